@@ -2313,6 +2313,14 @@ SOURCE=..\..\Src\Utils\blowfish.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\Src\Utils\CaptureFile.c
+# End Source File
+# Begin Source File
+
+SOURCE=..\..\Src\Utils\CaptureFile.h
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\Src\Utils\IniFileParser.c
 # End Source File
 # Begin Source File
@@ -2337,6 +2345,14 @@ SOURCE=..\..\Src\Utils\PacketFileSystem.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\Src\Utils\RewindBuffer.c
+# End Source File
+# Begin Source File
+
+SOURCE=..\..\Src\Utils\RewindBuffer.h
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\Src\Utils\SaveState.c
 # End Source File
 # Begin Source File
@@ -2477,12 +2493,24 @@ SOURCE=..\..\Src\VideoRender\Scalebit.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\Src\VideoRender\VideoPipeline.c
+# End Source File
+# Begin Source File
+
+SOURCE=..\..\Src\VideoRender\VideoPipeline.h
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\Src\VideoRender\VideoRender.c
 # End Source File
 # Begin Source File
 
 SOURCE=..\..\Src\VideoRender\VideoRender.h
 # End Source File
+# Begin Source File
+
+SOURCE=..\..\Src\VideoRender\VideoRenderSimd.h
+# End Source File
 # End Group
 # Begin Group "Win32"
 
@@ -2765,6 +2793,18 @@ SOURCE=..\..\Src\Z80\R800.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\Src\Z80\R800CoreLean.c
+# End Source File
+# Begin Source File
+
+SOURCE=..\..\Src\Z80\R800CoreR800.c
+# End Source File
+# Begin Source File
+
+SOURCE=..\..\Src\Z80\R800CoreZ80.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\Src\Z80\R800Dasm.c
 # End Source File
 # Begin Source File
@@ -2787,6 +2827,14 @@ SOURCE=..\..\Src\Z80\R800SaveState.c
 
 SOURCE=..\..\Src\Z80\R800SaveState.h
 # End Source File
+# Begin Source File
+
+SOURCE=..\..\Src\Z80\R800Trace.c
+# End Source File
+# Begin Source File
+
+SOURCE=..\..\Src\Z80\R800Trace.h
+# End Source File
 # End Group
 # End Group
 # Begin Group "Resource Files"
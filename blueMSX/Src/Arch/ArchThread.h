@@ -38,4 +38,22 @@ void  archThreadDestroy(void* thread);
 
 void archThreadSleep(int milliseconds);
 
+// Number of CPUs the host has, at least 1
+int archThreadGetCpuCount();
+
+// Atomic access to an int shared between threads. Each call is also a
+// full memory barrier, so what a thread wrote before archAtomicSet() is
+// seen by the thread that reads the new value with archAtomicGet().
+int  archAtomicGet(volatile int* value);
+void archAtomicSet(volatile int* value, int newValue);
+int  archAtomicExchange(volatile int* value, int newValue);
+
+// Sets value to newValue if it is oldValue. Returns the value it had.
+int  archAtomicCompareExchange(volatile int* value, int oldValue, int newValue);
+
+// Calls init the first time it is called with once, which starts at 0.
+// Threads calling it meanwhile return when init is done. Builds the
+// tables shared by all machines.
+void archThreadOnce(volatile int* once, void (*init)());
+
 #endif
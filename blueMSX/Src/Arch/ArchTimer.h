@@ -33,6 +33,8 @@
 UInt32 archGetSystemUpTime(UInt32 frequency);
 //void* archCreateTimer(int period, int (*timerCallback)(void*));
 void archTimerDestroy(void* timer);
+// Microseconds since an arbitrary start. The value wraps around, so
+// only the difference between two values is meaningful.
 UInt32 archGetHiresTimer();
 
 #define RDTSC_MAX_TIMERS 5
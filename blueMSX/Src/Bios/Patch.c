@@ -80,12 +80,9 @@ static const UInt8 bootSector[] = {
     0x20, 0xE6, 0x80, 0x6D, 0x8A, 0x00, 0x00, 0x00
 };
 
-static int patchEnabled = 0;
-static int patchBoardType = 0;
-
-void PatchDiskSetBusy(int driveId, int busy)
+void PatchDiskSetBusy(BoardContext* board, int driveId, int busy)
 {
-    if (driveId < MAXDRIVES && patchEnabled) {
+    if (driveId < MAXDRIVES && boardGetPatchEnabled(board)) {
         if (driveId == 0) ledSetFdd1(busy);
         if (driveId == 1) ledSetFdd2(busy);
     }
@@ -118,14 +115,9 @@ static void casout(void* ref, CpuRegs* cpu);
 
 void vdpCmdFlushAll();
 
-void PatchReset(BoardType boardType) {
-    patchEnabled = 0;
-    patchBoardType = boardType;
-}
-
 void PatchZ80(void* ref, CpuRegs* cpu)
 {
-    switch (patchBoardType) {
+    switch (boardGetType((BoardContext*)ref)) {
     default:
     case BOARD_MSX:
     case BOARD_MSX_S3527:
@@ -169,6 +161,7 @@ void PatchZ80(void* ref, CpuRegs* cpu)
 }
 
 static void phydio(void* ref, CpuRegs* cpu) {
+    BoardContext* board = (BoardContext*)ref;
     UInt8 buffer[512];
     UInt8 drive;
     UInt16 sector;
@@ -180,7 +173,7 @@ static void phydio(void* ref, CpuRegs* cpu) {
     UInt8 slotSec;
     int i;
 
-    patchEnabled = 1;
+    boardSetPatchEnabled(board, 1);
 
     cpu->iff1 = 1;
 
@@ -189,7 +182,7 @@ static void phydio(void* ref, CpuRegs* cpu) {
     address = cpu->HL.W;
     write   = cpu->AF.B.l & C_FLAG;
 
-    if (!diskPresent(drive)) {
+    if (!diskPresent(board, drive)) {
         cpu->AF.W=0x0201;
         return;
     }
@@ -208,13 +201,13 @@ static void phydio(void* ref, CpuRegs* cpu) {
     slotWrite(ref, 0xffff, slotSec);
 
     while (cpu->BC.B.h) {
-        PatchDiskSetBusy(drive, 1);
+        PatchDiskSetBusy(board, drive, 1);
         if (write) {
             for (i = 0; i < 512; i++) {
                 buffer[i]=slotRead(ref, address++);
             }
 
-            if (!diskWrite(drive, buffer, sector)) {
+            if (!diskWrite(board, drive, buffer, sector)) {
                 cpu->AF.W=0x0a01;
                 slotWrite(ref, 0xffff,origSlotSec);
                 ioPortWrite(ref, 0xa8,origSlotPri);
@@ -222,7 +215,7 @@ static void phydio(void* ref, CpuRegs* cpu) {
             }
         }
         else {
-            if (diskRead(drive, buffer, sector) != DSKE_OK) {
+            if (diskRead(board, drive, buffer, sector) != DSKE_OK) {
                 cpu->AF.W = 0x0401;
                 slotWrite(ref, 0xffff, origSlotSec);
                 ioPortWrite(ref, 0xa8, origSlotPri);
@@ -244,18 +237,19 @@ static void phydio(void* ref, CpuRegs* cpu) {
 }
 
 static void dskchg(void* ref, CpuRegs* cpu) {
+    BoardContext* board = (BoardContext*)ref;
     UInt8 buffer[512];
     UInt8 drive = cpu->AF.B.h;
 
     cpu->iff1 = 1;
 
-    if (!diskPresent(cpu->AF.B.h)) {
+    if (!diskPresent(board, cpu->AF.B.h)) {
         cpu->AF.W = 0x0201;
         return;
     }
 
-    PatchDiskSetBusy(drive, 1);
-    if (diskRead(drive, buffer, 1) != DSKE_OK) {
+    PatchDiskSetBusy(board, drive, 1);
+    if (diskRead(board, drive, buffer, 1) != DSKE_OK) {
         cpu->AF.W = 0x0a01;
         return;
     }
@@ -272,6 +266,7 @@ static void dskchg(void* ref, CpuRegs* cpu) {
 }
 
 static void getdpb(void* ref, CpuRegs* cpu) {
+    BoardContext* board = (BoardContext*)ref;
     UInt16 dirSectorNo;
     UInt16 dataSectorNo;
     UInt8  fatSectorNo;
@@ -279,7 +274,7 @@ static void getdpb(void* ref, CpuRegs* cpu) {
     UInt16 address;
     UInt8  mediaDescriptor;
 
-    if (!diskPresent(cpu->AF.B.h)) {
+    if (!diskPresent(board, cpu->AF.B.h)) {
         cpu->AF.W = 0x0201;
         return;
     }
@@ -340,6 +335,7 @@ static void getdpb(void* ref, CpuRegs* cpu) {
 }
 
 static void dskfmt(void* ref, CpuRegs* cpu) {
+    BoardContext* board = (BoardContext*)ref;
     UInt8 buffer[512];
     UInt8 index;
     int j;
@@ -364,7 +360,7 @@ static void dskfmt(void* ref, CpuRegs* cpu) {
     }
 
     /* If no disk, return "Not ready": */
-    if(!diskPresent(cpu->DE.B.h)) {
+    if(!diskPresent(board, cpu->DE.B.h)) {
         cpu->AF.W=0x0201;
         return;
     }
@@ -401,8 +397,8 @@ static void dskfmt(void* ref, CpuRegs* cpu) {
     buffer[27] = 0;
 
     /* If can't write bootblock, return "Write protected": */
-    PatchDiskSetBusy(cpu->DE.B.h, 1);
-    if (!diskWrite(cpu->DE.B.h, buffer, 0)) {
+    PatchDiskSetBusy(board, cpu->DE.B.h, 1);
+    if (!diskWrite(board, cpu->DE.B.h, buffer, 0)) {
         cpu->AF.W = 0x0001;
         return;
     }
@@ -416,7 +412,7 @@ static void dskfmt(void* ref, CpuRegs* cpu) {
         buffer[2] = 0xff;
         memset(buffer + 3, 0x00, 509);
 
-        if (!diskWrite(cpu->DE.B.h, buffer, sector++)) {
+        if (!diskWrite(board, cpu->DE.B.h, buffer, sector++)) {
             cpu->AF.W = 0x0a01;
             return;
         }
@@ -424,7 +420,7 @@ static void dskfmt(void* ref, CpuRegs* cpu) {
         memset(buffer, 0x00, 512);
 
         for(i = formatInfo[index].sectorsPerFAT; i > 1; i--) {
-            if (!diskWrite(cpu->DE.B.h, buffer, sector++)) {
+            if (!diskWrite(board, cpu->DE.B.h, buffer, sector++)) {
                 cpu->AF.W = 0x0A01;
                 return;
             }
@@ -436,7 +432,7 @@ static void dskfmt(void* ref, CpuRegs* cpu) {
 
     memset(buffer, 0x00, 512);
     while (dirSize--) {
-        if (!diskWrite(cpu->DE.B.h, buffer, sector++)) {
+        if (!diskWrite(board, cpu->DE.B.h, buffer, sector++)) {
             cpu->AF.W = 0x0A01;
             return;
         }
@@ -444,7 +440,7 @@ static void dskfmt(void* ref, CpuRegs* cpu) {
 
     memset(buffer, 0xFF, 512);
     while (dataSize--) {
-        if (!diskWrite(cpu->DE.B.h, buffer, sector++)) {
+        if (!diskWrite(board, cpu->DE.B.h, buffer, sector++)) {
             cpu->AF.W = 0x0a01;
             return;
         }
@@ -459,19 +455,22 @@ static void drvoff(void* ref, CpuRegs* cpu) {
 }
 
 static void tapion(void* ref, CpuRegs* cpu) {
+    BoardContext* board = (BoardContext*)ref;
+
     cpu->AF.B.l|=C_FLAG;
 
-    if (tapeReadHeader()) {
+    if (tapeReadHeader(board)) {
         cpu->AF.B.l&=~C_FLAG;
     }
 }
 
 static void tapin(void* ref, CpuRegs* cpu) {
+    BoardContext* board = (BoardContext*)ref;
     UInt8 value;
 
     cpu->AF.B.l |= C_FLAG;
 
-    if (tapeRead(&value)) {
+    if (tapeRead(board, &value)) {
         cpu->AF.B.h = value;
         cpu->AF.B.l &= ~C_FLAG;
     }
@@ -482,17 +481,21 @@ static void tapiof(void* ref, CpuRegs* cpu) {
 }
 
 static void tapoon(void* ref, CpuRegs* cpu) {
+    BoardContext* board = (BoardContext*)ref;
+
     cpu->AF.B.l |= C_FLAG;
 
-    if (tapeWriteHeader()) {
+    if (tapeWriteHeader(board)) {
         cpu->AF.B.l &= ~C_FLAG;
     }
 }
 
 static void tapout(void* ref, CpuRegs* cpu) {
+    BoardContext* board = (BoardContext*)ref;
+
     cpu->AF.B.l &= ~C_FLAG;
 
-    if (tapeWrite(cpu->AF.B.h)) {
+    if (tapeWrite(board, cpu->AF.B.h)) {
         cpu->AF.B.l &= ~C_FLAG;
     }
 }
@@ -506,9 +509,11 @@ static void stmotr(void* ref, CpuRegs* cpu) {
 }
 
 static void casout(void* ref, CpuRegs* cpu) {
+    BoardContext* board = (BoardContext*)ref;
+
     cpu->AF.B.l &= ~C_FLAG;
 
-    if (tapeWrite(cpu->AF.B.h)) {
+    if (tapeWrite(board, cpu->AF.B.h)) {
         cpu->AF.B.l &= ~C_FLAG;
     }
         cpu->PC.W = 0x20ED;
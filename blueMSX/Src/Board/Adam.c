@@ -50,10 +50,18 @@
 #include "ColecoSuperAction.h"
 #include "ColecoSteeringWheel.h"
 
-/* Hardware */
-static SN76489*    sn76489;
-static R800*       r800;
-static UInt8       adamMemMapReg;
+typedef struct {
+    BoardContext*   board;
+    SN76489*        sn76489;
+    R800*           r800;
+    R800Debug*      r800Debug;
+    UInt8           adamMemMapReg;
+
+    // ColecoAdam Joystick and PSG handler
+    ColecoJoystickDevice* joyDevice[2];
+    int             joyDeviceHandle;
+    int             joyMode;
+} Adam;
 
 /************************/
 /*	Adam Memory	*/
@@ -75,7 +83,7 @@ FFFF +---------+---------+---------+---------+
 typedef enum { BANK_02=0x00, BANK_04=0x50, BANK_06=0xa0, BANK_08=0xf0 } adamMemBanksHigh;
 typedef enum { BANK_01=0x00, BANK_03=0x05, BANK_05=0x0a, BANK_07=0x0f } adamMemBanksLow;
 
-static void adamMemMapSet(UInt8 value)
+static void adamMemMapSet(Adam* adam, UInt8 value)
 {
     UInt8 pages;
     int i;
@@ -85,28 +93,28 @@ static void adamMemMapSet(UInt8 value)
     pages |= (value&8)?(value&16)?(value&32)?BANK_02:BANK_08:BANK_06:BANK_04;
 
     for (i = 0; i < 4; i++) {
-        slotSetRamSlot(i, pages & 3);
+        slotSetRamSlot(adam->board, i, pages & 3);
         pages >>= 2;
     }
 }
 
-static void adamMemMapWrite(void* arg, UInt16 address, UInt8 value)
+static void adamMemMapWrite(Adam* adam, UInt16 address, UInt8 value)
 {
-	adamMemMapReg = value;
-	adamMemMapSet(value);
+	adam->adamMemMapReg = value;
+	adamMemMapSet(adam, value);
 	
 }
 
-static UInt8 adamMemMapRead(void* arg, UInt16 address)
+static UInt8 adamMemMapRead(Adam* adam, UInt16 address)
 {
-	return adamMemMapReg;
+	return adam->adamMemMapReg;
 }
 
-static void adamMemMapCreate(void)
+static void adamMemMapCreate(Adam* adam)
 {
     int i;
     for (i = 0x60; i <= 0x7f; i++) {
-        ioPortRegister(i, adamMemMapRead, adamMemMapWrite, NULL);
+        ioPortRegister(adam->board, i, adamMemMapRead, adamMemMapWrite, adam);
     }
 }
 
@@ -114,20 +122,20 @@ static void adamMemMapCreate(void)
 /*	Adam Net	*/
 /************************/
 
-static void adamNetWrite(void* arg, UInt16 address, UInt8 value)
+static void adamNetWrite(Adam* adam, UInt16 address, UInt8 value)
 {
 }
 
-static UInt8 adamNetRead(void* arg, UInt16 address)
+static UInt8 adamNetRead(Adam* adam, UInt16 address)
 {
 	return 0xff;
 }
 
- static void adamNetCreate(void)
+ static void adamNetCreate(Adam* adam)
 {
     int i;
     for (i = 0x20; i <= 0x3f; i++) {
-        ioPortRegister(i, adamNetRead, adamNetWrite, NULL);
+        ioPortRegister(adam->board, i, adamNetRead, adamNetWrite, adam);
     }
 }
 
@@ -136,23 +144,19 @@ static UInt8 adamNetRead(void* arg, UInt16 address)
 // ---------------------------------------------
 // ColecoAdam Joystick and PSG handler
 
-static ColecoJoystickDevice* joyDevice[2];
-static int joyDeviceHandle;
-static int joyMode;
-
-static void colecoSN76489Write(void* dummy, UInt16 ioPort, UInt8 value) 
+static void colecoSN76489Write(Adam* adam, UInt16 ioPort, UInt8 value) 
 {
-    sn76489WriteData(sn76489, ioPort, value);
+    sn76489WriteData(adam->sn76489, ioPort, value);
 }
 
-static void colecoJoyIoWrite(void* dummy, UInt16 ioPort, UInt8 value)
+static void colecoJoyIoWrite(Adam* adam, UInt16 ioPort, UInt8 value)
 {
-	joyMode = (ioPort >> 6) & 1;
+	adam->joyMode = (ioPort >> 6) & 1;
 }
 
-static UInt8 colecoJoyIoRead(void* dummy, UInt16 ioPort)
+static UInt8 colecoJoyIoRead(Adam* adam, UInt16 ioPort)
 {
-    ColecoJoystickDevice* device = joyDevice[(ioPort >> 1) & 1];
+    ColecoJoystickDevice* device = adam->joyDevice[(ioPort >> 1) & 1];
     UInt16 joyState = 0xffff;
     UInt8 value;
 
@@ -160,15 +164,15 @@ static UInt8 colecoJoyIoRead(void* dummy, UInt16 ioPort)
         joyState = device->read(device);
     }
 
-    if (joyMode != 0) {
-        return boardCaptureUInt8(ioPort & 2, ((joyState & 0x100) ? 0x10 : 0) |
-                                             ((joyState & 0x200) ? 0x20 : 0) |
-                                             ((joyState & 0x001) ? 0x01 : 0) |
-                                             ((joyState & 0x008) ? 0x02 : 0) |
-                                             ((joyState & 0x002) ? 0x04 : 0) |
-                                             ((joyState & 0x004) ? 0x08 : 0) |
-                                             ((joyState & 0x010) ? 0x40 : 0) |
-                                             0x30);
+    if (adam->joyMode != 0) {
+        return boardCaptureUInt8(adam->board, ioPort & 2, ((joyState & 0x100) ? 0x10 : 0) |
+                                                          ((joyState & 0x200) ? 0x20 : 0) |
+                                                          ((joyState & 0x001) ? 0x01 : 0) |
+                                                          ((joyState & 0x008) ? 0x02 : 0) |
+                                                          ((joyState & 0x002) ? 0x04 : 0) |
+                                                          ((joyState & 0x004) ? 0x08 : 0) |
+                                                          ((joyState & 0x010) ? 0x40 : 0) |
+                                                          0x30);
     }
 
     value = ((joyState & 0x100) ? 0x10 : 0) |
@@ -209,171 +213,181 @@ static UInt8 colecoJoyIoRead(void* dummy, UInt16 ioPort)
     return value;
 }
 
-static void colecoJoyIoHandler(void* dummy, int port, JoystickPortType type)
+static void colecoJoyIoHandler(Adam* adam, int port, JoystickPortType type)
 {
     if (port >= 2) {
         return;
     }
 
-    if (joyDevice[port] != NULL && joyDevice[port]->destroy != NULL) {
-        joyDevice[port]->destroy(joyDevice[port]);
+    if (adam->joyDevice[port] != NULL && adam->joyDevice[port]->destroy != NULL) {
+        adam->joyDevice[port]->destroy(adam->joyDevice[port]);
     }
     
     switch (type) {
     default:
     case JOYSTICK_PORT_NONE:
-        joyDevice[port] = NULL;
+        adam->joyDevice[port] = NULL;
         break;
     case JOYSTICK_PORT_COLECOJOYSTICK:
-        joyDevice[port] = colecoJoystickCreate(port);
+        adam->joyDevice[port] = colecoJoystickCreate(port);
         break;
     case JOYSTICK_PORT_SUPERACTION:
-        joyDevice[port] = colecoSuperActionCreate(port);
+        adam->joyDevice[port] = colecoSuperActionCreate(port);
         break;
     case JOYSTICK_PORT_STEERINGWHEEL:
-        joyDevice[port] = colecoSteeringWheelCreate(port);
+        adam->joyDevice[port] = colecoSteeringWheelCreate(port);
         break;
     }
 }
 
-static void colecoJoyIoLoadState(void* dummy)
+static void colecoJoyIoLoadState(Adam* adam)
 {
-    if (joyDevice[0] != NULL && joyDevice[0]->loadState != NULL) {
-        joyDevice[0]->loadState(joyDevice[0]);
+    if (adam->joyDevice[0] != NULL && adam->joyDevice[0]->loadState != NULL) {
+        adam->joyDevice[0]->loadState(adam->joyDevice[0]);
     }
-    if (joyDevice[1] != NULL && joyDevice[1]->loadState != NULL) {
-        joyDevice[1]->loadState(joyDevice[1]);
+    if (adam->joyDevice[1] != NULL && adam->joyDevice[1]->loadState != NULL) {
+        adam->joyDevice[1]->loadState(adam->joyDevice[1]);
     }
 }
 
-static void colecoJoyIoSaveState(void* dummy)
+static void colecoJoyIoSaveState(Adam* adam)
 {
-    if (joyDevice[0] != NULL && joyDevice[0]->saveState != NULL) {
-        joyDevice[0]->saveState(joyDevice[0]);
+    if (adam->joyDevice[0] != NULL && adam->joyDevice[0]->saveState != NULL) {
+        adam->joyDevice[0]->saveState(adam->joyDevice[0]);
     }
-    if (joyDevice[1] != NULL && joyDevice[1]->saveState != NULL) {
-        joyDevice[1]->saveState(joyDevice[1]);
+    if (adam->joyDevice[1] != NULL && adam->joyDevice[1]->saveState != NULL) {
+        adam->joyDevice[1]->saveState(adam->joyDevice[1]);
     }
 }
 
-static void colecoJoyIoReset(void* dummy)
+static void colecoJoyIoReset(Adam* adam)
 {
-    if (joyDevice[0] != NULL && joyDevice[0]->reset != NULL) {
-        joyDevice[0]->reset(joyDevice[0]);
+    if (adam->joyDevice[0] != NULL && adam->joyDevice[0]->reset != NULL) {
+        adam->joyDevice[0]->reset(adam->joyDevice[0]);
     }
-    if (joyDevice[1] != NULL && joyDevice[1]->reset != NULL) {
-        joyDevice[1]->reset(joyDevice[1]);
+    if (adam->joyDevice[1] != NULL && adam->joyDevice[1]->reset != NULL) {
+        adam->joyDevice[1]->reset(adam->joyDevice[1]);
     }
 }
 
-static void colecoJoyIoDestroy(void* dummy)
+static void colecoJoyIoDestroy(Adam* adam)
 {
     int i;
     for (i = 0xe0; i <= 0xff; i++) {
-        ioPortUnregister(i);
+        ioPortUnregister(adam->board, i);
     }
     
-    if (joyDevice[0] != NULL && joyDevice[0]->destroy != NULL) {
-        joyDevice[0]->destroy(joyDevice[0]);
+    if (adam->joyDevice[0] != NULL && adam->joyDevice[0]->destroy != NULL) {
+        adam->joyDevice[0]->destroy(adam->joyDevice[0]);
     }
-    if (joyDevice[1] != NULL && joyDevice[1]->destroy != NULL) {
-        joyDevice[1]->destroy(joyDevice[1]);
+    if (adam->joyDevice[1] != NULL && adam->joyDevice[1]->destroy != NULL) {
+        adam->joyDevice[1]->destroy(adam->joyDevice[1]);
     }
     
-    joystickPortUpdateHandlerUnregister();
+    joystickPortUpdateHandlerUnregister(adam);
 
-    deviceManagerUnregister(joyDeviceHandle);
+    deviceManagerUnregister(adam->board, adam->joyDeviceHandle);
 }
 
-static void colecoJoyIoCreate()
+static void colecoJoyIoCreate(Adam* adam)
 {
     DeviceCallbacks callbacks = { colecoJoyIoDestroy,   colecoJoyIoReset, 
                                   colecoJoyIoSaveState, colecoJoyIoLoadState };
 
     int i;
     for (i = 0xe0; i <= 0xff; i++) {
-        ioPortRegister(i, colecoJoyIoRead, colecoSN76489Write, NULL);
+        ioPortRegister(adam->board, i, colecoJoyIoRead, colecoSN76489Write, adam);
     }
     for (i = 0x80; i <= 0x9f; i++) {
-        ioPortRegister(i, NULL, colecoJoyIoWrite, NULL);
+        ioPortRegister(adam->board, i, NULL, colecoJoyIoWrite, adam);
     }
     for (i = 0xc0; i <= 0xdf; i++) {
-        ioPortRegister(i, NULL, colecoJoyIoWrite, NULL);
+        ioPortRegister(adam->board, i, NULL, colecoJoyIoWrite, adam);
     }
     
-    joystickPortUpdateHandlerRegister(colecoJoyIoHandler, NULL);
-    joyDeviceHandle = deviceManagerRegister(ROM_UNKNOWN, &callbacks, NULL);
+    joystickPortUpdateHandlerRegister(colecoJoyIoHandler, adam);
+    adam->joyDeviceHandle = deviceManagerRegister(adam->board, ROM_UNKNOWN, &callbacks, adam);
 }
 
-static void reset()
+static void reset(Adam* adam)
 {
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(adam->board);
 
-    slotManagerReset();
+    slotManagerReset(adam->board);
 
-    if (r800 != NULL) {
-        r800Reset(r800, systemTime);
+    if (adam->r800 != NULL) {
+        r800Reset(adam->r800, systemTime);
     }
 
-    if (sn76489 != NULL) {
-        sn76489Reset(sn76489);
+    if (adam->sn76489 != NULL) {
+        sn76489Reset(adam->sn76489);
     }
     
     ledSetCapslock(0);
 
-    deviceManagerReset();
+    deviceManagerReset(adam->board);
 }
 
-static void destroy() 
+static void destroy(Adam* adam) 
 {
-    boardRemoveExternalDevices();
+    boardRemoveExternalDevices(adam->board);
+
+    sn76489Destroy(adam->sn76489);
+    r800DebugDestroy(adam->r800Debug);
+    slotManagerDestroy(adam->board);
+    deviceManagerDestroy(adam->board);
+    r800Destroy(adam->r800);
 
-    sn76489Destroy(sn76489);
-    r800DebugDestroy();
-    slotManagerDestroy();
-    deviceManagerDestroy();
-    r800Destroy(r800);
+    free(adam);
 }
 
-static int getRefreshRate()
+static int getRefreshRate(Adam* adam)
 {
-    return vdpGetRefreshRate();
+    return vdpGetRefreshRate(adam->board);
 }
 
-static UInt32 getTimeTrace(int offset) {
-    return r800GetTimeTrace(r800, offset);
+static UInt32 getTimeTrace(Adam* adam, int offset) {
+    return r800GetTimeTrace(adam->r800, offset);
 }
 
-static void saveState()
+static void saveState(Adam* adam)
 {    
-    r800SaveState(r800);
-    sn76489SaveState(sn76489);
-    deviceManagerSaveState();
-    slotSaveState();
+    r800SaveState(adam->board, adam->r800);
+    sn76489SaveState(adam->sn76489);
+    deviceManagerSaveState(adam->board);
+    slotSaveState(adam->board);
 }
 
-static void loadState()
+static void loadState(Adam* adam)
 {
-    r800LoadState(r800);
-    boardInit(&r800->systemTime);
-    deviceManagerLoadState();
-    slotLoadState();
-    sn76489LoadState(sn76489);
+    r800LoadState(adam->board, adam->r800);
+    boardInit(adam->board, &adam->r800->systemTime);
+    deviceManagerLoadState(adam->board);
+    slotLoadState(adam->board);
+    sn76489LoadState(adam->sn76489);
 }
 
-int adamCreate(Machine* machine, 
+int adamCreate(BoardContext* board, Machine* machine, 
                  VdpSyncMode vdpSyncMode,
                  BoardInfo* boardInfo)
 {
+    Adam* adam;
     int success;
     int i;
 
-    r800 = r800Create(0, slotRead, slotWrite, ioPortRead, ioPortWrite, NULL, boardTimerCheckTimeout, NULL, NULL, NULL, NULL, NULL, NULL);
+    adam = (Adam*)calloc(1, sizeof(Adam));
+    adam->board = board;
+
+    adam->r800 = r800Create(0, slotRead, slotWrite, ioPortRead, ioPortWrite, NULL, boardTimerCheckTimeout, NULL, NULL, NULL, NULL, NULL, board);
+    r800SetMemoryBlocks(adam->r800, slotGetReadBlocks(board), slotGetWriteBlocks(board));
+    r800SetCodeCache(adam->r800, slotGetBlockVersions(board));
+    r800SetIoPortBlockWrite(adam->r800, ioPortCanWriteBlock, ioPortWriteBlock);
 
     boardInfo->cartridgeCount   = 1;
     boardInfo->diskdriveCount   = 2;
     boardInfo->casetteCount     = 1;
-    boardInfo->cpuRef           = r800;
+    boardInfo->cpuRef           = adam->r800;
+    boardInfo->ref              = adam;
 
     boardInfo->destroy          = destroy;
     boardInfo->softReset        = reset;
@@ -392,51 +406,51 @@ int adamCreate(Machine* machine,
     boardInfo->setDataBus       = r800SetDataBus;
     boardInfo->getTimeTrace     = getTimeTrace;
 
-    deviceManagerCreate();
+    deviceManagerCreate(board);
 
-    boardInit(&r800->systemTime);
-    ioPortReset();
+    boardInit(board, &adam->r800->systemTime);
+    ioPortReset(board);
 
-    r800Reset(r800, 0);
-    mixerReset(boardGetMixer());
+    r800Reset(adam->r800, 0);
+    mixerReset(boardGetMixer(board));
 
-    r800DebugCreate(r800);
+    adam->r800Debug = r800DebugCreate(board, adam->r800);
 
-    sn76489 = sn76489Create(boardGetMixer());
+    adam->sn76489 = sn76489Create(board, boardGetMixer(board));
 
-    slotManagerCreate();
+    slotManagerCreate(board);
     
     if (vdpSyncMode == VDP_SYNC_AUTO) {
         vdpSyncMode = VDP_SYNC_60HZ;
     }
-    vdpCreate(VDP_COLECO, machine->video.vdpVersion, vdpSyncMode, machine->video.vramSize / 0x4000);
+    vdpCreate(board, VDP_COLECO, machine->video.vdpVersion, vdpSyncMode, machine->video.vramSize / 0x4000);
 
-    colecoJoyIoCreate();
+    colecoJoyIoCreate(adam);
 
     ledSetCapslock(0);
 
     for (i = 0; i < 4; i++) {
-        slotSetSubslotted(i, 0);
+        slotSetSubslotted(board, i, 0);
     }
     for (i = 0; i < 2; i++) {
-        cartridgeSetSlotInfo(i, machine->cart[i].slot, 0);
+        cartridgeSetSlotInfo(board, i, machine->cart[i].slot, 0);
     }
 
-    success = machineInitialize(machine, NULL, NULL, NULL);
+    success = machineInitialize(board, machine, NULL, NULL, NULL);
 
     for (i = 0; i < 8; i++) {
-        slotMapRamPage(0, 0, i);
+        slotMapRamPage(board, 0, 0, i);
     }
 
     if (success) {
-        success = boardInsertExternalDevices();
+        success = boardInsertExternalDevices(board);
     }
 
-    r800SetFrequency(r800, CPU_Z80,  machine->cpu.freqZ80);
-    r800SetFrequency(r800, CPU_R800, machine->cpu.freqR800);
+    r800SetFrequency(adam->r800, CPU_Z80,  machine->cpu.freqZ80);
+    r800SetFrequency(adam->r800, CPU_R800, machine->cpu.freqR800);
 
     if (!success) {
-        destroy();
+        destroy(adam);
     }
 
     return success;
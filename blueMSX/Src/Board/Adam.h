@@ -30,7 +30,7 @@
  
 #include "Board.h"
 
-int adamCreate(Machine* machine, 
+int adamCreate(BoardContext* board, Machine* machine,
                  VdpSyncMode vdpSyncMode,
                  BoardInfo* boardInfo);
 
@@ -37,8 +37,9 @@
 #include "Moonsound.h"
 #include "SaveState.h"
 #include "ziphelper.h"
+#include "RewindBuffer.h"
+#include "CaptureFile.h"
 #include "ArchNotifications.h"
-#include "VideoManager.h"
 #include "DebugDeviceManager.h"
 #include "MegaromCartridge.h"
 #include "Disk.h"
@@ -47,69 +48,273 @@
 #include "MediaDb.h"
 #include "RomLoader.h"
 #include "JoystickPort.h"
+#include "SlotManager.h"
+#include "IoPort.h"
+#include "DeviceManager.h"
 #include <string.h>
 #include <stdlib.h>
 #include <time.h>
 
-extern void PatchReset(BoardType boardType);
-
-static int skipSync;
-static int pendingInt;
-static int boardType;
-static Mixer* boardMixer = NULL;
-static int (*syncToRealClock)(int, int) = NULL;
-UInt32* boardSysTime;
-static UInt64 boardSysTime64;
-static UInt32 oldTime;
-static UInt32 boardFreq = boardFrequency();
-static int fdcTimingEnable = 1;
-static int fdcActive       = 0;
-static BoardTimer* fdcTimer;
-static BoardTimer* syncTimer;
-static BoardTimer* mixerTimer;
-static BoardTimer* stateTimer;
-static BoardTimer* breakpointTimer;
-static BoardDeviceInfo* boardDeviceInfo;
-static Machine* boardMachine;
-static BoardInfo boardInfo;
-static UInt32 boardRamSize;
-static UInt32 boardVramSize;
-static int boardRunning = 0;
-
-static HdType hdType[MAX_HD_COUNT];
-  
-static int     ramMaxStates;
-static int     ramStateCur;
-static int     ramStateCount;
-static int     stateFrequency;
-static int     enableSnapshots;
-static int     useRom;
-static int     useMegaRom;
-static int     useMegaRam;
-static int     useFmPac;
-static RomType currentRomType[2];
-
-static BoardType boardLoadState(void);
-static void boardUpdateDisketteInfo();
 
-static char saveStateVersion[32] = "blueMSX - state  v 8";
+typedef struct {
+    UInt8  index;
+    UInt8  value;
+    UInt16 count;
+} RleData;
+
+typedef enum 
+{
+    CAPTURE_IDLE = 0,
+    CAPTURE_REC  = 1,
+    CAPTURE_PLAY = 2,
+} CaptureState;
+
+// Number of RLE entries in an input chunk of a capture file
+#define CAPTURE_CHUNK_ENTRIES 0x4000
+
+typedef struct Capture {
+    BoardTimer* timer;
+    BoardTimer* keyframeTimer;
+
+    CaptureFile* file;
+    UInt64 chunkOffset;
+    int    playback;
+    UInt32 endTime;
+    UInt64 endTime64;
+    UInt64 startTime64;
+    UInt64 playbackStart64;
+    CaptureState state;
+    RleData inputs[CAPTURE_CHUNK_ENTRIES];
+    int    inputCnt;
+    char   filename[512];
+} Capture;
+
+//------------------------------------------------------
+// Board context
+//
+// All state of a machine that is owned by the board and
+// the services the devices register with. The context is
+// passed to every function that works on the machine and
+// kept by every device of it.
+//------------------------------------------------------
+struct BoardContext {
+    UInt32* sysTime;    // Must be first, see boardSystemTime()
+    UInt32  boardFreq;
+    UInt64  boardSysTime64;
+    UInt32  oldTime;
+
+    SlotManagerContext*   slotManager;
+    IoPortContext*        ioPort;
+    DeviceManagerContext* deviceManager;
+    DebugDeviceContext*   debugDevices;
+    VideoManagerContext*  videoManager;
+    FrameBufferContext*   frameBuffer;
+    SaveStateContext*     saveState;
+    RewindBuffer*         rewindBuffer;
+    DiskContext*          disk;
+    TapeContext*          tape;
+
+    int skipSync;
+    int syncStateLoaded;
+    int pendingInt;
+    int boardType;
+    Mixer* boardMixer;
+    int (*syncToRealClock)(int, int);
+    int fdcActive;
+    BoardTimer* fdcTimer;
+    BoardTimer* syncTimer;
+    BoardTimer* mixerTimer;
+    BoardTimer* stateTimer;
+    BoardTimer* breakpointTimer;
+    BoardDeviceInfo* boardDeviceInfo;
+    Machine* boardMachine;
+    BoardInfo boardInfo;
+    UInt32 boardRamSize;
+    UInt32 boardVramSize;
+    int boardRunning;
+
+    HdType hdType[MAX_HD_COUNT];
+
+    int     stateFrequency;
+    int     enableSnapshots;
+    int     useRom;
+    int     useMegaRom;
+    int     useMegaRam;
+    int     useFmPac;
+    RomType currentRomType[2];
+
+    BoardTimerCb periodicCb;
+    void*        periodicRef;
+    UInt32       periodicInterval;
+    BoardTimer*  periodicTimer;
+
+    RleData* rleData;
+    int      rleDataSize;
+    int      rleIdx;
+    int      rleLeft;
+    UInt8    rleCache[256];
+
+    Capture cap;
+
+    BoardSnapshot* runAheadSnapshot;
+    int            runAheadLeft;
+    BoardTimer*    keepTimer;
+
+    BoardTimer** timerHeap;
+    int    timerHeapSize;
+    int    timerHeapCapacity;
+    UInt32 timerSequence;
+    UInt32 timeAnchor;
+    int    timeoutCheckBreak;
+    BoardTimerTraceCb timerTrace;
+
+    VDP* vdp;
+
+    int fdcTimingEnable;
+    int noSpriteLimits;
+    int spritesEnable;
+    int displayEnable;
+    int runAheadFrames;
+    int oversamplingYM2413;
+    int oversamplingY8950;
+    int oversamplingMoonsound;
+    int enableYM2413;
+    int enableY8950;
+    int enableMoonsound;
+    int videoAutodetect;
+    int patchEnabled;
+};
 
-static BoardTimerCb periodicCb;
-static void*        periodicRef;
-static UInt32       periodicInterval;
-static BoardTimer*  periodicTimer;
+static BoardType boardLoadState(BoardContext* board);
+static void boardWriteState(BoardContext* board, const char* stateFile, int screenshot);
+static int boardRestoreCurrentState(BoardContext* board);
+static void boardUpdateDisketteInfo(BoardContext* board);
+
+static char saveStateVersion[32] = "blueMSX - state  v 8";
 
-void boardTimerCleanup();
+static void boardTimerCleanup(BoardContext* context);
+static void timerSetAnchor(BoardContext* context, UInt32 anchor);
+static void timerRestoreAnchor(BoardContext* context, UInt32 anchor);
 
 #define HIRES_CYCLES_PER_LORES_CYCLE (UInt64)100000
 #define boardFrequency64() (HIRES_CYCLES_PER_LORES_CYCLE * boardFrequency())
 
+// Reverse snapshots are stored as deltas with a keyframe every second
+// (at the default 50 ms period). The arena is sized from the average
+// snapshot size incl. keyframes of an MSX2 with 512kB mapper.
+#define REWIND_KEYFRAME_INTERVAL    20
+#define REWIND_BYTES_PER_SNAPSHOT   (64 * 1024)
+#define REWIND_MIN_ARENA_SIZE       (8 * 1024 * 1024)
+
+BoardContext* boardContextCreate()
+{
+    BoardContext* board = calloc(1, sizeof(BoardContext));
+
+    board->boardFreq     = boardFrequency();
+    board->slotManager   = slotManagerContextCreate();
+    board->ioPort        = ioPortContextCreate();
+    board->deviceManager = deviceManagerContextCreate();
+    board->debugDevices  = debugDeviceContextCreate();
+    board->videoManager  = videoManagerContextCreate();
+    board->frameBuffer   = frameBufferContextCreate();
+    board->saveState     = saveStateContextCreate();
+    board->disk          = diskContextCreate();
+    board->tape          = tapeContextCreate();
+
+    board->fdcTimingEnable       = 1;
+    board->spritesEnable         = 1;
+    board->displayEnable         = 1;
+    board->oversamplingYM2413    = 1;
+    board->oversamplingY8950     = 1;
+    board->oversamplingMoonsound = 1;
+    board->enableYM2413          = 1;
+    board->enableY8950           = 1;
+    board->enableMoonsound       = 1;
+    board->videoAutodetect       = 1;
+
+    return board;
+}
+
+void boardContextDestroy(BoardContext* board)
+{
+    if (board == NULL) {
+        return;
+    }
+
+    slotManagerContextDestroy(board->slotManager);
+    ioPortContextDestroy(board->ioPort);
+    deviceManagerContextDestroy(board->deviceManager);
+    debugDeviceContextDestroy(board->debugDevices);
+    videoManagerContextDestroy(board->videoManager);
+    frameBufferContextDestroy(board->frameBuffer);
+    saveStateContextDestroy(board->saveState);
+    rewindBufferDestroy(board->rewindBuffer);
+    diskContextDestroy(board->disk);
+    tapeContextDestroy(board->tape);
+    free(board->timerHeap);
+    free(board);
+}
+
+SlotManagerContext* boardGetSlotManager(BoardContext* board)
+{
+    return board->slotManager;
+}
+
+IoPortContext* boardGetIoPort(BoardContext* board)
+{
+    return board->ioPort;
+}
+
+DeviceManagerContext* boardGetDeviceManager(BoardContext* board)
+{
+    return board->deviceManager;
+}
+
+DebugDeviceContext* boardGetDebugDevices(BoardContext* board)
+{
+    return board->debugDevices;
+}
+
+VideoManagerContext* boardGetVideoManager(BoardContext* board)
+{
+    return board->videoManager;
+}
+
+FrameBufferContext* boardGetFrameBuffer(BoardContext* board)
+{
+    return board->frameBuffer;
+}
+
+SaveStateContext* boardGetSaveState(BoardContext* board)
+{
+    return board->saveState;
+}
+
+RewindBuffer* boardGetRewindBuffer(BoardContext* board)
+{
+    return board->rewindBuffer;
+}
+
+DiskContext* boardGetDisk(BoardContext* board)
+{
+    return board->disk;
+}
+
+TapeContext* boardGetTape(BoardContext* board)
+{
+    return board->tape;
+}
 
 static void boardPeriodicCallback(void* ref, UInt32 time)
 {
-    if (periodicCb != NULL) {
-        periodicCb(periodicRef, time);
-        boardTimerAdd(periodicTimer, time + periodicInterval);
+    BoardContext* board = (BoardContext*)ref;
+
+    if (board->periodicCb != NULL) {
+        // Frames emulated ahead are undone, the callback sees them later
+        if (board->runAheadLeft == 0) {
+            board->periodicCb(board->periodicRef, time);
+        }
+        boardTimerAdd(board->periodicTimer, time + board->periodicInterval);
     }
 }
 
@@ -119,132 +324,155 @@ static void boardPeriodicCallback(void* ref, UInt32 time)
 // The callback needs to be added before the emulation
 // starts in order to be called.
 //------------------------------------------------------
-void boardSetPeriodicCallback(BoardTimerCb cb, void* ref, UInt32 freq)
+void boardSetPeriodicCallback(BoardContext* board, BoardTimerCb cb, void* ref, UInt32 freq)
 {
-    periodicCb       = cb;
-    periodicRef      = ref;
-    if (periodicCb != NULL && freq > 0) {
-        periodicInterval = boardFrequency() / freq;
+    board->periodicCb       = cb;
+    board->periodicRef      = ref;
+    if (board->periodicCb != NULL && freq > 0) {
+        board->periodicInterval = boardFrequency() / freq;
     }
 }
 
 //------------------------------------------------------
 // Capture stuff
+//
+// A capture is streamed to the capture file while it is
+// recorded. Inputs are RLE coded into a chunk buffer that
+// is written to the file when full, and a keyframe state
+// is written every CAPTURE_KEYFRAME_PERIOD ms. Playback
+// starts at a keyframe and reads the input chunks after it.
 //------------------------------------------------------
 
-#define CAPTURE_VERSION     3
+#define CAPTURE_VERSION     4
 
-typedef struct {
-    UInt8  index;
-    UInt8  value;
-    UInt16 count;
-} RleData;
+// Keyframe states are written every 10 seconds of emulated time
+#define CAPTURE_KEYFRAME_PERIOD 10000
 
-static RleData* rleData;
-static int      rleDataSize;
-static int      rleIdx;
-static UInt8    rleCache[256];
 
-static void rleEncStartEncode(void* buffer, int length, int startOffset)
+static void rleEncStartEncode(BoardContext* board, int resetCache)
 {
-    rleIdx = startOffset - 1;
-    rleDataSize = length / sizeof(RleData) - 1;
-    rleData = (RleData*)buffer;
+    board->rleIdx = -1;
+    board->rleDataSize = CAPTURE_CHUNK_ENTRIES;
+    board->rleData = board->cap.inputs;
+
+    if (resetCache) {
+        memset(board->rleCache, 0, sizeof(board->rleCache));
+    }
+}
 
-    if (startOffset == 0) {
-        memset(rleCache, 0, sizeof(rleCache));
+// Writes the encoded inputs to the capture file. The next input
+// starts a new RLE entry so the written entries are final.
+static void rleEncFlush(BoardContext* board)
+{
+    if (board->rleIdx >= 0 && board->cap.file != NULL) {
+        captureFileWriteChunk(board->cap.file, CAPTURE_CHUNK_INPUTS, boardSystemTime(board), boardSystemTime64(board),
+                              board->rleData, (board->rleIdx + 1) * sizeof(RleData));
     }
+    board->rleIdx = -1;
 }
 
-static void rleEncAdd(UInt8 index, UInt8 value)
+static void rleEncAdd(BoardContext* board, UInt8 index, UInt8 value)
 {
-    if (rleIdx < 0 || rleCache[index] != value || rleData[rleIdx].count == 0) {
-        rleIdx++;
-        rleData[rleIdx].value = value;
-        rleData[rleIdx].count = 1;
-        rleData[rleIdx].index = index;
-        rleCache[index] = value;
+    if (board->rleIdx < 0 || board->rleCache[index] != value || board->rleData[board->rleIdx].count == 0) {
+        if (board->rleIdx + 1 == board->rleDataSize) {
+            rleEncFlush(board);
+        }
+        board->rleIdx++;
+        board->rleData[board->rleIdx].value = value;
+        board->rleData[board->rleIdx].count = 1;
+        board->rleData[board->rleIdx].index = index;
+        board->rleCache[index] = value;
     }
     else {
-        rleData[rleIdx].count++;
+        board->rleData[board->rleIdx].count++;
     }
 }
 
-static int rleEncGetLength()
+static int rleEncGetLength(BoardContext* board)
 {
-    return rleIdx + 1;
+    return board->rleIdx + 1;
 }
 
-static void rleEncStartDecode(void* encodedData, int encodedSize)
+static void rleEncStartDecode(BoardContext* board)
 {
-    rleIdx = 0;
-    rleDataSize = encodedSize;
-    rleData = (RleData*)encodedData;
-    
-    memset(rleCache, 0, sizeof(rleCache));
-
-    rleCache[rleData[rleIdx].index] = rleData[rleIdx].value;
+    board->rleIdx = -1;
+    board->rleDataSize = 0;
+    board->rleLeft = 0;
+    board->rleData = board->cap.inputs;
 }
 
-static UInt8 rleEncGet(UInt8 index)
+// Reads the next input chunk from the capture file. The capture file
+// is closed when the end of the capture is reached.
+static int rleDecReadChunk(BoardContext* board)
 {
-    UInt8 value = rleCache[index];
+    CaptureChunkType type;
+    UInt32 time;
+    UInt64 time64;
+    UInt32 size;
+
+    while (board->cap.file != NULL) {
+        UInt64 offset = captureFileGetOffset(board->cap.file);
 
-    rleData[rleIdx].count--;
-    if (rleData[rleIdx].count == 0) {
-        rleIdx++;
-        rleCache[rleData[rleIdx].index] = rleData[rleIdx].value;
+        if (!captureFileNextChunk(board->cap.file, &type, &time, &time64, &size) || type == CAPTURE_CHUNK_END) {
+            board->cap.chunkOffset = offset;
+            break;
+        }
+        if (type == CAPTURE_CHUNK_INPUTS && size <= sizeof(board->cap.inputs)) {
+            if (!captureFileReadData(board->cap.file, board->rleData, size)) {
+                board->cap.chunkOffset = offset;
+                break;
+            }
+            board->cap.chunkOffset = offset;
+            board->rleDataSize = size / sizeof(RleData);
+            board->rleIdx = -1;
+            return 1;
+        }
     }
 
-    return value;
-}
+    captureFileClose(board->cap.file);
+    board->cap.file = NULL;
+    board->rleDataSize = 0;
+    board->rleIdx = -1;
 
-static int rleEncEof()
-{
-    return rleIdx > rleDataSize;
+    return 0;
 }
 
-
-typedef enum 
+// Returns the recorded value, or value if the end of the capture is reached
+static UInt8 rleEncGet(BoardContext* board, UInt8 index, UInt8 value)
 {
-    CAPTURE_IDLE = 0,
-    CAPTURE_REC  = 1,
-    CAPTURE_PLAY = 2,
-} CaptureState;
+    if (board->rleLeft == 0) {
+        RleData* rle;
 
-typedef struct Capture {
-    BoardTimer* timer;
+        if (board->rleIdx + 1 >= board->rleDataSize && !rleDecReadChunk(board)) {
+            return value;
+        }
+        rle = &board->rleData[++board->rleIdx];
+        board->rleCache[rle->index] = rle->value;
+        board->rleLeft = rle->count != 0 ? rle->count : 0x10000;
+    }
+    board->rleLeft--;
 
-    UInt8  initState[0x100000];
-    int    initStateSize;
-    UInt32 endTime;
-    UInt64 endTime64;
-    UInt64 startTime64;
-    CaptureState state;
-    UInt8  inputs[0x100000];
-    int    inputCnt;
-    char   filename[512];
-} Capture;
+    return board->rleCache[index];
+}
 
-static Capture cap;
 
-int boardCaptureHasData() {
-    return cap.endTime != 0 || cap.endTime64 != 0 || boardCaptureIsRecording();
+int boardCaptureHasData(BoardContext* board) {
+    return board->cap.endTime != 0 || board->cap.endTime64 != 0 || boardCaptureIsRecording(board);
 }
 
-int boardCaptureIsRecording() {
-    return cap.state == CAPTURE_REC;
+int boardCaptureIsRecording(BoardContext* board) {
+    return board->cap.state == CAPTURE_REC;
 }
 
-int  boardCaptureIsPlaying() {
-    return cap.state == CAPTURE_PLAY;
+int  boardCaptureIsPlaying(BoardContext* board) {
+    return board->cap.state == CAPTURE_PLAY;
 }
 
-int boardCaptureCompleteAmount() {
-    UInt64 length = (cap.endTime64 - cap.startTime64) / 1000;
-    UInt64 current = (boardSysTime64 - cap.startTime64) / 1000;
+int boardCaptureCompleteAmount(BoardContext* board) {
+    UInt64 length = (board->cap.endTime64 - board->cap.startTime64) / 1000;
+    UInt64 current = (board->boardSysTime64 - board->cap.startTime64) / 1000;
     // Return complete if almost complete
-    if (cap.endTime64 - boardSysTime64 < HIRES_CYCLES_PER_LORES_CYCLE * 100) {
+    if (board->cap.endTime64 - board->boardSysTime64 < HIRES_CYCLES_PER_LORES_CYCLE * 100) {
         return 1000;
     }
     if (length == 0) {
@@ -255,9 +483,11 @@ int boardCaptureCompleteAmount() {
 
 extern void actionEmuTogglePause();
 
-static void boardTimerCb(void* dummy, UInt32 time)
+static void boardTimerCb(void* ref, UInt32 time)
 {
-    if (cap.state == CAPTURE_PLAY) {
+    BoardContext* board = (BoardContext*)ref;
+
+    if (board->cap.state == CAPTURE_PLAY) {
         // If we reached the end time +/- 2 seconds we know we should stop
         // the capture. If not, we restart the timer 1/4 of max time into
         // the future. (Enventually we'll hit the real end time
@@ -265,412 +495,634 @@ static void boardTimerCb(void* dummy, UInt32 time)
         // (~3 minutes). Using the 64 bit timer we can extend the capture to
         // 90 days.
         // Will work correct with 'real' 64 bit timers
-        boardSystemTime64(); // Sync clock
-        if (boardCaptureCompleteAmount() < 1000) {
-            boardTimerAdd(cap.timer, time + 0x40000000);
+        boardSystemTime64(board); // Sync clock
+        if (boardCaptureCompleteAmount(board) < 1000) {
+            boardTimerAdd(board->cap.timer, time + 0x40000000);
         }
         else {
             actionEmuTogglePause();
-            cap.state = CAPTURE_IDLE;
+            board->cap.state = CAPTURE_IDLE;
+            captureFileClose(board->cap.file);
+            board->cap.file = NULL;
         }
     }
     
-    if (cap.state == CAPTURE_REC) {
-        cap.state = CAPTURE_IDLE;
-        boardCaptureStart(cap.filename);
+    if (board->cap.state == CAPTURE_REC) {
+        board->cap.state = CAPTURE_IDLE;
+        boardCaptureStart(board, board->cap.filename);
     }
 }
 
-void boardCaptureInit()
+static void boardCaptureWriteKeyframe(BoardContext* board)
 {
-    cap.timer = boardTimerCreate(boardTimerCb, NULL);
-    if (cap.state == CAPTURE_REC) {
-        boardTimerAdd(cap.timer, boardSystemTime() + 1);
+    void* image;
+    int size;
+
+    rleEncFlush(board);
+
+    saveStateCreateForImageWrite(board);
+    boardWriteState(board, board->cap.filename, 0);
+    image = saveStateDestroyImage(board, &size);
+
+    if (image != NULL) {
+        captureFileWriteChunk(board->cap.file, CAPTURE_CHUNK_STATE, boardSystemTime(board), boardSystemTime64(board),
+                              image, size);
+        free(image);
     }
 }
 
-void boardCaptureDestroy()
+static void boardKeyframeTimerCb(void* ref, UInt32 time)
 {
-    boardCaptureStop();
+    BoardContext* board = (BoardContext*)ref;
 
-    if (cap.timer != NULL) {
-        boardTimerDestroy(cap.timer);
-        cap.timer = NULL;
+    if (board->cap.state == CAPTURE_REC) {
+        boardCaptureWriteKeyframe(board);
+        boardTimerAdd(board->cap.keyframeTimer, time + boardFrequency() / 1000 * CAPTURE_KEYFRAME_PERIOD);
     }
-    cap.state = CAPTURE_IDLE;
 }
 
-void boardCaptureStart(const char* filename) {
-    FILE* f;
+// Opens a capture file for playback from the last keyframe at or before
+// time64 from the start of the capture and makes the keyframe the current
+// save state. Returns 0 if the file is not a capture or the keyframe can't
+// be read.
+static int boardCaptureOpenKeyframe(BoardContext* board, const char* fileName, UInt64 time64)
+{
+    CaptureFile* file;
+    CaptureChunkType type;
+    UInt32 time;
+    UInt32 size;
+    int keyframe;
+    int success = 0;
 
-    if (cap.state == CAPTURE_REC) {
-        return;
+    if (!captureFileIsCapture(fileName)) {
+        return 0;
     }
 
-    // If we're playing back a capture, we just start recording from where we're at
-    // and new recording will be appended to old recording
-    if (cap.state == CAPTURE_PLAY) {
-        cap.state = CAPTURE_REC;
-        return;
+    file = captureFileOpen(fileName);
+    if (file == NULL) {
+        return 0;
+    }
+
+    keyframe = captureFileFindKeyframe(file, captureFileGetStartTime64(file) + time64);
+    if (keyframe >= 0 && 
+        captureFileSeek(file, captureFileGetKeyframeOffset(file, keyframe)) &&
+        captureFileNextChunk(file, &type, &time, &time64, &size) &&
+        type == CAPTURE_CHUNK_STATE) 
+    {
+        void* image = malloc(size);
+        if (captureFileReadData(file, image, size)) {
+            success = saveStateCreateForImageRead(board, image, size);
+        }
+        free(image);
     }
 
-    strcpy(cap.filename, filename);
+    if (!success) {
+        captureFileClose(file);
+        return 0;
+    }
 
-    // If emulation is not running we want to start recording once 
-    // the emulation is started
-    if (cap.timer == NULL) {
-        cap.state = CAPTURE_REC;
-        return;
+    captureFileClose(board->cap.file);
+    board->cap.file = file;
+    board->cap.playback = 1;
+    if (fileName != board->cap.filename) {
+        strcpy(board->cap.filename, fileName);
     }
 
-    cap.initStateSize = 0;
-    boardSaveState("cap.tmp", 1);
-    f = fopen("cap.tmp", "rb");
-    if (f != NULL) {
-        cap.initStateSize = fread(cap.initState, 1, sizeof(cap.initState), f);
-        fclose(f);
+    return 1;
+}
+
+int boardCaptureSeek(BoardContext* board, int amount)
+{
+    UInt64 time64;
+
+    if (!board->boardRunning || board->cap.state != CAPTURE_PLAY) {
+        return 0;
     }
 
-    if (cap.initStateSize > 0) {
-        rleEncStartEncode(cap.inputs, sizeof(cap.inputs), 0);
-        cap.state = CAPTURE_REC;
+    time64 = (board->cap.endTime64 - board->cap.startTime64) / 1000 * amount;
+
+    if (!boardCaptureOpenKeyframe(board, board->cap.filename, time64)) {
+        return 0;
     }
 
-    cap.startTime64 = boardSystemTime64();
+    return boardRestoreCurrentState(board);
 }
 
-void boardCaptureStop() {
-    boardTimerRemove(cap.timer);
+int boardCaptureGetKeyframes(const char* fileName, UInt64* times, int maxCount, UInt64* length)
+{
+    CaptureFile* file;
+    UInt64 startTime64;
+    int count;
+    int i;
 
-    if (cap.state == CAPTURE_REC) {
-        SaveState* state;
-        FILE* f;
+    if (!captureFileIsCapture(fileName)) {
+        return 0;
+    }
 
-        cap.endTime = boardSystemTime();
-        cap.endTime64 = boardSystemTime64();
-        cap.state = CAPTURE_PLAY;
-        cap.inputCnt = rleEncGetLength();
+    file = captureFileOpen(fileName);
+    if (file == NULL) {
+        return 0;
+    }
 
-        f = fopen(cap.filename, "wb");
-        if (f != NULL) {
-            fwrite(cap.initState, 1, cap.initStateSize, f);
-            fclose(f);
-        }
+    startTime64 = captureFileGetStartTime64(file);
+    count = captureFileGetKeyframeCount(file);
 
-        saveStateCreateForWrite(cap.filename);
+    for (i = 0; i < count && i < maxCount; i++) {
+        times[i] = (captureFileGetKeyframeTime64(file, i) - startTime64) / HIRES_CYCLES_PER_LORES_CYCLE;
+    }
+    if (length != NULL) {
+        *length = (captureFileGetEndTime64(file) - startTime64) / HIRES_CYCLES_PER_LORES_CYCLE;
+    }
 
-        state = saveStateOpenForWrite("capture");
+    captureFileClose(file);
 
-        saveStateSet(state, "version", CAPTURE_VERSION);
+    return count;
+}
 
-        saveStateSet(state, "state", cap.state);
-        saveStateSet(state, "endTime", cap.endTime);
-        saveStateSet(state, "endTime64Hi", (UInt32)(cap.endTime64 >> 32));
-        saveStateSet(state, "endTime64Lo", (UInt32)cap.endTime64);
-        saveStateSet(state, "inputCnt", cap.inputCnt);
-        
-        if (cap.inputCnt > 0) {
-            saveStateSetBuffer(state, "inputs", cap.inputs, cap.inputCnt * sizeof(RleData));
+void boardCaptureSetPlaybackStart(BoardContext* board, UInt64 time)
+{
+    board->cap.playbackStart64 = time * HIRES_CYCLES_PER_LORES_CYCLE;
+}
+
+void boardCaptureInit(BoardContext* board)
+{
+    board->cap.timer = boardTimerCreate(board, boardTimerCb, board);
+    board->cap.keyframeTimer = boardTimerCreate(board, boardKeyframeTimerCb, board);
+    if (board->cap.state == CAPTURE_REC) {
+        boardTimerAdd(board->cap.timer, boardSystemTime(board) + 1);
+    }
+}
+
+void boardCaptureDestroy(BoardContext* board)
+{
+    boardCaptureStop(board);
+
+    if (board->cap.timer != NULL) {
+        boardTimerDestroy(board->cap.timer);
+        board->cap.timer = NULL;
+    }
+    if (board->cap.keyframeTimer != NULL) {
+        boardTimerDestroy(board->cap.keyframeTimer);
+        board->cap.keyframeTimer = NULL;
+    }
+    captureFileClose(board->cap.file);
+    board->cap.file = NULL;
+    board->cap.playback = 0;
+    board->cap.state = CAPTURE_IDLE;
+}
+
+void boardCaptureStart(BoardContext* board, const char* filename) {
+    if (board->cap.state == CAPTURE_REC) {
+        return;
+    }
+
+    // If we're playing back a capture, we just start recording from where we're at
+    // and new recording will be appended to old recording
+    if (board->cap.state == CAPTURE_PLAY) {
+        // Inputs of the current chunk that are not played yet are dropped
+        if (board->rleIdx >= 0) {
+            RleData* rle = &board->rleData[board->rleIdx];
+            rle->count = (UInt16)((rle->count != 0 ? rle->count : 0x10000) - board->rleLeft);
         }
+        boardTimerRemove(board->cap.timer);
+        captureFileClose(board->cap.file);
+        board->cap.file = captureFileOpenForWrite(board->cap.filename, board->cap.chunkOffset);
+        if (board->cap.file == NULL) {
+            board->cap.state = CAPTURE_IDLE;
+            return;
+        }
+        board->rleDataSize = CAPTURE_CHUNK_ENTRIES;
+        board->cap.state = CAPTURE_REC;
+        boardTimerAdd(board->cap.keyframeTimer, boardSystemTime(board) + boardFrequency() / 1000 * CAPTURE_KEYFRAME_PERIOD);
+        return;
+    }
 
-        saveStateClose(state);
-        saveStateDestroy();
+    strcpy(board->cap.filename, filename);
+
+    // If emulation is not running we want to start recording once 
+    // the emulation is started
+    if (board->cap.timer == NULL) {
+        board->cap.state = CAPTURE_REC;
+        return;
+    }
+
+    captureFileClose(board->cap.file);
+    board->cap.file = captureFileCreate(filename);
+    if (board->cap.file == NULL) {
+        return;
+    }
+
+    rleEncStartEncode(board, 1);
+    board->cap.state = CAPTURE_REC;
+    board->cap.startTime64 = boardSystemTime64(board);
+
+    // The capture starts with a keyframe of the initial state
+    boardCaptureWriteKeyframe(board);
+    boardTimerAdd(board->cap.keyframeTimer, boardSystemTime(board) + boardFrequency() / 1000 * CAPTURE_KEYFRAME_PERIOD);
+}
+
+void boardCaptureStop(BoardContext* board) {
+    boardTimerRemove(board->cap.timer);
+    boardTimerRemove(board->cap.keyframeTimer);
+
+    if (board->cap.state == CAPTURE_REC && board->cap.file != NULL) {
+        rleEncFlush(board);
+
+        board->cap.endTime = boardSystemTime(board);
+        board->cap.endTime64 = boardSystemTime64(board);
+
+        captureFileWriteChunk(board->cap.file, CAPTURE_CHUNK_END, board->cap.endTime, board->cap.endTime64, NULL, 0);
     }
 
+    captureFileClose(board->cap.file);
+    board->cap.file = NULL;
+
     // go back to idle state
-    cap.state = CAPTURE_IDLE;
+    board->cap.state = CAPTURE_IDLE;
 }
 
-UInt8 boardCaptureUInt8(UInt8 logId, UInt8 value) {
-    if (cap.state == CAPTURE_REC) {
-        rleEncAdd(logId, value);
-        if (rleEncEof()) {
-            boardCaptureStop();
-        }
+UInt8 boardCaptureUInt8(BoardContext* board, UInt8 logId, UInt8 value) {
+    if (board->cap.state == CAPTURE_REC) {
+        rleEncAdd(board, logId, value);
     }
-    if (cap.state == CAPTURE_PLAY) {
-        if (!rleEncEof()) {
-            value= rleEncGet(logId);
-        }
+    if (board->cap.state == CAPTURE_PLAY) {
+        value = rleEncGet(board, logId, value);
     }
     return value;
 }
 
-static void boardCaptureSaveState()
+static void boardCaptureSaveState(BoardContext* board)
 {
-    if (cap.state == CAPTURE_REC) {
-        SaveState* state = saveStateOpenForWrite("capture");
+    if (board->cap.state == CAPTURE_REC && board->cap.file != NULL) {
+        SaveState* state = saveStateOpenForWrite(board, "capture");
+        UInt64 offset = captureFileGetOffset(board->cap.file);
 
-        cap.inputCnt = rleEncGetLength();
+        board->cap.inputCnt = rleEncGetLength(board);
 
         saveStateSet(state, "version", CAPTURE_VERSION);
 
-        saveStateSet(state, "state", cap.state);
-        saveStateSet(state, "endTime", cap.endTime);
-        saveStateSet(state, "endTime64Hi", (UInt32)(cap.endTime64 >> 32));
-        saveStateSet(state, "endTime64Lo", (UInt32)cap.endTime64);
-        saveStateSet(state, "inputCnt", cap.inputCnt);
-        if (cap.inputCnt > 0) {
-            saveStateSetBuffer(state, "inputs", cap.inputs, cap.inputCnt * sizeof(RleData));
-        }
-        saveStateSet(state, "initStateSize", cap.initStateSize);
-        if (cap.initStateSize > 0) {
-            saveStateSetBuffer(state, "initState", cap.initState, cap.initStateSize);
+        saveStateSet(state, "state", board->cap.state);
+        saveStateSet(state, "startTime64Hi", (UInt32)(board->cap.startTime64 >> 32));
+        saveStateSet(state, "startTime64Lo", (UInt32)board->cap.startTime64);
+        saveStateSet(state, "offsetHi", (UInt32)(offset >> 32));
+        saveStateSet(state, "offsetLo", (UInt32)offset);
+        saveStateSet(state, "inputCnt", board->cap.inputCnt);
+        if (board->cap.inputCnt > 0) {
+            saveStateSetBuffer(state, "inputs", board->cap.inputs, board->cap.inputCnt * sizeof(RleData));
         }
+        saveStateSetBuffer(state, "filename", board->cap.filename, strlen(board->cap.filename) + 1);
         
-        saveStateSetBuffer(state, "rleCache", rleCache, sizeof(rleCache));
+        saveStateSetBuffer(state, "rleCache", board->rleCache, sizeof(board->rleCache));
 
         saveStateClose(state);
     }
 }
 
-static void boardCaptureLoadState()
+static void boardCaptureLoadState(BoardContext* board)
 {
     int version;
+    UInt64 offset;
 
-    SaveState* state = saveStateOpenForRead("capture");
+    SaveState* state = saveStateOpenForRead(board, "capture");
 
     version = saveStateGet(state, "version", 0);
 
-    cap.state = saveStateGet(state, "state", CAPTURE_IDLE);
-    cap.endTime = saveStateGet(state, "endTime", 0);
-    cap.endTime64 = (UInt64)saveStateGet(state, "endTime64Hi", 0) << 32 |
-                    (UInt64)saveStateGet(state, "endTime64Lo", 0);
-    cap.inputCnt = saveStateGet(state, "inputCnt", 0);
-    if (cap.inputCnt > 0) {
-        saveStateGetBuffer(state, "inputs", cap.inputs, cap.inputCnt * sizeof(RleData));
+    board->cap.state = saveStateGet(state, "state", CAPTURE_IDLE);
+    board->cap.startTime64 = (UInt64)saveStateGet(state, "startTime64Hi", 0) << 32 |
+                    (UInt64)saveStateGet(state, "startTime64Lo", 0);
+    offset = (UInt64)saveStateGet(state, "offsetHi", 0) << 32 |
+             (UInt64)saveStateGet(state, "offsetLo", 0);
+    board->cap.inputCnt = saveStateGet(state, "inputCnt", 0);
+    if (board->cap.inputCnt > CAPTURE_CHUNK_ENTRIES) {
+        board->cap.inputCnt = CAPTURE_CHUNK_ENTRIES;
     }
-    cap.initStateSize = saveStateGet(state, "initStateSize", 0);
-    if (cap.initStateSize > 0) {
-        saveStateGetBuffer(state, "initState", cap.initState, cap.initStateSize);
+    if (board->cap.inputCnt > 0) {
+        saveStateGetBuffer(state, "inputs", board->cap.inputs, board->cap.inputCnt * sizeof(RleData));
+    }
+    if (!board->cap.playback) {
+        saveStateGetBuffer(state, "filename", board->cap.filename, sizeof(board->cap.filename) - 1);
     }
         
-    saveStateGetBuffer(state, "rleCache", rleCache, sizeof(rleCache));
+    saveStateGetBuffer(state, "rleCache", board->rleCache, sizeof(board->rleCache));
 
     saveStateClose(state);
 
-    if (version != CAPTURE_VERSION) {
-        cap.state = CAPTURE_IDLE;
+    if (version != CAPTURE_VERSION || board->cap.state != CAPTURE_REC) {
+        board->cap.state = CAPTURE_IDLE;
+        board->cap.playback = 0;
+        captureFileClose(board->cap.file);
+        board->cap.file = NULL;
         return;
     }
 
-    if (cap.state == CAPTURE_PLAY) {
-        rleEncStartDecode(cap.inputs, cap.inputCnt);
+    // A keyframe of a capture that is being played back
+    if (board->cap.playback) {
+        board->cap.playback = 0;
+        board->cap.state = CAPTURE_PLAY;
+        board->cap.endTime = captureFileGetEndTime(board->cap.file);
+        board->cap.endTime64 = captureFileGetEndTime64(board->cap.file);
+        board->cap.startTime64 = captureFileGetStartTime64(board->cap.file);
+        board->cap.chunkOffset = offset;
+        captureFileSeek(board->cap.file, offset);
+
+        rleEncStartDecode(board);
 
-        while (cap.endTime - boardSystemTime() > 0x40000000 || cap.endTime == boardSystemTime()) {
-            cap.endTime -= 0x40000000;
+        while (board->cap.endTime - boardSystemTime(board) > 0x40000000 || board->cap.endTime == boardSystemTime(board)) {
+            board->cap.endTime -= 0x40000000;
         }
-        boardTimerAdd(cap.timer, cap.endTime);
+        boardTimerAdd(board->cap.timer, board->cap.endTime);
+        return;
     }
-    
-    if (cap.state == CAPTURE_REC) {
-        rleEncStartEncode(cap.inputs, sizeof(cap.inputs), cap.inputCnt);
+
+    // Continue a recording from the point the state was saved at
+    captureFileClose(board->cap.file);
+    board->cap.file = captureFileOpenForWrite(board->cap.filename, offset);
+    if (board->cap.file == NULL) {
+        board->cap.state = CAPTURE_IDLE;
+        return;
     }
+
+    rleEncStartEncode(board, 0);
+    board->rleIdx = board->cap.inputCnt - 1;
+    boardTimerAdd(board->cap.keyframeTimer, boardSystemTime(board) + boardFrequency() / 1000 * CAPTURE_KEYFRAME_PERIOD);
 }
 
 //------------------------------------------------------
 
 
-int boardGetNoSpriteLimits() {
-    return vdpGetNoSpritesLimit();
+int boardGetNoSpriteLimits(BoardContext* board) {
+    return board->noSpriteLimits;
 }
 
-void boardSetNoSpriteLimits(int enable) {
-    vdpSetNoSpriteLimits(enable);
+void boardSetNoSpriteLimits(BoardContext* board, int enable) {
+    board->noSpriteLimits = enable ? 1 : 0;
 }
 
-RomType boardGetRomType(int cartNo)
+int boardGetSpritesEnable(BoardContext* board) {
+    return board->spritesEnable;
+}
+
+void boardSetSpritesEnable(BoardContext* board, int enable) {
+    board->spritesEnable = enable ? 1 : 0;
+}
+
+int boardGetDisplayEnable(BoardContext* board) {
+    return board->displayEnable;
+}
+
+void boardSetDisplayEnable(BoardContext* board, int enable) {
+    board->displayEnable = enable ? 1 : 0;
+}
+
+void boardSetVdp(BoardContext* board, VDP* vdp) {
+    board->vdp = vdp;
+}
+
+VDP* boardGetVdp(BoardContext* board) {
+    return board->vdp;
+}
+
+RomType boardGetRomType(BoardContext* board, int cartNo)
 {
-    return currentRomType[cartNo];
+    return board->currentRomType[cartNo];
 }
 
-int boardGetFdcTimingEnable() {
-    return fdcTimingEnable;
+int boardGetFdcTimingEnable(BoardContext* board) {
+    return board->fdcTimingEnable;
 }
 
-void boardSetFdcTimingEnable(int enable) {
-    fdcTimingEnable = enable;
+void boardSetFdcTimingEnable(BoardContext* board, int enable) {
+    board->fdcTimingEnable = enable;
 }
 
-void boardSetFdcActive() {
-    if (!fdcTimingEnable) {
-        boardTimerAdd(fdcTimer, boardSystemTime() + (UInt32)((UInt64)500 * boardFrequency() / 1000));
-        fdcActive = 1;
+void boardSetFdcActive(BoardContext* board) {
+    if (!board->fdcTimingEnable) {
+        boardTimerAdd(board->fdcTimer, boardSystemTime(board) + (UInt32)((UInt64)500 * boardFrequency() / 1000));
+        board->fdcActive = 1;
     }
 }
 
-void boardSetBreakpoint(UInt16 address) {
-    if (boardRunning) {
-        boardInfo.setBreakpoint(boardInfo.cpuRef, address);
+void boardSetBreakpoint(BoardContext* board, UInt16 address) {
+    if (board->boardRunning) {
+        board->boardInfo.setBreakpoint(board->boardInfo.cpuRef, address);
     }
 }
 
-void boardClearBreakpoint(UInt16 address) {
-    if (boardRunning) {
-        boardInfo.clearBreakpoint(boardInfo.cpuRef, address);
+void boardClearBreakpoint(BoardContext* board, UInt16 address) {
+    if (board->boardRunning) {
+        board->boardInfo.clearBreakpoint(board->boardInfo.cpuRef, address);
     }
 }
 
 static void onFdcDone(void* ref, UInt32 time)
 {
-    fdcActive = 0;
+    BoardContext* board = (BoardContext*)ref;
+
+    board->fdcActive = 0;
 }
 
-static void doSync(UInt32 time, int breakpointHit)
+static void doSync(BoardContext* board, UInt32 time, int breakpointHit)
 {
     int execTime = 10;
-    if (!skipSync) {
-        execTime = syncToRealClock(fdcActive, breakpointHit);
+    board->syncStateLoaded = 0;
+    if (!board->skipSync && board->runAheadLeft == 0) {
+        execTime = board->syncToRealClock(board->fdcActive, breakpointHit);
+    }
+    if (board->syncStateLoaded) {
+        // A state loaded from the sync callback moved the system time
+        time = boardSystemTime(board);
     }
     if (execTime == -99) {
-        boardInfo.stop(boardInfo.cpuRef);
+        board->boardInfo.stop(board->boardInfo.cpuRef);
         return;
     }
 
-    boardSystemTime64();
+    boardSystemTime64(board);
 
     if (execTime == 0) {
-        boardTimerAdd(syncTimer, boardSystemTime() + 1);
+        boardTimerAdd(board->syncTimer, boardSystemTime(board) + 1);
     }
     else if (execTime < 0) {
         execTime = -execTime;
-        boardTimerAdd(syncTimer, boardSystemTime() + (UInt32)((UInt64)execTime * boardFreq / 1000));
+        boardTimerAdd(board->syncTimer, boardSystemTime(board) + (UInt32)((UInt64)execTime * board->boardFreq / 1000));
     }
     else {
-        boardTimerAdd(syncTimer, time + (UInt32)((UInt64)execTime * boardFreq / 1000));
+        boardTimerAdd(board->syncTimer, time + (UInt32)((UInt64)execTime * board->boardFreq / 1000));
     }
 }
 
 static void onMixerSync(void* ref, UInt32 time)
 {
-    mixerSync(boardMixer);
+    BoardContext* board = (BoardContext*)ref;
 
-    boardTimerAdd(mixerTimer, boardSystemTime() + boardFrequency() / 50);
+    mixerSync(board->boardMixer);
+
+    boardTimerAdd(board->mixerTimer, boardSystemTime(board) + boardFrequency() / 50);
 }
 
 static void onStateSync(void* ref, UInt32 time)
-{    
-    if (enableSnapshots) {
-        char memFilename[8];
-        ramStateCur = (ramStateCur + 1) % ramMaxStates;
-        if (ramStateCount < ramMaxStates) {
-            ramStateCount++;
-        }
+{
+    BoardContext* board = (BoardContext*)ref;
 
-        sprintf(memFilename, "mem%d", ramStateCur);
-        
-        boardSaveState(memFilename, 0);
+    if (board->enableSnapshots && board->runAheadLeft == 0) {
+        boardSaveState(board, "mem", 0);
+        rewindBufferCommit(board->rewindBuffer);
     }
 
-    boardTimerAdd(stateTimer, boardSystemTime() + stateFrequency);
+    boardTimerAdd(board->stateTimer, boardSystemTime(board) + board->stateFrequency);
 }
 
 static void onSync(void* ref, UInt32 time)
 {
-    doSync(time, 0);
+    BoardContext* board = (BoardContext*)ref;
+
+    doSync(board, time, 0);
 }
 
-void boardOnBreakpoint(UInt16 pc)
+void boardOnBreakpoint(BoardContext* board, UInt16 pc)
 {
-    doSync(boardSystemTime(), 1);
+    doSync(board, boardSystemTime(board), 1);
 }
 
-int boardInsertExternalDevices()
+int boardInsertExternalDevices(BoardContext* board)
 {
     int i;
     for (i = 0; i < 2; i++) {
-        if (boardDeviceInfo->carts[i].inserted) {
-            boardChangeCartridge(i, boardDeviceInfo->carts[i].type, 
-                                 boardDeviceInfo->carts[i].name,
-                                 boardDeviceInfo->carts[i].inZipName);
+        if (board->boardDeviceInfo->carts[i].inserted) {
+            boardChangeCartridge(board, i, board->boardDeviceInfo->carts[i].type, 
+                                 board->boardDeviceInfo->carts[i].name,
+                                 board->boardDeviceInfo->carts[i].inZipName);
         }
     }
 
     for (i = 0; i < MAXDRIVES; i++) {
-        if (boardDeviceInfo->disks[i].inserted) {
-            boardChangeDiskette(i, boardDeviceInfo->disks[i].name,
-                                boardDeviceInfo->disks[i].inZipName);
+        if (board->boardDeviceInfo->disks[i].inserted) {
+            boardChangeDiskette(board, i, board->boardDeviceInfo->disks[i].name,
+                                board->boardDeviceInfo->disks[i].inZipName);
         }
     }
 
-    if (boardDeviceInfo->tapes[0].inserted) {
-        boardChangeCassette(0, boardDeviceInfo->tapes[0].name,
-                            boardDeviceInfo->tapes[0].inZipName);
+    if (board->boardDeviceInfo->tapes[0].inserted) {
+        boardChangeCassette(board, 0, board->boardDeviceInfo->tapes[0].name,
+                            board->boardDeviceInfo->tapes[0].inZipName);
     }
     return 1;
 }
 
-int boardRemoveExternalDevices()
+int boardRemoveExternalDevices(BoardContext* board)
 {
-     boardChangeDiskette(0, NULL, NULL);
-     boardChangeDiskette(1, NULL, NULL);
+     boardChangeDiskette(board, 0, NULL, NULL);
+     boardChangeDiskette(board, 1, NULL, NULL);
 
-     boardChangeCassette(0, NULL, NULL);
+     boardChangeCassette(board, 0, NULL, NULL);
 
      return 1;
 }
 
-static void onBreakpointSync(void* ref, UInt32 time) {
-    skipSync = 0;
-    doSync(time, 1);
+static void onBreakpointSync(void* ref, UInt32 time)
+{
+    BoardContext* board = (BoardContext*)ref;
+
+    board->skipSync = 0;
+    doSync(board, time, 1);
 }
 
-int boardRewindOne() {
+int boardRewindOne(BoardContext* board) {
     UInt32 rewindTime;
-    if (stateFrequency <= 0) {
+    if (board->stateFrequency <= 0) {
         return 0;
     }
-    rewindTime = boardInfo.getTimeTrace(1);
-    if (rewindTime == 0 || !boardRewind()) {
+    rewindTime = board->boardInfo.getTimeTrace(board->boardInfo.ref, 1);
+    if (!boardRewind(board)) {
         return 0;
     }
-    boardTimerAdd(breakpointTimer, rewindTime);
-    skipSync = 1;
+    // The lean CPU cores keep no time trace, so there is no previous
+    // instruction to go back to. The step then stops at the first
+    // instruction after the snapshot instead.
+    if (rewindTime == 0) {
+        rewindTime = boardSystemTime(board);
+    }
+    boardTimerAdd(board->breakpointTimer, rewindTime);
+    board->skipSync = 1;
     return 1;
 }
 
-int boardRewind()
+int boardRewind(BoardContext* board)
 {
-    char stateFile[8];
+    if (board->rewindBuffer == NULL || rewindBufferGetCount(board->rewindBuffer) < 2 || 
+        !rewindBufferRewind(board->rewindBuffer)) 
+    {
+        return 0;
+    }
+
+    return boardRestoreState(board, "mem");
+}
 
-    if (ramStateCount < 2) {
+int boardRestoreState(BoardContext* board, const char* stateFile)
+{
+    if (!board->boardRunning) {
         return 0;
     }
 
-    ramStateCount--;
-    sprintf(stateFile, "mem%d", ramStateCur);
-    ramStateCur = (ramStateCur + ramMaxStates - 1) % ramMaxStates;
+    saveStateCreateForRead(board, stateFile);
 
-    boardTimerCleanup();
+    return boardRestoreCurrentState(board);
+}
 
-    saveStateCreateForRead(stateFile);
+// Loads the state opened by saveStateCreateForRead() into the running machine
+static int boardRestoreCurrentState(BoardContext* board)
+{
+    SaveState* state;
+
+    boardTimerCleanup(board);
+
+    if (board->runAheadLeft > 0) {
+        board->runAheadLeft = 0;
+        mixerSetHold(board->boardMixer, 0);
+    }
 
 //    boardType = boardLoadState();
 //    machineLoadState(boardMachine);
 
-    boardInfo.loadState();
-    boardCaptureLoadState();
+    board->boardInfo.loadState(board->boardInfo.ref);
+
+    timerRestoreAnchor(board, boardSystemTime(board));
+
+    // The 64 bit time is used by capture playback and must follow the
+    // restored system time
+    state = saveStateOpenForRead(board, "board");
+    board->boardSysTime64 = (UInt64)saveStateGet(state, "boardSysTime64Hi", 0) << 32 |
+                     (UInt64)saveStateGet(state, "boardSysTime64Lo", 0);
+    board->oldTime        = saveStateGet(state, "oldTime", 0);
+    saveStateClose(state);
+
+    boardCaptureLoadState(board);
+
+    saveStateDestroy(board);
+
+    board->syncStateLoaded = 1;
 
 #if 1
-    if (stateFrequency > 0) {
-        boardTimerAdd(stateTimer, boardSystemTime() + stateFrequency);
+    if (board->stateFrequency > 0) {
+        boardTimerAdd(board->stateTimer, boardSystemTime(board) + board->stateFrequency);
     }
     //boardTimerAdd(syncTimer, boardSystemTime() + 1);
-    boardTimerAdd(mixerTimer, boardSystemTime() + boardFrequency() / 50);
+    boardTimerAdd(board->mixerTimer, boardSystemTime(board) + boardFrequency() / 50);
     
     if (boardPeriodicCallback != NULL) {
-        boardTimerAdd(periodicTimer, boardSystemTime() + periodicInterval);
+        boardTimerAdd(board->periodicTimer, boardSystemTime(board) + board->periodicInterval);
     }
 #endif
     return 1;
 }
 
-void boardEnableSnapshots(int enable)
+void boardEnableSnapshots(BoardContext* board, int enable)
 {
-    enableSnapshots = enable;
+    board->enableSnapshots = enable;
 }
 
-int boardRun(Machine* machine, 
+int boardRun(BoardContext* board,
+             Machine* machine, 
              BoardDeviceInfo* deviceInfo,
              Mixer* mixer,
              char* stateFile,
@@ -682,242 +1134,279 @@ int boardRun(Machine* machine,
     int loadState = 0;
     int success = 0;
 
-    syncToRealClock = syncCallback;
+    board->syncToRealClock = syncCallback;
 
-    videoManagerReset();
-    debugDeviceManagerReset();
+    videoManagerReset(board);
+    debugDeviceManagerReset(board);
 
-    boardMixer      = mixer;
-    boardDeviceInfo = deviceInfo;
-    boardMachine    = machine;
+    board->boardMixer      = mixer;
+    mixerSetBoard(mixer, board);
+    board->boardDeviceInfo = deviceInfo;
+    board->boardMachine    = machine;
 
-    boardUpdateDisketteInfo();
+    boardUpdateDisketteInfo(board);
 
     if (stateFile != NULL) {
         int   size;
         char *version;
 
-        saveStateCreateForRead(stateFile);
+        // Playback of a capture starts at its first keyframe unless
+        // another start time is set
+        if (!boardCaptureOpenKeyframe(board, stateFile, board->cap.playbackStart64)) {
+            saveStateCreateForRead(board, stateFile);
+        }
+        board->cap.playbackStart64 = 0;
 
-        version = zipLoadFile(stateFile, "version", &size);
+        version = saveStateReadFile(board, "version", &size);
         if (version != NULL) {
             if (0 == strncmp(version, saveStateVersion, sizeof(saveStateVersion) - 1)) {
                 loadState = 1;
 
-                boardType = boardLoadState();
+                board->boardType = boardLoadState(board);
 
-                machineLoadState(boardMachine);
+                machineLoadState(board, board->boardMachine);
             }
             free(version);
         }
     }
 
-    boardType = machine->board.type;
-    PatchReset(boardType);
+    board->boardType = machine->board.type;
+    board->patchEnabled = 0;
 
 #if 0
-    useRom     = 0;
-    useMegaRom = 0;
-    useMegaRam = 0;
-    useFmPac   = 0;
-    currentRomType[0] = ROM_UNKNOWN;
-    currentRomType[1] = ROM_UNKNOWN;
+    board->useRom     = 0;
+    board->useMegaRom = 0;
+    board->useMegaRam = 0;
+    board->useFmPac   = 0;
+    board->currentRomType[0] = ROM_UNKNOWN;
+    board->currentRomType[1] = ROM_UNKNOWN;
 #endif
 
-    pendingInt = 0;
+    board->pendingInt = 0;
 
-    boardSetFrequency(frequency);
+    boardSetFrequency(board, frequency);
 
-    memset(&boardInfo, 0, sizeof(boardInfo));
+    memset(&board->boardInfo, 0, sizeof(board->boardInfo));
 
-    boardRunning = 1;
-    switch (boardType) {
+    board->boardRunning = 1;
+    switch (board->boardType) {
     case BOARD_MSX:
     case BOARD_MSX_S3527:
     case BOARD_MSX_S1985:
     case BOARD_MSX_T9769B:
     case BOARD_MSX_T9769C:
     case BOARD_MSX_FORTE_II:
-        success = msxCreate(machine, deviceInfo->video.vdpSyncMode, &boardInfo);
+        success = msxCreate(board, machine, deviceInfo->video.vdpSyncMode, &board->boardInfo);
         break;
     case BOARD_SVI:
-        success = sviCreate(machine, deviceInfo->video.vdpSyncMode, &boardInfo);
+        success = sviCreate(board, machine, deviceInfo->video.vdpSyncMode, &board->boardInfo);
         break;
     case BOARD_COLECO:
-        success = colecoCreate(machine, deviceInfo->video.vdpSyncMode, &boardInfo);
+        success = colecoCreate(board, machine, deviceInfo->video.vdpSyncMode, &board->boardInfo);
         break;
     case BOARD_COLECOADAM:
-        success = adamCreate(machine, deviceInfo->video.vdpSyncMode, &boardInfo);
+        success = adamCreate(board, machine, deviceInfo->video.vdpSyncMode, &board->boardInfo);
         break;
     case BOARD_SG1000:
     case BOARD_SC3000:
     case BOARD_SF7000:
-        success = sg1000Create(machine, deviceInfo->video.vdpSyncMode, &boardInfo);
+        success = sg1000Create(board, machine, deviceInfo->video.vdpSyncMode, &board->boardInfo);
         break;
     default:
         success = 0;
     }
     
-    boardCaptureInit();
+    boardCaptureInit(board);
 
     if (success && loadState) {
-        boardInfo.loadState();
-        boardCaptureLoadState();
+        board->boardInfo.loadState(board->boardInfo.ref);
+        boardCaptureLoadState(board);
+
+        // The mixer was reset when the machine was created, before the
+        // state moved the system time
+        mixerReset(board->boardMixer);
     }
 
     if (stateFile != NULL) {
-        saveStateDestroy();
+        saveStateDestroy(board);
     }
 
     if (success) {
-        syncTimer = boardTimerCreate(onSync, NULL);
-        fdcTimer = boardTimerCreate(onFdcDone, NULL);
-        mixerTimer = boardTimerCreate(onMixerSync, NULL);
+        board->syncTimer = boardTimerCreate(board, onSync, board);
+        board->fdcTimer = boardTimerCreate(board, onFdcDone, board);
+        board->mixerTimer = boardTimerCreate(board, onMixerSync, board);
         
-        stateFrequency = boardFrequency() / 1000 * reversePeriod;
-
-        if (stateFrequency > 0) {
-            ramStateCur  = 0;
-            ramMaxStates = reverseBufferCnt;
-            memZipFileSystemCreate(ramMaxStates);
-            stateTimer = boardTimerCreate(onStateSync, NULL);
-            breakpointTimer = boardTimerCreate(onBreakpointSync, NULL); 
-            boardTimerAdd(stateTimer, boardSystemTime() + stateFrequency);
+        board->stateFrequency = boardFrequency() / 1000 * reversePeriod;
+
+        if (board->stateFrequency > 0) {
+            UInt32 arenaSize = reverseBufferCnt * REWIND_BYTES_PER_SNAPSHOT;
+            if (arenaSize < REWIND_MIN_ARENA_SIZE) {
+                arenaSize = REWIND_MIN_ARENA_SIZE;
+            }
+            board->rewindBuffer = rewindBufferCreate(reverseBufferCnt, arenaSize, REWIND_KEYFRAME_INTERVAL);
+            board->stateTimer = boardTimerCreate(board, onStateSync, board);
+            board->breakpointTimer = boardTimerCreate(board, onBreakpointSync, board); 
+            boardTimerAdd(board->stateTimer, boardSystemTime(board) + board->stateFrequency);
         }
         else {
-            stateTimer = NULL;
+            board->stateTimer = NULL;
         }
 
-        boardTimerAdd(syncTimer, boardSystemTime() + 1);
-        boardTimerAdd(mixerTimer, boardSystemTime() + boardFrequency() / 50);
+        boardTimerAdd(board->syncTimer, boardSystemTime(board) + 1);
+        boardTimerAdd(board->mixerTimer, boardSystemTime(board) + boardFrequency() / 50);
         
         if (boardPeriodicCallback != NULL) {
-            periodicTimer = boardTimerCreate(boardPeriodicCallback, periodicRef);
-            boardTimerAdd(periodicTimer, boardSystemTime() + periodicInterval);
+            board->periodicTimer = boardTimerCreate(board, boardPeriodicCallback, board);
+            boardTimerAdd(board->periodicTimer, boardSystemTime(board) + board->periodicInterval);
         }
 
-        if (!skipSync) {
-            syncToRealClock(0, 0);
+        if (!board->skipSync) {
+            board->syncToRealClock(0, 0);
         }
 
-        boardInfo.run(boardInfo.cpuRef);
+        // Frames started while the machine is set up are not run ahead
+        board->runAheadSnapshot = boardSnapshotCreate();
 
-        if (periodicTimer != NULL) {
-            boardTimerDestroy(periodicTimer);
-            periodicTimer = NULL;
+        board->boardInfo.run(board->boardInfo.cpuRef);
+
+        if (board->periodicTimer != NULL) {
+            boardTimerDestroy(board->periodicTimer);
+            board->periodicTimer = NULL;
         }
 
-        boardCaptureDestroy();
+        boardCaptureDestroy(board);
+
+        boardSnapshotDestroy(board->runAheadSnapshot);
+        board->runAheadSnapshot = NULL;
+        board->keepTimer = NULL;
+        if (board->runAheadLeft > 0) {
+            board->runAheadLeft = 0;
+            mixerSetHold(board->boardMixer, 0);
+        }
 
-        boardInfo.destroy();
+        board->boardInfo.destroy(board->boardInfo.ref);
 
-        boardTimerDestroy(fdcTimer);
-        boardTimerDestroy(syncTimer);
-        boardTimerDestroy(mixerTimer);
-        if (breakpointTimer != NULL) {
-            boardTimerDestroy(breakpointTimer);
+        boardTimerDestroy(board->fdcTimer);
+        boardTimerDestroy(board->syncTimer);
+        boardTimerDestroy(board->mixerTimer);
+        if (board->breakpointTimer != NULL) {
+            boardTimerDestroy(board->breakpointTimer);
+            board->breakpointTimer = NULL;
         }
-        if (stateTimer != NULL) {
-            boardTimerDestroy(stateTimer);
-            memZipFileSystemDestroy();
+        if (board->stateTimer != NULL) {
+            boardTimerDestroy(board->stateTimer);
+            rewindBufferDestroy(board->rewindBuffer);
+            board->rewindBuffer = NULL;
         }
     }
     else {
-        boardCaptureStop();
+        boardCaptureStop(board);
     }
 
-    boardRunning = 0;
+    board->boardRunning = 0;
 
     return success;
 }
 
-BoardType boardGetType()
+BoardType boardGetType(BoardContext* board)
 {
-    return boardType & BOARD_MASK;
+    return board->boardType & BOARD_MASK;
 }
 
-Mixer* boardGetMixer()
+BoardInfo* boardGetInfo(BoardContext* board)
 {
-    return boardMixer;
+    return &board->boardInfo;
 }
 
-void boardSetMachine(Machine* machine)
+Mixer* boardGetMixer(BoardContext* board)
+{
+    return board->boardMixer;
+}
+
+void boardSetMachine(BoardContext* board, Machine* machine)
 {
     int i;
     int hdIndex = FIRST_INTERNAL_HD_INDEX;
 
     // Update HD info
     for (i = FIRST_INTERNAL_HD_INDEX; i < MAX_HD_COUNT; i++) {
-        hdType[i] = HD_NONE;
+        board->hdType[i] = HD_NONE;
     }
     for (i = 0; i < machine->slotInfoCount; i++) {
         switch (machine->slotInfo[i].romType) {
-        case ROM_SUNRISEIDE:  hdType[hdIndex++] = HD_SUNRISEIDE; break;
-        case ROM_BEERIDE:     hdType[hdIndex++] = HD_BEERIDE;    break;
-        case ROM_GIDE:        hdType[hdIndex++] = HD_GIDE;       break;
-        case ROM_SVI328RSIDE: hdType[hdIndex++] = HD_RSIDE;      break;
-        case ROM_NOWIND:      hdType[hdIndex++] = HD_NOWIND;     break;
-        case SRAM_MEGASCSI:   hdType[hdIndex++] = HD_MEGASCSI;   break;
-        case SRAM_WAVESCSI:   hdType[hdIndex++] = HD_WAVESCSI;   break;
-        case ROM_GOUDASCSI:   hdType[hdIndex++] = HD_GOUDASCSI;  break;
+        case ROM_SUNRISEIDE:  board->hdType[hdIndex++] = HD_SUNRISEIDE; break;
+        case ROM_BEERIDE:     board->hdType[hdIndex++] = HD_BEERIDE;    break;
+        case ROM_GIDE:        board->hdType[hdIndex++] = HD_GIDE;       break;
+        case ROM_SVI328RSIDE: board->hdType[hdIndex++] = HD_RSIDE;      break;
+        case ROM_NOWIND:      board->hdType[hdIndex++] = HD_NOWIND;     break;
+        case SRAM_MEGASCSI:   board->hdType[hdIndex++] = HD_MEGASCSI;   break;
+        case SRAM_WAVESCSI:   board->hdType[hdIndex++] = HD_WAVESCSI;   break;
+        case ROM_GOUDASCSI:   board->hdType[hdIndex++] = HD_GOUDASCSI;  break;
         }
     }
 
     // Update RAM info
-    boardRamSize  = 0;
-    boardVramSize = machine->video.vramSize;
+    board->boardRamSize  = 0;
+    board->boardVramSize = machine->video.vramSize;
 
     for (i = 0; i < machine->slotInfoCount; i++) {
         if (machine->slotInfo[i].romType == RAM_1KB_MIRRORED) {
-            boardRamSize = 0x400;
+            board->boardRamSize = 0x400;
         }
         if (machine->slotInfo[i].romType == RAM_2KB_MIRRORED) {
-            boardRamSize = 0x800;
+            board->boardRamSize = 0x800;
         }
     }
 
-    if (boardRamSize == 0) {
+    if (board->boardRamSize == 0) {
         for (i = 0; i < machine->slotInfoCount; i++) {
             if (machine->slotInfo[i].romType == RAM_NORMAL || machine->slotInfo[i].romType == RAM_MAPPER) {
-                boardRamSize = 0x2000 * machine->slotInfo[i].pageCount;
+                board->boardRamSize = 0x2000 * machine->slotInfo[i].pageCount;
             }
         }
     }
 
-    boardType = machine->board.type;
-    PatchReset(boardType);
+    board->boardType = machine->board.type;
+    board->patchEnabled = 0;
 
-    joystickPortUpdateBoardInfo();
+    joystickPortUpdateBoardInfo(board);
+}
+
+void boardReset(BoardContext* board)
+{
+    if (board->boardRunning) {
+        board->boardInfo.softReset(board->boardInfo.ref);
+    }
 }
 
-void boardReset()
+void boardStop(BoardContext* board)
 {
-    if (boardRunning) {
-        boardInfo.softReset();
+    if (board->boardRunning) {
+        board->boardInfo.stop(board->boardInfo.cpuRef);
     }
 }
 
-void boardSetDataBus(UInt8 value, UInt8 defValue, int useDef) {
-    if (boardRunning) {
-        boardInfo.setDataBus(boardInfo.cpuRef, value, defValue, useDef);
+void boardSetDataBus(BoardContext* board, UInt8 value, UInt8 defValue, int useDef) {
+    if (board->boardRunning) {
+        board->boardInfo.setDataBus(board->boardInfo.cpuRef, value, defValue, useDef);
     }
 }
 
-static BoardType boardLoadState(void)
+static BoardType boardLoadState(BoardContext* board)
 {
-    BoardDeviceInfo* di = boardDeviceInfo;
+    BoardDeviceInfo* di = board->boardDeviceInfo;
     SaveState* state;
     BoardType boardType;
     int   i;
     char  tag[16];
             
-    state = saveStateOpenForRead("board");
+    state = saveStateOpenForRead(board, "board");
 
     boardType      = saveStateGet(state, "boardType", BOARD_MSX);
-    boardSysTime64 = (UInt64)saveStateGet(state, "boardSysTime64Hi", 0) << 32 |
+    board->boardSysTime64 = (UInt64)saveStateGet(state, "boardSysTime64Hi", 0) << 32 |
                      (UInt64)saveStateGet(state, "boardSysTime64Lo", 0);
-    oldTime        = saveStateGet(state, "oldTime", 0);
-    pendingInt     = saveStateGet(state, "pendingInt", 0);
+    board->oldTime        = saveStateGet(state, "oldTime", 0);
+    board->pendingInt     = saveStateGet(state, "pendingInt", 0);
     
     di->carts[0].inserted = saveStateGet(state, "cartInserted00", 0);
     di->carts[0].type     = saveStateGet(state, "cartType00",     0);
@@ -955,16 +1444,16 @@ static BoardType boardLoadState(void)
 
     saveStateClose(state);
 
-    videoManagerLoadState();
-    tapeLoadState();
+    videoManagerLoadState(board);
+    tapeLoadState(board);
 
     return boardType;
 }
 
 
-void boardSaveState(const char* stateFile, int screenshot)
+static void boardWriteState(BoardContext* board, const char* stateFile, int screenshot)
 {
-    BoardDeviceInfo* di = boardDeviceInfo;
+    BoardDeviceInfo* di = board->boardDeviceInfo;
     char buf[128];
     time_t ltime;
     SaveState* state;
@@ -973,24 +1462,18 @@ void boardSaveState(const char* stateFile, int screenshot)
     int rv;
     int i;
 
-    if (!boardRunning) {
-        return;
-    }
-
-    saveStateCreateForWrite(stateFile);
-    
-    rv = zipSaveFile(stateFile, "version", 0, saveStateVersion, strlen(saveStateVersion) + 1);
+    rv = saveStateWriteFile(board, "version", 0, saveStateVersion, strlen(saveStateVersion) + 1);
     if (!rv) {
         return;
     }
     
-    state = saveStateOpenForWrite("board");
+    state = saveStateOpenForWrite(board, "board");
 
-    saveStateSet(state, "pendingInt", pendingInt);
-    saveStateSet(state, "boardType", boardType);
-    saveStateSet(state, "boardSysTime64Hi", (UInt32)(boardSysTime64 >> 32));
-    saveStateSet(state, "boardSysTime64Lo", (UInt32)boardSysTime64);
-    saveStateSet(state, "oldTime", oldTime);
+    saveStateSet(state, "pendingInt", board->pendingInt);
+    saveStateSet(state, "boardType", board->boardType);
+    saveStateSet(state, "boardSysTime64Hi", (UInt32)(board->boardSysTime64 >> 32));
+    saveStateSet(state, "boardSysTime64Lo", (UInt32)board->boardSysTime64);
+    saveStateSet(state, "oldTime", board->oldTime);
 
     saveStateSet(state, "cartInserted00", di->carts[0].inserted);
     saveStateSet(state, "cartType00",     di->carts[0].type);
@@ -1025,24 +1508,24 @@ void boardSaveState(const char* stateFile, int screenshot)
 
     saveStateClose(state);
 
-    boardCaptureSaveState();
+    boardCaptureSaveState(board);
 
-    videoManagerSaveState();
-    tapeSaveState();
+    videoManagerSaveState(board);
+    tapeSaveState(board);
 
     // Save machine state
-    machineSaveState(boardMachine);
+    machineSaveState(board, board->boardMachine);
 
     // Call board dependent save state
-    boardInfo.saveState(stateFile);
+    board->boardInfo.saveState(board->boardInfo.ref);
 
     if (screenshot) {
         bitmap = archScreenCapture(SC_SMALL, &size, 1);
         if( bitmap != NULL && size > 0 ) {
 #ifdef WII
-            zipSaveFile(stateFile, "screenshot.png", 1, bitmap, size);
+            saveStateWriteFile(board, "screenshot.png", 1, bitmap, size);
 #else
-            zipSaveFile(stateFile, "screenshot.bmp", 1, bitmap, size);
+            saveStateWriteFile(board, "screenshot.bmp", 1, bitmap, size);
 #endif
         }
         if( bitmap != NULL ) {
@@ -1053,93 +1536,119 @@ void boardSaveState(const char* stateFile, int screenshot)
     memset(buf, 0, 128);
     time(&ltime);
     strftime(buf, 128, "%X   %A, %B %d, %Y", localtime(&ltime));
-    zipSaveFile(stateFile, "date.txt", 1, buf, strlen(buf) + 1);
+    saveStateWriteFile(board, "date.txt", 1, buf, strlen(buf) + 1);
+}
+
+void boardSaveState(BoardContext* board, const char* stateFile, int screenshot)
+{
+    if (!board->boardRunning) {
+        return;
+    }
+
+    saveStateCreateForWrite(board, stateFile);
+    boardWriteState(board, stateFile, screenshot);
+    saveStateDestroy(board);
+}
+
+void boardSaveStateAsync(BoardContext* board, const char* stateFile, int screenshot, 
+                         void (*callback)(void*, const char*, int), void* ref)
+{
+    if (!board->boardRunning) {
+        if (callback != NULL) {
+            callback(ref, stateFile, 0);
+        }
+        return;
+    }
 
-    saveStateDestroy();
+    saveStateCreateForAsyncWrite(board, stateFile, callback, ref);
+    boardWriteState(board, stateFile, screenshot);
+    saveStateDestroy(board);
 }
 
 
-void boardSetFrequency(int frequency)
+void boardSetFrequency(BoardContext* board, int frequency)
 {
-    boardFreq = frequency * (boardFrequency() / 3579545);
+    board->boardFreq = frequency * (boardFrequency() / 3579545);
     
-	mixerSetBoardFrequency(frequency);
+    if (board->boardMixer != NULL) {
+        mixerSetBoardFrequency(board->boardMixer, frequency);
+    }
 }
 
-int boardGetRefreshRate()
+int boardGetRefreshRate(BoardContext* board)
 {
-    if (boardRunning) {
-        return boardInfo.getRefreshRate();
+    if (board->boardRunning) {
+        return board->boardInfo.getRefreshRate(board->boardInfo.ref);
     }
     return 0;
 }
 
-void  boardSetInt(UInt32 irq)
+void  boardSetInt(BoardContext* board, UInt32 irq)
 {
-    pendingInt |= irq;
-    boardInfo.setInt(boardInfo.cpuRef);
+    board->pendingInt |= irq;
+    board->boardInfo.setInt(board->boardInfo.cpuRef);
 }
 
-void   boardClearInt(UInt32 irq)
+void   boardClearInt(BoardContext* board, UInt32 irq)
 {
-    pendingInt &= ~irq;
-    if (pendingInt == 0) {
-        boardInfo.clearInt(boardInfo.cpuRef);
+    board->pendingInt &= ~irq;
+    if (board->pendingInt == 0) {
+        board->boardInfo.clearInt(board->boardInfo.cpuRef);
     }
 }
 
-UInt32 boardGetInt(UInt32 irq)
+UInt32 boardGetInt(BoardContext* board, UInt32 irq)
 {
-    return pendingInt & irq;
+    return board->pendingInt & irq;
 }
 
-UInt8* boardGetRamPage(int page)
+UInt8* boardGetRamPage(BoardContext* board, int page)
 {
-    if (boardInfo.getRamPage == NULL) {
+    if (board->boardInfo.getRamPage == NULL) {
         return NULL;
     }
-    return boardInfo.getRamPage(page);
+    return board->boardInfo.getRamPage(board->boardInfo.ref, page);
 }
 
-UInt32 boardGetRamSize()
+UInt32 boardGetRamSize(BoardContext* board)
 {
-    return boardRamSize;
+    return board->boardRamSize;
 }
 
-UInt32 boardGetVramSize()
+UInt32 boardGetVramSize(BoardContext* board)
 {
-    return boardVramSize;
+    return board->boardVramSize;
 }
 
-int boardUseRom()
+int boardUseRom(BoardContext* board)
 {
-    return useRom;
+    return board->useRom;
 }
 
-int boardUseMegaRom()
+int boardUseMegaRom(BoardContext* board)
 {
-    return useMegaRom;
+    return board->useMegaRom;
 }
 
-int boardUseMegaRam()
+int boardUseMegaRam(BoardContext* board)
 {
-    return useMegaRam;
+    return board->useMegaRam;
 }
 
-int boardUseFmPac()
+int boardUseFmPac(BoardContext* board)
 {
-    return useFmPac;
+    return board->useFmPac;
 }
 
-HdType boardGetHdType(int hdIndex)
+HdType boardGetHdType(BoardContext* board, int hdIndex)
 {
     if (hdIndex < 0 || hdIndex >= MAX_HD_COUNT) {
         return HD_NONE;
     }
-    return hdType[hdIndex];
+    return board->hdType[hdIndex];
 }
 
-void boardChangeCartridge(int cartNo, RomType romType, char* cart, char* cartZip)
+void boardChangeCartridge(BoardContext* board, int cartNo, RomType romType, char* cart, char* cartZip)
 {
     if (cart && strlen(cart) == 0) {
         cart = NULL;
@@ -1153,78 +1662,78 @@ void boardChangeCartridge(int cartNo, RomType romType, char* cart, char* cartZip
         int size;
         UInt8* buf = romLoad(cart, cartZip, &size);
         if (buf != NULL) {
-            MediaType* mediaType = mediaDbGuessRom(buf, size);
+            MediaType* mediaType = mediaDbGuessRom(board, buf, size);
             romType = mediaDbGetRomType(mediaType);
             free(buf);
         }
     }
 
-    if (boardDeviceInfo != NULL) {
-        boardDeviceInfo->carts[cartNo].inserted = cart != NULL;
-        boardDeviceInfo->carts[cartNo].type = romType;
+    if (board->boardDeviceInfo != NULL) {
+        board->boardDeviceInfo->carts[cartNo].inserted = cart != NULL;
+        board->boardDeviceInfo->carts[cartNo].type = romType;
 
-        if (boardDeviceInfo->carts[cartNo].name != cart) {
-            strcpy(boardDeviceInfo->carts[cartNo].name, cart ? cart : "");
+        if (board->boardDeviceInfo->carts[cartNo].name != cart) {
+            strcpy(board->boardDeviceInfo->carts[cartNo].name, cart ? cart : "");
         }
-        if (boardDeviceInfo->carts[cartNo].inZipName != cartZip) {
-            strcpy(boardDeviceInfo->carts[cartNo].inZipName, cartZip ? cartZip : "");
+        if (board->boardDeviceInfo->carts[cartNo].inZipName != cartZip) {
+            strcpy(board->boardDeviceInfo->carts[cartNo].inZipName, cartZip ? cartZip : "");
         }
     }
 
-    useRom     -= romTypeIsRom(currentRomType[cartNo]);
-    useMegaRom -= romTypeIsMegaRom(currentRomType[cartNo]);
-    useMegaRam -= romTypeIsMegaRam(currentRomType[cartNo]);
-    useFmPac   -= romTypeIsFmPac(currentRomType[cartNo]);
-    hdType[cartNo] = HD_NONE;
-    currentRomType[cartNo] = ROM_UNKNOWN;
+    board->useRom     -= romTypeIsRom(board->currentRomType[cartNo]);
+    board->useMegaRom -= romTypeIsMegaRom(board->currentRomType[cartNo]);
+    board->useMegaRam -= romTypeIsMegaRam(board->currentRomType[cartNo]);
+    board->useFmPac   -= romTypeIsFmPac(board->currentRomType[cartNo]);
+    board->hdType[cartNo] = HD_NONE;
+    board->currentRomType[cartNo] = ROM_UNKNOWN;
 
     if (cart != NULL) {
-        currentRomType[cartNo] = romType;
-        useRom     += romTypeIsRom(romType);
-        useMegaRom += romTypeIsMegaRom(romType);
-        useMegaRam += romTypeIsMegaRam(romType);
-        useFmPac   += romTypeIsFmPac(romType);
-        if (currentRomType[cartNo] == ROM_SUNRISEIDE)   hdType[cartNo] = HD_SUNRISEIDE;
-        if (currentRomType[cartNo] == ROM_BEERIDE)      hdType[cartNo] = HD_BEERIDE;
-        if (currentRomType[cartNo] == ROM_GIDE)         hdType[cartNo] = HD_GIDE;
-        if (currentRomType[cartNo] == ROM_SVI328RSIDE)  hdType[cartNo] = HD_RSIDE;
-        if (currentRomType[cartNo] == ROM_NOWIND)       hdType[cartNo] = HD_NOWIND;
-        if (currentRomType[cartNo] == SRAM_MEGASCSI)    hdType[cartNo] = HD_MEGASCSI;
-        if (currentRomType[cartNo] == SRAM_MEGASCSI128) hdType[cartNo] = HD_MEGASCSI;
-        if (currentRomType[cartNo] == SRAM_MEGASCSI256) hdType[cartNo] = HD_MEGASCSI;
-        if (currentRomType[cartNo] == SRAM_MEGASCSI512) hdType[cartNo] = HD_MEGASCSI;
-        if (currentRomType[cartNo] == SRAM_MEGASCSI1MB) hdType[cartNo] = HD_MEGASCSI;
-        if (currentRomType[cartNo] == SRAM_WAVESCSI)    hdType[cartNo] = HD_WAVESCSI;
-        if (currentRomType[cartNo] == SRAM_WAVESCSI128) hdType[cartNo] = HD_WAVESCSI;
-        if (currentRomType[cartNo] == SRAM_WAVESCSI256) hdType[cartNo] = HD_WAVESCSI;
-        if (currentRomType[cartNo] == SRAM_WAVESCSI512) hdType[cartNo] = HD_WAVESCSI;
-        if (currentRomType[cartNo] == SRAM_WAVESCSI1MB) hdType[cartNo] = HD_WAVESCSI;
-        if (currentRomType[cartNo] == ROM_GOUDASCSI)    hdType[cartNo] = HD_GOUDASCSI;
-    }
-
-    if (boardRunning && cartNo < boardInfo.cartridgeCount) {
-        int inserted = cartridgeInsert(cartNo, romType, cart, cartZip);
-        if (boardInfo.changeCartridge != NULL) {
-            boardInfo.changeCartridge(boardInfo.cpuRef, cartNo, inserted);
+        board->currentRomType[cartNo] = romType;
+        board->useRom     += romTypeIsRom(romType);
+        board->useMegaRom += romTypeIsMegaRom(romType);
+        board->useMegaRam += romTypeIsMegaRam(romType);
+        board->useFmPac   += romTypeIsFmPac(romType);
+        if (board->currentRomType[cartNo] == ROM_SUNRISEIDE)   board->hdType[cartNo] = HD_SUNRISEIDE;
+        if (board->currentRomType[cartNo] == ROM_BEERIDE)      board->hdType[cartNo] = HD_BEERIDE;
+        if (board->currentRomType[cartNo] == ROM_GIDE)         board->hdType[cartNo] = HD_GIDE;
+        if (board->currentRomType[cartNo] == ROM_SVI328RSIDE)  board->hdType[cartNo] = HD_RSIDE;
+        if (board->currentRomType[cartNo] == ROM_NOWIND)       board->hdType[cartNo] = HD_NOWIND;
+        if (board->currentRomType[cartNo] == SRAM_MEGASCSI)    board->hdType[cartNo] = HD_MEGASCSI;
+        if (board->currentRomType[cartNo] == SRAM_MEGASCSI128) board->hdType[cartNo] = HD_MEGASCSI;
+        if (board->currentRomType[cartNo] == SRAM_MEGASCSI256) board->hdType[cartNo] = HD_MEGASCSI;
+        if (board->currentRomType[cartNo] == SRAM_MEGASCSI512) board->hdType[cartNo] = HD_MEGASCSI;
+        if (board->currentRomType[cartNo] == SRAM_MEGASCSI1MB) board->hdType[cartNo] = HD_MEGASCSI;
+        if (board->currentRomType[cartNo] == SRAM_WAVESCSI)    board->hdType[cartNo] = HD_WAVESCSI;
+        if (board->currentRomType[cartNo] == SRAM_WAVESCSI128) board->hdType[cartNo] = HD_WAVESCSI;
+        if (board->currentRomType[cartNo] == SRAM_WAVESCSI256) board->hdType[cartNo] = HD_WAVESCSI;
+        if (board->currentRomType[cartNo] == SRAM_WAVESCSI512) board->hdType[cartNo] = HD_WAVESCSI;
+        if (board->currentRomType[cartNo] == SRAM_WAVESCSI1MB) board->hdType[cartNo] = HD_WAVESCSI;
+        if (board->currentRomType[cartNo] == ROM_GOUDASCSI)    board->hdType[cartNo] = HD_GOUDASCSI;
+    }
+
+    if (board->boardRunning && cartNo < board->boardInfo.cartridgeCount) {
+        int inserted = cartridgeInsert(board, cartNo, romType, cart, cartZip);
+        if (board->boardInfo.changeCartridge != NULL) {
+            board->boardInfo.changeCartridge(board->boardInfo.ref, cartNo, inserted);
         }
     }
 }
 
-static void boardUpdateDisketteInfo()
+static void boardUpdateDisketteInfo(BoardContext* board)
 {
     int i;
     for (i = 0; i < MAXDRIVES; i++) {
-        if (boardDeviceInfo->disks[i].inserted) {
-            diskSetInfo(i, boardDeviceInfo->disks[i].name,
-                        boardDeviceInfo->disks[i].inZipName);
+        if (board->boardDeviceInfo->disks[i].inserted) {
+            diskSetInfo(board, i, board->boardDeviceInfo->disks[i].name,
+                        board->boardDeviceInfo->disks[i].inZipName);
         }
         else {
-            diskSetInfo(i, NULL, NULL);
+            diskSetInfo(board, i, NULL, NULL);
         }
     }
 }
 
-void boardChangeDiskette(int driveId, char* fileName, const char* fileInZipFile)
+void boardChangeDiskette(BoardContext* board, int driveId, char* fileName, const char* fileInZipFile)
 {
     if (fileName && strlen(fileName) == 0) {
         fileName = NULL;
@@ -1234,21 +1743,21 @@ void boardChangeDiskette(int driveId, char* fileName, const char* fileInZipFile)
         fileInZipFile = NULL;
     }
 
-    if (boardDeviceInfo != NULL) {
-        boardDeviceInfo->disks[driveId].inserted = fileName != NULL;
+    if (board->boardDeviceInfo != NULL) {
+        board->boardDeviceInfo->disks[driveId].inserted = fileName != NULL;
         
-        if (boardDeviceInfo->disks[driveId].name != fileName) {
-            strcpy(boardDeviceInfo->disks[driveId].name, fileName ? fileName : "");
+        if (board->boardDeviceInfo->disks[driveId].name != fileName) {
+            strcpy(board->boardDeviceInfo->disks[driveId].name, fileName ? fileName : "");
         }
-        if (boardDeviceInfo->disks[driveId].inZipName != fileInZipFile) {
-            strcpy(boardDeviceInfo->disks[driveId].inZipName, fileInZipFile ? fileInZipFile : "");
+        if (board->boardDeviceInfo->disks[driveId].inZipName != fileInZipFile) {
+            strcpy(board->boardDeviceInfo->disks[driveId].inZipName, fileInZipFile ? fileInZipFile : "");
         }
     }
 
-    diskChange(driveId ,fileName, fileInZipFile);
+    diskChange(board, driveId, fileName, fileInZipFile);
 }
 
-void boardChangeCassette(int tapeId, char* name, const char* fileInZipFile)
+void boardChangeCassette(BoardContext* board, int tapeId, char* name, const char* fileInZipFile)
 {
     if (name && strlen(name) == 0) {
         name = NULL;
@@ -1258,28 +1767,28 @@ void boardChangeCassette(int tapeId, char* name, const char* fileInZipFile)
         fileInZipFile = NULL;
     }
 
-    if (boardDeviceInfo != NULL) {
-        boardDeviceInfo->tapes[tapeId].inserted = name != NULL;
+    if (board->boardDeviceInfo != NULL) {
+        board->boardDeviceInfo->tapes[tapeId].inserted = name != NULL;
 
-        if (boardDeviceInfo->tapes[tapeId].name != name) {
-            strcpy(boardDeviceInfo->tapes[tapeId].name, name ? name : "");
+        if (board->boardDeviceInfo->tapes[tapeId].name != name) {
+            strcpy(board->boardDeviceInfo->tapes[tapeId].name, name ? name : "");
         }
-        if (boardDeviceInfo->tapes[tapeId].inZipName != fileInZipFile) {
-            strcpy(boardDeviceInfo->tapes[tapeId].inZipName, fileInZipFile ? fileInZipFile : "");
+        if (board->boardDeviceInfo->tapes[tapeId].inZipName != fileInZipFile) {
+            strcpy(board->boardDeviceInfo->tapes[tapeId].inZipName, fileInZipFile ? fileInZipFile : "");
         }
     }
 
-    tapeInsert(name, fileInZipFile);
+    tapeInsert(board, name, fileInZipFile);
 }
 
-int boardGetCassetteInserted()
+int boardGetCassetteInserted(BoardContext* board)
 {
-    return tapeIsInserted();
+    return tapeIsInserted(board);
 }
 
-UInt32 boardCalcRelativeTimeout(UInt32 timerFrequency, UInt32 nextTimeout)
+UInt32 boardCalcRelativeTimeout(BoardContext* board, UInt32 timerFrequency, UInt32 nextTimeout)
 {
-    UInt64 currentTime = boardSystemTime64();
+    UInt64 currentTime = boardSystemTime64(board);
     UInt64 frequency   = boardFrequency64() / timerFrequency;
 
     currentTime = frequency * (currentTime / frequency);
@@ -1289,31 +1798,161 @@ UInt32 boardCalcRelativeTimeout(UInt32 timerFrequency, UInt32 nextTimeout)
 
 /////////////////////////////////////////////////////////////
 // Board timer
-
-typedef struct BoardTimer {
-    BoardTimer*  next;
-    BoardTimer*  prev;
+//
+// Pending timers are kept in a binary min-heap ordered on
+// the timeout relative to timeAnchor, so that insertion and
+// removal are O(log n) regardless of how many devices are
+// re-arming their timers. Timers with equal timeouts fire in
+// reverse order of insertion, same as the old sorted list.
+
+struct BoardTimer {
+    BoardContext* board;
     BoardTimerCb callback;
     void*        ref;
     UInt32       timeout;
+    UInt32       sequence;
+    int          index;
 };
 
-static BoardTimer* timerList = NULL;
-static UInt32 timeAnchor;
-static int    timeoutCheckBreak;
-
 #define MAX_TIME  (2 * 1368 * 313)
 #define TEST_TIME 0x7fffffff
 
-BoardTimer* boardTimerCreate(BoardTimerCb callback, void* ref)
+void boardTimerSetTrace(BoardContext* board, BoardTimerTraceCb callback)
+{
+    board->timerTrace = callback;
+}
+
+static int timerBefore(BoardContext* context, BoardTimer* a, BoardTimer* b)
+{
+    UInt32 ta = a->timeout - context->timeAnchor;
+    UInt32 tb = b->timeout - context->timeAnchor;
+
+    if (ta != tb) {
+        return ta < tb;
+    }
+    return (Int32)(a->sequence - b->sequence) > 0;
+}
+
+static void timerSetAnchor(BoardContext* context, UInt32 anchor)
+{
+    context->timeAnchor = anchor;
+
+    if (context->timerTrace != NULL) {
+        context->timerTrace(BOARD_TIMER_ANCHOR, NULL, anchor, 0);
+    }
+}
+
+static void timerHeapSet(BoardContext* context, int index, BoardTimer* timer)
+{
+    context->timerHeap[index] = timer;
+    timer->index     = index;
+}
+
+static void timerHeapSiftUp(BoardContext* context, int index)
+{
+    BoardTimer* timer = context->timerHeap[index];
+
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (!timerBefore(context, timer, context->timerHeap[parent])) {
+            break;
+        }
+        timerHeapSet(context, index, context->timerHeap[parent]);
+        index = parent;
+    }
+    timerHeapSet(context, index, timer);
+}
+
+static void timerHeapSiftDown(BoardContext* context, int index)
+{
+    BoardTimer* timer = context->timerHeap[index];
+
+    for (;;) {
+        int child = 2 * index + 1;
+        if (child >= context->timerHeapSize) {
+            break;
+        }
+        if (child + 1 < context->timerHeapSize && timerBefore(context, context->timerHeap[child + 1], context->timerHeap[child])) {
+            child++;
+        }
+        if (!timerBefore(context, context->timerHeap[child], timer)) {
+            break;
+        }
+        timerHeapSet(context, index, context->timerHeap[child]);
+        index = child;
+    }
+    timerHeapSet(context, index, timer);
+}
+
+// Devices add their timers while their state is loaded. The board files
+// call boardInit() with the restored CPU time before the devices load, so
+// the anchor is normally already there, but the heap is rebuilt after the
+// anchor is moved so that its order never depends on that.
+static void timerRestoreAnchor(BoardContext* context, UInt32 anchor)
+{
+    int i;
+
+    if (anchor == context->timeAnchor) {
+        return;
+    }
+
+    timerSetAnchor(context, anchor);
+
+    for (i = context->timerHeapSize / 2 - 1; i >= 0; i--) {
+        timerHeapSiftDown(context, i);
+    }
+}
+
+static void timerHeapInsert(BoardContext* context, BoardTimer* timer)
+{
+    if (context->timerHeapSize == context->timerHeapCapacity) {
+        context->timerHeapCapacity = context->timerHeapCapacity ? 2 * context->timerHeapCapacity : 32;
+        context->timerHeap = realloc(context->timerHeap, context->timerHeapCapacity * sizeof(BoardTimer*));
+    }
+
+    timerHeapSet(context, context->timerHeapSize++, timer);
+    timerHeapSiftUp(context, timer->index);
+}
+
+static void timerHeapRemove(BoardContext* context, BoardTimer* timer)
+{
+    int index = timer->index;
+
+    timer->index = -1;
+
+    if (--context->timerHeapSize == index) {
+        return;
+    }
+
+    timerHeapSet(context, index, context->timerHeap[context->timerHeapSize]);
+    if (index > 0 && timerBefore(context, context->timerHeap[index], context->timerHeap[(index - 1) / 2])) {
+        timerHeapSiftUp(context, index);
+    }
+    else {
+        timerHeapSiftDown(context, index);
+    }
+}
+
+static void timerRemove(BoardContext* context, BoardTimer* timer)
+{
+    if (timer->index >= 0) {
+        if (context->timerTrace != NULL) {
+            context->timerTrace(BOARD_TIMER_REMOVE, timer, 0, 0);
+        }
+        timerHeapRemove(context, timer);
+    }
+}
+
+BoardTimer* boardTimerCreate(BoardContext* board, BoardTimerCb callback, void* ref)
 {
     BoardTimer* timer = malloc(sizeof(BoardTimer));
 
-    timer->next     = timer;
-    timer->prev     = timer;
+    timer->board    = board;
     timer->callback = callback;
     timer->ref      = ref ? ref : timer;
     timer->timeout  = 0;
+    timer->sequence = 0;
+    timer->index    = -1;
 
     return timer;
 }
@@ -1327,138 +1966,288 @@ void boardTimerDestroy(BoardTimer* timer)
 
 void boardTimerAdd(BoardTimer* timer, UInt32 timeout)
 {
-    UInt32 currentTime = boardSystemTime();
-    BoardTimer* refTimer;
-    BoardTimer* next = timer->next;
-    BoardTimer* prev = timer->prev;
+    BoardContext* context = timer->board;
+    UInt32 currentTime = *context->sysTime;
 
     // Remove current timer
-    next->prev = prev;
-    prev->next = next;
+    timerRemove(context, timer);
 
-    timerList->timeout = currentTime + TEST_TIME;
-
-    refTimer = timerList->next;
-
-    if (timeout - timeAnchor - TEST_TIME < currentTime - timeAnchor - TEST_TIME) {
-        timer->next = timer;
-        timer->prev = timer;
-        
+    if (timeout - context->timeAnchor - TEST_TIME < currentTime - context->timeAnchor - TEST_TIME) {
         // Time has already expired
         return;
     }
 
-    while (timeout - timeAnchor > refTimer->timeout - timeAnchor) {
-        refTimer = refTimer->next;
-    }
-#if 0
-    {
-        static int highWatermark = 0;
-        int cnt = 0;
-        BoardTimer* t = timerList->next;
-        while (t != timerList) {
-            cnt++;
-            t = t->next;
-        }
-        if (cnt > highWatermark) {
-            highWatermark = cnt;
-            printf("HIGH: %d\n", highWatermark);
-        }
+    if (context->timerTrace != NULL) {
+        context->timerTrace(BOARD_TIMER_ADD, timer, currentTime, timeout);
     }
-#endif
 
-    timer->timeout       = timeout;
-    timer->next          = refTimer;
-    timer->prev          = refTimer->prev;
-    refTimer->prev->next = timer;
-    refTimer->prev       = timer;
+    timer->timeout  = timeout;
+    timer->sequence = ++context->timerSequence;
+    timerHeapInsert(context, timer);
 
-    boardInfo.setCpuTimeout(boardInfo.cpuRef, timerList->next->timeout);
+    context->boardInfo.setCpuTimeout(context->boardInfo.cpuRef, context->timerHeap[0]->timeout);
 }
 
 void boardTimerRemove(BoardTimer* timer)
 {
-    BoardTimer* next = timer->next;
-    BoardTimer* prev = timer->prev;
-
-    next->prev = prev;
-    prev->next = next;
-
-    timer->next = timer;
-    timer->prev = timer;
+    timerRemove(timer->board, timer);
 }
 
-void boardTimerCleanup()
+static void boardTimerCleanup(BoardContext* context)
 {
-    while (timerList->next != timerList) {
-        boardTimerRemove(timerList->next);
+    while (context->timerHeapSize > 0) {
+        timerRemove(context, context->timerHeap[context->timerHeapSize - 1]);
     }
 
-    timeoutCheckBreak = 1;
+    context->timeoutCheckBreak = 1;
 }
 
-void boardTimerCheckTimeout(void* dummy)
+// Called from the CPU loop, which passes the board the CPU was created
+// for as its reference
+void boardTimerCheckTimeout(void* ref)
 {
-    UInt32 currentTime = boardSystemTime();
-    timerList->timeout = currentTime + MAX_TIME;
-
-    timeoutCheckBreak = 0;
-    while (!timeoutCheckBreak) {
-        BoardTimer* timer = timerList->next;
-        if (timer == timerList) {
+    BoardContext* context = (BoardContext*)ref;
+    UInt32 currentTime = *context->sysTime;
+
+    context->timeoutCheckBreak = 0;
+    while (!context->timeoutCheckBreak) {
+        BoardTimer* timer;
+        if (context->timerHeapSize == 0) {
+            context->boardInfo.setCpuTimeout(context->boardInfo.cpuRef, currentTime + MAX_TIME);
             return;
         }
-        if (timer->timeout - timeAnchor > currentTime - timeAnchor) {
+        timer = context->timerHeap[0];
+        if (timer->timeout - context->timeAnchor > currentTime - context->timeAnchor) {
             break;
         }
 
-        boardTimerRemove(timer);
+        if (context->timerTrace != NULL) {
+            context->timerTrace(BOARD_TIMER_FIRE, timer, currentTime, timer->timeout);
+        }
+        timerHeapRemove(context, timer);
         timer->callback(timer->ref, timer->timeout);
     }
 
-    timeAnchor = boardSystemTime();    
+    timerSetAnchor(context, *context->sysTime);
+
+    if (context->timerHeapSize == 0) {
+        context->boardInfo.setCpuTimeout(context->boardInfo.cpuRef, currentTime + MAX_TIME);
+        return;
+    }
+
+    context->boardInfo.setCpuTimeout(context->boardInfo.cpuRef, context->timerHeap[0]->timeout);
+}
+
+UInt64 boardSystemTime64(BoardContext* board) {
+    UInt32 currentTime = boardSystemTime(board);
+    board->boardSysTime64 += HIRES_CYCLES_PER_LORES_CYCLE * (currentTime - board->oldTime);
+    board->oldTime = currentTime;
+    return board->boardSysTime64;
+}
+
+void boardInit(BoardContext* board, UInt32* systemTime)
+{
+    board->sysTime = systemTime;
+    board->oldTime = *systemTime;
+    board->boardSysTime64 = board->oldTime * HIRES_CYCLES_PER_LORES_CYCLE;
+
+    timerSetAnchor(board, *systemTime);
+}
+
+
+/////////////////////////////////////////////////////////////
+// Snapshots
+//
+// A snapshot is the raw state written by the BoardInfo
+// saveState hook, built uncompressed in a buffer that is
+// reused for every snapshot. The board timers are not part
+// of the device states, so their timeouts are kept with it.
+
+#define SNAPSHOT_TIMER_COUNT 9
+
+struct BoardSnapshot {
+    void*  buffer;
+    int    size;
+    int    allocSize;
+    UInt32 timeout[SNAPSHOT_TIMER_COUNT];
+    int    timerActive[SNAPSHOT_TIMER_COUNT];
+};
+
+static void boardGetTimers(BoardContext* board, BoardTimer** timers)
+{
+    timers[0] = board->syncTimer;
+    timers[1] = board->fdcTimer;
+    timers[2] = board->mixerTimer;
+    timers[3] = board->stateTimer;
+    timers[4] = board->breakpointTimer;
+    timers[5] = board->periodicTimer;
+    timers[6] = board->cap.timer;
+    timers[7] = board->cap.keyframeTimer;
+    timers[8] = board->keepTimer;
+}
+
+BoardSnapshot* boardSnapshotCreate()
+{
+    return calloc(1, sizeof(BoardSnapshot));
+}
+
+void boardSnapshotDestroy(BoardSnapshot* snapshot)
+{
+    if (snapshot != NULL) {
+        free(snapshot->buffer);
+        free(snapshot);
+    }
+}
+
+void boardSnapshotKeepTimer(BoardContext* board, BoardTimer* timer)
+{
+    board->keepTimer = timer;
+}
+
+const void* boardSnapshotGetData(BoardSnapshot* snapshot, int* size)
+{
+    *size = snapshot->size;
+    return snapshot->buffer;
+}
+
+int boardSnapshotSave(BoardContext* board, BoardSnapshot* snapshot)
+{
+    BoardTimer* timers[SNAPSHOT_TIMER_COUNT];
+    SaveState* state;
+    int i;
+
+    if (!board->boardRunning) {
+        return 0;
+    }
+
+    saveStateCreateForRawWrite(board, snapshot->buffer, snapshot->allocSize);
+
+    state = saveStateOpenForWrite(board, "board");
+    saveStateSet(state, "pendingInt", board->pendingInt);
+    saveStateSet(state, "boardSysTime64Hi", (UInt32)(board->boardSysTime64 >> 32));
+    saveStateSet(state, "boardSysTime64Lo", (UInt32)board->boardSysTime64);
+    saveStateSet(state, "oldTime", board->oldTime);
+    saveStateClose(state);
+
+    board->boardInfo.saveState(board->boardInfo.ref);
+    tapeSaveState(board);
+
+    snapshot->buffer = saveStateDestroyRaw(board, &snapshot->size, &snapshot->allocSize);
+
+    boardGetTimers(board, timers);
+    for (i = 0; i < SNAPSHOT_TIMER_COUNT; i++) {
+        snapshot->timerActive[i] = timers[i] != NULL && timers[i]->index >= 0;
+        snapshot->timeout[i]     = snapshot->timerActive[i] ? timers[i]->timeout : 0;
+    }
 
-    boardInfo.setCpuTimeout(boardInfo.cpuRef, timerList->next->timeout);
+    return 1;
 }
 
-UInt64 boardSystemTime64() {
-    UInt32 currentTime = boardSystemTime();
-    boardSysTime64 += HIRES_CYCLES_PER_LORES_CYCLE * (currentTime - oldTime);
-    oldTime = currentTime;
-    return boardSysTime64;
+int boardSnapshotLoad(BoardContext* board, BoardSnapshot* snapshot)
+{
+    BoardTimer* timers[SNAPSHOT_TIMER_COUNT];
+    SaveState* state;
+    int i;
+
+    if (!board->boardRunning || snapshot->size == 0) {
+        return 0;
+    }
+
+    saveStateCreateForRawRead(board, snapshot->buffer, snapshot->size);
+
+    boardTimerCleanup(board);
+
+    board->boardInfo.loadState(board->boardInfo.ref);
+    tapeLoadState(board);
+
+    timerRestoreAnchor(board, boardSystemTime(board));
+
+    state = saveStateOpenForRead(board, "board");
+    board->pendingInt     = saveStateGet(state, "pendingInt", 0);
+    board->boardSysTime64 = (UInt64)saveStateGet(state, "boardSysTime64Hi", 0) << 32 |
+                     (UInt64)saveStateGet(state, "boardSysTime64Lo", 0);
+    board->oldTime        = saveStateGet(state, "oldTime", 0);
+    saveStateClose(state);
+
+    saveStateDestroy(board);
+
+    boardGetTimers(board, timers);
+    for (i = 0; i < SNAPSHOT_TIMER_COUNT; i++) {
+        if (timers[i] != NULL && snapshot->timerActive[i]) {
+            boardTimerAdd(timers[i], snapshot->timeout[i]);
+        }
+    }
+
+    board->syncStateLoaded = 1;
+
+    return 1;
+}
+
+/////////////////////////////////////////////////////////////
+// Run-ahead
+//
+// The frame that ends when run-ahead starts is the real one.
+// A snapshot is taken and runAheadFrames more frames are
+// emulated with the mixer held and without syncing to the
+// real clock. Only the last of them is shown, after which the
+// snapshot is loaded and the real frame continues from there.
+
+void boardSetRunAhead(BoardContext* board, int frames)
+{
+    board->runAheadFrames = frames > 0 ? frames : 0;
+}
+
+int boardGetRunAhead(BoardContext* board)
+{
+    return board->runAheadFrames;
 }
 
-void boardInit(UInt32* systemTime)
+int boardIsRunningAhead(BoardContext* board)
 {
-    static BoardTimer dummy_timer;
-    boardSysTime = systemTime;
-    oldTime = *systemTime;
-    boardSysTime64 = oldTime * HIRES_CYCLES_PER_LORES_CYCLE;
+    return board->runAheadLeft > 0;
+}
 
-    timeAnchor = *systemTime;
+static int boardCanRunAhead(BoardContext* board)
+{
+    return board->runAheadFrames > 0 && board->runAheadSnapshot != NULL &&
+           board->cap.state == CAPTURE_IDLE;
+}
 
-    if (timerList == NULL) {
-        dummy_timer.next     = &dummy_timer;
-        dummy_timer.prev     = &dummy_timer;
-        dummy_timer.callback = NULL;
-        dummy_timer.ref      = &dummy_timer;
-        dummy_timer.timeout  = 0;
-        timerList = &dummy_timer;
+int boardIsFrameVisible(BoardContext* board)
+{
+    if (board->runAheadLeft > 0) {
+        return board->runAheadLeft == 1;
     }
+    return !boardCanRunAhead(board);
 }
 
+int boardOnFrameStart(BoardContext* board)
+{
+    if (board->runAheadLeft == 0) {
+        if (!boardCanRunAhead(board)) {
+            return 0;
+        }
+        if (!boardSnapshotSave(board, board->runAheadSnapshot)) {
+            return 0;
+        }
+        board->runAheadLeft = board->runAheadFrames;
+        mixerSetHold(board->boardMixer, 1);
+        return 0;
+    }
+
+    if (--board->runAheadLeft > 0) {
+        return 0;
+    }
+
+    mixerSetHold(board->boardMixer, 0);
+
+    return boardSnapshotLoad(board, board->runAheadSnapshot);
+}
 
 /////////////////////////////////////////////////////////////
 // Not board specific stuff....
 
 static char baseDirectory[512];
-static int oversamplingYM2413    = 1;
-static int oversamplingY8950     = 1;
-static int oversamplingMoonsound = 1;
-static int enableYM2413          = 1;
-static int enableY8950           = 1;
-static int enableMoonsound       = 1;
-static int videoAutodetect       = 1;
 
 const char* boardGetBaseDirectory() {
     return baseDirectory;
@@ -1468,58 +2257,66 @@ void boardSetDirectory(const char* dir) {
     strcpy(baseDirectory, dir);
 }
 
-void boardSetYm2413Oversampling(int value) {
-    oversamplingYM2413 = value;
+void boardSetYm2413Oversampling(BoardContext* board, int value) {
+    board->oversamplingYM2413 = value;
+}
+
+int boardGetYm2413Oversampling(BoardContext* board) {
+    return board->oversamplingYM2413;
+}
+
+void boardSetY8950Oversampling(BoardContext* board, int value) {
+    board->oversamplingY8950 = value;
 }
 
-int boardGetYm2413Oversampling() {
-    return oversamplingYM2413;
+int boardGetY8950Oversampling(BoardContext* board) {
+    return board->oversamplingY8950;
 }
 
-void boardSetY8950Oversampling(int value) {
-    oversamplingY8950 = value;
+void boardSetMoonsoundOversampling(BoardContext* board, int value) {
+    board->oversamplingMoonsound = value;
 }
 
-int boardGetY8950Oversampling() {
-    return oversamplingY8950;
+int boardGetMoonsoundOversampling(BoardContext* board) {
+    return board->oversamplingMoonsound;
 }
 
-void boardSetMoonsoundOversampling(int value) {
-    oversamplingMoonsound = value;
+void boardSetYm2413Enable(BoardContext* board, int value) {
+    board->enableYM2413 = value;
 }
 
-int boardGetMoonsoundOversampling() {
-    return oversamplingMoonsound;
+int boardGetYm2413Enable(BoardContext* board) {
+    return board->enableYM2413;
 }
 
-void boardSetYm2413Enable(int value) {
-    enableYM2413 = value;
+void boardSetY8950Enable(BoardContext* board, int value) {
+    board->enableY8950 = value;
 }
 
-int boardGetYm2413Enable() {
-    return enableYM2413;
+int boardGetY8950Enable(BoardContext* board) {
+    return board->enableY8950;
 }
 
-void boardSetY8950Enable(int value) {
-    enableY8950 = value;
+void boardSetMoonsoundEnable(BoardContext* board, int value) {
+    board->enableMoonsound = value;
 }
 
-int boardGetY8950Enable() {
-    return enableY8950;
+int boardGetMoonsoundEnable(BoardContext* board) {
+    return board->enableMoonsound;
 }
 
-void boardSetMoonsoundEnable(int value) {
-    enableMoonsound = value;
+void boardSetVideoAutodetect(BoardContext* board, int value) {
+    board->videoAutodetect = value;
 }
 
-int boardGetMoonsoundEnable() {
-    return enableMoonsound;
+int  boardGetVideoAutodetect(BoardContext* board) {
+    return board->videoAutodetect;
 }
 
-void boardSetVideoAutodetect(int value) {
-    videoAutodetect = value;
+void boardSetPatchEnabled(BoardContext* board, int value) {
+    board->patchEnabled = value;
 }
 
-int  boardGetVideoAutodetect() {
-    return videoAutodetect;
+int  boardGetPatchEnabled(BoardContext* board) {
+    return board->patchEnabled;
 }
@@ -62,14 +62,20 @@ typedef struct {
     int  diskdriveCount;
     int  casetteCount;
 
-    void* cpuRef;
-
-    void   (*destroy)();
-    void   (*softReset)();
-    void   (*loadState)();
-    void   (*saveState)();
-    int    (*getRefreshRate)();
-    UInt8* (*getRamPage)(int);
+    struct {
+        int slot;
+        int sslot;
+    } cartridge[2];     // Where the cartridges go, see cartridgeSetSlotInfo()
+
+    void* cpuRef;   // Passed to setDataBus() and the CPU calls
+    void* ref;      // State of the board type, passed to the other calls
+
+    void   (*destroy)(void*);
+    void   (*softReset)(void*);
+    void   (*loadState)(void*);
+    void   (*saveState)(void*);
+    int    (*getRefreshRate)(void*);
+    UInt8* (*getRamPage)(void*, int);
     void   (*setDataBus)(void*, UInt8, UInt8, int);
 
     void   (*run)(void*);
@@ -82,12 +88,42 @@ typedef struct {
 
     void   (*changeCartridge)(void*, int, int);
 
-    UInt32   (*getTimeTrace)(int);
+    UInt32   (*getTimeTrace)(void*, int);
 } BoardInfo;
 
-void boardInit(UInt32* systemTime);
-
-int boardRun(Machine* machine, 
+// A board context holds all state of one emulated machine: the board
+// (timers, board info, capture, snapshots, run-ahead and the system
+// time), the slot manager, the I/O port tables, the device managers, the
+// frame buffers, the save state and rewind buffer, and the settings below. Every device
+// keeps the context it was created with, so any number of machines can
+// run in one process, each on its own thread. A context is only used by
+// the thread running its machine and by the front end thread driving it.
+//
+// Process-wide are only host side state: the properties, the LEDs and
+// switches, the input configuration, the media database, the base
+// directory, the frame blending and deinterlace setting of the renderer
+// and the save state writer thread, which is shared by all boards. A few
+// sound and I/O chips still keep file-scope
+// state, so only one machine at a time can use them.
+BoardContext* boardContextCreate();
+void boardContextDestroy(BoardContext* board);
+
+struct SlotManagerContext*   boardGetSlotManager(BoardContext* board);
+struct IoPortContext*        boardGetIoPort(BoardContext* board);
+struct DeviceManagerContext* boardGetDeviceManager(BoardContext* board);
+struct DebugDeviceContext*   boardGetDebugDevices(BoardContext* board);
+struct VideoManagerContext*  boardGetVideoManager(BoardContext* board);
+struct FrameBufferContext*   boardGetFrameBuffer(BoardContext* board);
+struct SaveStateContext*     boardGetSaveState(BoardContext* board);
+struct RewindBuffer*         boardGetRewindBuffer(BoardContext* board);
+struct DiskContext*          boardGetDisk(BoardContext* board);
+struct TapeContext*          boardGetTape(BoardContext* board);
+
+void boardInit(BoardContext* board, UInt32* systemTime);
+
+// Runs a machine until it is stopped
+int boardRun(BoardContext* board,
+             Machine* machine, 
              BoardDeviceInfo* deviceInfo,
              Mixer* mixer,
              char* stateFile,
@@ -96,118 +132,203 @@ int boardRun(Machine* machine,
              int reverseBufferCnt,
              int (*syncCallback)(int, int));
 
-int boardRewind();
-int boardRewindOne();
-void boardEnableSnapshots(int enable);
-
-BoardType boardGetType();
-
-void boardSetMachine(Machine* machine);
-void boardReset();
-
-void boardSetDataBus(UInt8 value, UInt8 defaultValue, int setDefault);
-
-UInt64 boardSystemTime64();
-
-void boardCaptureStart(const char* filename);
-void boardCaptureStop();
-int boardCaptureHasData();
-int boardCaptureIsRecording();
-int boardCaptureIsPlaying();
-int boardCaptureCompleteAmount();
-
-UInt8 boardCaptureUInt8(UInt8 logId, UInt8 value);
-
-void boardSaveState(const char* stateFile, int screenshot);
-
-void boardSetFrequency(int frequency);
-int  boardGetRefreshRate();
-
-void boardSetBreakpoint(UInt16 address);
-void boardClearBreakpoint(UInt16 address);
-
-void   boardSetInt(UInt32 irq);
-void   boardClearInt(UInt32 irq);
-UInt32 boardGetInt(UInt32 irq);
-
-UInt8* boardGetRamPage(int page);
-UInt32 boardGetRamSize();
-UInt32 boardGetVramSize();
-
-int boardUseRom();
-int boardUseMegaRom();
-int boardUseMegaRam();
-int boardUseFmPac();
-
-void boardSetNoSpriteLimits(int enable);
-int boardGetNoSpriteLimits();
-
-RomType boardGetRomType(int cartNo);
+int boardRewind(BoardContext* board);
+int boardRewindOne(BoardContext* board);
+void boardEnableSnapshots(BoardContext* board, int enable);
+
+// Loads a state saved from the running machine without restarting it
+int boardRestoreState(BoardContext* board, const char* stateFile);
+
+// Raw in memory snapshots of the running machine. A snapshot holds the
+// uncompressed state written by the BoardInfo saveState hook and the
+// board timers, and can only be loaded in the run it was taken in. It
+// is much cheaper than boardSaveState() and boardRewind().
+typedef struct BoardSnapshot BoardSnapshot;
+
+BoardSnapshot* boardSnapshotCreate();
+void boardSnapshotDestroy(BoardSnapshot* snapshot);
+int  boardSnapshotSave(BoardContext* board, BoardSnapshot* snapshot);
+int  boardSnapshotLoad(BoardContext* board, BoardSnapshot* snapshot);
+
+// The raw state in a snapshot, e.g. to compare two snapshots
+const void* boardSnapshotGetData(BoardSnapshot* snapshot, int* size);
+
+// Run-ahead. Each frame is followed by the given number of hidden frames,
+// emulated with the current input and without audio. The last of them is
+// shown and the machine then goes back to the end of the first frame,
+// which removes that many frames of input lag in the emulated software.
+void boardSetRunAhead(BoardContext* board, int frames);
+int  boardGetRunAhead(BoardContext* board);
+
+// Whether the machine is in a hidden frame that is going to be undone
+int  boardIsRunningAhead(BoardContext* board);
+
+// Called by the video chip when a frame starts. boardIsFrameVisible()
+// tells if the frame that just ended is to be shown. boardOnFrameStart()
+// is called when the new frame is set up and returns 1 if run-ahead
+// moved the machine back to an earlier frame start.
+int  boardIsFrameVisible(BoardContext* board);
+int  boardOnFrameStart(BoardContext* board);
+
+BoardType boardGetType(BoardContext* board);
+
+// The board info set up by the create function of the board type, e.g.
+// msxCreate()
+BoardInfo* boardGetInfo(BoardContext* board);
+
+void boardSetMachine(BoardContext* board, Machine* machine);
+void boardReset(BoardContext* board);
+void boardStop(BoardContext* board);
+
+void boardSetDataBus(BoardContext* board, UInt8 value, UInt8 defaultValue, int setDefault);
+
+UInt64 boardSystemTime64(BoardContext* board);
+
+void boardCaptureStart(BoardContext* board, const char* filename);
+void boardCaptureStop(BoardContext* board);
+int boardCaptureHasData(BoardContext* board);
+int boardCaptureIsRecording(BoardContext* board);
+int boardCaptureIsPlaying(BoardContext* board);
+int boardCaptureCompleteAmount(BoardContext* board);
+// Continues playback of a capture from the last keyframe before the
+// given position (0 - 1000 of the capture length)
+int boardCaptureSeek(BoardContext* board, int amount);
+// Returns the number of keyframes in a capture file, or 0 if the file
+// is not a capture. The keyframe times and the capture length are in
+// board time units from the start of the capture.
+int boardCaptureGetKeyframes(const char* fileName, UInt64* times, int maxCount, UInt64* length);
+// Makes the next playback of a capture started by boardRun() begin
+// at the last keyframe at or before the given time
+void boardCaptureSetPlaybackStart(BoardContext* board, UInt64 time);
+
+UInt8 boardCaptureUInt8(BoardContext* board, UInt8 logId, UInt8 value);
+
+void boardSaveState(BoardContext* board, const char* stateFile, int screenshot);
+// Captures the state and writes it to disk on a worker thread. The
+// callback is called from the worker thread once the file is written.
+void boardSaveStateAsync(BoardContext* board, const char* stateFile, int screenshot, 
+                         void (*callback)(void* ref, const char* fileName, int success), void* ref);
+
+void boardSetFrequency(BoardContext* board, int frequency);
+int  boardGetRefreshRate(BoardContext* board);
+
+void boardSetBreakpoint(BoardContext* board, UInt16 address);
+void boardClearBreakpoint(BoardContext* board, UInt16 address);
+
+void   boardSetInt(BoardContext* board, UInt32 irq);
+void   boardClearInt(BoardContext* board, UInt32 irq);
+UInt32 boardGetInt(BoardContext* board, UInt32 irq);
+
+UInt8* boardGetRamPage(BoardContext* board, int page);
+UInt32 boardGetRamSize(BoardContext* board);
+UInt32 boardGetVramSize(BoardContext* board);
+
+int boardUseRom(BoardContext* board);
+int boardUseMegaRom(BoardContext* board);
+int boardUseMegaRam(BoardContext* board);
+int boardUseFmPac(BoardContext* board);
+
+void boardSetNoSpriteLimits(BoardContext* board, int enable);
+int boardGetNoSpriteLimits(BoardContext* board);
+void boardSetSpritesEnable(BoardContext* board, int enable);
+int boardGetSpritesEnable(BoardContext* board);
+void boardSetDisplayEnable(BoardContext* board, int enable);
+int boardGetDisplayEnable(BoardContext* board);
+
+// The VDP of the machine, set by vdpCreate() for the devices that work
+// with it. NULL when the machine has none.
+void boardSetVdp(BoardContext* board, VDP* vdp);
+VDP* boardGetVdp(BoardContext* board);
+
+RomType boardGetRomType(BoardContext* board, int cartNo);
 
 typedef enum { HD_NONE, HD_SUNRISEIDE, HD_BEERIDE, HD_GIDE, HD_RSIDE,
                HD_MEGASCSI, HD_WAVESCSI, HD_GOUDASCSI, HD_NOWIND } HdType;
-HdType boardGetHdType(int hdIndex);
-
-const char* boardGetBaseDirectory();
+HdType boardGetHdType(BoardContext* board, int hdIndex);
 
-Mixer* boardGetMixer();
+Mixer* boardGetMixer(BoardContext* board);
 
-void boardChangeCartridge(int cartNo, RomType romType, char* cart, char* cartZip);
-void boardChangeDiskette(int driveId, char* fileName, const char* fileInZipFile);
-void boardChangeCassette(int tapeId, char* name, const char* fileInZipFile);
+void boardChangeCartridge(BoardContext* board, int cartNo, RomType romType, char* cart, char* cartZip);
+void boardChangeDiskette(BoardContext* board, int driveId, char* fileName, const char* fileInZipFile);
+void boardChangeCassette(BoardContext* board, int tapeId, char* name, const char* fileInZipFile);
 
-int  boardGetCassetteInserted();
+int  boardGetCassetteInserted(BoardContext* board);
 
 #define boardFrequency() (6 * 3579545)
 
-static UInt32 boardSystemTime() {
-    extern UInt32* boardSysTime;
-    return *boardSysTime;
+// The system time pointer set by boardInit() is the first member of a
+// board context, so the time is read without a call
+static __inline UInt32 boardSystemTime(BoardContext* board) {
+    return **(UInt32**)board;
 }
 
-UInt64 boardSystemTime64();
+UInt64 boardSystemTime64(BoardContext* board);
 
 typedef void (*BoardTimerCb)(void* ref, UInt32 time);
 
 typedef struct BoardTimer BoardTimer;
 
-BoardTimer* boardTimerCreate(BoardTimerCb callback, void* ref);
+BoardTimer* boardTimerCreate(BoardContext* board, BoardTimerCb callback, void* ref);
 void boardTimerDestroy(BoardTimer* timer);
 void boardTimerAdd(BoardTimer* timer, UInt32 timeout);
 void boardTimerRemove(BoardTimer* timer);
 void boardTimerCheckTimeout(void* dummy);
-UInt32 boardCalcRelativeTimeout(UInt32 timerFrequency, UInt32 nextTimeout);
+UInt32 boardCalcRelativeTimeout(BoardContext* board, UInt32 timerFrequency, UInt32 nextTimeout);
 
-void   boardOnBreakpoint(UInt16 pc);
+// A timer of the front end, e.g. one that ends the run, that is to be
+// kept across snapshot loads like the board timers. Cleared when the
+// machine stops.
+void boardSnapshotKeepTimer(BoardContext* board, BoardTimer* timer);
 
-int boardInsertExternalDevices();
-int boardRemoveExternalDevices();
+// Timer trace, used by the headless runner to record the timer operations
+// of a run and replay them in a benchmark. ADD is only reported for timers
+// that are queued, FIRE for timers taken off the queue by a timeout, and
+// ANCHOR when the time the queue is ordered from moves.
+typedef enum {
+    BOARD_TIMER_ADD,
+    BOARD_TIMER_REMOVE,
+    BOARD_TIMER_FIRE,
+    BOARD_TIMER_ANCHOR
+} BoardTimerTraceOp;
 
-// The following methods are more generic config than board specific
-// They should be moved from board.
+typedef void (*BoardTimerTraceCb)(BoardTimerTraceOp op, BoardTimer* timer, UInt32 time, UInt32 timeout);
+
+void boardTimerSetTrace(BoardContext* board, BoardTimerTraceCb callback);
+
+void   boardOnBreakpoint(BoardContext* board, UInt16 pc);
+
+int boardInsertExternalDevices(BoardContext* board);
+int boardRemoveExternalDevices(BoardContext* board);
+
+// The base directory is shared by all boards
 void boardSetDirectory(const char* dir);
+const char* boardGetBaseDirectory();
 
-void boardSetFdcTimingEnable(int enable);
-int  boardGetFdcTimingEnable();
-void boardSetFdcActive();
-
-void boardSetYm2413Oversampling(int value);
-int  boardGetYm2413Oversampling();
-void boardSetY8950Oversampling(int value);
-int  boardGetY8950Oversampling();
-void boardSetMoonsoundOversampling(int value);
-int  boardGetMoonsoundOversampling();
-
-void boardSetYm2413Enable(int value);
-int  boardGetYm2413Enable();
-void boardSetY8950Enable(int value);
-int  boardGetY8950Enable();
-void boardSetMoonsoundEnable(int value);
-int  boardGetMoonsoundEnable();
-void boardSetVideoAutodetect(int value);
-int  boardGetVideoAutodetect();
-
-void boardSetPeriodicCallback(BoardTimerCb cb, void* reference, UInt32 frequency);
+// Machine settings, kept in the board context
+void boardSetFdcTimingEnable(BoardContext* board, int enable);
+int  boardGetFdcTimingEnable(BoardContext* board);
+void boardSetFdcActive(BoardContext* board);
+
+void boardSetYm2413Oversampling(BoardContext* board, int value);
+int  boardGetYm2413Oversampling(BoardContext* board);
+void boardSetY8950Oversampling(BoardContext* board, int value);
+int  boardGetY8950Oversampling(BoardContext* board);
+void boardSetMoonsoundOversampling(BoardContext* board, int value);
+int  boardGetMoonsoundOversampling(BoardContext* board);
+
+void boardSetYm2413Enable(BoardContext* board, int value);
+int  boardGetYm2413Enable(BoardContext* board);
+void boardSetY8950Enable(BoardContext* board, int value);
+int  boardGetY8950Enable(BoardContext* board);
+void boardSetMoonsoundEnable(BoardContext* board, int value);
+int  boardGetMoonsoundEnable(BoardContext* board);
+void boardSetVideoAutodetect(BoardContext* board, int value);
+int  boardGetVideoAutodetect(BoardContext* board);
+// Set when the disk BIOS is run through the patched ROM entries
+void boardSetPatchEnabled(BoardContext* board, int value);
+int  boardGetPatchEnabled(BoardContext* board);
+
+void boardSetPeriodicCallback(BoardContext* board, BoardTimerCb cb, void* reference, UInt32 frequency);
 
 #endif /* BOARD_H */
 
@@ -50,56 +50,52 @@
 #include "ColecoSuperAction.h"
 #include "ColecoSteeringWheel.h"
 
-/* Hardware */
-static SN76489*    sn76489;
-static R800*       r800;
-
-
-// ---------------------------------------------
-// SG-1000 Joystick and PSG handler
-
-static ColecoJoystickDevice* joyDevice[2];
-static int joyDeviceHandle;
-static int joyMode;
-static BoardTimer* rollerTimer;
-
-
-static UInt8 sliderVal[2] = { 0x30, 0x30 };
-static UInt32 joyIntState = 0;
-
-
-static void colecoSN76489Write(void* dummy, UInt16 ioPort, UInt8 value) 
+typedef struct {
+    BoardContext*   board;
+    SN76489*        sn76489;
+    R800*           r800;
+    R800Debug*      r800Debug;
+
+    // SG-1000 Joystick and PSG handler
+    ColecoJoystickDevice* joyDevice[2];
+    int             joyDeviceHandle;
+    int             joyMode;
+    BoardTimer*     rollerTimer;
+    UInt8           sliderVal[2];
+    UInt32          joyIntState;
+} Coleco;
+
+static void colecoSN76489Write(Coleco* coleco, UInt16 ioPort, UInt8 value) 
 {
-    sn76489WriteData(sn76489, ioPort, value);
+    sn76489WriteData(coleco->sn76489, ioPort, value);
 }
 
-static void colecoJoyIoWrite(void* dummy, UInt16 ioPort, UInt8 value)
+static void colecoJoyIoWrite(Coleco* coleco, UInt16 ioPort, UInt8 value)
 {
-	joyMode = (ioPort >> 6) & 1;
+	coleco->joyMode = (ioPort >> 6) & 1;
 }
 
-static UInt8 colecoJoyIoRead(void* dummy, UInt16 ioPort)
+static UInt8 colecoJoyIoRead(Coleco* coleco, UInt16 ioPort)
 {
     int devNo = (ioPort >> 1) & 1;
-    ColecoJoystickDevice* device = joyDevice[devNo];
+    ColecoJoystickDevice* device = coleco->joyDevice[devNo];
     UInt16 joyState = 0xffff;
-    static UInt8 oldValue[2] = { 0, 0 };
     UInt8 value;
 
     if (device != NULL && device->read != NULL) {
         joyState = device->read(device);
     }
 
-    if (joyMode != 0) {
-        value =  boardCaptureUInt8(2 * devNo, sliderVal[devNo] |
-                                              ((joyState & 0x001) ? 0x01 : 0) |
-                                              ((joyState & 0x008) ? 0x02 : 0) |
-                                              ((joyState & 0x002) ? 0x04 : 0) |
-                                              ((joyState & 0x004) ? 0x08 : 0) |
-                                              ((joyState & 0x010) ? 0x40 : 0));
+    if (coleco->joyMode != 0) {
+        value =  boardCaptureUInt8(coleco->board, 2 * devNo, coleco->sliderVal[devNo] |
+                                                             ((joyState & 0x001) ? 0x01 : 0) |
+                                                             ((joyState & 0x008) ? 0x02 : 0) |
+                                                             ((joyState & 0x002) ? 0x04 : 0) |
+                                                             ((joyState & 0x004) ? 0x08 : 0) |
+                                                             ((joyState & 0x010) ? 0x40 : 0));
     }
     else {
-        value = sliderVal[devNo] | ((joyState & 0x020) ? 0x40 : 0) | 0x0f;
+        value = coleco->sliderVal[devNo] | ((joyState & 0x020) ? 0x40 : 0) | 0x0f;
 
 	    if (devNo == 1) {
 		    if (inputEventGetState(EC_COLECO2_0))    value &= 0xFA;
@@ -134,229 +130,242 @@ static UInt8 colecoJoyIoRead(void* dummy, UInt16 ioPort)
 		    if ((joyState & 0x080) == 0)             value &= 0xF4;
 	    }
 
-        value = boardCaptureUInt8(4 + 2 * devNo, value);
+        value = boardCaptureUInt8(coleco->board, 4 + 2 * devNo, value);
     }
 
-    joyIntState &= ~(1 << devNo);
-    if (joyIntState == 0) {
-        r800ClearInt(r800);
+    coleco->joyIntState &= ~(1 << devNo);
+    if (coleco->joyIntState == 0) {
+        r800ClearInt(coleco->r800);
     }
 
     return value;
 }
 
-static void colecoJoyIoHandler(void* dummy, int port, JoystickPortType type)
+static void colecoJoyIoHandler(Coleco* coleco, int port, JoystickPortType type)
 {
     if (port >= 2) {
         return;
     }
 
-    if (joyDevice[port] != NULL && joyDevice[port]->destroy != NULL) {
-        joyDevice[port]->destroy(joyDevice[port]);
+    if (coleco->joyDevice[port] != NULL && coleco->joyDevice[port]->destroy != NULL) {
+        coleco->joyDevice[port]->destroy(coleco->joyDevice[port]);
     }
     
     switch (type) {
     default:
     case JOYSTICK_PORT_NONE:
-        joyDevice[port] = NULL;
+        coleco->joyDevice[port] = NULL;
         break;
     case JOYSTICK_PORT_COLECOJOYSTICK:
-        joyDevice[port] = colecoJoystickCreate(port);
+        coleco->joyDevice[port] = colecoJoystickCreate(port);
         break;
     case JOYSTICK_PORT_SUPERACTION:
-        joyDevice[port] = colecoSuperActionCreate(port);
+        coleco->joyDevice[port] = colecoSuperActionCreate(port);
         break;
     case JOYSTICK_PORT_STEERINGWHEEL:
-        joyDevice[port] = colecoSteeringWheelCreate(port);
+        coleco->joyDevice[port] = colecoSteeringWheelCreate(port);
         break;
     }
 }
 
-static void onRollerPoll(void* ref, UInt32 time)
+static void onRollerPoll(Coleco* coleco, UInt32 time)
 {
     int devNo;
 
     for (devNo = 0; devNo < 2; devNo++) {
-        ColecoJoystickDevice* device = joyDevice[devNo];
+        ColecoJoystickDevice* device = coleco->joyDevice[devNo];
         if (device != NULL && device->read != NULL) {
             UInt8 val = (UInt8)(device->read(device) >> 4) & 0x30;
-            if ((sliderVal[devNo] & 0x10) != 0 && (val & 0x10) == 0) {
-                joyIntState |= 1 << devNo;
+            if ((coleco->sliderVal[devNo] & 0x10) != 0 && (val & 0x10) == 0) {
+                coleco->joyIntState |= 1 << devNo;
             }
-            sliderVal[devNo] =  val;
+            coleco->sliderVal[devNo] =  val;
         }
     }
-    if (joyIntState != 0) {
-        r800SetInt(r800);
+    if (coleco->joyIntState != 0) {
+        r800SetInt(coleco->r800);
     }
     
-    boardTimerAdd(rollerTimer, boardSystemTime() + boardFrequency() / 1000);
+    boardTimerAdd(coleco->rollerTimer, boardSystemTime(coleco->board) + boardFrequency() / 1000);
 }
 
-static void colecoJoyIoLoadState(void* dummy)
+static void colecoJoyIoLoadState(Coleco* coleco)
 {
-    SaveState* state = saveStateOpenForRead("colecoJoyIo");
-    sliderVal[0] = (UInt8)saveStateGet(state, "sliderVal0", 0);
-    sliderVal[1] = (UInt8)saveStateGet(state, "sliderVal1", 0);
-    joyIntState  =        saveStateGet(state, "joyIntState", 0);
+    SaveState* state = saveStateOpenForRead(coleco->board, "colecoJoyIo");
+    coleco->sliderVal[0] = (UInt8)saveStateGet(state, "sliderVal0", 0);
+    coleco->sliderVal[1] = (UInt8)saveStateGet(state, "sliderVal1", 0);
+    coleco->joyIntState  =        saveStateGet(state, "joyIntState", 0);
     saveStateClose(state);
 
-    if (joyDevice[0] != NULL && joyDevice[0]->loadState != NULL) {
-        joyDevice[0]->loadState(joyDevice[0]);
+    if (coleco->joyDevice[0] != NULL && coleco->joyDevice[0]->loadState != NULL) {
+        coleco->joyDevice[0]->loadState(coleco->joyDevice[0]);
     }
-    if (joyDevice[1] != NULL && joyDevice[1]->loadState != NULL) {
-        joyDevice[1]->loadState(joyDevice[1]);
+    if (coleco->joyDevice[1] != NULL && coleco->joyDevice[1]->loadState != NULL) {
+        coleco->joyDevice[1]->loadState(coleco->joyDevice[1]);
     }
 }
 
-static void colecoJoyIoSaveState(void* dummy)
+static void colecoJoyIoSaveState(Coleco* coleco)
 {
-    SaveState* state = saveStateOpenForWrite("colecoJoyIo");
-    saveStateSet(state, "sliderVal0", sliderVal[0]);
-    saveStateSet(state, "sliderVal1", sliderVal[1]);
-    saveStateSet(state, "joyIntState", joyIntState);
+    SaveState* state = saveStateOpenForWrite(coleco->board, "colecoJoyIo");
+    saveStateSet(state, "sliderVal0", coleco->sliderVal[0]);
+    saveStateSet(state, "sliderVal1", coleco->sliderVal[1]);
+    saveStateSet(state, "joyIntState", coleco->joyIntState);
     saveStateClose(state);
 
-    if (joyDevice[0] != NULL && joyDevice[0]->saveState != NULL) {
-        joyDevice[0]->saveState(joyDevice[0]);
+    if (coleco->joyDevice[0] != NULL && coleco->joyDevice[0]->saveState != NULL) {
+        coleco->joyDevice[0]->saveState(coleco->joyDevice[0]);
     }
-    if (joyDevice[1] != NULL && joyDevice[1]->saveState != NULL) {
-        joyDevice[1]->saveState(joyDevice[1]);
+    if (coleco->joyDevice[1] != NULL && coleco->joyDevice[1]->saveState != NULL) {
+        coleco->joyDevice[1]->saveState(coleco->joyDevice[1]);
     }
 }
 
-static void colecoJoyIoReset(void* dummy)
+static void colecoJoyIoReset(Coleco* coleco)
 {
-    sliderVal[0] = 0x30;
-    sliderVal[1] = 0x30;
-    joyIntState = 0;
+    coleco->sliderVal[0] = 0x30;
+    coleco->sliderVal[1] = 0x30;
+    coleco->joyIntState = 0;
 
-    if (joyDevice[0] != NULL && joyDevice[0]->reset != NULL) {
-        joyDevice[0]->reset(joyDevice[0]);
+    if (coleco->joyDevice[0] != NULL && coleco->joyDevice[0]->reset != NULL) {
+        coleco->joyDevice[0]->reset(coleco->joyDevice[0]);
     }
-    if (joyDevice[1] != NULL && joyDevice[1]->reset != NULL) {
-        joyDevice[1]->reset(joyDevice[1]);
+    if (coleco->joyDevice[1] != NULL && coleco->joyDevice[1]->reset != NULL) {
+        coleco->joyDevice[1]->reset(coleco->joyDevice[1]);
     }
 }
 
-static void colecoJoyIoDestroy(void* dummy)
+static void colecoJoyIoDestroy(Coleco* coleco)
 {
     int i;
     for (i = 0xe0; i <= 0xff; i++) {
-        ioPortUnregister(i);
+        ioPortUnregister(coleco->board, i);
     }
     
-    if (joyDevice[0] != NULL && joyDevice[0]->destroy != NULL) {
-        joyDevice[0]->destroy(joyDevice[0]);
+    if (coleco->joyDevice[0] != NULL && coleco->joyDevice[0]->destroy != NULL) {
+        coleco->joyDevice[0]->destroy(coleco->joyDevice[0]);
     }
-    if (joyDevice[1] != NULL && joyDevice[1]->destroy != NULL) {
-        joyDevice[1]->destroy(joyDevice[1]);
+    if (coleco->joyDevice[1] != NULL && coleco->joyDevice[1]->destroy != NULL) {
+        coleco->joyDevice[1]->destroy(coleco->joyDevice[1]);
     }
     
-    joystickPortUpdateHandlerUnregister();
+    joystickPortUpdateHandlerUnregister(coleco);
 
-    deviceManagerUnregister(joyDeviceHandle);
+    deviceManagerUnregister(coleco->board, coleco->joyDeviceHandle);
 
-    boardTimerDestroy(rollerTimer);
+    boardTimerDestroy(coleco->rollerTimer);
 }
 
-static void colecoJoyIoCreate()
+static void colecoJoyIoCreate(Coleco* coleco)
 {
     DeviceCallbacks callbacks = { colecoJoyIoDestroy,   colecoJoyIoReset, 
                                   colecoJoyIoSaveState, colecoJoyIoLoadState };
 
     int i;
     
+    coleco->sliderVal[0] = 0x30;
+    coleco->sliderVal[1] = 0x30;
+
     // Initialize joyMode
-    joyMode = 1;
+    coleco->joyMode = 1;
 
     for (i = 0xe0; i <= 0xff; i++) {
-        ioPortRegister(i, colecoJoyIoRead, colecoSN76489Write, NULL);
+        ioPortRegister(coleco->board, i, colecoJoyIoRead, colecoSN76489Write, coleco);
     }
     for (i = 0x80; i <= 0x9f; i++) {
-        ioPortRegister(i, NULL, colecoJoyIoWrite, NULL);
+        ioPortRegister(coleco->board, i, NULL, colecoJoyIoWrite, coleco);
     }
     for (i = 0xc0; i <= 0xdf; i++) {
-        ioPortRegister(i, NULL, colecoJoyIoWrite, NULL);
+        ioPortRegister(coleco->board, i, NULL, colecoJoyIoWrite, coleco);
     }
     
-    joystickPortUpdateHandlerRegister(colecoJoyIoHandler, NULL);
-    joyDeviceHandle = deviceManagerRegister(ROM_UNKNOWN, &callbacks, NULL);
+    joystickPortUpdateHandlerRegister(colecoJoyIoHandler, coleco);
+    coleco->joyDeviceHandle = deviceManagerRegister(coleco->board, ROM_UNKNOWN, &callbacks, coleco);
 
-    rollerTimer = boardTimerCreate(onRollerPoll, NULL);
+    coleco->rollerTimer = boardTimerCreate(coleco->board, onRollerPoll, coleco);
         
-    boardTimerAdd(rollerTimer, boardSystemTime() + boardFrequency() / 200);
+    boardTimerAdd(coleco->rollerTimer, boardSystemTime(coleco->board) + boardFrequency() / 200);
 }
 
-static void reset()
+static void reset(Coleco* coleco)
 {
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(coleco->board);
 
-    slotManagerReset();
+    slotManagerReset(coleco->board);
 
-    if (r800 != NULL) {
-        r800Reset(r800, systemTime);
+    if (coleco->r800 != NULL) {
+        r800Reset(coleco->r800, systemTime);
     }
 
-    if (sn76489 != NULL) {
-        sn76489Reset(sn76489);
+    if (coleco->sn76489 != NULL) {
+        sn76489Reset(coleco->sn76489);
     }
     
     ledSetCapslock(0);
 
-    deviceManagerReset();
+    deviceManagerReset(coleco->board);
 }
 
-static void destroy() 
+static void destroy(Coleco* coleco) 
 {
-    boardRemoveExternalDevices();
+    boardRemoveExternalDevices(coleco->board);
 
-    sn76489Destroy(sn76489);
-    r800DebugDestroy();
-    slotManagerDestroy();
-    deviceManagerDestroy();
-    r800Destroy(r800);
+    sn76489Destroy(coleco->sn76489);
+    r800DebugDestroy(coleco->r800Debug);
+    slotManagerDestroy(coleco->board);
+    deviceManagerDestroy(coleco->board);
+    r800Destroy(coleco->r800);
+
+    free(coleco);
 }
 
-static int getRefreshRate()
+static int getRefreshRate(Coleco* coleco)
 {
-    return vdpGetRefreshRate();
+    return vdpGetRefreshRate(coleco->board);
 }
 
-static void saveState()
+static void saveState(Coleco* coleco)
 {    
-    r800SaveState(r800);
-    sn76489SaveState(sn76489);
-    deviceManagerSaveState();
-    slotSaveState();
+    r800SaveState(coleco->board, coleco->r800);
+    sn76489SaveState(coleco->sn76489);
+    deviceManagerSaveState(coleco->board);
+    slotSaveState(coleco->board);
 }
 
-static void loadState()
+static void loadState(Coleco* coleco)
 {
-    r800LoadState(r800);
-    boardInit(&r800->systemTime);
-    deviceManagerLoadState();
-    slotLoadState();
-    sn76489LoadState(sn76489);
+    r800LoadState(coleco->board, coleco->r800);
+    boardInit(coleco->board, &coleco->r800->systemTime);
+    deviceManagerLoadState(coleco->board);
+    slotLoadState(coleco->board);
+    sn76489LoadState(coleco->sn76489);
 }
 
-static UInt32 getTimeTrace(int offset) {
-    return r800GetTimeTrace(r800, offset);
+static UInt32 getTimeTrace(Coleco* coleco, int offset) {
+    return r800GetTimeTrace(coleco->r800, offset);
 }
 
-int colecoCreate(Machine* machine, 
+int colecoCreate(BoardContext* board, Machine* machine, 
                  VdpSyncMode vdpSyncMode,
                  BoardInfo* boardInfo)
 {
+    Coleco* coleco;
     int success;
     int i;
 
-    r800 = r800Create(CPU_ENABLE_M1, slotRead, slotWrite, ioPortRead, ioPortWrite, NULL, boardTimerCheckTimeout, NULL, NULL, NULL, NULL, NULL, NULL);
+    coleco = (Coleco*)calloc(1, sizeof(Coleco));
+    coleco->board = board;
+
+    coleco->r800 = r800Create(CPU_ENABLE_M1, slotRead, slotWrite, ioPortRead, ioPortWrite, NULL, boardTimerCheckTimeout, NULL, NULL, NULL, NULL, NULL, board);
+    r800SetMemoryBlocks(coleco->r800, slotGetReadBlocks(board), slotGetWriteBlocks(board));
+    r800SetCodeCache(coleco->r800, slotGetBlockVersions(board));
+    r800SetIoPortBlockWrite(coleco->r800, ioPortCanWriteBlock, ioPortWriteBlock);
 
     boardInfo->cartridgeCount   = 1;
     boardInfo->diskdriveCount   = 0;
     boardInfo->casetteCount     = 0;
-    boardInfo->cpuRef           = r800;
+    boardInfo->cpuRef           = coleco->r800;
+    boardInfo->ref              = coleco;
 
     boardInfo->destroy          = destroy;
     boardInfo->softReset        = reset;
@@ -376,51 +385,51 @@ int colecoCreate(Machine* machine,
     
     boardInfo->getTimeTrace     = getTimeTrace;
 
-    deviceManagerCreate();
+    deviceManagerCreate(board);
 
-    boardInit(&r800->systemTime);
-    ioPortReset();
+    boardInit(board, &coleco->r800->systemTime);
+    ioPortReset(board);
 
-    r800Reset(r800, 0);
-    mixerReset(boardGetMixer());
+    r800Reset(coleco->r800, 0);
+    mixerReset(boardGetMixer(board));
 
-    r800DebugCreate(r800);
+    coleco->r800Debug = r800DebugCreate(board, coleco->r800);
 
-    sn76489 = sn76489Create(boardGetMixer());
+    coleco->sn76489 = sn76489Create(board, boardGetMixer(board));
 
-    slotManagerCreate();
+    slotManagerCreate(board);
     
     if (vdpSyncMode == VDP_SYNC_AUTO) {
         vdpSyncMode = VDP_SYNC_60HZ;
     }
-    vdpCreate(VDP_COLECO, machine->video.vdpVersion, vdpSyncMode, machine->video.vramSize / 0x4000);
+    vdpCreate(board, VDP_COLECO, machine->video.vdpVersion, vdpSyncMode, machine->video.vramSize / 0x4000);
 
-    colecoJoyIoCreate();
+    colecoJoyIoCreate(coleco);
 
     ledSetCapslock(0);
 
     for (i = 0; i < 4; i++) {
-        slotSetSubslotted(i, 0);
+        slotSetSubslotted(board, i, 0);
     }
     for (i = 0; i < 2; i++) {
-        cartridgeSetSlotInfo(i, machine->cart[i].slot, 0);
+        cartridgeSetSlotInfo(board, i, machine->cart[i].slot, 0);
     }
 
-    success = machineInitialize(machine, NULL, NULL, NULL);
+    success = machineInitialize(board, machine, NULL, NULL, NULL);
 
     for (i = 0; i < 8; i++) {
-        slotMapRamPage(0, 0, i);
+        slotMapRamPage(board, 0, 0, i);
     }
 
     if (success) {
-        success = boardInsertExternalDevices();
+        success = boardInsertExternalDevices(board);
     }
 
-    r800SetFrequency(r800, CPU_Z80,  machine->cpu.freqZ80);
-    r800SetFrequency(r800, CPU_R800, machine->cpu.freqR800);
+    r800SetFrequency(coleco->r800, CPU_Z80,  machine->cpu.freqZ80);
+    r800SetFrequency(coleco->r800, CPU_R800, machine->cpu.freqR800);
 
     if (!success) {
-        destroy();
+        destroy(coleco);
     }
 
     return success;
@@ -30,7 +30,7 @@
  
 #include "Board.h"
 
-int colecoCreate(Machine* machine, 
+int colecoCreate(BoardContext* board, Machine* machine,
                  VdpSyncMode vdpSyncMode,
                  BoardInfo* boardInfo);
 
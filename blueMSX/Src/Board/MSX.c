@@ -53,124 +53,136 @@
 
 void PatchZ80(void* ref, CpuRegs* cpuRegs);
 
-// Hardware
-static MsxPsg*         msxPsg;
-static R800*           r800;
-static RTC*            rtc;
-static UInt8*          msxRam;
-static UInt32          msxRamSize;
-static UInt32          msxRamStart;
-static UInt32          z80Frequency;
-
-void msxSetCpu(int mode)
+typedef struct {
+    BoardContext*   board;
+    MsxPsg*         msxPsg;
+    R800*           r800;
+    R800Debug*      r800Debug;
+    RTC*            rtc;
+    UInt8*          msxRam;
+    UInt32          msxRamSize;
+    UInt32          msxRamStart;
+    UInt32          z80Frequency;
+} Msx;
+
+void msxSetCpu(BoardContext* board, int mode)
 {
+    Msx* msx = (Msx*)boardGetInfo(board)->ref;
+
     switch (mode) {
     default:
     case 0:
-        r800SetMode(r800, CPU_Z80);
+        r800SetMode(msx->r800, CPU_Z80);
         break;
     case 1:
-        r800SetMode(r800, CPU_R800);
+        r800SetMode(msx->r800, CPU_R800);
         break;
     }
 }
 
-void msxEnableCpuFreq_1_5(int enable) {
+void msxEnableCpuFreq_1_5(BoardContext* board, int enable) {
+    Msx* msx = (Msx*)boardGetInfo(board)->ref;
+
     if (enable) {
-        r800SetFrequency(r800, CPU_Z80, 3 * z80Frequency / 2);
+        r800SetFrequency(msx->r800, CPU_Z80, 3 * msx->z80Frequency / 2);
     }
     else {
-        r800SetFrequency(r800, CPU_Z80, z80Frequency);
+        r800SetFrequency(msx->r800, CPU_Z80, msx->z80Frequency);
     }
 }
 
-static void reset()
+static void reset(Msx* msx)
 {
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(msx->board);
 
-    slotManagerReset();
+    slotManagerReset(msx->board);
 
-    if (r800 != NULL) {
-        r800Reset(r800, systemTime);
+    if (msx->r800 != NULL) {
+        r800Reset(msx->r800, systemTime);
     }
     
-    deviceManagerReset();
+    deviceManagerReset(msx->board);
 }
 
-static void destroy() {        
-    rtcDestroy(rtc);
+static void destroy(Msx* msx) {        
+    rtcDestroy(msx->rtc);
 
-    boardRemoveExternalDevices();
+    boardRemoveExternalDevices(msx->board);
 
-    slotManagerDestroy();
+    slotManagerDestroy(msx->board);
 
-    r800DebugDestroy();
+    r800DebugDestroy(msx->r800Debug);
     
-	ioPortUnregister(0x2e);
+	ioPortUnregister(msx->board, 0x2e);
+
+    deviceManagerDestroy(msx->board);
 
-    deviceManagerDestroy();
+    r800Destroy(msx->r800);
 
-    r800Destroy(r800);
+    free(msx);
 }
 
-int getPC(){return r800->regs.PC.W;}
+int getPC(BoardContext* board) {
+    Msx* msx = (Msx*)boardGetInfo(board)->ref;
+    return msx->r800->regs.PC.W;
+}
 
-static int getRefreshRate()
+static int getRefreshRate(Msx* msx)
 {
-    return vdpGetRefreshRate();
+    return vdpGetRefreshRate(msx->board);
 }
 
-static UInt32 getTimeTrace(int offset) {
-    return r800GetTimeTrace(r800, offset);
+static UInt32 getTimeTrace(Msx* msx, int offset) {
+    return r800GetTimeTrace(msx->r800, offset);
 }
 
-static UInt8* getRamPage(int page) {
+static UInt8* getRamPage(Msx* msx, int page) {
     int start;
 
-    if (msxRam == NULL) {
+    if (msx->msxRam == NULL) {
         return NULL;
     }
 
-    start = page * 0x2000 - (int)msxRamStart;
+    start = page * 0x2000 - (int)msx->msxRamStart;
     if (page < 0) {
-        start += msxRamSize;
+        start += msx->msxRamSize;
     }
 
-    if (start < 0 || start >= (int)msxRamSize) {
+    if (start < 0 || start >= (int)msx->msxRamSize) {
         return NULL;
     }
 
-	return msxRam + start;
+	return msx->msxRam + start;
 }
     
-static void saveState()
+static void saveState(Msx* msx)
 {   
-    SaveState* state = saveStateOpenForWrite("msx");
+    SaveState* state = saveStateOpenForWrite(msx->board, "msx");
 
-    saveStateSet(state, "z80Frequency",    z80Frequency);
+    saveStateSet(state, "z80Frequency",    msx->z80Frequency);
     
     saveStateClose(state);
 
-    r800SaveState(r800);
-    deviceManagerSaveState();
-    slotSaveState();
-    rtcSaveState(rtc);
+    r800SaveState(msx->board, msx->r800);
+    deviceManagerSaveState(msx->board);
+    slotSaveState(msx->board);
+    rtcSaveState(msx->rtc);
 }
 
-static void loadState()
+static void loadState(Msx* msx)
 {
-    SaveState* state = saveStateOpenForRead("msx");
+    SaveState* state = saveStateOpenForRead(msx->board, "msx");
 
-    z80Frequency = saveStateGet(state, "z80Frequency", 0);
+    msx->z80Frequency = saveStateGet(state, "z80Frequency", 0);
 
     saveStateClose(state);
 
-    r800LoadState(r800);
-    boardInit(&r800->systemTime);
+    r800LoadState(msx->board, msx->r800);
+    boardInit(msx->board, &msx->r800->systemTime);
 
-    deviceManagerLoadState();
-    slotLoadState();
-    rtcLoadState(rtc);
+    deviceManagerLoadState(msx->board);
+    slotLoadState(msx->board);
+    rtcLoadState(msx->rtc);
 }
 
 static UInt8 testPort(void* dummy, UInt16 ioPort)
@@ -178,10 +190,11 @@ static UInt8 testPort(void* dummy, UInt16 ioPort)
     return 0x27;
 }
 
-int msxCreate(Machine* machine, 
+int msxCreate(BoardContext* board, Machine* machine, 
               VdpSyncMode vdpSyncMode,
               BoardInfo* boardInfo)
 {
+    Msx* msx;
     char cmosName[512];
     int success;
     int i;
@@ -194,12 +207,19 @@ int msxCreate(Machine* machine,
         cpuFlags |= CPU_VDP_IO_DELAY;
     }
 
-    r800 = r800Create(cpuFlags, slotRead, slotWrite, ioPortRead, ioPortWrite, PatchZ80, boardTimerCheckTimeout, NULL, NULL, NULL, NULL, NULL, NULL);
+    msx = (Msx*)calloc(1, sizeof(Msx));
+    msx->board = board;
+
+    msx->r800 = r800Create(cpuFlags, slotRead, slotWrite, ioPortRead, ioPortWrite, PatchZ80, boardTimerCheckTimeout, NULL, NULL, NULL, NULL, NULL, board);
+    r800SetMemoryBlocks(msx->r800, slotGetReadBlocks(board), slotGetWriteBlocks(board));
+    r800SetCodeCache(msx->r800, slotGetBlockVersions(board));
+    r800SetIoPortBlockWrite(msx->r800, ioPortCanWriteBlock, ioPortWriteBlock);
 
     boardInfo->cartridgeCount   = machine->board.type == BOARD_MSX_FORTE_II ? 0 : 2;
     boardInfo->diskdriveCount   = machine->board.type == BOARD_MSX_FORTE_II ? 0 : 2;
     boardInfo->casetteCount     = machine->board.type == BOARD_MSX_FORTE_II ? 0 : 1;
-    boardInfo->cpuRef           = r800;
+    boardInfo->cpuRef           = msx->r800;
+    boardInfo->ref              = msx;
 
     boardInfo->destroy          = destroy;
     boardInfo->softReset        = reset;
@@ -219,69 +239,69 @@ int msxCreate(Machine* machine,
     
     boardInfo->getTimeTrace     = getTimeTrace;
 
-    deviceManagerCreate();
-    boardInit(&r800->systemTime);
+    deviceManagerCreate(board);
+    boardInit(board, &msx->r800->systemTime);
 
-    ioPortReset();
-    ramMapperIoCreate();
+    ioPortReset(board);
+    ramMapperIoCreate(board);
 
-    r800Reset(r800, 0);
-    mixerReset(boardGetMixer());
+    r800Reset(msx->r800, 0);
+    mixerReset(boardGetMixer(board));
 
-    msxPPICreate(machine->board.type == BOARD_MSX_FORTE_II);
-    slotManagerCreate();
+    msxPPICreate(board, machine->board.type == BOARD_MSX_FORTE_II);
+    slotManagerCreate(board);
 
-    r800DebugCreate(r800);
+    msx->r800Debug = r800DebugCreate(board, msx->r800);
     
-	ioPortRegister(0x2e, testPort, NULL, NULL);
+	ioPortRegister(board, 0x2e, testPort, NULL, NULL);
 
     sprintf(cmosName, "%s" DIR_SEPARATOR "%s.cmos", boardGetBaseDirectory(), machine->name);
-    rtc = rtcCreate(machine->cmos.enable, machine->cmos.batteryBacked ? cmosName : 0);
+    msx->rtc = rtcCreate(board, machine->cmos.enable, machine->cmos.batteryBacked ? cmosName : 0);
 
-    msxRam = NULL;
+    msx->msxRam = NULL;
 
-    vdpCreate(VDP_MSX, machine->video.vdpVersion, vdpSyncMode, machine->video.vramSize / 0x4000);
+    vdpCreate(board, VDP_MSX, machine->video.vdpVersion, vdpSyncMode, machine->video.vramSize / 0x4000);
 
     for (i = 0; i < 4; i++) {
-        slotSetSubslotted(i, machine->slot[i].subslotted);
+        slotSetSubslotted(board, i, machine->slot[i].subslotted);
     }
 
     for (i = 0; i < 2; i++) {
-        cartridgeSetSlotInfo(i, machine->cart[i].slot, machine->cart[i].subslot);
+        cartridgeSetSlotInfo(board, i, machine->cart[i].slot, machine->cart[i].subslot);
     }
 
-    success = machineInitialize(machine, &msxRam, &msxRamSize, &msxRamStart);
+    success = machineInitialize(board, machine, &msx->msxRam, &msx->msxRamSize, &msx->msxRamStart);
 
-    msxPsg = msxPsgCreate(machine->board.type == BOARD_MSX || 
-                          machine->board.type == BOARD_MSX_FORTE_II 
-                          ? PSGTYPE_AY8910 : PSGTYPE_YM2149,
-                          machine->audio.psgstereo,
-                          machine->audio.psgpan,
-                          machine->board.type == BOARD_MSX_FORTE_II ? 1 : 2);
+    msx->msxPsg = msxPsgCreate(board, machine->board.type == BOARD_MSX || 
+                               machine->board.type == BOARD_MSX_FORTE_II 
+                               ? PSGTYPE_AY8910 : PSGTYPE_YM2149,
+                               machine->audio.psgstereo,
+                               machine->audio.psgpan,
+                               machine->board.type == BOARD_MSX_FORTE_II ? 1 : 2);
 
     if (machine->board.type == BOARD_MSX_FORTE_II) {
-        CoinDevice* coinDevice = coinDeviceCreate(msxPsg);
-        msxPsgRegisterCassetteRead(msxPsg, coinDeviceRead, coinDevice);
+        CoinDevice* coinDevice = coinDeviceCreate(board);
+        msxPsgRegisterCassetteRead(msx->msxPsg, coinDeviceRead, coinDevice);
     }
 
     for (i = 0; i < 8; i++) {
-        slotMapRamPage(0, 0, i);
+        slotMapRamPage(board, 0, 0, i);
     }
 
     if (success) {
-        success = boardInsertExternalDevices();
+        success = boardInsertExternalDevices(board);
     }
 
-    z80Frequency = machine->cpu.freqZ80;
+    msx->z80Frequency = machine->cpu.freqZ80;
 
-    diskEnable(0, machine->fdc.count > 0);
-    diskEnable(1, machine->fdc.count > 1);
+    diskEnable(board, 0, machine->fdc.count > 0);
+    diskEnable(board, 1, machine->fdc.count > 1);
 
-    r800SetFrequency(r800, CPU_Z80,  machine->cpu.freqZ80);
-    r800SetFrequency(r800, CPU_R800, machine->cpu.freqR800);
+    r800SetFrequency(msx->r800, CPU_Z80,  machine->cpu.freqZ80);
+    r800SetFrequency(msx->r800, CPU_R800, machine->cpu.freqR800);
 
     if (!success) {
-        destroy();
+        destroy(msx);
     }
 
     return success;
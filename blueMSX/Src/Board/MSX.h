@@ -30,7 +30,7 @@
  
 #include "Board.h"
 
-int msxCreate(Machine* machine, 
+int msxCreate(BoardContext* board, Machine* machine,
               VdpSyncMode vdpSyncMode,
               BoardInfo* boardInfo);
 
@@ -882,9 +882,9 @@ void machineUpdate(Machine* machine)
 }
 
 
-void machineLoadState(Machine* machine)
+void machineLoadState(BoardContext* board, Machine* machine)
 {
-    SaveState* state = saveStateOpenForRead("machine");
+    SaveState* state = saveStateOpenForRead(board, "machine");
     int hasR800 = 0;
     int i;
 
@@ -959,9 +959,9 @@ void machineLoadState(Machine* machine)
     machineUpdate(machine);
 }
 
-void machineSaveState(Machine* machine)
+void machineSaveState(BoardContext* board, Machine* machine)
 {
-    SaveState* state = saveStateOpenForWrite("machine");
+    SaveState* state = saveStateOpenForWrite(board, "machine");
     int i;
 
     saveStateSetBuffer(state, "name", machine->name, sizeof(machine->name));
@@ -1031,7 +1031,7 @@ void machineSaveState(Machine* machine)
     saveStateClose(state);
 }
 
-int machineInitialize(Machine* machine, UInt8** mainRam, UInt32* mainRamSize, UInt32* mainRamStart)
+int machineInitialize(BoardContext* board, Machine* machine, UInt8** mainRam, UInt32* mainRamSize, UInt32* mainRamStart)
 {
     UInt8* ram       = NULL;
     UInt32 ramSize   = 0;
@@ -1067,13 +1067,13 @@ int machineInitialize(Machine* machine, UInt8** mainRam, UInt32* mainRamSize, UI
         size      = 0x2000 * machine->slotInfo[i].pageCount;
 
         if (machine->slotInfo[i].romType == RAM_1KB_MIRRORED) {
-            success &= ramMirroredCreate(size, slot, subslot, startPage, 0x400, &ram, &ramSize);
+            success &= ramMirroredCreate(board, size, slot, subslot, startPage, 0x400, &ram, &ramSize);
             ramStart = startPage * 0x2000;
             continue;
         }
 
         if (machine->slotInfo[i].romType == RAM_2KB_MIRRORED) {
-            success &= ramMirroredCreate(size, slot, subslot, startPage, 0x800, &ram, &ramSize);
+            success &= ramMirroredCreate(board, size, slot, subslot, startPage, 0x800, &ram, &ramSize);
             ramStart = startPage * 0x2000;
             continue;
         }
@@ -1099,11 +1099,11 @@ int machineInitialize(Machine* machine, UInt8** mainRam, UInt32* mainRamSize, UI
 
         if (machine->slotInfo[i].romType == RAM_NORMAL) {
             if (ram == NULL && startPage == 0) {
-                success &= ramNormalCreate(size, slot, subslot, startPage, &ram, &ramSize);
+                success &= ramNormalCreate(board, size, slot, subslot, startPage, &ram, &ramSize);
                 ramStart = startPage * 0x2000;
             }
             else {
-                success &= ramNormalCreate(size, slot, subslot, startPage, &ram2, &ram2Size);
+                success &= ramNormalCreate(board, size, slot, subslot, startPage, &ram2, &ram2Size);
                 ram2Start = startPage * 0x2000;
             }
             continue;
@@ -1111,10 +1111,10 @@ int machineInitialize(Machine* machine, UInt8** mainRam, UInt32* mainRamSize, UI
 
         if (machine->slotInfo[i].romType == RAM_MAPPER) {
             if (ram == NULL && startPage == 0) {
-                success &= ramMapperCreate(size, slot, subslot, startPage, &ram, &ramSize);
+                success &= ramMapperCreate(board, size, slot, subslot, startPage, &ram, &ramSize);
             }
             else {
-                success &= ramMapperCreate(size, slot, subslot, startPage, NULL, NULL);
+                success &= ramMapperCreate(board, size, slot, subslot, startPage, NULL, NULL);
             }
             continue;
         }
@@ -1180,164 +1180,164 @@ int machineInitialize(Machine* machine, UInt8** mainRam, UInt32* mainRamSize, UI
         }
 
         if (machine->slotInfo[i].romType == ROM_SNATCHER) {
-            success &= romMapperSCCplusCreate(NULL, NULL, 0, slot, subslot, startPage, SCC_SNATCHER);
+            success &= romMapperSCCplusCreate(board, NULL, NULL, 0, slot, subslot, startPage, SCC_SNATCHER);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_SDSNATCHER) {
-            success &= romMapperSCCplusCreate(NULL, NULL, 0, slot, subslot, startPage, SCC_SDSNATCHER);
+            success &= romMapperSCCplusCreate(board, NULL, NULL, 0, slot, subslot, startPage, SCC_SDSNATCHER);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_SCCMIRRORED) {
-            success &= romMapperSCCplusCreate(NULL, NULL, 0, slot, subslot, startPage, SCC_MIRRORED);
+            success &= romMapperSCCplusCreate(board, NULL, NULL, 0, slot, subslot, startPage, SCC_MIRRORED);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_SCCEXTENDED) {
-            success &= romMapperSCCplusCreate(NULL, NULL, 0, slot, subslot, startPage, SCC_EXTENDED);
+            success &= romMapperSCCplusCreate(board, NULL, NULL, 0, slot, subslot, startPage, SCC_EXTENDED);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_PAC) {
-            success &= romMapperPACCreate("Pac.rom", NULL, 0, slot, subslot, startPage);
+            success &= romMapperPACCreate(board, "Pac.rom", NULL, 0, slot, subslot, startPage);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_EXTRAM) {
-            success &= ramMapperCreate(size, slot, subslot, startPage, NULL, NULL);
+            success &= ramMapperCreate(board, size, slot, subslot, startPage, NULL, NULL);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_MEGARAM) {
-            success &= romMapperMegaRAMCreate(size, slot, subslot, startPage);
+            success &= romMapperMegaRAMCreate(board, size, slot, subslot, startPage);
             continue;
         }
 
         if (machine->slotInfo[i].romType == SRAM_MATSUCHITA) {
-            success &= sramMapperMatsushitaCreate(0);
+            success &= sramMapperMatsushitaCreate(board, 0);
             continue;
         }
 
         if (machine->slotInfo[i].romType == SRAM_MATSUCHITA_INV) {
-            success &= sramMapperMatsushitaCreate(1);
+            success &= sramMapperMatsushitaCreate(board, 1);
             continue;
         }
 
         if (machine->slotInfo[i].romType == SRAM_S1985) {
-            success &= sramMapperS1985Create();
+            success &= sramMapperS1985Create(board);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_S1990) {
-            success &= romMapperS1990Create();
+            success &= romMapperS1990Create(board);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_TURBORTIMER) {
-            success &= romMapperTurboRTimerCreate(0);
+            success &= romMapperTurboRTimerCreate(board);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_TURBORIO) {
-            success &= romMapperTurboRIOCreate();
+            success &= romMapperTurboRIOCreate(board);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_F4DEVICE) {
-            success &= romMapperF4deviceCreate(0);
+            success &= romMapperF4deviceCreate(board, 0);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_MSXMIDI) {
-            success &= MSXMidiCreate(0);
+            success &= MSXMidiCreate(board, 0);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_MSXMIDI_EXTERNAL) {
-            success &= MSXMidiCreate(1);
+            success &= MSXMidiCreate(board, 1);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_F4INVERTED) {
-            success &= romMapperF4deviceCreate(1);
+            success &= romMapperF4deviceCreate(board, 1);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_NMS8280DIGI) {
-            success &= romMapperNms8280VideoDaCreate();
+            success &= romMapperNms8280VideoDaCreate(board);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_GIDE) {
-            success &= romMapperGIdeCreate(hdId++);
+            success &= romMapperGIdeCreate(board, hdId++);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_SONYHBI55) {
-            success &= romMapperSonyHBI55Create();
+            success &= romMapperSonyHBI55Create(board);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_MSXAUDIODEV) {
-            success &= romMapperMsxAudioCreate(NULL, NULL, 0, 0, 0, 0);
+            success &= romMapperMsxAudioCreate(board, NULL, NULL, 0, 0, 0, 0);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_JOYREXPSG) {
-            success &= romMapperJoyrexPsgCreate();
+            success &= romMapperJoyrexPsgCreate(board);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_OPCODEPSG) {
-            success &= romMapperOpcodePsgCreate();
+            success &= romMapperOpcodePsgCreate(board);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_TURBORPCM) {
-            success &= romMapperTurboRPcmCreate();
+            success &= romMapperTurboRPcmCreate(board);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_MSXPRN) {
-            success &= romMapperMsxPrnCreate();
+            success &= romMapperMsxPrnCreate(board);
             continue;
         }
 
         // --------- ColecoVision Super Expansion Module specific mappers
         if (machine->slotInfo[i].romType == ROM_OPCODEMEGA) {
-            success &= romMapperOpcodeMegaRamCreate(slot, subslot, startPage);
+            success &= romMapperOpcodeMegaRamCreate(board, slot, subslot, startPage);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_OPCODESAVE) {
-            success &= romMapperOpcodeSaveRamCreate(slot, subslot, startPage);
+            success &= romMapperOpcodeSaveRamCreate(board, slot, subslot, startPage);
             continue;
         }
         
         if (machine->slotInfo[i].romType == ROM_OPCODESLOT) {
-            success &= romMapperOpcodeSlotManagerCreate();
+            success &= romMapperOpcodeSlotManagerCreate(board);
             continue;
         }
 
         // --------- SVI specific mappers
         if (machine->slotInfo[i].romType == ROM_SVI328FDC) {
-            success &= svi328FdcCreate();
+            success &= svi328FdcCreate(board);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_SVI328PRN) {
-            success &= romMapperSvi328PrnCreate();
+            success &= romMapperSvi328PrnCreate(board);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_SVI328RS232) {
-            success &= romMapperSvi328Rs232Create(SVI328_RS232);
+            success &= romMapperSvi328Rs232Create(board, SVI328_RS232);
             continue;
         }
 
         if (machine->slotInfo[i].romType == ROM_SVI328RSIDE) {
-            success &= romMapperSvi328RsIdeCreate(hdId++);
+            success &= romMapperSvi328RsIdeCreate(board, hdId++);
             continue;
         }
         
@@ -1366,11 +1366,11 @@ int machineInitialize(Machine* machine, UInt8** mainRam, UInt32* mainRamSize, UI
                 if (machine->slotInfo[i].romType == SRAM_WAVESCSI ||
                     machine->slotInfo[i].romType == SRAM_ESESCC) {
                     success &= sramMapperEseSCCCreate
-                                (romName, buf, size, slot, subslot, startPage,
+                                (board, romName, buf, size, slot, subslot, startPage,
                                 machine->slotInfo[i].romType == SRAM_WAVESCSI ? hdId++ : 0, mode);
                 } else {
                     success &= sramMapperMegaSCSICreate
-                                (romName, buf, size, slot, subslot, startPage,
+                                (board, romName, buf, size, slot, subslot, startPage,
                                 machine->slotInfo[i].romType == SRAM_MEGASCSI ? hdId++ : 0, mode);
                 }
                 if (buf) free(buf);
@@ -1385,7 +1385,7 @@ int machineInitialize(Machine* machine, UInt8** mainRam, UInt32* mainRamSize, UI
 
             switch (machine->slotInfo[i].romType) {
             case ROM_MEGAFLSHSCC:
-                success &= romMapperMegaFlashRomSccCreate("Manbow2.rom", NULL, 0, slot, subslot, startPage, 0, 0x80000, 0);
+                success &= romMapperMegaFlashRomSccCreate(board, "Manbow2.rom", NULL, 0, slot, subslot, startPage, 0, 0x80000, 0);
                 break;
             default:
                 success = 0;
@@ -1396,80 +1396,80 @@ int machineInitialize(Machine* machine, UInt8** mainRam, UInt32* mainRamSize, UI
 
         switch (machine->slotInfo[i].romType) {
         case ROM_0x4000:
-            success &= romMapperNormalCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperNormalCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_0xC000:
-            success &= romMapperNormalCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperNormalCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_BASIC:
-            success &= romMapperBasicCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperBasicCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_PLAIN:
-            success &= romMapperPlainCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperPlainCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_NETTOUYAKYUU:
-            success &= romMapperNettouYakyuuCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperNettouYakyuuCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_MATRAINK:
-            success &= romMapperMatraINKCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperMatraINKCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_FORTEII:
-            success &= romMapperForteIICreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperForteIICreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_FMDAS:
-            success &= romMapperFmDasCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperFmDasCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_STANDARD:
-            success &= romMapperStandardCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperStandardCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
             
         case ROM_MSXDOS2:
-            success &= romMapperMsxDos2Create(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperMsxDos2Create(board, romName, buf, size, slot, subslot, startPage);
             break;
             
         case ROM_MUPACK:
-            success &= romMapperMuPackCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperMuPackCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
             
         case ROM_KONAMI5:
-            success &= romMapperKonami5Create(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperKonami5Create(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_MANBOW2:
             if (size > 0x70000) size = 0x70000;
-            success &= romMapperMegaFlashRomSccCreate(romName, buf, size, slot, subslot, startPage, 0x7f, 0x80000, 0);
+            success &= romMapperMegaFlashRomSccCreate(board, romName, buf, size, slot, subslot, startPage, 0x7f, 0x80000, 0);
             break;
 
         case ROM_MANBOW2_V2:
-            success &= romMapperMegaFlashRomSccCreate(romName, buf, size, slot, subslot, startPage, 0x7f, 0x100000, 1);
+            success &= romMapperMegaFlashRomSccCreate(board, romName, buf, size, slot, subslot, startPage, 0x7f, 0x100000, 1);
             break;
 
         case ROM_HAMARAJANIGHT:
-            success &= romMapperMegaFlashRomSccCreate(romName, buf, size, slot, subslot, startPage, 0xcf, 0x100000, 1);
+            success &= romMapperMegaFlashRomSccCreate(board, romName, buf, size, slot, subslot, startPage, 0xcf, 0x100000, 1);
             break;
 
         case ROM_MEGAFLSHSCC:
-            success &= romMapperMegaFlashRomSccCreate(romName, buf, size, slot, subslot, startPage, 0, 0x80000, 0);
+            success &= romMapperMegaFlashRomSccCreate(board, romName, buf, size, slot, subslot, startPage, 0, 0x80000, 0);
             break;
 
         case ROM_MEGAFLSHSCCPLUS:
-            success &= romMapperMegaFlashRomSccCreate(romName, buf, size, slot, subslot, startPage, 0, 0x100000, 1);
+            success &= romMapperMegaFlashRomSccCreate(board, romName, buf, size, slot, subslot, startPage, 0, 0x100000, 1);
             break;
 
         case ROM_OBSONET:
-            success &= romMapperObsonetCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperObsonetCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_NOWIND:
-            success &= romMapperNoWindCreate(hdId++, romName, buf, size, slot, subslot, startPage);
+            success &= romMapperNoWindCreate(board, hdId++, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_DUMAS:
@@ -1485,7 +1485,7 @@ int machineInitialize(Machine* machine, UInt8** mainRam, UInt32* mainRamSize, UI
                 strcat(eepromName, "_eeprom.rom");
                     
                 eepromData = romLoad(eepromName, NULL, &eepromSize);
-                success &= romMapperDumasCreate(romName, buf, size, slot, subslot, startPage,
+                success &= romMapperDumasCreate(board, romName, buf, size, slot, subslot, startPage,
                                                 eepromData, eepromSize);
                 if (eepromData != NULL) {
                     free(eepromData);
@@ -1494,42 +1494,42 @@ int machineInitialize(Machine* machine, UInt8** mainRam, UInt32* mainRamSize, UI
             break;
 
         case ROM_MOONSOUND:
-            success &= romMapperMoonsoundCreate(romName, buf, size, 640);
+            success &= romMapperMoonsoundCreate(board, romName, buf, size, 640);
             buf = NULL; // Ownership transferred to emulation of moonsound
             break;
 
         case ROM_SCC:
-            success &= romMapperSCCplusCreate(romName, buf, size, slot, subslot, startPage, SCC_EXTENDED);
+            success &= romMapperSCCplusCreate(board, romName, buf, size, slot, subslot, startPage, SCC_EXTENDED);
             break;
 
         case ROM_SCCPLUS:
-            success &= romMapperSCCplusCreate(romName, buf, size, slot, subslot, startPage, SCCP_EXTENDED);
+            success &= romMapperSCCplusCreate(board, romName, buf, size, slot, subslot, startPage, SCCP_EXTENDED);
             break;
             
         case ROM_KONAMI4:
-            success &= romMapperKonami4Create(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperKonami4Create(board, romName, buf, size, slot, subslot, startPage);
             break;
 
 #ifdef WIN32
         case ROM_GAMEREADER:
-            success &= romMapperGameReaderCreate(0, slot, subslot);
+            success &= romMapperGameReaderCreate(board, 0, slot, subslot);
             break;
 #endif
 
         case ROM_MAJUTSUSHI:
-            success &= romMapperMajutsushiCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperMajutsushiCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
             
         case ROM_HOLYQURAN:
-            success &= romMapperHolyQuranCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperHolyQuranCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_KONAMISYNTH:
-            success &= romMapperKonamiSynthCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperKonamiSynthCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
             
         case ROM_KONWORDPRO:
-            success &= romMapperKonamiWordProCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperKonamiWordProCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_KONAMKBDMAS:
@@ -1545,7 +1545,7 @@ int machineInitialize(Machine* machine, UInt8** mainRam, UInt32* mainRamSize, UI
                 strcat(voiceName, "_voice.rom");
                     
                 voiceData = romLoad(voiceName, NULL, &voiceSize);
-                success &= romMapperKonamiKeyboardMasterCreate(romName, buf, size, 
+                success &= romMapperKonamiKeyboardMasterCreate(board, romName, buf, size, 
                                                                slot, subslot, startPage,
                                                                voiceData, voiceSize);
                 if (voiceData != NULL) {
@@ -1555,230 +1555,230 @@ int machineInitialize(Machine* machine, UInt8** mainRam, UInt32* mainRamSize, UI
             break;
             
         case ROM_ASCII8:
-            success &= romMapperASCII8Create(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperASCII8Create(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_ASCII16:
-            success &= romMapperASCII16Create(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperASCII16Create(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_PANASONIC8:
-            success &= romMapperA1FMCreate(romName, buf, size, slot, subslot, startPage, 0x2000);
+            success &= romMapperA1FMCreate(board, romName, buf, size, slot, subslot, startPage, 0x2000);
             break;
 
         case ROM_PANASONICWX16:
-            success &= romMapperPanasonicCreate(romName, buf, size, slot, subslot, startPage, 0x4000, 6);
+            success &= romMapperPanasonicCreate(board, romName, buf, size, slot, subslot, startPage, 0x4000, 6);
             break;
 
         case ROM_PANASONIC16:
-            success &= romMapperPanasonicCreate(romName, buf, size, slot, subslot, startPage, 0x4000, 8);
+            success &= romMapperPanasonicCreate(board, romName, buf, size, slot, subslot, startPage, 0x4000, 8);
             break;
 
         case ROM_PANASONIC32:
-            success &= romMapperPanasonicCreate(romName, buf, size, slot, subslot, startPage, 0x8000, 8);
+            success &= romMapperPanasonicCreate(board, romName, buf, size, slot, subslot, startPage, 0x8000, 8);
             break;
 
         case ROM_FSA1FMMODEM:
-            success &= romMapperA1FMModemCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperA1FMModemCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
             
         case ROM_ASCII8SRAM:
-            success &= romMapperASCII8sramCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperASCII8sramCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
             
         case ROM_ASCII16SRAM:
-            success &= romMapperASCII16sramCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperASCII16sramCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_MSXAUDIO:
-            success &= romMapperMsxAudioCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperMsxAudioCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_YAMAHASFG01:
-            success &= romMapperSfg05Create(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperSfg05Create(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_YAMAHASFG05:
-            success &= romMapperSfg05Create(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperSfg05Create(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_YAMAHANET:
-            success &= romMapperNetCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperNetCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_SF7000IPL:
-            success &= romMapperSf7000IplCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperSf7000IplCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_KOEI:
-            success &= romMapperKoeiCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperKoeiCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
             
         case ROM_NATIONAL:
-            success &= romMapperNationalCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperNationalCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_KONAMI4NF:
-            success &= romMapperKonami4nfCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperKonami4nfCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
             
         case ROM_ASCII16NF:
-            success &= romMapperASCII16nfCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperASCII16nfCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
             
         case ROM_GAMEMASTER2:
-            success &= romMapperGameMaster2Create(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperGameMaster2Create(board, romName, buf, size, slot, subslot, startPage);
             break;
             
         case ROM_HARRYFOX:
-            success &= romMapperHarryFoxCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperHarryFoxCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
             
         case ROM_HALNOTE:
-            success &= romMapperHalnoteCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperHalnoteCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
             
         case ROM_RTYPE:
-            success &= romMapperRTypeCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperRTypeCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
             
         case ROM_CROSSBLAIM:
-            success &= romMapperCrossBlaimCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperCrossBlaimCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_LODERUNNER:
-            success &= romMapperLodeRunnerCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperLodeRunnerCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
             
         case ROM_KOREAN80:
-            success &= romMapperKorean80Create(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperKorean80Create(board, romName, buf, size, slot, subslot, startPage);
             break;
             
         case ROM_KOREAN90:
-            success &= romMapperKorean90Create(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperKorean90Create(board, romName, buf, size, slot, subslot, startPage);
             break;
             
         case ROM_KOREAN126:
-            success &= romMapperKorean126Create(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperKorean126Create(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_FMPAK:
-            success &= romMapperFMPAKCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperFMPAKCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_FMPAC:
-            success &= romMapperFMPACCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperFMPACCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
             
         case ROM_MSXMUSIC:
-            success &= romMapperMsxMusicCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperMsxMusicCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_NORMAL:
-            success &= romMapperNormalCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperNormalCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_DRAM:
-            success &= romMapperDramCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperDramCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_SG1000:
         case ROM_SC3000:
-            success &= romMapperSg1000Create(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperSg1000Create(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_SG1000_RAMEXPANDER_A:
-            success &= romMapperSg1000RamExpanderCreate(romName, buf, size, slot, subslot, startPage, ROM_SG1000_RAMEXPANDER_A);
+            success &= romMapperSg1000RamExpanderCreate(board, romName, buf, size, slot, subslot, startPage, ROM_SG1000_RAMEXPANDER_A);
             break;
 
         case ROM_SG1000_RAMEXPANDER_B:
-            success &= romMapperSg1000RamExpanderCreate(romName, buf, size, slot, subslot, startPage, ROM_SG1000_RAMEXPANDER_B);
+            success &= romMapperSg1000RamExpanderCreate(board, romName, buf, size, slot, subslot, startPage, ROM_SG1000_RAMEXPANDER_B);
             break;
 
         case ROM_SG1000CASTLE:
-            success &= romMapperSg1000CastleCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperSg1000CastleCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_SEGABASIC:
-            success &= romMapperSegaBasicCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperSegaBasicCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_CASPATCH:
-            success &= romMapperCasetteCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperCasetteCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_DISKPATCH:
-            success &= romMapperDiskCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperDiskCreate(board, romName, buf, size, slot, subslot, startPage);
            break;
 
         case ROM_TC8566AF:
-            success &= romMapperTC8566AFCreate(romName, buf, size, slot, subslot, startPage, ROM_TC8566AF);
+            success &= romMapperTC8566AFCreate(board, romName, buf, size, slot, subslot, startPage, ROM_TC8566AF);
             break;
         case ROM_TC8566AF_TR:
-            success &= romMapperTC8566AFCreate(romName, buf, size, slot, subslot, startPage, ROM_TC8566AF_TR);
+            success &= romMapperTC8566AFCreate(board, romName, buf, size, slot, subslot, startPage, ROM_TC8566AF_TR);
             break;
 
         case ROM_MICROSOL:
-            success &= romMapperMicrosolCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperMicrosolCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_ARC:
-            success &= romMapperArcCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperArcCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_NATIONALFDC:
-            success &= romMapperNationalFdcCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperNationalFdcCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_PHILIPSFDC:
-            success &= romMapperPhilipsFdcCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperPhilipsFdcCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_SVI707FDC:
-            success &= romMapperSvi707FdcCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperSvi707FdcCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_SVI738FDC:
-            success &= romMapperSvi738FdcCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperSvi738FdcCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_KANJI:
-            success &= romMapperKanjiCreate(buf, size);
+            success &= romMapperKanjiCreate(board, buf, size);
             break;
 
         case ROM_KANJI12:
-            success &= romMapperKanji12Create(buf, size);
+            success &= romMapperKanji12Create(board, buf, size);
             break;
 
         case ROM_BUNSETU:
-            success &= romMapperBunsetuCreate(romName, buf, size, slot, subslot, startPage, jisyoRom, jisyoRomSize);
+            success &= romMapperBunsetuCreate(board, romName, buf, size, slot, subslot, startPage, jisyoRom, jisyoRomSize);
             break;
 
         case ROM_SUNRISEIDE:
-            success &= romMapperSunriseIdeCreate(hdId++, romName, buf, size, slot, subslot, startPage);
+            success &= romMapperSunriseIdeCreate(board, hdId++, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_BEERIDE:
-            success &= romMapperBeerIdeCreate(hdId++, romName, buf, size, slot, subslot, startPage);
+            success &= romMapperBeerIdeCreate(board, hdId++, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_GOUDASCSI:
-            success &= romMapperGoudaSCSICreate(hdId++, romName, buf, size, slot, subslot, startPage);
+            success &= romMapperGoudaSCSICreate(board, hdId++, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_SONYHBIV1:
-            success &= romMapperSonyHbiV1Create(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperSonyHbiV1Create(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_PLAYBALL:
-            success &= romMapperPlayBallCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperPlayBallCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_DOOLY:
-            success &= romMapperDoolyCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperDoolyCreate(board, romName, buf, size, slot, subslot, startPage);
 
         case ROM_OPCODEBIOS:
-            success &= romMapperOpcodeBiosCreate(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperOpcodeBiosCreate(board, romName, buf, size, slot, subslot, startPage);
             break;
 
         case ROM_MICROSOL80:
@@ -1794,7 +1794,7 @@ int machineInitialize(Machine* machine, UInt8** mainRam, UInt32* mainRamSize, UI
                 strcat(charName, "_char.rom");
                     
                 charData = romLoad(charName, NULL, &charSize);
-                success &= romMapperMicrosolVmx80Create(romName, buf, size, 
+                success &= romMapperMicrosolVmx80Create(board, romName, buf, size, 
                                                         slot, subslot, startPage,
                                                         charData, charSize);
                 if (charData != NULL) {
@@ -1804,7 +1804,7 @@ int machineInitialize(Machine* machine, UInt8** mainRam, UInt32* mainRamSize, UI
             break;
 
         case ROM_SVI727COL80:
-            success &= romMapperSvi727Col80Create(romName, buf, size, slot, subslot, startPage);
+            success &= romMapperSvi727Col80Create(board, romName, buf, size, slot, subslot, startPage);
             break;
         }
         if( buf != NULL ) {
@@ -115,10 +115,10 @@ void machineUpdate(Machine* machine);
 
 void machineSave(Machine* machine);
 
-int machineInitialize(Machine* machine, UInt8** mainRam, UInt32* mainRamSize, UInt32* mainRamStart);
+int machineInitialize(BoardContext* board, Machine* machine, UInt8** mainRam, UInt32* mainRamSize, UInt32* mainRamStart);
 
-void machineLoadState(Machine* machine);
-void machineSaveState(Machine* machine);
+void machineLoadState(BoardContext* board, Machine* machine);
+void machineSaveState(BoardContext* board, Machine* machine);
 
 void machineSetDirectory(const char* dir);
 
@@ -51,13 +51,16 @@
 #include "Sf7000PPI.h"
 
 
-/* Hardware */
-static Sg1000JoyIo* joyIo;
-static SN76489*     sn76489;
-static R800*        r800;
-static UInt8*       sfRam;
-static UInt32       sfRamSize;
-static UInt32       sfRamStart;
+typedef struct {
+    BoardContext*   board;
+    Sg1000JoyIo*    joyIo;
+    SN76489*        sn76489;
+    R800*           r800;
+    R800Debug*      r800Debug;
+    UInt8*          sfRam;
+    UInt32          sfRamSize;
+    UInt32          sfRamStart;
+} Sg1000;
 
 
 /* Although the Sega machines doesn't have the slotted layout
@@ -85,147 +88,155 @@ C000 +---------+---------+---------+---------+
 // SG-1000 Joystick and PSG handler
 
 
-static void sg1000Sn76489Write(void* dummy, UInt16 ioPort, UInt8 value) 
+static void sg1000Sn76489Write(Sg1000* sg1000, UInt16 ioPort, UInt8 value) 
 {
-    sn76489WriteData(sn76489, ioPort, value);
+    sn76489WriteData(sg1000->sn76489, ioPort, value);
 }
 
-static UInt8 joyIoRead(void* dummy, UInt16 ioPort)
+static UInt8 joyIoRead(Sg1000* sg1000, UInt16 ioPort)
 {
     switch (ioPort & 1) {
     case 0:
-        return boardCaptureUInt8(0, (UInt8)(sg1000JoyIoRead(joyIo) & 0xff));
+        return boardCaptureUInt8(sg1000->board, 0, (UInt8)(sg1000JoyIoRead(sg1000->joyIo) & 0xff));
     case 1:
-        return boardCaptureUInt8(1, (UInt8)(sg1000JoyIoRead(joyIo) >> 8));
+        return boardCaptureUInt8(sg1000->board, 1, (UInt8)(sg1000JoyIoRead(sg1000->joyIo) >> 8));
     }
 
     return 0xff;
 }
 
-static void sg1000IoPortDestroy(void* dummy)
+static void sg1000IoPortDestroy(Sg1000* sg1000)
 {
 	int i;
 
 	for (i=0x40; i<0x80; i++)
-		ioPortUnregister(i);
+		ioPortUnregister(sg1000->board, i);
 
 	for (i=0xC0; i<0x100; i+=2)
-		ioPortUnregister(i);
+		ioPortUnregister(sg1000->board, i);
 
-	ioPortUnregister(0xc1);
-	ioPortUnregister(0xdd);
+	ioPortUnregister(sg1000->board, 0xc1);
+	ioPortUnregister(sg1000->board, 0xdd);
 }
 
-static void sg1000IoPortCreate()
+static void sg1000IoPortCreate(Sg1000* sg1000)
 {
     DeviceCallbacks callbacks = { sg1000IoPortDestroy, NULL, NULL, NULL };
 	int i;
    
 	for (i=0x40; i<0x80; i++)
-		ioPortRegister(i, NULL, sg1000Sn76489Write, NULL);
+		ioPortRegister(sg1000->board, i, NULL, sg1000Sn76489Write, sg1000);
 
 	for (i=0xC0; i<0x100; i+=2)
-		ioPortRegister(i, joyIoRead, NULL, NULL);
+		ioPortRegister(sg1000->board, i, joyIoRead, NULL, sg1000);
     
-	ioPortRegister(0xc1, joyIoRead, NULL, NULL);
-	ioPortRegister(0xdd, joyIoRead, NULL, NULL);
+	ioPortRegister(sg1000->board, 0xc1, joyIoRead, NULL, sg1000);
+	ioPortRegister(sg1000->board, 0xdd, joyIoRead, NULL, sg1000);
 }
 
 // -----------------------------------------------------
 
-static void reset()
+static void reset(Sg1000* sg1000)
 {
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(sg1000->board);
 
-    slotManagerReset();
+    slotManagerReset(sg1000->board);
 
-    if (r800 != NULL) {
-        r800Reset(r800, systemTime);
+    if (sg1000->r800 != NULL) {
+        r800Reset(sg1000->r800, systemTime);
     }
 
-    if (sn76489 != NULL) {
-        sn76489Reset(sn76489);
+    if (sg1000->sn76489 != NULL) {
+        sn76489Reset(sg1000->sn76489);
     }
     
     ledSetCapslock(0);
 
-    deviceManagerReset();
+    deviceManagerReset(sg1000->board);
 }
 
-static void destroy() 
+static void destroy(Sg1000* sg1000) 
 {    
-    boardRemoveExternalDevices();
-    sn76489Destroy(sn76489);
-    r800DebugDestroy();
-    slotManagerDestroy();
-    deviceManagerDestroy();
-    r800Destroy(r800);
+    boardRemoveExternalDevices(sg1000->board);
+    sn76489Destroy(sg1000->sn76489);
+    r800DebugDestroy(sg1000->r800Debug);
+    slotManagerDestroy(sg1000->board);
+    deviceManagerDestroy(sg1000->board);
+    r800Destroy(sg1000->r800);
+
+    free(sg1000);
 }
 
-static int getRefreshRate()
+static int getRefreshRate(Sg1000* sg1000)
 {
-    return vdpGetRefreshRate();
+    return vdpGetRefreshRate(sg1000->board);
 }
 
-static UInt32 getTimeTrace(int offset) {
-    return r800GetTimeTrace(r800, offset);
+static UInt32 getTimeTrace(Sg1000* sg1000, int offset) {
+    return r800GetTimeTrace(sg1000->r800, offset);
 }
 
-static void saveState()
+static void saveState(Sg1000* sg1000)
 {    
-    r800SaveState(r800);
-    deviceManagerSaveState();
-    slotSaveState();
-    sn76489SaveState(sn76489);
+    r800SaveState(sg1000->board, sg1000->r800);
+    deviceManagerSaveState(sg1000->board);
+    slotSaveState(sg1000->board);
+    sn76489SaveState(sg1000->sn76489);
 }
 
-static void loadState()
+static void loadState(Sg1000* sg1000)
 {
-    r800LoadState(r800);
-    boardInit(&r800->systemTime);
-    deviceManagerLoadState();
-    slotLoadState();
-    sn76489LoadState(sn76489);
+    r800LoadState(sg1000->board, sg1000->r800);
+    boardInit(sg1000->board, &sg1000->r800->systemTime);
+    deviceManagerLoadState(sg1000->board);
+    slotLoadState(sg1000->board);
+    sn76489LoadState(sg1000->sn76489);
 }
 
-static UInt8* getRamPage(int page) {
-    int start = page * 0x2000 - (int)sfRamStart;
+static UInt8* getRamPage(Sg1000* sg1000, int page) {
+    int start = page * 0x2000 - (int)sg1000->sfRamStart;
 
-    if (sfRam == NULL) {
+    if (sg1000->sfRam == NULL) {
         return NULL;
     }
 
-    if (start < 0 || start >= (int)sfRamSize) {
+    if (start < 0 || start >= (int)sg1000->sfRamSize) {
         return NULL;
     }
 
-	return sfRam + start;
+	return sg1000->sfRam + start;
 }
 
-static void changeCartridge(void* ref, int cartNo, int inserted)
+static void changeCartridge(Sg1000* sg1000, int cartNo, int inserted)
 {
     if (cartNo == 0) {
         int slot = inserted ? 2 + cartNo : 0;
 
-        slotSetRamSlot(0, slot);
+        slotSetRamSlot(sg1000->board, 0, slot);
     }
 }
 
-int sg1000Create(Machine* machine, 
+int sg1000Create(BoardContext* board, Machine* machine, 
                  VdpSyncMode vdpSyncMode,
                  BoardInfo* boardInfo)
 {
+    Sg1000* sg1000;
     int success;
     int i;
 
-    sfRam = NULL;
+    sg1000 = (Sg1000*)calloc(1, sizeof(Sg1000));
+    sg1000->board = board;
 
-    r800 = r800Create(0, slotRead, slotWrite, ioPortRead, ioPortWrite, NULL, boardTimerCheckTimeout, NULL, NULL, NULL, NULL, NULL, NULL);
+    sg1000->r800 = r800Create(0, slotRead, slotWrite, ioPortRead, ioPortWrite, NULL, boardTimerCheckTimeout, NULL, NULL, NULL, NULL, NULL, board);
+    r800SetMemoryBlocks(sg1000->r800, slotGetReadBlocks(board), slotGetWriteBlocks(board));
+    r800SetCodeCache(sg1000->r800, slotGetBlockVersions(board));
+    r800SetIoPortBlockWrite(sg1000->r800, ioPortCanWriteBlock, ioPortWriteBlock);
 
     boardInfo->cartridgeCount   = 1;
     boardInfo->diskdriveCount   = 0;
     boardInfo->casetteCount     = 0;
-    boardInfo->cpuRef           = r800;
+    boardInfo->cpuRef           = sg1000->r800;
+    boardInfo->ref              = sg1000;
 
     boardInfo->destroy          = destroy;
     boardInfo->softReset        = reset;
@@ -247,66 +258,66 @@ int sg1000Create(Machine* machine,
 
     boardInfo->changeCartridge  = changeCartridge;
 
-    deviceManagerCreate();
+    deviceManagerCreate(board);
     
-    boardInit(&r800->systemTime);
-    ioPortReset();
+    boardInit(board, &sg1000->r800->systemTime);
+    ioPortReset(board);
 
-    r800Reset(r800, 0);
-    mixerReset(boardGetMixer());
+    r800Reset(sg1000->r800, 0);
+    mixerReset(boardGetMixer(board));
 
-    r800DebugCreate(r800);
+    sg1000->r800Debug = r800DebugCreate(board, sg1000->r800);
 
-    sn76489 = sn76489Create(boardGetMixer());
+    sg1000->sn76489 = sn76489Create(board, boardGetMixer(board));
 
-    slotManagerCreate();
+    slotManagerCreate(board);
 
     if (vdpSyncMode == VDP_SYNC_AUTO) {
         vdpSyncMode = VDP_SYNC_60HZ;
     }
-    vdpCreate(VDP_SG1000, machine->video.vdpVersion, vdpSyncMode, machine->video.vramSize / 0x4000);
+    vdpCreate(board, VDP_SG1000, machine->video.vdpVersion, vdpSyncMode, machine->video.vramSize / 0x4000);
 
-    joyIo = sg1000JoyIoCreate();
+    sg1000->joyIo = sg1000JoyIoCreate(board);
     if (machine->board.type == BOARD_SC3000) {
-        sc3000PPICreate(joyIo);
+        sc3000PPICreate(board, sg1000->joyIo);
     }
     if (machine->board.type == BOARD_SF7000) {
-        sc3000PPICreate(joyIo);
-        sf7000PPICreate();
+        sc3000PPICreate(board, sg1000->joyIo);
+        sf7000PPICreate(board);
             
-        diskEnable(0, machine->fdc.count > 0);
-        diskEnable(1, machine->fdc.count > 1);
+        diskEnable(board, 0, machine->fdc.count > 0);
+        diskEnable(board, 1, machine->fdc.count > 1);
     }
-    sg1000IoPortCreate();
+    sg1000IoPortCreate(sg1000);
 
 	ledSetCapslock(0);
 
     for (i = 0; i < 4; i++) {
-        slotSetSubslotted(i, 0);
+        slotSetSubslotted(board, i, 0);
     }
     for (i = 0; i < 2; i++) {
-        cartridgeSetSlotInfo(i, 2 + i, 0);
+        cartridgeSetSlotInfo(board, i, 2 + i, 0);
     }
 
-    success = machineInitialize(machine, &sfRam, &sfRamSize, &sfRamStart);
+    success = machineInitialize(board, machine, &sg1000->sfRam, &sg1000->sfRamSize, &sg1000->sfRamStart);
 
     for (i = 0; i < 8; i++) {
-        slotMapRamPage(0, 0, i);
+        slotMapRamPage(board, 0, 0, i);
     }
 
     if (machine->board.type == BOARD_SF7000) {
-        slotSetRamSlot(0, 1);
+        slotSetRamSlot(board, 0, 1);
     }
 
     if (success) {
-        success = boardInsertExternalDevices();
+        success = boardInsertExternalDevices(board);
     }
 
-    r800SetFrequency(r800, CPU_Z80,  machine->cpu.freqZ80);
-    r800SetFrequency(r800, CPU_R800, machine->cpu.freqR800);
+    r800SetFrequency(sg1000->r800, CPU_Z80,  machine->cpu.freqZ80);
+    r800SetFrequency(sg1000->r800, CPU_R800, machine->cpu.freqR800);
 
     if (!success) {
-        destroy();
+        destroy(sg1000);
     }
 
     return success;
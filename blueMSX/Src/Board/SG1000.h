@@ -32,7 +32,7 @@
 #include "Board.h"
 #include <stdio.h>
 
-int sg1000Create(Machine* machine, 
+int sg1000Create(BoardContext* board, Machine* machine,
                  VdpSyncMode vdpSyncMode,
                  BoardInfo* boardInfo);
 
@@ -50,24 +50,29 @@
 #include "romMapperSvi80Col.h"
 #include "SviJoyIo.h"
 
-/* Hardware */
-static AY8910*         ay8910;
-static AudioKeyClick*  keyClick;
-static R800*           r800;
-static SviJoyIo*       joyIO;
-static UInt8           KeyboardMap[16];
-static UInt32          sviRamSize;
-static UInt32          sviRamStart;
-static UInt8*          sviRam;
-static UInt8           psgAYReg15;
-static int             svi328Col80Enabled;
-static UInt8           lastJoystickValue;
+typedef struct {
+    BoardContext*   board;
+    AY8910*         ay8910;
+    AudioKeyClick*  keyClick;
+    R800*           r800;
+    R800Debug*      r800Debug;
+    SviJoyIo*       joyIO;
+    UInt8           KeyboardMap[16];
+    UInt32          sviRamSize;
+    UInt32          sviRamStart;
+    UInt8*          sviRam;
+    UInt8           psgAYReg15;
+    int             svi328Col80Enabled;
+    UInt8           lastJoystickValue;
+} Svi;
 
 extern void PatchZ80(void* ref, CpuRegs* cpu);
 
 static void sviMemWrite(void* ref, UInt16 address, UInt8 value)
 {
-    if ((svi328Col80Enabled && svi328Col80MemBankCtrlStatus()) && (address & 0xf800) == 0xf000)
+    Svi* svi = (Svi*)boardGetInfo((BoardContext*)ref)->ref;
+
+    if ((svi->svi328Col80Enabled && svi328Col80MemBankCtrlStatus()) && (address & 0xf800) == 0xf000)
     {
         svi328Col80MemWrite(address & 0xfff, value);
     }
@@ -77,7 +82,9 @@ static void sviMemWrite(void* ref, UInt16 address, UInt8 value)
 
 static UInt8 sviMemRead(void* ref, UInt16 address)
 {
-    if ((svi328Col80Enabled && svi328Col80MemBankCtrlStatus()) && (address & 0xf800) == 0xf000) 
+    Svi* svi = (Svi*)boardGetInfo((BoardContext*)ref)->ref;
+
+    if ((svi->svi328Col80Enabled && svi328Col80MemBankCtrlStatus()) && (address & 0xf800) == 0xf000) 
         return svi328Col80MemRead(address & 0xfff);
     else
         return slotRead(ref, address);
@@ -96,11 +103,11 @@ FFFF +---------+---------+---------+---------+
 0000 +---------+---------+---------+---------+
 */
 
-static void sviMemSetBank(UInt8 value)
+static void sviMemSetBank(Svi* svi, UInt8 value)
 {
     UInt8 psreg;
     int i;
-    psgAYReg15 = value;
+    svi->psgAYReg15 = value;
 
     // Default to bank 1 and 2
     psreg = 0;
@@ -132,7 +139,7 @@ static void sviMemSetBank(UInt8 value)
 
     /* Map the SVI-328 bank to slot and page */
     for (i = 0; i < 4; i++) {
-        slotSetRamSlot(i, psreg & 3);
+        slotSetRamSlot(svi->board, i, psreg & 3);
         psreg >>= 2;
     }
 }
@@ -163,51 +170,51 @@ Bit Name    Description
 * The /CART signal must be active for any effect,
   then all banks of RAM are disabled. */
 
-static UInt8 sviPsgReadHandler(void* arg, UInt16 address) 
+static UInt8 sviPsgReadHandler(Svi* svi, UInt16 address) 
 {
     UInt8 value = 0xff;
 
     switch (address) {
         case 0:
-            value = boardCaptureUInt8(17, sviJoyIoRead(joyIO));
-            lastJoystickValue = value;
+            value = boardCaptureUInt8(svi->board, 17, sviJoyIoRead(svi->joyIO));
+            svi->lastJoystickValue = value;
             break;
         case 1:
-            value = psgAYReg15;
+            value = svi->psgAYReg15;
             break;
     }
     return value;
 }
 
-static UInt8 sviPsgPollHandler(void* arg, UInt16 address)
+static UInt8 sviPsgPollHandler(Svi* svi, UInt16 address)
 {
     UInt8 value = 0xff;
 
     switch (address) {
         case 0:
-            value = lastJoystickValue;
+            value = svi->lastJoystickValue;
             break;
         case 1:
-            value = psgAYReg15;
+            value = svi->psgAYReg15;
             break;
     }
     return value;
 }
 
-static void sviPsgWriteHandler(void* arg, UInt16 address, UInt8 value) 
+static void sviPsgWriteHandler(Svi* svi, UInt16 address, UInt8 value) 
 {
     switch (address) {
     case 0:
         break;
     case 1:
         ledSetCapslock(value & 0x20 ? 1 : 0);
-        if ((psgAYReg15 & 0xDF) != (value & 0xDF))
-            sviMemSetBank(value);
+        if ((svi->psgAYReg15 & 0xDF) != (value & 0xDF))
+            sviMemSetBank(svi, value);
         break;
     }
 }
 
-static int sviLoad80Col(Machine* machine, VdpSyncMode vdpSyncMode)
+static int sviLoad80Col(Svi* svi, Machine* machine, VdpSyncMode vdpSyncMode)
 {
     // The 80 column cart has a memory mapping that doesn't fit
     // the blueMSX memory management yet, so it needs special
@@ -224,8 +231,8 @@ static int sviLoad80Col(Machine* machine, VdpSyncMode vdpSyncMode)
             if (buf != NULL) {
                 if (machine->slotInfo[i].romType == ROM_SVI328COL80) {
                     int frameRate = (vdpSyncMode == VDP_SYNC_60HZ) ? 60 : 50;
-                    svi328Col80Enabled = romMapperSvi328Col80Create(frameRate, buf, size);
-                    success &= svi328Col80Enabled;
+                    svi->svi328Col80Enabled = romMapperSvi328Col80Create(svi->board, frameRate, buf, size);
+                    success &= svi->svi328Col80Enabled;
                 }
                 free(buf);
             }
@@ -235,92 +242,100 @@ static int sviLoad80Col(Machine* machine, VdpSyncMode vdpSyncMode)
     return success;
 }
 
-static void reset()
+static void reset(Svi* svi)
 {
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(svi->board);
 
-    slotManagerReset();
+    slotManagerReset(svi->board);
 
-    if (r800 != NULL) {
-        r800Reset(r800, systemTime);
+    if (svi->r800 != NULL) {
+        r800Reset(svi->r800, systemTime);
     }
-    if (ay8910 != NULL) {
-        ay8910Reset(ay8910);
+    if (svi->ay8910 != NULL) {
+        ay8910Reset(svi->ay8910);
     }
 
-    sviMemSetBank(0xDF);
+    sviMemSetBank(svi, 0xDF);
 
     ledSetCapslock(0);
 
-    deviceManagerReset();
+    deviceManagerReset(svi->board);
 }
 
-static void destroy()
+static void destroy(Svi* svi)
 {
-    boardRemoveExternalDevices();
-    ay8910SetIoPort(ay8910, NULL, NULL, NULL, NULL);
-    ay8910Destroy(ay8910);
-    ay8910 = NULL;
-    audioKeyClickDestroy(keyClick);
-    r800DebugDestroy();
-    slotManagerDestroy();
-    deviceManagerDestroy();
-    r800Destroy(r800);
+    boardRemoveExternalDevices(svi->board);
+    ay8910SetIoPort(svi->ay8910, NULL, NULL, NULL, NULL);
+    ay8910Destroy(svi->ay8910);
+    svi->ay8910 = NULL;
+    audioKeyClickDestroy(svi->keyClick);
+    r800DebugDestroy(svi->r800Debug);
+    slotManagerDestroy(svi->board);
+    deviceManagerDestroy(svi->board);
+    r800Destroy(svi->r800);
+
+    free(svi);
 }
 
-static int getRefreshRate()
+static int getRefreshRate(Svi* svi)
 {
-    return vdpGetRefreshRate();
+    return vdpGetRefreshRate(svi->board);
 }
 
-static UInt32 getTimeTrace(int offset) {
-    return r800GetTimeTrace(r800, offset);
+static UInt32 getTimeTrace(Svi* svi, int offset) {
+    return r800GetTimeTrace(svi->r800, offset);
 }
 
-static void saveState()
+static void saveState(Svi* svi)
 {
-    SaveState* state = saveStateOpenForWrite("svi");
+    SaveState* state = saveStateOpenForWrite(svi->board, "svi");
 
-    saveStateSet(state, "svi328Col80Enabled", svi328Col80Enabled);
-    saveStateSet(state, "psgAYReg15", psgAYReg15);
+    saveStateSet(state, "svi328Col80Enabled", svi->svi328Col80Enabled);
+    saveStateSet(state, "psgAYReg15", svi->psgAYReg15);
 
     saveStateClose(state);
 
-    r800SaveState(r800);
-    deviceManagerSaveState();
-    slotSaveState();
-    ay8910SaveState(ay8910);
+    r800SaveState(svi->board, svi->r800);
+    deviceManagerSaveState(svi->board);
+    slotSaveState(svi->board);
+    ay8910SaveState(svi->ay8910);
 }
 
-static void loadState()
+static void loadState(Svi* svi)
 {
-    SaveState* state = saveStateOpenForRead("svi");
+    SaveState* state = saveStateOpenForRead(svi->board, "svi");
 
-    svi328Col80Enabled = saveStateGet(state, "svi328Col80Enabled", 0);
-    psgAYReg15      = (UInt8)saveStateGet(state, "psgAYReg15", 0);
+    svi->svi328Col80Enabled = saveStateGet(state, "svi328Col80Enabled", 0);
+    svi->psgAYReg15      = (UInt8)saveStateGet(state, "psgAYReg15", 0);
 
     saveStateClose(state);
     
-    r800LoadState(r800);
-    boardInit(&r800->systemTime);
-    deviceManagerLoadState();
-    slotLoadState();
-    ay8910LoadState(ay8910);
+    r800LoadState(svi->board, svi->r800);
+    boardInit(svi->board, &svi->r800->systemTime);
+    deviceManagerLoadState(svi->board);
+    slotLoadState(svi->board);
+    ay8910LoadState(svi->ay8910);
 }
 
-int sviCreate(Machine* machine, 
+int sviCreate(BoardContext* board, Machine* machine, 
               VdpSyncMode vdpSyncMode,
               BoardInfo* boardInfo)
 {
+    Svi* svi;
     int success;
     int i;
 
-    r800 = r800Create(CPU_ENABLE_M1, sviMemRead, sviMemWrite, ioPortRead, ioPortWrite, PatchZ80, boardTimerCheckTimeout, NULL, NULL, NULL, NULL, NULL, NULL);
+    svi = (Svi*)calloc(1, sizeof(Svi));
+    svi->board = board;
+
+    svi->r800 = r800Create(CPU_ENABLE_M1, sviMemRead, sviMemWrite, ioPortRead, ioPortWrite, PatchZ80, boardTimerCheckTimeout, NULL, NULL, NULL, NULL, NULL, board);
+    r800SetIoPortBlockWrite(svi->r800, ioPortCanWriteBlock, ioPortWriteBlock);
 
     boardInfo->cartridgeCount   = 1;
     boardInfo->diskdriveCount   = 2;
     boardInfo->casetteCount     = 1;
-    boardInfo->cpuRef           = r800;
+    boardInfo->cpuRef           = svi->r800;
+    boardInfo->ref              = svi;
 
     boardInfo->destroy          = destroy;
     boardInfo->softReset        = reset;
@@ -340,61 +355,61 @@ int sviCreate(Machine* machine,
     
     boardInfo->getTimeTrace     = getTimeTrace;
 
-    deviceManagerCreate();
-    boardInit(&r800->systemTime);
-    ioPortReset();
-    r800Reset(r800, 0);
-    mixerReset(boardGetMixer());
+    deviceManagerCreate(board);
+    boardInit(board, &svi->r800->systemTime);
+    ioPortReset(board);
+    r800Reset(svi->r800, 0);
+    mixerReset(boardGetMixer(board));
 
-    r800DebugCreate(r800);
+    svi->r800Debug = r800DebugCreate(board, svi->r800);
 
-    ay8910 = ay8910Create(boardGetMixer(), AY8910_SVI, PSGTYPE_AY8910, 0, machine->audio.psgpan);
-    ay8910SetIoPort(ay8910, sviPsgReadHandler, sviPsgPollHandler, sviPsgWriteHandler, NULL);
+    svi->ay8910 = ay8910Create(board, boardGetMixer(board), AY8910_SVI, PSGTYPE_AY8910, 0, machine->audio.psgpan);
+    ay8910SetIoPort(svi->ay8910, sviPsgReadHandler, sviPsgPollHandler, sviPsgWriteHandler, svi);
 
-    keyClick  = audioKeyClickCreate(boardGetMixer());
+    svi->keyClick  = audioKeyClickCreate(boardGetMixer(board));
 
-    joyIO = sviJoyIoCreate();
+    svi->joyIO = sviJoyIoCreate(board);
     
-    sviPPICreate(joyIO);
-    slotManagerCreate();
+    sviPPICreate(board, svi->joyIO);
+    slotManagerCreate(board);
 
-    svi328Col80Enabled = 0;
+    svi->svi328Col80Enabled = 0;
 
     /* Initialize VDP */
-    vdpCreate(VDP_SVI, machine->video.vdpVersion, vdpSyncMode, machine->video.vramSize / 0x4000);
+    vdpCreate(board, VDP_SVI, machine->video.vdpVersion, vdpSyncMode, machine->video.vramSize / 0x4000);
 
     /* Initialize memory */
     for (i = 0; i < 4; i++) {
-        slotSetSubslotted(i, 0);
+        slotSetSubslotted(board, i, 0);
     }
     for (i = 0; i < 2; i++) {
-        cartridgeSetSlotInfo(i, machine->cart[i].slot, 0);
+        cartridgeSetSlotInfo(board, i, machine->cart[i].slot, 0);
     }
 
-    success = machineInitialize(machine, &sviRam, &sviRamSize, &sviRamStart);
-    success &= sviLoad80Col(machine, vdpSyncMode);
+    success = machineInitialize(board, machine, &svi->sviRam, &svi->sviRamSize, &svi->sviRamStart);
+    success &= sviLoad80Col(svi, machine, vdpSyncMode);
 
     for (i = 0; i < 8; i++) {
-        slotMapRamPage(0, 0, i);
+        slotMapRamPage(board, 0, 0, i);
     }
 
-    sviMemSetBank(0xDF);
+    sviMemSetBank(svi, 0xDF);
     ledSetCapslock(0);
 
     if (success) {
-        success = boardInsertExternalDevices();
+        success = boardInsertExternalDevices(board);
     }
 
-    memset(KeyboardMap, 0xff, 16);
+    memset(svi->KeyboardMap, 0xff, 16);
 
-    r800SetFrequency(r800, CPU_Z80,  machine->cpu.freqZ80);
-    r800SetFrequency(r800, CPU_R800, machine->cpu.freqR800);
+    r800SetFrequency(svi->r800, CPU_Z80,  machine->cpu.freqZ80);
+    r800SetFrequency(svi->r800, CPU_R800, machine->cpu.freqR800);
 
-    diskEnable(0, machine->fdc.count > 0);
-    diskEnable(1, machine->fdc.count > 1);
+    diskEnable(board, 0, machine->fdc.count > 0);
+    diskEnable(board, 1, machine->fdc.count > 1);
 
     if (!success) {
-        destroy();
+        destroy(svi);
     }
 
     return success;
@@ -30,7 +30,7 @@
  
 #include "Board.h"
 
-int sviCreate(Machine* machine, 
+int sviCreate(BoardContext* board, Machine* machine,
               VdpSyncMode vdpSyncMode,
               BoardInfo* boardInfo);
 
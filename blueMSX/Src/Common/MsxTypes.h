@@ -37,6 +37,11 @@ extern "C" {
 #define __int64 long long
 #endif
 
+/* The state of one emulated machine, see Board.h. Declared here so
+ * that every device can take the board it belongs to.
+ */
+typedef struct BoardContext BoardContext;
+
 #ifdef _WIN32
 #define DIR_SEPARATOR "\\"
 #else
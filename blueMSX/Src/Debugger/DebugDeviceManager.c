@@ -35,81 +35,140 @@
 typedef struct {
     int handle;
     DebugCallbacks callbacks;
+    DebugToolCallbacks toolCallbacks;
     void* ref;
     char  name[32];
     DbgDeviceType type;
 } DebugDeviceInfo;
 
-typedef struct {
+typedef struct Watchpoint {
+    struct Watchpoint* next;
+    int address;
+    DbgWatchpointCondition condition;
+    UInt32 refValue;
+    int size;
+} Watchpoint;
+
+struct DebugDeviceContext {
     DebugDeviceInfo di[MAX_DEVICES];
     int count;
     int lastHandle;
-} DebugDeviceManager;
+    Watchpoint* watchpoints[MAX_DEVICES];
+};
 
-static DebugDeviceManager devManager;
+DebugDeviceContext* debugDeviceContextCreate()
+{
+    return calloc(1, sizeof(DebugDeviceContext));
+}
 
-void debugDeviceManagerReset() 
+void debugDeviceContextDestroy(DebugDeviceContext* context)
 {
-    devManager.count = 0;
-//    devManager.lastHandle = 0;
+    int i;
+
+    for (i = 0; i < MAX_DEVICES; i++) {
+        while (context->watchpoints[i] != NULL) {
+            Watchpoint* watchpoint = context->watchpoints[i];
+            context->watchpoints[i] = watchpoint->next;
+            free(watchpoint);
+        }
+    }
+    free(context);
 }
 
-int debugDeviceRegister(DbgDeviceType type, const char* name, DebugCallbacks* callbacks, void* ref)
+void debugDeviceManagerReset(BoardContext* board) 
 {
-    if (devManager.count >= MAX_DEVICES) {
+    DebugDeviceContext* ctx = boardGetDebugDevices(board);
+
+    ctx->count = 0;
+//    ctx->lastHandle = 0;
+}
+
+int debugDeviceRegister(BoardContext* board, DbgDeviceType type, const char* name, DebugCallbacks* callbacks, void* ref)
+{
+    DebugDeviceContext* ctx = boardGetDebugDevices(board);
+
+    if (ctx->count >= MAX_DEVICES) {
         return 0;
     }
 
-    devManager.di[devManager.count].handle    = ++devManager.lastHandle;
-    devManager.di[devManager.count].callbacks = *callbacks;
-    devManager.di[devManager.count].ref       = ref;
-    devManager.di[devManager.count].type      = type;
+    ctx->di[ctx->count].handle    = ++ctx->lastHandle;
+    ctx->di[ctx->count].callbacks = *callbacks;
+    memset(&ctx->di[ctx->count].toolCallbacks, 0, sizeof(DebugToolCallbacks));
+    ctx->di[ctx->count].ref       = ref;
+    ctx->di[ctx->count].type      = type;
 
-    strcpy(devManager.di[devManager.count].name, name);
+    strcpy(ctx->di[ctx->count].name, name);
 
-    devManager.count++;
+    ctx->count++;
 
-    return devManager.lastHandle - 1;
+    return ctx->lastHandle - 1;
 }
 
-void debugDeviceUnregister(int handle)
+void debugDeviceUnregister(BoardContext* board, int handle)
 {
+    DebugDeviceContext* ctx = boardGetDebugDevices(board);
     int i;
 
-    if (devManager.count == 0) {
+    if (ctx->count == 0) {
         return;
     }
 
-    for (i = 0; i < devManager.count; i++) {
-        if (devManager.di[i].handle == handle + 1) {
+    for (i = 0; i < ctx->count; i++) {
+        if (ctx->di[i].handle == handle + 1) {
             break;
         }
     }
 
-    if (i == devManager.count) {
+    if (i == ctx->count) {
         return;
     }
 
-    devManager.count--;
-    while (i < devManager.count) {
-        devManager.di[i] = devManager.di[i + 1];
+    ctx->count--;
+    while (i < ctx->count) {
+        ctx->di[i] = ctx->di[i + 1];
         i++;
     }
 }
 
-void debugDeviceGetSnapshot(DbgDevice** dbgDeviceList, int* count)
+void debugDeviceSetToolCallbacks(BoardContext* board, int handle, DebugToolCallbacks* toolCallbacks)
 {
+    DebugDeviceContext* ctx = boardGetDebugDevices(board);
+    int i;
+
+    for (i = 0; i < ctx->count; i++) {
+        if (ctx->di[i].handle == handle + 1) {
+            ctx->di[i].toolCallbacks = *toolCallbacks;
+            return;
+        }
+    }
+}
+
+void debugDeviceDebuggerChanged(BoardContext* board)
+{
+    DebugDeviceContext* ctx = boardGetDebugDevices(board);
+    int i;
+
+    for (i = 0; i < ctx->count; i++) {
+        if (ctx->di[i].toolCallbacks.debuggerChanged != NULL) {
+            ctx->di[i].toolCallbacks.debuggerChanged(ctx->di[i].ref);
+        }
+    }
+}
+
+void debugDeviceGetSnapshot(BoardContext* board, DbgDevice** dbgDeviceList, int* count)
+{
+    DebugDeviceContext* ctx = boardGetDebugDevices(board);
     int index = 0;
     int i;
 
-    for (i = 0; i < devManager.count; i++) {
-        if (devManager.di[i].handle != 0) {
+    for (i = 0; i < ctx->count; i++) {
+        if (ctx->di[i].handle != 0) {
             dbgDeviceList[index] = calloc(1, sizeof(DbgDevice));
-            strcpy(dbgDeviceList[index]->name, devManager.di[i].name);
-            dbgDeviceList[index]->type = devManager.di[i].type;
-            dbgDeviceList[index]->deviceHandle = devManager.di[i].handle;
-            if (devManager.di[i].callbacks.getDebugInfo != NULL) {
-                devManager.di[i].callbacks.getDebugInfo(devManager.di[i].ref, dbgDeviceList[index++]);
+            strcpy(dbgDeviceList[index]->name, ctx->di[i].name);
+            dbgDeviceList[index]->type = ctx->di[i].type;
+            dbgDeviceList[index]->deviceHandle = ctx->di[i].handle;
+            if (ctx->di[i].callbacks.getDebugInfo != NULL) {
+                ctx->di[i].callbacks.getDebugInfo(ctx->di[i].ref, dbgDeviceList[index++]);
             }
         }
     }
@@ -117,54 +176,119 @@ void debugDeviceGetSnapshot(DbgDevice** dbgDeviceList, int* count)
     *count = index;
 }
 
-int debugDeviceWriteMemory(DbgMemoryBlock* memoryBlock, void* data, int startAddr, int size)
+int debugDeviceWriteMemory(BoardContext* board, DbgMemoryBlock* memoryBlock, void* data, int startAddr, int size)
 {
+    DebugDeviceContext* ctx = boardGetDebugDevices(board);
     int i;
 
-    for (i = 0; i < devManager.count; i++) {
-        if (devManager.di[i].handle == memoryBlock->deviceHandle) {
-            if (devManager.di[i].callbacks.writeMemory != NULL) {
-                return devManager.di[i].callbacks.writeMemory(devManager.di[i].ref, memoryBlock->name, data, startAddr, size);
+    for (i = 0; i < ctx->count; i++) {
+        if (ctx->di[i].handle == memoryBlock->deviceHandle) {
+            if (ctx->di[i].callbacks.writeMemory != NULL) {
+                return ctx->di[i].callbacks.writeMemory(ctx->di[i].ref, memoryBlock->name, data, startAddr, size);
             }
         }
     }
     return 0;
 }
 
-int debugDeviceWriteRegister(DbgRegisterBank* regBank, int regIndex, UInt32 value)
+int debugDeviceWriteRegister(BoardContext* board, DbgRegisterBank* regBank, int regIndex, UInt32 value)
 {
+    DebugDeviceContext* ctx = boardGetDebugDevices(board);
     int i;
 
-    for (i = 0; i < devManager.count; i++) {
-        if (devManager.di[i].handle == regBank->deviceHandle) {
-            if (devManager.di[i].callbacks.writeRegister != NULL) {
-                return devManager.di[i].callbacks.writeRegister(devManager.di[i].ref, regBank->name, regIndex, value);
+    for (i = 0; i < ctx->count; i++) {
+        if (ctx->di[i].handle == regBank->deviceHandle) {
+            if (ctx->di[i].callbacks.writeRegister != NULL) {
+                return ctx->di[i].callbacks.writeRegister(ctx->di[i].ref, regBank->name, regIndex, value);
             }
         }
     }
     return 0;
 }
 
-int debugDeviceWriteIoPort(DbgIoPorts* ioPorts, int portIndex, UInt32 value)
+int debugDeviceWriteIoPort(BoardContext* board, DbgIoPorts* ioPorts, int portIndex, UInt32 value)
 {
+    DebugDeviceContext* ctx = boardGetDebugDevices(board);
     int i;
 
-    for (i = 0; i < devManager.count; i++) {
-        if (devManager.di[i].handle == ioPorts->deviceHandle) {
-            if (devManager.di[i].callbacks.writeIoPort != NULL) {
-                return devManager.di[i].callbacks.writeIoPort(devManager.di[i].ref, ioPorts->name, portIndex, value);
+    for (i = 0; i < ctx->count; i++) {
+        if (ctx->di[i].handle == ioPorts->deviceHandle) {
+            if (ctx->di[i].callbacks.writeIoPort != NULL) {
+                return ctx->di[i].callbacks.writeIoPort(ctx->di[i].ref, ioPorts->name, portIndex, value);
             }
         }
     }
     return 0;
 }
 
-DbgDevice* dbgDeviceCreate(int handle)
+int debugDeviceSetProfiling(BoardContext* board, DbgDeviceType devType, int enable)
 {
+    DebugDeviceContext* ctx = boardGetDebugDevices(board);
+    int rv = 0;
+    int i;
+
+    for (i = 0; i < ctx->count; i++) {
+        if (ctx->di[i].type == devType) {
+            if (ctx->di[i].toolCallbacks.setProfiling != NULL) {
+                rv |= ctx->di[i].toolCallbacks.setProfiling(ctx->di[i].ref, enable);
+            }
+        }
+    }
+    return rv;
+}
+
+int debugDeviceSaveProfile(BoardContext* board, DbgDeviceType devType, const char* fileName)
+{
+    DebugDeviceContext* ctx = boardGetDebugDevices(board);
+    int i;
+
+    for (i = 0; i < ctx->count; i++) {
+        if (ctx->di[i].type == devType) {
+            if (ctx->di[i].toolCallbacks.saveProfile != NULL) {
+                return ctx->di[i].toolCallbacks.saveProfile(ctx->di[i].ref, fileName);
+            }
+        }
+    }
+    return 0;
+}
+
+int debugDeviceSetTrace(BoardContext* board, DbgDeviceType devType, const char* fileName, UInt64 size)
+{
+    DebugDeviceContext* ctx = boardGetDebugDevices(board);
+    int i;
+
+    for (i = 0; i < ctx->count; i++) {
+        if (ctx->di[i].type == devType) {
+            if (ctx->di[i].toolCallbacks.setTrace != NULL) {
+                return ctx->di[i].toolCallbacks.setTrace(ctx->di[i].ref, fileName, size);
+            }
+        }
+    }
+    return 0;
+}
+
+int debugDeviceSaveTrace(BoardContext* board, DbgDeviceType devType, const char* fileName)
+{
+    DebugDeviceContext* ctx = boardGetDebugDevices(board);
+    int i;
+
+    for (i = 0; i < ctx->count; i++) {
+        if (ctx->di[i].type == devType) {
+            if (ctx->di[i].toolCallbacks.saveTrace != NULL) {
+                return ctx->di[i].toolCallbacks.saveTrace(ctx->di[i].ref, fileName);
+            }
+        }
+    }
+    return 0;
+}
+
+DbgDevice* dbgDeviceCreate(BoardContext* board, int handle)
+{
+    DebugDeviceContext* ctx = boardGetDebugDevices(board);
     DbgDevice* device = calloc(1, sizeof(DbgDevice));
 
-    strcpy(device->name, devManager.di[handle].name);
-    device->deviceHandle = devManager.di[handle].handle;
+    strcpy(device->name, ctx->di[handle].name);
+    device->deviceHandle = ctx->di[handle].handle;
 
     return device;
 }
@@ -304,19 +428,10 @@ void dbgIoPortsAddPort(DbgIoPorts* ioPorts,
     }
 }
 
-typedef struct Watchpoint {
-    struct Watchpoint* next;
-    int address;
-    DbgWatchpointCondition condition;
-    UInt32 refValue;
-    int size;
-} Watchpoint;
-
-Watchpoint* watchpoints[MAX_DEVICES];
-
-void debugDeviceSetMemoryWatchpoint(DbgDeviceType devType, int address, DbgWatchpointCondition condition, UInt32 refValue, int size)
+void debugDeviceSetMemoryWatchpoint(BoardContext* board, DbgDeviceType devType, int address, DbgWatchpointCondition condition, UInt32 refValue, int size)
 {
-    Watchpoint* watchpoint = watchpoints[devType];
+    DebugDeviceContext* ctx = boardGetDebugDevices(board);
+    Watchpoint* watchpoint = ctx->watchpoints[devType];
 
     while (watchpoint != NULL) {
         if (watchpoint->address == address) {
@@ -326,24 +441,27 @@ void debugDeviceSetMemoryWatchpoint(DbgDeviceType devType, int address, DbgWatch
     }
     if (watchpoint == NULL) {
         watchpoint = (Watchpoint*)calloc(1, sizeof(Watchpoint));
-        watchpoint->next = watchpoints[devType];
-        watchpoints[devType] = watchpoint;
+        watchpoint->next = ctx->watchpoints[devType];
+        ctx->watchpoints[devType] = watchpoint;
     }
 
     watchpoint->address = address;
     watchpoint->condition = condition;
     watchpoint->refValue = refValue;
     watchpoint->size = size;
+
+    debugDeviceDebuggerChanged(board);
 }
 
-void debugDeviceClearMemoryWatchpoint(DbgDeviceType devType, int address)
+void debugDeviceClearMemoryWatchpoint(BoardContext* board, DbgDeviceType devType, int address)
 {
-    Watchpoint* watchpoint = watchpoints[devType];
+    DebugDeviceContext* ctx = boardGetDebugDevices(board);
+    Watchpoint* watchpoint = ctx->watchpoints[devType];
     Watchpoint* prevWatchpoint = NULL;
     while (watchpoint != NULL) {
         if (watchpoint->address == address) {
             if (prevWatchpoint == NULL) {
-                watchpoints[devType] = watchpoint->next;
+                ctx->watchpoints[devType] = watchpoint->next;
             }
             else {
                 prevWatchpoint->next = watchpoint->next;
@@ -354,10 +472,26 @@ void debugDeviceClearMemoryWatchpoint(DbgDeviceType devType, int address)
         prevWatchpoint = watchpoint;
         watchpoint = watchpoint->next;
     }
+
+    debugDeviceDebuggerChanged(board);
+}
+
+int debugDeviceHasWatchpoints(BoardContext* board)
+{
+    DebugDeviceContext* ctx = boardGetDebugDevices(board);
+    int i;
+
+    for (i = 0; i < MAX_DEVICES; i++) {
+        if (ctx->watchpoints[i] != NULL) {
+            return 1;
+        }
+    }
+    return 0;
 }
 
-void tryWatchpoint(DbgDeviceType devType, int address, UInt8 value, void* ref, WatchpointReadMemCallback callback) {
-    Watchpoint* watchpoint = watchpoints[devType];
+void tryWatchpoint(BoardContext* board, DbgDeviceType devType, int address, UInt8 value, void* ref, WatchpointReadMemCallback callback) {
+    DebugDeviceContext* ctx = boardGetDebugDevices(board);
+    Watchpoint* watchpoint = ctx->watchpoints[devType];
     while (watchpoint != NULL) {
         if (address >= watchpoint->address && address < watchpoint->address + watchpoint->size) {
             UInt32 checkValue = 0;
@@ -395,7 +529,7 @@ void tryWatchpoint(DbgDeviceType devType, int address, UInt8 value, void* ref, W
                 break;
             }
             if (breakpointHit) {
-                boardOnBreakpoint(0);
+                boardOnBreakpoint(board, 0);
                 return;
             }
         }
@@ -38,13 +38,37 @@ typedef struct {
     int (*writeIoPort)(void* ref, char* name, UInt16 port, UInt32 value);
 } DebugCallbacks;
 
+// Optional profiling and tracing callbacks of a device, set after it is
+// registered
+typedef struct {
+    int (*setProfiling)(void* ref, int enable);
+    int (*saveProfile)(void* ref, const char* fileName);
+    int (*setTrace)(void* ref, const char* fileName, UInt64 size);
+    int (*saveTrace)(void* ref, const char* fileName);
+    // Called when a debugger is attached or detached or the watchpoints
+    // change, e.g. to select the CPU core with the debugger support
+    void (*debuggerChanged)(void* ref);
+} DebugToolCallbacks;
+
 typedef UInt8 (*WatchpointReadMemCallback)(void*, int);
 
+// The debug devices and watchpoints of a board, found with
+// boardGetDebugDevices()
+typedef struct DebugDeviceContext DebugDeviceContext;
+
+DebugDeviceContext* debugDeviceContextCreate();
+void debugDeviceContextDestroy(DebugDeviceContext* context);
+
 
-void debugDeviceManagerReset();
+void debugDeviceManagerReset(BoardContext* board);
 
-int debugDeviceRegister(DbgDeviceType type, const char* name, DebugCallbacks* callbacks, void* ref);
-void debugDeviceUnregister(int handle);
+int debugDeviceRegister(BoardContext* board, DbgDeviceType type, const char* name, DebugCallbacks* callbacks, void* ref);
+void debugDeviceUnregister(BoardContext* board, int handle);
+void debugDeviceSetToolCallbacks(BoardContext* board, int handle, DebugToolCallbacks* toolCallbacks);
+
+// Tells the devices that a debugger was attached or detached. Setting and
+// clearing watchpoints does it too.
+void debugDeviceDebuggerChanged(BoardContext* board);
 
 DbgMemoryBlock* dbgDeviceAddMemoryBlock(DbgDevice* dbgDevice,
                                         const char* name,
@@ -83,14 +107,23 @@ void dbgIoPortsAddPort(DbgIoPorts* ioPorts,
                        DbgIoPortDirection direction,
                        UInt8 value);
 
-void debugDeviceGetSnapshot(DbgDevice** dbgDeviceList, int* count);
+void debugDeviceGetSnapshot(BoardContext* board, DbgDevice** dbgDeviceList, int* count);
+
+int debugDeviceWriteMemory(BoardContext* board, DbgMemoryBlock* memoryBlock, void* data, int startAddr, int size);
+int debugDeviceWriteRegister(BoardContext* board, DbgRegisterBank* regBank, int regIndex, UInt32 value);
+int debugDeviceWriteIoPort(BoardContext* board, DbgIoPorts* ioPorts, int portIndex, UInt32 value);
+
+// Profiling of the devices of a type. Returns 1 if any device of the
+// type supports it.
+int debugDeviceSetProfiling(BoardContext* board, DbgDeviceType devType, int enable);
+int debugDeviceSaveProfile(BoardContext* board, DbgDeviceType devType, const char* fileName);
 
-int debugDeviceWriteMemory(DbgMemoryBlock* memoryBlock, void* data, int startAddr, int size);
-int debugDeviceWriteRegister(DbgRegisterBank* regBank, int regIndex, UInt32 value);
-int debugDeviceWriteIoPort(DbgIoPorts* ioPorts, int portIndex, UInt32 value);
+int debugDeviceSetTrace(BoardContext* board, DbgDeviceType devType, const char* fileName, UInt64 size);
+int debugDeviceSaveTrace(BoardContext* board, DbgDeviceType devType, const char* fileName);
 
-void debugDeviceSetMemoryWatchpoint(DbgDeviceType devType, int address, DbgWatchpointCondition condition, UInt32 refValue, int size);
-void debugDeviceClearMemoryWatchpoint(DbgDeviceType devType, int address);
-void tryWatchpoint(DbgDeviceType devType, int address, UInt8 value, void* ref, WatchpointReadMemCallback callback);
+void debugDeviceSetMemoryWatchpoint(BoardContext* board, DbgDeviceType devType, int address, DbgWatchpointCondition condition, UInt32 refValue, int size);
+void debugDeviceClearMemoryWatchpoint(BoardContext* board, DbgDeviceType devType, int address);
+int  debugDeviceHasWatchpoints(BoardContext* board);
+void tryWatchpoint(BoardContext* board, DbgDeviceType devType, int address, UInt8 value, void* ref, WatchpointReadMemCallback callback);
 
 #endif /*DEBUG_DEVICE_MANAGER_H*/
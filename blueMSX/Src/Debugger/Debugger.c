@@ -31,6 +31,7 @@
 #include "Emulator.h"
 #include "Actions.h"
 #include "Board.h"
+#include "R800Debug.h"
 #include <stdlib.h>
 
 struct BlueDebugger {
@@ -93,6 +94,8 @@ BlueDebugger* debuggerCreate(DebuggerEvent onEmulatorStart,
         }
     }
 
+    debugDeviceDebuggerChanged(emulatorGetBoard());
+
     return debugger;
 }
 
@@ -109,6 +112,8 @@ void debuggerDestroy(BlueDebugger* debugger)
     }
 
     free(debugger);
+
+    debugDeviceDebuggerChanged(emulatorGetBoard());
 }
 
 int debuggerCheckVramAccess(void)
@@ -116,6 +121,18 @@ int debuggerCheckVramAccess(void)
     return debuggerVramAccessEnable > 0;
 }
 
+int debuggerIsPresent(void)
+{
+    int i;
+
+    for (i = 0; i < MAX_DEBUGGERS; i++) {
+        if (debuggerList[i] != NULL) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
 void debuggerNotifyEmulatorStart()
 {
     int i;
@@ -213,24 +230,24 @@ DbgSnapshot* dbgSnapshotCreate()
 
     dbgSnapshot = malloc(sizeof(DbgSnapshot));
 
-    debugDeviceGetSnapshot(dbgSnapshot->dbgDevice, &dbgSnapshot->count);
+    debugDeviceGetSnapshot(emulatorGetBoard(), dbgSnapshot->dbgDevice, &dbgSnapshot->count);
 
     return dbgSnapshot;
 }
 
 int dbgDeviceWriteMemory(DbgMemoryBlock* memoryBlock, void* data, int startAddr, int size)
 {
-    return debugDeviceWriteMemory(memoryBlock, data, startAddr, size);
+    return debugDeviceWriteMemory(emulatorGetBoard(), memoryBlock, data, startAddr, size);
 }
 
 int dbgDeviceWriteRegister(DbgRegisterBank* regBank, int regIndex, UInt32 value)
 {
-    return debugDeviceWriteRegister(regBank, regIndex, value);
+    return debugDeviceWriteRegister(emulatorGetBoard(), regBank, regIndex, value);
 }
 
 int dbgDeviceWriteIoPort(DbgIoPorts* ioPorts, int portIndex, UInt32 value)
 {
-    return debugDeviceWriteIoPort(ioPorts, portIndex, value);
+    return debugDeviceWriteIoPort(emulatorGetBoard(), ioPorts, portIndex, value);
 }
 
 void dbgSnapshotDestroy(DbgSnapshot* dbgSnapshot)
@@ -362,12 +379,12 @@ void dbgStepBack()
 
 void dbgSetBreakpoint(UInt16 address)
 {
-    boardSetBreakpoint(address);
+    boardSetBreakpoint(emulatorGetBoard(), address);
 }
 
 void dbgClearBreakpoint(UInt16 address)
 {
-    boardClearBreakpoint(address);
+    boardClearBreakpoint(emulatorGetBoard(), address);
 }
 
 void dbgEnableVramAccessCheck(int enable)
@@ -382,10 +399,30 @@ void dbgEnableVramAccessCheck(int enable)
 
 void dbgSetWatchpoint(DbgDeviceType devType, int address, DbgWatchpointCondition condition, UInt32 referenceValue, int size)
 {
-    debugDeviceSetMemoryWatchpoint(devType, address, condition, referenceValue, size);
+    debugDeviceSetMemoryWatchpoint(emulatorGetBoard(), devType, address, condition, referenceValue, size);
 }
 
 void dbgClearWatchpoint(DbgDeviceType devType, int address)
 {
-    debugDeviceClearMemoryWatchpoint(devType, address);
+    debugDeviceClearMemoryWatchpoint(emulatorGetBoard(), devType, address);
+}
+
+int dbgSetProfiling(DbgDeviceType devType, int enable)
+{
+    return debugDeviceSetProfiling(emulatorGetBoard(), devType, enable);
+}
+
+int dbgSaveProfile(DbgDeviceType devType, const char* fileName)
+{
+    return debugDeviceSaveProfile(emulatorGetBoard(), devType, fileName);
+}
+
+int dbgSetTrace(DbgDeviceType devType, const char* fileName, UInt64 size)
+{
+    return debugDeviceSetTrace(emulatorGetBoard(), devType, fileName, size);
+}
+
+int dbgSaveTrace(DbgDeviceType devType, const char* fileName)
+{
+    return debugDeviceSaveTrace(emulatorGetBoard(), devType, fileName);
 }
@@ -141,6 +141,16 @@ void dbgClearBreakpoint(UInt16 address);
 void dbgSetWatchpoint(DbgDeviceType devType, int address, DbgWatchpointCondition condition, UInt32 referenceValue, int size);
 void dbgClearWatchpoint(DbgDeviceType devType, int address);
 
+// Cycle profiling of emulated software. Enabling clears the collected
+// profile, which is saved in callgrind format.
+int dbgSetProfiling(DbgDeviceType devType, int enable);
+int dbgSaveProfile(DbgDeviceType devType, const char* fileName);
+
+// Binary instruction trace in a ring of the given number of bytes,
+// mapped to a file if a file name is given. A size of 0 stops tracing.
+int dbgSetTrace(DbgDeviceType devType, const char* fileName, UInt64 size);
+int dbgSaveTrace(DbgDeviceType devType, const char* fileName);
+
 int debuggerCheckVramAccess(void);
 
 void dbgEnableVramAccessCheck(int enable);
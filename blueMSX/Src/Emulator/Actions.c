@@ -30,6 +30,7 @@
 #include "Switches.h"
 #include "AudioMixer.h"
 #include "Board.h"
+#include "SaveState.h"
 #include "Casette.h"
 #include "Debugger.h"
 #include "Disk.h"
@@ -136,7 +137,7 @@ void actionDiskRemove(int i) {
     updateExtendedDiskName(i, state.properties->media.disks[i].fileName, state.properties->media.disks[i].fileNameInZip);
     if (emulatorGetState() != EMU_STOPPED) {
         emulatorSuspend();
-        boardChangeDiskette(i, NULL, NULL);
+        boardChangeDiskette(emulatorGetBoard(), i, NULL, NULL);
         emulatorResume();
     }
     archUpdateMenu(0);
@@ -187,7 +188,7 @@ void actionHarddiskRemove(int diskNo)
     updateExtendedDiskName(diskNo, state.properties->media.disks[diskNo].fileName, state.properties->media.disks[diskNo].fileNameInZip);
     if (emulatorGetState() != EMU_STOPPED) {
         emulatorSuspend();
-        boardChangeDiskette(diskNo, NULL, NULL);
+        boardChangeDiskette(emulatorGetBoard(), diskNo, NULL, NULL);
         emulatorResume();
     }
     archUpdateMenu(0);
@@ -210,7 +211,7 @@ void actionHarddiskRemoveAll()
                     state.properties->media.disks[diskNo].fileName[0] = 0;
                     state.properties->media.disks[diskNo].fileNameInZip[0] = 0;
                     updateExtendedDiskName(diskNo, state.properties->media.disks[diskNo].fileName, state.properties->media.disks[diskNo].fileNameInZip);
-                    if (flag) boardChangeDiskette(diskNo, NULL, NULL);
+                    if (flag) boardChangeDiskette(emulatorGetBoard(), diskNo, NULL, NULL);
                 }
             }
         //}
@@ -250,11 +251,11 @@ void actionInit(Video* video, Properties* properties, Mixer* mixer)
 }
 
 void actionToggleSpriteEnable() {
-    vdpSetSpritesEnable(!vdpGetSpritesEnable());
+    boardSetSpritesEnable(emulatorGetBoard(), !boardGetSpritesEnable(emulatorGetBoard()));
 }
 
 void actionToggleNoSpriteLimits() {
-    vdpSetNoSpriteLimits(!vdpGetNoSpritesLimit());
+    boardSetNoSpriteLimits(emulatorGetBoard(), !boardGetNoSpriteLimits(emulatorGetBoard()));
 }
 
 void actionToggleMsxKeyboardQuirk() {
@@ -278,7 +279,7 @@ void actionTogglePauseSwitch() {
 
 void actionToggleFdcTiming() {
     state.properties->emulation.enableFdcTiming = !state.properties->emulation.enableFdcTiming;
-    boardSetFdcTimingEnable(state.properties->emulation.enableFdcTiming);
+    boardSetFdcTimingEnable(emulatorGetBoard(), state.properties->emulation.enableFdcTiming);
 }
 
 
@@ -361,7 +362,7 @@ void actionVideoCapturePlay() {
 }
 
 void actionVideoCaptureSave() {
-    if (boardCaptureHasData()) {
+    if (boardCaptureHasData(emulatorGetBoard())) {
         archVideoCaptureSave();
     }
 }
@@ -373,7 +374,7 @@ void actionVideoCaptureStop() {
     
     emulatorSuspend();
     
-    boardCaptureStop();
+    boardCaptureStop(emulatorGetBoard());
 
     emulatorResume();
     archUpdateMenu(0);
@@ -382,7 +383,7 @@ void actionVideoCaptureStop() {
 void actionVideoCaptureRec() {
     if (emulatorGetState() == EMU_STOPPED) {
         strcpy(state.properties->filehistory.videocap, generateSaveFilename(state.properties, videoDir, videoPrefix, ".cap", 2));
-        boardCaptureStart(state.properties->filehistory.videocap);
+        boardCaptureStart(emulatorGetBoard(), state.properties->filehistory.videocap);
         actionEmuTogglePause();
         archUpdateMenu(0);
         return;
@@ -391,7 +392,7 @@ void actionVideoCaptureRec() {
     emulatorSuspend();
 
     strcpy(state.properties->filehistory.videocap, generateSaveFilename(state.properties, videoDir, videoPrefix, ".cap", 2));
-    boardCaptureStart(state.properties->filehistory.videocap);
+    boardCaptureStart(emulatorGetBoard(), state.properties->filehistory.videocap);
 
     emulatorResume();
     archUpdateMenu(0);
@@ -428,13 +429,14 @@ void actionSaveState() {
             }
 
             strcpy(ptr, ".sta");
-            boardSaveState(filename, 1);
+            boardSaveStateAsync(emulatorGetBoard(), filename, 1, NULL, NULL);
         }
         emulatorResume();
     }
 }
 
 void actionQuickLoadState() {
+    saveStateFlush();
     if (fileExist(state.properties->filehistory.quicksave, NULL)) {
         emulatorStop();
         emulatorStart(state.properties->filehistory.quicksave);
@@ -446,7 +448,7 @@ void actionQuickSaveState() {
     if (emulatorGetState() != EMU_STOPPED) {
         emulatorSuspend();
         strcpy(state.properties->filehistory.quicksave, generateSaveFilename(state.properties, stateDir, statePrefix, ".sta", 2));
-        boardSaveState(state.properties->filehistory.quicksave, 1);
+        boardSaveStateAsync(emulatorGetBoard(), state.properties->filehistory.quicksave, 1, NULL, NULL);
         emulatorResume();
     }
 }
@@ -457,6 +459,7 @@ void actionQuickSaveStateUndo() {
         // convert "c:\blah\states\blah_19.sta" to "c:\blah\states\blah_18.sta"
         // if its at "blah_00.sta" and "blah_99.sta" exists, then wrap around
         // (as quicksavestate goes from 99 -> 00)
+        saveStateFlush();
         if (state.properties->filehistory.quicksave && strlen(state.properties->filehistory.quicksave) > 10) {
             char numstr[5], *oldstatefilename;
             int numstrtonum;
@@ -578,7 +581,7 @@ void actionDiskQuickChange() {
 #ifdef WII
             archDiskQuickChangeNotify(0, state.properties->media.disks[0].fileName, state.properties->media.disks[0].fileNameInZip);
 #endif
-            boardChangeDiskette(0, state.properties->media.disks[0].fileName, state.properties->media.disks[0].fileNameInZip);
+            boardChangeDiskette(emulatorGetBoard(), 0, state.properties->media.disks[0].fileName, state.properties->media.disks[0].fileNameInZip);
             updateExtendedDiskName(0, state.properties->media.disks[0].fileName, state.properties->media.disks[0].fileNameInZip);
         }
         else {
@@ -586,7 +589,7 @@ void actionDiskQuickChange() {
 #ifdef WII
             archDiskQuickChangeNotify(0, state.properties->media.disks[0].fileName, state.properties->media.disks[0].fileNameInZip);
 #endif
-            boardChangeDiskette(0, state.properties->media.disks[0].fileName, NULL);
+            boardChangeDiskette(emulatorGetBoard(), 0, state.properties->media.disks[0].fileName, NULL);
             updateExtendedDiskName(0, state.properties->media.disks[0].fileName, state.properties->media.disks[0].fileNameInZip);
         }
 #ifndef WII
@@ -670,7 +673,7 @@ void actionCasInsert() {
     emulatorSuspend();
     filename = archFilenameGetOpenCas(state.properties);
     if (filename != NULL) {
-        if (state.properties->cassette.rewindAfterInsert) tapeRewindNextInsert();
+        if (state.properties->cassette.rewindAfterInsert) tapeRewindNextInsert(emulatorGetBoard());
         insertCassette(state.properties, 0, filename, NULL, 0);
     }
     emulatorResume();
@@ -682,17 +685,17 @@ void actionCasRewind() {
             emulatorSuspend();
         }
         else {
-            tapeSetReadOnly(1);
-            boardChangeCassette(0, strlen(state.properties->media.tapes[0].fileName) ? state.properties->media.tapes[0].fileName : NULL, 
+            tapeSetReadOnly(emulatorGetBoard(), 1);
+            boardChangeCassette(emulatorGetBoard(), 0, strlen(state.properties->media.tapes[0].fileName) ? state.properties->media.tapes[0].fileName : NULL, 
                                 strlen(state.properties->media.tapes[0].fileNameInZip) ? state.properties->media.tapes[0].fileNameInZip : NULL);
         }
-        tapeSetCurrentPos(0);
+        tapeSetCurrentPos(emulatorGetBoard(), 0);
     if (emulatorGetState() != EMU_STOPPED) {
         emulatorResume();
     }
     else {
-        boardChangeCassette(0, NULL, NULL);
-        tapeSetReadOnly(state.properties->cassette.readOnly);
+        boardChangeCassette(emulatorGetBoard(), 0, NULL, NULL);
+        tapeSetReadOnly(emulatorGetBoard(), state.properties->cassette.readOnly);
     }
     archUpdateMenu(0);
 }
@@ -705,7 +708,7 @@ void actionEmuResetSoft() {
     archUpdateMenu(0);
     if (emulatorGetState() == EMU_RUNNING) {
         emulatorSuspend();
-        boardReset();
+        boardReset(emulatorGetBoard());
         debuggerNotifyEmulatorReset();
         emulatorResume();
     }
@@ -767,7 +770,7 @@ void actionTapeRemove(int i) {
     state.properties->media.tapes[i].fileNameInZip[0] = 0;
     if (emulatorGetState() != EMU_STOPPED) {
         emulatorSuspend();
-        boardChangeCassette(i, NULL, NULL);
+        boardChangeCassette(emulatorGetBoard(), i, NULL, NULL);
         emulatorResume();
     }
     updateExtendedCasName(0, state.properties->media.tapes[0].fileName, state.properties->media.tapes[0].fileNameInZip);
@@ -786,12 +789,12 @@ void actionCartRemove(int i) {
         }
         else {
             emulatorSuspend();
-            boardChangeCartridge(i, ROM_UNKNOWN, NULL, NULL);
+            boardChangeCartridge(emulatorGetBoard(), i, ROM_UNKNOWN, NULL, NULL);
             emulatorResume();
         }
     }
     else {
-        boardChangeCartridge(i, ROM_UNKNOWN, NULL, NULL);
+        boardChangeCartridge(emulatorGetBoard(), i, ROM_UNKNOWN, NULL, NULL);
     }
     archUpdateMenu(0);
 }
@@ -843,27 +846,27 @@ void actionCasSave() {
         int type;
 
         if (emulatorGetState() == EMU_STOPPED) {
-            tapeSetReadOnly(1);
-            boardChangeCassette(0, strlen(state.properties->media.tapes[0].fileName) ? state.properties->media.tapes[0].fileName : NULL, 
+            tapeSetReadOnly(emulatorGetBoard(), 1);
+            boardChangeCassette(emulatorGetBoard(), 0, strlen(state.properties->media.tapes[0].fileName) ? state.properties->media.tapes[0].fileName : NULL, 
                                 strlen(state.properties->media.tapes[0].fileNameInZip) ? state.properties->media.tapes[0].fileNameInZip : NULL);
         }
         else {
             emulatorSuspend();
         }
         
-        type = tapeGetFormat();
+        type = tapeGetFormat(emulatorGetBoard());
 
         filename = archFilenameGetSaveCas(state.properties, &type);
 
         if (filename != NULL && strlen(filename) != 0) {
             if (type == 1 || type == 2 || type == 3) {
-                tapeSave(filename, type);
+                tapeSave(emulatorGetBoard(), filename, type);
             }
         }
 
         if (emulatorGetState() == EMU_STOPPED) {
-            boardChangeCassette(0, NULL, NULL);
-            tapeSetReadOnly(state.properties->cassette.readOnly);
+            boardChangeCassette(emulatorGetBoard(), 0, NULL, NULL);
+            tapeSetReadOnly(emulatorGetBoard(), state.properties->cassette.readOnly);
         }
         else {
             emulatorResume();
@@ -1133,17 +1136,17 @@ void actionMenuTools(int x, int y) {
 }
 
 void actionVideoEnableMon1(int value) {
-    videoManagerSetActive(videoManagerGetActive() != 0 ? 0 : -1);
+    videoManagerSetActive(emulatorGetBoard(), videoManagerGetActive(emulatorGetBoard()) != 0 ? 0 : -1);
     archUpdateMenu(0);
 }
 
 void actionVideoEnableMon2(int value) {
-    videoManagerSetActive(videoManagerGetActive() != 1 ? 1 : -1);
+    videoManagerSetActive(emulatorGetBoard(), videoManagerGetActive(emulatorGetBoard()) != 1 ? 1 : -1);
     archUpdateMenu(0);
 }
 
 void actionVideoEnableMon3(int value) {
-    videoManagerSetActive(videoManagerGetActive() != 2 ? 2 : -1);
+    videoManagerSetActive(emulatorGetBoard(), videoManagerGetActive(emulatorGetBoard()) != 2 ? 2 : -1);
     archUpdateMenu(0);
 }
 
@@ -1313,11 +1316,11 @@ void actionRenshaSetLevel(int value) {
 }
 
 void actionSetSpriteEnable(int value) {
-    vdpSetSpritesEnable(value);
+    boardSetSpritesEnable(emulatorGetBoard(), value);
 }
 
 void actionSetNoSpriteLimits(int value) {
-	vdpSetNoSpriteLimits(value);
+	boardSetNoSpriteLimits(emulatorGetBoard(), value);
 }
 
 void actionSetMsxAudioSwitch(int value) {
@@ -1337,7 +1340,7 @@ void actionSetPauseSwitch(int value) {
 
 void actionSetFdcTiming(int value) {
     state.properties->emulation.enableFdcTiming = value ? 1 : 0;
-    boardSetFdcTimingEnable(state.properties->emulation.enableFdcTiming);
+    boardSetFdcTimingEnable(emulatorGetBoard(), state.properties->emulation.enableFdcTiming);
 }
 
 void actionSetWaveCapture(int value) {
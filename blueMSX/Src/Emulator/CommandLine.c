@@ -510,7 +510,7 @@ static int emuStartWithArguments(Properties* properties, char* commandLine, char
         }
     }
 
-    if (properties->cassette.rewindAfterInsert) tapeRewindNextInsert();
+    if (properties->cassette.rewindAfterInsert) tapeRewindNextInsert(emulatorGetBoard());
 
     if (strlen(rom1)  && !insertCartridge(properties, 0, rom1, *rom1zip ? rom1zip : NULL, romType1, -1)) return 0;
     if (strlen(rom2)  && !insertCartridge(properties, 1, rom2, *rom2zip ? rom2zip : NULL, romType2, -1)) return 0;
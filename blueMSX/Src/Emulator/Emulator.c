@@ -34,6 +34,7 @@
 #include "Led.h"
 #include "Machine.h"
 #include "InputEvent.h"
+#include "SaveState.h"
 
 #include "ArchThread.h"
 #include "ArchEvent.h"
@@ -48,7 +49,11 @@
 #include <math.h>
 #include <string.h>
 
+// Not in ArchTimer.h as the callback type differs between the platforms
+void* archCreateTimer();
+
 static int WaitForSync(int maxSpeed, int breakpointHit);
+static int HeadlessSync(int maxSpeed, int breakpointHit);
 
 static void*  emuThread;
 #ifndef WII
@@ -70,6 +75,7 @@ static volatile EmuState emuState = EMU_STOPPED;
 static volatile int      emuSingleStep = 0;
 static Properties* properties;
 static Mixer* mixer;
+static BoardContext* board;
 static BoardDeviceInfo deviceInfo;
 static Machine* machine;
 static int lastScreenMode;
@@ -84,6 +90,15 @@ static UInt32 emuCpuSpeed       = 0;
 static UInt32 emuCpuUsage       = 0;
 static int    enableSynchronousUpdate = 1;
 
+static int         emuHeadless       = 0;
+static UInt32      emuHeadlessFrames = 0;
+static UInt64      emuHeadlessCycles = 0;
+static UInt64      emuHeadlessBudget;
+static UInt64      emuHeadlessTime;
+static UInt32      emuHeadlessLastTime;
+static BoardTimer* emuHeadlessTimer;
+static void      (*emuHeadlessCallback)(void);
+
 #if 0
 
 #define LOG_SIZE (10 * 1000000)
@@ -218,12 +233,21 @@ void emulatorInit(Properties* theProperties, Mixer* theMixer)
 {
     properties = theProperties;
     mixer      = theMixer;
+    board      = boardContextCreate();
 }
 
 void emulatorExit()
 {
+    saveStateStopWriter();
+    boardContextDestroy(board);
     properties = NULL;
     mixer      = NULL;
+    board      = NULL;
+}
+
+BoardContext* emulatorGetBoard()
+{
+    return board;
 }
 
 
@@ -247,7 +271,7 @@ void emulatorSetState(EmuState state) {
     if (state == EMU_STEP_BACK) {
         EmuState oldState = state;
         state = EMU_RUNNING;
-        if (!boardRewindOne()) {
+        if (!boardRewindOne(board)) {
             state = oldState;
         }
         
@@ -291,7 +315,7 @@ static int timerCallback(void* timer) {
         if (frameCount >= framePeriod) {
             frameCount %= framePeriod;
             if (emuState == EMU_RUNNING) {
-                refreshRate = boardGetRefreshRate();
+                refreshRate = boardGetRefreshRate(board);
 
                 if (syncMethod == P_EMU_SYNCAUTO || syncMethod == P_EMU_SYNCNONE) {
                     archUpdateEmuDisplay(0);
@@ -385,24 +409,32 @@ static void emulatorThread() {
     switchSetPause(properties->emulation.pauseSwitch);
     switchSetAudio(properties->emulation.audioSwitch);
 
-    if (properties->emulation.reverseEnable && properties->emulation.reverseMaxTime > 0) {
+    if (properties->emulation.reverseEnable && properties->emulation.reverseMaxTime > 0 && !emuHeadless) {
         reversePeriod = 50;
         reverseBufferCnt = properties->emulation.reverseMaxTime * 1000 / reversePeriod;
     }
-    success = boardRun(machine,
+    success = boardRun(board,
+                       machine,
                        &deviceInfo,
                        mixer,
                        *emuStateName ? emuStateName : NULL,
                        frequency, 
                        reversePeriod,
                        reverseBufferCnt,
-                       WaitForSync);
+                       emuHeadless ? HeadlessSync : WaitForSync);
 
     ledSetAll(0);
     emuState = EMU_STOPPED;
 
+    if (emuHeadlessTimer != NULL) {
+        boardTimerDestroy(emuHeadlessTimer);
+        emuHeadlessTimer = NULL;
+    }
+
 #ifndef WII
-    archTimerDestroy(emuTimer);
+    if (emuTimer != NULL) {
+        archTimerDestroy(emuTimer);
+    }
 #endif
 
     if (!success) {
@@ -442,7 +474,7 @@ void emulatorStart(const char* stateName) {
         return;
     }
 
-    boardSetMachine(machine);
+    boardSetMachine(board, machine);
 
 #ifndef NO_TIMERS
 #ifndef WII
@@ -450,7 +482,11 @@ void emulatorStart(const char* stateName) {
 #endif
     emuStartEvent = archEventCreate(0);
 #ifndef WII
-    emuTimer = archCreateTimer(emulatorGetSyncPeriod(), timerCallback);
+    // The headless runner syncs from the emulation thread itself
+    emuTimer = NULL;
+    if (!emuHeadless) {
+        emuTimer = archCreateTimer(emulatorGetSyncPeriod(), timerCallback);
+    }
 #endif
 #endif
 
@@ -467,6 +503,27 @@ void emulatorStart(const char* stateName) {
 
     clearlog();
 
+    if (emuHeadless) {
+        emuState = EMU_RUNNING;
+        emuHeadlessTime = 0;
+        emulatorThread();
+
+        archSoundSuspend();
+        archMidiEnable(0);
+        machineDestroy(machine);
+#ifndef NO_TIMERS
+#ifndef WII
+        archEventDestroy(emuSyncEvent);
+#endif
+        archEventDestroy(emuStartEvent);
+#endif
+        archEmulationStopNotification();
+        if (emulationStartFailure) {
+            archEmulationStartFailure();
+        }
+        return;
+    }
+
 #ifdef SINGLE_THREADED
     emuState = EMU_RUNNING;
     emulatorThread();
@@ -489,9 +546,9 @@ void emulatorStart(const char* stateName) {
     if (emuState != EMU_STOPPED) {
         getDeviceInfo(&deviceInfo);
 
-        boardSetYm2413Oversampling(properties->sound.chip.ym2413Oversampling);
-        boardSetY8950Oversampling(properties->sound.chip.y8950Oversampling);
-        boardSetMoonsoundOversampling(properties->sound.chip.moonsoundOversampling);
+        boardSetYm2413Oversampling(board, properties->sound.chip.ym2413Oversampling);
+        boardSetY8950Oversampling(board, properties->sound.chip.y8950Oversampling);
+        boardSetMoonsoundOversampling(board, properties->sound.chip.moonsoundOversampling);
 
         strcpy(properties->emulation.machineName, machine->name);
 
@@ -552,7 +609,7 @@ void emulatorSetFrequency(int logFrequency, int* frequency) {
         *frequency  = emuFrequency;
     }
 
-    boardSetFrequency(emuFrequency);
+    boardSetFrequency(board, emuFrequency);
 }
 
 void emulatorSuspend() {
@@ -587,7 +644,7 @@ void emulatorRestart() {
 
     emulatorStop();
     if (machine != NULL) {
-        boardSetMachine(machine);
+        boardSetMachine(board, machine);
         machineDestroy(machine);
     }
 }
@@ -663,6 +720,91 @@ void RefreshScreen(int screenMode) {
     }
 }
 
+//------------------------------------------------------
+// Headless mode runs the emulation on the calling thread
+// as fast as the host allows, without timers, display or
+// audio sync, until a frame or cycle budget is used up.
+// The optional callback is called when the budget is used
+// up, while the machine is still running.
+//------------------------------------------------------
+void emulatorSetHeadless(UInt32 frames, UInt64 cycles, void (*callback)(void))
+{
+    emuHeadless         = frames > 0 || cycles > 0;
+    emuHeadlessFrames   = frames;
+    emuHeadlessCycles   = cycles;
+    emuHeadlessTime     = 0;
+    emuHeadlessCallback = callback;
+}
+
+UInt64 emulatorGetHeadlessCycles()
+{
+    return emuHeadlessTime / (boardFrequency() / 3579545);
+}
+
+static void headlessDone()
+{
+    void (*callback)(void) = emuHeadlessCallback;
+
+    emuHeadlessCallback = NULL;
+    if (callback != NULL) {
+        callback();
+    }
+}
+
+static void onHeadlessBudget(void* ref, UInt32 time)
+{
+    // A hidden run-ahead frame is undone, the snapshot load rearms the timer
+    if (boardIsRunningAhead(board)) {
+        return;
+    }
+
+    emuHeadlessTime    += time - emuHeadlessLastTime;
+    emuHeadlessLastTime = time;
+
+    headlessDone();
+    boardStop(board);
+}
+
+static int HeadlessSync(int maxSpeed, int breakpointHit)
+{
+    UInt32 sysTime = boardSystemTime(board);
+    UInt64 remaining;
+
+    if (emuHeadlessTimer == NULL) {
+        // First sync is done right before the CPU starts
+        if (emuHeadlessFrames > 0) {
+            UInt32 lines = boardGetRefreshRate(board) == 60 ? 262 : 313;
+            emuHeadlessBudget = (UInt64)emuHeadlessFrames * 1368 * lines;
+        }
+        else {
+            emuHeadlessBudget = emuHeadlessCycles * (boardFrequency() / 3579545);
+        }
+        emuHeadlessTimer    = boardTimerCreate(board, onHeadlessBudget, NULL);
+        boardSnapshotKeepTimer(board, emuHeadlessTimer);
+        emuHeadlessLastTime = sysTime;
+    }
+
+    emuHeadlessTime    += sysTime - emuHeadlessLastTime;
+    emuHeadlessLastTime = sysTime;
+
+    if (emuExitFlag) {
+        return -99;
+    }
+    if (emuHeadlessTime >= emuHeadlessBudget) {
+        headlessDone();
+        return -99;
+    }
+
+    // Board timers only reach ~100s ahead, so the stop timer is
+    // armed once the end of the budget is less than a second away.
+    remaining = emuHeadlessBudget - emuHeadlessTime;
+    if (remaining < boardFrequency()) {
+        boardTimerAdd(emuHeadlessTimer, sysTime + (UInt32)remaining);
+    }
+
+    return 100;
+}
+
 #ifndef NO_TIMERS
 
 #ifdef WII
@@ -703,7 +845,7 @@ static int WaitForSync(int maxSpeed, int breakpointHit)
 
 int WaitReverse()
 {
-    boardEnableSnapshots(0);
+    boardEnableSnapshots(board, 0);
 
     for (;;) {
         UInt32 sysTime = archGetSystemUpTime(1000);
@@ -715,7 +857,7 @@ int WaitReverse()
         archEventWait(emuSyncEvent, -1);
     }
 
-    boardRewind();
+    boardRewind(board);
 
     return -60;
 }
@@ -735,7 +877,7 @@ static int WaitForSync(int maxSpeed, int breakpointHit) {
         return WaitReverse();
     }
 
-    boardEnableSnapshots(1);
+    boardEnableSnapshots(board, 1);
 
     emuMaxEmuSpeed = maxSpeed;
 
@@ -37,6 +37,9 @@ typedef enum { EMU_RUNNING, EMU_PAUSED, EMU_STOPPED, EMU_SUSPENDED, EMU_STEP, EM
 void emulatorInit(Properties* properties, Mixer* mixer);
 void emulatorExit();
 
+// The machine the emulator runs, created by emulatorInit()
+BoardContext* emulatorGetBoard();
+
 void emuEnableSynchronousUpdate(int enable);
 
 void emulatorSetFrequency(int logFrequency, int* frequency);
@@ -60,5 +63,8 @@ UInt32 emulatorGetCpuUsage();
 void emulatorResetMixer();
 int emulatorGetCurrentScreenMode();
 
+void   emulatorSetHeadless(UInt32 frames, UInt64 cycles, void (*callback)(void));
+UInt64 emulatorGetHeadlessCycles();
+
 #endif
 
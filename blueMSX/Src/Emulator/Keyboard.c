@@ -416,11 +416,11 @@ int keyboardGetKeyState(int keyCode)
     return (keyboardState[kbdCode >> 8] & (kbdCode & 0xff)) == 0;
 }
     
-void keyboardReset() 
+void keyboardReset(BoardContext* board) 
 {
     KeyboardKeymap keymap;
 
-    switch (boardGetType()) {
+    switch (boardGetType(board)) {
     case BOARD_SVI:
         keymap = KEYMAP_SVI;
         break;
@@ -470,18 +470,18 @@ UInt8* keyboardGetState() {
     return keyboardState;
 }
 
-void keyboardLoadState()
+void keyboardLoadState(BoardContext* board)
 {
-    SaveState* state = saveStateOpenForRead("keyboard");
+    SaveState* state = saveStateOpenForRead(board, "keyboard");
     keymapType = saveStateGet(state, "keymapType",  0);
     saveStateClose(state);
     keyboardSetKeymap(keymapType);
 
 }
 
-void keyboardSaveState()
+void keyboardSaveState(BoardContext* board)
 {
-    SaveState* state = saveStateOpenForWrite("keyboard");
+    SaveState* state = saveStateOpenForWrite(board, "keyboard");
     saveStateSet(state, "keymapType",  keymapType);
     saveStateClose(state);
 }
@@ -176,10 +176,10 @@ typedef enum { KEYMAP_MSX, KEYMAP_SVI, KEYMAP_COLECO, KEYMAP_SG1000 } KeyboardKe
 #define EK_JOY2_BUTTON6 119
 
 
-void keyboardReset();
+void keyboardReset(BoardContext* board);
 
-void keyboardLoadState();
-void keyboardSaveState();
+void keyboardLoadState(BoardContext* board);
+void keyboardSaveState(BoardContext* board);
 
 void keyboardKeyDown(int keyCode);
 void keyboardKeyUp(int keyCode);
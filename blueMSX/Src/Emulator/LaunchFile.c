@@ -165,7 +165,7 @@ int insertCartridge(Properties* properties, int drive, const char* fname, const
         char prettyRomName[256];
 
         if (buf != NULL) {
-            MediaType* mediaType  = mediaDbGuessRom(buf, size);
+            MediaType* mediaType  = mediaDbGuessRom(emulatorGetBoard(), buf, size);
             RomType    chkRomType = mediaDbGetRomType(mediaType);
             strcpy(prettyRomName, mediaDbGetPrettyString(mediaType));
             free(buf);
@@ -264,11 +264,11 @@ int insertCartridge(Properties* properties, int drive, const char* fname, const
     }
     else if (emulatorGetState() != EMU_STOPPED) {
         emulatorSuspend();
-        boardChangeCartridge(drive, romType, filename, isZip ? romName : NULL);
+        boardChangeCartridge(emulatorGetBoard(), drive, romType, filename, isZip ? romName : NULL);
         emulatorResume();
     }
     else {
-        boardChangeCartridge(drive, romType, filename, isZip ? romName : NULL);
+        boardChangeCartridge(emulatorGetBoard(), drive, romType, filename, isZip ? romName : NULL);
     }
 
     return 1;
@@ -384,7 +384,7 @@ int insertDiskette(Properties* properties, int drive, const char* fname, const c
     }
     else if (emulatorGetState() != EMU_STOPPED) {
         emulatorSuspend();
-        boardChangeDiskette(drive, filename, isZip ? diskName : NULL);
+        boardChangeDiskette(emulatorGetBoard(), drive, filename, isZip ? diskName : NULL);
         emulatorResume();
     }
 
@@ -440,7 +440,7 @@ int insertCassette(Properties* properties, int drive, const char* fname, const c
     }
     else if (emulatorGetState() != EMU_STOPPED) {
         emulatorSuspend();
-        boardChangeCassette(0, filename, isZip ? tapeName : NULL);
+        boardChangeCassette(emulatorGetBoard(), 0, filename, isZip ? tapeName : NULL);
         emulatorResume();
     }
 
@@ -689,7 +689,7 @@ int tryLaunchUnknownFile(Properties* properties, const char* fileName, int force
         rv = insertDiskette(properties, drive, fileName, NULL, forceAutostart);
     }
     else if (isFileExtension(fileName, ".cas")) {
-        if (properties->cassette.rewindAfterInsert) tapeRewindNextInsert();
+        if (properties->cassette.rewindAfterInsert) tapeRewindNextInsert(emulatorGetBoard());
         rv = insertCassette(properties, 0, fileName, NULL, forceAutostart);
     }
     else if (isFileExtension(fileName, ".zip")) {
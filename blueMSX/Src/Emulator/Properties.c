@@ -254,6 +254,7 @@ void propInitDefaults(Properties* properties, int langType, PropKeyboardLanguage
     properties->emulation.priorityBoost     = 0;
     properties->emulation.reverseEnable     = 1;
     properties->emulation.reverseMaxTime    = 15;
+    properties->emulation.runAhead          = 0;
 
     properties->video.monitorColor          = P_VIDEO_COLOR;
     properties->video.monitorType           = P_VIDEO_PALMON;
@@ -280,6 +281,7 @@ void propInitDefaults(Properties* properties, int langType, PropKeyboardLanguage
     properties->video.colorSaturationEnable = 0;
     properties->video.scanlinesPct          = 92;
     properties->video.colorSaturationWidth  = 2;
+    properties->video.filterThreads         = 0;
     properties->video.detectActiveMonitor   = 1;
     properties->video.captureFps            = 60;
     properties->video.captureSize           = 1;
@@ -563,6 +565,7 @@ static void propLoad(Properties* properties)
     GET_ENUM_VALUE_2(propFile, emulation, priorityBoost, BoolPair);
     GET_ENUM_VALUE_2(propFile, emulation, reverseEnable, BoolPair);
     GET_INT_VALUE_2(propFile, emulation, reverseMaxTime);
+    GET_INT_VALUE_2(propFile, emulation, runAhead);
     
     GET_ENUM_VALUE_2(propFile, video, monitorColor, MonitorColorPair);
     GET_ENUM_VALUE_2(propFile, video, monitorType, MonitorTypePair);
@@ -588,6 +591,7 @@ static void propLoad(Properties* properties)
     GET_INT_VALUE_2(propFile, video, scanlinesPct);
     GET_ENUM_VALUE_2(propFile, video, colorSaturationEnable, BoolPair);
     GET_INT_VALUE_2(propFile, video, colorSaturationWidth);
+    GET_INT_VALUE_2(propFile, video, filterThreads);
     GET_ENUM_VALUE_2(propFile, video, detectActiveMonitor, BoolPair);
     GET_INT_VALUE_2(propFile, video, captureFps);
     GET_INT_VALUE_2(propFile, video, captureSize);
@@ -820,6 +824,7 @@ void propSave(Properties* properties)
     SET_ENUM_VALUE_2(propFile, emulation, priorityBoost, YesNoPair);
     SET_ENUM_VALUE_2(propFile, emulation, reverseEnable, BoolPair);
     SET_INT_VALUE_2(propFile, emulation, reverseMaxTime);
+    SET_INT_VALUE_2(propFile, emulation, runAhead);
     
     SET_ENUM_VALUE_2(propFile, video, monitorColor, MonitorColorPair);
     SET_ENUM_VALUE_2(propFile, video, monitorType, MonitorTypePair);
@@ -831,6 +836,7 @@ void propSave(Properties* properties)
     SET_INT_VALUE_2(propFile, video, scanlinesPct);
     SET_ENUM_VALUE_2(propFile, video, colorSaturationEnable, YesNoPair);
     SET_INT_VALUE_2(propFile, video, colorSaturationWidth);
+    SET_INT_VALUE_2(propFile, video, filterThreads);
     SET_ENUM_VALUE_2(propFile, video, deInterlace, OnOffPair);
     SET_ENUM_VALUE_2(propFile, video, blendFrames, YesNoPair);
     SET_ENUM_VALUE_2(propFile, video, detectActiveMonitor, YesNoPair);
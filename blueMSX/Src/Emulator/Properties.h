@@ -227,6 +227,7 @@ typedef struct {
     int  vdpSyncMode;
     int  reverseEnable;
     int  reverseMaxTime;
+    int  runAhead;
 } EmulationProperties;
 
 typedef struct {
@@ -271,6 +272,7 @@ typedef struct {
     int scanlinesPct;
     int colorSaturationEnable;
     int colorSaturationWidth;
+    int filterThreads;
     int gamma;
     int detectActiveMonitor;
     int captureFps;
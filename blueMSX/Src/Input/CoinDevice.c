@@ -32,24 +32,25 @@
 #include "Board.h"
 
 struct CoinDevice {
+    BoardContext* board;
     int deviceHandle;
     UInt32 time;
 };
  
 static void destroy(CoinDevice* coinDev) 
 {
-    deviceManagerUnregister(coinDev->deviceHandle);
+    deviceManagerUnregister(coinDev->board, coinDev->deviceHandle);
     free(coinDev);
 }
 
 UInt8 coinDeviceRead(CoinDevice* coinDev) 
 {
     if(coinDev->time == 0 && inputEventGetState(EC_C)) {
-        coinDev->time = boardSystemTime();
+        coinDev->time = boardSystemTime(coinDev->board);
     }
 
     if (coinDev->time != 0) {
-        if ((boardSystemTime() - coinDev->time) < boardFrequency() * 2 / 10) {
+        if ((boardSystemTime(coinDev->board) - coinDev->time) < boardFrequency() * 2 / 10) {
             return 0;
         }
         coinDev->time = 0;
@@ -57,13 +58,15 @@ UInt8 coinDeviceRead(CoinDevice* coinDev)
     return 1;
 }
 
-CoinDevice* coinDeviceCreate()
+CoinDevice* coinDeviceCreate(BoardContext* board)
 {
     DeviceCallbacks callbacks = { destroy, NULL, NULL, NULL };
     CoinDevice* coinDev = (CoinDevice*)calloc(1, sizeof(CoinDevice));
+
+    coinDev->board = board;
     coinDev->time = 0;
 
-    coinDev->deviceHandle = deviceManagerRegister(ROM_UNKNOWN, &callbacks, coinDev);
+    coinDev->deviceHandle = deviceManagerRegister(board, ROM_UNKNOWN, &callbacks, coinDev);
 
     return coinDev;
 }
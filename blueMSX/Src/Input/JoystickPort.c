@@ -29,6 +29,7 @@
 #include "ArchInput.h"
 #include "Language.h"
 #include "Board.h"
+#include "ArchThread.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -39,16 +40,23 @@ typedef struct
     int              keyboardEnabled;
 } JoystickConfig;
 
-static JoystickPortUpdateHandler updateHandler = NULL;
-static void* updateHandlerRef;
+#define MAX_UPDATE_HANDLERS 8
+
+typedef struct {
+    volatile int              used;
+    JoystickPortUpdateHandler fn;
+    void*                     ref;
+} UpdateHandler;
+
+static UpdateHandler updateHandlers[MAX_UPDATE_HANDLERS];
 static JoystickPortType inputType[JOYSTICK_MAX_PORTS];
 
 static JoystickConfig joystickConfig;
 
-void joystickPortUpdateBoardInfo()
+void joystickPortUpdateBoardInfo(BoardContext* board)
 {
     int i;
-    BoardType boardType = boardGetType();
+    BoardType boardType = boardGetType(board);
 
     memset(&joystickConfig, 0, sizeof(joystickConfig));
 
@@ -124,8 +132,12 @@ int joystickPortTypeEnabled(int port, JoystickPortType type)
 void joystickPortSetType(int port, JoystickPortType type) 
 {
     AmEnableMode mode;
-    if (updateHandler != NULL && inputType[port] != type) {
-        updateHandler(updateHandlerRef, port, type);
+    int i;
+
+    for (i = 0; i < MAX_UPDATE_HANDLERS; i++) {
+        if (updateHandlers[i].fn != NULL && inputType[port] != type) {
+            updateHandlers[i].fn(updateHandlers[i].ref, port, type);
+        }
     }
 
     inputType[port] = type;
@@ -161,17 +173,37 @@ JoystickPortType joystickPortGetType(int port)
 void joystickPortUpdateHandlerRegister(JoystickPortUpdateHandler fn, void* ref)
 {
     int port;
-    updateHandler = fn;
-    updateHandlerRef = ref;
+    int i;
+
+    // Machines on different threads may register at the same time
+    for (i = 0; i < MAX_UPDATE_HANDLERS; i++) {
+        if (archAtomicCompareExchange(&updateHandlers[i].used, 0, 1) == 0) {
+            break;
+        }
+    }
+    if (i == MAX_UPDATE_HANDLERS) {
+        return;
+    }
+
+    updateHandlers[i].ref = ref;
+    updateHandlers[i].fn  = fn;
 
     for (port = 0; port < JOYSTICK_MAX_PORTS; port++) {
-        updateHandler(updateHandlerRef, port, inputType[port]);
+        fn(ref, port, inputType[port]);
     }
 }
 
-void joystickPortUpdateHandlerUnregister()
+void joystickPortUpdateHandlerUnregister(void* ref)
 {
-    updateHandler = NULL;
+    int i;
+
+    for (i = 0; i < MAX_UPDATE_HANDLERS; i++) {
+        if (updateHandlers[i].fn != NULL && updateHandlers[i].ref == ref) {
+            updateHandlers[i].fn = NULL;
+            archAtomicSet(&updateHandlers[i].used, 0);
+            return;
+        }
+    }
 }
 
 int joystickPortGetTypeCount()
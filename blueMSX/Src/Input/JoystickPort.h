@@ -50,7 +50,7 @@ typedef enum {
 typedef void (*JoystickPortUpdateHandler)(void*, int, JoystickPortType);
 
 // Machine dependent config methods that probably belongs somewhere else...
-void joystickPortUpdateBoardInfo();
+void joystickPortUpdateBoardInfo(BoardContext* board);
 int  joystickPortKeyboardEnabled();
 
 int joystickPortGetTypeCount();
@@ -63,7 +63,8 @@ char* joystickPortGetDescription(JoystickPortType type, int translate);
 JoystickPortType joystickPortNameToType(int port, char* name, int translate);
 char* joystickPortTypeToName(int port, int translate);
 
+// Each running machine registers a handler, so all of them follow the port types
 void joystickPortUpdateHandlerRegister(JoystickPortUpdateHandler fn, void* ref);
-void joystickPortUpdateHandlerUnregister();
+void joystickPortUpdateHandlerUnregister(void* ref);
 
 #endif // JOYSTICK_PORT_H
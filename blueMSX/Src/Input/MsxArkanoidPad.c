@@ -34,6 +34,7 @@
 #include <stdlib.h>
 
 struct MsxArkanoidPad {
+    BoardContext* board;
     MsxJoystickDevice joyDevice;
     int pos;
     UInt8 oldValue;
@@ -42,7 +43,7 @@ struct MsxArkanoidPad {
 
 static void saveState(MsxArkanoidPad* arkPad)
 {
-    SaveState* state = saveStateOpenForWrite("msxArkanoidPad");
+    SaveState* state = saveStateOpenForWrite(arkPad->board, "msxArkanoidPad");
 
     saveStateSet(state, "pos",      arkPad->pos);
     saveStateSet(state, "oldValue", arkPad->oldValue);
@@ -53,7 +54,7 @@ static void saveState(MsxArkanoidPad* arkPad)
 
 static void loadState(MsxArkanoidPad* arkPad)
 {
-    SaveState* state = saveStateOpenForRead("msxArkanoidPad");
+    SaveState* state = saveStateOpenForRead(arkPad->board, "msxArkanoidPad");
 
     arkPad->pos      =        saveStateGet(state, "pos",      236);
     arkPad->oldValue = (UInt8)saveStateGet(state, "oldValue", 0);
@@ -100,9 +101,11 @@ static void reset(MsxArkanoidPad* arkPad) {
     arkPad->oldValue = 0;
 }
 
-MsxJoystickDevice* msxArkanoidPadCreate()
+MsxJoystickDevice* msxArkanoidPadCreate(BoardContext* board)
 {
     MsxArkanoidPad* arkPad = (MsxArkanoidPad*)calloc(1, sizeof(MsxArkanoidPad));
+
+    arkPad->board = board;
     arkPad->joyDevice.read       = read;
     arkPad->joyDevice.write      = write;
     arkPad->joyDevice.reset      = reset;
@@ -58,6 +58,7 @@
 
 struct MsxAsciiLaser {
     MsxJoystickDevice joyDevice;
+    BoardContext* board;
     int scanlines;
     UInt32 lastTrigger;
 };
@@ -73,15 +74,15 @@ static UInt8 read(MsxAsciiLaser* joystick) {
     UInt8 state = (~archMouseGetButtonState(0) & 1) << 5;
     int mx, my;
 
-    vdpForceSync();
+    vdpForceSync(joystick->board);
 
     archMouseGetState(&mx, &my);
 
     my = my * joystick->scanlines / 0x10000;
     
-    frameBuffer = frameBufferGetDrawFrame();
+    frameBuffer = frameBufferGetDrawFrame(joystick->board);
     if (frameBuffer != NULL) {
-        int scanline = frameBufferGetScanline();
+        int scanline = frameBufferGetScanline(joystick->board);
         int myLow  = MAX(scanline - DELAY - HOLD - RADIUS, my + AIMADJUST - RADIUS);
         int myHigh = MIN(scanline - DELAY, my + AIMADJUST + RADIUS + HOLD);
         int y;
@@ -109,9 +110,10 @@ static UInt8 read(MsxAsciiLaser* joystick) {
     return state;
 }
 
-MsxJoystickDevice* msxAsciiLaserCreate()
+MsxJoystickDevice* msxAsciiLaserCreate(BoardContext* board)
 {
     MsxAsciiLaser* joystick = (MsxAsciiLaser*)calloc(1, sizeof(MsxAsciiLaser));
+    joystick->board = board;
     joystick->joyDevice.read   = read;
     
     return (MsxJoystickDevice*)joystick;
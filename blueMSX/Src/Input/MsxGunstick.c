@@ -38,6 +38,7 @@
 
 struct MsxGunstick {
     MsxJoystickDevice joyDevice;
+    BoardContext* board;
     int scanlines;
 };
 
@@ -50,16 +51,16 @@ static UInt8 read(MsxGunstick* joystick) {
     UInt8 state = (archMouseGetButtonState(0) & 1) << 4;
     int mx, my;
 
-    vdpForceSync();
+    vdpForceSync(joystick->board);
 
     archMouseGetState(&mx, &my);
 
     my = my * joystick->scanlines / 0x10000;
     
-    frameBuffer = frameBufferGetDrawFrame();
+    frameBuffer = frameBufferGetDrawFrame(joystick->board);
 
     if (frameBuffer != NULL) {
-        int scanline = frameBufferGetScanline();
+        int scanline = frameBufferGetScanline(joystick->board);
         int myLow  = MAX(scanline - DELAY, my - SENSITIVIY);
         int myHigh = MIN(scanline, my);
         int y;
@@ -87,9 +88,10 @@ static UInt8 read(MsxGunstick* joystick) {
     return ~state & 0x3f;
 }
 
-MsxJoystickDevice* msxGunstickCreate()
+MsxJoystickDevice* msxGunstickCreate(BoardContext* board)
 {
     MsxGunstick* joystick = (MsxGunstick*)calloc(1, sizeof(MsxGunstick));
+    joystick->board = board;
     joystick->joyDevice.read   = read;
     
     return (MsxJoystickDevice*)joystick;
@@ -34,6 +34,7 @@
 #include <stdlib.h>
 
 struct MsxMouse {
+    BoardContext* board;
     MsxJoystickDevice joyDevice;
     int dx;
     int dy;
@@ -45,7 +46,7 @@ struct MsxMouse {
 
 static void saveState(MsxMouse* mouse)
 {
-    SaveState* state = saveStateOpenForWrite("msxMouse");
+    SaveState* state = saveStateOpenForWrite(mouse->board, "msxMouse");
     
     saveStateSet(state, "dx",               mouse->dx);
     saveStateSet(state, "dy",               mouse->dy);
@@ -59,7 +60,7 @@ static void saveState(MsxMouse* mouse)
 
 static void loadState(MsxMouse* mouse) 
 {
-    SaveState* state = saveStateOpenForRead("msxMouse");
+    SaveState* state = saveStateOpenForRead(mouse->board, "msxMouse");
 
     mouse->dx              =        saveStateGet(state, "dx",              0);
     mouse->dy              =        saveStateGet(state, "dy",              0);
@@ -74,7 +75,7 @@ static void loadState(MsxMouse* mouse)
 static UInt8 read(MsxMouse* mouse) 
 {
     UInt8 state = 0x3f;
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(mouse->board);
 
     if (mouse->mouseAsJoystick) {
         if (systemTime - mouse->clock > boardFrequency() / 120) {
@@ -117,7 +118,7 @@ static UInt8 read(MsxMouse* mouse)
 
 static void write(MsxMouse* mouse, UInt8 value) 
 {
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(mouse->board);
 
     if (mouse->mouseAsJoystick) {
         return;
@@ -153,9 +154,11 @@ static void reset(MsxMouse* mouse) {
     mouse->oldValue = 0;
 }
 
-MsxJoystickDevice* msxMouseCreate()
+MsxJoystickDevice* msxMouseCreate(BoardContext* board)
 {
     MsxMouse* mouse = (MsxMouse*)calloc(1, sizeof(MsxMouse));
+
+    mouse->board = board;
     mouse->joyDevice.read       = read;
     mouse->joyDevice.write      = write;
     mouse->joyDevice.reset      = reset;
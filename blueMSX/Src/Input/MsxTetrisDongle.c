@@ -30,6 +30,7 @@
 #include "SaveState.h"
 
 struct MsxTetrisDongle {
+    BoardContext* board;
     MsxJoystickDevice joyDevice;
     UInt8 state;
 };
@@ -49,7 +50,7 @@ static void write(MsxTetrisDongle* tetrisDongle, UInt8 value) {
 
 static void saveState(MsxTetrisDongle* tetrisDongle)
 {
-    SaveState* state = saveStateOpenForWrite("tetrisDongle");
+    SaveState* state = saveStateOpenForWrite(tetrisDongle->board, "tetrisDongle");
     
     saveStateSet(state, "state", tetrisDongle->state);
 
@@ -58,7 +59,7 @@ static void saveState(MsxTetrisDongle* tetrisDongle)
 
 static void loadState(MsxTetrisDongle* tetrisDongle) 
 {
-    SaveState* state = saveStateOpenForRead("tetrisDongle");
+    SaveState* state = saveStateOpenForRead(tetrisDongle->board, "tetrisDongle");
 
     tetrisDongle->state = (UInt8)saveStateGet(state, "state", 0x3f);
 
@@ -69,9 +70,11 @@ static void reset(MsxTetrisDongle* tetrisDongle) {
     tetrisDongle->state = 0x3f;
 }
 
-MsxJoystickDevice* msxTetrisDongleCreate()
+MsxJoystickDevice* msxTetrisDongleCreate(BoardContext* board)
 {
     MsxTetrisDongle* tetrisDongle = (MsxTetrisDongle*)calloc(1, sizeof(MsxTetrisDongle));
+
+    tetrisDongle->board = board;
     tetrisDongle->joyDevice.read      = read;
     tetrisDongle->joyDevice.write     = write;
     tetrisDongle->joyDevice.reset     = reset;
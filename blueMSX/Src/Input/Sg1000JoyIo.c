@@ -39,6 +39,7 @@
 #include <stdlib.h>
 
 struct Sg1000JoyIo {
+    BoardContext* board;
     Sg1000JoystickDevice* joyDevice[2];
     int joyDeviceHandle;
     int deviceHandle;
@@ -104,9 +105,9 @@ static void destroy(Sg1000JoyIo* joyIo)
         }
     }
 
-    joystickPortUpdateHandlerUnregister();
+    joystickPortUpdateHandlerUnregister(joyIo);
 
-    deviceManagerUnregister(joyIo->deviceHandle);
+    deviceManagerUnregister(joyIo->board, joyIo->deviceHandle);
 }
 
 UInt16 sg1000JoyIoRead(Sg1000JoyIo* joyIo) 
@@ -121,14 +122,16 @@ UInt16 sg1000JoyIoRead(Sg1000JoyIo* joyIo)
     return state;
 }
 
-Sg1000JoyIo* sg1000JoyIoCreate() 
+Sg1000JoyIo* sg1000JoyIoCreate(BoardContext* board) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     Sg1000JoyIo* sg1000JoyIo = (Sg1000JoyIo*)calloc(1, sizeof(Sg1000JoyIo));
 
+    sg1000JoyIo->board = board;
+
     joystickPortUpdateHandlerRegister(joyIoHandler, sg1000JoyIo);
 
-    sg1000JoyIo->deviceHandle = deviceManagerRegister(ROM_UNKNOWN, &callbacks, sg1000JoyIo);
+    sg1000JoyIo->deviceHandle = deviceManagerRegister(board, ROM_UNKNOWN, &callbacks, sg1000JoyIo);
 
     return sg1000JoyIo;
 }
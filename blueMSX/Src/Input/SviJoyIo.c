@@ -37,6 +37,7 @@
 #include <stdlib.h>
 
 struct SviJoyIo {
+    BoardContext* board;
     SviJoystickDevice* joyDevice[2];
     int joyDeviceHandle;
     UInt8 lastReadValue;
@@ -103,9 +104,9 @@ static void destroy(SviJoyIo* joyIo)
         }
     }
 
-    joystickPortUpdateHandlerUnregister();
+    joystickPortUpdateHandlerUnregister(joyIo);
 
-    deviceManagerUnregister(joyIo->deviceHandle);
+    deviceManagerUnregister(joyIo->board, joyIo->deviceHandle);
 }
 
 UInt8 sviJoyIoRead(SviJoyIo* joyIo) {
@@ -131,14 +132,16 @@ UInt8 sviJoyIoReadTrigger(SviJoyIo* joyIo) {
     return value;
 }
 
-SviJoyIo* sviJoyIoCreate() 
+SviJoyIo* sviJoyIoCreate(BoardContext* board) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     SviJoyIo* sviJoyIo = (SviJoyIo*)calloc(1, sizeof(SviJoyIo));
 
+    sviJoyIo->board = board;
+
     joystickPortUpdateHandlerRegister(joyIoHandler, sviJoyIo);
 
-    sviJoyIo->deviceHandle = deviceManagerRegister(ROM_UNKNOWN, &callbacks, sviJoyIo);
+    sviJoyIo->deviceHandle = deviceManagerRegister(board, ROM_UNKNOWN, &callbacks, sviJoyIo);
 
     return sviJoyIo;
 }
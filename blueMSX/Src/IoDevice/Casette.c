@@ -26,6 +26,7 @@
 ******************************************************************************
 */
 #include "Casette.h"
+#include "Board.h"
 #include "Led.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -46,16 +47,31 @@ static UInt8 hdrASCII[10]  = { 0xea,0xea,0xea,0xea,0xea,0xea,0xea,0xea,0xea,0xea
 static UInt8 hdrBINARY[10] = { 0xd0,0xd0,0xd0,0xd0,0xd0,0xd0,0xd0,0xd0,0xd0,0xd0 };
 static UInt8 hdrBASIC[10]  = { 0xd3,0xd3,0xd3,0xd3,0xd3,0xd3,0xd3,0xd3,0xd3,0xd3 };
 static char   tapeBaseDir[512];
-static char   tapePosName[512];
-static char   tapeName[512];
-static int    tapeRdWr;
-static TapeFormat tapeFormat;
-static UInt8* tapeHeader;
-static int    tapeHeaderSize;
-static char*  ramImageBuffer = NULL;
-static int    ramImageSize = 0;
-static int    ramImagePos = 0;
-static int    rewindNextInsert = 0;
+
+struct TapeContext {
+    char   tapePosName[512];
+    char   tapeName[512];
+    int    tapeRdWr;
+    TapeFormat tapeFormat;
+    UInt8* tapeHeader;
+    int    tapeHeaderSize;
+    char*  ramImageBuffer;
+    int    ramImageSize;
+    int    ramImagePos;
+    int    rewindNextInsert;
+    TapeContent tapeContent[1024];
+};
+
+TapeContext* tapeContextCreate()
+{
+    return calloc(1, sizeof(TapeContext));
+}
+
+void tapeContextDestroy(TapeContext* ctx)
+{
+    free(ctx->ramImageBuffer);
+    free(ctx);
+}
 
 static char* stripPath(char* filename) {
     char* ptr = filename + strlen(filename) - 1;
@@ -69,44 +85,48 @@ static char* stripPath(char* filename) {
     return filename;
 }
 
-static int ramread(void* buf, int size, int* ramPos) {
-    if (*ramPos > ramImageSize) {
+static int ramread(TapeContext* ctx, void* buf, int size, int* ramPos) {
+    if (*ramPos > ctx->ramImageSize) {
         return 0;
     }
-    if (*ramPos + size > ramImageSize) {
-        size = ramImageSize - *ramPos;
+    if (*ramPos + size > ctx->ramImageSize) {
+        size = ctx->ramImageSize - *ramPos;
     }
 
-    memcpy(buf, ramImageBuffer + *ramPos, size);
+    memcpy(buf, ctx->ramImageBuffer + *ramPos, size);
     *ramPos += size;
 
     return size;
 }
 
-void tapeLoadState() {
-    SaveState* state = saveStateOpenForRead("tape");
+void tapeLoadState(BoardContext* board) {
+    TapeContext* ctx = boardGetTape(board);
+    SaveState* state = saveStateOpenForRead(board, "tape");
 
-    ramImagePos = saveStateGet(state, "ramImagePos",  0);
+    ctx->ramImagePos = saveStateGet(state, "ramImagePos",  0);
 
-    if (ramImagePos >= ramImageSize) {
-        ramImagePos = 0;
+    if (ctx->ramImagePos >= ctx->ramImageSize) {
+        ctx->ramImagePos = 0;
     }
     saveStateClose(state);
 }
 
-void tapeSaveState() {
-    SaveState* state = saveStateOpenForWrite("tape");
+void tapeSaveState(BoardContext* board) {
+    TapeContext* ctx = boardGetTape(board);
+    SaveState* state = saveStateOpenForWrite(board, "tape");
 
-    saveStateSet(state, "ramImagePos",  ramImagePos);
+    saveStateSet(state, "ramImagePos",  ctx->ramImagePos);
 
     saveStateClose(state);
 }
 
-UInt8 tapeRead(UInt8* value) 
+UInt8 tapeRead(BoardContext* board, UInt8* value) 
 {
-    if (ramImageBuffer != NULL) {
-        if (ramImagePos < ramImageSize) {
-            *value = ramImageBuffer[ramImagePos++];
+    TapeContext* ctx = boardGetTape(board);
+
+    if (ctx->ramImageBuffer != NULL) {
+        if (ctx->ramImagePos < ctx->ramImageSize) {
+            *value = ctx->ramImageBuffer[ctx->ramImagePos++];
             ledSetCas(1);
             return 1;
         }
@@ -116,20 +136,22 @@ UInt8 tapeRead(UInt8* value)
     return 0;
 }
 
-UInt8 tapeWrite(UInt8 value) 
+UInt8 tapeWrite(BoardContext* board, UInt8 value) 
 {
-    if (ramImageBuffer != NULL) {
-        if (ramImagePos >= ramImageSize) {
-            char* newBuf = realloc(ramImageBuffer, ramImageSize + 128);
+    TapeContext* ctx = boardGetTape(board);
+
+    if (ctx->ramImageBuffer != NULL) {
+        if (ctx->ramImagePos >= ctx->ramImageSize) {
+            char* newBuf = realloc(ctx->ramImageBuffer, ctx->ramImageSize + 128);
             if (newBuf) {
-                ramImageBuffer = newBuf;
-                memset(ramImageBuffer + ramImageSize, 0, 128);
-                ramImageSize += 128;
+                ctx->ramImageBuffer = newBuf;
+                memset(ctx->ramImageBuffer + ctx->ramImageSize, 0, 128);
+                ctx->ramImageSize += 128;
             }
         }
 
-        if (ramImagePos < ramImageSize) {
-            ramImageBuffer[ramImagePos++] = value;
+        if (ctx->ramImagePos < ctx->ramImageSize) {
+            ctx->ramImageBuffer[ctx->ramImagePos++] = value;
             ledSetCas(1);
             return 1;
         }
@@ -139,20 +161,22 @@ UInt8 tapeWrite(UInt8 value)
     return 0;
 }
 
-UInt8 tapeReadHeader() 
+UInt8 tapeReadHeader(BoardContext* board) 
 {    
-    if (ramImageBuffer != NULL) {
+    TapeContext* ctx = boardGetTape(board);
+
+    if (ctx->ramImageBuffer != NULL) {
         UInt8 buf[32];
         int i;
-        for (i = 0; i < tapeHeaderSize; i++) {
-            if (!tapeRead(buf + i)) {
+        for (i = 0; i < ctx->tapeHeaderSize; i++) {
+            if (!tapeRead(board, buf + i)) {
                 return 0;
             }
         }
         
-        while (memcmp(buf, tapeHeader, tapeHeaderSize)) {
-            memmove(buf, buf + 1, tapeHeaderSize - 1);
-            if (!tapeRead(buf + tapeHeaderSize - 1)) {
+        while (memcmp(buf, ctx->tapeHeader, ctx->tapeHeaderSize)) {
+            memmove(buf, buf + 1, ctx->tapeHeaderSize - 1);
+            if (!tapeRead(board, buf + ctx->tapeHeaderSize - 1)) {
                 return 0;
             }
         }
@@ -162,13 +186,15 @@ UInt8 tapeReadHeader()
     return 0;
 }
 
-UInt8 tapeWriteHeader() 
+UInt8 tapeWriteHeader(BoardContext* board) 
 {
-    if (ramImageBuffer != NULL) {
+    TapeContext* ctx = boardGetTape(board);
+
+    if (ctx->ramImageBuffer != NULL) {
         int i;
         
-        for (i = 0; i < tapeHeaderSize; i++) {
-            if (!tapeWrite(tapeHeader[i])) {
+        for (i = 0; i < ctx->tapeHeaderSize; i++) {
+            if (!tapeWrite(board, ctx->tapeHeader[i])) {
                 return 0;
             }
         }
@@ -182,64 +208,67 @@ void tapeSetDirectory(char* baseDir, char* prefix) {
     strcpy(tapeBaseDir, baseDir);
 }
 
-void tapeSetReadOnly(int readOnly)
+void tapeSetReadOnly(BoardContext* board, int readOnly)
 {
-    tapeRdWr = !readOnly;
+    TapeContext* ctx = boardGetTape(board);
+
+    ctx->tapeRdWr = !readOnly;
 }
 
-int tapeInsert(char *name, const char *fileInZipFile) 
+int tapeInsert(BoardContext* board, char *name, const char *fileInZipFile) 
 {
+    TapeContext* ctx = boardGetTape(board);
     FILE* file;
     Properties* pProperties = propGetGlobalProperties();
     
-    if (ramImageBuffer != NULL) {
-        file = fopen(tapePosName, "w");
+    if (ctx->ramImageBuffer != NULL) {
+        file = fopen(ctx->tapePosName, "w");
         if (file != NULL) {
             char buffer[32];
-            sprintf(buffer, "POS:%d", ramImagePos);
+            sprintf(buffer, "POS:%d", ctx->ramImagePos);
             fwrite(buffer, 1, 32, file);
             fclose(file);
         }
 
-        if (*tapeName && tapeRdWr) {
-            tapeSave(tapeName, tapeFormat);
+        if (*ctx->tapeName && ctx->tapeRdWr) {
+            tapeSave(board, ctx->tapeName, ctx->tapeFormat);
         }
 
-        free(ramImageBuffer);
-        ramImageBuffer = NULL;
+        free(ctx->ramImageBuffer);
+        ctx->ramImageBuffer = NULL;
     }
 
-    *tapeName = 0;
+    *ctx->tapeName = 0;
 
     if(!name) {
         return 1;
     }
 
     // Create filename for tape position file
-    sprintf(tapePosName, "%s" DIR_SEPARATOR "%s", tapeBaseDir, stripPath(name));
+    sprintf(ctx->tapePosName, "%s" DIR_SEPARATOR "%s", tapeBaseDir, stripPath(name));
     if (fileInZipFile == NULL) {
-        strcpy(tapeName, name);
+        strcpy(ctx->tapeName, name);
     }
     else {
-        strcat(tapePosName, stripPath((char*)fileInZipFile));
+        strcat(ctx->tapePosName, stripPath((char*)fileInZipFile));
     }
-    strcat(tapePosName, ".pos");
+    strcat(ctx->tapePosName, ".pos");
 
-    ramImagePos = 0;
+    ctx->ramImagePos = 0;
 
     // Load and verify tape position
-    file = fopen(tapePosName, "rb");
+    file = fopen(ctx->tapePosName, "rb");
     if (file != NULL) {
         char buffer[32] = { 0 };
         fread(buffer, 1, 31, file);
-        sscanf(buffer, "POS:%d", &ramImagePos);
+        sscanf(buffer, "POS:%d", &ctx->ramImagePos);
         fclose(file);
     }
 
     if (fileInZipFile != NULL) {
-        ramImageBuffer = zipLoadFile(name, fileInZipFile, &ramImageSize);
-        if (ramImagePos > ramImageSize) {
-            ramImagePos = ramImageSize;
+        ctx->ramImageBuffer = zipLoadFile(name, fileInZipFile, &ctx->ramImageSize);
+        if (ctx->ramImagePos > ctx->ramImageSize) {
+            ctx->ramImagePos = ctx->ramImageSize;
         }
     }
     else {
@@ -247,29 +276,29 @@ int tapeInsert(char *name, const char *fileInZipFile)
         if (file != NULL) {
             // Load file into RAM buffer
             fseek(file, 0, SEEK_END);
-            ramImageSize = ftell(file);
+            ctx->ramImageSize = ftell(file);
             fseek(file, 0, SEEK_SET);
-            ramImageBuffer = malloc(ramImageSize);
-            if (ramImageBuffer != NULL) {
-                if (ramImageSize != fread(ramImageBuffer, 1, ramImageSize, file)) {
-                    free(ramImageBuffer);
-                    ramImageBuffer = NULL;
+            ctx->ramImageBuffer = malloc(ctx->ramImageSize);
+            if (ctx->ramImageBuffer != NULL) {
+                if (ctx->ramImageSize != fread(ctx->ramImageBuffer, 1, ctx->ramImageSize, file)) {
+                    free(ctx->ramImageBuffer);
+                    ctx->ramImageBuffer = NULL;
                 }
             }
             fclose(file);
         }
     }
     
-    if (rewindNextInsert&&pProperties->cassette.rewindAfterInsert) ramImagePos=0;
-    rewindNextInsert=0;
+    if (ctx->rewindNextInsert&&pProperties->cassette.rewindAfterInsert) ctx->ramImagePos=0;
+    ctx->rewindNextInsert=0;
 
-    if (ramImageBuffer != NULL) {
-        UInt8* ptr = ramImageBuffer + ramImageSize - 17;
+    if (ctx->ramImageBuffer != NULL) {
+        UInt8* ptr = ctx->ramImageBuffer + ctx->ramImageSize - 17;
         int cntFMSXDOS = 0;
         int cntFMSX98  = 0;
         int cntSVICAS  = 0;
 
-        while (ptr >= ramImageBuffer) {
+        while (ptr >= ctx->ramImageBuffer) {
             if (!memcmp(ptr, hdrFMSXDOS, sizeof(hdrFMSXDOS))) {
                 cntFMSXDOS++;
             }
@@ -283,43 +312,46 @@ int tapeInsert(char *name, const char *fileInZipFile)
         }
 
         if (cntSVICAS > cntFMSXDOS && cntSVICAS > cntFMSX98) {
-            tapeFormat     = TAPE_SVICAS;
-            tapeHeader     = hdrSVICAS;
-            tapeHeaderSize = sizeof(hdrSVICAS);
+            ctx->tapeFormat     = TAPE_SVICAS;
+            ctx->tapeHeader     = hdrSVICAS;
+            ctx->tapeHeaderSize = sizeof(hdrSVICAS);
         }
         else if (cntFMSXDOS >= cntFMSX98) {
-            tapeFormat     = TAPE_FMSXDOS;
-            tapeHeader     = hdrFMSXDOS;
-            tapeHeaderSize = sizeof(hdrFMSXDOS);
+            ctx->tapeFormat     = TAPE_FMSXDOS;
+            ctx->tapeHeader     = hdrFMSXDOS;
+            ctx->tapeHeaderSize = sizeof(hdrFMSXDOS);
         }
         else {
-            tapeFormat     = TAPE_FMSX98AT;
-            tapeHeader     = hdrFMSX98;
-            tapeHeaderSize = sizeof(hdrFMSX98);
+            ctx->tapeFormat     = TAPE_FMSX98AT;
+            ctx->tapeHeader     = hdrFMSX98;
+            ctx->tapeHeaderSize = sizeof(hdrFMSX98);
         }
     }
 
-    if (ramImagePos > ramImageSize) {
-        ramImagePos = ramImageSize;
+    if (ctx->ramImagePos > ctx->ramImageSize) {
+        ctx->ramImagePos = ctx->ramImageSize;
     }
 
-    return ramImageBuffer != NULL;
+    return ctx->ramImageBuffer != NULL;
 }
 
-int tapeIsInserted()
+int tapeIsInserted(BoardContext* board)
 {
-    return ramImageBuffer != NULL;
+    TapeContext* ctx = boardGetTape(board);
+
+    return ctx->ramImageBuffer != NULL;
 }
 
-int tapeSave(char *name, TapeFormat format)
+int tapeSave(BoardContext* board, char *name, TapeFormat format)
 {
+    TapeContext* ctx = boardGetTape(board);
     FILE* file;
     int offset   = 0;
     int writePos = 0;
     UInt8* hdrData;
     int    hdrSize;
 
-    if (ramImageBuffer == NULL) {
+    if (ctx->ramImageBuffer == NULL) {
         return 0;
     }
 
@@ -332,8 +364,8 @@ int tapeSave(char *name, TapeFormat format)
         return 0;
     }
 
-    while (offset < ramImageSize) {
-        if (ramImageSize - offset >= tapeHeaderSize && !memcmp(ramImageBuffer + offset, tapeHeader, tapeHeaderSize)) {
+    while (offset < ctx->ramImageSize) {
+        if (ctx->ramImageSize - offset >= ctx->tapeHeaderSize && !memcmp(ctx->ramImageBuffer + offset, ctx->tapeHeader, ctx->tapeHeaderSize)) {
             switch (format) {
                 case TAPE_FMSXDOS:
                     hdrData = hdrFMSXDOS;
@@ -359,10 +391,10 @@ int tapeSave(char *name, TapeFormat format)
 
             fwrite(hdrData, 1, hdrSize, file);
             writePos += hdrSize;
-            offset += tapeHeaderSize;
+            offset += ctx->tapeHeaderSize;
         }
         else {
-            fwrite(ramImageBuffer + offset, 1, 1, file);
+            fwrite(ctx->ramImageBuffer + offset, 1, 1, file);
             writePos++;
             offset++;
         }
@@ -373,66 +405,70 @@ int tapeSave(char *name, TapeFormat format)
     return 1;
 }
 
-TapeFormat tapeGetFormat()
+TapeFormat tapeGetFormat(BoardContext* board)
 {
-    return tapeFormat;
+    TapeContext* ctx = boardGetTape(board);
+
+    return ctx->tapeFormat;
 }
 
-UInt32 tapeGetLength()
+UInt32 tapeGetLength(BoardContext* board)
 {
-    return ramImageSize;
+    TapeContext* ctx = boardGetTape(board);
+
+    return ctx->ramImageSize;
 }
 
-TapeContent* tapeGetContent(int* count)
+TapeContent* tapeGetContent(BoardContext* board, int* count)
 {
-    static TapeContent tapeContent[1024];
+    TapeContext* ctx = boardGetTape(board);
     int  index = 0;
     char buffer[32];
     int  ramPos = 0;
     int  position = 0;
     int  skipNext = 0;
 
-    memset(tapeContent, 0, sizeof(tapeContent));
+    memset(ctx->tapeContent, 0, sizeof(ctx->tapeContent));
 
     *count = 0;
 
-    if (ramImageBuffer == NULL) {
-        return tapeContent;
+    if (ctx->ramImageBuffer == NULL) {
+        return ctx->tapeContent;
     }
 
-    while (ramread(buffer, tapeHeaderSize, &ramPos) == tapeHeaderSize) {
-        if (!memcmp(buffer, tapeHeader, tapeHeaderSize)) {
+    while (ramread(ctx, buffer, ctx->tapeHeaderSize, &ramPos) == ctx->tapeHeaderSize) {
+        if (!memcmp(buffer, ctx->tapeHeader, ctx->tapeHeaderSize)) {
             if (skipNext) {
                 skipNext = 0;
             }
-            else if (ramread(buffer, 10, &ramPos) == 10) {
+            else if (ramread(ctx, buffer, 10, &ramPos) == 10) {
                 if (!memcmp(buffer, hdrASCII, 10)) {
-                    ramread(tapeContent[index].fileName, 6, &ramPos);
-                    tapeContent[index].type = TAPE_ASCII;
-                    tapeContent[index++].pos = ramPos - 16 - tapeHeaderSize;
+                    ramread(ctx, ctx->tapeContent[index].fileName, 6, &ramPos);
+                    ctx->tapeContent[index].type = TAPE_ASCII;
+                    ctx->tapeContent[index++].pos = ramPos - 16 - ctx->tapeHeaderSize;
 
-                    while (ramPos < ramImageSize && ramImageBuffer[ramPos] != 0x1a) {
+                    while (ramPos < ctx->ramImageSize && ctx->ramImageBuffer[ramPos] != 0x1a) {
                         ramPos++;
                     }
 
                     position = ramPos - 1;
                 } 
                 else if (!memcmp(buffer, hdrBINARY, 10)) {
-                    ramread(tapeContent[index].fileName, 6, &ramPos); 
-                    tapeContent[index].type = TAPE_BINARY;
-                    tapeContent[index++].pos = ramPos - 16 - tapeHeaderSize;
+                    ramread(ctx, ctx->tapeContent[index].fileName, 6, &ramPos); 
+                    ctx->tapeContent[index].type = TAPE_BINARY;
+                    ctx->tapeContent[index++].pos = ramPos - 16 - ctx->tapeHeaderSize;
                     skipNext = 1;
                 }
                 else if (!memcmp(buffer, hdrBASIC, 10)) {
-                    ramread(tapeContent[index].fileName, 6, &ramPos); 
-                    tapeContent[index].type = TAPE_BASIC;
-                    tapeContent[index++].pos = ramPos - 16 - tapeHeaderSize;
+                    ramread(ctx, ctx->tapeContent[index].fileName, 6, &ramPos); 
+                    ctx->tapeContent[index].type = TAPE_BASIC;
+                    ctx->tapeContent[index++].pos = ramPos - 16 - ctx->tapeHeaderSize;
                     skipNext = 1;
                 }
                 else {
-                    strcpy(tapeContent[index].fileName, "");
-                    tapeContent[index].type = TAPE_CUSTOM;
-                    tapeContent[index++].pos = ramPos - 10 - tapeHeaderSize;
+                    strcpy(ctx->tapeContent[index].fileName, "");
+                    ctx->tapeContent[index].type = TAPE_CUSTOM;
+                    ctx->tapeContent[index++].pos = ramPos - 10 - ctx->tapeHeaderSize;
                 }
             }
         }
@@ -441,22 +477,28 @@ TapeContent* tapeGetContent(int* count)
 
     *count = index;
 
-    return tapeContent;
+    return ctx->tapeContent;
 }
 
-UInt32 tapeGetCurrentPos()
+UInt32 tapeGetCurrentPos(BoardContext* board)
 {
-    return ramImagePos;
+    TapeContext* ctx = boardGetTape(board);
+
+    return ctx->ramImagePos;
 }
 
-void tapeSetCurrentPos(int pos)
+void tapeSetCurrentPos(BoardContext* board, int pos)
 {
-    if (pos < ramImageSize) {
-        ramImagePos = pos;
+    TapeContext* ctx = boardGetTape(board);
+
+    if (pos < ctx->ramImageSize) {
+        ctx->ramImagePos = pos;
     }
 }
 
-void tapeRewindNextInsert(void)
+void tapeRewindNextInsert(BoardContext* board)
 {
-	rewindNextInsert=1;
+    TapeContext* ctx = boardGetTape(board);
+
+	ctx->rewindNextInsert=1;
 }
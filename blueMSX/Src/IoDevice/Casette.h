@@ -40,23 +40,28 @@ typedef struct {
     char            fileName[8];
 } TapeContent;
 
+typedef struct TapeContext TapeContext;
+
+TapeContext* tapeContextCreate();
+void tapeContextDestroy(TapeContext* context);
+
 void   tapeSetDirectory(char* baseDir, char* prefix);
-int    tapeInsert(char *name, const char *fileInZipFile);
-int    tapeIsInserted();
-int    tapeSave(char *name, TapeFormat format);
-void tapeLoadState();
-void tapeSaveState();
-void tapeRewindNextInsert(void);
-UInt32 tapeGetLength();
-UInt32 tapeGetCurrentPos();
-void   tapeSetCurrentPos(int pos);
-TapeContent* tapeGetContent(int* count);
-TapeFormat   tapeGetFormat();
-void tapeSetReadOnly(int readOnly);
-
-UInt8 tapeWrite(UInt8 value);
-UInt8 tapeRead(UInt8* value);
-UInt8 tapeReadHeader();
-UInt8 tapeWriteHeader();
+int    tapeInsert(BoardContext* board, char *name, const char *fileInZipFile);
+int    tapeIsInserted(BoardContext* board);
+int    tapeSave(BoardContext* board, char *name, TapeFormat format);
+void tapeLoadState(BoardContext* board);
+void tapeSaveState(BoardContext* board);
+void tapeRewindNextInsert(BoardContext* board);
+UInt32 tapeGetLength(BoardContext* board);
+UInt32 tapeGetCurrentPos(BoardContext* board);
+void   tapeSetCurrentPos(BoardContext* board, int pos);
+TapeContent* tapeGetContent(BoardContext* board, int* count);
+TapeFormat   tapeGetFormat(BoardContext* board);
+void tapeSetReadOnly(BoardContext* board, int readOnly);
+
+UInt8 tapeWrite(BoardContext* board, UInt8 value);
+UInt8 tapeRead(BoardContext* board, UInt8* value);
+UInt8 tapeReadHeader(BoardContext* board);
+UInt8 tapeWriteHeader(BoardContext* board);
 
 #endif
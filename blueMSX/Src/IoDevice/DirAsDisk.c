@@ -269,18 +269,21 @@ typedef struct {
   int attr;
 } fileinfo;
 
-static int dskimagesize = 0;
-static byte *dskimage=NULL;
-static byte *fat;
-static byte *direc;
-static byte *cluster;
-static int sectorsperfat,numberoffats,reservedsectors;
-static int bytespersector,direlements,fatelements;
-static int availsectors;
-
-static int alBlockNo;
-
-static void load_dsk_svi(int diskType)
+// The image being built by dirLoadFile
+typedef struct {
+  int dskimagesize;
+  byte *dskimage;
+  byte *fat;
+  byte *direc;
+  byte *cluster;
+  int sectorsperfat,numberoffats,reservedsectors;
+  int bytespersector,direlements,fatelements;
+  int availsectors;
+
+  int alBlockNo;
+} DirDisk;
+
+static void load_dsk_svi(DirDisk* dd, int diskType)
 {
     int imageSize = 0;
     int dirOff = 0;
@@ -289,89 +292,89 @@ static void load_dsk_svi(int diskType)
     switch (diskType) {
     case 7:         // MSX2 CP/M 3 DSDD
         imageSize = 720;
-        alBlockNo = 1;
+        dd->alBlockNo = 1;
         break;
     case 6:         // MSX2 CP/M 3 SSDD
         imageSize = 360;
-        alBlockNo = 1;
+        dd->alBlockNo = 1;
         break;
     case 3:         // SVI-738 CP/M SSDD
         imageSize = 360;
-        alBlockNo = 1;
+        dd->alBlockNo = 1;
         break;
     case 5:         // SVI-328 Disk Basic DSDD
         dirOff = 0x2A000;
         fatData = 0xFF;
     case 2:         // SVI-328 CP/M DSDD
         imageSize = 338;
-        alBlockNo = 1;
+        dd->alBlockNo = 1;
         break;
     case 4:         // SVI-328 Disk Basic SSDD 
         dirOff = 0x14C00;
         fatData = 0xFE;
     case 1:         // SVI-328 CP/M SSDD
         imageSize = 168;
-        alBlockNo = 2;
+        dd->alBlockNo = 2;
         break;
     }
 
-    dskimage = (byte *) calloc (1, imageSize * 1024);
-    memset(dskimage, 0xe5, imageSize * 1024);
-    dskimagesize = imageSize * 1024;
+    dd->dskimage = (byte *) calloc (1, imageSize * 1024);
+    memset(dd->dskimage, 0xe5, imageSize * 1024);
+    dd->dskimagesize = imageSize * 1024;
 
     if (diskType == 3) {
-        memcpy(dskimage, svi738CpmBoot, 512);
+        memcpy(dd->dskimage, svi738CpmBoot, 512);
     }
     if (diskType == 6 || diskType == 7) {
-        memcpy(dskimage, msx2cpm3boot, 512);
+        memcpy(dd->dskimage, msx2cpm3boot, 512);
         if (diskType == 7) {
-            dskimage[dirOff + 0x13] = 0xA0;
+            dd->dskimage[dirOff + 0x13] = 0xA0;
         }
     }
 
     if (diskType == 4 || diskType == 5) {
-        memset(dskimage + dirOff, 0xFF, 17 * 256);
-        memset(dskimage + dirOff + 13 * 256, 0x00, 256);
-
-        memset(dskimage + dirOff + 14 * 256, 0xFF, 40);
-        memset(dskimage + dirOff + 14 * 256 + 40, fatData, 40);
-        memset(dskimage + dirOff + 14 * 256, 0xFE, 3);
-        dskimage[dirOff + 14 * 256 + 20] = 0xFE;
-        memset(dskimage + dirOff + 14 * 256 + 80, 0x20, 48);
-        memset(dskimage + dirOff + 14 * 256 + 128, 0x00, 128);
-
-        memcpy(dskimage + dirOff + 15 * 256, dskimage + dirOff + 14 * 256, 256);
-        memcpy(dskimage + dirOff + 16 * 256, dskimage + dirOff + 14 * 256, 256);
+        memset(dd->dskimage + dirOff, 0xFF, 17 * 256);
+        memset(dd->dskimage + dirOff + 13 * 256, 0x00, 256);
+
+        memset(dd->dskimage + dirOff + 14 * 256, 0xFF, 40);
+        memset(dd->dskimage + dirOff + 14 * 256 + 40, fatData, 40);
+        memset(dd->dskimage + dirOff + 14 * 256, 0xFE, 3);
+        dd->dskimage[dirOff + 14 * 256 + 20] = 0xFE;
+        memset(dd->dskimage + dirOff + 14 * 256 + 80, 0x20, 48);
+        memset(dd->dskimage + dirOff + 14 * 256 + 128, 0x00, 128);
+
+        memcpy(dd->dskimage + dirOff + 15 * 256, dd->dskimage + dirOff + 14 * 256, 256);
+        memcpy(dd->dskimage + dirOff + 16 * 256, dd->dskimage + dirOff + 14 * 256, 256);
     }
 }
 
-static void load_dsk_msx(void) {
-    dskimagesize = 720*1024;
-    dskimage=(byte *) calloc (1,720*1024);
-    memset (dskimage,0,720*1024);
-    memcpy (dskimage,msxboot,512);
-    reservedsectors=*(word *)(dskimage+0x0E);
-    numberoffats=*(dskimage+0x10);
-    sectorsperfat=*(word *)(dskimage+0x16);
-    bytespersector=*(word *)(dskimage+0x0B);
-    direlements=*(word *)(dskimage+0x11);
-    fat=dskimage+bytespersector*reservedsectors;
-    direc=fat+bytespersector*(sectorsperfat*numberoffats);
-    cluster=direc+direlements*32;
-    availsectors=80*9*2-reservedsectors-sectorsperfat*numberoffats;
-    availsectors-=direlements*32/bytespersector;
-    fatelements=availsectors/2;
-    fat[0]=0xF9;
-    fat[1]=0xFF;
-    fat[2]=0xFF;
+static void load_dsk_msx(DirDisk* dd) {
+    dd->dskimagesize = 720*1024;
+    dd->dskimage=(byte *) calloc (1,720*1024);
+    memset (dd->dskimage,0,720*1024);
+    memcpy (dd->dskimage,msxboot,512);
+    dd->reservedsectors=*(word *)(dd->dskimage+0x0E);
+    dd->numberoffats=*(dd->dskimage+0x10);
+    dd->sectorsperfat=*(word *)(dd->dskimage+0x16);
+    dd->bytespersector=*(word *)(dd->dskimage+0x0B);
+    dd->direlements=*(word *)(dd->dskimage+0x11);
+    dd->fat=dd->dskimage+dd->bytespersector*dd->reservedsectors;
+    dd->direc=dd->fat+dd->bytespersector*(dd->sectorsperfat*dd->numberoffats);
+    dd->cluster=dd->direc+dd->direlements*32;
+    dd->availsectors=80*9*2-dd->reservedsectors-dd->sectorsperfat*dd->numberoffats;
+    dd->availsectors-=dd->direlements*32/dd->bytespersector;
+    dd->fatelements=dd->availsectors/2;
+    dd->fat[0]=0xF9;
+    dd->fat[1]=0xFF;
+    dd->fat[2]=0xFF;
 }
 
-static fileinfo *getfileinfo(int pos) {
+static fileinfo *getfileinfo(DirDisk* dd, int pos) {
   fileinfo *file;  
   byte *dir;
   int i;
 
-  dir=direc+pos*32;
+  dir=dd->direc+pos*32;
   if (*dir<0x20 || *dir>=0x80) return NULL;
 
   file=(fileinfo *) malloc (sizeof (fileinfo));
@@ -409,7 +412,7 @@ static int getfilelength(int fd) {
     return length;
 }
 
-static int match(fileinfo *file, char *name) {
+static int match(DirDisk* dd, fileinfo *file, char *name) {
   char *p=file->name;
   int status=0,i;
 
@@ -440,68 +443,68 @@ static int match(fileinfo *file, char *name) {
   return 1;
 }
 
-static int next_link(int link) {
+static int next_link(DirDisk* dd, int link) {
   int pos;
 
   pos=(link>>1)*3;
   if (link&1)
-    return (((int)(fat[pos+2]))<<4)+(fat[pos+1]>>4);
+    return (((int)(dd->fat[pos+2]))<<4)+(dd->fat[pos+1]>>4);
   else
-    return (((int)(fat[pos+1]&0xF))<<8)+fat[pos];
+    return (((int)(dd->fat[pos+1]&0xF))<<8)+dd->fat[pos];
 }
 
-static int bytes_free(void) {
+static int bytes_free(DirDisk* dd) {
   int i,avail=0;
 
-  for (i=2; i<2+fatelements; i++)
-    if (!next_link (i)) avail++;
+  for (i=2; i<2+dd->fatelements; i++)
+    if (!next_link (dd, i)) avail++;
   return avail*1024;
 }
 
-static int remove_link(int link) {
+static int remove_link(DirDisk* dd, int link) {
   int pos;
   int current;
 
   pos=(link>>1)*3;
   if (link&1) {
-    current=(((int)(fat[pos+2]))<<4)+(fat[pos+1]>>4);
-    fat[pos+2]=0;
-    fat[pos+1]&=0xF;
+    current=(((int)(dd->fat[pos+2]))<<4)+(dd->fat[pos+1]>>4);
+    dd->fat[pos+2]=0;
+    dd->fat[pos+1]&=0xF;
     return current;
   }
   else  {
-    current=(((int)(fat[pos+1]&0xF))<<8)+fat[pos];
-    fat[pos]=0;
-    fat[pos+1]&=0xF0;
+    current=(((int)(dd->fat[pos+1]&0xF))<<8)+dd->fat[pos];
+    dd->fat[pos]=0;
+    dd->fat[pos+1]&=0xF0;
     return current;
   }
 }
 
-static void wipe(fileinfo *file) {
+static void wipe(DirDisk* dd, fileinfo *file) {
   int current;
 
   current=file->first;
   do {
-    current=remove_link (current);
+    current=remove_link (dd, current);
   } while (current!=0xFFF);
-  direc[file->pos*32]=0xE5;
+  dd->direc[file->pos*32]=0xE5;
 }
 
-static int get_free(void) {
+static int get_free(DirDisk* dd) {
   int i;
 
-  for (i=2; i<2+fatelements; i++)
-    if (!next_link (i)) return i;
+  for (i=2; i<2+dd->fatelements; i++)
+    if (!next_link (dd, i)) return i;
   //printf ("Internal error\n");
   //exit (5);
   return 0;
 }
 
-static int get_next_free(void) {
+static int get_next_free(DirDisk* dd) {
   int i,status=0;
 
-  for (i=2; i<2+fatelements; i++)
-    if (!next_link (i)) 
+  for (i=2; i<2+dd->fatelements; i++)
+    if (!next_link (dd, i)) 
       if (status) 
         return i;
       else
@@ -511,23 +514,23 @@ static int get_next_free(void) {
   return 0;
 }
 
-static void store_fat(int link, int next) {
+static void store_fat(DirDisk* dd, int link, int next) {
   int pos;
 
   pos=(link>>1)*3;
   if (link&1) {
-    fat[pos+2]=next>>4;
-    fat[pos+1]&=0xF;
-    fat[pos+1]|=(next&0xF)<<4;
+    dd->fat[pos+2]=next>>4;
+    dd->fat[pos+1]&=0xF;
+    dd->fat[pos+1]|=(next&0xF)<<4;
   }
   else  {
-    fat[pos]=next&0xFF;
-    fat[pos+1]&=0xF0;
-    fat[pos+1]|=next>>8;
+    dd->fat[pos]=next&0xFF;
+    dd->fat[pos+1]&=0xF0;
+    dd->fat[pos+1]|=next>>8;
   }
 }
 
-static int add_single_file(char *name, const char *pathname) {
+static int add_single_file(DirDisk* dd, char *name, const char *pathname) {
   int i,total;
   fileinfo *file;
   int fileid;
@@ -553,25 +556,25 @@ static int add_single_file(char *name, const char *pathname) {
       return -1;
   }
 
-  for (i=0; i<direlements; i++) {
-    if ((file=getfileinfo (i))!=NULL) {
-      if (match (file,name)) {
-        wipe (file);
+  for (i=0; i<dd->direlements; i++) {
+    if ((file=getfileinfo (dd, i))!=NULL) {
+      if (match (dd, file,name)) {
+        wipe (dd, file);
       }
       free (file);
     }
   }
 
-  if ((size=getfilelength(fileid))>bytes_free())
+  if ((size=getfilelength(fileid))>bytes_free(dd))
   {
     close (fileid);
     return 1;
   }
 
-  for (i=0; i<direlements; i++)
-    if (direc[i*32]<0x20 || direc[i*32]>=0x80)
+  for (i=0; i<dd->direlements; i++)
+    if (dd->direc[i*32]<0x20 || dd->direc[i*32]>=0x80)
       break;
-  if (i==direlements)
+  if (i==dd->direlements)
   {
     close (fileid);
     return 2;
@@ -585,28 +588,28 @@ static int add_single_file(char *name, const char *pathname) {
   close (fileid);
 
   total=(size+1023)>>10;
-  current=first=get_free ();
+  current=first=get_free (dd);
 
   for (i=0; i<total;) {
-    memcpy (cluster+(current-2)*1024,buffer,1024);
+    memcpy (dd->cluster+(current-2)*1024,buffer,1024);
     buffer+=1024;
     if (++i==total)
       next=0xFFF;
     else
-      next=get_next_free ();
-    store_fat (current,next);
+      next=get_next_free (dd);
+    store_fat (dd, current,next);
     current=next;
   }
 
-  memset (direc+pos*32,0,32);
-  memset (direc+pos*32,0x20,11);
+  memset (dd->direc+pos*32,0,32);
+  memset (dd->direc+pos*32,0x20,11);
   i=0; 
   for (p=name;*p;p++) {
     if (*p=='.') {
       i=8;
       continue;
     }
-    direc[pos*32+i++]=toupper (*p);
+    dd->direc[pos*32+i++]=toupper (*p);
   }
 
   result = stat(fullname, &s);
@@ -621,11 +624,11 @@ static int add_single_file(char *name, const char *pathname) {
       result = -1;
   }
   else {
-    *(word *)(direc+pos*32+0x1A)=first;
-    *(int *)(direc+pos*32+0x1C)=size;
-    *(word *)(direc+pos*32+0x16)=
+    *(word *)(dd->direc+pos*32+0x1A)=first;
+    *(int *)(dd->direc+pos*32+0x1C)=size;
+    *(word *)(dd->direc+pos*32+0x16)=
         (t->tm_sec>>1)+(t->tm_min<<5)+(t->tm_hour<<11);
-    *(word *)(direc+pos*32+0x18)=
+    *(word *)(dd->direc+pos*32+0x18)=
         (t->tm_mday)+(t->tm_mon<<5)+((t->tm_year-1980)<<9);
   }
   free (b);
@@ -643,7 +646,7 @@ static char* my_strupr(char* s)
     return s;
 }
 
-static int add_single_file_svi(int diskType, char *name, const char *pathname)
+static int add_single_file_svi(DirDisk* dd, int diskType, char *name, const char *pathname)
 {
     typedef struct
     {
@@ -707,7 +710,7 @@ static int add_single_file_svi(int diskType, char *name, const char *pathname)
     }
 
     do {
-        if (dskimage[dirOff + 16 * dirEntryNo] == 0xff) {
+        if (dd->dskimage[dirOff + 16 * dirEntryNo] == 0xff) {
             dirFound = 1;
         }
         else {
@@ -721,7 +724,7 @@ static int add_single_file_svi(int diskType, char *name, const char *pathname)
     }
 
     do {
-        if (dskimage[dirOff + 14 * 256 + fatCounter] == 0xff) {
+        if (dd->dskimage[dirOff + 14 * 256 + fatCounter] == 0xff) {
             fatFound = 1;
         }
         else {
@@ -769,7 +772,7 @@ static int add_single_file_svi(int diskType, char *name, const char *pathname)
             track = 80 - fatCounter;
         }
         offset = ((track * sides + side) * 17 + 1 - 1) * 256 - 2048;
-        memcpy(dskimage + offset, &fileBuf, bytesRead);
+        memcpy(dd->dskimage + offset, &fileBuf, bytesRead);
 
         if (!fileDone) {
             nextTrack = fatCounter;
@@ -777,24 +780,24 @@ static int add_single_file_svi(int diskType, char *name, const char *pathname)
             if (nextTrack == 20) {
                 nextTrack++;
             }
-            dskimage[dirOff + 14 * 256 + fatCounter] = nextTrack;
+            dd->dskimage[dirOff + 14 * 256 + fatCounter] = nextTrack;
             fatCounter = nextTrack;
         }
     }
     while (!fileDone);
 
-    memcpy(dskimage + dirOff + dirEntryNo * 16, &myDir, sizeof(myDir));
+    memcpy(dd->dskimage + dirOff + dirEntryNo * 16, &myDir, sizeof(myDir));
 
-    dskimage[dirOff + 14 * 256 + fatCounter] = 0xC0 | (int)ceil(bytesRead / 256.00);
+    dd->dskimage[dirOff + 14 * 256 + fatCounter] = 0xC0 | (int)ceil(bytesRead / 256.00);
 
-    memcpy(dskimage + dirOff + 15 * 256, dskimage + dirOff + 14 * 256, 256);
-    memcpy(dskimage + dirOff + 16 * 256, dskimage + dirOff + 14 * 256, 256);
+    memcpy(dd->dskimage + dirOff + 15 * 256, dd->dskimage + dirOff + 14 * 256, 256);
+    memcpy(dd->dskimage + dirOff + 16 * 256, dd->dskimage + dirOff + 14 * 256, 256);
 
     fclose(fpImport);
     return 0;
 }
 
-static int add_single_file_cpm(int diskType, char *name, const char *pathname)
+static int add_single_file_cpm(DirDisk* dd, int diskType, char *name, const char *pathname)
 {
     typedef struct
     {
@@ -893,7 +896,7 @@ static int add_single_file_cpm(int diskType, char *name, const char *pathname)
     }
 
     do {
-        if (dskimage[dirOffset + drm * 0x20] == 0xe5) {
+        if (dd->dskimage[dirOffset + drm * 0x20] == 0xe5) {
             drmFound = 1;
         }
         else {
@@ -915,23 +918,23 @@ static int add_single_file_cpm(int diskType, char *name, const char *pathname)
     rewind(fpImport);
     do {
         memset(&fileBuf, 0, dpbBLS);
-        myDir.pointers[alCount] = alBlockNo;
+        myDir.pointers[alCount] = dd->alBlockNo;
 
-//        trackOffset = ((alBlockNo - 1) & 0x02) ? (4352 * sides) : (4352 * sides + 4352);
-        trackOffset = ((alBlockNo - 1) & 0x02) ? (4352 * sides) : (4352 * sides);
-        dskDataOffset = (dirOffset + (alBlockNo * dpbBLS)) + trackOffset;
-//        dskDataOffset = dirOffset + (alBlockNo * dpbBLS);
+//        trackOffset = ((dd->alBlockNo - 1) & 0x02) ? (4352 * sides) : (4352 * sides + 4352);
+        trackOffset = ((dd->alBlockNo - 1) & 0x02) ? (4352 * sides) : (4352 * sides);
+        dskDataOffset = (dirOffset + (dd->alBlockNo * dpbBLS)) + trackOffset;
+//        dskDataOffset = dirOffset + (dd->alBlockNo * dpbBLS);
 
         fileRead = fread(fileBuf, 1, dpbBLS, fpImport);
         fileDone = (fileRead != dpbBLS);
 
-        memcpy(&dskimage[dskDataOffset], &fileBuf, dpbBLS);
+        memcpy(&dd->dskimage[dskDataOffset], &fileBuf, dpbBLS);
 
-        alBlockNo++;
+        dd->alBlockNo++;
         alCount++;
         if (alCount > 15) {
             myDir.blkcnt = 0x80;
-            memcpy(&dskimage[dirOffset + drm * sizeof(myDir)], &myDir, sizeof(myDir));
+            memcpy(&dd->dskimage[dirOffset + drm * sizeof(myDir)], &myDir, sizeof(myDir));
             memset(&myDir.pointers, 0, sizeof(myDir.pointers));
             alCount = 0;
             extent++;
@@ -945,7 +948,7 @@ static int add_single_file_cpm(int diskType, char *name, const char *pathname)
 
     myDir.blkcnt = (int)ceil((alCount * dpbBLS - (dpbBLS - fileRead)) / 128.00);
 
-    memcpy(&dskimage[dirOffset + drm * sizeof(myDir)], &myDir, sizeof(myDir));
+    memcpy(&dd->dskimage[dirOffset + drm * sizeof(myDir)], &myDir, sizeof(myDir));
 
     return 0;
 }
@@ -953,14 +956,18 @@ static int add_single_file_cpm(int diskType, char *name, const char *pathname)
 #ifdef USE_ARCH_GLOB
 void* dirLoadFile(DirDiskType diskType, const char* directory, int* size)
 {
+    DirDisk dirDisk;
+    DirDisk* dd = &dirDisk;
     ArchGlob* glob;
-    static char filename[512];
+    char filename[512];
+
+    memset(dd, 0, sizeof(DirDisk));
 
     if (diskType == 0) {
-        load_dsk_msx();
+        load_dsk_msx(dd);
     }
     else {
-        load_dsk_svi(diskType);
+        load_dsk_svi(dd, diskType);
     }
 
     sprintf(filename, "%s/*", directory);
@@ -980,18 +987,18 @@ void* dirLoadFile(DirDiskType diskType, const char* directory, int* size)
             }
             fileName++;
             if (diskType == 0) {
-                rv = add_single_file(fileName, directory);
+                rv = add_single_file(dd, fileName, directory);
             }
             else if (diskType == 4 || diskType == 5) {
-                rv = add_single_file_svi(diskType, fileName, directory);
+                rv = add_single_file_svi(dd, diskType, fileName, directory);
             }
             else {
-                rv = add_single_file_cpm(diskType, fileName, directory);
+                rv = add_single_file_cpm(dd, diskType, fileName, directory);
             }
 
             if (rv) {
-                free(dskimage);
-                dskimage = NULL;
+                free(dd->dskimage);
+                dd->dskimage = NULL;
                 break;
             }
         }
@@ -999,24 +1006,28 @@ void* dirLoadFile(DirDiskType diskType, const char* directory, int* size)
         archGlobFree(glob);
     }
 
-    *size = dskimagesize;
+    *size = dd->dskimagesize;
 
-    return dskimage;
+    return dd->dskimage;
 }
 #else
 void* dirLoadFile(DirDiskType diskType, const char* directory, int* size)
 {
 	WIN32_FIND_DATA fileData;
     HANDLE hFile;
-    static char filename[512];
+    DirDisk dirDisk;
+    DirDisk* dd = &dirDisk;
+    char filename[512];
     int success;
     int rv;
 
+    memset(dd, 0, sizeof(DirDisk));
+
     if (diskType == 0) {
-        load_dsk_msx();
+        load_dsk_msx(dd);
     }
     else {
-        load_dsk_svi(diskType);
+        load_dsk_svi(dd, diskType);
     }
 
     sprintf(filename, "%s" DIR_SEPARATOR "*.*", directory);
@@ -1026,18 +1037,18 @@ void* dirLoadFile(DirDiskType diskType, const char* directory, int* size)
     while (success) {
         if (fileData.dwFileAttributes != FILE_ATTRIBUTE_DIRECTORY) {
             if (diskType == 0) {
-                rv = add_single_file(fileName, directory);
+                rv = add_single_file(dd, fileName, directory);
             }
             else if (diskType == 4 || diskType == 5) {
-                rv = add_single_file_svi(diskType, fileName, directory);
+                rv = add_single_file_svi(dd, diskType, fileName, directory);
             }
             else {
-                rv = add_single_file_cpm(diskType, fileName, directory);
+                rv = add_single_file_cpm(dd, diskType, fileName, directory);
             }
 
             if (rv) {
-                free(dskimage);
-                dskimage = NULL;
+                free(dd->dskimage);
+                dd->dskimage = NULL;
                 break;
             }
         }
@@ -1048,8 +1059,8 @@ void* dirLoadFile(DirDiskType diskType, const char* directory, int* size)
         FindClose(hFile);
     }
 
-    *size = dskimagesize;
+    *size = dd->dskimagesize;
 
-    return dskimage;
+    return dd->dskimage;
 }
 #endif
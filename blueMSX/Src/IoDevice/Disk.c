@@ -26,6 +26,7 @@
 ******************************************************************************
 */
 #include "Disk.h"
+#include "Board.h"
 #include "DirAsDisk.h"
 #include "ziphelper.h"
 #include <stdlib.h>
@@ -42,119 +43,164 @@
 #define DISK_ERRORS_HEADER_SIZE 0x14
 #define DISK_ERRORS_SIZE        ((MAXSECTOR+7)/8)
 
-static int   drivesEnabled[MAXDRIVES] = { 1, 1 };
-static int   drivesIsCdrom[MAXDRIVES];
-static FILE* drives[MAXDRIVES];
-static int   RdOnly[MAXDRIVES];
-static char* ramImageBuffer[MAXDRIVES];
-static int   ramImageSize[MAXDRIVES];
-static int   sectorsPerTrack[MAXDRIVES];
-static int   sectorSize[MAXDRIVES];
-static int   fileSize[MAXDRIVES];
-static int   sides[MAXDRIVES];
-static int   tracks[MAXDRIVES];
-static int   changed[MAXDRIVES];
-static int   diskType[MAXDRIVES];
-static int   maxSector[MAXDRIVES];
-static char* drivesErrors[MAXDRIVES];
+struct DiskContext {
+    int   drivesEnabled[MAXDRIVES];
+    int   drivesIsCdrom[MAXDRIVES];
+    FILE* drives[MAXDRIVES];
+    int   RdOnly[MAXDRIVES];
+    char* ramImageBuffer[MAXDRIVES];
+    int   ramImageSize[MAXDRIVES];
+    int   sectorsPerTrack[MAXDRIVES];
+    int   sectorSize[MAXDRIVES];
+    int   fileSize[MAXDRIVES];
+    int   sides[MAXDRIVES];
+    int   tracks[MAXDRIVES];
+    int   changed[MAXDRIVES];
+    int   diskType[MAXDRIVES];
+    int   maxSector[MAXDRIVES];
+    char* drivesErrors[MAXDRIVES];
+};
+
 static const UInt8 svi328Cpm80track[] = "CP/M-80";
-static void diskHdUpdateInfo(int driveId);
-static void diskReadHdIdentifySector(int driveId, UInt8* buffer);
+static void diskHdUpdateInfo(BoardContext* board, int driveId);
+static void diskReadHdIdentifySector(BoardContext* board, int driveId, UInt8* buffer);
 
-enum { MSX_DISK, SVI328_DISK, IDEHD_DISK } diskTypes;
+enum { MSX_DISK, SVI328_DISK, IDEHD_DISK };
+
+DiskContext* diskContextCreate()
+{
+    DiskContext* ctx = calloc(1, sizeof(DiskContext));
+
+    ctx->drivesEnabled[0] = 1;
+    ctx->drivesEnabled[1] = 1;
+
+    return ctx;
+}
+
+void diskContextDestroy(DiskContext* ctx)
+{
+    int i;
+
+    for (i = 0; i < MAXDRIVES; i++) {
+        if (ctx->drives[i] != NULL) {
+            fclose(ctx->drives[i]);
+        }
+        free(ctx->ramImageBuffer[i]);
+        free(ctx->drivesErrors[i]);
+    }
+    free(ctx);
+}
 
-UInt8 diskEnabled(int driveId)
+UInt8 diskEnabled(BoardContext* board, int driveId)
 {
-    return driveId >= 0 && driveId < MAXDRIVES && drivesEnabled[driveId];
+    DiskContext* ctx = boardGetDisk(board);
+
+    return driveId >= 0 && driveId < MAXDRIVES && ctx->drivesEnabled[driveId];
 }
 
-int diskIsCdrom(int driveId)
+int diskIsCdrom(BoardContext* board, int driveId)
 {
-    return driveId >= 0 && driveId < MAXDRIVES && drivesIsCdrom[driveId];
+    DiskContext* ctx = boardGetDisk(board);
+
+    return driveId >= 0 && driveId < MAXDRIVES && ctx->drivesIsCdrom[driveId];
 }
 
 
-UInt8 diskReadOnly(int driveId)
+UInt8 diskReadOnly(BoardContext* board, int driveId)
 {
-    if (!diskPresent(driveId)) {
+    DiskContext* ctx = boardGetDisk(board);
+
+    if (!diskPresent(board, driveId)) {
         return 0;
     }
-    return RdOnly[driveId];
+    return ctx->RdOnly[driveId];
 }
 
-void  diskEnable(int driveId, int enable)
+void  diskEnable(BoardContext* board, int driveId, int enable)
 {
+    DiskContext* ctx = boardGetDisk(board);
+
     if (driveId >= 0 && driveId < MAXDRIVES)
-        drivesEnabled[driveId] = enable;
+        ctx->drivesEnabled[driveId] = enable;
 }
 
-UInt8 diskPresent(int driveId)
+UInt8 diskPresent(BoardContext* board, int driveId)
 {
+    DiskContext* ctx = boardGetDisk(board);
+
     return driveId >= 0 && driveId < MAXDRIVES && 
-        (drives[driveId] != NULL || ramImageBuffer[driveId] != NULL);
+        (ctx->drives[driveId] != NULL || ctx->ramImageBuffer[driveId] != NULL);
 }
 
-int diskGetSectorsPerTrack(int driveId)
+int diskGetSectorsPerTrack(BoardContext* board, int driveId)
 {
+    DiskContext* ctx = boardGetDisk(board);
+
     if (driveId < MAXDRIVES)
-        return sectorsPerTrack[driveId];
+        return ctx->sectorsPerTrack[driveId];
 
     return 0;
 }
 
-int diskGetSides(int driveId)
+int diskGetSides(BoardContext* board, int driveId)
 {
+    DiskContext* ctx = boardGetDisk(board);
+
     if (driveId < MAXDRIVES)
-        return sides[driveId];
+        return ctx->sides[driveId];
 
     return 0;
 }
 
-int diskGetSectorSize(int driveId, int side, int track, int density)
+int diskGetSectorSize(BoardContext* board, int driveId, int side, int track, int density)
 {
+    DiskContext* ctx = boardGetDisk(board);
     int secSize;
 
     if (driveId >= MAXDRIVES)
         return 0;
 
-    if (diskType[driveId] == SVI328_DISK) {
+    if (ctx->diskType[driveId] == SVI328_DISK) {
         secSize = (track==0 && side==0 && density==1) ? 128 : 256;
     }
     else {
-        secSize = sectorSize[driveId];
+        secSize = ctx->sectorSize[driveId];
     }
 
     return secSize;
 }
 
-static int diskGetSectorOffset(int driveId, int sector, int side, int track, int density)
+static int diskGetSectorOffset(BoardContext* board, int driveId, int sector, int side, int track, int density)
 {
+    DiskContext* ctx = boardGetDisk(board);
     int offset;
     int secSize;
 
     if (driveId >= MAXDRIVES)
         return 0;
 
-    secSize = diskGetSectorSize(driveId, side, track, density);
+    secSize = diskGetSectorSize(board, driveId, side, track, density);
 
-    if (diskType[driveId] == SVI328_DISK) {
+    if (ctx->diskType[driveId] == SVI328_DISK) {
         if (track==0 && side==0 && density==1)
             offset = (sector-1)*128; 
         else
-            offset = ((track*sides[driveId]+side)*17+sector-1)*256-2048;
+            offset = ((track*ctx->sides[driveId]+side)*17+sector-1)*256-2048;
     }
     else {
-        offset =  sector - 1 + diskGetSectorsPerTrack(driveId) * (track * diskGetSides(driveId) + side);
+        offset =  sector - 1 + diskGetSectorsPerTrack(board, driveId) * (track * diskGetSides(board, driveId) + side);
         offset *= secSize;
     }
     return offset;
 }
 
-int diskChanged(int driveId)
+int diskChanged(BoardContext* board, int driveId)
 {
+    DiskContext* ctx = boardGetDisk(board);
+
     if (driveId < MAXDRIVES) {
-        int isChanged = changed[driveId];
-        changed[driveId] = 0;
+        int isChanged = ctx->changed[driveId];
+        ctx->changed[driveId] = 0;
 
         return isChanged;
     }
@@ -162,78 +208,83 @@ int diskChanged(int driveId)
     return 0;
 }
 
-static DSKE diskReadError(int driveId, int sector)
+static DSKE diskReadError(BoardContext* board, int driveId, int sector)
 {
-    if( drivesErrors[driveId] == NULL ) {
+    DiskContext* ctx = boardGetDisk(board);
+
+    if( ctx->drivesErrors[driveId] == NULL ) {
         return DSKE_OK;
     }else{
-        return (drivesErrors[driveId][sector >> 3] & (0x80 >> (sector & 7)))?
+        return (ctx->drivesErrors[driveId][sector >> 3] & (0x80 >> (sector & 7)))?
                DSKE_CRC_ERROR : DSKE_OK;
     }
 }
 
-DSKE diskRead(int driveId, UInt8* buffer, int sector)
+DSKE diskRead(BoardContext* board, int driveId, UInt8* buffer, int sector)
 {
-    if (!diskPresent(driveId))
+    DiskContext* ctx = boardGetDisk(board);
+
+    if (!diskPresent(board, driveId))
         return DSKE_NO_DATA;
 
-    if (ramImageBuffer[driveId] != NULL) {
-        int offset = sector * sectorSize[driveId];
+    if (ctx->ramImageBuffer[driveId] != NULL) {
+        int offset = sector * ctx->sectorSize[driveId];
 
-        if (ramImageSize[driveId] < offset + sectorSize[driveId]) {
+        if (ctx->ramImageSize[driveId] < offset + ctx->sectorSize[driveId]) {
             return DSKE_NO_DATA;
         }
 
-        memcpy(buffer, ramImageBuffer[driveId] + offset, sectorSize[driveId]);
+        memcpy(buffer, ctx->ramImageBuffer[driveId] + offset, ctx->sectorSize[driveId]);
         return DSKE_OK;
     }
     else {
-        if ((drives[driveId] != NULL)) {
-            if (0 == fseek(drives[driveId], sector * sectorSize[driveId], SEEK_SET)) {
-                UInt8 success = fread(buffer, 1, sectorSize[driveId], drives[driveId]) == sectorSize[driveId];
-                return success? diskReadError(driveId, sector) : DSKE_NO_DATA;
+        if ((ctx->drives[driveId] != NULL)) {
+            if (0 == fseek(ctx->drives[driveId], sector * ctx->sectorSize[driveId], SEEK_SET)) {
+                UInt8 success = fread(buffer, 1, ctx->sectorSize[driveId], ctx->drives[driveId]) == ctx->sectorSize[driveId];
+                return success? diskReadError(board, driveId, sector) : DSKE_NO_DATA;
             }
         }
     }
     return DSKE_NO_DATA;
 }
 
-DSKE diskReadSector(int driveId, UInt8* buffer, int sector, int side, int track, int density, int *sectorSize)
+DSKE diskReadSector(BoardContext* board, int driveId, UInt8* buffer, int sector, int side, int track, int density, int *sectorSize)
 {
+    DiskContext* ctx = boardGetDisk(board);
     int secSize;
     int offset;
 
-    if (!diskPresent(driveId))
+    if (!diskPresent(board, driveId))
         return DSKE_NO_DATA;
 
-    if (diskType[driveId] == IDEHD_DISK && sector == -1) {
-        diskReadHdIdentifySector(driveId, buffer);
+    if (ctx->diskType[driveId] == IDEHD_DISK && sector == -1) {
+        diskReadHdIdentifySector(board, driveId, buffer);
         return DSKE_OK;
     }
 
-    offset = diskGetSectorOffset(driveId, sector, side, track, density);
-    secSize = diskGetSectorSize(driveId, side, track, density);
+    offset = diskGetSectorOffset(board, driveId, sector, side, track, density);
+    secSize = diskGetSectorSize(board, driveId, side, track, density);
 
     if (sectorSize != NULL) {
         *sectorSize = secSize;
     }
 
-    if (ramImageBuffer[driveId] != NULL) {
+    if (ctx->ramImageBuffer[driveId] != NULL) {
         int sectornum;
-        if (ramImageSize[driveId] < offset + secSize) {
+        if (ctx->ramImageSize[driveId] < offset + secSize) {
             return DSKE_NO_DATA;
         }
 
-        memcpy(buffer, ramImageBuffer[driveId] + offset, secSize);
-        sectornum = sector - 1 + diskGetSectorsPerTrack(driveId) * (track * diskGetSides(driveId) + side);
-        return diskReadError(driveId, sectornum);
+        memcpy(buffer, ctx->ramImageBuffer[driveId] + offset, secSize);
+        sectornum = sector - 1 + diskGetSectorsPerTrack(board, driveId) * (track * diskGetSides(board, driveId) + side);
+        return diskReadError(board, driveId, sectornum);
     }
     else {
-        if ((drives[driveId] != NULL)) {
-            if (0 == fseek(drives[driveId], offset, SEEK_SET)) {
-                UInt8 success = fread(buffer, 1, secSize, drives[driveId]) == secSize;
-                int sectornum = sector - 1 + diskGetSectorsPerTrack(driveId) * (track * diskGetSides(driveId) + side);
-                return success? diskReadError(driveId, sectornum) : DSKE_NO_DATA;
+        if ((ctx->drives[driveId] != NULL)) {
+            if (0 == fseek(ctx->drives[driveId], offset, SEEK_SET)) {
+                UInt8 success = fread(buffer, 1, secSize, ctx->drives[driveId]) == secSize;
+                int sectornum = sector - 1 + diskGetSectorsPerTrack(board, driveId) * (track * diskGetSides(board, driveId) + side);
+                return success? diskReadError(board, driveId, sectornum) : DSKE_NO_DATA;
             }
         }
     }
@@ -256,70 +307,71 @@ static int isSectorSize256(const UInt8* buf)
     return rv != 0;
 }
 
-static void diskUpdateInfo(int driveId) 
+static void diskUpdateInfo(BoardContext* board, int driveId) 
 {
+    DiskContext* ctx = boardGetDisk(board);
 	UInt8 buf[512];
     int secSize;
     DSKE rv;
 
-    sectorsPerTrack[driveId] = 9;
-    sides[driveId]           = 2;
-    tracks[driveId]          = 80;
-    changed[driveId]         = 1;
-    sectorSize[driveId]      = 512;
-    diskType[driveId]        = MSX_DISK;
-    maxSector[driveId]       = MAXSECTOR;
+    ctx->sectorsPerTrack[driveId] = 9;
+    ctx->sides[driveId]           = 2;
+    ctx->tracks[driveId]          = 80;
+    ctx->changed[driveId]         = 1;
+    ctx->sectorSize[driveId]      = 512;
+    ctx->diskType[driveId]        = MSX_DISK;
+    ctx->maxSector[driveId]       = MAXSECTOR;
 
-    if (fileSize[driveId] > 2 * 1024 * 1024) {
+    if (ctx->fileSize[driveId] > 2 * 1024 * 1024) {
         // HD image
-        diskHdUpdateInfo(driveId);
+        diskHdUpdateInfo(board, driveId);
         return;
     }
 
-    if (fileSize[driveId] / 512 == 1440) {
+    if (ctx->fileSize[driveId] / 512 == 1440) {
         return;
     }
 
-    rv = diskReadSector(driveId, buf, 1, 0, 0, 512, &secSize);
+    rv = diskReadSector(board, driveId, buf, 1, 0, 0, 512, &secSize);
     if (rv != DSKE_OK) {
         return;
     }
 
-    switch (fileSize[driveId]) {
+    switch (ctx->fileSize[driveId]) {
         case 163840:
             if (isSectorSize256(buf)) {
-                sectorSize[driveId]      = 256;
-                sectorsPerTrack[driveId] = 16;
-                tracks[driveId]          = 40;
-                sides[driveId]           = 1;
+                ctx->sectorSize[driveId]      = 256;
+                ctx->sectorsPerTrack[driveId] = 16;
+                ctx->tracks[driveId]          = 40;
+                ctx->sides[driveId]           = 1;
             }
             break;
         case 172032:  /* SVI-328 40 SS */
-            sides[driveId] = 1;
-            tracks[driveId] = 40;
-            sectorsPerTrack[driveId] = 17;
-            diskType[driveId] = SVI328_DISK;
+            ctx->sides[driveId] = 1;
+            ctx->tracks[driveId] = 40;
+            ctx->sectorsPerTrack[driveId] = 17;
+            ctx->diskType[driveId] = SVI328_DISK;
             return;
         case 184320:  /* BW 12 SSDD */
             if (isSectorSize256(buf)) {
-                sectorSize[driveId] = 256;
-                sectorsPerTrack[driveId] = 18;
-                tracks[driveId] = 40;
-                sides[driveId] = 1;
+                ctx->sectorSize[driveId] = 256;
+                ctx->sectorsPerTrack[driveId] = 18;
+                ctx->tracks[driveId] = 40;
+                ctx->sides[driveId] = 1;
             }
             return;
         case 204800:  /* Kaypro II SSDD */
-            sectorSize[driveId] = 512;
-            sectorsPerTrack[driveId] = 10;
-            tracks[driveId] = 40;
-            sides[driveId] = 1;
+            ctx->sectorSize[driveId] = 512;
+            ctx->sectorsPerTrack[driveId] = 10;
+            ctx->tracks[driveId] = 40;
+            ctx->sides[driveId] = 1;
             return;
         case 346112:  /* SVI-328 40 DS/80 SS */
-            sides[driveId] = 1;
-            tracks[driveId] = 80;
-            sectorsPerTrack[driveId] = 17;
-            diskType[driveId] = SVI328_DISK;
-            rv = diskReadSector(driveId, buf, 15, 0, 40, 0, &secSize);
+            ctx->sides[driveId] = 1;
+            ctx->tracks[driveId] = 80;
+            ctx->sectorsPerTrack[driveId] = 17;
+            ctx->diskType[driveId] = SVI328_DISK;
+            rv = diskReadSector(board, driveId, buf, 15, 0, 40, 0, &secSize);
             if (rv != DSKE_OK) {
                 return;
             }
@@ -327,13 +379,13 @@ static void diskUpdateInfo(int driveId)
             if (buf[0] == 0xfe && buf[1] == 0xfe && buf[2] == 0xfe && buf[20] != 0xfe && buf[40] == 0xfe) {
             	return;
             }
-            rv = diskReadSector(driveId, buf, 1, 0, 1, 0, &secSize);
+            rv = diskReadSector(board, driveId, buf, 1, 0, 1, 0, &secSize);
             if (rv != DSKE_OK) {
                 return;
             }
             // Is it sysgend for 80 track CP/M?
             if (memcmp(&buf[176], &svi328Cpm80track[0], strlen(svi328Cpm80track)) == 0) {
-                rv = diskReadSector(driveId, buf, 2, 0, 0, 1, &secSize);
+                rv = diskReadSector(board, driveId, buf, 2, 0, 0, 1, &secSize);
                 if (rv != DSKE_OK) {
                     return;
                 }
@@ -341,15 +393,15 @@ static void diskUpdateInfo(int driveId)
                     return;
                 }
             }
-            sides[driveId] = 2;
-            tracks[driveId] = 40;
+            ctx->sides[driveId] = 2;
+            ctx->tracks[driveId] = 40;
             return;
         case 348160:  /* SVI-728 DSDD (CP/M) */
             if (isSectorSize256(buf)) {
-                sectorSize[driveId] = 256;
-                sectorsPerTrack[driveId] = 17;
-                tracks[driveId] = 40;
-                sides[driveId] = 2;
+                ctx->sectorSize[driveId] = 256;
+                ctx->sectorsPerTrack[driveId] = 17;
+                ctx->tracks[driveId] = 40;
+                ctx->sides[driveId] = 2;
             }
             return;
 	}
@@ -357,127 +409,129 @@ static void diskUpdateInfo(int driveId)
     if (buf[0] ==0xeb) {
         switch (buf[0x15]) {
         case 0xf8:
-	        sides[driveId]           = 1;
-            tracks[driveId]          = 80;
-	        sectorsPerTrack[driveId] = 9;
+	        ctx->sides[driveId]           = 1;
+            ctx->tracks[driveId]          = 80;
+	        ctx->sectorsPerTrack[driveId] = 9;
             return;
         case 0xf9:
-	        sides[driveId]           = 2;
-            tracks[driveId]          = 80;
-	        sectorsPerTrack[driveId] = 9;
+	        ctx->sides[driveId]           = 2;
+            ctx->tracks[driveId]          = 80;
+	        ctx->sectorsPerTrack[driveId] = 9;
             // This check is needed to get the SVI-738 MSX-DOS disks to work
             // Maybe it should be applied to other cases as well
-            rv = diskReadSector(driveId, buf, 2, 0, 0, 512, &secSize);
+            rv = diskReadSector(board, driveId, buf, 2, 0, 0, 512, &secSize);
             if (rv == DSKE_OK && buf[0] == 0xf8) {
-	            sides[driveId] = 1;
+	            ctx->sides[driveId] = 1;
             }
             return;
         case 0xfa:
-	        sides[driveId]           = 1;
-            tracks[driveId]          = 80;
-	        sectorsPerTrack[driveId] = 8;
-            if (fileSize[driveId] == 368640) {
-	            sectorsPerTrack[driveId] = 9;
+	        ctx->sides[driveId]           = 1;
+            ctx->tracks[driveId]          = 80;
+	        ctx->sectorsPerTrack[driveId] = 8;
+            if (ctx->fileSize[driveId] == 368640) {
+	            ctx->sectorsPerTrack[driveId] = 9;
             }
             return;
         case 0xfb:
-	        sides[driveId]           = 2;
-            tracks[driveId]          = 80;
-	        sectorsPerTrack[driveId] = 8;
+	        ctx->sides[driveId]           = 2;
+            ctx->tracks[driveId]          = 80;
+	        ctx->sectorsPerTrack[driveId] = 8;
             return;
         case 0xfc:
-	        sides[driveId]           = 1;
-            tracks[driveId]          = 40;
-	        sectorsPerTrack[driveId] = 9;
+	        ctx->sides[driveId]           = 1;
+            ctx->tracks[driveId]          = 40;
+	        ctx->sectorsPerTrack[driveId] = 9;
             return;
         case 0xfd:
-	        sides[driveId]           = 2;
-            tracks[driveId]          = 40;
-	        sectorsPerTrack[driveId] = 9;
+	        ctx->sides[driveId]           = 2;
+            ctx->tracks[driveId]          = 40;
+	        ctx->sectorsPerTrack[driveId] = 9;
             return;
         case 0xfe:
-	        sides[driveId]           = 1;
-            tracks[driveId]          = 40;
-	        sectorsPerTrack[driveId] = 8;
+	        ctx->sides[driveId]           = 1;
+            ctx->tracks[driveId]          = 40;
+	        ctx->sectorsPerTrack[driveId] = 8;
             return;
         case 0xff:
-	        sides[driveId]           = 2;
-            tracks[driveId]          = 40;
-	        sectorsPerTrack[driveId] = 8;
+	        ctx->sides[driveId]           = 2;
+            ctx->tracks[driveId]          = 40;
+	        ctx->sectorsPerTrack[driveId] = 8;
             return;
         }
     }
 
     if ((buf[0] == 0xe9) || (buf[0] ==0xeb)) {
-	    sectorsPerTrack[driveId] = buf[0x18] + 256 * buf[0x19];
-	    sides[driveId]           = buf[0x1a] + 256 * buf[0x1b];
+	    ctx->sectorsPerTrack[driveId] = buf[0x18] + 256 * buf[0x19];
+	    ctx->sides[driveId]           = buf[0x1a] + 256 * buf[0x1b];
     }
     else {
-        rv = diskReadSector(driveId, buf, 2, 0, 0, 512, &secSize);
+        rv = diskReadSector(board, driveId, buf, 2, 0, 0, 512, &secSize);
         if (rv != DSKE_OK) {
             return;
         }
 		if (buf[0] >= 0xF8) {
-			sectorsPerTrack[driveId] = (buf[0] & 2) ? 8 : 9;
-			sides[driveId]           = (buf[0] & 1) ? 2 : 1;
+			ctx->sectorsPerTrack[driveId] = (buf[0] & 2) ? 8 : 9;
+			ctx->sides[driveId]           = (buf[0] & 1) ? 2 : 1;
 		}
     }
 
-    if (sectorsPerTrack[driveId] == 0  || sides[driveId] == 0 || 
-        sectorsPerTrack[driveId] > 255 || sides[driveId] > 2) 
+    if (ctx->sectorsPerTrack[driveId] == 0  || ctx->sides[driveId] == 0 || 
+        ctx->sectorsPerTrack[driveId] > 255 || ctx->sides[driveId] > 2) 
     {
-    	switch (fileSize[driveId]) {
+    	switch (ctx->fileSize[driveId]) {
         case 163840:
-            sectorSize[driveId]      = 256;
-	        sectorsPerTrack[driveId] = 16;
-            tracks[driveId]          = 40;
-	        sides[driveId]           = 1;
+            ctx->sectorSize[driveId]      = 256;
+	        ctx->sectorsPerTrack[driveId] = 16;
+            ctx->tracks[driveId]          = 40;
+	        ctx->sides[driveId]           = 1;
             break;
         case 327680:  /* 80 tracks, 1 side, 8 sectors/track */
-	        sectorsPerTrack[driveId] = 8;
-	        sides[driveId] = 1;
+	        ctx->sectorsPerTrack[driveId] = 8;
+	        ctx->sides[driveId] = 1;
             break;
         case 368640:  /* 80 tracks, 1 side, 9 sectors/track */
-	        sectorsPerTrack[driveId] = 9;
-	        sides[driveId] = 1;
+	        ctx->sectorsPerTrack[driveId] = 9;
+	        ctx->sides[driveId] = 1;
             break;
         case 655360:  /* 80 tracks, 2 side, 8 sectors/track */
-	        sectorsPerTrack[driveId] = 8;
-	        sides[driveId] = 2;
+	        ctx->sectorsPerTrack[driveId] = 8;
+	        ctx->sides[driveId] = 2;
             break;
         default:
-            sectorsPerTrack[driveId] = 9;
-            sides[driveId]           = 2;
+            ctx->sectorsPerTrack[driveId] = 9;
+            ctx->sides[driveId]           = 2;
         }
     }
 }
 
-UInt8 diskWrite(int driveId, UInt8 *buffer, int sector)
+UInt8 diskWrite(BoardContext* board, int driveId, UInt8 *buffer, int sector)
 {
-    if (!diskPresent(driveId)) {
+    DiskContext* ctx = boardGetDisk(board);
+
+    if (!diskPresent(board, driveId)) {
         return 0;
     }
 
-    if (sector >= maxSector[driveId]) {
+    if (sector >= ctx->maxSector[driveId]) {
         return 0;
     }
 
-    if (ramImageBuffer[driveId] != NULL) {
-        int offset = sector * sectorSize[driveId];
+    if (ctx->ramImageBuffer[driveId] != NULL) {
+        int offset = sector * ctx->sectorSize[driveId];
 
-        if (ramImageSize[driveId] < offset + sectorSize[driveId]) {
+        if (ctx->ramImageSize[driveId] < offset + ctx->sectorSize[driveId]) {
             return 0;
         }
 
-        memcpy(ramImageBuffer[driveId] + offset, buffer, sectorSize[driveId]);
+        memcpy(ctx->ramImageBuffer[driveId] + offset, buffer, ctx->sectorSize[driveId]);
         return 1;
     }
     else {
-        if (drives[driveId] != NULL && !RdOnly[driveId]) {
-            if (0 == fseek(drives[driveId], sector * sectorSize[driveId], SEEK_SET)) {
-                UInt8 success = fwrite(buffer, 1, sectorSize[driveId], drives[driveId]) == sectorSize[driveId];
+        if (ctx->drives[driveId] != NULL && !ctx->RdOnly[driveId]) {
+            if (0 == fseek(ctx->drives[driveId], sector * ctx->sectorSize[driveId], SEEK_SET)) {
+                UInt8 success = fwrite(buffer, 1, ctx->sectorSize[driveId], ctx->drives[driveId]) == ctx->sectorSize[driveId];
                 if (success && sector == 0) {
-                    diskUpdateInfo(driveId);
+                    diskUpdateInfo(board, driveId);
                 }
                 return success;
             }
@@ -486,36 +540,37 @@ UInt8 diskWrite(int driveId, UInt8 *buffer, int sector)
     return 0;
 }
 
-UInt8 diskWriteSector(int driveId, UInt8 *buffer, int sector, int side, int track, int density)
+UInt8 diskWriteSector(BoardContext* board, int driveId, UInt8 *buffer, int sector, int side, int track, int density)
 {
+    DiskContext* ctx = boardGetDisk(board);
     int secSize;
     int offset;
 
-    if (!diskPresent(driveId))
+    if (!diskPresent(board, driveId))
         return 0;
 
-    if (sector >= maxSector[driveId])
+    if (sector >= ctx->maxSector[driveId])
         return 0;
 
     if (density == 0) {
-        density = sectorSize[driveId];
+        density = ctx->sectorSize[driveId];
     }
 
-    offset = diskGetSectorOffset(driveId, sector, side, track, density);
-    secSize = diskGetSectorSize(driveId, side, track, density);
+    offset = diskGetSectorOffset(board, driveId, sector, side, track, density);
+    secSize = diskGetSectorSize(board, driveId, side, track, density);
 
-    if (ramImageBuffer[driveId] != NULL) {
-        if (ramImageSize[driveId] < offset + secSize) {
+    if (ctx->ramImageBuffer[driveId] != NULL) {
+        if (ctx->ramImageSize[driveId] < offset + secSize) {
             return 0;
         }
 
-        memcpy(ramImageBuffer[driveId] + offset, buffer, secSize);
+        memcpy(ctx->ramImageBuffer[driveId] + offset, buffer, secSize);
         return 1;
     }
     else {
-        if (drives[driveId] != NULL && !RdOnly[driveId]) {
-            if (0 == fseek(drives[driveId], offset, SEEK_SET)) {
-                UInt8 success = fwrite(buffer, 1, secSize, drives[driveId]) == secSize;
+        if (ctx->drives[driveId] != NULL && !ctx->RdOnly[driveId]) {
+            if (0 == fseek(ctx->drives[driveId], offset, SEEK_SET)) {
+                UInt8 success = fwrite(buffer, 1, secSize, ctx->drives[driveId]) == secSize;
                 return success;
             }
         }
@@ -523,9 +578,11 @@ UInt8 diskWriteSector(int driveId, UInt8 *buffer, int sector, int side, int trac
     return 0;
 }
 
-void diskSetInfo(int driveId, char* fileName, const char* fileInZipFile)
+void diskSetInfo(BoardContext* board, int driveId, char* fileName, const char* fileInZipFile)
 {
-    drivesIsCdrom[driveId] = fileName && strcmp(fileName, DISK_CDROM) == 0;
+    DiskContext* ctx = boardGetDisk(board);
+
+    ctx->drivesIsCdrom[driveId] = fileName && strcmp(fileName, DISK_CDROM) == 0;
 }
 
 static char *makeErrorsFileName(const char *fileName)
@@ -543,8 +600,9 @@ static char *makeErrorsFileName(const char *fileName)
     }
 }
 
-UInt8 diskChange(int driveId, const char* fileName, const char* fileInZipFile)
+UInt8 diskChange(BoardContext* board, int driveId, const char* fileName, const char* fileInZipFile)
 {
+    DiskContext* ctx = boardGetDisk(board);
     struct stat s;
     int rv;
     char *fname;
@@ -552,23 +610,23 @@ UInt8 diskChange(int driveId, const char* fileName, const char* fileInZipFile)
     if (driveId >= MAXDRIVES)
         return 0;
 
-    drivesIsCdrom[driveId] = 0;
+    ctx->drivesIsCdrom[driveId] = 0;
 
     /* Close previous disk image */
-    if(drives[driveId] != NULL) { 
-        fclose(drives[driveId]);
-        drives[driveId] = NULL; 
+    if(ctx->drives[driveId] != NULL) { 
+        fclose(ctx->drives[driveId]);
+        ctx->drives[driveId] = NULL; 
     }
 
-    if (ramImageBuffer[driveId] != NULL) {
+    if (ctx->ramImageBuffer[driveId] != NULL) {
         // Flush to file??
-        free(ramImageBuffer[driveId]);
-        ramImageBuffer[driveId] = NULL;
+        free(ctx->ramImageBuffer[driveId]);
+        ctx->ramImageBuffer[driveId] = NULL;
     }
 
-    if (drivesErrors[driveId] != NULL) {
-        free(drivesErrors[driveId]);
-        drivesErrors[driveId] = NULL;
+    if (ctx->drivesErrors[driveId] != NULL) {
+        free(ctx->drivesErrors[driveId]);
+        ctx->drivesErrors[driveId] = NULL;
     }
 
     if(!fileName) {
@@ -576,50 +634,50 @@ UInt8 diskChange(int driveId, const char* fileName, const char* fileInZipFile)
     }
 
     if (strcmp(fileName, DISK_CDROM) == 0) {
-        drivesIsCdrom[driveId] = 1;
+        ctx->drivesIsCdrom[driveId] = 1;
         return 1;
     }
 
     rv = stat(fileName, &s);
     if (rv == 0) {
         if (s.st_mode & S_IFDIR) {
-            ramImageBuffer[driveId] = dirLoadFile(DDT_MSX, fileName, &ramImageSize[driveId]);
-            fileSize[driveId] = ramImageSize[driveId];
-            diskUpdateInfo(driveId);
-            return ramImageBuffer[driveId] != NULL;
+            ctx->ramImageBuffer[driveId] = dirLoadFile(DDT_MSX, fileName, &ctx->ramImageSize[driveId]);
+            ctx->fileSize[driveId] = ctx->ramImageSize[driveId];
+            diskUpdateInfo(board, driveId);
+            return ctx->ramImageBuffer[driveId] != NULL;
         }
     }
 
     if (fileInZipFile != NULL) {
-        ramImageBuffer[driveId] = zipLoadFile(fileName, fileInZipFile, &ramImageSize[driveId]);
-        fileSize[driveId] = ramImageSize[driveId];
+        ctx->ramImageBuffer[driveId] = zipLoadFile(fileName, fileInZipFile, &ctx->ramImageSize[driveId]);
+        ctx->fileSize[driveId] = ctx->ramImageSize[driveId];
 
         fname = makeErrorsFileName(fileInZipFile);
         if( fname != NULL ) {
             int size=0;
-            drivesErrors[driveId] = zipLoadFile(fileName, fname, &size);
-            if( drivesErrors[driveId] != NULL && size > DISK_ERRORS_HEADER_SIZE &&
-                strcmp(drivesErrors[driveId], DISK_ERRORS_HEADER)==0 ) {
-                memcpy(drivesErrors[driveId],
-                       drivesErrors[driveId] + DISK_ERRORS_HEADER_SIZE,
+            ctx->drivesErrors[driveId] = zipLoadFile(fileName, fname, &size);
+            if( ctx->drivesErrors[driveId] != NULL && size > DISK_ERRORS_HEADER_SIZE &&
+                strcmp(ctx->drivesErrors[driveId], DISK_ERRORS_HEADER)==0 ) {
+                memcpy(ctx->drivesErrors[driveId],
+                       ctx->drivesErrors[driveId] + DISK_ERRORS_HEADER_SIZE,
                        size - DISK_ERRORS_HEADER_SIZE);
             }
             free(fname);
         }
 
-        diskUpdateInfo(driveId);
-        return ramImageBuffer[driveId] != NULL;
+        diskUpdateInfo(board, driveId);
+        return ctx->ramImageBuffer[driveId] != NULL;
     }
 
-    drives[driveId] = fopen(fileName, "r+b");
-    RdOnly[driveId] = 0;
+    ctx->drives[driveId] = fopen(fileName, "r+b");
+    ctx->RdOnly[driveId] = 0;
 
-    if (drives[driveId] == NULL) {
-        drives[driveId] = fopen(fileName, "rb");
-        RdOnly[driveId] = 1;
+    if (ctx->drives[driveId] == NULL) {
+        ctx->drives[driveId] = fopen(fileName, "rb");
+        ctx->RdOnly[driveId] = 1;
     }
 
-    if (drives[driveId] == NULL) {
+    if (ctx->drives[driveId] == NULL) {
         return 0;
     }
 
@@ -631,7 +689,7 @@ UInt8 diskChange(int driveId, const char* fileName, const char* fileInZipFile)
             if( fread(p, 1, DISK_ERRORS_HEADER_SIZE, f) == DISK_ERRORS_HEADER_SIZE ) {
                 if( strcmp(p, DISK_ERRORS_HEADER) == 0 ) {
                     fread(p, 1, DISK_ERRORS_SIZE, f);
-                    drivesErrors[driveId] = p;
+                    ctx->drivesErrors[driveId] = p;
                     p = NULL;
                 }
             }
@@ -643,10 +701,10 @@ UInt8 diskChange(int driveId, const char* fileName, const char* fileInZipFile)
         free(fname);
     }
 
-    fseek(drives[driveId],0,SEEK_END);
-    fileSize[driveId] = ftell(drives[driveId]);
+    fseek(ctx->drives[driveId],0,SEEK_END);
+    ctx->fileSize[driveId] = ftell(ctx->drives[driveId]);
 
-    diskUpdateInfo(driveId);
+    diskUpdateInfo(board, driveId);
 
     return 1;
 }
@@ -688,9 +746,10 @@ static const UInt8 hdIdentifyBlock[512] = {
     0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
 };
 
-static void diskReadHdIdentifySector(int driveId, UInt8* buffer)
+static void diskReadHdIdentifySector(BoardContext* board, int driveId, UInt8* buffer)
 {
-    UInt32 totalSectors = fileSize[driveId] / 512;
+    DiskContext* ctx = boardGetDisk(board);
+    UInt32 totalSectors = ctx->fileSize[driveId] / 512;
     UInt16 heads = 16;
     UInt16 sectors = 32;
     UInt16 cylinders = (UInt16)(totalSectors / (heads * sectors));
@@ -709,15 +768,17 @@ static void diskReadHdIdentifySector(int driveId, UInt8* buffer)
     buffer[0x7b] = (UInt8)((totalSectors & 0xff000000) >> 24);
 }
 
-static void diskHdUpdateInfo(int driveId)
+static void diskHdUpdateInfo(BoardContext* board, int driveId)
 {
-    sectorSize[driveId]      = 512;
-    sectorsPerTrack[driveId] = fileSize[driveId] / 512;
-    tracks[driveId]          = 1;
-    changed[driveId]         = 1;
-    sides[driveId]           = 1;
-    diskType[driveId]        = IDEHD_DISK;
-    maxSector[driveId]       = 99999999;
+    DiskContext* ctx = boardGetDisk(board);
+
+    ctx->sectorSize[driveId]      = 512;
+    ctx->sectorsPerTrack[driveId] = ctx->fileSize[driveId] / 512;
+    ctx->tracks[driveId]          = 1;
+    ctx->changed[driveId]         = 1;
+    ctx->sides[driveId]           = 1;
+    ctx->diskType[driveId]        = IDEHD_DISK;
+    ctx->maxSector[driveId]       = 99999999;
 }
 
 /* SCSI device */
@@ -727,51 +788,55 @@ static void diskHdUpdateInfo(int driveId)
     corresponds to harddisk and floppy disk
 */
 
-int _diskGetTotalSectors(int driveId)
+int _diskGetTotalSectors(BoardContext* board, int driveId)
 {
-    if ((diskPresent(driveId)) && (driveId < MAXDRIVES))
-        return fileSize[driveId] / 512;
+    DiskContext* ctx = boardGetDisk(board);
+
+    if ((diskPresent(board, driveId)) && (driveId < MAXDRIVES))
+        return ctx->fileSize[driveId] / 512;
     return 0;
 }
 
 /*
     optimized routine for ScsiDevice.c
 */
-int _diskRead2(int driveId, UInt8* buffer, int sector, int numSectors)
+int _diskRead2(BoardContext* board, int driveId, UInt8* buffer, int sector, int numSectors)
 {
+    DiskContext* ctx = boardGetDisk(board);
     int length  = numSectors * 512;
-    if (!diskPresent(driveId))
+    if (!diskPresent(board, driveId))
         return 0;
 
-    if (ramImageBuffer[driveId] == NULL) {
-        if ((drives[driveId] != NULL)) {
-            if (0 == fseek(drives[driveId], sector * 512, SEEK_SET))
-                return (fread(buffer, 1, length, drives[driveId]) == length);
+    if (ctx->ramImageBuffer[driveId] == NULL) {
+        if ((ctx->drives[driveId] != NULL)) {
+            if (0 == fseek(ctx->drives[driveId], sector * 512, SEEK_SET))
+                return (fread(buffer, 1, length, ctx->drives[driveId]) == length);
         }
         return 0;
     }
 
-    memcpy(buffer, ramImageBuffer[driveId] + sector * 512, numSectors * 512);
+    memcpy(buffer, ctx->ramImageBuffer[driveId] + sector * 512, numSectors * 512);
     return 1;
 }
 
 /*
     optimized routine for ScsiDevice.c
 */
-int _diskWrite2(int driveId, UInt8* buffer, int sector, int numSectors)
+int _diskWrite2(BoardContext* board, int driveId, UInt8* buffer, int sector, int numSectors)
 {
+    DiskContext* ctx = boardGetDisk(board);
     int length  = numSectors * 512;
-    if (!diskPresent(driveId))
+    if (!diskPresent(board, driveId))
         return 0;
 
-    if (ramImageBuffer[driveId] == NULL) {
-        if ((drives[driveId] != NULL)) {
-            if (0 == fseek(drives[driveId], sector * 512, SEEK_SET))
-                return (fwrite(buffer, 1, length, drives[driveId]) == length);
+    if (ctx->ramImageBuffer[driveId] == NULL) {
+        if ((ctx->drives[driveId] != NULL)) {
+            if (0 == fseek(ctx->drives[driveId], sector * 512, SEEK_SET))
+                return (fwrite(buffer, 1, length, ctx->drives[driveId]) == length);
         }
         return 0;
     }
 
-    memcpy(ramImageBuffer[driveId] + sector * 512, buffer, length);
+    memcpy(ctx->ramImageBuffer[driveId] + sector * 512, buffer, length);
     return 1;
 }
@@ -47,24 +47,29 @@ typedef enum {
     DSKE_CRC_ERROR
 } DSKE;
 
-UInt8 diskChange(int driveId, const char* fileName, const char* fileInZipFile);
-void diskSetInfo(int driveId, char* fileName, const char* fileInZipFile);
-void  diskEnable(int driveId, int enable);
-UInt8 diskEnabled(int driveId);
-UInt8 diskReadOnly(int driveId);
-UInt8 diskPresent(int driveId);
-DSKE  diskRead(int driveId, UInt8* buffer, int sector);
-DSKE  diskReadSector(int driveId, UInt8* buffer, int sector, int side, int track, int density, int *sectorSize);
-UInt8 diskWrite(int driveId, UInt8* buffer, int sector);
-UInt8 diskWriteSector(int driveId, UInt8 *buffer, int sector, int side, int track, int density);
-int   diskGetSectorsPerTrack(int driveId);
-int   diskGetSectorSize(int driveId, int side, int track, int density);
-int   diskIsCdrom(int driveId);
-int   diskGetSides(int driveId);
-int   diskChanged(int driveId);
-int   _diskRead2(int driveId, UInt8* buffer, int sector, int numSectors);
-int   _diskWrite2(int driveId, UInt8* buffer, int sector, int numSectors);
-int   _diskGetTotalSectors(int driveId);
+typedef struct DiskContext DiskContext;
+
+DiskContext* diskContextCreate();
+void diskContextDestroy(DiskContext* context);
+
+UInt8 diskChange(BoardContext* board, int driveId, const char* fileName, const char* fileInZipFile);
+void diskSetInfo(BoardContext* board, int driveId, char* fileName, const char* fileInZipFile);
+void  diskEnable(BoardContext* board, int driveId, int enable);
+UInt8 diskEnabled(BoardContext* board, int driveId);
+UInt8 diskReadOnly(BoardContext* board, int driveId);
+UInt8 diskPresent(BoardContext* board, int driveId);
+DSKE  diskRead(BoardContext* board, int driveId, UInt8* buffer, int sector);
+DSKE  diskReadSector(BoardContext* board, int driveId, UInt8* buffer, int sector, int side, int track, int density, int *sectorSize);
+UInt8 diskWrite(BoardContext* board, int driveId, UInt8* buffer, int sector);
+UInt8 diskWriteSector(BoardContext* board, int driveId, UInt8 *buffer, int sector, int side, int track, int density);
+int   diskGetSectorsPerTrack(BoardContext* board, int driveId);
+int   diskGetSectorSize(BoardContext* board, int driveId, int side, int track, int density);
+int   diskIsCdrom(BoardContext* board, int driveId);
+int   diskGetSides(BoardContext* board, int driveId);
+int   diskChanged(BoardContext* board, int driveId);
+int   _diskRead2(BoardContext* board, int driveId, UInt8* buffer, int sector, int numSectors);
+int   _diskWrite2(BoardContext* board, int driveId, UInt8* buffer, int sector, int numSectors);
+int   _diskGetTotalSectors(BoardContext* board, int driveId);
 static int diskGetHdDriveId(int hdId, int driveNo) {
     return MAX_FDC_COUNT + MAX_DRIVES_PER_HD * hdId + driveNo;
 }
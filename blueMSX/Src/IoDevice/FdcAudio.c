@@ -34,7 +34,7 @@
 
 #ifdef NO_EMBEDDED_SAMPLES
 
-FdcAudio* fdcAudioCreate(FdcAudioType type) { return NULL; }
+FdcAudio* fdcAudioCreate(BoardContext* board, FdcAudioType type) { return NULL; }
 void fdcAudioDestroy(FdcAudio* fdcAudio) {}
 void fdcAudioReset(FdcAudio* fdcAudio) {}
 void fdcAudioSetMotor(FdcAudio* fdcAudio, int motorOn) {}
@@ -3445,6 +3445,7 @@ static Int16 PanasonicMotorSamples[] = {
 
 
 struct FdcAudio {
+    BoardContext* board;
     SamplePlayer* samplePlayer;
     int motorOn;
     Int16* readSamples;
@@ -3485,11 +3486,13 @@ static void loadSample(char* filename, Int16** samples, Int32* count,
     *count = defCount;
 }
 
-FdcAudio* fdcAudioCreate(FdcAudioType type)
+FdcAudio* fdcAudioCreate(BoardContext* board, FdcAudioType type)
 {
     FdcAudio* fdcAudio = malloc(sizeof(FdcAudio));
 
-    fdcAudio->samplePlayer = samplePlayerCreate(boardGetMixer(), MIXER_CHANNEL_IO, 16, 44100);
+    fdcAudio->board = board;
+
+    fdcAudio->samplePlayer = samplePlayerCreate(boardGetMixer(board), MIXER_CHANNEL_IO, 16, 44100);
 
     switch (type) {
     default:
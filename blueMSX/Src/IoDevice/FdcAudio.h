@@ -34,7 +34,7 @@ typedef enum { FA_WESTERN_DIGITAL, FA_PANASONIC } FdcAudioType;
 
 typedef struct FdcAudio FdcAudio;
 
-FdcAudio* fdcAudioCreate(FdcAudioType type);
+FdcAudio* fdcAudioCreate(BoardContext* board, FdcAudioType type);
 void fdcAudioDestroy(FdcAudio* fdcAudio);
 void fdcAudioReset(FdcAudio* fdcAudio);
 void fdcAudioSetMotor(FdcAudio* fdcAudio, int motorOn);
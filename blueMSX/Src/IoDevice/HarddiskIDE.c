@@ -40,6 +40,7 @@
 
 
 struct HarddiskIde {
+    BoardContext* board;
     UInt8 errorReg;
     UInt8 sectorCountReg;
     UInt8 sectorNumReg;
@@ -94,7 +95,7 @@ static void executeCommand(HarddiskIde* hd, UInt8 cmd)
         break;
 
     case 0xec: // ATA Identify Device
-        if (diskReadSector(hd->diskId, hd->sectorData, -1, 0, 0, 0, NULL) != DSKE_OK) {
+        if (diskReadSector(hd->board, hd->diskId, hd->sectorData, -1, 0, 0, 0, NULL) != DSKE_OK) {
             setError(hd, 0x44);
             break;
         }
@@ -108,7 +109,7 @@ static void executeCommand(HarddiskIde* hd, UInt8 cmd)
         break;
 
     case 0xf8: {
-        UInt32 sectorCount = diskGetSectorsPerTrack(hd->diskId);
+        UInt32 sectorCount = diskGetSectorsPerTrack(hd->board, hd->diskId);
 	    hd->sectorNumReg    = (UInt8)((sectorCount >>  0) & 0xff);
 	    hd->cylinderLowReg  = (UInt8)((sectorCount >>  8) & 0xff);
 	    hd->cylinderHighReg = (UInt8)((sectorCount >> 16) & 0xff);
@@ -118,7 +119,7 @@ static void executeCommand(HarddiskIde* hd, UInt8 cmd)
     case 0x30: { // Write Sector
         int sectorNumber = getSectorNumber(hd);
         int numSectors = getNumSectors(hd);
-        if ((sectorNumber + numSectors) > diskGetSectorsPerTrack(hd->diskId)) {
+        if ((sectorNumber + numSectors) > diskGetSectorsPerTrack(hd->board, hd->diskId)) {
             setError(hd, 0x14);
             break;
         }
@@ -134,13 +135,13 @@ static void executeCommand(HarddiskIde* hd, UInt8 cmd)
         int numSectors = getNumSectors(hd);
         int i;
 
-        if ((sectorNumber + numSectors) > diskGetSectorsPerTrack(hd->diskId)) {
+        if ((sectorNumber + numSectors) > diskGetSectorsPerTrack(hd->board, hd->diskId)) {
             setError(hd, 0x14);
             break;
         }
           
         for (i = 0; i < numSectors; i++) {
-            if (diskReadSector(hd->diskId, hd->sectorData + i * 512, sectorNumber + i + 1, 0, 0, 0, NULL) != DSKE_OK) {
+            if (diskReadSector(hd->board, hd->diskId, hd->sectorData + i * 512, sectorNumber + i + 1, 0, 0, 0, NULL) != DSKE_OK) {
                 break;
             }
         }
@@ -178,7 +179,7 @@ UInt16 harddiskIdeRead(HarddiskIde* hd)
 {
     UInt16 value;
 
-    if (!hd->transferRead || !diskPresent(hd->diskId)) {
+    if (!hd->transferRead || !diskPresent(hd->board, hd->diskId)) {
         return 0x7f7f;
     }
 
@@ -195,7 +196,7 @@ UInt16 harddiskIdePeek(HarddiskIde* hd)
 {
     UInt16 value;
 
-    if (!hd->transferRead || !diskPresent(hd->diskId)) {
+    if (!hd->transferRead || !diskPresent(hd->board, hd->diskId)) {
         return 0x7f7f;
     }
 
@@ -207,7 +208,7 @@ UInt16 harddiskIdePeek(HarddiskIde* hd)
 
 void harddiskIdeWrite(HarddiskIde* hd, UInt16 value)
 {
-    if (!hd->transferWrite || !diskPresent(hd->diskId)) {
+    if (!hd->transferWrite || !diskPresent(hd->board, hd->diskId)) {
         return;
     }
 
@@ -215,7 +216,7 @@ void harddiskIdeWrite(HarddiskIde* hd, UInt16 value)
     hd->sectorData[hd->sectorDataOffset++] = value >> 8;
     hd->transferCount--;
     if ((hd->transferCount & 255) == 0) {
-        if (!diskWriteSector(hd->diskId, hd->sectorData, hd->transferSectorNumber + 1, 0, 0, 0)) {
+        if (!diskWriteSector(hd->board, hd->diskId, hd->sectorData, hd->transferSectorNumber + 1, 0, 0, 0)) {
             setError(hd, 0x44);
             hd->transferWrite = 0;
             return;
@@ -231,7 +232,7 @@ void harddiskIdeWrite(HarddiskIde* hd, UInt16 value)
 
 UInt8 harddiskIdeReadRegister(HarddiskIde* hd, UInt8 reg)
 {
-    if (!diskPresent(hd->diskId)) {
+    if (!diskPresent(hd->board, hd->diskId)) {
         return 0x7f;
     }
 
@@ -270,7 +271,7 @@ UInt8 harddiskIdePeekRegister(HarddiskIde* hd, UInt8 reg)
 
 void harddiskIdeWriteRegister(HarddiskIde* hd, UInt8 reg, UInt8 value)
 {
-    if (!diskPresent(hd->diskId)) {
+    if (!diskPresent(hd->board, hd->diskId)) {
         return;
     }
     switch (reg) {
@@ -300,7 +301,7 @@ void harddiskIdeWriteRegister(HarddiskIde* hd, UInt8 reg, UInt8 value)
 
 void harddiskIdeLoadState(HarddiskIde* ide)
 {
-    SaveState* state = saveStateOpenForRead("harddiskIde");
+    SaveState* state = saveStateOpenForRead(ide->board, "harddiskIde");
 
     ide->errorReg               = (UInt8)saveStateGet(state, "errorReg",        0);
     ide->sectorCountReg         = (UInt8)saveStateGet(state, "sectorCountReg",  0);
@@ -320,7 +321,7 @@ void harddiskIdeLoadState(HarddiskIde* ide)
 
 void harddiskIdeSaveState(HarddiskIde* ide)
 {
-    SaveState* state = saveStateOpenForWrite("harddiskIde");
+    SaveState* state = saveStateOpenForWrite(ide->board, "harddiskIde");
 
     saveStateSet(state, "errorReg",               ide->errorReg);
     saveStateSet(state, "sectorCountReg",         ide->sectorCountReg);
@@ -338,10 +339,11 @@ void harddiskIdeSaveState(HarddiskIde* ide)
     saveStateClose(state);
 }
 
-HarddiskIde* harddiskIdeCreate(int diskId)
+HarddiskIde* harddiskIdeCreate(BoardContext* board, int diskId)
 {
     HarddiskIde* hd = malloc(sizeof(HarddiskIde));
 
+    hd->board = board;
     hd->diskId = diskId;
     hd->transferRead = 0;
     hd->transferWrite = 0;
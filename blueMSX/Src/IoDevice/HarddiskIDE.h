@@ -32,7 +32,7 @@
 
 typedef struct HarddiskIde HarddiskIde;
 
-HarddiskIde* harddiskIdeCreate(int diskId);
+HarddiskIde* harddiskIdeCreate(BoardContext* board, int diskId);
 void harddiskIdeDestroy(HarddiskIde* hd);
 
 void harddiskIdeReset(HarddiskIde* hd);
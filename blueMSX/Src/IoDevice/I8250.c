@@ -60,6 +60,7 @@ typedef enum { I8250REG_RBR, I8250REG_THR, I8250REG_DLL, I8250REG_IER, I8250REG_
 
 struct I8250
 {
+    BoardContext* board;
     I8250Transmit transmit;
     I8250Signal   signal;
     I8250Set      setDataBits;
@@ -287,25 +288,25 @@ static void i8250CounterCreate(I8250* i8250, UInt32 frequency)
     divisor = i8250->reg[I8250REG_DLM]<<8 | i8250->reg[I8250REG_DLL];
     divisor = (divisor != 0) ? divisor : 1;
 
-    i8250->timerBaudRate = boardTimerCreate(i8250CounterOnTimer, i8250);
+    i8250->timerBaudRate = boardTimerCreate(i8250->board, i8250CounterOnTimer, i8250);
     // Fixme: start + stop + parity bit
     i8250->baudRate = (frequency/16/divisor/10);
     if (i8250->baudRate > 0) {
-        i8250->timeBaudRate = boardSystemTime() + boardFrequency() / i8250->baudRate;
+        i8250->timeBaudRate = boardSystemTime(i8250->board) + boardFrequency() / i8250->baudRate;
         boardTimerAdd(i8250->timerBaudRate, i8250->timeBaudRate);
     }
 }
 
 void i8250SaveState(I8250* uart)
 {
-    SaveState* state = saveStateOpenForWrite("i8250");
+    SaveState* state = saveStateOpenForWrite(uart->board, "i8250");
 
     saveStateClose(state);
 }
 
 void i8250LoadState(I8250* uart)
 {
-    SaveState* state = saveStateOpenForRead("i8250");
+    SaveState* state = saveStateOpenForRead(uart->board, "i8250");
 
     saveStateClose(state);
 }
@@ -327,7 +328,7 @@ void i8250Destroy(I8250* uart)
     free(uart);
 }
 
-I8250* i8250Create(UInt32 frequency, I8250Transmit transmit,    I8250Signal   signal,
+I8250* i8250Create(BoardContext* board, UInt32 frequency, I8250Transmit transmit,    I8250Signal   signal,
                    I8250Set      setDataBits, I8250Set      setStopBits,
                    I8250Set      setParity,   I8250Set      setRxReady,
                    I8250Set      setDtr,      I8250Set      setRts,
@@ -335,7 +336,8 @@ I8250* i8250Create(UInt32 frequency, I8250Transmit transmit,    I8250Signal   si
                    void* ref)
 {
     I8250* i8250 = calloc(1, sizeof(I8250));
-    
+
+    i8250->board = board;
     i8250->transmit    = transmit    ? transmit    : transmitDummy;
     i8250->signal      = signal      ? signal      : signalDummy;
     i8250->setDataBits = setDataBits ? setDataBits : setDataBitsDummy;
@@ -50,7 +50,7 @@ void i8250SaveState(I8250* i8250);
 void i8250Reset(I8250* i8250);
 void i8250Destroy(I8250* i8250); 
 
-I8250* i8250Create(UInt32 frequency, I8250Transmit transmit,    I8250Signal   signal,
+I8250* i8250Create(BoardContext* board, UInt32 frequency, I8250Transmit transmit,    I8250Signal   signal,
                    I8250Set      setDataBits, I8250Set      setStopBits,
                    I8250Set      setParity,   I8250Set      setRxReady,
                    I8250Set      setDtr,      I8250Set      setRts,
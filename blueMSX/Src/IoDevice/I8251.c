@@ -112,6 +112,7 @@ static void onRxPoll(I8251* i8251, UInt32 time);
 
 struct I8251
 {
+    BoardContext* board;
     I8251Transmit transmit;
     I8251Signal   signal;
     I8251Set      setDataBits;
@@ -249,7 +250,7 @@ static void writeCommand(I8251* i8251, UInt8 value)
 			i8251->status &= ~(STAT_PE | STAT_OE | STAT_FE);
 			i8251->recvReady = 1;
             i8251->rxPending = 0;
-            onRxPoll(i8251, boardSystemTime());
+            onRxPoll(i8251, boardSystemTime(i8251->board));
 		} 
         else {
             boardTimerRemove(i8251->timerRecv);
@@ -286,7 +287,7 @@ static void writeTrans(I8251* i8251, UInt8 value)
 	    i8251->status &= ~STAT_TXEMPTY;
 	    i8251->sendByte = value;
 
-        i8251->timeTrans = (UInt32)(boardSystemTime() + (UInt64)i8251->charLength * boardFrequency() / 4000000);
+        i8251->timeTrans = (UInt32)(boardSystemTime(i8251->board) + (UInt64)i8251->charLength * boardFrequency() / 4000000);
         boardTimerAdd(i8251->timerTrans, i8251->timeTrans);
 	} 
     else {
@@ -308,7 +309,7 @@ static void onTrans(I8251* i8251, UInt32 time)
 	    i8251->status &= ~STAT_TXEMPTY;
 	    i8251->sendByte = i8251->sendBuffer;
 
-        i8251->timeTrans = (UInt32)(boardSystemTime() + (UInt64)i8251->charLength * boardFrequency() / 4000000);
+        i8251->timeTrans = (UInt32)(boardSystemTime(i8251->board) + (UInt64)i8251->charLength * boardFrequency() / 4000000);
         boardTimerAdd(i8251->timerTrans, i8251->timeTrans);
 	}
 }
@@ -380,7 +381,7 @@ void i8251Write(I8251* i8251, UInt16 port, UInt8 value)
 
 void i8251LoadState(I8251* i8251)
 {
-    SaveState* state = saveStateOpenForRead("i8251");
+    SaveState* state = saveStateOpenForRead(i8251->board, "i8251");
     
     i8251->timeRecv      = saveStateGet(state, "timeRecv",        0);
     i8251->timeRxPoll    = saveStateGet(state, "timeRxPoll",      0);
@@ -416,7 +417,7 @@ void i8251LoadState(I8251* i8251)
 
 void i8251SaveState(I8251* i8251)
 {
-    SaveState* state = saveStateOpenForWrite("i8251");
+    SaveState* state = saveStateOpenForWrite(i8251->board, "i8251");
 
     saveStateSet(state, "timeRecv",        i8251->timeRecv);
     saveStateSet(state, "timeRxPoll",      i8251->timeRxPoll);
@@ -462,7 +463,7 @@ static void onRxPoll(I8251* i8251, UInt32 time)
     }
 
     if (i8251->rxPending == 0) {
-        i8251->timeRxPoll = (UInt32)(boardSystemTime() + (UInt64)i8251->charLength * boardFrequency() / 4000000);
+        i8251->timeRxPoll = (UInt32)(boardSystemTime(i8251->board) + (UInt64)i8251->charLength * boardFrequency() / 4000000);
         boardTimerAdd(i8251->timerRxPoll, i8251->timeRxPoll);
         return;
     }
@@ -478,7 +479,7 @@ static void onRxPoll(I8251* i8251, UInt32 time)
 	i8251->setRxReady(i8251->ref, 1);
 	i8251->recvReady = 0;
 
-    i8251->timeRecv = (UInt32)(boardSystemTime() + (UInt64)i8251->charLength * boardFrequency() / 4000000);
+    i8251->timeRecv = (UInt32)(boardSystemTime(i8251->board) + (UInt64)i8251->charLength * boardFrequency() / 4000000);
     boardTimerAdd(i8251->timerRecv, i8251->timeRecv);
 }
 
@@ -517,7 +518,7 @@ void i8251Destroy(I8251* i8251)
     free(i8251);
 }
 
-I8251* i8251Create(I8251Transmit transmit,    I8251Signal   signal,
+I8251* i8251Create(BoardContext* board, I8251Transmit transmit,    I8251Signal   signal,
                    I8251Set      setDataBits, I8251Set      setStopBits,
                    I8251Set      setParity,   I8251Set      setRxReady,
                    I8251Set      setDtr,      I8251Set      setRts,
@@ -526,6 +527,8 @@ I8251* i8251Create(I8251Transmit transmit,    I8251Signal   signal,
 {
     I8251* i8251 = calloc(1, sizeof(I8251));
     
+    i8251->board = board;
+
     i8251->transmit    = transmit    ? transmit    : transmitDummy;
     i8251->signal      = signal      ? signal      : signalDummy;
     i8251->setDataBits = setDataBits ? setDataBits : setDataBitsDummy;
@@ -539,9 +542,9 @@ I8251* i8251Create(I8251Transmit transmit,    I8251Signal   signal,
     
     i8251->ref = ref;
 
-    i8251->timerRecv   = boardTimerCreate(onRecv, i8251);
-    i8251->timerRxPoll = boardTimerCreate(onRxPoll, i8251);
-    i8251->timerTrans  = boardTimerCreate(onTrans, i8251);
+    i8251->timerRecv   = boardTimerCreate(board, onRecv, i8251);
+    i8251->timerRxPoll = boardTimerCreate(board, onRxPoll, i8251);
+    i8251->timerTrans  = boardTimerCreate(board, onTrans, i8251);
 
     i8251->semaphore = archSemaphoreCreate(1);
 
@@ -62,7 +62,7 @@ void i8251SaveState(I8251* usart);
 void i8251Reset(I8251* usart);
 void i8251Destroy(I8251* usart); 
 
-I8251* i8251Create(I8251Transmit transmit,    I8251Signal   signal,
+I8251* i8251Create(BoardContext* board, I8251Transmit transmit,    I8251Signal   signal,
                    I8251Set      setDataBits, I8251Set      setStopBits,
                    I8251Set      setParity,   I8251Set      setRxReady,
                    I8251Set      setDtr,      I8251Set      setRts,
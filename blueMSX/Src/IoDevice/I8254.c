@@ -34,6 +34,7 @@
 
 typedef struct Counter
 {
+    BoardContext* board;
     I8254Out out;
     void* ref;
 
@@ -86,7 +87,7 @@ static UInt16 counterGetElapsedTime(Counter* counter)
 {
     UInt64 elapsed;
     UInt32 elapsedTime;
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(counter->board);
 
     elapsed          = counter->frequency * (UInt64)(systemTime - counter->refTime) + counter->refFrag;
     counter->refTime = systemTime;
@@ -114,7 +115,7 @@ static void counterSetTimeout(Counter* counter)
     }
     
     if (nextTimeout != 0) {
-        counter->time = boardSystemTime() + 
+        counter->time = boardSystemTime(counter->board) + 
                       (UInt64)boardFrequency() * nextTimeout / counter->frequency;
         boardTimerAdd(counter->timer, counter->time);
     }
@@ -425,15 +426,16 @@ static void counterReset(Counter* counter)
     counter->controlWord   = 0x30;
 }
 
-static Counter* counterCreate(I8254Out out, void* ref, UInt32 frequency) 
+static Counter* counterCreate(BoardContext* board, I8254Out out, void* ref, UInt32 frequency) 
 {
     Counter* counter = calloc(1, sizeof(Counter));
 
+    counter->board = board;
     counter->frequency = frequency;
     counter->out = out;
     counter->ref = ref;
 
-    counter->timer = boardTimerCreate(counterOnTimer, counter);
+    counter->timer = boardTimerCreate(counter->board, counterOnTimer, counter);
 
     counterReset(counter);
 
@@ -448,6 +450,7 @@ static void counterDestroy(Counter* counter)
 
 struct I8254
 {
+    BoardContext* board;
     Counter* counter1;
     Counter* counter2;
     Counter* counter3;
@@ -526,7 +529,7 @@ void i8254Write(I8254* i8254, UInt16 port, UInt8 value)
 
 void i8254LoadState(I8254* i8254)
 {
-    SaveState* state = saveStateOpenForRead("i8254");
+    SaveState* state = saveStateOpenForRead(i8254->board, "i8254");
 
     i8254->counter1->time               = saveStateGet(state, "c1_time",              0);
     i8254->counter1->countingElement    = (UInt16)saveStateGet(state, "c1_countingElement",   0);
@@ -609,7 +612,7 @@ void i8254LoadState(I8254* i8254)
 
 void i8254SaveState(I8254* i8254)
 {
-    SaveState* state = saveStateOpenForWrite("i8254");
+    SaveState* state = saveStateOpenForWrite(i8254->board, "i8254");
 
     saveStateSet(state, "c1_time",              i8254->counter1->time);
     saveStateSet(state, "c1_countingElement",   i8254->counter1->countingElement);
@@ -727,13 +730,14 @@ static void outDummy(void* ref, int state)
 {
 }
 
-I8254* i8254Create(UInt32 frequency, I8254Out out1, I8254Out out2, I8254Out out3, void* ref)
+I8254* i8254Create(BoardContext* board, UInt32 frequency, I8254Out out1, I8254Out out2, I8254Out out3, void* ref)
 {
     I8254* i8254 = calloc(1, sizeof(I8254));
     
-    i8254->counter1 = counterCreate(out1 ? out1 : outDummy, ref, frequency);
-    i8254->counter2 = counterCreate(out2 ? out2 : outDummy, ref, frequency);
-    i8254->counter3 = counterCreate(out3 ? out3 : outDummy, ref, frequency);
+    i8254->board = board;
+    i8254->counter1 = counterCreate(board, out1 ? out1 : outDummy, ref, frequency);
+    i8254->counter2 = counterCreate(board, out2 ? out2 : outDummy, ref, frequency);
+    i8254->counter3 = counterCreate(board, out3 ? out3 : outDummy, ref, frequency);
 
     return i8254;
 }
@@ -785,8 +789,8 @@ static void i8254out3(void* ref, int state)
 }
 
 
-void testI8254() {
-    i8254 = i8254Create(4000000, i8254out1, i8254out2, i8254out3, 0);
+void testI8254(BoardContext* board) {
+    i8254 = i8254Create(board, 4000000, i8254out1, i8254out2, i8254out3, 0);
 
     i8254SetGate(i8254, I8254_COUNTER_1, 1);
     i8254Write(i8254, 3, 0x34);
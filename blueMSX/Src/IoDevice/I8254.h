@@ -50,6 +50,6 @@ void i8254SetGate(I8254* i8254, I8254Counter counter, int state);
 
 UInt32 i8254GetFrequency(I8254* i8254, I8254Counter counter);
 
-I8254* i8254Create(UInt32 frequency, I8254Out out1, I8254Out out2, I8254Out out3, void* ref);
+I8254* i8254Create(BoardContext* board, UInt32 frequency, I8254Out out1, I8254Out out2, I8254Out out3, void* ref);
 
 #endif
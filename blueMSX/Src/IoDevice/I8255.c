@@ -31,6 +31,7 @@
 
 struct I8255
 {
+    BoardContext* board;
     I8255Read peekA;
     I8255Read readA;
     I8255Write writeA;
@@ -57,7 +58,7 @@ static void writeDummy(void* ref, UInt8 value)
 {
 }
 
-I8255* i8255Create(I8255Read peekA,   I8255Read readA,   I8255Write writeA, 
+I8255* i8255Create(BoardContext* board, I8255Read peekA,   I8255Read readA,   I8255Write writeA, 
                    I8255Read peekB,   I8255Read readB,   I8255Write writeB,
                    I8255Read peekCLo, I8255Read readCLo, I8255Write writeCLo,
                    I8255Read peekCHi, I8255Read readCHi, I8255Write writeCHi,
@@ -65,6 +66,7 @@ I8255* i8255Create(I8255Read peekA,   I8255Read readA,   I8255Write writeA,
 {
     I8255* i8255 = calloc(1, sizeof(I8255));
 
+    i8255->board = board;
     i8255->peekA    = peekA    ? peekA    : readDummy;
     i8255->readA    = readA    ? readA    : readDummy;
     i8255->writeA   = writeA   ? writeA   : writeDummy;
@@ -98,7 +100,7 @@ void i8255Destroy(I8255* i8255)
 
 void i8255LoadState(I8255* i8255)
 {
-    SaveState* state = saveStateOpenForRead("i8255");
+    SaveState* state = saveStateOpenForRead(i8255->board, "i8255");
 
     i8255->reg[0] = (UInt8)saveStateGet(state, "reg00", 0);
     i8255->reg[1] = (UInt8)saveStateGet(state, "reg01", 0);
@@ -110,7 +112,7 @@ void i8255LoadState(I8255* i8255)
 
 void i8255SaveState(I8255* i8255)
 {
-    SaveState* state = saveStateOpenForWrite("i8255");
+    SaveState* state = saveStateOpenForWrite(i8255->board, "i8255");
     
     saveStateSet(state, "reg00", i8255->reg[0]);
     saveStateSet(state, "reg01", i8255->reg[1]);
@@ -336,6 +338,7 @@ void i8255Write(I8255* i8255, UInt16 port, UInt8 value)
 
 struct I8255
 {
+    BoardContext* board;
     I8255Read peekA;
     I8255Read readA;
     I8255Write writeA;
@@ -383,7 +386,7 @@ static void writeDummy(void* ref, UInt8 value)
 {
 }
 
-I8255* i8255Create(I8255Read peekA,   I8255Read readA,   I8255Write writeA, 
+I8255* i8255Create(BoardContext* board, I8255Read peekA,   I8255Read readA,   I8255Write writeA, 
                    I8255Read peekB,   I8255Read readB,   I8255Write writeB,
                    I8255Read peekCLo, I8255Read readCLo, I8255Write writeCLo,
                    I8255Read peekCHi, I8255Read readCHi, I8255Write writeCHi,
@@ -391,6 +394,7 @@ I8255* i8255Create(I8255Read peekA,   I8255Read readA,   I8255Write writeA,
 {
     I8255* i8255 = calloc(1, sizeof(I8255));
 
+    i8255->board = board;
     i8255->peekA    = peekA    ? peekA    : readLatchA;
     i8255->readA    = readA    ? readA    : readLatchA;
     i8255->writeA   = writeA   ? writeA   : writeDummy;
@@ -430,7 +434,7 @@ void i8255Destroy(I8255* i8255)
 
 void i8255LoadState(I8255* i8255)
 {
-    SaveState* state = saveStateOpenForRead("i8255");
+    SaveState* state = saveStateOpenForRead(i8255->board, "i8255");
 
     i8255->reg[0] = (UInt8)saveStateGet(state, "reg00", 0);
     i8255->reg[1] = (UInt8)saveStateGet(state, "reg01", 0);
@@ -442,7 +446,7 @@ void i8255LoadState(I8255* i8255)
 
 void i8255SaveState(I8255* i8255)
 {
-    SaveState* state = saveStateOpenForWrite("i8255");
+    SaveState* state = saveStateOpenForWrite(i8255->board, "i8255");
     
     saveStateSet(state, "reg00", i8255->reg[0]);
     saveStateSet(state, "reg01", i8255->reg[1]);
@@ -35,7 +35,7 @@ typedef struct I8255 I8255;
 typedef void  (*I8255Write)(void*, UInt8);
 typedef UInt8 (*I8255Read) (void*);
 
-I8255* i8255Create(I8255Read peekA,   I8255Read readA,   I8255Write writeA, 
+I8255* i8255Create(BoardContext* board, I8255Read peekA,   I8255Read readA,   I8255Write writeA, 
                    I8255Read peekB,   I8255Read readB,   I8255Write writeB,
                    I8255Read peekCLo, I8255Read readCLo, I8255Write writeCLo,
                    I8255Read peekCHi, I8255Read readCHi, I8255Write writeCHi,
@@ -90,7 +90,7 @@ typedef struct I8255 I8255;
 typedef void  (*I8255Write)(void*, UInt8);
 typedef UInt8 (*I8255Read) (void*);
 
-I8255* i8255Create(I8255Read peekA,   I8255Read readA,   I8255Write writeA, 
+I8255* i8255Create(BoardContext* board, I8255Read peekA,   I8255Read readA,   I8255Write writeA, 
                    I8255Read peekB,   I8255Read readB,   I8255Write writeB,
                    I8255Read peekCLo, I8255Read readCLo, I8255Write writeCLo,
                    I8255Read peekCHi, I8255Read readCHi, I8255Write writeCHi,
@@ -76,6 +76,7 @@ UInt8 colecoJoystickRead(ColecoJoystick* colecoJoystick)
 
 
 struct JoystickIO {
+    BoardContext* board;
     AY8910* ay8910;
     struct {
         JoystickIoType type;
@@ -110,7 +111,7 @@ static void joystickCheckType(JoystickIO* joyIO) {
 
 static UInt8 read(JoystickIO* joyIO, UInt16 address) 
 {
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(joyIO->board);
     UInt8 value;
     int joyId;
 
@@ -197,7 +198,7 @@ static UInt8 poll(JoystickIO* joyIO, UInt16 address)
 
 static void write(JoystickIO* joyIO, UInt16 address, UInt8 value) 
 {
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(joyIO->board);
 
     if (address & 1) {
         joystickCheckType(joyIO);
@@ -276,12 +277,13 @@ static void write(JoystickIO* joyIO, UInt16 address, UInt8 value)
     joyIO->registers[address & 1] = value;
 }
 
-JoystickIO* joystickIoCreate(AY8910* ay8910)
+JoystickIO* joystickIoCreate(BoardContext* board, AY8910* ay8910)
 {
     JoystickIO* joyIO;
     int buttons = archMouseGetButtonState(1);
 
     joyIO = calloc(1, sizeof(JoystickIO));
+    joyIO->board = board;
 
     joyIO->ay8910 = ay8910;
     joyIO->mouseAsJoystick = buttons & 1;
@@ -312,7 +314,7 @@ JoystickIoType joystickIoGetType(int port, int* userData) {
 
 void joystickIoSaveState(JoystickIO* joyIO)
 {
-    SaveState* state = saveStateOpenForWrite("joystickIo");
+    SaveState* state = saveStateOpenForWrite(joyIO->board, "joystickIo");
 
     joyIO->data[0] = joyTypeConfigured[0];
     joyIO->data[1] = joyTypeConfigured[1];
@@ -345,7 +347,7 @@ void joystickIoSaveState(JoystickIO* joyIO)
 
 void joystickIoLoadState(JoystickIO* joyIO)
 {
-    SaveState* state = saveStateOpenForRead("joystickIo");
+    SaveState* state = saveStateOpenForRead(joyIO->board, "joystickIo");
 
     joyIO->controls[0].type     =        saveStateGet(state, "ctrlType00",      0);
     joyIO->controls[0].buttons  = (UInt8)saveStateGet(state, "ctrlButtons00",   0);
@@ -378,12 +380,13 @@ void joystickIoLoadState(JoystickIO* joyIO)
     ledSetKana(0 == (joyIO->registers[1] & 0x80));
 }
 
-JoystickIO* joystickIoCreateSVI(void)
+JoystickIO* joystickIoCreateSVI(BoardContext* board)
 {
     JoystickIO* joyIO;
     int buttons = archMouseGetButtonState(1);
 
     joyIO = calloc(1, sizeof(JoystickIO));
+    joyIO->board = board;
 
     joyIO->mouseAsJoystick = buttons & 1;
 
@@ -432,12 +435,13 @@ UInt8 joystickReadTriggerSVI(JoystickIO* joyIO)
 	return value;
 }
 
-JoystickIO* joystickIoCreateColeco(void)
+JoystickIO* joystickIoCreateColeco(BoardContext* board)
 {
     JoystickIO* joyIO;
     int buttons = archMouseGetButtonState(1);
 
     joyIO = calloc(1, sizeof(JoystickIO));
+    joyIO->board = board;
 
     joyIO->mouseAsJoystick = buttons & 1;
 
@@ -465,12 +469,13 @@ UInt8 joystickPollColeco(JoystickIO* joyIO, int port)
     return rv;
 }
 
-JoystickIO* joystickIoCreateSG1000(void)
+JoystickIO* joystickIoCreateSG1000(BoardContext* board)
 {
     JoystickIO* joyIO;
     int buttons = archMouseGetButtonState(1);
 
     joyIO = calloc(1, sizeof(JoystickIO));
+    joyIO->board = board;
 
     joyIO->mouseAsJoystick = buttons & 1;
 
@@ -42,7 +42,7 @@ typedef enum {
 
 typedef struct JoystickIO JoystickIO;
 
-JoystickIO* joystickIoCreate(AY8910* ay8910);
+JoystickIO* joystickIoCreate(BoardContext* board, AY8910* ay8910);
 void joystickIoDestroy(JoystickIO* joyIO);
 
 void joystickIoLoadState(JoystickIO* joyIO);
@@ -51,18 +51,18 @@ void joystickIoSaveState(JoystickIO* joyIO);
 void joystickIoSetType(int port, JoystickIoType type, int userData);
 JoystickIoType joystickIoGetType(int port, int* userData);
 
-JoystickIO* joystickIoCreateSVI(void);
+JoystickIO* joystickIoCreateSVI(BoardContext* board);
 void joystickIoDestroySVI(JoystickIO* joyIO);
 UInt8 joystickReadSVI(JoystickIO* joyIO);
 UInt8 joystickPollSVI(JoystickIO* joyIO);
 UInt8 joystickReadTriggerSVI(JoystickIO* joyIO);
 
-JoystickIO* joystickIoCreateColeco(void);
+JoystickIO* joystickIoCreateColeco(BoardContext* board);
 void joystickIoDestroyColeco(JoystickIO* joyIO);
 UInt8 joystickReadColeco(JoystickIO* joyIO, int port);
 UInt8 joystickPollColeco(JoystickIO* joyIO, int port);
 
-JoystickIO* joystickIoCreateSG1000(void);
+JoystickIO* joystickIoCreateSG1000(BoardContext* board);
 void joystickIoDestroySG1000(JoystickIO* joyIO);
 UInt8 joystickReadSG1000(JoystickIO* joyIO, int port);
 UInt8 joystickPollSG1000(JoystickIO* joyIO, int port);
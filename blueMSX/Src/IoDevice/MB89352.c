@@ -108,6 +108,7 @@
 #define CMD_Set_ACK_REQ     7
 
 struct MB89352 {
+    BoardContext* board;
     Int32 debugHandle;
     int myId;                       // SPC SCSI ID 0..7
     int targetId;                   // SCSI Device target ID 0..7
@@ -830,7 +831,7 @@ void mb89352SaveState(MB89352* spc)
     char tag[8];
     int i;
 
-    SaveState* state = saveStateOpenForWrite("mb89352");
+    SaveState* state = saveStateOpenForWrite(spc->board, "mb89352");
     SCSILOG("Save state\n");
 
     saveStateSet(state, "myId",         spc->myId);
@@ -870,7 +871,7 @@ void mb89352LoadState(MB89352* spc)
     char tag[8];
     int i;
 
-    SaveState* state = saveStateOpenForRead("mb89352");
+    SaveState* state = saveStateOpenForRead(spc->board, "mb89352");
     SCSILOG("Load state\n");
 
     spc->myId           = saveStateGet(state, "myId", 7);
@@ -942,7 +943,7 @@ void mb89352Destroy(MB89352* spc)
     }
 
 #ifdef USE_DEBUGGER
-    debugDeviceUnregister(spc->debugHandle);
+    debugDeviceUnregister(spc->board, spc->debugHandle);
 #endif
 
     archCdromBufferFree(spc->buffer);
@@ -950,7 +951,7 @@ void mb89352Destroy(MB89352* spc)
     SCSILOG("spc destroy\n");
     scsiDeviceLogClose();}
 
-MB89352* mb89352Create(int hdId)
+MB89352* mb89352Create(BoardContext* board, int hdId)
 {
     int i;
     int diskId;
@@ -960,19 +961,20 @@ MB89352* mb89352Create(int hdId)
     scsiLog = scsiDeviceLogCreate();
     SCSILOG("spc create\n");
     spc = malloc(sizeof(MB89352));
+    spc->board = board;
     spc->buffer  = archCdromBufferMalloc(BUFFER_SIZE);
     spc->devBusy = 0;
 
 #ifdef USE_DEBUGGER
     DebugCallbacks dbgCallbacks = { (void*)mb89352GetDebugInfo, NULL, NULL, NULL };
     spc->debugHandle =
-        debugDeviceRegister(DBGTYPE_PORT, "MB89352 SPC", &dbgCallbacks, spc);
+        debugDeviceRegister(board, DBGTYPE_PORT, "MB89352 SPC", &dbgCallbacks, spc);
 #endif
 
     // this SCSI creating parameter is for MEGA-SCSI
     for (i = 0; i < 8; i++) {
         diskId = diskGetHdDriveId(hdId, i);
-        if (diskIsCdrom(diskId)) {
+        if (diskIsCdrom(board, diskId)) {
             deviceType = SDT_CDROM;
             scsiMode   = MODE_SCSI2 | MODE_UNITATTENTION | MODE_REMOVABLE;
         }
@@ -985,7 +987,7 @@ MB89352* mb89352Create(int hdId)
 #endif
         }
         spc->scsiDevice[i] =
-            scsiDeviceCreate(i, diskId, spc->buffer, NULL, deviceType,
+            scsiDeviceCreate(board, i, diskId, spc->buffer, NULL, deviceType,
                              scsiMode, (CdromXferCompCb)mb89352XferCb, spc);
     }
 
@@ -32,7 +32,7 @@
 
 typedef struct MB89352 MB89352;
 
-MB89352* mb89352Create(int hdId);
+MB89352* mb89352Create(BoardContext* board, int hdId);
 void mb89352Destroy(MB89352* spc);
 void mb89352Reset(MB89352* spc, int scsireset);
 void mb89352SaveState(MB89352* spc);
@@ -42,6 +42,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     MidiIO* midiIo;
@@ -71,7 +72,7 @@ static void unregisterIoPorts(MSXMidi* msxMidi);
 */
 static void saveState(MSXMidi* msxMidi)
 {
-    SaveState* state = saveStateOpenForWrite("MSXMidi");
+    SaveState* state = saveStateOpenForWrite(msxMidi->board, "MSXMidi");
     
     saveStateSet(state, "timerIRQlatch",    msxMidi->timerIRQlatch);
     saveStateSet(state, "timerIRQenabled",  msxMidi->timerIRQenabled);
@@ -89,7 +90,7 @@ static void saveState(MSXMidi* msxMidi)
 
 static void loadState(MSXMidi* msxMidi)
 {
-    SaveState* state = saveStateOpenForRead("MSXMidi");
+    SaveState* state = saveStateOpenForRead(msxMidi->board, "MSXMidi");
 
     msxMidi->timerIRQlatch   = saveStateGet(state, "timerIRQlatch",    0);
     msxMidi->timerIRQenabled = saveStateGet(state, "timerIRQenabled",  0);
@@ -107,7 +108,7 @@ static void loadState(MSXMidi* msxMidi)
 
 static void destroy(MSXMidi* msxMidi)
 {
-    ioPortUnregister(0xe2);
+    ioPortUnregister(msxMidi->board, 0xe2);
     unregisterIoPorts(msxMidi);
 
     midiIoDestroy(msxMidi->midiIo);
@@ -115,16 +116,16 @@ static void destroy(MSXMidi* msxMidi)
     i8251Destroy(msxMidi->i8251);
     i8254Destroy(msxMidi->i8254);
 
-    deviceManagerUnregister(msxMidi->deviceHandle);
-    debugDeviceUnregister(msxMidi->debugHandle);
+    deviceManagerUnregister(msxMidi->board, msxMidi->deviceHandle);
+    debugDeviceUnregister(msxMidi->board, msxMidi->debugHandle);
 
     free(msxMidi);
 }
 
 static void reset(MSXMidi* msxMidi) 
 {
-    boardClearInt(INT_TMR);
-    boardClearInt(INT_RXRDY);
+    boardClearInt(msxMidi->board, INT_TMR);
+    boardClearInt(msxMidi->board, INT_RXRDY);
 
 	msxMidi->timerIRQlatch   = 0;
 	msxMidi->timerIRQenabled = 0;
@@ -146,10 +147,10 @@ static void setTimerIRQ(MSXMidi* msxMidi, int status)
 		msxMidi->timerIRQlatch = status;
 		if (msxMidi->timerIRQenabled) {
 			if (msxMidi->timerIRQlatch) {
-                boardSetInt(INT_TMR);
+                boardSetInt(msxMidi->board, INT_TMR);
 			} 
             else {
-                boardClearInt(INT_TMR);
+                boardClearInt(msxMidi->board, INT_TMR);
 			}
 		}
 
@@ -163,10 +164,10 @@ static void enableTimerIRQ(MSXMidi* msxMidi, int enabled)
 		msxMidi->timerIRQenabled = enabled;
 		if (msxMidi->timerIRQlatch) {
 			if (msxMidi->timerIRQenabled) {
-                boardSetInt(INT_TMR);
+                boardSetInt(msxMidi->board, INT_TMR);
 			} 
             else {
-                boardClearInt(INT_TMR);
+                boardClearInt(msxMidi->board, INT_TMR);
 			}
 		}
         i8254SetGate(msxMidi->i8254, 2, msxMidi->timerIRQenabled && !msxMidi->timerIRQlatch);
@@ -179,10 +180,10 @@ static void setRxRDYIRQ(MSXMidi* msxMidi, int status)
 		msxMidi->rxrdyIRQlatch = status;
 		if (msxMidi->rxrdyIRQenabled) {
 			if (msxMidi->rxrdyIRQlatch) {
-                boardSetInt(INT_RXRDY);
+                boardSetInt(msxMidi->board, INT_RXRDY);
 			}
             else {
-                boardClearInt(INT_RXRDY);
+                boardClearInt(msxMidi->board, INT_RXRDY);
 			}
 		}
 	}
@@ -193,7 +194,7 @@ static void enableRxRDYIRQ(MSXMidi* msxMidi, int enabled)
 	if (msxMidi->rxrdyIRQenabled != enabled) {
 		msxMidi->rxrdyIRQenabled = enabled;
 		if (!msxMidi->rxrdyIRQenabled && msxMidi->rxrdyIRQlatch) {
-            boardClearInt(INT_RXRDY);
+            boardClearInt(msxMidi->board, INT_RXRDY);
 		}
 	}
 }
@@ -242,7 +243,7 @@ static void setRts(MSXMidi* msxMidi, int status)
 
 static int getDtr(MSXMidi* msxMidi)
 {
-    return boardGetInt(INT_TMR) ? 1 : 0;
+    return boardGetInt(msxMidi->board, INT_TMR) ? 1 : 0;
 }
 
 static int getRts(MSXMidi* msxMidi)
@@ -279,7 +280,7 @@ static void unregisterIoPorts(MSXMidi* msxMidi) {
     }
     
     for (i = 0; i < (msxMidi->ioStart == 0xe0 ? 2 : 8); i++) {
-        ioPortUnregister(msxMidi->ioStart + i);
+        ioPortUnregister(msxMidi->board, msxMidi->ioStart + i);
     }
 
     msxMidi->ioStart = 0;
@@ -300,7 +301,7 @@ static void registerIoPorts(MSXMidi* msxMidi, int ioStart) {
 
     i = msxMidi->ioStart == 0xe0 ? 2 : 8;
     while (i--) {
-        ioPortRegister(ioStart + i, readIo, writeIo, msxMidi);
+        ioPortRegister(msxMidi->board, ioStart + i, readIo, writeIo, msxMidi);
     }
 }
 
@@ -417,25 +418,26 @@ static void midiInCallback(MSXMidi* msxMidi, UInt8* buffer, UInt32 length)
 ** MSX MIDI Create Method
 ******************************************
 */
-int MSXMidiCreate(int isExternal)
+int MSXMidiCreate(BoardContext* board, int isExternal)
 {
     DeviceCallbacks callbacks = {destroy, reset, saveState, loadState};
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     MSXMidi* msxMidi;
 
     msxMidi = malloc(sizeof(MSXMidi));
+    msxMidi->board = board;
     
     msxMidi->ioStart = 0;
-    msxMidi->deviceHandle = deviceManagerRegister(isExternal ? ROM_MSXMIDI_EXTERNAL : ROM_MSXMIDI, &callbacks, msxMidi);
-    msxMidi->debugHandle = debugDeviceRegister(DBGTYPE_AUDIO, langDbgDevMsxMidi(), &dbgCallbacks, msxMidi);
+    msxMidi->deviceHandle = deviceManagerRegister(board, isExternal ? ROM_MSXMIDI_EXTERNAL : ROM_MSXMIDI, &callbacks, msxMidi);
+    msxMidi->debugHandle = debugDeviceRegister(board, DBGTYPE_AUDIO, langDbgDevMsxMidi(), &dbgCallbacks, msxMidi);
 
-    msxMidi->i8254 = i8254Create(4000000, pitOut0, pitOut1, pitOut2, msxMidi);
-    msxMidi->i8251 = i8251Create(transmit, signal8251, setDataBits, setStopBits, setParity, 
+    msxMidi->i8254 = i8254Create(board, 4000000, pitOut0, pitOut1, pitOut2, msxMidi);
+    msxMidi->i8251 = i8251Create(board, transmit, signal8251, setDataBits, setStopBits, setParity, 
                                  setRxReady, setDtr, setRts, getDtr, getRts, msxMidi);
     msxMidi->isExternal = isExternal;
 
     if (isExternal) {
-        ioPortRegister(0xe2, NULL, writeIo, msxMidi);
+        ioPortRegister(board, 0xe2, NULL, writeIo, msxMidi);
     }
     else {
         registerIoPorts(msxMidi, 0xe8);
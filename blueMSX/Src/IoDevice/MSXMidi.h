@@ -31,6 +31,6 @@
 
 #include "MsxTypes.h"
 
-int MSXMidiCreate(int isExternal);
+int MSXMidiCreate(BoardContext* board, int isExternal);
 
 #endif
@@ -34,6 +34,7 @@
 
 typedef struct Microchip24x00
 {
+    BoardContext* board;
     UInt8* romData;
     int    romMask;
     int    addressSize;
@@ -151,11 +152,12 @@ static void onTimer(Microchip24x00* rm, UInt32 time)
     rm->isWriting = 0;
 }
 
-Microchip24x00* microchip24x00Create(MicroshipDeviceType deviceType, const char* sramFilename)
+Microchip24x00* microchip24x00Create(BoardContext* board, MicroshipDeviceType deviceType, const char* sramFilename)
 {
     int size = getSize(deviceType);
     Microchip24x00* rm = calloc(1, sizeof(Microchip24x00));
 
+    rm->board = board;
     rm->deviceType = deviceType;
     rm->addressSize = getAddressSize(deviceType);
     rm->writeBufferMask = getWriteBufferSize(deviceType) - 1;
@@ -170,7 +172,7 @@ Microchip24x00* microchip24x00Create(MicroshipDeviceType deviceType, const char*
         sramLoad(rm->sramFilename, rm->romData, rm->romMask + 1, NULL, 0);
     }
 
-    rm->timer = boardTimerCreate(onTimer, rm);
+    rm->timer = boardTimerCreate(rm->board, onTimer, rm);
 
     microchip24x00Reset(rm);
 
@@ -205,7 +207,7 @@ void microchip24x00Reset(Microchip24x00* rm)
 
 void microchip24x00SaveState(Microchip24x00* rm)
 {
-    SaveState* state = saveStateOpenForWrite("Microchip24x00");
+    SaveState* state = saveStateOpenForWrite(rm->board, "Microchip24x00");
 
     saveStateSet(state, "scl",           rm->scl);
     saveStateSet(state, "sda",           rm->sda);
@@ -226,7 +228,7 @@ void microchip24x00SaveState(Microchip24x00* rm)
 
 void microchip24x00LoadState(Microchip24x00* rm)
 {
-    SaveState* state = saveStateOpenForRead("Microchip24x00");
+    SaveState* state = saveStateOpenForRead(rm->board, "Microchip24x00");
 
     rm->scl             = saveStateGet(state, "scl",             0);
     rm->sda             = saveStateGet(state, "sda",             0);
@@ -348,7 +350,7 @@ void microchip24x00SetSda(Microchip24x00* rm, int value)
                     ((rm->address + 1) & rm->writeBufferMask)) & rm->romMask;
             }
             if (rm->writeCounter > 0) {
-                rm->timeWriting = boardSystemTime() + boardFrequency() * 3 / 1000;
+                rm->timeWriting = boardSystemTime(rm->board) + boardFrequency() * 3 / 1000;
                 boardTimerAdd(rm->timer, rm->timeWriting);
                 rm->isWriting = 1;
             }
@@ -47,7 +47,7 @@ typedef enum {
     M24xx64
 } MicroshipDeviceType;
 
-Microchip24x00* microchip24x00Create(MicroshipDeviceType deviceType, const char* sramFilename);
+Microchip24x00* microchip24x00Create(BoardContext* board, MicroshipDeviceType deviceType, const char* sramFilename);
 void microchip24x00Destroy(Microchip24x00* rm);
 
 void microchip24x00Reset(Microchip24x00* rm);
@@ -36,6 +36,7 @@
 
 typedef struct Microwire93Cx6
 {
+    BoardContext* board;
     UInt8* romData;
     int    romMask;
     int    modeX8;
@@ -98,10 +99,12 @@ static void onTimer(Microwire93Cx6* rm, UInt32 time)
     }
 }
 
-Microwire93Cx6* microwire93Cx6Create(int size, int mode, void* imgData, int imgSize, const char* sramFilename)
+Microwire93Cx6* microwire93Cx6Create(BoardContext* board, int size, int mode, void* imgData, int imgSize, const char* sramFilename)
 {
     Microwire93Cx6* rm = calloc(1, sizeof(Microwire93Cx6));
 
+    rm->board = board;
+
     if (sramFilename != NULL) {
         strcpy(rm->sramFilename, sramFilename);
     }
@@ -122,7 +125,7 @@ Microwire93Cx6* microwire93Cx6Create(int size, int mode, void* imgData, int imgS
     // Set mode (8/16 bit)
     rm->modeX8 = mode == 16 ? 0 : 1;
 
-    rm->timer = boardTimerCreate(onTimer, rm);
+    rm->timer = boardTimerCreate(rm->board, onTimer, rm);
 
     microwire93Cx6Reset(rm);
 
@@ -153,7 +156,7 @@ void microwire93Cx6Reset(Microwire93Cx6* rm)
 
 void microwire93Cx6SaveState(Microwire93Cx6* rm)
 {
-    SaveState* state = saveStateOpenForWrite("Microwire93Cx6");
+    SaveState* state = saveStateOpenForWrite(rm->board, "Microwire93Cx6");
 
     saveStateSet(state, "phase",        rm->phase);
     saveStateSet(state, "command",      rm->command);
@@ -171,7 +174,7 @@ void microwire93Cx6SaveState(Microwire93Cx6* rm)
 
 void microwire93Cx6LoadState(Microwire93Cx6* rm)
 {
-    SaveState* state = saveStateOpenForRead("Microwire93Cx6");
+    SaveState* state = saveStateOpenForRead(rm->board, "Microwire93Cx6");
 
     rm->phase           = saveStateGet(state, "phase",        PHASE_IDLE);
     rm->command         = saveStateGet(state, "command",      0);
@@ -263,7 +266,7 @@ void microwire93Cx6SetClk(Microwire93Cx6* rm, int value)
                 if (rm->programEnable) {
                     memset(rm->romData, 0xff, rm->romMask + 1);
                     rm->Do = 0;
-                    boardTimerAdd(rm->timer, boardSystemTime() + boardFrequency() * 8 / 1000);
+                    boardTimerAdd(rm->timer, boardSystemTime(rm->board) + boardFrequency() * 8 / 1000);
                     rm->phase = PHASE_PROGRAMMING;
                 }
                 else {
@@ -295,7 +298,7 @@ void microwire93Cx6SetClk(Microwire93Cx6* rm, int value)
             if (rm->programEnable) {
                 romWrite(rm, rm->command, 0xffff);
                 rm->Do = 0;
-                boardTimerAdd(rm->timer, boardSystemTime() + boardFrequency() * 3 / 1000);
+                boardTimerAdd(rm->timer, boardSystemTime(rm->board) + boardFrequency() * 3 / 1000);
                 rm->phase = PHASE_PROGRAMMING;
             }
             else {
@@ -321,7 +324,7 @@ void microwire93Cx6SetClk(Microwire93Cx6* rm, int value)
                             romWrite(rm, i, rm->value);
                         }
                         rm->Do = 0;
-                        boardTimerAdd(rm->timer, boardSystemTime() + boardFrequency() * 16 / 1000);
+                        boardTimerAdd(rm->timer, boardSystemTime(rm->board) + boardFrequency() * 16 / 1000);
                         rm->phase = PHASE_PROGRAMMING;
                     }
                     else {
@@ -339,7 +342,7 @@ void microwire93Cx6SetClk(Microwire93Cx6* rm, int value)
                 if (rm->programEnable) {
                     romWrite(rm, rm->command, rm->value);
                     rm->Do = 0;
-                    boardTimerAdd(rm->timer, boardSystemTime() + boardFrequency() * 3 / 1000);
+                    boardTimerAdd(rm->timer, boardSystemTime(rm->board) + boardFrequency() * 3 / 1000);
                     rm->phase = PHASE_PROGRAMMING;
                 }
                 else {
@@ -49,6 +49,7 @@ static UInt8 getKeyState(int row);
 
 
 typedef struct {
+    BoardContext* board;
     int    deviceHandle;
     int    debugHandle;
     I8255* i8255;
@@ -63,14 +64,14 @@ typedef struct {
 
 static void destroy(MsxPPI* ppi)
 {
-    ioPortUnregister(0xa8);
-    ioPortUnregister(0xa9);
-    ioPortUnregister(0xaa);
-    ioPortUnregister(0xab);
+    ioPortUnregister(ppi->board, 0xa8);
+    ioPortUnregister(ppi->board, 0xa9);
+    ioPortUnregister(ppi->board, 0xaa);
+    ioPortUnregister(ppi->board, 0xab);
 
     audioKeyClickDestroy(ppi->keyClick);
-    deviceManagerUnregister(ppi->deviceHandle);
-    debugDeviceUnregister(ppi->debugHandle);
+    deviceManagerUnregister(ppi->board, ppi->deviceHandle);
+    debugDeviceUnregister(ppi->board, ppi->debugHandle);
 
     dacDestroy(ppi->dac);
 
@@ -90,7 +91,7 @@ static void reset(MsxPPI* ppi)
 
 static void loadState(MsxPPI* ppi)
 {
-    SaveState* state = saveStateOpenForRead("MsxPPI");
+    SaveState* state = saveStateOpenForRead(ppi->board, "MsxPPI");
 
     ppi->row    = (UInt8)saveStateGet(state, "row", 0);
     ppi->regA   =        saveStateGet(state, "regA", -1);
@@ -103,7 +104,7 @@ static void loadState(MsxPPI* ppi)
 
 static void saveState(MsxPPI* ppi)
 {
-    SaveState* state = saveStateOpenForWrite("MsxPPI");
+    SaveState* state = saveStateOpenForWrite(ppi->board, "MsxPPI");
     
     saveStateSet(state, "row", ppi->row);
     saveStateSet(state, "regA", ppi->regA);
@@ -122,7 +123,7 @@ static void writeA(MsxPPI* ppi, UInt8 value)
         ppi->regA = value;
 
         for (i = 0; i < 4; i++) {
-            slotSetRamSlot(i, value & 3);
+            slotSetRamSlot(ppi->board, i, value & 3);
             value >>= 2;
         }
     }
@@ -151,7 +152,7 @@ static UInt8 peekB(MsxPPI* ppi)
     if (ppi->row == 8) {
         int renshaSpeed = switchGetRensha();
         if (renshaSpeed) {
-            UInt8 renshaOn = (UInt8)((UInt64)renshaSpeed * boardSystemTime() / boardFrequency());
+            UInt8 renshaOn = (UInt8)((UInt64)renshaSpeed * boardSystemTime(ppi->board) / boardFrequency());
             value |= (renshaOn & 1);
         }
     }
@@ -161,12 +162,12 @@ static UInt8 peekB(MsxPPI* ppi)
 
 static UInt8 readB(MsxPPI* ppi)
 {
-    UInt8 value = boardCaptureUInt8(ppi->row, getKeyState(ppi->row));
+    UInt8 value = boardCaptureUInt8(ppi->board, ppi->row, getKeyState(ppi->row));
 
     if (ppi->row == 8) {
         int renshaSpeed = switchGetRensha();
         if (renshaSpeed) {
-            UInt8 renshaOn = (UInt8)((UInt64)renshaSpeed * boardSystemTime() / boardFrequency());
+            UInt8 renshaOn = (UInt8)((UInt64)renshaSpeed * boardSystemTime(ppi->board) / boardFrequency());
             ledSetRensha(renshaSpeed > 14 ? 1 : renshaOn & 2);
             value |= (renshaOn & 1);
         }
@@ -189,37 +190,39 @@ static void getDebugInfo(MsxPPI* ppi, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 3, 0xab, DBG_IO_READWRITE, i8255Peek(ppi->i8255, 0xab));
 }
 
-void msxPPICreate(int ignoreKeyboard)
+void msxPPICreate(BoardContext* board, int ignoreKeyboard)
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     MsxPPI* ppi = malloc(sizeof(MsxPPI));
 
-    ppi->deviceHandle = deviceManagerRegister(RAM_MAPPER, &callbacks, ppi);
-    ppi->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, langDbgDevPpi(), &dbgCallbacks, ppi);
+    ppi->board = board;
+
+    ppi->deviceHandle = deviceManagerRegister(board, RAM_MAPPER, &callbacks, ppi);
+    ppi->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, langDbgDevPpi(), &dbgCallbacks, ppi);
 
     if (ignoreKeyboard) {
-        ppi->i8255 = i8255Create(NULL,  NULL,  writeA,
+        ppi->i8255 = i8255Create(board, NULL,  NULL,  writeA,
                                  NULL,  NULL,  NULL,
                                  NULL,  NULL,  writeCLo,
                                  NULL,  NULL,  writeCHi,
                                  ppi);
     }
     else {
-        ppi->i8255 = i8255Create(NULL,  NULL,  writeA,
+        ppi->i8255 = i8255Create(board, NULL,  NULL,  writeA,
                                  peekB, readB, NULL,
                                  NULL,  NULL,  writeCLo,
                                  NULL,  NULL,  writeCHi,
                                  ppi);
     }
-    ppi->keyClick = audioKeyClickCreate(boardGetMixer());
+    ppi->keyClick = audioKeyClickCreate(boardGetMixer(board));
 
-    ppi->dac = dacCreate(boardGetMixer(), DAC_MONO);
+    ppi->dac = dacCreate(boardGetMixer(board), DAC_MONO);
 
-    ioPortRegister(0xa8, i8255Read, i8255Write, ppi->i8255);
-    ioPortRegister(0xa9, i8255Read, i8255Write, ppi->i8255);
-    ioPortRegister(0xaa, i8255Read, i8255Write, ppi->i8255);
-    ioPortRegister(0xab, i8255Read, i8255Write, ppi->i8255);
+    ioPortRegister(board, 0xa8, i8255Read, i8255Write, ppi->i8255);
+    ioPortRegister(board, 0xa9, i8255Read, i8255Write, ppi->i8255);
+    ioPortRegister(board, 0xaa, i8255Read, i8255Write, ppi->i8255);
+    ioPortRegister(board, 0xab, i8255Read, i8255Write, ppi->i8255);
 
     reset(ppi);
 }
@@ -30,7 +30,7 @@
 
 #include "MsxTypes.h"
 
-void msxPPICreate(int ignoreKeyboard);
+void msxPPICreate(BoardContext* board, int ignoreKeyboard);
 
 #endif
 
@@ -38,6 +38,7 @@
 extern int diskOffset;
 
 struct NEC765 {
+    BoardContext* board;
     UInt8 drive;
 
     UInt8 mainStatus;
@@ -335,16 +336,16 @@ static void nec765CommandPhaseWrite(NEC765* fdc, UInt8 value)
         case 1:
             fdc->drive = value & 0x03;
             fdc->side = (value >> 2)& 1;
-            fdc->sectorSize = diskGetSectorSize(fdc->drive, fdc->side, fdc->currentTrack, 0);
+            fdc->sectorSize = diskGetSectorSize(fdc->board, fdc->drive, fdc->side, fdc->currentTrack, 0);
             
             fdc->status0 &= ~(ST0_DS0 | ST0_DS1 | ST0_IC0 | ST0_IC1);
-            fdc->status0 |= (diskPresent(fdc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
-                           (diskEnabled(fdc->drive) ? 0 : ST0_IC1);
+            fdc->status0 |= (diskPresent(fdc->board, fdc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
+                           (diskEnabled(fdc->board, fdc->drive) ? 0 : ST0_IC1);
             fdc->status3  = (value & (ST3_DS0 | ST3_DS1)) | 
                            (fdc->currentTrack == 0        ? ST3_TK0 : 0) | 
-                           (diskGetSides(fdc->drive) == 2 ? ST3_HD  : 0) | 
-                           (diskReadOnly(fdc->drive)      ? ST3_WP  : 0) |
-                           (diskPresent(fdc->drive)       ? ST3_RDY : 0);
+                           (diskGetSides(fdc->board, fdc->drive) == 2 ? ST3_HD  : 0) | 
+                           (diskReadOnly(fdc->board, fdc->drive)      ? ST3_WP  : 0) |
+                           (diskPresent(fdc->board, fdc->drive)       ? ST3_RDY : 0);
             break;
 		case 2:
             fdc->cylinderNumber = value;
@@ -360,11 +361,11 @@ static void nec765CommandPhaseWrite(NEC765* fdc, UInt8 value)
             if (fdc->command == CMD_READ_DATA) {
                 int sectorSize;
     
-        		DSKE rv = diskReadSector(fdc->drive, fdc->sectorBuf, fdc->sectorNumber, fdc->side, 
+        		DSKE rv = diskReadSector(fdc->board, fdc->drive, fdc->sectorBuf, fdc->sectorNumber, fdc->side, 
                                          fdc->currentTrack, 0, &sectorSize);
                 
                 fdcAudioSetReadWrite(fdc->fdcAudio);
-                boardSetFdcActive();
+                boardSetFdcActive(fdc->board);
                 if (rv == DSKE_NO_DATA) {
                     fdc->status0 |= ST0_IC0;
                     fdc->status1 |= ST1_ND;
@@ -393,16 +394,16 @@ static void nec765CommandPhaseWrite(NEC765* fdc, UInt8 value)
         case 1:
             fdc->drive = value & 0x03;
             fdc->side = (value >> 2)& 1;
-            fdc->sectorSize = diskGetSectorSize(fdc->drive, fdc->side, fdc->currentTrack, 0);
+            fdc->sectorSize = diskGetSectorSize(fdc->board, fdc->drive, fdc->side, fdc->currentTrack, 0);
             
             fdc->status0 &= ~(ST0_DS0 | ST0_DS1 | ST0_IC0 | ST0_IC1);
-            fdc->status0 |= (diskPresent(fdc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
-                           (diskEnabled(fdc->drive) ? 0 : ST0_IC1);
+            fdc->status0 |= (diskPresent(fdc->board, fdc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
+                           (diskEnabled(fdc->board, fdc->drive) ? 0 : ST0_IC1);
             fdc->status3  = (value & (ST3_DS0 | ST3_DS1)) | 
                            (fdc->currentTrack == 0        ? ST3_TK0 : 0) | 
-                           (diskGetSides(fdc->drive) == 2 ? ST3_HD  : 0) |  
-                           (diskReadOnly(fdc->drive)      ? ST3_WP  : 0) |
-                           (diskPresent(fdc->drive)       ? ST3_RDY : 0);
+                           (diskGetSides(fdc->board, fdc->drive) == 2 ? ST3_HD  : 0) |  
+                           (diskReadOnly(fdc->board, fdc->drive)      ? ST3_WP  : 0) |
+                           (diskPresent(fdc->board, fdc->drive)       ? ST3_RDY : 0);
             break;
 		case 2:
             fdc->number = value;
@@ -431,13 +432,13 @@ static void nec765CommandPhaseWrite(NEC765* fdc, UInt8 value)
             fdc->side = (value >>2)& 1;
             
             fdc->status0 &= ~(ST0_DS0 | ST0_DS1 | ST0_IC0 | ST0_IC1);
-            fdc->status0 |= (diskPresent(fdc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
-                           (diskEnabled(fdc->drive) ? 0 : ST0_IC1);
+            fdc->status0 |= (diskPresent(fdc->board, fdc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
+                           (diskEnabled(fdc->board, fdc->drive) ? 0 : ST0_IC1);
             fdc->status3  = (value & (ST3_DS0 | ST3_DS1)) | 
                            (fdc->currentTrack == 0        ? ST3_TK0 : 0) | 
-                           (diskGetSides(fdc->drive) == 2 ? ST3_HD  : 0) |  
-                           (diskReadOnly(fdc->drive)      ? ST3_WP  : 0) |
-                           (diskPresent(fdc->drive)       ? ST3_RDY : 0);
+                           (diskGetSides(fdc->board, fdc->drive) == 2 ? ST3_HD  : 0) |  
+                           (diskReadOnly(fdc->board, fdc->drive)      ? ST3_WP  : 0) |
+                           (diskPresent(fdc->board, fdc->drive)       ? ST3_RDY : 0);
             break;
 		case 2: 
             fdc->currentTrack = value;
@@ -457,13 +458,13 @@ static void nec765CommandPhaseWrite(NEC765* fdc, UInt8 value)
             fdc->drive = value & 0x03;
             
             fdc->status0 &= ~(ST0_DS0 | ST0_DS1 | ST0_IC0 | ST0_IC1);
-            fdc->status0 |= (diskPresent(fdc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
-                           (diskEnabled(fdc->drive) ? 0 : ST0_IC1);
+            fdc->status0 |= (diskPresent(fdc->board, fdc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
+                           (diskEnabled(fdc->board, fdc->drive) ? 0 : ST0_IC1);
             fdc->status3  = (value & (ST3_DS0 | ST3_DS1)) | 
                            (fdc->currentTrack == 0        ? ST3_TK0 : 0) | 
-                           (diskGetSides(fdc->drive) == 2 ? ST3_HD  : 0) |  
-                           (diskReadOnly(fdc->drive)      ? ST3_WP  : 0) |
-                           (diskPresent(fdc->drive)       ? ST3_RDY : 0);
+                           (diskGetSides(fdc->board, fdc->drive) == 2 ? ST3_HD  : 0) |  
+                           (diskReadOnly(fdc->board, fdc->drive)      ? ST3_WP  : 0) |
+                           (diskPresent(fdc->board, fdc->drive)       ? ST3_RDY : 0);
             
             fdc->currentTrack = 0;
             fdc->status0     |= ST0_SE;
@@ -491,13 +492,13 @@ static void nec765CommandPhaseWrite(NEC765* fdc, UInt8 value)
             fdc->side = (value >>2)& 1;
             
             fdc->status0 &= ~(ST0_DS0 | ST0_DS1 | ST0_IC0 | ST0_IC1);
-            fdc->status0 |= (diskPresent(fdc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
-                           (diskEnabled(fdc->drive) ? 0 : ST0_IC1);
+            fdc->status0 |= (diskPresent(fdc->board, fdc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
+                           (diskEnabled(fdc->board, fdc->drive) ? 0 : ST0_IC1);
             fdc->status3  = (value & (ST3_DS0 | ST3_DS1)) | 
                            (fdc->currentTrack == 0        ? ST3_TK0 : 0) | 
-                           (diskGetSides(fdc->drive) == 2 ? ST3_HD  : 0) |  
-                           (diskReadOnly(fdc->drive)      ? ST3_WP  : 0) |
-                           (diskPresent(fdc->drive)       ? ST3_RDY : 0);
+                           (diskGetSides(fdc->board, fdc->drive) == 2 ? ST3_HD  : 0) |  
+                           (diskReadOnly(fdc->board, fdc->drive)      ? ST3_WP  : 0) |
+                           (diskPresent(fdc->board, fdc->drive)       ? ST3_RDY : 0);
             
             fdc->mainStatus |= STM_DIO;
 		    fdc->phase       = PHASE_RESULT;
@@ -519,7 +520,7 @@ static void nec765ExecutionPhaseWrite(NEC765* fdc, UInt8 value)
 			fdc->sectorBuf[fdc->sectorOffset++] = value;
             
     		if (fdc->sectorOffset == fdc->sectorSize) {
-                rv = diskWriteSector(fdc->drive, fdc->sectorBuf, fdc->sectorNumber, fdc->side, 
+                rv = diskWriteSector(fdc->board, fdc->drive, fdc->sectorBuf, fdc->sectorNumber, fdc->side, 
                                      fdc->currentTrack, 0);
                 if (!rv) {
                     fdc->status1 |= ST1_NW;
@@ -527,7 +528,7 @@ static void nec765ExecutionPhaseWrite(NEC765* fdc, UInt8 value)
 
                 fdcAudioSetReadWrite(fdc->fdcAudio);
 
-                boardSetFdcActive();
+                boardSetFdcActive(fdc->board);
 
                 fdc->phase       = PHASE_RESULT;
                 fdc->phaseStep   = 0;
@@ -543,12 +544,12 @@ static void nec765ExecutionPhaseWrite(NEC765* fdc, UInt8 value)
             break;
         case 1:
             memset(fdc->sectorBuf, fdc->fillerByte, fdc->sectorSize);
-            rv = diskWrite(fdc->drive, fdc->sectorBuf, fdc->sectorNumber - 1 +
-                      diskGetSectorsPerTrack(fdc->drive) * (fdc->currentTrack * diskGetSides(fdc->drive) + value));
+            rv = diskWrite(fdc->board, fdc->drive, fdc->sectorBuf, fdc->sectorNumber - 1 +
+                      diskGetSectorsPerTrack(fdc->board, fdc->drive) * (fdc->currentTrack * diskGetSides(fdc->board, fdc->drive) + value));
             if (!rv) {
                 fdc->status1 |= ST1_NW;
             }
-            boardSetFdcActive();
+            boardSetFdcActive(fdc->board);
             break;
         case 2:
             fdc->sectorNumber = value;
@@ -564,11 +565,12 @@ static void nec765ExecutionPhaseWrite(NEC765* fdc, UInt8 value)
 	}
 }
 
-NEC765* nec765Create()
+NEC765* nec765Create(BoardContext* board)
 {
     NEC765* fdc = malloc(sizeof(NEC765));
 
-    fdc->fdcAudio = fdcAudioCreate(FA_PANASONIC);
+    fdc->board = board;
+    fdc->fdcAudio = fdcAudioCreate(board, FA_PANASONIC);
 
     nec765Reset(fdc);
 
@@ -583,8 +585,10 @@ void nec765Destroy(NEC765* fdc)
 
 void nec765Reset(NEC765* fdc)
 {
+    BoardContext* board = fdc->board;
     FdcAudio* fdcAudio = fdc->fdcAudio;
     memset(fdc, 0, sizeof(NEC765));
+    fdc->board = board;
     fdc->fdcAudio = fdcAudio;
 
     fdc->mainStatus = STM_NDM | STM_RQM;
@@ -606,7 +610,7 @@ UInt8 nec765Read(NEC765* fdc)
     switch (fdc->phase) {            
 	case PHASE_DATATRANSFER:
         value = nec765ExecutionPhaseRead(fdc);
-        fdc->dataTransferTime = boardSystemTime();
+        fdc->dataTransferTime = boardSystemTime(fdc->board);
         fdc->mainStatus &= ~STM_RQM;
         return value;
 
@@ -630,7 +634,7 @@ UInt8 nec765Peek(NEC765* fdc)
 UInt8 nec765ReadStatus(NEC765* fdc)
 {
     if (~fdc->mainStatus & STM_RQM) {
-        UInt32 elapsed = boardSystemTime() - fdc->dataTransferTime;
+        UInt32 elapsed = boardSystemTime(fdc->board) - fdc->dataTransferTime;
         if (elapsed > boardFrequency() * 60 / 1000000) {
             fdc->mainStatus |= STM_RQM;
         } 
@@ -645,8 +649,8 @@ UInt8 nec765PeekStatus(NEC765* fdc)
 
 void nec765Write(NEC765* fdc, UInt8 value)
 {
-    //ledSetFdd1((value & 0x10) && diskEnabled(0)); /* 10:10 2004/10/09 FDD LED PATCH */ 
-    //ledSetFdd2((value & 0x20) && diskEnabled(1)); /* 10:10 2004/10/09 FDD LED PATCH */ 
+    //ledSetFdd1((value & 0x10) && diskEnabled(fdc->board, 0)); /* 10:10 2004/10/09 FDD LED PATCH */ 
+    //ledSetFdd2((value & 0x20) && diskEnabled(fdc->board, 1)); /* 10:10 2004/10/09 FDD LED PATCH */ 
 
     switch (fdc->phase) {
 	case PHASE_IDLE:
@@ -659,7 +663,7 @@ void nec765Write(NEC765* fdc, UInt8 value)
         
 	case PHASE_DATATRANSFER:
         nec765ExecutionPhaseWrite(fdc, value);
-        fdc->dataTransferTime = boardSystemTime();
+        fdc->dataTransferTime = boardSystemTime(fdc->board);
         fdc->mainStatus &= ~STM_RQM;
         break;
     }
@@ -672,9 +676,9 @@ int nec765GetInt(NEC765* fdc)
 
 int nec765GetIndex(NEC765* fdc)
 {
-    if (diskEnabled(fdc->drive)) {
-        if (diskPresent(fdc->drive)) {
-            if ((UInt64)160 * boardSystemTime() / boardFrequency() & 0x1e) {
+    if (diskEnabled(fdc->board, fdc->drive)) {
+        if (diskPresent(fdc->board, fdc->drive)) {
+            if ((UInt64)160 * boardSystemTime(fdc->board) / boardFrequency() & 0x1e) {
 			    return 1;
 		    }
         }
@@ -684,12 +688,12 @@ int nec765GetIndex(NEC765* fdc)
 
 int nec765DiskChanged(NEC765* fdc, int drive)
 {
-    return diskChanged(drive);
+    return diskChanged(fdc->board, drive);
 }
 
 void nec765LoadState(NEC765* fdc)
 {
-    SaveState* state = saveStateOpenForRead("nec765");
+    SaveState* state = saveStateOpenForRead(fdc->board, "nec765");
 
     fdc->drive               = (UInt8) saveStateGet(state, "drive",              0);
     fdc->mainStatus          = (UInt8) saveStateGet(state, "mainStatus",         STM_NDM | STM_RQM);
@@ -717,7 +721,7 @@ void nec765LoadState(NEC765* fdc)
 
 void nec765SaveState(NEC765* fdc)
 {
-    SaveState* state = saveStateOpenForWrite("nec765");
+    SaveState* state = saveStateOpenForWrite(fdc->board, "nec765");
 
     saveStateSet(state, "drive",              fdc->drive);
     saveStateSet(state, "mainStatus",         fdc->mainStatus);
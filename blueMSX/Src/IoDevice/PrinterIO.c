@@ -33,6 +33,7 @@
 #include <string.h>
 
 typedef struct PrinterIO {
+    BoardContext* board;
     PrinterType type;
     DAC* dac;
     FILE* file;
@@ -56,7 +57,7 @@ static void setType(PrinterIO* printerIO)
         printerIO->file = fopen(theFileName, "w+");
         break;
     case PRN_SIMPL:
-        printerIO->dac = dacCreate(boardGetMixer(), DAC_MONO);
+        printerIO->dac = dacCreate(boardGetMixer(printerIO->board), DAC_MONO);
         break;
     }
 }
@@ -110,10 +111,12 @@ int  printerIODoStrobe(PrinterIO* printerIO)
     return printerIO->type != PRN_SIMPL;
 }
 
-PrinterIO* printerIOCreate(void)
+PrinterIO* printerIOCreate(BoardContext* board)
 {
     PrinterIO* printerIO = calloc(1, sizeof(PrinterIO));
 
+    printerIO->board = board;
+
     setType(printerIO);
 
     thePrinterIO = printerIO;
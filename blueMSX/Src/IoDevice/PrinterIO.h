@@ -34,7 +34,7 @@ typedef struct PrinterIO PrinterIO;
 
 typedef enum {PRN_NONE, PRN_SIMPL, PRN_FILE, PRN_HOST } PrinterType;
 
-PrinterIO* printerIOCreate(void);
+PrinterIO* printerIOCreate(BoardContext* board);
 void printerIODestroy(PrinterIO* printerIO);
 
 void printerIOWrite(PrinterIO* printerIO, UInt8 value);
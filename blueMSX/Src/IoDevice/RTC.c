@@ -67,6 +67,7 @@ static const int daysInMonth[4][12] = {
 #define OFFSETOF(s, a) ((int)(&((s*)0)->a))
 
 struct RTC {
+    BoardContext* board;
     int debugHandle;
 
     char cmosName[512];
@@ -91,9 +92,9 @@ struct RTC {
 
 void rtcLoadState(RTC* rtc)
 {
-    SaveState* state = saveStateOpenForRead("rtc");
+    SaveState* state = saveStateOpenForRead(rtc->board, "rtc");
 
-    rtc->refTime  =         saveStateGet(state, "refTime",  boardSystemTime());
+    rtc->refTime  =         saveStateGet(state, "refTime",  boardSystemTime(rtc->board));
     rtc->refFrag  =         saveStateGet(state, "refFrag",  0);
     rtc->fraction =         saveStateGet(state, "fraction", 0);
     rtc->seconds  =         saveStateGet(state, "seconds",  0);
@@ -111,7 +112,7 @@ void rtcLoadState(RTC* rtc)
 
 void rtcSaveState(RTC* rtc)
 {
-    SaveState* state = saveStateOpenForWrite("rtc");
+    SaveState* state = saveStateOpenForWrite(rtc->board, "rtc");
 
     saveStateSet(state, "refTime",  rtc->refTime);
     saveStateSet(state, "refFrag",  rtc->refFrag);
@@ -178,7 +179,7 @@ static void rtcUpdateRegs(RTC* rtc)
     int carryYears;
     UInt64 elapsed;
     UInt32 elapsedTime;
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(rtc->board);
 
     elapsed      = 16384 * (UInt64)(systemTime - rtc->refTime) + rtc->refFrag;
     rtc->refTime = systemTime;
@@ -308,11 +309,13 @@ static void getDebugInfo(RTC* rtc, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 1, 0xb5, DBG_IO_READWRITE, rtcPeekData(rtc, 0xb5));
 }
 
-RTC* rtcCreate(int enable, char* cmosName)
+RTC* rtcCreate(BoardContext* board, int enable, char* cmosName)
 {
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     RTC* rtc = (RTC*)calloc(1, sizeof(RTC));
 
+    rtc->board = board;
+
     rtc->modeReg = MODE_TIMERENABLE;
 
     if (cmosName != NULL) {
@@ -344,10 +347,10 @@ RTC* rtcCreate(int enable, char* cmosName)
     }
 
     if (enable) {
-        rtc->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, langDbgDevRtc(), &dbgCallbacks, rtc);
+        rtc->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, langDbgDevRtc(), &dbgCallbacks, rtc);
         
-        ioPortRegister(0xb4, NULL,        rtcWriteLatch, rtc);
-        ioPortRegister(0xb5, rtcReadData, rtcWriteData,  rtc);
+        ioPortRegister(board, 0xb4, NULL,        rtcWriteLatch, rtc);
+        ioPortRegister(board, 0xb5, rtcReadData, rtcWriteData,  rtc);
     }
 
     rtcUpdateRegs(rtc);
@@ -357,10 +360,10 @@ RTC* rtcCreate(int enable, char* cmosName)
 
 void rtcDestroy(RTC* rtc)
 {
-    debugDeviceUnregister(rtc->debugHandle);
+    debugDeviceUnregister(rtc->board, rtc->debugHandle);
 
-    ioPortUnregister(0xb4);
-    ioPortUnregister(0xb5);
+    ioPortUnregister(rtc->board, 0xb4);
+    ioPortUnregister(rtc->board, 0xb5);
 
     if (rtc->cmosName[0]) {
         FILE* file = fopen(rtc->cmosName, "w");
@@ -34,7 +34,7 @@
 typedef struct RTC RTC;
 
 /* Constructor and destructor */
-RTC* rtcCreate(int enable, char* cmosName);
+RTC* rtcCreate(BoardContext* board, int enable, char* cmosName);
 void rtcDestroy(RTC* rtc);
 
 void rtcLoadState(RTC* rtc);
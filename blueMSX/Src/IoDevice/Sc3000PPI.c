@@ -39,6 +39,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int    deviceHandle;
     int    debugHandle;
     I8255* i8255;
@@ -147,13 +148,13 @@ static UInt16 getKeyState(Sc3000PPI* ppi)
 
 static void destroy(Sc3000PPI* ppi)
 {
-    ioPortUnregister(0xdc);
-    ioPortUnregister(0xdd);
-    ioPortUnregister(0xde);
-    ioPortUnregister(0xdf);
+    ioPortUnregister(ppi->board, 0xdc);
+    ioPortUnregister(ppi->board, 0xdd);
+    ioPortUnregister(ppi->board, 0xde);
+    ioPortUnregister(ppi->board, 0xdf);
 
-    deviceManagerUnregister(ppi->deviceHandle);
-    debugDeviceUnregister(ppi->debugHandle);
+    deviceManagerUnregister(ppi->board, ppi->deviceHandle);
+    debugDeviceUnregister(ppi->board, ppi->debugHandle);
 
     i8255Destroy(ppi->i8255);
 
@@ -169,7 +170,7 @@ static void reset(Sc3000PPI* ppi)
 
 static void loadState(Sc3000PPI* ppi)
 {
-    SaveState* state = saveStateOpenForRead("Sc3000PPI");
+    SaveState* state = saveStateOpenForRead(ppi->board, "Sc3000PPI");
 
     ppi->row = (UInt8)saveStateGet(state, "row", 0);
 
@@ -180,7 +181,7 @@ static void loadState(Sc3000PPI* ppi)
 
 static void saveState(Sc3000PPI* ppi)
 {
-    SaveState* state = saveStateOpenForWrite("Sc3000PPI");
+    SaveState* state = saveStateOpenForWrite(ppi->board, "Sc3000PPI");
     
     saveStateSet(state, "row", ppi->row);
 
@@ -196,12 +197,12 @@ static void writeCLo(Sc3000PPI* ppi, UInt8 value)
 
 static UInt8 readA(Sc3000PPI* ppi)
 {
-    return boardCaptureUInt8(16 + ppi->row * 2, getKeyState(ppi) & 0xff);
+    return boardCaptureUInt8(ppi->board, 16 + ppi->row * 2, getKeyState(ppi) & 0xff);
 }
 
 static UInt8 readB(Sc3000PPI* ppi)
 {
-    return boardCaptureUInt8(16 + ppi->row * 2 + 1, getKeyState(ppi) >> 8);
+    return boardCaptureUInt8(ppi->board, 16 + ppi->row * 2 + 1, getKeyState(ppi) >> 8);
 }
 
 static UInt8 peekA(Sc3000PPI* ppi)
@@ -225,27 +226,29 @@ static void getDebugInfo(Sc3000PPI* ppi, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 3, 0xdf, DBG_IO_READWRITE, i8255Read(ppi->i8255, 0xdf));
 }
 
-void sc3000PPICreate(Sg1000JoyIo* joyIo)
+void sc3000PPICreate(BoardContext* board, Sg1000JoyIo* joyIo)
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     Sc3000PPI* ppi = malloc(sizeof(Sc3000PPI));
 
-    ppi->deviceHandle = deviceManagerRegister(RAM_MAPPER, &callbacks, ppi);
-    ppi->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, langDbgDevPpi(), &dbgCallbacks, ppi);
+    ppi->board = board;
+
+    ppi->deviceHandle = deviceManagerRegister(board, RAM_MAPPER, &callbacks, ppi);
+    ppi->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, langDbgDevPpi(), &dbgCallbacks, ppi);
 
     ppi->joyIo = joyIo;
 
-    ppi->i8255 = i8255Create(peekA, readA, NULL,
+    ppi->i8255 = i8255Create(board, peekA, readA, NULL,
                              peekB, readB, NULL,
                              NULL,  NULL,  writeCLo,
                              NULL,  NULL,  NULL,
                              ppi);
 
-    ioPortRegister(0xdc, i8255Read, i8255Write, ppi->i8255); // PPI Port A
-    ioPortRegister(0xdd, i8255Read, i8255Write, ppi->i8255); // PPI Port B
-    ioPortRegister(0xde, i8255Read, i8255Write, ppi->i8255); // PPI Port C
-    ioPortRegister(0xdf, i8255Read, i8255Write, ppi->i8255); // PPI Mode
+    ioPortRegister(board, 0xdc, i8255Read, i8255Write, ppi->i8255); // PPI Port A
+    ioPortRegister(board, 0xdd, i8255Read, i8255Write, ppi->i8255); // PPI Port B
+    ioPortRegister(board, 0xde, i8255Read, i8255Write, ppi->i8255); // PPI Port C
+    ioPortRegister(board, 0xdf, i8255Read, i8255Write, ppi->i8255); // PPI Mode
 
     reset(ppi);
 }
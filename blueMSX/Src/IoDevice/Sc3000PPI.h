@@ -31,7 +31,7 @@
 #include "MsxTypes.h"
 #include "Sg1000JoyIo.h"
 
-void sc3000PPICreate(Sg1000JoyIo* joyIo);
+void sc3000PPICreate(BoardContext* board, Sg1000JoyIo* joyIo);
 
 #endif
 
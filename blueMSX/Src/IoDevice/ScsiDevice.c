@@ -59,6 +59,7 @@
 #define MT_FMT_ERROR    0x72
 
 struct SCSIDEVICE {
+    BoardContext* board;
     int diskId;
     int scsiId;             // SCSI ID 0..7
     int deviceType;
@@ -147,11 +148,12 @@ void scsiDeviceLogClose()
 
 #endif
 
-SCSIDEVICE* scsiDeviceCreate(int scsiId, int diskId, UInt8* buf, char* name,
+SCSIDEVICE* scsiDeviceCreate(BoardContext* board, int scsiId, int diskId, UInt8* buf, char* name,
                   int type, int mode, CdromXferCompCb xferCompCb, void* ref)
 {
     SCSIDEVICE* scsi = malloc(sizeof(SCSIDEVICE));
 
+    scsi->board = board;
     scsi->scsiId        = scsiId;
     scsi->diskId        = diskId;
     scsi->buffer        = buf;
@@ -244,16 +246,16 @@ int scsiDeviceSelection(SCSIDEVICE* scsi)
     if (scsi->mode & MODE_REMOVABLE) {
         if (!scsi->enabled &&
            (scsi->mode & MODE_NOVAXIS) && scsi->deviceType != SDT_CDROM) {
-            scsi->enabled = diskPresent(scsi->diskId) ? 1 : 0;
+            scsi->enabled = diskPresent(scsi->board, scsi->diskId) ? 1 : 0;
         }
         return scsi->enabled;
     }
-    return scsi->enabled && diskPresent(scsi->diskId);
+    return scsi->enabled && diskPresent(scsi->board, scsi->diskId);
 }
 
 static int scsiDeviceGetReady(SCSIDEVICE* scsi)
 {
-    if (diskPresent(scsi->diskId)) {
+    if (diskPresent(scsi->board, scsi->diskId)) {
         return 1;
     }
     scsi->keycode = SENSE_MEDIUM_NOT_PRESENT;
@@ -263,7 +265,7 @@ static int scsiDeviceGetReady(SCSIDEVICE* scsi)
 static int scsiDeviceDiskChanged(SCSIDEVICE* scsi)
 {
     FileProperties* pDisk;
-    int changed = diskChanged(scsi->diskId);
+    int changed = diskChanged(scsi->board, scsi->diskId);
 
     if (changed) {
         scsi->motor = 1;
@@ -286,7 +288,7 @@ static int scsiDeviceDiskChanged(SCSIDEVICE* scsi)
         SCSILOG1("filename: %s\n", scsi->disk.fileName);
         SCSILOG1("     zip: %s\n", scsi->disk.fileNameInZip);
     } else {
-        if (scsi->inserted & !diskPresent(scsi->diskId)) {
+        if (scsi->inserted & !diskPresent(scsi->board, scsi->diskId)) {
             scsi->inserted = 0;
             scsi->motor    = 0;
             scsi->changed  = 1;
@@ -318,20 +320,20 @@ static void scsiDeviceStartStopUnit(SCSIDEVICE* scsi)
     switch (scsi->cdb[4]) {
     case 2:
         // Eject
-        if (diskPresent(scsi->diskId)) {
+        if (diskPresent(scsi->board, scsi->diskId)) {
             disk->fileName[0] = 0;
             disk->fileNameInZip[0] = 0;
             updateExtendedDiskName(scsi->diskId, disk->fileName, disk->fileNameInZip);
-            boardChangeDiskette(scsi->diskId, NULL, NULL);
+            boardChangeDiskette(scsi->board, scsi->diskId, NULL, NULL);
             SCSILOG1("hdd %d eject\n", scsi->scsiId);
         }
         break;
     case 3:
         // Insert
-        if (!diskPresent(scsi->diskId)) {
+        if (!diskPresent(scsi->board, scsi->diskId)) {
             *disk = scsi->disk;
             updateExtendedDiskName(scsi->diskId, disk->fileName, disk->fileNameInZip);
-            boardChangeDiskette(scsi->diskId, disk->fileName, disk->fileNameInZip);
+            boardChangeDiskette(scsi->board, scsi->diskId, disk->fileName, disk->fileNameInZip);
             SCSILOG1("hdd %d insert\n", scsi->scsiId);
         }
         break;
@@ -342,7 +344,7 @@ static void scsiDeviceStartStopUnit(SCSIDEVICE* scsi)
 
 static int scsiDeviceInquiry(SCSIDEVICE* scsi)
 {
-    int total       = _diskGetTotalSectors(scsi->diskId);
+    int total       = _diskGetTotalSectors(scsi->board, scsi->diskId);
     int length      = scsi->length;
     UInt8* buffer   = scsi->buffer;
     UInt8 type      = (UInt8)(scsi->deviceType & 0xff);
@@ -431,7 +433,7 @@ static int scsiDeviceModeSense(SCSIDEVICE* scsi)
 
     if ((length > 0) && (scsi->cdb[2] == 3)) {
         UInt8* buffer   = scsi->buffer;
-        int total       = _diskGetTotalSectors(scsi->diskId);
+        int total       = _diskGetTotalSectors(scsi->board, scsi->diskId);
         int media       = MT_UNKNOWN;
         int sectors     = 64;
         int blockLength = scsi->sectorSize >> 8;
@@ -534,7 +536,7 @@ static int scsiDeviceRequestSense(SCSIDEVICE* scsi)
 
 static int scsiDeviceCheckReadOnly(SCSIDEVICE* scsi)
 {
-    int result = diskReadOnly(scsi->diskId);
+    int result = diskReadOnly(scsi->board, scsi->diskId);
     if (result) {
         scsi->keycode = SENSE_WRITE_PROTECT;
     }
@@ -543,7 +545,7 @@ static int scsiDeviceCheckReadOnly(SCSIDEVICE* scsi)
 
 static int scsiDeviceReadCapacity(SCSIDEVICE* scsi)
 {
-    UInt32 block  = _diskGetTotalSectors(scsi->diskId);
+    UInt32 block  = _diskGetTotalSectors(scsi->board, scsi->diskId);
     UInt8* buffer = scsi->buffer;
 
     if (block == 0) {
@@ -593,7 +595,7 @@ static int scsiDeviceBlueMSX(SCSIDEVICE* scsi)
     }
     if (cmd == 1) {
         // inserted
-        buffer[0] = diskPresent(scsi->diskId) ? 1 : 0;
+        buffer[0] = diskPresent(scsi->board, scsi->diskId) ? 1 : 0;
         return 1;
     }
     if (cmd < 6) {
@@ -617,7 +619,7 @@ static int scsiDeviceBlueMSX(SCSIDEVICE* scsi)
 
 static int scsiDeviceCheckAddress(SCSIDEVICE* scsi)
 {
-    int total = _diskGetTotalSectors(scsi->diskId);
+    int total = _diskGetTotalSectors(scsi->board, scsi->diskId);
     if (total == 0) {
         scsi->keycode = SENSE_MEDIUM_NOT_PRESENT;
         SCSILOG1("hdd %d: drive not ready\n", scsi->scsiId);
@@ -649,7 +651,7 @@ static int scsiDeviceReadSector(SCSIDEVICE* scsi, int* blocks)
     }
 
     //SCSILOG("hdd#%d read sector: %d %d\n", scsi->scsiId, scsi->sector, numSectors);
-    if (_diskRead2(scsi->diskId, scsi->buffer, scsi->sector, numSectors)) {
+    if (_diskRead2(scsi->board, scsi->diskId, scsi->buffer, scsi->sector, numSectors)) {
         scsi->sector += numSectors;
         scsi->length -= numSectors;
         *blocks = scsi->length;
@@ -689,7 +691,7 @@ static int scsiDeviceWriteSector(SCSIDEVICE* scsi, int* blocks)
     }
 
     SCSILOG3("hdd#%d write sector: %d %d\n", scsi->scsiId, scsi->sector, numSectors);
-    if (_diskWrite2(scsi->diskId, scsi->buffer, scsi->sector, numSectors)) {
+    if (_diskWrite2(scsi->board, scsi->diskId, scsi->buffer, scsi->sector, numSectors)) {
         scsi->sector += numSectors;
         scsi->length -= numSectors;
 
@@ -722,7 +724,7 @@ static void scsiDeviceFormatUnit(SCSIDEVICE* scsi)
 {
     if (scsiDeviceGetReady(scsi) && !scsiDeviceCheckReadOnly(scsi)) {
         memset(scsi->buffer, 0, 512);
-        if (_diskWrite2(scsi->diskId, scsi->buffer, 0, 1)) {
+        if (_diskWrite2(scsi->board, scsi->diskId, scsi->buffer, 0, 1)) {
             scsi->reset   = 1;
             scsi->changed = 1;
         } else {
@@ -1016,7 +1018,7 @@ int scsiDeviceMsgOut(SCSIDEVICE* scsi, UInt8 value)
 
 void scsiDeviceSaveState(SCSIDEVICE* scsi)
 {
-    SaveState* state = saveStateOpenForWrite("scsidevice");
+    SaveState* state = saveStateOpenForWrite(scsi->board, "scsidevice");
 
     saveStateSet(state, "enabled",    scsi->enabled);
     saveStateSet(state, "deviceType", scsi->deviceType);
@@ -1044,7 +1046,7 @@ void scsiDeviceSaveState(SCSIDEVICE* scsi)
 
 void scsiDeviceLoadState(SCSIDEVICE* scsi)
 {
-    SaveState* state = saveStateOpenForRead("scsidevice");
+    SaveState* state = saveStateOpenForRead(scsi->board, "scsidevice");
 
     scsi->enabled    = saveStateGet(state, "enabled",    1);
     scsi->deviceType = saveStateGet(state, "deviceType", 0);
@@ -65,7 +65,7 @@ typedef enum {
 
 typedef struct SCSIDEVICE SCSIDEVICE;
 
-SCSIDEVICE* scsiDeviceCreate(int scsiId, int diskId, UInt8* buf, char* name,
+SCSIDEVICE* scsiDeviceCreate(BoardContext* board, int scsiId, int diskId, UInt8* buf, char* name,
                   int type, int mode, CdromXferCompCb xferCompCb, void* ref);
 void scsiDeviceDestroy(SCSIDEVICE* scsi);
 void scsiDeviceReset(SCSIDEVICE* scsi);
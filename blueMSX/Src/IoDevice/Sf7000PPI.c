@@ -39,6 +39,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int    deviceHandle;
     int    debugHandle;
     UInt8  ramSlot;
@@ -49,13 +50,13 @@ typedef struct {
 
 static void destroy(Sf7000PPI* ppi)
 {
-    ioPortUnregister(0xe4);
-    ioPortUnregister(0xe5);
-    ioPortUnregister(0xe6);
-    ioPortUnregister(0xe7);
+    ioPortUnregister(ppi->board, 0xe4);
+    ioPortUnregister(ppi->board, 0xe5);
+    ioPortUnregister(ppi->board, 0xe6);
+    ioPortUnregister(ppi->board, 0xe7);
 
-    deviceManagerUnregister(ppi->deviceHandle);
-    debugDeviceUnregister(ppi->debugHandle);
+    deviceManagerUnregister(ppi->board, ppi->deviceHandle);
+    debugDeviceUnregister(ppi->board, ppi->debugHandle);
 
     nec765Destroy(ppi->nec765);
     i8255Destroy(ppi->i8255);
@@ -65,7 +66,7 @@ static void destroy(Sf7000PPI* ppi)
 
 static void loadState(Sf7000PPI* ppi)
 {
-    SaveState* state = saveStateOpenForRead("Sf7000PPI");
+    SaveState* state = saveStateOpenForRead(ppi->board, "Sf7000PPI");
 
     ppi->ramSlot = (UInt8)saveStateGet(state, "ramSlot", 0);
     saveStateClose(state);
@@ -76,7 +77,7 @@ static void loadState(Sf7000PPI* ppi)
 
 static void saveState(Sf7000PPI* ppi)
 {
-    SaveState* state = saveStateOpenForWrite("Sf7000PPI");
+    SaveState* state = saveStateOpenForWrite(ppi->board, "Sf7000PPI");
     
     saveStateSet(state, "ramSlot", ppi->ramSlot);
 
@@ -111,12 +112,12 @@ static UInt8 readA(Sf7000PPI* ppi)
 
 static void writeCHi(Sf7000PPI* ppi, UInt8 value)
 {
-    int slot = slotGetRamSlot(0);
+    int slot = slotGetRamSlot(ppi->board, 0);
 
     ppi->ramSlot = (~value >> 2) & 0x01;
 
     if (slot == 0 || slot == 1) {
-        slotSetRamSlot(0, ppi->ramSlot);
+        slotSetRamSlot(ppi->board, 0, ppi->ramSlot);
     }
 }
 
@@ -169,30 +170,32 @@ static void fdcWrite(Sf7000PPI* ppi, UInt16 port, UInt8 value)
     }
 }
 
-void sf7000PPICreate()
+void sf7000PPICreate(BoardContext* board)
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     Sf7000PPI* ppi = malloc(sizeof(Sf7000PPI));
 
-    ppi->deviceHandle = deviceManagerRegister(RAM_MAPPER, &callbacks, ppi);
-    ppi->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, langDbgDevPpi(), &dbgCallbacks, ppi);
+    ppi->board = board;
+
+    ppi->deviceHandle = deviceManagerRegister(board, RAM_MAPPER, &callbacks, ppi);
+    ppi->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, langDbgDevPpi(), &dbgCallbacks, ppi);
     
-    ppi->nec765 = nec765Create();
+    ppi->nec765 = nec765Create(board);
 
-    ppi->i8255 = i8255Create(NULL,  readA,  NULL,
+    ppi->i8255 = i8255Create(board, NULL,  readA,  NULL,
                              NULL,  NULL,  NULL,
                              NULL,  NULL,  writeCLo,
                              NULL,  NULL,  writeCHi,
                              ppi);
 
-	ioPortRegister(0xe0, fdcRead, NULL, ppi);
-	ioPortRegister(0xe1, fdcRead, fdcWrite, ppi);
+	ioPortRegister(board, 0xe0, fdcRead, NULL, ppi);
+	ioPortRegister(board, 0xe1, fdcRead, fdcWrite, ppi);
 
-    ioPortRegister(0xe4, read, write, ppi); // PPI Port A
-    ioPortRegister(0xe5, read, write, ppi); // PPI Port B
-    ioPortRegister(0xe6, read, write, ppi); // PPI Port C
-    ioPortRegister(0xe7, read, write, ppi); // PPI Mode
+    ioPortRegister(board, 0xe4, read, write, ppi); // PPI Port A
+    ioPortRegister(board, 0xe5, read, write, ppi); // PPI Port B
+    ioPortRegister(board, 0xe6, read, write, ppi); // PPI Port C
+    ioPortRegister(board, 0xe7, read, write, ppi); // PPI Mode
 
     reset(ppi);
 }
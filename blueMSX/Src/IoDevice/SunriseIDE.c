@@ -36,18 +36,20 @@
     
 
 struct SunriseIde {
+    BoardContext* board;
     int softReset;
     int currentDevice;
     HarddiskIde* hdide[2];
 };
 
 
-SunriseIde* sunriseIdeCreate(int hdId)
+SunriseIde* sunriseIdeCreate(BoardContext* board, int hdId)
 {
     SunriseIde* ide = malloc(sizeof(SunriseIde));
 
-    ide->hdide[0] = harddiskIdeCreate(diskGetHdDriveId(hdId, 0));
-    ide->hdide[1] = harddiskIdeCreate(diskGetHdDriveId(hdId, 1));
+    ide->board = board;
+    ide->hdide[0] = harddiskIdeCreate(board, diskGetHdDriveId(hdId, 0));
+    ide->hdide[1] = harddiskIdeCreate(board, diskGetHdDriveId(hdId, 1));
 
     sunriseIdeReset(ide);
 
@@ -160,7 +162,7 @@ void sunriseIdeWriteRegister(SunriseIde* ide, UInt8 reg, UInt8 value)
 
 void sunriseIdeLoadState(SunriseIde* ide)
 {
-    SaveState* state = saveStateOpenForRead("sunriseIde");
+    SaveState* state = saveStateOpenForRead(ide->board, "sunriseIde");
 
     ide->softReset     = saveStateGet(state, "softReset",     0);
     ide->currentDevice = saveStateGet(state, "currentDevice", 0);
@@ -173,7 +175,7 @@ void sunriseIdeLoadState(SunriseIde* ide)
 
 void sunriseIdeSaveState(SunriseIde* ide)
 {
-    SaveState* state = saveStateOpenForWrite("sunriseIde");
+    SaveState* state = saveStateOpenForWrite(ide->board, "sunriseIde");
 
     saveStateSet(state, "softReset",     ide->softReset);
     saveStateSet(state, "currentDevice", ide->currentDevice);
@@ -32,7 +32,7 @@
 
 typedef struct SunriseIde SunriseIde;
 
-SunriseIde* sunriseIdeCreate(int hdId);
+SunriseIde* sunriseIdeCreate(BoardContext* board, int hdId);
 void sunriseIdeDestroy(SunriseIde* ide);
 
 void sunriseIdeReset(SunriseIde* ide);
@@ -115,6 +115,7 @@ static UInt8 getKeyState(int row);
 */
 
 typedef struct {
+    BoardContext* board;
     int    deviceHandle;
     int    debugHandle;
     I8255* i8255;
@@ -129,15 +130,15 @@ typedef struct {
 
 static void destroy(SviPPI* ppi)
 {
-    ioPortUnregister(0x98);
-    ioPortUnregister(0x99);
-    ioPortUnregister(0x96);
-    ioPortUnregister(0x97);
-    ioPortUnregister(0x9A);
+    ioPortUnregister(ppi->board, 0x98);
+    ioPortUnregister(ppi->board, 0x99);
+    ioPortUnregister(ppi->board, 0x96);
+    ioPortUnregister(ppi->board, 0x97);
+    ioPortUnregister(ppi->board, 0x9A);
 
     audioKeyClickDestroy(ppi->keyClick);
-    deviceManagerUnregister(ppi->deviceHandle);
-    debugDeviceUnregister(ppi->debugHandle);
+    deviceManagerUnregister(ppi->board, ppi->deviceHandle);
+    debugDeviceUnregister(ppi->board, ppi->debugHandle);
 
     dacDestroy(ppi->dac);
 
@@ -156,7 +157,7 @@ static void reset(SviPPI* ppi)
 
 static void loadState(SviPPI* ppi)
 {
-    SaveState* state = saveStateOpenForRead("SviPPI");
+    SaveState* state = saveStateOpenForRead(ppi->board, "SviPPI");
 
     ppi->row    = (UInt8)saveStateGet(state, "row", 0);
     ppi->regCHi =        saveStateGet(state, "regCHi", -1);
@@ -168,7 +169,7 @@ static void loadState(SviPPI* ppi)
 
 static void saveState(SviPPI* ppi)
 {
-    SaveState* state = saveStateOpenForWrite("SviPPI");
+    SaveState* state = saveStateOpenForWrite(ppi->board, "SviPPI");
     
     saveStateSet(state, "row", ppi->row);
     saveStateSet(state, "regCHi", ppi->regCHi);
@@ -210,23 +211,23 @@ static void writeCHi(SviPPI* ppi, UInt8 value)
 static UInt8 peekA(SviPPI* ppi)
 {
     return sviJoyIoReadTrigger(ppi->joyIO) | 
-           (boardGetCassetteInserted() ? 0:0x40);
+           (boardGetCassetteInserted(ppi->board) ? 0:0x40);
 }
 
 static UInt8 readA(SviPPI* ppi)
 {
 #if 1
     // dvik: reverted to 2.8 since wav support is not finished yet
-    return boardCaptureUInt8(16, sviJoyIoReadTrigger(ppi->joyIO)) | 
-        (boardGetCassetteInserted() ? 0:0x40);
+    return boardCaptureUInt8(ppi->board, 16, sviJoyIoReadTrigger(ppi->joyIO)) | 
+        (boardGetCassetteInserted(ppi->board) ? 0:0x40);
 #else
     UInt8 value;
     UInt8 casdat = 0;
 
-    value = boardCaptureUInt8(16, sviJoyIoReadTrigger(ppi->joyIO));
-    value |= boardGetCassetteInserted() ? 0:0x40; 
+    value = boardCaptureUInt8(ppi->board, 16, sviJoyIoReadTrigger(ppi->joyIO));
+    value |= boardGetCassetteInserted(ppi->board) ? 0:0x40; 
 
-    tapeRead(&casdat);
+    tapeRead(ppi->board, &casdat);
     value |= (casdat) ? 0:0x80;
 
     dacWrite(ppi->dac, DAC_CH_MONO, (casdat & 0x01) ? 0 : 255);
@@ -242,7 +243,7 @@ static UInt8 peekB(SviPPI* ppi)
 
 static UInt8 readB(SviPPI* ppi)
 {
-    return boardCaptureUInt8(ppi->row, getKeyState(ppi->row));
+    return boardCaptureUInt8(ppi->board, ppi->row, getKeyState(ppi->row));
 }
 
 static void getDebugInfo(SviPPI* ppi, DbgDevice* dbgDevice)
@@ -257,31 +258,33 @@ static void getDebugInfo(SviPPI* ppi, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 4, 0x9A, DBG_IO_READ,      peek(ppi, 0x9A));
 }
 
-void sviPPICreate(SviJoyIo* joyIO)
+void sviPPICreate(BoardContext* board, SviJoyIo* joyIO)
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     SviPPI* ppi = malloc(sizeof(SviPPI));
 
-    ppi->deviceHandle = deviceManagerRegister(RAM_MAPPER, &callbacks, ppi);
-    ppi->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, langDbgDevPpi(), &dbgCallbacks, ppi);
+    ppi->board = board;
+
+    ppi->deviceHandle = deviceManagerRegister(board, RAM_MAPPER, &callbacks, ppi);
+    ppi->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, langDbgDevPpi(), &dbgCallbacks, ppi);
 
     ppi->joyIO = joyIO;
-    ppi->i8255 = i8255Create(peekA, readA, NULL,
+    ppi->i8255 = i8255Create(board, peekA, readA, NULL,
                              peekB, readB, NULL,
                              NULL,  NULL,  writeCLo,
                              NULL,  NULL,  writeCHi,
                              ppi);
 
-    ppi->keyClick = audioKeyClickCreate(boardGetMixer());
+    ppi->keyClick = audioKeyClickCreate(boardGetMixer(board));
 
-    ppi->dac = dacCreate(boardGetMixer(), DAC_MONO);
+    ppi->dac = dacCreate(boardGetMixer(board), DAC_MONO);
 
-    ioPortRegister(0x98, i8255Read, i8255Write, ppi->i8255); // PPI Port A
-    ioPortRegister(0x99, i8255Read, i8255Write, ppi->i8255); // PPI Port B
-    ioPortRegister(0x96, i8255Read, i8255Write, ppi->i8255); // PPI Port C
-    ioPortRegister(0x97, i8255Read, i8255Write, ppi->i8255); // PPI Mode
-    ioPortRegister(0x9A, readRow, NULL,  ppi); // PPI Return Port C (Low)
+    ioPortRegister(board, 0x98, i8255Read, i8255Write, ppi->i8255); // PPI Port A
+    ioPortRegister(board, 0x99, i8255Read, i8255Write, ppi->i8255); // PPI Port B
+    ioPortRegister(board, 0x96, i8255Read, i8255Write, ppi->i8255); // PPI Port C
+    ioPortRegister(board, 0x97, i8255Read, i8255Write, ppi->i8255); // PPI Mode
+    ioPortRegister(board, 0x9A, readRow, NULL,  ppi); // PPI Return Port C (Low)
 
     reset(ppi);
 }
@@ -31,7 +31,7 @@
 #include "MsxTypes.h"
 #include "SviJoyIo.h"
 
-void sviPPICreate(SviJoyIo* joyIO);
+void sviPPICreate(BoardContext* board, SviJoyIo* joyIO);
 
 #endif
 
@@ -38,6 +38,7 @@
 extern int diskOffset;
 
 struct TC8566AF {
+    BoardContext* board;
     UInt8 drive;
 
     UInt8 mainStatus;
@@ -323,13 +324,13 @@ static void tc8566afCommandPhaseWrite(TC8566AF* tc, UInt8 value)
 		switch (tc->phaseStep++) {
 		case 0:
             tc->status0 &= ~(ST0_DS0 | ST0_DS1 | ST0_IC0 | ST0_IC1);
-            tc->status0 |= (diskPresent(tc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
-                           (diskEnabled(tc->drive) ? 0 : ST0_IC1);
+            tc->status0 |= (diskPresent(tc->board, tc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
+                           (diskEnabled(tc->board, tc->drive) ? 0 : ST0_IC1);
             tc->status3  = (value & (ST3_DS0 | ST3_DS1)) | 
                            (tc->currentTrack == 0        ? ST3_TK0 : 0) | 
-                           (diskGetSides(tc->drive) == 2 ? ST3_HD  : 0) | 
-                           (diskReadOnly(tc->drive)      ? ST3_WP  : 0) |
-                           (diskPresent(tc->drive)       ? ST3_RDY : 0);
+                           (diskGetSides(tc->board, tc->drive) == 2 ? ST3_HD  : 0) | 
+                           (diskReadOnly(tc->board, tc->drive)      ? ST3_WP  : 0) |
+                           (diskPresent(tc->board, tc->drive)       ? ST3_RDY : 0);
 			break;
 		case 1:
             tc->cylinderNumber = value;
@@ -347,10 +348,10 @@ static void tc8566afCommandPhaseWrite(TC8566AF* tc, UInt8 value)
 		case 7:
             if (tc->command == CMD_READ_DATA) {
                 int sectorSize;
-        		DSKE rv = diskReadSector(tc->drive, tc->sectorBuf, tc->sectorNumber, tc->side, 
+        		DSKE rv = diskReadSector(tc->board, tc->drive, tc->sectorBuf, tc->sectorNumber, tc->side, 
                                          tc->currentTrack, 0, &sectorSize);
                 fdcAudioSetReadWrite(tc->fdcAudio);
-                boardSetFdcActive();
+                boardSetFdcActive(tc->board);
                 if (rv == DSKE_NO_DATA) {
                     tc->status0 |= ST0_IC0;
                     tc->status1 |= ST1_ND;
@@ -375,13 +376,13 @@ static void tc8566afCommandPhaseWrite(TC8566AF* tc, UInt8 value)
 		switch (tc->phaseStep++) {
 		case 0:
             tc->status0 &= ~(ST0_DS0 | ST0_DS1 | ST0_IC0 | ST0_IC1);
-            tc->status0 |= (diskPresent(tc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
-                           (diskEnabled(tc->drive) ? 0 : ST0_IC1);
+            tc->status0 |= (diskPresent(tc->board, tc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
+                           (diskEnabled(tc->board, tc->drive) ? 0 : ST0_IC1);
             tc->status3  = (value & (ST3_DS0 | ST3_DS1)) | 
                            (tc->currentTrack == 0        ? ST3_TK0 : 0) | 
-                           (diskGetSides(tc->drive) == 2 ? ST3_HD  : 0) |  
-                           (diskReadOnly(tc->drive)      ? ST3_WP  : 0) |
-                           (diskPresent(tc->drive)       ? ST3_RDY : 0);
+                           (diskGetSides(tc->board, tc->drive) == 2 ? ST3_HD  : 0) |  
+                           (diskReadOnly(tc->board, tc->drive)      ? ST3_WP  : 0) |
+                           (diskPresent(tc->board, tc->drive)       ? ST3_RDY : 0);
 			break;
 		case 1:
             tc->number = value;
@@ -404,13 +405,13 @@ static void tc8566afCommandPhaseWrite(TC8566AF* tc, UInt8 value)
 		switch (tc->phaseStep++) {
 		case 0:
             tc->status0 &= ~(ST0_DS0 | ST0_DS1 | ST0_IC0 | ST0_IC1);
-            tc->status0 |= (diskPresent(tc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
-                           (diskEnabled(tc->drive) ? 0 : ST0_IC1);
+            tc->status0 |= (diskPresent(tc->board, tc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
+                           (diskEnabled(tc->board, tc->drive) ? 0 : ST0_IC1);
             tc->status3  = (value & (ST3_DS0 | ST3_DS1)) | 
                            (tc->currentTrack == 0        ? ST3_TK0 : 0) | 
-                           (diskGetSides(tc->drive) == 2 ? ST3_HD  : 0) |  
-                           (diskReadOnly(tc->drive)      ? ST3_WP  : 0) |
-                           (diskPresent(tc->drive)       ? ST3_RDY : 0);
+                           (diskGetSides(tc->board, tc->drive) == 2 ? ST3_HD  : 0) |  
+                           (diskReadOnly(tc->board, tc->drive)      ? ST3_WP  : 0) |
+                           (diskPresent(tc->board, tc->drive)       ? ST3_RDY : 0);
 			break;
 		case 1: 
             tc->currentTrack = value;
@@ -425,13 +426,13 @@ static void tc8566afCommandPhaseWrite(TC8566AF* tc, UInt8 value)
 		switch (tc->phaseStep++) {
 		case 0: 
             tc->status0 &= ~(ST0_DS0 | ST0_DS1 | ST0_IC0 | ST0_IC1);
-            tc->status0 |= (diskPresent(tc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
-                           (diskEnabled(tc->drive) ? 0 : ST0_IC1);
+            tc->status0 |= (diskPresent(tc->board, tc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
+                           (diskEnabled(tc->board, tc->drive) ? 0 : ST0_IC1);
             tc->status3  = (value & (ST3_DS0 | ST3_DS1)) | 
                            (tc->currentTrack == 0        ? ST3_TK0 : 0) | 
-                           (diskGetSides(tc->drive) == 2 ? ST3_HD  : 0) |  
-                           (diskReadOnly(tc->drive)      ? ST3_WP  : 0) |
-                           (diskPresent(tc->drive)       ? ST3_RDY : 0);
+                           (diskGetSides(tc->board, tc->drive) == 2 ? ST3_HD  : 0) |  
+                           (diskReadOnly(tc->board, tc->drive)      ? ST3_WP  : 0) |
+                           (diskPresent(tc->board, tc->drive)       ? ST3_RDY : 0);
 
             tc->currentTrack = 0;
             tc->status0     |= ST0_SE;
@@ -454,13 +455,13 @@ static void tc8566afCommandPhaseWrite(TC8566AF* tc, UInt8 value)
 		switch (tc->phaseStep++) {
 		case 0:
             tc->status0 &= ~(ST0_DS0 | ST0_DS1 | ST0_IC0 | ST0_IC1);
-            tc->status0 |= (diskPresent(tc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
-                           (diskEnabled(tc->drive) ? 0 : ST0_IC1);
+            tc->status0 |= (diskPresent(tc->board, tc->drive) ? 0 : ST0_DS0) | (value & (ST0_DS0 | ST0_DS1)) |
+                           (diskEnabled(tc->board, tc->drive) ? 0 : ST0_IC1);
             tc->status3  = (value & (ST3_DS0 | ST3_DS1)) | 
                            (tc->currentTrack == 0        ? ST3_TK0 : 0) | 
-                           (diskGetSides(tc->drive) == 2 ? ST3_HD  : 0) |  
-                           (diskReadOnly(tc->drive)      ? ST3_WP  : 0) |
-                           (diskPresent(tc->drive)       ? ST3_RDY : 0);
+                           (diskGetSides(tc->board, tc->drive) == 2 ? ST3_HD  : 0) |  
+                           (diskReadOnly(tc->board, tc->drive)      ? ST3_WP  : 0) |
+                           (diskPresent(tc->board, tc->drive)       ? ST3_RDY : 0);
             
 		    tc->phase       = PHASE_RESULT;
             tc->phaseStep   = 0;
@@ -481,7 +482,7 @@ static void tc8566afExecutionPhaseWrite(TC8566AF* tc, UInt8 value)
 			tc->sectorBuf[tc->sectorOffset++] = value;
             
     		if (tc->sectorOffset == 512) {
-                rv = diskWriteSector(tc->drive, tc->sectorBuf, tc->sectorNumber, tc->side, 
+                rv = diskWriteSector(tc->board, tc->drive, tc->sectorBuf, tc->sectorNumber, tc->side, 
                                      tc->currentTrack, 0);
                 if (!rv) {
                     tc->status1 |= ST1_NW;
@@ -489,7 +490,7 @@ static void tc8566afExecutionPhaseWrite(TC8566AF* tc, UInt8 value)
 
                 fdcAudioSetReadWrite(tc->fdcAudio);
 
-                boardSetFdcActive();
+                boardSetFdcActive(tc->board);
 
                 tc->phase       = PHASE_RESULT;
                 tc->phaseStep   = 0;
@@ -505,12 +506,12 @@ static void tc8566afExecutionPhaseWrite(TC8566AF* tc, UInt8 value)
             break;
         case 1:
             memset(tc->sectorBuf, tc->fillerByte, 512);
-            rv = diskWrite(tc->drive, tc->sectorBuf, tc->sectorNumber - 1 +
-                      diskGetSectorsPerTrack(tc->drive) * (tc->currentTrack * diskGetSides(tc->drive) + value));
+            rv = diskWrite(tc->board, tc->drive, tc->sectorBuf, tc->sectorNumber - 1 +
+                      diskGetSectorsPerTrack(tc->board, tc->drive) * (tc->currentTrack * diskGetSides(tc->board, tc->drive) + value));
             if (!rv) {
                 tc->status1 |= ST1_NW;
             }
-            boardSetFdcActive();
+            boardSetFdcActive(tc->board);
             break;
         case 2:
             tc->sectorNumber = value;
@@ -526,11 +527,12 @@ static void tc8566afExecutionPhaseWrite(TC8566AF* tc, UInt8 value)
 	}
 }
 
-TC8566AF* tc8566afCreate()
+TC8566AF* tc8566afCreate(BoardContext* board)
 {
-    TC8566AF* tc = malloc(sizeof(TC8566AF));
+    TC8566AF* tc = calloc(1, sizeof(TC8566AF));
 
-    tc->fdcAudio = fdcAudioCreate(FA_PANASONIC);
+    tc->board = board;
+    tc->fdcAudio = fdcAudioCreate(board, FA_PANASONIC);
 
     tc8566afReset(tc);
 
@@ -545,8 +547,10 @@ void tc8566afDestroy(TC8566AF* tc)
 
 void tc8566afReset(TC8566AF* tc)
 {
+    BoardContext* board = tc->board;
     FdcAudio* fdcAudio = tc->fdcAudio;
     memset(tc, 0, sizeof(TC8566AF));
+    tc->board = board;
     tc->fdcAudio = fdcAudio;
 
     tc->mainStatus = STM_NDM | STM_RQM;
@@ -562,7 +566,7 @@ UInt8 tc8566afReadRegister(TC8566AF* tc, UInt8 reg)
     switch (reg) {
     case 4: 
         if (~tc->mainStatus & STM_RQM) {
-            UInt32 elapsed = boardSystemTime() - tc->dataTransferTime;
+            UInt32 elapsed = boardSystemTime(tc->board) - tc->dataTransferTime;
             if (elapsed > boardFrequency() * 60 / 1000000) {
                 tc->mainStatus |= STM_RQM;
             } 
@@ -574,7 +578,7 @@ UInt8 tc8566afReadRegister(TC8566AF* tc, UInt8 reg)
         switch (tc->phase) {            
 		case PHASE_DATATRANSFER:
             reg = tc8566afExecutionPhaseRead(tc);
-            tc->dataTransferTime = boardSystemTime();
+            tc->dataTransferTime = boardSystemTime(tc->board);
             tc->mainStatus &= ~STM_RQM;
             return reg;
 
@@ -606,10 +610,10 @@ void tc8566afWriteRegister(TC8566AF* tc, UInt8 reg, UInt8 value)
 {
     switch (reg) {
 	case 2:
-        fdcAudioSetMotor(tc->fdcAudio, ((value & 0x10) && diskEnabled(0)) || ((value & 0x20) && diskEnabled(1)));
+        fdcAudioSetMotor(tc->fdcAudio, ((value & 0x10) && diskEnabled(tc->board, 0)) || ((value & 0x20) && diskEnabled(tc->board, 1)));
 
-        ledSetFdd1((value & 0x10) && diskEnabled(0)); /* 10:10 2004/10/09 FDD LED PATCH */ 
-        ledSetFdd2((value & 0x20) && diskEnabled(1)); /* 10:10 2004/10/09 FDD LED PATCH */ 
+        ledSetFdd1((value & 0x10) && diskEnabled(tc->board, 0)); /* 10:10 2004/10/09 FDD LED PATCH */ 
+        ledSetFdd2((value & 0x20) && diskEnabled(tc->board, 1)); /* 10:10 2004/10/09 FDD LED PATCH */ 
 
         tc->drive = value & 0x03;
         break;
@@ -626,7 +630,7 @@ void tc8566afWriteRegister(TC8566AF* tc, UInt8 reg, UInt8 value)
             
 		case PHASE_DATATRANSFER:
             tc8566afExecutionPhaseWrite(tc, value);
-            tc->dataTransferTime = boardSystemTime();
+            tc->dataTransferTime = boardSystemTime(tc->board);
             tc->mainStatus &= ~STM_RQM;
         	break;
         }
@@ -636,12 +640,12 @@ void tc8566afWriteRegister(TC8566AF* tc, UInt8 reg, UInt8 value)
 
 int tc8566afDiskChanged(TC8566AF* tc, int drive)
 {
-    return diskChanged(drive);
+    return diskChanged(tc->board, drive);
 }
 
 void tc8566afLoadState(TC8566AF* tc)
 {
-    SaveState* state = saveStateOpenForRead("tc8566af");
+    SaveState* state = saveStateOpenForRead(tc->board, "tc8566af");
 
     tc->drive               = (UInt8) saveStateGet(state, "drive",              0);
     tc->mainStatus          = (UInt8) saveStateGet(state, "mainStatus",         STM_NDM | STM_RQM);
@@ -669,7 +673,7 @@ void tc8566afLoadState(TC8566AF* tc)
 
 void tc8566afSaveState(TC8566AF* tc)
 {
-    SaveState* state = saveStateOpenForWrite("tc8566af");
+    SaveState* state = saveStateOpenForWrite(tc->board, "tc8566af");
 
     saveStateSet(state, "drive",              tc->drive);
     saveStateSet(state, "mainStatus",         tc->mainStatus);
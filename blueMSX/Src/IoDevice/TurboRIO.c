@@ -40,6 +40,7 @@
 
 
 typedef struct TurboRIO {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
 } TurboRIO;
@@ -57,10 +58,10 @@ static UInt8 read(TurboRIO* turboRIO, UInt16 ioPort)
 
 static void destroy(TurboRIO* turboRIO)
 {
-    ioPortUnregister(0xa7);
+    ioPortUnregister(turboRIO->board, 0xa7);
 
-    debugDeviceUnregister(turboRIO->debugHandle);
-    deviceManagerUnregister(turboRIO->deviceHandle);
+    debugDeviceUnregister(turboRIO->board, turboRIO->debugHandle);
+    deviceManagerUnregister(turboRIO->board, turboRIO->deviceHandle);
 
     free(turboRIO);
 }
@@ -73,17 +74,19 @@ static void getDebugInfo(TurboRIO* turboRIO, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 0, 0xa7, DBG_IO_READWRITE, read(turboRIO, 0xa7));
 }
 
-int romMapperTurboRIOCreate()
+int romMapperTurboRIOCreate(BoardContext* board)
 {
     DeviceCallbacks callbacks = { destroy, NULL, NULL, NULL };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
 
     TurboRIO* turboRIO = (TurboRIO*)calloc(1, sizeof(TurboRIO));
 
-    turboRIO->deviceHandle = deviceManagerRegister(ROM_TURBORIO, &callbacks, turboRIO);
-    turboRIO->debugHandle = debugDeviceRegister(DBGTYPE_PORT, langDbgDevTrPause(), &dbgCallbacks, turboRIO);
+    turboRIO->board = board;
 
-    ioPortRegister(0xa7, read, write, turboRIO);
+    turboRIO->deviceHandle = deviceManagerRegister(board, ROM_TURBORIO, &callbacks, turboRIO);
+    turboRIO->debugHandle = debugDeviceRegister(board, DBGTYPE_PORT, langDbgDevTrPause(), &dbgCallbacks, turboRIO);
+
+    ioPortRegister(board, 0xa7, read, write, turboRIO);
 
     return 1;
 }
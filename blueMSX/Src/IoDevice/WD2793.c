@@ -36,6 +36,7 @@
 #include <string.h>
 
 struct WD2793 {
+	BoardContext* board;
 	UInt8  regStatus;
 	UInt8  regCommand;
 	UInt8  regSector;
@@ -104,9 +105,9 @@ static void wd2793ReadSector(WD2793* wd)
     int sectorSize = 0;
 
     if (wd->drive >= 0) {
-		rv = diskReadSector(wd->drive, wd->sectorBuf, wd->regSector, wd->diskSide, wd->diskTrack, wd->diskDensity, &sectorSize);
+		rv = diskReadSector(wd->board, wd->drive, wd->sectorBuf, wd->regSector, wd->diskSide, wd->diskTrack, wd->diskDensity, &sectorSize);
         fdcAudioSetReadWrite(wd->fdcAudio);
-        boardSetFdcActive();
+        boardSetFdcActive(wd->board);
     }
     if (rv == DSKE_NO_DATA || wd->diskTrack != wd->regTrack) {
 	    wd->regStatus |= ST_RECORD_NOT_FOUND;
@@ -120,7 +121,7 @@ static void wd2793ReadSector(WD2793* wd)
 		wd->sectorOffset    = 0;
 		wd->dataRequest     = 0;
         wd->dataReady       = 0;
-        wd->dataRequsetTime = boardSystemTime();
+        wd->dataRequsetTime = boardSystemTime(wd->board);
         wd->dataAvailable = sectorSize;
     }
 }
@@ -130,7 +131,7 @@ static void sync(WD2793* wd)
     if (wd->step) {
         const UInt64 timePerStep[4] = { 200, 100, 66, 50 };
 
-        UInt32 steps = (UInt32)(timePerStep[wd->regCommand & 3] * (boardSystemTime() - wd->stepTime) / boardFrequency());
+        UInt32 steps = (UInt32)(timePerStep[wd->regCommand & 3] * (boardSystemTime(wd->board) - wd->stepTime) / boardFrequency());
 
         while (wd->curStep < steps) {
             wd->curStep++;
@@ -138,7 +139,7 @@ static void sync(WD2793* wd)
 		        wd->regTrack += wd->stepDirection;
             }
 
-            if (diskEnabled(wd->drive) && 
+            if (diskEnabled(wd->board, wd->drive) && 
                 ((wd->stepDirection == -1 && wd->diskTrack > 0) || wd->stepDirection == 1)) {
 		        wd->diskTrack += wd->stepDirection;
             }
@@ -148,7 +149,7 @@ static void sync(WD2793* wd)
                 wd->step       = 0;
                 break;
             } 
-            if (wd->stepDirection == -1 && diskEnabled(wd->drive) && wd->diskTrack == 0) {
+            if (wd->stepDirection == -1 && diskEnabled(wd->board, wd->drive) && wd->diskTrack == 0) {
                 wd->regTrack   = 0;
 	            wd->intRequest = 1;
 	            wd->regStatus &= ~ST_BUSY;
@@ -187,7 +188,7 @@ static void commandType2(WD2793* wd)
     wd->headLoaded  = 1;
 	wd->dataRequest = 0;
 
-	if (!diskPresent(wd->drive)) {
+	if (!diskPresent(wd->board, wd->drive)) {
 	    wd->intRequest  = 1;
 	    wd->regStatus &= ~ST_BUSY;
         return;
@@ -203,7 +204,7 @@ static void commandType2(WD2793* wd)
 	case CMD_WRITE_SECTORS:
 		wd->sectorOffset  = 0;
 		wd->dataRequest   = 1;
-        wd->dataAvailable = diskGetSectorSize(wd->drive, wd->diskSide, wd->diskTrack, wd->diskDensity);
+        wd->dataAvailable = diskGetSectorSize(wd->board, wd->drive, wd->diskSide, wd->diskTrack, wd->diskDensity);
 		break;
 	}
 }
@@ -216,7 +217,7 @@ static void commandType3(WD2793* wd)
 	wd->dataRequest = 0;
 	wd->dataReady  = 0;
 
-	if (!diskPresent(wd->drive)) {
+	if (!diskPresent(wd->board, wd->drive)) {
 	    wd->intRequest = 1;
 	    wd->regStatus &= ~ST_BUSY;
         return;
@@ -274,7 +275,7 @@ static void commandType1(WD2793* wd)
 
     wd->step     = 1;
     wd->curStep  = 0;
-    wd->stepTime = boardSystemTime();
+    wd->stepTime = boardSystemTime(wd->board);
 }
 
 int wd2793GetSide(WD2793* wd)
@@ -329,12 +330,12 @@ void wd2793SetMotor(WD2793* wd, int motorOn)
         break;
     }
 
-    fdcAudioSetMotor(wd->fdcAudio, diskEnabled(wd->drive));
+    fdcAudioSetMotor(wd->fdcAudio, diskEnabled(wd->board, wd->drive));
 }
 
 int wd2793DiskChanged(WD2793* wd, int drive)
 {
-    return diskChanged(drive);
+    return diskChanged(wd->board, drive);
 }
 
 int wd2793PeekDataRequest(WD2793* wd)
@@ -342,7 +343,7 @@ int wd2793PeekDataRequest(WD2793* wd)
     int dataRequest = wd->dataRequest;
 
 	if (((wd->regCommand & 0xF0) == 0xF0) && ((wd->regStatus & ST_BUSY) || wd->dataReady)) {
-        UInt32 pulses = (boardSystemTime() - wd->dataRequsetTime) / (boardFrequency() / 5);
+        UInt32 pulses = (boardSystemTime(wd->board) - wd->dataRequsetTime) / (boardFrequency() / 5);
 		if (wd->dataReady) {
 			dataRequest = 1;
 		} 
@@ -352,7 +353,7 @@ int wd2793PeekDataRequest(WD2793* wd)
 	}
 
     if ((wd->regCommand & 0xe0) == 0x80 && (wd->regStatus & ST_BUSY)) {
-        UInt32 pulses = (boardSystemTime() - wd->dataRequsetTime) / (boardFrequency() / 25);
+        UInt32 pulses = (boardSystemTime(wd->board) - wd->dataRequsetTime) / (boardFrequency() / 25);
 		if (wd->dataReady) {
 			dataRequest = 1;
 		}
@@ -365,7 +366,7 @@ int wd2793GetDataRequest(WD2793* wd)
 {
     sync(wd);
 	if (((wd->regCommand & 0xF0) == 0xF0) && ((wd->regStatus & ST_BUSY) || wd->dataReady)) {
-        UInt32 pulses = (boardSystemTime() - wd->dataRequsetTime) / (boardFrequency() / 5);
+        UInt32 pulses = (boardSystemTime(wd->board) - wd->dataRequsetTime) / (boardFrequency() / 5);
 		if (wd->dataReady) {
 			wd->dataRequest = 1;
 		} 
@@ -382,7 +383,7 @@ int wd2793GetDataRequest(WD2793* wd)
 	}
 
     if ((wd->regCommand & 0xe0) == 0x80 && (wd->regStatus & ST_BUSY)) {
-        UInt32 pulses = (boardSystemTime() - wd->dataRequsetTime) / (boardFrequency() / 25);
+        UInt32 pulses = (boardSystemTime(wd->board) - wd->dataRequsetTime) / (boardFrequency() / 25);
 		if (wd->dataReady) {
 			wd->dataRequest = 1;
 		}
@@ -488,13 +489,13 @@ void wd2793SetDataReg(WD2793* wd, UInt8 value)
 		if (wd->dataAvailable == 0) {
             int rv = 0;
             if (wd->drive >= 0) {
-                wd->dataRequsetTime = boardSystemTime();
-                rv = diskWriteSector(wd->drive, wd->sectorBuf, wd->regSector, wd->diskSide, wd->diskTrack, wd->diskDensity);
+                wd->dataRequsetTime = boardSystemTime(wd->board);
+                rv = diskWriteSector(wd->board, wd->drive, wd->sectorBuf, wd->regSector, wd->diskSide, wd->diskTrack, wd->diskDensity);
                 fdcAudioSetReadWrite(wd->fdcAudio);
-                boardSetFdcActive();
+                boardSetFdcActive(wd->board);
             }
 			wd->sectorOffset  = 0;
-            wd->dataAvailable = diskGetSectorSize(wd->drive, wd->diskSide, wd->diskTrack, wd->diskDensity);
+            wd->dataAvailable = diskGetSectorSize(wd->board, wd->drive, wd->diskSide, wd->diskTrack, wd->diskDensity);
 			if (!rv || wd->diskTrack != wd->regTrack) {
 				wd->regStatus |= ST_RECORD_NOT_FOUND;
 	            wd->intRequest = 1;
@@ -520,9 +521,9 @@ UInt8 wd2793PeekStatusReg(WD2793* wd)
 
 	if (((wd->regCommand & 0x80) == 0) || ((wd->regCommand & 0xf0) == 0xd0)) {
 		regStatus &= ~(ST_INDEX | ST_TRACK00 | ST_HEAD_LOADED | ST_WRITE_PROTECTED);
-    	if (diskEnabled(wd->drive)) {
-            if (diskPresent(wd->drive)) {
-                if ((UInt64)160 * boardSystemTime() / boardFrequency() & 0x1e) {
+    	if (diskEnabled(wd->board, wd->drive)) {
+            if (diskPresent(wd->board, wd->drive)) {
+                if ((UInt64)160 * boardSystemTime(wd->board) / boardFrequency() & 0x1e) {
 			        regStatus |= ST_INDEX;
 		        }
             }
@@ -546,7 +547,7 @@ UInt8 wd2793PeekStatusReg(WD2793* wd)
 		}
 	}
 
-	if (diskPresent(wd->drive)) {
+	if (diskPresent(wd->board, wd->drive)) {
 		regStatus &= ~ST_NOT_READY;
 	} 
     else {
@@ -561,9 +562,9 @@ UInt8 wd2793GetStatusReg(WD2793* wd)
     sync(wd);
 	if (((wd->regCommand & 0x80) == 0) || ((wd->regCommand & 0xf0) == 0xd0)) {
 		wd->regStatus &= ~(ST_INDEX | ST_TRACK00 | ST_HEAD_LOADED | ST_WRITE_PROTECTED);
-    	if (diskEnabled(wd->drive)) {
-            if (diskPresent(wd->drive)) {
-                if ((UInt64)160 * boardSystemTime() / boardFrequency() & 0x1e) {
+    	if (diskEnabled(wd->board, wd->drive)) {
+            if (diskPresent(wd->board, wd->drive)) {
+                if ((UInt64)160 * boardSystemTime(wd->board) / boardFrequency() & 0x1e) {
 			        wd->regStatus |= ST_INDEX;
 		        }
             }
@@ -587,7 +588,7 @@ UInt8 wd2793GetStatusReg(WD2793* wd)
 		}
 	}
 
-	if (diskPresent(wd->drive)) {
+	if (diskPresent(wd->board, wd->drive)) {
 		wd->regStatus &= ~ST_NOT_READY;
 	} 
     else {
@@ -671,11 +672,12 @@ void wd2793Reset(WD2793* wd)
     fdcAudioReset(wd->fdcAudio);
 }
 
-WD2793* wd2793Create(Wd2793FdcType type)
+WD2793* wd2793Create(BoardContext* board, Wd2793FdcType type)
 {
-    WD2793* wd = malloc(sizeof(WD2793));
+    WD2793* wd = calloc(1, sizeof(WD2793));
 
-    wd->fdcAudio = fdcAudioCreate(FA_WESTERN_DIGITAL);
+    wd->board = board;
+    wd->fdcAudio = fdcAudioCreate(board, FA_WESTERN_DIGITAL);
 
     wd->type = type;
 
@@ -692,7 +694,7 @@ void wd2793Destroy(WD2793* wd)
 
 void wd2793LoadState(WD2793* wd)
 {
-    SaveState* state = saveStateOpenForRead("wd2793");
+    SaveState* state = saveStateOpenForRead(wd->board, "wd2793");
 
     wd->step            =         saveStateGet(state, "step",            0);
     wd->curStep         =         saveStateGet(state, "curStep",         0);
@@ -727,7 +729,7 @@ void wd2793LoadState(WD2793* wd)
 
 void wd2793SaveState(WD2793* wd)
 {
-    SaveState* state = saveStateOpenForWrite("wd2793");
+    SaveState* state = saveStateOpenForWrite(wd->board, "wd2793");
 
     saveStateSet(state, "step",            wd->step);
     saveStateSet(state, "curStep",         wd->curStep);
@@ -39,7 +39,7 @@ typedef enum
 
 typedef struct WD2793 WD2793;
 
-WD2793* wd2793Create(Wd2793FdcType type);
+WD2793* wd2793Create(BoardContext* board, Wd2793FdcType type);
 void    wd2793Destroy(WD2793* tc);
 void    wd2793Reset(WD2793* tc);
 
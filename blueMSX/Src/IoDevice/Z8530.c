@@ -32,6 +32,7 @@
 
 struct Z8530
 {
+    BoardContext* board;
     void* ref;
     int mode;
     int reg;
@@ -145,14 +146,14 @@ void z8530Write(Z8530* z8530, UInt16 port, UInt8 value)
 
 void z8530SaveState(Z8530* z8530)
 {
-    SaveState* state = saveStateOpenForWrite("z8530");
+    SaveState* state = saveStateOpenForWrite(z8530->board, "z8530");
 
     saveStateClose(state);
 }
 
 void z8530LoadState(Z8530* z8530)
 {
-    SaveState* state = saveStateOpenForRead("z8530");
+    SaveState* state = saveStateOpenForRead(z8530->board, "z8530");
 
     saveStateClose(state);
 }
@@ -166,9 +167,11 @@ void z8530Destroy(Z8530* z8530)
     free(z8530);
 }
 
-Z8530* z8530Create(void* ref)
+Z8530* z8530Create(BoardContext* board, void* ref)
 {
     Z8530* z8530 = calloc(1, sizeof(Z8530));
+
+    z8530->board = board;
     z8530->ref = ref;
 
     return z8530;
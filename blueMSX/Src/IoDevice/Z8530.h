@@ -41,6 +41,6 @@ void z8530SaveState(Z8530* z8530);
 void z8530Reset(Z8530* z8530);
 void z8530Destroy(Z8530* z8530); 
 
-Z8530* z8530Create(void* ref);
+Z8530* z8530Create(BoardContext* board, void* ref);
 
 #endif
@@ -42,6 +42,7 @@ typedef UInt8 (*ReadCb)(void*);
 typedef void  (*WriteCb)(void*, UInt8);
 
 typedef struct {
+    BoardContext* board;
     int state;
 
     UInt8 reg_a;
@@ -117,31 +118,32 @@ static void ft245UsbHostReset(Ft245UsbHost* host)
 
 static void onTimer(Ft245UsbHost* host, UInt32 time)
 {
-    if (diskChanged(host->driveId)) {
+    if (diskChanged(host->board, host->driveId)) {
         char sectorBuffer[512];
         
-        _diskRead2(host->driveId, sectorBuffer, 1, 1);
+        _diskRead2(host->board, host->driveId, sectorBuffer, 1, 1);
 
         host->writeCb(host->ref, 0x00);
         host->writeCb(host->ref, 0x00);
         host->writeCb(host->ref, sectorBuffer[0] & 255);
     }
     
-    boardTimerAdd(host->timer, boardSystemTime() + boardFrequency());
+    boardTimerAdd(host->timer, boardSystemTime(host->board) + boardFrequency());
 }
 
-static Ft245UsbHost* ft245UsbHostCreate(int driveId, ReadCb readCb, WriteCb writeCb, void* ref)
+static Ft245UsbHost* ft245UsbHostCreate(BoardContext* board, int driveId, ReadCb readCb, WriteCb writeCb, void* ref)
 {
     Ft245UsbHost* host = calloc(1, sizeof(Ft245UsbHost));
 
+    host->board = board;
     host->driveId = diskGetUsbDriveId(driveId, 0);
 
     host->readCb  = readCb;
     host->writeCb = writeCb;
     host->ref     = ref;
 
-    host->timer = boardTimerCreate(onTimer, host);
-    boardTimerAdd(host->timer, boardSystemTime() + boardFrequency());
+    host->timer = boardTimerCreate(host->board, onTimer, host);
+    boardTimerAdd(host->timer, boardSystemTime(host->board) + boardFrequency());
 
     ft245UsbHostReset(host);
 
@@ -227,7 +229,7 @@ static void ft245UsbHostDskio(Ft245UsbHost* host)
        
     if (host->reg_f & 1) {
         // diskio write
-        if (diskReadOnly(host->driveId)) {
+        if (diskReadOnly(host->board, host->driveId)) {
             ft245UsbHostDiskioWriteExit(host, 1, ERR_WRITEPROTECTED);
             host->state = ST_WAIT;
             return;
@@ -270,7 +272,7 @@ static void ft245UsbHostDskio(Ft245UsbHost* host)
     } 
     else {
         // diskio read
-        int rv = _diskRead2(host->driveId, host->transferBuffer, startSector, sectorAmount);
+        int rv = _diskRead2(host->board, host->driveId, host->transferBuffer, startSector, sectorAmount);
 
         printf("Reading sector %d - %d, %s\n", startSector, sectorAmount, (rv ? "OK" : "FAILED"));
 
@@ -315,7 +317,7 @@ static void ft245UsbHostChoice(Ft245UsbHost* host)
 
 static void ft245UsbHostDskfmt(Ft245UsbHost* host) 
 {
-    if (diskReadOnly(host->driveId)) {
+    if (diskReadOnly(host->board, host->driveId)) {
         ft245UsbHostDiskioWriteExit(host, 1, ERR_WRITEPROTECTED);
         host->state = ST_WAIT;
         return;
@@ -487,7 +489,7 @@ void ft245UsbHostTrigger(Ft245UsbHost* host)
             host->writeBuffer[host->writePointer++] = host->readCb(host->ref);
            
             if (host->writePointer == size) {
-                _diskWrite2(host->driveId, host->writeBuffer, startSector, host->reg_b);
+                _diskWrite2(host->board, host->driveId, host->writeBuffer, startSector, host->reg_b);
                 ft245UsbHostDiskioWriteExit(host, 0, 0);
                 host->state = ST_WAIT;
             }
@@ -591,6 +593,7 @@ static UInt8 fifoFront(Fifo* fifo)
 
 typedef struct FT245
 {
+    BoardContext* board;
     Fifo* sendFifo;
     Fifo* recvFifo;
     UInt32 dataRecvTime;
@@ -621,19 +624,20 @@ static UInt8 hostRead(FT245* ft)
 static void hostSend(FT245* ft, UInt8 value)
 {
     if (fifoIsEmpty(ft->recvFifo)) {
-        ft->dataRecvTime = boardSystemTime();
+        ft->dataRecvTime = boardSystemTime(ft->board);
     }
     fifoPush(ft->recvFifo, value);
 }
 
-FT245* ft245Create(int driveId)
+FT245* ft245Create(BoardContext* board, int driveId)
 {
     FT245* ft = malloc(sizeof(FT245));
 
+    ft->board = board;
     ft->recvFifo = fifoCreate(65536);
     ft->sendFifo = fifoCreate(65536);
 
-    ft->usbHost = ft245UsbHostCreate(driveId, hostRead, hostSend, ft);
+    ft->usbHost = ft245UsbHostCreate(board, driveId, hostRead, hostSend, ft);
 
     return ft;
 }
@@ -654,7 +658,7 @@ void ft245Reset(FT245* ft)
 
 UInt8 ft245Peek(FT245* ft)
 {
-    UInt32 elapsed = boardSystemTime() - ft->dataRecvTime;
+    UInt32 elapsed = boardSystemTime(ft->board) - ft->dataRecvTime;
     if (elapsed < boardFrequency() / (1000000 / 1250)) {
         return 0xff;
     } 
@@ -665,7 +669,7 @@ UInt8 ft245Read(FT245* ft)
 {
     UInt8 value;
 
-    UInt32 elapsed = boardSystemTime() - ft->dataRecvTime;
+    UInt32 elapsed = boardSystemTime(ft->board) - ft->dataRecvTime;
     if (elapsed < boardFrequency() / (1000000 / 1250)) {
         return 0xff;
     } 
@@ -32,7 +32,7 @@
 
 typedef struct FT245 FT245;
 
-FT245* ft245Create(int driveId);
+FT245* ft245Create(BoardContext* board, int driveId);
 void ft245Destroy(FT245* ft);
 void ft245Reset(FT245* ft);
 
@@ -41,6 +41,7 @@
 
 typedef struct RTL8019
 {
+    BoardContext* board;
     UInt8  regCr;
     UInt8  regPstart;
     UInt8  regPstop;
@@ -202,16 +203,17 @@ void rtl8019LoadState(RTL8019* rtl)
 {
 }
 
-RTL8019* rtl8019Create()
+RTL8019* rtl8019Create(BoardContext* board)
 {
     RTL8019* rtl = malloc(sizeof(RTL8019));
     int i;
 
+    rtl->board = board;
     rtl->archInit = 0;
-    rtl->timerTx = boardTimerCreate(onTxTimer, rtl);
-    rtl->timerRx = boardTimerCreate(onRxTimer, rtl);
+    rtl->timerTx = boardTimerCreate(rtl->board, onTxTimer, rtl);
+    rtl->timerRx = boardTimerCreate(rtl->board, onRxTimer, rtl);
 
-    boardTimerAdd(rtl->timerRx, boardSystemTime() + 1);
+    boardTimerAdd(rtl->timerRx, boardSystemTime(rtl->board) + 1);
 
     rtl8019Reset(rtl);
 
@@ -367,7 +369,7 @@ static void writeCr(RTL8019* rtl, UInt8 value)
                 archEthSendPacket(&SAFEMEM(rtl, rtl->regTpsr * 256), rtl->regTbcr);
             }
 
-            rtl->timeTx = boardSystemTime() + (192 + 8 * (int)rtl->regTbcr + 99) / 100 * boardFrequency() / 100000;
+            rtl->timeTx = boardSystemTime(rtl->board) + (192 + 8 * (int)rtl->regTbcr + 99) / 100 * boardFrequency() / 100000;
             boardTimerAdd(rtl->timerTx, rtl->timeTx);
             break;
         case TCR_LB_INTERN:
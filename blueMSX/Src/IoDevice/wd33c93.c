@@ -129,6 +129,7 @@
 
 struct WD33C93
 {
+    BoardContext* board;
     int         myId;
     int         targetId;
     UInt8       latch;
@@ -523,14 +524,14 @@ static SCSIDEVICE* wd33c93ScsiDevCreate(WD33C93* wd33c93, int id)
     int diskId, mode, type;
 
     diskId = diskGetHdDriveId(wd33c93->hdId, id);
-    if (diskIsCdrom(diskId)) {
+    if (diskIsCdrom(wd33c93->board, diskId)) {
         mode = MODE_SCSI1 | MODE_UNITATTENTION | MODE_REMOVABLE | MODE_NOVAXIS;
         type = SDT_CDROM;
     } else {
         mode = MODE_SCSI1 | MODE_UNITATTENTION | MODE_FDS120 | MODE_REMOVABLE | MODE_NOVAXIS;
         type = SDT_DirectAccess;
     }
-    return scsiDeviceCreate(id, diskId, wd33c93->buffer, NULL, type, mode,
+    return scsiDeviceCreate(wd33c93->board, id, diskId, wd33c93->buffer, NULL, type, mode,
                            (CdromXferCompCb)wd33c93XferCb, wd33c93);
 #else
     SCSIDEVICE* dev;
@@ -544,17 +545,18 @@ static SCSIDEVICE* wd33c93ScsiDevCreate(WD33C93* wd33c93, int id)
         mode = MODE_SCSI1 | MODE_UNITATTENTION | MODE_REMOVABLE | MODE_NOVAXIS;
         type = SDT_CDROM;
     }
-    dev = scsiDeviceCreate(id, diskGetHdDriveId(wd33c93->hdId, id),
+    dev = scsiDeviceCreate(wd33c93->board, id, diskGetHdDriveId(wd33c93->hdId, id),
             wd33c93->buffer, NULL, type, mode, (CdromXferCompCb)wd33c93XferCb, wd33c93);
     return dev;
 #endif
 }
 
-WD33C93* wd33c93Create(int hdId)
+WD33C93* wd33c93Create(BoardContext* board, int hdId)
 {
     WD33C93* wd33c93 = malloc(sizeof(WD33C93));
     int i;
 
+    wd33c93->board = board;
     scsiLog = scsiDeviceLogCreate();
     wd33c93->buffer  = archCdromBufferMalloc(BUFFER_SIZE);
     wd33c93->maxDev  = 8;
@@ -574,7 +576,7 @@ WD33C93* wd33c93Create(int hdId)
 
 void  wd33c93SaveState(WD33C93* wd33c93)
 {
-    SaveState* state = saveStateOpenForWrite("wd33c93");
+    SaveState* state = saveStateOpenForWrite(wd33c93->board, "wd33c93");
     int i;
 
     saveStateSet(state, "myId",         wd33c93->myId);
@@ -601,7 +603,7 @@ void  wd33c93SaveState(WD33C93* wd33c93)
 
 void  wd33c93LoadState(WD33C93* wd33c93)
 {
-    SaveState* state = saveStateOpenForRead("wd33c93");
+    SaveState* state = saveStateOpenForRead(wd33c93->board, "wd33c93");
     int old = wd33c93->maxDev;
     int i;
 
@@ -32,7 +32,7 @@
 
 typedef struct WD33C93 WD33C93;
 
-WD33C93* wd33c93Create(int hdId);
+WD33C93* wd33c93Create(BoardContext* board, int hdId);
 void	 wd33c93Reset(WD33C93* wd33c93, int scsireset);
 void     wd33c93Destroy(WD33C93* wd33c93);
 
@@ -0,0 +1,116 @@
+/*****************************************************************************
+** $Source: /cygdrive/d/Private/_SVNROOT/bluemsx/blueMSX/Src/Linux/blueMSXlite/HeadlessBench.c,v $
+**
+** $Revision: 1.1 $
+**
+** $Date: 2026-10-18 12:00:00 $
+**
+** More info: http://www.bluemsx.com
+**
+** Copyright (C) 2003-2004 Daniel Vik, Tomas Karlsson
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+******************************************************************************
+*/
+#include "HeadlessBench.h"
+#include <stdio.h>
+#include <string.h>
+
+#define BENCH_RUNS 3
+
+const HeadlessBench headlessBenches[] = {
+    // The CPU time is kept in a 32 bit count of the master clock
+    { "-cpubench", "<seconds>",
+      { "Run <seconds> of emulated CPU time with each CPU",
+        "core and print the speed in MIPS" },
+      90, cpuBench },
+    { "-iobench", "<seconds>",
+      { "Run <seconds> of emulated VRAM uploads with OTIR",
+        "and print the port write rate" },
+      90, ioBench },
+    { "-cputest", "<tests>",
+      { "Run the first <tests> tests of the instruction",
+        "exerciser with each CPU core and memory access",
+        "path and compare with the memory callbacks" },
+      0xffffffff, cpuTest },
+    { "-videobench", "<frames>",
+      { "Render <frames> frames with each set of video",
+        "kernels and filter thread count, check them",
+        "against the generic kernels and print Mpixel/s" },
+      0xffffffff, videoBench },
+    { "-flipbench", "<frames>",
+      { "Draw and flip <frames> frames while another",
+        "thread flips the view frame, and check that",
+        "no torn frame is seen" },
+      0xffffffff, flipBench },
+    { NULL }
+};
+
+const HeadlessBench* headlessBenchFind(const char* option)
+{
+    const HeadlessBench* bench;
+
+    for (bench = headlessBenches; bench->option != NULL; bench++) {
+        if (strcmp(bench->option, option) == 0) {
+            return bench;
+        }
+    }
+    return NULL;
+}
+
+int headlessBenchRun(const HeadlessBench* bench, UInt32 count)
+{
+    return bench->run(count < bench->maxCount ? count : bench->maxCount);
+}
+
+void headlessBenchUsage()
+{
+    const HeadlessBench* bench;
+
+    for (bench = headlessBenches; bench->option != NULL; bench++) {
+        printf("       blueMSXheadless %s %s\n", bench->option, bench->argument);
+    }
+}
+
+void headlessBenchHelp()
+{
+    const HeadlessBench* bench;
+
+    for (bench = headlessBenches; bench->option != NULL; bench++) {
+        int i;
+
+        printf("  %s %s\n", bench->option, bench->argument);
+        for (i = 0; i < 3 && bench->help[i] != NULL; i++) {
+            printf("                  %s\n", bench->help[i]);
+        }
+    }
+}
+
+double headlessBenchBest(double (*run)(void* ref), void* ref)
+{
+    double best = 0;
+    int i;
+
+    for (i = 0; i < BENCH_RUNS; i++) {
+        double rate = run(ref);
+        if (rate > best) {
+            best = rate;
+        }
+    }
+    return best;
+}
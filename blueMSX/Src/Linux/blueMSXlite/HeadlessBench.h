@@ -0,0 +1,83 @@
+/*****************************************************************************
+** $Source: /cygdrive/d/Private/_SVNROOT/bluemsx/blueMSX/Src/Linux/blueMSXlite/HeadlessBench.h,v $
+**
+** $Revision: 1.1 $
+**
+** $Date: 2026-10-18 12:00:00 $
+**
+** More info: http://www.bluemsx.com
+**
+** Copyright (C) 2003-2004 Daniel Vik, Tomas Karlsson
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+******************************************************************************
+*/
+#ifndef HEADLESS_BENCH_H
+#define HEADLESS_BENCH_H
+
+#include "MsxTypes.h"
+
+//
+// Benchmarks of the headless runner. Each one is run by its command
+// line option with a count (seconds or frames), prints its results and
+// returns the number of checks that failed.
+//
+
+typedef struct {
+    const char* option;
+    const char* argument;
+    const char* help[3];
+    UInt32      maxCount;
+    int       (*run)(UInt32 count);
+} HeadlessBench;
+
+extern const HeadlessBench headlessBenches[];
+
+// Returns the bench for a command line option, or NULL
+const HeadlessBench* headlessBenchFind(const char* option);
+
+// Runs a bench with count limited to its maxCount and returns the
+// number of failed checks
+int headlessBenchRun(const HeadlessBench* bench, UInt32 count);
+
+void headlessBenchUsage();
+void headlessBenchHelp();
+
+// Calls run a few times and returns the best rate it returned, to
+// filter out the host load
+double headlessBenchBest(double (*run)(void* ref), void* ref);
+
+int cpuBench(UInt32 seconds);
+int ioBench(UInt32 seconds);
+int cpuTest(UInt32 tests);
+int videoBench(UInt32 frames);
+int flipBench(UInt32 frames);
+
+void stateBench(BoardContext* board, const char* fileName, int count);
+
+// Runs with and without run-ahead hash the machine state on the real
+// timeline, which has to be the same
+void   runAheadTestStart(BoardContext* board, int frames);
+UInt32 runAheadTestEnd(BoardContext* board, int frames);
+
+// Records the board timer operations of the run, which timerBench()
+// replays when it is done
+void timerBenchRecord(BoardContext* board);
+void timerBench(BoardContext* board, UInt32 count);
+
+#endif
@@ -0,0 +1,328 @@
+/*****************************************************************************
+** $Source: /cygdrive/d/Private/_SVNROOT/bluemsx/blueMSX/Src/Linux/blueMSXlite/HeadlessCpuBench.c,v $
+**
+** $Revision: 1.1 $
+**
+** $Date: 2026-10-18 12:00:00 $
+**
+** More info: http://www.bluemsx.com
+**
+** Copyright (C) 2003-2004 Daniel Vik, Tomas Karlsson
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+******************************************************************************
+*/
+#include "HeadlessBench.h"
+#include "R800.h"
+#include "IoPort.h"
+#include "Board.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// The CPU timeout is a 32 bit count of the master clock, which wraps
+// after 199 seconds
+#define CPU_BENCH_MAX_SECONDS 90
+
+typedef struct {
+    const char* name;
+    CpuMode     mode;
+    UInt32      flags;
+    UInt32      seconds;
+    UInt32      count;
+    UInt32      checksum;
+    int         codeCache;
+} CpuBenchRun;
+
+// Instruction mix for the CPU benchmark: a block copy followed by a
+// loop with memory, stack, I/O and indexed instructions.
+static const UInt8 cpuBenchCode[] = {
+    0x31, 0x00, 0xf0,           // 0000  ld   sp,f000h
+    0x21, 0x00, 0x80,           // 0003  ld   hl,8000h
+    0x11, 0x00, 0x90,           // 0006  ld   de,9000h
+    0x01, 0x00, 0x01,           // 0009  ld   bc,0100h
+    0xed, 0xb0,                 // 000c  ldir
+    0x06, 0x40,                 // 000e  ld   b,40h
+    0x7e,                       // 0010  ld   a,(hl)
+    0x80,                       // 0011  add  a,b
+    0xab,                       // 0012  xor  e
+    0x12,                       // 0013  ld   (de),a
+    0x23,                       // 0014  inc  hl
+    0x13,                       // 0015  inc  de
+    0xc5,                       // 0016  push bc
+    0xcd, 0x29, 0x00,           // 0017  call 0029h
+    0xc1,                       // 001a  pop  bc
+    0x07,                       // 001b  rlca
+    0xd3, 0x40,                 // 001c  out  (40h),a
+    0xdb, 0x41,                 // 001e  in   a,(41h)
+    0xdd, 0xcb, 0x02, 0x5e,     // 0020  bit  3,(ix+2)
+    0x10, 0xea,                 // 0024  djnz 0010h
+    0xc3, 0x03, 0x00,           // 0026  jp   0003h
+    0xeb,                       // 0029  ex   de,hl
+    0xeb,                       // 002a  ex   de,hl
+    0xc9                        // 002b  ret
+};
+
+static UInt8 cpuBenchRam[0x10000];
+static UInt8* cpuBenchBlocks[0x100];
+static UInt32 cpuBenchVersions[0x100];
+static R800* cpuBenchCpu;
+
+static UInt8 cpuBenchRead(void* ref, UInt16 address)
+{
+    return cpuBenchRam[address];
+}
+
+static void cpuBenchWrite(void* ref, UInt16 address, UInt8 value)
+{
+    cpuBenchRam[address] = value;
+}
+
+static void cpuBenchTimeout(void* ref)
+{
+    r800StopExecution(cpuBenchCpu);
+}
+
+static void cpuBenchStart(CpuBenchRun* run, const UInt8* code, int codeSize, 
+                          R800ReadCb readIo, R800WriteCb writeIo, void* ioRef)
+{
+    int i;
+
+    memset(cpuBenchRam, 0, sizeof(cpuBenchRam));
+    memcpy(cpuBenchRam, code, codeSize);
+
+    cpuBenchCpu = r800Create(CPU_ENABLE_M1 | run->flags, cpuBenchRead, cpuBenchWrite, readIo, writeIo, 
+                             NULL, cpuBenchTimeout, NULL, NULL, NULL, NULL, NULL, ioRef);
+    r800SetFrequency(cpuBenchCpu, CPU_Z80,  R800_MASTER_FREQUENCY / 6);
+    r800SetFrequency(cpuBenchCpu, CPU_R800, R800_MASTER_FREQUENCY / 3);
+    r800SetMode(cpuBenchCpu, run->mode);
+    r800SetTimeoutAt(cpuBenchCpu, 
+                     (run->seconds < CPU_BENCH_MAX_SECONDS ? run->seconds : CPU_BENCH_MAX_SECONDS) * R800_MASTER_FREQUENCY);
+
+    for (i = 0; i < 0x100; i++) {
+        cpuBenchBlocks[i] = cpuBenchRam + 0x100 * i;
+    }
+    r800SetMemoryBlocks(cpuBenchCpu, cpuBenchBlocks, cpuBenchBlocks);
+
+    if (run->codeCache) {
+        for (i = 0; i < 0x100; i++) {
+            cpuBenchVersions[i] = 1;
+        }
+        r800SetCodeCache(cpuBenchCpu, cpuBenchVersions);
+    }
+}
+
+// Runs the CPU until the timeout and returns the process time it took.
+// Process time is used as the run is short and the host may be busy.
+static double cpuBenchExecute()
+{
+    clock_t startTime = clock();
+
+    r800Execute(cpuBenchCpu);
+
+    return (double)(clock() - startTime) / CLOCKS_PER_SEC;
+}
+
+static double cpuBenchRun(void* ref)
+{
+    CpuBenchRun* run = (CpuBenchRun*)ref;
+    BoardContext* board = boardContextCreate();
+    UInt32 hash = 2166136261u;
+    double elapsed;
+    int i;
+
+    cpuBenchStart(run, cpuBenchCode, sizeof(cpuBenchCode), NULL, NULL, NULL);
+    elapsed = cpuBenchExecute();
+
+    run->count = cpuBenchCpu->instCnt;
+
+    for (i = 0; i < (int)sizeof(cpuBenchRam); i++) {
+        hash = (hash ^ cpuBenchRam[i]) * 16777619;
+    }
+    for (i = 0; i < (int)sizeof(CpuRegs); i++) {
+        hash = (hash ^ ((UInt8*)&cpuBenchCpu->regs)[i]) * 16777619;
+    }
+    run->checksum = hash ^ cpuBenchCpu->systemTime;
+
+    r800Destroy(cpuBenchCpu);
+
+    return elapsed > 0 ? run->count / elapsed / 1000000 : 0;
+}
+
+int cpuBench(UInt32 seconds)
+{
+    static const struct {
+        const char* name;
+        CpuMode     mode;
+    } modes[] = {
+        { "Z80",  CPU_Z80 },
+        { "R800", CPU_R800 },
+    };
+    int failed = 0;
+    int i;
+
+    for (i = 0; i < (int)(sizeof(modes) / sizeof(modes[0])); i++) {
+        CpuBenchRun generic = { NULL, modes[i].mode, CPU_GENERIC_CORE, seconds, 0, 0, 0 };
+        CpuBenchRun constant = { NULL, modes[i].mode, 0, seconds, 0, 0, 0 };
+        CpuBenchRun cached = { NULL, modes[i].mode, 0, seconds, 0, 0, 1 };
+        double genericMips = headlessBenchBest(cpuBenchRun, &generic);
+        double mips;
+
+        printf("%-5s generic core   %10u instructions  %7.1f MIPS\n", 
+               modes[i].name, generic.count, genericMips);
+
+        mips = headlessBenchBest(cpuBenchRun, &constant);
+        printf("%-5s constant core  %10u instructions  %7.1f MIPS  (%.2fx)%s\n", 
+               modes[i].name, constant.count, mips, mips / genericMips,
+               constant.checksum != generic.checksum ? "  RESULTS DIFFER" : "");
+
+        mips = headlessBenchBest(cpuBenchRun, &cached);
+        printf("%-5s code cache     %10u instructions  %7.1f MIPS  (%.2fx)%s\n", 
+               modes[i].name, cached.count, mips, mips / genericMips,
+               cached.checksum != generic.checksum ? "  RESULTS DIFFER" : "");
+
+        failed += constant.checksum != generic.checksum;
+        failed += cached.checksum != generic.checksum;
+    }
+
+    return failed;
+}
+
+// VRAM upload for the I/O benchmark: sets the VDP write address and
+// writes 16 kB to port 98h with OTIR, then reads the status register.
+static const UInt8 ioBenchCode[] = {
+    0x31, 0x00, 0xf0,           // 0000  ld   sp,f000h
+    0x21, 0x00, 0x80,           // 0003  ld   hl,8000h
+    0xaf,                       // 0006  xor  a
+    0xd3, 0x99,                 // 0007  out  (99h),a
+    0x3e, 0x40,                 // 0009  ld   a,40h
+    0xd3, 0x99,                 // 000b  out  (99h),a
+    0x0e, 0x98,                 // 000d  ld   c,98h
+    0x16, 0x40,                 // 000f  ld   d,40h
+    0x06, 0x00,                 // 0011  ld   b,00h
+    0xed, 0xb3,                 // 0013  otir
+    0x15,                       // 0015  dec  d
+    0x20, 0xf9,                 // 0016  jr   nz,0011h
+    0xdb, 0x99,                 // 0018  in   a,(99h)
+    0x34,                       // 001a  inc  (hl)
+    0xc3, 0x03, 0x00            // 001b  jp   0003h
+};
+
+static UInt8  ioBenchVram[0x4000];
+static UInt16 ioBenchAddress;
+static int    ioBenchLatch;
+static UInt32 ioBenchWrites;
+static UInt32 ioBenchTimeHash;
+
+static UInt8 ioBenchReadStatus(void* ref, UInt16 port)
+{
+    ioBenchLatch = 0;
+    return 0x80;
+}
+
+static void ioBenchWriteData(void* ref, UInt16 port, UInt8 value)
+{
+    ioBenchVram[ioBenchAddress++ & 0x3fff] = value;
+    ioBenchWrites++;
+    ioBenchTimeHash = (ioBenchTimeHash ^ cpuBenchCpu->systemTime) * 16777619;
+}
+
+// Block writes from the constant cores. The write times go into the
+// checksum, so a block write has to see the same times as the writes
+// of the generic core.
+static void ioBenchWriteBlock(void* ref, UInt16 port, const UInt8* values, 
+                              const UInt32* times, int count)
+{
+    int i;
+
+    for (i = 0; i < count; i++) {
+        ioBenchVram[ioBenchAddress++ & 0x3fff] = values[i];
+        ioBenchWrites++;
+        ioBenchTimeHash = (ioBenchTimeHash ^ times[i]) * 16777619;
+    }
+}
+
+static void ioBenchWriteControl(void* ref, UInt16 port, UInt8 value)
+{
+    ioBenchAddress = ioBenchLatch ? (ioBenchAddress & 0xff) | ((value & 0x3f) << 8) : value;
+    ioBenchLatch ^= 1;
+}
+
+static double ioBenchRun(void* ref)
+{
+    CpuBenchRun* run = (CpuBenchRun*)ref;
+    BoardContext* board = boardContextCreate();
+    UInt32 hash = 2166136261u;
+    double elapsed;
+    int i;
+
+    memset(ioBenchVram, 0, sizeof(ioBenchVram));
+    ioBenchAddress = 0;
+    ioBenchLatch   = 0;
+    ioBenchWrites  = 0;
+    ioBenchTimeHash = 2166136261u;
+
+    ioPortReset(board);
+    ioPortRegister(board, 0x98, NULL, ioBenchWriteData, NULL);
+    ioPortRegister(board, 0x99, ioBenchReadStatus, ioBenchWriteControl, NULL);
+    ioPortRegisterWriteBlock(board, 0x98, ioBenchWriteBlock);
+
+    cpuBenchStart(run, ioBenchCode, sizeof(ioBenchCode), ioPortRead, ioPortWrite, board);
+    r800SetIoPortBlockWrite(cpuBenchCpu, ioPortCanWriteBlock, ioPortWriteBlock);
+    for (i = 0x8000; i < 0xc000; i++) {
+        cpuBenchRam[i] = (UInt8)(i * 7 + (i >> 8));
+    }
+    elapsed = cpuBenchExecute();
+
+    for (i = 0; i < (int)sizeof(ioBenchVram); i++) {
+        hash = (hash ^ ioBenchVram[i]) * 16777619;
+    }
+    run->count    = ioBenchWrites;
+    run->checksum = hash ^ cpuBenchCpu->systemTime ^ ioBenchWrites ^ ioBenchTimeHash;
+
+    r800Destroy(cpuBenchCpu);
+    boardContextDestroy(board);
+
+    return elapsed > 0 ? ioBenchWrites / elapsed / 1000000 : 0;
+}
+
+int ioBench(UInt32 seconds)
+{
+    CpuBenchRun runs[] = {
+        { "Z80   generic core ", CPU_Z80,  CPU_GENERIC_CORE, 0, 0, 0, 0 },
+        { "Z80   constant core", CPU_Z80,  0, 0, 0, 0, 0 },
+        { "R800  generic core ", CPU_R800, CPU_GENERIC_CORE, 0, 0, 0, 0 },
+        { "R800  constant core", CPU_R800, 0, 0, 0, 0, 0 },
+    };
+    int failed = 0;
+    int i;
+
+    for (i = 0; i < (int)(sizeof(runs) / sizeof(runs[0])); i++) {
+        double rate;
+
+        runs[i].seconds = seconds;
+        rate = headlessBenchBest(ioBenchRun, &runs[i]);
+        printf("%s  %10u port writes  %7.1f M/s  checksum %08x%s\n", 
+               runs[i].name, runs[i].count, rate, runs[i].checksum,
+               (i & 1) && runs[i].checksum != runs[i - 1].checksum ? "  RESULTS DIFFER" : "");
+
+        failed += (i & 1) && runs[i].checksum != runs[i - 1].checksum;
+    }
+
+    return failed;
+}
@@ -0,0 +1,552 @@
+/*****************************************************************************
+** $Source: /cygdrive/d/Private/_SVNROOT/bluemsx/blueMSX/Src/Linux/blueMSXlite/HeadlessCpuTest.c,v $
+**
+** $Revision: 1.1 $
+**
+** $Date: 2026-10-18 12:00:00 $
+**
+** More info: http://www.bluemsx.com
+**
+** Copyright (C) 2003-2004 Daniel Vik, Tomas Karlsson
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+******************************************************************************
+*/
+#include "HeadlessBench.h"
+#include "R800.h"
+#include <stdio.h>
+#include <string.h>
+
+//
+// Instruction exerciser in the style of zexdoc/zexall. Each test runs an
+// instruction on every combination of the bits in its inc vector, and
+// each of those once with every bit in its shift vector toggled, and
+// hashes the registers, the memory it can reach, the port accesses and
+// the time taken. Instead of comparing with the hashes of a real Z80 it
+// compares the constant timing cores, the direct memory block access and
+// the code cache with the generic core reading and writing through the
+// callbacks.
+//
+// The instruction is placed across a 256 byte block boundary, as is the
+// memory operand at DATA, and 4000h-7FFFh is ROM that ignores writes.
+//
+
+#define TEST_CODE       0x80fe
+#define TEST_DATA       0x81ff
+#define TEST_AREA_START 0x7f00
+#define TEST_AREA_END   0x8600
+#define TEST_TIMEOUT    0x40000
+
+typedef struct {
+    UInt8  inst[4];
+    UInt16 memop;
+    UInt16 iy;
+    UInt16 ix;
+    UInt16 hl;
+    UInt16 de;
+    UInt16 bc;
+    UInt8  f;
+    UInt8  a;
+    UInt16 sp;
+} CpuTestVector;
+
+typedef struct {
+    const char*   name;
+    CpuTestVector base;
+    CpuTestVector inc;
+    CpuTestVector shift;
+} CpuTest;
+
+#define D TEST_DATA
+
+static const CpuTest cpuTests[] = {
+    { "<adc,sbc> hl,<bc,de,hl,sp>",
+      { { 0xed, 0x42, 0x00, 0x00 }, 0x832c, 0x4f88, 0xf22b, 0xb339, 0x7e1f, 0x1563, 0xd3, 0x89, 0x465e },
+      { { 0x00, 0x38, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x8800, 0x0000, 0x0000, 0x01, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0xffff, 0xffff, 0xffff, 0xd6, 0x00, 0xffff } },
+    { "add hl,<bc,de,hl,sp>",
+      { { 0x09, 0x00, 0x00, 0x00 }, 0xc4a5, 0xc4c7, 0xd226, 0xa050, 0x58ea, 0x8566, 0xc6, 0xde, 0x9bc9 },
+      { { 0x30, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x8800, 0x0000, 0x0000, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0xffff, 0xffff, 0xffff, 0xff, 0x00, 0xffff } },
+    { "add <ix,iy>,<bc,de,ix/iy,sp>",
+      { { 0xdd, 0x09, 0x00, 0x00 }, 0xac23, 0x7f5e, 0xe5c1, 0x4a7b, 0xd04a, 0x1c63, 0x02, 0x12, 0x3ea5 },
+      { { 0x20, 0x30, 0x00, 0x00 }, 0x0000, 0x8800, 0x8800, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0xffff, 0xffff, 0x0000, 0xffff, 0xffff, 0xff, 0x00, 0xffff } },
+    { "aluop a,nn",
+      { { 0xc6, 0x00, 0x00, 0x00 }, 0xc3d7, 0x1c9b, 0x4f64, 0x2d87, 0x9d13, 0x72f6, 0x00, 0x43, 0xdd4c },
+      { { 0x38, 0x81, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x01, 0x81, 0x0000 },
+      { { 0x00, 0xff, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xd6, 0xff, 0x0000 } },
+    { "aluop a,<b,c,d,e,h,l,(hl),a>",
+      { { 0x80, 0x00, 0x00, 0x00 }, 0xc53e, 0x573a, 0x4c4d, D,      0xe309, 0xa666, 0xd0, 0x3b, 0xadbb },
+      { { 0x3f, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x01, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x00ff, 0x0000, 0x0000, 0x0000, 0xffff, 0xffff, 0xd6, 0xff, 0x0000 } },
+    { "aluop a,(<ix,iy>+1)",
+      { { 0xdd, 0x86, 0x01, 0x00 }, 0x90b7, D - 1,  D - 1,  0x32fd, 0x406e, 0xc1dc, 0x45, 0x6e, 0xe5fa },
+      { { 0x20, 0x38, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x01, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x00ff, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xd6, 0xff, 0x0000 } },
+    { "<daa,cpl,scf,ccf>",
+      { { 0x27, 0x00, 0x00, 0x00 }, 0x2141, 0x09fa, 0x1d60, 0xa559, 0x8d5b, 0x9079, 0x04, 0x8e, 0x299d },
+      { { 0x18, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x13, 0xff, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xc4, 0x00, 0x0000 } },
+    { "<inc,dec> <b,c,d,e,h,l,(hl),a>",
+      { { 0x04, 0x00, 0x00, 0x00 }, 0x0a4f, 0x2e5a, 0x2f0c, D,      0x36f3, 0x9b74, 0x90, 0x4a, 0xa3b2 },
+      { { 0x39, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x01, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x00ff, 0x0000, 0x0000, 0x0000, 0xffff, 0xffff, 0xd6, 0xff, 0x0000 } },
+    { "<inc,dec> (<ix,iy>+1)",
+      { { 0xdd, 0x34, 0x01, 0x00 }, 0x6ff5, D - 1,  D - 1,  0x8df1, 0x8a8d, 0x0ad5, 0x46, 0x0a, 0x4c71 },
+      { { 0x20, 0x01, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x01, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x00ff, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xd6, 0x00, 0x0000 } },
+    { "<inc,dec> <bc,de,hl,sp>",
+      { { 0x03, 0x00, 0x00, 0x00 }, 0x2b63, 0x0bb2, 0x55d5, 0x21a0, 0x64d9, 0xf20a, 0xb9, 0x79, 0x2c18 },
+      { { 0x38, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0xffff, 0xffff, 0xffff, 0xff, 0x00, 0xffff } },
+    { "<inc,dec> <ix,iy>",
+      { { 0xdd, 0x23, 0x00, 0x00 }, 0x7ccf, 0x9e4b, 0x7a0e, 0x3651, 0xd94b, 0xcd69, 0x07, 0x55, 0xdbb5 },
+      { { 0x20, 0x08, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0xffff, 0xffff, 0x0000, 0x0000, 0x0000, 0xff, 0x00, 0x0000 } },
+    { "<rlca,rrca,rla,rra>",
+      { { 0x07, 0x00, 0x00, 0x00 }, 0xcb92, 0x6d43, 0x0a90, 0xc284, 0x0c53, 0xf50e, 0x91, 0xeb, 0x40fc },
+      { { 0x18, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x01, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xd6, 0xff, 0x0000 } },
+    { "<rlc,rrc,rl,rr,sla,sra,sll,srl,bit,res,set> <b,c,d,e,h,l,(hl),a>",
+      { { 0xcb, 0x00, 0x00, 0x00 }, 0x3ddf, 0x7a4d, 0x2b2b, D,      0x5f88, 0x0fda, 0x05, 0xe4, 0x1a3c },
+      { { 0x00, 0xff, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x01, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x00ff, 0x0000, 0x0000, 0x0000, 0x0000, 0xffff, 0xd6, 0xff, 0x0000 } },
+    { "<rlc,rrc,rl,rr,sla,sra,sll,srl,bit,res,set> (<ix,iy>+1)",
+      { { 0xdd, 0xcb, 0x01, 0x00 }, 0x2cd5, D - 1,  D - 1,  0x3fd6, 0x2c3b, 0xe1f6, 0x81, 0x30, 0xa6d9 },
+      { { 0x20, 0x00, 0x00, 0xff }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x00ff, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xd7, 0x00, 0x0000 } },
+    { "ld <b,c,d,e,h,l,(hl),a>,<b,c,d,e,h,l,(hl),a>",
+      { { 0x40, 0x00, 0x00, 0x00 }, 0x72a4, 0xa024, 0x61ac, D,      0x82c7, 0x718f, 0x97, 0x8f, 0xef8e },
+      { { 0x3f, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x00ff, 0x0000, 0x0000, 0x0000, 0xffff, 0xffff, 0xff, 0xff, 0x0000 } },
+    { "ld <b,c,d,e,h,l,a>,(<ix,iy>+1)",
+      { { 0xdd, 0x46, 0x01, 0x00 }, 0xd7c6, D - 1,  D - 1,  0xf1b5, 0x2a77, 0x0c6b, 0x38, 0x4a, 0xc1a9 },
+      { { 0x20, 0x38, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0xffff, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 } },
+    { "ld (<ix,iy>+1),<b,c,d,e,h,l,a>",
+      { { 0xdd, 0x70, 0x01, 0x00 }, 0x270d, D - 1,  D - 1,  0xb5b3, 0xd3c6, 0x3b70, 0x5c, 0x81, 0x5c52 },
+      { { 0x20, 0x07, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x00ff, 0xffff, 0xffff, 0x00, 0xff, 0x0000 } },
+    { "ld <b,c,d,e,h,l,(hl),a>,nn",
+      { { 0x06, 0x00, 0x00, 0x00 }, 0x32f7, 0x13f8, 0x77a4, D,      0x0c0a, 0x9dd9, 0x50, 0xd6, 0x9f45 },
+      { { 0x38, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0xff, 0x00, 0x00 }, 0x00ff, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 } },
+    { "ld (<ix,iy>+1),nn",
+      { { 0xdd, 0x36, 0x01, 0x00 }, 0x1b45, D - 1,  D - 1,  0xe3a8, 0x79f3, 0x4e66, 0x5d, 0x35, 0xbd38 },
+      { { 0x20, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0xff }, 0xffff, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 } },
+    { "ld <bc,de,hl,sp>,nnnn",
+      { { 0x01, 0x34, 0x12, 0x00 }, 0x5c1c, 0x2d46, 0x8eb9, 0x6078, 0x74b1, 0xb30e, 0x46, 0xd1, 0x30cc },
+      { { 0x30, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0xff, 0xff, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 } },
+    { "ld a,(nnnn) / ld (nnnn),a",
+      { { 0x32, 0xff, 0x81, 0x00 }, 0xfd68, 0xf4ec, 0x44a0, 0xb543, 0x0653, 0xcdba, 0xd2, 0x4f, 0x1fd8 },
+      { { 0x08, 0x01, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0xffff, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0xff, 0x0000 } },
+    { "ld hl,(nnnn) / ld (nnnn),hl",
+      { { 0x22, 0xff, 0x81, 0x00 }, 0xc3b5, 0x6a7a, 0xb94b, 0xce61, 0xc5f5, 0x2a8a, 0x2f, 0xd8, 0x9a7c },
+      { { 0x08, 0x01, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0xffff, 0x0000, 0x0000, 0xffff, 0x0000, 0x0000, 0x00, 0x00, 0x0000 } },
+    { "ld <ix,iy>,(nnnn) / ld (nnnn),<ix,iy>",
+      { { 0xdd, 0x22, 0xff, 0x81 }, 0x36c8, 0xf4c9, 0x4e14, 0x8bb6, 0x4d61, 0x9e43, 0x87, 0x4e, 0x0d86 },
+      { { 0x20, 0x08, 0x01, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0xffff, 0xffff, 0xffff, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 } },
+    { "ld <bc,de,hl,sp>,(nnnn) / ld (nnnn),<bc,de,hl,sp>",
+      { { 0xed, 0x43, 0xff, 0x81 }, 0x5ac1, 0xb31c, 0xfa3d, 0x7d26, 0xcb80, 0x6a0e, 0x70, 0x5e, 0x3c2f },
+      { { 0x00, 0x38, 0x01, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0xffff, 0x0000, 0x0000, 0xffff, 0xffff, 0xffff, 0x00, 0x00, 0xffff } },
+    { "<push,pop> <bc,de,hl,af>",
+      { { 0xc5, 0x00, 0x00, 0x00 }, 0x8c3f, 0x41b7, 0x9e3a, 0x1b67, 0x5ae3, 0xc9f5, 0x4d, 0xb2, D      },
+      { { 0x34, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0001 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0xffff, 0x0000, 0x0000, 0xffff, 0xffff, 0xffff, 0xff, 0xff, 0x0000 } },
+    { "<push,pop> <ix,iy>",
+      { { 0xdd, 0xe5, 0x00, 0x00 }, 0x41a4, 0x3b2e, 0x55ef, 0xa1f0, 0x2d0b, 0x7a3c, 0x90, 0x1c, D      },
+      { { 0x20, 0x04, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0001 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0xffff, 0xffff, 0xffff, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 } },
+    { "ex (sp),hl",
+      { { 0xe3, 0x00, 0x00, 0x00 }, 0x7c1d, 0xa0e2, 0x61d8, 0x0d93, 0xbef0, 0x38f8, 0x32, 0x9b, D      },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0001 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0xffff, 0x0000, 0x0000, 0xffff, 0x0000, 0x0000, 0x00, 0x00, 0x0000 } },
+    { "ex (sp),<ix,iy>",
+      { { 0xdd, 0xe3, 0x00, 0x00 }, 0x20b6, 0x15b3, 0xd9a1, 0x6e8f, 0x4a0b, 0x97c2, 0x6c, 0xa4, D      },
+      { { 0x20, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0001 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0xffff, 0xffff, 0xffff, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 } },
+    { "<ldi,ldd,ldir,lddr>",
+      { { 0xed, 0xa0, 0x00, 0x00 }, 0x1e4f, 0x6a22, 0x9b17, 0x8100, 0x8380, 0x0001, 0x87, 0x26, 0x6d5a },
+      { { 0x00, 0x18, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0003, 0x0003, 0x01f6, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xd7, 0x00, 0x0000 } },
+    { "<ldir,lddr> with overlapping source and destination",
+      { { 0xed, 0xb0, 0x00, 0x00 }, 0x5d12, 0x88e3, 0x1f4c, 0x8300, 0x8301, 0x0001, 0x00, 0x00, 0x2b81 },
+      { { 0x00, 0x08, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0009, 0x0006, 0x01f6, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 } },
+    { "<ldir,lddr> to ROM",
+      { { 0xed, 0xb0, 0x00, 0x00 }, 0xe02b, 0x5c73, 0x41b9, 0x8100, 0x7fc0, 0x0001, 0x00, 0x00, 0x73de },
+      { { 0x00, 0x08, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0001, 0x0003, 0x007e, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 } },
+    { "ldir over its own code",
+      { { 0xed, 0xb0, 0x00, 0x00 }, 0x4e00, 0x2c95, 0x93f0, D - 12, 0x80f4, 0x0008, 0x00, 0x00, 0x58e2 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0005, 0x01, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 } },
+    { "lddr over its own code",
+      { { 0xed, 0xb8, 0x00, 0x00 }, 0x0d7b, 0xb6a1, 0x64c3, 0x8107, 0x8108, 0x0010, 0x00, 0x00, 0x9e27 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x000f, 0x01, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 } },
+    { "<cpi,cpd,cpir,cpdr>",
+      { { 0xed, 0xa1, 0x00, 0x00 }, 0x9a4b, 0xe3f1, 0x0a1c, 0x8100, 0x5a66, 0x0001, 0x00, 0x00, 0xb1d5 },
+      { { 0x00, 0x18, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0003, 0x0000, 0x01f6, 0x01, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0xff, 0x0000 } },
+    { "<ini,ind,inir,indr,outi,outd,otir,otdr>",
+      { { 0xed, 0xa2, 0x00, 0x00 }, 0x3c8e, 0x0b6e, 0x6e2c, 0x81f0, 0x1d3e, 0x0110, 0x00, 0xa7, 0xd54b },
+      { { 0x00, 0x19, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x3e00, 0x00, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xff, 0x00, 0x0000 } },
+    { "<rrd,rld>",
+      { { 0xed, 0x67, 0x00, 0x00 }, 0x91cb, 0x8b13, 0xd9a4, D,      0xb12e, 0x4f33, 0x35, 0xe6, 0x6f18 },
+      { { 0x00, 0x08, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x01, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x00ff, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xd6, 0xff, 0x0000 } },
+    { "neg",
+      { { 0xed, 0x44, 0x00, 0x00 }, 0x38a2, 0x5f6b, 0xd934, 0x57e4, 0xd2d6, 0x4642, 0x43, 0x5a, 0x09e7 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x01, 0xff, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xd6, 0x00, 0x0000 } },
+    { "<jr,djnz> [cc,]$ and neighbours",
+      { { 0x18, 0xfe, 0x00, 0x00 }, 0x6a30, 0x4d2f, 0xa0c1, D,      0x5e23, 0x0007, 0x00, 0x3c, D      },
+      { { 0x38, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0300, 0xc1, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x04, 0x00, 0x0000 } },
+    { "jp [cc,]$ and neighbours",
+      { { 0xc2, 0xfe, 0x80, 0x00 }, 0x0c9e, 0x77d2, 0x1b0a, D,      0xe5a9, 0x2f61, 0x00, 0x95, D      },
+      { { 0x39, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xc5, 0x00, 0x0000 },
+      { { 0x00, 0x00, 0x00, 0x00 }, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x00, 0x00, 0x0000 } },
+};
+
+#undef D
+
+typedef enum {
+    BLOCKS_NONE,
+    BLOCKS_ALL,
+    BLOCKS_EVEN,
+    BLOCKS_ODD
+} CpuTestBlocks;
+
+typedef struct {
+    const char*   name;
+    CpuMode       mode;
+    UInt32        frequency;
+    int           core;
+} CpuTestCore;
+
+// The core r800Execute() is expected to pick, as R800.c numbers them
+static const CpuTestCore cpuTestCores[] = {
+    { "Z80 3.58 MHz", CPU_Z80,  R800_MASTER_FREQUENCY / 6, 2 },
+    { "Z80 5.37 MHz", CPU_Z80,  R800_MASTER_FREQUENCY / 4, 1 },
+    { "R800",         CPU_R800, R800_MASTER_FREQUENCY / 3, 3 },
+};
+
+typedef struct {
+    const char*   name;
+    UInt32        flags;
+    CpuTestBlocks blocks;
+    int           codeCache;
+} CpuTestRun;
+
+// The first run is the reference for the others
+static const CpuTestRun cpuTestRuns[] = {
+    { "generic core, callbacks",     CPU_GENERIC_CORE, BLOCKS_NONE, 0 },
+    { "generic core, direct",        CPU_GENERIC_CORE, BLOCKS_ALL,  0 },
+    { "constant core, callbacks",    0,                BLOCKS_NONE, 0 },
+    { "constant core, direct",       0,                BLOCKS_ALL,  0 },
+    { "constant core, even blocks",  0,                BLOCKS_EVEN, 0 },
+    { "constant core, odd blocks",   0,                BLOCKS_ODD,  0 },
+    { "constant core, code cache",   0,                BLOCKS_ALL,  1 },
+    { "constant core, cache odd",    0,                BLOCKS_ODD,  1 },
+};
+
+#define CPU_TEST_RUNS (sizeof(cpuTestRuns) / sizeof(cpuTestRuns[0]))
+
+static UInt8  testRam[0x10000];
+static UInt8  testImage[0x10000];
+static UInt8* testReadBlocks[0x100];
+static UInt8* testWriteBlocks[0x100];
+static UInt32 testBlockVersions[0x100];
+static R800*  testCpu;
+static UInt32 testIoSequence;
+static UInt32 testIoHash;
+
+static int isRom(UInt16 address)
+{
+    return address >= 0x4000 && address < 0x8000;
+}
+
+static UInt32 hashBytes(UInt32 hash, const void* data, int size)
+{
+    const UInt8* p = (const UInt8*)data;
+
+    while (size--) {
+        hash = (hash ^ *p++) * 16777619;
+    }
+    return hash;
+}
+
+static UInt8 testRead(void* ref, UInt16 address)
+{
+    return testRam[address];
+}
+
+static void testWrite(void* ref, UInt16 address, UInt8 value)
+{
+    if (!isRom(address)) {
+        testRam[address] = value;
+    }
+}
+
+static UInt8 testReadIo(void* ref, UInt16 port)
+{
+    UInt8 value = (UInt8)(testIoSequence++ * 0x1d + port);
+
+    testIoHash = (testIoHash ^ port) * 16777619;
+    return value;
+}
+
+// A write to port FFh ends the test of an instruction
+static void testWriteIo(void* ref, UInt16 port, UInt8 value)
+{
+    if ((port & 0xff) == 0xff) {
+        r800StopExecution(testCpu);
+        return;
+    }
+    testIoHash = (testIoHash ^ port ^ (value << 16)) * 16777619;
+}
+
+static void testTimeout(void* ref)
+{
+    r800StopExecution(testCpu);
+}
+
+static void testSetBlocks(CpuTestBlocks blocks)
+{
+    int i;
+
+    for (i = 0; i < 0x100; i++) {
+        int direct = blocks == BLOCKS_ALL ||
+                     (blocks == BLOCKS_EVEN && (i & 1) == 0) ||
+                     (blocks == BLOCKS_ODD  && (i & 1) == 1);
+
+        testReadBlocks[i]  = direct ? testRam + 0x100 * i : NULL;
+        testWriteBlocks[i] = direct && !isRom((UInt16)(0x100 * i)) ? testRam + 0x100 * i : NULL;
+    }
+}
+
+// Copies the test area into the memory. The blocks that change get a
+// new version like the slot manager gives them, so the code cache keeps
+// the instructions that are the same as in the previous vector.
+static void testLoadArea(const UInt8* area)
+{
+    int address;
+
+    for (address = TEST_AREA_START; address < TEST_AREA_END; address += 0x100) {
+        const UInt8* data = area + address - TEST_AREA_START;
+
+        if (memcmp(testRam + address, data, 0x100) != 0) {
+            memcpy(testRam + address, data, 0x100);
+            testBlockVersions[address >> 8]++;
+        }
+    }
+}
+
+// Runs the instruction of a vector and returns the hash of its effects
+static UInt32 testVector(const CpuTestVector* v, const CpuRegs* resetRegs)
+{
+    static const UInt8 stop[] = { 0xd3, 0xff };   // out (0ffh),a
+    UInt8 area[TEST_AREA_END - TEST_AREA_START];
+    UInt32 startTime = testCpu->systemTime;
+    UInt32 startCount = testCpu->instCnt;
+    UInt32 hash = 2166136261u;
+    CpuRegs* regs = &testCpu->regs;
+
+    memcpy(area, testImage + TEST_AREA_START, sizeof(area));
+    memcpy(area + TEST_CODE - TEST_AREA_START, v->inst, 4);
+    memcpy(area + TEST_CODE + 4 - TEST_AREA_START, stop, sizeof(stop));
+    area[TEST_DATA - TEST_AREA_START]     = (UInt8)v->memop;
+    area[TEST_DATA + 1 - TEST_AREA_START] = (UInt8)(v->memop >> 8);
+    testLoadArea(area);
+
+    *regs = *resetRegs;
+    regs->PC.W   = TEST_CODE;
+    regs->IY.W   = v->iy;
+    regs->IX.W   = v->ix;
+    regs->HL.W   = v->hl;
+    regs->DE.W   = v->de;
+    regs->BC.W   = v->bc;
+    regs->AF.B.l = v->f;
+    regs->AF.B.h = v->a;
+    regs->SP.W   = v->sp;
+
+    testIoSequence = 0;
+    testIoHash     = 0;
+
+    testCpu->terminate = 0;
+    r800SetTimeoutAt(testCpu, startTime + TEST_TIMEOUT);
+    r800Execute(testCpu);
+
+    hash = hashBytes(hash, regs, sizeof(CpuRegs));
+    hash = hashBytes(hash, testRam + TEST_AREA_START, TEST_AREA_END - TEST_AREA_START);
+    hash ^= testIoHash;
+    hash = (hash ^ (testCpu->systemTime - startTime)) * 16777619;
+    hash = (hash ^ (testCpu->instCnt - startCount)) * 16777619;
+
+    return hash;
+}
+
+static int vectorBits(const CpuTestVector* mask, int* bits)
+{
+    const UInt8* p = (const UInt8*)mask;
+    int count = 0;
+    int i;
+
+    for (i = 0; i < 8 * (int)sizeof(CpuTestVector); i++) {
+        if (p[i / 8] & (1 << (i % 8))) {
+            bits[count++] = i;
+        }
+    }
+    return count;
+}
+
+static void vectorToggle(CpuTestVector* v, int bit)
+{
+    ((UInt8*)v)[bit / 8] ^= 1 << (bit % 8);
+}
+
+// Runs all vectors of a test on a new CPU and returns the hash of the
+// results. The vector count is returned in count.
+static UInt32 testRun(const CpuTest* test, const CpuTestCore* core,
+                      const CpuTestRun* run, UInt32* count, int* coreUsed)
+{
+    int incBits[8 * sizeof(CpuTestVector)];
+    int shiftBits[8 * sizeof(CpuTestVector)];
+    int incCount   = vectorBits(&test->inc, incBits);
+    int shiftCount = vectorBits(&test->shift, shiftBits);
+    UInt32 hash = 2166136261u;
+    CpuRegs resetRegs;
+    UInt32 n;
+    int i;
+    int s;
+
+    memcpy(testRam, testImage, sizeof(testRam));
+
+    testCpu = r800Create(CPU_ENABLE_M1 | run->flags, testRead, testWrite, testReadIo, testWriteIo,
+                         NULL, testTimeout, NULL, NULL, NULL, NULL, NULL, NULL);
+    r800SetFrequency(testCpu, core->mode, core->frequency);
+    r800SetMode(testCpu, core->mode);
+    testSetBlocks(run->blocks);
+    r800SetMemoryBlocks(testCpu, testReadBlocks, testWriteBlocks);
+    if (run->codeCache) {
+        for (i = 0; i < 0x100; i++) {
+            testBlockVersions[i] = 1;
+        }
+        r800SetCodeCache(testCpu, testBlockVersions);
+    }
+    resetRegs = testCpu->regs;
+
+    *count = 0;
+    for (n = 0; n < (1u << incCount); n++) {
+        CpuTestVector v = test->base;
+
+        for (i = 0; i < incCount; i++) {
+            if (n & (1 << i)) {
+                vectorToggle(&v, incBits[i]);
+            }
+        }
+        for (s = -1; s < shiftCount; s++) {
+            CpuTestVector w = v;
+            if (s >= 0) {
+                vectorToggle(&w, shiftBits[s]);
+            }
+            hash = (hash ^ testVector(&w, &resetRegs)) * 16777619;
+            (*count)++;
+        }
+    }
+
+    // Catches writes outside the area a vector is checked on
+    hash = hashBytes(hash, testRam, sizeof(testRam));
+
+    *coreUsed = testCpu->core;
+    r800Destroy(testCpu);
+
+    return hash;
+}
+
+// Runs the first count tests of the exerciser on each CPU mode and
+// prints the runs that don't give the results of the generic core
+// through the memory callbacks.
+int cpuTest(UInt32 count)
+{
+    int testCount = sizeof(cpuTests) / sizeof(cpuTests[0]);
+    int failed = 0;
+    int c;
+    int t;
+    int i;
+
+    for (i = 0; i < 0x10000; i++) {
+        testImage[i] = (UInt8)((i * 0x6b) ^ (i >> 7) * 0x35 ^ 0xa5);
+    }
+
+    if (count < (UInt32)testCount) {
+        testCount = count;
+    }
+
+    for (c = 0; c < (int)(sizeof(cpuTestCores) / sizeof(cpuTestCores[0])); c++) {
+        const CpuTestCore* core = cpuTestCores + c;
+
+        printf("%s\n", core->name);
+
+        for (t = 0; t < testCount; t++) {
+            const CpuTest* test = cpuTests + t;
+            UInt32 hash[CPU_TEST_RUNS];
+            UInt32 vectors = 0;
+            int errors = 0;
+            int r;
+
+            for (r = 0; r < (int)CPU_TEST_RUNS; r++) {
+                int coreUsed;
+
+                hash[r] = testRun(test, core, cpuTestRuns + r, &vectors, &coreUsed);
+                if (hash[r] != hash[0] || coreUsed != (cpuTestRuns[r].flags & CPU_GENERIC_CORE ? 0 : core->core)) {
+                    if (errors++ == 0) {
+                        printf("  %-58s %7u  ERROR\n", test->name, vectors);
+                    }
+                    printf("      %-28s %08x, expected %08x%s\n", cpuTestRuns[r].name, hash[r], hash[0],
+                           hash[r] == hash[0] ? " (other core)" : "");
+                }
+            }
+            if (errors == 0) {
+                printf("  %-58s %7u  %08x ok\n", test->name, vectors, hash[0]);
+            }
+            else {
+                failed++;
+            }
+        }
+    }
+
+    if (failed > 0) {
+        printf("%d tests FAILED\n", failed);
+    }
+    else {
+        printf("All tests passed\n");
+    }
+
+    return failed;
+}
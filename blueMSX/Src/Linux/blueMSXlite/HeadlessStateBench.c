@@ -0,0 +1,217 @@
+/*****************************************************************************
+** $Source: /cygdrive/d/Private/_SVNROOT/bluemsx/blueMSX/Src/Linux/blueMSXlite/HeadlessStateBench.c,v $
+**
+** $Revision: 1.1 $
+**
+** $Date: 2026-10-18 12:00:00 $
+**
+** More info: http://www.bluemsx.com
+**
+** Copyright (C) 2003-2004 Daniel Vik, Tomas Karlsson
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+******************************************************************************
+*/
+#include "HeadlessBench.h"
+#include "ArchTimer.h"
+#include "Board.h"
+#include "SaveState.h"
+#include "zlib.h"
+#include <stdio.h>
+
+static volatile int stateBenchWritten;
+
+static UInt32 fileSize(const char* fileName)
+{
+    FILE* f = fopen(fileName, "rb");
+    UInt32 size = 0;
+
+    if (f != NULL) {
+        fseek(f, 0, SEEK_END);
+        size = ftell(f);
+        fclose(f);
+    }
+    return size;
+}
+
+static void onStateWritten(void* ref, const char* fileName, int success)
+{
+    if (success) {
+        stateBenchWritten++;
+    }
+}
+
+// Times saving and loading the state of the running machine in
+// each save state format.
+void stateBench(BoardContext* board, const char* fileName, int count)
+{
+    static const struct {
+        const char*     name;
+        SaveStateFormat format;
+    } formats[] = {
+        { "zip",               SAVESTATE_FORMAT_ZIP },
+        { "binary",            SAVESTATE_FORMAT_BINARY },
+        { "binary+compressed", SAVESTATE_FORMAT_BINARY_COMPRESSED }
+    };
+    SaveStateFormat oldFormat = saveStateGetFormat(board);
+    int i;
+    int j;
+
+    for (i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
+        UInt32 saveTime;
+        UInt32 loadTime;
+        UInt32 asyncTime;
+        UInt32 flushTime;
+
+        saveStateSetFormat(board, formats[i].format);
+
+        saveTime = archGetSystemUpTime(1000);
+        for (j = 0; j < count; j++) {
+            boardSaveState(board, fileName, 0);
+        }
+        saveTime = archGetSystemUpTime(1000) - saveTime;
+
+        loadTime = archGetSystemUpTime(1000);
+        for (j = 0; j < count; j++) {
+            boardRestoreState(board, fileName);
+        }
+        loadTime = archGetSystemUpTime(1000) - loadTime;
+
+        // Time the caller is blocked by an async save and the time 
+        // until the writer thread has written it
+        stateBenchWritten = 0;
+        asyncTime = 0;
+        flushTime = 0;
+        for (j = 0; j < count; j++) {
+            UInt32 startTime = archGetSystemUpTime(1000000);
+            boardSaveStateAsync(board, fileName, 0, onStateWritten, NULL);
+            asyncTime += archGetSystemUpTime(1000000) - startTime;
+            saveStateFlush();
+            flushTime += archGetSystemUpTime(1000000) - startTime;
+        }
+
+        printf("%-18s save %7.3f ms  load %7.3f ms  size %7u bytes\n", formats[i].name,
+               (double)saveTime / count, (double)loadTime / count,
+               fileSize(fileName));
+        printf("%-18s async save %7.3f ms  written after %7.3f ms  (%d/%d written)\n", "",
+               asyncTime / 1000.0 / count, flushTime / 1000.0 / count,
+               stateBenchWritten, count);
+    }
+
+    saveStateSetFormat(board, oldFormat);
+    remove(fileName);
+}
+
+/////////////////////////////////////////////////////////////
+// Run-ahead test
+//
+// Run-ahead loads a snapshot at every frame while the timer anchor is
+// one or more frames after the snapshot was taken, so the restored
+// timers end up on both sides of the anchor. The machine state is
+// hashed at a fixed rate on the real timeline and has to be the same
+// with and without run-ahead.
+
+#define RUN_AHEAD_TEST_FREQUENCY 10
+
+static BoardSnapshot* runAheadTestSnapshot;
+static UInt32 runAheadTestHash;
+static int    runAheadTestCount;
+static UInt32 runAheadTestAnchor;
+static UInt32 runAheadTestRestoreAnchor;
+static int    runAheadTestRestoring;
+static int    runAheadTestBefore;
+static int    runAheadTestAfter;
+
+static void runAheadTestCb(void* ref, UInt32 time)
+{
+    BoardContext* board = (BoardContext*)ref;
+    const void* data;
+    int size;
+
+    boardSnapshotSave(board, runAheadTestSnapshot);
+    data = boardSnapshotGetData(runAheadTestSnapshot, &size);
+
+    runAheadTestHash = crc32(runAheadTestHash, data, size);
+    runAheadTestCount++;
+}
+
+// Counts the timers added while a snapshot is loaded that are due
+// before and after the anchor from before the load
+static void runAheadTestTrace(BoardTimerTraceOp op, BoardTimer* timer, UInt32 time, UInt32 timeout)
+{
+    switch (op) {
+    case BOARD_TIMER_ANCHOR:
+        if ((Int32)(time - runAheadTestAnchor) < 0) {
+            runAheadTestRestoreAnchor = runAheadTestAnchor;
+            runAheadTestRestoring     = 1;
+        }
+        runAheadTestAnchor = time;
+        break;
+    case BOARD_TIMER_ADD:
+        if (runAheadTestRestoring) {
+            if ((Int32)(timeout - runAheadTestRestoreAnchor) < 0) {
+                runAheadTestBefore++;
+            }
+            else {
+                runAheadTestAfter++;
+            }
+        }
+        break;
+    case BOARD_TIMER_FIRE:
+        runAheadTestRestoring = 0;
+        break;
+    default:
+        break;
+    }
+}
+
+// Sets up the next run of the test, without run-ahead for frames 0
+void runAheadTestStart(BoardContext* board, int frames)
+{
+    if (runAheadTestSnapshot == NULL) {
+        runAheadTestSnapshot = boardSnapshotCreate();
+    }
+    runAheadTestHash  = 0;
+    runAheadTestCount = 0;
+    runAheadTestBefore = 0;
+    runAheadTestAfter  = 0;
+    runAheadTestAnchor = 0;
+    runAheadTestRestoring = 0;
+
+    boardSetRunAhead(board, frames);
+    boardSetPeriodicCallback(board, runAheadTestCb, board, RUN_AHEAD_TEST_FREQUENCY);
+    boardTimerSetTrace(board, frames > 0 ? runAheadTestTrace : NULL);
+}
+
+// Ends a run of the test and returns the hash of the machine states
+UInt32 runAheadTestEnd(BoardContext* board, int frames)
+{
+    boardSetPeriodicCallback(board, NULL, NULL, 0);
+    boardTimerSetTrace(board, NULL);
+    boardSetRunAhead(board, 0);
+
+    if (frames == 0) {
+        printf("run-ahead off  %5d states  hash %08x\n",
+               runAheadTestCount, runAheadTestHash);
+    }
+    else {
+        printf("run-ahead %-3d  %5d states  hash %08x  restored timers %d before and %d after the anchor\n",
+               frames, runAheadTestCount, runAheadTestHash, runAheadTestBefore, runAheadTestAfter);
+    }
+    return runAheadTestHash;
+}
@@ -0,0 +1,368 @@
+/*****************************************************************************
+** $Source: /cygdrive/d/Private/_SVNROOT/bluemsx/blueMSX/Src/Linux/blueMSXlite/HeadlessTimerBench.c,v $
+**
+** $Revision: 1.1 $
+**
+** $Date: 2026-10-18 12:00:00 $
+**
+** More info: http://www.bluemsx.com
+**
+** Copyright (C) 2003-2004 Daniel Vik, Tomas Karlsson
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+******************************************************************************
+*/
+#include "HeadlessBench.h"
+#include "Board.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+//
+// Records the board timer operations of a headless run and replays them
+// on a copy of the board timer heap and on a copy of the sorted timer
+// list it replaced. Both have to take the timers off the queue in the
+// recorded order.
+//
+
+#define TIMER_BENCH_MAX_EVENTS  (8 * 1024 * 1024)
+#define TIMER_BENCH_MAX_TIMERS  256
+
+#define TEST_TIME 0x7fffffff
+
+typedef struct {
+    UInt8  op;
+    UInt8  id;
+    UInt32 time;
+    UInt32 timeout;
+} TimerEvent;
+
+typedef struct BenchTimer BenchTimer;
+
+struct BenchTimer {
+    BenchTimer* next;
+    BenchTimer* prev;
+    UInt32      timeout;
+    UInt32      sequence;
+    int         index;
+};
+
+typedef struct {
+    BenchTimer  timers[TIMER_BENCH_MAX_TIMERS];
+    BenchTimer* heap[TIMER_BENCH_MAX_TIMERS];
+    int         heapSize;
+    BenchTimer  list;
+    UInt32      sequence;
+    UInt32      anchor;
+    UInt32      nextTimeout;
+    int         errors;
+    int         maxQueued;
+} TimerReplay;
+
+static BoardTimer* traceTimers[TIMER_BENCH_MAX_TIMERS];
+static int         traceTimerCount;
+static TimerEvent* traceEvents;
+static int         traceCount;
+static int         traceDropped;
+
+static void onTimerTrace(BoardTimerTraceOp op, BoardTimer* timer, UInt32 time, UInt32 timeout)
+{
+    TimerEvent* event;
+    int id = 0;
+
+    if (traceCount == TIMER_BENCH_MAX_EVENTS) {
+        traceDropped++;
+        return;
+    }
+
+    if (timer != NULL) {
+        for (id = 0; id < traceTimerCount && traceTimers[id] != timer; id++);
+        if (id == TIMER_BENCH_MAX_TIMERS) {
+            traceDropped++;
+            return;
+        }
+        if (id == traceTimerCount) {
+            traceTimers[traceTimerCount++] = timer;
+        }
+    }
+
+    event = traceEvents + traceCount++;
+    event->op      = (UInt8)op;
+    event->id      = (UInt8)id;
+    event->time    = time;
+    event->timeout = timeout;
+}
+
+void timerBenchRecord(BoardContext* board)
+{
+    traceEvents = malloc(TIMER_BENCH_MAX_EVENTS * sizeof(TimerEvent));
+    traceCount  = 0;
+
+    boardTimerSetTrace(board, onTimerTrace);
+}
+
+/////////////////////////////////////////////////////////////
+// Binary heap, as in Board.c
+
+static int heapBefore(TimerReplay* r, BenchTimer* a, BenchTimer* b)
+{
+    UInt32 ta = a->timeout - r->anchor;
+    UInt32 tb = b->timeout - r->anchor;
+
+    if (ta != tb) {
+        return ta < tb;
+    }
+    return (Int32)(a->sequence - b->sequence) > 0;
+}
+
+static void heapSet(TimerReplay* r, int index, BenchTimer* timer)
+{
+    r->heap[index] = timer;
+    timer->index   = index;
+}
+
+static void heapSiftUp(TimerReplay* r, int index)
+{
+    BenchTimer* timer = r->heap[index];
+
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (!heapBefore(r, timer, r->heap[parent])) {
+            break;
+        }
+        heapSet(r, index, r->heap[parent]);
+        index = parent;
+    }
+    heapSet(r, index, timer);
+}
+
+static void heapSiftDown(TimerReplay* r, int index)
+{
+    BenchTimer* timer = r->heap[index];
+
+    for (;;) {
+        int child = 2 * index + 1;
+        if (child >= r->heapSize) {
+            break;
+        }
+        if (child + 1 < r->heapSize && heapBefore(r, r->heap[child + 1], r->heap[child])) {
+            child++;
+        }
+        if (!heapBefore(r, r->heap[child], timer)) {
+            break;
+        }
+        heapSet(r, index, r->heap[child]);
+        index = child;
+    }
+    heapSet(r, index, timer);
+}
+
+static void heapRemove(TimerReplay* r, BenchTimer* timer)
+{
+    int index = timer->index;
+
+    if (index < 0) {
+        return;
+    }
+
+    timer->index = -1;
+
+    if (--r->heapSize == index) {
+        return;
+    }
+
+    heapSet(r, index, r->heap[r->heapSize]);
+    if (index > 0 && heapBefore(r, r->heap[index], r->heap[(index - 1) / 2])) {
+        heapSiftUp(r, index);
+    }
+    else {
+        heapSiftDown(r, index);
+    }
+}
+
+static void heapReplay(TimerReplay* r, const TimerEvent* event, int count)
+{
+    int i;
+
+    r->heapSize = 0;
+    for (i = 0; i < TIMER_BENCH_MAX_TIMERS; i++) {
+        r->timers[i].index = -1;
+    }
+
+    for (; count > 0; count--, event++) {
+        BenchTimer* timer = r->timers + event->id;
+
+        switch (event->op) {
+        case BOARD_TIMER_ADD:
+            heapRemove(r, timer);
+            timer->timeout  = event->timeout;
+            timer->sequence = ++r->sequence;
+            heapSet(r, r->heapSize++, timer);
+            heapSiftUp(r, timer->index);
+            r->nextTimeout = r->heap[0]->timeout;
+            if (r->heapSize > r->maxQueued) {
+                r->maxQueued = r->heapSize;
+            }
+            break;
+        case BOARD_TIMER_REMOVE:
+            heapRemove(r, timer);
+            break;
+        case BOARD_TIMER_FIRE:
+            if (r->heapSize == 0 || r->heap[0] != timer) {
+                r->errors++;
+            }
+            heapRemove(r, timer);
+            break;
+        case BOARD_TIMER_ANCHOR:
+            r->anchor = event->time;
+            break;
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////
+// Sorted list, as in Board.c before the heap
+
+static void listRemove(BenchTimer* timer)
+{
+    BenchTimer* next = timer->next;
+    BenchTimer* prev = timer->prev;
+
+    next->prev = prev;
+    prev->next = next;
+
+    timer->next = timer;
+    timer->prev = timer;
+}
+
+static void listReplay(TimerReplay* r, const TimerEvent* event, int count)
+{
+    BenchTimer* list = &r->list;
+    int i;
+
+    list->next = list;
+    list->prev = list;
+    for (i = 0; i < TIMER_BENCH_MAX_TIMERS; i++) {
+        r->timers[i].next = r->timers + i;
+        r->timers[i].prev = r->timers + i;
+    }
+
+    for (; count > 0; count--, event++) {
+        BenchTimer* timer = r->timers + event->id;
+        BenchTimer* refTimer;
+
+        switch (event->op) {
+        case BOARD_TIMER_ADD:
+            listRemove(timer);
+            list->timeout = event->time + TEST_TIME;
+            refTimer = list->next;
+            while (event->timeout - r->anchor > refTimer->timeout - r->anchor) {
+                refTimer = refTimer->next;
+            }
+            timer->timeout       = event->timeout;
+            timer->next          = refTimer;
+            timer->prev          = refTimer->prev;
+            refTimer->prev->next = timer;
+            refTimer->prev       = timer;
+            r->nextTimeout = list->next->timeout;
+            break;
+        case BOARD_TIMER_REMOVE:
+            listRemove(timer);
+            break;
+        case BOARD_TIMER_FIRE:
+            if (list->next != timer) {
+                r->errors++;
+            }
+            listRemove(timer);
+            break;
+        case BOARD_TIMER_ANCHOR:
+            r->anchor = event->time;
+            break;
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////
+
+typedef struct {
+    void      (*replayTrace)(TimerReplay*, const TimerEvent*, int);
+    TimerReplay replay;
+    UInt32      passes;
+    int         errors;
+    int         maxQueued;
+} TimerBenchRun;
+
+// Replays the trace and returns the rate in million operations per
+// second of process time
+static double timerBenchRun(void* ref)
+{
+    TimerBenchRun* run = (TimerBenchRun*)ref;
+    TimerReplay* r = &run->replay;
+    clock_t startTime;
+    double elapsed;
+    UInt32 i;
+
+    r->errors    = 0;
+    r->maxQueued = 0;
+    r->anchor    = 0;
+
+    startTime = clock();
+    for (i = 0; i < run->passes; i++) {
+        run->replayTrace(r, traceEvents, traceCount);
+    }
+    elapsed = (double)(clock() - startTime) / CLOCKS_PER_SEC;
+
+    run->errors    = r->errors;
+    run->maxQueued = r->maxQueued;
+
+    return elapsed > 0 ? (double)traceCount * run->passes / elapsed / 1000000 : 0;
+}
+
+// Replays the timer trace recorded since timerBenchRecord() count times
+// with each timer queue and prints the speed.
+void timerBench(BoardContext* board, UInt32 count)
+{
+    TimerBenchRun* list = calloc(1, sizeof(TimerBenchRun));
+    TimerBenchRun* heap = calloc(1, sizeof(TimerBenchRun));
+    double listRate;
+    double heapRate;
+
+    boardTimerSetTrace(board, NULL);
+
+    list->replayTrace = listReplay;
+    list->passes = count;
+    heap->replayTrace = heapReplay;
+    heap->passes = count;
+
+    listRate = headlessBenchBest(timerBenchRun, list);
+    heapRate = headlessBenchBest(timerBenchRun, heap);
+
+    printf("Timer trace: %d operations on %d timers, up to %d queued%s\n",
+           traceCount, traceTimerCount, heap->maxQueued,
+           traceDropped > 0 ? " (trace truncated)" : "");
+    printf("sorted list  %7.1f M ops/s  %s\n", listRate,
+           list->errors ? "FIRE ORDER DIFFERS" : "fire order ok");
+    printf("binary heap  %7.1f M ops/s  %s  (%.2fx)\n", heapRate,
+           heap->errors ? "FIRE ORDER DIFFERS" : "fire order ok",
+           listRate > 0 ? heapRate / listRate : 0.0);
+
+    free(list);
+    free(heap);
+    free(traceEvents);
+    traceEvents = NULL;
+}
@@ -0,0 +1,425 @@
+/*****************************************************************************
+** $Source: /cygdrive/d/Private/_SVNROOT/bluemsx/blueMSX/Src/Linux/blueMSXlite/HeadlessVideoBench.c,v $
+**
+** $Revision: 1.1 $
+**
+** $Date: 2026-10-18 12:00:00 $
+**
+** More info: http://www.bluemsx.com
+**
+** Copyright (C) 2003-2004 Daniel Vik, Tomas Karlsson
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+******************************************************************************
+*/
+#include "HeadlessBench.h"
+#include "ArchTimer.h"
+#include "ArchThread.h"
+#include "VideoRender.h"
+#include "FrameBuffer.h"
+#include "Board.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Video benchmark. Renders a frame of random pixels with each set of
+// video kernels, and the scaling filters with more and more threads.
+// Checks that the images match the ones rendered with the generic
+// kernels or one thread and prints the speed in destination Mpixel/s.
+// A doubleWidth of 2 makes every other line double width.
+static const struct {
+    const char*  name;
+    int          bitDepth;
+    int          zoom;
+    int          lines;
+    int          doubleWidth;
+    int          interlace;
+    int          scanLinesPct;
+    int          saturationWidth;
+    VideoPalMode palMode;
+    int          canChangeZoom;
+} videoBenchRuns[] = {
+    { "copy 2x2",                32, 2, 240, 0, 0,  0, 0, VIDEO_PAL_FAST,        0 },
+    { "copy 2x2 double width",   32, 2, 240, 1, 0,  0, 0, VIDEO_PAL_FAST,        0 },
+    { "copy 2x1",                32, 2, 480, 0, 0,  0, 0, VIDEO_PAL_FAST,        0 },
+    { "copy 2x1 double width",   32, 2, 480, 1, 0,  0, 0, VIDEO_PAL_FAST,        0 },
+    { "copy 1x1",                32, 1, 240, 0, 0,  0, 0, VIDEO_PAL_FAST,        0 },
+    { "copy 1x1 double width",   32, 1, 240, 1, 0,  0, 0, VIDEO_PAL_FAST,        0 },
+    { "copy 1x05",               32, 1, 480, 0, 0,  0, 0, VIDEO_PAL_FAST,        0 },
+    { "copy 1x05 double width",  32, 1, 480, 1, 0,  0, 0, VIDEO_PAL_FAST,        0 },
+    { "copy 2x2 16",             16, 2, 240, 0, 0,  0, 0, VIDEO_PAL_FAST,        0 },
+    { "copy 2x2 16 dw",          16, 2, 240, 1, 0,  0, 0, VIDEO_PAL_FAST,        0 },
+    { "copy 2x1 16",             16, 2, 480, 0, 0,  0, 0, VIDEO_PAL_FAST,        0 },
+    { "copy 2x1 16 dw",          16, 2, 480, 1, 0,  0, 0, VIDEO_PAL_FAST,        0 },
+    { "copy 1x1 16",             16, 1, 240, 0, 0,  0, 0, VIDEO_PAL_FAST,        0 },
+    { "copy 1x1 16 dw",          16, 1, 240, 1, 0,  0, 0, VIDEO_PAL_FAST,        0 },
+    { "copy 1x05 16",            16, 1, 480, 0, 0,  0, 0, VIDEO_PAL_FAST,        0 },
+    { "copy 1x05 16 dw",         16, 1, 480, 1, 0,  0, 0, VIDEO_PAL_FAST,        0 },
+    { "copy 2x2 + scanlines 16", 16, 2, 240, 0, 0, 50, 0, VIDEO_PAL_FAST,        0 },
+    { "copy 2x2 + scanlines 32", 32, 2, 240, 0, 0, 50, 0, VIDEO_PAL_FAST,        0 },
+    { "copy 2x2 + saturation 1", 32, 2, 240, 0, 0,  0, 1, VIDEO_PAL_FAST,        0 },
+    { "copy 2x2 + saturation 2", 32, 2, 240, 0, 0,  0, 2, VIDEO_PAL_FAST,        0 },
+    { "copy 2x2 + saturation 3", 32, 2, 240, 0, 0,  0, 3, VIDEO_PAL_FAST,        0 },
+    { "copy 2x2 + saturation 4", 32, 2, 240, 0, 0,  0, 4, VIDEO_PAL_FAST,        0 },
+    { "monitor 2x2",             32, 2, 240, 0, 0,  0, 0, VIDEO_PAL_MONITOR,     0 },
+    { "monitor 2x2 dw",          32, 2, 240, 1, 0,  0, 0, VIDEO_PAL_MONITOR,     0 },
+    { "monitor 2x2 odd field",   32, 2, 240, 2, 1,  0, 0, VIDEO_PAL_MONITOR,     0 },
+    { "monitor 2x1",             32, 2, 480, 0, 0,  0, 0, VIDEO_PAL_MONITOR,     0 },
+    { "monitor 2x1 dw",          32, 2, 480, 1, 0,  0, 0, VIDEO_PAL_MONITOR,     0 },
+    { "monitor 1x1",             32, 1, 240, 0, 0,  0, 0, VIDEO_PAL_MONITOR,     0 },
+    { "monitor 1x1 dw",          32, 1, 240, 1, 0,  0, 0, VIDEO_PAL_MONITOR,     0 },
+    { "monitor 1x05",            32, 1, 480, 0, 0,  0, 0, VIDEO_PAL_MONITOR,     0 },
+    { "monitor 1x05 dw",         32, 1, 480, 1, 0,  0, 0, VIDEO_PAL_MONITOR,     0 },
+    { "monitor 2x2 16",          16, 2, 240, 0, 0,  0, 0, VIDEO_PAL_MONITOR,     0 },
+    { "monitor 2x2 16 dw",       16, 2, 240, 1, 0,  0, 0, VIDEO_PAL_MONITOR,     0 },
+    { "monitor 2x2 16 odd",      16, 2, 240, 2, 1,  0, 0, VIDEO_PAL_MONITOR,     0 },
+    { "monitor 2x1 16",          16, 2, 480, 0, 0,  0, 0, VIDEO_PAL_MONITOR,     0 },
+    { "monitor 2x1 16 dw",       16, 2, 480, 1, 0,  0, 0, VIDEO_PAL_MONITOR,     0 },
+    { "monitor 1x1 16",          16, 1, 240, 0, 0,  0, 0, VIDEO_PAL_MONITOR,     0 },
+    { "monitor 1x1 16 dw",       16, 1, 240, 1, 0,  0, 0, VIDEO_PAL_MONITOR,     0 },
+    { "sharp 2x2",               32, 2, 240, 0, 0,  0, 0, VIDEO_PAL_SHARP,       0 },
+    { "sharp 2x2 dw",            32, 2, 240, 1, 0,  0, 0, VIDEO_PAL_SHARP,       0 },
+    { "sharp 2x1",               32, 2, 480, 0, 0,  0, 0, VIDEO_PAL_SHARP,       0 },
+    { "sharp 2x1 dw",            32, 2, 480, 1, 0,  0, 0, VIDEO_PAL_SHARP,       0 },
+    { "sharp noise 2x2",         32, 2, 240, 0, 0,  0, 0, VIDEO_PAL_SHARP_NOISE, 0 },
+    { "sharp noise 2x2 dw",      32, 2, 240, 1, 0,  0, 0, VIDEO_PAL_SHARP_NOISE, 0 },
+    { "sharp noise 2x2 odd",     32, 2, 240, 2, 1,  0, 0, VIDEO_PAL_SHARP_NOISE, 0 },
+    { "sharp noise 2x1",         32, 2, 480, 0, 0,  0, 0, VIDEO_PAL_SHARP_NOISE, 0 },
+    { "sharp noise 2x1 dw",      32, 2, 480, 1, 0,  0, 0, VIDEO_PAL_SHARP_NOISE, 0 },
+    { "sharp noise 1x1",         32, 1, 240, 0, 0,  0, 0, VIDEO_PAL_SHARP_NOISE, 0 },
+    { "sharp noise 1x1 dw",      32, 1, 240, 1, 0,  0, 0, VIDEO_PAL_SHARP_NOISE, 0 },
+    { "sharp noise 1x05",        32, 1, 480, 0, 0,  0, 0, VIDEO_PAL_SHARP_NOISE, 0 },
+    { "sharp noise 1x05 dw",     32, 1, 480, 1, 0,  0, 0, VIDEO_PAL_SHARP_NOISE, 0 },
+    { "sharp 2x2 16",            16, 2, 240, 0, 0,  0, 0, VIDEO_PAL_SHARP,       0 },
+    { "sharp 2x2 16 dw",         16, 2, 240, 1, 0,  0, 0, VIDEO_PAL_SHARP,       0 },
+    { "sharp 2x1 16",            16, 2, 480, 0, 0,  0, 0, VIDEO_PAL_SHARP,       0 },
+    { "sharp 2x1 16 dw",         16, 2, 480, 1, 0,  0, 0, VIDEO_PAL_SHARP,       0 },
+    { "sharp noise 2x2 16",      16, 2, 240, 0, 0,  0, 0, VIDEO_PAL_SHARP_NOISE, 0 },
+    { "sharp noise 2x2 16 dw",   16, 2, 240, 1, 0,  0, 0, VIDEO_PAL_SHARP_NOISE, 0 },
+    { "sharp noise 2x2 16 odd",  16, 2, 240, 2, 1,  0, 0, VIDEO_PAL_SHARP_NOISE, 0 },
+    { "sharp noise 2x1 16",      16, 2, 480, 0, 0,  0, 0, VIDEO_PAL_SHARP_NOISE, 0 },
+    { "sharp noise 2x1 16 dw",   16, 2, 480, 1, 0,  0, 0, VIDEO_PAL_SHARP_NOISE, 0 },
+    { "sharp noise 1x1 16",      16, 1, 240, 0, 0,  0, 0, VIDEO_PAL_SHARP_NOISE, 0 },
+    { "sharp noise 1x1 16 dw",   16, 1, 240, 1, 0,  0, 0, VIDEO_PAL_SHARP_NOISE, 0 },
+    { "blur 2x2",                32, 2, 240, 0, 0,  0, 0, VIDEO_PAL_BLUR,        0 },
+    { "blur 2x2 dw",             32, 2, 240, 1, 0,  0, 0, VIDEO_PAL_BLUR,        0 },
+    { "blur 2x1",                32, 2, 480, 0, 0,  0, 0, VIDEO_PAL_BLUR,        0 },
+    { "blur 2x1 dw",             32, 2, 480, 1, 0,  0, 0, VIDEO_PAL_BLUR,        0 },
+    { "blur noise 2x2",          32, 2, 240, 0, 0,  0, 0, VIDEO_PAL_BLUR_NOISE,  0 },
+    { "blur noise 2x2 dw",       32, 2, 240, 1, 0,  0, 0, VIDEO_PAL_BLUR_NOISE,  0 },
+    { "blur noise 2x2 odd",      32, 2, 240, 2, 1,  0, 0, VIDEO_PAL_BLUR_NOISE,  0 },
+    { "blur noise 2x1",          32, 2, 480, 0, 0,  0, 0, VIDEO_PAL_BLUR_NOISE,  0 },
+    { "blur noise 2x1 dw",       32, 2, 480, 1, 0,  0, 0, VIDEO_PAL_BLUR_NOISE,  0 },
+    { "blur noise 1x05",         32, 1, 480, 0, 0,  0, 0, VIDEO_PAL_BLUR_NOISE,  0 },
+    { "blur noise 1x05 dw",      32, 1, 480, 1, 0,  0, 0, VIDEO_PAL_BLUR_NOISE,  0 },
+    { "blur noise 2x2 16",       16, 2, 240, 0, 0,  0, 0, VIDEO_PAL_BLUR_NOISE,  0 },
+    { "blur noise 2x1 16",       16, 2, 480, 0, 0,  0, 0, VIDEO_PAL_BLUR_NOISE,  0 },
+    { "scale2x 16",              16, 2, 240, 0, 0,  0, 0, VIDEO_PAL_SCALE2X,     0 },
+    { "scale2x 32",              32, 2, 240, 0, 0,  0, 0, VIDEO_PAL_SCALE2X,     0 },
+    { "hq2x",                    32, 2, 240, 0, 0,  0, 0, VIDEO_PAL_HQ2X,        0 },
+    { "hq3x",                    32, 2, 240, 0, 0,  0, 0, VIDEO_PAL_HQ2X,        1 },
+};
+
+#define VIDEO_BENCH_PITCH (960 * sizeof(UInt32))
+#define VIDEO_BENCH_SIZE  (720 * VIDEO_BENCH_PITCH)
+
+typedef struct {
+    Video*       video;
+    FrameBuffer* frame;
+    int          run;
+    UInt32       frames;
+    void*        pDst;
+} VideoBenchRun;
+
+static double videoBenchRun(void* ref)
+{
+    VideoBenchRun* bench = (VideoBenchRun*)ref;
+    // Wall time, the filters may run on several threads
+    UInt32 startTime = archGetSystemUpTime(1000000);
+    double elapsed;
+    int zoom = 1;
+    UInt32 j;
+
+    for (j = 0; j < bench->frames; j++) {
+        zoom = videoRender(bench->video, bench->frame, videoBenchRuns[bench->run].bitDepth, 
+                           videoBenchRuns[bench->run].zoom, bench->pDst, 0, VIDEO_BENCH_PITCH, 
+                           videoBenchRuns[bench->run].canChangeZoom);
+    }
+    elapsed = (archGetSystemUpTime(1000000) - startTime) / 1000000.0;
+
+    return elapsed > 0 ? bench->frames * 76800.0 * zoom * zoom / elapsed / 1000000 : 0;
+}
+
+// Each measurement renders with a new video, so the noise of the PAL
+// methods starts from the same seed and the images can be compared
+static double videoBenchBest(FrameBuffer* frame, int run, int threads, UInt32 frames, void* pDst)
+{
+    Video* benchVideo = videoCreate();
+    VideoBenchRun bench = { benchVideo, frame, run, frames, pDst };
+    double rate;
+
+    memset(pDst, 0, VIDEO_BENCH_SIZE);
+
+    videoSetFilterThreads(benchVideo, threads);
+    videoSetPalMode(benchVideo, videoBenchRuns[run].palMode);
+    videoSetScanLines(benchVideo, videoBenchRuns[run].scanLinesPct > 0, videoBenchRuns[run].scanLinesPct);
+    videoSetColorSaturation(benchVideo, videoBenchRuns[run].saturationWidth > 0, videoBenchRuns[run].saturationWidth);
+
+    rate = headlessBenchBest(videoBenchRun, &bench);
+
+    videoDestroy(benchVideo);
+
+    return rate;
+}
+
+int videoBench(UInt32 frames)
+{
+    static const struct {
+        const char* name;
+        VideoSimd   simd;
+    } simds[] = {
+        { "SSE2", VIDEO_SIMD_SSE2 },
+        { "NEON", VIDEO_SIMD_NEON },
+        { "auto", VIDEO_SIMD_AUTO },
+    };
+    static const int threadCounts[] = { 2, 4, 8 };
+    FrameBuffer* frame = (FrameBuffer*)calloc(1, sizeof(FrameBuffer));
+    UInt8* genericBuffer = (UInt8*)calloc(1, VIDEO_BENCH_SIZE);
+    UInt8* buffer = (UInt8*)calloc(1, VIDEO_BENCH_SIZE);
+    VideoSimd oldSimd;
+    UInt32 rnd = 1;
+    int failed = 0;
+    int i;
+    int j;
+
+    // Selects the kernels of the first video before the old set is saved
+    videoDestroy(videoCreate());
+    oldSimd = videoGetSimd();
+
+    for (i = 0; i < FB_MAX_LINES; i++) {
+        for (j = 0; j < FB_MAX_LINE_WIDTH; j++) {
+            rnd = rnd * 1103515245 + 12345;
+            frame->line[i].buffer[j] = (UInt16)(rnd >> 16);
+        }
+    }
+    frame->maxWidth = 272;
+
+    for (i = 0; i < (int)(sizeof(videoBenchRuns) / sizeof(videoBenchRuns[0])); i++) {
+        double genericRate;
+        double rate;
+        int differ;
+
+        frame->lines     = videoBenchRuns[i].lines;
+        frame->interlace = videoBenchRuns[i].interlace ? INTERLACE_ODD : INTERLACE_NONE;
+        for (j = 0; j < FB_MAX_LINES; j++) {
+            frame->line[j].doubleWidth = videoBenchRuns[i].doubleWidth == 2 ? j & 1 : videoBenchRuns[i].doubleWidth;
+        }
+
+        videoSetSimd(VIDEO_SIMD_NONE);
+        genericRate = videoBenchBest(frame, i, 1, frames, genericBuffer);
+
+        if (videoBenchRuns[i].palMode == VIDEO_PAL_SCALE2X || videoBenchRuns[i].palMode == VIDEO_PAL_HQ2X) {
+            // The filters have no SIMD kernels, compare the thread counts
+            videoSetSimd(oldSimd);
+            printf("%-24s 1 thread  %8.1f Mpixel/s\n", videoBenchRuns[i].name, genericRate);
+
+            for (j = 0; j < (int)(sizeof(threadCounts) / sizeof(threadCounts[0])); j++) {
+                rate = videoBenchBest(frame, i, threadCounts[j], frames, buffer);
+                differ = memcmp(buffer, genericBuffer, VIDEO_BENCH_SIZE) != 0;
+                printf("%-24s %d threads %8.1f Mpixel/s  (%.2fx)%s\n", 
+                       videoBenchRuns[i].name, threadCounts[j], rate, rate / genericRate,
+                       differ ? "  RESULTS DIFFER" : "");
+                failed += differ;
+            }
+            continue;
+        }
+
+        printf("%-24s generic   %8.1f Mpixel/s\n", videoBenchRuns[i].name, genericRate);
+
+        for (j = 0; j < (int)(sizeof(simds) / sizeof(simds[0])); j++) {
+            if (!videoSetSimd(simds[j].simd)) {
+                continue;
+            }
+            rate = videoBenchBest(frame, i, 1, frames, buffer);
+            differ = memcmp(buffer, genericBuffer, VIDEO_BENCH_SIZE) != 0;
+            printf("%-24s %-9s %8.1f Mpixel/s  (%.2fx)%s\n", 
+                   videoBenchRuns[i].name, simds[j].name, rate, rate / genericRate,
+                   differ ? "  RESULTS DIFFER" : "");
+            failed += differ;
+        }
+    }
+
+    // Throughput of each kernel on the test line VIDEO_SIMD_AUTO times
+    printf("\n%-28s %10s", "kernel", "generic");
+    for (j = 0; j < (int)(sizeof(simds) / sizeof(simds[0])) - 1; j++) {
+        if (videoIsSimdSupported(simds[j].simd)) {
+            printf(" %10s", simds[j].name);
+        }
+    }
+    printf("  auto\n");
+
+    for (i = 0; i < videoGetKernelCount(); i++) {
+        VideoSimd simd = videoGetKernelSimd(i);
+
+        printf("%-28s %10.1f", videoGetKernelName(i), videoGetKernelRate(i, VIDEO_SIMD_NONE));
+        for (j = 0; j < (int)(sizeof(simds) / sizeof(simds[0])) - 1; j++) {
+            if (videoIsSimdSupported(simds[j].simd)) {
+                printf(" %10.1f", videoGetKernelRate(i, simds[j].simd));
+            }
+        }
+        printf("  %s\n", simd == VIDEO_SIMD_SSE2 ? "SSE2" : simd == VIDEO_SIMD_NEON ? "NEON" : "generic");
+    }
+
+    if (failed > 0) {
+        printf("%d results differ\n", failed);
+    }
+
+    videoSetSimd(oldSimd);
+    free(buffer);
+    free(genericBuffer);
+    free(frame);
+
+    return failed;
+}
+
+// The draw side fills each frame with its sequence number, so a frame
+// that is flipped to the view side while it is drawn shows two numbers.
+// A mix of two frames is one colour unless one of them is being drawn.
+static BoardContext* flipBenchBoard;
+static volatile int flipBenchDone;
+static int flipBenchMix;
+static UInt32 flipBenchViews;
+static UInt32 flipBenchTorn;
+static UInt32 flipBenchOlder;
+
+static UInt32 flipBenchSequence(FrameBuffer* frame)
+{
+    return frame->line[0].buffer[0] | ((UInt32)frame->line[0].buffer[1] << 16);
+}
+
+static void flipBenchViewer()
+{
+    UInt32 lastSequence = 0;
+
+    while (!archAtomicGet(&flipBenchDone)) {
+        FrameBuffer* frame = frameBufferFlipViewFrameMix(flipBenchBoard, flipBenchMix, 50);
+        UInt32 sequence = flipBenchSequence(frame);
+        UInt16 color = frame->line[0].buffer[2];
+        int torn = 0;
+        int y;
+        int x;
+
+        for (y = 0; y < frame->lines && !torn; y++) {
+            for (x = y == 0 ? 2 : 0; x < frame->maxWidth; x++) {
+                if (frame->line[y].buffer[x] != color) {
+                    torn = 1;
+                    break;
+                }
+            }
+        }
+        if (!flipBenchMix) {
+            torn |= color != (UInt16)sequence;
+            flipBenchOlder += sequence < lastSequence;
+        }
+        flipBenchTorn  += torn;
+        flipBenchViews++;
+        lastSequence = sequence;
+    }
+}
+
+// With two frames the draw side draws into the view, so some torn
+// frames are expected there and only a missing last frame fails
+int flipBench(UInt32 frames)
+{
+    static const struct {
+        int frameCount;
+        int mixFrames;
+    } setups[] = { { 2, 0 }, { 3, 0 }, { 4, 0 }, { 4, 1 } };
+    int failed = 0;
+    int i;
+
+    flipBenchBoard = boardContextCreate();
+
+    for (i = 0; i < (int)(sizeof(setups) / sizeof(setups[0])); i++) {
+        FrameBufferData* frameData;
+        UInt32 maxFlipTime = 0;
+        UInt32 startTime;
+        UInt32 elapsed;
+        UInt32 sequence;
+        void* viewer;
+
+        frameBufferSetFrameCount(flipBenchBoard, setups[i].frameCount);
+        frameData = frameBufferDataCreate(flipBenchBoard, 272, 240, 1);
+        frameBufferSetActive(flipBenchBoard, frameData);
+
+        flipBenchDone  = 0;
+        flipBenchMix   = setups[i].mixFrames;
+        flipBenchViews = 0;
+        flipBenchTorn  = 0;
+        flipBenchOlder = 0;
+        viewer = archThreadCreate(flipBenchViewer, THREAD_PRIO_NORMAL);
+
+        startTime = archGetSystemUpTime(1000000);
+        for (sequence = 1; sequence <= frames; sequence++) {
+            FrameBuffer* frame = frameBufferGetDrawFrame(flipBenchBoard);
+            UInt32 flipTime;
+            int y;
+
+            for (y = 0; y < frame->lines; y++) {
+                UInt16* buffer = frame->line[y].buffer;
+                int x;
+
+                for (x = 0; x < frame->maxWidth; x++) {
+                    buffer[x] = (UInt16)sequence;
+                }
+            }
+            frame->line[0].buffer[1] = (UInt16)(sequence >> 16);
+
+            flipTime = archGetSystemUpTime(1000000);
+            frameBufferFlipDrawFrame(flipBenchBoard);
+            flipTime = archGetSystemUpTime(1000000) - flipTime;
+            if (flipTime > maxFlipTime) {
+                maxFlipTime = flipTime;
+            }
+        }
+        elapsed = archGetSystemUpTime(1000000) - startTime;
+
+        archAtomicSet(&flipBenchDone, 1);
+        archThreadJoin(viewer, -1);
+        archThreadDestroy(viewer);
+
+        // The view side gets the last frame once the draw side is done
+        sequence = flipBenchSequence(frameBufferFlipViewFrameMix(flipBenchBoard, 0, 0));
+
+        printf("%d frames%s  %u flips in %.2f s  max flip %u us  %u views  %u torn  %u out of order%s\n",
+               setups[i].frameCount, setups[i].mixFrames ? " mixed" : "", frames, elapsed / 1000000.0, maxFlipTime, flipBenchViews,
+               flipBenchTorn, flipBenchOlder, sequence == frames ? "" : "  LAST FRAME MISSING");
+
+        failed += sequence != frames;
+        if (setups[i].frameCount > 2) {
+            failed += flipBenchTorn + flipBenchOlder > 0;
+        }
+
+        frameBufferSetActive(flipBenchBoard, NULL);
+        frameBufferDataDestroy(flipBenchBoard, frameData);
+    }
+
+    boardContextDestroy(flipBenchBoard);
+
+    return failed;
+}
@@ -33,6 +33,7 @@
 #include <errno.h>
 #include <sys/time.h>
 #include <stdlib.h>
+#include <unistd.h>
 
 
 
@@ -52,6 +53,10 @@ static void* threadEntry(void* data)
 
 
 void* archThreadCreate(void (*entryPoint)(), int priority) { 
+    return archThreadCreateEx(entryPoint, priority, 65536);
+}
+
+void* archThreadCreateEx(void (*entryPoint)(), int priority, int stacksize) { 
     int rv;
     pthread_t* thread;
     pthread_attr_t attr;
@@ -59,7 +64,7 @@ void* archThreadCreate(void (*entryPoint)(), int priority) {
     size_t size;
     rv = pthread_attr_init(&attr);
 
-    pthread_attr_setstacksize(&attr, 65536);
+    pthread_attr_setstacksize(&attr, stacksize);
 
     thread = (pthread_t*)malloc(sizeof(pthread_t));
 
@@ -109,3 +114,51 @@ void archThreadSleep(int milliseconds)
     tv.tv_usec = milliseconds * 1000;
     select(0, NULL, NULL, NULL, &tv);
 }
+
+int archThreadGetCpuCount()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return count > 0 ? (int)count : 1;
+}
+
+int archAtomicGet(volatile int* value)
+{
+    return __sync_fetch_and_add(value, 0);
+}
+
+void archAtomicSet(volatile int* value, int newValue)
+{
+    archAtomicExchange(value, newValue);
+}
+
+int archAtomicExchange(volatile int* value, int newValue)
+{
+    int oldValue;
+
+    do {
+        oldValue = *value;
+    } while (__sync_val_compare_and_swap(value, oldValue, newValue) != oldValue);
+
+    return oldValue;
+}
+
+int archAtomicCompareExchange(volatile int* value, int oldValue, int newValue)
+{
+    return __sync_val_compare_and_swap(value, oldValue, newValue);
+}
+
+void archThreadOnce(volatile int* once, void (*init)())
+{
+    if (archAtomicGet(once) == 2) {
+        return;
+    }
+    if (archAtomicCompareExchange(once, 0, 1) == 0) {
+        init();
+        archAtomicSet(once, 2);
+        return;
+    }
+    while (archAtomicGet(once) != 2) {
+        archThreadSleep(1);
+    }
+}
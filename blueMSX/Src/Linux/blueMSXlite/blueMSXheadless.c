@@ -0,0 +1,704 @@
+/*****************************************************************************
+** $Source: /cygdrive/d/Private/_SVNROOT/bluemsx/blueMSX/Src/Linux/blueMSXlite/blueMSXheadless.c,v $
+**
+** $Revision: 1.1 $
+**
+** $Date: 2026-10-17 12:00:00 $
+**
+** More info: http://www.bluemsx.com
+**
+** Copyright (C) 2003-2004 Daniel Vik, Tomas Karlsson
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+******************************************************************************
+*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "CommandLine.h"
+#include "Properties.h"
+#include "ArchFile.h"
+#include "ArchTimer.h"
+#include "ArchThread.h"
+#include "VideoRender.h"
+#include "VideoPipeline.h"
+#include "AudioMixer.h"
+#include "Casette.h"
+#include "Machine.h"
+#include "Board.h"
+#include "Emulator.h"
+#include "Actions.h"
+#include "LaunchFile.h"
+#include "Language.h"
+#include "SaveState.h"
+#include "FrameBuffer.h"
+#include "R800.h"
+#include "R800Trace.h"
+#include "HeadlessBench.h"
+
+//
+// Headless runner. Boots a machine with the usual blueMSX command
+// line arguments, runs a fixed number of frames or CPU cycles as fast
+// as the host allows and exits. No display, input or audio device
+// is opened.
+//
+// Exit status is 0 when the budget was run, 1 if the emulation could
+// not be started and 2 on bad arguments.
+//
+// With -render the runner renders a capture to raw video and a wav
+// file instead, using worker processes for parallel segments.
+//
+// The benchmark options (-cpubench, -videobench, ...) are listed in
+// HeadlessBench.c. Each runs on its own without a machine.
+//
+// With -tracedump it disassembles a binary instruction trace.
+//
+
+static Properties* properties;
+static Video* video;
+static Mixer* mixer;
+static int stateBenchCount;
+static UInt32 timerBenchCount;
+static int runAheadTestFrames;
+static char stateBenchFile[512];
+
+// Segments own the frames and samples from their keyframe plus a lead-in
+// up to the start of the next segment. The lead-in (200 ms) gives the
+// frame buffers time to fill after the keyframe is loaded.
+#define RENDER_LEAD_IN (boardFrequency() / 5)
+
+// A segment is run a little (1 ms) past its end, so that the mixer has
+// made the samples up to the end whichever side of a sample boundary
+// the run stops on.
+#define RENDER_LEAD_OUT (boardFrequency() / 1000)
+
+typedef struct {
+    UInt64 start;
+    UInt64 begin;
+    UInt64 end;
+} RenderSegment;
+
+static RenderSegment renderSegment;
+static int          renderZoom;
+static UInt32       renderInterval;
+static UInt64       renderNextFrame;
+static UInt64       renderFramesLeft;
+static UInt32       renderStartTime;
+static BoardTimer*  renderTimer;
+static FILE*        renderVideoFile;
+static FILE*        renderAudioFile;
+static UInt64       renderAudioSkip;
+static UInt64       renderAudioLeft;
+
+int archUpdateEmuDisplay(int syncMode)
+{
+    return 1;
+}
+
+void archTrap(UInt8 value)
+{
+}
+
+void archVideoCaptureSave()
+{
+}
+
+static void setDefaultPaths(const char* rootDir)
+{
+    char buffer[512];
+
+    propertiesSetDirectory(rootDir, rootDir);
+
+    sprintf(buffer, "%s/QuickSave", rootDir);
+    archCreateDirectory(buffer);
+    actionSetQuickSaveSetDirectory(buffer, "");
+
+    sprintf(buffer, "%s/SRAM", rootDir);
+    archCreateDirectory(buffer);
+    boardSetDirectory(buffer);
+
+    sprintf(buffer, "%s/Casinfo", rootDir);
+    archCreateDirectory(buffer);
+    tapeSetDirectory(buffer, "");
+
+    sprintf(buffer, "%s/Databases", rootDir);
+    archCreateDirectory(buffer);
+    mediaDbLoad(buffer);
+
+    sprintf(buffer, "%s/Machines", rootDir);
+    machineSetDirectory(buffer);
+}
+
+// Number of audio samples from the start of the capture until time
+static UInt64 renderSampleCount(UInt64 time)
+{
+    UInt64 rate = mixerGetSampleRate(mixer);
+
+    return (time * rate + boardFrequency() - 1) / boardFrequency();
+}
+
+// Number of frames from the start of the capture until time. Frame
+// n is shown at n frame intervals into the capture, frame 0 is never
+// shown since nothing is drawn yet.
+static UInt64 renderFrameCount(UInt64 time)
+{
+    UInt64 frames = (time + renderInterval - 1) / renderInterval;
+
+    return frames > 0 ? frames - 1 : 0;
+}
+
+// Writes the frames the render thread has finished
+static void renderWriteImages()
+{
+    VideoImage* image;
+
+    while ((image = videoPipelineGetNext()) != NULL) {
+        fwrite(image->pixels, 4, image->width * image->height, renderVideoFile);
+    }
+}
+
+// The frame is rendered by the pipeline while the emulation goes on.
+// The finished images are written first, which leaves the render
+// thread a free image for each frame.
+static void renderFrameCb(void* timer, UInt32 time)
+{
+    renderWriteImages();
+    videoPipelinePublish(1, 1);
+    renderFramesLeft--;
+
+    renderNextFrame += renderInterval;
+    if (renderFramesLeft > 0) {
+        boardTimerAdd(renderTimer, renderStartTime + (UInt32)(renderNextFrame - renderSegment.start));
+    }
+}
+
+// Called one frame interval after the segment started. Frames are
+// timed from the start of the capture, so the frame timer is armed
+// here instead of using the periodic callback.
+static void renderStartCb(void* ref, UInt32 time)
+{
+    BoardContext* board = (BoardContext*)ref;
+
+    boardSetPeriodicCallback(board, NULL, NULL, 0);
+
+    renderStartTime = time - renderInterval;
+    renderTimer     = boardTimerCreate(board, renderFrameCb, NULL);
+
+    if (renderFramesLeft > 0) {
+        UInt32 frameTime = renderStartTime + (UInt32)(renderNextFrame - renderSegment.start);
+
+        // The first frame of the capture is due now
+        if (frameTime == time) {
+            renderFrameCb(renderTimer, time);
+        }
+        else {
+            boardTimerAdd(renderTimer, frameTime);
+        }
+    }
+}
+
+static Int32 renderAudioWrite(void* dummy, Int16* buffer, UInt32 count)
+{
+    // Audio is stereo, and the callback counts individual samples
+    count /= 2;
+
+    if (renderAudioSkip > 0) {
+        UInt32 skip = renderAudioSkip < count ? (UInt32)renderAudioSkip : count;
+        renderAudioSkip -= skip;
+        buffer += 2 * skip;
+        count  -= skip;
+    }
+    if (count > renderAudioLeft) {
+        count = (UInt32)renderAudioLeft;
+    }
+    if (count > 0) {
+        fwrite(buffer, 4, count, renderAudioFile);
+        renderAudioLeft -= count;
+    }
+    return 0;
+}
+
+static void renderSegmentDone()
+{
+    mixerSync(mixer);
+}
+
+static FILE* renderOpenAt(const char* fileName, UInt64 offset)
+{
+    FILE* file = fopen(fileName, "r+b");
+
+    if (file != NULL && fseeko(file, (off_t)offset, SEEK_SET) != 0) {
+        fclose(file);
+        file = NULL;
+    }
+    return file;
+}
+
+// Plays back one segment of the capture and writes its frames and
+// samples at their place in the output files. Runs in a worker process.
+static int renderCaptureSegment(const char* capture, const char* output)
+{
+    UInt32 frameSize = 4 * 320 * renderZoom * 240 * renderZoom;
+    char fileName[512];
+    UInt64 cycles;
+    UInt64 frame;
+
+    frame = renderFrameCount(renderSegment.begin);
+    renderFramesLeft = renderFrameCount(renderSegment.end) - frame;
+    renderNextFrame  = (frame + 1) * renderInterval;
+
+    renderAudioSkip = renderSampleCount(renderSegment.begin) - renderSampleCount(renderSegment.start);
+    renderAudioLeft = renderSampleCount(renderSegment.end) - renderSampleCount(renderSegment.begin);
+
+    sprintf(fileName, "%s.rgb", output);
+    renderVideoFile = renderOpenAt(fileName, frame * frameSize);
+    sprintf(fileName, "%s.wav", output);
+    renderAudioFile = renderOpenAt(fileName, 44 + 4 * renderSampleCount(renderSegment.begin));
+    if (renderVideoFile == NULL || renderAudioFile == NULL) {
+        return 0;
+    }
+
+    mixerSetStereo(mixer, 1);
+    mixerSetWriteCallback(mixer, renderAudioWrite, NULL, 2);
+    mixerSetBoardFrequencyFixed(mixer, 3579545);
+    frameBufferSetFrameCount(emulatorGetBoard(), 4);
+
+    videoPipelineStart(emulatorGetBoard(), video, 0, NULL);
+    videoPipelineSetFormat(32, renderZoom);
+
+    boardCaptureSetPlaybackStart(emulatorGetBoard(), renderSegment.start);
+    boardSetPeriodicCallback(emulatorGetBoard(), renderStartCb, emulatorGetBoard(), properties->video.captureFps);
+
+    cycles = (renderSegment.end + RENDER_LEAD_OUT - renderSegment.start + boardFrequency() / 3579545 - 1) / (boardFrequency() / 3579545);
+    emulatorSetHeadless(0, cycles, renderSegmentDone);
+    emulatorStart(capture);
+
+    if (renderTimer != NULL) {
+        boardTimerDestroy(renderTimer);
+        renderTimer = NULL;
+    }
+
+    renderWriteImages();
+    videoPipelineFlush();
+    renderWriteImages();
+
+    videoPipelineStop();
+
+    if (emulatorGetHeadlessCycles() == 0) {
+        return 0;
+    }
+
+    // The segment is not padded if the run ended early, since the
+    // output would no longer match a render in one piece
+    if (renderFramesLeft > 0 || renderAudioLeft > 0) {
+        printf("Segment at %llu ended %llu frames and %llu samples short\n",
+               (unsigned long long)renderSegment.start,
+               (unsigned long long)renderFramesLeft, (unsigned long long)renderAudioLeft);
+        fflush(stdout);
+        return 0;
+    }
+
+    return fclose(renderVideoFile) == 0 && fclose(renderAudioFile) == 0;
+}
+
+static void writeUInt32(FILE* file, UInt32 value)
+{
+    UInt8 data[4] = { (UInt8)value, (UInt8)(value >> 8), (UInt8)(value >> 16), (UInt8)(value >> 24) };
+    fwrite(data, 1, 4, file);
+}
+
+static void writeUInt16(FILE* file, UInt16 value)
+{
+    UInt8 data[2] = { (UInt8)value, (UInt8)(value >> 8) };
+    fwrite(data, 1, 2, file);
+}
+
+static int writeWavHeader(const char* fileName, UInt32 rate, UInt32 dataSize)
+{
+    FILE* file = fopen(fileName, "wb");
+
+    if (file == NULL) {
+        return 0;
+    }
+
+    fwrite("RIFF", 1, 4, file);
+    writeUInt32(file, dataSize + 36);
+    fwrite("WAVEfmt ", 1, 8, file);
+    writeUInt32(file, 16);
+    writeUInt16(file, 1);
+    writeUInt16(file, 2);
+    writeUInt32(file, rate);
+    writeUInt32(file, rate * 4);
+    writeUInt16(file, 4);
+    writeUInt16(file, 16);
+    fwrite("data", 1, 4, file);
+    writeUInt32(file, dataSize);
+
+    return fclose(file) == 0;
+}
+
+// Renders a capture to <output>.rgb (raw 32 bit BGRX frames) and
+// <output>.wav. The capture is split into segments at its keyframes
+// and up to 'jobs' segments are played back at the same time, each
+// in its own process since the emulator state is global. The frame
+// and sample count of every segment is known up front, so each worker
+// writes directly to its part of the output files.
+static int renderCapture(const char* capture, const char* output, int jobs)
+{
+    RenderSegment* segments;
+    UInt64* keyframes;
+    UInt64 length;
+    UInt64 leadIn;
+    int count;
+    int running = 0;
+    int next = 0;
+    int failed = 0;
+    int i;
+    char fileName[512];
+    FILE* file;
+
+    count = boardCaptureGetKeyframes(capture, NULL, 0, NULL);
+    if (count == 0) {
+        printf("%s is not a capture file\n", capture);
+        return 0;
+    }
+
+    keyframes = malloc(count * sizeof(UInt64));
+    segments  = malloc(count * sizeof(RenderSegment));
+    boardCaptureGetKeyframes(capture, keyframes, count, &length);
+
+    renderZoom     = properties->video.captureSize == 0 ? 1 : 2;
+    renderInterval = boardFrequency() / properties->video.captureFps;
+    leadIn         = RENDER_LEAD_IN > renderInterval ? RENDER_LEAD_IN : renderInterval;
+
+    for (i = 0; i < count; i++) {
+        segments[i].start = keyframes[i];
+        segments[i].begin = i == 0 ? 0 : keyframes[i] + leadIn;
+        segments[i].end   = i == count - 1 ? length : keyframes[i + 1] + leadIn;
+        if (segments[i].begin > length) segments[i].begin = length;
+        if (segments[i].end   > length) segments[i].end   = length;
+    }
+
+    sprintf(fileName, "%s.rgb", output);
+    file = fopen(fileName, "wb");
+    if (file == NULL || fclose(file) != 0) {
+        failed = 1;
+    }
+    sprintf(fileName, "%s.wav", output);
+    if (!writeWavHeader(fileName, mixerGetSampleRate(mixer), (UInt32)(4 * renderSampleCount(length)))) {
+        failed = 1;
+    }
+
+    fflush(stdout);
+
+    while ((next < count && !failed) || running > 0) {
+        int status;
+
+        while (running < jobs && next < count && !failed) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                renderSegment = segments[next];
+                _exit(renderCaptureSegment(capture, output) ? 0 : 1);
+            }
+            if (pid < 0) {
+                failed = 1;
+                break;
+            }
+            running++;
+            next++;
+        }
+        if (running > 0 && wait(&status) > 0) {
+            running--;
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                failed = 1;
+            }
+        }
+    }
+
+    free(keyframes);
+    free(segments);
+
+    if (failed) {
+        printf("Failed to render %s\n", capture);
+        return 0;
+    }
+
+    printf("Rendered %d segments, %llu frames of %dx%d at %d fps\n", count,
+           (unsigned long long)renderFrameCount(length),
+           320 * renderZoom, 240 * renderZoom, properties->video.captureFps);
+    printf("e.g. ffmpeg -f rawvideo -pix_fmt bgr0 -s %dx%d -r %d -i %s.rgb -i %s.wav %s.mp4\n",
+           320 * renderZoom, 240 * renderZoom, properties->video.captureFps, output, output, output);
+
+    return 1;
+}
+
+static void onHeadlessDone()
+{
+    stateBench(emulatorGetBoard(), stateBenchFile, stateBenchCount);
+}
+
+// Runs the machine given by the command line for the given frames or
+// cycles and prints the speed. Returns 2 if the command line could not
+// be parsed, otherwise 0 with the number of cycles run (0 if the
+// emulation did not start).
+static int runHeadless(char* szLine, UInt32 frames, UInt64 cycles, UInt64* cyclesRun)
+{
+    UInt32 startTime;
+    UInt32 elapsed;
+    int result;
+
+    emulatorSetHeadless(frames, cycles, stateBenchCount > 0 ? onHeadlessDone : NULL);
+
+    startTime = archGetSystemUpTime(1000);
+
+    result = emuTryStartWithArguments(properties, szLine, NULL);
+    if (result < 0) {
+        printf("Failed to parse command line\n");
+        return 2;
+    }
+    if (result == 0) {
+        emulatorStart(NULL);
+    }
+
+    elapsed    = archGetSystemUpTime(1000) - startTime;
+    *cyclesRun = emulatorGetHeadlessCycles();
+
+    if (*cyclesRun > 0) {
+        printf("%s: %llu cycles in %u ms (%.1fx real time)\n",
+               properties->emulation.machineName, (unsigned long long)*cyclesRun, elapsed,
+               elapsed > 0 ? (double)*cyclesRun / 3579.545 / elapsed : 0.0);
+    }
+    else {
+        printf("%s: failed to start emulation\n", properties->emulation.machineName);
+    }
+
+    return 0;
+}
+
+static void usage()
+{
+    printf("Usage: blueMSXheadless -frames <n> | -cycles <n> [-statebench <n>] [-timerbench <n>]\n");
+    printf("                       [-runaheadtest <n>] [blueMSX arguments]\n");
+    printf("       blueMSXheadless -render <capture> <output> [-jobs <n>]\n");
+    headlessBenchUsage();
+    printf("       blueMSXheadless -tracedump <trace> <n>\n");
+    printf("\n");
+    printf("  -frames <n>     Run n video frames\n");
+    printf("  -cycles <n>     Run n CPU cycles (at 3.579545 MHz)\n");
+    printf("  -statebench <n> Save and load the state n times per save state\n");
+    printf("                  format when the run is done and print the times\n");
+    printf("  -timerbench <n> Record the board timer operations of the run and\n");
+    printf("                  replay them n times with the timer heap and with\n");
+    printf("                  the old sorted timer list\n");
+    printf("  -runaheadtest <n>\n");
+    printf("                  Run twice, the second time with n frames of\n");
+    printf("                  run-ahead, and check that the machine states\n");
+    printf("                  saved along the way are the same. Machines\n");
+    printf("                  with a clock chip start from the host time\n");
+    printf("                  and can't be compared\n");
+    printf("  -render <capture> <output>\n");
+    printf("                  Render a capture to <output>.rgb and <output>.wav\n");
+    printf("  -jobs <n>       Number of capture segments rendered in parallel\n");
+    printf("                  (default is the number of CPUs)\n");
+    headlessBenchHelp();
+    printf("  -tracedump <trace> <n>\n");
+    printf("                  Disassemble the last n instructions in an\n");
+    printf("                  instruction trace, or all of them if n is 0\n");
+    printf("\n");
+    printf("e.g. blueMSXheadless -frames 3000 -machine MSX2 -rom1 game.rom\n");
+}
+
+int main(int argc, char **argv)
+{
+    char szLine[8192] = "";
+    UInt32 frames = 0;
+    UInt64 cycles = 0;
+    UInt32 startTime;
+    UInt64 cyclesRun;
+    int resetProperties;
+    char* renderFile = NULL;
+    char* renderOutput = NULL;
+    int renderJobs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    const HeadlessBench* bench = NULL;
+    UInt32 benchCount = 0;
+    char* traceFile = NULL;
+    UInt64 traceCount = 0;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-frames") == 0 && i + 1 < argc) {
+            frames = (UInt32)strtoul(argv[++i], NULL, 0);
+            continue;
+        }
+        if (strcmp(argv[i], "-cycles") == 0 && i + 1 < argc) {
+            cycles = (UInt64)strtoull(argv[++i], NULL, 0);
+            continue;
+        }
+        if (strcmp(argv[i], "-statebench") == 0 && i + 1 < argc) {
+            stateBenchCount = atoi(argv[++i]);
+            continue;
+        }
+        if (strcmp(argv[i], "-runaheadtest") == 0 && i + 1 < argc) {
+            runAheadTestFrames = atoi(argv[++i]);
+            continue;
+        }
+        if (strcmp(argv[i], "-timerbench") == 0 && i + 1 < argc) {
+            timerBenchCount = (UInt32)strtoul(argv[++i], NULL, 0);
+            continue;
+        }
+        if (strcmp(argv[i], "-render") == 0 && i + 2 < argc) {
+            renderFile   = argv[++i];
+            renderOutput = argv[++i];
+            continue;
+        }
+        if (strcmp(argv[i], "-jobs") == 0 && i + 1 < argc) {
+            renderJobs = atoi(argv[++i]);
+            continue;
+        }
+        if (headlessBenchFind(argv[i]) != NULL && i + 1 < argc) {
+            bench      = headlessBenchFind(argv[i]);
+            benchCount = (UInt32)strtoul(argv[++i], NULL, 0);
+            continue;
+        }
+        if (strcmp(argv[i], "-tracedump") == 0 && i + 2 < argc) {
+            traceFile  = argv[++i];
+            traceCount = (UInt64)strtoull(argv[++i], NULL, 0);
+            continue;
+        }
+        if (strchr(argv[i], ' ') != NULL) {
+            strcat(szLine, "\"");
+            strcat(szLine, argv[i]);
+            strcat(szLine, "\" ");
+        }
+        else {
+            strcat(szLine, argv[i]);
+            strcat(szLine, " ");
+        }
+    }
+
+    if (bench != NULL && benchCount > 0) {
+        return headlessBenchRun(bench, benchCount) > 0 ? 1 : 0;
+    }
+
+    if (traceFile != NULL) {
+        if (!r800TraceDecode(traceFile, stdout, traceCount)) {
+            printf("Failed to read trace %s\n", traceFile);
+            return 1;
+        }
+        return 0;
+    }
+
+    if (frames == 0 && cycles == 0 && renderFile == NULL) {
+        usage();
+        return 2;
+    }
+
+    setDefaultPaths(archGetCurrentDirectory());
+
+    resetProperties = emuCheckResetArgument(szLine);
+    properties = propCreate(resetProperties, 0, P_KBD_EUROPEAN, 0, "");
+
+    properties->emulation.syncMethod = P_EMU_SYNCIGNORE;
+    properties->emulation.speed      = 50;
+
+    video = videoCreate();
+    mixer = mixerCreate();
+
+    emulatorInit(properties, mixer);
+    actionInit(video, properties, mixer);
+    langInit();
+    tapeSetReadOnly(emulatorGetBoard(), properties->cassette.readOnly);
+
+    mediaDbSetDefaultRomType(properties->cartridge.defaultType);
+
+    {
+        Machine* machine = machineCreate(properties->emulation.machineName);
+        if (machine != NULL) {
+            boardSetMachine(emulatorGetBoard(), machine);
+            machineDestroy(machine);
+        }
+    }
+    boardSetFdcTimingEnable(emulatorGetBoard(), properties->emulation.enableFdcTiming);
+    boardSetY8950Enable(emulatorGetBoard(), properties->sound.chip.enableY8950);
+    boardSetYm2413Enable(emulatorGetBoard(), properties->sound.chip.enableYM2413);
+    boardSetMoonsoundEnable(emulatorGetBoard(), properties->sound.chip.enableMoonsound);
+    boardSetVideoAutodetect(emulatorGetBoard(), properties->video.chipAutodetect);
+
+    if (renderFile != NULL) {
+        videoUpdateAll(video, properties);
+
+        startTime = archGetSystemUpTime(1000);
+        i = renderCapture(renderFile, renderOutput, renderJobs > 0 ? renderJobs : 1);
+        printf("%u ms\n", archGetSystemUpTime(1000) - startTime);
+
+        videoDestroy(video);
+        free(properties);
+        mixerDestroy(mixer);
+
+        return i ? 0 : 1;
+    }
+
+    sprintf(stateBenchFile, "%s/QuickSave/statebench.sta", archGetCurrentDirectory());
+
+    if (timerBenchCount > 0) {
+        timerBenchRecord(emulatorGetBoard());
+    }
+
+    if (runAheadTestFrames > 0) {
+        UInt32 hash;
+
+        runAheadTestStart(emulatorGetBoard(), 0);
+        i = runHeadless(szLine, frames, cycles, &cyclesRun);
+        hash = runAheadTestEnd(emulatorGetBoard(), 0);
+        if (i == 0 && cyclesRun > 0) {
+            runAheadTestStart(emulatorGetBoard(), runAheadTestFrames);
+            i = runHeadless(szLine, frames, cycles, &cyclesRun);
+            if (runAheadTestEnd(emulatorGetBoard(), runAheadTestFrames) != hash) {
+                printf("Run-ahead test failed, the machine states differ\n");
+                cyclesRun = 0;
+            }
+            else {
+                printf("Run-ahead test passed\n");
+            }
+        }
+    }
+    else {
+        i = runHeadless(szLine, frames, cycles, &cyclesRun);
+    }
+    if (i != 0) {
+        return i;
+    }
+
+    if (timerBenchCount > 0) {
+        timerBench(emulatorGetBoard(), timerBenchCount);
+    }
+
+    saveStateStopWriter();
+
+    // Don't write the forced sync settings back to bluemsx.ini
+    videoDestroy(video);
+    free(properties);
+    mixerDestroy(mixer);
+
+    return cyclesRun > 0 ? 0 : 1;
+}
@@ -37,6 +37,7 @@
 #include "Properties.h"
 #include "ArchFile.h"
 #include "VideoRender.h"
+#include "VideoPipeline.h"
 #include "AudioMixer.h"
 #include "Casette.h"
 #include "PrinterIO.h"
@@ -45,6 +46,9 @@
 #include "Machine.h"
 #include "Board.h"
 #include "ArchEvent.h"
+#include "ArchThread.h"
+#include "Emulator.h"
+#include "SaveState.h"
 
 static Properties* properties;
 static Video* video;
@@ -55,8 +59,7 @@ static Display* display;
 static Screen* screen;
 static XImage* ximage;
 static int bitDepth;
-static int dpyUpdateEvent = 0;
-static void* dpyUpdateAckEvent = NULL;
+static volatile int dpyUpdateEvent = 0;
 
 #define WIDTH  640
 #define HEIGHT 480
@@ -126,49 +129,44 @@ int createX11Window(const char *title, int width, int height, int bitDepth)
   return 1;
 }
 
+int updateEmuDisplay();
+
 int  archUpdateEmuDisplay(int syncMode) 
 {
+    videoPipelinePublish(properties->emulation.syncMethod == P_EMU_SYNCTOVBLANKASYNC,
+                         properties->emulation.syncMethod == P_EMU_SYNCFRAMES);
 #ifdef LINUX_TEST
     updateEmuDisplay();
     XSync(display, 0);
-    return;
 #endif
-    dpyUpdateEvent = 1;
-    if (properties->emulation.syncMethod == P_EMU_SYNCFRAMES) {
-        archEventWait(dpyUpdateAckEvent, 500);
-    }
     return 1;
 }
 
-int updateEmuDisplay() 
+// Called on the render thread when an image is ready
+static void onImageReady()
 {
-    FrameBuffer* frameBuffer;
-    int bytesPerPixel = bitDepth / 8;
-    char* dpyData  = ximage->data;  
-    int borderWidth;
-    int dstOffset;
-
-    frameBuffer = frameBufferFlipViewFrame(0);
-    if (frameBuffer == NULL) {
-        frameBuffer = frameBufferGetWhiteNoiseFrame();
-    }
-
-    borderWidth = 320 - frameBuffer->maxWidth;
+    archAtomicSet(&dpyUpdateEvent, 1);
+}
 
-    videoRender(video, frameBuffer, bitDepth, 2, 
-                dpyData + borderWidth * bytesPerPixel, 
-                0, WIDTH * bytesPerPixel, -1);
+// Shows the newest image from the render thread. Only the rows that
+// changed since the last image shown are sent to the display.
+int updateEmuDisplay() 
+{
+    VideoImage* image;
+    int i;
 
-    if (borderWidth > 0) {
-        int h = HEIGHT;
-        while (h--) {
-            memset(dpyData, 0, borderWidth * bytesPerPixel);
-            memset(dpyData + (WIDTH - borderWidth) * bytesPerPixel, 0, borderWidth * bytesPerPixel);
-            dpyData += WIDTH * bytesPerPixel;
-        }
+    image = videoPipelineGetLatest();
+    if (image == NULL || image->bitDepth != bitDepth) {
+        return 0;
     }
 
-    XPutImage(display, window, DefaultGCOfScreen(screen), ximage, 0, 0, 0, 0, WIDTH,HEIGHT);
+    for (i = 0; i < image->rectCount; i++) {
+        memcpy(ximage->data + image->rect[i].y * image->pitch, 
+               (char*)image->pixels + image->rect[i].y * image->pitch, 
+               image->rect[i].height * image->pitch);
+        XPutImage(display, window, DefaultGCOfScreen(screen), ximage, 
+                  0, image->rect[i].y, 0, image->rect[i].y, WIDTH, image->rect[i].height);
+    }
 
     return 0; 
 }
@@ -232,20 +230,22 @@ int main(int argc, char **argv)
         return 0;
     }
     
-    dpyUpdateAckEvent = archEventCreate(0);
-
     video = videoCreate();
     videoSetColors(video, properties->video.saturation, properties->video.brightness, 
                   properties->video.contrast, properties->video.gamma);
     videoSetScanLines(video, properties->video.scanlinesEnable, properties->video.scanlinesPct);
     videoSetColorSaturation(video, properties->video.colorSaturationEnable, properties->video.colorSaturationWidth);
+
+    // Frames are rendered on their own thread and shown here
+    videoPipelineStart(emulatorGetBoard(), video, 1, onImageReady);
+    videoPipelineSetFormat(bitDepth, 2);
     
     mixer = mixerCreate();
     
     emulatorInit(properties, mixer);
     actionInit(video, properties, mixer);
     langInit();
-    tapeSetReadOnly(properties->cassette.readOnly);
+    tapeSetReadOnly(emulatorGetBoard(), properties->cassette.readOnly);
     
     langSetLanguage(properties->language);
     
@@ -292,15 +292,16 @@ int main(int argc, char **argv)
     {
         Machine* machine = machineCreate(properties->emulation.machineName);
         if (machine != NULL) {
-            boardSetMachine(machine);
+            boardSetMachine(emulatorGetBoard(), machine);
             machineDestroy(machine);
         }
     }
-    boardSetFdcTimingEnable(properties->emulation.enableFdcTiming);
-    boardSetY8950Enable(properties->sound.chip.enableY8950);
-    boardSetYm2413Enable(properties->sound.chip.enableYM2413);
-    boardSetMoonsoundEnable(properties->sound.chip.enableMoonsound);
-    boardSetVideoAutodetect(properties->video.chipAutodetect);
+    boardSetFdcTimingEnable(emulatorGetBoard(), properties->emulation.enableFdcTiming);
+    boardSetRunAhead(emulatorGetBoard(), properties->emulation.runAhead);
+    boardSetY8950Enable(emulatorGetBoard(), properties->sound.chip.enableY8950);
+    boardSetYm2413Enable(emulatorGetBoard(), properties->sound.chip.enableYM2413);
+    boardSetMoonsoundEnable(emulatorGetBoard(), properties->sound.chip.enableMoonsound);
+    boardSetVideoAutodetect(emulatorGetBoard(), properties->video.chipAutodetect);
 
     XSync(display, 0);
     
@@ -315,16 +316,19 @@ int main(int argc, char **argv)
     }
 
     for (i = 0; i < 50000; i++) {
-        if (dpyUpdateEvent) {
+        if (archAtomicExchange(&dpyUpdateEvent, 0)) {
             updateEmuDisplay();
             XSync(display, 0);
-            dpyUpdateEvent = 0;
-            archEventSet(dpyUpdateAckEvent);
         }
         archThreadSleep(10);
     }
 
-    
+    emulatorStop();
+    videoPipelineStop();
+
+    // Let queued save states finish writing
+    saveStateStopWriter();
+
     videoDestroy(video);
     propDestroy(properties);
     archSoundDestroy();
@@ -1225,7 +1225,7 @@ extern "C" void mediaDbSetDefaultRomType(RomType romType)
     romdbDefaultType = romType;
 }
 
-extern "C" MediaType* mediaDbGuessRom(const void *buffer, int size) 
+extern "C" MediaType* mediaDbGuessRom(BoardContext* board, const void *buffer, int size) 
 {
     static MediaType staticMediaType(ROM_UNKNOWN, "Unknown MSX rom");
 
@@ -1250,7 +1250,7 @@ extern "C" MediaType* mediaDbGuessRom(const void *buffer, int size)
         return mediaType;
     }
 
-    BoardType boardType = boardGetType();
+    BoardType boardType = boardGetType(board);
 
     switch (boardType) {
     case BOARD_SVI:
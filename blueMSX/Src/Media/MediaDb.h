@@ -28,6 +28,8 @@
 #ifndef MEDIA_DB_H
 #define MEDIA_DB_H
 
+#include "MsxTypes.h"
+
 typedef int RomType;
 enum  {
     ROM_UNKNOWN     = 0,
@@ -221,7 +223,7 @@ void mediaDbCreateCasdb();
 
 
 MediaType* mediaDbLookupRom(const void *buffer, int size);
-MediaType* mediaDbGuessRom(const void *buffer, int size);
+MediaType* mediaDbGuessRom(BoardContext* board, const void *buffer, int size);
 MediaType* mediaDbLookupDisk(const void *buffer, int size);
 MediaType* mediaDbLookupCas(const void *buffer, int size);
 
@@ -45,6 +45,7 @@ typedef struct {
 
 struct AmdFlash
 {
+    BoardContext* board;
     UInt8* romData;
     UInt32 cmdAddr1;
     UInt32 cmdAddr2;
@@ -188,7 +189,7 @@ void amdFlashReset(AmdFlash* rm)
 
 void amdFlashSaveState(AmdFlash* rm)
 {
-    SaveState* state = saveStateOpenForWrite("amdFlash");
+    SaveState* state = saveStateOpenForWrite(rm->board, "amdFlash");
     int i;
 
     for (i = 0; i < 8; i++) {
@@ -206,7 +207,7 @@ void amdFlashSaveState(AmdFlash* rm)
 
 void amdFlashLoadState(AmdFlash* rm)
 {
-    SaveState* state = saveStateOpenForRead("amdFlash");
+    SaveState* state = saveStateOpenForRead(rm->board, "amdFlash");
     int i;
 
     for (i = 0; i < 8; i++) {
@@ -222,10 +223,11 @@ void amdFlashLoadState(AmdFlash* rm)
     saveStateClose(state);
 }
 
-AmdFlash* amdFlashCreate(AmdType type, int flashSize, int sectorSize, UInt32 writeProtectMask, void* romData, int size, const char* sramFilename, int loadSram)
+AmdFlash* amdFlashCreate(BoardContext* board, AmdType type, int flashSize, int sectorSize, UInt32 writeProtectMask, void* romData, int size, const char* sramFilename, int loadSram)
 {
     AmdFlash* rm = (AmdFlash*)calloc(1, sizeof(AmdFlash));
 
+    rm->board = board;
     rm->writeProtectMask = writeProtectMask;
 
     if (type == 0) {
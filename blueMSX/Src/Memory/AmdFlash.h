@@ -35,7 +35,7 @@ typedef struct AmdFlash AmdFlash;
 typedef enum { AMD_TYPE_1, AMD_TYPE_2 } AmdType;
 
 
-AmdFlash* amdFlashCreate(AmdType type, int flashSize, int sectorSize, UInt32 writeProtectMask, 
+AmdFlash* amdFlashCreate(BoardContext* board, AmdType type, int flashSize, int sectorSize, UInt32 writeProtectMask, 
                          void* romData, int size, const char* sramFilename, int loadSram);
 void amdFlashDestroy(AmdFlash* rm);
 
@@ -45,6 +45,7 @@ typedef struct {
 
 struct AtmelPerom
 {
+    BoardContext* board;
     UInt8* romData;
     UInt32 cmdAddr1;
     UInt32 cmdAddr2;
@@ -188,7 +189,7 @@ void atmelPeromReset(AtmelPerom* rm)
 
 void atmelPeromSaveState(AtmelPerom* rm)
 {
-    SaveState* state = saveStateOpenForWrite("atmelPerom");
+    SaveState* state = saveStateOpenForWrite(rm->board, "atmelPerom");
     int i;
 
     for (i = 0; i < 8; i++) {
@@ -206,7 +207,7 @@ void atmelPeromSaveState(AtmelPerom* rm)
 
 void atmelPeromLoadState(AtmelPerom* rm)
 {
-    SaveState* state = saveStateOpenForRead("atmelPerom");
+    SaveState* state = saveStateOpenForRead(rm->board, "atmelPerom");
     int i;
 
     for (i = 0; i < 8; i++) {
@@ -222,10 +223,11 @@ void atmelPeromLoadState(AtmelPerom* rm)
     saveStateClose(state);
 }
 
-AtmelPerom* atmelPeromCreate(AmdType type, int flashSize, int sectorSize, UInt32 writeProtectMask, void* romData, int size, const char* sramFilename, int loadSram)
+AtmelPerom* atmelPeromCreate(BoardContext* board, AmdType type, int flashSize, int sectorSize, UInt32 writeProtectMask, void* romData, int size, const char* sramFilename, int loadSram)
 {
     AtmelPerom* rm = (AtmelPerom*)calloc(1, sizeof(AtmelPerom));
 
+    rm->board = board;
     rm->writeProtectMask = writeProtectMask;
 
     if (type == 0) {
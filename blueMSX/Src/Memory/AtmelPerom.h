@@ -35,7 +35,7 @@ typedef struct AtmelPerom AtmelPerom;
 typedef enum { AMD_TYPE_1, AMD_TYPE_2 } AmdType;
 
 
-AtmelPerom* atmelPeromCreate(AmdType type, int flashSize, int sectorSize, UInt32 writeProtectMask, 
+AtmelPerom* atmelPeromCreate(BoardContext* board, AmdType type, int flashSize, int sectorSize, UInt32 writeProtectMask, 
                          void* romData, int size, const char* sramFilename, int loadSram);
 void atmelPeromDestroy(AtmelPerom* rm);
 
@@ -26,6 +26,7 @@
 ******************************************************************************
 */
 #include "DeviceManager.h"
+#include "Board.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -39,101 +40,118 @@ typedef struct {
     int type;
 } DeviceInfo;
 
-typedef struct {
+struct DeviceManagerContext {
     DeviceInfo di[MAX_DEVICES];
     int count;
     int lastHandle;
     int shutDown;
-} DeviceManager;
+};
+
+DeviceManagerContext* deviceManagerContextCreate()
+{
+    return calloc(1, sizeof(DeviceManagerContext));
+}
 
-static DeviceManager deviceManager;
+void deviceManagerContextDestroy(DeviceManagerContext* context)
+{
+    free(context);
+}
 
-void deviceManagerCreate() {
-    deviceManager.count = 0;
-    deviceManager.lastHandle = 0;
-    deviceManager.shutDown = 0;
+void deviceManagerCreate(BoardContext* board) {
+    DeviceManagerContext* ctx = boardGetDeviceManager(board);
+
+    ctx->count = 0;
+    ctx->lastHandle = 0;
+    ctx->shutDown = 0;
 }
 
-void deviceManagerDestroy()
+void deviceManagerDestroy(BoardContext* board)
 {
+    DeviceManagerContext* ctx = boardGetDeviceManager(board);
     int i;
 
-    deviceManager.shutDown = 1;
+    ctx->shutDown = 1;
     
-    for (i = 0; i < deviceManager.count; i++) {
-        if (deviceManager.di[i].callbacks.destroy != NULL) {
-            deviceManager.di[i].callbacks.destroy(deviceManager.di[i].ref);
+    for (i = 0; i < ctx->count; i++) {
+        if (ctx->di[i].callbacks.destroy != NULL) {
+            ctx->di[i].callbacks.destroy(ctx->di[i].ref);
         }
     }
 }
 
-void deviceManagerReset()
+void deviceManagerReset(BoardContext* board)
 {
+    DeviceManagerContext* ctx = boardGetDeviceManager(board);
     int i;
-    for (i = 0; i < deviceManager.count; i++) {
-        if (deviceManager.di[i].callbacks.reset != NULL) {
-            deviceManager.di[i].callbacks.reset(deviceManager.di[i].ref);
+    for (i = 0; i < ctx->count; i++) {
+        if (ctx->di[i].callbacks.reset != NULL) {
+            ctx->di[i].callbacks.reset(ctx->di[i].ref);
         }
     }
 }
 
-void deviceManagerLoadState()
+void deviceManagerLoadState(BoardContext* board)
 {
+    DeviceManagerContext* ctx = boardGetDeviceManager(board);
     int i;
-    for (i = 0; i < deviceManager.count; i++) {
-        if (deviceManager.di[i].callbacks.loadState != NULL) {
-            deviceManager.di[i].callbacks.loadState(deviceManager.di[i].ref);
+    for (i = 0; i < ctx->count; i++) {
+        if (ctx->di[i].callbacks.loadState != NULL) {
+            ctx->di[i].callbacks.loadState(ctx->di[i].ref);
         }
     }
 }
 
-void deviceManagerSaveState()
+void deviceManagerSaveState(BoardContext* board)
 {
+    DeviceManagerContext* ctx = boardGetDeviceManager(board);
     int i;
-    for (i = 0; i < deviceManager.count; i++) {
-        if (deviceManager.di[i].callbacks.saveState != NULL) {
-            deviceManager.di[i].callbacks.saveState(deviceManager.di[i].ref);
+    for (i = 0; i < ctx->count; i++) {
+        if (ctx->di[i].callbacks.saveState != NULL) {
+            ctx->di[i].callbacks.saveState(ctx->di[i].ref);
         }
     }
 }
 
-int deviceManagerRegister(int type, DeviceCallbacks* callbacks, void* ref)
+int deviceManagerRegister(BoardContext* board, int type, DeviceCallbacks* callbacks, void* ref)
 {
-    if (deviceManager.count >= MAX_DEVICES) {
+    DeviceManagerContext* ctx = boardGetDeviceManager(board);
+
+    if (ctx->count >= MAX_DEVICES) {
         return 0;
     }
 
-    deviceManager.di[deviceManager.count].handle    = ++deviceManager.lastHandle;
-    deviceManager.di[deviceManager.count].type      = type;
-    deviceManager.di[deviceManager.count].callbacks = *callbacks;
-    deviceManager.di[deviceManager.count].ref       = ref;
+    ctx->di[ctx->count].handle    = ++ctx->lastHandle;
+    ctx->di[ctx->count].type      = type;
+    ctx->di[ctx->count].callbacks = *callbacks;
+    ctx->di[ctx->count].ref       = ref;
 
-    deviceManager.count++;
+    ctx->count++;
 
-    return deviceManager.lastHandle;
+    return ctx->lastHandle;
 }
 
-void deviceManagerUnregister(int handle)
+void deviceManagerUnregister(BoardContext* board, int handle)
 {
+    DeviceManagerContext* ctx = boardGetDeviceManager(board);
     int i;
 
-    if (deviceManager.count == 0 || deviceManager.shutDown) {
+    if (ctx->count == 0 || ctx->shutDown) {
         return;
     }
 
-    for (i = 0; i < deviceManager.count; i++) {
-        if (deviceManager.di[i].handle == handle) {
+    for (i = 0; i < ctx->count; i++) {
+        if (ctx->di[i].handle == handle) {
             break;
         }
     }
 
-    if (i == deviceManager.count) {
+    if (i == ctx->count) {
         return;
     }
 
-    deviceManager.count--;
-    while (i < deviceManager.count) {
-        deviceManager.di[i] = deviceManager.di[i + 1];
+    ctx->count--;
+    while (i < ctx->count) {
+        ctx->di[i] = ctx->di[i + 1];
         i++;
     }
 }
@@ -37,15 +37,21 @@ typedef struct {
     void  (*loadState)(void*);
 } DeviceCallbacks;
 
-void deviceManagerCreate();
-void deviceManagerDestroy();
+// The devices of a board, found with boardGetDeviceManager()
+typedef struct DeviceManagerContext DeviceManagerContext;
 
-void deviceManagerReset();
+DeviceManagerContext* deviceManagerContextCreate();
+void deviceManagerContextDestroy(DeviceManagerContext* context);
 
-void deviceManagerLoadState();
-void deviceManagerSaveState();
+void deviceManagerCreate(BoardContext* board);
+void deviceManagerDestroy(BoardContext* board);
 
-int deviceManagerRegister(int type, DeviceCallbacks* callbacks, void* ref);
-void deviceManagerUnregister(int handle);
+void deviceManagerReset(BoardContext* board);
+
+void deviceManagerLoadState(BoardContext* board);
+void deviceManagerSaveState(BoardContext* board);
+
+int deviceManagerRegister(BoardContext* board, int type, DeviceCallbacks* callbacks, void* ref);
+void deviceManagerUnregister(BoardContext* board, int handle);
 
 #endif
@@ -34,131 +34,273 @@
 typedef struct IoPortInfo {
     IoPortRead  read;
     IoPortWrite write;
+    IoPortWriteBlock writeBlock;
     void*       ref;
 } IoPortInfo;
 
-static IoPortInfo ioTable[256];
-static IoPortInfo ioSubTable[256];
-static IoPortInfo ioUnused[2];
-static int currentSubport;
+typedef struct {
+    IoPortRead  read;
+    void*       ref;
+} IoPortReadEntry;
 
-void ioPortReset()
-{
-    memset(ioTable, 0, sizeof(ioTable));
-    memset(ioSubTable, 0, sizeof(ioSubTable));
+typedef struct {
+    IoPortWrite write;
+    IoPortWriteBlock writeBlock;
+    void*       ref;
+} IoPortWriteEntry;
+
+struct IoPortContext {
+    IoPortInfo ioTable[256];
+    IoPortInfo ioSubTable[256];
+    IoPortInfo ioUnused[2];
+    int currentSubport;
+    int subportsEnabled;
 
-    currentSubport = 0;
+    // Handlers called for each port, rebuilt from the tables above on
+    // every change so that an access is a single call
+    IoPortReadEntry  readTable[256];
+    IoPortWriteEntry writeTable[256];
+};
+
+static UInt8 readNone(void* ref, UInt16 port)
+{
+    return 0xff;
 }
 
-void* ioPortGetRef(int port)
+static void writeNone(void* ref, UInt16 port, UInt8 value)
 {
-	return ioTable[port].ref;
 }
 
-void ioPortRegister(int port, IoPortRead read, IoPortWrite write, void* ref)
+static void ioPortUpdate(IoPortContext* ctx, int port);
+
+static void ioPortUpdateSub(IoPortContext* ctx)
 {
-    if (ioTable[port].read  == NULL && 
-        ioTable[port].write == NULL && 
-        ioTable[port].ref   == NULL)
-    {
-        ioTable[port].read  = read;
-        ioTable[port].write = write;
-        ioTable[port].ref   = ref;
+    int port;
+
+    for (port = 0x40; port < 0x50; port++) {
+        ioPortUpdate(ctx, port);
     }
 }
 
-
-void ioPortUnregister(int port)
+static void writeSubport(IoPortContext* ctx, UInt16 port, UInt8 value)
 {
-    ioTable[port].read  = NULL;
-    ioTable[port].write = NULL;
-    ioTable[port].ref   = NULL;
+    ctx->currentSubport = value;
+    ioPortUpdateSub(ctx);
 }
 
-void ioPortRegisterUnused(int idx, IoPortRead read, IoPortWrite write, void* ref)
+static void ioPortUpdate(IoPortContext* ctx, int port)
 {
-    ioUnused[idx].read  = read;
-    ioUnused[idx].write = write;
-    ioUnused[idx].ref   = ref;
+    IoPortReadEntry*  readEntry  = &ctx->readTable[port];
+    IoPortWriteEntry* writeEntry = &ctx->writeTable[port];
+    IoPortInfo* info = &ctx->ioTable[port];
+
+    readEntry->read   = readNone;
+    readEntry->ref    = NULL;
+    writeEntry->write = writeNone;
+    writeEntry->writeBlock = NULL;
+    writeEntry->ref   = NULL;
+
+    // Ports 0x40 - 0x4f of MSX boards belong to the selected subport
+    if (ctx->subportsEnabled && port >= 0x40 && port < 0x50) {
+        info = &ctx->ioSubTable[ctx->currentSubport];
+        if (info->read != NULL) {
+            readEntry->read = info->read;
+            readEntry->ref  = info->ref;
+        }
+        if (port == 0x40) {
+            writeEntry->write = (IoPortWrite)writeSubport;
+            writeEntry->ref   = ctx;
+        }
+        else if (info->write != NULL) {
+            writeEntry->write = info->write;
+            writeEntry->ref   = info->ref;
+        }
+        return;
+    }
+
+    if (info->read == NULL) {
+        info = ctx->ioUnused[0].read != NULL ? &ctx->ioUnused[0] : &ctx->ioUnused[1];
+    }
+    if (info->read != NULL) {
+        readEntry->read = info->read;
+        readEntry->ref  = info->ref;
+    }
+
+    info = &ctx->ioTable[port];
+    if (info->writeBlock != NULL) {
+        writeEntry->writeBlock = info->writeBlock;
+    }
+    if (info->write == NULL) {
+        info = ctx->ioUnused[0].write != NULL ? &ctx->ioUnused[0] : &ctx->ioUnused[1];
+    }
+    if (info->write != NULL) {
+        writeEntry->write = info->write;
+        writeEntry->ref   = info->ref;
+    }
 }
 
-void ioPortUnregisterUnused(int idx)
+static void ioPortUpdateAll(IoPortContext* ctx)
 {
-    ioUnused[idx].read  = NULL;
-    ioUnused[idx].write = NULL;
-    ioUnused[idx].ref   = NULL;
+    int port;
+
+    for (port = 0; port < 256; port++) {
+        ioPortUpdate(ctx, port);
+    }
 }
 
-void ioPortRegisterSub(int subport, IoPortRead read, IoPortWrite write, void* ref)
+IoPortContext* ioPortContextCreate()
 {
-    ioSubTable[subport].read  = read;
-    ioSubTable[subport].write = write;
-    ioSubTable[subport].ref   = ref;
+    return calloc(1, sizeof(IoPortContext));
 }
 
+void ioPortContextDestroy(IoPortContext* context)
+{
+    free(context);
+}
 
-void ioPortUnregisterSub(int subport)
+void ioPortReset(BoardContext* board)
 {
-    ioSubTable[subport].read  = NULL;
-    ioSubTable[subport].write = NULL;
-    ioSubTable[subport].ref   = NULL;
+    IoPortContext* ctx = boardGetIoPort(board);
+
+    memset(ctx->ioTable, 0, sizeof(ctx->ioTable));
+    memset(ctx->ioSubTable, 0, sizeof(ctx->ioSubTable));
+
+    ctx->currentSubport = 0;
+    ctx->subportsEnabled = boardGetType(board) == BOARD_MSX;
+
+    ioPortUpdateAll(ctx);
 }
 
-int ioPortCheckSub(int subport)
+void* ioPortGetRef(BoardContext* board, int port)
 {
-    return currentSubport = subport;
+    IoPortContext* ctx = boardGetIoPort(board);
+
+	return ctx->ioTable[port].ref;
 }
 
-UInt8 ioPortRead(void* ref, UInt16 port)
+void ioPortRegister(BoardContext* board, int port, IoPortRead read, IoPortWrite write, void* ref)
 {
-    port &= 0xff;
+    IoPortContext* ctx = boardGetIoPort(board);
 
-    if (boardGetType() == BOARD_MSX && port >= 0x40 && port < 0x50) {
-        if (ioSubTable[currentSubport].read == NULL) {
-            return 0xff;
-        }
+    if (ctx->ioTable[port].read  == NULL && 
+        ctx->ioTable[port].write == NULL && 
+        ctx->ioTable[port].ref   == NULL)
+    {
+        ctx->ioTable[port].read  = read;
+        ctx->ioTable[port].write = write;
+        ctx->ioTable[port].ref   = ref;
 
-        return ioSubTable[currentSubport].read(ioSubTable[currentSubport].ref, port);
+        ioPortUpdate(ctx, port);
     }
+}
 
-    if (ioTable[port].read == NULL) {
-        if (ioUnused[0].read != NULL) {
-            return ioUnused[0].read(ioUnused[0].ref, port);
-        }
-        if (ioUnused[1].read != NULL) {
-            return ioUnused[1].read(ioUnused[1].ref, port);
-        }
-        return 0xff;
+
+void ioPortUnregister(BoardContext* board, int port)
+{
+    IoPortContext* ctx = boardGetIoPort(board);
+
+    ctx->ioTable[port].read  = NULL;
+    ctx->ioTable[port].write = NULL;
+    ctx->ioTable[port].writeBlock = NULL;
+    ctx->ioTable[port].ref   = NULL;
+
+    ioPortUpdate(ctx, port);
+}
+
+void ioPortRegisterWriteBlock(BoardContext* board, int port, IoPortWriteBlock writeBlock)
+{
+    IoPortContext* ctx = boardGetIoPort(board);
+
+    if (ctx->ioTable[port].write != NULL) {
+        ctx->ioTable[port].writeBlock = writeBlock;
+
+        ioPortUpdate(ctx, port);
     }
+}
+
+void ioPortRegisterUnused(BoardContext* board, int idx, IoPortRead read, IoPortWrite write, void* ref)
+{
+    IoPortContext* ctx = boardGetIoPort(board);
+
+    ctx->ioUnused[idx].read  = read;
+    ctx->ioUnused[idx].write = write;
+    ctx->ioUnused[idx].ref   = ref;
+
+    ioPortUpdateAll(ctx);
+}
+
+void ioPortUnregisterUnused(BoardContext* board, int idx)
+{
+    IoPortContext* ctx = boardGetIoPort(board);
+
+    ctx->ioUnused[idx].read  = NULL;
+    ctx->ioUnused[idx].write = NULL;
+    ctx->ioUnused[idx].ref   = NULL;
 
-    return ioTable[port].read(ioTable[port].ref, port);
+    ioPortUpdateAll(ctx);
+}
+
+void ioPortRegisterSub(BoardContext* board, int subport, IoPortRead read, IoPortWrite write, void* ref)
+{
+    IoPortContext* ctx = boardGetIoPort(board);
+
+    ctx->ioSubTable[subport].read  = read;
+    ctx->ioSubTable[subport].write = write;
+    ctx->ioSubTable[subport].ref   = ref;
+
+    ioPortUpdateSub(ctx);
+}
+
+
+void ioPortUnregisterSub(BoardContext* board, int subport)
+{
+    IoPortContext* ctx = boardGetIoPort(board);
+
+    ctx->ioSubTable[subport].read  = NULL;
+    ctx->ioSubTable[subport].write = NULL;
+    ctx->ioSubTable[subport].ref   = NULL;
+
+    ioPortUpdateSub(ctx);
+}
+
+int ioPortCheckSub(BoardContext* board, int subport)
+{
+    IoPortContext* ctx = boardGetIoPort(board);
+
+    ctx->currentSubport = subport;
+    ioPortUpdateSub(ctx);
+
+    return subport;
+}
+
+UInt8 ioPortRead(void* ref, UInt16 port)
+{
+    IoPortContext* ctx = boardGetIoPort((BoardContext*)ref);
+    IoPortReadEntry* entry = &ctx->readTable[port & 0xff];
+
+    return entry->read(entry->ref, port & 0xff);
 }
 
 void  ioPortWrite(void* ref, UInt16 port, UInt8 value)
 {
-    port &= 0xff;
+    IoPortContext* ctx = boardGetIoPort((BoardContext*)ref);
+    IoPortWriteEntry* entry = &ctx->writeTable[port & 0xff];
 
-    if (boardGetType() == BOARD_MSX && port >= 0x40 && port < 0x50) {
-        if (port == 0x40) {
-            currentSubport = value;
-            return;
-        }
-        
-        if (ioSubTable[currentSubport].write != NULL) {
-            ioSubTable[currentSubport].write(ioSubTable[currentSubport].ref, port, value);
-        }
-        return;
-    }
+    entry->write(entry->ref, port & 0xff, value);
+}
 
-    if (ioTable[port].write != NULL) {
-        ioTable[port].write(ioTable[port].ref, port, value);
-    }
-    else if (ioUnused[0].write != NULL) {
-        ioUnused[0].write(ioUnused[0].ref, port, value);
-    }
-    else if (ioUnused[1].write != NULL) {
-        ioUnused[1].write(ioUnused[1].ref, port, value);
-    }
+int ioPortCanWriteBlock(void* ref, UInt16 port)
+{
+    IoPortContext* ctx = boardGetIoPort((BoardContext*)ref);
+
+    return ctx->writeTable[port & 0xff].writeBlock != NULL;
 }
 
+void ioPortWriteBlock(void* ref, UInt16 port, const UInt8* values, const UInt32* times, int count)
+{
+    IoPortContext* ctx = boardGetIoPort((BoardContext*)ref);
+    IoPortWriteEntry* entry = &ctx->writeTable[port & 0xff];
+
+    entry->writeBlock(entry->ref, port & 0xff, values, times, count);
+}
 
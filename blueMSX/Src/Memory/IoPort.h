@@ -32,20 +32,35 @@
 
 typedef UInt8 (*IoPortRead)(void*, UInt16);
 typedef void  (*IoPortWrite)(void*, UInt16, UInt8);
+typedef void  (*IoPortWriteBlock)(void*, UInt16, const UInt8*, const UInt32*, int);
 
-void* ioPortGetRef(int port);
-void ioPortRegister(int port, IoPortRead read, IoPortWrite write, void* ref);
-void ioPortUnregister(int port);
+// The I/O port tables of a board, found with boardGetIoPort(). The
+// read and write functions below take the board as their reference.
+typedef struct IoPortContext IoPortContext;
 
-void ioPortRegisterUnused(int idx, IoPortRead read, IoPortWrite write, void* ref);
-void ioPortUnregisterUnused(int idx);
+IoPortContext* ioPortContextCreate();
+void ioPortContextDestroy(IoPortContext* context);
 
-void ioPortRegisterSub(int subport, IoPortRead read, IoPortWrite write, void* ref);
-void ioPortUnregisterSub(int subport);
-int ioPortCheckSub(int subport);
+void* ioPortGetRef(BoardContext* board, int port);
+void ioPortRegister(BoardContext* board, int port, IoPortRead read, IoPortWrite write, void* ref);
+void ioPortUnregister(BoardContext* board, int port);
 
-void  ioPortReset();
+// A block write handler takes several values written to a port by a
+// block I/O instruction, each with the system time of its write. It is
+// called after the instruction has run, and must not schedule timers.
+void ioPortRegisterWriteBlock(BoardContext* board, int port, IoPortWriteBlock writeBlock);
+
+void ioPortRegisterUnused(BoardContext* board, int idx, IoPortRead read, IoPortWrite write, void* ref);
+void ioPortUnregisterUnused(BoardContext* board, int idx);
+
+void ioPortRegisterSub(BoardContext* board, int subport, IoPortRead read, IoPortWrite write, void* ref);
+void ioPortUnregisterSub(BoardContext* board, int subport);
+int ioPortCheckSub(BoardContext* board, int subport);
+
+void  ioPortReset(BoardContext* board);
 UInt8 ioPortRead(void* ref, UInt16 port);
 void  ioPortWrite(void* ref, UInt16 port, UInt8 value);
+int   ioPortCanWriteBlock(void* ref, UInt16 port);
+void  ioPortWriteBlock(void* ref, UInt16 port, const UInt8* values, const UInt32* times, int count);
 
 #endif
@@ -29,6 +29,7 @@
 #include "MediaDb.h"
 #include "RomLoader.h"
 #include "SlotManager.h"
+#include "Board.h"
 
 #include "ramMapper.h"
 #include "ramNormal.h"
@@ -120,34 +121,25 @@
 #include "Sc3000PPI.h"
 
 
-typedef struct {
-    struct {
-        int slot;
-        int sslot;
-    } cart[2];
-} CartridgeInfo;
-
-
-CartridgeInfo cartridgeInfo;
-
-
-void cartridgeSetSlotInfo(int cartNo, int slot, int sslot) 
+void cartridgeSetSlotInfo(BoardContext* board, int cartNo, int slot, int sslot) 
 {
-    cartridgeInfo.cart[cartNo].slot  = slot;
-    cartridgeInfo.cart[cartNo].sslot = sslot;
+    BoardInfo* boardInfo = boardGetInfo(board);
+
+    boardInfo->cartridge[cartNo].slot  = slot;
+    boardInfo->cartridge[cartNo].sslot = sslot;
 }
 
-int cartridgeInsert(int cartNo, RomType romType, const char* cart, const char* cartZip)
+int cartridgeInsert(BoardContext* board, int cartNo, RomType romType, const char* cart, const char* cartZip)
 {
     const char* romName = cartZip != NULL ? cartZip : cart;
     int success = 1;
     UInt8* buf;
     int size;
-    int slot  = cartridgeInfo.cart[cartNo].slot;
-    int sslot = cartridgeInfo.cart[cartNo].sslot;
+    int slot  = boardGetInfo(board)->cartridge[cartNo].slot;
+    int sslot = boardGetInfo(board)->cartridge[cartNo].sslot;
 
     // Delete old cartridge
-    slotRemove(slot, sslot);
+    slotRemove(board, slot, sslot);
 
     if (cart == NULL) {
         return 0;
@@ -155,140 +147,140 @@ int cartridgeInsert(int cartNo, RomType romType, const char* cart, const char* c
     
     switch (romType) {
     case ROM_EXTRAM16KB:
-        success &= ramNormalCreate(0x4000, slot, sslot, 4, NULL, NULL);
+        success &= ramNormalCreate(board, 0x4000, slot, sslot, 4, NULL, NULL);
         break;
     case ROM_EXTRAM32KB:
-        success &= ramNormalCreate(0x8000, slot, sslot, 0, NULL, NULL);
+        success &= ramNormalCreate(board, 0x8000, slot, sslot, 0, NULL, NULL);
         break;
     case ROM_EXTRAM48KB:
-        success &= ramNormalCreate(0xc000, slot, sslot, 0, NULL, NULL);
+        success &= ramNormalCreate(board, 0xc000, slot, sslot, 0, NULL, NULL);
         break;
     case ROM_EXTRAM64KB:
-        success &= ramNormalCreate(0x10000, slot, sslot, 0, NULL, NULL);
+        success &= ramNormalCreate(board, 0x10000, slot, sslot, 0, NULL, NULL);
         break;
     case ROM_EXTRAM512KB:
-        success &= ramMapperCreate(0x80000, slot, sslot, 0, NULL, NULL);
+        success &= ramMapperCreate(board, 0x80000, slot, sslot, 0, NULL, NULL);
         break;
         
     case ROM_EXTRAM1MB:
-        success &= ramMapperCreate(0x100000, slot, sslot, 0, NULL, NULL);
+        success &= ramMapperCreate(board, 0x100000, slot, sslot, 0, NULL, NULL);
         break;
         
     case ROM_EXTRAM2MB:
-        success &= ramMapperCreate(0x200000, slot, sslot, 0, NULL, NULL);
+        success &= ramMapperCreate(board, 0x200000, slot, sslot, 0, NULL, NULL);
         break;
         
     case ROM_EXTRAM4MB:
-        success &= ramMapperCreate(0x400000, slot, sslot, 0, NULL, NULL);
+        success &= ramMapperCreate(board, 0x400000, slot, sslot, 0, NULL, NULL);
         break;
 
     case ROM_MEGARAM128:
-        success &= romMapperMegaRAMCreate(0x20000, slot, sslot, 0);
+        success &= romMapperMegaRAMCreate(board, 0x20000, slot, sslot, 0);
         break;
 
     case ROM_MEGARAM256:
-        success &= romMapperMegaRAMCreate(0x40000, slot, sslot, 0);
+        success &= romMapperMegaRAMCreate(board, 0x40000, slot, sslot, 0);
         break;
 
     case ROM_MEGARAM512:
-        success &= romMapperMegaRAMCreate(0x80000, slot, sslot, 0);
+        success &= romMapperMegaRAMCreate(board, 0x80000, slot, sslot, 0);
         break;
 
     case ROM_MEGARAM768:
-        success &= romMapperMegaRAMCreate(0xc0000, slot, sslot, 0);
+        success &= romMapperMegaRAMCreate(board, 0xc0000, slot, sslot, 0);
         break;
 
     case ROM_MEGARAM2M:
-        success &= romMapperMegaRAMCreate(0x200000, slot, sslot, 0);
+        success &= romMapperMegaRAMCreate(board, 0x200000, slot, sslot, 0);
         break;
 
     case ROM_PAC:
-        success &= romMapperPACCreate("PacA.rom", NULL, 0, slot, sslot, 2);
+        success &= romMapperPACCreate(board, "PacA.rom", NULL, 0, slot, sslot, 2);
         break;
 
 #ifdef WIN32
     case ROM_GAMEREADER:
-        success &= romMapperGameReaderCreate(cartNo, slot, sslot);
+        success &= romMapperGameReaderCreate(board, cartNo, slot, sslot);
         break;
 #endif
 
     case ROM_JOYREXPSG:
-        success &= romMapperJoyrexPsgCreate();
+        success &= romMapperJoyrexPsgCreate(board);
         break;
 
     case ROM_GIDE:
-        success &= romMapperGIdeCreate(cartNo);
+        success &= romMapperGIdeCreate(board, cartNo);
         break;
 
     case ROM_NMS1210:
-        romMapperNms1210Rs232Create(slot, sslot, 2);
+        romMapperNms1210Rs232Create(board, slot, sslot, 2);
         break;
 
     case SRAM_MEGASCSI128:
-        success &= sramMapperMegaSCSICreate("", NULL, 0x20000, slot, sslot, 2, cartNo, 1);
+        success &= sramMapperMegaSCSICreate(board, "", NULL, 0x20000, slot, sslot, 2, cartNo, 1);
         break;
 
     case SRAM_MEGASCSI256:
-        success &= sramMapperMegaSCSICreate("", NULL, 0x40000, slot, sslot, 2, cartNo, 1);
+        success &= sramMapperMegaSCSICreate(board, "", NULL, 0x40000, slot, sslot, 2, cartNo, 1);
         break;
 
     case SRAM_MEGASCSI512:
-        success &= sramMapperMegaSCSICreate("", NULL, 0x80000, slot, sslot, 2, cartNo, 1);
+        success &= sramMapperMegaSCSICreate(board, "", NULL, 0x80000, slot, sslot, 2, cartNo, 1);
         break;
 
     case SRAM_MEGASCSI1MB:
-        success &= sramMapperMegaSCSICreate("", NULL, 0x100000, slot, sslot, 2, cartNo, 1);
+        success &= sramMapperMegaSCSICreate(board, "", NULL, 0x100000, slot, sslot, 2, cartNo, 1);
         break;
 
     case SRAM_ESERAM128:
-        success &= sramMapperMegaSCSICreate("", NULL, 0x20000, slot, sslot, 2, 0, 0);
+        success &= sramMapperMegaSCSICreate(board, "", NULL, 0x20000, slot, sslot, 2, 0, 0);
         break;
 
     case SRAM_ESERAM256:
-        success &= sramMapperMegaSCSICreate("", NULL, 0x40000, slot, sslot, 2, 0, 0);
+        success &= sramMapperMegaSCSICreate(board, "", NULL, 0x40000, slot, sslot, 2, 0, 0);
         break;
 
     case SRAM_ESERAM512:
-        success &= sramMapperMegaSCSICreate("", NULL, 0x80000, slot, sslot, 2, 0, 0);
+        success &= sramMapperMegaSCSICreate(board, "", NULL, 0x80000, slot, sslot, 2, 0, 0);
         break;
 
     case SRAM_ESERAM1MB:
-        success &= sramMapperMegaSCSICreate("", NULL, 0x100000, slot, sslot, 2, 0, 0);
+        success &= sramMapperMegaSCSICreate(board, "", NULL, 0x100000, slot, sslot, 2, 0, 0);
         break;
 
     case SRAM_WAVESCSI128:
-        success &= sramMapperEseSCCCreate("", NULL, 0x20000, slot, sslot, 2, cartNo, 1);
+        success &= sramMapperEseSCCCreate(board, "", NULL, 0x20000, slot, sslot, 2, cartNo, 1);
         break;
 
     case SRAM_WAVESCSI256:
-        success &= sramMapperEseSCCCreate("", NULL, 0x40000, slot, sslot, 2, cartNo, 1);
+        success &= sramMapperEseSCCCreate(board, "", NULL, 0x40000, slot, sslot, 2, cartNo, 1);
         break;
 
     case SRAM_WAVESCSI512:
-        success &= sramMapperEseSCCCreate("", NULL, 0x80000, slot, sslot, 2, cartNo, 1);
+        success &= sramMapperEseSCCCreate(board, "", NULL, 0x80000, slot, sslot, 2, cartNo, 1);
         break;
 
     case SRAM_WAVESCSI1MB:
-        success &= sramMapperEseSCCCreate("", NULL, 0x100000, slot, sslot, 2, cartNo, 1);
+        success &= sramMapperEseSCCCreate(board, "", NULL, 0x100000, slot, sslot, 2, cartNo, 1);
         break;
 
     case SRAM_ESESCC128:
-        success &= sramMapperEseSCCCreate("", NULL, 0x20000, slot, sslot, 2, 0, 0);
+        success &= sramMapperEseSCCCreate(board, "", NULL, 0x20000, slot, sslot, 2, 0, 0);
         break;
 
     case SRAM_ESESCC256:
-        success &= sramMapperEseSCCCreate("", NULL, 0x40000, slot, sslot, 2, 0, 0);
+        success &= sramMapperEseSCCCreate(board, "", NULL, 0x40000, slot, sslot, 2, 0, 0);
         break;
 
     case SRAM_ESESCC512:
-        success &= sramMapperEseSCCCreate("", NULL, 0x80000, slot, sslot, 2, 0, 0);
+        success &= sramMapperEseSCCCreate(board, "", NULL, 0x80000, slot, sslot, 2, 0, 0);
         break;
 
     case ROM_FMPAC:
         if (cart[strlen(cart) - 4] != '.') {
             buf = romLoad("Machines/Shared Roms/FMPAC.rom", "", &size);
             if (buf != NULL) {
-                success &= romMapperFMPACCreate("FmPacA.rom", buf, size, slot, sslot, 2);
+                success &= romMapperFMPACCreate(board, "FmPacA.rom", buf, size, slot, sslot, 2);
                 free(buf);
             }
             else {
@@ -298,7 +290,7 @@ int cartridgeInsert(int cartNo, RomType romType, const char* cart, const char* c
                     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
                     0x50, 0x41, 0x43, 0x32, 0x4f, 0x50, 0x4c, 0x4c
                 };
-                success &= romMapperFMPACCreate("FmPacA.rom", romFMPAC, 0x10000, slot, sslot, 2);
+                success &= romMapperFMPACCreate(board, "FmPacA.rom", romFMPAC, 0x10000, slot, sslot, 2);
             }
             break;
         }
@@ -308,7 +300,7 @@ int cartridgeInsert(int cartNo, RomType romType, const char* cart, const char* c
         if (strcmp(cart, "Sunrise IDE") == 0) {
             buf = romLoad("Machines/Shared Roms/SUNRISEIDE.rom", cartZip, &size);
             if (buf == 0) {
-                success &= romMapperSunriseIdeCreate(cartNo, romName, NULL, 0, slot, sslot, 0);
+                success &= romMapperSunriseIdeCreate(board, cartNo, romName, NULL, 0, slot, sslot, 0);
                 break;
             }
         }
@@ -316,7 +308,7 @@ int cartridgeInsert(int cartNo, RomType romType, const char* cart, const char* c
         else if (strcmp(cart, "Beer IDE") == 0) {
             buf = romLoad("Machines/Shared Roms/beeride.rom", cartZip, &size);
             if (buf == 0) {
-                success &= romMapperBeerIdeCreate(cartNo, romName, NULL, 0, slot, sslot, 0);
+                success &= romMapperBeerIdeCreate(board, cartNo, romName, NULL, 0, slot, sslot, 0);
                 break;
             }
         }
@@ -324,7 +316,7 @@ int cartridgeInsert(int cartNo, RomType romType, const char* cart, const char* c
         else if (strcmp(cart, "Gouda SCSI") == 0) {
             buf = romLoad("Machines/Shared Roms/novaxis.rom", cartZip, &size);
             if (buf == 0) {
-                success &= romMapperGoudaSCSICreate(cartNo, romName, NULL, 0, slot, sslot, 2);
+                success &= romMapperGoudaSCSICreate(board, cartNo, romName, NULL, 0, slot, sslot, 2);
                 break;
             }
         }
@@ -342,130 +334,130 @@ int cartridgeInsert(int cartNo, RomType romType, const char* cart, const char* c
         if (buf == NULL) {
             switch (romType) {
             case ROM_SNATCHER:
-                success &= romMapperSCCplusCreate(NULL, NULL, 0, slot, sslot, 2, SCC_SNATCHER);
+                success &= romMapperSCCplusCreate(board, NULL, NULL, 0, slot, sslot, 2, SCC_SNATCHER);
                 break;
 
             case ROM_SDSNATCHER:
-                success &= romMapperSCCplusCreate(NULL, NULL, 0, slot, sslot, 2, SCC_SDSNATCHER);
+                success &= romMapperSCCplusCreate(board, NULL, NULL, 0, slot, sslot, 2, SCC_SDSNATCHER);
                 break;
 
             case ROM_SCCMIRRORED:
-                success &= romMapperSCCplusCreate(NULL, NULL, 0, slot, sslot, 2, SCC_MIRRORED);
+                success &= romMapperSCCplusCreate(board, NULL, NULL, 0, slot, sslot, 2, SCC_MIRRORED);
                 break;
 
             case ROM_SCCEXTENDED:
-                success &= romMapperSCCplusCreate(NULL, NULL, 0, slot, sslot, 2, SCC_EXTENDED);
+                success &= romMapperSCCplusCreate(board, NULL, NULL, 0, slot, sslot, 2, SCC_EXTENDED);
                 break;
 
             case ROM_SCC:
-                success &= romMapperSCCplusCreate(romName, NULL, 0, slot, sslot, 2, SCC_EXTENDED);
+                success &= romMapperSCCplusCreate(board, romName, NULL, 0, slot, sslot, 2, SCC_EXTENDED);
                 break;
 
             case ROM_SCCPLUS:
-                success &= romMapperSCCplusCreate(romName, NULL, 0, slot, sslot, 2, SCCP_EXTENDED);
+                success &= romMapperSCCplusCreate(board, romName, NULL, 0, slot, sslot, 2, SCCP_EXTENDED);
                 break;
 
             case ROM_SONYHBI55:
-                success &= romMapperSonyHBI55Create();
+                success &= romMapperSonyHBI55Create(board);
                 break;
 
             case ROM_MEGAFLSHSCC:
-                success &= romMapperMegaFlashRomSccCreate("MegaFlashRomScc.rom", NULL, 0, slot, sslot, 2, 0, 0x80000, 0);
+                success &= romMapperMegaFlashRomSccCreate(board, "MegaFlashRomScc.rom", NULL, 0, slot, sslot, 2, 0, 0x80000, 0);
                 break;
 
             case ROM_MEGAFLSHSCCPLUS:
-                success &= romMapperMegaFlashRomSccCreate("MegaFlashRomScc.rom", NULL, 0, slot, sslot, 2, 0, 0x100000, 1);
+                success &= romMapperMegaFlashRomSccCreate(board, "MegaFlashRomScc.rom", NULL, 0, slot, sslot, 2, 0, 0x100000, 1);
                 break;
             }
             break;
         }
         
         if (romType == ROM_UNKNOWN) {
-            MediaType* mediaType = mediaDbGuessRom(buf, size);
+            MediaType* mediaType = mediaDbGuessRom(board, buf, size);
             romType =  mediaDbGetRomType(mediaType);
         }
 
         switch (romType) {
         case ROM_0x4000:
-            success &= romMapperNormalCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperNormalCreate(board, romName, buf, size, slot, sslot, 2);
             break;
             
         case ROM_0xC000:
-            success &= romMapperNormalCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperNormalCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_BASIC:
-            success &= romMapperBasicCreate(romName, buf, size, slot, sslot, 4);
+            success &= romMapperBasicCreate(board, romName, buf, size, slot, sslot, 4);
             break;
 
         case ROM_FMDAS:
-            success &= romMapperFmDasCreate(romName, buf, size, slot, sslot, 0);
+            success &= romMapperFmDasCreate(board, romName, buf, size, slot, sslot, 0);
             break;
 
         case ROM_PLAIN:
-            success &= romMapperPlainCreate(romName, buf, size, slot, sslot, 0);
+            success &= romMapperPlainCreate(board, romName, buf, size, slot, sslot, 0);
             break;
 
         case ROM_NETTOUYAKYUU:
-            success &= romMapperNettouYakyuuCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperNettouYakyuuCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_MATRAINK:
-            success &= romMapperMatraINKCreate(romName, buf, size, slot, sslot, 0);
+            success &= romMapperMatraINKCreate(board, romName, buf, size, slot, sslot, 0);
             break;
 
         case ROM_FORTEII:
-            success &= romMapperForteIICreate(romName, buf, size, slot, sslot, 0);
+            success &= romMapperForteIICreate(board, romName, buf, size, slot, sslot, 0);
             break;
 
         case ROM_FMPAK:
-            success &= romMapperFMPAKCreate(romName, buf, size, slot, sslot, 0);
+            success &= romMapperFMPAKCreate(board, romName, buf, size, slot, sslot, 0);
             break;
 
         case ROM_STANDARD:
-            success &= romMapperStandardCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperStandardCreate(board, romName, buf, size, slot, sslot, 2);
             break;
             
         case ROM_MSXDOS2:
-            success &= romMapperMsxDos2Create(romName, buf, size, slot, sslot, 2);
+            success &= romMapperMsxDos2Create(board, romName, buf, size, slot, sslot, 2);
             break;
             
         case ROM_KONAMI5:
-            success &= romMapperKonami5Create(romName, buf, size, slot, sslot, 2);
+            success &= romMapperKonami5Create(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_MUPACK:
-            success &= romMapperMuPackCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperMuPackCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
 
         case ROM_MANBOW2:
             if (size > 0x70000) size = 0x70000;
-            success &= romMapperMegaFlashRomSccCreate(romName, buf, size, slot, sslot, 2, 0x7f, 0x80000, 0);
+            success &= romMapperMegaFlashRomSccCreate(board, romName, buf, size, slot, sslot, 2, 0x7f, 0x80000, 0);
             break;
 
         case ROM_MANBOW2_V2:
-            success &= romMapperMegaFlashRomSccCreate(romName, buf, size, slot, sslot, 2, 0x7f, 0x100000, 1);
+            success &= romMapperMegaFlashRomSccCreate(board, romName, buf, size, slot, sslot, 2, 0x7f, 0x100000, 1);
             break;
 
         case ROM_HAMARAJANIGHT:
-            success &= romMapperMegaFlashRomSccCreate(romName, buf, size, slot, sslot, 2, 0xcf, 0x100000, 1);
+            success &= romMapperMegaFlashRomSccCreate(board, romName, buf, size, slot, sslot, 2, 0xcf, 0x100000, 1);
             break;
 
         case ROM_MEGAFLSHSCC:
-            success &= romMapperMegaFlashRomSccCreate(romName, buf, size, slot, sslot, 2, 0, 0x80000, 0);
+            success &= romMapperMegaFlashRomSccCreate(board, romName, buf, size, slot, sslot, 2, 0, 0x80000, 0);
             break;
 
         case ROM_MEGAFLSHSCCPLUS:
-            success &= romMapperMegaFlashRomSccCreate(romName, buf, size, slot, sslot, 2, 0, 0x100000, 1);
+            success &= romMapperMegaFlashRomSccCreate(board, romName, buf, size, slot, sslot, 2, 0, 0x100000, 1);
             break;
 
         case ROM_OBSONET:
-            success &= romMapperObsonetCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperObsonetCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_NOWIND:
-            success &= romMapperNoWindCreate(cartNo, romName, buf, size, slot, sslot, 0);
+            success &= romMapperNoWindCreate(board, cartNo, romName, buf, size, slot, sslot, 0);
             break;
 
         case ROM_DUMAS:
@@ -482,7 +474,7 @@ int cartridgeInsert(int cartNo, RomType romType, const char* cart, const char* c
                 strcat(eepromName, "_eeprom.rom");
                     
                 eepromData = romLoad(eepromName, NULL, &eepromSize);
-                success &= romMapperDumasCreate(romName, buf, size, slot, sslot, 2, eepromData, eepromSize);
+                success &= romMapperDumasCreate(board, romName, buf, size, slot, sslot, 2, eepromData, eepromSize);
                 if (eepromData != NULL) {
                     free(eepromData);
                 }
@@ -490,52 +482,52 @@ int cartridgeInsert(int cartNo, RomType romType, const char* cart, const char* c
             break;
 
         case ROM_SNATCHER:
-            success &= romMapperSCCplusCreate(NULL, buf, size, slot, sslot, 2, SCC_SNATCHER);
+            success &= romMapperSCCplusCreate(board, NULL, buf, size, slot, sslot, 2, SCC_SNATCHER);
             break;
 
         case ROM_SDSNATCHER:
-            success &= romMapperSCCplusCreate(NULL, buf, size, slot, sslot, 2, SCC_SDSNATCHER);
+            success &= romMapperSCCplusCreate(board, NULL, buf, size, slot, sslot, 2, SCC_SDSNATCHER);
             break;
 
         case ROM_SCCMIRRORED:
-            success &= romMapperSCCplusCreate(NULL, buf, size, slot, sslot, 2, SCC_MIRRORED);
+            success &= romMapperSCCplusCreate(board, NULL, buf, size, slot, sslot, 2, SCC_MIRRORED);
             break;
 
         case ROM_SCCEXTENDED:
-            success &= romMapperSCCplusCreate(NULL, buf, size, slot, sslot, 2, SCC_EXTENDED);
+            success &= romMapperSCCplusCreate(board, NULL, buf, size, slot, sslot, 2, SCC_EXTENDED);
             break;
 
         case ROM_SCC:
-            success &= romMapperSCCplusCreate(romName, buf, size, slot, sslot, 2, SCC_EXTENDED);
+            success &= romMapperSCCplusCreate(board, romName, buf, size, slot, sslot, 2, SCC_EXTENDED);
             break;
 
         case ROM_SCCPLUS:
-            success &= romMapperSCCplusCreate(romName, buf, size, slot, sslot, 2, SCCP_EXTENDED);
+            success &= romMapperSCCplusCreate(board, romName, buf, size, slot, sslot, 2, SCCP_EXTENDED);
             break;
 
         case ROM_MOONSOUND:
-            success &= romMapperMoonsoundCreate(romName, buf, size, 640);
+            success &= romMapperMoonsoundCreate(board, romName, buf, size, 640);
             buf = NULL; // Buffer ownership is transferred to YMF278
             break;
             
         case ROM_KONAMI4:
-            success &= romMapperKonami4Create(romName, buf, size, slot, sslot, 2);
+            success &= romMapperKonami4Create(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_MAJUTSUSHI:
-            success &= romMapperMajutsushiCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperMajutsushiCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_HOLYQURAN:
-            success &= romMapperHolyQuranCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperHolyQuranCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
 		case ROM_KONAMISYNTH:
-            success &= romMapperKonamiSynthCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperKonamiSynthCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_KONWORDPRO:
-            success &= romMapperKonamiWordProCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperKonamiWordProCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_KONAMKBDMAS:
@@ -552,7 +544,7 @@ int cartridgeInsert(int cartNo, RomType romType, const char* cart, const char* c
                 strcat(voiceName, "_voice.rom");
                     
                 voiceData = romLoad(voiceName, NULL, &voiceSize);
-                success &= romMapperKonamiKeyboardMasterCreate(romName, buf, size, slot, sslot, 2, voiceData, voiceSize);
+                success &= romMapperKonamiKeyboardMasterCreate(board, romName, buf, size, slot, sslot, 2, voiceData, voiceSize);
                 if (voiceData != NULL) {
                     free(voiceData);
                 }
@@ -560,219 +552,219 @@ int cartridgeInsert(int cartNo, RomType romType, const char* cart, const char* c
             break;
             
         case ROM_ASCII8:
-            success &= romMapperASCII8Create(romName, buf, size, slot, sslot, 2);
+            success &= romMapperASCII8Create(board, romName, buf, size, slot, sslot, 2);
             break;
             
         case ROM_ASCII16:
-            success &= romMapperASCII16Create(romName, buf, size, slot, sslot, 2);
+            success &= romMapperASCII16Create(board, romName, buf, size, slot, sslot, 2);
             break;
             
         case ROM_ASCII8SRAM:
-            success &= romMapperASCII8sramCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperASCII8sramCreate(board, romName, buf, size, slot, sslot, 2);
             break;
             
         case ROM_ASCII16SRAM:
-            success &= romMapperASCII16sramCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperASCII16sramCreate(board, romName, buf, size, slot, sslot, 2);
             break;
             
         case ROM_KOEI:
-            success &= romMapperKoeiCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperKoeiCreate(board, romName, buf, size, slot, sslot, 2);
             break;
             
         case ROM_KONAMI4NF:
-            success &= romMapperKonami4nfCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperKonami4nfCreate(board, romName, buf, size, slot, sslot, 2);
             break;
             
         case ROM_ASCII16NF:
-            success &= romMapperASCII16nfCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperASCII16nfCreate(board, romName, buf, size, slot, sslot, 2);
             break;
             
         case ROM_GAMEMASTER2:
-            success &= romMapperGameMaster2Create(romName, buf, size, slot, sslot, 2);
+            success &= romMapperGameMaster2Create(board, romName, buf, size, slot, sslot, 2);
             break;
             
         case ROM_HARRYFOX:
-            success &= romMapperHarryFoxCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperHarryFoxCreate(board, romName, buf, size, slot, sslot, 2);
             break;
             
         case ROM_HALNOTE:
-            success &= romMapperHalnoteCreate(romName, buf, size, slot, sslot, 0);
+            success &= romMapperHalnoteCreate(board, romName, buf, size, slot, sslot, 0);
             break;
             
         case ROM_RTYPE:
-            success &= romMapperRTypeCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperRTypeCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_LODERUNNER:
-            success &= romMapperLodeRunnerCreate(romName, buf, size, slot, sslot, 4);
+            success &= romMapperLodeRunnerCreate(board, romName, buf, size, slot, sslot, 4);
             break;
             
         case ROM_CROSSBLAIM:
-            success &= romMapperCrossBlaimCreate(romName, buf, size, slot, sslot, 0);
+            success &= romMapperCrossBlaimCreate(board, romName, buf, size, slot, sslot, 0);
             break;
             
         case ROM_KOREAN80:
-            success &= romMapperKorean80Create(romName, buf, size, slot, sslot, 2);
+            success &= romMapperKorean80Create(board, romName, buf, size, slot, sslot, 2);
             break;
             
         case ROM_KOREAN90:
-            success &= romMapperKorean90Create(romName, buf, size, slot, sslot, 2);
+            success &= romMapperKorean90Create(board, romName, buf, size, slot, sslot, 2);
             break;
             
         case ROM_KOREAN126:
-            success &= romMapperKorean126Create(romName, buf, size, slot, sslot, 2);
+            success &= romMapperKorean126Create(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_MSXAUDIO:
-            success &= romMapperMsxAudioCreate(romName, buf, size, slot, sslot, 0);
+            success &= romMapperMsxAudioCreate(board, romName, buf, size, slot, sslot, 0);
             break;
 
         case ROM_YAMAHASFG01:
-            success &= romMapperSfg05Create(romName, buf, size, slot, sslot, 0);
+            success &= romMapperSfg05Create(board, romName, buf, size, slot, sslot, 0);
             break;
 
         case ROM_YAMAHASFG05:
-            success &= romMapperSfg05Create(romName, buf, size, slot, sslot, 0);
+            success &= romMapperSfg05Create(board, romName, buf, size, slot, sslot, 0);
             break;
 
         case ROM_YAMAHANET:
-            success &= romMapperNetCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperNetCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_SF7000IPL:
-            success &= romMapperSf7000IplCreate(romName, buf, size, slot, sslot, 0);
+            success &= romMapperSf7000IplCreate(board, romName, buf, size, slot, sslot, 0);
             break;
 
         case ROM_DISKPATCH:
-            success &= romMapperDiskCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperDiskCreate(board, romName, buf, size, slot, sslot, 2);
            break;
 
         case ROM_TC8566AF:
-            success &= romMapperTC8566AFCreate(romName, buf, size, slot, sslot, 2, ROM_TC8566AF);
+            success &= romMapperTC8566AFCreate(board, romName, buf, size, slot, sslot, 2, ROM_TC8566AF);
             break;
 
         case ROM_TC8566AF_TR:
-            success &= romMapperTC8566AFCreate(romName, buf, size, slot, sslot, 2, ROM_TC8566AF_TR);
+            success &= romMapperTC8566AFCreate(board, romName, buf, size, slot, sslot, 2, ROM_TC8566AF_TR);
             break;
 
         case ROM_MICROSOL:
-            success &= romMapperMicrosolCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperMicrosolCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_ARC:
-            success &= romMapperArcCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperArcCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_NATIONALFDC:
-            success &= romMapperNationalFdcCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperNationalFdcCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_PHILIPSFDC:
-            success &= romMapperPhilipsFdcCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperPhilipsFdcCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_SVI707FDC:
-            success &= romMapperSvi707FdcCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperSvi707FdcCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_SVI738FDC:
-            success &= romMapperSvi738FdcCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperSvi738FdcCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_SVI328CART:
-            success &= romMapperNormalCreate(romName, buf, size, 1, 0, 0);
+            success &= romMapperNormalCreate(board, romName, buf, size, 1, 0, 0);
             break;
 
         case ROM_COLECO:
-            success &= romMapperNormalCreate(romName, buf, size, 0, 0, 4);
+            success &= romMapperNormalCreate(board, romName, buf, size, 0, 0, 4);
             break;
 
         case ROM_CVMEGACART:
-            success &= romMapperCvMegaCartCreate(romName, buf, size, 0, 0, 4);
+            success &= romMapperCvMegaCartCreate(board, romName, buf, size, 0, 0, 4);
             break;
             
         case ROM_ACTIVISIONPCB:
         case ROM_ACTIVISIONPCB_2K:
         case ROM_ACTIVISIONPCB_16K:
         case ROM_ACTIVISIONPCB_256K:
-            success &= romMapperActivisionPcbCreate(romName, romType, buf, size, 0, 0, 4);
+            success &= romMapperActivisionPcbCreate(board, romName, romType, buf, size, 0, 0, 4);
             break;
 
         case ROM_SG1000:
         case ROM_SC3000:
-            success &= romMapperSg1000Create(romName, buf, size, slot, sslot, 0);
+            success &= romMapperSg1000Create(board, romName, buf, size, slot, sslot, 0);
             break;
 
         case ROM_SG1000CASTLE:
-            success &= romMapperSg1000CastleCreate(romName, buf, size, slot, sslot, 0);
+            success &= romMapperSg1000CastleCreate(board, romName, buf, size, slot, sslot, 0);
             break;
 
         case ROM_SG1000_RAMEXPANDER_A:
-            success &= romMapperSg1000RamExpanderCreate(romName, buf, size, slot, sslot, 0, ROM_SG1000_RAMEXPANDER_A);
+            success &= romMapperSg1000RamExpanderCreate(board, romName, buf, size, slot, sslot, 0, ROM_SG1000_RAMEXPANDER_A);
             break;
 
         case ROM_SG1000_RAMEXPANDER_B:
-            success &= romMapperSg1000RamExpanderCreate(romName, buf, size, slot, sslot, 0, ROM_SG1000_RAMEXPANDER_B);
+            success &= romMapperSg1000RamExpanderCreate(board, romName, buf, size, slot, sslot, 0, ROM_SG1000_RAMEXPANDER_B);
             break;
 
         case ROM_SEGABASIC:
-            success &= romMapperSegaBasicCreate(romName, buf, size, slot, sslot, 0);
+            success &= romMapperSegaBasicCreate(board, romName, buf, size, slot, sslot, 0);
             break;
 
         case ROM_KANJI:
-            success &= romMapperKanjiCreate(buf, size);
+            success &= romMapperKanjiCreate(board, buf, size);
             break;
 
         case ROM_KANJI12:
-            success &= romMapperKanji12Create(buf, size);
+            success &= romMapperKanji12Create(board, buf, size);
             break;
             
         case ROM_FMPAC:
-            success &= romMapperFMPACCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperFMPACCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_SUNRISEIDE:
-            success &= romMapperSunriseIdeCreate(cartNo, romName, buf, size, slot, sslot, 0);
+            success &= romMapperSunriseIdeCreate(board, cartNo, romName, buf, size, slot, sslot, 0);
             break;
 
         case ROM_BEERIDE:
-            success &= romMapperBeerIdeCreate(cartNo, romName, buf, size, slot, sslot, 2);
+            success &= romMapperBeerIdeCreate(board, cartNo, romName, buf, size, slot, sslot, 2);
             break;
 
         case SRAM_MEGASCSI:
-            success &= sramMapperMegaSCSICreate(romName, buf, size, slot, sslot, 2, cartNo, cartZip ? 0x81 : 1);
+            success &= sramMapperMegaSCSICreate(board, romName, buf, size, slot, sslot, 2, cartNo, cartZip ? 0x81 : 1);
             break;
 
         case SRAM_WAVESCSI:
-            success &= sramMapperEseSCCCreate(romName, buf, size, slot, sslot, 2, cartNo, cartZip ? 0x81 : 1);
+            success &= sramMapperEseSCCCreate(board, romName, buf, size, slot, sslot, 2, cartNo, cartZip ? 0x81 : 1);
             break;
 
         case ROM_GOUDASCSI:
-            success &= romMapperGoudaSCSICreate(cartNo, romName, buf, size, slot, sslot, 2);
+            success &= romMapperGoudaSCSICreate(board, cartNo, romName, buf, size, slot, sslot, 2);
             break;
 
         case SRAM_ESERAM:
-            success &= sramMapperMegaSCSICreate(romName, buf, size, slot, sslot, 2, 0, cartZip ? 0x80 : 0);
+            success &= sramMapperMegaSCSICreate(board, romName, buf, size, slot, sslot, 2, 0, cartZip ? 0x80 : 0);
             break;
 
         case SRAM_ESESCC:
-            success &= sramMapperEseSCCCreate(romName, buf, size, slot, sslot, 2, 0, cartZip ? 0x80 : 0);
+            success &= sramMapperEseSCCCreate(board, romName, buf, size, slot, sslot, 2, 0, cartZip ? 0x80 : 0);
             break;
 
         case ROM_SONYHBIV1:
-            success &= romMapperSonyHbiV1Create(romName, buf, size, slot, sslot, 2);
+            success &= romMapperSonyHbiV1Create(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_PLAYBALL:
-            success &= romMapperPlayBallCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperPlayBallCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_DOOLY:
-            success &= romMapperDoolyCreate(romName, buf, size, slot, sslot, 2);
+            success &= romMapperDoolyCreate(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_SVI727COL80:
-            success &= romMapperSvi727Col80Create(romName, buf, size, slot, sslot, 2);
+            success &= romMapperSvi727Col80Create(board, romName, buf, size, slot, sslot, 2);
             break;
 
         case ROM_MICROSOL80:
@@ -789,7 +781,7 @@ int cartridgeInsert(int cartNo, RomType romType, const char* cart, const char* c
                 strcat(charName, "_char.rom");
                     
                 charData = romLoad(charName, NULL, &charSize);
-                success &= romMapperMicrosolVmx80Create(romName, buf, size, slot, sslot, 2, charData, charSize);
+                success &= romMapperMicrosolVmx80Create(board, romName, buf, size, slot, sslot, 2, charData, charSize);
                 if (charData != NULL) {
                     free(charData);
                 }
@@ -32,8 +32,8 @@
 #include "MediaDb.h"
 #include "YM2413.h"
 
-void cartridgeSetSlotInfo(int cartNo, int slot, int sslot);
+void cartridgeSetSlotInfo(BoardContext* board, int cartNo, int slot, int sslot);
 
-int cartridgeInsert(int cartNo, RomType romType, const char* cart, const char* cartZip);
+int cartridgeInsert(BoardContext* board, int cartNo, RomType romType, const char* cart, const char* cartZip);
 
 #endif
@@ -26,6 +26,7 @@
 ******************************************************************************
 */
 #include "SlotManager.h"
+#include "Board.h"
 #include "SaveState.h"
 #include "Led.h"
 #include "IoPort.h"
@@ -37,6 +38,8 @@ typedef struct {
     UInt8* pageData;
     int    readEnable;
     int    writeEnable;
+    UInt32 directBlocks;
+    int    aliased;
 } RamSlotState;
 
 typedef struct {
@@ -53,6 +56,8 @@ typedef struct {
     UInt8*        pageData;
     int           writeEnable;
     int           readEnable;
+    UInt32        directBlocks;
+    UInt8*        bankBase;
     SlotRead      read;
     SlotRead      peek;
     SlotWrite     write;
@@ -60,134 +65,353 @@ typedef struct {
     void*         ref;
 } Slot;
 
-static RamSlotState     ramslot[8];
-static PrimarySlotState pslot[4];
-static Slot             slotTable[4][4][8];
-static Slot             slotAddr0;
-static UInt8            emptyRAM[0x2000];
-static Int32            initialized;
+struct SlotManagerContext {
+    RamSlotState     ramslot[8];
+    PrimarySlotState pslot[4];
+    Slot             slotTable[4][4][8];
+    Slot             slotAddr0;
+    UInt8            emptyRAM[0x2000];
+    Int32            initialized;
+    UInt8*           readBlocks[256];
+    UInt8*           writeBlocks[256];
+    UInt32           blockVersions[256];
+    UInt32           version;
+};
+
+SlotManagerContext* slotManagerContextCreate()
+{
+    return calloc(1, sizeof(SlotManagerContext));
+}
+
+void slotManagerContextDestroy(SlotManagerContext* context)
+{
+    free(context);
+}
+
+UInt8** slotGetReadBlocks(BoardContext* board)
+{
+    SlotManagerContext* ctx = boardGetSlotManager(board);
+
+    return ctx->readBlocks;
+}
+
+UInt8** slotGetWriteBlocks(BoardContext* board)
+{
+    SlotManagerContext* ctx = boardGetSlotManager(board);
+
+    return ctx->writeBlocks;
+}
+
+const UInt32* slotGetBlockVersions(BoardContext* board)
+{
+    SlotManagerContext* ctx = boardGetSlotManager(board);
+
+    return ctx->blockVersions;
+}
+
+static UInt32 slotNextVersion(SlotManagerContext* ctx)
+{
+    if (++ctx->version == 0) {
+        ctx->version = 1;
+    }
+    return ctx->version;
+}
+
+static int slotPageOverlaps(SlotManagerContext* ctx, int page, int other)
+{
+    return ctx->ramslot[other].pageData < ctx->ramslot[page].pageData + 0x2000 &&
+           ctx->ramslot[page].pageData < ctx->ramslot[other].pageData + 0x2000;
+}
+
+/* Returns 1 if a page has blocks that are read directly from page data
+** that another page writes directly, or that is written directly and
+** read directly through another page. The CPU only sees its own direct
+** writes at the address it wrote to.
+*/
+static int slotPageAliased(SlotManagerContext* ctx, int page)
+{
+    RamSlotState* ramslot = &ctx->ramslot[page];
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        RamSlotState* other = &ctx->ramslot[i];
+
+        if (i == page || !slotPageOverlaps(ctx, page, i)) {
+            continue;
+        }
+        if ((ramslot->readEnable || ramslot->directBlocks != 0) && other->writeEnable) {
+            return 1;
+        }
+        if (ramslot->writeEnable && (other->readEnable || other->directBlocks != 0)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Gives the block written by slotWrite() a new version, in all pages
+** that map the same page data.
+*/
+static void slotCodeWritten(SlotManagerContext* ctx, UInt16 address)
+{
+    UInt8* data = ctx->ramslot[address >> 13].pageData + (address & 0x1fff);
+    int page;
+
+    for (page = 0; page < 8; page++) {
+        UInt8* pageData = ctx->ramslot[page].pageData;
+        int block = 32 * page + (int)((data - pageData) >> 8);
+
+        if (data >= pageData && data < pageData + 0x2000 && ctx->blockVersions[block] != 0) {
+            ctx->blockVersions[block] = slotNextVersion(ctx);
+        }
+    }
+}
 
-void slotMapRamPage(int slot, int sslot, int page)
+/* Gives the blocks of a page a new version after its mapping changed.
+** The other pages get one as well if they now share their page data
+** with it or stopped doing so.
+*/
+static void slotUpdateVersions(SlotManagerContext* ctx, int page)
 {
-    ramslot[page].readEnable  = slotTable[slot][sslot][page].readEnable;
-    ramslot[page].writeEnable = slotTable[slot][sslot][page].writeEnable;
-    ramslot[page].pageData    = slotTable[slot][sslot][page].pageData;
+    int p;
+    int i;
+
+    for (p = 0; p < 8; p++) {
+        int aliased = slotPageAliased(ctx, p);
+
+        if (p == page || aliased != ctx->ramslot[p].aliased) {
+            UInt32 version = aliased ? 0 : slotNextVersion(ctx);
+
+            ctx->ramslot[p].aliased = aliased;
+            for (i = 0; i < 32; i++) {
+                ctx->blockVersions[32 * p + i] = version;
+            }
+        }
+    }
 }
 
-void slotSetRamSlot(int slot, int psl)
+/* Updates the direct access blocks of a page from the mapped page. A
+** page without read access may still have direct read blocks, one bit
+** per 256 byte block in directBlocks. The blocks with the subslot
+** register at 0xffff and the write0 handler at 0x0000 are left to
+** slotRead() and slotWrite().
+*/
+static void slotUpdateBlocks(SlotManagerContext* ctx, int page)
 {
+    RamSlotState* ramslot = &ctx->ramslot[page];
+    int i;
+
+    for (i = 0; i < 32; i++) {
+        ctx->readBlocks[32 * page + i]  = ramslot->readEnable || (ramslot->directBlocks >> i) & 1 ? ramslot->pageData + 0x100 * i : NULL;
+        ctx->writeBlocks[32 * page + i] = ramslot->writeEnable ? ramslot->pageData + 0x100 * i : NULL;
+    }
+
+    if (page == 7 && ctx->pslot[ctx->pslot[3].state].subslotted) {
+        ctx->readBlocks[0xff]  = NULL;
+        ctx->writeBlocks[0xff] = NULL;
+    }
+
+    if (page == 0 && ctx->slotAddr0.write != NULL) {
+        ctx->writeBlocks[0x00] = NULL;
+    }
+
+    slotUpdateVersions(ctx, page);
+}
+
+static void slotMapRam(SlotManagerContext* ctx, int slot, int sslot, int page)
+{
+    ctx->ramslot[page].readEnable  = ctx->slotTable[slot][sslot][page].readEnable;
+    ctx->ramslot[page].writeEnable = ctx->slotTable[slot][sslot][page].writeEnable;
+    ctx->ramslot[page].pageData    = ctx->slotTable[slot][sslot][page].pageData;
+    ctx->ramslot[page].directBlocks = ctx->slotTable[slot][sslot][page].directBlocks;
+
+    slotUpdateBlocks(ctx, page);
+}
+
+void slotMapRamPage(BoardContext* board, int slot, int sslot, int page)
+{
+    slotMapRam(boardGetSlotManager(board), slot, sslot, page);
+}
+
+void slotSetRamSlot(BoardContext* board, int slot, int psl)
+{
+    SlotManagerContext* ctx = boardGetSlotManager(board);
     int ssl;
 
-    pslot[slot].state    = psl;
-    pslot[slot].substate = (pslot[psl].sslReg >> (slot * 2)) & 3;
+    ctx->pslot[slot].state    = psl;
+    ctx->pslot[slot].substate = (ctx->pslot[psl].sslReg >> (slot * 2)) & 3;
 
-    ssl = pslot[psl].subslotted ? pslot[slot].substate : 0;
+    ssl = ctx->pslot[psl].subslotted ? ctx->pslot[slot].substate : 0;
     
-    slotMapRamPage(psl, ssl, 2 * slot);
-    slotMapRamPage(psl, ssl, 2 * slot + 1);
+    slotMapRam(ctx, psl, ssl, 2 * slot);
+    slotMapRam(ctx, psl, ssl, 2 * slot + 1);
 }
 
-int slotGetRamSlot(int page)
+int slotGetRamSlot(BoardContext* board, int page)
 {
+    SlotManagerContext* ctx = boardGetSlotManager(board);
     int i;
     for (i = 0; i < 4; i++) {
-        if (pslot[i].state == page) {
+        if (ctx->pslot[i].state == page) {
             return i;
         }
     }
     return 0;
 }
 
-void slotMapPage(int slot, int sslot, int page, UInt8* pageData, 
-                 int readEnable, int writeEnable) 
+/* Keeps the lowest page data mapped by the device registered on a page
+** in all pages of the registration. As devices map their data from the
+** start when created, this is the start of the device data, and the
+** banks of a page are counted from it.
+*/
+static void slotUpdateBankBase(SlotManagerContext* ctx, int slot, int sslot, int page, UInt8* pageData)
 {
-    if (!initialized) {
+    Slot* slotInfo = &ctx->slotTable[slot][sslot][page];
+    Slot* regInfo  = &ctx->slotTable[slot][sslot][slotInfo->startpage];
+    int i;
+
+    if (page - slotInfo->startpage >= regInfo->pages) {
+        return;
+    }
+
+    if (slotInfo->bankBase != NULL && slotInfo->bankBase <= pageData) {
         return;
     }
 
-    slotTable[slot][sslot][page].readEnable  = readEnable;
-    slotTable[slot][sslot][page].writeEnable = writeEnable;
+    for (i = 0; i < regInfo->pages; i++) {
+        regInfo[i].bankBase = pageData;
+    }
+}
+
+static void slotMapPageData(SlotManagerContext* ctx, int slot, int sslot, int page, UInt8* pageData, 
+                            int readEnable, int writeEnable, UInt32 directBlocks) 
+{
+    if (!ctx->initialized) {
+        return;
+    }
+
+    ctx->slotTable[slot][sslot][page].readEnable  = readEnable;
+    ctx->slotTable[slot][sslot][page].writeEnable = writeEnable;
+    ctx->slotTable[slot][sslot][page].directBlocks = directBlocks;
 
     if (pageData != NULL) {
-        slotTable[slot][sslot][page].pageData = pageData;
+        ctx->slotTable[slot][sslot][page].pageData = pageData;
+        slotUpdateBankBase(ctx, slot, sslot, page, pageData);
     }
 #if 0
-    if (pslot[page >> 1].state == slot && (!pslot[slot].subslotted || sslot == 2 || pslot[page >> 1].substate == sslot)) {
-        slotMapRamPage(slot, sslot, page);
+    if (ctx->pslot[page >> 1].state == slot && (!ctx->pslot[slot].subslotted || sslot == 2 || ctx->pslot[page >> 1].substate == sslot)) {
+        slotMapRam(ctx, slot, sslot, page);
     }
 #else
-    if (pslot[page >> 1].state == slot && 
-        (!pslot[slot].subslotted || pslot[page >> 1].substate == sslot)) 
+    if (ctx->pslot[page >> 1].state == slot && 
+        (!ctx->pslot[slot].subslotted || ctx->pslot[page >> 1].substate == sslot)) 
     {
-        slotMapRamPage(slot, sslot, page);
+        slotMapRam(ctx, slot, sslot, page);
     }
 #endif
 }
 
-void slotUpdatePage(int slot, int sslot, int page, UInt8* pageData, 
+void slotMapPage(BoardContext* board, int slot, int sslot, int page, UInt8* pageData, 
+                 int readEnable, int writeEnable) 
+{
+    SlotManagerContext* ctx = boardGetSlotManager(board);
+
+    slotMapPageData(ctx, slot, sslot, page, pageData, readEnable, writeEnable, 0);
+}
+
+void slotMapPageIo(BoardContext* board, int slot, int sslot, int page, UInt8* pageData, 
+                   int ioStart, int ioSize) 
+{
+    SlotManagerContext* ctx = boardGetSlotManager(board);
+    UInt32 directBlocks = 0xffffffff;
+    int block;
+
+    for (block = ioStart >> 8; block <= (ioStart + ioSize - 1) >> 8 && block < 32; block++) {
+        directBlocks &= ~((UInt32)1 << block);
+    }
+
+    slotMapPageData(ctx, slot, sslot, page, pageData, 0, 0, directBlocks);
+}
+
+void slotUpdatePage(BoardContext* board, int slot, int sslot, int page, UInt8* pageData, 
                     int readEnable, int writeEnable) 
 {
-    if (!initialized) {
+    SlotManagerContext* ctx = boardGetSlotManager(board);
+
+    if (!ctx->initialized) {
         return;
     }
 
-    slotMapPage(slot, sslot, page, pageData, readEnable, writeEnable);
+    slotMapPage(board, slot, sslot, page, pageData, readEnable, writeEnable);
     return;
-    slotTable[slot][sslot][page].readEnable  = readEnable;
-    slotTable[slot][sslot][page].writeEnable = writeEnable;
+    ctx->slotTable[slot][sslot][page].readEnable  = readEnable;
+    ctx->slotTable[slot][sslot][page].writeEnable = writeEnable;
 
     if (pageData != NULL) {
-        slotTable[slot][sslot][page].pageData = pageData;
+        ctx->slotTable[slot][sslot][page].pageData = pageData;
     }
 }
 
-void slotUnmapPage(int slot, int sslot, int page)
+void slotUnmapPage(BoardContext* board, int slot, int sslot, int page)
 {
-    if (!initialized) {
+    SlotManagerContext* ctx = boardGetSlotManager(board);
+
+    if (!ctx->initialized) {
         return;
     }
 
-    slotTable[slot][sslot][page].readEnable  = 0;
-    slotTable[slot][sslot][page].writeEnable = 1;
-    slotTable[slot][sslot][page].pageData = emptyRAM;
+    ctx->slotTable[slot][sslot][page].readEnable  = 0;
+    ctx->slotTable[slot][sslot][page].writeEnable = 1;
+    ctx->slotTable[slot][sslot][page].directBlocks = 0;
+    ctx->slotTable[slot][sslot][page].pageData = ctx->emptyRAM;
 
-    if (pslot[page >> 1].state == slot && 
-        (!pslot[slot].subslotted || pslot[page >> 1].substate == sslot))  
+    if (ctx->pslot[page >> 1].state == slot && 
+        (!ctx->pslot[slot].subslotted || ctx->pslot[page >> 1].substate == sslot))  
     {
-        slotMapRamPage(slot, sslot, page);
+        slotMapRam(ctx, slot, sslot, page);
     }
 }
 
-void slotRegisterWrite0(SlotWrite writeCb, void* ref) 
+void slotRegisterWrite0(BoardContext* board, SlotWrite writeCb, void* ref) 
 {
-    if (!initialized) {
+    SlotManagerContext* ctx = boardGetSlotManager(board);
+
+    if (!ctx->initialized) {
         return;
     }
 
-    slotAddr0.read  = NULL;
-    slotAddr0.write = writeCb;
-    slotAddr0.eject = NULL;
-    slotAddr0.ref   = ref;
+    ctx->slotAddr0.read  = NULL;
+    ctx->slotAddr0.write = writeCb;
+    ctx->slotAddr0.eject = NULL;
+    ctx->slotAddr0.ref   = ref;
+
+    slotUpdateBlocks(ctx, 0);
 }
 
-void slotUnregisterWrite0() {
-    if (!initialized) {
+void slotUnregisterWrite0(BoardContext* board) {
+    SlotManagerContext* ctx = boardGetSlotManager(board);
+
+    if (!ctx->initialized) {
         return;
     }
 
-    memset(&slotAddr0, 0, sizeof(Slot));
+    memset(&ctx->slotAddr0, 0, sizeof(Slot));
+
+    slotUpdateBlocks(ctx, 0);
 }
 
-void slotRegister(int slot, int sslot, int startpage, int pages,
+void slotRegister(BoardContext* board, int slot, int sslot, int startpage, int pages,
                   SlotRead readCb, SlotRead peekCb, SlotWrite writeCb, SlotEject ejectCb, void* ref)
 {
+    SlotManagerContext* ctx = boardGetSlotManager(board);
     Slot* slotInfo;
+    int page;
     
-    if (!initialized) {
+    if (!ctx->initialized) {
         return;
     }
 
-    slotInfo = &slotTable[slot][sslot][startpage];
+    slotInfo = &ctx->slotTable[slot][sslot][startpage];
 
     slotInfo->pages = pages;
 
@@ -198,125 +422,169 @@ void slotRegister(int slot, int sslot, int startpage, int pages,
         slotInfo->write = writeCb;
         slotInfo->eject = ejectCb;
         slotInfo->ref   = ref;
+        slotInfo->bankBase = NULL;
         slotInfo++;
     }
+
+    // Pages mapped before the device registered
+    for (page = startpage; page < startpage + ctx->slotTable[slot][sslot][startpage].pages; page++) {
+        UInt8* pageData = ctx->slotTable[slot][sslot][page].pageData;
+        if (pageData != NULL && pageData != ctx->emptyRAM) {
+            slotUpdateBankBase(ctx, slot, sslot, page, pageData);
+        }
+    }
 }
 
 
-void slotUnregister(int slot, int sslot, int startpage)
+void slotUnregister(BoardContext* board, int slot, int sslot, int startpage)
 {
+    SlotManagerContext* ctx = boardGetSlotManager(board);
     Slot* slotInfo;
     int pages;
 
-    if (!initialized) {
+    if (!ctx->initialized) {
         return;
     }
 
-    slotInfo = &slotTable[slot][sslot][startpage];
+    slotInfo = &ctx->slotTable[slot][sslot][startpage];
     pages = slotInfo->pages;
 
     while (pages--) {
         memset(slotInfo, 0, sizeof(Slot));
-        slotUnmapPage(slot, sslot, startpage + pages);
+        slotUnmapPage(board, slot, sslot, startpage + pages);
         slotInfo++;
     }
 }
 
-void slotRemove(int slot, int sslot)
+void slotRemove(BoardContext* board, int slot, int sslot)
 {
+    SlotManagerContext* ctx = boardGetSlotManager(board);
     int page;
 
-    if (!initialized) {
+    if (!ctx->initialized) {
         return;
     }
 
     for (page = 0; page < 8; page++) {
-        Slot* slotInfo = &slotTable[slot][sslot][page];
+        Slot* slotInfo = &ctx->slotTable[slot][sslot][page];
         if (slotInfo->eject != NULL) {
             slotInfo->eject(slotInfo->ref);
         }
     }
 }
 
-void slotSetSubslotted(int slot, int subslotted)
+void slotSetSubslotted(BoardContext* board, int slot, int subslotted)
 {
-    if (!initialized) {
+    SlotManagerContext* ctx = boardGetSlotManager(board);
+
+    if (!ctx->initialized) {
         return;
     }
 
-    pslot[slot].subslotted = subslotted;
+    ctx->pslot[slot].subslotted = subslotted;
+
+    slotUpdateBlocks(ctx, 7);
 }
 
-void slotManagerReset() 
+void slotManagerReset(BoardContext* board) 
 {
+    SlotManagerContext* ctx = boardGetSlotManager(board);
     int page;
 
-    if (!initialized) {
+    if (!ctx->initialized) {
         return;
     }
 
     for (page = 0; page < 4; page++) {
-        pslot[page].state = 0;
-        pslot[page].substate = 0;
+        ctx->pslot[page].state = 0;
+        ctx->pslot[page].substate = 0;
 
-        slotMapRamPage(0, 0, 2 * page);
-        slotMapRamPage(0, 0, 2 * page + 1);
+        slotMapRam(ctx, 0, 0, 2 * page);
+        slotMapRam(ctx, 0, 0, 2 * page + 1);
     }
 }
 
-void slotManagerCreate()
+void slotManagerCreate(BoardContext* board)
 {
+    SlotManagerContext* ctx = boardGetSlotManager(board);
     int slot;
     int sslot;
     int page;
 
-    memset(emptyRAM, 0xff, 0x2000);
-    memset(ramslot, 0, sizeof(ramslot));
-    memset(pslot, 0, sizeof(pslot));
-    memset(slotTable, 0, sizeof(slotTable));
-    memset(&slotAddr0, 0, sizeof(slotAddr0));
+    memset(ctx->emptyRAM, 0xff, 0x2000);
+    memset(ctx->ramslot, 0, sizeof(ctx->ramslot));
+    memset(ctx->pslot, 0, sizeof(ctx->pslot));
+    memset(ctx->slotTable, 0, sizeof(ctx->slotTable));
+    memset(&ctx->slotAddr0, 0, sizeof(ctx->slotAddr0));
+    memset(ctx->readBlocks, 0, sizeof(ctx->readBlocks));
+    memset(ctx->writeBlocks, 0, sizeof(ctx->writeBlocks));
+    memset(ctx->blockVersions, 0, sizeof(ctx->blockVersions));
 
     for (slot = 0; slot < 4; slot++) {
         for (sslot = 0; sslot < 4; sslot++) {
             for (page = 0; page < 8; page++) {
-                slotUnmapPage(slot, sslot, page);
+                slotUnmapPage(board, slot, sslot, page);
             }
         }
     }
 
-    initialized = 1;
+    ctx->initialized = 1;
+}
+
+void slotManagerDestroy(BoardContext* board) 
+{
+    SlotManagerContext* ctx = boardGetSlotManager(board);
+
+    ctx->initialized = 0;
+
+    memset(ctx->readBlocks, 0, sizeof(ctx->readBlocks));
+    memset(ctx->writeBlocks, 0, sizeof(ctx->writeBlocks));
+    memset(ctx->blockVersions, 0, sizeof(ctx->blockVersions));
 }
 
-void slotManagerDestroy() 
+void slotGetMapping(BoardContext* board, UInt16 address, int* slot, int* sslot, int* bank)
 {
-    initialized = 0;
+    SlotManagerContext* ctx = boardGetSlotManager(board);
+    UInt8* pageData = ctx->ramslot[address >> 13].pageData;
+    int psl = ctx->pslot[address >> 14].state;
+    int ssl = ctx->pslot[psl].subslotted ? ctx->pslot[address >> 14].substate : 0;
+    UInt8* bankBase = ctx->slotTable[psl][ssl][address >> 13].bankBase;
+
+    *slot  = psl;
+    *sslot = ssl;
+    *bank  = 0;
+
+    if (pageData != ctx->emptyRAM && bankBase != NULL && pageData >= bankBase) {
+        *bank = (int)((pageData - bankBase) / 0x2000);
+    }
 }
 
 UInt8 slotPeek(void* ref, UInt16 address)
 {
+    SlotManagerContext* ctx = boardGetSlotManager((BoardContext*)ref);
     Slot* slotInfo;
     int psl;
     int ssl;
 
-    if (!initialized) {
+    if (!ctx->initialized) {
         return 0xff;
     }
 
     if (address == 0xffff) {
-        UInt8 sslReg = pslot[3].state;
-        if (pslot[sslReg].subslotted) {
-            return ~pslot[sslReg].sslReg;
+        UInt8 sslReg = ctx->pslot[3].state;
+        if (ctx->pslot[sslReg].subslotted) {
+            return ~ctx->pslot[sslReg].sslReg;
         }
     }
 
-    if (ramslot[address >> 13].readEnable) {
-        return ramslot[address >> 13].pageData[address & 0x1fff];
+    if (ctx->ramslot[address >> 13].readEnable) {
+        return ctx->ramslot[address >> 13].pageData[address & 0x1fff];
     }
 
-    psl = pslot[address >> 14].state;
-    ssl = pslot[psl].subslotted ? pslot[address >> 14].substate : 0;
+    psl = ctx->pslot[address >> 14].state;
+    ssl = ctx->pslot[psl].subslotted ? ctx->pslot[address >> 14].substate : 0;
 
-    slotInfo = &slotTable[psl][ssl][address >> 13];
+    slotInfo = &ctx->slotTable[psl][ssl][address >> 13];
 
     if (slotInfo->peek != NULL) {
         address -= slotInfo->startpage << 13;
@@ -328,29 +596,30 @@ UInt8 slotPeek(void* ref, UInt16 address)
 
 UInt8 slotRead(void* ref, UInt16 address)
 {
+    SlotManagerContext* ctx = boardGetSlotManager((BoardContext*)ref);
     Slot* slotInfo;
     int psl;
     int ssl;
 
-    if (!initialized) {
+    if (!ctx->initialized) {
         return 0xff;
     }
 
     if (address == 0xffff) {
-        UInt8 sslReg = pslot[3].state;
-        if (pslot[sslReg].subslotted) {
-            return ~pslot[sslReg].sslReg;
+        UInt8 sslReg = ctx->pslot[3].state;
+        if (ctx->pslot[sslReg].subslotted) {
+            return ~ctx->pslot[sslReg].sslReg;
         }
     }
 
-    if (ramslot[address >> 13].readEnable) {
-        return ramslot[address >> 13].pageData[address & 0x1fff];
+    if (ctx->ramslot[address >> 13].readEnable) {
+        return ctx->ramslot[address >> 13].pageData[address & 0x1fff];
     }
 
-    psl = pslot[address >> 14].state;
-    ssl = pslot[psl].subslotted ? pslot[address >> 14].substate : 0;
+    psl = ctx->pslot[address >> 14].state;
+    ssl = ctx->pslot[psl].subslotted ? ctx->pslot[address >> 14].substate : 0;
 
-    slotInfo = &slotTable[psl][ssl][address >> 13];
+    slotInfo = &ctx->slotTable[psl][ssl][address >> 13];
 
     if (slotInfo->read != NULL) {
         address -= slotInfo->startpage << 13;
@@ -362,27 +631,31 @@ UInt8 slotRead(void* ref, UInt16 address)
 
 void slotWrite(void* ref, UInt16 address, UInt8 value)
 {
+    SlotManagerContext* ctx = boardGetSlotManager((BoardContext*)ref);
     Slot* slotInfo;
     int psl;
     int ssl;
     int page;
 
-    if (!initialized) {
+    if (!ctx->initialized) {
         return;
     }
 
+    // Code decoded from the block may be changed by the write
+    slotCodeWritten(ctx, address);
+
     if (address == 0xffff) {
-        UInt8 pslReg = pslot[3].state;
+        UInt8 pslReg = ctx->pslot[3].state;
 
-        if (pslot[pslReg].subslotted) {
+        if (ctx->pslot[pslReg].subslotted) {
 //            printf("SW: %d %d %d %d\n", (value>>0)&3, (value>>2)&3, (value>>4)&3, (value>>6)&3);
-            pslot[pslReg].sslReg = value;
+            ctx->pslot[pslReg].sslReg = value;
 
             for (page = 0; page < 4; page++) {
-                if(pslot[page].state == pslReg) {
-                    pslot[page].substate = value & 3;
-                    slotMapRamPage(pslReg, value & 3, 2 * page);
-                    slotMapRamPage(pslReg, value & 3, 2 * page + 1);
+                if(ctx->pslot[page].state == pslReg) {
+                    ctx->pslot[page].substate = value & 3;
+                    slotMapRam(ctx, pslReg, value & 3, 2 * page);
+                    slotMapRam(ctx, pslReg, value & 3, 2 * page + 1);
                 }
                 value >>= 2;
             }
@@ -392,21 +665,21 @@ void slotWrite(void* ref, UInt16 address, UInt8 value)
     }
 
     if (address == 0) {
-        if (slotAddr0.write != NULL) {
-            slotAddr0.write(slotAddr0.ref, address, value);
+        if (ctx->slotAddr0.write != NULL) {
+            ctx->slotAddr0.write(ctx->slotAddr0.ref, address, value);
             return;
         }
     }
 
-    if (ramslot[address >> 13].writeEnable) {
-        ramslot[address >> 13].pageData[address & 0x1FFF] = value;
+    if (ctx->ramslot[address >> 13].writeEnable) {
+        ctx->ramslot[address >> 13].pageData[address & 0x1FFF] = value;
         return;
     }
 
-    psl = pslot[address >> 14].state;
-    ssl = pslot[psl].subslotted ? pslot[address >> 14].substate : 0;
+    psl = ctx->pslot[address >> 14].state;
+    ssl = ctx->pslot[psl].subslotted ? ctx->pslot[address >> 14].substate : 0;
 
-    slotInfo = &slotTable[psl][ssl][address >> 13];
+    slotInfo = &ctx->slotTable[psl][ssl][address >> 13];
 
     if (slotInfo->write != NULL) {
         address -= slotInfo->startpage << 13;
@@ -414,69 +687,71 @@ void slotWrite(void* ref, UInt16 address, UInt8 value)
     }
 }
 
-void slotSaveState()
+void slotSaveState(BoardContext* board)
 {
+    SlotManagerContext* ctx = boardGetSlotManager(board);
     SaveState* state;
     char tag[32];
     int i;
 
-    if (!initialized) {
+    if (!ctx->initialized) {
         return;
     }
 
-    state = saveStateOpenForWrite("slotManager");
+    state = saveStateOpenForWrite(board, "slotManager");
 
     for (i = 0; i < 4; i++) {
         sprintf(tag, "subslotted%d", i);
-        saveStateSet(state, tag, pslot[i].subslotted);
+        saveStateSet(state, tag, ctx->pslot[i].subslotted);
         
         sprintf(tag, "state%d", i);
-        saveStateSet(state, tag, pslot[i].state);
+        saveStateSet(state, tag, ctx->pslot[i].state);
         
         sprintf(tag, "substate%d", i);
-        saveStateSet(state, tag, pslot[i].substate);
+        saveStateSet(state, tag, ctx->pslot[i].substate);
         
         sprintf(tag, "sslReg%d", i);
-        saveStateSet(state, tag, pslot[i].sslReg);
+        saveStateSet(state, tag, ctx->pslot[i].sslReg);
     }
 
     saveStateClose(state);
 }
 
-void slotLoadState()
+void slotLoadState(BoardContext* board)
 {
+    SlotManagerContext* ctx = boardGetSlotManager(board);
     SaveState* state;
     char tag[32];
     int page;
     int i;
 
-    if (!initialized) {
+    if (!ctx->initialized) {
         return;
     }
 
-    state = saveStateOpenForRead("slotManager");
+    state = saveStateOpenForRead(board, "slotManager");
 
     for (i = 0; i < 4; i++) {
         sprintf(tag, "subslotted%d", i);
-        pslot[i].subslotted = saveStateGet(state, tag, 0);
+        ctx->pslot[i].subslotted = saveStateGet(state, tag, 0);
         
         sprintf(tag, "state%d", i);
-        pslot[i].state = (UInt8)saveStateGet(state, tag, 0);
+        ctx->pslot[i].state = (UInt8)saveStateGet(state, tag, 0);
         
         sprintf(tag, "substate%d", i);
-        pslot[i].substate = (UInt8)saveStateGet(state, tag, 0);
+        ctx->pslot[i].substate = (UInt8)saveStateGet(state, tag, 0);
         
         sprintf(tag, "sslReg%d", i);
-        pslot[i].sslReg = (UInt8)saveStateGet(state, tag, 0);
+        ctx->pslot[i].sslReg = (UInt8)saveStateGet(state, tag, 0);
     }
 
     saveStateClose(state);
 
     for (page = 0; page < 4; page++) {
-        int psl = pslot[page].state;
-        int ssl = pslot[psl].subslotted ? pslot[page].substate : 0;
+        int psl = ctx->pslot[page].state;
+        int ssl = ctx->pslot[psl].subslotted ? ctx->pslot[page].substate : 0;
 
-        slotMapRamPage(psl, ssl, 2 * page);
-        slotMapRamPage(psl, ssl, 2 * page + 1);
+        slotMapRam(ctx, psl, ssl, 2 * page);
+        slotMapRam(ctx, psl, ssl, 2 * page + 1);
     }
 }
@@ -35,38 +35,73 @@ typedef UInt8 (*SlotRead)(void*, UInt16);
 typedef void  (*SlotWrite)(void*, UInt16, UInt8);
 typedef void  (*SlotEject)(void*);
 
+// The slot state of a board. It is created with the board context and
+// found with boardGetSlotManager(). slotRead(), slotWrite() and
+// slotPeek() take the board as their reference, like the CPU passes it.
+typedef struct SlotManagerContext SlotManagerContext;
 
-void slotManagerCreate();
-void slotManagerDestroy();
+SlotManagerContext* slotManagerContextCreate();
+void slotManagerContextDestroy(SlotManagerContext* context);
 
-void slotManagerReset();
+void slotManagerCreate(BoardContext* board);
+void slotManagerDestroy(BoardContext* board);
 
-void slotLoadState();
-void slotSaveState();
+void slotManagerReset(BoardContext* board);
+
+void slotLoadState(BoardContext* board);
+void slotSaveState(BoardContext* board);
 
 void slotWrite(void* ref, UInt16 address, UInt8 value);
 UInt8 slotRead(void* ref, UInt16 address);
 UInt8 slotPeek(void* ref, UInt16 address);
 
-void slotRegister(int slot, int sslot, int startpage, int pages,
+void slotRegister(BoardContext* board, int slot, int sslot, int startpage, int pages,
                   SlotRead readCb, SlotRead peekCb, SlotWrite writeCb, SlotEject ejectCb, void* ref);
-void slotUnregister(int slot, int sslot, int startpage);
+void slotUnregister(BoardContext* board, int slot, int sslot, int startpage);
+
+void slotRemove(BoardContext* board, int slot, int sslot);
 
-void slotRemove(int slot, int sslot);
+void slotRegisterWrite0(BoardContext* board, SlotWrite writeCb, void* ref);
+void slotUnregisterWrite0(BoardContext* board);
 
-void slotRegisterWrite0(SlotWrite writeCb, void* ref);
-void slotUnregisterWrite0();
+// Tables with a pointer to the memory in each 256 byte block of the
+// address space that slotRead() and slotWrite() access directly, or
+// NULL where they call a slot handler. The read table also points to
+// the plain memory blocks of pages mapped with slotMapPageIo().
+// The tables belong to the board and follow all mapping
+// changes, so the CPU can use them instead of slotRead() and slotWrite().
+UInt8** slotGetReadBlocks(BoardContext* board);
+UInt8** slotGetWriteBlocks(BoardContext* board);
 
-void slotSetRamSlot(int slot, int psl);
-int slotGetRamSlot(int page);
-void slotMapRamPage(int slot, int sslot, int page);
+// Table with a version number for each 256 byte block. A block gets a
+// new version when its mapping changes and when slotWrite() writes to
+// it, so code decoded from a block is valid as long as the version is
+// the same and the CPU hasn't written to it directly. Blocks that are
+// mapped at more than one address have version 0 and must not be cached.
+const UInt32* slotGetBlockVersions(BoardContext* board);
 
-void slotMapPage(int slot, int sslot, int page, UInt8* pageData, 
+void slotSetRamSlot(BoardContext* board, int slot, int psl);
+int slotGetRamSlot(BoardContext* board, int page);
+void slotMapRamPage(BoardContext* board, int slot, int sslot, int page);
+
+void slotMapPage(BoardContext* board, int slot, int sslot, int page, UInt8* pageData, 
                  int readEnable, int writeEnable);
-void slotUnmapPage(int slot, int sslot, int page);
-void slotUpdatePage(int slot, int sslot, int page, UInt8* pageData, 
+// Maps a banked page that is read directly from the page data, except
+// for the 256 byte blocks covering ioSize bytes at offset ioStart in the
+// page, which are read through the slot handler. Writes to the page and
+// slotRead() go to the slot handler, which must handle the whole page.
+void slotMapPageIo(BoardContext* board, int slot, int sslot, int page, UInt8* pageData, 
+                   int ioStart, int ioSize);
+void slotUnmapPage(BoardContext* board, int slot, int sslot, int page);
+void slotUpdatePage(BoardContext* board, int slot, int sslot, int page, UInt8* pageData, 
                     int readEnable, int writeEnable);
 
-void slotSetSubslotted(int slot, int subslotted);
+void slotSetSubslotted(BoardContext* board, int slot, int subslotted);
+
+// Returns the slot and subslot mapped at an address and the 8 kB bank
+// of the mapped page, counted from the start of the data of the device
+// registered on the page. Pages without page data or without a
+// registered device are reported as bank 0.
+void slotGetMapping(BoardContext* board, UInt16 address, int* slot, int* sslot, int* bank);
 
 #endif
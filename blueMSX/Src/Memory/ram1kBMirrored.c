@@ -38,6 +38,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     int slot;
@@ -50,7 +51,7 @@ typedef struct {
 
 static void saveState(Ram1kBMirrored* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperMirroredRam");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperMirroredRam");
 
     saveStateSet(state, "mask", rm->mask);
     saveStateSetBuffer(state, "ramData", rm->ramData, rm->mask + 1);
@@ -60,7 +61,7 @@ static void saveState(Ram1kBMirrored* rm)
 
 static void loadState(Ram1kBMirrored* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperMirroredRam");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperMirroredRam");
 
     rm->mask = saveStateGet(state, "mask", 0x400);
     saveStateGetBuffer(state, "ramData", rm->ramData, rm->mask + 1);
@@ -70,10 +71,10 @@ static void loadState(Ram1kBMirrored* rm)
 
 static void destroy(Ram1kBMirrored* rm)
 {
-    debugDeviceUnregister(rm->debugHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
-    slotUnregister(rm->slot, rm->sslot, 0);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, 0);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm);
 }
@@ -104,7 +105,7 @@ static void write(Ram1kBMirrored* rm, UInt16 address, UInt8 value)
     rm->ramData[address & rm->mask] = value;
 }
 
-int ramMirroredCreate(int size, int slot, int sslot, int startPage, 
+int ramMirroredCreate(BoardContext* board, int size, int slot, int sslot, int startPage, 
                       UInt32 ramBlockSize, UInt8** ramPtr, UInt32* ramSize) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -123,6 +124,7 @@ int ramMirroredCreate(int size, int slot, int sslot, int startPage,
     }
 
     rm = malloc(sizeof(Ram1kBMirrored));
+    rm->board = board;
 
     rm->mask      = ramBlockSize - 1;
     rm->slot      = slot;
@@ -132,15 +134,15 @@ int ramMirroredCreate(int size, int slot, int sslot, int startPage,
 
     memset(rm->ramData, 0, sizeof(rm->ramData));
 
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_RAM, langDbgDevRam(), &dbgCallbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_RAM, langDbgDevRam(), &dbgCallbacks, rm);
 
     for (i = 0; i < pages; i++) {
-        slotMapPage(slot, sslot, i + startPage, NULL, 0, 0);
+        slotMapPage(board, slot, sslot, i + startPage, NULL, 0, 0);
     } 
 
-    rm->deviceHandle = deviceManagerRegister(ramBlockSize == 0x400 ? RAM_1KB_MIRRORED : RAM_2KB_MIRRORED, 
+    rm->deviceHandle = deviceManagerRegister(board, ramBlockSize == 0x400 ? RAM_1KB_MIRRORED : RAM_2KB_MIRRORED, 
                                              &callbacks, rm);
-    slotRegister(slot, sslot, startPage, pages, read, read, write, destroy, rm);
+    slotRegister(board, slot, sslot, startPage, pages, read, read, write, destroy, rm);
 
     if (ramPtr != NULL) {
         *ramPtr = rm->ramData;
@@ -30,7 +30,7 @@
 
 #include "MsxTypes.h"
 
-int ramMirroredCreate(int size, int slot, int sslot, int startPage, UInt32 ramBlockSize, 
+int ramMirroredCreate(BoardContext* board, int size, int slot, int sslot, int startPage, UInt32 ramBlockSize, 
                       UInt8** ramPtr, UInt32* ramSize);
 
 #endif
@@ -41,6 +41,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* ramData;
     int handle;
@@ -58,7 +59,7 @@ static void writeIo(RamMapper* rm, UInt16 page, UInt8 value);
 
 static void saveState(RamMapper* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperRam");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperRam");
     
     saveStateSet(state, "mask",     rm->mask);
     saveStateSet(state, "dramMode", rm->dramMode);
@@ -71,7 +72,7 @@ static void saveState(RamMapper* rm)
 
 static void loadState(RamMapper* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperRam");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperRam");
     int i;
     
     rm->mask     = saveStateGet(state, "mask", 0);
@@ -93,8 +94,8 @@ static void loadState(RamMapper* rm)
     for (i = 0; i < 4; i++) {
         int value = ramMapperIoGetPortValue(i) & rm->mask;
         int mapped = rm->dramMode && (rm->mask - value < 4) ? 0 : 1;
-        slotMapPage(rm->slot, rm->sslot, 2 * i,     rm->ramData + 0x4000 * value, 1, mapped);
-        slotMapPage(rm->slot, rm->sslot, 2 * i + 1, rm->ramData + 0x4000 * value + 0x2000, 1, mapped);
+        slotMapPage(rm->board, rm->slot, rm->sslot, 2 * i,     rm->ramData + 0x4000 * value, 1, mapped);
+        slotMapPage(rm->board, rm->slot, rm->sslot, 2 * i + 1, rm->ramData + 0x4000 * value + 0x2000, 1, mapped);
     }
 #endif
 }
@@ -104,12 +105,12 @@ static void writeIo(RamMapper* rm, UInt16 page, UInt8 value)
     int baseAddr = 0x4000 * (value & rm->mask);
     rm->port[page] = value;
     if (rm->dramMode && baseAddr >= (rm->size - 0x10000)) {
-        slotMapPage(rm->slot, rm->sslot, 2 * page,     NULL, 0, 0);
-        slotMapPage(rm->slot, rm->sslot, 2 * page + 1, NULL, 0, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, 2 * page,     NULL, 0, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, 2 * page + 1, NULL, 0, 0);
     }
     else {
-        slotMapPage(rm->slot, rm->sslot, 2 * page,     rm->ramData + baseAddr, 1, 1);
-        slotMapPage(rm->slot, rm->sslot, 2 * page + 1, rm->ramData + baseAddr + 0x2000, 1, 1);
+        slotMapPage(rm->board, rm->slot, rm->sslot, 2 * page,     rm->ramData + baseAddr, 1, 1);
+        slotMapPage(rm->board, rm->slot, rm->sslot, 2 * page + 1, rm->ramData + baseAddr + 0x2000, 1, 1);
     }
 }
 
@@ -131,10 +132,10 @@ static void reset(RamMapper* rm)
 
 static void destroy(RamMapper* rm)
 {
-    debugDeviceUnregister(rm->debugHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
     ramMapperIoRemove(rm->handle);
-    slotUnregister(rm->slot, rm->sslot, 0);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, 0);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
     panasonicDramUnregister(rm->dramHandle);
     free(rm->ramData);
 
@@ -157,7 +158,7 @@ static int dbgWriteMemory(RamMapper* rm, char* name, void* data, int start, int
     return 1;
 }
 
-int ramMapperCreate(int size, int slot, int sslot, int startPage, UInt8** ramPtr, UInt32* ramSize) 
+int ramMapperCreate(BoardContext* board, int size, int slot, int sslot, int startPage, UInt8** ramPtr, UInt32* ramSize) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, dbgWriteMemory, NULL, NULL };
@@ -180,6 +181,7 @@ int ramMapperCreate(int size, int slot, int sslot, int startPage, UInt8** ramPtr
     }
 
     rm = malloc(sizeof(RamMapper));
+    rm->board = board;
 
     rm->ramData  = malloc(size);
     rm->size     = size;
@@ -192,10 +194,10 @@ int ramMapperCreate(int size, int slot, int sslot, int startPage, UInt8** ramPtr
 
     rm->handle  = ramMapperIoAdd(pages * 0x4000, writeIo, rm);
     
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_RAM, langDbgDevRam(), &dbgCallbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_RAM, langDbgDevRam(), &dbgCallbacks, rm);
 
-    rm->deviceHandle = deviceManagerRegister(RAM_MAPPER, &callbacks, rm);
-    slotRegister(slot, sslot, 0, 8, NULL, NULL, NULL, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, RAM_MAPPER, &callbacks, rm);
+    slotRegister(board, slot, sslot, 0, 8, NULL, NULL, NULL, destroy, rm);
 
     reset(rm);
 
@@ -30,6 +30,6 @@
 
 #include "MsxTypes.h"
 
-int ramMapperCreate(int size, int slot, int sslot, int startPage, UInt8** ramPtr, UInt32* ramSize);
+int ramMapperCreate(BoardContext* board, int size, int slot, int sslot, int startPage, UInt8** ramPtr, UInt32* ramSize);
 
 #endif
@@ -45,6 +45,7 @@ typedef struct {
 } RamMapperCb;
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     int handleCount;
@@ -73,7 +74,7 @@ static int ramMapperIoGetMask(RamMapperIo* rm)
 
 static void saveState(RamMapperIo* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperRamIo");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperRamIo");
     saveStateSet(state, "port0", rm->port[0]);
     saveStateSet(state, "port1", rm->port[1]);
     saveStateSet(state, "port2", rm->port[2]);
@@ -84,7 +85,7 @@ static void saveState(RamMapperIo* rm)
 
 static void loadState(RamMapperIo* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperRamIo");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperRamIo");
     rm->port[0] = saveStateGet(state, "port0", 3);
     rm->port[1] = saveStateGet(state, "port1", 2);
     rm->port[2] = saveStateGet(state, "port2", 1);
@@ -97,13 +98,13 @@ static void loadState(RamMapperIo* rm)
 
 static void destroy(RamMapperIo* rm) 
 {
-    ioPortUnregister(0xfc);
-    ioPortUnregister(0xfd);
-    ioPortUnregister(0xfe);
-    ioPortUnregister(0xff);
+    ioPortUnregister(rm->board, 0xfc);
+    ioPortUnregister(rm->board, 0xfd);
+    ioPortUnregister(rm->board, 0xfe);
+    ioPortUnregister(rm->board, 0xff);
 
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
     free(mapperIo);
     mapperIo = NULL;
@@ -142,13 +143,14 @@ static void getDebugInfo(RamMapperIo* rm, DbgDevice* dbgDevice)
     }
 }
 
-int ramMapperIoCreate() 
+int ramMapperIoCreate(BoardContext* board) 
 {
     RamMapperIo* rm;
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
 
     rm = malloc(sizeof(RamMapperIo));
+    rm->board = board;
     rm->count = 0;
     rm->mask  = 0;
     rm->handleCount = 0;
@@ -158,13 +160,13 @@ int ramMapperIoCreate()
     rm->port[2] = 1;
     rm->port[3] = 0;
 
-    rm->deviceHandle = deviceManagerRegister(RAM_MAPPER, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, langDbgDevRamMapper(), &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, RAM_MAPPER, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, langDbgDevRamMapper(), &dbgCallbacks, rm);
 
-    ioPortRegister(0xfc, read, write, rm);
-    ioPortRegister(0xfd, read, write, rm);
-    ioPortRegister(0xfe, read, write, rm);
-    ioPortRegister(0xff, read, write, rm);
+    ioPortRegister(board, 0xfc, read, write, rm);
+    ioPortRegister(board, 0xfd, read, write, rm);
+    ioPortRegister(board, 0xfe, read, write, rm);
+    ioPortRegister(board, 0xff, read, write, rm);
 
     mapperIo = rm;
 
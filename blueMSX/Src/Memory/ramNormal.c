@@ -38,6 +38,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     int slot;
@@ -49,7 +50,7 @@ typedef struct {
 
 static void saveState(RamNormal* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperNormalRam");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperNormalRam");
 
     saveStateSet(state, "pages", rm->pages);
     saveStateSetBuffer(state, "ramData", rm->ramData, rm->pages * 0x2000);
@@ -59,7 +60,7 @@ static void saveState(RamNormal* rm)
 
 static void loadState(RamNormal* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperNormalRam");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperNormalRam");
     int i;
 
     rm->pages = saveStateGet(state, "pages", 0);
@@ -75,10 +76,10 @@ static void loadState(RamNormal* rm)
 
 static void destroy(RamNormal* rm)
 {
-    debugDeviceUnregister(rm->debugHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
-    slotUnregister(rm->slot, rm->sslot, 0);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, 0);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm);
 }
@@ -99,7 +100,7 @@ static int dbgWriteMemory(RamNormal* rm, char* name, void* data, int start, int
     return 1;
 }
 
-int ramNormalCreate(int size, int slot, int sslot, int startPage, UInt8** ramPtr, UInt32* ramSize) 
+int ramNormalCreate(BoardContext* board, int size, int slot, int sslot, int startPage, UInt8** ramPtr, UInt32* ramSize) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, dbgWriteMemory, NULL, NULL };
@@ -117,6 +118,7 @@ int ramNormalCreate(int size, int slot, int sslot, int startPage, UInt8** ramPtr
     }
 
     rm = malloc(sizeof(RamNormal));
+    rm->board = board;
 
     rm->slot      = slot;
     rm->sslot     = sslot;
@@ -125,14 +127,14 @@ int ramNormalCreate(int size, int slot, int sslot, int startPage, UInt8** ramPtr
 
     memset(rm->ramData, 0xff, sizeof(rm->ramData));
 
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_RAM, langDbgDevRam(), &dbgCallbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_RAM, langDbgDevRam(), &dbgCallbacks, rm);
 
     for (i = 0; i < pages; i++) {
-        slotMapPage(slot, sslot, i + startPage, rm->ramData + 0x2000 * i, 1, 1);
+        slotMapPage(board, slot, sslot, i + startPage, rm->ramData + 0x2000 * i, 1, 1);
     }
 
-    rm->deviceHandle = deviceManagerRegister(RAM_NORMAL, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, pages, NULL, NULL, NULL, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, RAM_NORMAL, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, pages, NULL, NULL, NULL, destroy, rm);
 
     if (ramPtr != NULL) {
         *ramPtr = rm->ramData;
@@ -30,6 +30,6 @@
 
 #include "MsxTypes.h"
 
-int ramNormalCreate(int size, int slot, int sslot, int startPage, UInt8** ramPtr, UInt32* ramSize);
+int ramNormalCreate(BoardContext* board, int size, int slot, int sslot, int startPage, UInt8** ramPtr, UInt32* ramSize);
 
 #endif
@@ -43,6 +43,7 @@ enum {
 };
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     UInt8* sram;
@@ -99,7 +100,7 @@ static void changeBank(RomMapperA1FM* rm, int region, int bank);
 
 static void saveState(RomMapperA1FM* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperPanasonic");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperPanasonic");
     char tag[16];
     int i;
 
@@ -117,7 +118,7 @@ static void saveState(RomMapperA1FM* rm)
 
 static void loadState(RomMapperA1FM* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperPanasonic");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperPanasonic");
     int romMapper[8];
     char tag[16];
     int i;
@@ -154,8 +155,8 @@ static void destroy(RomMapperA1FM* rm)
 {
     sramSave(rm->sramFilename, rm->sram, rm->sramSize, NULL, 0);
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     panasonicSramDestroy();
 
@@ -201,7 +202,7 @@ static void changeBank(RomMapperA1FM* rm, int region, int bank)
         readBlock = emptyRam;
     }
 
-    slotMapPage(rm->slot, rm->sslot, region, readBlock, region != 3, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, region, readBlock, region != 3, 0);
 }
 
 static UInt8 read(RomMapperA1FM* rm, UInt16 address) 
@@ -253,7 +254,7 @@ static void reset(RomMapperA1FM* rm)
     changeBank(rm, 7, 0);
 }
 
-int romMapperA1FMCreate(const char* filename, UInt8* romData, 
+int romMapperA1FMCreate(BoardContext* board, const char* filename, UInt8* romData, 
                              int size, int slot, int sslot, int startPage,
                              int sramSize) 
 {
@@ -268,9 +269,10 @@ int romMapperA1FMCreate(const char* filename, UInt8* romData,
     memset(emptyRam, 0xff, sizeof(emptyRam));
 
     rm = malloc(sizeof(RomMapperA1FM));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_PANASONIC8, &callbacks, rm);
-    slotRegister(slot, sslot, 0, 8, read, read, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_PANASONIC8, &callbacks, rm);
+    slotRegister(board, slot, sslot, 0, 8, read, read, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -40,6 +40,7 @@ extern UInt8 panasonicSramGet(UInt32 address);
 extern void  panasonicSramSet(UInt32 address, UInt8 value);
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int    romSize;
@@ -51,7 +52,7 @@ typedef struct {
 
 static void saveState(RomMapperA1FMModem* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperPanasonicA1FM");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperPanasonicA1FM");
 
     saveStateSet(state, "romMapper", rm->romMapper);
     
@@ -60,18 +61,18 @@ static void saveState(RomMapperA1FMModem* rm)
 
 static void loadState(RomMapperA1FMModem* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperPanasonicA1FM");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperPanasonicA1FM");
     rm->romMapper = saveStateGet(state, "romMapper", 0);
     
     saveStateClose(state);
     
-    slotMapPage(rm->slot, rm->sslot, rm->startPage, rm->romData + rm->romMapper * 0x2000, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage, rm->romData + rm->romMapper * 0x2000, 1, 0);
 }
 
 static void destroy(RomMapperA1FMModem* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -104,27 +105,28 @@ static void write(RomMapperA1FMModem* rm, UInt16 address, UInt8 value)
 
 		if (address == 0x7fc4) {
             rm->romMapper = value & 0x0f;
-            slotMapPage(rm->slot, rm->sslot, rm->startPage, rm->romData + rm->romMapper * 0x2000, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage, rm->romData + rm->romMapper * 0x2000, 1, 0);
 		}
 	}
 }
 
 static void reset(RomMapperA1FMModem* rm)
 {
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, rm->romData + rm->romMapper * 0x2000, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, NULL, 0, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 0, rm->romData + rm->romMapper * 0x2000, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 1, NULL, 0, 0);
 }
 
-int romMapperA1FMModemCreate(const char* filename, UInt8* romData, 
+int romMapperA1FMModemCreate(BoardContext* board, const char* filename, UInt8* romData, 
                              int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     RomMapperA1FMModem* rm;
 
     rm = malloc(sizeof(RomMapperA1FMModem));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_FSA1FMMODEM, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 2, read, read, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_FSA1FMMODEM, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 2, read, read, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -30,7 +30,7 @@
  
 #include "MsxTypes.h"
 
-int romMapperA1FMModemCreate(const char* filename, UInt8* romData, 
+int romMapperA1FMModemCreate(BoardContext* board, const char* filename, UInt8* romData, 
                              int size, int slot, int sslot, int startPage);
 
 #endif
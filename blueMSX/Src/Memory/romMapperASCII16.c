@@ -36,6 +36,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -47,8 +48,8 @@ typedef struct {
 
 static void destroy(RomMapperASCII16* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -56,7 +57,7 @@ static void destroy(RomMapperASCII16* rm)
 
 static void saveState(RomMapperASCII16* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperASCII16");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperASCII16");
     char tag[16];
     int i;
 
@@ -70,7 +71,7 @@ static void saveState(RomMapperASCII16* rm)
 
 static void loadState(RomMapperASCII16* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperASCII16");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperASCII16");
     char tag[16];
     int i;
 
@@ -83,8 +84,8 @@ static void loadState(RomMapperASCII16* rm)
 
     for (i = 0; i < 4; i += 2) {
         UInt8* bankData = rm->romData + (rm->romMapper[i] << 14);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i,     bankData, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 1, bankData + 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i,     bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i + 1, bankData + 0x2000, 1, 0);
     }
 }
 
@@ -107,12 +108,12 @@ static void write(RomMapperASCII16* rm, UInt16 address, UInt8 value)
         
         rm->romMapper[bank] = value;
 
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank,     bankData, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank + 1, bankData + 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank,     bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank + 1, bankData + 0x2000, 1, 0);
     }
 }
 
-int romMapperASCII16Create(const char* filename, UInt8* romData, 
+int romMapperASCII16Create(BoardContext* board, const char* filename, UInt8* romData, 
                            int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -126,9 +127,10 @@ int romMapperASCII16Create(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperASCII16));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_ASCII16, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_ASCII16, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     size = (size + 0x3fff) & ~0x3fff;
 
@@ -143,8 +145,8 @@ int romMapperASCII16Create(const char* filename, UInt8* romData,
     rm->romMapper[2] = 0;
 
     for (i = 0; i < 4; i += 2) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i,     rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 1, rm->romData + rm->romMapper[i] * 0x2000 + 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i,     rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i + 1, rm->romData + rm->romMapper[i] * 0x2000 + 0x2000, 1, 0);
     }
 
     return 1;
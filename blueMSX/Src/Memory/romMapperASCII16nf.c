@@ -39,6 +39,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -50,7 +51,7 @@ typedef struct {
 
 static void saveState(RomMapperASCII16nf* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperASCII16nf");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperASCII16nf");
     char tag[16];
     int i;
 
@@ -64,7 +65,7 @@ static void saveState(RomMapperASCII16nf* rm)
 
 static void loadState(RomMapperASCII16nf* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperASCII16nf");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperASCII16nf");
     char tag[16];
     int i;
 
@@ -77,15 +78,15 @@ static void loadState(RomMapperASCII16nf* rm)
 
     for (i = 0; i < 4; i += 2) {
         UInt8* bankData = rm->romData + (rm->romMapper[i] << 14);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i,     bankData, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 1, bankData + 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i,     bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i + 1, bankData + 0x2000, 1, 0);
     }
 }
 
 static void destroy(RomMapperASCII16nf* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -110,12 +111,12 @@ static void write(RomMapperASCII16nf* rm, UInt16 address, UInt8 value)
         
         rm->romMapper[bank] = value;
 
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank,     bankData, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank + 1, bankData + 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank,     bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank + 1, bankData + 0x2000, 1, 0);
     }
 }
 
-int romMapperASCII16nfCreate(const char* filename, UInt8* romData, 
+int romMapperASCII16nfCreate(BoardContext* board, const char* filename, UInt8* romData, 
                              int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -123,9 +124,10 @@ int romMapperASCII16nfCreate(const char* filename, UInt8* romData,
     int i;
 
     rm = malloc(sizeof(RomMapperASCII16nf));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_ASCII16NF, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_ASCII16NF, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     size = (size + 0x3fff) & ~0x3fff;
 
@@ -140,8 +142,8 @@ int romMapperASCII16nfCreate(const char* filename, UInt8* romData,
     rm->romMapper[2] = 0;
 
     for (i = 0; i < 4; i += 2) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i,     rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 1, rm->romData + rm->romMapper[i] * 0x2000 + 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i,     rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i + 1, rm->romData + rm->romMapper[i] * 0x2000 + 0x2000, 1, 0);
     }
 
     return 1;
@@ -37,6 +37,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     UInt8 sram[0x2000];
@@ -51,7 +52,7 @@ typedef struct {
 
 static void saveState(RomMapperASCII16sram* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperASCII16sram");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperASCII16sram");
     char tag[16];
     int i;
 
@@ -67,7 +68,7 @@ static void saveState(RomMapperASCII16sram* rm)
 
 static void loadState(RomMapperASCII16sram* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperASCII16sram");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperASCII16sram");
     char tag[16];
     int i;
 
@@ -82,12 +83,12 @@ static void loadState(RomMapperASCII16sram* rm)
 
     for (i = 0; i < 4; i += 2) {   
         if (rm->sramEnabled & (1 << ((i >> 1) + 1))) {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + i,     rm->sram, 1, 0);
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 1, rm->sram, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i,     rm->sram, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i + 1, rm->sram, 1, 0);
         }
         else {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + i,     rm->romData + rm->romMapper[i] * 0x4000, 1, 0);
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 1, rm->romData + rm->romMapper[i] * 0x4000 + 0x2000, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i,     rm->romData + rm->romMapper[i] * 0x4000, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i + 1, rm->romData + rm->romMapper[i] * 0x4000 + 0x2000, 1, 0);
         }
     }
 }
@@ -96,8 +97,8 @@ static void destroy(RomMapperASCII16sram* rm)
 {
     sramSave(rm->sramFilename, rm->sram, 0x800, NULL, 0);
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -125,8 +126,8 @@ static void write(RomMapperASCII16sram* rm, UInt16 address, UInt8 value)
 
         rm->romMapper[bank] = value;
 
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank,     bankData1, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank + 1, bankData2, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank,     bankData1, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank + 1, bankData2, 1, 0);
     }
     else if ((1 << (address >> 14)) & rm->sramEnabled & 0x4) {
         int i;
@@ -138,7 +139,7 @@ static void write(RomMapperASCII16sram* rm, UInt16 address, UInt8 value)
     }
 }
 
-int romMapperASCII16sramCreate(const char* filename, UInt8* romData, 
+int romMapperASCII16sramCreate(BoardContext* board, const char* filename, UInt8* romData, 
                                int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -154,9 +155,10 @@ int romMapperASCII16sramCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperASCII16sram));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_ASCII16SRAM, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_ASCII16SRAM, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     rm->romData = calloc(1, size);
     memcpy(rm->romData, romData, origSize);
@@ -179,8 +181,8 @@ int romMapperASCII16sramCreate(const char* filename, UInt8* romData,
     rm->romMapper[2] = 0;
 
     for (i = 0; i < 4; i += 2) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i,     rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 1, rm->romData + rm->romMapper[i] * 0x2000 + 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i,     rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i + 1, rm->romData + rm->romMapper[i] * 0x2000 + 0x2000, 1, 0);
     }
 
     return 1;
@@ -36,6 +36,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -47,7 +48,7 @@ typedef struct {
 
 static void saveState(RomMapperASCII8* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperASCII8");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperASCII8");
     char tag[16];
     int i;
 
@@ -61,7 +62,7 @@ static void saveState(RomMapperASCII8* rm)
 
 static void loadState(RomMapperASCII8* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperASCII8");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperASCII8");
     char tag[16];
     int i;
 
@@ -73,14 +74,14 @@ static void loadState(RomMapperASCII8* rm)
     saveStateClose(state);
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 }
 
 static void destroy(RomMapperASCII8* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -104,11 +105,11 @@ static void write(RomMapperASCII8* rm, UInt16 address, UInt8 value)
 
         rm->romMapper[bank] = value;
         
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
     }
 }
 
-int romMapperASCII8Create(const char* filename, UInt8* romData, 
+int romMapperASCII8Create(BoardContext* board, const char* filename, UInt8* romData, 
                           int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -123,9 +124,10 @@ int romMapperASCII8Create(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperASCII8));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_ASCII8, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_ASCII8, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     rm->romData = calloc(1, size);
     memcpy(rm->romData, romData, origSize);
@@ -140,7 +142,7 @@ int romMapperASCII8Create(const char* filename, UInt8* romData,
     rm->romMapper[3] = 0;
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 
     return 1;
@@ -30,7 +30,7 @@
  
 #include "MsxTypes.h"
 
-int romMapperASCII8Create(const char* filename, UInt8* romData, 
+int romMapperASCII8Create(BoardContext* board, const char* filename, UInt8* romData, 
                           int size, int slot, int sslot, int startPage);
 
 #endif
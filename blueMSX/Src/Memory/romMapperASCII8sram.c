@@ -37,6 +37,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     UInt8 sram[0x2000];
@@ -51,7 +52,7 @@ typedef struct {
 
 static void saveState(RomMapperASCII8sram* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperASCII8sram");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperASCII8sram");
     char tag[16];
     int i;
 
@@ -67,7 +68,7 @@ static void saveState(RomMapperASCII8sram* rm)
 
 static void loadState(RomMapperASCII8sram* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperASCII8sram");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperASCII8sram");
     char tag[16];
     int i;
 
@@ -82,10 +83,10 @@ static void loadState(RomMapperASCII8sram* rm)
 
     for (i = 0; i < 4; i++) {   
         if (rm->sramEnabled & (1 << i)) {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->sram, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->sram, 1, 0);
         }
         else {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
         }
     }
 }
@@ -94,8 +95,8 @@ static void destroy(RomMapperASCII8sram* rm)
 {
     sramSave(rm->sramFilename, rm->sram, 0x2000, NULL, 0);
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -121,11 +122,11 @@ static void write(RomMapperASCII8sram* rm, UInt16 address, UInt8 value)
         }
 
         rm->romMapper[bank] = value;
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, writeCache);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, writeCache);
     }
 }
 
-int romMapperASCII8sramCreate(const char* filename, UInt8* romData, 
+int romMapperASCII8sramCreate(BoardContext* board, const char* filename, UInt8* romData, 
                               int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -140,9 +141,10 @@ int romMapperASCII8sramCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperASCII8sram));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_ASCII8SRAM, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_ASCII8SRAM, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     rm->romData = calloc(1, size);
     memcpy(rm->romData, romData, origSize);
@@ -162,7 +164,7 @@ int romMapperASCII8sramCreate(const char* filename, UInt8* romData,
     rm->romMapper[3] = 0;
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 
     return 1;
@@ -33,6 +33,7 @@
 #include <stdio.h>
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -48,13 +49,13 @@ typedef struct {
 static void slotSetMapper(RomMapperActivisionPcb* rm, int romMapper)
 {
     rm->romMapper = romMapper & rm->romMask;
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, rm->romData + 0x0000 + (rm->romMapper << 14), 0, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 3, rm->romData + 0x2000 + (rm->romMapper << 14), 0, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 2, rm->romData + 0x0000 + (rm->romMapper << 14), 0, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 3, rm->romData + 0x2000 + (rm->romMapper << 14), 0, 0);
 }
 
 static void saveState(RomMapperActivisionPcb* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperActivisionPcb");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperActivisionPcb");
     saveStateSet(state, "romMapper",  rm->romMapper);
     saveStateSet(state, "latch",      rm->latch);
     saveStateClose(state);
@@ -66,7 +67,7 @@ static void saveState(RomMapperActivisionPcb* rm)
 
 static void loadState(RomMapperActivisionPcb* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperActivisionPcb");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperActivisionPcb");
     rm->romMapper = (UInt8)saveStateGet(state, "romMapper",  1);
     rm->latch     = (UInt8)saveStateGet(state, "latch",      0);
     slotSetMapper(rm, rm->romMapper);
@@ -78,8 +79,8 @@ static void loadState(RomMapperActivisionPcb* rm)
 
 static void destroy(RomMapperActivisionPcb* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
     if (rm->eeprom != NULL) {
         microchip24x00Destroy(rm->eeprom);
     }
@@ -190,7 +191,7 @@ static UInt8 peek(RomMapperActivisionPcb* rm, UInt16 address)
     return 0;
 }
 
-int romMapperActivisionPcbCreate(const char* filename, int romType, UInt8* romData, 
+int romMapperActivisionPcbCreate(BoardContext* board, const char* filename, int romType, UInt8* romData, 
                                  int size, int slot, int sslot, 
                                  int startPage) 
 {
@@ -202,9 +203,10 @@ int romMapperActivisionPcbCreate(const char* filename, int romType, UInt8* romDa
     }
     
     rm = malloc(sizeof(RomMapperActivisionPcb));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(romType, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, read, peek, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, romType, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, read, peek, write, destroy, rm);
 
     rm->romData = calloc(1, size);
     memcpy(rm->romData, romData, size);
@@ -217,14 +219,14 @@ int romMapperActivisionPcbCreate(const char* filename, int romType, UInt8* romDa
         rm->eeprom = NULL;
     }
     else {
-        rm->eeprom = microchip24x00Create(
+        rm->eeprom = microchip24x00Create(board, 
             romType == ROM_ACTIVISIONPCB_2K ? AT24C02 :
             (romType == ROM_ACTIVISIONPCB_16K ? AT24C16 : AT24C256), sramCreateFilename(filename));
     }
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, rm->romData + 0x0000, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, rm->romData + 0x2000, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, rm->romData + 0x0000 + (rm->romMapper << 14), 0, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 3, rm->romData + 0x2000 + (rm->romMapper << 14), 0, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 0, rm->romData + 0x0000, 1, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 1, rm->romData + 0x2000, 1, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 2, rm->romData + 0x0000 + (rm->romMapper << 14), 0, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 3, rm->romData + 0x2000 + (rm->romMapper << 14), 0, 0);
 
     reset(rm);
 
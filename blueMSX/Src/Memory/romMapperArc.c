@@ -39,6 +39,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     UInt8* romData;
@@ -51,11 +52,11 @@ typedef struct {
 
 static void destroy(Arc* rm)
 {
-    ioPortUnregister(0x7f);
+    ioPortUnregister(rm->board, 0x7f);
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
     free(rm->romData);
     free(rm);
@@ -63,7 +64,7 @@ static void destroy(Arc* rm)
 
 static void saveState(Arc* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperArc");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperArc");
 
     saveStateSet(state, "offset", rm->offset);
 
@@ -72,7 +73,7 @@ static void saveState(Arc* rm)
 
 static void loadState(Arc* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperArc");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperArc");
 
     rm->offset = (UInt8)saveStateGet(state, "offset", 0);
 
@@ -107,7 +108,7 @@ static void getDebugInfo(Arc* rm, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 0, 0x7f, DBG_IO_READWRITE, readIo(rm, 0x7f));
 }
 
-int romMapperArcCreate(const char* filename, UInt8* romData, 
+int romMapperArcCreate(BoardContext* board, const char* filename, UInt8* romData, 
                        int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
@@ -117,11 +118,12 @@ int romMapperArcCreate(const char* filename, UInt8* romData,
     int i;
 
     rm = malloc(sizeof(Arc));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_ARC, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_CART, "Parallax ARC", &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_ARC, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_CART, "Parallax ARC", &dbgCallbacks, rm);
 
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, NULL, destroy, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, NULL, destroy, rm);
 
     size = (size + 0x3fff) & ~0x3fff;
 
@@ -132,10 +134,10 @@ int romMapperArcCreate(const char* filename, UInt8* romData,
     rm->startPage  = startPage;
 
     for (i = 0; i < pages; i++) {
-        slotMapPage(slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
+        slotMapPage(board, slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
     }
     
-    ioPortRegister(0x7f, readIo, writeIo, rm);
+    ioPortRegister(board, 0x7f, readIo, writeIo, rm);
 
     reset(rm);
 
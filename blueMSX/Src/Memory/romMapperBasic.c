@@ -36,6 +36,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -48,13 +49,13 @@ static void destroy(void* arg)
 {
     RomMapperBasic* rm = (RomMapperBasic*)arg;
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
 }
-int romMapperBasicCreate(const char* filename, UInt8* romData, 
+int romMapperBasicCreate(BoardContext* board, const char* filename, UInt8* romData, 
                          int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, NULL, NULL };
@@ -65,6 +66,7 @@ int romMapperBasicCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperBasic));
+    rm->board = board;
 
     rm->romData = malloc(0x8000);
     memset(rm->romData, 0xff, 0x8000);
@@ -75,13 +77,13 @@ int romMapperBasicCreate(const char* filename, UInt8* romData,
     rm->sslot = sslot;
     rm->startPage  = startPage;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_BASIC, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, NULL, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_BASIC, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, NULL, destroy, rm);
 
-    slotMapPage(slot, sslot, startPage + 0, rm->romData + 0x0000, 1, 0);
-    slotMapPage(slot, sslot, startPage + 1, rm->romData + 0x2000, 1, 0);
-    slotMapPage(slot, sslot, startPage + 2, rm->romData + 0x4000, 1, 0);
-    slotMapPage(slot, sslot, startPage + 3, rm->romData + 0x6000, 1, 0);
+    slotMapPage(board, slot, sslot, startPage + 0, rm->romData + 0x0000, 1, 0);
+    slotMapPage(board, slot, sslot, startPage + 1, rm->romData + 0x2000, 1, 0);
+    slotMapPage(board, slot, sslot, startPage + 2, rm->romData + 0x4000, 1, 0);
+    slotMapPage(board, slot, sslot, startPage + 3, rm->romData + 0x6000, 1, 0);
 
     return 1;
 }
@@ -72,6 +72,7 @@ PC7    HRD    25 /IORD
 */
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     UInt8* romData;
@@ -88,7 +89,7 @@ typedef struct {
 
 static void saveState(RomMapperBeerIde* rm)
 {
-    SaveState* state = saveStateOpenForWrite("RomMapperBeerIde");
+    SaveState* state = saveStateOpenForWrite(rm->board, "RomMapperBeerIde");
 
     saveStateSet(state, "ideAddress", rm->ideAddress);
     saveStateSet(state, "ideIoRead", rm->ideIoRead);
@@ -103,7 +104,7 @@ static void saveState(RomMapperBeerIde* rm)
 
 static void loadState(RomMapperBeerIde* rm)
 {
-    SaveState* state = saveStateOpenForRead("RomMapperBeerIde");
+    SaveState* state = saveStateOpenForRead(rm->board, "RomMapperBeerIde");
 
     rm->ideAddress = (UInt8)saveStateGet(state, "ideAddress", 0);
     rm->ideIoRead = (UInt8)saveStateGet(state, "ideIoRead", 0);
@@ -118,14 +119,14 @@ static void loadState(RomMapperBeerIde* rm)
 
 static void destroy(RomMapperBeerIde* rm)
 {
-    ioPortUnregister(0x30);
-    ioPortUnregister(0x31);
-    ioPortUnregister(0x32);
-    ioPortUnregister(0x33);
+    ioPortUnregister(rm->board, 0x30);
+    ioPortUnregister(rm->board, 0x31);
+    ioPortUnregister(rm->board, 0x32);
+    ioPortUnregister(rm->board, 0x33);
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
     harddiskIdeDestroy(rm->hdide);
     i8255Destroy(rm->i8255);
@@ -221,7 +222,7 @@ static void getDebugInfo(RomMapperBeerIde* rm, DbgDevice* dbgDevice)
     }
 }
 
-int romMapperBeerIdeCreate(int hdId, const char* fileName, UInt8* romData, 
+int romMapperBeerIdeCreate(BoardContext* board, int hdId, const char* fileName, UInt8* romData, 
                            int size, int slot, int sslot, int startPage)
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
@@ -240,12 +241,13 @@ int romMapperBeerIdeCreate(int hdId, const char* fileName, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperBeerIde));
+    rm->board = board;
     
-    rm->deviceHandle = deviceManagerRegister(ROM_BEERIDE, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_PORT, langDbgDevIdeBeer(), &dbgCallbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, read, read, NULL, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_BEERIDE, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_PORT, langDbgDevIdeBeer(), &dbgCallbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, read, read, NULL, destroy, rm);
 
-    rm->i8255 = i8255Create( NULL, readA, writeA,
+    rm->i8255 = i8255Create(board,  NULL, readA, writeA,
                              NULL, readB, writeB,
                              NULL, NULL,  writeCLo,
                              NULL, NULL,  writeCHi,
@@ -263,16 +265,17 @@ int romMapperBeerIdeCreate(int hdId, const char* fileName, UInt8* romData,
     rm->sslot = sslot;
     rm->startPage  = startPage;
 
+    // The ROM needs no read handler, the IDE interface is on I/O ports
     for (i = 0; i < 8; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, NULL, 0, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, i < 2 ? rm->romData + 0x2000 * i : NULL, i < 2, 0);
     }
 
-    ioPortRegister(0x30, i8255Read, i8255Write, rm->i8255); // PPI Port A
-    ioPortRegister(0x31, i8255Read, i8255Write, rm->i8255); // PPI Port B
-    ioPortRegister(0x32, i8255Read, i8255Write, rm->i8255); // PPI Port C
-    ioPortRegister(0x33, i8255Read, i8255Write, rm->i8255); // PPI Mode
+    ioPortRegister(board, 0x30, i8255Read, i8255Write, rm->i8255); // PPI Port A
+    ioPortRegister(board, 0x31, i8255Read, i8255Write, rm->i8255); // PPI Port B
+    ioPortRegister(board, 0x32, i8255Read, i8255Write, rm->i8255); // PPI Port C
+    ioPortRegister(board, 0x33, i8255Read, i8255Write, rm->i8255); // PPI Mode
 
-    rm->hdide = harddiskIdeCreate(diskGetHdDriveId(hdId, 0));
+    rm->hdide = harddiskIdeCreate(board, diskGetHdDriveId(hdId, 0));
 
     reset(rm);
 
@@ -30,6 +30,6 @@
  
 #include "MsxTypes.h"
 
-int romMapperBeerIdeCreate(int hdId, const char* fileName, UInt8* romData, 
+int romMapperBeerIdeCreate(BoardContext* board, int hdId, const char* fileName, UInt8* romData, 
                            int size, int slot, int sslot, int startPage);
 #endif
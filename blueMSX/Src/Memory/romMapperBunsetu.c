@@ -36,6 +36,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     UInt8* jisyoData;
@@ -47,7 +48,7 @@ typedef struct {
 
 static void saveState(RomMapperBunsetu* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperBunsetu");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperBunsetu");
 
     saveStateSet(state, "address", rm->address);
     
@@ -56,7 +57,7 @@ static void saveState(RomMapperBunsetu* rm)
 
 static void loadState(RomMapperBunsetu* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperBunsetu");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperBunsetu");
 
     rm->address = saveStateGet(state, "address", 0);
 
@@ -65,8 +66,8 @@ static void loadState(RomMapperBunsetu* rm)
 
 static void destroy(RomMapperBunsetu* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     if (rm->jisyoData) {
@@ -120,7 +121,7 @@ static void write(RomMapperBunsetu* rm, UInt16 address, UInt8 value)
 	}
 }
 
-int romMapperBunsetuCreate(const char* filename, UInt8* romData, 
+int romMapperBunsetuCreate(BoardContext* board, const char* filename, UInt8* romData, 
                           int size, int slot, int sslot, int startPage,
                           void* jisyoRom, int jisyoSize) 
 {
@@ -132,9 +133,10 @@ int romMapperBunsetuCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperBunsetu));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_BUNSETU, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, read, peek, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_BUNSETU, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, read, peek, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -151,10 +153,11 @@ int romMapperBunsetuCreate(const char* filename, UInt8* romData,
     rm->sslot     = sslot;
     rm->startPage = startPage;
 
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, rm->romData + 0x0000, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, rm->romData + 0x2000, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, rm->romData + 0x4000, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 3, rm->romData + 0x6000, 0, 0);
+    // Only the dictionary port at 0xbfff needs the read handler
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 0, rm->romData + 0x0000, 1, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 1, rm->romData + 0x2000, 1, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 2, rm->romData + 0x4000, 1, 0);
+    slotMapPageIo(board, rm->slot, rm->sslot, rm->startPage + 3, rm->romData + 0x6000, 0x1fff, 1);
 
     return 1;
 }
@@ -39,6 +39,7 @@ static UInt16 patchAddress[] = { 0x00e1, 0x00e4, 0x00e7, 0x00ea, 0x00ed, 0x00f0,
 static UInt16 patchAddressSVI[] = {0x006C,0x006F,0x0072,0x0075,0x0078,0x210A,0x21A9,0}; // 0x0069
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -48,14 +49,14 @@ typedef struct {
 
 static void destroy(RomMapperCasette* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
 }
 
-int romMapperCasetteCreate(const char* filename, UInt8* romData, 
+int romMapperCasetteCreate(BoardContext* board, const char* filename, UInt8* romData, 
                         int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, NULL, NULL };
@@ -68,9 +69,10 @@ int romMapperCasetteCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperCasette));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_CASPATCH, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, pages, NULL, NULL, NULL, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_CASPATCH, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, pages, NULL, NULL, NULL, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -79,7 +81,7 @@ int romMapperCasetteCreate(const char* filename, UInt8* romData,
     rm->sslot = sslot;
     rm->startPage  = startPage;
 
-    if (boardGetType() == BOARD_SVI) {
+    if (boardGetType(board) == BOARD_SVI) {
         // Patch the SVI-328 BIOS and BASIC for cassette handling
         for (i = 0; patchAddressSVI[i]; i++) {
             UInt8* ptr = rm->romData + patchAddressSVI[i];
@@ -107,7 +109,7 @@ int romMapperCasetteCreate(const char* filename, UInt8* romData,
     }
 
     for (i = 0; i < pages; i++) {
-        slotMapPage(slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
+        slotMapPage(board, slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
     }
 
     return 1;
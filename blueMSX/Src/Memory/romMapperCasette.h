@@ -30,7 +30,7 @@
 
 #include "MsxTypes.h"
 
-int romMapperCasetteCreate(const char* filename, UInt8* romData, 
+int romMapperCasetteCreate(BoardContext* board, const char* filename, UInt8* romData, 
                            int size, int slot, int sslot, int startPage);
 
 #endif
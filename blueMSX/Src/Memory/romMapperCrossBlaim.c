@@ -36,6 +36,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -50,7 +51,7 @@ static void write(RomMapperCrossBlaim* rm, UInt16 address, UInt8 value);
 
 static void saveState(RomMapperCrossBlaim* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperCrossBlaim");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperCrossBlaim");
     char tag[16];
     int i;
 
@@ -64,7 +65,7 @@ static void saveState(RomMapperCrossBlaim* rm)
 
 static void loadState(RomMapperCrossBlaim* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperCrossBlaim");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperCrossBlaim");
     char tag[16];
     int i;
 
@@ -82,8 +83,8 @@ static void loadState(RomMapperCrossBlaim* rm)
 
 static void destroy(RomMapperCrossBlaim* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -102,14 +103,14 @@ static void write(RomMapperCrossBlaim* rm, UInt16 address, UInt8 value)
     		// page 2 specified bank
     		UInt8* bankData = rm->romData + ((int)value << 14);
     		
-	        slotMapPage(rm->slot, rm->sslot, 4, bankData,          1, 0);
-        	slotMapPage(rm->slot, rm->sslot, 5, bankData + 0x2000, 1, 0);
+	        slotMapPage(rm->board, rm->slot, rm->sslot, 4, bankData,          1, 0);
+        	slotMapPage(rm->board, rm->slot, rm->sslot, 5, bankData + 0x2000, 1, 0);
     		
     		// page 0 and 3 unmapped
-    		slotMapPage(rm->slot, rm->sslot, 0, NULL, 0, 0);
-    		slotMapPage(rm->slot, rm->sslot, 1, NULL, 0, 0);
-    		slotMapPage(rm->slot, rm->sslot, 6, NULL, 0, 0);
-    		slotMapPage(rm->slot, rm->sslot, 7, NULL, 0, 0);
+    		slotMapPage(rm->board, rm->slot, rm->sslot, 0, NULL, 0, 0);
+    		slotMapPage(rm->board, rm->slot, rm->sslot, 1, NULL, 0, 0);
+    		slotMapPage(rm->board, rm->slot, rm->sslot, 6, NULL, 0, 0);
+    		slotMapPage(rm->board, rm->slot, rm->sslot, 7, NULL, 0, 0);
     	}
     	else {
     		int i;
@@ -118,14 +119,14 @@ static void write(RomMapperCrossBlaim* rm, UInt16 address, UInt8 value)
     		// page 2 bank 1, page 0 and 3 mirrors of page 2
     		for (i=0;i<8;i+=2) {
     			if (i==2) continue;
-    			slotMapPage(rm->slot, rm->sslot, i,   rm->romData+0x4000, 1, 0);
-    			slotMapPage(rm->slot, rm->sslot, i+1, rm->romData+0x6000, 1, 0);
+    			slotMapPage(rm->board, rm->slot, rm->sslot, i,   rm->romData+0x4000, 1, 0);
+    			slotMapPage(rm->board, rm->slot, rm->sslot, i+1, rm->romData+0x6000, 1, 0);
     		}
     	}
     }
 }
 
-int romMapperCrossBlaimCreate(const char* filename, UInt8* romData, 
+int romMapperCrossBlaimCreate(BoardContext* board, const char* filename, UInt8* romData, 
                               int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -136,9 +137,10 @@ int romMapperCrossBlaimCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperCrossBlaim));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_CROSSBLAIM, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 8, NULL, NULL, write, destroy, rm); // $0000-$FFFF
+    rm->deviceHandle = deviceManagerRegister(board, ROM_CROSSBLAIM, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 8, NULL, NULL, write, destroy, rm); // $0000-$FFFF
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -148,8 +150,8 @@ int romMapperCrossBlaimCreate(const char* filename, UInt8* romData,
     rm->startPage  = startPage;
 
     // page 1 fixed to ROM 0 bank 0
-    slotMapPage(rm->slot, rm->sslot, 2, rm->romData+0x0000, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, 3, rm->romData+0x2000, 1, 0);
+    slotMapPage(board, rm->slot, rm->sslot, 2, rm->romData+0x0000, 1, 0);
+    slotMapPage(board, rm->slot, rm->sslot, 3, rm->romData+0x2000, 1, 0);
     
     rm->romMapper[0] = 0;
     rm->romMapper[2] = -1;
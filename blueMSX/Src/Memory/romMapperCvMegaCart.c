@@ -36,6 +36,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -47,8 +48,8 @@ typedef struct {
 
 static void destroy(RomMapperCvMegaCart* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -56,7 +57,7 @@ static void destroy(RomMapperCvMegaCart* rm)
 
 static void saveState(RomMapperCvMegaCart* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperCvMegaCart");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperCvMegaCart");
 
     saveStateSet(state, "romMapper", rm->romMapper);
 
@@ -65,7 +66,7 @@ static void saveState(RomMapperCvMegaCart* rm)
 
 static void loadState(RomMapperCvMegaCart* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperCvMegaCart");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperCvMegaCart");
     UInt8* bankData;
 
     rm->romMapper = saveStateGet(state, "romMapper", 0);
@@ -73,8 +74,8 @@ static void loadState(RomMapperCvMegaCart* rm)
     saveStateClose(state);
 
     bankData = rm->romData + (rm->romMapper << 14);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, bankData, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 3, bankData + 0x2000, 0, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 2, bankData, 1, 0);
+    slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + 3, bankData + 0x2000, 0x1fc0, 0x40);
 }
 
 static UInt8 read(RomMapperCvMegaCart* rm, UInt16 address) 
@@ -91,8 +92,8 @@ static UInt8 read(RomMapperCvMegaCart* rm, UInt16 address)
     rm->romMapper = address & rm->romMask;
 
     bankData = rm->romData + (rm->romMapper << 14);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, bankData, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 3, bankData + 0x2000, 0, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 2, bankData, 1, 0);
+    slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + 3, bankData + 0x2000, 0x1fc0, 0x40);
 
     return rm->romMapper;
 }
@@ -109,7 +110,7 @@ static UInt8 peek(RomMapperCvMegaCart* rm, UInt16 address)
     return rm->romMapper;
 }
 
-int romMapperCvMegaCartCreate(const char* filename, UInt8* romData, 
+int romMapperCvMegaCartCreate(BoardContext* board, const char* filename, UInt8* romData, 
                            int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -121,9 +122,10 @@ int romMapperCvMegaCartCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperCvMegaCart));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_CVMEGACART, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, read, peek, NULL, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_CVMEGACART, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, read, peek, NULL, destroy, rm);
 
     rm->romData = calloc(1, size);
     memcpy(rm->romData, romData, size);
@@ -134,12 +136,13 @@ int romMapperCvMegaCartCreate(const char* filename, UInt8* romData,
     rm->romMapper = 0;
 
     bankData = rm->romData + (rm->romMask << 14);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, bankData, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, bankData + 0x2000, 1, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 0, bankData, 1, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 1, bankData + 0x2000, 1, 0);
 
+    // Only the bank select hotspots at 0xffc0 - 0xffff need the read handler
     bankData = rm->romData + (rm->romMapper << 14);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, bankData, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 3, bankData + 0x2000, 0, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 2, bankData, 1, 0);
+    slotMapPageIo(board, rm->slot, rm->sslot, rm->startPage + 3, bankData + 0x2000, 0x1fc0, 0x40);
  
     return 1;
 }
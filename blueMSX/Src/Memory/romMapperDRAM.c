@@ -74,6 +74,7 @@ void panasonicDramUpdate(int mode)
 }
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int sramHandle;
     UInt8* romData;
@@ -85,8 +86,8 @@ typedef struct {
 
 static void destroy(RomMapperDram* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
     panasonicDramUnregister(rm->sramHandle);
 
     free(rm->romData);
@@ -100,14 +101,14 @@ static void setDram(RomMapperDram* rm, int enable)
             int endPage = MIN(4, rm->startPage + rm->pages);
             int page;
             for (page = rm->startPage; page < 4; page++) {
-                slotMapPage(rm->slot, rm->sslot, page, boardGetRamPage(page - 8), 1, 0);
+                slotMapPage(rm->board, rm->slot, rm->sslot, page, boardGetRamPage(rm->board, page - 8), 1, 0);
             }
         }
         else if (rm->slot == 3 && rm->sslot == 1) {
             int endPage = MIN(4, rm->startPage + rm->pages);
             int page;
             for (page = rm->startPage; page < 4; page++) {
-                slotMapPage(rm->slot, rm->sslot, page, boardGetRamPage(page - 4), 1, 0);
+                slotMapPage(rm->board, rm->slot, rm->sslot, page, boardGetRamPage(rm->board, page - 4), 1, 0);
             }
         }
     }
@@ -115,12 +116,12 @@ static void setDram(RomMapperDram* rm, int enable)
         int endPage = MIN(4, rm->startPage + rm->pages);
         int page;
         for (page = rm->startPage; page < 4; page++) {
-            slotMapPage(rm->slot, rm->sslot, page, rm->romData + 0x2000 * (page - rm->startPage), 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, page, rm->romData + 0x2000 * (page - rm->startPage), 1, 0);
         }
     }
 }
 
-int romMapperDramCreate(const char* filename, UInt8* romData, 
+int romMapperDramCreate(BoardContext* board, const char* filename, UInt8* romData, 
                         int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, NULL, NULL };
@@ -132,9 +133,10 @@ int romMapperDramCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperDram));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_DRAM, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, pages, NULL, NULL, NULL, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_DRAM, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, pages, NULL, NULL, NULL, destroy, rm);
     rm->sramHandle = panasonicDramRegister(setDram, rm);
 
     rm->romData = malloc(pages * 0x2000);
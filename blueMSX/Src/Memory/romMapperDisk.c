@@ -38,6 +38,7 @@
 static UInt16 patchAddress[] = { 0x4010, 0x4013, 0x4016, 0x401c, 0x401f, 0 };
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -47,14 +48,14 @@ typedef struct {
 
 static void destroy(RomMapperDisk* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
 }
 
-int romMapperDiskCreate(const char* filename, UInt8* romData, 
+int romMapperDiskCreate(BoardContext* board, const char* filename, UInt8* romData, 
                         int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, NULL, NULL };
@@ -67,9 +68,10 @@ int romMapperDiskCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperDisk));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_DISKPATCH, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, pages, NULL, NULL, NULL, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_DISKPATCH, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, pages, NULL, NULL, NULL, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -87,7 +89,7 @@ int romMapperDiskCreate(const char* filename, UInt8* romData,
     }
 
     for (i = 0; i < pages; i++) {
-        slotMapPage(slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
+        slotMapPage(board, slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
     }
 
     return 1;
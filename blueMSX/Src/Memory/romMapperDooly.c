@@ -36,6 +36,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -44,24 +45,36 @@ typedef struct {
     UInt8 conversion;
 } RomMapperDooly;
 
+static void mapPages(RomMapperDooly* rm)
+{
+    int i;
+
+    // The data bit conversions need the read handler
+    for (i = 0; i < 4; i++) {
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + 0x2000 * i, rm->conversion == 0, 0);
+    }
+}
+
 static void loadState(RomMapperDooly* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperDooly");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperDooly");
     rm->conversion = (UInt8)saveStateGet(state, "conversion", 0);
     saveStateClose(state);
+
+    mapPages(rm);
 }
 
 static void saveState(RomMapperDooly* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperDooly");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperDooly");
     saveStateSet(state, "conversion", rm->conversion);
     saveStateClose(state);
 }
 
 static void destroy(RomMapperDooly* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -106,25 +119,27 @@ static void write(RomMapperDooly* rm, UInt16 address, UInt8 value)
 {
     if (address != 0x7f00) {
         rm->conversion = value & 0x07;
+        mapPages(rm);
     }
 }
 
 static void reset(RomMapperDooly* rm)
 {
     rm->conversion = 0;
+    mapPages(rm);
 }
 
-int romMapperDoolyCreate(const char* filename, UInt8* romData, 
+int romMapperDoolyCreate(BoardContext* board, const char* filename, UInt8* romData, 
                          int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     RomMapperDooly* rm;
-    int i;
 
     rm = malloc(sizeof(RomMapperDooly));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_DOOLY, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, read, read, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_DOOLY, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, read, read, write, destroy, rm);
 
     if (size > 0x8000) {
         size = 0x8000;
@@ -137,10 +152,6 @@ int romMapperDoolyCreate(const char* filename, UInt8* romData,
     rm->sslot = sslot;
     rm->startPage  = startPage;
 
-    for (i = 0; i < 4; i++) {
-        slotMapPage(slot, sslot, i + startPage, NULL, 0, 0);
-    }
-
     reset(rm);
 
     return 1;
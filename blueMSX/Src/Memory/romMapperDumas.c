@@ -40,6 +40,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     AmdFlash* amdFlash;
     SL811HS*  sl811hs;
@@ -58,7 +59,7 @@ typedef struct {
 
 static void saveState(RomMapperDumas* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperDumas");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperDumas");
 
     saveStateSet(state, "romMapper", rm->romMapper);
     saveStateSet(state, "regBank", rm->regBank);
@@ -72,7 +73,7 @@ static void saveState(RomMapperDumas* rm)
 
 static void loadState(RomMapperDumas* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperDumas");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperDumas");
 
     rm->romMapper = (UInt8)saveStateGet(state, "romMapper", 0);
     rm->regBank = (UInt8)saveStateGet(state, "regBank", 0);
@@ -85,7 +86,8 @@ static void loadState(RomMapperDumas* rm)
 
     rm->flashPage = amdFlashGetPage(rm->amdFlash, rm->romMapper * 0x4000);
 
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, rm->flashPage, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 0, rm->flashPage, 1, 0);
+    slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + 1, rm->flashPage + 0x2000, 0x1ffc, 4);
 }
 
 static void destroy(RomMapperDumas* rm)
@@ -93,8 +95,8 @@ static void destroy(RomMapperDumas* rm)
     amdFlashDestroy(rm->amdFlash);
     sl811hsDestroy(rm->sl811hs);
     microwire93Cx6Destroy(rm->eeprom);
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm);
 }
@@ -109,7 +111,8 @@ static void reset(RomMapperDumas* rm)
     sl811hsReset(rm->sl811hs);
     microwire93Cx6Reset(rm->eeprom);
     rm->flashPage = amdFlashGetPage(rm->amdFlash, rm->romMapper * 0x4000);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, rm->flashPage, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 0, rm->flashPage, 1, 0);
+    slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + 1, rm->flashPage + 0x2000, 0x1ffc, 4);
 }
 
 static UInt8 read(RomMapperDumas* rm, UInt16 address) 
@@ -153,7 +156,8 @@ static void write(RomMapperDumas* rm, UInt16 address, UInt8 value)
     case 0x3ffc:
         rm->romMapper = value & 0x1f;
         rm->flashPage = amdFlashGetPage(rm->amdFlash, rm->romMapper * 0x4000);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, rm->flashPage, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 0, rm->flashPage, 1, 0);
+        slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + 1, rm->flashPage + 0x2000, 0x1ffc, 4);
         break;
     case 0x3ffd:
         rm->reg3ffd = value;
@@ -168,7 +172,7 @@ static void write(RomMapperDumas* rm, UInt16 address, UInt8 value)
     }
 }
 
-int romMapperDumasCreate(const char* filename, UInt8* romData, 
+int romMapperDumasCreate(BoardContext* board, const char* filename, UInt8* romData, 
                          int size, int slot, int sslot, int startPage,
                          UInt8* eepromData, int eepromSize) 
 {
@@ -176,24 +180,26 @@ int romMapperDumasCreate(const char* filename, UInt8* romData,
     RomMapperDumas* rm;
 
     rm = malloc(sizeof(RomMapperDumas));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_DUMAS, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, read, peek, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_DUMAS, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, read, peek, write, destroy, rm);
 
-    rm->amdFlash = amdFlashCreate(AMD_TYPE_1, 0x80000, 0x10000, 0, romData, size, sramCreateFilenameWithSuffix("dumas.rom", "", ".rom"), 0);
+    rm->amdFlash = amdFlashCreate(board, AMD_TYPE_1, 0x80000, 0x10000, 0, romData, size, sramCreateFilenameWithSuffix("dumas.rom", "", ".rom"), 0);
     rm->slot  = slot;
     rm->sslot = sslot;
     rm->startPage  = startPage;
 
     rm->sl811hs = sl811hsCreate();
-    rm->eeprom  = microwire93Cx6Create(0x400, 8, eepromData, eepromSize, sramCreateFilenameWithSuffix("dumas_eeprom.rom", "", ".rom"));
+    rm->eeprom  = microwire93Cx6Create(board, 0x400, 8, eepromData, eepromSize, sramCreateFilenameWithSuffix("dumas_eeprom.rom", "", ".rom"));
 
     rm->flashPage = amdFlashGetPage(rm->amdFlash, 0);
 
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, rm->flashPage, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, NULL, 0, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, rm->ram + 0x0000, 1, 1);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 3, rm->ram + 0x2000, 1, 1);
+    // Only the registers at 0x7ffc - 0x7fff need the read handler
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 0, rm->flashPage, 1, 0);
+    slotMapPageIo(board, rm->slot, rm->sslot, rm->startPage + 1, rm->flashPage + 0x2000, 0x1ffc, 4);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 2, rm->ram + 0x0000, 1, 1);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 3, rm->ram + 0x2000, 1, 1);
 
     reset(rm);
 
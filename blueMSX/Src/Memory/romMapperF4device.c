@@ -37,6 +37,7 @@
 #include <stdio.h>
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     int inverted;
@@ -45,7 +46,7 @@ typedef struct {
 
 static void saveState(RomMapperF4device* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperF4device");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperF4device");
 
     saveStateSet(state, "status", rm->status);
 
@@ -54,7 +55,7 @@ static void saveState(RomMapperF4device* rm)
 
 static void loadState(RomMapperF4device* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperF4device");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperF4device");
     
     rm->status = saveStateGet(state, "status", 0);
 
@@ -63,10 +64,10 @@ static void loadState(RomMapperF4device* rm)
 
 static void destroy(RomMapperF4device* rm)
 {
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
-    ioPortUnregister(0xf4);
+    ioPortUnregister(rm->board, 0xf4);
 
     free(rm);
 }
@@ -99,17 +100,19 @@ static void getDebugInfo(RomMapperF4device* rm, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 0, 0xf4, DBG_IO_READWRITE, read(rm, 0xe4));
 }
 
-int romMapperF4deviceCreate(int inverted) 
+int romMapperF4deviceCreate(BoardContext* board, int inverted) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     RomMapperF4device* rm = malloc(sizeof(RomMapperF4device));
 
+    rm->board = board;
+
     rm->inverted   = inverted;
-    rm->deviceHandle = deviceManagerRegister(inverted ? ROM_F4INVERTED : ROM_F4DEVICE, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, langDbgDevF4Device(), &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, inverted ? ROM_F4INVERTED : ROM_F4DEVICE, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, langDbgDevF4Device(), &dbgCallbacks, rm);
 
-    ioPortRegister(0xf4, read, write, rm);
+    ioPortRegister(board, 0xf4, read, write, rm);
 
     reset(rm);
 
@@ -30,6 +30,6 @@
 
 #include "MsxTypes.h"
 
-int romMapperF4deviceCreate(int inverted);
+int romMapperF4deviceCreate(BoardContext* board, int inverted);
 
 #endif
@@ -43,6 +43,7 @@
 static char pacHeader[] = "PAC2 BACKUP DATA";
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     YM_2413* ym2413;
@@ -59,9 +60,24 @@ typedef struct {
     UInt8 reg1fff;
 } RomMapperFMPAC;
 
+static void mapPages(RomMapperFMPAC* rm)
+{
+    UInt8* bankData = rm->romData + (rm->bankSelect << 14);
+
+    // Only the registers are read through the handler
+    if (rm->sramEnabled) {
+        slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage, rm->sram, 0x1ffe, 2);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 1, NULL, 0, 0);
+    }
+    else {
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage, bankData, 1, 0);
+        slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + 1, bankData + 0x2000, 0x1ff6, 2);
+    }
+}
+
 static void saveState(RomMapperFMPAC* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperFMPAC");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperFMPAC");
 
     saveStateSet(state, "bankSelect",  rm->bankSelect);
     saveStateSet(state, "enable",      rm->enable);
@@ -80,7 +96,7 @@ static void saveState(RomMapperFMPAC* rm)
 
 static void loadState(RomMapperFMPAC* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperFMPAC");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperFMPAC");
     
     rm->bankSelect  =        saveStateGet(state, "bankSelect", 0);
     rm->enable      =        saveStateGet(state, "enable", 0);
@@ -95,22 +111,24 @@ static void loadState(RomMapperFMPAC* rm)
     if (rm->ym2413 != NULL) {
         ym2413LoadState(rm->ym2413);
     }
+
+    mapPages(rm);
 }
 
 static void destroy(RomMapperFMPAC* rm)
 {
     sramSave(rm->sramFilename, rm->sram, 0x1ffe, pacHeader, strlen(pacHeader));
 
-    ioPortUnregister(0x7c);
-    ioPortUnregister(0x7d);
+    ioPortUnregister(rm->board, 0x7c);
+    ioPortUnregister(rm->board, 0x7d);
     
     if (rm->ym2413 != NULL) {
         ym2413Destroy(rm->ym2413);
     }
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
     free(rm);
 }
@@ -125,6 +143,8 @@ static void reset(RomMapperFMPAC* rm)
     rm->reg1fff    = 0xff;
     rm->enable     = 0;
     rm->bankSelect = 0;
+
+    mapPages(rm);
 }
 
 static UInt8 read(RomMapperFMPAC* rm, UInt16 address) 
@@ -167,12 +187,14 @@ static void write(RomMapperFMPAC* rm, UInt16 address, UInt8 value)
         if ((rm->enable & 0x10) == 0) {
             rm->reg1ffe = value;
             rm->sramEnabled = rm->reg1ffe == 0x4d && rm->reg1fff == 0x69;
+            mapPages(rm);
         }
         break;
     case 0x1fff:
         if ((rm->enable & 0x10) == 0) {
             rm->reg1fff = value;
             rm->sramEnabled = rm->reg1ffe == 0x4d && rm->reg1fff == 0x69;
+            mapPages(rm);
         }
         break;
 	case 0x3ff4:
@@ -191,10 +213,12 @@ static void write(RomMapperFMPAC* rm, UInt16 address, UInt8 value)
             rm->reg1ffe = 0;
             rm->reg1fff = 0;
             rm->sramEnabled = 0;
+            mapPages(rm);
         }
 		break;
 	case 0x3ff7:
         rm->bankSelect = value & 3;
+        mapPages(rm);
 		break;
 	default:
 		if (rm->sramEnabled && address < 0x1ffe) {
@@ -234,7 +258,7 @@ static void getDebugInfo(RomMapperFMPAC* rm, DbgDevice* dbgDevice)
     ym2413GetDebugInfo(rm->ym2413, dbgDevice);
 }
 
-int romMapperFMPACCreate(const char* filename, UInt8* romData, 
+int romMapperFMPACCreate(BoardContext* board, const char* filename, UInt8* romData, 
                          int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
@@ -246,17 +270,18 @@ int romMapperFMPACCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperFMPAC));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_FMPAC, &callbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_FMPAC, &callbacks, rm);
 
-    slotRegister(slot, sslot, startPage, 2, read, read, write, destroy, rm);
+    slotRegister(board, slot, sslot, startPage, 2, read, read, write, destroy, rm);
 
     rm->ym2413 = NULL;
-    if (boardGetYm2413Enable()) {
-        rm->ym2413 = ym2413Create(boardGetMixer());
-        rm->debugHandle = debugDeviceRegister(DBGTYPE_AUDIO, langDbgDevFmpac(), &dbgCallbacks, rm);
-        ioPortRegister(0x7c, NULL, writeIo, rm);
-        ioPortRegister(0x7d, NULL, writeIo, rm);
+    if (boardGetYm2413Enable(board)) {
+        rm->ym2413 = ym2413Create(board, boardGetMixer(board));
+        rm->debugHandle = debugDeviceRegister(board, DBGTYPE_AUDIO, langDbgDevFmpac(), &dbgCallbacks, rm);
+        ioPortRegister(board, 0x7c, NULL, writeIo, rm);
+        ioPortRegister(board, 0x7d, NULL, writeIo, rm);
     }
 
     memcpy(rm->romData, romData, 0x10000);
@@ -270,9 +295,6 @@ int romMapperFMPACCreate(const char* filename, UInt8* romData,
 
     sramLoad(rm->sramFilename, rm->sram, 0x1ffe, pacHeader, strlen(pacHeader));
 
-    slotMapPage(rm->slot, rm->sslot, rm->startPage,     rm->romData, 0, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, rm->romData + 0x2000, 0, 0);
-
     reset(rm);
 
     return 1;
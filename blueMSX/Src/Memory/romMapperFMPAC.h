@@ -30,7 +30,7 @@
  
 #include "MsxTypes.h"
 
-int romMapperFMPACCreate(const char* filename, UInt8* romData, 
+int romMapperFMPACCreate(BoardContext* board, const char* filename, UInt8* romData, 
                          int size, int slot, int sslot, int startPage);
 
 #endif
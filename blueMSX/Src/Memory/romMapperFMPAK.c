@@ -41,6 +41,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     YM_2413* ym2413;
@@ -77,11 +78,11 @@ static void destroy(void* arg)
 {
     RomMapperFMPAK* rm = (RomMapperFMPAK*)arg;
 
-    ioPortUnregister(0x7c);
-    ioPortUnregister(0x7d);
+    ioPortUnregister(rm->board, 0x7c);
+    ioPortUnregister(rm->board, 0x7d);
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -155,7 +156,7 @@ static void getDebugInfo(RomMapperFMPAK* rm, DbgDevice* dbgDevice)
     ym2413GetDebugInfo(rm->ym2413, dbgDevice);
 }
 
-int romMapperFMPAKCreate(const char* filename, UInt8* romData, 
+int romMapperFMPAKCreate(BoardContext* board, const char* filename, UInt8* romData, 
                          int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
@@ -169,6 +170,7 @@ int romMapperFMPAKCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperFMPAK));
+    rm->board = board;
 
     rm->romData = malloc(0x10000);
     memset(rm->romData, 0xff, 0x10000);
@@ -244,18 +246,18 @@ int romMapperFMPAKCreate(const char* filename, UInt8* romData,
     }
     
     rm->ym2413 = NULL;
-    if (boardGetYm2413Enable()) {
-        rm->ym2413 = ym2413Create(boardGetMixer());
-        rm->debugHandle = debugDeviceRegister(DBGTYPE_AUDIO, langDbgDevFmpak(), &dbgCallbacks, rm);
-        ioPortRegister(0x7c, NULL, writeIo, rm);
-        ioPortRegister(0x7d, NULL, writeIo, rm);
+    if (boardGetYm2413Enable(board)) {
+        rm->ym2413 = ym2413Create(board, boardGetMixer(board));
+        rm->debugHandle = debugDeviceRegister(board, DBGTYPE_AUDIO, langDbgDevFmpak(), &dbgCallbacks, rm);
+        ioPortRegister(board, 0x7c, NULL, writeIo, rm);
+        ioPortRegister(board, 0x7d, NULL, writeIo, rm);
     }
 
-    rm->deviceHandle = deviceManagerRegister(ROM_FMPAK, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 8, NULL, NULL, NULL, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_FMPAK, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 8, NULL, NULL, NULL, destroy, rm);
 
     for (i = 0; i < 8; i++) {
-        slotMapPage(slot, sslot, startPage + i, rm->romData + 0x2000 * romMapper[i], 1, 0);
+        slotMapPage(board, slot, sslot, startPage + i, rm->romData + 0x2000 * romMapper[i], 1, 0);
     }
 
     return 1;
@@ -34,6 +34,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -43,14 +44,14 @@ typedef struct {
 
 static void destroy(RomMapperFmDas* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
 }
 
-int romMapperFmDasCreate(const char* filename, UInt8* romData, 
+int romMapperFmDasCreate(BoardContext* board, const char* filename, UInt8* romData, 
                           int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, NULL, NULL };
@@ -61,9 +62,10 @@ int romMapperFmDasCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperFmDas));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_FMDAS, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 8, NULL, NULL, NULL, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_FMDAS, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 8, NULL, NULL, NULL, destroy, rm);
 
     rm->romData = malloc(0x8000);
     memcpy(rm->romData, romData, 0x8000);
@@ -73,14 +75,14 @@ int romMapperFmDasCreate(const char* filename, UInt8* romData,
     rm->sslot = sslot;
     rm->startPage  = startPage;
 
-    slotMapPage(slot, sslot, 0, rm->romData + 0x0000, 1, 0);
-    slotMapPage(slot, sslot, 1, rm->romData + 0x2000, 1, 1);
-    slotMapPage(slot, sslot, 2, rm->romData + 0x4000, 1, 0);
-    slotMapPage(slot, sslot, 3, rm->romData + 0x6000, 1, 0);
-    slotMapPage(slot, sslot, 4, rm->romData + 0x0000, 1, 0);
-    slotMapPage(slot, sslot, 5, rm->romData + 0x2000, 1, 1);
-    slotMapPage(slot, sslot, 6, rm->romData + 0x4000, 1, 0);
-    slotMapPage(slot, sslot, 7, rm->romData + 0x6000, 1, 0);
+    slotMapPage(board, slot, sslot, 0, rm->romData + 0x0000, 1, 0);
+    slotMapPage(board, slot, sslot, 1, rm->romData + 0x2000, 1, 1);
+    slotMapPage(board, slot, sslot, 2, rm->romData + 0x4000, 1, 0);
+    slotMapPage(board, slot, sslot, 3, rm->romData + 0x6000, 1, 0);
+    slotMapPage(board, slot, sslot, 4, rm->romData + 0x0000, 1, 0);
+    slotMapPage(board, slot, sslot, 5, rm->romData + 0x2000, 1, 1);
+    slotMapPage(board, slot, sslot, 6, rm->romData + 0x4000, 1, 0);
+    slotMapPage(board, slot, sslot, 7, rm->romData + 0x6000, 1, 0);
 
     return 1;
 }
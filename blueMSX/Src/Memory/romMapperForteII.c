@@ -36,6 +36,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int slot;
     int sslot;
@@ -45,8 +46,8 @@ typedef struct {
 
 static void destroy(RomMapperForteII* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
     free(rm);
 }
 
@@ -82,7 +83,7 @@ static UInt8 eeprom2cpu8(UInt8 v)
            (((v >>  3) & 1) <<  7);
 }
 
-int romMapperForteIICreate(const char* filename, UInt8* romData, 
+int romMapperForteIICreate(BoardContext* board, const char* filename, UInt8* romData, 
                            int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, NULL, NULL };
@@ -94,6 +95,7 @@ int romMapperForteIICreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperForteII));
+    rm->board = board;
     memset(rm->romData, 0xff, 0x10000);
     
     for (i = 0; i < size; i++) {
@@ -104,11 +106,11 @@ int romMapperForteIICreate(const char* filename, UInt8* romData,
     rm->sslot = sslot;
     rm->startPage  = startPage;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_FORTEII, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 8, NULL, NULL, NULL, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_FORTEII, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 8, NULL, NULL, NULL, destroy, rm);
 
     for (i = 0; i < 8; i++) {
-        slotMapPage(slot, sslot, startPage + i, rm->romData + 0x2000 * i, 1, 0);
+        slotMapPage(board, slot, sslot, startPage + i, rm->romData + 0x2000 * i, 1, 0);
     }
 
     return 1;
@@ -30,7 +30,7 @@
  
 #include "MsxTypes.h"
 
-int romMapperForteIICreate(const char* filename, UInt8* romData, 
+int romMapperForteIICreate(BoardContext* board, const char* filename, UInt8* romData, 
                            int size, int slot, int sslot, int startPage);
 
 #endif
@@ -41,6 +41,7 @@
 #include <time.h>
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     HarddiskIde* hdide;
@@ -51,7 +52,7 @@ typedef struct {
 
 static void saveState(RomMapperGIde* rm)
 {
-    SaveState* state = saveStateOpenForWrite("RomMapperGIde");
+    SaveState* state = saveStateOpenForWrite(rm->board, "RomMapperGIde");
 
     saveStateSet(state, "intEnable",  rm->intEnable);
     saveStateSet(state, "drvSelect",  rm->drvSelect);
@@ -64,7 +65,7 @@ static void saveState(RomMapperGIde* rm)
 
 static void loadState(RomMapperGIde* rm)
 {
-    SaveState* state = saveStateOpenForRead("RomMapperGIde");
+    SaveState* state = saveStateOpenForRead(rm->board, "RomMapperGIde");
 
     rm->intEnable  = (UInt8)saveStateGet(state, "intEnable",  0);
     rm->drvSelect  = (UInt8)saveStateGet(state, "drvSelect",  0);
@@ -79,23 +80,23 @@ static void destroy(RomMapperGIde* rm)
 {
     int portBase;
 
-    portBase = (boardGetType() == BOARD_SVI) ? 0x40:0x60;
+    portBase = (boardGetType(rm->board) == BOARD_SVI) ? 0x40:0x60;
 
-    ioPortUnregister(portBase | 0x04);
-    ioPortUnregister(portBase | 0x05);
-    ioPortUnregister(portBase | 0x06);
-    ioPortUnregister(portBase | 0x07);
-    ioPortUnregister(portBase | 0x08);
-    ioPortUnregister(portBase | 0x09);
-    ioPortUnregister(portBase | 0x0a);
-    ioPortUnregister(portBase | 0x0b);
-    ioPortUnregister(portBase | 0x0c);
-    ioPortUnregister(portBase | 0x0d);
-    ioPortUnregister(portBase | 0x0e);
-    ioPortUnregister(portBase | 0x0f);
+    ioPortUnregister(rm->board, portBase | 0x04);
+    ioPortUnregister(rm->board, portBase | 0x05);
+    ioPortUnregister(rm->board, portBase | 0x06);
+    ioPortUnregister(rm->board, portBase | 0x07);
+    ioPortUnregister(rm->board, portBase | 0x08);
+    ioPortUnregister(rm->board, portBase | 0x09);
+    ioPortUnregister(rm->board, portBase | 0x0a);
+    ioPortUnregister(rm->board, portBase | 0x0b);
+    ioPortUnregister(rm->board, portBase | 0x0c);
+    ioPortUnregister(rm->board, portBase | 0x0d);
+    ioPortUnregister(rm->board, portBase | 0x0e);
+    ioPortUnregister(rm->board, portBase | 0x0f);
 
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
     harddiskIdeDestroy(rm->hdide);
 
@@ -287,7 +288,7 @@ static void getDebugInfo(RomMapperGIde* rm, DbgDevice* dbgDevice)
     }
 }
 
-int romMapperGIdeCreate(int hdId) 
+int romMapperGIdeCreate(BoardContext* board, int hdId) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
@@ -295,26 +296,27 @@ int romMapperGIdeCreate(int hdId)
     int portBase;
 
     rm = malloc(sizeof(RomMapperGIde));
-
-    rm->deviceHandle = deviceManagerRegister(ROM_GIDE, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_PORT, langDbgDevIdeGide(), &dbgCallbacks, rm);
-
-    portBase = (boardGetType() == BOARD_SVI) ? 0x40:0x60;
-
-    ioPortRegister(portBase | 0x04, readIo, writeIo, rm);
-    ioPortRegister(portBase | 0x05, readIo, writeIo, rm);
-    ioPortRegister(portBase | 0x06, readIo, writeIo, rm);
-    ioPortRegister(portBase | 0x07, readIo, writeIo, rm);
-    ioPortRegister(portBase | 0x08, readIo, writeIo, rm);
-    ioPortRegister(portBase | 0x09, readIo, writeIo, rm);
-    ioPortRegister(portBase | 0x0a, readIo, writeIo, rm);
-    ioPortRegister(portBase | 0x0b, readIo, writeIo, rm);
-    ioPortRegister(portBase | 0x0c, readIo, writeIo, rm);
-    ioPortRegister(portBase | 0x0d, readIo, writeIo, rm);
-    ioPortRegister(portBase | 0x0e, readIo, writeIo, rm);
-    ioPortRegister(portBase | 0x0f, readIo, writeIo, rm);
-
-    rm->hdide = harddiskIdeCreate(diskGetHdDriveId(hdId, 0));
+    rm->board = board;
+
+    rm->deviceHandle = deviceManagerRegister(board, ROM_GIDE, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_PORT, langDbgDevIdeGide(), &dbgCallbacks, rm);
+
+    portBase = (boardGetType(board) == BOARD_SVI) ? 0x40:0x60;
+
+    ioPortRegister(board, portBase | 0x04, readIo, writeIo, rm);
+    ioPortRegister(board, portBase | 0x05, readIo, writeIo, rm);
+    ioPortRegister(board, portBase | 0x06, readIo, writeIo, rm);
+    ioPortRegister(board, portBase | 0x07, readIo, writeIo, rm);
+    ioPortRegister(board, portBase | 0x08, readIo, writeIo, rm);
+    ioPortRegister(board, portBase | 0x09, readIo, writeIo, rm);
+    ioPortRegister(board, portBase | 0x0a, readIo, writeIo, rm);
+    ioPortRegister(board, portBase | 0x0b, readIo, writeIo, rm);
+    ioPortRegister(board, portBase | 0x0c, readIo, writeIo, rm);
+    ioPortRegister(board, portBase | 0x0d, readIo, writeIo, rm);
+    ioPortRegister(board, portBase | 0x0e, readIo, writeIo, rm);
+    ioPortRegister(board, portBase | 0x0f, readIo, writeIo, rm);
+
+    rm->hdide = harddiskIdeCreate(board, diskGetHdDriveId(hdId, 0));
 
     reset(rm);
 
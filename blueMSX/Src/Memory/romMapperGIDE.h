@@ -30,6 +30,6 @@
  
 #include "MsxTypes.h"
 
-int romMapperGIdeCreate(int hdId);
+int romMapperGIdeCreate(BoardContext* board, int hdId);
 
 #endif
@@ -37,6 +37,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     UInt8 sram[0x4000];
@@ -52,7 +53,7 @@ typedef struct {
 
 static void saveState(RomMapperGameMaster2* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperGameMaster2");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperGameMaster2");
     char tag[16];
     int i;
 
@@ -68,7 +69,7 @@ static void saveState(RomMapperGameMaster2* rm)
 
 static void loadState(RomMapperGameMaster2* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperGameMaster2");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperGameMaster2");
     char tag[16];
     int i;
 
@@ -83,10 +84,10 @@ static void loadState(RomMapperGameMaster2* rm)
 
     for (i = 0; i < 4; i++) {   
         if (rm->sramEnabled & (1 << (i + 2))) {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->sram, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->sram, 1, 0);
         }
         else {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
         }
     }
 }
@@ -97,8 +98,8 @@ static void destroy(RomMapperGameMaster2* rm)
 
     sramSave(rm->sramFilename, rm->sram, 0x2000, NULL, 0);
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -118,11 +119,11 @@ static void write(RomMapperGameMaster2* rm, UInt16 address, UInt8 value)
         if (value & 0x10) {
             // Select SRAM startPage
             if (value & 0x20) {
-                slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, rm->sram + 0x2000, 1, 0);
+                slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, rm->sram + 0x2000, 1, 0);
                 rm->sramBank = 1;
             }
             else {
-                slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, rm->sram, 1, 0);
+                slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, rm->sram, 1, 0);
                 rm->sramBank = 0;
             }
         }
@@ -131,7 +132,7 @@ static void write(RomMapperGameMaster2* rm, UInt16 address, UInt8 value)
 
             rm->romMapper[bank] = value;
             
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, rm->romData + ((int)value << 13), 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, rm->romData + ((int)value << 13), 1, 0);
         }
     }
 
@@ -143,7 +144,7 @@ static void write(RomMapperGameMaster2* rm, UInt16 address, UInt8 value)
     }
 }
 
-int romMapperGameMaster2Create(const char* filename, UInt8* romData, 
+int romMapperGameMaster2Create(BoardContext* board, const char* filename, UInt8* romData, 
                                int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -155,9 +156,10 @@ int romMapperGameMaster2Create(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperGameMaster2));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_GAMEMASTER2, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_GAMEMASTER2, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -183,7 +185,7 @@ int romMapperGameMaster2Create(const char* filename, UInt8* romData,
     rm->romMapper[3] = 0;
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 
     return 1;
@@ -45,6 +45,7 @@ static FILE* f = NULL;
 #define CACHE_LINE_SIZE (1 << CACHE_LINE_BITS)
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     GrHandle* gameReader;
     int slot;
@@ -56,13 +57,13 @@ typedef struct {
 
 static void saveState(RomMapperGameReader* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperGameReader");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperGameReader");
     saveStateClose(state);
 }
 
 static void loadState(RomMapperGameReader* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperGameReader");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperGameReader");
     saveStateClose(state);
 }
 
@@ -71,10 +72,10 @@ static void destroy(RomMapperGameReader* rm)
 {
     if (rm->gameReader != NULL) {
         gameReaderDestroy(rm->gameReader);
-        ioPortUnregisterUnused(rm->cartSlot);
-        slotUnregister(rm->slot, rm->sslot, 0);
+        ioPortUnregisterUnused(rm->board, rm->cartSlot);
+        slotUnregister(rm->board, rm->slot, rm->sslot, 0);
     }
-    deviceManagerUnregister(rm->deviceHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
 //    fclose(f);
     f = NULL;
@@ -165,15 +166,16 @@ static void write(RomMapperGameReader* rm, UInt16 address, UInt8 value)
 #endif
 }
 
-int romMapperGameReaderCreate(int cartSlot, int slot, int sslot) 
+int romMapperGameReaderCreate(BoardContext* board, int cartSlot, int slot, int sslot) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
     RomMapperGameReader* rm;
     int i;
 
     rm = malloc(sizeof(RomMapperGameReader));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_GAMEREADER, &callbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_GAMEREADER, &callbacks, rm);
 
     rm->slot     = slot;
     rm->sslot    = sslot;
@@ -187,10 +189,10 @@ int romMapperGameReaderCreate(int cartSlot, int slot, int sslot)
     }
 
     if (rm->gameReader != NULL) {
-        ioPortRegisterUnused(cartSlot, readIo, writeIo, rm);
-        slotRegister(slot, sslot, 0, 8, read, read, write, destroy, rm);
+        ioPortRegisterUnused(board, cartSlot, readIo, writeIo, rm);
+        slotRegister(board, slot, sslot, 0, 8, read, read, write, destroy, rm);
         for (i = 0; i < 8; i++) {   
-            slotMapPage(rm->slot, rm->sslot, i, NULL, 0, 0);
+            slotMapPage(board, rm->slot, rm->sslot, i, NULL, 0, 0);
         }
     }
 
@@ -251,6 +253,7 @@ typedef struct {
 } MapperList;
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     GrHandle* gameReader;
     int slot;
@@ -263,13 +266,13 @@ typedef struct {
 
 static void saveState(RomMapperGameReader* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperGameReader");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperGameReader");
     saveStateClose(state);
 }
 
 static void loadState(RomMapperGameReader* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperGameReader");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperGameReader");
     saveStateClose(state);
 }
 
@@ -278,10 +281,10 @@ static void destroy(RomMapperGameReader* rm)
 {
     if (rm->gameReader != NULL) {
         gameReaderDestroy(rm->gameReader);
-        ioPortUnregisterUnused(rm->cartSlot);
-        slotUnregister(rm->slot, rm->sslot, 0);
+        ioPortUnregisterUnused(rm->board, rm->cartSlot);
+        slotUnregister(rm->board, rm->slot, rm->sslot, 0);
     }
-    deviceManagerUnregister(rm->deviceHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
 	// TODO: clear mapperList!
 
@@ -461,15 +464,16 @@ static void write(RomMapperGameReader* rm, UInt16 address, UInt8 value)
 	return;
 }
 
-int romMapperGameReaderCreate(int cartSlot, int slot, int sslot) 
+int romMapperGameReaderCreate(BoardContext* board, int cartSlot, int slot, int sslot) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
     RomMapperGameReader* rm;
     int i;
 
     rm = malloc(sizeof(RomMapperGameReader));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_GAMEREADER, &callbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_GAMEREADER, &callbacks, rm);
 
     rm->slot     = slot;
     rm->sslot    = sslot;
@@ -486,10 +490,10 @@ int romMapperGameReaderCreate(int cartSlot, int slot, int sslot)
     }
 
     if (rm->gameReader != NULL) {
-        ioPortRegisterUnused(cartSlot, readIo, writeIo, rm);
-        slotRegister(slot, sslot, 0, 8, read, read, write, destroy, rm);
+        ioPortRegisterUnused(board, cartSlot, readIo, writeIo, rm);
+        slotRegister(board, slot, sslot, 0, 8, read, read, write, destroy, rm);
         for (i = 0; i < 8; i++) {   
-            slotMapPage(rm->slot, rm->sslot, i, NULL, 0, 0);
+            slotMapPage(board, rm->slot, rm->sslot, i, NULL, 0, 0);
         }
     }
 
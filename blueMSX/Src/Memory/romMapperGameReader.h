@@ -30,6 +30,6 @@
  
 #include "MsxTypes.h"
 
-int romMapperGameReaderCreate(int cartSlot, int slot, int sslot);
+int romMapperGameReaderCreate(BoardContext* board, int cartSlot, int slot, int sslot);
 
 #endif
@@ -41,6 +41,7 @@
 #define PORT_BASE   0x34
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     UInt8* romData;
@@ -89,20 +90,20 @@ static void reset(RomMapperGoudaSCSI* rm)
 
 static void destroy(RomMapperGoudaSCSI* rm)
 {
-    ioPortUnregister(PORT_BASE + 0);
-    ioPortUnregister(PORT_BASE + 1);
-    ioPortUnregister(PORT_BASE + 2);
+    ioPortUnregister(rm->board, PORT_BASE + 0);
+    ioPortUnregister(rm->board, PORT_BASE + 1);
+    ioPortUnregister(rm->board, PORT_BASE + 2);
 
-    debugDeviceUnregister(rm->debugHandle);
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     wd33c93Destroy(rm->wd33c93);
     free(rm->romData);
     free(rm);
 }
 
-int romMapperGoudaSCSICreate(int hdId, const char* filename, UInt8* romData,
+int romMapperGoudaSCSICreate(BoardContext* board, int hdId, const char* filename, UInt8* romData,
                           int size, int slot, int sslot, int startPage)
 {
     DeviceCallbacks callbacks = {
@@ -125,10 +126,11 @@ int romMapperGoudaSCSICreate(int hdId, const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperGoudaSCSI));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_GOUDASCSI, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 2, NULL, NULL, NULL, (SlotEject)destroy, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_PORT, langDbgDevScsiGouda(), &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_GOUDASCSI, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 2, NULL, NULL, NULL, (SlotEject)destroy, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_PORT, langDbgDevScsiGouda(), &dbgCallbacks, rm);
 
     rm->romData = malloc(0x4000);
     if (romData != NULL) {
@@ -162,14 +164,14 @@ int romMapperGoudaSCSICreate(int hdId, const char* filename, UInt8* romData,
     rm->slot  = slot;
     rm->sslot = sslot;
     rm->startPage  = startPage;
-    rm->wd33c93 = wd33c93Create(hdId);
+    rm->wd33c93 = wd33c93Create(board, hdId);
 
-    slotMapPage(slot, sslot, startPage    , rm->romData         , 1, 0);
-    slotMapPage(slot, sslot, startPage + 1, rm->romData + 0x2000, 1, 0);
+    slotMapPage(board, slot, sslot, startPage    , rm->romData         , 1, 0);
+    slotMapPage(board, slot, sslot, startPage + 1, rm->romData + 0x2000, 1, 0);
 
-    ioPortRegister(PORT_BASE + 0, (IoPortRead)wd33c93ReadAuxStatus, (IoPortWrite)wd33c93WriteAdr, rm->wd33c93);
-    ioPortRegister(PORT_BASE + 1, (IoPortRead)wd33c93ReadCtrl, (IoPortWrite)wd33c93WriteCtrl, rm->wd33c93);
-    ioPortRegister(PORT_BASE + 2, (IoPortRead)dummy, (IoPortWrite)sbicReset, rm);
+    ioPortRegister(board, PORT_BASE + 0, (IoPortRead)wd33c93ReadAuxStatus, (IoPortWrite)wd33c93WriteAdr, rm->wd33c93);
+    ioPortRegister(board, PORT_BASE + 1, (IoPortRead)wd33c93ReadCtrl, (IoPortWrite)wd33c93WriteCtrl, rm->wd33c93);
+    ioPortRegister(board, PORT_BASE + 2, (IoPortRead)dummy, (IoPortWrite)sbicReset, rm);
 
     return 1;
 }
@@ -37,6 +37,7 @@
 #include <stdio.h>
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -53,7 +54,7 @@ typedef struct {
 
 static void saveState(RomMapperHalnote* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperHalnote");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperHalnote");
     char tag[16];
     int i;
 
@@ -70,10 +71,9 @@ static void saveState(RomMapperHalnote* rm)
 
 static void loadState(RomMapperHalnote* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperHalnote");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperHalnote");
     char tag[16];
     int i;
-    int readMode;
 
     for (i = 0; i < 6; i++) {
         sprintf(tag, "romMapper%d", i);
@@ -87,20 +87,21 @@ static void loadState(RomMapperHalnote* rm)
 
 
     for (i = 0; i < 4; i++) {
-        readMode = 1;
         if (i == 1 && rm->subMapperEnabled) {
-            readMode = 0;
+            slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + 2 + i, rm->romData + rm->romMapper[i] * 0x2000, 0x1000, 0x1000);
+        }
+        else {
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 2 + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
         }
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 2 + i, rm->romData + rm->romMapper[i] * 0x2000, readMode, 0);
     }
 
     if (rm->sramEnabled) {
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, rm->sramData,          1, 1);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, rm->sramData + 0x2000, 1, 1);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 0, rm->sramData,          1, 1);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 1, rm->sramData + 0x2000, 1, 1);
     }
     else {
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, NULL, 0, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, NULL, 0, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 0, NULL, 0, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 1, NULL, 0, 0);
     }
     
 }
@@ -109,8 +110,8 @@ static void destroy(RomMapperHalnote* rm)
 {
     sramSave(rm->sramFilename, rm->sramData, 0x4000, NULL, 0);
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm->sramData);
@@ -161,15 +162,15 @@ static void write(RomMapperHalnote* rm, UInt16 address, UInt8 value)
     if (bank == 0) {
         if (mapperMode) {
             if (rm->sramEnabled == 0) {
-                slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, rm->sramData,          1, 1);
-                slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, rm->sramData + 0x2000, 1, 1);
+                slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 0, rm->sramData,          1, 1);
+                slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 1, rm->sramData + 0x2000, 1, 1);
                 rm->sramEnabled = 1;
             }
         }
         else {
             if (rm->sramEnabled) {
-                slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, NULL, 0, 0);
-                slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, NULL, 0, 0);
+                slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 0, NULL, 0, 0);
+                slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 1, NULL, 0, 0);
                 rm->sramEnabled = 0;
             }
         }
@@ -192,11 +193,18 @@ static void write(RomMapperHalnote* rm, UInt16 address, UInt8 value)
         UInt8* bankData = rm->romData + ((int)value << 13);
 
         rm->romMapper[bank] = value;
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank + 2, bankData, readMode, 0);
+
+        // Only the 2 kB sub banks at 0x7000 - 0x7fff need the read handler
+        if (readMode) {
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank + 2, bankData, 1, 0);
+        }
+        else {
+            slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + bank + 2, bankData, 0x1000, 0x1000);
+        }
     }
 }
 
-int romMapperHalnoteCreate(const char* filename, UInt8* romData, 
+int romMapperHalnoteCreate(BoardContext* board, const char* filename, UInt8* romData, 
                           int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -208,9 +216,10 @@ int romMapperHalnoteCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperHalnote));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_HALNOTE, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 6, read, read, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_HALNOTE, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 6, read, read, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -229,11 +238,11 @@ int romMapperHalnoteCreate(const char* filename, UInt8* romData,
         rm->romMapper[i] = 0;
     }
 
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, NULL, 0, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, NULL, 0, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 0, NULL, 0, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 1, NULL, 0, 0);
 
     for (i = 0; i < 4; i++) {
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 2, rm->romData, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i + 2, rm->romData, 1, 0);
     }
 
     return 1;
@@ -36,6 +36,7 @@
  
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -47,7 +48,7 @@ typedef struct {
 
 static void saveState(RomMapperHarryFox* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperHarryFox");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperHarryFox");
     char tag[16];
     int i;
 
@@ -61,7 +62,7 @@ static void saveState(RomMapperHarryFox* rm)
 
 static void loadState(RomMapperHarryFox* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperHarryFox");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperHarryFox");
     char tag[16];
     int i;
 
@@ -74,15 +75,15 @@ static void loadState(RomMapperHarryFox* rm)
 
     for (i = 0; i < 4; i += 2) {
         UInt8* bankData = rm->romData + (rm->romMapper[i] << 14);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i,     bankData, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 1, bankData + 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i,     bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i + 1, bankData + 0x2000, 1, 0);
     }
 }
 
 static void destroy(RomMapperHarryFox* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -107,12 +108,12 @@ static void write(RomMapperHarryFox* rm, UInt16 address, UInt8 value)
         
         rm->romMapper[bank] = value;
 
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank,     bankData, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank + 1, bankData + 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank,     bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank + 1, bankData + 0x2000, 1, 0);
     }
 }
 
-int romMapperHarryFoxCreate(const char* filename, UInt8* romData, 
+int romMapperHarryFoxCreate(BoardContext* board, const char* filename, UInt8* romData, 
                             int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -124,9 +125,10 @@ int romMapperHarryFoxCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperHarryFox));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_HARRYFOX, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_HARRYFOX, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -139,8 +141,8 @@ int romMapperHarryFoxCreate(const char* filename, UInt8* romData,
     rm->romMapper[2] = 2;
 
     for (i = 0; i < 4; i += 2) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i,     rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 1, rm->romData + rm->romMapper[i] * 0x2000 + 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i,     rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i + 1, rm->romData + rm->romMapper[i] * 0x2000 + 0x2000, 1, 0);
     }
 
     return 1;
@@ -36,6 +36,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -47,7 +48,7 @@ typedef struct {
 
 static void saveState(RomMapperHolyQuran* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperHolyQuran");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperHolyQuran");
     char tag[16];
     int i;
 
@@ -61,7 +62,7 @@ static void saveState(RomMapperHolyQuran* rm)
 
 static void loadState(RomMapperHolyQuran* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperHolyQuran");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperHolyQuran");
     char tag[16];
     int i;
 
@@ -73,14 +74,14 @@ static void loadState(RomMapperHolyQuran* rm)
     saveStateClose(state);
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 }
 
 static void destroy(RomMapperHolyQuran* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -103,11 +104,11 @@ static void write(RomMapperHolyQuran* rm, UInt16 address, UInt8 value)
 
         rm->romMapper[bank] = value;
         
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
     }
 }
 
-int romMapperHolyQuranCreate(const char* filename, UInt8* romData, 
+int romMapperHolyQuranCreate(BoardContext* board, const char* filename, UInt8* romData, 
                            int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -119,9 +120,10 @@ int romMapperHolyQuranCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperHolyQuran));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_HOLYQURAN, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_HOLYQURAN, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -136,7 +138,7 @@ int romMapperHolyQuranCreate(const char* filename, UInt8* romData,
     rm->romMapper[3] = 0;
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 
     return 1;
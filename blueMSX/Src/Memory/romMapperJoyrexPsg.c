@@ -38,6 +38,7 @@
 #include <stdio.h>
 
 typedef struct {
+    BoardContext* board;
     SN76489* sn76489;
     int    deviceHandle;
     int    debugHandle;
@@ -55,11 +56,11 @@ static void loadState(RomMapperJoyrexPsg* rm)
 
 static void destroy(RomMapperJoyrexPsg* rm)
 {
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
     sn76489Destroy(rm->sn76489);
 
-    ioPortUnregister(0xf0);
+    ioPortUnregister(rm->board, 0xf0);
 
     free(rm);
 }
@@ -88,18 +89,20 @@ static void getDebugInfo(RomMapperJoyrexPsg* rm, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 0, 0xf0, DBG_IO_READWRITE, peek(rm, 0xf0));
 }
 
-int romMapperJoyrexPsgCreate() 
+int romMapperJoyrexPsgCreate(BoardContext* board) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     RomMapperJoyrexPsg* rm = malloc(sizeof(RomMapperJoyrexPsg));
 
-    rm->deviceHandle = deviceManagerRegister(ROM_JOYREXPSG, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_AUDIO, "SN76489", &dbgCallbacks, rm);
+    rm->board = board;
 
-    rm->sn76489 = sn76489Create(boardGetMixer());
+    rm->deviceHandle = deviceManagerRegister(board, ROM_JOYREXPSG, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_AUDIO, "SN76489", &dbgCallbacks, rm);
 
-    ioPortRegister(0xf0, NULL, write, rm);
+    rm->sn76489 = sn76489Create(board, boardGetMixer(board));
+
+    ioPortRegister(board, 0xf0, NULL, write, rm);
 
     reset(rm);
 
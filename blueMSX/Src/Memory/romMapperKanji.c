@@ -38,6 +38,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     UInt8* romData;
     int deviceHandle;
     int debugHandle;
@@ -47,7 +48,7 @@ typedef struct {
 
 static void saveState(RomMapperKanji* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperKanji");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperKanji");
 
     saveStateSet(state, "address0", rm->address[0]);
     saveStateSet(state, "address1", rm->address[1]);
@@ -57,7 +58,7 @@ static void saveState(RomMapperKanji* rm)
 
 static void loadState(RomMapperKanji* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperKanji");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperKanji");
 
     rm->address[0] = saveStateGet(state, "address0", 0);
     rm->address[1] = saveStateGet(state, "address1", 0);
@@ -67,13 +68,13 @@ static void loadState(RomMapperKanji* rm)
 
 static void destroy(RomMapperKanji* rm)
 {
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
-    ioPortUnregister(0xd9);
-    ioPortUnregister(0xd8);
-    ioPortUnregister(0xda);
-    ioPortUnregister(0xdb);
+    ioPortUnregister(rm->board, 0xd9);
+    ioPortUnregister(rm->board, 0xd8);
+    ioPortUnregister(rm->board, 0xda);
+    ioPortUnregister(rm->board, 0xdb);
 
     free(rm->romData);
     free(rm);
@@ -138,7 +139,7 @@ static void getDebugInfo(RomMapperKanji* rm, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 3, 0xdb, DBG_IO_READWRITE, peek(rm, 0xdb));
 }
 
-int romMapperKanjiCreate(UInt8* romData, int size) 
+int romMapperKanjiCreate(BoardContext* board, UInt8* romData, int size) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
@@ -149,21 +150,22 @@ int romMapperKanjiCreate(UInt8* romData, int size)
     }
 
     rm = malloc(sizeof(RomMapperKanji));
+    rm->board = board;
 
     rm->size = size;
     rm->address[0] = 0;
     rm->address[1] = 0x20000;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_KANJI, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, langDbgDevKanji(), &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_KANJI, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, langDbgDevKanji(), &dbgCallbacks, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
     
-    ioPortRegister(0xd8, NULL, write, rm);
-    ioPortRegister(0xd9, read, write, rm);
-    ioPortRegister(0xda, NULL, write, rm);
-    ioPortRegister(0xdb, read, write, rm);
+    ioPortRegister(board, 0xd8, NULL, write, rm);
+    ioPortRegister(board, 0xd9, read, write, rm);
+    ioPortRegister(board, 0xda, NULL, write, rm);
+    ioPortRegister(board, 0xdb, read, write, rm);
 
     return 1;
 }
@@ -30,6 +30,6 @@
 
 #include "MsxTypes.h"
 
-int romMapperKanjiCreate(UInt8* romData, int size);
+int romMapperKanjiCreate(BoardContext* board, UInt8* romData, int size);
 
 #endif
@@ -38,6 +38,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     UInt8* romData;
     int deviceHandle;
     int debugHandle;
@@ -47,7 +48,7 @@ typedef struct {
 
 static void saveState(RomMapperKanji12* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperKanji12");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperKanji12");
 
     saveStateSet(state, "address", rm->address);
     
@@ -56,7 +57,7 @@ static void saveState(RomMapperKanji12* rm)
 
 static void loadState(RomMapperKanji12* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperKanji12");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperKanji12");
 
     rm->address = saveStateGet(state, "address", 0);
 
@@ -65,13 +66,13 @@ static void loadState(RomMapperKanji12* rm)
 
 static void destroy(RomMapperKanji12* rm)
 {
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
-    ioPortUnregister(0xd9);
-    ioPortUnregister(0xd8);
-    ioPortUnregister(0xda);
-    ioPortUnregister(0xdb);
+    ioPortUnregister(rm->board, 0xd9);
+    ioPortUnregister(rm->board, 0xd8);
+    ioPortUnregister(rm->board, 0xda);
+    ioPortUnregister(rm->board, 0xdb);
 
     free(rm->romData);
     free(rm);
@@ -138,7 +139,7 @@ static void write(RomMapperKanji12* rm, UInt16 ioPort, UInt8 value)
 
 static void getDebugInfo(RomMapperKanji12* rm, DbgDevice* dbgDevice)
 {
-    if (ioPortCheckSub(0xf7)) {
+    if (ioPortCheckSub(rm->board, 0xf7)) {
         DbgIoPorts* ioPorts;
         int i;
 
@@ -150,7 +151,7 @@ static void getDebugInfo(RomMapperKanji12* rm, DbgDevice* dbgDevice)
     }
 }
 
-int romMapperKanji12Create(UInt8* romData, int size) 
+int romMapperKanji12Create(BoardContext* board, UInt8* romData, int size) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
@@ -161,17 +162,18 @@ int romMapperKanji12Create(UInt8* romData, int size)
     }
 
     rm = malloc(sizeof(RomMapperKanji12));
+    rm->board = board;
 
     rm->size = size;
     rm->address = 0;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_KANJI12, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_CART, langDbgDevKanji12(), &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_KANJI12, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_CART, langDbgDevKanji12(), &dbgCallbacks, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
     
-    ioPortRegisterSub(0xf7, read, write, rm);
+    ioPortRegisterSub(board, 0xf7, read, write, rm);
 
     return 1;
 }
@@ -30,6 +30,6 @@
 
 #include "MsxTypes.h"
 
-int romMapperKanji12Create(UInt8* romData, int size);
+int romMapperKanji12Create(BoardContext* board, UInt8* romData, int size);
 
 #endif
@@ -67,6 +67,7 @@
 #define SRAM_PAGES 4
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     UInt8 sram[SRAM_PAGES << 13];
@@ -81,7 +82,7 @@ typedef struct {
 
 static void saveState(RomMapperKoei* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperKoei");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperKoei");
     char tag[16];
     int i;
 
@@ -97,7 +98,7 @@ static void saveState(RomMapperKoei* rm)
 
 static void loadState(RomMapperKoei* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperKoei");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperKoei");
     char tag[16];
     int i;
 
@@ -112,10 +113,10 @@ static void loadState(RomMapperKoei* rm)
 
     for (i = 0; i < 4; i++) {   
         if (rm->sramEnabled & (1 << i)) {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->sram + (rm->romMapper[i] & (SRAM_PAGES - 1)) * 0x2000, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->sram + (rm->romMapper[i] & (SRAM_PAGES - 1)) * 0x2000, 1, 0);
         }
         else {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
         }
     }
 }
@@ -124,8 +125,8 @@ static void destroy(RomMapperKoei* rm)
 {
     sramSave(rm->sramFilename, rm->sram, SRAM_PAGES << 13, NULL, 0);
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -151,11 +152,11 @@ static void write(RomMapperKoei* rm, UInt16 address, UInt8 value)
         }
 
         rm->romMapper[bank] = value;
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, writeCache);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, writeCache);
     }
 }
 
-int romMapperKoeiCreate(const char* filename, UInt8* romData, 
+int romMapperKoeiCreate(BoardContext* board, const char* filename, UInt8* romData, 
                         int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -167,9 +168,10 @@ int romMapperKoeiCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperKoei));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_KOEI, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_KOEI, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -189,7 +191,7 @@ int romMapperKoeiCreate(const char* filename, UInt8* romData,
     rm->romMapper[3] = 0;
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 
     return 1;
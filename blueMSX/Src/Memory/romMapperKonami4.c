@@ -36,6 +36,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -47,7 +48,7 @@ typedef struct {
 
 static void saveState(RomMapperKonami4* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperKonami4");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperKonami4");
     char tag[16];
     int i;
 
@@ -61,7 +62,7 @@ static void saveState(RomMapperKonami4* rm)
 
 static void loadState(RomMapperKonami4* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperKonami4");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperKonami4");
     char tag[16];
     int i;
 
@@ -73,14 +74,14 @@ static void loadState(RomMapperKonami4* rm)
     saveStateClose(state);
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 }
 
 static void destroy(RomMapperKonami4* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -105,11 +106,11 @@ static void write(RomMapperKonami4* rm, UInt16 address, UInt8 value)
 
         rm->romMapper[bank] = value;
         
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
     }
 }
 
-int romMapperKonami4Create(const char* filename, UInt8* romData, 
+int romMapperKonami4Create(BoardContext* board, const char* filename, UInt8* romData, 
                            int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -122,9 +123,10 @@ int romMapperKonami4Create(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperKonami4));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_KONAMI4, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_KONAMI4, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     romSize = size > 0x40000 ? size : 0x40000;
     rm->romData = malloc(romSize);
@@ -145,7 +147,7 @@ int romMapperKonami4Create(const char* filename, UInt8* romData,
     rm->romMapper[3] = 3;
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 
     return 1;
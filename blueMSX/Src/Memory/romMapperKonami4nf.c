@@ -40,6 +40,7 @@
  
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -51,7 +52,7 @@ typedef struct {
 
 static void saveState(RomMapperKonami4nf* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperKonami4nf");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperKonami4nf");
     char tag[16];
     int i;
 
@@ -65,7 +66,7 @@ static void saveState(RomMapperKonami4nf* rm)
 
 static void loadState(RomMapperKonami4nf* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperKonami4nf");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperKonami4nf");
     char tag[16];
     int i;
 
@@ -77,14 +78,14 @@ static void loadState(RomMapperKonami4nf* rm)
     saveStateClose(state);
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 }
 
 static void destroy(RomMapperKonami4nf* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -104,11 +105,11 @@ static void write(RomMapperKonami4nf* rm, UInt16 address, UInt8 value)
 
         rm->romMapper[bank] = value;
         
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
     }
 }
 
-int romMapperKonami4nfCreate(const char* filename, UInt8* romData, 
+int romMapperKonami4nfCreate(BoardContext* board, const char* filename, UInt8* romData, 
                              int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -120,9 +121,10 @@ int romMapperKonami4nfCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperKonami4nf));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_KONAMI4NF, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_KONAMI4NF, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -137,7 +139,7 @@ int romMapperKonami4nfCreate(const char* filename, UInt8* romData,
     rm->romMapper[3] = 3;
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 
     return 1;
@@ -37,6 +37,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -50,7 +51,7 @@ typedef struct {
 
 static void saveState(RomMapperKonami5* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperKonami5");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperKonami5");
     char tag[16];
     int i;
 
@@ -68,7 +69,7 @@ static void saveState(RomMapperKonami5* rm)
 
 static void loadState(RomMapperKonami5* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperKonami5");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperKonami5");
     char tag[16];
     int i;
 
@@ -84,21 +85,22 @@ static void loadState(RomMapperKonami5* rm)
     sccLoadState(rm->scc);
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
     
+    // Only the SCC registers at 0x9800 - 0x9fff need the read handler
     if (rm->sccEnable) {
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, rm->romData + rm->romMapper[2] * 0x2000, 0, 0);
+        slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + 2, rm->romData + rm->romMapper[2] * 0x2000, 0x1800, 0x800);
     }
     else {
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, rm->romData + rm->romMapper[2] * 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 2, rm->romData + rm->romMapper[2] * 0x2000, 1, 0);
     }
 }
 
 static void destroy(RomMapperKonami5* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
     sccDestroy(rm->scc);
 
     free(rm->romData);
@@ -165,15 +167,15 @@ static void write(RomMapperKonami5* rm, UInt16 address, UInt8 value)
         rm->romMapper[bank] = value;
         
         if (bank == 2 && rm->sccEnable) {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, rm->romData + rm->romMapper[2] * 0x2000, 0, 0);
+            slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + 2, rm->romData + rm->romMapper[2] * 0x2000, 0x1800, 0x800);
         }
         else {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
         }
     }
 }
 
-int romMapperKonami5Create(const char* filename, UInt8* romData, 
+int romMapperKonami5Create(BoardContext* board, const char* filename, UInt8* romData, 
                            int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
@@ -189,9 +191,10 @@ int romMapperKonami5Create(const char* filename, UInt8* romData,
 
 
     rm = malloc(sizeof(RomMapperKonami5));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_KONAMI5, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, read, peek, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_KONAMI5, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, read, peek, write, destroy, rm);
 
     rm->romData = calloc(1, size);
     memcpy(rm->romData, romData, origSize);
@@ -199,7 +202,7 @@ int romMapperKonami5Create(const char* filename, UInt8* romData,
     rm->slot  = slot;
     rm->sslot = sslot;
     rm->startPage  = startPage;
-    rm->scc = sccCreate(boardGetMixer());
+    rm->scc = sccCreate(board, boardGetMixer(board));
     sccSetMode(rm->scc, SCC_REAL);
     rm->sccEnable = 0;
 
@@ -209,7 +212,7 @@ int romMapperKonami5Create(const char* filename, UInt8* romData,
     rm->romMapper[3] = 3;
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 
     return 1;
@@ -30,7 +30,7 @@
  
 #include "MsxTypes.h"
 
-int romMapperKonami5Create(const char* filename, UInt8* romData, 
+int romMapperKonami5Create(BoardContext* board, const char* filename, UInt8* romData, 
                            int size, int slot, int sslot, int startPage);
 
 #endif
@@ -42,6 +42,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
 
@@ -55,7 +56,7 @@ typedef struct {
 
 static void saveState(RomMapperKonamiKeyboardMaster* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperKonamiKbdMaster");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperKonamiKbdMaster");
     
     saveStateClose(state);
     
@@ -64,7 +65,7 @@ static void saveState(RomMapperKonamiKeyboardMaster* rm)
 
 static void loadState(RomMapperKonamiKeyboardMaster* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperKonamiKbdMaster");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperKonamiKbdMaster");
 
     saveStateClose(state);
     
@@ -73,12 +74,12 @@ static void loadState(RomMapperKonamiKeyboardMaster* rm)
 
 static void destroy(RomMapperKonamiKeyboardMaster* rm)
 {
-    ioPortUnregister(0x00);
-    ioPortUnregister(0x20);
+    ioPortUnregister(rm->board, 0x00);
+    ioPortUnregister(rm->board, 0x20);
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
     vlm5030Destroy(rm->vlm5030);
 
     free(rm->romData);
@@ -119,7 +120,7 @@ static void getDebugInfo(RomMapperKonamiKeyboardMaster* rm, DbgDevice* dbgDevice
     dbgIoPortsAddPort(ioPorts, 1, 0x20, DBG_IO_READWRITE, read(rm, 0x20));
 }
 
-int romMapperKonamiKeyboardMasterCreate(const char* filename, UInt8* romData, 
+int romMapperKonamiKeyboardMasterCreate(BoardContext* board, const char* filename, UInt8* romData, 
                                         int size, int slot, int sslot, 
                                         int startPage,
                                        void* voiceRom, int voiceSize) 
@@ -134,11 +135,12 @@ int romMapperKonamiKeyboardMasterCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperKonamiKeyboardMaster));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_KONAMKBDMAS, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_CART, langDbgDevKonamiKbd(), &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_KONAMKBDMAS, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_CART, langDbgDevKonamiKbd(), &dbgCallbacks, rm);
 
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, NULL, destroy, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, NULL, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -154,17 +156,17 @@ int romMapperKonamiKeyboardMasterCreate(const char* filename, UInt8* romData,
         memcpy(rm->voiceData, voiceData, 0x4000);
     }
 
-    rm->vlm5030 = vlm5030Create(boardGetMixer(), rm->voiceData, 0x4000);
+    rm->vlm5030 = vlm5030Create(board, boardGetMixer(board), rm->voiceData, 0x4000);
     rm->slot  = slot;
     rm->sslot = sslot;
     rm->startPage  = startPage;
 
     for (i = 0; i < 2; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + i * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + i * 0x2000, 1, 0);
     }
 
-    ioPortRegister(0x00, read, write, rm);
-    ioPortRegister(0x20, read, write, rm);
+    ioPortRegister(board, 0x00, read, write, rm);
+    ioPortRegister(board, 0x20, read, write, rm);
 
     return 1;
 }
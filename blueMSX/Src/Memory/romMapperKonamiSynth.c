@@ -38,6 +38,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
 	DAC* dac;
@@ -48,8 +49,8 @@ typedef struct {
 
 static void destroy(RomMapperKonamiSynth* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
     dacDestroy(rm->dac);
 
     free(rm->romData);
@@ -65,7 +66,7 @@ static void write(RomMapperKonamiSynth* rm, UInt16 address, UInt8 value)
 	}
 }
 
-int romMapperKonamiSynthCreate(const char* filename, UInt8* romData, 
+int romMapperKonamiSynthCreate(BoardContext* board, const char* filename, UInt8* romData, 
                                int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, NULL, NULL };
@@ -77,19 +78,20 @@ int romMapperKonamiSynthCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperKonamiSynth));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_KONAMISYNTH, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_KONAMISYNTH, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
-    rm->dac   = dacCreate(boardGetMixer(), DAC_MONO);
+    rm->dac   = dacCreate(boardGetMixer(board), DAC_MONO);
     rm->slot  = slot;
     rm->sslot = sslot;
     rm->startPage  = startPage;
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + i * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + i * 0x2000, 1, 0);
     }
 
     return 1;
@@ -36,6 +36,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -46,20 +47,20 @@ typedef struct {
 
 static void saveState(RomMapperKonamiWordPro* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperKonamiWordPro");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperKonamiWordPro");
     saveStateClose(state);
 }
 
 static void loadState(RomMapperKonamiWordPro* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperKonamiWordPro");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperKonamiWordPro");
     saveStateClose(state);
 }
 
 static void destroy(RomMapperKonamiWordPro* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -68,7 +69,7 @@ static void destroy(RomMapperKonamiWordPro* rm)
 static UInt8 read(RomMapperKonamiWordPro* rm, UInt16 address)
 {
 #if 0
-    if (address < getPC() - 2 || address > getPC() + 4) {
+    if (address < getPC(rm->board) - 2 || address > getPC(rm->board) + 4) {
         printf("R %.4x :\n", address);
     }
     if (rm->control == 0xdb && address < 0x8000) {
@@ -97,7 +98,7 @@ static void reset(RomMapperKonamiWordPro* rm)
     rm->control = 0xff;
 }
 
-int romMapperKonamiWordProCreate(const char* filename, UInt8* romData, 
+int romMapperKonamiWordProCreate(BoardContext* board, const char* filename, UInt8* romData, 
                           int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
@@ -110,12 +111,13 @@ int romMapperKonamiWordProCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperKonamiWordPro));
+    rm->board = board;
 
     if (pages == 8)
         startPage = 0;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_KONWORDPRO, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, pages, read, read, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_KONWORDPRO, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, pages, read, read, write, destroy, rm);
 
     rm->romData = calloc(1, size);
     memcpy(rm->romData, romData, size);
@@ -123,8 +125,14 @@ int romMapperKonamiWordProCreate(const char* filename, UInt8* romData,
     rm->sslot = sslot;
     rm->startPage  = startPage;
 
+    // The ROM at 0x4000 - 0xbfff needs no read handler
     for (i = 0; i < pages; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + i * 0x2000, 0, 0);
+        if (i >= 2 && i < 6) {
+            slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + (i - 2) * 0x2000, 1, 0);
+        }
+        else {
+            slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, NULL, 0, 0);
+        }
     }
 
     reset(rm);
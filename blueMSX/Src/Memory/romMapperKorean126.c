@@ -36,6 +36,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -47,7 +48,7 @@ typedef struct {
 
 static void saveState(RomMapperKorean126* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperKorean126");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperKorean126");
     char tag[16];
     int i;
 
@@ -61,7 +62,7 @@ static void saveState(RomMapperKorean126* rm)
 
 static void loadState(RomMapperKorean126* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperKorean126");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperKorean126");
     char tag[16];
     int i;
 
@@ -74,15 +75,15 @@ static void loadState(RomMapperKorean126* rm)
 
     for (i = 0; i < 4; i += 2) {
         UInt8* bankData = rm->romData + (rm->romMapper[i] << 14);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i,     bankData, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 1, bankData + 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i,     bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i + 1, bankData + 0x2000, 1, 0);
     }
 }
 
 static void destroy(RomMapperKorean126* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -103,11 +104,11 @@ static void write(RomMapperKorean126* rm, UInt16 address, UInt8 value)
 
     rm->romMapper[bank] = value;
     
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + bank + 1, bankData + 0x2000, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank + 1, bankData + 0x2000, 1, 0);
 }
 
-int romMapperKorean126Create(const char* filename, UInt8* romData, 
+int romMapperKorean126Create(BoardContext* board, const char* filename, UInt8* romData, 
                              int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -119,9 +120,10 @@ int romMapperKorean126Create(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperKorean126));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_KOREAN126, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_KOREAN126, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -134,8 +136,8 @@ int romMapperKorean126Create(const char* filename, UInt8* romData,
     rm->romMapper[2] = 0;
 
     for (i = 0; i < 4; i += 2) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i,     rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 1, rm->romData + rm->romMapper[i] * 0x2000 + 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i,     rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i + 1, rm->romData + rm->romMapper[i] * 0x2000 + 0x2000, 1, 0);
     }
 
     return 1;
@@ -35,6 +35,7 @@
 #include <stdio.h>
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -46,7 +47,7 @@ typedef struct {
 
 static void saveState(RomMapperKorean80* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperKorean80");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperKorean80");
     char tag[16];
     int i;
 
@@ -60,7 +61,7 @@ static void saveState(RomMapperKorean80* rm)
 
 static void loadState(RomMapperKorean80* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperKorean80");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperKorean80");
     char tag[16];
     int i;
 
@@ -72,14 +73,14 @@ static void loadState(RomMapperKorean80* rm)
     saveStateClose(state);
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 }
 
 static void destroy(RomMapperKorean80* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -101,11 +102,11 @@ static void write(RomMapperKorean80* rm, UInt16 address, UInt8 value)
 
         rm->romMapper[bank] = value;
         
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
     }
 }
 
-int romMapperKorean80Create(const char* filename, UInt8* romData, 
+int romMapperKorean80Create(BoardContext* board, const char* filename, UInt8* romData, 
                             int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -117,9 +118,10 @@ int romMapperKorean80Create(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperKorean80));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_KOREAN80, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_KOREAN80, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -134,7 +136,7 @@ int romMapperKorean80Create(const char* filename, UInt8* romData,
     rm->romMapper[3] = 0;
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 
     return 1;
@@ -30,7 +30,7 @@
  
 #include "MsxTypes.h"
 
-int romMapperKorean80Create(const char* filename, UInt8* romData, 
+int romMapperKorean80Create(BoardContext* board, const char* filename, UInt8* romData, 
                             int size, int slot, int sslot, int startPage);
 
 #endif
@@ -38,6 +38,7 @@
 #include <stdio.h>
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     UInt8* romData;
@@ -50,7 +51,7 @@ typedef struct {
 
 static void saveState(RomMapperKorean90* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperKorean90");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperKorean90");
     char tag[16];
     int i;
 
@@ -64,7 +65,7 @@ static void saveState(RomMapperKorean90* rm)
 
 static void loadState(RomMapperKorean90* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperKorean90");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperKorean90");
     char tag[16];
     int i;
 
@@ -76,17 +77,17 @@ static void loadState(RomMapperKorean90* rm)
     saveStateClose(state);
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 }
 
 static void destroy(RomMapperKorean90* rm)
 {
-    if (ioPortGetRef(0x77)&&ioPortGetRef(0x77)==rm) ioPortUnregister(0x77);
+    if (ioPortGetRef(rm->board, 0x77)&&ioPortGetRef(rm->board, 0x77)==rm) ioPortUnregister(rm->board, 0x77);
     
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
     free(rm->romData);
     free(rm);
@@ -113,7 +114,7 @@ static void write(RomMapperKorean90* rm, UInt16 address, UInt8 value)
     }
 
     for (i = 0; i < 4; i++) {
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 }
 
@@ -125,7 +126,7 @@ static void getDebugInfo(RomMapperKorean90* rm, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 0, 0x77, DBG_IO_WRITE, 0);
 }
 
-int romMapperKorean90Create(const char* filename, UInt8* romData, 
+int romMapperKorean90Create(BoardContext* board, const char* filename, UInt8* romData, 
                             int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -138,11 +139,12 @@ int romMapperKorean90Create(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperKorean90));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_KOREAN90, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_CART, langDbgDevKorean90(), &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_KOREAN90, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_CART, langDbgDevKorean90(), &dbgCallbacks, rm);
 
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, NULL, destroy, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, NULL, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -157,12 +159,12 @@ int romMapperKorean90Create(const char* filename, UInt8* romData,
     rm->romMapper[3] = 1;
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
     
     // bankswitch I/O at port $77, 1st insertion only
     // it's very likely though that writes to that port get intercepted by every inserted Korean90 cart, and not just 1
-    ioPortRegister(0x77, NULL, write, rm);
+    ioPortRegister(board, 0x77, NULL, write, rm);
 
     return 1;
 }
@@ -36,6 +36,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -47,7 +48,7 @@ typedef struct {
 
 static void saveState(RomMapperLodeRunner* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperLodeRunner");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperLodeRunner");
 
     saveStateSet(state, "romMapper", rm->romMapper);
     
@@ -56,7 +57,7 @@ static void saveState(RomMapperLodeRunner* rm)
 
 static void loadState(RomMapperLodeRunner* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperLodeRunner");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperLodeRunner");
     UInt8* bankData;
 
     rm->romMapper = saveStateGet(state, "romMapper", 0);
@@ -64,14 +65,14 @@ static void loadState(RomMapperLodeRunner* rm)
     saveStateClose(state);
 
     bankData = rm->romData + (rm->romMapper << 14);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage,     bankData, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, bankData + 0x2000, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage,     bankData, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 1, bankData + 0x2000, 1, 0);
 }
 
 static void destroy(RomMapperLodeRunner* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
     free(rm->romData);
     free(rm);
 }
@@ -85,12 +86,12 @@ static void write(RomMapperLodeRunner* rm, UInt16 address, UInt8 value)
         
         rm->romMapper = value;
 
-        slotMapPage(rm->slot, rm->sslot, rm->startPage,     bankData, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, bankData + 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage,     bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 1, bankData + 0x2000, 1, 0);
     }
 }
 
-int romMapperLodeRunnerCreate(const char* filename, UInt8* romData, 
+int romMapperLodeRunnerCreate(BoardContext* board, const char* filename, UInt8* romData, 
                           int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -101,10 +102,11 @@ int romMapperLodeRunnerCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperLodeRunner));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_LODERUNNER, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, NULL, destroy, rm);
-    slotRegisterWrite0(write, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_LODERUNNER, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, NULL, destroy, rm);
+    slotRegisterWrite0(board, write, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -115,8 +117,8 @@ int romMapperLodeRunnerCreate(const char* filename, UInt8* romData,
 
     rm->romMapper = 0;
 
-    slotMapPage(rm->slot, rm->sslot, rm->startPage,     rm->romData + rm->romMapper * 0x2000, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, rm->romData + rm->romMapper * 0x2000 + 0x2000, 1, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage,     rm->romData + rm->romMapper * 0x2000, 1, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 1, rm->romData + rm->romMapper * 0x2000 + 0x2000, 1, 0);
 
     return 1;
 }
@@ -38,6 +38,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
 	DAC* dac;
@@ -50,7 +51,7 @@ typedef struct {
 
 static void saveState(RomMapperMajutsushi* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperMajutsushi");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperMajutsushi");
     char tag[16];
     int i;
 
@@ -64,7 +65,7 @@ static void saveState(RomMapperMajutsushi* rm)
 
 static void loadState(RomMapperMajutsushi* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperMajutsushi");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperMajutsushi");
     char tag[16];
     int i;
 
@@ -76,14 +77,14 @@ static void loadState(RomMapperMajutsushi* rm)
     saveStateClose(state);
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 }
 
 static void destroy(RomMapperMajutsushi* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
     dacDestroy(rm->dac);
 
     free(rm->romData);
@@ -114,11 +115,11 @@ static void write(RomMapperMajutsushi* rm, UInt16 address, UInt8 value)
 
         rm->romMapper[bank] = value;
         
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
     }
 }
 
-int romMapperMajutsushiCreate(const char* filename, UInt8* romData, 
+int romMapperMajutsushiCreate(BoardContext* board, const char* filename, UInt8* romData, 
                            int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -130,13 +131,14 @@ int romMapperMajutsushiCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperMajutsushi));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_MAJUTSUSHI, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_MAJUTSUSHI, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
-    rm->dac = dacCreate(boardGetMixer(), DAC_MONO);
+    rm->dac = dacCreate(boardGetMixer(board), DAC_MONO);
     rm->size = size;
     rm->slot  = slot;
     rm->sslot = sslot;
@@ -148,7 +150,7 @@ int romMapperMajutsushiCreate(const char* filename, UInt8* romData,
     rm->romMapper[3] = 3;
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 
     return 1;
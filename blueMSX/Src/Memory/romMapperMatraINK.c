@@ -36,6 +36,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     AmdFlash* flash;
     int slot;
@@ -56,8 +57,8 @@ static void loadState(RomMapperMatraINK* rm)
 static void destroy(RomMapperMatraINK* rm)
 {
     amdFlashDestroy(rm->flash);
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm);
 }
@@ -78,7 +79,7 @@ static void write(RomMapperMatraINK* rm, UInt16 address, UInt8 value)
     amdFlashWrite(rm->flash, address, value);
 }
 
-int romMapperMatraINKCreate(const char* filename, UInt8* romData, 
+int romMapperMatraINKCreate(BoardContext* board, const char* filename, UInt8* romData, 
                              int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -86,18 +87,19 @@ int romMapperMatraINKCreate(const char* filename, UInt8* romData,
     int i;
 
     rm = calloc(1, sizeof(RomMapperMatraINK));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_MEGAFLSHSCC, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 8, read, peek, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_MEGAFLSHSCC, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 8, read, peek, write, destroy, rm);
 
     rm->slot  = slot;
     rm->sslot = sslot;
     rm->startPage  = startPage;
 
-    rm->flash = amdFlashCreate(AMD_TYPE_2, 0x10000, 0x10000, 0xff, romData, size, NULL, 0);
+    rm->flash = amdFlashCreate(board, AMD_TYPE_2, 0x10000, 0x10000, 0xff, romData, size, NULL, 0);
 
     for (i = 0; i < 8; i++) {
-        slotMapPage(slot, sslot, startPage + i, NULL, 0, 0);
+        slotMapPage(board, slot, sslot, startPage + i, NULL, 0, 0);
     }
 
     return 1;
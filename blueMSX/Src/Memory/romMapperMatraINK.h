@@ -29,7 +29,7 @@
  
 #include "MsxTypes.h"
 
-int romMapperMatraINKCreate(const char* filename, UInt8* romData, 
+int romMapperMatraINKCreate(BoardContext* board, const char* filename, UInt8* romData, 
                              int size, int slot, int sslot, int startPage);
 
 #endif
@@ -41,6 +41,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int    debugHandle;
     UInt8* romData;
@@ -74,12 +75,12 @@ static void mapPage(RomMapperMegaFlashRomScc* rm, int bank, int page)
 
     readEnable = (bank == 2 && rm->sccEnable) || rm->flashPage[bank] >= 0 ? 0 : 1;
 
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, bankData, readEnable, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, bankData, readEnable, 0);
 }
 
 static void saveState(RomMapperMegaFlashRomScc* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperMegaFlashRomScc");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperMegaFlashRomScc");
     char tag[16];
     int i;
 
@@ -100,7 +101,7 @@ static void saveState(RomMapperMegaFlashRomScc* rm)
 
 static void loadState(RomMapperMegaFlashRomScc* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperMegaFlashRomScc");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperMegaFlashRomScc");
     char tag[16];
     int i;
 
@@ -126,16 +127,16 @@ static void loadState(RomMapperMegaFlashRomScc* rm)
 static void destroy(RomMapperMegaFlashRomScc* rm)
 {
     amdFlashDestroy(rm->flash);
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
     if (rm->ay8910)
         ay8910Destroy(rm->ay8910);
     sccDestroy(rm->scc);
 
-    ioPortUnregister(0x10);
-    ioPortUnregister(0x11);
-    ioPortUnregister(0x12);
+    ioPortUnregister(rm->board, 0x10);
+    ioPortUnregister(rm->board, 0x11);
+    ioPortUnregister(rm->board, 0x12);
 
     free(rm->romData);
     free(rm);
@@ -242,7 +243,7 @@ static void getDebugInfo(RomMapperMegaFlashRomScc* rm, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 2, 0x12, DBG_IO_READ,  peek(rm, 0x12));
 }
 
-int romMapperMegaFlashRomSccCreate(const char* filename, UInt8* romData, 
+int romMapperMegaFlashRomSccCreate(BoardContext* board, const char* filename, UInt8* romData, 
                                    int size, int slot, int sslot, int startPage, UInt32 writeProtectMask, 
                                    int flashSize, int hasPsg) 
 {
@@ -252,10 +253,11 @@ int romMapperMegaFlashRomSccCreate(const char* filename, UInt8* romData,
     int i;
 
     rm = calloc(1, sizeof(RomMapperMegaFlashRomScc));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(hasPsg ? ROM_MEGAFLSHSCCPLUS : ROM_MEGAFLSHSCC, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_AUDIO, "AY8910", &dbgCallbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, read, peek, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, hasPsg ? ROM_MEGAFLSHSCCPLUS : ROM_MEGAFLSHSCC, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_AUDIO, "AY8910", &dbgCallbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, read, peek, write, destroy, rm);
 
     if (size >= flashSize) {
         size = flashSize;
@@ -269,23 +271,23 @@ int romMapperMegaFlashRomSccCreate(const char* filename, UInt8* romData,
     rm->sslot = sslot;
     rm->romMask = flashSize / 0x2000 - 1;
     rm->startPage  = startPage;
-    rm->scc = sccCreate(boardGetMixer());
+    rm->scc = sccCreate(board, boardGetMixer(board));
     sccSetMode(rm->scc, SCC_REAL);
     rm->sccEnable = 0;
     if (hasPsg) {
-        rm->ay8910 = ay8910Create(boardGetMixer(), AY8910_MSX, PSGTYPE_AY8910, 0, NULL);
+        rm->ay8910 = ay8910Create(board, boardGetMixer(board), AY8910_MSX, PSGTYPE_AY8910, 0, NULL);
     }
 
-    rm->flash = amdFlashCreate(AMD_TYPE_2, flashSize, 0x10000, writeProtectMask, romData, size, sramCreateFilenameWithSuffix(filename, "", ".sram"), 1);
+    rm->flash = amdFlashCreate(board, AMD_TYPE_2, flashSize, 0x10000, writeProtectMask, romData, size, sramCreateFilenameWithSuffix(filename, "", ".sram"), 1);
 
     for (i = 0; i < 4; i++) {   
         mapPage(rm, i, i);
     }
     
     if (hasPsg) {
-        ioPortRegister(0x10, NULL, ioWrite, rm);
-        ioPortRegister(0x11, NULL, ioWrite, rm);
-        ioPortRegister(0x12, ioRead, NULL, rm);
+        ioPortRegister(board, 0x10, NULL, ioWrite, rm);
+        ioPortRegister(board, 0x11, NULL, ioWrite, rm);
+        ioPortRegister(board, 0x12, ioRead, NULL, rm);
     }
 
     return 1;
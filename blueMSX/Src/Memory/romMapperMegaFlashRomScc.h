@@ -30,7 +30,7 @@
  
 #include "MsxTypes.h"
 
-int romMapperMegaFlashRomSccCreate(const char* filename, UInt8* romData, 
+int romMapperMegaFlashRomSccCreate(BoardContext* board, const char* filename, UInt8* romData, 
                                    int size, int slot, int sslot, int startPage, 
                                    UInt32 writeProtectMask, int flashSize, int hasPsg);
 
@@ -12,6 +12,7 @@
 #include <string.h>
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     AmdFlash* flash;
@@ -339,7 +340,7 @@ static void reset(RomMapperMegaFlashRomSccPlus* rm)
 
 static void saveState(RomMapperMegaFlashRomSccPlus* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperMegaFlashRomSccPlus");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperMegaFlashRomSccPlus");
     char tag[16];
     int i;
 
@@ -358,7 +359,7 @@ static void saveState(RomMapperMegaFlashRomSccPlus* rm)
 
 static void loadState(RomMapperMegaFlashRomSccPlus* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperMegaFlashRomSccPlus");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperMegaFlashRomSccPlus");
     char tag[16];
     int i;
 
@@ -382,8 +383,8 @@ static void loadState(RomMapperMegaFlashRomSccPlus* rm)
 static void destroy(RomMapperMegaFlashRomSccPlus* rm)
 {
     amdFlashDestroy(rm->flash);
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
     sccDestroy(rm->scc);
 
     free(rm->romData);
@@ -411,10 +412,10 @@ static void mapPage(RomMapperMegaFlashRomSccPlus* rm, int bank, int page)
 
     readEnable = (bank == 2 && rm->sccEnable) || rm->flashPage[bank] >= 0 ? 0 : 1;
 
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, bankData, readEnable, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, bankData, readEnable, 0);
 }
 
-int romMapperMegaFlashRomSccPlusCreate(const char* filename, UInt8* romData, 
+int romMapperMegaFlashRomSccPlusCreate(BoardContext* board, const char* filename, UInt8* romData, 
                                        int size, int slot, int sslot, int startPage,
                                        SccEnable sccEnable, UInt32 writeProtectMask)
 {
@@ -423,9 +424,10 @@ int romMapperMegaFlashRomSccPlusCreate(const char* filename, UInt8* romData,
     int i;
 
     rm = calloc(1, sizeof(RomMapperMegaFlashRomSccPlus));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_MEGAFLSHSCC, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, read, peek, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_MEGAFLSHSCC, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, read, peek, write, destroy, rm);
 
     if (size >= 0x80000) {
         size = 0x80000;
@@ -439,17 +441,17 @@ int romMapperMegaFlashRomSccPlusCreate(const char* filename, UInt8* romData,
     rm->sslot = sslot;
     rm->romMask = rm->size / 0x2000 - 1;
     rm->startPage  = startPage;
-    rm->scc = sccCreate(boardGetMixer());
+    rm->scc = sccCreate(board, boardGetMixer(board));
     sccSetMode(rm->scc, SCC_PLUS);
     rm->sccEnable = 0;
 
-    rm->flash = amdFlashCreate(AMD_TYPE_2, 0x80000, 0x10000, writeProtectMask, romData, size, sramCreateFilenameWithSuffix(filename, "", ".sram"), 1);
+    rm->flash = amdFlashCreate(board, AMD_TYPE_2, 0x80000, 0x10000, writeProtectMask, romData, size, sramCreateFilenameWithSuffix(filename, "", ".sram"), 1);
 
     for (i = 0; i < 4; i++) {   
         mapPage(rm, i, i);
     }
 
-    ay8910 = ay8910Create(boardGetMixer(), AY8910_MSX_SCCPLUS, PSGTYPE_AY8910, 0, machine->audio.psgpan);
+    ay8910 = ay8910Create(board, boardGetMixer(board), AY8910_MSX_SCCPLUS, PSGTYPE_AY8910, 0, machine->audio.psgpan);
     ay8910SetIoPort(ay8910, read, peek, write, NULL);
 
     return 1;
@@ -9,7 +9,7 @@ typedef enum {
     EN_SCCPLUS
 } SccEnable;
 
-int romMapperMegaFlashRomSccPlusCreate(const char* filename, UInt8* romData, 
+int romMapperMegaFlashRomSccPlusCreate(BoardContext* board, const char* filename, UInt8* romData, 
                                        int size, int slot, int sslot, int startPage,
                                        SccEnable sccEnable, UInt32 writeProtectMask);
 
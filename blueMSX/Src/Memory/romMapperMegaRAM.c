@@ -39,6 +39,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     UInt8* ramData;
@@ -52,7 +53,7 @@ typedef struct {
 
 static void saveState(RomMapperMegaRAM* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperMegaRAM");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperMegaRAM");
     char tag[16];
     int i;
 
@@ -71,7 +72,7 @@ static void saveState(RomMapperMegaRAM* rm)
 
 static void loadState(RomMapperMegaRAM* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperMegaRAM");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperMegaRAM");
     char tag[16];
     int i;
 
@@ -88,17 +89,17 @@ static void loadState(RomMapperMegaRAM* rm)
     saveStateClose(state);
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->ramData + rm->romMapper[i] * 0x2000, 1, rm->writeEnabled);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 4, rm->ramData + rm->romMapper[i] * 0x2000, 1, rm->writeEnabled);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->ramData + rm->romMapper[i] * 0x2000, 1, rm->writeEnabled);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i + 4, rm->ramData + rm->romMapper[i] * 0x2000, 1, rm->writeEnabled);
     }
 }
 
 static void destroy(RomMapperMegaRAM* rm)
 {
-    ioPortUnregister(0x8e);
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    ioPortUnregister(rm->board, 0x8e);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
     free(rm->ramData);
     free(rm);
@@ -118,8 +119,8 @@ static void write(RomMapperMegaRAM* rm, UInt16 address, UInt8 value)
 
         rm->romMapper[bank] = value;
         
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank  + 4, bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank  + 4, bankData, 1, 0);
     }
 }
 
@@ -128,8 +129,8 @@ static void writeIo(RomMapperMegaRAM* rm, UInt16 ioPort, UInt8 value)
     if (rm->writeEnabled) {
         int i;
         for (i = 0; i < 4; i++) {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->ramData + rm->romMapper[i] * 0x2000, 1, 0);
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 4, rm->ramData + rm->romMapper[i] * 0x2000, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->ramData + rm->romMapper[i] * 0x2000, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i + 4, rm->ramData + rm->romMapper[i] * 0x2000, 1, 0);
         }
     }
     rm->writeEnabled = 0;
@@ -140,8 +141,8 @@ static UInt8 readIo(RomMapperMegaRAM* rm, UInt16 ioPort)
     if (!rm->writeEnabled) {
         int i;
         for (i = 0; i < 4; i++) {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->ramData + rm->romMapper[i] * 0x2000, 1, 1);
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 4, rm->ramData + rm->romMapper[i] * 0x2000, 1, 1);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->ramData + rm->romMapper[i] * 0x2000, 1, 1);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i + 4, rm->ramData + rm->romMapper[i] * 0x2000, 1, 1);
         }
     }
     rm->writeEnabled = 1;
@@ -158,7 +159,7 @@ static void getDebugInfo(RomMapperMegaRAM* rm, DbgDevice* dbgDevice)
 }
 
 
-int romMapperMegaRAMCreate(int size, int slot, int sslot, int startPage) 
+int romMapperMegaRAMCreate(BoardContext* board, int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
@@ -170,11 +171,12 @@ int romMapperMegaRAMCreate(int size, int slot, int sslot, int startPage)
     }
 
     rm = malloc(sizeof(RomMapperMegaRAM));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_MEGARAM, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_CART, langDbgDevMegaRam(), &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_MEGARAM, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_CART, langDbgDevMegaRam(), &dbgCallbacks, rm);
 
-    slotRegister(slot, sslot, startPage, 8, NULL, NULL, write, destroy, rm);
+    slotRegister(board, slot, sslot, startPage, 8, NULL, NULL, write, destroy, rm);
 
     rm->ramData = malloc(size);
     memset(rm->ramData, 0xff, size);
@@ -190,11 +192,11 @@ int romMapperMegaRAMCreate(int size, int slot, int sslot, int startPage)
     rm->romMapper[3] = 0;
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->ramData + rm->romMapper[i] * 0x2000, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 4, rm->ramData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->ramData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i + 4, rm->ramData + rm->romMapper[i] * 0x2000, 1, 0);
     }
     
-    ioPortRegister(0x8e, readIo, writeIo, rm);
+    ioPortRegister(board, 0x8e, readIo, writeIo, rm);
 
     return 1;
 }
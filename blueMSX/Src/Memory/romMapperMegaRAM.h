@@ -30,6 +30,6 @@
  
 #include "MsxTypes.h"
 
-int romMapperMegaRAMCreate(int size, int slot, int sslot, int startPage);
+int romMapperMegaRAMCreate(BoardContext* board, int size, int slot, int sslot, int startPage);
 
 #endif
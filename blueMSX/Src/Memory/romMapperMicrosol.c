@@ -41,6 +41,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     WD2793* fdc;
@@ -52,15 +53,15 @@ typedef struct {
 
 static void destroy(Microsol* rm)
 {
-    ioPortUnregister(0xd0);
-    ioPortUnregister(0xd1);
-    ioPortUnregister(0xd2);
-    ioPortUnregister(0xd3);
-    ioPortUnregister(0xd4);
+    ioPortUnregister(rm->board, 0xd0);
+    ioPortUnregister(rm->board, 0xd1);
+    ioPortUnregister(rm->board, 0xd2);
+    ioPortUnregister(rm->board, 0xd3);
+    ioPortUnregister(rm->board, 0xd4);
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
     wd2793Destroy(rm->fdc);
 
@@ -70,7 +71,7 @@ static void destroy(Microsol* rm)
 
 static void saveState(Microsol* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperMicrosol");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperMicrosol");
 
     saveStateClose(state);
 
@@ -79,7 +80,7 @@ static void saveState(Microsol* rm)
 
 static void loadState(Microsol* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperMicrosol");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperMicrosol");
 
     saveStateClose(state);
 
@@ -185,7 +186,7 @@ static void getDebugInfo(Microsol* rm, DbgDevice* dbgDevice)
     }
 }
 
-int romMapperMicrosolCreate(const char* filename, UInt8* romData, 
+int romMapperMicrosolCreate(BoardContext* board, const char* filename, UInt8* romData, 
                             int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
@@ -195,11 +196,12 @@ int romMapperMicrosolCreate(const char* filename, UInt8* romData,
     int i;
 
     rm = malloc(sizeof(Microsol));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_MICROSOL, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, langDbgDevFdcMicrosol(), &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_MICROSOL, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, langDbgDevFdcMicrosol(), &dbgCallbacks, rm);
 
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, NULL, destroy, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, NULL, destroy, rm);
 
     size = (size + 0x3fff) & ~0x3fff;
 
@@ -210,16 +212,16 @@ int romMapperMicrosolCreate(const char* filename, UInt8* romData,
     rm->startPage  = startPage;
 
     for (i = 0; i < pages; i++) {
-        slotMapPage(slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
+        slotMapPage(board, slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
     }
     
-    ioPortRegister(0xd0, readIo, writeIo, rm);
-    ioPortRegister(0xd1, readIo, writeIo, rm);
-    ioPortRegister(0xd2, readIo, writeIo, rm);
-    ioPortRegister(0xd3, readIo, writeIo, rm);
-    ioPortRegister(0xd4, readIo, writeIo, rm);
+    ioPortRegister(board, 0xd0, readIo, writeIo, rm);
+    ioPortRegister(board, 0xd1, readIo, writeIo, rm);
+    ioPortRegister(board, 0xd2, readIo, writeIo, rm);
+    ioPortRegister(board, 0xd3, readIo, writeIo, rm);
+    ioPortRegister(board, 0xd4, readIo, writeIo, rm);
 
-    rm->fdc = wd2793Create(FDC_TYPE_WD2793);
+    rm->fdc = wd2793Create(board, FDC_TYPE_WD2793);
 
     reset(rm);
 
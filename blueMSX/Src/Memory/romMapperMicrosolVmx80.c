@@ -36,6 +36,7 @@
 #include <string.h>
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     UInt8* charData;
@@ -47,20 +48,20 @@ typedef struct {
 
 static void saveState(RomMapperMicrosolVmx80* rm)
 {
-    SaveState* state = saveStateOpenForWrite("Vmx80");
+    SaveState* state = saveStateOpenForWrite(rm->board, "Vmx80");
     saveStateClose(state);
 }
 
 static void loadState(RomMapperMicrosolVmx80* rm)
 {
-    SaveState* state = saveStateOpenForRead("Vmx80");
+    SaveState* state = saveStateOpenForRead(rm->board, "Vmx80");
     saveStateClose(state);
 }
 
 static void destroy(RomMapperMicrosolVmx80* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm->charData);
@@ -99,23 +100,23 @@ static void reset(RomMapperMicrosolVmx80* rm)
 {
 }
 
-int romMapperMicrosolVmx80Create(const char* filename, UInt8* romData, int size,
+int romMapperMicrosolVmx80Create(BoardContext* board, const char* filename, UInt8* romData, int size,
                                  int slot, int sslot, int startPage,
                                  void* charRom, int charSize) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     RomMapperMicrosolVmx80* rm;
     int pages = 2;
-    int i;
 
     if ((startPage + pages) > 8) {
         return 0;
     }
 
     rm = malloc(sizeof(RomMapperMicrosolVmx80));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_MICROSOL80, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 2, read, read, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_MICROSOL80, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 2, read, read, write, destroy, rm);
 
     rm->charData = calloc(1, 0x2000);
     if (charRom != NULL) {
@@ -126,17 +127,18 @@ int romMapperMicrosolVmx80Create(const char* filename, UInt8* romData, int size,
     }
 
     rm->crtc6845 = NULL;
-    rm->crtc6845 = crtc6845Create(50, rm->charData, charSize, 0x0800, 7, 0, 80, 4);
+    rm->crtc6845 = crtc6845Create(board, 50, rm->charData, charSize, 0x0800, 7, 0, 80, 4);
 
-    rm->romData = calloc(1, size);
+    rm->romData = calloc(1, size > 0x4000 ? size : 0x4000);
     memcpy(rm->romData, romData, size);
     rm->slot  = slot;
     rm->sslot = sslot;
     rm->startPage  = startPage;
 
-    for (i = 0; i < pages; i++) {
-        slotMapPage(slot, sslot, i + startPage, NULL, 0, 0);
-    }
+    // Only the CRTC memory at 0x6000 - 0x67ff and the CRTC register at
+    // 0x7001 need the read handler
+    slotMapPage(board, slot, sslot, startPage, rm->romData, 1, 0);
+    slotMapPageIo(board, slot, sslot, startPage + 1, rm->romData + 0x2000, 0x0000, 0x1002);
 
     reset(rm);
 
@@ -39,6 +39,7 @@
 #include <string.h>
 
 typedef struct {
+    BoardContext* board;
     int      deviceHandle;
     int      debugHandle;
     Moonsound* moonsound;
@@ -46,19 +47,19 @@ typedef struct {
 
 static void destroy(RomMapperMoonsound* rm)
 {
-    ioPortUnregister(0x7e);
-    ioPortUnregister(0x7f);
-    ioPortUnregister(0xc4);
-    ioPortUnregister(0xc5);
-    ioPortUnregister(0xc6);
-    ioPortUnregister(0xc7);
+    ioPortUnregister(rm->board, 0x7e);
+    ioPortUnregister(rm->board, 0x7f);
+    ioPortUnregister(rm->board, 0xc4);
+    ioPortUnregister(rm->board, 0xc5);
+    ioPortUnregister(rm->board, 0xc6);
+    ioPortUnregister(rm->board, 0xc7);
 
     if (rm->moonsound != NULL) {
         moonsoundDestroy(rm->moonsound);
     }
 
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
     free(rm);
 }
@@ -72,7 +73,7 @@ static void reset(RomMapperMoonsound* rm)
 
 static void loadState(RomMapperMoonsound* rm)
 {
-    SaveState* state = saveStateOpenForRead("RomMapperMoonsound");
+    SaveState* state = saveStateOpenForRead(rm->board, "RomMapperMoonsound");
 
     saveStateClose(state);
     
@@ -83,7 +84,7 @@ static void loadState(RomMapperMoonsound* rm)
 
 static void saveState(RomMapperMoonsound* rm)
 {
-    SaveState* state = saveStateOpenForWrite("RomMapperMoonsound");
+    SaveState* state = saveStateOpenForWrite(rm->board, "RomMapperMoonsound");
 
     saveStateClose(state);
 
@@ -126,25 +127,27 @@ static void getDebugInfo(RomMapperMoonsound* rm, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 5, 0xc7, DBG_IO_READWRITE, peek(rm, 0xc7));
 }
 
-int romMapperMoonsoundCreate(const char* filename, UInt8* romData, int size, int sramSize)
+int romMapperMoonsoundCreate(BoardContext* board, const char* filename, UInt8* romData, int size, int sramSize)
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     RomMapperMoonsound* rm = malloc(sizeof(RomMapperMoonsound));
 
-    rm->deviceHandle = deviceManagerRegister(ROM_MOONSOUND, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_AUDIO, langDbgDevMoonsound(), &dbgCallbacks, rm);
+    rm->board = board;
+
+    rm->deviceHandle = deviceManagerRegister(board, ROM_MOONSOUND, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_AUDIO, langDbgDevMoonsound(), &dbgCallbacks, rm);
     
     rm->moonsound = NULL;
 
-    if (boardGetMoonsoundEnable()) {
-        rm->moonsound = moonsoundCreate(boardGetMixer(), romData, size, sramSize);
-        ioPortRegister(0x7e, read, write, rm);
-        ioPortRegister(0x7f, read, write, rm);
-        ioPortRegister(0xc4, read, write, rm);
-        ioPortRegister(0xc5, read, write, rm);
-        ioPortRegister(0xc6, read, write, rm);
-        ioPortRegister(0xc7, read, write, rm);
+    if (boardGetMoonsoundEnable(board)) {
+        rm->moonsound = moonsoundCreate(board, boardGetMixer(board), romData, size, sramSize);
+        ioPortRegister(board, 0x7e, read, write, rm);
+        ioPortRegister(board, 0x7f, read, write, rm);
+        ioPortRegister(board, 0xc4, read, write, rm);
+        ioPortRegister(board, 0xc5, read, write, rm);
+        ioPortRegister(board, 0xc6, read, write, rm);
+        ioPortRegister(board, 0xc7, read, write, rm);
     }
     else {
         // moonsound emulation has ownership of rom data. Need to
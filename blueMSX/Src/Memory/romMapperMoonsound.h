@@ -30,6 +30,6 @@
 
 #include "MsxTypes.h"
 
-int romMapperMoonsoundCreate(const char* filename, UInt8* romData, int size, int sramSize);
+int romMapperMoonsoundCreate(BoardContext* board, const char* filename, UInt8* romData, int size, int sramSize);
 
 #endif
@@ -46,6 +46,7 @@
 #define RX_QUEUE_SIZE 256
 
 typedef struct {
+    BoardContext* board;
     MidiIO* midiIo;
     UInt8   command;
     UInt8   rxData;
@@ -98,12 +99,12 @@ static void onRecv(PhilipsMidi* midi, UInt32 time)
         archSemaphoreSignal(midi->semaphore);
         midi->status |= STAT_RXRDY;
         if (midi->command & CMD_RDINT) {
-            boardSetInt(0x400);
+            boardSetInt(midi->board, 0x400);
             midi->status |= ST_INT;
         }
     }
     
-    midi->timeRecv = boardSystemTime() + midi->charTime;
+    midi->timeRecv = boardSystemTime(midi->board) + midi->charTime;
     boardTimerAdd(midi->timerRecv, midi->timeRecv);
 }
 
@@ -116,12 +117,12 @@ static void onTrans(PhilipsMidi* midi, UInt32 time)
     }
     else {
         midiIoTransmit(midi->midiIo, midi->txBuffer);
-        midi->timeTrans = boardSystemTime() + midi->charTime;
+        midi->timeTrans = boardSystemTime(midi->board) + midi->charTime;
         boardTimerAdd(midi->timerTrans, midi->timeTrans);
 
         midi->status |= STAT_TXEMPTY;
         if (midi->command & CMD_WRINT) {
-            boardSetInt(0x400);
+            boardSetInt(midi->board, 0x400);
             midi->status |= ST_INT;
         }
     }
@@ -140,18 +141,20 @@ void philipsMidiReset(PhilipsMidi* midi)
     boardTimerRemove(midi->timerRecv);
     boardTimerRemove(midi->timerTrans);
     
-    midi->timeRecv = boardSystemTime() + midi->charTime;
+    midi->timeRecv = boardSystemTime(midi->board) + midi->charTime;
     boardTimerAdd(midi->timerRecv, midi->timeRecv);
 }
 
-PhilipsMidi* philipsMidiCreate()
+PhilipsMidi* philipsMidiCreate(BoardContext* board)
 {
     PhilipsMidi* midi = (PhilipsMidi*)calloc(1, sizeof(PhilipsMidi));
 
+    midi->board = board;
+
     midi->midiIo = midiIoCreate(midiInCallback, midi);
     midi->semaphore = archSemaphoreCreate(1);
-    midi->timerRecv   = boardTimerCreate(onRecv, midi);
-    midi->timerTrans  = boardTimerCreate(onTrans, midi);
+    midi->timerRecv   = boardTimerCreate(board, onRecv, midi);
+    midi->timerTrans  = boardTimerCreate(board, onTrans, midi);
 
     return midi;
 }
@@ -169,7 +172,7 @@ UInt8 philipsMidiReadStatus(PhilipsMidi* midi)
 {
     UInt8 val = midi->status;
 
-    boardClearInt(0x400);
+    boardClearInt(midi->board, 0x400);
     midi->status &= ~ST_INT;
 
     return val;
@@ -252,7 +255,7 @@ void philipsMidiWriteCommand(PhilipsMidi* midi, UInt8 value)
 	charLength = (dataBits + parityEnable + stopBits) * baudrate;
     midi->charTime = (UInt32)(charLength * boardFrequency() / 500000);
     
-    midi->timeRecv = boardSystemTime() + midi->charTime;
+    midi->timeRecv = boardSystemTime(midi->board) + midi->charTime;
     boardTimerAdd(midi->timerRecv, midi->timeRecv);
 }
 
@@ -264,7 +267,7 @@ void philipsMidiWriteData(PhilipsMidi* midi, UInt8 value)
 
     if (midi->txPending == 0) {
         midiIoTransmit(midi->midiIo, value);
-        midi->timeTrans = boardSystemTime() + midi->charTime;
+        midi->timeTrans = boardSystemTime(midi->board) + midi->charTime;
         boardTimerAdd(midi->timerTrans, midi->timeTrans);
         midi->txPending = 1;
     }
@@ -276,6 +279,7 @@ void philipsMidiWriteData(PhilipsMidi* midi, UInt8 value)
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     Y8950* y8950;
@@ -296,9 +300,32 @@ typedef struct {
 
 static int deviceCount = 0;
 
+static void mapPages(RomMapperMsxAudio* rm)
+{
+    int i;
+
+    // The ROM mirrors can only be mapped directly when they are whole pages
+    if (rm->romData == NULL || rm->sizeMask < 0x1fff || (rm->sizeMask & (rm->sizeMask + 1))) {
+        return;
+    }
+
+    // Only the RAM at 0x3000 - 0x3fff of each 16 kB page needs the read
+    // handler while bank 0 is selected
+    for (i = 0; i < 8; i++) {
+        UInt8* pageData = rm->romData + ((0x8000 * rm->bankSelect + 0x2000 * (i & 3)) & rm->sizeMask);
+
+        if (rm->bankSelect == 0 && (i & 1)) {
+            slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + i, pageData, 0x1000, 0x1000);
+        }
+        else {
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, pageData, 1, 0);
+        }
+    }
+}
+
 static void saveState(RomMapperMsxAudio* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperMsxAudio");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperMsxAudio");
 
     saveStateSet(state, "bankSelect", rm->bankSelect);
     saveStateSetBuffer(state, "ram", rm->ram, sizeof(rm->ram));
@@ -312,7 +339,7 @@ static void saveState(RomMapperMsxAudio* rm)
 
 static void loadState(RomMapperMsxAudio* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperMsxAudio");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperMsxAudio");
 
     rm->bankSelect = saveStateGet(state, "bankSelect", 0);
     saveStateGetBuffer(state, "ram", rm->ram, sizeof(rm->ram));
@@ -322,6 +349,8 @@ static void loadState(RomMapperMsxAudio* rm)
     if (rm->y8950 != NULL) {
         y8950LoadState(rm->y8950);
     }
+
+    mapPages(rm);
 }
 
 static void destroy(RomMapperMsxAudio* rm)
@@ -330,20 +359,20 @@ static void destroy(RomMapperMsxAudio* rm)
         philipsMidiDestroy(rm->midi);
     }
 
-    ioPortUnregister(0x00);
-    ioPortUnregister(0x01);
-    ioPortUnregister(0x04);
-    ioPortUnregister(0x05);
+    ioPortUnregister(rm->board, 0x00);
+    ioPortUnregister(rm->board, 0x01);
+    ioPortUnregister(rm->board, 0x04);
+    ioPortUnregister(rm->board, 0x05);
 
-    ioPortUnregister(rm->ioBase + 0);
-    ioPortUnregister(rm->ioBase + 1);
+    ioPortUnregister(rm->board, rm->ioBase + 0);
+    ioPortUnregister(rm->board, rm->ioBase + 1);
     
     if (rm->y8950) {
-    	if (ioPortGetRef(0xc0)==rm->y8950&&ioPortGetRef(0xc1)==rm->y8950) {
-    		ioPortUnregister(0xc0); ioPortUnregister(0xc1);
+    	if (ioPortGetRef(rm->board, 0xc0)==rm->y8950&&ioPortGetRef(rm->board, 0xc1)==rm->y8950) {
+    		ioPortUnregister(rm->board, 0xc0); ioPortUnregister(rm->board, 0xc1);
     	}
-    	if (ioPortGetRef(0xc2)==rm->y8950&&ioPortGetRef(0xc3)==rm->y8950) {
-    		ioPortUnregister(0xc2); ioPortUnregister(0xc3);
+    	if (ioPortGetRef(rm->board, 0xc2)==rm->y8950&&ioPortGetRef(rm->board, 0xc3)==rm->y8950) {
+    		ioPortUnregister(rm->board, 0xc2); ioPortUnregister(rm->board, 0xc3);
     	}
     }
 
@@ -354,11 +383,11 @@ static void destroy(RomMapperMsxAudio* rm)
     }
 
     if (rm->sizeMask != -1) {
-        slotUnregister(rm->slot, rm->sslot, rm->startPage);
+        slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
     }
 
-    debugDeviceUnregister(rm->debugHandle);
-    deviceManagerUnregister(rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     if (rm->romData != NULL) {
         free(rm->romData);
@@ -383,24 +412,27 @@ static void write(RomMapperMsxAudio* rm, UInt16 address, UInt8 value)
 	// FS-CA1 port select, bit 0:c0/c1, bit 1:c2/c3
 	if (rm->is_fs_ca1&&address==0x7fff&&rm->y8950) {
 		if (value&1) {
-			ioPortRegister(0xc0, y8950Read, y8950Write, rm->y8950);
-			ioPortRegister(0xc1, y8950Read, y8950Write, rm->y8950);
+			ioPortRegister(rm->board, 0xc0, y8950Read, y8950Write, rm->y8950);
+			ioPortRegister(rm->board, 0xc1, y8950Read, y8950Write, rm->y8950);
 		}
-		else if (ioPortGetRef(0xc0)==rm->y8950&&ioPortGetRef(0xc1)==rm->y8950) {
-			ioPortUnregister(0xc0); ioPortUnregister(0xc1);
+		else if (ioPortGetRef(rm->board, 0xc0)==rm->y8950&&ioPortGetRef(rm->board, 0xc1)==rm->y8950) {
+			ioPortUnregister(rm->board, 0xc0); ioPortUnregister(rm->board, 0xc1);
 		}
 		
 		if (value&2) {
-			ioPortRegister(0xc2, y8950Read, y8950Write, rm->y8950);
-			ioPortRegister(0xc3, y8950Read, y8950Write, rm->y8950);
+			ioPortRegister(rm->board, 0xc2, y8950Read, y8950Write, rm->y8950);
+			ioPortRegister(rm->board, 0xc3, y8950Read, y8950Write, rm->y8950);
 		}
-		else if (ioPortGetRef(0xc2)==rm->y8950&&ioPortGetRef(0xc3)==rm->y8950) {
-			ioPortUnregister(0xc2); ioPortUnregister(0xc3);
+		else if (ioPortGetRef(rm->board, 0xc2)==rm->y8950&&ioPortGetRef(rm->board, 0xc3)==rm->y8950) {
+			ioPortUnregister(rm->board, 0xc2); ioPortUnregister(rm->board, 0xc3);
 		}
 	}
 #endif
 	// bankswitch
-	if (address==0x7ffe) rm->bankSelect = value & 3;
+	if (address==0x7ffe) {
+		rm->bankSelect = value & 3;
+		mapPages(rm);
+	}
 	
 	address &= 0x3fff;
 	if (rm->bankSelect == 0 && address >= 0x3000) {
@@ -479,7 +511,7 @@ static void getDebugInfo(RomMapperMsxAudio* rm, DbgDevice* dbgDevice)
     y8950GetDebugInfo(rm->y8950, dbgDevice);
 }
 
-int romMapperMsxAudioCreate(const char* filename, UInt8* romData, 
+int romMapperMsxAudioCreate(BoardContext* board, const char* filename, UInt8* romData, 
                             int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
@@ -487,10 +519,11 @@ int romMapperMsxAudioCreate(const char* filename, UInt8* romData,
     RomMapperMsxAudio* rm;
     int i;
 
-    rm = malloc(sizeof(RomMapperMsxAudio));
+    rm = calloc(1, sizeof(RomMapperMsxAudio));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_MSXAUDIO, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_AUDIO, langDbgDevMsxAudio(), &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_MSXAUDIO, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_AUDIO, langDbgDevMsxAudio(), &dbgCallbacks, rm);
 
     rm->ioBase = 0xc0 + deviceCount++ * 2;
 
@@ -503,7 +536,7 @@ int romMapperMsxAudioCreate(const char* filename, UInt8* romData,
         
         // For FS-CA1, $8000-$FFFF is unmapped
         // firmware locks up, needs more testing
-        slotRegister(slot, sslot, startPage, pages, read, read, write, destroy, rm);
+        slotRegister(board, slot, sslot, startPage, pages, read, read, write, destroy, rm);
 
         rm->romData = malloc(size);
         memcpy(rm->romData, romData, size);
@@ -522,26 +555,27 @@ int romMapperMsxAudioCreate(const char* filename, UInt8* romData,
         }
         
         for (i = 0; i < pages; i++) {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + i, NULL, 0, 0);
+            slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, NULL, 0, 0);
         }
+        mapPages(rm);
     }
 
     rm->y8950 = NULL;
 
-    if (boardGetY8950Enable()) {
-        rm->y8950 = y8950Create(boardGetMixer());
+    if (boardGetY8950Enable(board)) {
+        rm->y8950 = y8950Create(board, boardGetMixer(board));
        	
-       	ioPortRegister(rm->ioBase + 0, y8950Read, y8950Write, rm->y8950);
-       	ioPortRegister(rm->ioBase + 1, y8950Read, y8950Write, rm->y8950);
+       	ioPortRegister(board, rm->ioBase + 0, y8950Read, y8950Write, rm->y8950);
+       	ioPortRegister(board, rm->ioBase + 1, y8950Read, y8950Write, rm->y8950);
 	
-        ioPortRegister(0x00, NULL, midiWrite, rm);
-        ioPortRegister(0x01, NULL, midiWrite, rm);
-        ioPortRegister(0x04, midiRead, NULL, rm);
-        ioPortRegister(0x05, midiRead, NULL, rm);
+        ioPortRegister(board, 0x00, NULL, midiWrite, rm);
+        ioPortRegister(board, 0x01, NULL, midiWrite, rm);
+        ioPortRegister(board, 0x04, midiRead, NULL, rm);
+        ioPortRegister(board, 0x05, midiRead, NULL, rm);
     }
     
     if (deviceCount == 1) {
-        rm->midi = philipsMidiCreate();
+        rm->midi = philipsMidiCreate(board);
     }
     
     reset(rm);
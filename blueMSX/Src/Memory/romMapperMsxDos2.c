@@ -35,6 +35,7 @@
 #include <stdio.h>
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -46,7 +47,7 @@ typedef struct {
 
 static void saveState(RomMapperMsxDos2* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperMsxDos2");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperMsxDos2");
     char tag[16];
     int i;
 
@@ -60,7 +61,7 @@ static void saveState(RomMapperMsxDos2* rm)
 
 static void loadState(RomMapperMsxDos2* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperMsxDos2");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperMsxDos2");
     char tag[16];
     int i;
 
@@ -73,15 +74,15 @@ static void loadState(RomMapperMsxDos2* rm)
 
     for (i = 0; i < 4; i += 2) {
         UInt8* bankData = rm->romData + (rm->romMapper[i] << 14);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i,     bankData, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 1, bankData + 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i,     bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i + 1, bankData + 0x2000, 1, 0);
     }
 }
 
 static void destroy(RomMapperMsxDos2* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -110,12 +111,12 @@ static void write(RomMapperMsxDos2* rm, UInt16 address, UInt8 value)
         
         rm->romMapper[bank] = value;
 
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank,     bankData, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank + 1, bankData + 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank,     bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank + 1, bankData + 0x2000, 1, 0);
     }
 }
 
-int romMapperMsxDos2Create(const char* filename, UInt8* romData, 
+int romMapperMsxDos2Create(BoardContext* board, const char* filename, UInt8* romData, 
                            int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -127,9 +128,10 @@ int romMapperMsxDos2Create(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperMsxDos2));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_MSXDOS2, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_MSXDOS2, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -142,8 +144,8 @@ int romMapperMsxDos2Create(const char* filename, UInt8* romData,
     rm->romMapper[2] = size / 0x2000 - 2;
 
     for (i = 0; i < 4; i += 2) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i,     rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 1, rm->romData + rm->romMapper[i] * 0x2000 + 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i,     rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i + 1, rm->romData + rm->romMapper[i] * 0x2000 + 0x2000, 1, 0);
     }
 
     return 1;
@@ -39,6 +39,7 @@
 #include <string.h>
 
 typedef struct {
+    BoardContext* board;
     int      deviceHandle;
     int      debugHandle;
     YM_2413* ym2413;
@@ -50,16 +51,16 @@ typedef struct {
 
 static void destroy(MsxMusic* rm)
 {
-    ioPortUnregister(0x7c);
-    ioPortUnregister(0x7d);
+    ioPortUnregister(rm->board, 0x7c);
+    ioPortUnregister(rm->board, 0x7d);
 
     if (rm->ym2413 != NULL) {
         ym2413Destroy(rm->ym2413);
     }
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
     free(rm->romData);
     free(rm);
@@ -113,7 +114,7 @@ static void getDebugInfo(MsxMusic* rm, DbgDevice* dbgDevice)
     ym2413GetDebugInfo(rm->ym2413, dbgDevice);
 }
 
-int romMapperMsxMusicCreate(const char* filename, UInt8* romData, 
+int romMapperMsxMusicCreate(BoardContext* board, const char* filename, UInt8* romData, 
                             int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
@@ -122,19 +123,21 @@ int romMapperMsxMusicCreate(const char* filename, UInt8* romData,
     int pages = size / 0x2000 + ((size & 0x1fff) ? 1 : 0);
     int i;
 
+    rm->board = board;
+
     if (pages == 0 || (startPage + pages) > 8) {
         free(rm);
         return 0;
     }
 
-    rm->deviceHandle = deviceManagerRegister(ROM_MSXMUSIC, &callbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_MSXMUSIC, &callbacks, rm);
     
     rm->ym2413 = NULL;
-    if (boardGetYm2413Enable()) {
-        rm->ym2413 = ym2413Create(boardGetMixer());
-        rm->debugHandle = debugDeviceRegister(DBGTYPE_AUDIO, langDbgDevMsxMusic(), &dbgCallbacks, rm);
-        ioPortRegister(0x7c, NULL, write, rm);
-        ioPortRegister(0x7d, NULL, write, rm);
+    if (boardGetYm2413Enable(board)) {
+        rm->ym2413 = ym2413Create(board, boardGetMixer(board));
+        rm->debugHandle = debugDeviceRegister(board, DBGTYPE_AUDIO, langDbgDevMsxMusic(), &dbgCallbacks, rm);
+        ioPortRegister(board, 0x7c, NULL, write, rm);
+        ioPortRegister(board, 0x7d, NULL, write, rm);
     }
 
     rm->romData = malloc(pages * 0x2000);
@@ -145,7 +148,7 @@ int romMapperMsxMusicCreate(const char* filename, UInt8* romData,
     rm->startPage  = startPage;
 
     for (i = 0; i < pages; i++) {
-        slotMapPage(slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
+        slotMapPage(board, slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
     }
 
     reset(rm);
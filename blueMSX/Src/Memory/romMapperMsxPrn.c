@@ -36,6 +36,7 @@
 #include <stdlib.h>
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     UInt8 prnData;
@@ -45,7 +46,7 @@ typedef struct {
 
 static void saveState(RomMapperMsxPrn* prn)
 {
-    SaveState* state = saveStateOpenForWrite("MsxPrn");
+    SaveState* state = saveStateOpenForWrite(prn->board, "MsxPrn");
 
     saveStateSet(state, "prnData",  prn->prnData);
     saveStateSet(state, "prnStrobe",  prn->prnStrobe);
@@ -55,7 +56,7 @@ static void saveState(RomMapperMsxPrn* prn)
 
 static void loadState(RomMapperMsxPrn* prn)
 {
-    SaveState* state = saveStateOpenForRead("MsxPrn");
+    SaveState* state = saveStateOpenForRead(prn->board, "MsxPrn");
 
     prn->prnData  = (UInt8)saveStateGet(state, "prnData",  0);
     prn->prnStrobe  = (UInt8)saveStateGet(state, "prnStrobe",  0);
@@ -65,11 +66,11 @@ static void loadState(RomMapperMsxPrn* prn)
 
 static void destroy(RomMapperMsxPrn* prn)
 {
-    deviceManagerUnregister(prn->deviceHandle);
-    debugDeviceUnregister(prn->debugHandle);
+    deviceManagerUnregister(prn->board, prn->deviceHandle);
+    debugDeviceUnregister(prn->board, prn->debugHandle);
 
-    ioPortUnregister(0x90);
-    ioPortUnregister(0x91);
+    ioPortUnregister(prn->board, 0x90);
+    ioPortUnregister(prn->board, 0x91);
 
     printerIODestroy(prn->printerIO);
 
@@ -120,21 +121,22 @@ static void getDebugInfo(RomMapperMsxPrn* prn, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 1, 0x91, DBG_IO_READWRITE, readIo(prn, 0x91));
 }
 
-int romMapperMsxPrnCreate(void) 
+int romMapperMsxPrnCreate(BoardContext* board) 
 {
     DeviceCallbacks callbacks = {destroy, reset, saveState, loadState};
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     RomMapperMsxPrn* prn;
 
     prn = malloc(sizeof(RomMapperMsxPrn));
+    prn->board = board;
 
-    prn->printerIO = printerIOCreate();
+    prn->printerIO = printerIOCreate(board);
 
-    prn->deviceHandle = deviceManagerRegister(ROM_MSXPRN, &callbacks, prn);
-    prn->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, langDbgDevPrinter(), &dbgCallbacks, prn);
+    prn->deviceHandle = deviceManagerRegister(board, ROM_MSXPRN, &callbacks, prn);
+    prn->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, langDbgDevPrinter(), &dbgCallbacks, prn);
 
-    ioPortRegister(0x90, readIo, writeIo, prn);
-    ioPortRegister(0x91, readIo, writeIo, prn);
+    ioPortRegister(board, 0x90, readIo, writeIo, prn);
+    ioPortRegister(board, 0x91, readIo, writeIo, prn);
 
     reset(prn);
 
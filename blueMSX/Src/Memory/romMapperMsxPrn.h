@@ -30,6 +30,6 @@
 
 #include "MsxTypes.h"
 
-int romMapperMsxPrnCreate(void);
+int romMapperMsxPrnCreate(BoardContext* board);
 
 #endif
@@ -67,6 +67,7 @@
 #define CMD_HUNT   0x80
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     int slot;
@@ -88,7 +89,7 @@ static MSXRs232* msxRs232;
 */
 static void saveState(MSXRs232* msxRs232)
 {
-    SaveState* state = saveStateOpenForWrite("MSXRs232");
+    SaveState* state = saveStateOpenForWrite(msxRs232->board, "MSXRs232");
 
     saveStateSet(state, "status",  msxRs232->status);
     saveStateSet(state, "intmask",  msxRs232->intmask);
@@ -101,7 +102,7 @@ static void saveState(MSXRs232* msxRs232)
 
 static void loadState(MSXRs232* msxRs232)
 {
-    SaveState* state = saveStateOpenForRead("MSXRs232");
+    SaveState* state = saveStateOpenForRead(msxRs232->board, "MSXRs232");
 
     msxRs232->status  = (UInt8)saveStateGet(state, "status",  0);
     msxRs232->intmask  = (UInt8)saveStateGet(state, "intmask",  0);
@@ -114,20 +115,20 @@ static void loadState(MSXRs232* msxRs232)
 
 static void destroy(MSXRs232* msxRs232)
 {
-    ioPortUnregister(0x80);
-    ioPortUnregister(0x81);
-    ioPortUnregister(0x82);
-    ioPortUnregister(0x84);
-    ioPortUnregister(0x85);
-    ioPortUnregister(0x86);
-    ioPortUnregister(0x87);
+    ioPortUnregister(msxRs232->board, 0x80);
+    ioPortUnregister(msxRs232->board, 0x81);
+    ioPortUnregister(msxRs232->board, 0x82);
+    ioPortUnregister(msxRs232->board, 0x84);
+    ioPortUnregister(msxRs232->board, 0x85);
+    ioPortUnregister(msxRs232->board, 0x86);
+    ioPortUnregister(msxRs232->board, 0x87);
        
     i8251Destroy(msxRs232->i8251);
     i8254Destroy(msxRs232->i8254);
 
-    slotUnregister(msxRs232->slot, msxRs232->sslot, msxRs232->startPage);
-    deviceManagerUnregister(msxRs232->deviceHandle);
-    debugDeviceUnregister(msxRs232->debugHandle);
+    slotUnregister(msxRs232->board, msxRs232->slot, msxRs232->sslot, msxRs232->startPage);
+    deviceManagerUnregister(msxRs232->board, msxRs232->deviceHandle);
+    debugDeviceUnregister(msxRs232->board, msxRs232->debugHandle);
 
     free(msxRs232->romData);
     free(msxRs232);
@@ -259,9 +260,9 @@ static void setRxReady(MSXRs232* msxRs232, int status)
 {
     if (~msxRs232->intmask & INTMASK_RXREADY) {
         if (status)
-            boardSetInt(1);
+            boardSetInt(msxRs232->board, 1);
         else
-            boardClearInt(1);
+            boardClearInt(msxRs232->board, 1);
     }
 }
 
@@ -327,7 +328,7 @@ static void getDebugInfo(MSXRs232* msxRs232, DbgDevice* dbgDevice)
 ** MSX RS-232 Create Method
 ******************************************
 */
-int romMapperMsxRs232Create(const char* filename, UInt8* romData, int size, int slot, int sslot, int startPage)
+int romMapperMsxRs232Create(BoardContext* board, const char* filename, UInt8* romData, int size, int slot, int sslot, int startPage)
 {
     DeviceCallbacks callbacks = {destroy, reset, saveState, loadState};
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
@@ -339,37 +340,39 @@ int romMapperMsxRs232Create(const char* filename, UInt8* romData, int size, int
     }
 
     msxRs232 = malloc(sizeof(MSXRs232));
+    msxRs232->board = board;
     
-    msxRs232->deviceHandle = deviceManagerRegister(ROM_MSXRS232, &callbacks, msxRs232);
-    msxRs232->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, langDbgDevRs232(), &dbgCallbacks, msxRs232);
+    msxRs232->deviceHandle = deviceManagerRegister(board, ROM_MSXRS232, &callbacks, msxRs232);
+    msxRs232->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, langDbgDevRs232(), &dbgCallbacks, msxRs232);
 
-    slotRegister(slot, sslot, startPage, pages, read, peek, write, destroy, msxRs232);
+    slotRegister(board, slot, sslot, startPage, pages, read, peek, write, destroy, msxRs232);
 
-    msxRs232->romData = malloc(size);
+    msxRs232->romData = calloc(1, size > 0x4000 ? size : 0x4000);
     memcpy(msxRs232->romData, romData, size);
     
     msxRs232->slot  = slot;
     msxRs232->sslot = sslot;
     msxRs232->startPage  = startPage;
 
+    // The ROM needs no read handler, the UART is on I/O ports
     for (i = 0; i < pages; i++) {
-        slotMapPage(slot, sslot, i + startPage, NULL, 0, 0);
+        slotMapPage(board, slot, sslot, i + startPage, i < 2 ? msxRs232->romData + 0x2000 * i : NULL, i < 2, 0);
     }
 
-    msxRs232->i8251 = i8251Create(rs232transmit, rs232signal, setDataBits, setStopBits, setParity, 
+    msxRs232->i8251 = i8251Create(board, rs232transmit, rs232signal, setDataBits, setStopBits, setParity, 
                                  setRxReady, setDtr, setRts, getDtr, getRts, msxRs232);
 
-    msxRs232->i8254 = i8254Create(1843200, pitOut0, pitOut1, pitOut2, msxRs232);
+    msxRs232->i8254 = i8254Create(board, 1843200, pitOut0, pitOut1, pitOut2, msxRs232);
 
     msxRs232->serialLink = archUartCreate(romMapperMsxRs232ReceiveCallback);
 
-    ioPortRegister(0x80, readIo, writeIo, msxRs232);
-    ioPortRegister(0x81, readIo, writeIo, msxRs232);
-    ioPortRegister(0x82, readIo, writeIo, msxRs232);
-    ioPortRegister(0x84, readIo, writeIo, msxRs232);
-    ioPortRegister(0x85, readIo, writeIo, msxRs232);
-    ioPortRegister(0x86, readIo, writeIo, msxRs232);
-    ioPortRegister(0x87, NULL, writeIo, msxRs232);
+    ioPortRegister(board, 0x80, readIo, writeIo, msxRs232);
+    ioPortRegister(board, 0x81, readIo, writeIo, msxRs232);
+    ioPortRegister(board, 0x82, readIo, writeIo, msxRs232);
+    ioPortRegister(board, 0x84, readIo, writeIo, msxRs232);
+    ioPortRegister(board, 0x85, readIo, writeIo, msxRs232);
+    ioPortRegister(board, 0x86, readIo, writeIo, msxRs232);
+    ioPortRegister(board, 0x87, NULL, writeIo, msxRs232);
 
     reset(msxRs232);
 
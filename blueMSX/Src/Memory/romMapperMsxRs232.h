@@ -31,6 +31,6 @@
 
 #include "MsxTypes.h"
 
-int romMapperMsxRs232Create(const char* filename, UInt8* romData, int size, int slot, int sslot, int startPage);
+int romMapperMsxRs232Create(BoardContext* board, const char* filename, UInt8* romData, int size, int slot, int sslot, int startPage);
 
 #endif
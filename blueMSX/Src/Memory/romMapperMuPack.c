@@ -37,6 +37,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -60,7 +61,7 @@ static void writeIo(RomMapperMuPack* rm, UInt16 page, UInt8 value)
 
 static void saveState(RomMapperMuPack* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperMuPack");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperMuPack");
 
     saveStateSet(state, "sslReg", rm->sslReg);
     saveStateSetBuffer(state, "subslot", rm->subslot, 4);
@@ -73,7 +74,7 @@ static void saveState(RomMapperMuPack* rm)
 
 static void loadState(RomMapperMuPack* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperMuPack");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperMuPack");
     int i;
     
     rm->sslReg = (UInt8)saveStateGet(state, "sslReg", 0);
@@ -91,8 +92,8 @@ static void loadState(RomMapperMuPack* rm)
 
 static void destroy(RomMapperMuPack* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, 0);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, 0);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
     
     ramMapperIoRemove(rm->handle);
 
@@ -154,7 +155,7 @@ static void write(RomMapperMuPack* rm, UInt16 address, UInt8 value)
     }
 }
 
-int romMapperMuPackCreate(const char* filename, UInt8* romData, 
+int romMapperMuPackCreate(BoardContext* board, const char* filename, UInt8* romData, 
                            int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
@@ -162,9 +163,10 @@ int romMapperMuPackCreate(const char* filename, UInt8* romData,
     int i;
 
     rm = malloc(sizeof(RomMapperMuPack));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_MUPACK, &callbacks, rm);
-    slotRegister(slot, sslot, 0, 8, read, read, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_MUPACK, &callbacks, rm);
+    slotRegister(board, slot, sslot, 0, 8, read, read, write, destroy, rm);
 
     rm->romData = calloc(1, size);
     memcpy(rm->romData, romData, size);
@@ -178,10 +180,10 @@ int romMapperMuPackCreate(const char* filename, UInt8* romData,
     rm->handle  = ramMapperIoAdd((rm->ramMask + 1) * 0x4000, writeIo, rm);
 
     // MIDI
-    MSXMidiCreate(1);
+    MSXMidiCreate(board, 1);
 
     for (i = 0; i < 8; i++) { 
-        slotMapPage(rm->slot, rm->sslot, i, NULL, 0, 0);
+        slotMapPage(board, rm->slot, rm->sslot, i, NULL, 0, 0);
     }
 
     reset(rm);
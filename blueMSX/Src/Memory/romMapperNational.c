@@ -37,6 +37,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     UInt8 sram[0x1000];
@@ -49,9 +50,19 @@ typedef struct {
     int romMapper[8];
 } RomMapperNational;
 
+static void mapPage(RomMapperNational* rm, int page)
+{
+    UInt8* bankData = rm->romData + (rm->romMapper[page] << 14);
+
+    // Only the bank registers at 0x7ff0 - 0x7ff6 and the SRAM port at
+    // 0x3ffd of each bank need the read handler
+    slotMapPage(rm->board, rm->slot, rm->sslot, page, bankData, 1, 0);
+    slotMapPageIo(rm->board, rm->slot, rm->sslot, page + 1, bankData + 0x2000, 0x1ff0, 0x10);
+}
+
 static void saveState(RomMapperNational* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperNational");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperNational");
     char tag[16];
     int i;
 
@@ -68,7 +79,7 @@ static void saveState(RomMapperNational* rm)
 
 static void loadState(RomMapperNational* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperNational");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperNational");
     char tag[16];
     int i;
 
@@ -83,7 +94,7 @@ static void loadState(RomMapperNational* rm)
     saveStateClose(state);
 
     for (i = 0; i < 8; i += 2) {
-        slotMapPage(rm->slot, rm->sslot, i, rm->romData + rm->romMapper[i] * 0x4000, 1, 0);
+        mapPage(rm, i);
     }
 }
 
@@ -91,8 +102,8 @@ static void destroy(RomMapperNational* rm)
 {
     sramSave(rm->sramFilename, rm->sram, 0x800, NULL, 0);
 
-    slotUnregister(rm->slot, rm->sslot, 0);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, 0);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -128,19 +139,19 @@ static void write(RomMapperNational* rm, UInt16 address, UInt8 value)
 {
 	if (address == 0x6000) {
         rm->romMapper[2] = value;
-        slotMapPage(rm->slot, rm->sslot, 2, rm->romData + ((int)value << 14), 1, 0);
+        mapPage(rm, 2);
 	} 
     else if (address == 0x6400) {
         rm->romMapper[0] = value;
-        slotMapPage(rm->slot, rm->sslot, 0, rm->romData + ((int)value << 14), 1, 0);
+        mapPage(rm, 0);
 	} 
     else if (address == 0x7000) {
         rm->romMapper[4] = value;
-        slotMapPage(rm->slot, rm->sslot, 4, rm->romData + ((int)value << 14), 1, 0);
+        mapPage(rm, 4);
 	} 
     else if (address == 0x7400) {
         rm->romMapper[6] = value;
-        slotMapPage(rm->slot, rm->sslot, 6, rm->romData + ((int)value << 14), 1, 0);
+        mapPage(rm, 6);
 	} 
     else if (address == 0x7ff9) {
 		rm->control = value;
@@ -162,7 +173,7 @@ static void write(RomMapperNational* rm, UInt16 address, UInt8 value)
 	}
 }
 
-int romMapperNationalCreate(const char* filename, UInt8* romData, 
+int romMapperNationalCreate(BoardContext* board, const char* filename, UInt8* romData, 
                                int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -174,9 +185,10 @@ int romMapperNationalCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperNational));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_NATIONAL, &callbacks, rm);
-    slotRegister(slot, sslot, 0, 8, read, peek, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_NATIONAL, &callbacks, rm);
+    slotRegister(board, slot, sslot, 0, 8, read, peek, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -196,8 +208,7 @@ int romMapperNationalCreate(const char* filename, UInt8* romData,
     rm->romMapper[6] = 0;
 
     for (i = 0; i < 8; i += 2) {   
-        slotMapPage(slot, sslot, i,     rm->romData + rm->romMapper[i] * 0x2000, 1, 0 );
-        slotMapPage(slot, sslot, i + 1, rm->romData + rm->romMapper[i] * 0x2000 + 0x2000, 0, 0);
+        mapPage(rm, i);
     }
 
     return 1;
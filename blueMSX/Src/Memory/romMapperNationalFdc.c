@@ -38,6 +38,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     WD2793* fdc;
@@ -49,7 +50,7 @@ typedef struct {
 
 static void saveState(RomMapperNationalFdc* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperNationalFdc");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperNationalFdc");
 
     saveStateSet(state, "reg", rm->reg);
     
@@ -60,7 +61,7 @@ static void saveState(RomMapperNationalFdc* rm)
 
 static void loadState(RomMapperNationalFdc* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperNationalFdc");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperNationalFdc");
 
     rm->reg = (UInt8)saveStateGet(state, "reg", 0);
 
@@ -71,8 +72,8 @@ static void loadState(RomMapperNationalFdc* rm)
 
 static void destroy(RomMapperNationalFdc* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -162,7 +163,7 @@ static void reset(RomMapperNationalFdc* rm)
     wd2793Reset(rm->fdc);
 }
 
-int romMapperNationalFdcCreate(const char* filename, UInt8* romData, 
+int romMapperNationalFdcCreate(BoardContext* board, const char* filename, UInt8* romData, 
                                int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -175,9 +176,10 @@ int romMapperNationalFdcCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperNationalFdc));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_NATIONALFDC, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, pages, read, peek, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_NATIONALFDC, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, pages, read, peek, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -187,10 +189,16 @@ int romMapperNationalFdcCreate(const char* filename, UInt8* romData,
     rm->startPage  = startPage;
 
     for (i = 0; i < pages; i++) {
-        slotMapPage(slot, sslot, i + startPage, NULL, 0, 0);
+        slotMapPage(board, slot, sslot, i + startPage, NULL, 0, 0);
     }
 
-    rm->fdc = wd2793Create(FDC_TYPE_WD2793);
+    // The rom is read directly, except for the fdc registers at its end
+    if (size >= 0x4000) {
+        slotMapPage(board, slot, sslot, startPage, rm->romData, 1, 0);
+        slotMapPageIo(board, slot, sslot, startPage + 1, rm->romData + 0x2000, 0x1f80, 0x40);
+    }
+
+    rm->fdc = wd2793Create(board, FDC_TYPE_WD2793);
 
     reset(rm);
 
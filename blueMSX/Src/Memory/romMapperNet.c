@@ -60,6 +60,7 @@
 #define RX_QUEUE_SIZE 256
 
 typedef struct {
+    BoardContext* board;
     MidiIO*     midiIo;
     UInt8       command;
     UInt8       rxData;
@@ -123,13 +124,13 @@ static void onRecv(YM2148* midi, UInt32 time)
         archSemaphoreSignal(midi->semaphore);
         midi->status |= STAT_RXRDY;
         if (midi->command & CMD_RDINT) {
-            boardSetDataBus(midi->vector, 0, 0);
-            boardSetInt(0x800);
+            boardSetDataBus(midi->board, midi->vector, 0, 0);
+            boardSetInt(midi->board, 0x800);
             midi->status |= ST_INT;
         }
     }
     
-    midi->timeRecv = boardSystemTime() + midi->charTime;
+    midi->timeRecv = boardSystemTime(midi->board) + midi->charTime;
     boardTimerAdd(midi->timerRecv, midi->timeRecv);
 }
 
@@ -142,13 +143,13 @@ static void onTrans(YM2148* midi, UInt32 time)
     }
     else {
         midiIoTransmit(midi->midiIo, midi->txBuffer);
-        midi->timeTrans = boardSystemTime() + midi->charTime;
+        midi->timeTrans = boardSystemTime(midi->board) + midi->charTime;
         boardTimerAdd(midi->timerTrans, midi->timeTrans);
 
         midi->status |= STAT_TXEMPTY;
         if (midi->command & CMD_WRINT) {
-            boardSetDataBus(midi->vector, 0, 0);
-            boardSetInt(0x800);
+            boardSetDataBus(midi->board, midi->vector, 0, 0);
+            boardSetInt(midi->board, 0x800);
             midi->status |= ST_INT;
         }
     }
@@ -167,20 +168,21 @@ static void ym2148Reset(YM2148* midi)
     boardTimerRemove(midi->timerRecv);
     boardTimerRemove(midi->timerTrans);
     
-    midi->timeRecv = boardSystemTime() + midi->charTime;
+    midi->timeRecv = boardSystemTime(midi->board) + midi->charTime;
     boardTimerAdd(midi->timerRecv, midi->timeRecv);
 }
 
-static YM2148* ym2148Create()
+static YM2148* ym2148Create(BoardContext* board)
 {
     YM2148* midi = (YM2148*)calloc(1, sizeof(YM2148));
 
+    midi->board = board;
     midi->midiIo = midiIoCreate(midiInCallback, midi);
     midi->semaphore = archSemaphoreCreate(1);
-    midi->timerRecv   = boardTimerCreate(onRecv, midi);
-    midi->timerTrans  = boardTimerCreate(onTrans, midi);
+    midi->timerRecv   = boardTimerCreate(midi->board, onRecv, midi);
+    midi->timerTrans  = boardTimerCreate(midi->board, onTrans, midi);
 
-    midi->timeRecv = boardSystemTime() + midi->charTime;
+    midi->timeRecv = boardSystemTime(midi->board) + midi->charTime;
     boardTimerAdd(midi->timerRecv, midi->timeRecv);
 
     return midi;
@@ -196,7 +198,7 @@ static UInt8 ym2148ReadStatus(YM2148* midi)
 {
     UInt8 val = midi->status;
 
-    boardClearInt(0x800);
+    boardClearInt(midi->board, 0x800);
     midi->status &= ~ST_INT;
 
     return val;
@@ -211,7 +213,7 @@ static UInt8 ym2148ReadData(YM2148* midi)
 static void ym2148SetVector(YM2148* midi, UInt8 value)
 {
     midi->vector = value;
-    boardSetDataBus(midi->vector, 0, 0);
+    boardSetDataBus(midi->board, midi->vector, 0, 0);
 }
 
 static void ym2148WriteCommand(YM2148* midi, UInt8 value)
@@ -236,7 +238,7 @@ static void ym2148WriteData(YM2148* midi, UInt8 value)
 
     if (midi->txPending == 0) {
         midiIoTransmit(midi->midiIo, value);
-        midi->timeTrans = boardSystemTime() + midi->charTime;
+        midi->timeTrans = boardSystemTime(midi->board) + midi->charTime;
         boardTimerAdd(midi->timerTrans, midi->timeTrans);
         midi->txPending = 1;
     }
@@ -249,7 +251,7 @@ static void ym2148WriteData(YM2148* midi, UInt8 value)
 
 static void ym2148SaveState(YM2148* midi)
 {
-    SaveState* state = saveStateOpenForWrite("ym2148");
+    SaveState* state = saveStateOpenForWrite(midi->board, "ym2148");
     
     saveStateSet(state, "command", midi->command);
     saveStateSet(state, "vector", midi->vector);
@@ -259,7 +261,7 @@ static void ym2148SaveState(YM2148* midi)
 
 static void ym2148LoadState(YM2148* midi)
 {
-    SaveState* state = saveStateOpenForRead("ym2148");
+    SaveState* state = saveStateOpenForRead(midi->board, "ym2148");
     
     midi->command = (UInt8)saveStateGet(state, "command", 0);
     midi->vector  = (UInt8)saveStateGet(state, "vector", 0);
@@ -284,6 +286,7 @@ IO Read #0C
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     YM2151* ym2151;
@@ -301,7 +304,7 @@ static int deviceCount = 0;
 
 static void saveState(RomMapperNet* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperNet");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperNet");
     
     saveStateSet(state, "kbdLatch", rm->kbdLatch);
     
@@ -313,7 +316,7 @@ static void saveState(RomMapperNet* rm)
 
 static void loadState(RomMapperNet* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperNet");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperNet");
 
     rm->kbdLatch = (UInt8)saveStateGet(state, "kbdLatch", 0);
 
@@ -338,10 +341,10 @@ static void destroy(RomMapperNet* rm)
         ykIoDestroy(rm->ykIo);
     }
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
 
-    debugDeviceUnregister(rm->debugHandle);
-    deviceManagerUnregister(rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     if (rm->romData != NULL) {
         free(rm->romData);
@@ -419,7 +422,7 @@ static void write(RomMapperNet* rm, UInt16 address, UInt8 value)
         ym2148SetVector(rm->ym2148, value);
         break;
     case 0x3ff4:
-        boardSetDataBus(value, value, 1);
+        boardSetDataBus(rm->board, value, value, 1);
         ym2151SetIrqVector(rm->ym2151, value);
         break;
     case 0x3ff5:
@@ -437,7 +440,7 @@ static void getDebugInfo(RomMapperNet* rm, DbgDevice* dbgDevice)
     ym2151GetDebugInfo(rm->ym2151, dbgDevice);
 }
 
-int romMapperNetCreate(const char* filename, UInt8* romData, 
+int romMapperNetCreate(BoardContext* board, const char* filename, UInt8* romData, 
                        int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
@@ -451,11 +454,12 @@ int romMapperNetCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperNet));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_YAMAHANET, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, "Yamaha Net", &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_YAMAHANET, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, "Yamaha Net", &dbgCallbacks, rm);
 
-    slotRegister(slot, sslot, startPage, pages, read, read, write, destroy, rm);
+    slotRegister(board, slot, sslot, startPage, pages, read, read, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -464,12 +468,18 @@ int romMapperNetCreate(const char* filename, UInt8* romData,
     rm->startPage  = startPage;
     rm->sizeMask = size - 1;
 
+    // Only the registers at 0x7ff0 - 0x7ff7 need the read handler
     for (i = 0; i < pages; i++) {
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, NULL, 0, 0);
+        if (i == 1) {
+            slotMapPageIo(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + 0x2000 * i, 0x1ff0, 8);
+        }
+        else {
+            slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + 0x2000 * i, 1, 0);
+        }
     }
 
-    rm->ym2151 = ym2151Create(boardGetMixer());
-    rm->ym2148 = ym2148Create();
+    rm->ym2151 = ym2151Create(board, boardGetMixer(board));
+    rm->ym2148 = ym2148Create(board);
     rm->ykIo = ykIoCreate();
 
     reset(rm);
@@ -38,6 +38,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     SamplePlayer* samplePlayer;
     int deviceHandle;
     UInt8* romData;
@@ -50,7 +51,7 @@ typedef struct {
 
 static void saveState(RomMapperNettouYakyuu* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperNettouYakyuu");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperNettouYakyuu");
     char tag[16];
     int i;
 
@@ -64,7 +65,7 @@ static void saveState(RomMapperNettouYakyuu* rm)
 
 static void loadState(RomMapperNettouYakyuu* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperNettouYakyuu");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperNettouYakyuu");
     char tag[16];
     int i;
 
@@ -76,7 +77,7 @@ static void loadState(RomMapperNettouYakyuu* rm)
     saveStateClose(state);
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + (rm->romMapper[i]&rm->romMask) * 0x2000, (rm->romMapper[i]>>7^1)&1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + (rm->romMapper[i]&rm->romMask) * 0x2000, (rm->romMapper[i]>>7^1)&1, 0);
     }
 }
 
@@ -87,8 +88,8 @@ static void loadState(RomMapperNettouYakyuu* rm)
 
 static void destroy(RomMapperNettouYakyuu* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -106,12 +107,12 @@ static void write(RomMapperNettouYakyuu* rm, UInt16 address, UInt8 value)
 	
 	if (rm->romMapper[bank] != value) {
 		UInt8* bankData = rm->romData + ((int)(value&rm->romMask) << 13);
-		slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, bankData, value>>7^1, 0);
+		slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, bankData, value>>7^1, 0);
 	}
 	rm->romMapper[bank] = value;
 }
 
-int romMapperNettouYakyuuCreate(const char* filename, UInt8* romData, 
+int romMapperNettouYakyuuCreate(BoardContext* board, const char* filename, UInt8* romData, 
                           int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -126,9 +127,10 @@ int romMapperNettouYakyuuCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperNettouYakyuu));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_NETTOUYAKYUU, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_NETTOUYAKYUU, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     rm->romData = calloc(1, size);
     memcpy(rm->romData, romData, origSize);
@@ -143,7 +145,7 @@ int romMapperNettouYakyuuCreate(const char* filename, UInt8* romData,
     rm->romMapper[3] = 0;
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 
     return 1;
@@ -156,8 +158,8 @@ int romMapperNettouYakyuuCreate(const char* filename, UInt8* romData,
 static void destroy(RomMapperNettouYakyuu* rm)
 {
     samplePlayerDestroy(rm->samplePlayer);
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -179,7 +181,7 @@ static void write(RomMapperNettouYakyuu* rm, UInt16 address, UInt8 value)
 		
 		if (rm->romMapper[bank] != value) {
 			UInt8* bankData = rm->romData + ((int)(value&rm->romMask) << 13);
-			slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, bankData, value>>7^1, 0);
+			slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, bankData, value>>7^1, 0);
 		}
 		rm->romMapper[bank] = value;
 		return;
@@ -228,7 +230,7 @@ static void write(RomMapperNettouYakyuu* rm, UInt16 address, UInt8 value)
 	samplePlayerSetIndex(rm->samplePlayer,index);
 }
 
-int romMapperNettouYakyuuCreate(const char* filename, UInt8* romData, 
+int romMapperNettouYakyuuCreate(BoardContext* board, const char* filename, UInt8* romData, 
                           int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -243,9 +245,10 @@ int romMapperNettouYakyuuCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperNettouYakyuu));
-    rm->samplePlayer = samplePlayerCreate(boardGetMixer(), MIXER_CHANNEL_PCM, 8, 11025);
-    rm->deviceHandle = deviceManagerRegister(ROM_NETTOUYAKYUU, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->board = board;
+    rm->samplePlayer = samplePlayerCreate(boardGetMixer(board), MIXER_CHANNEL_PCM, 8, 11025);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_NETTOUYAKYUU, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     rm->romData = calloc(1, size);
     memcpy(rm->romData, romData, origSize);
@@ -260,7 +263,7 @@ int romMapperNettouYakyuuCreate(const char* filename, UInt8* romData,
     rm->romMapper[3] = 0;
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 
     return 1;
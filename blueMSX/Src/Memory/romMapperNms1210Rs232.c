@@ -68,6 +68,7 @@
 #define CMD_HUNT   0x80
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     int slot;
@@ -88,7 +89,7 @@ static NMS1210Rs232* nms1210Rs232;
 */
 static void saveState(NMS1210Rs232* nms1210Rs232)
 {
-    SaveState* state = saveStateOpenForWrite("NMS1210Rs232");
+    SaveState* state = saveStateOpenForWrite(nms1210Rs232->board, "NMS1210Rs232");
 
     saveStateSet(state, "status",  nms1210Rs232->status);
     saveStateSet(state, "intmask",  nms1210Rs232->intmask);
@@ -101,7 +102,7 @@ static void saveState(NMS1210Rs232* nms1210Rs232)
 
 static void loadState(NMS1210Rs232* nms1210Rs232)
 {
-    SaveState* state = saveStateOpenForRead("NMS1210Rs232");
+    SaveState* state = saveStateOpenForRead(nms1210Rs232->board, "NMS1210Rs232");
 
     nms1210Rs232->status  = (UInt8)saveStateGet(state, "status",  0);
     nms1210Rs232->intmask  = (UInt8)saveStateGet(state, "intmask",  0);
@@ -114,22 +115,22 @@ static void loadState(NMS1210Rs232* nms1210Rs232)
 
 static void destroy(NMS1210Rs232* nms1210Rs232)
 {
-    ioPortUnregister(0x37);
-    ioPortUnregister(0x38);
-    ioPortUnregister(0x39);
-    ioPortUnregister(0x3a);
-    ioPortUnregister(0x3b);
-    ioPortUnregister(0x3c);
-    ioPortUnregister(0x3d);
-    ioPortUnregister(0x3e);
-    ioPortUnregister(0x3f);
+    ioPortUnregister(nms1210Rs232->board, 0x37);
+    ioPortUnregister(nms1210Rs232->board, 0x38);
+    ioPortUnregister(nms1210Rs232->board, 0x39);
+    ioPortUnregister(nms1210Rs232->board, 0x3a);
+    ioPortUnregister(nms1210Rs232->board, 0x3b);
+    ioPortUnregister(nms1210Rs232->board, 0x3c);
+    ioPortUnregister(nms1210Rs232->board, 0x3d);
+    ioPortUnregister(nms1210Rs232->board, 0x3e);
+    ioPortUnregister(nms1210Rs232->board, 0x3f);
 
     z8530Destroy(nms1210Rs232->z8530);
     i8254Destroy(nms1210Rs232->i8254);
 
-    slotUnregister(nms1210Rs232->slot, nms1210Rs232->sslot, nms1210Rs232->startPage);
-    deviceManagerUnregister(nms1210Rs232->deviceHandle);
-    debugDeviceUnregister(nms1210Rs232->debugHandle);
+    slotUnregister(nms1210Rs232->board, nms1210Rs232->slot, nms1210Rs232->sslot, nms1210Rs232->startPage);
+    deviceManagerUnregister(nms1210Rs232->board, nms1210Rs232->deviceHandle);
+    debugDeviceUnregister(nms1210Rs232->board, nms1210Rs232->debugHandle);
 
     free(nms1210Rs232);
 }
@@ -249,9 +250,9 @@ static void setRxReady(NMS1210Rs232* nms1210Rs232, int status)
 {
     if (~nms1210Rs232->intmask & INTMASK_RXREADY) {
         if (status)
-            boardSetInt(1);
+            boardSetInt(nms1210Rs232->board, 1);
         else
-            boardClearInt(1);
+            boardClearInt(nms1210Rs232->board, 1);
     }
 }
 
@@ -317,7 +318,7 @@ static void getDebugInfo(NMS1210Rs232* nms1210Rs232, DbgDevice* dbgDevice)
 ** NMS1210 RS-232 Create Method
 ******************************************
 */
-int romMapperNms1210Rs232Create(int slot, int sslot, int startPage)
+int romMapperNms1210Rs232Create(BoardContext* board, int slot, int sslot, int startPage)
 {
     DeviceCallbacks callbacks = {destroy, reset, saveState, loadState};
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
@@ -329,37 +330,38 @@ int romMapperNms1210Rs232Create(int slot, int sslot, int startPage)
     }
 
     nms1210Rs232 = malloc(sizeof(NMS1210Rs232));
+    nms1210Rs232->board = board;
 
-    nms1210Rs232->deviceHandle = deviceManagerRegister(ROM_MSXRS232, &callbacks, nms1210Rs232);
-    nms1210Rs232->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, langDbgDevRs232(), &dbgCallbacks, nms1210Rs232);
+    nms1210Rs232->deviceHandle = deviceManagerRegister(board, ROM_MSXRS232, &callbacks, nms1210Rs232);
+    nms1210Rs232->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, langDbgDevRs232(), &dbgCallbacks, nms1210Rs232);
 
-    slotRegister(slot, sslot, startPage, pages, read, peek, write, destroy, nms1210Rs232);
+    slotRegister(board, slot, sslot, startPage, pages, read, peek, write, destroy, nms1210Rs232);
 
     nms1210Rs232->slot  = slot;
     nms1210Rs232->sslot = sslot;
     nms1210Rs232->startPage  = startPage;
 
     for (i = 0; i < pages; i++) {
-        slotMapPage(slot, sslot, i + startPage, NULL, 0, 0);
+        slotMapPage(board, slot, sslot, i + startPage, NULL, 0, 0);
     }
 
 //    nms1210Rs232->i8251 = i8251Create(rs232transmit, rs232signal, setDataBits, setStopBits, setParity, 
 //                                 setRxReady, setDtr, setRts, getDtr, getRts, nms1210Rs232);
-    nms1210Rs232->z8530 = z8530Create(nms1210Rs232);
+    nms1210Rs232->z8530 = z8530Create(board, nms1210Rs232);
 
-    nms1210Rs232->i8254 = i8254Create(3686400, pitOut0, pitOut1, pitOut2, nms1210Rs232);
+    nms1210Rs232->i8254 = i8254Create(board, 3686400, pitOut0, pitOut1, pitOut2, nms1210Rs232);
 
     nms1210Rs232->serialLink = archUartCreate(romMapperMsxRs232ReceiveCallback);
 
-    ioPortRegister(0x37, readIo, writeIo, nms1210Rs232);
-    ioPortRegister(0x38, readIo, writeIo, nms1210Rs232);
-    ioPortRegister(0x39, readIo, writeIo, nms1210Rs232);
-    ioPortRegister(0x3a, readIo, writeIo, nms1210Rs232);
-    ioPortRegister(0x3b, readIo, writeIo, nms1210Rs232);
-    ioPortRegister(0x3c, readIo, writeIo, nms1210Rs232);
-    ioPortRegister(0x3d, readIo, writeIo, nms1210Rs232);
-    ioPortRegister(0x3e, readIo, writeIo, nms1210Rs232);
-    ioPortRegister(0x3f, NULL, writeIo, nms1210Rs232);
+    ioPortRegister(board, 0x37, readIo, writeIo, nms1210Rs232);
+    ioPortRegister(board, 0x38, readIo, writeIo, nms1210Rs232);
+    ioPortRegister(board, 0x39, readIo, writeIo, nms1210Rs232);
+    ioPortRegister(board, 0x3a, readIo, writeIo, nms1210Rs232);
+    ioPortRegister(board, 0x3b, readIo, writeIo, nms1210Rs232);
+    ioPortRegister(board, 0x3c, readIo, writeIo, nms1210Rs232);
+    ioPortRegister(board, 0x3d, readIo, writeIo, nms1210Rs232);
+    ioPortRegister(board, 0x3e, readIo, writeIo, nms1210Rs232);
+    ioPortRegister(board, 0x3f, NULL, writeIo, nms1210Rs232);
 
     reset(nms1210Rs232);
 
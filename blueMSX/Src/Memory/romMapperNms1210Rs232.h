@@ -30,6 +30,6 @@
 
 #include "MsxTypes.h"
 
-int romMapperNms1210Rs232Create(int slot, int sslot, int startPage);
+int romMapperNms1210Rs232Create(BoardContext* board, int slot, int sslot, int startPage);
 
 #endif
@@ -35,6 +35,7 @@
 #include <stdlib.h>
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int vdpDaHandle;
     UInt16* videoBuffer;
@@ -80,20 +81,22 @@ static UInt8 daRead(RomMapperNms8280VideoDa* rm, int screenMode, int x, int y, P
 
 static void destroy(RomMapperNms8280VideoDa* rm)
 {
-    deviceManagerUnregister(rm->deviceHandle);
-    vdpUnregisterDaConverter(rm->vdpDaHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    vdpUnregisterDaConverter(rm->board, rm->vdpDaHandle);
 
     free(rm);
 }
 
-int romMapperNms8280VideoDaCreate() 
+int romMapperNms8280VideoDaCreate(BoardContext* board) 
 {
     DeviceCallbacks callbacks   = { destroy, NULL, NULL, NULL };
     VdpDaCallbacks  daCallbacks = { daStart, NULL, daRead };
     RomMapperNms8280VideoDa* rm = malloc(sizeof(RomMapperNms8280VideoDa));
 
-    rm->deviceHandle = deviceManagerRegister(ROM_NMS8280DIGI, &callbacks, rm);
-    rm->vdpDaHandle    = vdpRegisterDaConverter(&daCallbacks, rm, VIDEO_MASK_ALL);
+    rm->board = board;
+
+    rm->deviceHandle = deviceManagerRegister(board, ROM_NMS8280DIGI, &callbacks, rm);
+    rm->vdpDaHandle    = vdpRegisterDaConverter(board, &daCallbacks, rm, VIDEO_MASK_ALL);
 
     return 1;
 }
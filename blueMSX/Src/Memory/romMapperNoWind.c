@@ -104,6 +104,7 @@ static void debugCb(const char* message)
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     AmdFlash* amdFlash;
     int slot;
@@ -121,18 +122,18 @@ static void updateMapper(RomMapperNoWind* rm, UInt8 page)
     rm->romMapper = page & 0x1f;
     rm->flashPage = amdFlashGetPage(rm->amdFlash, rm->romMapper * 0x4000);
 
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, NULL, 0, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, NULL, 0, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, rm->flashPage, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 3, rm->flashPage + 0x2000, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 4, NULL,          0, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 5, rm->flashPage + 0x2000, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 0, NULL, 0, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 1, NULL, 0, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 2, rm->flashPage, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 3, rm->flashPage + 0x2000, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 4, NULL,          0, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 5, rm->flashPage + 0x2000, 1, 0);
 }
 
 
 static void saveState(RomMapperNoWind* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperDumas");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperDumas");
 
     saveStateSet(state, "romMapper", rm->romMapper);
 
@@ -143,7 +144,7 @@ static void saveState(RomMapperNoWind* rm)
 
 static void loadState(RomMapperNoWind* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperDumas");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperDumas");
 
     rm->romMapper = (UInt8)saveStateGet(state, "romMapper", 0);
 
@@ -161,8 +162,8 @@ static void destroy(RomMapperNoWind* rm)
     if (nowindusb_cleanup) nowindusb_cleanup();
     nowindUnloadDll();
 #endif
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm);
 }
@@ -219,21 +220,22 @@ static void write(RomMapperNoWind* rm, UInt16 address, UInt8 value)
     }
 }
 
-int romMapperNoWindCreate(int driveId, const char* filename, UInt8* romData, 
+int romMapperNoWindCreate(BoardContext* board, int driveId, const char* filename, UInt8* romData, 
                          int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     RomMapperNoWind* rm;
 
     rm = malloc(sizeof(RomMapperNoWind));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_NOWIND, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 6, read, peek, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_NOWIND, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 6, read, peek, write, destroy, rm);
 
     if (filename == NULL) {
         filename = "nowind.rom";
     }
-    rm->amdFlash = amdFlashCreate(AMD_TYPE_1, 0x80000, 0x10000, 0, romData, size, sramCreateFilenameWithSuffix(filename, "", ".rom"), 0);
+    rm->amdFlash = amdFlashCreate(board, AMD_TYPE_1, 0x80000, 0x10000, 0, romData, size, sramCreateFilenameWithSuffix(filename, "", ".rom"), 0);
     rm->slot  = slot;
     rm->sslot = sslot;
     rm->startPage  = startPage;
@@ -150,6 +150,7 @@ static void debugCb(const char* message)
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     AmdFlash* amdFlash;
     int slot;
@@ -210,12 +211,12 @@ static void updateMapper(RomMapperNoWind* rm, UInt8 page)
     rm->romMapper = page & 0x1f;
     rm->flashPage = amdFlashGetPage(rm->amdFlash, rm->romMapper * 0x4000);
 
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, NULL, 0, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, NULL, 0, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, rm->flashPage, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 3, rm->flashPage + 0x2000, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 4, NULL,          0, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 5, rm->flashPage + 0x2000, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 0, NULL, 0, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 1, NULL, 0, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 2, rm->flashPage, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 3, rm->flashPage + 0x2000, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 4, NULL,          0, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 5, rm->flashPage + 0x2000, 1, 0);
 }
 
 
@@ -223,7 +224,7 @@ static void saveState(void* _rm)
 {
     RomMapperNoWind* rm = (RomMapperNoWind*)_rm;
 
-    SaveState* state = saveStateOpenForWrite("mapperDumas");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperDumas");
 
     saveStateSet(state, "romMapper", rm->romMapper);
 
@@ -236,7 +237,7 @@ static void loadState(void* _rm)
 {
     RomMapperNoWind* rm = (RomMapperNoWind*)_rm;
 
-    SaveState* state = saveStateOpenForRead("mapperDumas");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperDumas");
 
     rm->romMapper = (UInt8)saveStateGet(state, "romMapper", 0);
 
@@ -265,8 +266,8 @@ static void destroy(void* _rm)
         nowindUnloadDll();
     }
 #endif
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm);
 }
@@ -325,7 +326,7 @@ static void write(RomMapperNoWind* rm, UInt16 address, UInt8 value)
     }
 }
 
-int romMapperNoWindCreate(int driveId, const char* filename, UInt8* romData, 
+int romMapperNoWindCreate(BoardContext* board, int driveId, const char* filename, UInt8* romData, 
                          int size, int slot, int sslot, int startPage) 
 {
     NoWindProperties* prop = &propGetGlobalProperties()->nowind;
@@ -335,13 +336,14 @@ int romMapperNoWindCreate(int driveId, const char* filename, UInt8* romData,
 
     rm = (RomMapperNoWind*)malloc(sizeof(RomMapperNoWind));
 
-    rm->deviceHandle = deviceManagerRegister(ROM_NOWIND, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 6, (SlotRead)read, (SlotRead)peek, (SlotWrite)write, destroy, rm);
+    rm->board = board;
+    rm->deviceHandle = deviceManagerRegister(board, ROM_NOWIND, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 6, (SlotRead)read, (SlotRead)peek, (SlotWrite)write, destroy, rm);
 
     if (filename == NULL) {
         filename = "nowind.rom";
     }
-    rm->amdFlash = amdFlashCreate(AMD_TYPE_1, 0x80000, 0x10000, 0, romData, size, sramCreateFilenameWithSuffix(filename, "", ".rom"), 0);
+    rm->amdFlash = amdFlashCreate(board, AMD_TYPE_1, 0x80000, 0x10000, 0, romData, size, sramCreateFilenameWithSuffix(filename, "", ".rom"), 0);
     rm->slot  = slot;
     rm->sslot = sslot;
     rm->startPage  = startPage;
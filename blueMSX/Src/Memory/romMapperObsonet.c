@@ -39,6 +39,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     AmdFlash* amdFlash;
     RTL8019*  rtl8019;
@@ -54,7 +55,7 @@ typedef struct {
 
 static void saveState(RomMapperObsonet* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperObsonet");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperObsonet");
 
     saveStateSet(state, "romMapper", rm->romMapper);
     saveStateSet(state, "regBank", rm->regBank);
@@ -67,7 +68,7 @@ static void saveState(RomMapperObsonet* rm)
 
 static void loadState(RomMapperObsonet* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperObsonet");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperObsonet");
 
     rm->romMapper = (UInt8)saveStateGet(state, "romMapper", 0);
     rm->regBank = (UInt8)saveStateGet(state, "regBank", 0);
@@ -79,15 +80,16 @@ static void loadState(RomMapperObsonet* rm)
 
     rm->flashPage = amdFlashGetPage(rm->amdFlash, rm->romMapper * 0x4000);
 
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, rm->flashPage, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 0, rm->flashPage, 1, 0);
+    slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + 1, rm->flashPage + 0x2000, 0x1fe0, 0x20);
 }
 
 static void destroy(RomMapperObsonet* rm)
 {
     amdFlashDestroy(rm->amdFlash);
     rtl8019Destroy(rm->rtl8019);
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm);
 }
@@ -99,7 +101,8 @@ static void reset(RomMapperObsonet* rm)
     amdFlashReset(rm->amdFlash);
     rtl8019Reset(rm->rtl8019);
     rm->flashPage = amdFlashGetPage(rm->amdFlash, rm->romMapper * 0x4000);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, rm->flashPage, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 0, rm->flashPage, 1, 0);
+    slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + 1, rm->flashPage + 0x2000, 0x1fe0, 0x20);
 }
 
 static UInt8 read(RomMapperObsonet* rm, UInt16 address) 
@@ -111,7 +114,7 @@ static UInt8 read(RomMapperObsonet* rm, UInt16 address)
     }
 
     if (address < 0x4000) {
-        // This is reads to 0x6000-0x7FDF, rest are directly mapped
+        // Only the block below the registers is read here, rest are directly mapped
         return rm->flashPage[address];
     }
 
@@ -139,7 +142,8 @@ static void write(RomMapperObsonet* rm, UInt16 address, UInt8 value)
             if (rm->regBank == 3) {
                 rm->romMapper = value & 0x1f;
                 rm->flashPage = amdFlashGetPage(rm->amdFlash, rm->romMapper * 0x4000);
-                slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, rm->flashPage, 1, 0);
+                slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 0, rm->flashPage, 1, 0);
+                slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + 1, rm->flashPage + 0x2000, 0x1fe0, 0x20);
             }
             break;
         }
@@ -150,30 +154,32 @@ static void write(RomMapperObsonet* rm, UInt16 address, UInt8 value)
     }
 }
 
-int romMapperObsonetCreate(const char* filename, UInt8* romData, 
+int romMapperObsonetCreate(BoardContext* board, const char* filename, UInt8* romData, 
                            int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     RomMapperObsonet* rm;
 
     rm = malloc(sizeof(RomMapperObsonet));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_OBSONET, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, read, peek, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_OBSONET, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, read, peek, write, destroy, rm);
 
-    rm->amdFlash = amdFlashCreate(AMD_TYPE_1, 0x80000, 0x10000, 0, romData, size, sramCreateFilenameWithSuffix("obsonet.rom", "", ".rom"), 0);
+    rm->amdFlash = amdFlashCreate(board, AMD_TYPE_1, 0x80000, 0x10000, 0, romData, size, sramCreateFilenameWithSuffix("obsonet.rom", "", ".rom"), 0);
     rm->slot  = slot;
     rm->sslot = sslot;
     rm->startPage  = startPage;
 
-    rm->rtl8019 = rtl8019Create();
+    rm->rtl8019 = rtl8019Create(board);
 
     rm->flashPage = amdFlashGetPage(rm->amdFlash, 0);
 
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, rm->flashPage, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, NULL, 0, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, NULL, 0, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 3, NULL, 0, 0);
+    // Only the registers at 0x7fe0 - 0x7fff need the read handler
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 0, rm->flashPage, 1, 0);
+    slotMapPageIo(board, rm->slot, rm->sslot, rm->startPage + 1, rm->flashPage + 0x2000, 0x1fe0, 0x20);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 2, NULL, 0, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 3, NULL, 0, 0);
 
     reset(rm);
 
@@ -39,6 +39,7 @@
 #include <stdio.h>
 
 typedef struct {
+    BoardContext* board;
     UInt8   biosLatch;
 
     int     slot;
@@ -54,26 +55,26 @@ typedef struct {
 
 static void saveState(RomMapperOpcodeBios* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperOpcodeBios");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperOpcodeBios");
     saveStateSet(state, "biosLatch",  rm->biosLatch);
     saveStateClose(state);
 }
 
 static void loadState(RomMapperOpcodeBios* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperOpcodeBios");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperOpcodeBios");
     rm->biosLatch       = (UInt8)saveStateGet(state, "biosLatch",  0);
     saveStateClose(state);
 
-    slotMapPage(rm->slot, rm->sslot, 0, rm->biosRom + rm->biosLatch * 0x2000, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, 0, rm->biosRom + rm->biosLatch * 0x2000, 1, 0);
 }
 
 static void destroy(RomMapperOpcodeBios* rm)
 {
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
-    ioPortUnregister(0x40);
+    ioPortUnregister(rm->board, 0x40);
 
     free(rm);
 }
@@ -91,13 +92,13 @@ static UInt8 read(RomMapperOpcodeBios* rm, UInt16 ioPort)
 static void write(RomMapperOpcodeBios* rm, UInt16 ioPort, UInt8 value)
 {
     rm->biosLatch = value & 0x03;
-    slotMapPage(rm->slot, rm->sslot, 0, rm->biosRom + rm->biosLatch * 0x2000, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, 0, rm->biosRom + rm->biosLatch * 0x2000, 1, 0);
 }
 
 static void reset(RomMapperOpcodeBios* rm)
 {
     rm->biosLatch       = 0;
-    slotMapPage(rm->slot, rm->sslot, 0, rm->biosRom + rm->biosLatch * 0x2000, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, 0, rm->biosRom + rm->biosLatch * 0x2000, 1, 0);
 }
 
 static void getDebugInfo(RomMapperOpcodeBios* rm, DbgDevice* dbgDevice)
@@ -110,7 +111,7 @@ static void getDebugInfo(RomMapperOpcodeBios* rm, DbgDevice* dbgDevice)
     dbgDeviceAddMemoryBlock(dbgDevice, "BIOS", 0, 0, sizeof(rm->biosRom), rm->biosRom);
 }
 
-int romMapperOpcodeBiosCreate(const char* filename, UInt8* romData, 
+int romMapperOpcodeBiosCreate(BoardContext* board, const char* filename, UInt8* romData, 
                               int size, int slot, int sslot, 
                               int startPage) 
 {
@@ -119,6 +120,8 @@ int romMapperOpcodeBiosCreate(const char* filename, UInt8* romData,
     
     RomMapperOpcodeBios* rm = malloc(sizeof(RomMapperOpcodeBios));
     
+    rm->board = board;
+
     rm->slot      = slot;
     rm->sslot     = sslot;
     rm->startPage = startPage;
@@ -132,10 +135,10 @@ int romMapperOpcodeBiosCreate(const char* filename, UInt8* romData,
         memcpy(rm->biosRom, romData, size);
     }
 
-    rm->deviceHandle = deviceManagerRegister(ROM_OPCODEBIOS, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, "BIOS", &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_OPCODEBIOS, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, "BIOS", &dbgCallbacks, rm);
 
-    ioPortRegister(0x40, read, write, rm);
+    ioPortRegister(board, 0x40, read, write, rm);
 
     reset(rm);
 
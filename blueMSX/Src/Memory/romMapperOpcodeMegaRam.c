@@ -39,6 +39,7 @@
 #include <stdio.h>
 
 typedef struct {
+    BoardContext* board;
     UInt8   megaRamLatch[4];
 
     int     slot;
@@ -57,13 +58,13 @@ static void slotUpdate(RomMapperOpcodeMegaRam* rm)
     int i;
 
     for (i = 0; i < 4; i++) {
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->megaRam + 0x2000 * rm->megaRamLatch[i], 1, 1);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->megaRam + 0x2000 * rm->megaRamLatch[i], 1, 1);
     }
 }
 
 static void saveState(RomMapperOpcodeMegaRam* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperOpcodeMegaRam");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperOpcodeMegaRam");
 
     saveStateSet(state, "megaRamLatch0", rm->megaRamLatch[0]);
     saveStateSet(state, "megaRamLatch1", rm->megaRamLatch[1]);
@@ -77,7 +78,7 @@ static void saveState(RomMapperOpcodeMegaRam* rm)
 
 static void loadState(RomMapperOpcodeMegaRam* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperOpcodeMegaRam");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperOpcodeMegaRam");
 
     rm->megaRamLatch[0] = (UInt8)saveStateGet(state, "megaRamLatch0",  0);
     rm->megaRamLatch[1] = (UInt8)saveStateGet(state, "megaRamLatch1",  0);
@@ -93,13 +94,13 @@ static void loadState(RomMapperOpcodeMegaRam* rm)
 
 static void destroy(RomMapperOpcodeMegaRam* rm)
 {
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
-    ioPortUnregister(0x48);
-    ioPortUnregister(0x49);
-    ioPortUnregister(0x4a);
-    ioPortUnregister(0x4b);
+    ioPortUnregister(rm->board, 0x48);
+    ioPortUnregister(rm->board, 0x49);
+    ioPortUnregister(rm->board, 0x4a);
+    ioPortUnregister(rm->board, 0x4b);
 
     free(rm);
 }
@@ -144,26 +145,28 @@ static void getDebugInfo(RomMapperOpcodeMegaRam* rm, DbgDevice* dbgDevice)
     dbgDeviceAddMemoryBlock(dbgDevice, "Mega Ram", 0, 0, sizeof(rm->megaRam), rm->megaRam);
 }
 
-int romMapperOpcodeMegaRamCreate(int slot, int sslot, int startPage) 
+int romMapperOpcodeMegaRamCreate(BoardContext* board, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     
     RomMapperOpcodeMegaRam* rm = malloc(sizeof(RomMapperOpcodeMegaRam));
     
+    rm->board = board;
+
     rm->slot      = slot;
     rm->sslot     = sslot;
     rm->startPage = startPage;
     
     memset(rm->megaRam, 0xff, sizeof(rm->megaRam));
 
-    rm->deviceHandle = deviceManagerRegister(ROM_OPCODEMEGA, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_RAM, "MEGARAM", &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_OPCODEMEGA, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_RAM, "MEGARAM", &dbgCallbacks, rm);
 
-    ioPortRegister(0x48, read, write, rm);
-    ioPortRegister(0x49, read, write, rm);
-    ioPortRegister(0x4a, read, write, rm);
-    ioPortRegister(0x4b, read, write, rm);
+    ioPortRegister(board, 0x48, read, write, rm);
+    ioPortRegister(board, 0x49, read, write, rm);
+    ioPortRegister(board, 0x4a, read, write, rm);
+    ioPortRegister(board, 0x4b, read, write, rm);
 
     reset(rm);
 
@@ -30,6 +30,6 @@
  
 #include "MsxTypes.h"
 
-int romMapperOpcodeMegaRamCreate(int slot, int sslot, int startPage);
+int romMapperOpcodeMegaRamCreate(BoardContext* board, int slot, int sslot, int startPage);
 
 #endif
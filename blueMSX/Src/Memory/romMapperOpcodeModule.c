@@ -39,6 +39,7 @@
 #include <stdio.h>
 
 typedef struct {
+    BoardContext* board;
     UInt8   slotSelect;
     UInt8   biosLatch;
     UInt8   megaRamLatch[4];
@@ -71,24 +72,24 @@ static void slotUpdate(RomMapperOpcodeModule* rm)
     UInt8 slotSelect = rm->slotSelect;
     int i;
 
-    slotMapPage(rm->slot, rm->sslot, 0, rm->biosRom + rm->biosLatch * 0x2000, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, 1, rm->ram + 0x0000, 1, 1);
-    slotMapPage(rm->slot, rm->sslot, 2, rm->ram + 0x2000, 1, 1);
-    slotMapPage(rm->slot, rm->sslot, 3, rm->ram + 0x4000, 1, 1);
+    slotMapPage(rm->board, rm->slot, rm->sslot, 0, rm->biosRom + rm->biosLatch * 0x2000, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, 1, rm->ram + 0x0000, 1, 1);
+    slotMapPage(rm->board, rm->slot, rm->sslot, 2, rm->ram + 0x2000, 1, 1);
+    slotMapPage(rm->board, rm->slot, rm->sslot, 3, rm->ram + 0x4000, 1, 1);
 
     for (i = 0; i < 4; i++, slotSelect >>= 2) {
         switch (slotSelect & 3) {
         case SLOT_CARTRIDGE:
-            slotMapPage(rm->slot, rm->sslot, 4 + i, rm->rom + 0x2000 * i, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, 4 + i, rm->rom + 0x2000 * i, 1, 0);
             break;
         case SLOT_MEGARAM:
-            slotMapPage(rm->slot, rm->sslot, 4 + i, rm->megaRam + 0x2000 * rm->megaRamLatch[i], 1, 1);
+            slotMapPage(rm->board, rm->slot, rm->sslot, 4 + i, rm->megaRam + 0x2000 * rm->megaRamLatch[i], 1, 1);
             break;
         case SLOT_SAVERAM:
-            slotMapPage(rm->slot, rm->sslot, 4 + i, rm->saveRam + 0x2000 * i, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, 4 + i, rm->saveRam + 0x2000 * i, 1, 0);
             break;
         case SLOT_EMPTY:
-            slotMapPage(rm->slot, rm->sslot, 4 + i, NULL, 0, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, 4 + i, NULL, 0, 0);
             break;
         }
     }
@@ -96,7 +97,7 @@ static void slotUpdate(RomMapperOpcodeModule* rm)
 
 static void saveState(RomMapperOpcodeModule* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperOpcodeModule");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperOpcodeModule");
 
     saveStateSet(state, "biosLatch",  rm->biosLatch);
     saveStateSet(state, "slotSelect", rm->slotSelect);
@@ -115,7 +116,7 @@ static void saveState(RomMapperOpcodeModule* rm)
 
 static void loadState(RomMapperOpcodeModule* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperOpcodeModule");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperOpcodeModule");
 
     rm->biosLatch       = (UInt8)saveStateGet(state, "biosLatch",  0);
     rm->slotSelect      = (UInt8)saveStateGet(state, "slotSelect",  0);
@@ -136,12 +137,12 @@ static void loadState(RomMapperOpcodeModule* rm)
 static void destroy(RomMapperOpcodeModule* rm)
 {
     int i;
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
     ay8910Destroy(rm->ay8910);
 
     for (i = 0; i < 16; i++) {
-        ioPortUnregister(0x60 + i);
+        ioPortUnregister(rm->board, 0x60 + i);
     }
 
     free(rm);
@@ -175,7 +176,7 @@ static void write(RomMapperOpcodeModule* rm, UInt16 ioPort, UInt8 value)
     switch (ioPort) {
     case 0x40:
         rm->biosLatch = value & 0x03;
-        slotMapPage(rm->slot, rm->sslot, 0, rm->biosRom + rm->biosLatch * 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, 0, rm->biosRom + rm->biosLatch * 0x2000, 1, 0);
         break;
     case 0x48:
     case 0x49:
@@ -221,7 +222,7 @@ static void getDebugInfo(RomMapperOpcodeModule* rm, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 0, 0x40, DBG_IO_READWRITE, peek(rm, 0x40));
 }
 
-int romMapperOpcodeModuleCreate(char* filename, UInt8* romData, 
+int romMapperOpcodeModuleCreate(BoardContext* board, char* filename, UInt8* romData, 
                                 int size, int slot, int sslot, 
                                 int startPage,
                                 void* biosRom, int biosSize) 
@@ -231,6 +232,8 @@ int romMapperOpcodeModuleCreate(char* filename, UInt8* romData,
     
     RomMapperOpcodeModule* rm = malloc(sizeof(RomMapperOpcodeModule));
     
+    rm->board = board;
+
     rm->slot      = slot;
     rm->sslot     = sslot;
     rm->startPage = startPage;
@@ -255,15 +258,15 @@ int romMapperOpcodeModuleCreate(char* filename, UInt8* romData,
         memcpy(rm->rom, romData, size);
     }
 
-    rm->deviceHandle = deviceManagerRegister(ROM_OPCODEPSG, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_AUDIO, "AY8910", &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_OPCODEPSG, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_AUDIO, "AY8910", &dbgCallbacks, rm);
 
-    rm->ay8910 = ay8910Create(boardGetMixer(), AY8910_MSX, PSGTYPE_AY8910, 0, NULL);
+    rm->ay8910 = ay8910Create(board, boardGetMixer(board), AY8910_MSX, PSGTYPE_AY8910, 0, NULL);
 
-    ioPortRegister(0x40, read, write, rm);
-    ioPortRegister(0x50, NULL, write, rm);
-    ioPortRegister(0x51, NULL, write, rm);
-    ioPortRegister(0x52, read, NULL, rm);
+    ioPortRegister(board, 0x40, read, write, rm);
+    ioPortRegister(board, 0x50, NULL, write, rm);
+    ioPortRegister(board, 0x51, NULL, write, rm);
+    ioPortRegister(board, 0x52, read, NULL, rm);
 
     reset(rm);
 
@@ -30,7 +30,7 @@
  
 #include "MsxTypes.h"
 
-int romMapperOpcodeModuleCreate(char* filename, UInt8* romData, 
+int romMapperOpcodeModuleCreate(BoardContext* board, char* filename, UInt8* romData, 
                                 int size, int slot, int sslot, 
                                 int startPage,
                                 void* biosRom, int biosSize);
@@ -38,6 +38,7 @@
 #include <stdio.h>
 
 typedef struct {
+    BoardContext* board;
     AY8910* ay8910;
     int    deviceHandle;
     int    debugHandle;
@@ -55,13 +56,13 @@ static void loadState(RomMapperOpcodePsg* rm)
 
 static void destroy(RomMapperOpcodePsg* rm)
 {
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
     ay8910Destroy(rm->ay8910);
 
-    ioPortUnregister(0x50);
-    ioPortUnregister(0x51);
-    ioPortUnregister(0x52);
+    ioPortUnregister(rm->board, 0x50);
+    ioPortUnregister(rm->board, 0x51);
+    ioPortUnregister(rm->board, 0x52);
 
     free(rm);
 }
@@ -102,20 +103,22 @@ static void getDebugInfo(RomMapperOpcodePsg* rm, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 2, 0x52, DBG_IO_READ,  peek(rm, 0x52));
 }
 
-int romMapperOpcodePsgCreate() 
+int romMapperOpcodePsgCreate(BoardContext* board) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     RomMapperOpcodePsg* rm = malloc(sizeof(RomMapperOpcodePsg));
 
-    rm->deviceHandle = deviceManagerRegister(ROM_OPCODEPSG, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_AUDIO, "AY8910", &dbgCallbacks, rm);
+    rm->board = board;
 
-    rm->ay8910 = ay8910Create(boardGetMixer(), AY8910_MSX, PSGTYPE_AY8910, 0, NULL);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_OPCODEPSG, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_AUDIO, "AY8910", &dbgCallbacks, rm);
 
-    ioPortRegister(0x50, NULL, write, rm);
-    ioPortRegister(0x51, NULL, write, rm);
-    ioPortRegister(0x52, read, NULL, rm);
+    rm->ay8910 = ay8910Create(board, boardGetMixer(board), AY8910_MSX, PSGTYPE_AY8910, 0, NULL);
+
+    ioPortRegister(board, 0x50, NULL, write, rm);
+    ioPortRegister(board, 0x51, NULL, write, rm);
+    ioPortRegister(board, 0x52, read, NULL, rm);
 
     reset(rm);
 
@@ -30,6 +30,6 @@
  
 #include "MsxTypes.h"
 
-int romMapperOpcodePsgCreate();
+int romMapperOpcodePsgCreate(BoardContext* board);
 
 #endif
@@ -40,6 +40,7 @@
 #include <stdio.h>
 
 typedef struct {
+    BoardContext* board;
     int     slot;
     int     sslot;
     int     startPage;
@@ -58,7 +59,7 @@ typedef struct {
 
 static void saveState(RomMapperOpcodeSaveRam* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperOpcodeSaveRam");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperOpcodeSaveRam");
 
     
     saveStateSetBuffer(state, "saveRam", rm->saveRam, 0x8000);
@@ -68,7 +69,7 @@ static void saveState(RomMapperOpcodeSaveRam* rm)
 
 static void loadState(RomMapperOpcodeSaveRam* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperOpcodeSaveRam");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperOpcodeSaveRam");
     
     saveStateGetBuffer(state, "saveRam", rm->saveRam, 0x8000);
 
@@ -79,8 +80,8 @@ static void destroy(RomMapperOpcodeSaveRam* rm)
 {
     sramSave(rm->saveRamFilename, rm->saveRam, sizeof(rm->saveRam), NULL, 0);
 
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
     free(rm);
 }
@@ -134,28 +135,30 @@ static void getDebugInfo(RomMapperOpcodeSaveRam* rm, DbgDevice* dbgDevice)
     dbgDeviceAddMemoryBlock(dbgDevice, "Save Ram", 0, 0, sizeof(rm->saveRam), rm->saveRam);
 }
 
-int romMapperOpcodeSaveRamCreate(int slot, int sslot, int startPage) 
+int romMapperOpcodeSaveRamCreate(BoardContext* board, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     
     RomMapperOpcodeSaveRam* rm = malloc(sizeof(RomMapperOpcodeSaveRam));
     
+    rm->board = board;
+
     rm->slot      = slot;
     rm->sslot     = sslot;
     rm->startPage = startPage;
     
     memset(rm->saveRam, 0xff, sizeof(rm->saveRam));
     
-    slotRegister(rm->slot, rm->sslot, rm->startPage, 4, NULL, NULL, write, destroy, rm);
+    slotRegister(board, rm->slot, rm->sslot, rm->startPage, 4, NULL, NULL, write, destroy, rm);
 
-    rm->deviceHandle = deviceManagerRegister(ROM_OPCODESAVE, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_RAM, "SAVERAM", &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_OPCODESAVE, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_RAM, "SAVERAM", &dbgCallbacks, rm);
 
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 0, rm->saveRam + 0x0000, 1, 1);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, rm->saveRam + 0x2000, 1, 1);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, rm->saveRam + 0x4000, 1, 1);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 3, rm->saveRam + 0x6000, 1, 1);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 0, rm->saveRam + 0x0000, 1, 1);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 1, rm->saveRam + 0x2000, 1, 1);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 2, rm->saveRam + 0x4000, 1, 1);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 3, rm->saveRam + 0x6000, 1, 1);
 
     strcpy(rm->saveRamFilename, sramCreateFilename("SaveRam"));
 
@@ -30,6 +30,6 @@
 
 #include "MsxTypes.h"
 
-int romMapperOpcodeSaveRamCreate(int slot, int sslot, int startPage);
+int romMapperOpcodeSaveRamCreate(BoardContext* board, int slot, int sslot, int startPage);
 
 #endif
@@ -39,6 +39,7 @@
 #include <stdio.h>
 
 typedef struct {
+    BoardContext* board;
     UInt8   slotSelect;
 
     int    deviceHandle;
@@ -51,30 +52,30 @@ static void slotUpdate(RomMapperOpcodeSlotManager* rm)
     int i;
 
     for (i = 0; i < 4; i++) {
-        slotMapRamPage((rm->slotSelect >> (2 * i)) & 3, 0, 4 + i);
+        slotMapRamPage(rm->board, (rm->slotSelect >> (2 * i)) & 3, 0, 4 + i);
     }
 }
 
 static void saveState(RomMapperOpcodeSlotManager* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperOpcodeSlotManager");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperOpcodeSlotManager");
     saveStateSet(state, "slotSelect", rm->slotSelect);
     saveStateClose(state);
 }
 
 static void loadState(RomMapperOpcodeSlotManager* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperOpcodeSlotManager");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperOpcodeSlotManager");
     rm->slotSelect      = (UInt8)saveStateGet(state, "slotSelect",  0);
     saveStateClose(state);
 }
 
 static void destroy(RomMapperOpcodeSlotManager* rm)
 {
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
-    ioPortUnregister(0x41);
+    ioPortUnregister(rm->board, 0x41);
 
     free(rm);
 }
@@ -109,17 +110,19 @@ static void getDebugInfo(RomMapperOpcodeSlotManager* rm, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 0, 0x41, DBG_IO_READWRITE, peek(rm, 0x41));
 }
 
-int romMapperOpcodeSlotManagerCreate() 
+int romMapperOpcodeSlotManagerCreate(BoardContext* board) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     
     RomMapperOpcodeSlotManager* rm = malloc(sizeof(RomMapperOpcodeSlotManager));
 
-    rm->deviceHandle = deviceManagerRegister(ROM_OPCODESLOT, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, "SLOTSELECT", &dbgCallbacks, rm);
+    rm->board = board;
 
-    ioPortRegister(0x41, read, write, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_OPCODESLOT, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, "SLOTSELECT", &dbgCallbacks, rm);
+
+    ioPortRegister(board, 0x41, read, write, rm);
 
     reset(rm);
 
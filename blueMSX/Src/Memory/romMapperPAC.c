@@ -39,6 +39,7 @@
 static char pacHeader[] = "PAC2 BACKUP DATA";
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8 reg1ffe;
     UInt8 reg1fff;
@@ -52,7 +53,7 @@ typedef struct {
 
 static void saveState(RomMapperPAC* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperPAC");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperPAC");
 
     saveStateSetBuffer(state, "sram", rm->sram, sizeof(rm->sram));
     
@@ -61,7 +62,7 @@ static void saveState(RomMapperPAC* rm)
 
 static void loadState(RomMapperPAC* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperPAC");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperPAC");
 
     saveStateGetBuffer(state, "sram", rm->sram, sizeof(rm->sram));
     
@@ -70,10 +71,10 @@ static void loadState(RomMapperPAC* rm)
     rm->sramEnabled = rm->sram[0x1ffe] == 0x4d && rm->sram[0x1fff] == 0x69;
 
     if (rm->sramEnabled) {
-        slotMapPage(rm->slot, rm->sslot, rm->startPage, rm->sram, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage, rm->sram, 1, 0);
     }
     else {
-        slotUnmapPage(rm->slot, rm->sslot, rm->startPage);
+        slotUnmapPage(rm->board, rm->slot, rm->sslot, rm->startPage);
     }
 }
 
@@ -81,8 +82,8 @@ static void destroy(RomMapperPAC* rm)
 {
     sramSave(rm->sramFilename, rm->sram, 0x1ffe, pacHeader, strlen(pacHeader));
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm);
 }
@@ -124,24 +125,25 @@ static void write(RomMapperPAC* rm, UInt16 address, UInt8 value)
 
     if (update) {
         if (rm->sramEnabled) {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage, rm->sram, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage, rm->sram, 1, 0);
         }
         else {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage, NULL, 0, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage, NULL, 0, 0);
         }
     }
 }
 
-int romMapperPACCreate(const char* filename, UInt8* romData, 
+int romMapperPACCreate(BoardContext* board, const char* filename, UInt8* romData, 
                          int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
     RomMapperPAC* rm;
 
     rm = malloc(sizeof(RomMapperPAC));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_PAC, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 2, read, read, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_PAC, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 2, read, read, write, destroy, rm);
 
     memset(rm->sram, 0xff, 0x2000);
     rm->slot  = slot;
@@ -152,8 +154,8 @@ int romMapperPACCreate(const char* filename, UInt8* romData,
 
     sramLoad(rm->sramFilename, rm->sram, 0x1ffe, pacHeader, strlen(pacHeader));
 
-    slotMapPage(rm->slot, rm->sslot, rm->startPage,     NULL, 0, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, NULL, 0, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage,     NULL, 0, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 1, NULL, 0, 0);
 
     return 1;
 }
@@ -43,6 +43,7 @@ enum {
 };
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     UInt8* sram;
@@ -73,7 +74,7 @@ static void changeBank(RomMapperPanasonic* rm, int region, int bank);
 
 static void saveState(RomMapperPanasonic* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperPanasonic");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperPanasonic");
     char tag[16];
     int i;
 
@@ -92,7 +93,7 @@ static void saveState(RomMapperPanasonic* rm)
 
 static void loadState(RomMapperPanasonic* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperPanasonic");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperPanasonic");
     int romMapper[8];
     char tag[16];
     int i;
@@ -118,7 +119,7 @@ static void loadState(RomMapperPanasonic* rm)
         rm->readBlock = rm->sram + rm->readOffset;
         break;
     case READ_RAM:
-        rm->readBlock = boardGetRamPage(rm->readOffset);
+        rm->readBlock = boardGetRamPage(rm->board, rm->readOffset);
         if (rm->readBlock == NULL) {
             rm->readBlock = emptyRam;
         }
@@ -133,8 +134,8 @@ static void destroy(RomMapperPanasonic* rm)
 {
     sramSave(rm->sramFilename, rm->sram, rm->sramSize, NULL, 0);
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     panasonicSramDestroy();
 
@@ -156,12 +157,12 @@ static void changeBank(RomMapperPanasonic* rm, int region, int bank)
             rm->readOffset = offset;
             rm->readBlock = rm->sram + offset;
         }
-        slotMapPage(rm->slot, rm->sslot, region, rm->sram + offset, region != 3, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, region, rm->sram + offset, region != 3, 0);
 	} 
     else if (bank >= RAM_BASE) {
         UInt8* ram;
 
-        ram = boardGetRamPage(bank - RAM_BASE);
+        ram = boardGetRamPage(rm->board, bank - RAM_BASE);
         if (ram == NULL) {
             ram = emptyRam;
         }
@@ -172,7 +173,7 @@ static void changeBank(RomMapperPanasonic* rm, int region, int bank)
             rm->readBlock = ram;
         }
 
-        slotMapPage(rm->slot, rm->sslot, region, ram, region != 3, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, region, ram, region != 3, 0);
 	} 
     else {
 		int offset = bank * 0x2000 & (rm->romSize - 1);
@@ -181,7 +182,7 @@ static void changeBank(RomMapperPanasonic* rm, int region, int bank)
             rm->readOffset = offset;
             rm->readBlock = rm->romData + offset;
         }
-        slotMapPage(rm->slot, rm->sslot, region, rm->romData + offset, region != 3, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, region, rm->romData + offset, region != 3, 0);
 	}
 }
 
@@ -220,7 +221,7 @@ static UInt8 read(RomMapperPanasonic* rm, UInt16 address)
         return rm->sram[offset + (address & 0x1fff)];
 	} 
     if (bank >= RAM_BASE) {
-        UInt8* ram = boardGetRamPage(bank - RAM_BASE);
+        UInt8* ram = boardGetRamPage(rm->board, bank - RAM_BASE);
         if (ram == NULL) {
             ram = emptyRam;
         }
@@ -274,7 +275,7 @@ static void write(RomMapperPanasonic* rm, UInt16 address, UInt8 value)
             rm->sram[offset + (address & 0x1fff)] = value;
 		} 
         else if (bank >= RAM_BASE) {
-            UInt8* ram = boardGetRamPage(bank - RAM_BASE);
+            UInt8* ram = boardGetRamPage(rm->board, bank - RAM_BASE);
             if (ram != NULL) {
                 ram[address & 0x1fff] = value;
             }
@@ -290,11 +291,11 @@ static void reset(RomMapperPanasonic* rm)
     
     for (i = 0; i < rm->mappedSlots; i++) {
         rm->romMapper[i] = 0;
-        slotMapPage(rm->slot, rm->sslot, i, rm->romData, i != 3, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, i, rm->romData, i != 3, 0);
     }
 }
 
-int romMapperPanasonicCreate(const char* filename, UInt8* romData, 
+int romMapperPanasonicCreate(BoardContext* board, const char* filename, UInt8* romData, 
                              int size, int slot, int sslot, int startPage,
                              int sramSize, int mappedSlots) 
 {
@@ -310,6 +311,7 @@ int romMapperPanasonicCreate(const char* filename, UInt8* romData,
     memset(emptyRam, 0xff, sizeof(emptyRam));
 
     rm = malloc(sizeof(RomMapperPanasonic));
+    rm->board = board;
 
     rm->mappedSlots = mappedSlots;
 
@@ -330,8 +332,8 @@ int romMapperPanasonicCreate(const char* filename, UInt8* romData,
         }
     }
 
-    rm->deviceHandle = deviceManagerRegister(romType, &callbacks, rm);
-    slotRegister(slot, sslot, 0, rm->mappedSlots, read, read, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, romType, &callbacks, rm);
+    slotRegister(board, slot, sslot, 0, rm->mappedSlots, read, read, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -30,7 +30,7 @@
  
 #include "MsxTypes.h"
 
-int romMapperPanasonicCreate(const char* filename, UInt8* romData, 
+int romMapperPanasonicCreate(BoardContext* board, const char* filename, UInt8* romData, 
                              int size, int slot, int sslot, int startPage, 
                              int sramSize, int mappedSlots);
 
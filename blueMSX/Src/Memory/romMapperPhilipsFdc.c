@@ -38,6 +38,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     WD2793* fdc;
@@ -50,7 +51,7 @@ typedef struct {
 
 static void saveState(RomMapperPhilipsFdc* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperPhilipsFdc");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperPhilipsFdc");
 
     saveStateSet(state, "sideReg",  rm->sideReg);
     saveStateSet(state, "driveReg", rm->driveReg);
@@ -62,7 +63,7 @@ static void saveState(RomMapperPhilipsFdc* rm)
 
 static void loadState(RomMapperPhilipsFdc* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperPhilipsFdc");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperPhilipsFdc");
 
     rm->sideReg  = (UInt8)saveStateGet(state, "sideReg",  0);
     rm->driveReg = (UInt8)saveStateGet(state, "driveReg", 0);
@@ -75,8 +76,8 @@ static void loadState(RomMapperPhilipsFdc* rm)
 static void destroy(RomMapperPhilipsFdc* rm)
 {
     wd2793Destroy(rm->fdc);
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -175,7 +176,7 @@ static void reset(RomMapperPhilipsFdc* rm)
     write(rm, 0xffd, 0);
 }
 
-int romMapperPhilipsFdcCreate(const char* filename, UInt8* romData, 
+int romMapperPhilipsFdcCreate(BoardContext* board, const char* filename, UInt8* romData, 
                               int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
@@ -188,9 +189,10 @@ int romMapperPhilipsFdcCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperPhilipsFdc));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_PHILIPSFDC, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, pages, read, peek, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_PHILIPSFDC, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, pages, read, peek, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -202,10 +204,16 @@ int romMapperPhilipsFdcCreate(const char* filename, UInt8* romData,
     rm->driveReg = 0;
 
     for (i = 0; i < pages; i++) {
-        slotMapPage(slot, sslot, i + startPage, NULL, 0, 0);
+        slotMapPage(board, slot, sslot, i + startPage, NULL, 0, 0);
     }
 
-    rm->fdc = wd2793Create(FDC_TYPE_WD2793);
+    // The rom is read directly, except for the fdc registers at its end
+    if (size >= 0x4000) {
+        slotMapPage(board, slot, sslot, startPage, rm->romData, 1, 0);
+        slotMapPageIo(board, slot, sslot, startPage + 1, rm->romData + 0x2000, 0x1ff8, 8);
+    }
+
+    rm->fdc = wd2793Create(board, FDC_TYPE_WD2793);
 
     reset(rm);
 
@@ -36,6 +36,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -48,8 +49,8 @@ static void destroy(void* arg)
 {
     RomMapperPlain* rm = (RomMapperPlain*)arg;
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -98,7 +99,7 @@ static UInt16 getRomStart(UInt8* romData, int size)
 }
 
 
-int romMapperPlainCreate(const char* filename, UInt8* romData, 
+int romMapperPlainCreate(BoardContext* board, const char* filename, UInt8* romData, 
                          int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, NULL, NULL };
@@ -111,6 +112,7 @@ int romMapperPlainCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperPlain));
+    rm->board = board;
 
     rm->romData = malloc(0x10000);
     memset(rm->romData, 0xff, 0x10000);
@@ -192,11 +194,11 @@ int romMapperPlainCreate(const char* filename, UInt8* romData,
         return 0;
     }
 
-    rm->deviceHandle = deviceManagerRegister(ROM_PLAIN, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 8, NULL, NULL, NULL, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_PLAIN, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 8, NULL, NULL, NULL, destroy, rm);
 
     for (i = 0; i < 8; i++) {
-        slotMapPage(slot, sslot, startPage + i, rm->romData + 0x2000 * romMapper[i], 1, 0);
+        slotMapPage(board, slot, sslot, startPage + i, rm->romData + 0x2000 * romMapper[i], 1, 0);
     }
 
     return 1;
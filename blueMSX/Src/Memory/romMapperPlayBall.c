@@ -37,6 +37,7 @@
 #include <stdio.h>
 
 typedef struct {
+    BoardContext* board;
     SamplePlayer* samplePlayer;
     int deviceHandle;
     UInt8* romData;
@@ -50,26 +51,27 @@ typedef struct {
 
 static void destroy(RomMapperPlayBall* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
     free(rm->romData);
     free(rm);
 }
 
-int romMapperPlayBallCreate(const char* filename, UInt8* romData, 
+int romMapperPlayBallCreate(BoardContext* board, const char* filename, UInt8* romData, 
                           int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, NULL, NULL };
     RomMapperPlayBall* rm;
 
     rm = malloc(sizeof(RomMapperPlayBall));
+    rm->board = board;
 
     if (size > 0x8000) {
         size = 0x8000;
     }
 
-    rm->deviceHandle = deviceManagerRegister(ROM_PLAYBALL, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, NULL, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_PLAYBALL, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, NULL, destroy, rm);
 
     rm->romData = malloc(0x8000);
     memset(rm->romData + size, 0xff, 0x8000 - size);
@@ -79,10 +81,10 @@ int romMapperPlayBallCreate(const char* filename, UInt8* romData,
     rm->sslot = sslot;
     rm->startPage  = startPage;
 
-    slotMapPage(rm->slot, rm->sslot, rm->startPage,     rm->romData + 0x0000, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, rm->romData + 0x2000, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, rm->romData + 0x4000, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 3, rm->romData + 0x6000, 0, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage,     rm->romData + 0x0000, 1, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 1, rm->romData + 0x2000, 1, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 2, rm->romData + 0x4000, 1, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 3, rm->romData + 0x6000, 0, 0);
 
     return 1;
 }
@@ -94,8 +96,8 @@ int romMapperPlayBallCreate(const char* filename, UInt8* romData,
 static void destroy(RomMapperPlayBall* rm)
 {
     samplePlayerDestroy(rm->samplePlayer);
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
     free(rm->romData);
     free(rm);
 }
@@ -136,22 +138,23 @@ static void write(RomMapperPlayBall* rm, UInt16 address, UInt8 value)
     }
 }
 
-int romMapperPlayBallCreate(const char* filename, UInt8* romData, 
+int romMapperPlayBallCreate(BoardContext* board, const char* filename, UInt8* romData, 
                           int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, NULL, NULL };
     RomMapperPlayBall* rm;
 
     rm = malloc(sizeof(RomMapperPlayBall));
+    rm->board = board;
 
-    rm->samplePlayer = samplePlayerCreate(boardGetMixer(), MIXER_CHANNEL_PCM, 8, 11025);
+    rm->samplePlayer = samplePlayerCreate(boardGetMixer(board), MIXER_CHANNEL_PCM, 8, 11025);
 
     if (size > 0x8000) {
         size = 0x8000;
     }
 
-    rm->deviceHandle = deviceManagerRegister(ROM_PLAYBALL, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, read, read, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_PLAYBALL, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, read, read, write, destroy, rm);
 
     rm->romData = malloc(0x8000);
     memset(rm->romData + size, 0xff, 0x8000 - size);
@@ -161,10 +164,11 @@ int romMapperPlayBallCreate(const char* filename, UInt8* romData,
     rm->sslot = sslot;
     rm->startPage  = startPage;
 
-    slotMapPage(rm->slot, rm->sslot, rm->startPage,     rm->romData + 0x0000, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, rm->romData + 0x2000, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, rm->romData + 0x4000, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + 3, rm->romData + 0x6000, 0, 0);
+    // Only the sample player status at 0xbfff needs the read handler
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage,     rm->romData + 0x0000, 1, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 1, rm->romData + 0x2000, 1, 0);
+    slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 2, rm->romData + 0x4000, 1, 0);
+    slotMapPageIo(board, rm->slot, rm->sslot, rm->startPage + 3, rm->romData + 0x6000, 0x1fff, 1);
 
     return 1;
 }
@@ -35,6 +35,7 @@
 #include <stdio.h>
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -46,7 +47,7 @@ typedef struct {
 
 static void saveState(RomMapperRType* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperRType");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperRType");
     char tag[16];
     int i;
 
@@ -60,7 +61,7 @@ static void saveState(RomMapperRType* rm)
 
 static void loadState(RomMapperRType* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperRType");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperRType");
     char tag[16];
     int bank = 2;
     UInt8* bankData;
@@ -74,14 +75,14 @@ static void loadState(RomMapperRType* rm)
     //DINK: Nov 27, 2013 - fix for save state load at level2+
     bank = 2;
     bankData = rm->romData + (rm->romMapper[bank] << 14);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + bank,     bankData, 1, 0);
-    slotMapPage(rm->slot, rm->sslot, rm->startPage + bank + 1, bankData + 0x2000, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank,     bankData, 1, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank + 1, bankData + 0x2000, 1, 0);
 }
 
 static void destroy(RomMapperRType* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -105,12 +106,12 @@ static void write(RomMapperRType* rm, UInt16 address, UInt8 value)
         
         rm->romMapper[bank] = value;
 
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank,     bankData, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank + 1, bankData + 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank,     bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank + 1, bankData + 0x2000, 1, 0);
     }
 }
 
-int romMapperRTypeCreate(const char* filename, UInt8* romData, 
+int romMapperRTypeCreate(BoardContext* board, const char* filename, UInt8* romData, 
                          int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -122,9 +123,10 @@ int romMapperRTypeCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperRType));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_RTYPE, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_RTYPE, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -139,8 +141,8 @@ int romMapperRTypeCreate(const char* filename, UInt8* romData,
     rm->romMapper[3] = 1;
 
     for (i = 0; i < 4; i += 2) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i,     rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 1, rm->romData + rm->romMapper[i] * 0x2000 + 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i,     rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i + 1, rm->romData + rm->romMapper[i] * 0x2000 + 0x2000, 1, 0);
     }
 
     return 1;
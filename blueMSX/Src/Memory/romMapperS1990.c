@@ -37,9 +37,10 @@
 #include <string.h>
 #include <stdio.h>
 
-extern void msxSetCpu(int mode);
+extern void msxSetCpu(BoardContext* board, int mode);
 
 typedef struct {
+    BoardContext* board;
     int   deviceHandle;
     int   debugHandle;
 	UInt8 registerSelect;
@@ -48,7 +49,7 @@ typedef struct {
 
 static void saveState(RomMapperS1990* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperS1990");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperS1990");
 
     saveStateSet(state, "registerSelect",  rm->registerSelect);
     saveStateSet(state, "cpuStatus",       rm->cpuStatus);
@@ -58,7 +59,7 @@ static void saveState(RomMapperS1990* rm)
 
 static void loadState(RomMapperS1990* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperS1990");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperS1990");
 
     rm->registerSelect = (UInt8)saveStateGet(state, "registerSelect",  0);
     rm->cpuStatus      = (UInt8)saveStateGet(state, "cpuStatus",       0);
@@ -68,11 +69,11 @@ static void loadState(RomMapperS1990* rm)
 
 static void destroy(RomMapperS1990* rm)
 {
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
-    ioPortUnregister(0xe4);
-    ioPortUnregister(0xe5);
+    ioPortUnregister(rm->board, 0xe4);
+    ioPortUnregister(rm->board, 0xe5);
 
     free(rm);
 }
@@ -80,7 +81,7 @@ static void destroy(RomMapperS1990* rm)
 static void updateStatus(RomMapperS1990* rm, UInt8 value)
 {
 	rm->cpuStatus = value & 0x60;
-    msxSetCpu((rm->cpuStatus & 0x20) ? 0 : 1);
+    msxSetCpu(rm->board, (rm->cpuStatus & 0x20) ? 0 : 1);
     panasonicDramUpdate((rm->cpuStatus & 0x40) ? 0 : 1);
 }
 
@@ -140,19 +141,20 @@ static void getDebugInfo(RomMapperS1990* rm, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 1, 0xe5, DBG_IO_READWRITE, read(rm, 0xe5));
 }
 
-int romMapperS1990Create() 
+int romMapperS1990Create(BoardContext* board) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     RomMapperS1990* rm;
 
     rm = malloc(sizeof(RomMapperS1990));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_S1990, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, langDbgDevS1990(), &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_S1990, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, langDbgDevS1990(), &dbgCallbacks, rm);
 
-    ioPortRegister(0xe4, read, write, rm);
-    ioPortRegister(0xe5, read, write, rm);
+    ioPortRegister(board, 0xe4, read, write, rm);
+    ioPortRegister(board, 0xe5, read, write, rm);
 
     reset(rm);
 
@@ -38,6 +38,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8 romData[0x22000];
     int slot;
@@ -55,7 +56,7 @@ typedef struct {
 
 static void saveState(RomMapperSCCplus* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperSCCplus");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperSCCplus");
     char tag[16];
     int i;
 
@@ -82,7 +83,7 @@ static void saveState(RomMapperSCCplus* rm)
 
 static void loadState(RomMapperSCCplus* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperSCCplus");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperSCCplus");
     char tag[16];
     int bank;
     int i;
@@ -109,31 +110,33 @@ static void loadState(RomMapperSCCplus* rm)
 
     for (bank = 0; bank < 4; bank++) {   
         if (rm->isMapped[bank]) {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, rm->romData + 0x2000 * rm->romMapper[bank], 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, rm->romData + 0x2000 * rm->romMapper[bank], 1, 0);
         }
         else {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, rm->romData + 0x20000, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, rm->romData + 0x20000, 1, 0);
         }
     }
     
+    // Only the SCC registers at 0x9800 - 0x9fff or 0xb800 - 0xbfff need
+    // the read handler
     if (rm->sccMode == SCC_PLUS) {
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, NULL, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 3, NULL, 0, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 2, NULL, 1, 0);
+        slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + 3, NULL, 0x1800, 0x800);
     }
     else if (rm->sccMode = SCC_COMPATIBLE) {
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, NULL, 0, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 3, NULL, 1, 0);
+        slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + 2, NULL, 0x1800, 0x800);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 3, NULL, 1, 0);
     }
     else {
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, NULL, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 3, NULL, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 2, NULL, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 3, NULL, 1, 0);
     }
 }
 
 static void destroy(RomMapperSCCplus* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
     sccDestroy(rm->scc);
 
     free(rm);
@@ -191,20 +194,20 @@ static UInt8 peek(RomMapperSCCplus* rm, UInt16 address)
 static void updateEnable(RomMapperSCCplus* rm)
 {
     if ((rm->modeRegister & 0x20) && (rm->romMapper[3] & 0x80)) {
-        slotUpdatePage(rm->slot, rm->sslot, rm->startPage + 2, NULL, 1, 0);
-        slotUpdatePage(rm->slot, rm->sslot, rm->startPage + 3, NULL, 0, 0);
+        slotUpdatePage(rm->board, rm->slot, rm->sslot, rm->startPage + 2, NULL, 1, 0);
+        slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + 3, NULL, 0x1800, 0x800);
         sccSetMode(rm->scc, SCC_PLUS);
         rm->sccMode = SCC_PLUS;
     }
     else if (!(rm->modeRegister & 0x20) && (rm->romMapper[2] & 0x3f) == 0x3f) {
-        slotUpdatePage(rm->slot, rm->sslot, rm->startPage + 2, NULL, 0, 0);
-        slotUpdatePage(rm->slot, rm->sslot, rm->startPage + 3, NULL, 1, 0);
+        slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + 2, NULL, 0x1800, 0x800);
+        slotUpdatePage(rm->board, rm->slot, rm->sslot, rm->startPage + 3, NULL, 1, 0);
         sccSetMode(rm->scc, SCC_COMPATIBLE);
         rm->sccMode = SCC_COMPATIBLE;
     }
     else {
-        slotUpdatePage(rm->slot, rm->sslot, rm->startPage + 2, NULL, 1, 0);
-        slotUpdatePage(rm->slot, rm->sslot, rm->startPage + 3, NULL, 1, 0);
+        slotUpdatePage(rm->board, rm->slot, rm->sslot, rm->startPage + 2, NULL, 1, 0);
+        slotUpdatePage(rm->board, rm->slot, rm->sslot, rm->startPage + 3, NULL, 1, 0);
         rm->sccMode = SCC_NONE;
     }
 }
@@ -247,10 +250,10 @@ static void write(RomMapperSCCplus* rm, UInt16 address, UInt8 value)
                                 (value < 8  && rm->sccType != SCC_SDSNATCHER);
 
         if (rm->isMapped[bank]) {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, rm->romData + 0x2000 * value, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, rm->romData + 0x2000 * value, 1, 0);
         }
         else {
-            slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, rm->romData + 0x20000, 1, 0);
+            slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, rm->romData + 0x20000, 1, 0);
         }
 
         updateEnable(rm);
@@ -266,16 +269,17 @@ static void write(RomMapperSCCplus* rm, UInt16 address, UInt8 value)
     }
 }
 
-int romMapperSCCplusCreate(const char* filename, UInt8* romData, 
+int romMapperSCCplusCreate(BoardContext* board, const char* filename, UInt8* romData, 
                            int size, int slot, int sslot, int startPage, SccType sccType) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     RomMapperSCCplus* rm;
 
     rm = malloc(sizeof(RomMapperSCCplus));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_SCCEXTENDED, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, read, peek, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_SCCEXTENDED, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, read, peek, write, destroy, rm);
 
     memset(rm->romData, 0xff, 0x22000);
 
@@ -299,7 +303,7 @@ int romMapperSCCplusCreate(const char* filename, UInt8* romData,
     rm->isMapped[2]     = sccType != SCC_SDSNATCHER;
     rm->isMapped[3]     = sccType != SCC_SDSNATCHER;
     rm->mapperMask      = sccType == SCC_MIRRORED ? 0x07 : 0x0f;
-    rm->scc             = sccCreate(boardGetMixer());
+    rm->scc             = sccCreate(board, boardGetMixer(board));
     rm->sccType         = sccType;
     rm->sccMode         = SCC_NONE;
 
@@ -309,16 +313,16 @@ int romMapperSCCplusCreate(const char* filename, UInt8* romData,
     rm->romMapper[3] = 3;
 
     if (sccType != SCC_SDSNATCHER) {
-        slotMapPage(rm->slot, rm->sslot, rm->startPage,     rm->romData + 0x0000, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, rm->romData + 0x2000, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, rm->romData + 0x4000, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 3, rm->romData + 0x6000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage,     rm->romData + 0x0000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 1, rm->romData + 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 2, rm->romData + 0x4000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 3, rm->romData + 0x6000, 1, 0);
     }
     else {
-        slotMapPage(rm->slot, rm->sslot, rm->startPage,     rm->romData + 0x20000, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 1, rm->romData + 0x20000, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 2, rm->romData + 0x20000, 1, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + 3, rm->romData + 0x20000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage,     rm->romData + 0x20000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 1, rm->romData + 0x20000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 2, rm->romData + 0x20000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + 3, rm->romData + 0x20000, 1, 0);
     }
 
     return 1;
@@ -38,7 +38,7 @@ typedef enum {
     SCCP_EXTENDED
 } SccType;
 
-int romMapperSCCplusCreate(const char* filename, UInt8* romData, 
+int romMapperSCCplusCreate(BoardContext* board, const char* filename, UInt8* romData, 
                            int size, int slot, int sslot, int startPage,
                            SccType sccType);
 
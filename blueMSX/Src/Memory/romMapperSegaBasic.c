@@ -38,6 +38,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     UInt8* romData;
@@ -49,7 +50,7 @@ typedef struct {
 
 static void saveState(RomMapperSegaBasic* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperSegaBasic");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperSegaBasic");
 
     saveStateSetBuffer(state, "ram", rm->ram, 0x8000);
 
@@ -58,7 +59,7 @@ static void saveState(RomMapperSegaBasic* rm)
 
 static void loadState(RomMapperSegaBasic* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperSegaBasic");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperSegaBasic");
 
     saveStateGetBuffer(state, "ram", rm->ram, 0x8000);
 
@@ -67,10 +68,10 @@ static void loadState(RomMapperSegaBasic* rm)
 
 static void destroy(RomMapperSegaBasic* rm)
 {
-    debugDeviceUnregister(rm->debugHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -92,7 +93,7 @@ static int dbgWriteMemory(RomMapperSegaBasic* rm, char* name, void* data, int st
     return 1;
 }
 
-int romMapperSegaBasicCreate(const char* filename, UInt8* romData, 
+int romMapperSegaBasicCreate(BoardContext* board, const char* filename, UInt8* romData, 
                           int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -106,12 +107,13 @@ int romMapperSegaBasicCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperSegaBasic));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_SEGABASIC, &callbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_SEGABASIC, &callbacks, rm);
     
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_RAM, langDbgDevRam(), &dbgCallbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_RAM, langDbgDevRam(), &dbgCallbacks, rm);
 
-    slotRegister(slot, sslot, startPage, pages, NULL, NULL, NULL, destroy, rm);
+    slotRegister(board, slot, sslot, startPage, pages, NULL, NULL, NULL, destroy, rm);
 
     rm->romData = malloc(pages * 0x2000);
     memcpy(rm->romData, romData, size);
@@ -123,12 +125,12 @@ int romMapperSegaBasicCreate(const char* filename, UInt8* romData,
     
     for (i = 0; i < pages; i++) {
         if (i + startPage >= 2) slot = 0;
-        slotMapPage(slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
+        slotMapPage(board, slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
         
     }
     
     for (; i < 8; i++) {
-        slotMapPage(0, 0, i, rm->ram + 0x2000 * (i - 4), 1, 1);
+        slotMapPage(board, 0, 0, i, rm->ram + 0x2000 * (i - 4), 1, 1);
     }
 
     return 1;
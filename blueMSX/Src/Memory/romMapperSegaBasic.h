@@ -30,7 +30,7 @@
 
 #include "MsxTypes.h"
 
-int romMapperSegaBasicCreate(const char* filename, UInt8* romData, 
+int romMapperSegaBasicCreate(BoardContext* board, const char* filename, UInt8* romData, 
                                 int size, int slot, int sslot, int startPage);
 
 #endif
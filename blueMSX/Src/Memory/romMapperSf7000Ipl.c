@@ -37,6 +37,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -46,8 +47,8 @@ typedef struct {
 
 static void destroy(RomMapperSf7000Ipl* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -55,14 +56,14 @@ static void destroy(RomMapperSf7000Ipl* rm)
 
 static void write(RomMapperSf7000Ipl* rm, UInt16 address, UInt8 value) 
 {
-    UInt8* ramPage = boardGetRamPage(address / 0x2000);
+    UInt8* ramPage = boardGetRamPage(rm->board, address / 0x2000);
 
     if (ramPage != NULL) {
         ramPage[address & 0x1fff] = value;
     }
 }
 
-int romMapperSf7000IplCreate(const char* filename, UInt8* romData, 
+int romMapperSf7000IplCreate(BoardContext* board, const char* filename, UInt8* romData, 
                           int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, NULL, NULL };
@@ -71,9 +72,10 @@ int romMapperSf7000IplCreate(const char* filename, UInt8* romData,
     int i;
 
     rm = malloc(sizeof(RomMapperSf7000Ipl));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_NORMAL, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, pages, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_NORMAL, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, pages, NULL, NULL, write, destroy, rm);
 
     rm->romData = malloc(0x4000);
     if (size > 0x4000) {
@@ -87,7 +89,7 @@ int romMapperSf7000IplCreate(const char* filename, UInt8* romData,
     rm->startPage  = startPage;
 
     for (i = 0; i < pages; i++) {
-        slotMapPage(slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
+        slotMapPage(board, slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
     }
 
     return 1;
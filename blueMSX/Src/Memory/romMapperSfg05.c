@@ -52,6 +52,7 @@
 #define RX_QUEUE_SIZE 256
 
 typedef struct {
+    BoardContext* board;
     MidiIO*     midiIo;
     UInt8       command;
     UInt8       rxData;
@@ -120,14 +121,14 @@ static void onRecv(YM2148* midi, UInt32 time)
             archSemaphoreSignal(midi->semaphore);
             midi->status |= STAT_RXRBSY;
             if (midi->command & CMD_RXINT) {
-                boardSetDataBus(midi->vector, 0, 0);
-                boardSetInt(0x800);
+                boardSetDataBus(midi->board, midi->vector, 0, 0);
+                boardSetInt(midi->board, 0x800);
                 midi->status |= ST_INT;
             }
         }
     }
 
-    midi->timeRecv = boardSystemTime() + midi->charTime;
+    midi->timeRecv = boardSystemTime(midi->board) + midi->charTime;
     boardTimerAdd(midi->timerRecv, midi->timeRecv);
 }
 
@@ -139,8 +140,8 @@ static void onTrans(YM2148* midi, UInt32 time)
 	if (midi->status &  STAT_TXRDY) {
 		midi->status |= STAT_TXEMPTY;
         if (midi->command & CMD_TXINT) {
-            boardSetDataBus(midi->vector, 0, 0);
-            boardSetInt(0x800);
+            boardSetDataBus(midi->board, midi->vector, 0, 0);
+            boardSetInt(midi->board, 0x800);
             midi->status |= ST_INT;
         }
 	}
@@ -149,7 +150,7 @@ static void onTrans(YM2148* midi, UInt32 time)
 	    midi->status &= ~STAT_TXEMPTY;
 	    midi->sendByte = midi->sendBuffer;
 
-        midi->timeTrans = boardSystemTime() + midi->charTime;
+        midi->timeTrans = boardSystemTime(midi->board) + midi->charTime;
         boardTimerAdd(midi->timerTrans, midi->timeTrans);
 	}
 }
@@ -167,18 +168,19 @@ static void ym2148Reset(YM2148* midi)
     boardTimerRemove(midi->timerRecv);
     boardTimerRemove(midi->timerTrans);
     
-    midi->timeRecv = boardSystemTime() + midi->charTime;
+    midi->timeRecv = boardSystemTime(midi->board) + midi->charTime;
     boardTimerAdd(midi->timerRecv, midi->timeRecv);
 }
 
-static YM2148* ym2148Create()
+static YM2148* ym2148Create(BoardContext* board)
 {
     YM2148* midi = (YM2148*)calloc(1, sizeof(YM2148));
 
+    midi->board = board;
     midi->midiIo = midiIoCreate(midiInCallback, midi);
     midi->semaphore = archSemaphoreCreate(1);
-    midi->timerRecv   = boardTimerCreate(onRecv, midi);
-    midi->timerTrans  = boardTimerCreate(onTrans, midi);
+    midi->timerRecv   = boardTimerCreate(midi->board, onRecv, midi);
+    midi->timerTrans  = boardTimerCreate(midi->board, onTrans, midi);
 
     ym2148Reset(midi);
 
@@ -195,7 +197,7 @@ static UInt8 ym2148ReadStatus(YM2148* midi)
 {
     UInt8 val = midi->status;
 
-    boardClearInt(0x800);
+    boardClearInt(midi->board, 0x800);
     midi->status &= ~ST_INT;
 
     return val;
@@ -211,7 +213,7 @@ static UInt8 ym2148ReadData(YM2148* midi)
 static void ym2148SetVector(YM2148* midi, UInt8 value)
 {
     midi->vector = value;
-    boardSetDataBus(midi->vector, 0, 0);
+    boardSetDataBus(midi->board, midi->vector, 0, 0);
 }
 
 static void ym2148WriteCommand(YM2148* midi, UInt8 value)
@@ -228,8 +230,8 @@ static void ym2148WriteCommand(YM2148* midi, UInt8 value)
 	if (value & CMD_TXINT) {
         if ((midi->status & STAT_TXEMPTY) && (value & CMD_TXEN)) {
                 if (midi->command & CMD_TXINT) {
-                boardSetDataBus(midi->vector, 0, 0);
-                boardSetInt(0x800);
+                boardSetDataBus(midi->board, midi->vector, 0, 0);
+                boardSetInt(midi->board, 0x800);
                 midi->status |= ST_INT;
             }
         }
@@ -245,7 +247,7 @@ static void ym2148WriteData(YM2148* midi, UInt8 value)
 	    midi->status &= ~STAT_TXEMPTY;
 	    midi->sendByte = value;
 
-        midi->timeTrans = boardSystemTime() + midi->charTime;
+        midi->timeTrans = boardSystemTime(midi->board) + midi->charTime;
         boardTimerAdd(midi->timerTrans, midi->timeTrans);
 	} 
     else {
@@ -257,7 +259,7 @@ static void ym2148WriteData(YM2148* midi, UInt8 value)
 
 static void ym2148SaveState(YM2148* midi)
 {
-    SaveState* state = saveStateOpenForWrite("ym2148");
+    SaveState* state = saveStateOpenForWrite(midi->board, "ym2148");
 
     saveStateSet(state, "command", midi->command);
     saveStateSet(state, "rxData", midi->rxData);
@@ -275,7 +277,7 @@ static void ym2148SaveState(YM2148* midi)
 
 static void ym2148LoadState(YM2148* midi)
 {
-    SaveState* state = saveStateOpenForRead("ym2148");
+    SaveState* state = saveStateOpenForRead(midi->board, "ym2148");
     
     midi->command = saveStateGet(state, "command", 0);
     midi->rxData = saveStateGet(state, "rxData", 0);
@@ -298,6 +300,7 @@ static void ym2148LoadState(YM2148* midi)
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     YM2151* ym2151;
@@ -315,7 +318,7 @@ static int deviceCount = 0;
 
 static void saveState(RomMapperSfg05* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperSfg05");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperSfg05");
     
     saveStateSet(state, "kbdLatch", rm->kbdLatch);
     
@@ -327,7 +330,7 @@ static void saveState(RomMapperSfg05* rm)
 
 static void loadState(RomMapperSfg05* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperSfg05");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperSfg05");
 
     rm->kbdLatch = (UInt8)saveStateGet(state, "kbdLatch", 0);
 
@@ -352,10 +355,10 @@ static void destroy(RomMapperSfg05* rm)
         ykIoDestroy(rm->ykIo);
     }
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
 
-    debugDeviceUnregister(rm->debugHandle);
-    deviceManagerUnregister(rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     if (rm->romData != NULL) {
         free(rm->romData);
@@ -433,7 +436,7 @@ static void write(RomMapperSfg05* rm, UInt16 address, UInt8 value)
         ym2148SetVector(rm->ym2148, value);
         break;
     case 0x3ff4:
-        boardSetDataBus(value, value, 1);
+        boardSetDataBus(rm->board, value, value, 1);
         ym2151SetIrqVector(rm->ym2151, value);
         break;
     case 0x3ff5:
@@ -451,7 +454,7 @@ static void getDebugInfo(RomMapperSfg05* rm, DbgDevice* dbgDevice)
     ym2151GetDebugInfo(rm->ym2151, dbgDevice);
 }
 
-int romMapperSfg05Create(const char* filename, UInt8* romData, 
+int romMapperSfg05Create(BoardContext* board, const char* filename, UInt8* romData, 
                             int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
@@ -465,11 +468,12 @@ int romMapperSfg05Create(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperSfg05));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(pages == 2 ? ROM_YAMAHASFG01 : ROM_YAMAHASFG05, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_AUDIO, langDbgDevSfg05(), &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, pages == 2 ? ROM_YAMAHASFG01 : ROM_YAMAHASFG05, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_AUDIO, langDbgDevSfg05(), &dbgCallbacks, rm);
 
-    slotRegister(slot, sslot, startPage, pages, read, read, write, destroy, rm);
+    slotRegister(board, slot, sslot, startPage, pages, read, read, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -478,12 +482,18 @@ int romMapperSfg05Create(const char* filename, UInt8* romData,
     rm->startPage  = startPage;
     rm->sizeMask = size - 1;
 
+    // Only the registers at 0x3ff0 - 0x3ff7 need the read handler
     for (i = 0; i < pages; i++) {
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, NULL, 0, 0);
+        if (i == 1) {
+            slotMapPageIo(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + 0x2000 * i, 0x1ff0, 8);
+        }
+        else {
+            slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + 0x2000 * i, 1, 0);
+        }
     }
 
-    rm->ym2151 = ym2151Create(boardGetMixer());
-    rm->ym2148 = ym2148Create();
+    rm->ym2151 = ym2151Create(board, boardGetMixer(board));
+    rm->ym2148 = ym2148Create(board);
     rm->ykIo = ykIoCreate();
 
     reset(rm);
@@ -30,7 +30,7 @@
  
 #include "MsxTypes.h"
 
-int romMapperSfg05Create(const char* filename, UInt8* romData, 
+int romMapperSfg05Create(BoardContext* board, const char* filename, UInt8* romData, 
                          int size, int slot, int sslot, int startPage);
 
 #endif
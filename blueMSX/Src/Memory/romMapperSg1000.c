@@ -36,6 +36,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -45,14 +46,14 @@ typedef struct {
 
 static void destroy(RomMapperSg1000* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
 }
 
-int romMapperSg1000Create(const char* filename, UInt8* romData, 
+int romMapperSg1000Create(BoardContext* board, const char* filename, UInt8* romData, 
                           int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, NULL, NULL };
@@ -65,9 +66,10 @@ int romMapperSg1000Create(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperSg1000));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_SG1000, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, pages, NULL, NULL, NULL, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_SG1000, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, pages, NULL, NULL, NULL, destroy, rm);
 
     rm->romData = malloc(pages * 0x2000);
     memcpy(rm->romData, romData, size);
@@ -78,7 +80,7 @@ int romMapperSg1000Create(const char* filename, UInt8* romData,
 
     for (i = 0; i < pages; i++) {
         if (i + startPage >= 2) slot = 0;
-        slotMapPage(slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
+        slotMapPage(board, slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
     }
 
     return 1;
@@ -37,6 +37,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     UInt8 sram[0x2000];
@@ -50,14 +51,14 @@ static void destroy(RomMapperSg1000Castle* rm)
 {
     sramSave(rm->sramFilename, rm->sram, 0x2000, NULL, 0);
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
 }
 
-int romMapperSg1000CastleCreate(const char* filename, UInt8* romData, 
+int romMapperSg1000CastleCreate(BoardContext* board, const char* filename, UInt8* romData, 
                           int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, NULL, NULL };
@@ -70,9 +71,10 @@ int romMapperSg1000CastleCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperSg1000Castle));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_SG1000CASTLE, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, pages, NULL, NULL, NULL, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_SG1000CASTLE, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, pages, NULL, NULL, NULL, destroy, rm);
 
     rm->romData = malloc(pages * 0x2000);
     memcpy(rm->romData, romData, size);
@@ -87,7 +89,7 @@ int romMapperSg1000CastleCreate(const char* filename, UInt8* romData,
 
     for (i = 0; i < pages; i++) {
         if (i + startPage >= 2) slot = 0;
-        slotMapPage(slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
+        slotMapPage(board, slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
     }
     // Always map SRAM in slot 0. This is an unfortunate workaround because
     // Sega roms are mapped in slot 2, but the page size is 16kB and the SRAM
@@ -96,7 +98,7 @@ int romMapperSg1000CastleCreate(const char* filename, UInt8* romData,
     // Note though that mapping carts to slot 2 is also sort of a workaround to
     // allow carts to be inserted/removed more easily in a running system. This
     // patch prevent removing the cart to be handled correctly though
-    slotMapPage(0, 0, 4 + rm->startPage, rm->sram, 1, 1);
+    slotMapPage(board, 0, 0, 4 + rm->startPage, rm->sram, 1, 1);
 //    slotMapPage(rm->slot, rm->sslot, 4 + rm->startPage, rm->sram, 1, 1);
 
     return 1;
@@ -37,6 +37,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     UInt8 ram1[0x2000];
@@ -49,7 +50,7 @@ typedef struct {
 
 static void saveState(RomMapperSg1000RamExpander* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperSegaRamExpander");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperSegaRamExpander");
 
     saveStateSet(state, "mask2", rm->mask2);
     saveStateSetBuffer(state, "ram1", rm->ram1, 0x2000);
@@ -60,7 +61,7 @@ static void saveState(RomMapperSg1000RamExpander* rm)
 
 static void loadState(RomMapperSg1000RamExpander* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperSegaRamExpander");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperSegaRamExpander");
 
     rm->mask2 = saveStateGet(state, "mask2", 0x400);
     saveStateGetBuffer(state, "ram1", rm->ram2, 0x2000);
@@ -71,8 +72,8 @@ static void loadState(RomMapperSg1000RamExpander* rm)
 
 static void destroy(RomMapperSg1000RamExpander* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -88,7 +89,7 @@ static void write(RomMapperSg1000RamExpander* rm, UInt16 address, UInt8 value)
     rm->ram2[address & rm->mask2] = value;
 }
 
-int romMapperSg1000RamExpanderCreate(const char* filename, UInt8* romData, 
+int romMapperSg1000RamExpanderCreate(BoardContext* board, const char* filename, UInt8* romData, 
                                      int size, int slot, int sslot, int startPage, int type) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -101,9 +102,10 @@ int romMapperSg1000RamExpanderCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperSg1000RamExpander));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(type, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, pages, read, read, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, type, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, pages, read, read, write, destroy, rm);
 
     rm->romData = malloc(pages * 0x2000);
     memcpy(rm->romData, romData, size);
@@ -118,15 +120,15 @@ int romMapperSg1000RamExpanderCreate(const char* filename, UInt8* romData,
     for (i = 0; i < pages; i++) {
         if (i + startPage >= 2) slot = 0;
         if (type == ROM_SG1000_RAMEXPANDER_A && i + startPage == 1) {
-            slotMapPage(slot, sslot, i + startPage, rm->ram1, 1, 1);
+            slotMapPage(board, slot, sslot, i + startPage, rm->ram1, 1, 1);
         }
         else {
-            slotMapPage(slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
+            slotMapPage(board, slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
         }
     }
 
-    slotMapPage(slot, sslot, 6, NULL, 0, 0);
-    slotMapPage(slot, sslot, 7, NULL, 0, 0);
+    slotMapPage(board, slot, sslot, 6, NULL, 0, 0);
+    slotMapPage(board, slot, sslot, 7, NULL, 0, 0);
 
     return 1;
 }
@@ -44,6 +44,7 @@
 #include <string.h>
 
 typedef struct {
+    BoardContext* board;
     int    deviceHandle;
     int    debugHandle;
     I8255* i8255;
@@ -58,15 +59,15 @@ typedef struct {
 
 static void destroy(SonyHBI55* rm)
 {
-    ioPortUnregister(0xb0);
-    ioPortUnregister(0xb1);
-    ioPortUnregister(0xb2);
-    ioPortUnregister(0xb3);
+    ioPortUnregister(rm->board, 0xb0);
+    ioPortUnregister(rm->board, 0xb1);
+    ioPortUnregister(rm->board, 0xb2);
+    ioPortUnregister(rm->board, 0xb3);
     
     sramSave(sramCreateFilename("HBI-55.SRAM"), rm->sram, 0x1000, NULL, 0);
 
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
     i8255Destroy(rm->i8255);
 
@@ -86,7 +87,7 @@ static void reset(SonyHBI55* rm)
 
 static void loadState(SonyHBI55* rm)
 {
-    SaveState* state = saveStateOpenForRead("SonyHBI55");
+    SaveState* state = saveStateOpenForRead(rm->board, "SonyHBI55");
 
     rm->mode       = (UInt8) saveStateGet(state, "mode",       0);
     rm->addrLatch  = (UInt8) saveStateGet(state, "addrLatch",  0);
@@ -101,7 +102,7 @@ static void loadState(SonyHBI55* rm)
 
 static void saveState(SonyHBI55* rm)
 {
-    SaveState* state = saveStateOpenForWrite("SonyHBI55");
+    SaveState* state = saveStateOpenForWrite(rm->board, "SonyHBI55");
     
     saveStateSet(state, "mode",       rm->mode);
     saveStateSet(state, "addrLatch",  rm->addrLatch);
@@ -182,30 +183,32 @@ static void getDebugInfo(SonyHBI55* rm, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 3, 0xb3, DBG_IO_READWRITE, i8255Peek(rm->i8255, 0xb3));
 }
 
-int romMapperSonyHBI55Create()
+int romMapperSonyHBI55Create(BoardContext* board)
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     SonyHBI55* rm = malloc(sizeof(SonyHBI55));
 
-    rm->deviceHandle = deviceManagerRegister(ROM_SONYHBI55, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_CART, langDbgDevHbi55(), &dbgCallbacks, rm);
+    rm->board = board;
+
+    rm->deviceHandle = deviceManagerRegister(board, ROM_SONYHBI55, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_CART, langDbgDevHbi55(), &dbgCallbacks, rm);
 
     memset(rm->sram, 0xff, sizeof(rm->sram));
     sramLoad(sramCreateFilename("HBI-55.SRAM"), rm->sram, 0x1000, NULL, 0);
 
     rm->sram[0] = 0x53;
 
-    rm->i8255 = i8255Create(NULL,    NULL,    writeA,
+    rm->i8255 = i8255Create(board, NULL,    NULL,    writeA,
                             NULL,    NULL,    writeB,
                             readCLo, readCLo, writeCLo,
                             readCHi, readCHi, writeCHi,
                             rm);
 
-    ioPortRegister(0xb0, i8255Read, i8255Write, rm->i8255);
-    ioPortRegister(0xb1, i8255Read, i8255Write, rm->i8255);
-    ioPortRegister(0xb2, i8255Read, i8255Write, rm->i8255);
-    ioPortRegister(0xb3, i8255Read, i8255Write, rm->i8255);
+    ioPortRegister(board, 0xb0, i8255Read, i8255Write, rm->i8255);
+    ioPortRegister(board, 0xb1, i8255Read, i8255Write, rm->i8255);
+    ioPortRegister(board, 0xb2, i8255Read, i8255Write, rm->i8255);
+    ioPortRegister(board, 0xb3, i8255Read, i8255Write, rm->i8255);
 
     reset(rm);
 
@@ -38,6 +38,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -61,13 +62,13 @@ typedef struct {
 
 static void saveState(RomMapperSonyHbiV1* rm)
 {
-    SaveState* state = saveStateOpenForWrite("Vmx80");
+    SaveState* state = saveStateOpenForWrite(rm->board, "Vmx80");
     saveStateClose(state);
 }
 
 static void loadState(RomMapperSonyHbiV1* rm)
 {
-    SaveState* state = saveStateOpenForRead("Vmx80");
+    SaveState* state = saveStateOpenForRead(rm->board, "Vmx80");
     saveStateClose(state);
 }
 
@@ -75,8 +76,8 @@ static void destroy(RomMapperSonyHbiV1* rm)
 {
     boardTimerDestroy(rm->timerDigitize);
     boardTimerDestroy(rm->timerBusy);
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -245,10 +246,10 @@ static void onTimerDigitize(RomMapperSonyHbiV1* rm, UInt32 time)
     if (--rm->delay == 0) {
         rm->status0 |= 0x80;
         digitize(rm);
-        boardTimerAdd(rm->timerBusy, boardSystemTime() + boardFrequency() / 60);
+        boardTimerAdd(rm->timerBusy, boardSystemTime(rm->board) + boardFrequency() / 60);
     }
     else {
-        boardTimerAdd(rm->timerDigitize, boardSystemTime() + boardFrequency() / 60);
+        boardTimerAdd(rm->timerDigitize, boardSystemTime(rm->board) + boardFrequency() / 60);
     }
 }
 
@@ -278,7 +279,7 @@ static UInt8 read(RomMapperSonyHbiV1* rm, UInt16 address)
         value = rm->status0 | rm->command;
         break;
     case 0x3ffd:
-        value = (UInt8)(((boardSystemTime() / (boardFrequency() / 60)) & 1) << 7) | 
+        value = (UInt8)(((boardSystemTime(rm->board) / (boardFrequency() / 60)) & 1) << 7) | 
                 (archVideoInIsVideoConnected() ? 0 : 0x10) |
                 (rm->startBlockY << 2) | rm->startBlockX;
         break;
@@ -316,16 +317,16 @@ static void write(RomMapperSonyHbiV1* rm, UInt16 address, UInt8 value)
         case 1:
             digitize(rm);
             rm->status0 |= 0x80;
-            boardTimerAdd(rm->timerBusy, boardSystemTime() + boardFrequency() / 60);
+            boardTimerAdd(rm->timerBusy, boardSystemTime(rm->board) + boardFrequency() / 60);
             break;
         case 2:
             if (rm->delay == 0) {
                 rm->status0 |= 0x80;
                 digitize(rm);
-                boardTimerAdd(rm->timerBusy, boardSystemTime() + boardFrequency() / 60);
+                boardTimerAdd(rm->timerBusy, boardSystemTime(rm->board) + boardFrequency() / 60);
             }
             else
-                boardTimerAdd(rm->timerDigitize, boardSystemTime() + boardFrequency() / 60);
+                boardTimerAdd(rm->timerDigitize, boardSystemTime(rm->board) + boardFrequency() / 60);
             break;
         case 3:
             printf("HBI-V1 Command = 3\n");
@@ -360,7 +361,7 @@ static void reset(RomMapperSonyHbiV1* rm)
     rm->delay       = 0;
 }
 
-int romMapperSonyHbiV1Create(const char* filename, UInt8* romData, int size,
+int romMapperSonyHbiV1Create(BoardContext* board, const char* filename, UInt8* romData, int size,
                              int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
@@ -373,21 +374,29 @@ int romMapperSonyHbiV1Create(const char* filename, UInt8* romData, int size,
     }
 
     rm = malloc(sizeof(RomMapperSonyHbiV1));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_SONYHBIV1, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, read, read, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_SONYHBIV1, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, read, read, write, destroy, rm);
 
-    rm->romData = calloc(1, size);
+    rm->romData = calloc(1, size > 0x8000 ? size : 0x8000);
     memcpy(rm->romData, romData, size);
     rm->slot  = slot;
     rm->sslot = sslot;
     rm->startPage  = startPage;
     
-    rm->timerDigitize = boardTimerCreate(onTimerDigitize, rm);
-    rm->timerBusy     = boardTimerCreate(onTimerBusy,     rm);
+    rm->timerDigitize = boardTimerCreate(board, onTimerDigitize, rm);
+    rm->timerBusy     = boardTimerCreate(board, onTimerBusy,     rm);
 
+    // Only the frame buffer port at offset 0x3e00 - 0x3eff and the registers
+    // at offset 0x3ffc - 0x3ffe need the read handler
     for (i = 0; i < pages; i++) {
-        slotMapPage(slot, sslot, i + startPage, NULL, 0, 0);
+        if (i == 1) {
+            slotMapPageIo(board, slot, sslot, i + startPage, rm->romData + 0x2000 * i, 0x1e00, 0x200);
+        }
+        else {
+            slotMapPage(board, slot, sslot, i + startPage, rm->romData + 0x2000 * i, 1, 0);
+        }
     }
 
     reset(rm);
@@ -31,7 +31,7 @@
 
 #include "MsxTypes.h"
 
-int romMapperSonyHbiV1Create(const char* filename, UInt8* romData, int size,
+int romMapperSonyHbiV1Create(BoardContext* board, const char* filename, UInt8* romData, int size,
                              int slot, int sslot, int startPage);
 
 #endif
@@ -36,6 +36,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -47,7 +48,7 @@ typedef struct {
 
 static void saveState(RomMapperStandard* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperStandard");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperStandard");
     char tag[16];
     int i;
 
@@ -61,7 +62,7 @@ static void saveState(RomMapperStandard* rm)
 
 static void loadState(RomMapperStandard* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperStandard");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperStandard");
     char tag[16];
     int i;
 
@@ -73,14 +74,14 @@ static void loadState(RomMapperStandard* rm)
     saveStateClose(state);
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 }
 
 static void destroy(RomMapperStandard* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->romData);
     free(rm);
@@ -108,11 +109,11 @@ static void write(RomMapperStandard* rm, UInt16 address, UInt8 value)
 
         rm->romMapper[bank] = value;
         
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + bank, bankData, 1, 0);
     }
 }
 
-int romMapperStandardCreate(const char* filename, UInt8* romData, 
+int romMapperStandardCreate(BoardContext* board, const char* filename, UInt8* romData, 
                             int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -124,9 +125,10 @@ int romMapperStandardCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperStandard));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_STANDARD, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_STANDARD, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, NULL, NULL, write, destroy, rm);
 
     rm->romData = malloc(size);
     memcpy(rm->romData, romData, size);
@@ -141,7 +143,7 @@ int romMapperStandardCreate(const char* filename, UInt8* romData,
     rm->romMapper[3] = 3;
 
     for (i = 0; i < 4; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, rm->romData + rm->romMapper[i] * 0x2000, 1, 0);
     }
 
     return 1;
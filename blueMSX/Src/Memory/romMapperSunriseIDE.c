@@ -37,6 +37,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     int slot;
@@ -51,10 +52,24 @@ typedef struct {
     int    romMapper;
 } RomMapperSunriseIde;
 
+static void mapPages(RomMapperSunriseIde* rm)
+{
+    UInt8* bankData = rm->romData + rm->romMapper;
+
+    // Only the IDE data and register ports at 0x7c00 - 0x7eff need the
+    // read handler while the interface is enabled
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 2, bankData, 1, 0);
+    if (rm->ideEnabled) {
+        slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + 3, bankData + 0x2000, 0x1c00, 0x300);
+    }
+    else {
+        slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 3, bankData + 0x2000, 1, 0);
+    }
+}
 
 static void saveState(RomMapperSunriseIde* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperSunriseIde");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperSunriseIde");
 
     saveStateSet(state, "ideEnabled", rm->ideEnabled);
     saveStateSet(state, "readLatch", rm->readLatch);
@@ -68,7 +83,7 @@ static void saveState(RomMapperSunriseIde* rm)
 
 static void loadState(RomMapperSunriseIde* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperSunriseIde");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperSunriseIde");
 
     rm->ideEnabled = saveStateGet(state, "ideEnabled", 0);
     rm->readLatch = (UInt8)saveStateGet(state, "readLatch", 0);
@@ -78,12 +93,14 @@ static void loadState(RomMapperSunriseIde* rm)
     saveStateClose(state);
     
     sunriseIdeLoadState(rm->ide);
+
+    mapPages(rm);
 }
 
 static void destroy(RomMapperSunriseIde* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     sunriseIdeDestroy(rm->ide);
 
@@ -143,6 +160,7 @@ static void write(RomMapperSunriseIde* rm, UInt16 address, UInt8 value)
 	    value = ((value & 0xcc) >> 2) | ((value & 0x33) << 2);
 	    value = ((value & 0xaa) >> 1) | ((value & 0x55) << 1);
         rm->romMapper = 0x4000 * (value & rm->romMask);
+        mapPages(rm);
 		return;
 	}
 
@@ -173,7 +191,7 @@ static void reset(RomMapperSunriseIde* rm)
 }
 
 
-int romMapperSunriseIdeCreate(int hdId, const char* filename, UInt8* romData, 
+int romMapperSunriseIdeCreate(BoardContext* board, int hdId, const char* filename, UInt8* romData, 
                               int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
@@ -196,11 +214,12 @@ int romMapperSunriseIdeCreate(int hdId, const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperSunriseIde));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_SUNRISEIDE, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 8, read, peek, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_SUNRISEIDE, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 8, read, peek, write, destroy, rm);
 
-    rm->ide = sunriseIdeCreate(hdId);
+    rm->ide = sunriseIdeCreate(board, hdId);
 
     rm->romData = calloc(1, size);
     if (romData != NULL) {
@@ -217,12 +236,14 @@ int romMapperSunriseIdeCreate(int hdId, const char* filename, UInt8* romData,
     rm->romMapper = 0;
 
     for (i = 0; i < 8; i++) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i, NULL, 0, 0);
+        slotMapPage(board, rm->slot, rm->sslot, rm->startPage + i, NULL, 0, 0);
     }
 
     rm->ideEnabled = 1;
     rm->romMapper = 0;
 
+    mapPages(rm);
+
     reset(rm);
 
     return 1;
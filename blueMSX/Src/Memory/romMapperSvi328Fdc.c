@@ -38,6 +38,7 @@
 #include <stdio.h>
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     WD2793* fdc;
@@ -46,7 +47,7 @@ typedef struct {
 
 static void saveState(Svi328Fdc* rm)
 {
-    SaveState* state = saveStateOpenForWrite("Svi328Fdc");
+    SaveState* state = saveStateOpenForWrite(rm->board, "Svi328Fdc");
 
     saveStateSet(state, "drvSelect",  rm->drvSelect);
     
@@ -57,7 +58,7 @@ static void saveState(Svi328Fdc* rm)
 
 static void loadState(Svi328Fdc* rm)
 {
-    SaveState* state = saveStateOpenForRead("Svi328Fdc");
+    SaveState* state = saveStateOpenForRead(rm->board, "Svi328Fdc");
 
     rm->drvSelect  = (UInt8)saveStateGet(state, "drvSelect",  0);
 
@@ -68,15 +69,15 @@ static void loadState(Svi328Fdc* rm)
 
 static void destroy(Svi328Fdc* rm)
 {
-    ioPortUnregister(0x30);
-    ioPortUnregister(0x31);
-    ioPortUnregister(0x32);
-    ioPortUnregister(0x33);
-    ioPortUnregister(0x34);
-    ioPortUnregister(0x38);
+    ioPortUnregister(rm->board, 0x30);
+    ioPortUnregister(rm->board, 0x31);
+    ioPortUnregister(rm->board, 0x32);
+    ioPortUnregister(rm->board, 0x33);
+    ioPortUnregister(rm->board, 0x34);
+    ioPortUnregister(rm->board, 0x38);
 
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
     wd2793Destroy(rm->fdc);
 
@@ -175,25 +176,26 @@ static void getDebugInfo(Svi328Fdc* rm, DbgDevice* dbgDevice)
     }
 }
 
-int svi328FdcCreate(void) 
+int svi328FdcCreate(BoardContext* board) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     Svi328Fdc* rm;
 
-    rm = malloc(sizeof(Svi328Fdc));
+    rm = calloc(1, sizeof(Svi328Fdc));
+    rm->board = board;
     
-    rm->deviceHandle = deviceManagerRegister(ROM_SVI328FDC, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_PORT, langDbgDevSviFdc(), &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_SVI328FDC, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_PORT, langDbgDevSviFdc(), &dbgCallbacks, rm);
 
-    ioPortRegister(0x30, readIo, writeIo, rm);
-    ioPortRegister(0x31, readIo, writeIo, rm);
-    ioPortRegister(0x32, readIo, writeIo, rm);
-    ioPortRegister(0x33, readIo, writeIo, rm);
-    ioPortRegister(0x34, readIo, writeIo, rm);
-    ioPortRegister(0x38, readIo, writeIo, rm);
+    ioPortRegister(board, 0x30, readIo, writeIo, rm);
+    ioPortRegister(board, 0x31, readIo, writeIo, rm);
+    ioPortRegister(board, 0x32, readIo, writeIo, rm);
+    ioPortRegister(board, 0x33, readIo, writeIo, rm);
+    ioPortRegister(board, 0x34, readIo, writeIo, rm);
+    ioPortRegister(board, 0x38, readIo, writeIo, rm);
 
-    rm->fdc = wd2793Create(FDC_TYPE_WD2793);
+    rm->fdc = wd2793Create(board, FDC_TYPE_WD2793);
 
     reset(rm);
 
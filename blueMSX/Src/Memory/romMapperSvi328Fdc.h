@@ -30,6 +30,6 @@
 
 #include "MsxTypes.h"
 
-int svi328FdcCreate(void);
+int svi328FdcCreate(BoardContext* board);
 
 #endif
@@ -36,6 +36,7 @@
 #include <stdlib.h>
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     UInt8 prnData;
@@ -45,7 +46,7 @@ typedef struct {
 
 static void saveState(RomMapperSvi328Prn* prn)
 {
-    SaveState* state = saveStateOpenForWrite("Svi328Prn");
+    SaveState* state = saveStateOpenForWrite(prn->board, "Svi328Prn");
 
     saveStateSet(state, "prnData", prn->prnData);
     saveStateSet(state, "prnStrobe", prn->prnStrobe);
@@ -55,7 +56,7 @@ static void saveState(RomMapperSvi328Prn* prn)
 
 static void loadState(RomMapperSvi328Prn* prn)
 {
-    SaveState* state = saveStateOpenForRead("Svi328Prn");
+    SaveState* state = saveStateOpenForRead(prn->board, "Svi328Prn");
 
     prn->prnData  = (UInt8)saveStateGet(state, "prnData",  0);
     prn->prnStrobe  = (UInt8)saveStateGet(state, "prnStrobe",  0);
@@ -65,12 +66,12 @@ static void loadState(RomMapperSvi328Prn* prn)
 
 static void destroy(RomMapperSvi328Prn* prn)
 {
-    ioPortUnregister(0x10);
-    ioPortUnregister(0x11);
-    ioPortUnregister(0x12);
+    ioPortUnregister(prn->board, 0x10);
+    ioPortUnregister(prn->board, 0x11);
+    ioPortUnregister(prn->board, 0x12);
 
-    deviceManagerUnregister(prn->deviceHandle);
-    debugDeviceUnregister(prn->debugHandle);
+    deviceManagerUnregister(prn->board, prn->deviceHandle);
+    debugDeviceUnregister(prn->board, prn->debugHandle);
 
     printerIODestroy(prn->printerIO);
 
@@ -130,22 +131,23 @@ static void getDebugInfo(RomMapperSvi328Prn* rm, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 2, 0x12, DBG_IO_READWRITE, peekIo(rm, 0x12));
 }
 
-int romMapperSvi328PrnCreate(void) 
+int romMapperSvi328PrnCreate(BoardContext* board) 
 {
     DeviceCallbacks callbacks = {destroy, reset, saveState, loadState};
     DebugCallbacks dbgCallbacks = {getDebugInfo, NULL, NULL, NULL};
     RomMapperSvi328Prn* prn;
 
     prn = malloc(sizeof(RomMapperSvi328Prn));
+    prn->board = board;
 
-    prn->printerIO = printerIOCreate();
+    prn->printerIO = printerIOCreate(board);
 
-    prn->deviceHandle = deviceManagerRegister(ROM_SVI328PRN, &callbacks, prn);
-    prn->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, langDbgDevSviPrn(), &dbgCallbacks, prn);
+    prn->deviceHandle = deviceManagerRegister(board, ROM_SVI328PRN, &callbacks, prn);
+    prn->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, langDbgDevSviPrn(), &dbgCallbacks, prn);
 
-    ioPortRegister(0x10, NULL, writeIo, prn);
-    ioPortRegister(0x11, NULL, writeIo, prn);
-    ioPortRegister(0x12, readIo, NULL, prn);
+    ioPortRegister(board, 0x10, NULL, writeIo, prn);
+    ioPortRegister(board, 0x11, NULL, writeIo, prn);
+    ioPortRegister(board, 0x12, readIo, NULL, prn);
 
     reset(prn);
 
@@ -30,6 +30,6 @@
 
 #include "MsxTypes.h"
 
-int romMapperSvi328PrnCreate(void);
+int romMapperSvi328PrnCreate(BoardContext* board);
 
 #endif
@@ -37,6 +37,7 @@
 #include <stdlib.h>
 
 typedef struct {
+    BoardContext* board;
     int connector;
     int deviceHandle;
     int debugHandle;
@@ -50,7 +51,7 @@ static RomMapperSvi328Rs232* rs232;
 
 static void saveState(RomMapperSvi328Rs232* rs232)
 {
-    SaveState* state = saveStateOpenForWrite("Svi328Rs232");
+    SaveState* state = saveStateOpenForWrite(rs232->board, "Svi328Rs232");
 
     saveStateSet(state, "connector", rs232->connector);
     saveStateSet(state, "deviceHandle", rs232->deviceHandle);
@@ -62,7 +63,7 @@ static void saveState(RomMapperSvi328Rs232* rs232)
 
 static void loadState(RomMapperSvi328Rs232* rs232)
 {
-    SaveState* state = saveStateOpenForRead("Svi328Rs232");
+    SaveState* state = saveStateOpenForRead(rs232->board, "Svi328Rs232");
 
     rs232->connector = saveStateGet(state, "connector",  0);
     rs232->deviceHandle = (UInt8)saveStateGet(state, "deviceHandle",  0);
@@ -76,25 +77,25 @@ static void destroy(RomMapperSvi328Rs232* rs232)
 {
     switch (rs232->connector) {
     case SVI328_MODEM:
-        ioPortUnregister(0x20);
-        ioPortUnregister(0x21);
-        ioPortUnregister(0x22);
-        ioPortUnregister(0x23);
-        ioPortUnregister(0x24);
-        ioPortUnregister(0x25);
-        ioPortUnregister(0x26);
-        ioPortUnregister(0x27);
+        ioPortUnregister(rs232->board, 0x20);
+        ioPortUnregister(rs232->board, 0x21);
+        ioPortUnregister(rs232->board, 0x22);
+        ioPortUnregister(rs232->board, 0x23);
+        ioPortUnregister(rs232->board, 0x24);
+        ioPortUnregister(rs232->board, 0x25);
+        ioPortUnregister(rs232->board, 0x26);
+        ioPortUnregister(rs232->board, 0x27);
         break;
 
     case SVI328_RS232:
-        ioPortUnregister(0x28);
-        ioPortUnregister(0x29);
-        ioPortUnregister(0x2A);
-        ioPortUnregister(0x2B);
-        ioPortUnregister(0x2C);
-        ioPortUnregister(0x2D);
-        ioPortUnregister(0x2E);
-        ioPortUnregister(0x2F);
+        ioPortUnregister(rs232->board, 0x28);
+        ioPortUnregister(rs232->board, 0x29);
+        ioPortUnregister(rs232->board, 0x2A);
+        ioPortUnregister(rs232->board, 0x2B);
+        ioPortUnregister(rs232->board, 0x2C);
+        ioPortUnregister(rs232->board, 0x2D);
+        ioPortUnregister(rs232->board, 0x2E);
+        ioPortUnregister(rs232->board, 0x2F);
         break;
     }
     
@@ -102,8 +103,8 @@ static void destroy(RomMapperSvi328Rs232* rs232)
 
     archUartDestroy();
 
-    deviceManagerUnregister(rs232->deviceHandle);
-    debugDeviceUnregister(rs232->debugHandle);
+    deviceManagerUnregister(rs232->board, rs232->deviceHandle);
+    debugDeviceUnregister(rs232->board, rs232->debugHandle);
 
     free(rs232);
 }
@@ -150,45 +151,46 @@ static void getDebugInfo(RomMapperSvi328Rs232* rs232, DbgDevice* dbgDevice)
     }
 }
 
-int romMapperSvi328Rs232Create(Svi328UartConnector connector)
+int romMapperSvi328Rs232Create(BoardContext* board, Svi328UartConnector connector)
 {
     DeviceCallbacks callbacks = {destroy, NULL, saveState, loadState};
     DebugCallbacks dbgCallbacks = {getDebugInfo, NULL, NULL, NULL};
 
     rs232 = malloc(sizeof(RomMapperSvi328Rs232));
+    rs232->board = board;
 
     rs232->connector  = connector;
-    rs232->deviceHandle = deviceManagerRegister(ROM_SVI328RS232, &callbacks, rs232);
-    rs232->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, langDbgDevRs232(), &dbgCallbacks, rs232);
+    rs232->deviceHandle = deviceManagerRegister(board, ROM_SVI328RS232, &callbacks, rs232);
+    rs232->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, langDbgDevRs232(), &dbgCallbacks, rs232);
 
     rs232->i8250 = NULL;
-    rs232->i8250 = i8250Create(3072000, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, rs232);
+    rs232->i8250 = i8250Create(board, 3072000, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, rs232);
 
     rs232->serialLink = archUartCreate(romMapperSvi328Rs232ReceiveCallback);
 
     switch (rs232->connector) {
     case SVI328_MODEM:
         rs232->baseAddress = 0x20;
-        ioPortRegister(0x20, readIo, writeIo, rs232);
-        ioPortRegister(0x21, readIo, writeIo, rs232);
-        ioPortRegister(0x22, readIo, NULL,    rs232);
-        ioPortRegister(0x23, readIo, writeIo, rs232);
-        ioPortRegister(0x24, readIo, writeIo, rs232);
-        ioPortRegister(0x25, readIo, NULL,    rs232);
-        ioPortRegister(0x26, readIo, NULL,    rs232);
-        ioPortRegister(0x27, readIo, writeIo, rs232);
+        ioPortRegister(board, 0x20, readIo, writeIo, rs232);
+        ioPortRegister(board, 0x21, readIo, writeIo, rs232);
+        ioPortRegister(board, 0x22, readIo, NULL,    rs232);
+        ioPortRegister(board, 0x23, readIo, writeIo, rs232);
+        ioPortRegister(board, 0x24, readIo, writeIo, rs232);
+        ioPortRegister(board, 0x25, readIo, NULL,    rs232);
+        ioPortRegister(board, 0x26, readIo, NULL,    rs232);
+        ioPortRegister(board, 0x27, readIo, writeIo, rs232);
         break;
 
     case SVI328_RS232:
         rs232->baseAddress = 0x28;
-        ioPortRegister(0x28, readIo, writeIo, rs232);
-        ioPortRegister(0x29, readIo, writeIo, rs232);
-        ioPortRegister(0x2A, readIo, NULL,    rs232);
-        ioPortRegister(0x2B, readIo, writeIo, rs232);
-        ioPortRegister(0x2C, readIo, writeIo, rs232);
-        ioPortRegister(0x2D, readIo, NULL,    rs232);
-        ioPortRegister(0x2E, readIo, NULL,    rs232);
-        ioPortRegister(0x2F, readIo, writeIo, rs232);
+        ioPortRegister(board, 0x28, readIo, writeIo, rs232);
+        ioPortRegister(board, 0x29, readIo, writeIo, rs232);
+        ioPortRegister(board, 0x2A, readIo, NULL,    rs232);
+        ioPortRegister(board, 0x2B, readIo, writeIo, rs232);
+        ioPortRegister(board, 0x2C, readIo, writeIo, rs232);
+        ioPortRegister(board, 0x2D, readIo, NULL,    rs232);
+        ioPortRegister(board, 0x2E, readIo, NULL,    rs232);
+        ioPortRegister(board, 0x2F, readIo, writeIo, rs232);
         break;
 
     default:
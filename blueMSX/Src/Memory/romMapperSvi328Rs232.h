@@ -33,6 +33,6 @@
 
 typedef enum { SVI328_RS232, SVI328_MODEM } Svi328UartConnector;
 
-int romMapperSvi328Rs232Create(Svi328UartConnector connector);
+int romMapperSvi328Rs232Create(BoardContext* board, Svi328UartConnector connector);
 
 #endif
@@ -72,6 +72,7 @@ PC7    HRD    25 /IORD    PA7    HRST   1   RST
 */
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     HarddiskIde* hdide;
@@ -84,7 +85,7 @@ typedef struct {
 
 static void saveState(RomMapperRsIde* rm)
 {
-    SaveState* state = saveStateOpenForWrite("RomMapperRsIde");
+    SaveState* state = saveStateOpenForWrite(rm->board, "RomMapperRsIde");
 
     saveStateSet(state, "ideAddress", rm->ideAddress);
     saveStateSet(state, "ideIoRead", rm->ideIoRead);
@@ -99,7 +100,7 @@ static void saveState(RomMapperRsIde* rm)
 
 static void loadState(RomMapperRsIde* rm)
 {
-    SaveState* state = saveStateOpenForRead("RomMapperRsIde");
+    SaveState* state = saveStateOpenForRead(rm->board, "RomMapperRsIde");
 
     rm->ideAddress = (UInt8)saveStateGet(state, "ideAddress", 0);
     rm->ideIoRead = (UInt8)saveStateGet(state, "ideIoRead", 0);
@@ -114,13 +115,13 @@ static void loadState(RomMapperRsIde* rm)
 
 static void destroy(RomMapperRsIde* rm)
 {
-    ioPortUnregister(0x14);
-    ioPortUnregister(0x15);
-    ioPortUnregister(0x16);
-    ioPortUnregister(0x17);
+    ioPortUnregister(rm->board, 0x14);
+    ioPortUnregister(rm->board, 0x15);
+    ioPortUnregister(rm->board, 0x16);
+    ioPortUnregister(rm->board, 0x17);
 
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
     harddiskIdeDestroy(rm->hdide);
     i8255Destroy(rm->i8255);
@@ -217,29 +218,30 @@ static void getDebugInfo(RomMapperRsIde* rm, DbgDevice* dbgDevice)
     }
 }
 
-int romMapperSvi328RsIdeCreate(int hdId)
+int romMapperSvi328RsIdeCreate(BoardContext* board, int hdId)
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     RomMapperRsIde* rm;
 
     rm = malloc(sizeof(RomMapperRsIde));
+    rm->board = board;
     
-    rm->deviceHandle = deviceManagerRegister(ROM_SVI328RSIDE, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_PORT, langDbgDevIdeSviRs(), &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_SVI328RSIDE, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_PORT, langDbgDevIdeSviRs(), &dbgCallbacks, rm);
 
-    rm->i8255 = i8255Create( NULL, NULL,    writeA,
+    rm->i8255 = i8255Create(board,  NULL, NULL,    writeA,
                              NULL, readB,   writeB,
                              NULL, readCLo, writeCLo,
                              NULL, readCHi, writeCHi,
                              rm);
 
-    ioPortRegister(0x14, i8255Read, i8255Write, rm->i8255); // PPI Port A
-    ioPortRegister(0x15, i8255Read, i8255Write, rm->i8255); // PPI Port B
-    ioPortRegister(0x16, i8255Read, i8255Write, rm->i8255); // PPI Port C
-    ioPortRegister(0x17, i8255Read, i8255Write, rm->i8255); // PPI Mode
+    ioPortRegister(board, 0x14, i8255Read, i8255Write, rm->i8255); // PPI Port A
+    ioPortRegister(board, 0x15, i8255Read, i8255Write, rm->i8255); // PPI Port B
+    ioPortRegister(board, 0x16, i8255Read, i8255Write, rm->i8255); // PPI Port C
+    ioPortRegister(board, 0x17, i8255Read, i8255Write, rm->i8255); // PPI Mode
 
-    rm->hdide = harddiskIdeCreate(diskGetHdDriveId(hdId, 0));
+    rm->hdide = harddiskIdeCreate(board, diskGetHdDriveId(hdId, 0));
 
     reset(rm);
 
@@ -30,6 +30,6 @@
  
 #include "MsxTypes.h"
 
-int romMapperSvi328RsIdeCreate(int hdId);
+int romMapperSvi328RsIdeCreate(BoardContext* board, int hdId);
 
 #endif
@@ -30,7 +30,7 @@
 
 #include "MsxTypes.h"
 
-int romMapperSvi707FdcCreate(const char* filename, UInt8* romData, 
+int romMapperSvi707FdcCreate(BoardContext* board, const char* filename, UInt8* romData, 
                              int size, int slot, int sslot, int startPage);
 
 #endif
@@ -37,6 +37,7 @@
 #include <string.h>
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* charData;
     int slot;
@@ -47,23 +48,23 @@ typedef struct {
 
 static void saveState(RomMapperSvi727Col80* rm)
 {
-    SaveState* state = saveStateOpenForWrite("Svi727");
+    SaveState* state = saveStateOpenForWrite(rm->board, "Svi727");
     saveStateClose(state);
 }
 
 static void loadState(RomMapperSvi727Col80* rm)
 {
-    SaveState* state = saveStateOpenForRead("Svi727");
+    SaveState* state = saveStateOpenForRead(rm->board, "Svi727");
     saveStateClose(state);
 }
 
 static void destroy(RomMapperSvi727Col80* rm)
 {
-    ioPortUnregister(0x78);
-    ioPortUnregister(0x79);
+    ioPortUnregister(rm->board, 0x78);
+    ioPortUnregister(rm->board, 0x79);
 
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     free(rm->charData);
     free(rm);
@@ -108,7 +109,7 @@ static void reset(RomMapperSvi727Col80* rm)
 {
 }
 
-int romMapperSvi727Col80Create(const char* filename, UInt8* charRom, int charSize,
+int romMapperSvi727Col80Create(BoardContext* board, const char* filename, UInt8* charRom, int charSize,
                                  int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
@@ -119,9 +120,10 @@ int romMapperSvi727Col80Create(const char* filename, UInt8* charRom, int charSiz
     startPage = 0;
 
     rm = malloc(sizeof(RomMapperSvi727Col80));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_SVI727COL80, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, pages, read, read, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_SVI727COL80, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, pages, read, read, write, destroy, rm);
 
     rm->charData = calloc(1, 0x2000);
     if (charRom != NULL) {
@@ -133,18 +135,18 @@ int romMapperSvi727Col80Create(const char* filename, UInt8* charRom, int charSiz
     }
 
     rm->crtc6845 = NULL;
-    rm->crtc6845 = crtc6845Create(50, rm->charData, charSize, 0x0800, 7, 0, 80, 4);
+    rm->crtc6845 = crtc6845Create(board, 50, rm->charData, charSize, 0x0800, 7, 0, 80, 4);
 
     rm->slot  = slot;
     rm->sslot = sslot;
     rm->startPage = startPage;
 
     for (i = 0; i < pages; i++) {
-        slotMapPage(slot, sslot, i + startPage, NULL, 0, 0);
+        slotMapPage(board, slot, sslot, i + startPage, NULL, 0, 0);
     }
 
-    ioPortRegister(0x78, NULL,   writeIo, rm);
-    ioPortRegister(0x79, readIo, writeIo, rm);
+    ioPortRegister(board, 0x78, NULL,   writeIo, rm);
+    ioPortRegister(board, 0x79, readIo, writeIo, rm);
 
     reset(rm);
 
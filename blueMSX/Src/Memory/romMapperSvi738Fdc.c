@@ -38,6 +38,7 @@
 #include <stdio.h>
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt8* romData;
     WD2793* fdc;
@@ -49,7 +50,7 @@ typedef struct {
 
 static void saveState(RomMapperSvi738Fdc* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperSvi738Fdc");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperSvi738Fdc");
 
     saveStateSet(state, "drvSelect",  rm->drvSelect);
     
@@ -60,7 +61,7 @@ static void saveState(RomMapperSvi738Fdc* rm)
 
 static void loadState(RomMapperSvi738Fdc* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperSvi738Fdc");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperSvi738Fdc");
 
     rm->drvSelect  = (UInt8)saveStateGet(state, "drvSelect",  0);
 
@@ -71,8 +72,8 @@ static void loadState(RomMapperSvi738Fdc* rm)
 
 static void destroy(RomMapperSvi738Fdc* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     wd2793Destroy(rm->fdc);
 
@@ -133,8 +134,8 @@ static void write(RomMapperSvi738Fdc* rm, UInt16 address, UInt8 value)
             rm->drvSelect = value & 0x3f;
             wd2793SetSide(rm->fdc, value & 4);
             wd2793SetMotor(rm->fdc, value & 8);
-            if (diskEnabled(0)) ledSetFdd1(value & 1);
-            if (diskEnabled(1)) ledSetFdd2(value & 2);
+            if (diskEnabled(rm->board, 0)) ledSetFdd1(value & 1);
+            if (diskEnabled(rm->board, 1)) ledSetFdd2(value & 2);
             switch (value & 3) {
                 case 1:
                     wd2793SetDrive(rm->fdc, 0);
@@ -156,7 +157,7 @@ static void reset(RomMapperSvi738Fdc* rm)
     write(rm, 0xffd, 0);
 }
 
-int romMapperSvi738FdcCreate(const char* filename, UInt8* romData, 
+int romMapperSvi738FdcCreate(BoardContext* board, const char* filename, UInt8* romData, 
                               int size, int slot, int sslot, int startPage) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
@@ -169,22 +170,27 @@ int romMapperSvi738FdcCreate(const char* filename, UInt8* romData,
     }
 
     rm = malloc(sizeof(RomMapperSvi738Fdc));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(ROM_SVI738FDC, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, pages, read, peek, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, ROM_SVI738FDC, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, pages, read, peek, write, destroy, rm);
 
-    rm->romData = malloc(size);
+    rm->romData = calloc(1, size > 0x4000 ? size : 0x4000);
     memcpy(rm->romData, romData, size);
     
     rm->slot  = slot;
     rm->sslot = sslot;
     rm->startPage  = startPage;
 
-    for (i = 0; i < pages; i++) {
-        slotMapPage(slot, sslot, i + startPage, NULL, 0, 0);
+    // Only the fdc registers at 0x7fb8 - 0x7fbf and their mirrors in the
+    // upper pages need the read handler
+    slotMapPage(board, slot, sslot, startPage, rm->romData, 1, 0);
+    slotMapPageIo(board, slot, sslot, startPage + 1, rm->romData + 0x2000, 0x1fb8, 8);
+    for (i = 2; i < pages; i++) {
+        slotMapPage(board, slot, sslot, i + startPage, NULL, 0, 0);
     }
 
-    rm->fdc = wd2793Create(FDC_TYPE_WD2793);
+    rm->fdc = wd2793Create(board, FDC_TYPE_WD2793);
 
     reset(rm);
 
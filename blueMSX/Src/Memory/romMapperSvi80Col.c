@@ -36,6 +36,7 @@
 #include <stdlib.h>
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int debugHandle;
     UInt8 memBankCtrl;
@@ -46,7 +47,7 @@ static RomMapperSvi328Col80* svi328col80Instance = NULL;
 
 static void saveState(RomMapperSvi328Col80* svi328col80)
 {
-    SaveState* state = saveStateOpenForWrite("Svi80Col");
+    SaveState* state = saveStateOpenForWrite(svi328col80->board, "Svi80Col");
 
     saveStateSet(state, "memBankCtrl", svi328col80->memBankCtrl);
     
@@ -55,7 +56,7 @@ static void saveState(RomMapperSvi328Col80* svi328col80)
 
 static void loadState(RomMapperSvi328Col80* svi328col80)
 {
-    SaveState* state = saveStateOpenForRead("Svi80Col");
+    SaveState* state = saveStateOpenForRead(svi328col80->board, "Svi80Col");
 
     svi328col80->memBankCtrl = (UInt8)saveStateGet(state, "memBankCtrl", 0);
 
@@ -65,12 +66,12 @@ static void loadState(RomMapperSvi328Col80* svi328col80)
 static void destroy(RomMapperSvi328Col80* svi328col80)
 {
 
-    ioPortUnregister(0x50);
-    ioPortUnregister(0x51);
-    ioPortUnregister(0x58);
+    ioPortUnregister(svi328col80->board, 0x50);
+    ioPortUnregister(svi328col80->board, 0x51);
+    ioPortUnregister(svi328col80->board, 0x58);
 
-    deviceManagerUnregister(svi328col80->deviceHandle);
-    debugDeviceUnregister(svi328col80->debugHandle);
+    deviceManagerUnregister(svi328col80->board, svi328col80->deviceHandle);
+    debugDeviceUnregister(svi328col80->board, svi328col80->debugHandle);
 
     free(svi328col80);
 }
@@ -144,7 +145,7 @@ static void getDebugInfo(RomMapperSvi328Col80* rm, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 2, 0x58, DBG_IO_READWRITE, peekIo(rm, 0x58));
 }
 
-int romMapperSvi328Col80Create(int frameRate, UInt8* romData, int size)
+int romMapperSvi328Col80Create(BoardContext* board, int frameRate, UInt8* romData, int size)
 {
     DeviceCallbacks callbacks = {destroy, reset, saveState, loadState};
     DebugCallbacks dbgCallbacks = {getDebugInfo, NULL, NULL, NULL};
@@ -154,18 +155,19 @@ int romMapperSvi328Col80Create(int frameRate, UInt8* romData, int size)
     	return 0;
 
     svi328col80 = malloc(sizeof(RomMapperSvi328Col80));
+    svi328col80->board = board;
     svi328col80Instance = svi328col80;
 
-    svi328col80->deviceHandle = deviceManagerRegister(ROM_SVI328COL80, &callbacks, svi328col80);
+    svi328col80->deviceHandle = deviceManagerRegister(board, ROM_SVI328COL80, &callbacks, svi328col80);
 
     svi328col80->crtc6845 = NULL;
-    svi328col80->crtc6845 = crtc6845Create(frameRate, romData, size, 0x800, 7, 0, 82, 4);
+    svi328col80->crtc6845 = crtc6845Create(board, frameRate, romData, size, 0x800, 7, 0, 82, 4);
 
-    svi328col80->debugHandle = debugDeviceRegister(DBGTYPE_VIDEO, langDbgDevSvi80Col(), &dbgCallbacks, svi328col80);
+    svi328col80->debugHandle = debugDeviceRegister(board, DBGTYPE_VIDEO, langDbgDevSvi80Col(), &dbgCallbacks, svi328col80);
 
-    ioPortRegister(0x50, NULL,   writeIo, svi328col80);
-    ioPortRegister(0x51, readIo, writeIo, svi328col80);
-    ioPortRegister(0x58, readIo, writeIo, svi328col80);
+    ioPortRegister(board, 0x50, NULL,   writeIo, svi328col80);
+    ioPortRegister(board, 0x51, readIo, writeIo, svi328col80);
+    ioPortRegister(board, 0x58, readIo, writeIo, svi328col80);
 
     reset(svi328col80);
 
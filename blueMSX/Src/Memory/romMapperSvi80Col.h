@@ -35,6 +35,6 @@ void svi328Col80MemWrite(UInt16 address, UInt8 value);
 UInt8 svi328Col80MemRead(UInt16 address);
 int svi328Col80MemBankCtrlStatus(void);
 
-int romMapperSvi328Col80Create(int frameRate, UInt8* romData, int size);
+int romMapperSvi328Col80Create(BoardContext* board, int frameRate, UInt8* romData, int size);
 
 #endif
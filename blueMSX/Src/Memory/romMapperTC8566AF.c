@@ -37,6 +37,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     TC8566AF* fdc;
     UInt8* romData;
@@ -48,9 +49,20 @@ typedef struct {
     int romMapper[4];
 } RomMapperTC8566AF;
 
+static void mapPages(RomMapperTC8566AF* rm)
+{
+    UInt8* bankData = rm->romData + 0x4000 * rm->romMapper[0];
+
+    // The fdc registers at the end of the bank are read through the handler
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage, bankData, 1, 0);
+    slotMapPageIo(rm->board, rm->slot, rm->sslot, rm->startPage + 1, bankData + 0x2000, 0x1ff0, 0x10);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 2, NULL, 0, 0);
+    slotMapPage(rm->board, rm->slot, rm->sslot, rm->startPage + 3, NULL, 0, 0);
+}
+
 static void saveState(RomMapperTC8566AF* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperTC8566AF");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperTC8566AF");
     char tag[16];
     int i;
 
@@ -66,7 +78,7 @@ static void saveState(RomMapperTC8566AF* rm)
 
 static void loadState(RomMapperTC8566AF* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperTC8566AF");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperTC8566AF");
     char tag[16];
     int i;
 
@@ -77,19 +89,15 @@ static void loadState(RomMapperTC8566AF* rm)
 
     saveStateClose(state);
 
-    for (i = 0; i < 4; i += 2) {
-        UInt8* bankData = rm->romData + (rm->romMapper[i] << 14);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i,     bankData, 0, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 1, bankData + 0x2000, 0, 0);
-    }
+    mapPages(rm);
 
     tc8566afLoadState(rm->fdc);
 }
 
 static void destroy(RomMapperTC8566AF* rm)
 {
-    slotUnregister(rm->slot, rm->sslot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->slot, rm->sslot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     tc8566afDestroy(rm->fdc);
 
@@ -99,17 +107,12 @@ static void destroy(RomMapperTC8566AF* rm)
 
 static void reset(RomMapperTC8566AF* rm)
 {
-    int i;
-
     tc8566afReset(rm->fdc);
 
     rm->romMapper[0] = 0;
     rm->romMapper[2] = 0;
 
-    for (i = 0; i < 4; i += 2) {   
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i,     rm->romData + rm->romMapper[i] * 0x2000, 0, 0);
-        slotMapPage(rm->slot, rm->sslot, rm->startPage + i + 1, rm->romData + rm->romMapper[i] * 0x2000 + 0x2000, 0, 0);
-    }
+    mapPages(rm);
 }
 
 static UInt8 read(RomMapperTC8566AF* rm, UInt16 address) 
@@ -187,6 +190,7 @@ static void write(RomMapperTC8566AF* rm, UInt16 address, UInt8 value)
     
     if ((address == 0x6000) || (address == 0x7ff0) || (address == 0x7ffe)) {
         rm->romMapper[0] =  value & rm->romMask;
+        mapPages(rm);
         return;
     } 
     else {
@@ -225,17 +229,18 @@ static void write(RomMapperTC8566AF* rm, UInt16 address, UInt8 value)
     }
 }
 
-int romMapperTC8566AFCreate(const char* filename, UInt8* romData, 
+int romMapperTC8566AFCreate(BoardContext* board, const char* filename, UInt8* romData, 
                            int size, int slot, int sslot, int startPage,
                            RomType romType) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     RomMapperTC8566AF* rm;
 
-    rm = malloc(sizeof(RomMapperTC8566AF));
+    rm = calloc(1, sizeof(RomMapperTC8566AF));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(romType, &callbacks, rm);
-    slotRegister(slot, sslot, startPage, 4, read, peek, write, destroy, rm);
+    rm->deviceHandle = deviceManagerRegister(board, romType, &callbacks, rm);
+    slotRegister(board, slot, sslot, startPage, 4, read, peek, write, destroy, rm);
 
     size = (size + 0x3fff) & ~0x3fff;
 
@@ -247,7 +252,7 @@ int romMapperTC8566AFCreate(const char* filename, UInt8* romData,
     rm->startPage  = startPage;
     rm->romType = romType;
 
-    rm->fdc = tc8566afCreate();
+    rm->fdc = tc8566afCreate(board);
 
     reset(rm);
 
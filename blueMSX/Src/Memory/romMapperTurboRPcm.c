@@ -39,6 +39,7 @@
 #include <stdio.h>
 
 typedef struct {
+    BoardContext* board;
     DAC*   dac;
     int    deviceHandle;
     int    debugHandle;
@@ -52,7 +53,7 @@ typedef struct {
 
 static void saveState(RomMapperTurboRPcm* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperTurboRPcm");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperTurboRPcm");
 
     saveStateSet(state, "sample",  rm->sample);
     saveStateSet(state, "status",  rm->status);
@@ -65,7 +66,7 @@ static void saveState(RomMapperTurboRPcm* rm)
 
 static void loadState(RomMapperTurboRPcm* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperTurboRPcm");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperTurboRPcm");
 
     rm->sample  = (UInt8)saveStateGet(state, "sample",  0);
     rm->status  = (UInt8)saveStateGet(state, "status",  0);
@@ -80,12 +81,12 @@ static void loadState(RomMapperTurboRPcm* rm)
 
 static void destroy(RomMapperTurboRPcm* rm)
 {
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
     dacDestroy(rm->dac);
 
-    ioPortUnregister(0xa4);
-    ioPortUnregister(0xa5);
+    ioPortUnregister(rm->board, 0xa4);
+    ioPortUnregister(rm->board, 0xa5);
 
     free(rm);
 }
@@ -93,7 +94,7 @@ static void destroy(RomMapperTurboRPcm* rm)
 static UInt8 getTimerCounter(RomMapperTurboRPcm* rm)
 {
     UInt64 elapsed;
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(rm->board);
 
     elapsed      = 15750 * (UInt64)(systemTime - rm->refTime) + rm->refFrag;
     rm->refTime  = systemTime;
@@ -150,7 +151,7 @@ static void write(RomMapperTurboRPcm* rm, UInt16 ioPort, UInt8 value)
 
 static void reset(RomMapperTurboRPcm* rm)
 {
-    rm->refTime = boardSystemTime();
+    rm->refTime = boardSystemTime(rm->board);
     rm->refFrag = 0;
     rm->time    = 0;
 }
@@ -164,23 +165,25 @@ static void getDebugInfo(RomMapperTurboRPcm* rm, DbgDevice* dbgDevice)
     dbgIoPortsAddPort(ioPorts, 1, 0xa5, DBG_IO_READWRITE, peek(rm, 0xa5));
 }
 
-int romMapperTurboRPcmCreate() 
+int romMapperTurboRPcmCreate(BoardContext* board) 
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     RomMapperTurboRPcm* rm = malloc(sizeof(RomMapperTurboRPcm));
 
-    rm->deviceHandle = deviceManagerRegister(ROM_TURBORPCM, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_AUDIO, langDbgDevPcm(), &dbgCallbacks, rm);
+    rm->board = board;
 
-    rm->mixer  = boardGetMixer();
+    rm->deviceHandle = deviceManagerRegister(board, ROM_TURBORPCM, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_AUDIO, langDbgDevPcm(), &dbgCallbacks, rm);
+
+    rm->mixer  = boardGetMixer(board);
 
     rm->dac    = dacCreate(rm->mixer, DAC_MONO);
 	rm->status = 0;
     rm->time   = 0;
 
-    ioPortRegister(0xa4, read, write, rm);
-    ioPortRegister(0xa5, read, write, rm);
+    ioPortRegister(board, 0xa4, read, write, rm);
+    ioPortRegister(board, 0xa5, read, write, rm);
 
     return 1;
 }
@@ -37,6 +37,7 @@
 
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     UInt32 counter;
     UInt32 refTime;
@@ -47,7 +48,7 @@ static RomMapperTurboRTimer* theTimer = NULL;
 
 static void saveState(RomMapperTurboRTimer* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperTurboRTimer");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperTurboRTimer");
 
     saveStateSet(state, "counter", rm->counter);
     saveStateSet(state, "refTime", rm->refTime);
@@ -58,10 +59,10 @@ static void saveState(RomMapperTurboRTimer* rm)
 
 static void loadState(RomMapperTurboRTimer* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperTurboRTimer");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperTurboRTimer");
 
     rm->counter = saveStateGet(state, "counter", 0);
-    rm->refTime = saveStateGet(state, "refTime", boardSystemTime());
+    rm->refTime = saveStateGet(state, "refTime", boardSystemTime(rm->board));
     rm->refFrag = saveStateGet(state, "refFrag", 0);
 
     saveStateClose(state);
@@ -69,10 +70,10 @@ static void loadState(RomMapperTurboRTimer* rm)
 
 static void destroy(RomMapperTurboRTimer* rm)
 {
-    deviceManagerUnregister(rm->deviceHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
-    ioPortUnregister(0xe6);
-    ioPortUnregister(0xe7);
+    ioPortUnregister(rm->board, 0xe6);
+    ioPortUnregister(rm->board, 0xe7);
 
     free(rm);
 
@@ -82,7 +83,7 @@ static void destroy(RomMapperTurboRTimer* rm)
 void romMapperTurboRTimerSync()
 {
     if (theTimer != NULL) {
-        UInt32 systemTime = boardSystemTime();
+        UInt32 systemTime = boardSystemTime(theTimer->board);
         UInt64 elapsed = 255682 * (UInt64)(systemTime - theTimer->refTime) + theTimer->refFrag;
         theTimer->refTime = systemTime;
         theTimer->refFrag = (UInt32)(elapsed % boardFrequency());
@@ -107,23 +108,25 @@ static UInt8 read(RomMapperTurboRTimer* rm, UInt16 ioPort)
 static void write(RomMapperTurboRTimer* rm, UInt16 ioPort, UInt8 value)
 {
     theTimer->counter = 0;
-    rm->refTime = boardSystemTime();
+    rm->refTime = boardSystemTime(rm->board);
     rm->refFrag = 0;
 }
 
-int romMapperTurboRTimerCreate() 
+int romMapperTurboRTimerCreate(BoardContext* board) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
     RomMapperTurboRTimer* rm = malloc(sizeof(RomMapperTurboRTimer));
 
-    rm->deviceHandle = deviceManagerRegister(ROM_TURBORTIMER, &callbacks, rm);
+    rm->board = board;
 
-    rm->refTime = boardSystemTime();
+    rm->deviceHandle = deviceManagerRegister(board, ROM_TURBORTIMER, &callbacks, rm);
+
+    rm->refTime = boardSystemTime(board);
     rm->refFrag = 0;
     rm->counter = 0;
 
-    ioPortRegister(0xe6, read, write, rm);
-    ioPortRegister(0xe7, read, write, rm);
+    ioPortRegister(board, 0xe6, read, write, rm);
+    ioPortRegister(board, 0xe7, read, write, rm);
 
     theTimer = rm;
 
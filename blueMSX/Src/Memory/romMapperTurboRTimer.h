@@ -30,7 +30,7 @@
 
 #include "MsxTypes.h"
 
-int romMapperTurboRTimerCreate();
+int romMapperTurboRTimerCreate(BoardContext* board);
 void romMapperTurboRTimerSync();
 
 #endif
@@ -107,6 +107,7 @@ static int logNo = 0;
 #endif
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int pSlot;
     int sSlot;
@@ -177,7 +178,7 @@ static void setMapperLow(SramMapperEseSCC* rm, int page, UInt8 value)
 
     if ((value != rm->mapper[page]) || change)  {
         rm->mapper[page] = value;
-        slotMapPage(rm->pSlot, rm->sSlot, rm->startPage + page,
+        slotMapPage(rm->board, rm->pSlot, rm->sSlot, rm->startPage + page,
                     rm->sramData + value * 0x2000, readMode, writeMode);
         DBGLOG4("mapper low change: p%x v%x r%x w%x\n", page, value, readMode, writeMode);
     } else {
@@ -208,13 +209,13 @@ static void setMapperHigh(SramMapperEseSCC* rm, UInt8 value)
         if (rm->spcEnable) {
             rm->mapper[0] = mapperLow0;
             rm->preChange = 1;
-            slotMapPage(rm->pSlot, rm->sSlot, rm->startPage, NULL, 0, 0);
+            slotMapPage(rm->board, rm->pSlot, rm->sSlot, rm->startPage, NULL, 0, 0);
             DBGLOG1("mapper high change: p0 SPC (hidden %x) r0 w0\n", rm->mapper[0]);
         } else {
             int B6 = newValue & 0x40;
             rm->preChange = 0;
             rm->mapper[0] = (mapperLow0 | B6) & rm->mapperMask;
-            slotMapPage(rm->pSlot, rm->sSlot, rm->startPage,
+            slotMapPage(rm->board, rm->pSlot, rm->sSlot, rm->startPage,
                         rm->sramData + rm->mapper[0] * 0x2000,
                         1, rm->writeEnable);
             DBGLOG2("mapper high change: p0 v%x r1 w%d\n", rm->mapper[0], rm->writeEnable);
@@ -248,7 +249,7 @@ static void saveState(SramMapperEseSCC* rm)
 {
     char tag[16];
     int i;
-    SaveState* state = saveStateOpenForWrite("mapperEseSCC");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperEseSCC");
 
     saveStateSetBuffer(state, "sramData", rm->sramData, rm->sramSize);
     saveStateSet(state, "sccEnable"  , rm->sccEnable);
@@ -269,7 +270,7 @@ static void saveState(SramMapperEseSCC* rm)
 
 static void loadState(SramMapperEseSCC* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperEseSCC");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperEseSCC");
     char tag[16];
     int i;
 
@@ -298,8 +299,8 @@ static void destroy(SramMapperEseSCC* rm)
     if (!rm->isZip) sramSave(rm->sramFilename, rm->sramData, rm->sramSize, NULL, 0);
     if (rm->isAutoName) --autoNameCounter[rm->type][rm->element];
 
-    slotUnregister(rm->pSlot, rm->sSlot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->pSlot, rm->sSlot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
 #ifdef ESESCCDEBUG
     --logNo;
@@ -448,7 +449,7 @@ static void write(SramMapperEseSCC* rm, UInt16 address, UInt8 value)
     DBGLOG1("can't write: %x\n", address);
 }
 
-int sramMapperEseSCCCreate(const char* filename, UInt8* buf, int size, int pSlot, int sSlot, int startPage, int hdId, int mode)
+int sramMapperEseSCCCreate(BoardContext* board, const char* filename, UInt8* buf, int size, int pSlot, int sSlot, int startPage, int hdId, int mode)
 {
     DeviceCallbacks callbacks = { (void*)destroy, (void*)reset, (void*)saveState, (void*)loadState };
 
@@ -461,12 +462,13 @@ int sramMapperEseSCCCreate(const char* filename, UInt8* buf, int size, int pSlot
     }
 
     rm = malloc(sizeof(SramMapperEseSCC));
+    rm->board = board;
 
     rm->type  = mode & 1;
     rm->isZip = mode & 0x80;
 
-    rm->deviceHandle = deviceManagerRegister(SRAM_ESESCC, &callbacks, rm);
-    slotRegister(pSlot, sSlot, startPage, 4, (SlotRead)read, (SlotRead)peek,
+    rm->deviceHandle = deviceManagerRegister(board, SRAM_ESESCC, &callbacks, rm);
+    slotRegister(board, pSlot, sSlot, startPage, 4, (SlotRead)read, (SlotRead)peek,
                 (SlotWrite)write, (SlotEject)destroy, rm);
 
     rm->pSlot          = pSlot;
@@ -517,16 +519,16 @@ int sramMapperEseSCCCreate(const char* filename, UInt8* buf, int size, int pSlot
 
     for (i = 0; i < 4; ++i) {
         rm->mapper[i] = i;
-        slotMapPage(rm->pSlot, rm->sSlot, rm->startPage + i,
+        slotMapPage(board, rm->pSlot, rm->sSlot, rm->startPage + i,
                     rm->sramData + i * 0x2000, 1, 0);
     }
 
     // initialize SCC
-    rm->scc = sccCreate(boardGetMixer());
+    rm->scc = sccCreate(board, boardGetMixer(board));
     sccSetMode(rm->scc, SCC_REAL);
 
     // initialize SPC
-    rm->spc = rm->type ? mb89352Create(hdId) : NULL;
+    rm->spc = rm->type ? mb89352Create(board, hdId) : NULL;
 
     return 1;
 }
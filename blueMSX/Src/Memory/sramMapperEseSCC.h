@@ -30,6 +30,6 @@
 
 #include "MsxTypes.h"
 
-int sramMapperEseSCCCreate(const char* filename, UInt8* buf, int size, int pSlot, int sSlot, int startPage, int hdId, int mode);
+int sramMapperEseSCCCreate(BoardContext* board, const char* filename, UInt8* buf, int size, int pSlot, int sSlot, int startPage, int hdId, int mode);
 
 #endif
@@ -38,9 +38,10 @@
 #include <string.h>
 #include <stdio.h>
 
-extern void msxEnableCpuFreq_1_5(int enable);
+extern void msxEnableCpuFreq_1_5(BoardContext* board, int enable);
 
 typedef struct {
+    BoardContext* board;
     int    deviceHandle;
     int    debugHandle;
     UInt8  sram[0x800];
@@ -54,7 +55,7 @@ typedef struct {
 
 static void saveState(SramMapperMatsushita* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperMatsushita");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperMatsushita");
 
     saveStateSet(state, "address", rm->address);
     saveStateSet(state, "color1",  rm->color1);
@@ -67,7 +68,7 @@ static void saveState(SramMapperMatsushita* rm)
 
 static void loadState(SramMapperMatsushita* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperMatsushita");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperMatsushita");
 
     rm->address =        saveStateGet(state, "address", 0);
     rm->color1  = (UInt8)saveStateGet(state, "color1",  0);
@@ -77,17 +78,17 @@ static void loadState(SramMapperMatsushita* rm)
 
     saveStateClose(state);
 
-    msxEnableCpuFreq_1_5(rm->cpu15);
+    msxEnableCpuFreq_1_5(rm->board, rm->cpu15);
 }
 
 static void destroy(SramMapperMatsushita* rm)
 {
     sramSave(sramCreateFilename("Matsushita.SRAM"), rm->sram, 0x800, NULL, 0);
 
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
-    ioPortUnregisterSub(0x08);
+    ioPortUnregisterSub(rm->board, 0x08);
 
     free(rm);
 }
@@ -153,7 +154,7 @@ static void write(SramMapperMatsushita* rm, UInt16 ioPort, UInt8 value)
 	switch (ioPort & 0x0f) {
     case 1:
         rm->cpu15 = (value & 1) == (rm->inverted ? 0 : 1);
-        msxEnableCpuFreq_1_5(rm->cpu15);
+        msxEnableCpuFreq_1_5(rm->board, rm->cpu15);
         break;
 	case 3:
 		rm->color2 = value >> 4;
@@ -179,7 +180,7 @@ static void write(SramMapperMatsushita* rm, UInt16 ioPort, UInt8 value)
 
 static void getDebugInfo(SramMapperMatsushita* rm, DbgDevice* dbgDevice)
 {
-    if (ioPortCheckSub(0x08)) {
+    if (ioPortCheckSub(rm->board, 0x08)) {
         DbgIoPorts* ioPorts;
         int i;
 
@@ -191,16 +192,17 @@ static void getDebugInfo(SramMapperMatsushita* rm, DbgDevice* dbgDevice)
     }
 }
 
-int sramMapperMatsushitaCreate(int inverted) 
+int sramMapperMatsushitaCreate(BoardContext* board, int inverted) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     SramMapperMatsushita* rm;
 
     rm = malloc(sizeof(SramMapperMatsushita));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(inverted ? SRAM_MATSUCHITA_INV : SRAM_MATSUCHITA, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, langDbgDevMatsushita(), &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, inverted ? SRAM_MATSUCHITA_INV : SRAM_MATSUCHITA, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, langDbgDevMatsushita(), &dbgCallbacks, rm);
 
     memset(rm->sram, 0xff, 0x800);
     rm->address = 0;
@@ -208,7 +210,7 @@ int sramMapperMatsushitaCreate(int inverted)
 
     sramLoad(sramCreateFilename("Matsushita.SRAM"), rm->sram, 0x800, NULL, 0);
 
-    ioPortRegisterSub(0x08, read, write, rm);
+    ioPortRegisterSub(board, 0x08, read, write, rm);
 
     return 1;
 }
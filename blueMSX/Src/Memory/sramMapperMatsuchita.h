@@ -30,6 +30,6 @@
 
 #include "MsxTypes.h"
 
-int sramMapperMatsushitaCreate();
+int sramMapperMatsushitaCreate(BoardContext* board, int inverted);
 
 #endif
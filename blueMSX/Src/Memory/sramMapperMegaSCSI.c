@@ -100,6 +100,7 @@ static int megascsiTotal = 0;
 #define SPC_BANK 0x7f
 
 typedef struct {
+    BoardContext* board;
     int deviceHandle;
     int pSlot;
     int sSlot;
@@ -144,7 +145,7 @@ static void setMapper(SramMapperMegaSCSI* rm, int page, UInt8 value)
     if (rm->mapper[page] != value) {
         rm->mapper[page] = value;
         DBGLOG4("bank change: p%x v%x r%d w%d\n", page, value, readFlag, writeFlag);
-        slotMapPage(rm->pSlot, rm->sSlot, rm->startPage + page,
+        slotMapPage(rm->board, rm->pSlot, rm->sSlot, rm->startPage + page,
                     adr, readFlag, writeFlag);
     } else {
         DBGLOG("bank not changed\n");
@@ -158,7 +159,7 @@ static void reset(SramMapperMegaSCSI* rm)
     for (i = 0; i < 4; ++i) {
         //setMapper(rm, i, 0);
         rm->mapper[i] = 0;
-        slotMapPage(rm->pSlot, rm->sSlot, rm->startPage + i, rm->sramData, 1, 0);
+        slotMapPage(rm->board, rm->pSlot, rm->sSlot, rm->startPage + i, rm->sramData, 1, 0);
     }
 
     if (rm->type) mb89352Reset(rm->spc, 1);
@@ -173,7 +174,7 @@ static void saveState(SramMapperMegaSCSI* rm)
 {
     char tag[16];
     int i;
-    SaveState* state = saveStateOpenForWrite("mapperMegaSCSI");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperMegaSCSI");
 
     saveStateSetBuffer(state, "sramData", rm->sramData, rm->sramSize);
 
@@ -190,7 +191,7 @@ static void saveState(SramMapperMegaSCSI* rm)
 
 static void loadState(SramMapperMegaSCSI* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperMegaSCSI");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperMegaSCSI");
     char tag[16];
     int i;
 
@@ -215,8 +216,8 @@ static void destroy(SramMapperMegaSCSI* rm)
         sramSave(rm->sramFilename, rm->sramData, rm->sramSize, NULL, 0);
     }
 
-    slotUnregister(rm->pSlot, rm->sSlot, rm->startPage);
-    deviceManagerUnregister(rm->deviceHandle);
+    slotUnregister(rm->board, rm->pSlot, rm->sSlot, rm->startPage);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
 
     if (rm->type) {
         mb89352Destroy(rm->spc);
@@ -295,7 +296,7 @@ static void write(SramMapperMegaSCSI* rm, UInt16 address, UInt8 value)
     }
 }
 
-int sramMapperMegaSCSICreate(const char* filename, UInt8* buf, int size, int pSlot, int sSlot, int startPage, int hdId, int flag)
+int sramMapperMegaSCSICreate(BoardContext* board, const char* filename, UInt8* buf, int size, int pSlot, int sSlot, int startPage, int hdId, int flag)
 {
     DeviceCallbacks callbacks = {
         (void*)destroy, (void*)reset, (void*)saveState, (void*)loadState };
@@ -309,6 +310,7 @@ int sramMapperMegaSCSICreate(const char* filename, UInt8* buf, int size, int pSl
     }
 
     rm = malloc(sizeof(SramMapperMegaSCSI));
+    rm->board = board;
     rm->type = flag & 1;
     rm->isZip = flag & 0x80;
 
@@ -323,14 +325,14 @@ int sramMapperMegaSCSICreate(const char* filename, UInt8* buf, int size, int pSl
     }
 #endif
 
-    rm->deviceHandle = deviceManagerRegister(SRAM_MEGASCSI, &callbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, SRAM_MEGASCSI, &callbacks, rm);
 
     if (rm->type) {
-        slotRegister(pSlot, sSlot, startPage, 4,
+        slotRegister(board, pSlot, sSlot, startPage, 4,
                     (SlotRead)read, (SlotRead)peek, (SlotWrite)write,
                     (SlotEject)destroy, rm);
     } else {
-        slotRegister(pSlot, sSlot, startPage, 4, NULL, NULL, (SlotWrite)write,
+        slotRegister(board, pSlot, sSlot, startPage, 4, NULL, NULL, (SlotWrite)write,
                     (SlotEject)destroy, rm);
     }
 
@@ -365,11 +367,11 @@ int sramMapperMegaSCSICreate(const char* filename, UInt8* buf, int size, int pSl
     // initialized mapper
     for (i = 0; i < 4; ++i) {
         rm->mapper[i] = 0;
-        slotMapPage(rm->pSlot, rm->sSlot, rm->startPage + i, rm->sramData, 1, 0);
+        slotMapPage(board, rm->pSlot, rm->sSlot, rm->startPage + i, rm->sramData, 1, 0);
     }
 
     // initialized spc
-    rm->spc = rm->type ? mb89352Create(hdId) : NULL;
+    rm->spc = rm->type ? mb89352Create(board, hdId) : NULL;
 
     return 1;
 }
@@ -30,7 +30,7 @@
 
 #include "MsxTypes.h"
 
-int sramMapperMegaSCSICreate(const char* filename, UInt8* buf, int size,
+int sramMapperMegaSCSICreate(BoardContext* board, const char* filename, UInt8* buf, int size,
                 int pSlot, int sSlot, int startPage, int hdId, int flag);
 
 #endif
@@ -40,6 +40,7 @@
 extern int frontSwitchEnabled();
 
 typedef struct {
+    BoardContext* board;
     int    deviceHandle;
     int    debugHandle;
     UInt8  sram[0x10];
@@ -51,7 +52,7 @@ typedef struct {
 
 static void saveState(SramMapperS1985* rm)
 {
-    SaveState* state = saveStateOpenForWrite("mapperS1985");
+    SaveState* state = saveStateOpenForWrite(rm->board, "mapperS1985");
 
     saveStateSet(state, "address", rm->address);
     saveStateSet(state, "color1",  rm->color1);
@@ -63,7 +64,7 @@ static void saveState(SramMapperS1985* rm)
 
 static void loadState(SramMapperS1985* rm)
 {
-    SaveState* state = saveStateOpenForRead("mapperS1985");
+    SaveState* state = saveStateOpenForRead(rm->board, "mapperS1985");
 
     rm->address =        saveStateGet(state, "address", 0);
     rm->color1  = (UInt8)saveStateGet(state, "color1",  0);
@@ -77,10 +78,10 @@ static void destroy(SramMapperS1985* rm)
 {
     sramSave(sramCreateFilename("S1985.SRAM"), rm->sram, 0x10, NULL, 0);
 
-    deviceManagerUnregister(rm->deviceHandle);
-    debugDeviceUnregister(rm->debugHandle);
+    deviceManagerUnregister(rm->board, rm->deviceHandle);
+    debugDeviceUnregister(rm->board, rm->debugHandle);
 
-    ioPortUnregisterSub(0x08);
+    ioPortUnregisterSub(rm->board, 0x08);
 
     free(rm);
 }
@@ -147,7 +148,7 @@ static void write(SramMapperS1985* rm, UInt16 ioPort, UInt8 value)
 
 static void getDebugInfo(SramMapperS1985* rm, DbgDevice* dbgDevice)
 {
-    if (ioPortCheckSub(0xfe)) {
+    if (ioPortCheckSub(rm->board, 0xfe)) {
         DbgIoPorts* ioPorts;
         int i;
 
@@ -159,23 +160,24 @@ static void getDebugInfo(SramMapperS1985* rm, DbgDevice* dbgDevice)
     }
 }
 
-int sramMapperS1985Create() 
+int sramMapperS1985Create(BoardContext* board) 
 {
     DeviceCallbacks callbacks = { destroy, NULL, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     SramMapperS1985* rm;
 
     rm = malloc(sizeof(SramMapperS1985));
+    rm->board = board;
 
-    rm->deviceHandle = deviceManagerRegister(SRAM_S1985, &callbacks, rm);
-    rm->debugHandle = debugDeviceRegister(DBGTYPE_BIOS, langDbgDevS1985(), &dbgCallbacks, rm);
+    rm->deviceHandle = deviceManagerRegister(board, SRAM_S1985, &callbacks, rm);
+    rm->debugHandle = debugDeviceRegister(board, DBGTYPE_BIOS, langDbgDevS1985(), &dbgCallbacks, rm);
 
     memset(rm->sram, 0xff, 0x10);
     rm->address = 0;
 
     sramLoad(sramCreateFilename("S1985.SRAM"), rm->sram, 0x10, NULL, 0);
 
-    ioPortRegisterSub(0xfe, read, write, rm);
+    ioPortRegisterSub(board, 0xfe, read, write, rm);
 
     return 1;
 }
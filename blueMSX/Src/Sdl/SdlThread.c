@@ -28,6 +28,11 @@
 #include "ArchThread.h"
 #include <SDL.h>
 #include <stdlib.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
 
 static int threadEntry(void* data) 
 {
@@ -44,6 +49,11 @@ void* archThreadCreate(void (*entryPoint)(), int priority) {
     return sdlThread;
 }
 
+// SDL threads get the default stack size of the host
+void* archThreadCreateEx(void (*entryPoint)(), int priority, int stacksize) { 
+    return archThreadCreate(entryPoint, priority);
+}
+
 void archThreadJoin(void* thread, int timeout) 
 {
     SDL_Thread* sdlThread = (SDL_Thread*)thread;
@@ -62,3 +72,81 @@ void archThreadSleep(int milliseconds)
 {
     SDL_Delay(milliseconds);
 }
+
+int archThreadGetCpuCount()
+{
+#ifdef _SC_NPROCESSORS_ONLN
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return count > 0 ? (int)count : 1;
+#else
+    return 1;
+#endif
+}
+
+#ifdef _WIN32
+
+int archAtomicGet(volatile int* value)
+{
+    return InterlockedExchangeAdd((LONG*)value, 0);
+}
+
+void archAtomicSet(volatile int* value, int newValue)
+{
+    InterlockedExchange((LONG*)value, newValue);
+}
+
+int archAtomicExchange(volatile int* value, int newValue)
+{
+    return InterlockedExchange((LONG*)value, newValue);
+}
+
+int archAtomicCompareExchange(volatile int* value, int oldValue, int newValue)
+{
+    return InterlockedCompareExchange((LONG*)value, newValue, oldValue);
+}
+
+#else
+
+int archAtomicGet(volatile int* value)
+{
+    return __sync_fetch_and_add(value, 0);
+}
+
+void archAtomicSet(volatile int* value, int newValue)
+{
+    archAtomicExchange(value, newValue);
+}
+
+int archAtomicExchange(volatile int* value, int newValue)
+{
+    int oldValue;
+
+    do {
+        oldValue = *value;
+    } while (__sync_val_compare_and_swap(value, oldValue, newValue) != oldValue);
+
+    return oldValue;
+}
+
+int archAtomicCompareExchange(volatile int* value, int oldValue, int newValue)
+{
+    return __sync_val_compare_and_swap(value, oldValue, newValue);
+}
+
+#endif
+
+void archThreadOnce(volatile int* once, void (*init)())
+{
+    if (archAtomicGet(once) == 2) {
+        return;
+    }
+    if (archAtomicCompareExchange(once, 0, 1) == 0) {
+        init();
+        archAtomicSet(once, 2);
+        return;
+    }
+    while (archAtomicGet(once) != 2) {
+        archThreadSleep(1);
+    }
+}
@@ -28,6 +28,11 @@
 #include "ArchTimer.h"
 #include <stdlib.h>
 #include <SDL.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
 
 #ifdef NO_TIMERS
 
@@ -40,17 +45,14 @@ void archTimerDestroy(void* timer) {}
 
 // The only timer that is required is a high res timer. The resolution is
 // not super important, the higher the better, but one tick every 10ms is
-// good enough. The frequency argument is in Hz and is 1000 or less.
+// good enough. The frequency argument is in Hz. SDL_GetTicks() counts
+// milliseconds, so frequencies above 1000 Hz are scaled but do not get a
+// finer resolution than one millisecond.
 UInt32 archGetSystemUpTime(UInt32 frequency) 
 {
-    return SDL_GetTicks() / (1000 / frequency);
+    return (UInt32)((UInt64)SDL_GetTicks() * frequency / 1000);
 }
 
-// This is just a timer value with a frequency as high as possible. 
-// The frequency of the timer is not important.
-UInt32 archGetHiresTimer() {
-    return SDL_GetTicks();
-}
 
 #else 
 
@@ -94,11 +96,32 @@ void archTimerDestroy(void* timer)
 
 UInt32 archGetSystemUpTime(UInt32 frequency) 
 {
-    return SDL_GetTicks() / (1000 / frequency);
+    return (UInt32)((UInt64)SDL_GetTicks() * frequency / 1000);
 }
 
+
+#endif
+
+// SDL 1.2 only has the millisecond SDL_GetTicks(), so the high res timer
+// reads the host clock directly. It counts microseconds and wraps around,
+// only the difference between two values is meaningful.
 UInt32 archGetHiresTimer() {
-    return SDL_GetTicks();
-}
+#ifdef _WIN32
+    static LONGLONG frequency = 0;
+    LARGE_INTEGER li;
 
-#endif
\ No newline at end of file
+    if (frequency == 0) {
+        QueryPerformanceFrequency(&li);
+        frequency = li.QuadPart;
+    }
+    QueryPerformanceCounter(&li);
+
+    return (UInt32)(li.QuadPart / frequency * 1000000 + li.QuadPart % frequency * 1000000 / frequency);
+#else
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+
+    return tv.tv_sec * 1000000 + tv.tv_usec;
+#endif
+}
@@ -31,12 +31,14 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <SDL.h>
 
 #include "CommandLine.h"
 #include "Properties.h"
 #include "ArchFile.h"
 #include "VideoRender.h"
+#include "VideoPipeline.h"
 #include "AudioMixer.h"
 #include "Casette.h"
 #include "PrinterIO.h"
@@ -49,7 +51,9 @@
 #include "Actions.h"
 #include "Language.h"
 #include "LaunchFile.h"
+#include "SaveState.h"
 #include "ArchEvent.h"
+#include "ArchThread.h"
 #include "ArchSound.h"
 #include "ArchNotifications.h"
 #include "JoystickPort.h"
@@ -76,15 +80,14 @@ static Mixer* mixer;
 static Shortcuts* shortcuts;
 static int doQuit = 0;
 
-static int pendingDisplayEvents = 0;
-static void* dpyUpdateAckEvent = NULL;
+static volatile int displayEventPending = 0;
 
 static SDL_Surface *surface;
 static int   bitDepth;
 static int   zoom = 1;
-static char* displayData[2] = { NULL, NULL };
-static int   curDisplayData = 0;
+static char* displayData = NULL;
 static int   displayPitch = 0;
+static int   displayReset = 1;
 #ifdef ENABLE_OPENGL
 static GLfloat texCoordX;
 static GLfloat texCoordY;
@@ -113,8 +116,7 @@ void createSdlSurface(int width, int height, int fullscreen)
     if (!surface) { bitDepth = 16; surface = SDL_SetVideoMode(width, height, bitDepth, flags); }
 
     if (surface != NULL) {
-        displayData[0] = (char*)surface->pixels;
-        curDisplayData = 0;
+        displayData = (char*)surface->pixels;
         displayPitch = surface->pitch;
     }
 }
@@ -147,8 +149,7 @@ void createSdlGlSurface(int width, int height, int fullscreen)
 	glOrtho(0, width, height, 0, -1, 1);
 	glMatrixMode(GL_MODELVIEW);
 
-	displayData[0]  = (char*)calloc(1, bitDepth / 8 * texW * texH);
-	displayData[1]  = (char*)calloc(1, bitDepth / 8 * texW * texH);
+	displayData  = (char*)calloc(1, bitDepth / 8 * texW * texH);
 	displayPitch = width * bitDepth / 8;
 
 	texCoordX = (GLfloat)width  / texW;
@@ -161,11 +162,11 @@ void createSdlGlSurface(int width, int height, int fullscreen)
 
 	if (bitDepth == 16) {
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, texW, texH, 0,
-			            GL_RGB, GL_UNSIGNED_SHORT_5_6_5, displayData[0]);
+			            GL_RGB, GL_UNSIGNED_SHORT_5_6_5, displayData);
 	} 
     else {
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texW, texH, 0,
-			            GL_RGBA, GL_UNSIGNED_BYTE, displayData[0]);
+			            GL_RGBA, GL_UNSIGNED_BYTE, displayData);
 	}
 }
 #endif
@@ -210,6 +211,10 @@ int createSdlWindow()
         createSdlSurface(width, height, fullscreen);
     }
 
+    // The new surface does not hold the last frame
+    displayReset = 1;
+    videoPipelineSetFormat(bitDepth, zoom);
+
     // Set the window caption
     SDL_WM_SetCaption( title, NULL );
 
@@ -219,155 +224,125 @@ int createSdlWindow()
     return 1;
 }
 
-static int isLineDirty(int y, int lines) {
-    int width = zoom * WIDTH * bitDepth / 8 / sizeof(UInt32);
-
-    UInt32* d0 = (UInt32*)(displayData[0]) + width * y;
-    UInt32* d1 = (UInt32*)(displayData[1]) + width * y;
-    UInt32  cmp = 0;
-    UInt32  i = lines * width / 8;
-
-    while (i-- && !cmp) {
-        cmp |= d0[0] - d1[0];
-        cmp |= d0[1] - d1[1];
-        cmp |= d0[2] - d1[2];
-        cmp |= d0[3] - d1[3];
-        cmp |= d0[4] - d1[4];
-        cmp |= d0[5] - d1[5];
-        cmp |= d0[6] - d1[6];
-        cmp |= d0[7] - d1[7];
-        d0 += 8;
-        d1 += 8;
-    }
-    return cmp;
-}
-
+// Shows the newest image from the render thread. Only the rows that
+// changed since the last image shown are copied to the display.
 int updateEmuDisplay(int updateAll) 
 {
-    FrameBuffer* frameBuffer;
-    int bytesPerPixel = bitDepth / 8;
-    char* dpyData  = displayData[curDisplayData];
+    VideoImage* image;
     int width  = zoom * WIDTH;
     int height = zoom * HEIGHT;
-    int borderWidth;
+    VideoRect fullRect;
+    VideoRect* rect;
+    int rectCount;
+    SDL_Rect sdlRect[VIDEO_PIPELINE_MAX_RECTS];
+    int i;
 
-    frameBuffer = frameBufferFlipViewFrame(properties->emulation.syncMethod == P_EMU_SYNCTOVBLANKASYNC);
-    if (frameBuffer == NULL) {
-        frameBuffer = frameBufferGetWhiteNoiseFrame();
+    image = videoPipelineGetLatest();
+    if (image == NULL || image->bitDepth != bitDepth || image->zoom != zoom) {
+        return 0;
     }
 
-    borderWidth = (320 - frameBuffer->maxWidth) * zoom / 2;
+    updateAll |= displayReset;
+    displayReset = 0;
 
 #ifdef ENABLE_OPENGL
-    if (properties->video.driver != P_VIDEO_DRVGDI) {
-        const int linesPerBlock = 4;
-        GLfloat coordX = texCoordX;
-        GLfloat coordY = texCoordY;
-        int y; 
-        int isDirty = 0; 
+    updateAll |= properties->video.driver == P_VIDEO_DRVDIRECTX;
+#endif
 
-        if (properties->video.horizontalStretch) {
-            coordX = texCoordX * (width - 2 * borderWidth) / width;
-            borderWidth = 0;
-        }
+    fullRect.x      = 0;
+    fullRect.y      = 0;
+    fullRect.width  = width;
+    fullRect.height = height;
 
-        videoRender(video, frameBuffer, bitDepth, zoom,
-                    dpyData + borderWidth * bytesPerPixel, 0, displayPitch, -1);
+    rect      = updateAll ? &fullRect : image->rect;
+    rectCount = updateAll ? 1 : image->rectCount;
 
-        if (borderWidth > 0) {
-            int h = height;
-            while (h--) {
-                memset(dpyData, 0, borderWidth * bytesPerPixel);
-                memset(dpyData + (width - borderWidth) * bytesPerPixel, 0, borderWidth * bytesPerPixel);
-                dpyData += displayPitch;
-            }
-        }
+#ifdef ENABLE_OPENGL
+    if (properties->video.driver != P_VIDEO_DRVGDI) {
+        GLfloat coordX0 = 0;
+        GLfloat coordX1 = texCoordX;
+        GLfloat coordY  = texCoordY;
 
-        updateAll |= properties->video.driver == P_VIDEO_DRVDIRECTX;
+        if (properties->video.horizontalStretch) {
+            coordX0 = texCoordX * image->borderWidth / width;
+            coordX1 = texCoordX * (width - image->borderWidth) / width;
+        }
 
-        for (y = 0; y < height; y += linesPerBlock) {
-            if (updateAll || isLineDirty(y, linesPerBlock)) {
-                if (!isDirty) {
-                    glEnable(GL_TEXTURE_2D);
-                    glEnable(GL_ASYNC_TEX_IMAGE_SGIX);
-	                glBindTexture(GL_TEXTURE_2D, textureId);
+        if (rectCount > 0) {
+            glEnable(GL_TEXTURE_2D);
+            glEnable(GL_ASYNC_TEX_IMAGE_SGIX);
+	        glBindTexture(GL_TEXTURE_2D, textureId);
 
-	                glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
-                    isDirty = 1;
-                }
+	        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
 
+            // Only the changed rows are uploaded, the texture keeps the rest
+            for (i = 0; i < rectCount; i++) {
+                char* pixels = (char*)image->pixels + rect[i].y * image->pitch;
                 if (bitDepth == 16) {
-		            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, width, linesPerBlock,
-		                            GL_RGB, GL_UNSIGNED_SHORT_5_6_5, displayData[curDisplayData] + y * displayPitch);
+		            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, rect[i].y, width, rect[i].height,
+		                            GL_RGB, GL_UNSIGNED_SHORT_5_6_5, pixels);
 	            } 
                 else {
-		            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, width, linesPerBlock,
-		                            GL_RGBA, GL_UNSIGNED_BYTE, displayData[curDisplayData] + y * displayPitch);
+		            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, rect[i].y, width, rect[i].height,
+		                            GL_RGBA, GL_UNSIGNED_BYTE, pixels);
 	            }
             }
-        }
 
-        if (isDirty) {
             glBegin(GL_QUADS);
-	        glTexCoord2f(0,      coordY); glVertex2i(0,     height);
-	        glTexCoord2f(coordX, coordY); glVertex2i(width, height);
-	        glTexCoord2f(coordX, 0     ); glVertex2i(width, 0     );
-	        glTexCoord2f(0,      0     ); glVertex2i(0,     0     );
+	        glTexCoord2f(coordX0, coordY); glVertex2i(0,     height);
+	        glTexCoord2f(coordX1, coordY); glVertex2i(width, height);
+	        glTexCoord2f(coordX1, 0     ); glVertex2i(width, 0     );
+	        glTexCoord2f(coordX0, 0     ); glVertex2i(0,     0     );
 	        glEnd();
             glDisable(GL_TEXTURE_2D);
             
 	        SDL_GL_SwapBuffers();
         }
 
-        curDisplayData ^= 1;
-
         return 0;
     }
 #endif
 
-    videoRender(video, frameBuffer, bitDepth, zoom, 
-                dpyData + borderWidth * bytesPerPixel, 0, displayPitch, -1);
-
-    if (borderWidth > 0) {
-        int h = height;
-        while (h--) {
-            memset(dpyData, 0, borderWidth * bytesPerPixel);
-            memset(dpyData + (width - borderWidth) * bytesPerPixel, 0, borderWidth * bytesPerPixel);
-            dpyData += displayPitch;
-        }
-    }
-
-
     if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) < 0) {
         return 0;
     }
-    SDL_UpdateRect(surface, 0, 0, width, height);
+    for (i = 0; i < rectCount; i++) {
+        int y;
+        for (y = rect[i].y; y < rect[i].y + rect[i].height; y++) {
+            memcpy(displayData + y * displayPitch, (char*)image->pixels + y * image->pitch, image->pitch);
+        }
+        sdlRect[i].x = 0;
+        sdlRect[i].y = rect[i].y;
+        sdlRect[i].w = width;
+        sdlRect[i].h = rect[i].height;
+    }
     if (SDL_MUSTLOCK(surface)) SDL_UnlockSurface(surface);
+    SDL_UpdateRects(surface, rectCount, sdlRect);
 
     return 0; 
 }
 
-int  archUpdateEmuDisplay(int syncMode) 
+// Called on the render thread when an image is ready. There is at most
+// one display event in the queue, it shows the newest image.
+static void onImageReady()
 {
     SDL_Event event;
 
-    if (pendingDisplayEvents > 1) {
-        return 1;
+    if (archAtomicExchange(&displayEventPending, 1)) {
+        return;
     }
 
-    pendingDisplayEvents++;
-
     event.type = SDL_USEREVENT;
     event.user.code = EVENT_UPDATE_DISPLAY;
     event.user.data1 = NULL;
     event.user.data2 = NULL;
     SDL_PushEvent(&event);
+}
 
-#ifndef SINGLE_THREADED
-    if (properties->emulation.syncMethod == P_EMU_SYNCFRAMES) {
-        archEventWait(dpyUpdateAckEvent, 500);
-    }
-#endif
+int  archUpdateEmuDisplay(int syncMode) 
+{
+    videoPipelinePublish(properties->emulation.syncMethod == P_EMU_SYNCTOVBLANKASYNC,
+                         properties->emulation.syncMethod == P_EMU_SYNCFRAMES);
     return 1;
 }
 
@@ -472,9 +447,8 @@ static void handleEvent(SDL_Event* event)
     case SDL_USEREVENT:
         switch (event->user.code) {
         case EVENT_UPDATE_DISPLAY:
+            archAtomicSet(&displayEventPending, 0);
             updateEmuDisplay(0);
-            archEventSet(dpyUpdateAckEvent);
-            pendingDisplayEvents--;
             break;
         case EVENT_UPDATE_WINDOW:
             if (!createSdlWindow()) {
@@ -564,13 +538,14 @@ int main(int argc, char **argv)
                   properties->video.contrast, properties->video.gamma);
     videoSetScanLines(video, properties->video.scanlinesEnable, properties->video.scanlinesPct);
     videoSetColorSaturation(video, properties->video.colorSaturationEnable, properties->video.colorSaturationWidth);
+
+    // Frames are rendered on their own thread and shown here
+    videoPipelineStart(emulatorGetBoard(), video, 1, onImageReady);
     
     bitDepth = 32;
     if (!createSdlWindow()) {
         return 0;
     }
-    
-    dpyUpdateAckEvent = archEventCreate(0);
 
     keyboardInit();
 
@@ -579,7 +554,7 @@ int main(int argc, char **argv)
     emulatorInit(properties, mixer);
     actionInit(video, properties, mixer);
     langInit();
-    tapeSetReadOnly(properties->cassette.readOnly);
+    tapeSetReadOnly(emulatorGetBoard(), properties->cassette.readOnly);
     
     langSetLanguage(properties->language);
     
@@ -628,15 +603,16 @@ int main(int argc, char **argv)
     {
         Machine* machine = machineCreate(properties->emulation.machineName);
         if (machine != NULL) {
-            boardSetMachine(machine);
+            boardSetMachine(emulatorGetBoard(), machine);
             machineDestroy(machine);
         }
     }
-    boardSetFdcTimingEnable(properties->emulation.enableFdcTiming);
-    boardSetY8950Enable(properties->sound.chip.enableY8950);
-    boardSetYm2413Enable(properties->sound.chip.enableYM2413);
-    boardSetMoonsoundEnable(properties->sound.chip.enableMoonsound);
-    boardSetVideoAutodetect(properties->video.detectActiveMonitor);
+    boardSetFdcTimingEnable(emulatorGetBoard(), properties->emulation.enableFdcTiming);
+    boardSetRunAhead(emulatorGetBoard(), properties->emulation.runAhead);
+    boardSetY8950Enable(emulatorGetBoard(), properties->sound.chip.enableY8950);
+    boardSetYm2413Enable(emulatorGetBoard(), properties->sound.chip.enableYM2413);
+    boardSetMoonsoundEnable(emulatorGetBoard(), properties->sound.chip.enableMoonsound);
+    boardSetVideoAutodetect(emulatorGetBoard(), properties->video.detectActiveMonitor);
 
     i = emuTryStartWithArguments(properties, szLine, NULL);
     if (i < 0) {
@@ -661,6 +637,12 @@ int main(int argc, char **argv)
         } while(SDL_PollEvent(&event));
     }
 
+    emulatorStop();
+    videoPipelineStop();
+
+    // Let queued save states finish writing
+    saveStateStopWriter();
+
 	// For stop threads before destroy.
 	// Clean up.
 	if (SDL_WasInit(SDL_INIT_EVERYTHING)) {
@@ -365,7 +365,7 @@ int main(int argc, char **argv)
     emulatorInit(properties, mixer);
     actionInit(NULL, properties, mixer);
     langInit();
-    tapeSetReadOnly(properties->cassette.readOnly);
+    tapeSetReadOnly(emulatorGetBoard(), properties->cassette.readOnly);
     
     langSetLanguage(properties->language);
     
@@ -412,15 +412,15 @@ int main(int argc, char **argv)
     {
         Machine* machine = machineCreate(properties->emulation.machineName);
         if (machine != NULL) {
-            boardSetMachine(machine);
+            boardSetMachine(emulatorGetBoard(), machine);
             machineDestroy(machine);
         }
     }
-    boardSetFdcTimingEnable(properties->emulation.enableFdcTiming);
-    boardSetY8950Enable(properties->sound.chip.enableY8950);
-    boardSetYm2413Enable(properties->sound.chip.enableYM2413);
-    boardSetMoonsoundEnable(properties->sound.chip.enableMoonsound);
-    boardSetVideoAutodetect(properties->video.detectActiveMonitor);
+    boardSetFdcTimingEnable(emulatorGetBoard(), properties->emulation.enableFdcTiming);
+    boardSetY8950Enable(emulatorGetBoard(), properties->sound.chip.enableY8950);
+    boardSetYm2413Enable(emulatorGetBoard(), properties->sound.chip.enableYM2413);
+    boardSetMoonsoundEnable(emulatorGetBoard(), properties->sound.chip.enableMoonsound);
+    boardSetVideoAutodetect(emulatorGetBoard(), properties->video.detectActiveMonitor);
 
     i = emuTryStartWithArguments(properties, szLine, NULL);
     if (i < 0) {
@@ -475,8 +475,8 @@ Pixel videoGetColor(int R, int G, int B)
 // No back buffers implemented, so these methods just need to return something not NULL
 // Back buffers could make use of these methods which are called when the MSX switches
 // frames
-FrameBuffer* frameBufferGetDrawFrame() {return NOT_NULL; } 
-FrameBuffer* frameBufferFlipDrawFrame() { return NOT_NULL; }
+FrameBuffer* frameBufferGetDrawFrame(BoardContext* board) {return NOT_NULL; } 
+FrameBuffer* frameBufferFlipDrawFrame(BoardContext* board) { return NOT_NULL; }
 
 // This is the important method and it should return a pointer to scan line y (0-239)
 Pixel* frameBufferGetLine(FrameBuffer* frameBuffer, int y) { 
@@ -485,20 +485,23 @@ Pixel* frameBufferGetLine(FrameBuffer* frameBuffer, int y) {
 
 // Used by gunstick and asciilaser
 static int fbScanLine = 0;
-void frameBufferSetScanline(int scanline) { fbScanLine = scanline; }
-int frameBufferGetScanline() { return fbScanLine; }
+void frameBufferSetScanline(BoardContext* board, int scanline) { fbScanLine = scanline; }
+int frameBufferGetScanline(BoardContext* board) { return fbScanLine; }
 
 
 ////// The following methods are not needed for a fast renderer
 
 // Only one video device supported
-FrameBufferData* frameBufferDataCreate(int maxWidth, int maxHeight, int defaultHorizZoom) { return NOT_NULL; }
-FrameBufferData* frameBufferGetActive() { return NOT_NULL; }
+FrameBufferContext* frameBufferContextCreate() { return NOT_NULL; }
+void frameBufferContextDestroy(FrameBufferContext* context) {}
 
-void frameBufferDataDestroy(FrameBufferData* frameData) {}
+FrameBufferData* frameBufferDataCreate(BoardContext* board, int maxWidth, int maxHeight, int defaultHorizZoom) { return NOT_NULL; }
+FrameBufferData* frameBufferGetActive(BoardContext* board) { return NOT_NULL; }
 
-void frameBufferSetActive(FrameBufferData* frameData) {}
-void frameBufferSetMixMode(FrameBufferMixMode mode, FrameBufferMixMode mask) {}
+void frameBufferDataDestroy(BoardContext* board, FrameBufferData* frameData) {}
+
+void frameBufferSetActive(BoardContext* board, FrameBufferData* frameData) {}
+void frameBufferSetMixMode(BoardContext* board, FrameBufferMixMode mode, FrameBufferMixMode mask) {}
 
 void   frameBufferSetLineCount(FrameBuffer* frameBuffer, int val) {} // Assume line count is always 240
 int    frameBufferGetLineCount(FrameBuffer* frameBuffer) { return HEIGHT; }
@@ -37,9 +37,6 @@
 
 #define BASE_PHASE_STEP 0x28959becUL  /* = (1 << 28) * 3579545 / 32 / 44100 */
 
-static Int16 voltTable[16];
-static Int16 voltEnvTable[32];
-
 static const UInt8 regMask[16] = {
     0xff, 0x0f, 0xff, 0x0f, 0xff, 0x0f, 0x1f, 0x3f, 
     0x1f, 0x1f, 0x1f, 0xff, 0xff, 0x0f, 0xff, 0xff
@@ -49,6 +46,7 @@ static Int32* ay8910Sync(void* ref, UInt32 count);
 static void updateRegister(AY8910* ay8910, UInt8 address, UInt8 data);
 
 struct AY8910 {
+    BoardContext* board;
     Mixer* mixer;
     Int32  handle;
     Int32  debugHandle;
@@ -83,12 +81,16 @@ struct AY8910 {
     Int32  stereo;
     Int32  pan[3];
 
+    // The envelope steps differ between the AY8910 and the YM2149
+    Int16  voltTable[16];
+    Int16  voltEnvTable[32];
+
     Int32  buffer[AUDIO_STEREO_BUFFER_SIZE];
 };
 
 void ay8910LoadState(AY8910* ay8910)
 {
-    SaveState* state = saveStateOpenForRead("ay8910");
+    SaveState* state = saveStateOpenForRead(ay8910->board, "ay8910");
     char tag[32];
     int i;
 
@@ -131,7 +133,7 @@ void ay8910LoadState(AY8910* ay8910)
 
 void ay8910SaveState(AY8910* ay8910)
 {
-    SaveState* state = saveStateOpenForWrite("ay8910");
+    SaveState* state = saveStateOpenForWrite(ay8910->board, "ay8910");
     char tag[32];
     int i;
 
@@ -217,33 +219,35 @@ static int dbgWriteRegister(AY8910* ay8910, char* name, int regIndex, UInt32 val
     return 1;
 }
 
-AY8910* ay8910Create(Mixer* mixer, Ay8910Connector connector, PsgType type, Int32 stereo, Int32* pan)
+AY8910* ay8910Create(BoardContext* board, Mixer* mixer, Ay8910Connector connector, PsgType type, Int32 stereo, Int32* pan)
 {
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, dbgWriteRegister, NULL };
     AY8910* ay8910 = (AY8910*)calloc(1, sizeof(AY8910));
     int i;
 
+    ay8910->board = board;
+
     DoubleT v = 0x26a9;
     for (i = 15; i >= 0; i--) {
-        voltTable[i] = (Int16)v;
-        voltEnvTable[2 * i + 0] = (Int16)v;
-        voltEnvTable[2 * i + 1] = (Int16)v;
+        ay8910->voltTable[i] = (Int16)v;
+        ay8910->voltEnvTable[2 * i + 0] = (Int16)v;
+        ay8910->voltEnvTable[2 * i + 1] = (Int16)v;
         v *= 0.70794578438413791080221494218943;
     }
 
     if ( type == PSGTYPE_YM2149) {
         DoubleT v = 0x26a9;
         for (i = 31; i >= 0; i--) {
-            voltEnvTable[i] = (Int16)v;
+            ay8910->voltEnvTable[i] = (Int16)v;
             v *= 0.84139514164519509115274189380029;
         }
     }
 
     for (i = 0; i < 16; i++) {
-        voltTable[i] -= voltTable[0];
+        ay8910->voltTable[i] -= ay8910->voltTable[0];
     }
     for (i = 0; i < 32; i++) {
-        voltEnvTable[i] -= voltEnvTable[0];
+        ay8910->voltEnvTable[i] -= ay8910->voltEnvTable[0];
     }
 
     ay8910->mixer = mixer;
@@ -265,25 +269,25 @@ AY8910* ay8910Create(Mixer* mixer, Ay8910Connector connector, PsgType type, Int3
 
     switch (ay8910->connector) {
     case AY8910_MSX:
-        ioPortRegister(0xa0, NULL,           ay8910WriteAddress, ay8910);
-        ioPortRegister(0xa1, NULL,           ay8910WriteData,    ay8910);
-        ioPortRegister(0xa2, ay8910ReadData, NULL,               ay8910);
+        ioPortRegister(board, 0xa0, NULL,           ay8910WriteAddress, ay8910);
+        ioPortRegister(board, 0xa1, NULL,           ay8910WriteData,    ay8910);
+        ioPortRegister(board, 0xa2, ay8910ReadData, NULL,               ay8910);
         break;
 
     case AY8910_MSX_SCCPLUS:
-        ioPortRegister(0x10, NULL,           ay8910WriteAddress, ay8910);
-        ioPortRegister(0x11, NULL,           ay8910WriteData,    ay8910);
-        ioPortRegister(0x12, ay8910ReadData, NULL,               ay8910);
+        ioPortRegister(board, 0x10, NULL,           ay8910WriteAddress, ay8910);
+        ioPortRegister(board, 0x11, NULL,           ay8910WriteData,    ay8910);
+        ioPortRegister(board, 0x12, ay8910ReadData, NULL,               ay8910);
         break;
 
     case AY8910_SVI:
-        ioPortRegister(0x88, NULL,           ay8910WriteAddress, ay8910);
-        ioPortRegister(0x8c, NULL,           ay8910WriteData,    ay8910);
-        ioPortRegister(0x90, ay8910ReadData, NULL,               ay8910);
+        ioPortRegister(board, 0x88, NULL,           ay8910WriteAddress, ay8910);
+        ioPortRegister(board, 0x8c, NULL,           ay8910WriteData,    ay8910);
+        ioPortRegister(board, 0x90, ay8910ReadData, NULL,               ay8910);
         break;
     }
 
-    ay8910->debugHandle = debugDeviceRegister(DBGTYPE_AUDIO, langDbgDevAy8910(), &dbgCallbacks, ay8910);
+    ay8910->debugHandle = debugDeviceRegister(board, DBGTYPE_AUDIO, langDbgDevAy8910(), &dbgCallbacks, ay8910);
 
     return ay8910;
 }
@@ -302,25 +306,25 @@ void ay8910Reset(AY8910* ay8910)
 
 void ay8910Destroy(AY8910* ay8910)
 {
-    debugDeviceUnregister(ay8910->debugHandle);
+    debugDeviceUnregister(ay8910->board, ay8910->debugHandle);
 
     switch (ay8910->connector) {
     case AY8910_MSX:
-        ioPortUnregister(0xa0);
-        ioPortUnregister(0xa1);
-        ioPortUnregister(0xa2);
+        ioPortUnregister(ay8910->board, 0xa0);
+        ioPortUnregister(ay8910->board, 0xa1);
+        ioPortUnregister(ay8910->board, 0xa2);
         break;
 
     case AY8910_MSX_SCCPLUS:
-        ioPortUnregister(0x10);
-        ioPortUnregister(0x11);
-        ioPortUnregister(0x12);
+        ioPortUnregister(ay8910->board, 0x10);
+        ioPortUnregister(ay8910->board, 0x11);
+        ioPortUnregister(ay8910->board, 0x12);
         break;
 
     case AY8910_SVI:
-        ioPortUnregister(0x88);
-        ioPortUnregister(0x8c);
-        ioPortUnregister(0x90);
+        ioPortUnregister(ay8910->board, 0x88);
+        ioPortUnregister(ay8910->board, 0x8c);
+        ioPortUnregister(ay8910->board, 0x90);
         break;
     }
 
@@ -432,23 +436,8 @@ static void updateRegister(AY8910* ay8910, UInt8 regIndex, UInt8 data)
     }
 }
 
-#if 1
-extern int framecounter;
-int   curFramecounter = 0;
-#endif
-
 void ay8910WriteData(AY8910* ay8910, UInt16 ioPort, UInt8 data)
 {
-#if 0
-    if (ay8910->address < 2 || ay8910->address == 8) {
-        if (framecounter > curFramecounter) {
-            int delta = framecounter - curFramecounter;
-            printf("    dw  $10%.2x     ; Delay %d frames\n", delta, delta);
-            curFramecounter = framecounter;
-        }
-        printf("    dw  $%.2x%.2x\n", ay8910->address, data);
-    }
-#endif
     updateRegister(ay8910, ay8910->address, data);
 }
 
@@ -505,10 +494,10 @@ static Int32* ay8910Sync(void* ref, UInt32 count)
 
             /* Amplify sample using either envelope volume or channel volume */
             if (ay8910->ampVolume[channel] & 0x10) {
-                sampleVolume[channel] += (Int16)tone * voltEnvTable[envVolume] / 16;
+                sampleVolume[channel] += (Int16)tone * ay8910->voltEnvTable[envVolume] / 16;
             }
             else {
-                sampleVolume[channel] += (Int16)tone * voltTable[ay8910->ampVolume[channel]] / 16;
+                sampleVolume[channel] += (Int16)tone * ay8910->voltTable[ay8910->ampVolume[channel]] / 16;
             }
         }
 
@@ -41,26 +41,6 @@
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
 
 
-static int mixerCPUFrequency;
-static int mixerConnector;
-static int mixerCPUFrequencyFixed;
-
-void mixerSetBoardFrequency(int CPUFrequency)
-{
-    if (mixerCPUFrequencyFixed != 0) {
-    	mixerCPUFrequency = mixerCPUFrequencyFixed;
-    }
-    else {
-    	mixerCPUFrequency = CPUFrequency;
-    }
-}
-
-void mixerSetBoardFrequencyFixed(int CPUFrequency)
-{
-	mixerCPUFrequencyFixed = CPUFrequency;
-    mixerCPUFrequency = mixerCPUFrequencyFixed;
-}
-
 typedef struct {
     UInt32 riff;
     UInt32 fileSize;
@@ -109,6 +89,7 @@ typedef struct {
 
 struct Mixer
 { 
+    BoardContext* board;
     MixerWriteCallback writeCallback;
     void*  writeRef;
     Int32  fragmentSize;
@@ -134,6 +115,9 @@ struct Mixer
     Int32   volCntRight;
     FILE*   file;
     int     enable;
+    int     hold;
+    int     cpuFrequency;
+    int     cpuFrequencyFixed;
 };
 
 
@@ -337,6 +321,8 @@ static void updateVolumes(Mixer* mixer)
     }
 }
 
+// The first mixer created is the one of the front end. The theme
+// triggers show its volumes.
 static Mixer* globalMixer = NULL;
 
 Mixer* mixerGetGlobalMixer()
@@ -351,6 +337,7 @@ Mixer* mixerCreate()
     mixer->fragmentSize = 512;
     mixer->enable = 1;
     mixer->rate = AUDIO_SAMPLERATE;
+    mixer->cpuFrequency = 3579545;
 
     if (globalMixer == NULL) globalMixer = mixer;
 
@@ -360,7 +347,9 @@ Mixer* mixerCreate()
 void mixerDestroy(Mixer* mixer)
 {
     mixerStopLog(mixer);
-    globalMixer = NULL;
+    if (globalMixer == mixer) {
+        globalMixer = NULL;
+    }
     free(mixer);
 }
 
@@ -448,25 +437,53 @@ Int32 mixerGetMasterVolume(Mixer* mixer, int leftRight)
     return leftRight ? mixer->volIntRight : mixer->volIntLeft;
 }
 
+void mixerSetBoard(Mixer* mixer, BoardContext* board)
+{
+    mixer->board = board;
+}
+
+void mixerSetBoardFrequency(Mixer* mixer, int CPUFrequency)
+{
+    if (mixer->cpuFrequencyFixed != 0) {
+        mixer->cpuFrequency = mixer->cpuFrequencyFixed;
+    }
+    else {
+        mixer->cpuFrequency = CPUFrequency;
+    }
+}
+
+void mixerSetBoardFrequencyFixed(Mixer* mixer, int CPUFrequency)
+{
+    mixer->cpuFrequencyFixed = CPUFrequency;
+    if (CPUFrequency != 0) {
+        mixer->cpuFrequency = CPUFrequency;
+    }
+}
+
 void mixerReset(Mixer* mixer)
 {
-    mixer->refTime = boardSystemTime();
+    mixer->refTime = boardSystemTime(mixer->board);
+    mixer->refFrag = 0;
     mixer->index = 0;
 }
 
 void mixerSync(Mixer* mixer)
 {
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(mixer->board);
     Int16* buffer   = mixer->buffer;
     Int32* chBuff[MAX_CHANNELS];
     UInt32 count;
     UInt64 elapsed;
     int i;
 
+    if (mixer->hold) {
+        return;
+    }
+
     elapsed        = mixer->rate * (UInt64)(systemTime - mixer->refTime) + mixer->refFrag;
     mixer->refTime = systemTime;
-    mixer->refFrag = (UInt32)(elapsed % (mixerCPUFrequency * (boardFrequency() / 3579545)));
-    count          = (UInt32)(elapsed / (mixerCPUFrequency * (boardFrequency() / 3579545)));
+    mixer->refFrag = (UInt32)(elapsed % (mixer->cpuFrequency * (boardFrequency() / 3579545)));
+    count          = (UInt32)(elapsed / (mixer->cpuFrequency * (boardFrequency() / 3579545)));
 
     if (count == 0 || count > AUDIO_MONO_BUFFER_SIZE) {
         return;
@@ -712,3 +729,8 @@ void mixerSetEnable(Mixer* mixer, int enable)
     mixer->enable = enable;
 //    printf("AUDIO: %s\n", enable?"enabled":"disabled");
 }
+
+void mixerSetHold(Mixer* mixer, int hold)
+{
+    mixer->hold = hold;
+}
@@ -91,6 +91,8 @@ int  mixerIsLogging(Mixer* mixer);
 void mixerStopLog(Mixer* mixer);
 
 /* Internal interface methods */
+// The mixer runs on the system time of the board it is attached to
+void mixerSetBoard(Mixer* mixer, BoardContext* board);
 void mixerReset(Mixer* mixer);
 void mixerSync(Mixer* mixer);
 
@@ -98,10 +100,15 @@ Int32 mixerRegisterChannel(Mixer* mixer, Int32 audioType, Int32 stereo,
                            MixerUpdateCallback callback, MixerSetSampleRateCallback rateCallback,
                            void*param);
 void mixerSetEnable(Mixer* mixer, int enable);
+// While the mixer is held mixerSync() produces no samples and the mixer
+// time stands still, so emulation that is later undone isn't heard.
+void mixerSetHold(Mixer* mixer, int hold);
 void mixerUnregisterChannel(Mixer* mixer, Int32 handle);
 
-void mixerSetBoardFrequency(int CPUFrequency);
-void mixerSetBoardFrequencyFixed(int CPUFrequency);
+// The emulation speed of the board. A fixed frequency, used when audio
+// is captured, overrides it until it is set back to 0.
+void mixerSetBoardFrequency(Mixer* mixer, int CPUFrequency);
+void mixerSetBoardFrequencyFixed(Mixer* mixer, int CPUFrequency);
 
 #endif
 
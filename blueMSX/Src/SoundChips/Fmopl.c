@@ -18,6 +18,7 @@
 #include "Switches.h"
 #include "SaveState.h"
 #include "Board.h"
+#include "ArchThread.h"
 
 #ifndef	PI
 #define	PI 3.14159265358979323846
@@ -186,25 +187,9 @@ static INT32 RATE_0[16]=
 
 /* --------------------	static state --------------------- */
 
-/* lock	level of common	table */
-
-/* work	table */
-void *cur_chip = NULL;	/* current chip	point */
-/* currenct	chip state */
-/* static OPLSAMPLE	 *bufL,*bufR; */
-OPL_CH *S_CH;
-OPL_CH *E_CH;
-OPL_SLOT *SLOT7_1,*SLOT7_2,*SLOT8_1,*SLOT8_2;
-
-int	num_lock = 0;
-INT32  *ams_table;
-INT32  *vib_table;
-INT32 amsIncr;
-INT32 vibIncr;
-INT32 outd;
-INT32 ams;
-INT32 vib;
-INT32 feedback2;		/* connect for SLOT	2 */
+/* the common tables are built once and shared by all chips */
+static volatile int tablesOnce = 0;
+static int tablesOpen = 0;
 
 /* --------------------- subroutines  ---------------------	*/
 
@@ -228,7 +213,7 @@ void OPL_STATUS_SET(FM_OPL *OPL,int	flag)
 		if(OPL->status & OPL->statusmask)
 		{	/* IRQ on */
 			OPL->status	|= 0x80;
-			boardSetInt(0x10);
+			boardSetInt(OPL->board, 0x10);
 		}
 	}
 }
@@ -243,7 +228,7 @@ void OPL_STATUS_RESET(FM_OPL *OPL,int flag)
 		if (!(OPL->status &	OPL->statusmask) )
 		{
 			OPL->status	&= 0x7f;
-			boardClearInt(0x10);
+			boardClearInt(OPL->board, 0x10);
 		}
 	}
 }
@@ -285,7 +270,7 @@ void OPL_KEYOFF(OPL_SLOT *SLOT)
 
 /* ---------- calcrate Envelope	Generator &	Phase Generator	---------- */
 /* return :	envelope output	*/
-UINT32 OPL_CALC_SLOT( OPL_SLOT *SLOT )
+UINT32 OPL_CALC_SLOT( FM_OPL *OPL, OPL_SLOT *SLOT )
 {
 	/* calcrate	envelope generator */
 	if(	(SLOT->evc+=SLOT->evs) >= SLOT->eve	)
@@ -319,7 +304,7 @@ UINT32 OPL_CALC_SLOT( OPL_SLOT *SLOT )
 		}
 	}
 	/* calcrate	envelope */
-	return SLOT->TLL+ENV_CURVE[SLOT->evc>>ENV_BITS]+(SLOT->ams ? ams : 0);
+	return SLOT->TLL+ENV_CURVE[SLOT->evc>>ENV_BITS]+(SLOT->ams ? OPL->ams : 0);
 }
 
 /* ---------- frequency	counter	for	operater update	---------- */
@@ -407,30 +392,30 @@ void set_sl_rr(FM_OPL *OPL,int slot,int	v)
 /* operator	output calcrator */
 #define	OP_OUT(slot,env,con)   (&SIN_TABLE[slot->wavetableidx])[((slot->Cnt+con)/(0x1000000/SIN_ENT))&(SIN_ENT-1)][env]
 /* ---------- calcrate one of channel ---------- */
-void OPL_CALC_CH( OPL_CH *CH )
+void OPL_CALC_CH( FM_OPL *OPL, OPL_CH *CH )
 {
 	UINT32 env_out;
 	OPL_SLOT *SLOT;
 
-	feedback2 =	0;
+	OPL->feedback2 =	0;
 	/* SLOT	1 */
 	SLOT = &CH->SLOT[SLOT1];
-	env_out=OPL_CALC_SLOT(SLOT);
+	env_out=OPL_CALC_SLOT(OPL,SLOT);
 	if(	env_out	< EG_ENT-1 )
 	{
 		/* PG */
-		if(SLOT->vib) SLOT->Cnt	+= (SLOT->Incr*vib/VIB_RATE);
+		if(SLOT->vib) SLOT->Cnt	+= (SLOT->Incr*OPL->vib/VIB_RATE);
 		else		  SLOT->Cnt	+= SLOT->Incr;
 		/* connectoion */
 		if(CH->FB)
 		{
 			int	feedback1 =	(CH->op1_out[0]+CH->op1_out[1])>>CH->FB;
 			CH->op1_out[1] = CH->op1_out[0];
-			*(CH->CON ?	&outd :	&feedback2)	+= CH->op1_out[0] =	OP_OUT(SLOT,env_out,feedback1);
+			*(CH->CON ?	&OPL->outd :	&OPL->feedback2)	+= CH->op1_out[0] =	OP_OUT(SLOT,env_out,feedback1);
 		}
 		else
 		{
-			*(CH->CON ?	&outd :	&feedback2)	+= OP_OUT(SLOT,env_out,0);
+			*(CH->CON ?	&OPL->outd :	&OPL->feedback2)	+= OP_OUT(SLOT,env_out,0);
 		}
 	}else
 	{
@@ -439,100 +424,107 @@ void OPL_CALC_CH( OPL_CH *CH )
 	}
 	/* SLOT	2 */
 	SLOT = &CH->SLOT[SLOT2];
-	env_out=OPL_CALC_SLOT(SLOT);
+	env_out=OPL_CALC_SLOT(OPL,SLOT);
 	if(	env_out	< EG_ENT-1 )
 	{
 		/* PG */
-		if(SLOT->vib) SLOT->Cnt	+= (SLOT->Incr*vib/VIB_RATE);
+		if(SLOT->vib) SLOT->Cnt	+= (SLOT->Incr*OPL->vib/VIB_RATE);
 		else		  SLOT->Cnt	+= SLOT->Incr;
 		/* connectoion */
-		outd +=	OP_OUT(SLOT,env_out, feedback2);
+		OPL->outd +=	OP_OUT(SLOT,env_out, OPL->feedback2);
 	}
 }
 
 /* ---------- calcrate rythm block ---------- */
 #define	WHITE_NOISE_db 6.0
-void OPL_CALC_RH( OPL_CH *CH )
+void OPL_CALC_RH( FM_OPL *OPL, OPL_CH *CH )
 {
 	UINT32 env_tam,env_sd,env_top,env_hh;
-	int	whitenoise = (int)((rand()&1)*(WHITE_NOISE_db/EG_STEP));
+	int	whitenoise;
 	INT32 tone8;
 
 	OPL_SLOT *SLOT;
 	int	env_out;
+	OPL_SLOT *SLOT7_1 = &CH[7].SLOT[SLOT1];
+	OPL_SLOT *SLOT7_2 = &CH[7].SLOT[SLOT2];
+	OPL_SLOT *SLOT8_1 = &CH[8].SLOT[SLOT1];
+	OPL_SLOT *SLOT8_2 = &CH[8].SLOT[SLOT2];
+
+	OPL->noiseRnd = OPL->noiseRnd * 1103515245 + 12345;
+	whitenoise = (int)(((OPL->noiseRnd >> 16)&1)*(WHITE_NOISE_db/EG_STEP));
 
 	/* BD :	same as	FM serial mode and output level	is large */
-	feedback2 =	0;
+	OPL->feedback2 =	0;
 	/* SLOT	1 */
 	SLOT = &CH[6].SLOT[SLOT1];
-	env_out=OPL_CALC_SLOT(SLOT);
+	env_out=OPL_CALC_SLOT(OPL,SLOT);
 	if(	env_out	< EG_ENT-1 )
 	{
 		/* PG */
-		if(SLOT->vib) SLOT->Cnt	+= (SLOT->Incr*vib/VIB_RATE);
+		if(SLOT->vib) SLOT->Cnt	+= (SLOT->Incr*OPL->vib/VIB_RATE);
 		else		  SLOT->Cnt	+= SLOT->Incr;
 		/* connectoion */
 		if(CH[6].FB)
 		{
 			int	feedback1 =	(CH[6].op1_out[0]+CH[6].op1_out[1])>>CH[6].FB;
 			CH[6].op1_out[1] = CH[6].op1_out[0];
-			feedback2 =	CH[6].op1_out[0] = OP_OUT(SLOT,env_out,feedback1);
+			OPL->feedback2 =	CH[6].op1_out[0] = OP_OUT(SLOT,env_out,feedback1);
 		}
 		else
 		{
-			feedback2 =	OP_OUT(SLOT,env_out,0);
+			OPL->feedback2 =	OP_OUT(SLOT,env_out,0);
 		}
 	}else
 	{
-		feedback2 =	0;
+		OPL->feedback2 =	0;
 		CH[6].op1_out[1] = CH[6].op1_out[0];
 		CH[6].op1_out[0] = 0;
 	}
 	/* SLOT	2 */
 	SLOT = &CH[6].SLOT[SLOT2];
-	env_out=OPL_CALC_SLOT(SLOT);
+	env_out=OPL_CALC_SLOT(OPL,SLOT);
 	if(	env_out	< EG_ENT-1 )
 	{
 		/* PG */
-		if(SLOT->vib) SLOT->Cnt	+= (SLOT->Incr*vib/VIB_RATE);
+		if(SLOT->vib) SLOT->Cnt	+= (SLOT->Incr*OPL->vib/VIB_RATE);
 		else		  SLOT->Cnt	+= SLOT->Incr;
 		/* connectoion */
-		outd +=	OP_OUT(SLOT,env_out, feedback2)*2;
+		OPL->outd +=	OP_OUT(SLOT,env_out, OPL->feedback2)*2;
 	}
 
 	/* SD  (17)	= mul14[fnum7] + white noise */
 	/* TAM (15)	= mul15[fnum8] */
 	/* TOP (18)	= fnum6(mul18[fnum8]+whitenoise) */
 	/* HH  (14)	= fnum7(mul18[fnum8]+whitenoise) + white noise */
-	env_sd =OPL_CALC_SLOT(SLOT7_2) + whitenoise;
-	env_tam=OPL_CALC_SLOT(SLOT8_1);
-	env_top=OPL_CALC_SLOT(SLOT8_2);
-	env_hh =OPL_CALC_SLOT(SLOT7_1) + whitenoise;
+	env_sd =OPL_CALC_SLOT(OPL,SLOT7_2) + whitenoise;
+	env_tam=OPL_CALC_SLOT(OPL,SLOT8_1);
+	env_top=OPL_CALC_SLOT(OPL,SLOT8_2);
+	env_hh =OPL_CALC_SLOT(OPL,SLOT7_1) + whitenoise;
 
 	/* PG */
-	if(SLOT7_1->vib) SLOT7_1->Cnt += (2*SLOT7_1->Incr*vib/VIB_RATE);
+	if(SLOT7_1->vib) SLOT7_1->Cnt += (2*SLOT7_1->Incr*OPL->vib/VIB_RATE);
 	else			 SLOT7_1->Cnt += 2*SLOT7_1->Incr;
-	if(SLOT7_2->vib) SLOT7_2->Cnt += ((CH[7].fc*8)*vib/VIB_RATE);
+	if(SLOT7_2->vib) SLOT7_2->Cnt += ((CH[7].fc*8)*OPL->vib/VIB_RATE);
 	else			 SLOT7_2->Cnt += (CH[7].fc*8);
-	if(SLOT8_1->vib) SLOT8_1->Cnt += (SLOT8_1->Incr*vib/VIB_RATE);
+	if(SLOT8_1->vib) SLOT8_1->Cnt += (SLOT8_1->Incr*OPL->vib/VIB_RATE);
 	else			 SLOT8_1->Cnt += SLOT8_1->Incr;
-	if(SLOT8_2->vib) SLOT8_2->Cnt += ((CH[8].fc*48)*vib/VIB_RATE);
+	if(SLOT8_2->vib) SLOT8_2->Cnt += ((CH[8].fc*48)*OPL->vib/VIB_RATE);
 	else			 SLOT8_2->Cnt += (CH[8].fc*48);
 
 	tone8 =	OP_OUT(SLOT8_2,whitenoise,0	);
 
 	/* SD */
 	if(	env_sd < EG_ENT-1 )
-		outd +=	OP_OUT(SLOT7_1,env_sd, 0)*8;
+		OPL->outd +=	OP_OUT(SLOT7_1,env_sd, 0)*8;
 	/* TAM */
 	if(	env_tam	< EG_ENT-1 )
-		outd +=	OP_OUT(SLOT8_1,env_tam,	0)*2;
+		OPL->outd +=	OP_OUT(SLOT8_1,env_tam,	0)*2;
 	/* TOP-CY */
 	if(	env_top	< EG_ENT-1 )
-		outd +=	OP_OUT(SLOT7_2,env_top,tone8)*2;
+		OPL->outd +=	OP_OUT(SLOT7_2,env_top,tone8)*2;
 	/* HH */
 	if(	env_hh	< EG_ENT-1 )
-		outd +=	OP_OUT(SLOT7_2,env_hh,tone8)*2;
+		OPL->outd +=	OP_OUT(SLOT7_2,env_hh,tone8)*2;
 }
 
 /* ----------- initialize time tabls ----------- */
@@ -649,14 +641,6 @@ static int OPLOpenTable( void )
 }
 
 
-static void	OPLCloseTable( void	)
-{
-	free(TL_TABLE);
-	free(SIN_TABLE);
-	free(AMS_TABLE);
-	free(VIB_TABLE);
-}
-
 /* CSM Key Controll	*/
 void CSMKeyControll(OPL_CH *CH)
 {
@@ -950,29 +934,16 @@ void OPLWriteReg(FM_OPL	*OPL, int r, int v)
 	}
 }
 
-/* lock/unlock for common table	*/
-static int OPL_LockTable(void)
+/* build the common tables the first time a chip is created */
+static void OPLInitTables(void)
 {
-	num_lock++;
-	if(num_lock>1) return 0;
-	/* first time */
-	cur_chip = NULL;
-	/* allocate	total level	table (128kb space)	*/
-	if(	!OPLOpenTable()	)
-	{
-		num_lock--;
-		return -1;
-	}
-	return 0;
+	tablesOpen = OPLOpenTable();
 }
 
-static void	OPL_UnLockTable(void)
+static int OPL_LockTable(void)
 {
-	if(num_lock) num_lock--;
-	if(num_lock) return;
-	/* last	time */
-	cur_chip = NULL;
-	OPLCloseTable();
+	archThreadOnce(&tablesOnce, OPLInitTables);
+	return tablesOpen ? 0 : -1;
 }
 
 
@@ -983,57 +954,39 @@ int	Y8950UpdateOne(FM_OPL *OPL)
 	UINT32 amsCnt  = OPL->amsCnt;
 	UINT32 vibCnt  = OPL->vibCnt;
 	UINT8 rythm	= OPL->rythm&0x20;
-	OPL_CH *CH,*R_CH;
+	OPL_CH *CH,*R_CH,*S_CH,*E_CH;
 	YM_DELTAT *DELTAT =	OPL->deltat;
 
-	/* setup DELTA-T unit */
-	YM_DELTAT_DECODE_PRESET(DELTAT);
-
-	if(	(void *)OPL	!= cur_chip	){
-		cur_chip = (void *)OPL;
-		/* channel pointers	*/
-		S_CH = OPL->P_CH;
-		E_CH = &S_CH[9];
-		/* rythm slot */
-		SLOT7_1	= &S_CH[7].SLOT[SLOT1];
-		SLOT7_2	= &S_CH[7].SLOT[SLOT2];
-		SLOT8_1	= &S_CH[8].SLOT[SLOT1];
-		SLOT8_2	= &S_CH[8].SLOT[SLOT2];
-		/* LFO state */
-		amsIncr	= OPL->amsIncr;
-		vibIncr	= OPL->vibIncr;
-		ams_table =	&AMS_TABLE[OPL->ams_table_idx];
-		vib_table =	&VIB_TABLE[OPL->vib_table_idx];			
-	}
-
+	S_CH = OPL->P_CH;
+	E_CH = &S_CH[9];
 	R_CH = rythm ? &S_CH[6]	: E_CH;
 	/*			  channel A			channel	B		  channel C		 */
 	/* LFO */
-	ams	= ams_table[(amsCnt+=amsIncr)>>AMS_SHIFT];
-	vib	= vib_table[(vibCnt+=vibIncr)>>VIB_SHIFT];
+	OPL->ams = AMS_TABLE[OPL->ams_table_idx + ((amsCnt+=OPL->amsIncr)>>AMS_SHIFT)];
+	OPL->vib = VIB_TABLE[OPL->vib_table_idx + ((vibCnt+=OPL->vibIncr)>>VIB_SHIFT)];
 	/* FM part */
-	outd = 0;
+	OPL->outd = 0;
     count = OPL->rate / OPL->baseRate;
     while (count--) {
 	    for(CH=S_CH	; CH < R_CH	; CH++)
-		    OPL_CALC_CH(CH);
+		    OPL_CALC_CH(OPL,CH);
 	    /* Rythn part */
 	    if(rythm)
-		    OPL_CALC_RH(S_CH);
+		    OPL_CALC_RH(OPL,S_CH);
     }
-    outd /= OPL->rate / OPL->baseRate;
+    OPL->outd /= OPL->rate / OPL->baseRate;
 
     OPL->dacCtrlVolume = OPL->dacSampleVolume - OPL->dacOldSampleVolume + 0x3fe7 * OPL->dacCtrlVolume / 0x4000;
     OPL->dacOldSampleVolume = OPL->dacSampleVolume;
     OPL->dacDaVolume += 2 * (OPL->dacCtrlVolume - OPL->dacDaVolume) / 3;
     OPL->dacEnabled = OPL->dacDaVolume;
-    outd += OPL->dacDaVolume << 14;
+    OPL->outd += OPL->dacDaVolume << 14;
 
 	/* deltaT ADPCM	*/
 	if(	DELTAT->flag )
 		YM_DELTAT_ADPCM_CALC(DELTAT);
 	/* limit check */
-	data = outd;//Limit( outd ,	OPL_MAXOUT,	OPL_MINOUT );
+	data = OPL->outd;//Limit( outd ,	OPL_MAXOUT,	OPL_MINOUT );
 	OPL->amsCnt	= amsCnt;
 	OPL->vibCnt	= vibCnt;
 	/* deltaT START	flag */
@@ -1080,7 +1033,7 @@ void OPLResetChip(FM_OPL *OPL)
 		YM_DELTAT *DELTAT =	OPL->deltat;
 
 		DELTAT->freqbase = OPL->freqbase;
-		DELTAT->output_pointer = &outd;
+		DELTAT->output_pointer = &OPL->outd;
 #ifdef MSX_AUDIO
 		DELTAT->portshift =	2;
 #else
@@ -1113,7 +1066,7 @@ void OPLSetOversampling(FM_OPL *OPL, int oversampling)
 
 /* ----------  Create one of vietual YM3812	----------		 */
 /* 'rate'  is sampling rate	and	'bufsiz' is	the	size of	the	 */
-FM_OPL *OPLCreate(int type,	int	clock, int rate, int sampleram, void* ref)
+FM_OPL *OPLCreate(BoardContext* board, int type,	int	clock, int rate, int sampleram, void* ref)
 {
 	char *ptr;
 	FM_OPL *OPL;
@@ -1140,12 +1093,11 @@ FM_OPL *OPLCreate(int type,	int	clock, int rate, int sampleram, void* ref)
 	}
 	ptr+=sizeof(YM_DELTAT);
 
-	YM_DELTAT_DECODE_PRESET(OPL->deltat);
-
 	/* set channel state pointer */
 
     OPL->deltat->OPL = OPL;
 
+    OPL->board = board;
     OPL->ref   = ref;
 	OPL->type  = type;
 	OPL->clock = clock;
@@ -1162,7 +1114,6 @@ FM_OPL *OPLCreate(int type,	int	clock, int rate, int sampleram, void* ref)
 /* ----------  Destroy one of vietual YM3812 ----------	*/
 void OPLDestroy(FM_OPL *OPL)
 {
-	OPL_UnLockTable();
 	free(OPL->deltat->memory);
 	free(OPL);
 }
@@ -1267,7 +1218,7 @@ int	OPLTimerOver(FM_OPL	*OPL,int c)
 
 void Y8950LoadState(FM_OPL *OPL)
 {
-    SaveState* state = saveStateOpenForRead("fmopl");
+    SaveState* state = saveStateOpenForRead(OPL->board, "fmopl");
     char tag[32];
     int i;
     int j;
@@ -1417,7 +1368,7 @@ void Y8950LoadState(FM_OPL *OPL)
 
 void Y8950SaveState(FM_OPL *OPL)
 {
-    SaveState* state = saveStateOpenForWrite("fmopl");
+    SaveState* state = saveStateOpenForWrite(OPL->board, "fmopl");
     char tag[32];
     int i;
     int j;
@@ -83,6 +83,7 @@ typedef struct fm_opl_channel {
 
 /* OPL state */
 typedef struct fm_opl_f {
+    BoardContext* board; /* Board the IRQ goes to */
     void* ref; /* Pointer to user data */
 	/* Delta-T ADPCM unit (Y8950) */
 	YM_DELTAT *deltat;			/* DELTA-T ADPCM       */
@@ -117,6 +118,12 @@ typedef struct fm_opl_f {
 	INT32 amsIncr;
 	INT32 vibCnt;
 	INT32 vibIncr;
+	INT32 ams;			/* LFO outputs of the current sample */
+	INT32 vib;
+	/* output of the current sample */
+	INT32 outd;
+	INT32 feedback2;	/* connect for SLOT 2 */
+	UINT32 noiseRnd;	/* rythm white noise generator */
 	/* wave selector enable flag */
 	UINT8 wavesel;
     
@@ -141,7 +148,7 @@ typedef struct fm_opl_f {
 #define OPL_TYPE_YM3812 (OPL_TYPE_WAVESEL)
 #define OPL_TYPE_Y8950  (OPL_TYPE_ADPCM|OPL_TYPE_KEYBOARD|OPL_TYPE_IO)
 
-FM_OPL *OPLCreate(int type, int clock, int rate, int sampleram, void* ref);
+FM_OPL *OPLCreate(BoardContext* board, int type, int clock, int rate, int sampleram, void* ref);
 void OPLDestroy(FM_OPL *OPL);
 
 void OPLSetOversampling(FM_OPL *OPL, int oversampling);
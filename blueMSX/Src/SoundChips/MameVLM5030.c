@@ -102,6 +102,8 @@ typedef   signed long  INT32;
 
 struct vlm5030_info
 {
+    BoardContext* board;
+    void* ref; /* owner, synced by stream_update() */
 //	const struct VLM5030interface *intf;
 
 	sound_stream * channel;
@@ -148,20 +150,9 @@ struct vlm5030_info
 	int current_k[10];
 
 	INT32 x[10];
-};
-
-struct vlm5030_info vlm5030Info[4];
-
-#define SOUND_VLM5030 0
-struct vlm5030_info* sndti_token(int dummy, int idx)
-{
-    return vlm5030Info + idx;
-}
 
-struct vlm5030_info* auto_malloc(int dummy)
-{
-    return vlm5030Info;
-}
+	UINT32 noise_rnd; /* unvoiced sample generator */
+};
 
 /* phase value */
 enum {
@@ -315,10 +306,8 @@ static int parse_frame (struct vlm5030_info *chip)
 
 /* decode and buffering data */
 //static void vlm5030_update_callback(void *param,stream_sample_t **inputs, stream_sample_t **_buffer, int length)
-void vlm5030_update_callback(stream_sample_t *_buffer, int length)
+void vlm5030_update_callback(struct vlm5030_info *chip, stream_sample_t *_buffer, int length)
 {
-//	struct vlm5030_info *chip = param;
-	struct vlm5030_info *chip = sndti_token(SOUND_VLM5030, 0);
 	int buf_count=0;
 	int interp_effect;
 	int i;
@@ -398,7 +387,8 @@ void vlm5030_update_callback(stream_sample_t *_buffer, int length)
 			}
 			else if (chip->old_pitch <= 1)
 			{	/* generate unvoiced samples here */
-				current_val = (rand()&1) ? (int)chip->current_energy : -(int)chip->current_energy;
+				chip->noise_rnd = chip->noise_rnd * 1103515245 + 12345;
+				current_val = ((chip->noise_rnd >> 16)&1) ? (int)chip->current_energy : -(int)chip->current_energy;
 			}
 			else
 			{
@@ -475,7 +465,7 @@ phase_stop:
 /* realtime update */
 static void VLM5030_update(struct vlm5030_info *chip)
 {
-	stream_update(chip->channel,0);
+	stream_update(chip->ref,0);
 }
 
 /* setup parameteroption when RST=H */
@@ -545,17 +535,15 @@ static void VLM5030_reset(struct vlm5030_info *chip)
 }
 
 /* set speech rom address */
-void VLM5030_set_rom(void *speech_rom, int length)
+void VLM5030_set_rom(struct vlm5030_info *chip, void *speech_rom, int length)
 {
-	struct vlm5030_info *chip = sndti_token(SOUND_VLM5030, 0);
     memcpy(chip->rom, speech_rom, 0x4000);
 //	chip->rom = (UINT8 *)speech_rom;
 }
 
 /* get BSY pin level */
-int VLM5030_BSY(void)
+int VLM5030_BSY(struct vlm5030_info *chip)
 {
-	struct vlm5030_info *chip = sndti_token(SOUND_VLM5030, 0);
 	VLM5030_update(chip);
 	return chip->pin_BSY;
 }
@@ -563,14 +551,12 @@ int VLM5030_BSY(void)
 /* latch contoll data */
 WRITE8_HANDLER( VLM5030_data_w )
 {
-	struct vlm5030_info *chip = sndti_token(SOUND_VLM5030, 0);
 	chip->latch_data = (UINT8)data;
 }
 
 /* set RST pin level : reset / set table address A8-A15 */
-void VLM5030_RST (int pin )
+void VLM5030_RST (struct vlm5030_info *chip, int pin)
 {
-	struct vlm5030_info *chip = sndti_token(SOUND_VLM5030, 0);
 	if( chip->pin_RST )
 	{
 		if( !pin )
@@ -593,18 +579,16 @@ void VLM5030_RST (int pin )
 }
 
 /* set VCU pin level : ?? unknown */
-void VLM5030_VCU(int pin)
+void VLM5030_VCU(struct vlm5030_info *chip, int pin)
 {
-	struct vlm5030_info *chip = sndti_token(SOUND_VLM5030, 0);
 	/* direct mode / indirect mode */
 	chip->pin_VCU = pin;
 	return;
 }
 
 /* set ST pin level  : set table address A0-A7 / start speech */
-void VLM5030_ST(int pin )
+void VLM5030_ST(struct vlm5030_info *chip, int pin)
 {
-	struct vlm5030_info *chip = sndti_token(SOUND_VLM5030, 0);
 	int table;
 
 	if( chip->pin_ST != pin )
@@ -668,13 +652,14 @@ if( chip->interp_step != 1)
 
 /* start VLM5030 with sound rom              */
 /* speech_rom == 0 -> use sampling data mode */
-void *vlm5030_start(int clock)
+struct vlm5030_info *vlm5030_start(BoardContext* board, int clock, void* ref)
 {
 	int emulation_rate;
 	struct vlm5030_info *chip;
 
-	chip = auto_malloc(sizeof(*chip));
-	memset(chip, 0, sizeof(*chip));
+	chip = calloc(1, sizeof(*chip));
+	chip->board = board;
+	chip->ref = ref;
 
 //	chip->intf = config;
 
@@ -725,11 +710,15 @@ void *vlm5030_start(int clock)
 	return chip;
 }
 
-void vlm5030_LoadState()
+void vlm5030_stop(struct vlm5030_info *chip)
+{
+	free(chip);
+}
+
+void vlm5030_LoadState(struct vlm5030_info *chip)
 {
-	struct vlm5030_info *chip = sndti_token(SOUND_VLM5030, 0);
     int i;
-    SaveState* state = saveStateOpenForWrite("vlm_5030");
+    SaveState* state = saveStateOpenForWrite(chip->board, "vlm_5030");
     
     saveStateSet(state, "address",       chip->address);
     saveStateSet(state, "pin_ST",        chip->pin_ST);
@@ -763,11 +752,10 @@ void vlm5030_LoadState()
     saveStateClose(state);
 }
 
-void vlm5030_SaveState()
+void vlm5030_SaveState(struct vlm5030_info *chip)
 {
-	struct vlm5030_info *chip = sndti_token(SOUND_VLM5030, 0);
     int i;
-    SaveState* state = saveStateOpenForRead("vlm_5030");
+    SaveState* state = saveStateOpenForRead(chip->board, "vlm_5030");
     
     chip->address       = (UInt16)saveStateGet(state, "address",       0);
     chip->pin_ST        = (UInt8)saveStateGet(state, "pin_ST",        0);
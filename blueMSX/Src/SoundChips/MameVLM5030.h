@@ -1,18 +1,24 @@
 #ifndef VLM5030_h
 #define VLM5030_h
 
+#include "MsxTypes.h"
+
+struct vlm5030_info;
+
 #define WRITE8_HANDLER(name) 	\
-    void     name(int offset, unsigned char data)
+    void     name(struct vlm5030_info *chip, int offset, unsigned char data)
 
 typedef void* sound_stream;
 typedef int stream_sample_t;
 extern void stream_update(sound_stream,int);
-void vlm5030_update_callback(stream_sample_t *_buffer, int length);
+void vlm5030_update_callback(struct vlm5030_info *chip, stream_sample_t *_buffer, int length);
 
-void *vlm5030_start(int clock);
+/* ref is passed to stream_update() when the chip needs the output synced */
+struct vlm5030_info *vlm5030_start(BoardContext* board, int clock, void* ref);
+void vlm5030_stop(struct vlm5030_info *chip);
 
-void vlm5030_LoadState();
-void vlm5030_SaveState();
+void vlm5030_LoadState(struct vlm5030_info *chip);
+void vlm5030_SaveState(struct vlm5030_info *chip);
 
 
 struct VLM5030interface
@@ -22,17 +28,17 @@ struct VLM5030interface
 };
 
 /* set speech rom address */
-void VLM5030_set_rom(void *speech_rom, int length);
+void VLM5030_set_rom(struct vlm5030_info *chip, void *speech_rom, int length);
 
 /* get BSY pin level */
-int VLM5030_BSY(void);
+int VLM5030_BSY(struct vlm5030_info *chip);
 /* latch contoll data */
 WRITE8_HANDLER( VLM5030_data_w );
 /* set RST pin level : reset / set table address A8-A15 */
-void VLM5030_RST (int pin );
+void VLM5030_RST (struct vlm5030_info *chip, int pin );
 /* set VCU pin level : ?? unknown */
-void VLM5030_VCU(int pin );
+void VLM5030_VCU(struct vlm5030_info *chip, int pin );
 /* set ST pin level  : set table address A0-A7 / start speech */
-void VLM5030_ST(int pin );
+void VLM5030_ST(struct vlm5030_info *chip, int pin );
 
 #endif
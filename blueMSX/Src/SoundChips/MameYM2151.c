@@ -11,6 +11,7 @@
 
 #include "MameYM2151.h"
 #include "SaveState.h"
+#include "ArchThread.h"
 
 
 /* struct describing a single operator */
@@ -66,6 +67,7 @@ typedef struct
 
 struct MameYm2151
 {
+    BoardContext* board;
     void* ref;
 
 	YM2151Operator	oper[32];			/* the 32 operators */
@@ -447,8 +449,8 @@ static UInt8 lfo_noise_waveform[256] = {
 
 
 
-/* these variables stay here for speedup purposes only */
-static MameYm2151 * PSG;
+/* the tables are built once and shared by all chips */
+static volatile int tablesOnce = 0;
 
 
 /* own PI definition */
@@ -626,7 +628,7 @@ static void init_chip_tables(MameYm2151 *chip)
 			(op)->phase = 0;			/* clear phase */		\
 			(op)->state = EG_ATT;		/* KEY ON = attack */	\
 			(op)->volume += (~(op)->volume *					\
-                           (eg_inc[(op)->eg_sel_ar + ((PSG->eg_cnt>>(op)->eg_sh_ar)&7)])	\
+                           (eg_inc[(op)->eg_sel_ar + ((chip->eg_cnt>>(op)->eg_sh_ar)&7)])	\
                           ) >>4;								\
 			if ((op)->volume <= MIN_ATT_INDEX)					\
 			{													\
@@ -649,7 +651,7 @@ static void init_chip_tables(MameYm2151 *chip)
 		}														\
 }
 
-static void envelope_KONKOFF(YM2151Operator * op, int v)
+static void envelope_KONKOFF(MameYm2151 *chip, YM2151Operator * op, int v)
 {
 	if (v&0x08)	/* M1 */
 		KEY_ON (op+0, 1)
@@ -893,8 +895,7 @@ void YM2151WriteReg(MameYm2151 *chip, int r, int v)
 			break;
 
 		case 0x08:
-			PSG = chip; /* PSG is used in KEY_ON macro */
-			envelope_KONKOFF(&chip->oper[ (v&7)*4 ], v );
+			envelope_KONKOFF(chip, &chip->oper[ (v&7)*4 ], v );
 			break;
 
 		case 0x0f:	/* noise mode enable, noise period */
@@ -1134,13 +1135,14 @@ static void ym2151_state_save_register( MameYm2151 *chip )
 {
 }
 
-MameYm2151* YM2151Create(void* ref, int clock, int rate)
+MameYm2151* YM2151Create(BoardContext* board, void* ref, int clock, int rate)
 {
     MameYm2151 *chip = (MameYm2151 *)calloc(1, sizeof(MameYm2151));
 
+    chip->board = board;
     chip->ref = ref;
 
-	init_tables();
+	archThreadOnce(&tablesOnce, init_tables);
 
 	chip->clock = clock;
 	/*rate = clock/64;*/
@@ -1256,12 +1258,12 @@ static void chan_calc(MameYm2151* chip, unsigned int chan)
 	UInt32 AM = 0;
 
 	chip->m2 = chip->c1 = chip->c2 = chip->mem = 0;
-	op = &PSG->oper[chan*4];	/* M1 */
+	op = &chip->oper[chan*4];	/* M1 */
 
 	*op->mem_connect = op->mem_value;	/* restore delayed sample (MEM) value to m2 or c2 */
 
 	if (op->ams)
-		AM = PSG->lfa << (op->ams-1);
+		AM = chip->lfa << (op->ams-1);
 	env = volume_calc(op);
 	{
 		Int32 out = op->fb_out_prev + op->fb_out_curr;
@@ -1305,12 +1307,12 @@ static void chan7_calc(MameYm2151* chip)
 	UInt32 AM = 0;
 
 	chip->m2 = chip->c1 = chip->c2 = chip->mem = 0;
-	op = &PSG->oper[7*4];		/* M1 */
+	op = &chip->oper[7*4];		/* M1 */
 
 	*op->mem_connect = op->mem_value;	/* restore delayed sample (MEM) value to m2 or c2 */
 
 	if (op->ams)
-		AM = PSG->lfa << (op->ams-1);
+		AM = chip->lfa << (op->ams-1);
 	env = volume_calc(op);
 	{
 		Int32 out = op->fb_out_prev + op->fb_out_curr;
@@ -1341,14 +1343,14 @@ static void chan7_calc(MameYm2151* chip)
 		*(op+2)->connect += op_calc(op+2, env, chip->c1);
 
 	env = volume_calc(op+3);	/* C2 */
-	if (PSG->noise & 0x80)
+	if (chip->noise & 0x80)
 	{
 		UInt32 noiseout;
 
 		noiseout = 0;
 		if (env < 0x3ff)
 			noiseout = (env ^ 0x3ff) * 2;	/* range of the YM2151 noise output is -2044 to 2040 */
-		chip->chanout[7] += ((PSG->noise_rng&0x10000) ? noiseout: (UInt32)-(Int32)noiseout); /* bit 16 -> output */
+		chip->chanout[7] += ((chip->noise_rng&0x10000) ? noiseout: (UInt32)-(Int32)noiseout); /* bit 16 -> output */
 	}
 	else
 	{
@@ -1568,33 +1570,33 @@ rate 11 1         |
                                  --
 */
 
-static void advance_eg(void)
+static void advance_eg(MameYm2151* chip)
 {
 	YM2151Operator *op;
 	unsigned int i;
 
 
 
-	PSG->eg_timer += PSG->eg_timer_add;
+	chip->eg_timer += chip->eg_timer_add;
 
-	while (PSG->eg_timer >= PSG->eg_timer_overflow)
+	while (chip->eg_timer >= chip->eg_timer_overflow)
 	{
-		PSG->eg_timer -= PSG->eg_timer_overflow;
+		chip->eg_timer -= chip->eg_timer_overflow;
 
-		PSG->eg_cnt++;
+		chip->eg_cnt++;
 
 		/* envelope generator */
-		op = &PSG->oper[0];	/* CH 0 M1 */
+		op = &chip->oper[0];	/* CH 0 M1 */
 		i = 32;
 		do
 		{
 			switch(op->state)
 			{
 			case EG_ATT:	/* attack phase */
-				if ( !(PSG->eg_cnt & ((1<<op->eg_sh_ar)-1) ) )
+				if ( !(chip->eg_cnt & ((1<<op->eg_sh_ar)-1) ) )
 				{
 					op->volume += (~op->volume *
-                                   (eg_inc[op->eg_sel_ar + ((PSG->eg_cnt>>op->eg_sh_ar)&7)])
+                                   (eg_inc[op->eg_sel_ar + ((chip->eg_cnt>>op->eg_sh_ar)&7)])
                                   ) >>4;
 
 					if (op->volume <= MIN_ATT_INDEX)
@@ -1607,9 +1609,9 @@ static void advance_eg(void)
 			break;
 
 			case EG_DEC:	/* decay phase */
-				if ( !(PSG->eg_cnt & ((1<<op->eg_sh_d1r)-1) ) )
+				if ( !(chip->eg_cnt & ((1<<op->eg_sh_d1r)-1) ) )
 				{
-					op->volume += eg_inc[op->eg_sel_d1r + ((PSG->eg_cnt>>op->eg_sh_d1r)&7)];
+					op->volume += eg_inc[op->eg_sel_d1r + ((chip->eg_cnt>>op->eg_sh_d1r)&7)];
 
 					if ( (UInt32)op->volume >= op->d1l )
 						op->state = EG_SUS;
@@ -1618,9 +1620,9 @@ static void advance_eg(void)
 			break;
 
 			case EG_SUS:	/* sustain phase */
-				if ( !(PSG->eg_cnt & ((1<<op->eg_sh_d2r)-1) ) )
+				if ( !(chip->eg_cnt & ((1<<op->eg_sh_d2r)-1) ) )
 				{
-					op->volume += eg_inc[op->eg_sel_d2r + ((PSG->eg_cnt>>op->eg_sh_d2r)&7)];
+					op->volume += eg_inc[op->eg_sel_d2r + ((chip->eg_cnt>>op->eg_sh_d2r)&7)];
 
 					if ( op->volume >= MAX_ATT_INDEX )
 					{
@@ -1632,9 +1634,9 @@ static void advance_eg(void)
 			break;
 
 			case EG_REL:	/* release phase */
-				if ( !(PSG->eg_cnt & ((1<<op->eg_sh_rr)-1) ) )
+				if ( !(chip->eg_cnt & ((1<<op->eg_sh_rr)-1) ) )
 				{
-					op->volume += eg_inc[op->eg_sel_rr + ((PSG->eg_cnt>>op->eg_sh_rr)&7)];
+					op->volume += eg_inc[op->eg_sel_rr + ((chip->eg_cnt>>op->eg_sh_rr)&7)];
 
 					if ( op->volume >= MAX_ATT_INDEX )
 					{
@@ -1652,31 +1654,31 @@ static void advance_eg(void)
 }
 
 
-static void advance(void)
+static void advance(MameYm2151* chip)
 {
 	YM2151Operator *op;
 	unsigned int i;
 	int a,p;
 
 	/* LFO */
-	if (PSG->test&2)
-		PSG->lfo_phase = 0;
+	if (chip->test&2)
+		chip->lfo_phase = 0;
 	else
 	{
-		PSG->lfo_timer += PSG->lfo_timer_add;
-		if (PSG->lfo_timer >= PSG->lfo_overflow)
+		chip->lfo_timer += chip->lfo_timer_add;
+		if (chip->lfo_timer >= chip->lfo_overflow)
 		{
-			PSG->lfo_timer   -= PSG->lfo_overflow;
-			PSG->lfo_counter += PSG->lfo_counter_add;
-			PSG->lfo_phase   += (PSG->lfo_counter>>4);
-			PSG->lfo_phase   &= 255;
-			PSG->lfo_counter &= 15;
+			chip->lfo_timer   -= chip->lfo_overflow;
+			chip->lfo_counter += chip->lfo_counter_add;
+			chip->lfo_phase   += (chip->lfo_counter>>4);
+			chip->lfo_phase   &= 255;
+			chip->lfo_counter &= 15;
 		}
 	}
 
-	i = PSG->lfo_phase;
+	i = chip->lfo_phase;
 	/* calculate LFO AM and PM waveform value (all verified on real chip, except for noise algorithm which is impossible to analyse)*/
-	switch (PSG->lfo_wsel)
+	switch (chip->lfo_wsel)
 	{
 	case 0:
 		/* saw */
@@ -1731,8 +1733,8 @@ static void advance(void)
 		p = a-128;
 		break;
 	}
-	PSG->lfa = a * PSG->amd / 128;
-	PSG->lfp = p * PSG->pmd / 128;
+	chip->lfa = a * chip->amd / 128;
+	chip->lfp = p * chip->pmd / 128;
 
 
 	/*	The Noise Generator of the YM2151 is 17-bit shift register.
@@ -1740,26 +1742,26 @@ static void advance(void)
 	*	Output of the register is negated (bit0 XOR bit3).
 	*	Simply use bit16 as the noise output.
 	*/
-	PSG->noise_p += PSG->noise_f;
-	i = (PSG->noise_p>>16);		/* number of events (shifts of the shift register) */
-	PSG->noise_p &= 0xffff;
+	chip->noise_p += chip->noise_f;
+	i = (chip->noise_p>>16);		/* number of events (shifts of the shift register) */
+	chip->noise_p &= 0xffff;
 	while (i)
 	{
 		UInt32 j;
-		j = ( (PSG->noise_rng ^ (PSG->noise_rng>>3) ) & 1) ^ 1;
-		PSG->noise_rng = (j<<16) | (PSG->noise_rng>>1);
+		j = ( (chip->noise_rng ^ (chip->noise_rng>>3) ) & 1) ^ 1;
+		chip->noise_rng = (j<<16) | (chip->noise_rng>>1);
 		i--;
 	}
 
 
 	/* phase generator */
-	op = &PSG->oper[0];	/* CH 0 M1 */
+	op = &chip->oper[0];	/* CH 0 M1 */
 	i = 8;
 	do
 	{
 		if (op->pms)	/* only when phase modulation from LFO is enabled for this channel */
 		{
-			Int32 mod_ind = PSG->lfp;		/* -128..+127 (8bits signed) */
+			Int32 mod_ind = chip->lfp;		/* -128..+127 (8bits signed) */
 			if (op->pms < 6)
 				mod_ind >>= (6 - op->pms);
 			else
@@ -1768,10 +1770,10 @@ static void advance(void)
 			if (mod_ind)
 			{
 				UInt32 kc_channel =	op->kc_i + mod_ind;
-				(op+0)->phase += ( (PSG->freq[ kc_channel + (op+0)->dt2 ] + (op+0)->dt1) * (op+0)->mul ) >> 1;
-				(op+1)->phase += ( (PSG->freq[ kc_channel + (op+1)->dt2 ] + (op+1)->dt1) * (op+1)->mul ) >> 1;
-				(op+2)->phase += ( (PSG->freq[ kc_channel + (op+2)->dt2 ] + (op+2)->dt1) * (op+2)->mul ) >> 1;
-				(op+3)->phase += ( (PSG->freq[ kc_channel + (op+3)->dt2 ] + (op+3)->dt1) * (op+3)->mul ) >> 1;
+				(op+0)->phase += ( (chip->freq[ kc_channel + (op+0)->dt2 ] + (op+0)->dt1) * (op+0)->mul ) >> 1;
+				(op+1)->phase += ( (chip->freq[ kc_channel + (op+1)->dt2 ] + (op+1)->dt1) * (op+1)->mul ) >> 1;
+				(op+2)->phase += ( (chip->freq[ kc_channel + (op+2)->dt2 ] + (op+2)->dt1) * (op+2)->mul ) >> 1;
+				(op+3)->phase += ( (chip->freq[ kc_channel + (op+3)->dt2 ] + (op+3)->dt1) * (op+3)->mul ) >> 1;
 			}
 			else		/* phase modulation from LFO is equal to zero */
 			{
@@ -1803,11 +1805,11 @@ static void advance(void)
 	* the sound played is the same as after normal KEY ON.
 	*/
 
-	if (PSG->csm_req)			/* CSM KEYON/KEYOFF seqeunce request */
+	if (chip->csm_req)			/* CSM KEYON/KEYOFF seqeunce request */
 	{
-		if (PSG->csm_req==2)	/* KEY ON */
+		if (chip->csm_req==2)	/* KEY ON */
 		{
-			op = &PSG->oper[0];	/* CH 0 M1 */
+			op = &chip->oper[0];	/* CH 0 M1 */
 			i = 32;
 			do
 			{
@@ -1815,11 +1817,11 @@ static void advance(void)
 				op++;
 				i--;
 			}while (i);
-			PSG->csm_req = 1;
+			chip->csm_req = 1;
 		}
 		else					/* KEY OFF */
 		{
-			op = &PSG->oper[0];	/* CH 0 M1 */
+			op = &chip->oper[0];	/* CH 0 M1 */
 			i = 32;
 			do
 			{
@@ -1827,7 +1829,7 @@ static void advance(void)
 				op++;
 				i--;
 			}while (i);
-			PSG->csm_req = 0;
+			chip->csm_req = 0;
 		}
 	}
 }
@@ -1845,11 +1847,9 @@ void YM2151UpdateOne(MameYm2151* chip, Int16* bufL, Int16* bufR, int length)
 	int i;
 	signed int outl,outr;
 
-	PSG = chip;
-
 	for (i=0; i<length; i++)
 	{
-		advance_eg();
+		advance_eg(chip);
 
 		chip->chanout[0] = 0;
 		chip->chanout[1] = 0;
@@ -1869,22 +1869,22 @@ void YM2151UpdateOne(MameYm2151* chip, Int16* bufL, Int16* bufR, int length)
 		chan_calc(chip, 6);
 		chan7_calc(chip);
 
-		outl = chip->chanout[0] & PSG->pan[0];
-		outr = chip->chanout[0] & PSG->pan[1];
-		outl += (chip->chanout[1] & PSG->pan[2]);
-		outr += (chip->chanout[1] & PSG->pan[3]);
-		outl += (chip->chanout[2] & PSG->pan[4]);
-		outr += (chip->chanout[2] & PSG->pan[5]);
-		outl += (chip->chanout[3] & PSG->pan[6]);
-		outr += (chip->chanout[3] & PSG->pan[7]);
-		outl += (chip->chanout[4] & PSG->pan[8]);
-		outr += (chip->chanout[4] & PSG->pan[9]);
-		outl += (chip->chanout[5] & PSG->pan[10]);
-		outr += (chip->chanout[5] & PSG->pan[11]);
-		outl += (chip->chanout[6] & PSG->pan[12]);
-		outr += (chip->chanout[6] & PSG->pan[13]);
-		outl += (chip->chanout[7] & PSG->pan[14]);
-		outr += (chip->chanout[7] & PSG->pan[15]);
+		outl = chip->chanout[0] & chip->pan[0];
+		outr = chip->chanout[0] & chip->pan[1];
+		outl += (chip->chanout[1] & chip->pan[2]);
+		outr += (chip->chanout[1] & chip->pan[3]);
+		outl += (chip->chanout[2] & chip->pan[4]);
+		outr += (chip->chanout[2] & chip->pan[5]);
+		outl += (chip->chanout[3] & chip->pan[6]);
+		outr += (chip->chanout[3] & chip->pan[7]);
+		outl += (chip->chanout[4] & chip->pan[8]);
+		outr += (chip->chanout[4] & chip->pan[9]);
+		outl += (chip->chanout[5] & chip->pan[10]);
+		outr += (chip->chanout[5] & chip->pan[11]);
+		outl += (chip->chanout[6] & chip->pan[12]);
+		outr += (chip->chanout[6] & chip->pan[13]);
+		outl += (chip->chanout[7] & chip->pan[14]);
+		outr += (chip->chanout[7] & chip->pan[15]);
 
 		outl >>= FINAL_SH;
 		outr >>= FINAL_SH;
@@ -1895,14 +1895,14 @@ void YM2151UpdateOne(MameYm2151* chip, Int16* bufL, Int16* bufR, int length)
 		((Int16*)bufL)[i] = (Int16)outl;
 		((Int16*)bufR)[i] = (Int16)outr;
 
-		advance();
+		advance(chip);
 	}
 }
 
 
 void YM2151LoadState(MameYm2151* chip)
 {
-    SaveState* state = saveStateOpenForRead("ym2151_core");
+    SaveState* state = saveStateOpenForRead(chip->board, "ym2151_core");
     char tag[32];
     int i;
     int tmp;
@@ -2076,7 +2076,7 @@ void YM2151LoadState(MameYm2151* chip)
 
 void YM2151SaveState(MameYm2151* chip)
 {
-    SaveState* state = saveStateOpenForWrite("ym2151_core");
+    SaveState* state = saveStateOpenForWrite(chip->board, "ym2151_core");
     char tag[32];
     int i;
 
@@ -36,7 +36,7 @@
 
 typedef struct MameYm2151 MameYm2151;
 
-MameYm2151* YM2151Create(void* ref, int clock, int rate);
+MameYm2151* YM2151Create(BoardContext* board, void* ref, int clock, int rate);
 void YM2151Destroy(MameYm2151* chip);
 void YM2151ResetChip(MameYm2151* chip);
 void YM2151UpdateOne(MameYm2151* chip,Int16* bufL, Int16* bufR, int length);
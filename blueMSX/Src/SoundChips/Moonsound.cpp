@@ -43,6 +43,7 @@ struct Moonsound {
         memset(defaultBuffer, 0, sizeof(defaultBuffer));
     }
 
+    BoardContext* board;
     Mixer* mixer;
     Int32 handle;
 
@@ -109,7 +110,7 @@ void moonsoundTimerStart(void* ref, int timer, int start, UInt8 timerRef)
         moonsound->timerRef1 = timerRef;
         moonsound->timerStarted1 = start;
         if (start) {
-            moonsound->timeout1 = boardCalcRelativeTimeout(12380, moonsound->timerValue1);
+            moonsound->timeout1 = boardCalcRelativeTimeout(moonsound->board, 12380, moonsound->timerValue1);
             boardTimerAdd(moonsound->timer1, moonsound->timeout1);
         }
         else {
@@ -120,7 +121,7 @@ void moonsoundTimerStart(void* ref, int timer, int start, UInt8 timerRef)
         moonsound->timerRef2 = timerRef;
         moonsound->timerStarted2 = start;
         if (start) {
-            moonsound->timeout2 = boardCalcRelativeTimeout(12380, moonsound->timerValue2);
+            moonsound->timeout2 = boardCalcRelativeTimeout(moonsound->board, 12380, moonsound->timerValue2);
             boardTimerAdd(moonsound->timer2, moonsound->timeout2);
         }
         else {
@@ -144,7 +145,7 @@ void moonsoundDestroy(Moonsound* moonsound)
 
 void moonsoundSaveState(Moonsound* moonsound)
 {
-    SaveState* state = saveStateOpenForWrite("moonsound");
+    SaveState* state = saveStateOpenForWrite(moonsound->board, "moonsound");
 
     saveStateSet(state, "timerValue1",    moonsound->timerValue1);
     saveStateSet(state, "timeout1",       moonsound->timeout1);
@@ -165,7 +166,7 @@ void moonsoundSaveState(Moonsound* moonsound)
 
 void moonsoundLoadState(Moonsound* moonsound)
 {
-    SaveState* state = saveStateOpenForRead("moonsound");
+    SaveState* state = saveStateOpenForRead(moonsound->board, "moonsound");
 
     moonsound->timerValue1    =        saveStateGet(state, "timerValue1",    0);
     moonsound->timeout1       =        saveStateGet(state, "timeout1",       0);
@@ -193,16 +194,14 @@ void moonsoundLoadState(Moonsound* moonsound)
 }
 
 
-static char* regText(int d)
+static char* regText(char* text, int d)
 {
-    static char text[5];
     sprintf(text, "R%.2x", d);
     return text;
 }
 
-static char* slotRegText(int s, int r)
+static char* slotRegText(char* text, int s, int r)
 {
-    static char text[5];
     sprintf(text, "S%d:%d", s, r);
     return text;
 }
@@ -220,8 +219,9 @@ static char regsAvailYMF262[] = {
 
 void moonsoundGetDebugInfo(Moonsound* moonsound, DbgDevice* dbgDevice)
 {
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(moonsound->board);
     DbgRegisterBank* regBank;
+    char text[8];
     int r;
 
     // Add YMF262 registers
@@ -238,10 +238,10 @@ void moonsoundGetDebugInfo(Moonsound* moonsound, DbgDevice* dbgDevice)
     for (r = 0; r < sizeof(regsAvailYMF262); r++) {
         if (regsAvailYMF262[r]) {
             if (r <= 8) {
-                dbgRegisterBankAddRegister(regBank, c++, regText(r), 8, moonsound->ymf262->peekReg(r|0x100));
+                dbgRegisterBankAddRegister(regBank, c++, regText(text, r), 8, moonsound->ymf262->peekReg(r|0x100));
             }
             else {
-                dbgRegisterBankAddRegister(regBank, c++, regText(r), 8, moonsound->ymf262->peekReg(r));
+                dbgRegisterBankAddRegister(regBank, c++, regText(text, r), 8, moonsound->ymf262->peekReg(r));
             }
         }
     }
@@ -253,20 +253,20 @@ void moonsoundGetDebugInfo(Moonsound* moonsound, DbgDevice* dbgDevice)
     c = 0;
     dbgRegisterBankAddRegister(regBank, c++, "SR", 8, moonsound->ymf278->peekStatus(systemTime));
     
-    r=0x00; dbgRegisterBankAddRegister(regBank, c++, regText(r), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
-    r=0x01; dbgRegisterBankAddRegister(regBank, c++, regText(r), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
-    r=0x02; dbgRegisterBankAddRegister(regBank, c++, regText(r), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
-    r=0x03; dbgRegisterBankAddRegister(regBank, c++, regText(r), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
-    r=0x04; dbgRegisterBankAddRegister(regBank, c++, regText(r), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
-    r=0x05; dbgRegisterBankAddRegister(regBank, c++, regText(r), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
-    r=0x06; dbgRegisterBankAddRegister(regBank, c++, regText(r), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
-    r=0xf8; dbgRegisterBankAddRegister(regBank, c++, regText(r), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
-    r=0xf9; dbgRegisterBankAddRegister(regBank, c++, regText(r), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
+    r=0x00; dbgRegisterBankAddRegister(regBank, c++, regText(text, r), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
+    r=0x01; dbgRegisterBankAddRegister(regBank, c++, regText(text, r), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
+    r=0x02; dbgRegisterBankAddRegister(regBank, c++, regText(text, r), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
+    r=0x03; dbgRegisterBankAddRegister(regBank, c++, regText(text, r), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
+    r=0x04; dbgRegisterBankAddRegister(regBank, c++, regText(text, r), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
+    r=0x05; dbgRegisterBankAddRegister(regBank, c++, regText(text, r), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
+    r=0x06; dbgRegisterBankAddRegister(regBank, c++, regText(text, r), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
+    r=0xf8; dbgRegisterBankAddRegister(regBank, c++, regText(text, r), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
+    r=0xf9; dbgRegisterBankAddRegister(regBank, c++, regText(text, r), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
 
     for (int i = 0; i < 10; i++) {
         for (int j = 0; j < 10; j++) {
             int r = 8 + i * 24 + j;
-            dbgRegisterBankAddRegister(regBank, c++, slotRegText(i,j), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
+            dbgRegisterBankAddRegister(regBank, c++, slotRegText(text, i, j), 8, moonsound->ymf278->peekRegOPL4(r, systemTime));
         }
     }
 
@@ -277,7 +277,7 @@ void moonsoundGetDebugInfo(Moonsound* moonsound, DbgDevice* dbgDevice)
 
 void moonsoundReset(Moonsound* moonsound)
 {
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(moonsound->board);
 
     moonsound->timerStarted1 = (UInt32)-1;
     moonsound->timerStarted2 = (UInt32)-1;
@@ -315,7 +315,7 @@ static Int32* moonsoundSync(void* ref, UInt32 count)
 UInt8 moonsoundPeek(Moonsound* moonsound, UInt16 ioPort)
 {
 	UInt8 result = 0xff;
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(moonsound->board);
 
     if (moonsound == NULL) {
         return 0xff;
@@ -347,7 +347,7 @@ UInt8 moonsoundPeek(Moonsound* moonsound, UInt16 ioPort)
 UInt8 moonsoundRead(Moonsound* moonsound, UInt16 ioPort)
 {
 	UInt8 result = 0xff;
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(moonsound->board);
 
 	if (ioPort < 0xC0) {
 		switch (ioPort & 0x01) {
@@ -377,7 +377,7 @@ UInt8 moonsoundRead(Moonsound* moonsound, UInt16 ioPort)
 
 void moonsoundWrite(Moonsound* moonsound, UInt16 ioPort, UInt8 value)
 {
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(moonsound->board);
 	if (ioPort < 0xC0) {
 		switch (ioPort & 0x01) {
 		case 0: // select register
@@ -408,30 +408,31 @@ void moonsoundWrite(Moonsound* moonsound, UInt16 ioPort, UInt8 value)
 void moonsoundSetSampleRate(void* ref, UInt32 rate)
 {
     Moonsound* moonsound = (Moonsound*)ref;
-    moonsound->ymf262->setSampleRate(rate, boardGetMoonsoundOversampling());
-    moonsound->ymf278->setSampleRate(rate, boardGetMoonsoundOversampling());
+    moonsound->ymf262->setSampleRate(rate, boardGetMoonsoundOversampling(moonsound->board));
+    moonsound->ymf278->setSampleRate(rate, boardGetMoonsoundOversampling(moonsound->board));
 }
 
-Moonsound* moonsoundCreate(Mixer* mixer, void* romData, int romSize, int sramSize)
+Moonsound* moonsoundCreate(BoardContext* board, Mixer* mixer, void* romData, int romSize, int sramSize)
 {
     Moonsound* moonsound = new Moonsound;
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(board);
 
+    moonsound->board = board;
     moonsound->mixer = mixer;
     moonsound->timerStarted1 = 0;
     moonsound->timerStarted2 = 0;
 
-    moonsound->timer1 = boardTimerCreate(onTimeout1, moonsound);
-    moonsound->timer2 = boardTimerCreate(onTimeout2, moonsound);
+    moonsound->timer1 = boardTimerCreate(board, onTimeout1, moonsound);
+    moonsound->timer2 = boardTimerCreate(board, onTimeout2, moonsound);
 
     moonsound->handle = mixerRegisterChannel(mixer, MIXER_CHANNEL_MOONSOUND, 1, moonsoundSync, moonsoundSetSampleRate, moonsound);
 
-    moonsound->ymf262 = new YMF262(0, systemTime, moonsound);
-    moonsound->ymf262->setSampleRate(mixerGetSampleRate(mixer), boardGetMoonsoundOversampling());
+    moonsound->ymf262 = new YMF262(board, 0, systemTime, moonsound);
+    moonsound->ymf262->setSampleRate(mixerGetSampleRate(mixer), boardGetMoonsoundOversampling(board));
 	moonsound->ymf262->setVolume(32767 * 9 / 10);
 
-    moonsound->ymf278 = new YMF278(0, sramSize, romData, romSize, systemTime);
-    moonsound->ymf278->setSampleRate(mixerGetSampleRate(mixer), boardGetMoonsoundOversampling());
+    moonsound->ymf278 = new YMF278(board, 0, sramSize, romData, romSize, systemTime);
+    moonsound->ymf278->setSampleRate(mixerGetSampleRate(mixer), boardGetMoonsoundOversampling(board));
     moonsound->ymf278->setVolume(32767 * 9 / 10);
 
     return moonsound;
@@ -39,7 +39,7 @@ extern "C" {
 typedef struct Moonsound Moonsound;
 
 /* Constructor and destructor */
-Moonsound* moonsoundCreate(Mixer* mixer, void* romData, int romSize, int sramSize);
+Moonsound* moonsoundCreate(BoardContext* board, Mixer* mixer, void* romData, int romSize, int sramSize);
 void moonsoundDestroy(Moonsound* moonsound);
 void moonsoundReset(Moonsound* moonsound);
 UInt8 moonsoundRead(Moonsound* moonsound, UInt16 ioPort);
@@ -44,6 +44,7 @@ extern "C" Int32* msxaudioSync(void* ref, UInt32 count);
 #define OFFSETOF(s, a) ((int)(&((s*)0)->a))
 
 struct MsxAudio {
+    BoardContext* board;
     MsxAudio() :
         timer1(0), timer2(0), timerRef1(-1), timerRef2(-1) {
         memset(defaultBuffer, 0, sizeof(defaultBuffer));
@@ -110,7 +111,7 @@ void msxaudioTimerStart(int timer, int start, UInt8 ref)
 
 extern "C" void msxaudioTick2() {
     if (theMsxAudio != NULL) {
-        theMsxAudio->y8950->pushTime(boardSystemTime());
+        theMsxAudio->y8950->pushTime(boardSystemTime(theMsxAudio->board));
     }
 }
 
@@ -137,10 +138,10 @@ extern "C" void msxaudioTick(UInt32 elapsedTime)
 
 extern "C" void msxaudioDestroy(void* rm) {
     MsxAudio* msxaudio = (MsxAudio*)rm;
-    deviceManagerUnregister(msxaudio->deviceHandle);
+    deviceManagerUnregister(msxaudio->board, msxaudio->deviceHandle);
 
-    ioPortUnregister(0xc0);
-    ioPortUnregister(0xc1);
+    ioPortUnregister(msxaudio->board, 0xc0);
+    ioPortUnregister(msxaudio->board, 0xc1);
 
     mixerUnregisterChannel(msxaudio->mixer, msxaudio->handle);
 
@@ -162,7 +163,7 @@ extern "C" void msxaudioLoadState(void* rm)
 extern "C" UInt8 msxaudioRead(MsxAudio* msxaudio, UInt16 ioPort)
 {
 	UInt8 result = 0xff;
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(msxaudio->board);
 
 	switch (ioPort & 0x01) {
 	case 0:
@@ -179,7 +180,7 @@ extern "C" UInt8 msxaudioRead(MsxAudio* msxaudio, UInt16 ioPort)
 
 extern "C" void msxaudioWrite(MsxAudio* msxaudio, UInt16 ioPort, UInt8 value) 
 {
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(msxaudio->board);
 	switch (ioPort & 0x01) {
 	case 0:
 		msxaudio->registerLatch = value;
@@ -194,17 +195,18 @@ extern "C" void msxaudioWrite(MsxAudio* msxaudio, UInt16 ioPort, UInt8 value)
 void msxaudioSetSampleRate(void* ref, UInt32 rate)
 {
     MsxAudio* msxaudio = (MsxAudio*)ref;
-    msxaudio->y8950->setSampleRate(rate, boardGetY8950Oversampling());
+    msxaudio->y8950->setSampleRate(rate, boardGetY8950Oversampling(msxaudio->board));
 }
 
-extern "C" int msxaudioCreate(Mixer* mixer)
+extern "C" int msxaudioCreate(BoardContext* board, Mixer* mixer)
 {
     DeviceCallbacks callbacks = { msxaudioDestroy, NULL, msxaudioSaveState, msxaudioLoadState };
     MsxAudio* msxaudio = new MsxAudio;
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(board);
 
     theMsxAudio = msxaudio;
 
+    msxaudio->board = board;
     msxaudio->mixer = mixer;
     msxaudio->counter1 = -1;
     msxaudio->counter2 = -1;
@@ -212,14 +214,14 @@ extern "C" int msxaudioCreate(Mixer* mixer)
 
     msxaudio->handle = mixerRegisterChannel(mixer, MIXER_CHANNEL_MSXAUDIO, 0, msxaudioSync, msxaudioSetSampleRate, msxaudio);
 
-    msxaudio->deviceHandle = deviceManagerRegister(ROM_MSXAUDIO, &callbacks, msxaudio);
+    msxaudio->deviceHandle = deviceManagerRegister(msxaudio->board, ROM_MSXAUDIO, &callbacks, msxaudio);
 
-    msxaudio->y8950 = new Y8950("MsxAudio", 256*1024, systemTime);
-    msxaudio->y8950->setSampleRate(mixerGetSampleRate(mixer), boardGetY8950Oversampling());
+    msxaudio->y8950 = new Y8950(board, "MsxAudio", 256*1024, systemTime);
+    msxaudio->y8950->setSampleRate(mixerGetSampleRate(mixer), boardGetY8950Oversampling(msxaudio->board));
 	msxaudio->y8950->setVolume(32767);
 
-    ioPortRegister(0xc0, (IoPortRead)msxaudioRead, (IoPortWrite)msxaudioWrite, msxaudio);
-    ioPortRegister(0xc1, (IoPortRead)msxaudioRead, (IoPortWrite)msxaudioWrite, msxaudio);
+    ioPortRegister(msxaudio->board, 0xc0, (IoPortRead)msxaudioRead, (IoPortWrite)msxaudioWrite, msxaudio);
+    ioPortRegister(msxaudio->board, 0xc1, (IoPortRead)msxaudioRead, (IoPortWrite)msxaudioWrite, msxaudio);
 
     return 1;
 }
@@ -36,7 +36,7 @@ extern "C" {
 #include "AudioMixer.h"
 
 /* Constructor and destructor */
-int msxaudioCreate(Mixer* mixer);
+int msxaudioCreate(BoardContext* board, Mixer* mixer);
 
 void msxaudioTick(UInt32 elapsedTime);
 void msxaudioTick2();
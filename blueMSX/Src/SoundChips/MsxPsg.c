@@ -49,6 +49,7 @@
 #include <stdlib.h>
 
 struct MsxPsg {
+    BoardContext* board;
     int deviceHandle;
     AY8910* ay8910;
     int currentPort;
@@ -78,12 +79,12 @@ static void joystickPortHandler(MsxPsg* msxPsg, int port, JoystickPortType type)
         break;
 #ifndef EXCLUDE_JOYSTICK_PORT_GUNSTICK
     case JOYSTICK_PORT_GUNSTICK:
-        msxPsg->devFun[port] = msxGunstickCreate();
+        msxPsg->devFun[port] = msxGunstickCreate(msxPsg->board);
         break;
 #endif
 #ifndef EXCLUDE_JOYSTICK_PORT_ASCIILASER
     case JOYSTICK_PORT_ASCIILASER:
-        msxPsg->devFun[port] = msxAsciiLaserCreate();
+        msxPsg->devFun[port] = msxAsciiLaserCreate(msxPsg->board);
         break;
 #endif
 #ifndef EXCLUDE_JOYSTICK_PORT_JOYSTICK
@@ -93,12 +94,12 @@ static void joystickPortHandler(MsxPsg* msxPsg, int port, JoystickPortType type)
 #endif
 #ifndef EXCLUDE_JOYSTICK_PORT_MOUSE
     case JOYSTICK_PORT_MOUSE:
-        msxPsg->devFun[port] = msxMouseCreate();
+        msxPsg->devFun[port] = msxMouseCreate(msxPsg->board);
         break;
 #endif
 #ifndef EXCLUDE_JOYSTICK_PORT_TETRIS2DONGLE
     case JOYSTICK_PORT_TETRIS2DONGLE:
-        msxPsg->devFun[port] = msxTetrisDongleCreate();
+        msxPsg->devFun[port] = msxTetrisDongleCreate(msxPsg->board);
         break;
 #endif
 #ifndef EXCLUDE_JOYSTICK_PORT_MAGICKEYDONGLE
@@ -108,7 +109,7 @@ static void joystickPortHandler(MsxPsg* msxPsg, int port, JoystickPortType type)
 #endif
 #ifndef EXCLUDE_JOYSTICK_PORT_ARKANOID_PAD
     case JOYSTICK_PORT_ARKANOID_PAD:
-        msxPsg->devFun[port] = msxArkanoidPadCreate();
+        msxPsg->devFun[port] = msxArkanoidPadCreate(msxPsg->board);
         break;
 #endif
     }
@@ -142,9 +143,9 @@ static UInt8 read(MsxPsg* msxPsg, UInt16 address)
             msxPsg->devFun[msxPsg->currentPort]->read != NULL) {
             state = msxPsg->devFun[msxPsg->currentPort]->read(msxPsg->devFun[msxPsg->currentPort]);
         }
-        state = boardCaptureUInt8(16 + msxPsg->currentPort, state);
+        state = boardCaptureUInt8(msxPsg->board, 16 + msxPsg->currentPort, state);
         if (renshaSpeed) {
-            state &= ~((((UInt64)renshaSpeed * boardSystemTime() / boardFrequency()) & 1) << 4);
+            state &= ~((((UInt64)renshaSpeed * boardSystemTime(msxPsg->board) / boardFrequency()) & 1) << 4);
         }
         /* pins 6/7 input ANDed with pins 6/7 output */
         state&=((msxPsg->registers[1]>>(msxPsg->currentPort<<1&2)&3)<<4|0xf);
@@ -160,7 +161,7 @@ static UInt8 read(MsxPsg* msxPsg, UInt16 address)
 
 #if 0
         // COmment out until cassette wave is working
-        tapeRead(&casdat);
+        tapeRead(msxPsg->board, &casdat);
         state |= (casdat) ? 0:0x80;
        	dacWrite(msxPsg->dac, DAC_CH_MONO, (casdat) ? 0 : 255);
 #endif
@@ -193,7 +194,7 @@ static void write(MsxPsg* msxPsg, UInt16 address, UInt8 value)
 static void saveState(MsxPsg* msxPsg)
 {
     // dink: fix for certain games where buttons are stuck after reload of state
-    SaveState* state = saveStateOpenForWrite("MsxPsg");
+    SaveState* state = saveStateOpenForWrite(msxPsg->board, "MsxPsg");
     saveStateSet(state, "currentport", msxPsg->currentPort);
     saveStateSet(state, "registers0", msxPsg->registers[0]);
     saveStateSet(state, "registers1", msxPsg->registers[1]);
@@ -212,7 +213,7 @@ static void saveState(MsxPsg* msxPsg)
 static void loadState(MsxPsg* msxPsg)
 {
     // dink: fix for certain games where buttons are stuck after reload of state
-    SaveState* state = saveStateOpenForRead("MsxPsg");
+    SaveState* state = saveStateOpenForRead(msxPsg->board, "MsxPsg");
     msxPsg->currentPort =          saveStateGet(state, "currentport", 0);
     msxPsg->registers[0] = (UInt8) saveStateGet(state, "registers0", 0);
     msxPsg->registers[1] = (UInt8) saveStateGet(state, "registers1", 0);
@@ -250,8 +251,8 @@ static void destroy(MsxPsg* msxPsg)
 {
     ay8910SetIoPort(msxPsg->ay8910, NULL, NULL, NULL, NULL);
     ay8910Destroy(msxPsg->ay8910);
-    joystickPortUpdateHandlerUnregister();
-    deviceManagerUnregister(msxPsg->deviceHandle);
+    joystickPortUpdateHandlerUnregister(msxPsg);
+    deviceManagerUnregister(msxPsg->board, msxPsg->deviceHandle);
     dacDestroy(msxPsg->dac);
     if (msxPsg->devFun[0] != NULL && msxPsg->devFun[0]->destroy != NULL) {
 	    msxPsg->devFun[0]->destroy(msxPsg->devFun[0]);
@@ -268,21 +269,23 @@ void msxPsgRegisterCassetteRead(MsxPsg* msxPsg, CassetteCb cb, void* ref)
     msxPsg->casRef = ref;
 }
 
-MsxPsg* msxPsgCreate(PsgType type, int stereo, int* pan, int maxPorts)
+MsxPsg* msxPsgCreate(BoardContext* board, PsgType type, int stereo, int* pan, int maxPorts)
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     MsxPsg* msxPsg = (MsxPsg*)calloc(1, sizeof(MsxPsg));
 
-    msxPsg->ay8910 = ay8910Create(boardGetMixer(), AY8910_MSX, type, stereo, pan);
+    msxPsg->board = board;
+
+    msxPsg->ay8910 = ay8910Create(board, boardGetMixer(board), AY8910_MSX, type, stereo, pan);
     msxPsg->maxPorts = maxPorts;
 
-    msxPsg->dac = dacCreate(boardGetMixer(), DAC_MONO);
+    msxPsg->dac = dacCreate(boardGetMixer(board), DAC_MONO);
 
     ay8910SetIoPort(msxPsg->ay8910, read, peek, write, msxPsg);
 
     joystickPortUpdateHandlerRegister(joystickPortHandler, msxPsg);
 
-    msxPsg->deviceHandle = deviceManagerRegister(ROM_UNKNOWN, &callbacks, msxPsg);
+    msxPsg->deviceHandle = deviceManagerRegister(board, ROM_UNKNOWN, &callbacks, msxPsg);
 
     return msxPsg;
 }
@@ -10,6 +10,7 @@
 #include "OpenMsxY8950.h"
 
 extern "C" {
+#include "Board.h"
 #include "SaveState.h"
 }
 
@@ -28,7 +29,6 @@ unsigned int Y8950::Slot::dphaseDRTable[16][16];
 unsigned int Y8950::Slot::dphaseTable[1024][8][16];
 
 
-extern "C" UInt32 boardSystemTime();
 extern "C" int switchGetAudio();
 
 //**************************************************//
@@ -429,8 +429,8 @@ void Y8950::callback(byte flag)
 	setStatus(flag);
 }
 
-Y8950::Y8950(const string& name_, int sampleRam, const EmuTime& time)
-	: timer1(this), timer2(this), adpcm(*this, name_, sampleRam), /*connector(),*/
+Y8950::Y8950(BoardContext* board_, const string& name_, int sampleRam, const EmuTime& time)
+	: irq(board_), timer1(this), timer2(this), board(board_), adpcm(board_, *this, name_, sampleRam), /*connector(),*/
           name(name_)
 {
 	makePmTable();
@@ -1217,7 +1217,7 @@ byte Y8950::read(unsigned address)
 
 void Y8950::write(unsigned address, byte value)
 {
-	writeReg(address, value, boardSystemTime());
+	writeReg(address, value, boardSystemTime(board));
 }
 
 
@@ -1228,7 +1228,7 @@ void Y8950::pushTime(const EmuTime &time)
 
 void Y8950::loadState()
 {
-    SaveState* state = saveStateOpenForRead("y8950");
+    SaveState* state = saveStateOpenForRead(board, "y8950");
 
     saveStateClose(state);
 
@@ -1237,7 +1237,7 @@ void Y8950::loadState()
 
 void Y8950::saveState()
 {
-    SaveState* state = saveStateOpenForWrite("y8950");
+    SaveState* state = saveStateOpenForWrite(board, "y8950");
 
     saveStateClose(state);
 
@@ -44,13 +44,16 @@ class MsxAudioTimer
 class MsxAudioIRQHelper 
 {
 public:
-    MsxAudioIRQHelper() {}
-    static void set() {
-        boardSetInt(0x10);
+    MsxAudioIRQHelper(BoardContext* board_) : board(board_) {}
+    void set() {
+        boardSetInt(board, 0x10);
     }
-    static void reset() {
-        boardClearInt(0x10);
+    void reset() {
+        boardClearInt(board, 0x10);
     }
+
+private:
+    BoardContext* board;
 };
 
 #ifndef OPENMSX_SOUNDDEVICE
@@ -261,7 +264,7 @@ class Y8950 : public SoundDevice, public TimerCallback
 	};
 
 public:
-	Y8950(const string& name, int sampleRam, const EmuTime& time);
+	Y8950(BoardContext* board, const string& name, int sampleRam, const EmuTime& time);
 	virtual ~Y8950();
 
 	void reset(const EmuTime &time);
@@ -406,6 +409,9 @@ private:
 	/** 320us timer. */
 	MsxAudioTimer<3125, STATUS_T2> timer2;
 
+	/** Board the chip belongs to. */
+	BoardContext* board;
+
 	// ADPCM
 	Y8950Adpcm adpcm;
 	friend class Y8950Adpcm;
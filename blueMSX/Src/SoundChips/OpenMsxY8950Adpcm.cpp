@@ -5,6 +5,7 @@
 #include "OpenMsxY8950.h"
 
 extern "C" {
+#include "Board.h"
 #include "SaveState.h"
 }
 
@@ -60,15 +61,12 @@ int Y8950Adpcm::CLAP(int min, int x, int max)
 //                                                          //
 //**********************************************************//
 
-extern "C" UInt32 boardSystemTime();
-
-
-Y8950Adpcm::Y8950Adpcm(Y8950& y8950_, const string& name_, int sampleRam)
-	: y8950(y8950_), name(name_ + " RAM"), ramSize(sampleRam), volume(0)
+Y8950Adpcm::Y8950Adpcm(BoardContext* board_, Y8950& y8950_, const string& name_, int sampleRam)
+	: board(board_), y8950(y8950_), name(name_ + " RAM"), ramSize(sampleRam), volume(0)
 {
 	ramBank = new byte[ramSize];
 	memset(ramBank, 0xFF, ramSize);
-    sysTime = oldTime = boardSystemTime();
+    sysTime = oldTime = boardSystemTime(board);
     unschedule(oldTime);
 
 //	Debugger::instance().registerDebuggable(name, *this);
@@ -383,14 +381,14 @@ void Y8950Adpcm::write(unsigned address, byte value)
 
 void Y8950Adpcm::loadState()
 {
-    SaveState* state = saveStateOpenForRead("y8950adpcm");
+    SaveState* state = saveStateOpenForRead(board, "y8950adpcm");
 
     saveStateClose(state);
 }
 
 void Y8950Adpcm::saveState()
 {
-    SaveState* state = saveStateOpenForWrite("y8950adpcm");
+    SaveState* state = saveStateOpenForWrite(board, "y8950adpcm");
 
     saveStateClose(state);
 }
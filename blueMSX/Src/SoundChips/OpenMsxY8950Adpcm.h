@@ -18,7 +18,7 @@ class Y8950;
 class Y8950Adpcm
 {
 public:
-	Y8950Adpcm(Y8950& y8950, const string& name, int sampleRam);
+	Y8950Adpcm(BoardContext* board, Y8950& y8950, const string& name, int sampleRam);
 	virtual ~Y8950Adpcm();
 	
 	void reset(const EmuTime& time);
@@ -49,6 +49,7 @@ private:
 	int CLAP(int min, int x, int max);
 	void restart();
 
+	BoardContext* board;
 	Y8950& y8950;
 	const string name;
 
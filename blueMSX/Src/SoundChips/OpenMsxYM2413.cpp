@@ -7,6 +7,7 @@
 
 extern "C" {
 #include "SaveState.h"
+#include "ArchThread.h"
 }
 
 #include <stdio.h>
@@ -809,15 +810,11 @@ inline int OpenYM2413::rhythm_calc(bool noise)
 }
 
 
-// generic table initialize
+// generic table initialize, done once for all chips
+static volatile int tablesOnce = 0;
+
 void OpenYM2413::init_tables()
 {
-	static bool alreadyInit = false;
-	if (alreadyInit) {
-		return;
-	}
-	alreadyInit = true;
-	
 	for (int x = 0; x < TL_RES_LEN; x++) {
 		DoubleT m = (1 << 16) / pow(2.0, (x + 1) * (ENV_STEP / 4.0) / 8.0);
 		m = floor(m);
@@ -1338,7 +1335,8 @@ void OpenYM2413::reset(const EmuTime &time)
 }
 
 
-OpenYM2413::OpenYM2413(const string &name, short volume, const EmuTime &time)
+OpenYM2413::OpenYM2413(BoardContext* board, const string &name, short volume, const EmuTime &time)
+	: OpenYM2413Base(board)
 {
 	eg_cnt = eg_timer = 0;
 	rhythm = 0;
@@ -1351,7 +1349,7 @@ OpenYM2413::OpenYM2413(const string &name, short volume, const EmuTime &time)
 	
     oplOversampling = 1;
 
-	init_tables();
+	archThreadOnce(&tablesOnce, init_tables);
 
 	reset(time);
 }
@@ -1440,7 +1438,7 @@ void OpenYM2413::setInternalVolume(short newVolume)
 
 void OpenYM2413::loadState()
 {
-    SaveState* state = saveStateOpenForRead("ym2413");
+    SaveState* state = saveStateOpenForRead(board, "ym2413");
     char tag[32];
     int i;
 
@@ -1594,7 +1592,7 @@ void OpenYM2413::loadState()
 
 void OpenYM2413::saveState()
 {
-    SaveState* state = saveStateOpenForWrite("ym2413");
+    SaveState* state = saveStateOpenForWrite(board, "ym2413");
     char tag[32];
     int i;
 
@@ -49,7 +49,7 @@ class SoundDevice
 class OpenYM2413Base : public SoundDevice
 {
 public:
-    OpenYM2413Base() {}
+    OpenYM2413Base(BoardContext* board_) : board(board_) {}
     virtual ~OpenYM2413Base() {}
 		
 	virtual void reset(const EmuTime &time) = 0;
@@ -61,6 +61,9 @@ public:
 
     virtual void loadState() = 0;
     virtual void saveState() = 0;
+
+protected:
+    BoardContext* board;
 };
 
 #endif
@@ -135,7 +138,7 @@ class Channel
 class OpenYM2413 : public OpenYM2413Base
 {
 	public:
-		OpenYM2413(const string &name, short volume, const EmuTime &time);
+		OpenYM2413(BoardContext* board, const string &name, short volume, const EmuTime &time);
 		virtual ~OpenYM2413();
 		
 		virtual void reset(const EmuTime &time);
@@ -154,7 +157,7 @@ class OpenYM2413 : public OpenYM2413Base
 		void checkMute();
 		bool checkMuteHelper();
 		
-		void init_tables();
+		static void init_tables();
 		
 		inline void advance_lfo();
 		inline void advance();
@@ -7,6 +7,7 @@
 
 extern "C" {
 #include "SaveState.h"
+#include "ArchThread.h"
 }
 
 #ifdef assert
@@ -15,6 +16,7 @@ extern "C" {
 #define assert(x)
 
 #include <stdio.h>
+#include <string.h>
 #include <cmath>
 #include <algorithm>
 
@@ -32,11 +34,6 @@ word OpenYM2413_2::fullsintable[PG_WIDTH];
 word OpenYM2413_2::halfsintable[PG_WIDTH];
 word* OpenYM2413_2::waveform[2] = {fullsintable, halfsintable};
 short OpenYM2413_2::dB2LinTab[(2 * DB_MUTE) * 2];
-unsigned int OpenYM2413_2::dphaseARTable[16][16];
-unsigned int OpenYM2413_2::dphaseDRTable[16][16];
-unsigned int OpenYM2413_2::dphaseTable[512][8][16];
-unsigned int OpenYM2413_2::pm_dphase;
-unsigned int OpenYM2413_2::am_dphase;
 
 
 //***************************************************//
@@ -331,6 +328,7 @@ OpenYM2413_2::Patch::Patch(int n, const byte* data)
 //************************************************************//
 
 OpenYM2413_2::Slot::Slot(bool type)
+	: opll(NULL)
 {
 	reset(type);
 }
@@ -364,7 +362,7 @@ void OpenYM2413_2::Slot::reset(bool type_)
 
 void OpenYM2413_2::Slot::updatePG()
 {
-	dphase = dphaseTable[fnum][block][patches[patchIdx].ML];
+	dphase = opll->dphaseTable[fnum][block][patches[patchIdx].ML];
 }
 
 void OpenYM2413_2::Slot::updateTLL()
@@ -388,25 +386,25 @@ void OpenYM2413_2::Slot::updateEG()
 {
 	switch (eg_mode) {
 	case ATTACK:
-		eg_dphase = dphaseARTable[patches[patchIdx].AR][rks];
+		eg_dphase = opll->dphaseARTable[patches[patchIdx].AR][rks];
 		break;
 	case DECAY:
-		eg_dphase = dphaseDRTable[patches[patchIdx].DR][rks];
+		eg_dphase = opll->dphaseDRTable[patches[patchIdx].DR][rks];
 		break;
 	case SUSTINE:
-		eg_dphase = dphaseDRTable[patches[patchIdx].RR][rks];
+		eg_dphase = opll->dphaseDRTable[patches[patchIdx].RR][rks];
 		break;
 	case RELEASE:
 		if (sustine) {
-			eg_dphase = dphaseDRTable[5][rks];
+			eg_dphase = opll->dphaseDRTable[5][rks];
 		} else if (patches[patchIdx].EG) {
-			eg_dphase = dphaseDRTable[patches[patchIdx].RR][rks];
+			eg_dphase = opll->dphaseDRTable[patches[patchIdx].RR][rks];
 		} else {
-			eg_dphase = dphaseDRTable[7][rks];
+			eg_dphase = opll->dphaseDRTable[7][rks];
 		}
 		break;
 	case SETTLE:
-		eg_dphase = dphaseDRTable[15][0];
+		eg_dphase = opll->dphaseDRTable[15][0];
 		break;
 	case SUSHOLD:
 	case FINISH:
@@ -572,8 +570,22 @@ static byte inst_data[16 + 3][8] = {
 	{ 0x25,0x11,0x00,0x00,0xf8,0xfa,0xf8,0x55 }
 };
 
-OpenYM2413_2::OpenYM2413_2(const string& name_, short volume, const EmuTime& time)
-	: name(name_)
+// Tables that don't depend on the sample rate, built once for all chips
+static volatile int tablesOnce = 0;
+
+void OpenYM2413_2::makeTables()
+{
+	makePmTable();
+	makeAmTable();
+	makeDB2LinTable();
+	makeAdjustTable();
+	makeTllTable();
+	makeRksTable();
+	makeSinTable();
+}
+
+OpenYM2413_2::OpenYM2413_2(BoardContext* board, const string& name_, short volume, const EmuTime& time)
+	: OpenYM2413Base(board), name(name_)
 {
 	for (int i = 0; i < 16 + 3; ++i) {
 		patches[2 * i + 0] = Patch(0, inst_data[i]);
@@ -589,15 +601,17 @@ OpenYM2413_2::OpenYM2413_2(const string& name_, short volume, const EmuTime& tim
 		ch[i].patches = patches;
         ch[i].mod.patches = patches;
         ch[i].car.patches = patches;
+        ch[i].mod.opll = this;
+        ch[i].car.opll = this;
 	}
 
-	makePmTable();
-	makeAmTable();
-	makeDB2LinTable();
-	makeAdjustTable();
-	makeTllTable();
-	makeRksTable();
-	makeSinTable();
+	memset(dphaseTable, 0, sizeof(dphaseTable));
+	memset(dphaseARTable, 0, sizeof(dphaseARTable));
+	memset(dphaseDRTable, 0, sizeof(dphaseDRTable));
+	pm_dphase = 0;
+	am_dphase = 0;
+
+	archThreadOnce(&tablesOnce, makeTables);
 
 	reset(time);
 }
@@ -1241,7 +1255,7 @@ void OpenYM2413_2::write(unsigned address, byte value)
 
 void OpenYM2413_2::loadState()
 {
-    SaveState* state = saveStateOpenForRead("ym2413_2");
+    SaveState* state = saveStateOpenForRead(board, "ym2413_2");
     char tag[32];
     int i;
 
@@ -1440,7 +1454,7 @@ void OpenYM2413_2::loadState()
 
 void OpenYM2413_2::saveState()
 {
-    SaveState* state = saveStateOpenForWrite("ym2413_2");
+    SaveState* state = saveStateOpenForWrite(board, "ym2413_2");
     char tag[32];
     int i;
 
@@ -49,7 +49,7 @@ class SoundDevice
 class OpenYM2413Base : public SoundDevice
 {
 public:
-    OpenYM2413Base() {}
+    OpenYM2413Base(BoardContext* board_) : board(board_) {}
     virtual ~OpenYM2413Base() {}
 		
 	virtual void reset(const EmuTime &time) = 0;
@@ -62,6 +62,9 @@ public:
 
     virtual void loadState() = 0;
     virtual void saveState() = 0;
+
+protected:
+    BoardContext* board;
 };
 
 #endif
@@ -177,6 +180,8 @@ class OpenYM2413_2 : public OpenYM2413Base
 		inline static int wave2_8pi(int e);
 		inline static int EG2DB(int d);
 		inline static int SL2EG(int d);
+
+		OpenYM2413_2* opll;	// Owner, holds the sample rate tables
 	
 		Patch* patches;
         int patchIdx;
@@ -226,7 +231,7 @@ class OpenYM2413_2 : public OpenYM2413Base
 	};
 
 public:
-	OpenYM2413_2(const string& name, short volume, const EmuTime& time);
+	OpenYM2413_2(BoardContext* board, const string& name, short volume, const EmuTime& time);
 	virtual ~OpenYM2413_2();
 
 	virtual void reset(const EmuTime& time);
@@ -249,15 +254,16 @@ private:
 	void checkMute();
 	bool checkMuteHelper();
 
+	static void makeTables();
 	static void makeAdjustTable();
 	static void makeSinTable();
 	static int lin2db(DoubleT d);
 	static void makePmTable();
 	static void makeAmTable();
-	static void makeDphaseTable(int sampleRate);
+	void makeDphaseTable(int sampleRate);
 	static void makeTllTable();
-	static void makeDphaseARTable(int sampleRate);
-	static void makeDphaseDRTable(int sampleRate);
+	void makeDphaseARTable(int sampleRate);
+	void makeDphaseDRTable(int sampleRate);
 	static void makeRksTable();
 	static void makeDB2LinTable();
 	
@@ -330,8 +336,8 @@ private:
 	static int amtable[AM_PG_WIDTH];
 
 	// Noise and LFO
-	static unsigned int pm_dphase;
-	static unsigned int am_dphase;
+	unsigned int pm_dphase;
+	unsigned int am_dphase;
 
 	// Liner to Log curve conversion table (for Attack rate).
 	static word AR_ADJUST_TABLE[1 << EG_BITS];
@@ -340,16 +346,16 @@ private:
 	enum { READY, ATTACK, DECAY, SUSHOLD, SUSTINE, RELEASE, SETTLE, FINISH };
 
     // Phase incr table for Attack
-    static unsigned int dphaseARTable[16][16];
+    unsigned int dphaseARTable[16][16];
     // Phase incr table for Decay and Release
-    static unsigned int dphaseDRTable[16][16];
+    unsigned int dphaseDRTable[16][16];
 
     // KSL + TL Table
     static unsigned int tllTable[16][8][1 << TL_BITS][4];
     static int rksTable[2][8][2];
 
-    // Phase incr table for PG 
-    static unsigned int dphaseTable[512][8][16];
+    // Phase incr table for PG, depends on the sample rate of the chip
+    unsigned int dphaseTable[512][8][16];
 
 	const std::string name;
 
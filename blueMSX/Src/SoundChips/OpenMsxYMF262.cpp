@@ -49,6 +49,7 @@
 
 extern "C" {
 #include "SaveState.h"
+#include "ArchThread.h"
 }
 
 #ifdef _MSC_VER
@@ -392,7 +393,6 @@ const int lfo_pm_table[8 * 8 * 2] =
 };
 
 
-static int* chanOut;
 #define PHASE_MOD1 18
 #define PHASE_MOD2 19
 
@@ -635,7 +635,7 @@ inline int YMF262Slot::volume_calc(byte LFO_AM)
 
 // calculate output of a standard 2 operator channel
 // (or 1st part of a 4-op channel) 
-void YMF262Channel::chan_calc(byte LFO_AM)
+void YMF262Channel::chan_calc(int* chanOut, byte LFO_AM)
 {
     chanOut[PHASE_MOD1] = 0;
     chanOut[PHASE_MOD2] = 0;
@@ -663,7 +663,7 @@ void YMF262Channel::chan_calc(byte LFO_AM)
 }
 
 // calculate output of a 2nd part of 4-op channel 
-void YMF262Channel::chan_calc_ext(byte LFO_AM)
+void YMF262Channel::chan_calc_ext(int* chanOut, byte LFO_AM)
 {
 	chanOut[PHASE_MOD1] = 0;
 
@@ -715,6 +715,7 @@ void YMF262Channel::chan_calc_ext(byte LFO_AM)
 // calculate rhythm 
 void YMF262::chan_calc_rhythm(bool noise)
 {
+	int* chanOut = chanout;
 	YMF262Slot& SLOT6_1 = channels[6].slots[SLOT1];
 	YMF262Slot& SLOT6_2 = channels[6].slots[SLOT2];
 	YMF262Slot& SLOT7_1 = channels[7].slots[SLOT1];
@@ -863,15 +864,12 @@ void YMF262::chan_calc_rhythm(bool noise)
 }
 
 
-// generic table initialize 
+// generic table initialize, done once for all chips
+static volatile int tablesOnce = 0;
+
 void YMF262::init_tables(void)
 {
     int i;
-	static bool alreadyInit = false;
-	if (alreadyInit) {
-		return;
-	}
-	alreadyInit = true;
 
 	for (int x = 0; x < TL_RES_LEN; x++) {
 		DoubleT m = (1 << 16) / pow((DoubleT)2, (x + 1) * (ENV_STEP / 4.0) / 8.0);
@@ -1823,21 +1821,21 @@ void YMF262::reset(const EmuTime &time)
 	setInternalMute(true);
 }
 
-YMF262::YMF262(short volume, const EmuTime &time, void* ref)
-	: timer1(this, ref), timer2(this, ref)
+YMF262::YMF262(BoardContext* board_, short volume, const EmuTime &time, void* ref)
+	: irq(board_), timer1(this, ref), timer2(this, ref), board(board_)
 {
-    chanOut = chanout;
-
 	LFO_AM = LFO_PM = 0;
 	lfo_am_depth = lfo_pm_depth_range = lfo_am_cnt = lfo_pm_cnt = 0;
 	noise_rng = noise_p = 0;
 	rhythm = nts = 0;
 	OPL3_mode = false;
 	status = status2 = statusMask = 0;
+	memset(reg, 0, sizeof(reg));
+	memset(chanout, 0, sizeof(chanout));
 	
     oplOversampling = 1;
 
-	init_tables();
+	archThreadOnce(&tablesOnce, init_tables);
 
 	reset(time);
 }
@@ -1903,70 +1901,70 @@ int* YMF262::updateBuffer(int length)
 
 		    // register set #1 
 		    // extended 4op ch#0 part 1 or 2op ch#0 
-		    channels[0].chan_calc(LFO_AM);
+		    channels[0].chan_calc(chanout, LFO_AM);
 		    if (channels[0].extended) {
 			    // extended 4op ch#0 part 2 
-			    channels[3].chan_calc_ext(LFO_AM);
+			    channels[3].chan_calc_ext(chanout, LFO_AM);
 		    } else {
 			    // standard 2op ch#3 
-			    channels[3].chan_calc(LFO_AM);
+			    channels[3].chan_calc(chanout, LFO_AM);
 		    }
 
 		    // extended 4op ch#1 part 1 or 2op ch#1 
-		    channels[1].chan_calc(LFO_AM);
+		    channels[1].chan_calc(chanout, LFO_AM);
 		    if (channels[1].extended) {
 			    // extended 4op ch#1 part 2 
-			    channels[4].chan_calc_ext(LFO_AM);
+			    channels[4].chan_calc_ext(chanout, LFO_AM);
 		    } else {
 			    // standard 2op ch#4 
-			    channels[4].chan_calc(LFO_AM);
+			    channels[4].chan_calc(chanout, LFO_AM);
 		    }
 
 		    // extended 4op ch#2 part 1 or 2op ch#2 
-		    channels[2].chan_calc(LFO_AM);
+		    channels[2].chan_calc(chanout, LFO_AM);
 		    if (channels[2].extended) {
 			    // extended 4op ch#2 part 2 
-			    channels[5].chan_calc_ext(LFO_AM);
+			    channels[5].chan_calc_ext(chanout, LFO_AM);
 		    } else {
 			    // standard 2op ch#5 
-			    channels[5].chan_calc(LFO_AM);
+			    channels[5].chan_calc(chanout, LFO_AM);
 		    }
 
 		    if (!rhythmEnabled) {
-			    channels[6].chan_calc(LFO_AM);
-			    channels[7].chan_calc(LFO_AM);
-			    channels[8].chan_calc(LFO_AM);
+			    channels[6].chan_calc(chanout, LFO_AM);
+			    channels[7].chan_calc(chanout, LFO_AM);
+			    channels[8].chan_calc(chanout, LFO_AM);
 		    } else {
 			    // Rhythm part 
 			    chan_calc_rhythm(noise_rng & 1);
 		    }
 
 		    // register set #2 
-		    channels[9].chan_calc(LFO_AM);
+		    channels[9].chan_calc(chanout, LFO_AM);
 		    if (channels[9].extended) {
-			    channels[12].chan_calc_ext(LFO_AM);
+			    channels[12].chan_calc_ext(chanout, LFO_AM);
 		    } else {
-			    channels[12].chan_calc(LFO_AM);
+			    channels[12].chan_calc(chanout, LFO_AM);
 		    }
 
-		    channels[10].chan_calc(LFO_AM);
+		    channels[10].chan_calc(chanout, LFO_AM);
 		    if (channels[10].extended) {
-			    channels[13].chan_calc_ext(LFO_AM);
+			    channels[13].chan_calc_ext(chanout, LFO_AM);
 		    } else {
-			    channels[13].chan_calc(LFO_AM);
+			    channels[13].chan_calc(chanout, LFO_AM);
 		    }
 
-		    channels[11].chan_calc(LFO_AM);
+		    channels[11].chan_calc(chanout, LFO_AM);
 		    if (channels[11].extended) {
-			    channels[14].chan_calc_ext(LFO_AM);
+			    channels[14].chan_calc_ext(chanout, LFO_AM);
 		    } else {
-			    channels[14].chan_calc(LFO_AM);
+			    channels[14].chan_calc(chanout, LFO_AM);
 		    }
 
 		    // channels 15,16,17 are fixed 2-operator channels only 
-		    channels[15].chan_calc(LFO_AM);
-		    channels[16].chan_calc(LFO_AM);
-		    channels[17].chan_calc(LFO_AM);
+		    channels[15].chan_calc(chanout, LFO_AM);
+		    channels[16].chan_calc(chanout, LFO_AM);
+		    channels[17].chan_calc(chanout, LFO_AM);
 
 		    for (int i = 0; i < 18; i++) {
 			    a += chanout[i] & pan[4 * i + 0];
@@ -1992,7 +1990,7 @@ void YMF262::setInternalVolume(short newVolume)
 
 void YMF262::loadState()
 {
-    SaveState* state = saveStateOpenForRead("ymf262");
+    SaveState* state = saveStateOpenForRead(board, "ymf262");
     char tag[32];
     int i;
     
@@ -2167,7 +2165,7 @@ void YMF262::loadState()
 
 void YMF262::saveState()
 {
-    SaveState* state = saveStateOpenForWrite("ymf262");
+    SaveState* state = saveStateOpenForWrite(board, "ymf262");
     char tag[32];
     int i;
     
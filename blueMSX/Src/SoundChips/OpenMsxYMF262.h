@@ -55,13 +55,16 @@ class Timer
 class IRQHelper 
 {
 public:
-    IRQHelper() {}
-    static void set() {
-        boardSetInt(0x8);
+    IRQHelper(BoardContext* board_) : board(board_) {}
+    void set() {
+        boardSetInt(board, 0x8);
     }
-    static void reset() {
-        boardClearInt(0x8);
+    void reset() {
+        boardClearInt(board, 0x8);
     }
+
+private:
+    BoardContext* board;
 };
 
 #ifndef OPENMSX_SOUNDDEVICE
@@ -147,8 +150,9 @@ class YMF262Channel
 {
 	public:
 		YMF262Channel();
-		void chan_calc(byte LFO_AM);
-		void chan_calc_ext(byte LFO_AM);
+		// chanOut is the channel output of the chip
+		void chan_calc(int* chanOut, byte LFO_AM);
+		void chan_calc_ext(int* chanOut, byte LFO_AM);
 		void CALC_FCSLOT(YMF262Slot &slot);
 
 		YMF262Slot slots[2];
@@ -183,7 +187,7 @@ static const int STATUS_T1      = R04_MASK_T1;
 class YMF262 : public SoundDevice, public TimerCallback
 {
 	public:
-		YMF262(short volume, const EmuTime &time, void* ref);
+		YMF262(BoardContext* board, short volume, const EmuTime &time, void* ref);
 		virtual ~YMF262();
 		
 		virtual void reset(const EmuTime &time);
@@ -204,7 +208,7 @@ class YMF262 : public SoundDevice, public TimerCallback
 
 	private:
 		void writeRegForce(int r, byte v, const EmuTime &time);
-		void init_tables(void);
+		static void init_tables(void);
 		void setStatus(byte flag);
 		void resetStatus(byte flag);
 		void changeStatusMask(byte flag);
@@ -263,6 +267,8 @@ class YMF262 : public SoundDevice, public TimerCallback
 
 		int chanout[20];		// 18 channels + two phase modulation
 		short maxVolume;
+
+		BoardContext* board;
 };
 
 #endif
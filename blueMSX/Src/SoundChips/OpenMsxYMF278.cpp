@@ -153,6 +153,9 @@ const int am_depth[8] = {
 
 YMF278Slot::YMF278Slot()
 {
+	env_vol_step = env_vol_lim = 0;
+	pos = 0;
+	sample1 = sample2 = 0;
 	reset();
 }
 
@@ -767,8 +770,9 @@ byte YMF278::readStatus(const EmuTime &time)
 	return result;
 }
 
-YMF278::YMF278(short volume, int ramSize, void* romData, int romSize,
+YMF278::YMF278(BoardContext* board_, short volume, int ramSize, void* romData, int romSize,
                const EmuTime &time)
+	: board(board_)
 {
     LD_Time = 0;
     BUSY_Time = 0;
@@ -857,7 +861,7 @@ void YMF278::writeMem(unsigned int address, byte value)
 //REMEMBER TO SAVE RAM
 void YMF278::loadState()
 {
-    SaveState* state = saveStateOpenForRead("ymf278");
+    SaveState* state = saveStateOpenForRead(board, "ymf278");
 
     ramSize           = saveStateGet(state, "ramSize",           0);
     eg_cnt            = saveStateGet(state, "eg_cnt",            0);
@@ -994,7 +998,7 @@ void YMF278::loadState()
 
 void YMF278::saveState()
 {
-    SaveState* state = saveStateOpenForWrite("ymf278");
+    SaveState* state = saveStateOpenForWrite(board, "ymf278");
 
     saveStateSet(state, "ramSize",           ramSize);
     saveStateSet(state, "eg_cnt",            eg_cnt);
@@ -101,7 +101,7 @@ static const int MASTER_CLK = 33868800;
 class YMF278 : public SoundDevice
 {
 	public:
-		YMF278(short volume, int ramSize, void* romData, int romSize,
+		YMF278(BoardContext* board, short volume, int ramSize, void* romData, int romSize,
 		       const EmuTime &time);
 		virtual ~YMF278();
 		void reset(const EmuTime &time);
@@ -164,6 +164,8 @@ class YMF278 : public SoundDevice
 
 		unsigned long LD_Time;
 		unsigned long BUSY_Time;
+
+		BoardContext* board;
 };
 
 #endif
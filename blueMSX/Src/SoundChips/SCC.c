@@ -47,6 +47,7 @@ static Int32* sccSync(SCC* scc, UInt32 count);
 
 struct SCC
 {
+    BoardContext* board;
     Mixer* mixer;
     Int32  handle;
     Int32  debugHandle;
@@ -77,7 +78,7 @@ struct SCC
 
 void sccLoadState(SCC* scc)
 {
-    SaveState* state = saveStateOpenForRead("scc");
+    SaveState* state = saveStateOpenForRead(scc->board, "scc");
     char tag[32];
     int i;
 
@@ -124,7 +125,7 @@ void sccLoadState(SCC* scc)
 
 void sccSaveState(SCC* scc)
 {
-    SaveState* state = saveStateOpenForWrite("scc");
+    SaveState* state = saveStateOpenForWrite(scc->board, "scc");
     char tag[32];
     int i;
 
@@ -373,11 +374,12 @@ static void getDebugInfo(SCC* scc, DbgDevice* dbgDevice)
     dbgDeviceAddMemoryBlock(dbgDevice, langDbgMemScc(), 1, 0, 0x100, ram);
 }
 
-SCC* sccCreate(Mixer* mixer)
+SCC* sccCreate(BoardContext* board, Mixer* mixer)
 {
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     SCC* scc = (SCC*)calloc(1, sizeof(SCC));
 
+    scc->board = board;
     scc->mixer = mixer;
 
 //    scc->debugHandle = debugDeviceRegister(DBGTYPE_AUDIO, langDbgDevScc(), &dbgCallbacks, scc);
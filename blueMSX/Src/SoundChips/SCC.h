@@ -40,7 +40,7 @@ typedef struct SCC SCC;
 typedef enum { SCC_NONE = 0, SCC_REAL, SCC_COMPATIBLE, SCC_PLUS } SccMode;
 
 /* Constructor and destructor */
-SCC* sccCreate(Mixer* mixer);
+SCC* sccCreate(BoardContext* board, Mixer* mixer);
 void sccDestroy(SCC* scc);
 void sccReset(SCC* scc);
 void sccSetMode(SCC* scc, SccMode newMode);
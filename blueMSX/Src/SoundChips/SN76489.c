@@ -65,6 +65,7 @@ static int VoltTables[2][16] =
 
 struct SN76489 {
     /* Framework params */
+    BoardContext* board;
     Mixer* mixer;
     Int32  handle;
     Int32  debugHandle;
@@ -101,7 +102,7 @@ static Int32* sn76489Sync(void* ref, UInt32 count);
 
 void sn76489LoadState(SN76489* sn76489)
 {
-    SaveState* state = saveStateOpenForRead("sn76489");
+    SaveState* state = saveStateOpenForRead(sn76489->board, "sn76489");
     char tag[32];
     int i;
     
@@ -124,14 +125,21 @@ void sn76489LoadState(SN76489* sn76489)
 
         sprintf(tag, "toneFlipFlop%d", i);
         sn76489->toneFlipFlop[i] = saveStateGet(state, tag, 0);
+
+        sn76489->toneInterpol[i] = 0;
     }
 
+    // Older states don't have the sample position, it starts over then
+    sn76489->clock = 0;
+    saveStateGetBuffer(state, "clock",        &sn76489->clock,       sizeof(sn76489->clock));
+    saveStateGetBuffer(state, "toneInterpol", sn76489->toneInterpol, sizeof(sn76489->toneInterpol));
+
     saveStateClose(state);
 }
 
 void sn76489SaveState(SN76489* sn76489)
 {
-    SaveState* state = saveStateOpenForWrite("sn76489");
+    SaveState* state = saveStateOpenForWrite(sn76489->board, "sn76489");
     char tag[32];
     int i;
 
@@ -154,11 +162,10 @@ void sn76489SaveState(SN76489* sn76489)
 
         sprintf(tag, "toneFlipFlop%d", i);
         saveStateSet(state, tag, sn76489->toneFlipFlop[i]);
-        
-        sn76489->toneInterpol[i] = 0;
     }
 
-    sn76489->clock = 0;
+    saveStateSetBuffer(state, "clock",        &sn76489->clock,       sizeof(sn76489->clock));
+    saveStateSetBuffer(state, "toneInterpol", sn76489->toneInterpol, sizeof(sn76489->toneInterpol));
 
     saveStateClose(state);
 }
@@ -191,7 +198,7 @@ static void getDebugInfo(SN76489* sn76489, DbgDevice* dbgDevice)
 
 void sn76489Destroy(SN76489* sn76489)
 {
-    debugDeviceUnregister(sn76489->debugHandle);
+    debugDeviceUnregister(sn76489->board, sn76489->debugHandle);
     mixerUnregisterChannel(sn76489->mixer, sn76489->handle);
     free(sn76489);
 }
@@ -216,15 +223,17 @@ void sn76489Reset(SN76489* sn76489)
     p->shiftReg = 1 << (sn76489->shiftRegisterWidth - 1);
 }
 
-SN76489* sn76489Create(Mixer* mixer)
+SN76489* sn76489Create(BoardContext* board, Mixer* mixer)
 {
     DebugCallbacks dbgCallbacks = { getDebugInfo, NULL, NULL, NULL };
     SN76489* sn76489 = (SN76489*)calloc(1, sizeof(SN76489));
 
+    sn76489->board = board;
+
     sn76489->mixer = mixer;
 
     sn76489->handle = mixerRegisterChannel(mixer, MIXER_CHANNEL_PSG, 0, sn76489Sync, NULL, sn76489);
-    sn76489->debugHandle = debugDeviceRegister(DBGTYPE_AUDIO, "SN76489 PSG", &dbgCallbacks, sn76489);
+    sn76489->debugHandle = debugDeviceRegister(board, DBGTYPE_AUDIO, "SN76489 PSG", &dbgCallbacks, sn76489);
 
 
     sn76489->voltTableIdx       = VOL_FULL;
@@ -386,6 +395,7 @@ static Int32* sn76489Sync(void* ref, UInt32 count);
 
 
 struct SN76489 {
+    BoardContext* board;
     Mixer* mixer;
     Int32  handle;
     Int32  debugHandle;
@@ -407,7 +417,7 @@ struct SN76489 {
 
 void sn76489LoadState(SN76489* sn76489)
 {
-    SaveState* state = saveStateOpenForRead("sn76489");
+    SaveState* state = saveStateOpenForRead(sn76489->board, "sn76489");
     char tag[32];
     int i;
 
@@ -435,7 +445,7 @@ void sn76489LoadState(SN76489* sn76489)
 
 void sn76489SaveState(SN76489* sn76489)
 {
-    SaveState* state = saveStateOpenForWrite("sn76489");
+    SaveState* state = saveStateOpenForWrite(sn76489->board, "sn76489");
     char tag[32];
     int i;
 
@@ -475,11 +485,13 @@ static void setDebugInfo(SN76489* sn76489, DbgDevice* dbgDevice)
     }
 }
 
-SN76489* sn76489Create(Mixer* mixer)
+SN76489* sn76489Create(BoardContext* board, Mixer* mixer)
 {
     SN76489* sn76489 = (SN76489*)calloc(1, sizeof(SN76489));
     int i;
 
+    sn76489->board = board;
+
     sn76489->mixer = mixer;
 
     sn76489->handle = mixerRegisterChannel(mixer, MIXER_CHANNEL_PSG, 0, sn76489Sync, sn76489);
@@ -515,13 +527,11 @@ void sn76489Reset(SN76489* sn76489)
 
 void sn76489Destroy(SN76489* sn76489)
 {
-    debugDeviceUnregister(sn76489->debugHandle);
+    debugDeviceUnregister(sn76489->board, sn76489->debugHandle);
     mixerUnregisterChannel(sn76489->mixer, sn76489->handle);
     free(sn76489);
 }
 
-extern int framecounter;
-
 void sn76489WriteData(SN76489* sn76489, UInt16 ioPort, UInt8 data)
 {
     UInt32 period;
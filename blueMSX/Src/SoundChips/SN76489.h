@@ -35,7 +35,7 @@
 typedef struct SN76489 SN76489;
 
 /* Constructor and destructor */
-SN76489* sn76489Create(Mixer* mixer);
+SN76489* sn76489Create(BoardContext* board, Mixer* mixer);
 void sn76489Destroy(SN76489* sn76489);
 
 /* Reset chip */
@@ -38,6 +38,7 @@
 #define FREQINCR         (FREQUENCY / 440)
 
 struct VLM5030 {
+    BoardContext* board;
     Mixer* mixer;
     Int32  handle;
     
@@ -46,24 +47,24 @@ struct VLM5030 {
     Int32 sampleVolume;
     Int32 oldSampleVolume;
     Int32 ctrlVolume;
+
+    struct vlm5030_info* chip;
     
     Int32  buffer[AUDIO_MONO_BUFFER_SIZE];
 };
 
-static VLM5030* theVlm5030 = NULL;
-
-void stream_update(void* dummy1, int idx)
+void stream_update(void* ref, int idx)
 {
-    if (theVlm5030 != NULL) {
-        mixerSync(theVlm5030->mixer);
-    }
+    VLM5030* vlm5030 = (VLM5030*)ref;
+
+    mixerSync(vlm5030->mixer);
 }
 
 UInt8 vlm5030Peek(VLM5030* vlm5030, UInt16 ioPort)
 {
     switch (ioPort & 1) {
     case 0:
-        return VLM5030_BSY() ? 0x10 : 0;
+        return VLM5030_BSY(vlm5030->chip) ? 0x10 : 0;
     case 1:
         break;
     }
@@ -74,7 +75,7 @@ UInt8 vlm5030Read(VLM5030* vlm5030, UInt16 ioPort)
 {
     switch (ioPort & 1) {
     case 0:
-        return VLM5030_BSY() ? 0x10 : 0;
+        return VLM5030_BSY(vlm5030->chip) ? 0x10 : 0;
     case 1:
         break;
     }
@@ -86,13 +87,13 @@ void vlm5030Write(VLM5030* vlm5030, UInt16 ioPort, UInt8 value)
     switch (ioPort & 1) {
     case 0:
         mixerSync(vlm5030->mixer);
-        VLM5030_data_w(0, value);
+        VLM5030_data_w(vlm5030->chip, 0, value);
         break;
     case 1:
         mixerSync(vlm5030->mixer);
-	    VLM5030_RST((value & 0x01) ? 1 : 0 );
-	    VLM5030_VCU((value & 0x04) ? 1 : 0 );
-	    VLM5030_ST( (value & 0x02) ? 1 : 0 );
+	    VLM5030_RST(vlm5030->chip, (value & 0x01) ? 1 : 0 );
+	    VLM5030_VCU(vlm5030->chip, (value & 0x04) ? 1 : 0 );
+	    VLM5030_ST(vlm5030->chip, (value & 0x02) ? 1 : 0 );
         break;
     }
 }
@@ -104,7 +105,7 @@ static Int32* vlm5030Sync(VLM5030* vlm5030, UInt32 count)
     for (i = 0; i < count; i++) {
         vlm5030->timer += FREQINCR;
         if (vlm5030->timer >= 44100) {
-            vlm5030_update_callback(&vlm5030->sampleVolume, 1);
+            vlm5030_update_callback(vlm5030->chip, &vlm5030->sampleVolume, 1);
             vlm5030->sampleVolume *= 10;
             vlm5030->timer -= 44100;
         }
@@ -124,7 +125,7 @@ static Int32* vlm5030Sync(VLM5030* vlm5030, UInt32 count)
 
 void vlm5030SaveState(VLM5030* vlm5030)
 {
-    SaveState* state = saveStateOpenForWrite("vlm5030");
+    SaveState* state = saveStateOpenForWrite(vlm5030->board, "vlm5030");
     
     saveStateSet(state, "timer",           vlm5030->timer);
     saveStateSet(state, "ctrlVolume",      vlm5030->ctrlVolume);
@@ -137,7 +138,7 @@ void vlm5030SaveState(VLM5030* vlm5030)
 
 void vlm5030LoadState(VLM5030* vlm5030)
 {
-    SaveState* state = saveStateOpenForRead("vlm5030");
+    SaveState* state = saveStateOpenForRead(vlm5030->board, "vlm5030");
     
     vlm5030->timer            = saveStateGet(state, "timer",           0);
     vlm5030->ctrlVolume       = saveStateGet(state, "ctrlVolume",      0);
@@ -152,30 +153,29 @@ void vlm5030Destroy(VLM5030* vlm5030)
 {
     mixerUnregisterChannel(vlm5030->mixer, vlm5030->handle);
 
-    theVlm5030 = NULL;
+    vlm5030_stop(vlm5030->chip);
 
     free(vlm5030);
 }
 
 void vlm5030Reset(VLM5030* vlm5030)
 {
-    VLM5030_RST(0);
+    VLM5030_RST(vlm5030->chip, 0);
 }
 
-VLM5030* vlm5030Create(Mixer* mixer, UInt8* voiceData, int length)
+VLM5030* vlm5030Create(BoardContext* board, Mixer* mixer, UInt8* voiceData, int length)
 {
     VLM5030* vlm5030;
     
     vlm5030 = (VLM5030*)calloc(1, sizeof(VLM5030));
 
+    vlm5030->board = board;
     vlm5030->mixer = mixer;
 
-    vlm5030->handle = mixerRegisterChannel(mixer, MIXER_CHANNEL_PCM, 0, vlm5030Sync, NULL, vlm5030);
-
-    vlm5030_start(FREQUENCY);
-    VLM5030_set_rom(voiceData, length);
+    vlm5030->chip = vlm5030_start(board, FREQUENCY, vlm5030);
+    VLM5030_set_rom(vlm5030->chip, voiceData, length);
 
-    theVlm5030 = vlm5030;
+    vlm5030->handle = mixerRegisterChannel(mixer, MIXER_CHANNEL_PCM, 0, vlm5030Sync, NULL, vlm5030);
 
     return vlm5030;
 }
@@ -35,7 +35,7 @@
 typedef struct VLM5030 VLM5030;
 
 /* Constructor and destructor */
-VLM5030* vlm5030Create(Mixer* mixer, UInt8* voiceData, int length);
+VLM5030* vlm5030Create(BoardContext* board, Mixer* mixer, UInt8* voiceData, int length);
 void vlm5030Destroy(VLM5030* vlm5030);
 void vlm5030Reset(VLM5030* vlm5030);
 void vlm5030LoadState(VLM5030* vlm5030);
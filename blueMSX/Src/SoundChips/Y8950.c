@@ -43,6 +43,7 @@
 
 
 struct Y8950 {
+    BoardContext* board;
     Mixer* mixer;
     Int32  handle;
     UInt32 rate;
@@ -65,11 +66,6 @@ struct Y8950 {
     Int32  buffer[AUDIO_MONO_BUFFER_SIZE];
 };
 
-extern INT32 outd;
-extern INT32 ams;
-extern INT32 vib;
-extern INT32 feedback2;
-
 void y8950TimerStart(void* ptr, int timer, int start);
 
 static void onTimeout1(void* ptr, UInt32 time)
@@ -99,7 +95,7 @@ void y8950TimerStart(void* ptr, int timer, int start)
     if (timer == 0) {
         if (start != 0) {
             if (!y8950->timerRunning1) {
-                UInt32 systemTime = boardSystemTime();
+                UInt32 systemTime = boardSystemTime(y8950->board);
                 UInt32 adjust = systemTime % TIMER_FREQUENCY;
                 y8950->timeout1 = systemTime + TIMER_FREQUENCY * y8950->timerValue1 - adjust;
                 boardTimerAdd(y8950->timer1, y8950->timeout1);
@@ -116,7 +112,7 @@ void y8950TimerStart(void* ptr, int timer, int start)
     else {
         if (start != 0) {
             if (!y8950->timerRunning2) {
-                UInt32 systemTime = boardSystemTime();
+                UInt32 systemTime = boardSystemTime(y8950->board);
                 UInt32 adjust = systemTime % (4 * TIMER_FREQUENCY);
                 y8950->timeout2 = systemTime + TIMER_FREQUENCY * y8950->timerValue2 - adjust;
                 boardTimerAdd(y8950->timer2, y8950->timeout2);
@@ -197,9 +193,8 @@ void y8950Write(Y8950* y8950, UInt16 ioPort, UInt8 value)
         break;
     }
 }
-static char* regText(int d)
+static char* regText(char* text, int d)
 {
-    static char text[5];
     sprintf(text, "R%.2x", d);
     return text;
 }
@@ -218,6 +213,7 @@ static char regsAvailAY8950[] = {
 void y8950GetDebugInfo(Y8950* y8950, DbgDevice* dbgDevice)
 {
     DbgRegisterBank* regBank;
+    char text[8];
 
     // Add YM2413 registers
     int c = 1;
@@ -235,7 +231,7 @@ void y8950GetDebugInfo(Y8950* y8950, DbgDevice* dbgDevice)
 
     for (r = 0; r < sizeof(regsAvailAY8950); r++) {
         if (regsAvailAY8950[r]) {
-            dbgRegisterBankAddRegister(regBank, c++, regText(r), 8, y8950->opl->regs[r]);
+            dbgRegisterBankAddRegister(regBank, c++, regText(text, r), 8, y8950->opl->regs[r]);
         }
     }
 
@@ -271,7 +267,7 @@ static Int32* y8950Sync(void* ref, UInt32 count)
 
 void y8950SaveState(Y8950* y8950)
 {
-    SaveState* state = saveStateOpenForWrite("msxaudio1");
+    SaveState* state = saveStateOpenForWrite(y8950->board, "msxaudio1");
 
     saveStateSet(state, "address",       y8950->address);
     saveStateSet(state, "timerValue1",   y8950->timerValue1);
@@ -280,20 +276,20 @@ void y8950SaveState(Y8950* y8950)
     saveStateSet(state, "timerValue2",   y8950->timerValue2);
     saveStateSet(state, "timerRunning2", y8950->timerRunning2);
     saveStateSet(state, "timeout2",      y8950->timeout2);
-    saveStateSet(state, "outd",          outd);
-    saveStateSet(state, "ams",           ams);
-    saveStateSet(state, "vib",           vib);
-    saveStateSet(state, "feedback2",     feedback2);
+    saveStateSet(state, "outd",          y8950->opl->outd);
+    saveStateSet(state, "ams",           y8950->opl->ams);
+    saveStateSet(state, "vib",           y8950->opl->vib);
+    saveStateSet(state, "feedback2",     y8950->opl->feedback2);
 
     saveStateClose(state);
 
     Y8950SaveState(y8950->opl);
-    YM_DELTAT_ADPCM_SaveState(y8950->opl->deltat);
+    YM_DELTAT_ADPCM_SaveState(y8950->board, y8950->opl->deltat);
 }
 
 void y8950LoadState(Y8950* y8950)
 {
-    SaveState* state = saveStateOpenForRead("msxaudio1");
+    SaveState* state = saveStateOpenForRead(y8950->board, "msxaudio1");
 
     y8950->address       = (UInt8)saveStateGet(state, "address",       0);
     y8950->timerValue1   =        saveStateGet(state, "timerValue1",   0);
@@ -303,15 +299,15 @@ void y8950LoadState(Y8950* y8950)
     y8950->timerRunning2 =        saveStateGet(state, "timerRunning2", 0);
     y8950->timeout2      =        saveStateGet(state, "timeout2",      0);
 
-    outd      = saveStateGet(state, "outd",      0);
-    ams       = saveStateGet(state, "ams",       0);
-    vib       = saveStateGet(state, "vib",       0);
-    feedback2 = saveStateGet(state, "feedback2", 0);
+    y8950->opl->outd      = saveStateGet(state, "outd",      0);
+    y8950->opl->ams       = saveStateGet(state, "ams",       0);
+    y8950->opl->vib       = saveStateGet(state, "vib",       0);
+    y8950->opl->feedback2 = saveStateGet(state, "feedback2", 0);
 
     saveStateClose(state);
 
     Y8950LoadState(y8950->opl);
-    YM_DELTAT_ADPCM_LoadState(y8950->opl->deltat);
+    YM_DELTAT_ADPCM_LoadState(y8950->board, y8950->opl->deltat);
 
     if (y8950->timerRunning1) {
         boardTimerAdd(y8950->timer1, y8950->timeout1);
@@ -352,25 +348,26 @@ void y8950SetSampleRate(void* ref, UInt32 rate)
     y8950->rate = rate;
 }
 
-Y8950* y8950Create(Mixer* mixer)
+Y8950* y8950Create(BoardContext* board, Mixer* mixer)
 {
     Y8950* y8950;
     
     y8950 = (Y8950*)calloc(1, sizeof(Y8950));
+    y8950->board = board;
 
     y8950->mixer = mixer;
     y8950->timerRunning1 = 0;
     y8950->timerRunning2 = 0;
 
-    y8950->timer1 = boardTimerCreate(onTimeout1, y8950);
-    y8950->timer2 = boardTimerCreate(onTimeout2, y8950);
+    y8950->timer1 = boardTimerCreate(board, onTimeout1, y8950);
+    y8950->timer2 = boardTimerCreate(board, onTimeout2, y8950);
     
     y8950->ykIo = ykIoCreate();
 
     y8950->handle = mixerRegisterChannel(mixer, MIXER_CHANNEL_MSXAUDIO, 0, y8950Sync, y8950SetSampleRate, y8950);
 
-    y8950->opl = OPLCreate(OPL_TYPE_Y8950, FREQUENCY, SAMPLERATE, 256, y8950);
-    OPLSetOversampling(y8950->opl, boardGetY8950Oversampling());
+    y8950->opl = OPLCreate(board, OPL_TYPE_Y8950, FREQUENCY, SAMPLERATE, 256, y8950);
+    OPLSetOversampling(y8950->opl, boardGetY8950Oversampling(board));
     OPLResetChip(y8950->opl);
 
 	y8950->rate = mixerGetSampleRate(mixer);
@@ -36,7 +36,7 @@
 typedef struct Y8950 Y8950;
 
 /* Constructor and destructor */
-Y8950* y8950Create(Mixer* mixer);
+Y8950* y8950Create(BoardContext* board, Mixer* mixer);
 void y8950Destroy(Y8950* y8950);
 void y8950Reset(Y8950* y8950);
 void y8950LoadState(Y8950* y8950);
@@ -42,12 +42,12 @@ extern "C" {
 #define FREQUENCY        3579545
  
 struct YM_2413 {
-    YM_2413() : address(0) {
+    YM_2413(BoardContext* board_) : board(board_), address(0) {
         if (0) {
-             ym2413 = new OpenYM2413("ym2413", 100, 0);
+             ym2413 = new OpenYM2413(board, "ym2413", 100, 0);
         }
         else {
-             ym2413 = new OpenYM2413_2("ym2413", 100, 0);
+             ym2413 = new OpenYM2413_2(board, "ym2413", 100, 0);
         }
         memset(defaultBuffer, 0, sizeof(defaultBuffer));
     }
@@ -56,6 +56,7 @@ struct YM_2413 {
         delete ym2413;
     }
 
+    BoardContext* board;
     Mixer* mixer;
     Int32  handle;
 
@@ -71,7 +72,7 @@ extern "C" {
 void ym2413SaveState(YM_2413* ref)
 {
     YM_2413* ym2413 = (YM_2413*)ref;
-    SaveState* state = saveStateOpenForWrite("msxmusic");
+    SaveState* state = saveStateOpenForWrite(ym2413->board, "msxmusic");
 
     saveStateSetBuffer(state, "regs", ym2413->registers, 256);
 
@@ -83,7 +84,7 @@ void ym2413SaveState(YM_2413* ref)
 void ym2413LoadState(YM_2413* ref)
 {
     YM_2413* ym2413 = (YM_2413*)ref;
-    SaveState* state = saveStateOpenForRead("msxmusic");
+    SaveState* state = saveStateOpenForRead(ym2413->board, "msxmusic");
 
     saveStateGetBuffer(state, "regs", ym2413->registers, 256);
 
@@ -96,7 +97,7 @@ void ym2413Reset(YM_2413* ref)
 {
     YM_2413* ym2413 = (YM_2413*)ref;
 
-    ym2413->ym2413->reset(boardSystemTime());
+    ym2413->ym2413->reset(boardSystemTime(ym2413->board));
 }
 
 void ym2413WriteAddress(YM_2413* ym2413, UInt8 address)
@@ -106,7 +107,7 @@ void ym2413WriteAddress(YM_2413* ym2413, UInt8 address)
 
 void ym2413WriteData(YM_2413* ym2413, UInt8 data)
 {
-    UInt32 systemTime = boardSystemTime();
+    UInt32 systemTime = boardSystemTime(ym2413->board);
     mixerSync(ym2413->mixer);
     ym2413->registers[ym2413->address & 0xff] = data;
     ym2413->ym2413->writeReg(ym2413->address, data, systemTime);
@@ -131,9 +132,8 @@ static Int32* ym2413Sync(void* ref, UInt32 count)
     return ym2413->buffer;
 }
 
-static char* regText(int d)
+static char* regText(char* text, int d)
 {
-    static char text[5];
     sprintf(text, "R%.2x", d);
     return text;
 }
@@ -146,6 +146,7 @@ static char regsAvailYM2413[] = {
 void ym2413GetDebugInfo(YM_2413* ym2413, DbgDevice* dbgDevice)
 {
     DbgRegisterBank* regBank;
+    char text[8];
 
     // Add YM2413 registers
     int c = 0;
@@ -158,7 +159,7 @@ void ym2413GetDebugInfo(YM_2413* ym2413, DbgDevice* dbgDevice)
     c = 0;
     for (int r = 0; r < sizeof(regsAvailYM2413); r++) {
         if (regsAvailYM2413[r]) {
-            dbgRegisterBankAddRegister(regBank, c++, regText(r), 8, ym2413->ym2413->peekReg(r));
+            dbgRegisterBankAddRegister(regBank, c++, regText(text, r), 8, ym2413->ym2413->peekReg(r));
         }
     }
 }
@@ -166,20 +167,20 @@ void ym2413GetDebugInfo(YM_2413* ym2413, DbgDevice* dbgDevice)
 void ym2413SetSampleRate(void* ref, UInt32 rate)
 {
     YM_2413* ym2413 = (YM_2413*)ref;
-    ym2413->ym2413->setSampleRate(rate, boardGetYm2413Oversampling());
+    ym2413->ym2413->setSampleRate(rate, boardGetYm2413Oversampling(ym2413->board));
 }
 
-YM_2413* ym2413Create(Mixer* mixer)
+YM_2413* ym2413Create(BoardContext* board, Mixer* mixer)
 {
     YM_2413* ym2413;
 
-    ym2413 = new YM_2413;
+    ym2413 = new YM_2413(board);
 
     ym2413->mixer = mixer;
 
     ym2413->handle = mixerRegisterChannel(mixer, MIXER_CHANNEL_MSXMUSIC, 0, ym2413Sync, ym2413SetSampleRate, ym2413);
 
-    ym2413->ym2413->setSampleRate(mixerGetSampleRate(mixer), boardGetYm2413Oversampling());
+    ym2413->ym2413->setSampleRate(mixerGetSampleRate(mixer), boardGetYm2413Oversampling(board));
 	ym2413->ym2413->setVolume(32767 * 9 / 10);
 
     return ym2413;
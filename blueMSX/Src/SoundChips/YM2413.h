@@ -40,7 +40,7 @@ extern "C" {
 typedef struct YM_2413 YM_2413;
 
 /* Constructor and destructor */
-YM_2413* ym2413Create(Mixer* mixer);
+YM_2413* ym2413Create(BoardContext* board, Mixer* mixer);
 void ym2413Destroy(YM_2413* ym2413);
 void ym2413WriteAddress(YM_2413* ym2413, UInt8 address);
 void ym2413WriteData(YM_2413* ym2413, UInt8 data);
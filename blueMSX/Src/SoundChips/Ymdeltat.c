@@ -25,8 +25,6 @@
 void OPL_STATUS_SET(void *OPL,int	flag);
 void OPL_STATUS_RESET(void *OPL,int flag);
 
-UINT8 *ym_deltat_memory;      /* memory pointer */
-
 /* Forecast to next Forecast (rate = *8) */
 /* 1/8 , 3/8 , 5/8 , 7/8 , 9/8 , 11/8 , 13/8 , 15/8 */
 const INT32 ym_deltat_decode_tableB1[16] = {
@@ -264,7 +262,7 @@ void YM_DELTAT_ADPCM_CALC(YM_DELTAT *DELTAT)
 			if( DELTAT->now_addr&1 ) data = DELTAT->now_data & 0x0f;
 			else
 			{
-				DELTAT->now_data = *(ym_deltat_memory+(DELTAT->now_addr>>1));
+				DELTAT->now_data = *(DELTAT->memory+(DELTAT->now_addr>>1));
 				data = DELTAT->now_data >> 4;
 			}
 			DELTAT->now_addr++;
@@ -302,9 +300,9 @@ void YM_DELTAT_ADPCM_CALC(YM_DELTAT *DELTAT)
 }
 
 
-void YM_DELTAT_ADPCM_LoadState(YM_DELTAT *DELTAT)
+void YM_DELTAT_ADPCM_LoadState(BoardContext* board, YM_DELTAT *DELTAT)
 {
-    SaveState* state = saveStateOpenForRead("ymdeltat");
+    SaveState* state = saveStateOpenForRead(board, "ymdeltat");
 
     DELTAT->memory_size   = saveStateGet(state, "memory_size",   0);
     DELTAT->output_range  = saveStateGet(state, "output_range",  0);
@@ -343,9 +341,9 @@ void YM_DELTAT_ADPCM_LoadState(YM_DELTAT *DELTAT)
 	DELTAT->pan = &DELTAT->output_pointer[(DELTAT->portcontrol>>6)&0x03];
 }
 
-void YM_DELTAT_ADPCM_SaveState(YM_DELTAT *DELTAT)
+void YM_DELTAT_ADPCM_SaveState(BoardContext* board, YM_DELTAT *DELTAT)
 {
-    SaveState* state = saveStateOpenForWrite("ymdeltat");
+    SaveState* state = saveStateOpenForWrite(board, "ymdeltat");
 
     saveStateSet(state, "memory_size",   DELTAT->memory_size);
     saveStateSet(state, "output_range",  DELTAT->output_range);
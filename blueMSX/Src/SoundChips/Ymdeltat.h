@@ -55,14 +55,8 @@ typedef struct deltat_adpcm_state {
 	UINT8 arrivedFlag;    /* flag of arrived end address */
 }YM_DELTAT;
 
-/* static state */
-extern UINT8 *ym_deltat_memory;       /* memory pointer */
-
-/* before YM_DELTAT_ADPCM_CALC(YM_DELTAT *DELTAT); */
-#define YM_DELTAT_DECODE_PRESET(DELTAT) {ym_deltat_memory = DELTAT->memory;}
-
-void YM_DELTAT_ADPCM_LoadState(YM_DELTAT *DELTAT);
-void YM_DELTAT_ADPCM_SaveState(YM_DELTAT *DELTAT);
+void YM_DELTAT_ADPCM_LoadState(BoardContext* board, YM_DELTAT *DELTAT);
+void YM_DELTAT_ADPCM_SaveState(BoardContext* board, YM_DELTAT *DELTAT);
 
 UINT8 YM_DELTAT_ADPCM_Peek(YM_DELTAT *DELTAT);
 UINT8 YM_DELTAT_ADPCM_Peek2(YM_DELTAT *DELTAT);
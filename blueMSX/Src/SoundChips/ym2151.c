@@ -41,6 +41,7 @@
 
 
 struct YM2151 {
+    BoardContext* board;
     Mixer* mixer;
     Int32  handle;
     UInt32 rate;
@@ -86,8 +87,8 @@ void ym2151SetIrq(void* ptr, int timer)
 {
     YM2151* ym2151 = (YM2151*)ptr;
     if (ym2151->irqState == 0) {
-        boardSetDataBus(ym2151->irqVector, 0, 0);
-		boardSetInt(0x40);
+        boardSetDataBus(ym2151->board, ym2151->irqVector, 0, 0);
+		boardSetInt(ym2151->board, 0x40);
     }
     ym2151->irqState |= timer;
 }
@@ -97,7 +98,7 @@ void ym2151ClearIrq(void* ptr, int timer)
     YM2151* ym2151 = (YM2151*)ptr;
     ym2151->irqState &= ~timer;
     if (ym2151->irqState == 0) {
-		boardClearInt(0x40);
+		boardClearInt(ym2151->board, 0x40);
     }
 }
 
@@ -128,7 +129,7 @@ void ym2151TimerStart(void* ptr, int timer, int start)
     if (timer == 0) {
         if (start != 0) {
             if (!ym2151->timerRunning1) {
-                UInt32 systemTime = boardSystemTime();
+                UInt32 systemTime = boardSystemTime(ym2151->board);
                 UInt32 adjust = systemTime % TIMER_FREQUENCY;
                 ym2151->timeout1 = systemTime + TIMER_FREQUENCY * ym2151->timerValue1 - adjust;
                 boardTimerAdd(ym2151->timer1, ym2151->timeout1);
@@ -145,7 +146,7 @@ void ym2151TimerStart(void* ptr, int timer, int start)
     else {
         if (start != 0) {
             if (!ym2151->timerRunning2) {
-                UInt32 systemTime = boardSystemTime();
+                UInt32 systemTime = boardSystemTime(ym2151->board);
                 UInt32 adjust = systemTime % (16 * TIMER_FREQUENCY);
                 ym2151->timeout2 = systemTime + TIMER_FREQUENCY * ym2151->timerValue2 - adjust;
                 boardTimerAdd(ym2151->timer2, ym2151->timeout2);
@@ -225,7 +226,7 @@ static Int32* ym2151Sync(void* ref, UInt32 count)
 
 void ym2151SaveState(YM2151* ym2151)
 {
-    SaveState* state = saveStateOpenForWrite("ym2151");
+    SaveState* state = saveStateOpenForWrite(ym2151->board, "ym2151");
 
     saveStateSet(state, "address",       ym2151->address);
     saveStateSet(state, "irqState",      ym2151->irqState);
@@ -245,7 +246,7 @@ void ym2151SaveState(YM2151* ym2151)
 
 void ym2151LoadState(YM2151* ym2151)
 {
-    SaveState* state = saveStateOpenForRead("ym2151");
+    SaveState* state = saveStateOpenForRead(ym2151->board, "ym2151");
 
     ym2151->address       = (UInt8)saveStateGet(state, "address",       0);
     ym2151->irqState      =        saveStateGet(state, "irqState",      0);
@@ -307,20 +308,21 @@ void ym2151SetSampleRate(void* ref, UInt32 rate)
     ym2151->rate = rate;
 }
 
-YM2151* ym2151Create(Mixer* mixer)
+YM2151* ym2151Create(BoardContext* board, Mixer* mixer)
 {
     YM2151* ym2151;
     
     ym2151 = (YM2151*)calloc(1, sizeof(YM2151));
+    ym2151->board = board;
 
     ym2151->mixer = mixer;
 
-    ym2151->timer1 = boardTimerCreate(onTimeout1, ym2151);
-    ym2151->timer2 = boardTimerCreate(onTimeout2, ym2151);
+    ym2151->timer1 = boardTimerCreate(board, onTimeout1, ym2151);
+    ym2151->timer2 = boardTimerCreate(board, onTimeout2, ym2151);
 
     ym2151->handle = mixerRegisterChannel(mixer, MIXER_CHANNEL_YAMAHA_SFG, 1, ym2151Sync, ym2151SetSampleRate, ym2151);
 
-    ym2151->opl = YM2151Create(ym2151, FREQUENCY, SAMPLERATE);
+    ym2151->opl = YM2151Create(board, ym2151, FREQUENCY, SAMPLERATE);
     
     ym2151->rate = mixerGetSampleRate(mixer);
 
@@ -36,7 +36,7 @@
 typedef struct YM2151 YM2151;
 
 /* Constructor and destructor */
-YM2151* ym2151Create(Mixer* mixer);
+YM2151* ym2151Create(BoardContext* board, Mixer* mixer);
 void ym2151Destroy(YM2151* ym2151);
 void ym2151Reset(YM2151* ym2151);
 void ym2151LoadState(YM2151* ym2151);
@@ -149,11 +149,11 @@ int themeTriggerEmuRunning() {
 }
 
 int themeTriggerFdcTiming() {
-    return boardGetFdcTimingEnable();
+    return boardGetFdcTimingEnable(emulatorGetBoard());
 }
 
 int themeTriggerNoSpriteLimits() {
-    return boardGetNoSpriteLimits();
+    return boardGetNoSpriteLimits(emulatorGetBoard());
 }
 
 int themeTriggerLedDiskA() {
@@ -457,19 +457,19 @@ int themeTriggerMachineScc() {
 }
 
 int themeTriggerMachineRom() {
-    return boardUseRom();
+    return boardUseRom(emulatorGetBoard());
 }
 
 int themeTriggerMachineMegaRom() {
-    return boardUseMegaRom();
+    return boardUseMegaRom(emulatorGetBoard());
 }
 
 int themeTriggerMachineMegaRam() {
-    return boardUseMegaRam();
+    return boardUseMegaRam(emulatorGetBoard());
 }
 
 int themeTriggerMachineFmPac() {
-    return boardUseFmPac();
+    return boardUseFmPac(emulatorGetBoard());
 }
 
 int themeTriggerConfDiskRI() {
@@ -610,15 +610,15 @@ int themeTriggerVideoRfModulatorEn() {
 }
 
 int themeTriggerVideoCaptureNone() {
-    return !boardCaptureIsRecording() && !boardCaptureIsPlaying() ? 1 : 0;
+    return !boardCaptureIsRecording(emulatorGetBoard()) && !boardCaptureIsPlaying(emulatorGetBoard()) ? 1 : 0;
 }
 
 int themeTriggerVideoCapturePlay() {
-    return boardCaptureIsPlaying() ? 1 : 0;
+    return boardCaptureIsPlaying(emulatorGetBoard()) ? 1 : 0;
 }
 
 int themeTriggerVideoCaptureRec() {
-    return boardCaptureIsRecording() ? 1 : 0;
+    return boardCaptureIsRecording(emulatorGetBoard()) ? 1 : 0;
 }
 
 int themeTriggerVideoGamma() {
@@ -658,27 +658,27 @@ int themeTriggerVideoFilter() {
 }
 
 int themeTriggerVideoEnableMon1() {
-    return videoManagerGetActive() == 0;
+    return videoManagerGetActive(emulatorGetBoard()) == 0;
 }
 
 int themeTriggerVideoEnableMon2() {
-    return videoManagerGetActive() == 1;
+    return videoManagerGetActive(emulatorGetBoard()) == 1;
 }
 
 int themeTriggerVideoEnableMon3() {
-    return videoManagerGetActive() == 2;
+    return videoManagerGetActive(emulatorGetBoard()) == 2;
 }
 
 int themeTriggerVideoPresentMon1() {
-    return videoManagerGetCount() >= 1;
+    return videoManagerGetCount(emulatorGetBoard()) >= 1;
 }
 
 int themeTriggerVideoPresentMon2() {
-    return videoManagerGetCount() >= 2;
+    return videoManagerGetCount(emulatorGetBoard()) >= 2;
 }
 
 int themeTriggerVideoPresentMon3() {
-    return videoManagerGetCount() >= 3;
+    return videoManagerGetCount(emulatorGetBoard()) >= 3;
 }
 
 int themeTriggerVideoIsMonitorAmber() {
@@ -765,15 +765,15 @@ char* themeTriggerVideoSaturationText() {
 }
 
 char* themeTriggerVideoMonName1Text() {
-    return videoManagerGetName(0);
+    return videoManagerGetName(emulatorGetBoard(), 0);
 }
 
 char* themeTriggerVideoMonName2Text() {
-    return videoManagerGetName(1);
+    return videoManagerGetName(emulatorGetBoard(), 1);
 }
 
 char* themeTriggerVideoMonName3Text() {
-    return videoManagerGetName(2);
+    return videoManagerGetName(emulatorGetBoard(), 2);
 }
 
 char* themeTriggerScreenMode() {
@@ -804,18 +804,18 @@ char* themeTriggerScreenModeShort() {
 
 char* themeTriggerMemoryRam() {
     static char buffer[16];
-    if (boardGetRamSize() >= 1024 * 1024) {
-        sprintf(buffer, "%dMB", boardGetRamSize() / 1024 * 1024);
+    if (boardGetRamSize(emulatorGetBoard()) >= 1024 * 1024) {
+        sprintf(buffer, "%dMB", boardGetRamSize(emulatorGetBoard()) / 1024 * 1024);
     }
     else {
-        sprintf(buffer, "%dkB", boardGetRamSize() / 1024);
+        sprintf(buffer, "%dkB", boardGetRamSize(emulatorGetBoard()) / 1024);
     }
     return buffer;
 }
 
 char* themeTriggerMemoryVram() {
     static char buffer[16];
-    sprintf(buffer, "%dkB", boardGetVramSize() / 1024);
+    sprintf(buffer, "%dkB", boardGetVramSize(emulatorGetBoard()) / 1024);
     return buffer;
 }
 
@@ -862,19 +862,19 @@ char* themeTriggerPerfTimerString(int timer) {
 }
 
 const char* themeTriggerRomMapper1() {
-    return propGetGlobalProperties()->media.carts[0].fileName[0] ? romTypeToString(boardGetRomType(0)) : "";
+    return propGetGlobalProperties()->media.carts[0].fileName[0] ? romTypeToString(boardGetRomType(emulatorGetBoard(), 0)) : "";
 }
 
 const char* themeTriggerRomMapper2() {
-    return propGetGlobalProperties()->media.carts[1].fileName[0] ? romTypeToString(boardGetRomType(1)) : ""; 
+    return propGetGlobalProperties()->media.carts[1].fileName[0] ? romTypeToString(boardGetRomType(emulatorGetBoard(), 1)) : ""; 
 }
 
 const char* themeTriggerRomMapper1Short() {
-    return propGetGlobalProperties()->media.carts[0].fileName[0] ? romTypeToShortString(boardGetRomType(0)) : "";
+    return propGetGlobalProperties()->media.carts[0].fileName[0] ? romTypeToShortString(boardGetRomType(emulatorGetBoard(), 0)) : "";
 }
 
 const char* themeTriggerRomMapper2Short() {
-    return propGetGlobalProperties()->media.carts[1].fileName[0] ? romTypeToShortString(boardGetRomType(1)) : "";
+    return propGetGlobalProperties()->media.carts[1].fileName[0] ? romTypeToShortString(boardGetRomType(emulatorGetBoard(), 1)) : "";
 }
 
 char* themeTriggerMachineName() {
@@ -0,0 +1,438 @@
+/*****************************************************************************
+** $Source: /cygdrive/d/Private/_SVNROOT/bluemsx/blueMSX/Src/Utils/CaptureFile.c,v $
+**
+** $Revision: 1.1 $
+**
+** $Date: 2026-10-17 12:00:00 $
+**
+** More info: http://www.bluemsx.com
+**
+** Copyright (C) 2003-2006 Daniel Vik
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+******************************************************************************
+*/
+#include "CaptureFile.h"
+#include "zlib.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+//
+// File layout:
+//
+//   UInt32 magic, UInt32 version
+//   chunks * { ChunkHeader, payload }
+//
+// Chunks are only ever appended, so a capture that was never stopped
+// can still be played up to its last complete chunk. Each chunk has a
+// CRC of its header and payload, and reading stops at the first chunk
+// with an invalid header or CRC. Offsets are 64 bit so captures have no
+// size limit on hosts with large file support.
+//
+// Version 1 captures have no CRC in the chunk header. They are still
+// played and continued, without the CRC check.
+//
+
+#define CAPTURE_MAGIC   0x43584d42 // "BMXC"
+#define CAPTURE_VERSION 2
+
+#define CRC_BUFFER_SIZE (64 * 1024)
+
+typedef struct {
+    UInt32 type;
+    UInt32 size;
+    UInt32 time;
+    UInt32 time64Hi;
+    UInt32 time64Lo;
+    UInt32 crc;
+} ChunkHeader;
+
+#define CHUNK_HEADER_CRC_SIZE (sizeof(ChunkHeader) - sizeof(UInt32))
+#define chunkHeaderSize(file) ((file)->version == 1 ? CHUNK_HEADER_CRC_SIZE : sizeof(ChunkHeader))
+
+typedef struct {
+    UInt64 time64;
+    UInt64 offset;
+} Keyframe;
+
+struct CaptureFile {
+    FILE*     file;
+    UInt32    version;
+    UInt64    offset;
+    UInt64    length;
+    Keyframe* keyframes;
+    int       keyframeCount;
+    int       keyframeAlloc;
+    UInt64    startTime64;
+    UInt64    endTime64;
+    UInt32    endTime;
+};
+
+static int fileSeek(FILE* file, UInt64 offset)
+{
+#if defined(_MSC_VER) && _MSC_VER >= 1400
+    return _fseeki64(file, (__int64)offset, SEEK_SET);
+#elif defined(_WIN32)
+    return fseek(file, (long)offset, SEEK_SET);
+#else
+    return fseeko(file, (off_t)offset, SEEK_SET);
+#endif
+}
+
+static UInt64 fileLength(FILE* file)
+{
+#if defined(_MSC_VER) && _MSC_VER >= 1400
+    _fseeki64(file, 0, SEEK_END);
+    return (UInt64)_ftelli64(file);
+#elif defined(_WIN32)
+    fseek(file, 0, SEEK_END);
+    return (UInt64)ftell(file);
+#else
+    fseeko(file, 0, SEEK_END);
+    return (UInt64)ftello(file);
+#endif
+}
+
+static int fileTruncate(FILE* file, UInt64 length)
+{
+    fflush(file);
+#if defined(_MSC_VER) && _MSC_VER >= 1400
+    return _chsize_s(_fileno(file), (__int64)length);
+#elif defined(_WIN32)
+    return _chsize(_fileno(file), (long)length);
+#else
+    return ftruncate(fileno(file), (off_t)length);
+#endif
+}
+
+// Returns the version of the capture, or 0 if the file is not a capture
+static UInt32 readHeader(FILE* file)
+{
+    UInt32 header[2];
+
+    if (fread(header, 1, sizeof(header), file) != sizeof(header) ||
+        header[0] != CAPTURE_MAGIC || header[1] < 1 || header[1] > CAPTURE_VERSION)
+    {
+        return 0;
+    }
+    return header[1];
+}
+
+static UInt32 headerCrc(ChunkHeader* header)
+{
+    return crc32(0, (const Bytef*)header, CHUNK_HEADER_CRC_SIZE);
+}
+
+// Checks the CRC of the chunk that ends at the current offset
+static int checkChunkCrc(CaptureFile* file, UInt32 size)
+{
+    ChunkHeader header;
+    UInt8* buffer;
+    UInt32 crc;
+
+    if (file->version == 1) {
+        return 1;
+    }
+
+    if (fileSeek(file->file, file->offset - sizeof(header) - size) != 0 ||
+        fread(&header, 1, sizeof(header), file->file) != sizeof(header))
+    {
+        return 0;
+    }
+
+    buffer = malloc(CRC_BUFFER_SIZE);
+    crc = headerCrc(&header);
+    while (size > 0) {
+        UInt32 length = size < CRC_BUFFER_SIZE ? size : CRC_BUFFER_SIZE;
+        if (fread(buffer, 1, length, file->file) != length) {
+            break;
+        }
+        crc = crc32(crc, buffer, length);
+        size -= length;
+    }
+    free(buffer);
+
+    return size == 0 && crc == header.crc;
+}
+
+static CaptureFile* captureFileAlloc(FILE* file, UInt32 version, UInt64 offset)
+{
+    CaptureFile* capFile = (CaptureFile*)calloc(1, sizeof(CaptureFile));
+
+    capFile->file    = file;
+    capFile->version = version;
+    capFile->offset  = offset;
+
+    return capFile;
+}
+
+static void addKeyframe(CaptureFile* file, UInt64 time64, UInt64 offset)
+{
+    if (file->keyframeCount == file->keyframeAlloc) {
+        file->keyframeAlloc = file->keyframeAlloc ? 2 * file->keyframeAlloc : 64;
+        file->keyframes = realloc(file->keyframes, file->keyframeAlloc * sizeof(Keyframe));
+    }
+    file->keyframes[file->keyframeCount].time64 = time64;
+    file->keyframes[file->keyframeCount].offset = offset;
+    file->keyframeCount++;
+}
+
+int captureFileIsCapture(const char* fileName)
+{
+    FILE* file = fopen(fileName, "rb");
+    int isCapture;
+
+    if (file == NULL) {
+        return 0;
+    }
+    isCapture = readHeader(file) != 0;
+    fclose(file);
+
+    return isCapture;
+}
+
+CaptureFile* captureFileCreate(const char* fileName)
+{
+    UInt32 header[2] = { CAPTURE_MAGIC, CAPTURE_VERSION };
+    FILE* file = fopen(fileName, "wb");
+
+    if (file == NULL) {
+        return NULL;
+    }
+    if (fwrite(header, 1, sizeof(header), file) != sizeof(header)) {
+        fclose(file);
+        return NULL;
+    }
+
+    return captureFileAlloc(file, CAPTURE_VERSION, sizeof(header));
+}
+
+CaptureFile* captureFileOpenForWrite(const char* fileName, UInt64 offset)
+{
+    FILE* file = fopen(fileName, "r+b");
+    UInt32 version;
+
+    if (file == NULL) {
+        return NULL;
+    }
+    // Drop the chunks after the offset, they may be longer than the
+    // chunks that replace them and would be read after the new ones
+    version = readHeader(file);
+    if (version == 0 || offset > fileLength(file) ||
+        fileTruncate(file, offset) != 0 || fileSeek(file, offset) != 0)
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    return captureFileAlloc(file, version, offset);
+}
+
+CaptureFile* captureFileOpen(const char* fileName)
+{
+    CaptureFile* capFile;
+    CaptureChunkType type;
+    UInt32 time;
+    UInt64 time64;
+    UInt32 size;
+    UInt32 version;
+    FILE* file;
+    int first = 1;
+
+    file = fopen(fileName, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+    version = readHeader(file);
+    if (version == 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    capFile = captureFileAlloc(file, version, 2 * sizeof(UInt32));
+    capFile->length = fileLength(file);
+
+    // Index the keyframes and find the capture times. The capture ends
+    // before the first chunk that fails its CRC.
+    while (captureFileNextChunk(capFile, &type, &time, &time64, &size)) {
+        if (!checkChunkCrc(capFile, size)) {
+            capFile->length = capFile->offset - chunkHeaderSize(capFile) - size;
+            break;
+        }
+        if (first) {
+            capFile->startTime64 = time64;
+            first = 0;
+        }
+        capFile->endTime   = time;
+        capFile->endTime64 = time64;
+
+        if (type == CAPTURE_CHUNK_STATE) {
+            addKeyframe(capFile, time64, capFile->offset - chunkHeaderSize(capFile) - size);
+        }
+        if (type == CAPTURE_CHUNK_END) {
+            break;
+        }
+    }
+
+    captureFileSeek(capFile, 2 * sizeof(UInt32));
+
+    return capFile;
+}
+
+void captureFileClose(CaptureFile* file)
+{
+    if (file == NULL) {
+        return;
+    }
+    fclose(file->file);
+    free(file->keyframes);
+    free(file);
+}
+
+UInt64 captureFileGetOffset(CaptureFile* file)
+{
+    return file->offset;
+}
+
+int captureFileWriteChunk(CaptureFile* file, CaptureChunkType type,
+                          UInt32 time, UInt64 time64, void* data, UInt32 size)
+{
+    ChunkHeader header;
+    UInt32 headerSize = chunkHeaderSize(file);
+
+    header.type     = type;
+    header.size     = size;
+    header.time     = time;
+    header.time64Hi = (UInt32)(time64 >> 32);
+    header.time64Lo = (UInt32)time64;
+    header.crc      = headerCrc(&header);
+    if (size > 0) {
+        header.crc  = crc32(header.crc, data, size);
+    }
+
+    if (fwrite(&header, 1, headerSize, file->file) != headerSize ||
+        (size > 0 && fwrite(data, 1, size, file->file) != size))
+    {
+        return 0;
+    }
+
+    // Keep the file playable if the emulator is terminated while recording
+    fflush(file->file);
+
+    file->offset += headerSize + size;
+
+    return 1;
+}
+
+int captureFileNextChunk(CaptureFile* file, CaptureChunkType* type,
+                         UInt32* time, UInt64* time64, UInt32* size)
+{
+    ChunkHeader header;
+    UInt32 headerSize = chunkHeaderSize(file);
+
+    if (fileSeek(file->file, file->offset) != 0 ||
+        fread(&header, 1, headerSize, file->file) != headerSize)
+    {
+        return 0;
+    }
+
+    // Stop at a chunk with an unknown type or one that was not
+    // completely written
+    if (header.type < CAPTURE_CHUNK_INPUTS || header.type > CAPTURE_CHUNK_END) {
+        return 0;
+    }
+    if (file->length > 0 && file->offset + headerSize + header.size > file->length) {
+        return 0;
+    }
+
+    *type   = (CaptureChunkType)header.type;
+    *time   = header.time;
+    *time64 = (UInt64)header.time64Hi << 32 | header.time64Lo;
+    *size   = header.size;
+
+    file->offset += headerSize + header.size;
+
+    return 1;
+}
+
+int captureFileReadData(CaptureFile* file, void* buffer, UInt32 size)
+{
+    return fread(buffer, 1, size, file->file) == size;
+}
+
+int captureFileSeek(CaptureFile* file, UInt64 offset)
+{
+    file->offset = offset;
+    return fileSeek(file->file, offset) == 0;
+}
+
+int captureFileGetKeyframeCount(CaptureFile* file)
+{
+    return file->keyframeCount;
+}
+
+// Returns the last keyframe at or before time64, or the first keyframe
+int captureFileFindKeyframe(CaptureFile* file, UInt64 time64)
+{
+    int lo = 0;
+    int hi = file->keyframeCount - 1;
+
+    if (file->keyframeCount == 0) {
+        return -1;
+    }
+
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (file->keyframes[mid].time64 <= time64) {
+            lo = mid;
+        }
+        else {
+            hi = mid - 1;
+        }
+    }
+    return lo;
+}
+
+UInt64 captureFileGetKeyframeOffset(CaptureFile* file, int keyframe)
+{
+    return file->keyframes[keyframe].offset;
+}
+
+UInt64 captureFileGetKeyframeTime64(CaptureFile* file, int keyframe)
+{
+    return file->keyframes[keyframe].time64;
+}
+
+UInt64 captureFileGetStartTime64(CaptureFile* file)
+{
+    return file->startTime64;
+}
+
+UInt64 captureFileGetEndTime64(CaptureFile* file)
+{
+    return file->endTime64;
+}
+
+UInt32 captureFileGetEndTime(CaptureFile* file)
+{
+    return file->endTime;
+}
@@ -0,0 +1,84 @@
+/*****************************************************************************
+** $Source: /cygdrive/d/Private/_SVNROOT/bluemsx/blueMSX/Src/Utils/CaptureFile.h,v $
+**
+** $Revision: 1.1 $
+**
+** $Date: 2026-10-17 12:00:00 $
+**
+** More info: http://www.bluemsx.com
+**
+** Copyright (C) 2003-2006 Daniel Vik
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+******************************************************************************
+*/
+#ifndef CAPTURE_FILE_H
+#define CAPTURE_FILE_H
+
+#include "MsxTypes.h"
+
+//
+// A capture file is a stream of chunks written in emulation order.
+// Each chunk has a type, the board time it was written at and a
+// payload. Input chunks hold recorded input data, state chunks hold
+// a complete save state image (keyframe) that playback can start
+// from. The stream ends with an end chunk, or at the last complete
+// chunk if the recording was never stopped.
+//
+
+typedef enum {
+    CAPTURE_CHUNK_INPUTS = 1,
+    CAPTURE_CHUNK_STATE  = 2,
+    CAPTURE_CHUNK_END    = 3
+} CaptureChunkType;
+
+typedef struct CaptureFile CaptureFile;
+
+int captureFileIsCapture(const char* fileName);
+
+// Creates a new capture file, or opens an existing one for writing
+// at the given offset. The file is truncated at the offset.
+CaptureFile* captureFileCreate(const char* fileName);
+CaptureFile* captureFileOpenForWrite(const char* fileName, UInt64 offset);
+
+// Opens a capture for reading and indexes its keyframes
+CaptureFile* captureFileOpen(const char* fileName);
+
+void captureFileClose(CaptureFile* file);
+
+// Offset of the next chunk to write or read
+UInt64 captureFileGetOffset(CaptureFile* file);
+
+int captureFileWriteChunk(CaptureFile* file, CaptureChunkType type,
+                          UInt32 time, UInt64 time64, void* data, UInt32 size);
+
+// Reads the header of the next chunk. The payload is then read with
+// captureFileReadData() or skipped by the next captureFileNextChunk().
+int captureFileNextChunk(CaptureFile* file, CaptureChunkType* type,
+                         UInt32* time, UInt64* time64, UInt32* size);
+int captureFileReadData(CaptureFile* file, void* buffer, UInt32 size);
+int captureFileSeek(CaptureFile* file, UInt64 offset);
+
+// Keyframe lookup and capture times of a capture opened for reading
+int    captureFileGetKeyframeCount(CaptureFile* file);
+int    captureFileFindKeyframe(CaptureFile* file, UInt64 time64);
+UInt64 captureFileGetKeyframeOffset(CaptureFile* file, int keyframe);
+UInt64 captureFileGetKeyframeTime64(CaptureFile* file, int keyframe);
+UInt64 captureFileGetStartTime64(CaptureFile* file);
+UInt64 captureFileGetEndTime64(CaptureFile* file);
+UInt32 captureFileGetEndTime(CaptureFile* file);
+
+#endif /* CAPTURE_FILE_H */
@@ -0,0 +1,644 @@
+/*****************************************************************************
+** $Source: /cygdrive/d/Private/_SVNROOT/bluemsx/blueMSX/Src/Utils/RewindBuffer.c,v $
+**
+** $Revision: 1.1 $
+**
+** $Date: 2026-10-17 12:00:00 $
+**
+** More info: http://www.bluemsx.com
+**
+** Copyright (C) 2003-2006 Daniel Vik
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+******************************************************************************
+*/
+#include "RewindBuffer.h"
+#include "ArchTimer.h"
+#include <stdlib.h>
+#include <string.h>
+
+//
+// Snapshot layout in the arena:
+//
+//   UInt32 fileCount
+//   fileCount * { UInt8 nameLen, name, UInt8 flags, UInt32 size,
+//                 UInt32 encodedSize, encoded data }
+//
+// File data is XORed against the file with the same name in the previous
+// snapshot (or against zero in a keyframe) and the result is RLE coded:
+//
+//   0x00-0x7f  literal run of c + 1 bytes follows
+//   0x80-0xfe  run of c - 0x7f zero bytes
+//   0xff       run of zero bytes, UInt32 length follows
+//
+
+#define FILE_FLAG_DELTA  0x01
+
+#define MIN_ZERO_RUN     3
+#define MAX_LITERAL_RUN  0x80
+#define MAX_SHORT_RUN    0x7f
+
+typedef struct {
+    char   name[64];
+    UInt32 size;
+    UInt32 allocSize;
+    UInt8* data;
+} RewindFile;
+
+typedef struct {
+    RewindFile* files;
+    int         count;
+    int         allocCount;
+} RewindFileSet;
+
+typedef struct {
+    UInt32 offset;
+    UInt32 size;
+    int    keyframe;
+} RewindEntry;
+
+struct RewindBuffer {
+    UInt8*       arena;
+    UInt32       arenaSize;
+    UInt32       head;
+
+    RewindEntry* entries;
+    int          maxEntries;
+    int          first;
+    int          count;
+
+    int          keyframeInterval;
+    int          sinceKeyframe;
+
+    // current holds the files of the newest snapshot in the arena
+    // when currentValid is set. After a rewind it holds the files of
+    // the snapshot that was removed.
+    RewindFileSet current;
+    RewindFileSet pending;
+    int           currentValid;
+    int           pendingOpen;
+
+    UInt8*  scratch;
+    UInt32  scratchSize;
+
+    UInt32  startTime;
+    UInt32  snapshotsTaken;
+    UInt32  lastRawBytes;
+    UInt32  lastBytes;
+    UInt32  lastTime;
+    UInt32  maxTime;
+    UInt64  totalBytes;
+    UInt64  totalTime;
+};
+
+static void put32(UInt8* p, UInt32 value)
+{
+    p[0] = (UInt8)(value >>  0);
+    p[1] = (UInt8)(value >>  8);
+    p[2] = (UInt8)(value >> 16);
+    p[3] = (UInt8)(value >> 24);
+}
+
+static UInt32 get32(const UInt8* p)
+{
+    return (UInt32)p[0] | ((UInt32)p[1] << 8) | ((UInt32)p[2] << 16) | ((UInt32)p[3] << 24);
+}
+
+static void fileSetDestroy(RewindFileSet* set)
+{
+    int i;
+    for (i = 0; i < set->allocCount; i++) {
+        free(set->files[i].data);
+    }
+    free(set->files);
+    set->files      = NULL;
+    set->count      = 0;
+    set->allocCount = 0;
+}
+
+static RewindFile* fileSetAdd(RewindFileSet* set, const char* name, UInt32 size)
+{
+    RewindFile* file;
+
+    if (set->count == set->allocCount) {
+        int newCount = set->allocCount ? 2 * set->allocCount : 64;
+        set->files = (RewindFile*)realloc(set->files, newCount * sizeof(RewindFile));
+        memset(set->files + set->allocCount, 0, (newCount - set->allocCount) * sizeof(RewindFile));
+        set->allocCount = newCount;
+    }
+
+    // Buffers are kept between snapshots to avoid reallocating
+    file = &set->files[set->count];
+    if (file->allocSize < size) {
+        free(file->data);
+        file->data      = (UInt8*)malloc(size);
+        file->allocSize = size;
+    }
+    strncpy(file->name, name, sizeof(file->name) - 1);
+    file->name[sizeof(file->name) - 1] = 0;
+    file->size = size;
+
+    set->count++;
+
+    return file;
+}
+
+static RewindFile* fileSetFind(RewindFileSet* set, const char* name, int hint)
+{
+    int i;
+
+    // Snapshots normally contain the same files in the same order
+    if (hint < set->count && strcmp(set->files[hint].name, name) == 0) {
+        return &set->files[hint];
+    }
+    for (i = 0; i < set->count; i++) {
+        if (strcmp(set->files[i].name, name) == 0) {
+            return &set->files[i];
+        }
+    }
+    return NULL;
+}
+
+static void fileSetSwap(RewindBuffer* rb)
+{
+    RewindFileSet tmp = rb->current;
+    rb->current = rb->pending;
+    rb->pending = tmp;
+}
+
+static UInt32 zeroRun(const UInt8* src, const UInt8* ref, UInt32 offset, UInt32 size)
+{
+    UInt32 i = offset;
+
+    // Buffers are malloced so both have the same word alignment
+    if (ref != NULL) {
+        while (i < size && (i & 3) != 0 && src[i] == ref[i]) i++;
+        if ((i & 3) == 0) {
+            while (i + 4 <= size && *(const UInt32*)(src + i) == *(const UInt32*)(ref + i)) i += 4;
+        }
+        while (i < size && src[i] == ref[i]) i++;
+    }
+    else {
+        while (i < size && (i & 3) != 0 && src[i] == 0) i++;
+        if ((i & 3) == 0) {
+            while (i + 4 <= size && *(const UInt32*)(src + i) == 0) i += 4;
+        }
+        while (i < size && src[i] == 0) i++;
+    }
+
+    return i - offset;
+}
+
+static UInt8* encodeFile(UInt8* dst, const UInt8* src, const UInt8* ref, UInt32 size)
+{
+    UInt32 i = 0;
+
+    while (i < size) {
+        UInt32 run = zeroRun(src, ref, i, size);
+        UInt32 start;
+
+        if (run >= MIN_ZERO_RUN || i + run == size) {
+            if (run > MAX_SHORT_RUN) {
+                *dst++ = 0xff;
+                put32(dst, run);
+                dst += 4;
+            }
+            else if (run > 0) {
+                *dst++ = (UInt8)(0x7f + run);
+            }
+            i += run;
+            continue;
+        }
+
+        start = i;
+        while (i < size && i - start < MAX_LITERAL_RUN) {
+            if (zeroRun(src, ref, i, i + MIN_ZERO_RUN < size ? i + MIN_ZERO_RUN : size) >= MIN_ZERO_RUN) {
+                break;
+            }
+            i++;
+        }
+        *dst++ = (UInt8)(i - start - 1);
+        if (ref != NULL) {
+            while (start < i) {
+                *dst++ = src[start] ^ ref[start];
+                start++;
+            }
+        }
+        else {
+            memcpy(dst, src + start, i - start);
+            dst += i - start;
+        }
+    }
+
+    return dst;
+}
+
+static const UInt8* decodeFile(UInt8* dst, const UInt8* ref, UInt32 size, const UInt8* src)
+{
+    UInt32 i = 0;
+
+    while (i < size) {
+        UInt32 c = *src++;
+        UInt32 n;
+
+        if (c < 0x80) {
+            n = c + 1;
+            if (ref != NULL) {
+                UInt32 j;
+                for (j = 0; j < n; j++) {
+                    dst[i + j] = src[j] ^ ref[i + j];
+                }
+            }
+            else {
+                memcpy(dst + i, src, n);
+            }
+            src += n;
+        }
+        else {
+            if (c == 0xff) {
+                n = get32(src);
+                src += 4;
+            }
+            else {
+                n = c - 0x7f;
+            }
+            if (ref != NULL) {
+                memcpy(dst + i, ref + i, n);
+            }
+            else {
+                memset(dst + i, 0, n);
+            }
+        }
+        i += n;
+    }
+
+    return src;
+}
+
+static void scratchReserve(RewindBuffer* rb, UInt32 size)
+{
+    if (rb->scratchSize < size) {
+        rb->scratchSize = size + size / 2;
+        rb->scratch = (UInt8*)realloc(rb->scratch, rb->scratchSize);
+    }
+}
+
+// Encodes the pending snapshot into the scratch buffer and returns its size
+static UInt32 encodeSnapshot(RewindBuffer* rb, int keyframe)
+{
+    UInt32 pos = 4;
+    int i;
+
+    scratchReserve(rb, pos);
+    put32(rb->scratch, rb->pending.count);
+
+    for (i = 0; i < rb->pending.count; i++) {
+        RewindFile* file = &rb->pending.files[i];
+        RewindFile* ref  = NULL;
+        UInt32 nameLen   = strlen(file->name);
+        UInt8* p;
+        UInt8* end;
+
+        if (!keyframe) {
+            ref = fileSetFind(&rb->current, file->name, i);
+            if (ref != NULL && ref->size != file->size) {
+                ref = NULL;
+            }
+        }
+
+        // Worst case is one control byte per literal run
+        scratchReserve(rb, pos + 1 + nameLen + 1 + 8 + file->size + file->size / MAX_LITERAL_RUN + 8);
+
+        p = rb->scratch + pos;
+        *p++ = (UInt8)nameLen;
+        memcpy(p, file->name, nameLen);
+        p += nameLen;
+        *p++ = ref != NULL ? FILE_FLAG_DELTA : 0;
+        put32(p, file->size);
+        p += 8;
+
+        end = encodeFile(p, file->data, ref != NULL ? ref->data : NULL, file->size);
+        put32(p - 4, (UInt32)(end - p));
+
+        pos = (UInt32)(end - rb->scratch);
+    }
+
+    return pos;
+}
+
+// Decodes a snapshot on top of the current files
+static void decodeSnapshot(RewindBuffer* rb, RewindEntry* entry)
+{
+    const UInt8* p = rb->arena + entry->offset;
+    int count = get32(p);
+    int i;
+
+    p += 4;
+
+    rb->pending.count = 0;
+
+    for (i = 0; i < count; i++) {
+        char name[64];
+        UInt32 nameLen = *p++;
+        UInt8  flags;
+        UInt32 size;
+        UInt32 encodedSize;
+        RewindFile* file;
+        RewindFile* ref = NULL;
+
+        memcpy(name, p, nameLen);
+        name[nameLen] = 0;
+        p += nameLen;
+        flags       = *p++;
+        size        = get32(p);
+        encodedSize = get32(p + 4);
+        p += 8;
+
+        file = fileSetAdd(&rb->pending, name, size);
+        if (flags & FILE_FLAG_DELTA) {
+            ref = fileSetFind(&rb->current, name, i);
+        }
+        decodeFile(file->data, ref != NULL ? ref->data : NULL, size, p);
+        p += encodedSize;
+    }
+
+    fileSetSwap(rb);
+}
+
+static RewindEntry* entryAt(RewindBuffer* rb, int index)
+{
+    return &rb->entries[(rb->first + index) % rb->maxEntries];
+}
+
+// Rebuilds the current files from the newest keyframe and its deltas
+static void rebuildCurrent(RewindBuffer* rb)
+{
+    int index = rb->count - 1;
+    int i;
+
+    while (index > 0 && !entryAt(rb, index)->keyframe) {
+        index--;
+    }
+
+    rb->current.count = 0;
+    for (i = index; i < rb->count; i++) {
+        decodeSnapshot(rb, entryAt(rb, i));
+    }
+    rb->currentValid = 1;
+}
+
+static int arenaAlloc(RewindBuffer* rb, UInt32 size, UInt32* offset)
+{
+    UInt32 tail;
+
+    if (rb->count == 0) {
+        rb->head = 0;
+        *offset = 0;
+        return size <= rb->arenaSize;
+    }
+
+    tail = entryAt(rb, 0)->offset;
+
+    if (rb->head > tail) {
+        if (rb->head + size <= rb->arenaSize) {
+            *offset = rb->head;
+            return 1;
+        }
+        if (size <= tail) {
+            *offset = 0;
+            return 1;
+        }
+        return 0;
+    }
+    if (rb->head < tail && rb->head + size <= tail) {
+        *offset = rb->head;
+        return 1;
+    }
+    return 0;
+}
+
+// Drops the oldest keyframe and its deltas. The group the next delta
+// depends on is only dropped when a keyframe is being added.
+static int evictOldest(RewindBuffer* rb, int keyframe)
+{
+    int n = 1;
+
+    if (rb->count == 0) {
+        return 0;
+    }
+
+    while (n < rb->count && !entryAt(rb, n)->keyframe) {
+        n++;
+    }
+    if (n == rb->count && !keyframe) {
+        return 0;
+    }
+
+    rb->first  = (rb->first + n) % rb->maxEntries;
+    rb->count -= n;
+
+    return 1;
+}
+
+RewindBuffer* rewindBufferCreate(int maxSnapshots, UInt32 arenaSize, int keyframeInterval)
+{
+    RewindBuffer* rb = (RewindBuffer*)calloc(1, sizeof(RewindBuffer));
+
+    rb->arena      = (UInt8*)malloc(arenaSize);
+    rb->arenaSize  = rb->arena != NULL ? arenaSize : 0;
+    rb->entries    = (RewindEntry*)calloc(maxSnapshots, sizeof(RewindEntry));
+    rb->maxEntries = maxSnapshots;
+
+    rb->keyframeInterval = keyframeInterval > 0 ? keyframeInterval : 1;
+
+    return rb;
+}
+
+void rewindBufferDestroy(RewindBuffer* rb)
+{
+    if (rb == NULL) {
+        return;
+    }
+
+    fileSetDestroy(&rb->current);
+    fileSetDestroy(&rb->pending);
+    free(rb->arena);
+    free(rb->entries);
+    free(rb->scratch);
+    free(rb);
+}
+
+int rewindBufferSaveFile(RewindBuffer* rb, const char* fileName, int append, void* buffer, int size)
+{
+    RewindFile* file;
+
+    if (rb->maxEntries == 0) {
+        return 0;
+    }
+
+    if (!append) {
+        rb->startTime   = archGetHiresTimer();
+        rb->pending.count = 0;
+        rb->pendingOpen = 1;
+    }
+
+    if (!rb->pendingOpen || size < 0) {
+        return 0;
+    }
+
+    file = fileSetAdd(&rb->pending, fileName, size);
+    if (file->data == NULL && size > 0) {
+        rb->pending.count--;
+        return 0;
+    }
+    memcpy(file->data, buffer, size);
+
+    return 1;
+}
+
+int rewindBufferCommit(RewindBuffer* rb)
+{
+    RewindEntry* entry;
+    UInt32 offset;
+    UInt32 size;
+    UInt32 time;
+    int keyframe;
+    int i;
+
+    if (!rb->pendingOpen) {
+        return 0;
+    }
+    rb->pendingOpen = 0;
+
+    keyframe = !rb->currentValid || rb->count == 0 || rb->sinceKeyframe >= rb->keyframeInterval;
+    size = encodeSnapshot(rb, keyframe);
+
+    for (;;) {
+        if (rb->count < rb->maxEntries && arenaAlloc(rb, size, &offset)) {
+            break;
+        }
+        if (evictOldest(rb, keyframe)) {
+            continue;
+        }
+        if (keyframe) {
+            // Snapshot is larger than the whole arena
+            rb->currentValid = 0;
+            return 0;
+        }
+        keyframe = 1;
+        size = encodeSnapshot(rb, keyframe);
+    }
+
+    memcpy(rb->arena + offset, rb->scratch, size);
+
+    entry = entryAt(rb, rb->count++);
+    entry->offset   = offset;
+    entry->size     = size;
+    entry->keyframe = keyframe;
+
+    rb->head          = offset + size;
+    rb->sinceKeyframe = keyframe ? 1 : rb->sinceKeyframe + 1;
+
+    fileSetSwap(rb);
+    rb->currentValid = 1;
+
+    time = archGetHiresTimer() - rb->startTime;
+
+    rb->lastRawBytes = 0;
+    for (i = 0; i < rb->current.count; i++) {
+        rb->lastRawBytes += rb->current.files[i].size;
+    }
+    rb->lastBytes   = size;
+    rb->lastTime    = time;
+    rb->totalBytes += size;
+    rb->totalTime  += time;
+    if (time > rb->maxTime) {
+        rb->maxTime = time;
+    }
+    rb->snapshotsTaken++;
+
+    return 1;
+}
+
+int rewindBufferRewind(RewindBuffer* rb)
+{
+    if (rb->count == 0) {
+        return 0;
+    }
+
+    if (!rb->currentValid) {
+        rebuildCurrent(rb);
+    }
+
+    rb->count--;
+    if (rb->count > 0) {
+        RewindEntry* entry = entryAt(rb, rb->count - 1);
+        rb->head = entry->offset + entry->size;
+    }
+
+    // The next snapshot can't be a delta against a removed one
+    rb->currentValid = 0;
+
+    return 1;
+}
+
+void* rewindBufferLoadFile(RewindBuffer* rb, const char* fileName, int* size)
+{
+    RewindFile* file = fileSetFind(&rb->current, fileName, 0);
+    void* buffer;
+
+    *size = 0;
+
+    if (file == NULL || file->size == 0) {
+        return NULL;
+    }
+
+    buffer = malloc(file->size);
+    memcpy(buffer, file->data, file->size);
+    *size = file->size;
+
+    return buffer;
+}
+
+int rewindBufferGetCount(RewindBuffer* rb)
+{
+    return rb->count;
+}
+
+void rewindBufferGetStats(RewindBuffer* rb, RewindBufferStats* stats)
+{
+    int i;
+
+    memset(stats, 0, sizeof(RewindBufferStats));
+
+    stats->snapshotCount = rb->count;
+    stats->arenaSize     = rb->arenaSize;
+    for (i = 0; i < rb->count; i++) {
+        RewindEntry* entry = entryAt(rb, i);
+        stats->keyframeCount += entry->keyframe;
+        stats->arenaUsed     += entry->size;
+    }
+
+    stats->snapshotsTaken = rb->snapshotsTaken;
+    stats->lastRawBytes   = rb->lastRawBytes;
+    stats->lastBytes      = rb->lastBytes;
+    stats->lastTime       = rb->lastTime;
+    stats->maxTime        = rb->maxTime;
+    if (rb->snapshotsTaken > 0) {
+        stats->avgBytes = (UInt32)(rb->totalBytes / rb->snapshotsTaken);
+        stats->avgTime  = (UInt32)(rb->totalTime  / rb->snapshotsTaken);
+    }
+}
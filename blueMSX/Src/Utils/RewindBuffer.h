@@ -0,0 +1,75 @@
+/*****************************************************************************
+** $Source: /cygdrive/d/Private/_SVNROOT/bluemsx/blueMSX/Src/Utils/RewindBuffer.h,v $
+**
+** $Revision: 1.1 $
+**
+** $Date: 2026-10-17 12:00:00 $
+**
+** More info: http://www.bluemsx.com
+**
+** Copyright (C) 2003-2006 Daniel Vik
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+******************************************************************************
+*/
+#ifndef REWIND_BUFFER_H
+#define REWIND_BUFFER_H
+
+#include "MsxTypes.h"
+
+//
+// The rewind buffer holds the in memory save states used for reverse
+// play. Save states written to zip names starting with "mem" end up
+// here. Each snapshot is stored as an XOR/RLE delta against the previous
+// one, with a full keyframe every keyframeInterval snapshots. All
+// snapshots live in one preallocated ring arena; when it is full the
+// oldest keyframe and its deltas are dropped. Each board owns its own
+// rewind buffer, see boardGetRewindBuffer().
+//
+
+typedef struct RewindBuffer RewindBuffer;
+
+typedef struct {
+    int    snapshotCount;   // Snapshots currently in the buffer
+    int    keyframeCount;   // Keyframes currently in the buffer
+    UInt32 arenaSize;       // Size of the arena in bytes
+    UInt32 arenaUsed;       // Bytes used by stored snapshots
+    UInt32 snapshotsTaken;  // Snapshots taken since create
+    UInt32 lastRawBytes;    // Uncompressed size of the last snapshot
+    UInt32 lastBytes;       // Stored size of the last snapshot
+    UInt32 avgBytes;        // Average stored size per snapshot
+    UInt32 lastTime;        // Time to take the last snapshot (us)
+    UInt32 avgTime;         // Average time per snapshot (us)
+    UInt32 maxTime;         // Longest time to take a snapshot (us)
+} RewindBufferStats;
+
+RewindBuffer* rewindBufferCreate(int maxSnapshots, UInt32 arenaSize, int keyframeInterval);
+void rewindBufferDestroy(RewindBuffer* rb);
+
+// A write with append == 0 starts a new snapshot, which is added to the
+// buffer by rewindBufferCommit().
+int rewindBufferSaveFile(RewindBuffer* rb, const char* fileName, int append, void* buffer, int size);
+int rewindBufferCommit(RewindBuffer* rb);
+
+// Removes the newest snapshot from the buffer and makes its files
+// available to rewindBufferLoadFile().
+int rewindBufferRewind(RewindBuffer* rb);
+void* rewindBufferLoadFile(RewindBuffer* rb, const char* fileName, int* size);
+
+int rewindBufferGetCount(RewindBuffer* rb);
+void rewindBufferGetStats(RewindBuffer* rb, RewindBufferStats* stats);
+
+#endif /* REWIND_BUFFER_H */
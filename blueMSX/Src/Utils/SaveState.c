@@ -26,7 +26,11 @@
 ******************************************************************************
 */
 #include "SaveState.h"
+#include "Board.h"
+#include "RewindBuffer.h"
 #include "ziphelper.h"
+#include "ArchThread.h"
+#include "ArchEvent.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -34,15 +38,109 @@
 // Must be power of 2
 #define ALLOC_BLOCK_SIZE 256
 
+// Number of states that can wait for the writer thread
+#define WRITE_QUEUE_SIZE 4
+
+// Marks a tag that occurs more than once in a component. Lookups of
+// such tags fall back to the linear scan to keep the scan order.
+#define TAG_DUPLICATED 0xffffffff
+
 struct SaveState {
     UInt32 allocSize;
     UInt32 size;
     UInt32 offset;
     UInt32 *buffer;
     char   fileName[64];
+    BoardContext* board;
+    int    ownsBuffer;
+    UInt32 *index;
+    UInt32 indexMask;
 };
 
-static char stateFile[512];
+//
+// Binary container. All components are stored after each other in one
+// buffer which is written to disk (optionally compressed) in one go by
+// saveStateDestroy(). Each component is stored as
+//
+//   UInt32 nameHash, UInt32 nameLength, UInt32 size, name, data
+//
+// with name and data padded to 32 bit so components can be read in
+// place. A container file starts with a ContainerHeader.
+//
+
+#define CONTAINER_MAGIC   0x53584d42 // "BMXS"
+#define CONTAINER_VERSION 1
+#define CONTAINER_FLAG_COMPRESSED 1
+
+typedef struct {
+    UInt32 magic;
+    UInt32 version;
+    UInt32 flags;
+    UInt32 size;
+    UInt32 storedSize;
+} ContainerHeader;
+
+typedef struct {
+    int     active;
+    int     writing;
+    int     started;
+    int     async;
+    int     borrowed;
+    UInt8*  buffer;
+    UInt32  size;
+    UInt32  allocSize;
+    UInt32* index;
+    UInt32  indexMask;
+    SaveStateFormat   format;
+    SaveStateCallback callback;
+    void*             ref;
+} Container;
+
+//
+// Asynchronous writer. States created with saveStateCreateForAsyncWrite()
+// are serialized into a container in memory. saveStateDestroy() hands
+// the container to the writer thread, which compresses it and writes
+// it to disk. The queue is bounded; when it is full saveStateDestroy()
+// blocks until the oldest queued state is written. The thread is
+// started with the first queued state and runs until
+// saveStateStopWriter().
+//
+
+typedef struct {
+    char              fileName[512];
+    SaveStateFormat   format;
+    UInt8*            buffer;
+    UInt32            size;
+    SaveStateCallback callback;
+    void*             ref;
+} WriteJob;
+
+static struct {
+    void*    thread;
+    void*    lock;
+    void*    jobSem;
+    void*    freeSem;
+    void*    idleSem;
+    WriteJob jobs[WRITE_QUEUE_SIZE];
+    int      head;
+    int      tail;
+    int      pending;
+    int      idleWaiters;
+    int      quit;
+} writer;
+
+// The state file being read or written by a board
+struct SaveStateContext {
+    char            stateFile[512];
+    SaveStateFormat writeFormat;
+    Container       container;
+
+    struct {
+        char fileName[64];
+        int  count;
+    } saveFileTable[128];
+    int tableCount;
+};
 
 static UInt32 tagFromName(const char* tagName)
 {
@@ -76,26 +174,18 @@ static void checkTag(SaveState* state, const char* tagName)
 #define checkTag(state, tagName)
 #endif
 
-static struct {
-    char fileName[64];
-    int  count;
-} saveFileTable[128];
-
-static int tableCount;
-
-static char* getIndexedFilename(const char* fileName)
+static char* getIndexedFilename(SaveStateContext* ctx, const char* fileName, char* indexedFileName)
 {
-    static char indexedFileName[64];
     int i;
 
-    for (i = 0; i < tableCount; i++) {
-        if (0 == strcmp(fileName, saveFileTable[i].fileName)) {
-            sprintf(indexedFileName, "%s_%.2d", fileName, ++saveFileTable[i].count);
+    for (i = 0; i < ctx->tableCount; i++) {
+        if (0 == strcmp(fileName, ctx->saveFileTable[i].fileName)) {
+            sprintf(indexedFileName, "%s_%.2d", fileName, ++ctx->saveFileTable[i].count);
             return indexedFileName;
         }
     }
-    strcpy(saveFileTable[tableCount].fileName, fileName);
-    saveFileTable[tableCount++].count = 0;
+    strcpy(ctx->saveFileTable[ctx->tableCount].fileName, fileName);
+    ctx->saveFileTable[ctx->tableCount++].count = 0;
 
     strcpy(indexedFileName, fileName);
     strcat(indexedFileName, "_00");
@@ -103,58 +193,724 @@ static char* getIndexedFilename(const char* fileName)
     return indexedFileName;
 }
 
-void saveStateCreateForRead(const char* fileName)
+/////////////////////////////////////////////////////////////
+// Container
+
+static UInt32 align32(UInt32 size)
+{
+    return (size + sizeof(UInt32) - 1) & ~(sizeof(UInt32) - 1);
+}
+
+static void containerReset(SaveStateContext* ctx)
+{
+    if (!ctx->container.borrowed) {
+        free(ctx->container.buffer);
+    }
+    free(ctx->container.index);
+    memset(&ctx->container, 0, sizeof(ctx->container));
+}
+
+static void containerBuildIndex(SaveStateContext* ctx)
+{
+    UInt32 offset = 0;
+    UInt32 count = 0;
+    UInt32 indexSize = 16;
+
+    while (offset + 12 <= ctx->container.size) {
+        UInt32* entry = (UInt32*)(ctx->container.buffer + offset);
+        offset += 12 + align32(entry[1]) + align32(entry[2]);
+        count++;
+    }
+
+    while (indexSize < 2 * count) {
+        indexSize *= 2;
+    }
+    ctx->container.index     = (UInt32*)calloc(indexSize, sizeof(UInt32));
+    ctx->container.indexMask = indexSize - 1;
+
+    offset = 0;
+    while (offset + 12 <= ctx->container.size) {
+        UInt32* entry = (UInt32*)(ctx->container.buffer + offset);
+        UInt32 slot = entry[0] & ctx->container.indexMask;
+        while (ctx->container.index[slot] != 0) {
+            slot = (slot + 1) & ctx->container.indexMask;
+        }
+        ctx->container.index[slot] = offset + 1;
+        offset += 12 + align32(entry[1]) + align32(entry[2]);
+    }
+}
+
+static UInt32* containerFind(SaveStateContext* ctx, const char* fileName)
+{
+    UInt32 hash = tagFromName(fileName);
+    UInt32 slot;
+
+    if (ctx->container.index == NULL) {
+        return NULL;
+    }
+
+    for (slot = hash & ctx->container.indexMask; ctx->container.index[slot] != 0; slot = (slot + 1) & ctx->container.indexMask) {
+        UInt32* entry = (UInt32*)(ctx->container.buffer + ctx->container.index[slot] - 1);
+        if (entry[0] == hash && entry[1] == strlen(fileName) + 1 && 
+            0 == strcmp((char*)(entry + 3), fileName)) 
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// Makes the stored data of a container the current container
+static int containerSetData(SaveStateContext* ctx, ContainerHeader* header, void* data, int ownsData)
+{
+    if (header->flags & CONTAINER_FLAG_COMPRESSED) {
+        unsigned long size = header->size;
+        ctx->container.buffer = zipUncompress(data, header->storedSize, &size);
+        if (ownsData) {
+            free(data);
+        }
+        if (ctx->container.buffer == NULL) {
+            return 0;
+        }
+    }
+    else if (ownsData) {
+        ctx->container.buffer = data;
+    }
+    else {
+        ctx->container.buffer = malloc(header->size);
+        memcpy(ctx->container.buffer, data, header->size);
+    }
+
+    ctx->container.size      = header->size;
+    ctx->container.allocSize = header->size;
+
+    return 1;
+}
+
+static int containerLoad(SaveStateContext* ctx, const char* fileName)
+{
+    ContainerHeader header;
+    FILE* file;
+    void* data;
+
+    saveStateFlush();
+
+    file = fopen(fileName, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+
+    if (fread(&header, 1, sizeof(header), file) != sizeof(header) || 
+        header.magic != CONTAINER_MAGIC || header.version != CONTAINER_VERSION) 
+    {
+        fclose(file);
+        return 0;
+    }
+
+    data = malloc(header.storedSize);
+    if (data == NULL || fread(data, 1, header.storedSize, file) != header.storedSize) {
+        free(data);
+        fclose(file);
+        return 0;
+    }
+    fclose(file);
+
+    return containerSetData(ctx, &header, data, 1);
+}
+
+// Writes a container buffer to disk in the given format
+static int containerSave(const char* fileName, SaveStateFormat format, UInt8* buffer, UInt32 size)
+{
+    ContainerHeader header;
+    void* data = buffer;
+    unsigned long storedSize = size;
+    int success = 0;
+    FILE* file;
+
+    if (format == SAVESTATE_FORMAT_ZIP) {
+        UInt32 offset = 0;
+        success = 1;
+        while (offset + 12 <= size) {
+            UInt32* entry = (UInt32*)(buffer + offset);
+            success &= zipSaveFile(fileName, (char*)(entry + 3), offset > 0, 
+                                   (UInt8*)(entry + 3) + align32(entry[1]), entry[2]);
+            offset += 12 + align32(entry[1]) + align32(entry[2]);
+        }
+        return success;
+    }
+
+    header.magic   = CONTAINER_MAGIC;
+    header.version = CONTAINER_VERSION;
+    header.flags   = 0;
+    header.size    = size;
+
+    if (format == SAVESTATE_FORMAT_BINARY_COMPRESSED) {
+        void* compressed = zipCompress(buffer, size, &storedSize);
+        if (compressed != NULL) {
+            data = compressed;
+            header.flags |= CONTAINER_FLAG_COMPRESSED;
+        }
+        else {
+            storedSize = size;
+        }
+    }
+    header.storedSize = storedSize;
+
+    file = fopen(fileName, "wb");
+    if (file != NULL) {
+        success = fwrite(&header, 1, sizeof(header), file) == sizeof(header) &&
+                  fwrite(data, 1, storedSize, file) == storedSize;
+        success &= fclose(file) == 0;
+    }
+
+    if (data != buffer) {
+        free(data);
+    }
+
+    return success;
+}
+
+static int containerWrite(SaveStateContext* ctx, const char* fileName, int append, void* buffer, int size)
+{
+    UInt32 nameLength = strlen(fileName) + 1;
+    UInt32 entrySize  = 12 + align32(nameLength) + align32(size);
+    UInt32* entry;
+
+    if (!ctx->container.started) {
+        ctx->container.started = 1;
+        // Appending to an existing zip keeps it a zip
+        if (append && !containerLoad(ctx, ctx->stateFile)) {
+            FILE* file = fopen(ctx->stateFile, "rb");
+            if (file != NULL) {
+                fclose(file);
+                ctx->container.active = 0;
+                return zipSaveFile(ctx->stateFile, fileName, append, buffer, size);
+            }
+        }
+    }
+    if (!append) {
+        ctx->container.size = 0;
+    }
+
+    if (ctx->container.size + entrySize > ctx->container.allocSize) {
+        ctx->container.allocSize = 2 * (ctx->container.size + entrySize);
+        ctx->container.buffer = realloc(ctx->container.buffer, ctx->container.allocSize);
+    }
+
+    entry = (UInt32*)(ctx->container.buffer + ctx->container.size);
+    memset(entry, 0, entrySize);
+    entry[0] = tagFromName(fileName);
+    entry[1] = nameLength;
+    entry[2] = size;
+    memcpy(entry + 3, fileName, nameLength);
+    memcpy((UInt8*)(entry + 3) + align32(nameLength), buffer, size);
+
+    ctx->container.size += entrySize;
+
+    return 1;
+}
+
+/////////////////////////////////////////////////////////////
+// Writer thread
+
+static void writerThread()
+{
+    for (;;) {
+        WriteJob* job;
+        int success;
+
+        archSemaphoreWait(writer.jobSem, -1);
+
+        // The stop request is signaled after the last queued job
+        archSemaphoreWait(writer.lock, -1);
+        if (writer.pending == 0 && writer.quit) {
+            archSemaphoreSignal(writer.lock);
+            break;
+        }
+        archSemaphoreSignal(writer.lock);
+
+        job = &writer.jobs[writer.tail];
+        success = containerSave(job->fileName, job->format, job->buffer, job->size);
+        free(job->buffer);
+
+        if (job->callback != NULL) {
+            job->callback(job->ref, job->fileName, success);
+        }
+
+        archSemaphoreWait(writer.lock, -1);
+        writer.tail = (writer.tail + 1) % WRITE_QUEUE_SIZE;
+        writer.pending--;
+        if (writer.pending == 0) {
+            while (writer.idleWaiters > 0) {
+                writer.idleWaiters--;
+                archSemaphoreSignal(writer.idleSem);
+            }
+        }
+        archSemaphoreSignal(writer.lock);
+
+        archSemaphoreSignal(writer.freeSem);
+    }
+}
+
+// Queues the container for the writer thread, which takes over the buffer
+static void writerQueue(SaveStateContext* ctx)
+{
+    WriteJob* job;
+
+    if (writer.thread == NULL) {
+        writer.lock    = archSemaphoreCreate(1);
+        writer.jobSem  = archSemaphoreCreate(0);
+        writer.freeSem = archSemaphoreCreate(WRITE_QUEUE_SIZE);
+        writer.idleSem = archSemaphoreCreate(0);
+        writer.thread  = archThreadCreate(writerThread, THREAD_PRIO_NORMAL);
+    }
+
+    archSemaphoreWait(writer.freeSem, -1);
+
+    archSemaphoreWait(writer.lock, -1);
+    job = &writer.jobs[writer.head];
+    strcpy(job->fileName, ctx->stateFile);
+    job->format   = ctx->container.format;
+    job->buffer   = ctx->container.buffer;
+    job->size     = ctx->container.size;
+    job->callback = ctx->container.callback;
+    job->ref      = ctx->container.ref;
+    writer.head = (writer.head + 1) % WRITE_QUEUE_SIZE;
+    writer.pending++;
+    archSemaphoreSignal(writer.lock);
+
+    archSemaphoreSignal(writer.jobSem);
+
+    ctx->container.buffer = NULL;
+}
+
+/////////////////////////////////////////////////////////////
+// State files
+//
+// States with a file name starting with "mem" are kept in the rewind
+// buffer of the board, other states are zip files.
+
+static int stateFileSave(BoardContext* board, SaveStateContext* ctx, const char* fileName, int append, void* buffer, int size)
+{
+    if (strncmp(ctx->stateFile, "mem", 3) == 0) {
+        RewindBuffer* rb = boardGetRewindBuffer(board);
+        return rb != NULL ? rewindBufferSaveFile(rb, fileName, append, buffer, size) : 0;
+    }
+    return zipSaveFile(ctx->stateFile, fileName, append, buffer, size);
+}
+
+static void* stateFileLoad(BoardContext* board, SaveStateContext* ctx, const char* fileName, int* size)
+{
+    if (strncmp(ctx->stateFile, "mem", 3) == 0) {
+        RewindBuffer* rb = boardGetRewindBuffer(board);
+        *size = 0;
+        return rb != NULL ? rewindBufferLoadFile(rb, fileName, size) : NULL;
+    }
+    return zipLoadFile(ctx->stateFile, fileName, size);
+}
+
+/////////////////////////////////////////////////////////////
+// Tag index
+
+static void buildTagIndex(SaveState* state)
+{
+    UInt32 offset = 0;
+    UInt32 count = 0;
+    UInt32 indexSize = 16;
+
+    while (offset + 2 <= state->size) {
+        offset += 2 + (state->buffer[offset + 1] + sizeof(UInt32) - 1) / sizeof(UInt32);
+        count++;
+    }
+
+    while (indexSize < 2 * count) {
+        indexSize *= 2;
+    }
+    state->index     = (UInt32*)calloc(2 * indexSize, sizeof(UInt32));
+    state->indexMask = indexSize - 1;
+
+    offset = 0;
+    while (offset + 2 <= state->size) {
+        UInt32 tag  = state->buffer[offset];
+        UInt32 slot = tag & state->indexMask;
+        while (state->index[2 * slot + 1] != 0 && state->index[2 * slot] != tag) {
+            slot = (slot + 1) & state->indexMask;
+        }
+        if (state->index[2 * slot + 1] != 0) {
+            state->index[2 * slot + 1] = TAG_DUPLICATED;
+        }
+        else {
+            state->index[2 * slot]     = tag;
+            state->index[2 * slot + 1] = offset + 1;
+        }
+        offset += 2 + (state->buffer[offset + 1] + sizeof(UInt32) - 1) / sizeof(UInt32);
+    }
+}
+
+// Returns the offset + 1 of the element with the given tag, 0 if not 
+// found or TAG_DUPLICATED if the tag needs a linear scan.
+static UInt32 findTag(SaveState* state, UInt32 tag)
+{
+    UInt32 slot = tag & state->indexMask;
+
+    while (state->index[2 * slot + 1] != 0) {
+        if (state->index[2 * slot] == tag) {
+            return state->index[2 * slot + 1];
+        }
+        slot = (slot + 1) & state->indexMask;
+    }
+    return 0;
+}
+
+/////////////////////////////////////////////////////////////
+
+SaveStateContext* saveStateContextCreate(void)
+{
+    SaveStateContext* ctx = calloc(1, sizeof(SaveStateContext));
+
+    ctx->writeFormat = SAVESTATE_FORMAT_ZIP;
+
+    return ctx;
+}
+
+void saveStateContextDestroy(SaveStateContext* ctx)
 {
-    tableCount = 0;
-    strcpy(stateFile, fileName);
+    containerReset(ctx);
+    free(ctx);
+}
+
+void saveStateSetFormat(BoardContext* board, SaveStateFormat format)
+{
+    SaveStateContext* ctx = boardGetSaveState(board);
+
+    ctx->writeFormat = format;
+}
+
+SaveStateFormat saveStateGetFormat(BoardContext* board)
+{
+    SaveStateContext* ctx = boardGetSaveState(board);
+
+    return ctx->writeFormat;
+}
+
+void saveStateCreateForRead(BoardContext* board, const char* fileName)
+{
+    SaveStateContext* ctx = boardGetSaveState(board);
+
+    if (strncmp(fileName, "mem", 3) != 0) {
+        saveStateFlush();
+    }
+
+    ctx->tableCount = 0;
+    strcpy(ctx->stateFile, fileName);
+
+    containerReset(ctx);
+    if (strncmp(fileName, "mem", 3) != 0 && containerLoad(ctx, fileName)) {
+        ctx->container.active = 1;
+        containerBuildIndex(ctx);
+        return;
+    }
+
     zipCacheReadOnlyZip(fileName);
 }
 
-void saveStateCreateForWrite(const char* fileName)
+void saveStateCreateForWrite(BoardContext* board, const char* fileName)
 {
-    tableCount = 0;
-    strcpy(stateFile, fileName);
+    SaveStateContext* ctx = boardGetSaveState(board);
+
+    ctx->tableCount = 0;
+    strcpy(ctx->stateFile, fileName);
+
+    containerReset(ctx);
+    if (ctx->writeFormat != SAVESTATE_FORMAT_ZIP && strncmp(fileName, "mem", 3) != 0) {
+        ctx->container.active  = 1;
+        ctx->container.writing = 1;
+        ctx->container.format  = ctx->writeFormat;
+    }
 }
 
-void saveStateDestroy(void)
+void saveStateCreateForAsyncWrite(BoardContext* board, const char* fileName, SaveStateCallback callback, void* ref)
 {
+    SaveStateContext* ctx = boardGetSaveState(board);
+
+    saveStateCreateForWrite(board, fileName);
+
+    // The in memory states are always written synchronously
+    if (strncmp(fileName, "mem", 3) != 0) {
+        ctx->container.active  = 1;
+        ctx->container.writing = 1;
+        ctx->container.async   = 1;
+        ctx->container.format  = ctx->writeFormat;
+    }
+    ctx->container.callback = callback;
+    ctx->container.ref      = ref;
+}
+
+void saveStateDestroy(BoardContext* board)
+{
+    SaveStateContext* ctx = boardGetSaveState(board);
+
+    if (ctx->container.active && ctx->container.writing && ctx->container.async) {
+        writerQueue(ctx);
+    }
+    else {
+        int success = 1;
+        if (ctx->container.active && ctx->container.writing) {
+            success = containerSave(ctx->stateFile, ctx->container.format, ctx->container.buffer, ctx->container.size);
+        }
+        if (ctx->container.callback != NULL) {
+            ctx->container.callback(ctx->container.ref, ctx->stateFile, success);
+        }
+    }
+    containerReset(ctx);
+
     zipCacheReadOnlyZip(NULL);
 }
 
-SaveState* saveStateOpenForRead(const char* fileName) {
+void saveStateCreateForImageWrite(BoardContext* board)
+{
+    SaveStateContext* ctx = boardGetSaveState(board);
+
+    ctx->tableCount = 0;
+    ctx->stateFile[0] = 0;
+
+    containerReset(ctx);
+    ctx->container.active  = 1;
+    ctx->container.writing = 1;
+    ctx->container.started = 1;
+    ctx->container.format  = SAVESTATE_FORMAT_BINARY_COMPRESSED;
+}
+
+void* saveStateDestroyImage(BoardContext* board, int* size)
+{
+    SaveStateContext* ctx = boardGetSaveState(board);
+    ContainerHeader header;
+    unsigned long storedSize;
+    void* compressed;
+    UInt8* image = NULL;
+
+    header.magic   = CONTAINER_MAGIC;
+    header.version = CONTAINER_VERSION;
+    header.flags   = CONTAINER_FLAG_COMPRESSED;
+    header.size    = ctx->container.size;
+
+    *size = 0;
+
+    compressed = zipCompress(ctx->container.buffer, ctx->container.size, &storedSize);
+    if (compressed != NULL) {
+        header.storedSize = storedSize;
+        image = malloc(sizeof(header) + storedSize);
+        memcpy(image, &header, sizeof(header));
+        memcpy(image + sizeof(header), compressed, storedSize);
+        *size = sizeof(header) + storedSize;
+        free(compressed);
+    }
+
+    containerReset(ctx);
+
+    return image;
+}
+
+int saveStateCreateForImageRead(BoardContext* board, void* image, int size)
+{
+    SaveStateContext* ctx = boardGetSaveState(board);
+    ContainerHeader* header = (ContainerHeader*)image;
+
+    ctx->tableCount = 0;
+    ctx->stateFile[0] = 0;
+
+    containerReset(ctx);
+
+    if (size < sizeof(ContainerHeader) || header->magic != CONTAINER_MAGIC || 
+        header->version != CONTAINER_VERSION || 
+        size - sizeof(ContainerHeader) < header->storedSize ||
+        !containerSetData(ctx, header, header + 1, 0)) 
+    {
+        return 0;
+    }
+
+    ctx->container.active = 1;
+    containerBuildIndex(ctx);
+
+    return 1;
+}
+
+void saveStateCreateForRawWrite(BoardContext* board, void* buffer, int allocSize)
+{
+    SaveStateContext* ctx = boardGetSaveState(board);
+
+    ctx->tableCount = 0;
+    ctx->stateFile[0] = 0;
+
+    containerReset(ctx);
+    ctx->container.active    = 1;
+    ctx->container.writing   = 1;
+    ctx->container.started   = 1;
+    ctx->container.format    = SAVESTATE_FORMAT_BINARY;
+    ctx->container.buffer    = buffer;
+    ctx->container.allocSize = allocSize;
+}
+
+void* saveStateDestroyRaw(BoardContext* board, int* size, int* allocSize)
+{
+    SaveStateContext* ctx = boardGetSaveState(board);
+    void* buffer = ctx->container.buffer;
+
+    *size      = ctx->container.size;
+    *allocSize = ctx->container.allocSize;
+
+    ctx->container.buffer = NULL;
+    containerReset(ctx);
+
+    return buffer;
+}
+
+void saveStateCreateForRawRead(BoardContext* board, void* buffer, int size)
+{
+    SaveStateContext* ctx = boardGetSaveState(board);
+
+    ctx->tableCount = 0;
+    ctx->stateFile[0] = 0;
+
+    containerReset(ctx);
+    ctx->container.active    = 1;
+    ctx->container.borrowed  = 1;
+    ctx->container.buffer    = buffer;
+    ctx->container.size      = size;
+    ctx->container.allocSize = size;
+    containerBuildIndex(ctx);
+}
+
+void saveStateFlush(void)
+{
+    if (writer.thread == NULL) {
+        return;
+    }
+
+    archSemaphoreWait(writer.lock, -1);
+    if (writer.pending == 0) {
+        archSemaphoreSignal(writer.lock);
+        return;
+    }
+    writer.idleWaiters++;
+    archSemaphoreSignal(writer.lock);
+
+    archSemaphoreWait(writer.idleSem, -1);
+}
+
+void saveStateStopWriter(void)
+{
+    if (writer.thread == NULL) {
+        return;
+    }
+
+    archSemaphoreWait(writer.lock, -1);
+    writer.quit = 1;
+    archSemaphoreSignal(writer.lock);
+    archSemaphoreSignal(writer.jobSem);
+
+    archThreadJoin(writer.thread, -1);
+    archThreadDestroy(writer.thread);
+
+    archSemaphoreDestroy(writer.lock);
+    archSemaphoreDestroy(writer.jobSem);
+    archSemaphoreDestroy(writer.freeSem);
+    archSemaphoreDestroy(writer.idleSem);
+
+    memset(&writer, 0, sizeof(writer));
+}
+
+int saveStateWriteFile(BoardContext* board, const char* fileName, int append, void* buffer, int size)
+{
+    SaveStateContext* ctx = boardGetSaveState(board);
+
+    if (ctx->container.active) {
+        return containerWrite(ctx, fileName, append, buffer, size);
+    }
+    return stateFileSave(board, ctx, fileName, append, buffer, size);
+}
+
+void* saveStateReadFile(BoardContext* board, const char* fileName, int* size)
+{
+    SaveStateContext* ctx = boardGetSaveState(board);
+
+    if (ctx->container.active) {
+        UInt32* entry = containerFind(ctx, fileName);
+        void* buffer;
+
+        *size = 0;
+        if (entry == NULL || entry[2] == 0) {
+            return NULL;
+        }
+        buffer = malloc(entry[2]);
+        memcpy(buffer, (UInt8*)(entry + 3) + align32(entry[1]), entry[2]);
+        *size = entry[2];
+        return buffer;
+    }
+    return stateFileLoad(board, ctx, fileName, size);
+}
+
+SaveState* saveStateOpenForRead(BoardContext* board, const char* fileName) {
+    SaveStateContext* ctx = boardGetSaveState(board);
     SaveState* state = (SaveState*)malloc(sizeof(SaveState));
     Int32 size = 0;
-    void* buffer = zipLoadFile(stateFile, getIndexedFilename(fileName), &size);
+    void* buffer = NULL;
+    char indexedFileName[64];
+
+    getIndexedFilename(ctx, fileName, indexedFileName);
+
+    state->ownsBuffer = 1;
+
+    if (ctx->container.active) {
+        // Components are read in place from the container
+        UInt32* entry = containerFind(ctx, indexedFileName);
+        if (entry != NULL) {
+            buffer = (UInt8*)(entry + 3) + align32(entry[1]);
+            size   = entry[2];
+            state->ownsBuffer = 0;
+        }
+    }
+    else {
+        buffer = stateFileLoad(board, ctx, indexedFileName, &size);
+    }
 
     state->allocSize = size;
     state->buffer = buffer;
     state->size = size / sizeof(UInt32);
     state->offset = 0;
     state->fileName[0] = 0;
+    state->board = board;
+
+    buildTagIndex(state);
 
     return state;
 }
 
-SaveState* saveStateOpenForWrite(const char* fileName) {
+SaveState* saveStateOpenForWrite(BoardContext* board, const char* fileName) {
+    SaveStateContext* ctx = boardGetSaveState(board);
     SaveState* state = (SaveState*)malloc(sizeof(SaveState));
 
-    state->size      = 0;
-    state->offset    = 0;
-    state->buffer    = NULL;
-    state->allocSize = 0;
+    state->size       = 0;
+    state->offset     = 0;
+    state->buffer     = NULL;
+    state->allocSize  = 0;
+    state->ownsBuffer = 1;
+    state->index      = NULL;
+    state->board      = board;
 
-    strcpy(state->fileName, getIndexedFilename(fileName));
+    getIndexedFilename(ctx, fileName, state->fileName);
 
     return state;
 }
 
 void saveStateClose(SaveState* state) {
     if (state->fileName[0]) {
-        zipSaveFile(stateFile, state->fileName, 1, state->buffer, state->offset * sizeof(UInt32));
+        saveStateWriteFile(state->board, state->fileName, 1, state->buffer, state->offset * sizeof(UInt32));
     }
-    if (state->buffer != NULL) {
+    if (state->buffer != NULL && state->ownsBuffer) {
         free(state->buffer);
     }
+    free(state->index);
     state->allocSize = 0;
     free(state);
 }
@@ -203,6 +959,12 @@ UInt32 saveStateGet(SaveState* state, const char* tagName, UInt32 defValue)
         return value;
     }
 
+    offset = findTag(state, tag);
+    if (offset != TAG_DUPLICATED) {
+        return offset != 0 ? state->buffer[offset + 1] : value;
+    }
+    offset = startOffset;
+
     do {
         elemTag = state->buffer[offset++];
         elemLen = state->buffer[offset++];
@@ -234,6 +996,19 @@ void saveStateGetBuffer(SaveState* state, const char* tagName, void* buffer, UIn
         return;
     }
 
+    offset = findTag(state, tag);
+    if (offset != TAG_DUPLICATED) {
+        if (offset != 0) {
+            offset--;
+            elemLen = state->buffer[offset + 1];
+            memcpy(buffer, state->buffer + offset + 2, length < elemLen ? length : elemLen);
+            offset += 2 + (elemLen + sizeof(UInt32) - 1) / sizeof(UInt32);
+            state->offset = offset < state->size ? offset : 0;
+        }
+        return;
+    }
+    offset = startOffset;
+
     do {
         elemTag = state->buffer[offset++];
         elemLen = state->buffer[offset++];
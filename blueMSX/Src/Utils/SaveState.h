@@ -32,12 +32,67 @@
 
 typedef struct SaveState SaveState;
 
-void saveStateCreateForRead(const char* fileName);
-void saveStateCreateForWrite(const char* fileName);
-void saveStateDestroy(void);
+// The state file being read or written by a board, found with 
+// boardGetSaveState(). The functions below that take a board work on 
+// its state file. The writer thread is shared by all boards.
+typedef struct SaveStateContext SaveStateContext;
 
-SaveState* saveStateOpenForRead(const char* fileName);
-SaveState* saveStateOpenForWrite(const char* fileName);
+SaveStateContext* saveStateContextCreate(void);
+void saveStateContextDestroy(SaveStateContext* ctx);
+
+typedef enum {
+    SAVESTATE_FORMAT_ZIP,               // One zip entry per component
+    SAVESTATE_FORMAT_BINARY,            // All components in one buffer
+    SAVESTATE_FORMAT_BINARY_COMPRESSED  // Binary, compressed in one pass
+} SaveStateFormat;
+
+// Selects the format of states written after the call. States of 
+// either format can be read.
+void saveStateSetFormat(BoardContext* board, SaveStateFormat format);
+SaveStateFormat saveStateGetFormat(BoardContext* board);
+
+// Called when a state is written. success is 0 if the write failed.
+typedef void (*SaveStateCallback)(void* ref, const char* fileName, int success);
+
+void saveStateCreateForRead(BoardContext* board, const char* fileName);
+void saveStateCreateForWrite(BoardContext* board, const char* fileName);
+void saveStateDestroy(BoardContext* board);
+
+// Like saveStateCreateForWrite() but the state is built in memory and
+// saveStateDestroy() queues it for compression and writing on a worker 
+// thread. The callback is called from the worker thread when the file 
+// is written. saveStateFlush() waits until all queued states are 
+// written; it is called before a state file is read. 
+// saveStateStopWriter() writes the queued states and stops the worker
+// thread; it is called on exit.
+void saveStateCreateForAsyncWrite(BoardContext* board, const char* fileName, SaveStateCallback callback, void* ref);
+void saveStateFlush(void);
+void saveStateStopWriter(void);
+
+// Builds a state in memory. saveStateDestroyImage() ends the write and
+// returns the compressed state file image, which is freed by the caller.
+// An image is read back with saveStateCreateForImageRead() and closed
+// with saveStateDestroy().
+void saveStateCreateForImageWrite(BoardContext* board);
+void* saveStateDestroyImage(BoardContext* board, int* size);
+int saveStateCreateForImageRead(BoardContext* board, void* image, int size);
+
+// Builds an uncompressed state in a buffer owned by the caller, which
+// is grown with realloc() as needed. saveStateDestroyRaw() ends the write
+// and returns the buffer with the size of the state, so a buffer reused
+// for every state is only reallocated when the state grows. A raw state
+// is read in place with saveStateCreateForRawRead() and closed with
+// saveStateDestroy(), which leaves the buffer to the caller.
+void saveStateCreateForRawWrite(BoardContext* board, void* buffer, int allocSize);
+void* saveStateDestroyRaw(BoardContext* board, int* size, int* allocSize);
+void saveStateCreateForRawRead(BoardContext* board, void* buffer, int size);
+
+// Reads and writes raw files in the current state file
+int saveStateWriteFile(BoardContext* board, const char* fileName, int append, void* buffer, int size);
+void* saveStateReadFile(BoardContext* board, const char* fileName, int* size);
+
+SaveState* saveStateOpenForRead(BoardContext* board, const char* fileName);
+SaveState* saveStateOpenForWrite(BoardContext* board, const char* fileName);
 void saveStateClose(SaveState* state);
 
 UInt32 saveStateGet(SaveState* state, const char* tagName, UInt32 defValue);
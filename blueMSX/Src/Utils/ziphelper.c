@@ -55,357 +55,6 @@ static void toLower(char* str) {
     }
 }
 
-#if 1
-
-#define MAX_FILES_IN_ZIP 64
-
-typedef struct 
-{
-    char  filename[32];
-    int   size;
-    char* buffer;
-} MemFile;
-
-typedef struct 
-{
-    char    zipName[32];
-    MemFile* memFiles[MAX_FILES_IN_ZIP];
-    int     count;
-} MemZipFile;
-
-static MemZipFile** memZipFiles = NULL;
-static int memZipFileCount = 0;
-
-void memZipFileDestroy(MemZipFile* memZipFile)
-{
-    int i;
-
-    if (memZipFile == NULL)
-    {
-        return;
-    }
-
-    // Remove node
-    for (i = 0; i < memZipFileCount; i++)
-    {
-        if (memZipFiles[i] == memZipFile)
-        {
-            memZipFiles[i] = NULL;
-        }
-    }
-
-    // Delete file contents
-    for (i = 0; i < memZipFile->count; i++)
-    {
-        if (memZipFile->memFiles[i]->buffer != NULL)
-        {
-            free(memZipFile->memFiles[i]->buffer);
-        }
-        free(memZipFile->memFiles[i]);
-    }
-    free(memZipFile);
-}
-
-void memZipFileSystemCreate(int maxFiles)
-{
-    memZipFileCount = maxFiles;
-    memZipFiles = (MemZipFile**) calloc(memZipFileCount, sizeof(MemZipFile*));
-}
-
-void memZipFileSystemDestroy()
-{
-    int i;
-
-    if (memZipFileCount == 0)
-    {
-        return;
-    }
-
-    for (i = 0; i < memZipFileCount; i++)
-    {
-        memZipFileDestroy(memZipFiles[i]);
-    }
-    free(memZipFiles);
-
-    memZipFileCount = 0;
-}
-
-MemZipFile* memZipFileFind(const char* zipName)
-{
-    int i;
-    for (i = 0; i < memZipFileCount; i++)
-    {
-        if (memZipFiles[i] != NULL && 
-            strcmp(memZipFiles[i]->zipName, zipName) == 0)
-        {
-            return memZipFiles[i];
-        }
-    }
-    return NULL;
-}
-
-MemZipFile* memZipFileCreate(const char* zipName)
-{
-    int i;
-
-    for (i = 0; i < memZipFileCount; i++)
-    {
-        if (memZipFiles[i] == NULL)
-        {
-            memZipFiles[i] = malloc(sizeof(MemZipFile));
-            strcpy(memZipFiles[i]->zipName, zipName);
-            memZipFiles[i]->count = 0;
-            return memZipFiles[i];
-        }
-    }
-    return NULL;
-}
-
-MemFile* memFileFindInZip(MemZipFile* memZipFile, const char* filename)
-{
-    if (memZipFile != NULL)
-    {
-        int i;
-        for (i = 0; i < memZipFile->count; i++)
-        {
-            if (strcmp(memZipFile->memFiles[i]->filename, filename) == 0)
-            {
-                return memZipFile->memFiles[i];
-            }
-        }
-    }
-    return NULL;
-}
-
-void* memFileLoad(const char* zipName, const char* filename, int* size)
-{
-    MemFile* memFile = memFileFindInZip(memZipFileFind(zipName), filename);
-    if (memFile != NULL && memFile->size > 0)
-    {
-        void* buffer = malloc(memFile->size);
-        memcpy(buffer, memFile->buffer, memFile->size);
-        *size = memFile->size;
-        return buffer;
-    }
-    *size = 0;
-    return NULL;
-}
-
-int memFileSave(const char* zipName, const char* filename, int append, void* buffer, int size)
-{
-    MemZipFile* memZipFile = memZipFileFind(zipName);
-    MemFile* memFile;
-
-    if (!append)
-    {
-        memZipFileDestroy(memZipFile);
-        memZipFile = NULL;
-    }
-
-    if (memZipFile == NULL)
-    {
-        memZipFile = memZipFileCreate(zipName);
-    }
-
-    if (memZipFile == NULL || memZipFile->count == MAX_FILES_IN_ZIP)
-    {
-        return 0;
-    }
-    
-    memFile = malloc(sizeof(MemFile));
-    memFile->buffer = malloc(size);
-    memcpy(memFile->buffer, buffer, size);
-    memFile->size = size;
-    strcpy(memFile->filename, filename);
-
-    memZipFile->memFiles[memZipFile->count++] = memFile;
-
-    return 1;
-}
-
-#else
-//////////////////////////////////////////
-// Memory zip files
-
-typedef struct {
-    char  filename[32];
-    void* data;
-    int   size;
-    unsigned long compSize;
-} MemFile;
-
-typedef struct {
-    char    zipName[32];
-    MemFile memFile[32];
-    int     count;
-} MemZipFile;
-
-MemZipFile* memZipFileCreate(const char* zipName)
-{
-    MemZipFile* zipFile = (MemZipFile*)malloc(sizeof(MemZipFile));
-    if (zipFile == NULL) {
-        return NULL;
-    }
-    strcpy(zipFile->zipName, zipName);
-    zipFile->count = 0;
-
-    return zipFile;
-}
-
-void memZipFileErase(MemZipFile* zipFile)
-{
-    int i;
-    for (i = 0; i < zipFile->count; i++) {
-        free(zipFile->memFile[i].data);
-    }
-    zipFile->count = 0;
-}
-
-void memZipFileDestroy(MemZipFile* zipFile)
-{
-    memZipFileErase(zipFile);
-    free(zipFile);
-}
-
-void* memZipFileRead(MemZipFile* zipFile, const char* filename, int* size)
-{
-    int i;
-    *size = 0;
-    for (i = 0; i < zipFile->count; i++) {
-        if (strcmp(filename, zipFile->memFile[i].filename) == 0) {
-            if (zipFile->memFile[i].size) {
-                unsigned long sz = zipFile->memFile[i].size;
-                void* buf = zipUncompress(zipFile->memFile[i].data, zipFile->memFile[i].compSize, &sz);
-                if (buf) {
-                    *size = (int)sz;
-                    return buf;
-                }
-            }
-        }
-    }
-    return NULL;
-}
-
-int memZipFileWrite(MemZipFile* zipFile, const char* filename, void* buffer, int size)
-{
-    static const int MemFileCount = sizeof(zipFile->memFile) / sizeof(zipFile->memFile[0]);
-    unsigned long compSize;
-    void* compBuf;
-    MemFile* memFile = NULL;
-    int i;
-    for (i = 0; i < zipFile->count; i++) {
-        if (strcmp(filename, zipFile->memFile[i].filename) == 0) {
-            memFile = &zipFile->memFile[i];
-            free(memFile->data);
-        }
-    }
-    if (memFile == NULL && zipFile->count < MemFileCount) {
-        memFile = &zipFile->memFile[zipFile->count++];
-    }
-    if (memFile == NULL) {
-        return 0;
-    }
-
-    compBuf = zipCompress(buffer, size, &compSize);
-    memFile->data = malloc(compSize);
-    memcpy(memFile->data, compBuf, compSize);
-    memFile->size = memFile->data ? size : 0;
-    memFile->compSize = compSize;
-    strcpy(memFile->filename, filename);
-    free(compBuf);
-    
-    return 1;
-}
-
-//////////////////////////////////////////
-// Memory zip file system
-
-
-typedef struct {
-    MemZipFile** zipFiles;
-    int count;
-    int maxFiles;
-} MemZipFileSystem;
-
-MemZipFileSystem memZipFileSystem;
-
-void memZipFileSystemCreate(int maxFiles)
-{
-    memZipFileSystem.zipFiles = (MemZipFile**)malloc(maxFiles * sizeof(MemZipFile*));
-    memZipFileSystem.count    = 0;
-    memZipFileSystem.maxFiles = maxFiles;
-}
-
-void memZipFileSystemDestroy()
-{
-    int i;
-
-    if (memZipFileSystem.zipFiles == NULL) {
-        return;
-    }
-
-    for (i = 0; i < memZipFileSystem.count; i++) {
-        memZipFileDestroy(memZipFileSystem.zipFiles[i]);
-    }
-
-    free(memZipFileSystem.zipFiles);
-    memZipFileSystem.zipFiles = NULL;
-    memZipFileSystem.count = 0;
-}
-
-MemZipFile* memZipFileSystemOpen(const char* filename, int create) 
-{
-    int i;
-    for (i = 0; i < memZipFileSystem.count; i++) {
-        MemZipFile* zipFile = memZipFileSystem.zipFiles[i];
-        if (strcmp(filename, zipFile->zipName) == 0) {
-            return zipFile;
-        }
-    }
-    if (create) {
-        if (memZipFileSystem.count < memZipFileSystem.maxFiles) {
-            MemZipFile* zipFile = memZipFileCreate(filename);
-            if (zipFile != NULL) {
-                memZipFileSystem.zipFiles[memZipFileSystem.count++] = zipFile;
-            }
-            return zipFile;
-        }
-    }
-    return NULL;
-}
-
-////////////////////////////////////////
-
-void* memFileLoad(const char* zipName, const char* filename, int* size)
-{
-    MemZipFile* zipFile;
-
-    *size = 0;
-
-    zipFile = memZipFileSystemOpen(zipName, 0);
-    if (zipFile == NULL) {
-        return NULL;
-    }
-
-    return memZipFileRead(zipFile, filename, size);
-}
-
-int memFileSave(const char* zipName, const char* filename, int append, void* buffer, int size)
-{
-    MemZipFile* zipFile = memZipFileSystemOpen(zipName, 1);
-    if (zipFile == NULL) {
-        return 0;
-    }
-
-    if (!append) {
-        memZipFileErase(zipFile);
-    }
-
-    return memZipFileWrite(zipFile, filename, buffer, size);
-}
-
-#endif
-
 /******************************************************************************
 *** Description
 ***     Load a file in a zip file into memory.
@@ -489,9 +138,6 @@ static zlib_filefunc_def cacheFilefunc;
 
 void* zipLoadFile(const char* zipName, const char* fileName, int* size)
 {
-    if (strncmp(zipName, "mem", 3) == 0) {
-        return memFileLoad(zipName, fileName, size);
-    }
     if( cacheData != NULL && *cacheFile != '\0' && 0==strcmp(cacheFile, zipName) ) {
         return _zipLoadFile(cacheData, fileName, size, &cacheFilefunc);
     }else{
@@ -551,10 +197,6 @@ int zipSaveFile(const char* zipName, const char* fileName, int append, void* buf
     zip_fileinfo zi;
     int err;
 
-    if (strncmp(zipName, "mem", 3) == 0) {
-        return memFileSave(zipName, fileName, append, buffer, size);
-    }
-
     zip = zipOpen(zipName, append ? 2 : 0);
     if (zip == NULL) {
         return 0;
@@ -81,7 +81,7 @@ static void crtcRenderVideoBuffer(CRTC6845* crtc)
     int x, y;
     int charWidth, charHeight;
     int Nr  = crtc->registers.reg[CRTC_R9] + 1; // Number of rasters per character
-    FrameBuffer* crtcFrameBuffer = frameBufferFlipDrawFrame(); // Call once per frame
+    FrameBuffer* crtcFrameBuffer = frameBufferFlipDrawFrame(crtc->board); // Call once per frame
 
     crtc->frameCounter++;
 
@@ -143,6 +143,10 @@ static void crtcRenderVideoBuffer(CRTC6845* crtc)
             charAddress++;
         }
     }
+
+    for (y = 0; y < DISPLAY_HEIGHT; y++) {
+        frameBufferHashLine(crtcFrameBuffer, y);
+    }
 }
 
 static void crtcCursorUpdate(CRTC6845* crtc)
@@ -233,8 +237,8 @@ void crtcWriteLatch(CRTC6845* crtc, UInt8 value)
 void crtcMemWrite(CRTC6845* crtc, UInt16 address, UInt8 value)
 {
     crtc->vram[address & crtc->vramMask] = value;
-    if (!crtc->videoEnabled && boardGetVideoAutodetect() && videoManagerGetCount() > 1) {
-        videoManagerSetActive(crtc->videoHandle);
+    if (!crtc->videoEnabled && boardGetVideoAutodetect(crtc->board) && videoManagerGetCount(crtc->board) > 1) {
+        videoManagerSetActive(crtc->board, crtc->videoHandle);
     }
 }
 
@@ -253,12 +257,12 @@ static void crtc6845Reset(CRTC6845* crtc)
 
 static void crtc6845Destroy(CRTC6845* crtc)
 {
-    debugDeviceUnregister(crtc->debugHandle);
-    deviceManagerUnregister(crtc->deviceHandle);
-    videoManagerUnregister(crtc->videoHandle);
+    debugDeviceUnregister(crtc->board, crtc->debugHandle);
+    deviceManagerUnregister(crtc->board, crtc->deviceHandle);
+    videoManagerUnregister(crtc->board, crtc->videoHandle);
     boardTimerDestroy(crtc->timerDisplay);
 
-    frameBufferDataDestroy(crtc->frameBufferData);
+    frameBufferDataDestroy(crtc->board, crtc->frameBufferData);
 
     free(crtc->vram);
     free(crtc->romData);
@@ -300,7 +304,7 @@ static int dbgWriteRegister(CRTC6845* crtc, char* name, int regIndex, UInt32 val
     return 1;
 }
 
-CRTC6845* crtc6845Create(int frameRate, UInt8* romData, int size, int vramSize, 
+CRTC6845* crtc6845Create(BoardContext* board, int frameRate, UInt8* romData, int size, int vramSize, 
                          int charWidth, int charSpace, int charsPerLine, int borderChars)
 {
     CRTC6845* crtc;
@@ -308,6 +312,7 @@ CRTC6845* crtc6845Create(int frameRate, UInt8* romData, int size, int vramSize,
     int pixelZoom = 1;
 
     crtc = calloc(1, sizeof(CRTC6845));
+    crtc->board = board;
     
     crtc->vram = malloc(vramSize);
     crtc->vramMask = vramSize - 1;
@@ -340,23 +345,23 @@ CRTC6845* crtc6845Create(int frameRate, UInt8* romData, int size, int vramSize,
     }
 
     // Create and start frame refresh timer
-    crtc->timerDisplay = boardTimerCreate(crtcOnDisplay, crtc);
-    crtc->timeDisplay = boardSystemTime() + REFRESH_PERIOD;
+    crtc->timerDisplay = boardTimerCreate(board, crtcOnDisplay, crtc);
+    crtc->timeDisplay = boardSystemTime(board) + REFRESH_PERIOD;
     boardTimerAdd(crtc->timerDisplay, crtc->timeDisplay);
 
     // Initialize device
     {
         DeviceCallbacks callbacks = { crtc6845Destroy, crtc6845Reset, saveState, loadState };
         DebugCallbacks dbgCallbacks = { getDebugInfo, dbgWriteMemory, dbgWriteRegister, NULL };
-        crtc->deviceHandle = deviceManagerRegister(ROM_SVI328COL80, &callbacks, crtc);
-        crtc->debugHandle = debugDeviceRegister(DBGTYPE_VIDEO, langDbgDevCrtc6845(), &dbgCallbacks, crtc);
+        crtc->deviceHandle = deviceManagerRegister(board, ROM_SVI328COL80, &callbacks, crtc);
+        crtc->debugHandle = debugDeviceRegister(board, DBGTYPE_VIDEO, langDbgDevCrtc6845(), &dbgCallbacks, crtc);
     }
 
     // Initialize video frame buffer
     {
         VideoCallbacks videoCallbacks = { crtcVideoEnable, crtcVideoDisable };
-        crtc->frameBufferData = frameBufferDataCreate(crtc->displayWidth, DISPLAY_HEIGHT, pixelZoom);
-        crtc->videoHandle = videoManagerRegister("CRTC6845", crtc->frameBufferData, &videoCallbacks, crtc);
+        crtc->frameBufferData = frameBufferDataCreate(crtc->board, crtc->displayWidth, DISPLAY_HEIGHT, pixelZoom);
+        crtc->videoHandle = videoManagerRegister(board, "CRTC6845", crtc->frameBufferData, &videoCallbacks, crtc);
     }
 
     return crtc;
@@ -366,7 +371,7 @@ static void saveState(CRTC6845* crtc)
 {
     int index;
 
-    SaveState* state = saveStateOpenForWrite("crtc6845");
+    SaveState* state = saveStateOpenForWrite(crtc->board, "crtc6845");
 
     saveStateSet(state, "crtc->cursor.mode",         crtc->cursor.mode);
     saveStateSet(state, "crtc->cursor.rasterStart",  crtc->cursor.rasterStart);
@@ -400,7 +405,7 @@ static void loadState(CRTC6845* crtc)
 {
     int index;
 
-    SaveState* state = saveStateOpenForRead("crtc6845");
+    SaveState* state = saveStateOpenForRead(crtc->board, "crtc6845");
 
     crtc->cursor.mode         = saveStateGet(state, "crtc->cursor.mode",         0);
     crtc->cursor.rasterStart  = (UInt8)saveStateGet(state, "crtc->cursor.rasterStart",  0);
@@ -417,7 +422,7 @@ static void loadState(CRTC6845* crtc)
 
     crtc->frameCounter    = saveStateGet(state, "crtc->frameCounter",   0);
     crtc->frameRate       = saveStateGet(state, "crtc->frameRate",      0);
-    crtc->timeDisplay     = saveStateGet(state, "crtc->timeDisplay",    boardSystemTime() + 100);
+    crtc->timeDisplay     = saveStateGet(state, "crtc->timeDisplay",    boardSystemTime(crtc->board) + 100);
     crtc->vramMask        = saveStateGet(state, "crtc->vramMask",       0);
     crtc->romMask         = saveStateGet(state, "crtc->romMask",        0);
     crtc->charWidth       = saveStateGet(state, "crtc->charWidth",      0);
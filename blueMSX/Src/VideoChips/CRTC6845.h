@@ -50,6 +50,7 @@ typedef struct
 
 typedef struct
 {
+    BoardContext*    board;
     Crtc6845Cursor   cursor;
     Crtc6845Register registers;
     UInt32           frameCounter;
@@ -78,7 +79,7 @@ void crtcWriteLatch(CRTC6845* crtc, UInt8 value);
 void crtcMemWrite(CRTC6845* crtc, UInt16 address, UInt8 value);
 UInt8 crtcMemRead(CRTC6845* crtc, UInt16 address);
 
-CRTC6845* crtc6845Create(int frameRate, UInt8* romData, int size, int vramSize, 
+CRTC6845* crtc6845Create(BoardContext* board, int frameRate, UInt8* romData, int size, int vramSize, 
                          int charWidth, int charSpace, int charsPerLine, int borderChars);
 
 #endif
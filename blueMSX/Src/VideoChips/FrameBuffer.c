@@ -26,7 +26,8 @@
 ******************************************************************************
 */
 #include "FrameBuffer.h"
-#include "ArchEvent.h"
+#include "Board.h"
+#include "ArchThread.h"
 #include "ArchVideoIn.h"
 #include <stdlib.h>
 #include <string.h>
@@ -40,10 +41,41 @@
 #define MAX_FRAMES_PER_FRAMEBUFFER 4
 #endif
 
+// The flip state is a single int that the emulation thread (draw side)
+// and the presentation (view side) change with compare and swap, so no
+// side ever waits for the other. It holds:
+//   draw  - frame the video chip draws into, owned by the draw side
+//   view  - frame shown, owned by the view side
+//   order - the frames from the most to the least recently drawn. The
+//           frames never drawn are last, from the highest index down.
+//   drawn - one bit per frame that has been drawn
+//   count - number of frames in use
+//   mix   - frame the view side mixes with the view, if mixing is set
+// The draw side takes the least recently drawn frame that is not the
+// view, the view side the most recently drawn frame that is not the
+// draw frame. With four frames the view is mixed with the next most
+// recent complete frame, which is the frame that was dropped in between
+// when the view side missed one. This is the frame selection of the
+// semaphore based flips it replaced. The mix frame is reserved until
+// the mix is done, so the draw side doesn't take it in the meantime.
+// With three or four frames, draw is never view after the first draw
+// flip following a reset, so there is no tearing. With two frames the
+// draw side draws into the view.
+#define FLIP_DRAW(state)      (((state) >> 0) & 3)
+#define FLIP_VIEW(state)      (((state) >> 2) & 3)
+#define FLIP_ORDER(state, i)  (((state) >> (4 + 2 * (i))) & 3)
+#define FLIP_DRAWN(state, i)  (((state) >> (12 + (i))) & 1)
+#define FLIP_COUNT(state)     (((state) >> 16) & 7)
+#define FLIP_MIXING(state)    (((state) >> 19) & 1)
+#define FLIP_MIX(state)       (((state) >> 20) & 3)
+
+#define FLIP_SET_DRAW(state, draw) (((state) & ~0x03) | (draw))
+#define FLIP_SET_VIEW(state, view) (((state) & ~0x0c) | ((view) << 2))
+#define FLIP_SET_MIX(state, mix)   (((state) & ~0x380000) | (1 << 19) | ((mix) << 20))
+#define FLIP_CLEAR_MIX(state)      ((state) & ~0x380000)
+
 struct FrameBufferData {
-    int viewFrame;
-    int drawFrame;
-    int currentAge;
+    volatile int flipState;
 #ifndef WII
     int currentBlendFrame;
 #endif
@@ -53,8 +85,16 @@ struct FrameBufferData {
 #endif
 };
 
-static int curScanline = 0;
-static void* semaphore = NULL;
+struct FrameBufferContext {
+    FrameBufferData* currentBuffer;
+    FrameBufferMixMode mixMode;
+    FrameBufferMixMode mixMask;
+    int frameCount;
+    int curScanline;
+};
+
+// The deinterlace buffer and frame blending belong to the video
+// renderer of the front end
 static FrameBuffer* deintBuffer = NULL;
 #ifndef WII
 static int confBlendFrames = 0;
@@ -62,200 +102,194 @@ static int confBlendFrames = 0;
 
 static FrameBuffer* mixFrame(FrameBuffer* d, FrameBuffer* a, FrameBuffer* b, int pct);
 static FrameBuffer* mixFrameInterlace(FrameBuffer* d, FrameBuffer* a, FrameBuffer* b, int pct);
-static void frameBufferSuperimpose(FrameBuffer* a);
-static void frameBufferExternal(FrameBuffer* a);
+static void frameBufferSuperimpose(FrameBufferContext* ctx, FrameBuffer* a);
+static void frameBufferExternal(FrameBufferContext* ctx, FrameBuffer* a);
 static void frameBufferBlack(FrameBuffer* a);
-extern int getScreenCompletePercent();
+static void frameBufferClearHashes(FrameBuffer* a);
+extern int vdpGetScreenCompletePercent(BoardContext* board);
 
-static void waitSem() {
-    if (semaphore == NULL) {
-        semaphore = archSemaphoreCreate(1);
-    }
-    archSemaphoreWait(semaphore, -1);
-}
 
-static void signalSem() {
-    archSemaphoreSignal(semaphore);
-}
+static int flipStateCreate(int draw, int count)
+{
+    int state = draw | (count << 16);
+    int i;
 
+    for (i = 0; i < MAX_FRAMES_PER_FRAMEBUFFER; i++) {
+        state |= (MAX_FRAMES_PER_FRAMEBUFFER - 1 - i) << (4 + 2 * i);
+    }
+    return state;
+}
 
+static int flipRank(int state, int frame)
+{
+    int i;
 
-static FrameBufferData* currentBuffer = NULL;
-static FrameBufferMixMode mixMode = MIXMODE_INTERNAL;
-static FrameBufferMixMode mixMask = MIXMODE_INTERNAL;
-static int frameBufferCount = MAX_FRAMES_PER_FRAMEBUFFER;
+    for (i = 0; FLIP_ORDER(state, i) != frame; i++);
 
+    return i;
+}
 
-static FrameBuffer* frameBufferFlipViewFrame1(int mixFrames)
+static int flipIsNewer(int state, int frame, int refFrame)
 {
-    if (currentBuffer == NULL) {
-        return NULL;
-    }
-    currentBuffer->frame->age = ++currentBuffer->currentAge;
-    return currentBuffer->frame;
+    return FLIP_DRAWN(state, frame) && flipRank(state, frame) < flipRank(state, refFrame);
 }
 
-static FrameBuffer* frameBufferFlipViewFrame2(int mixFrames)
+// Makes a frame the most recently drawn
+static int flipSetDrawn(int state, int frame)
 {
-    int index;
+    int order = frame;
+    int n = 1;
+    int i;
 
-    if (currentBuffer == NULL) {
-        return NULL;
-    }
-    waitSem();
-    index = currentBuffer->viewFrame == 1 ? 0 : 1;
-    if (currentBuffer->frame[index].age > currentBuffer->frame[currentBuffer->viewFrame].age) {
-        currentBuffer->viewFrame = index;
+    for (i = 0; i < MAX_FRAMES_PER_FRAMEBUFFER; i++) {
+        if (FLIP_ORDER(state, i) != frame) {
+            order |= FLIP_ORDER(state, i) << (2 * n++);
+        }
     }
-    signalSem();
-    return currentBuffer->frame + currentBuffer->viewFrame;
+    return (state & ~0x0ff0) | (order << 4) | (1 << (12 + frame));
 }
 
-static FrameBuffer* frameBufferFlipViewFrame3(int mixFrames)
+// Returns the most recently drawn frame that is neither draw nor view,
+// or frame 0 if that frame hasn't been drawn
+static int flipMixFrame(int state)
 {
-    int index;
+    int i;
 
-    if (currentBuffer == NULL) {
-        return NULL;
-    }
-    waitSem();
-    switch (currentBuffer->viewFrame) {
-    case 0: index = currentBuffer->drawFrame == 1 ? 2 : 1; break;
-    case 1: index = currentBuffer->drawFrame == 2 ? 0 : 2; break;
-    case 2: index = currentBuffer->drawFrame == 0 ? 1 : 0; break;
-    }
-    if (currentBuffer->frame[index].age > currentBuffer->frame[currentBuffer->viewFrame].age) {
-        currentBuffer->viewFrame = index;
+    for (i = 0; i < MAX_FRAMES_PER_FRAMEBUFFER; i++) {
+        int frame = FLIP_ORDER(state, i);
+        if (frame != FLIP_DRAW(state) && frame != FLIP_VIEW(state)) {
+            return FLIP_DRAWN(state, frame) ? frame : 0;
+        }
     }
-    signalSem();
-    return currentBuffer->frame + currentBuffer->viewFrame;
+    return 0;
 }
 
-static FrameBuffer* frameBufferFlipViewFrame4(int mixFrames)
+static FrameBuffer* flipViewFrame(FrameBufferData* currentBuffer, int mixFrames, int mixPercent)
 {
+    FrameBuffer* frameBuffer;
+    int oldState;
+    int newState;
+    int index;
     int i;
 
-    if (currentBuffer == NULL) {
-        return NULL;
-    }
-    waitSem();
-    for (i = 0; i < 4; i++) {
-        if (i == currentBuffer->drawFrame) continue;
-        if (currentBuffer->frame[i].age > currentBuffer->frame[currentBuffer->viewFrame].age) {
-            currentBuffer->viewFrame = i;
+    do {
+        oldState = archAtomicGet(&currentBuffer->flipState);
+        newState = oldState;
+
+        switch (FLIP_COUNT(oldState)) {
+        case 1:
+            return currentBuffer->frame;
+        case 2:
+            index = FLIP_VIEW(oldState) == 1 ? 0 : 1;
+            break;
+        case 3:
+            switch (FLIP_VIEW(oldState)) {
+            case 0:  index = FLIP_DRAW(oldState) == 1 ? 2 : 1; break;
+            case 1:  index = FLIP_DRAW(oldState) == 2 ? 0 : 2; break;
+            default: index = FLIP_DRAW(oldState) == 0 ? 1 : 0; break;
+            }
+            break;
+        default:
+            for (i = 0; FLIP_ORDER(oldState, i) == FLIP_DRAW(oldState); i++);
+            index = FLIP_ORDER(oldState, i);
+            break;
         }
-    }
 
-    if (mixFrames) {
-        int secondFrame = 0;
-        int viewAge = 0;
-        for (i = 0; i < 4; i++) {
-            if (i == currentBuffer->drawFrame) continue;
-            if (i == currentBuffer->viewFrame) continue;
-            if (currentBuffer->frame[i].age > viewAge) {
-                viewAge = currentBuffer->frame[i].age;
-                secondFrame = i;
-            }
+        if (flipIsNewer(oldState, index, FLIP_VIEW(oldState))) {
+            newState = FLIP_SET_VIEW(oldState, index);
         }
-        signalSem();
+        if (mixFrames && FLIP_COUNT(newState) == 4) {
+            newState = FLIP_SET_MIX(newState, flipMixFrame(newState));
+        }
+    } while (newState != oldState && archAtomicCompareExchange(&currentBuffer->flipState, oldState, newState) != oldState);
 
-        return mixFrame(NULL, currentBuffer->frame + currentBuffer->viewFrame, currentBuffer->frame + secondFrame, getScreenCompletePercent());
+    if (!FLIP_MIXING(newState)) {
+        return currentBuffer->frame + FLIP_VIEW(newState);
     }
 
-    signalSem();
-    return currentBuffer->frame + currentBuffer->viewFrame;
-}
+    frameBuffer = mixFrame(NULL, currentBuffer->frame + FLIP_VIEW(newState),
+                           currentBuffer->frame + FLIP_MIX(newState), mixPercent);
 
+    do {
+        oldState = archAtomicGet(&currentBuffer->flipState);
+        newState = FLIP_CLEAR_MIX(oldState);
+    } while (archAtomicCompareExchange(&currentBuffer->flipState, oldState, newState) != oldState);
 
-static FrameBuffer* frameBufferFlipDrawFrame1()
-{
-    if (currentBuffer == NULL) {
-        return NULL;
-    }
-    return currentBuffer->frame;
+    return frameBuffer;
 }
 
-static FrameBuffer* frameBufferFlipDrawFrame2()
+static FrameBuffer* flipDrawFrame(FrameBufferData* currentBuffer)
 {
-    FrameBuffer* frame;
+    int oldState;
+    int newState;
+    int draw;
+    int i;
 
-    if (currentBuffer == NULL) {
-        return NULL;
-    }
-    waitSem();
-    currentBuffer->drawFrame = currentBuffer->viewFrame;
-    frame = currentBuffer->frame + currentBuffer->drawFrame;
-    frame->age = ++currentBuffer->currentAge;
-    signalSem();
-    return frame;
-}
+    do {
+        oldState = archAtomicGet(&currentBuffer->flipState);
+
+        switch (FLIP_COUNT(oldState)) {
+        case 1:
+            return currentBuffer->frame;
+        case 2:
+            draw = FLIP_VIEW(oldState);
+            break;
+        case 3:
+            switch (FLIP_DRAW(oldState)) {
+            case 0:  draw = FLIP_VIEW(oldState) == 1 ? 2 : 1; break;
+            case 1:  draw = FLIP_VIEW(oldState) == 2 ? 0 : 2; break;
+            default: draw = FLIP_VIEW(oldState) == 0 ? 1 : 0; break;
+            }
+            break;
+        default:
+            for (i = MAX_FRAMES_PER_FRAMEBUFFER - 1; FLIP_ORDER(oldState, i) == FLIP_VIEW(oldState) ||
+                 (FLIP_MIXING(oldState) && FLIP_ORDER(oldState, i) == FLIP_MIX(oldState)); i--);
+            draw = FLIP_ORDER(oldState, i);
+            break;
+        }
 
-static FrameBuffer* frameBufferFlipDrawFrame3()
-{
-    FrameBuffer* frame;
+        newState = flipSetDrawn(FLIP_SET_DRAW(oldState, draw), draw);
+    } while (newState != oldState && archAtomicCompareExchange(&currentBuffer->flipState, oldState, newState) != oldState);
 
-    if (currentBuffer == NULL) {
-        return NULL;
-    }
-    waitSem();
-    switch (currentBuffer->drawFrame) {
-    case 0: currentBuffer->drawFrame = currentBuffer->viewFrame == 1 ? 2 : 1; break;
-    case 1: currentBuffer->drawFrame = currentBuffer->viewFrame == 2 ? 0 : 2; break;
-    case 2: currentBuffer->drawFrame = currentBuffer->viewFrame == 0 ? 1 : 0; break;
-    }
-    frame = currentBuffer->frame + currentBuffer->drawFrame;
-    frame->age = ++currentBuffer->currentAge;
-    signalSem();
-    return frame;
+    return currentBuffer->frame + FLIP_DRAW(newState);
 }
 
-
-static FrameBuffer* frameBufferFlipDrawFrame4()
+FrameBufferContext* frameBufferContextCreate()
 {
-    FrameBuffer* frame;
-    int drawFrame = currentBuffer->drawFrame;
-    int drawAge = 0x7fffffff;
-    int i;
-
-    if (currentBuffer == NULL) {
-        return NULL;
-    }
+    FrameBufferContext* ctx = calloc(1, sizeof(FrameBufferContext));
 
-    waitSem();
+    ctx->mixMode    = MIXMODE_INTERNAL;
+    ctx->mixMask    = MIXMODE_INTERNAL;
+    ctx->frameCount = MAX_FRAMES_PER_FRAMEBUFFER;
 
-    for (i = 0; i < 4; i++) {
-        if (i == currentBuffer->viewFrame) continue;
-        if (currentBuffer->frame[i].age < drawAge) {
-            drawAge = currentBuffer->frame[i].age;
-            currentBuffer->drawFrame = i;
-        }
-    }
-
-    signalSem();
-    frame = currentBuffer->frame + currentBuffer->drawFrame;
-    frame->age = ++currentBuffer->currentAge;
-    return frame;
+    return ctx;
 }
 
+void frameBufferContextDestroy(FrameBufferContext* context)
+{
+    free(context);
+}
 
-
-FrameBuffer* frameBufferGetViewFrame()
+FrameBuffer* frameBufferGetViewFrame(BoardContext* board)
 {
-    return currentBuffer ? currentBuffer->frame + currentBuffer->viewFrame : NULL;
+    FrameBufferData* currentBuffer = boardGetFrameBuffer(board)->currentBuffer;
+
+    return currentBuffer ? currentBuffer->frame + FLIP_VIEW(archAtomicGet(&currentBuffer->flipState)) : NULL;
 }
 
-void frameBufferSetScanline(int scanline)
+void frameBufferSetScanline(BoardContext* board, int scanline)
 {
-    curScanline = scanline;
+    boardGetFrameBuffer(board)->curScanline = scanline;
 }
 
-int frameBufferGetScanline()
+int frameBufferGetScanline(BoardContext* board)
 {
-    return curScanline;
+    return boardGetFrameBuffer(board)->curScanline;
 }
 
-FrameBuffer* frameBufferGetDrawFrame()
+FrameBuffer* frameBufferGetDrawFrame(BoardContext* board)
 {
+    FrameBufferData* currentBuffer = boardGetFrameBuffer(board)->currentBuffer;
     FrameBuffer* frameBuffer;
 
     if (currentBuffer == NULL) {
@@ -263,62 +297,54 @@ FrameBuffer* frameBufferGetDrawFrame()
     }
 #ifdef WII
 
-    frameBuffer = currentBuffer->frame + currentBuffer->drawFrame;
+    frameBuffer = currentBuffer->frame + FLIP_DRAW(currentBuffer->flipState);
 #else
     if (confBlendFrames) {
         frameBuffer = currentBuffer->blendFrame + currentBuffer->currentBlendFrame;
     }
     else {
-        frameBuffer = currentBuffer->frame + currentBuffer->drawFrame;
+        frameBuffer = currentBuffer->frame + FLIP_DRAW(currentBuffer->flipState);
     }
 #endif
 
     return frameBuffer;
 }
 
-void frameBufferSetFrameCount(int frameCount)
+void frameBufferSetFrameCount(BoardContext* board, int frameCount)
 {
-    waitSem();
-    frameBufferCount = frameCount;
-    if (currentBuffer != NULL) {
-        int i;
-        currentBuffer->viewFrame = 0;
-        currentBuffer->drawFrame = 0;
+    FrameBufferContext* ctx = boardGetFrameBuffer(board);
 
-        for (i = 0; i < MAX_FRAMES_PER_FRAMEBUFFER; i++) {
-            currentBuffer->frame[i].age = 0;
-        }
+    ctx->frameCount = frameCount;
+    if (ctx->currentBuffer != NULL) {
+        archAtomicSet(&ctx->currentBuffer->flipState, flipStateCreate(0, frameCount));
     }
-    signalSem();
 }
 
-FrameBuffer* frameBufferFlipViewFrame(int mixFrames)
+FrameBuffer* frameBufferFlipViewFrame(BoardContext* board, int mixFrames)
 {
-    FrameBuffer* frameBuffer;
+    return frameBufferFlipViewFrameMix(board, mixFrames, mixFrames ? vdpGetScreenCompletePercent(board) : 0);
+}
+
+int frameBufferGetMixPercent(BoardContext* board)
+{
+    return vdpGetScreenCompletePercent(board);
+}
+
+FrameBuffer* frameBufferFlipViewFrameMix(BoardContext* board, int mixFrames, int mixPercent)
+{
+    FrameBufferData* currentBuffer = boardGetFrameBuffer(board)->currentBuffer;
 
     if (currentBuffer == NULL) {
         return NULL;
     }
 
-    switch (frameBufferCount) {
-    case 2:
-        frameBuffer = frameBufferFlipViewFrame2(mixFrames);
-        break;
-    case 3:
-        frameBuffer = frameBufferFlipViewFrame3(mixFrames);
-        break;
-    case 4:
-        frameBuffer = frameBufferFlipViewFrame4(mixFrames);
-        break;
-    default:
-        frameBuffer = frameBufferFlipViewFrame1(mixFrames);
-        break;
-    }
-    return frameBuffer;
+    return flipViewFrame(currentBuffer, mixFrames, mixPercent);
 }
 
-FrameBuffer* frameBufferFlipDrawFrame()
+FrameBuffer* frameBufferFlipDrawFrame(BoardContext* board)
 {
+    FrameBufferContext* ctx = boardGetFrameBuffer(board);
+    FrameBufferData* currentBuffer = ctx->currentBuffer;
     FrameBuffer* frameBuffer;
 
 #ifdef WII
@@ -329,46 +355,37 @@ FrameBuffer* frameBufferFlipDrawFrame()
     }
 #ifndef WII
     if (confBlendFrames) {
-        mixFrame(currentBuffer->frame + currentBuffer->drawFrame,
+        mixFrame(currentBuffer->frame + FLIP_DRAW(currentBuffer->flipState),
                  &currentBuffer->blendFrame[0], &currentBuffer->blendFrame[1], 50);
     }
 #endif
-    curScanline = 0;
+    ctx->curScanline = 0;
 
-    if (mixMode == MIXMODE_EXTERNAL) {
-        frameBufferExternal(currentBuffer->frame + currentBuffer->drawFrame);
+    if (ctx->mixMode == MIXMODE_EXTERNAL) {
+        frameBufferExternal(ctx, currentBuffer->frame + FLIP_DRAW(currentBuffer->flipState));
     }
-    else if (mixMode == MIXMODE_BOTH) {
-        frameBufferSuperimpose(currentBuffer->frame + currentBuffer->drawFrame);
+    else if (ctx->mixMode == MIXMODE_BOTH) {
+        frameBufferSuperimpose(ctx, currentBuffer->frame + FLIP_DRAW(currentBuffer->flipState));
     }
-    else if (mixMode == MIXMODE_NONE) {
-        frameBufferBlack(currentBuffer->frame + currentBuffer->drawFrame);
+    else if (ctx->mixMode == MIXMODE_NONE) {
+        frameBufferBlack(currentBuffer->frame + FLIP_DRAW(currentBuffer->flipState));
     }
 
 //    ++xxxx;
     //printf("%d\n", xxxx);
 //    confBlendFrames = xxxx < 2100 || (xxxx >= 7900 && xxxx <= 9400);
 
-    switch (frameBufferCount) {
-    case 2:
-        frameBuffer = frameBufferFlipDrawFrame2();
-        break;
-    case 3:
-        frameBuffer = frameBufferFlipDrawFrame3();
-        break;
-    case 4:
-        frameBuffer = frameBufferFlipDrawFrame4();
-        break;
-    default:
-        frameBuffer = frameBufferFlipDrawFrame1();
-        break;
-    }
+    frameBuffer = flipDrawFrame(currentBuffer);
 #ifndef WII
     if (confBlendFrames) {
         currentBuffer->currentBlendFrame ^= 1;
         frameBuffer = currentBuffer->blendFrame + currentBuffer->currentBlendFrame;
     }
 #endif
+    // Lines keep their old content until they are redrawn, so they
+    // are unknown until the video chip hashes them again
+    frameBufferClearHashes(frameBuffer);
+
     return frameBuffer;
 }
 
@@ -381,11 +398,46 @@ void frameBufferSetBlendFrames(int blendFrames)
 #endif
 }
 
-FrameBufferData* frameBufferDataCreate(int maxWidth, int maxHeight, int defaultHorizZoom)
+void frameBufferHashLine(FrameBuffer* frameBuffer, int y)
 {
+    LineBuffer* line = frameBuffer->line + y;
+    UInt32* data = (UInt32*)line->buffer;
+    int width = line->doubleWidth ? frameBuffer->maxWidth : frameBuffer->maxWidth / 2;
+    UInt32 hash0 = 2166136261U ^ line->doubleWidth;
+    UInt32 hash1 = 2166136261U;
+    int x;
+
+    // Two interleaved FNV-1a streams, to not stall on the multiply
+    for (x = 0; x < width - 1; x += 2) {
+        hash0 = (hash0 ^ data[x + 0]) * 16777619U;
+        hash1 = (hash1 ^ data[x + 1]) * 16777619U;
+    }
+    if (x < width) {
+        hash0 = (hash0 ^ data[x]) * 16777619U;
+    }
+
+    line->hash = ((hash0 * 31) ^ hash1) | 1;
+}
+
+static void frameBufferClearHashes(FrameBuffer* a)
+{
+    int y;
+
+    if (a == NULL) {
+        return;
+    }
+
+    for (y = 0; y < FB_MAX_LINES; y++) {
+        a->line[y].hash = 0;
+    }
+}
+
+FrameBufferData* frameBufferDataCreate(BoardContext* board, int maxWidth, int maxHeight, int defaultHorizZoom)
+{
+    int frameCount = boardGetFrameBuffer(board)->frameCount;
     int i;
     FrameBufferData* frameData = calloc(1, sizeof(FrameBufferData));
-    frameData->drawFrame = frameBufferCount > 1 ? 1 : 0;
+    frameData->flipState = flipStateCreate(frameCount > 1 ? 1 : 0, frameCount);
 
     for (i = 0; i < MAX_FRAMES_PER_FRAMEBUFFER; i++) {
         int j;
@@ -410,36 +462,38 @@ FrameBufferData* frameBufferDataCreate(int maxWidth, int maxHeight, int defaultH
     return frameData;
 }
 
-void frameBufferDataDestroy(FrameBufferData* frameData)
+void frameBufferDataDestroy(BoardContext* board, FrameBufferData* frameData)
 {
-    if (frameData == currentBuffer) {
-        currentBuffer = NULL;
+    FrameBufferContext* ctx = boardGetFrameBuffer(board);
+
+    if (frameData == ctx->currentBuffer) {
+        ctx->currentBuffer = NULL;
     }
     free(frameData);
-    if (semaphore != NULL) {
-        archSemaphoreDestroy(semaphore);
-        semaphore = NULL;
-    }
 }
 
 
-void frameBufferSetActive(FrameBufferData* frameData)
+void frameBufferSetActive(BoardContext* board, FrameBufferData* frameData)
 {
-    currentBuffer = frameData;
+    FrameBufferContext* ctx = boardGetFrameBuffer(board);
+
+    ctx->currentBuffer = frameData;
     if (frameData == NULL) {
-        mixMode = MIXMODE_INTERNAL;
+        ctx->mixMode = MIXMODE_INTERNAL;
     }
 }
 
-void frameBufferSetMixMode(FrameBufferMixMode mode,  FrameBufferMixMode mask)
+void frameBufferSetMixMode(BoardContext* board, FrameBufferMixMode mode,  FrameBufferMixMode mask)
 {
-    mixMode = mode;
-    mixMask = mask;
+    FrameBufferContext* ctx = boardGetFrameBuffer(board);
+
+    ctx->mixMode = mode;
+    ctx->mixMask = mask;
 }
 
-FrameBufferData* frameBufferGetActive()
+FrameBufferData* frameBufferGetActive(BoardContext* board)
 {
-    return currentBuffer;
+    return boardGetFrameBuffer(board)->currentBuffer;
 }
 
 FrameBuffer* frameBufferGetWhiteNoiseFrame()
@@ -501,6 +555,14 @@ FrameBuffer* frameBufferDeinterlace(FrameBuffer* frameBuffer)
 #define M1 0x3E07C1F
 #define M2 0x3E0F81F
 
+static UInt32 mixHash(UInt32 a, UInt32 b, int pct)
+{
+    if (a == 0 || b == 0) {
+        return 0;
+    }
+    return ((a * 16777619U) ^ b ^ ((UInt32)pct << 25)) | 1;
+}
+
 static FrameBuffer* mixFrame(FrameBuffer* d, FrameBuffer* a, FrameBuffer* b, int pct)
 {
     static FrameBuffer* dst = NULL;
@@ -538,6 +600,7 @@ static FrameBuffer* mixFrame(FrameBuffer* d, FrameBuffer* a, FrameBuffer* b, int
         UInt32* dp = (UInt32*)d->line[y].buffer;
 
         d->line[y].doubleWidth = a->line[y].doubleWidth;
+        d->line[y].hash = mixHash(a->line[y].hash, b->line[y].hash, p);
         for (x = 0; x < width; x ++) {
 #ifdef WII
             UInt32 av = ((ap[x] >> 1) & 0xffe0ffe0) | (ap[x] & 0x001f001f);
@@ -600,21 +663,24 @@ static FrameBuffer* mixFrameInterlace(FrameBuffer* d, FrameBuffer* a, FrameBuffe
         UInt32* bp;
         UInt32* dp;
 
+        LineBuffer* bl;
+
         if (y & 1) {
-            ap = (UInt32*)a->line[y / 2].buffer;
-            bp = (UInt32*)b->line[y / 2].buffer;
+            bl = b->line + y / 2;
         }
         else {
-            ap = (UInt32*)a->line[y / 2].buffer;
             if (y == 0) {
-                bp = (UInt32*)b->line[a->lines - 1].buffer;
+                bl = b->line + a->lines - 1;
             }
             else {
-                bp = (UInt32*)b->line[y / 2 - 1].buffer;
+                bl = b->line + y / 2 - 1;
             }
         }
+        ap = (UInt32*)a->line[y / 2].buffer;
+        bp = (UInt32*)bl->buffer;
         dp = (UInt32*)d->line[y].buffer;
         d->line[y].doubleWidth = a->line[y / 2].doubleWidth;
+        d->line[y].hash = mixHash(a->line[y / 2].hash, bl->hash, p);
 
         for (x = 0; x < width; x++) {
 #ifdef WII
@@ -637,13 +703,10 @@ static FrameBuffer* mixFrameInterlace(FrameBuffer* d, FrameBuffer* a, FrameBuffe
     return d;
 }
 
+static UInt16 blackImage[FB_MAX_LINE_WIDTH * FB_MAX_LINES];
+
 static UInt16* getBlackImage()
 {
-    static UInt16* blackImage = NULL;
-
-    if (blackImage == NULL) {
-        blackImage = calloc(sizeof(UInt16), FB_MAX_LINE_WIDTH * FB_MAX_LINES);
-    }
     return blackImage;
 }
 
@@ -656,9 +719,10 @@ static void frameBufferBlack(FrameBuffer* a)
         memcpy(a->line[y].buffer, pImage, a->maxWidth * sizeof(UInt16));
         a->line[y].doubleWidth = 0;
     }
+    frameBufferClearHashes(a);
 }
 
-static void frameBufferExternal(FrameBuffer* a)
+static void frameBufferExternal(FrameBufferContext* ctx, FrameBuffer* a)
 {
     int y;
     UInt16* pImage = NULL;
@@ -683,13 +747,15 @@ static void frameBufferExternal(FrameBuffer* a)
         imageHeight *= 2;
     }
 
-    if (mixMode & mixMask) {
+    if (ctx->mixMode & ctx->mixMask) {
         pImage = archVideoInBufferGet(imageWidth, imageHeight);
     }
     if (pImage == NULL) {
         pImage = getBlackImage();
     }
 
+    frameBufferClearHashes(a);
+
     if (scaleHeight) {
         a->lines *= 2;
 
@@ -702,7 +768,7 @@ static void frameBufferExternal(FrameBuffer* a)
     }
 }
 
-static void frameBufferSuperimpose(FrameBuffer* a)
+static void frameBufferSuperimpose(FrameBufferContext* ctx, FrameBuffer* a)
 {
     int x, y;
     UInt16* pImage = NULL;
@@ -727,13 +793,15 @@ static void frameBufferSuperimpose(FrameBuffer* a)
         imageHeight *= 2;
     }
 
-    if (mixMode & mixMask) {
+    if (ctx->mixMode & ctx->mixMask) {
         pImage = archVideoInBufferGet(imageWidth, imageHeight);
     }
     if (pImage == NULL) {
         pImage = getBlackImage();
     }
 
+    frameBufferClearHashes(a);
+
     if (scaleHeight) {
         for (y = a->lines - 1; y >= 0; y--) {
             UInt16* pSrc = a->line[y].buffer;
@@ -40,6 +40,7 @@
 #ifndef NO_FRAMEBUFFER
 typedef struct {
     int doubleWidth; // 1 when normal, 2 when 2 src pixels per dest pixel
+    UInt32 hash;     // Content hash of the line, 0 when unknown
     UInt16 buffer[FB_MAX_LINE_WIDTH];
 } LineBuffer;
 #endif
@@ -50,7 +51,6 @@ typedef enum { INTERLACE_NONE, INTERLACE_ODD, INTERLACE_EVEN } InterlaceMode;
 typedef void FrameBuffer;
 #else
 typedef struct {
-    int age;           // Internal use
     InterlaceMode interlace;
     int maxWidth;
     int lines;         // Number of lines in frame buffer
@@ -60,6 +60,13 @@ typedef struct {
 
 typedef struct FrameBufferData FrameBufferData;
 
+// The frame buffer state of a board: the active frame buffer, its mix
+// mode, the number of frames and the scanline drawn
+typedef struct FrameBufferContext FrameBufferContext;
+
+FrameBufferContext* frameBufferContextCreate();
+void frameBufferContextDestroy(FrameBufferContext* context);
+
 typedef enum {
     MIXMODE_INTERNAL = 1,
     MIXMODE_BOTH     = 2,
@@ -67,30 +74,46 @@ typedef enum {
     MIXMODE_NONE     = 8
 } FrameBufferMixMode;
 
-void frameBufferSetFrameCount(int frameCount);
+void frameBufferSetFrameCount(BoardContext* board, int frameCount);
+
+FrameBuffer* frameBufferGetViewFrame(BoardContext* board);
+FrameBuffer* frameBufferGetDrawFrame(BoardContext* board);
 
-FrameBuffer* frameBufferGetViewFrame();
-FrameBuffer* frameBufferGetDrawFrame();
-FrameBuffer* frameBufferFlipViewFrame(int mixFrames);
-FrameBuffer* frameBufferFlipDrawFrame();
+// The emulation thread flips the draw frame while one other thread flips
+// the view frame. Neither flip waits for the other, and the view frame
+// is the newest complete frame.
+FrameBuffer* frameBufferFlipViewFrame(BoardContext* board, int mixFrames);
+FrameBuffer* frameBufferFlipDrawFrame(BoardContext* board);
 
-void frameBufferSetScanline(int scanline);
-int frameBufferGetScanline();
+// Flips the view frame like frameBufferFlipViewFrame() on a thread other
+// than the emulation thread. The frames are mixed by mixPercent, which
+// the emulation thread gets from frameBufferGetMixPercent().
+FrameBuffer* frameBufferFlipViewFrameMix(BoardContext* board, int mixFrames, int mixPercent);
+int frameBufferGetMixPercent(BoardContext* board);
+
+void frameBufferSetScanline(BoardContext* board, int scanline);
+int frameBufferGetScanline(BoardContext* board);
 
 FrameBuffer* frameBufferGetWhiteNoiseFrame();
 FrameBuffer* frameBufferDeinterlace(FrameBuffer* frameBuffer);
 void frameBufferClearDeinterlace();
 
-FrameBufferData* frameBufferDataCreate(int maxWidth, int maxHeight, int defaultHorizZoom);
-void frameBufferDataDestroy(FrameBufferData* frameData);
+FrameBufferData* frameBufferDataCreate(BoardContext* board, int maxWidth, int maxHeight, int defaultHorizZoom);
+void frameBufferDataDestroy(BoardContext* board, FrameBufferData* frameData);
 
-void frameBufferSetActive(FrameBufferData* frameData);
-void frameBufferSetMixMode(FrameBufferMixMode mode, FrameBufferMixMode mask);
+void frameBufferSetActive(BoardContext* board, FrameBufferData* frameData);
+void frameBufferSetMixMode(BoardContext* board, FrameBufferMixMode mode, FrameBufferMixMode mask);
 
-FrameBufferData* frameBufferGetActive();
+FrameBufferData* frameBufferGetActive(BoardContext* board);
 
 void frameBufferSetBlendFrames(int blendFrames);
 
+// Called by a video chip when it has completed a line in the draw frame.
+// The line hash lets the video renderer skip lines that did not change
+// since they were last shown. Lines that are not hashed are always
+// treated as changed.
+void frameBufferHashLine(FrameBuffer* frameBuffer, int y);
+
 #ifdef WII
 #define BKMODE_TRANSPARENT 0x0020
 #define videoGetColor(R, G, B) \
@@ -123,6 +146,7 @@ void   frameBufferSetInterlace(FrameBuffer* frameBuffer, int val);
 void   frameBufferSetLineCount(FrameBuffer* frameBuffer, int val);
 int    frameBufferGetLineCount(FrameBuffer* frameBuffer);
 int    frameBufferGetMaxWidth(FrameBuffer* frameBuffer);
+#define frameBufferHashLine(frameBuffer, y)
 
 #else
 
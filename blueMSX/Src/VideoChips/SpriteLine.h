@@ -36,7 +36,7 @@ typedef struct {
     UInt16 pattern;
 } SpriteAttribute;
 
-static UInt8 colChckBuf[384] = {
+static const UInt8 colChckBuf[384] = {
     0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
     1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
     1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
@@ -55,14 +55,11 @@ static UInt8 lineBufferNull[512];
 
 #define nullSpritesLine() lineBufferNull
 
-static UInt8 lineBuffer[2][384];
-static UInt8* lineBufs[2] = { nullSpritesLine(), nullSpritesLine() };
-static UInt8* lineBuf = nullSpritesLine();
-static int nonVisibleLine = -1;
 
 
 UInt8* spritesLine(VDP* vdp, int line) {
     int bufIndex;
+    UInt8* lineBuf;
     UInt8 collisionBuf[384];
     UInt8* attrib;
     UInt8* attribTable[32];
@@ -83,13 +80,13 @@ UInt8* spritesLine(VDP* vdp, int line) {
 //    vdp->vdpStatus[0] &= 0xbf;
 
     if (idx == 0) {
-        lineBufs[bufIndex] = nullSpritesLine();
+        vdp->spriteLines[bufIndex] = nullSpritesLine();
         return nullSpritesLine();
     }
 
     if (!vdp->screenOn || (vdp->vdpStatus[2] & 0x40) ||vdpIsSpritesOff(vdp->vdpRegs)) {
-        lineBufs[bufIndex] = nullSpritesLine();
-        return lineBufs[bufIndex ^ 1];
+        vdp->spriteLines[bufIndex] = nullSpritesLine();
+        return vdp->spriteLines[bufIndex ^ 1];
     }
 
     attrib = &vdp->vram[vdp->sprTabBase & (-1 << 7)];
@@ -140,7 +137,7 @@ UInt8* spritesLine(VDP* vdp, int line) {
 			if ((vdp->vdpStatus[0] & 0xc0) == 0) {
 				vdp->vdpStatus[0] = (vdp->vdpStatus[0] & 0xe0) | 0x40 | idx;
 			}
-			if (!noSpriteLimits)
+			if (!boardGetNoSpriteLimits(vdp->board))
 				break;
         }
 
@@ -148,15 +145,15 @@ UInt8* spritesLine(VDP* vdp, int line) {
     }
 
     if (visibleCnt == 0) {
-        lineBufs[bufIndex] = nullSpritesLine();
-        return lineBufs[bufIndex ^ 1];
+        vdp->spriteLines[bufIndex] = nullSpritesLine();
+        return vdp->spriteLines[bufIndex ^ 1];
     }
 
 	if ((vdp->vdpStatus[0] & 0xc0) == 0) {
 		vdp->vdpStatus[0] = (vdp->vdpStatus[0] & 0xe0) | (idx < 32 ? idx : 31);
 	}
     
-    lineBuf = lineBuffer[bufIndex];
+    lineBuf = vdp->spriteLineBuffer[bufIndex];
     memset(lineBuf, 0, 384);
     memset(collisionBuf, 0, 384);
 
@@ -168,7 +165,7 @@ UInt8* spritesLine(VDP* vdp, int line) {
         UInt8  pattern;
         UInt8* linePtr;
         UInt8* colPtr;
-        UInt8* colChck;
+        const UInt8* colChck;
         int    colOffset;
 
         attrib     = attribTable[visibleCnt];
@@ -309,23 +306,24 @@ UInt8* spritesLine(VDP* vdp, int line) {
         }
     }
 
-    lineBufs[bufIndex] = lineBuf + 32;
+    vdp->spriteLines[bufIndex] = lineBuf + 32;
 
-    if (!spritesEnable) {
+    if (!boardGetSpritesEnable(vdp->board)) {
         return nullSpritesLine();
     }
 
-    return lineBufs[bufIndex ^ 1];
+    return vdp->spriteLines[bufIndex ^ 1];
 }
 
 
 void spriteLineInvalidate(VDP* vdp, int line) {
-    nonVisibleLine = line - vdp->firstLine;
+    vdp->nonVisibleLine = line - vdp->firstLine;
 }
 
 UInt8* colorSpritesLine(VDP* vdp, int line, int scr6) {
     int solidColor;
     int bufIndex;
+    UInt8* lineBuf;
     UInt8 collisionBuf[384];
     SpriteAttribute attribTable[32];
     UInt8 patternMask;
@@ -336,8 +334,6 @@ UInt8* colorSpritesLine(VDP* vdp, int line, int scr6) {
     int   visibleCnt;
     int   collision;
     int   idx;
-    static UInt8 ccColorMask;
-    static UInt8 ccColorCheckMask;
 
     idx = line;
 
@@ -348,23 +344,23 @@ UInt8* colorSpritesLine(VDP* vdp, int line, int scr6) {
 //    vdp->vdpStatus[0] &= 0x80;
 
     if (line == 0xffffffff) {
-        nonVisibleLine = -1000;
+        vdp->nonVisibleLine = -1000;
         // This is an not 100% correct optimization. CC sprites should be shown only when
         // they collide with a non CC sprite. However very few games/demos uses this and
         // it is safe to disable the CC sprites if no non CC sprites are visible.
-        ccColorMask = ccColorCheckMask;
-        ccColorCheckMask = 0xf0;
+        vdp->ccColorMask = vdp->ccColorCheckMask;
+        vdp->ccColorCheckMask = 0xf0;
     }
 
-    if (idx == 0 || nonVisibleLine == line) {
-        lineBufs[bufIndex] = nullSpritesLine();
+    if (idx == 0 || vdp->nonVisibleLine == line) {
+        vdp->spriteLines[bufIndex] = nullSpritesLine();
         return nullSpritesLine();
     }
 
     if (!vdp->screenOn || (vdp->vdpStatus[2] & 0x40) ||vdpIsSpritesOff(vdp->vdpRegs)) {
 //    if (!vdp->screenOn ||vdpIsSpritesOff(vdp->vdpRegs)) {
-        lineBufs[bufIndex] = nullSpritesLine();
-        return lineBufs[bufIndex ^ 1];
+        vdp->spriteLines[bufIndex] = nullSpritesLine();
+        return vdp->spriteLines[bufIndex ^ 1];
     }
 
     solidColor   = vdpIsColor0Solid(vdp->vdpRegs) ? 1 : 0;
@@ -397,7 +393,7 @@ UInt8* colorSpritesLine(VDP* vdp, int line, int scr6) {
 			if ((vdp->vdpStatus[0] & 0xc0) == 0) {
 				vdp->vdpStatus[0] = (vdp->vdpStatus[0] & 0xe0) | 0x40 | sprite;
 			}
-			if (!noSpriteLimits)
+			if (!boardGetNoSpriteLimits(vdp->board))
 				break;
         }
 
@@ -409,10 +405,10 @@ UInt8* colorSpritesLine(VDP* vdp, int line, int scr6) {
                 continue;
             }
 
-            color &= ccColorMask;
+            color &= vdp->ccColorMask;
         }
         else if ((color & 0x0f) || solidColor) {
-            ccColorCheckMask = 0xff;
+            vdp->ccColorCheckMask = 0xff;
         }
 
         attribTable[visibleCnt].color         = color;
@@ -426,15 +422,15 @@ UInt8* colorSpritesLine(VDP* vdp, int line, int scr6) {
     }
 
     if (visibleCnt == 0) {
-        lineBufs[bufIndex] = nullSpritesLine();
-        return lineBufs[bufIndex ^ 1];
+        vdp->spriteLines[bufIndex] = nullSpritesLine();
+        return vdp->spriteLines[bufIndex ^ 1];
     }
 
 	if ((vdp->vdpStatus[0] & 0xc0) == 0) {
 		vdp->vdpStatus[0] = (vdp->vdpStatus[0] & 0xe0) | (sprite < 32 ? sprite : 31);
 	}
     
-    lineBuf = lineBuffer[bufIndex];
+    lineBuf = vdp->spriteLineBuffer[bufIndex];
     memset(lineBuf, 0, 384);
     memset(collisionBuf, 0, 384);
 
@@ -443,7 +439,7 @@ UInt8* colorSpritesLine(VDP* vdp, int line, int scr6) {
         SpriteAttribute* attrib = &attribTable[idx];
         UInt8* linePtr;
         UInt8* colPtr;
-        UInt8* colChck;
+        const UInt8* colChck;
         UInt16 pattern;
         UInt8 color;
         int offset;
@@ -574,21 +570,21 @@ UInt8* colorSpritesLine(VDP* vdp, int line, int scr6) {
         }
     }
 
-    lineBufs[bufIndex] = lineBuf + 32;
+    vdp->spriteLines[bufIndex] = lineBuf + 32;
 
-    if (!spritesEnable) {
+    if (!boardGetSpritesEnable(vdp->board)) {
         return nullSpritesLine();
     }
 
-    return lineBufs[bufIndex ^ 1];
+    return vdp->spriteLines[bufIndex ^ 1];
 }
 
 UInt8* getSpritesLine(VDP* vdp, int line) {
-    if (!spritesEnable) {
+    if (!boardGetSpritesEnable(vdp->board)) {
         return nullSpritesLine();
     }
 
-    return lineBufs[(line & 1) ^ 1];
+    return vdp->spriteLines[(line & 1) ^ 1];
 }
 
 #endif
@@ -136,6 +136,7 @@ static int tmp;
 **************************************************************
 */
 struct VdpCmdState {
+    BoardContext* board;
     UInt8* vramBase;
     UInt8* vramRead;
     UInt8* vramWrite;
@@ -939,9 +940,11 @@ static void HmmcEngine(VdpCmdState* vdpCmd)
 **      Initializes the command engine.
 **************************************************************
 */
-VdpCmdState* vdpCmdCreate(int vramSize, UInt8* vramPtr, UInt32 systemTime)
+VdpCmdState* vdpCmdCreate(BoardContext* board, int vramSize, UInt8* vramPtr, UInt32 systemTime)
 {
     VdpCmdState* vdpCmd = calloc(1, sizeof(VdpCmdState));
+
+    vdpCmd->board = board;
     vdpCmd->systemTime = systemTime;
     vdpCmd->vramBase = vramPtr;
 
@@ -1302,7 +1305,7 @@ void vdpCmdExecute(VdpCmdState* vdpCmd, UInt32 systemTime)
 */
 void vdpCmdLoadState(VdpCmdState* vdpCmd)
 {
-    SaveState* state = saveStateOpenForRead("vdpCommandEngine");
+    SaveState* state = saveStateOpenForRead(vdpCmd->board, "vdpCommandEngine");
 
     vdpCmd->SX            =         saveStateGet(state, "SX",         0);
     vdpCmd->SY            =         saveStateGet(state, "SY",         0);
@@ -1324,7 +1327,7 @@ void vdpCmdLoadState(VdpCmdState* vdpCmd)
     vdpCmd->TY            =         saveStateGet(state, "TY",         0);
     vdpCmd->MX            =         saveStateGet(state, "MX",         0);
     vdpCmd->VdpOpsCnt     =         saveStateGet(state, "VdpOpsCnt",  0);
-    vdpCmd->systemTime    =         saveStateGet(state, "systemTime", boardSystemTime());
+    vdpCmd->systemTime    =         saveStateGet(state, "systemTime", boardSystemTime(vdpCmd->board));
     vdpCmd->newScrMode    =         saveStateGet(state, "newScrMode", 0);
     vdpCmd->screenMode    =         saveStateGet(state, "screenMode", 0);
     vdpCmd->timingMode    =         saveStateGet(state, "timingMode", 0);
@@ -1347,7 +1350,7 @@ void vdpCmdLoadState(VdpCmdState* vdpCmd)
 */
 void vdpCmdSaveState(VdpCmdState* vdpCmd)
 {
-    SaveState* state = saveStateOpenForWrite("vdpCommandEngine");
+    SaveState* state = saveStateOpenForWrite(vdpCmd->board, "vdpCommandEngine");
 
     saveStateSet(state, "SX",         vdpCmd->SX);
     saveStateSet(state, "SY",         vdpCmd->SY);
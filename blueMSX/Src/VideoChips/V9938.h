@@ -28,7 +28,7 @@ typedef struct VdpCmdState VdpCmdState;
 **      is the initial time of this timer.
 **************************************************************
 */
-VdpCmdState* vdpCmdCreate(int vramSize, UInt8* vramPtr, UInt32 systemTime);
+VdpCmdState* vdpCmdCreate(BoardContext* board, int vramSize, UInt8* vramPtr, UInt32 systemTime);
 
 void vdpCmdDestroy(VdpCmdState* state);
 
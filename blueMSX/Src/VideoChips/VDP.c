@@ -28,7 +28,6 @@
 #include "VDP.h"
 #include "V9938.h"
 #include "Board.h"
-#include "Board.h"
 #include "IoPort.h"
 #include "SaveState.h"
 #include "DeviceManager.h"
@@ -42,47 +41,10 @@
 
 
 //#define ENABLE_VRAM_DECAY
-// Global configuration (not device specific)
 
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
 
-static int spritesEnable = 1;
-static int noSpriteLimits = 0;
-static int displayEnable = 1;
-static int refreshRate   = 0;
-static int canFlipFrameBuffer = 0;
-
-void vdpSetSpritesEnable(int enable) {
-    spritesEnable = enable ? 1 : 0;
-}
-
-int vdpGetSpritesEnable() {
-    return spritesEnable;
-}
-
-void vdpSetNoSpriteLimits(int enable) {
-    noSpriteLimits = enable ? 1 : 0;
-}
-
-int vdpGetNoSpritesLimit() {
-    return noSpriteLimits;
-}
-
-
-void vdpSetDisplayEnable(int enable) {
-    displayEnable = enable ? 1 : 0;
-}
-
-int vdpGetDisplayEnable() {
-    return displayEnable;
-}
-
-int vdpGetRefreshRate() 
-{
-    return refreshRate;
-}
-
 
 // Video DA management
 
@@ -97,33 +59,13 @@ static void  daStart(void* ref, int oddPage) {}
 static void  daEnd(void* ref) {}
 static UInt8 daRead(void* ref, int screenMode, int x, int y, Pixel* palette, int count) { return 0x00; }
 
-static VdpDaDevice vdpDaDevice = {
-    0,
-    VIDEO_INTERNAL,
-    { daStart, daEnd, daRead },
-    NULL
-};
-
-int vdpRegisterDaConverter(VdpDaCallbacks* callbacks, void* ref, VideoMode videoModeMask)
+static void daDeviceReset(VdpDaDevice* daDevice)
 {
-    vdpDaDevice.videoModeMask     = videoModeMask;
-    vdpDaDevice.callbacks.daStart = callbacks->daStart ? callbacks->daStart : daStart;
-    vdpDaDevice.callbacks.daEnd   = callbacks->daEnd   ? callbacks->daEnd   : daEnd;
-    vdpDaDevice.callbacks.daRead  = callbacks->daRead  ? callbacks->daRead  : daRead;
-    vdpDaDevice.ref               = ref;
-    vdpDaDevice.handle++;
-
-    return vdpDaDevice.handle;
-}
-
-void vdpUnregisterDaConverter(int vdpDaHandle)
-{
-    if (vdpDaHandle == vdpDaDevice.handle) {
-        vdpDaDevice.videoModeMask       = VIDEO_INTERNAL;
-        vdpDaDevice.callbacks.daStart   = daStart;
-        vdpDaDevice.callbacks.daEnd     = daEnd;
-        vdpDaDevice.callbacks.daRead    = daRead;
-    }
+    daDevice->videoModeMask     = VIDEO_INTERNAL;
+    daDevice->callbacks.daStart = daStart;
+    daDevice->callbacks.daEnd   = daEnd;
+    daDevice->callbacks.daRead  = daRead;
+    daDevice->ref               = NULL;
 }
 
 
@@ -137,9 +79,13 @@ void vdpUnregisterDaConverter(int vdpDaHandle)
 
 #define VRAM_SIZE (192 * 1024)
 
-static int vramAddr;
-#define MAP_VRAM(vdp, addr) ((vdp)->vramPtr + ((vramAddr = addr, (vdp)->screenMode >= 7 && (vdp)->screenMode <= 12 ? (vramAddr >> 1 | ((vramAddr & 1) << 16)) : vramAddr) & (vdp)->vramAccMask))
-#define MAP_VRAMINDEX(vdp, addr) (((vramAddr = addr, (vdp)->screenMode >= 7 && (vdp)->screenMode <= 12 ? (vramAddr >> 1 | ((vramAddr & 1) << 16)) : vramAddr)))
+static __inline int mapVramIndex(int screenMode, int vramAddr)
+{
+    return screenMode >= 7 && screenMode <= 12 ? (vramAddr >> 1 | ((vramAddr & 1) << 16)) : vramAddr;
+}
+
+#define MAP_VRAM(vdp, addr) ((vdp)->vramPtr + (mapVramIndex((vdp)->screenMode, addr) & (vdp)->vramAccMask))
+#define MAP_VRAMINDEX(vdp, addr) mapVramIndex((vdp)->screenMode, addr)
 
 #define vdpIsSpritesBig(regs)        (regs[1]  & 0x01)
 #define vdpIsSprites16x16(regs)      (regs[1]  & 0x02)
@@ -270,10 +216,6 @@ static UInt16 defaultPaletteRegs[16] = {
     0x0171, 0x0373, 0x0661, 0x0664, 0x0411, 0x0265, 0x0555, 0x0777
 };
 
-typedef struct VDP VDP;
-
-static VDP* theVdp = NULL;
-
 static void RefreshLineTx80(VDP*, int, int, int);
 static void RefreshLine0(VDP*, int, int, int);
 static void RefreshLine0Plus(VDP*, int, int, int);
@@ -289,8 +231,32 @@ static void RefreshLine10(VDP*, int, int, int);
 static void RefreshLine12(VDP*, int, int, int);
 
 static void sync(VDP*, UInt32);
+static void syncAt(VDP*, UInt32, UInt32);
+
+typedef struct {
+    Pixel* linePtr;
+    UInt8* sprLine;
+    UInt8* charTable;
+    const int* jump;
+    int    page;
+    int    scroll;
+    int    hScroll;
+    int    hScroll512;
+    int    hscroll;
+    int    vscroll;
+    int    chrTabO;
+    int    base;
+    int    patternBase;
+    int    pattern;
+    UInt8  colPattern;
+    Pixel  color[2];
+    int    x;
+    int    y;
+    int    shift;
+} RefreshLineState;
 
 struct VDP {
+    BoardContext* board;
     VdpCmdState* cmdEngine;
     void (*RefreshLine)(VDP*, int, int, int);
     int    vdpConnector;
@@ -395,6 +361,39 @@ struct VDP {
     int videoEnabled;
 
     FrameBufferData* frameBuffer;
+    int canFlipFrameBuffer;
+    int refreshRate;
+    int frameCounter;
+
+    VdpDaDevice daDevice;
+
+    UInt32 vramAccessTime;
+    UInt32 vramDecayRnd;
+
+    // Sprites of the current and the previous line
+    UInt8  spriteLineBuffer[2][384];
+    UInt8* spriteLines[2];
+    int    nonVisibleLine;
+    UInt8  ccColorMask;
+    UInt8  ccColorCheckMask;
+
+    // Where each line renderer is in the line it draws, kept between
+    // the calls that draw parts of the line
+    RefreshLineState refreshBlank;
+    RefreshLineState refresh0;
+    RefreshLineState refresh0Plus;
+    RefreshLineState refresh0Mix;
+    RefreshLineState refreshTx80;
+    RefreshLineState refresh1;
+    RefreshLineState refresh2;
+    RefreshLineState refresh3;
+    RefreshLineState refresh4;
+    RefreshLineState refresh5;
+    RefreshLineState refresh6;
+    RefreshLineState refresh7;
+    RefreshLineState refresh8;
+    RefreshLineState refresh10;
+    RefreshLineState refresh12;
 };
 
 #include "SpriteLine.h"
@@ -415,10 +414,8 @@ static void updateOutputMode(VDP* vdp);
 // 1       2us       2us      7.95us
 // 2       2us       2us      7.95us   (R0&0x02)
 // 3       2us       2us      3.5us    (R1&0x08)
-static void checkVramAccessTimeTms(VDP* vdp)
+static void checkVramAccessTimeTms(VDP* vdp, UInt32 systemTime)
 {
-    static UInt32 oldTime = 0xffff0000;
-
     if (debuggerCheckVramAccess()) {
         UInt32 minTime;
 
@@ -443,10 +440,10 @@ static void checkVramAccessTimeTms(VDP* vdp)
             }
         }
 
-        if (boardSystemTime() - oldTime < minTime) {
-            boardOnBreakpoint(0);
+        if (systemTime - vdp->vramAccessTime < minTime) {
+            boardOnBreakpoint(vdp->board, 0);
         }
-        oldTime = boardSystemTime();
+        vdp->vramAccessTime = systemTime;
     }
 }
 
@@ -480,7 +477,7 @@ static void vdpBlink(VDP* vdp)
 
 static void scheduleScrModeChange(VDP* vdp)
 {
-    vdp->timeScrMode = vdp->frameStartTime + HPERIOD * (1 + (boardSystemTime() - vdp->frameStartTime) / HPERIOD);
+    vdp->timeScrMode = vdp->frameStartTime + HPERIOD * (1 + (boardSystemTime(vdp->board) - vdp->frameStartTime) / HPERIOD);
     vdp->timeScrModeEn = 1;
     boardTimerAdd(vdp->timerScrModeChange, vdp->timeScrMode);
 }
@@ -531,26 +528,24 @@ static void onHint(VDP* vdp, UInt32 time)
     vdp->timeHintEn = 0;
 
     if (vdp->vdpRegs[0] & 0x10) {
-        boardSetInt(INT_IE1);
+        boardSetInt(vdp->board, INT_IE1);
     }
 }
 
-int framecounter = 0;
-
 static void onVint(VDP* vdp, UInt32 time)
 {
     sync(vdp, time);
 
     vdp->timeVintEn = 0;
 
-    framecounter++;
+    vdp->frameCounter++;
 
 //    vdp->lineOffset = -1;
     vdp->vdpStatus[0] |= 0x80;
     vdp->vdpStatus[2] |= 0x40;
 //    if (vdp->vdpVersion != VDP_TMS9929A && vdp->vdpVersion != VDP_TMS99x8A) {
         if (vdp->vdpRegs[1] & 0x20) {
-            boardSetInt(INT_IE0);
+            boardSetInt(vdp->board, INT_IE0);
         }
 //    }
 //    vdp->drawArea = 0;
@@ -568,7 +563,7 @@ static void onDrawAreaEnd(VDP* vdp, UInt32 time)
 static void onTmsVint(VDP* vdp, UInt32 time)
 {
     if (vdp->vdpRegs[1] & 0x20) {
-        boardSetInt(INT_IE0);
+        boardSetInt(vdp->board, INT_IE0);
     }
 }
 
@@ -592,12 +587,14 @@ static void onDrawAreaStart(VDP* vdp, UInt32 time)
     vdpSetTimingMode(vdp->cmdEngine, ((vdp->vdpRegs[1] >> 6) & vdp->drawArea) | (vdp->vdpRegs[8] & 2));
 }
 
-static UInt32 frameStartTime;
-static int    timeDisplay;
-
-int getScreenCompletePercent() 
+int vdpGetScreenCompletePercent(BoardContext* board) 
 {
-    return 100 * (boardSystemTime() - frameStartTime) / timeDisplay;
+    VDP* vdp = boardGetVdp(board);
+
+    if (vdp == NULL || vdp->lastLine <= 0) {
+        return 0;
+    }
+    return 100 * (boardSystemTime(board) - vdp->frameStartTime) / (HPERIOD * vdp->lastLine);
 }
 
 static void onDisplay(VDP* vdp, UInt32 time)
@@ -610,12 +607,12 @@ static void onDisplay(VDP* vdp, UInt32 time)
 
     if (vdp->videoEnabled) {
         FrameBuffer* frameBuffer;
-        if (canFlipFrameBuffer >= 2) {
-            frameBuffer = frameBufferFlipDrawFrame();
+        if (vdp->canFlipFrameBuffer >= 2 && boardIsFrameVisible(vdp->board)) {
+            frameBuffer = frameBufferFlipDrawFrame(vdp->board);
         }
         else {
-            frameBuffer = frameBufferGetDrawFrame();
-            canFlipFrameBuffer++;
+            frameBuffer = frameBufferGetDrawFrame(vdp->board);
+            vdp->canFlipFrameBuffer++;
         }
         frameBufferSetLineCount(frameBuffer, 240);
         if (vdpIsInterlaceOn(vdp->vdpRegs)) {
@@ -626,7 +623,7 @@ static void onDisplay(VDP* vdp, UInt32 time)
         }
     }
 
-    refreshRate = isPal ? 50 : 60; // Update global refresh rate
+    vdp->refreshRate = isPal ? 50 : 60;
 
     vdp->scr0splitLine = 0;
     vdp->curLine = 0;
@@ -636,7 +633,7 @@ static void onDisplay(VDP* vdp, UInt32 time)
     vdp->displayOffest = isPal ? 27 : 0;
     vdp->firstLine = vdp->displayOffest + (vdpIsScanLines212(vdp->vdpRegs) ? 14 : 24) + vdp->VAdjust;
     if (!(vdp->vdpRegs[0] & 0x10)) {
-        boardClearInt(INT_IE1);
+        boardClearInt(vdp->board, INT_IE1);
     }
     vdp->vdpStatus[2] ^= 0x02;
     RefreshScreen(vdp->screenMode);
@@ -652,19 +649,22 @@ static void onDisplay(VDP* vdp, UInt32 time)
     scheduleHint(vdp);
     scheduleVint(vdp);
 
-    frameStartTime = vdp->frameStartTime;
-    timeDisplay    = HPERIOD * vdp->lastLine;
-
     if (vdp->vdpRegs[0] & 0x40) {
         if (vdp->screenMode >= 5 && vdp->screenMode <= 12) {
             digitize(vdp);
         }
     }
+
+    if (boardOnFrameStart(vdp->board)) {
+        // Run-ahead moved back to the start of an earlier frame. The
+        // frame drawn from here is complete, so it may be shown.
+        vdp->canFlipFrameBuffer = 2;
+    }
 }
 
 static void simulateVramDecay(VDP* vdp) 
 {
-    int time = (boardSystemTime() - vdp->screenOffTime) / 1350000;
+    int time = (boardSystemTime(vdp->board) - vdp->screenOffTime) / 1350000;
     int i;
     if (time >= 24) {
         for (i = 0x0000; i < 0x3000; i += 2) {
@@ -673,16 +673,15 @@ static void simulateVramDecay(VDP* vdp)
         }
     }
     else if (time >= 8) {
-        static UInt32 rnd = 0xfffffff3;
-        static UInt8 v[32] = { 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1 };
-        UInt8* vPtr = v + time - 8;
+        static const UInt8 v[32] = { 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1 };
+        const UInt8* vPtr = v + time - 8;
         time -= 8;
         for (i = 0x0000; i < 0x3000; i += 2) {
             int j = 8;
             UInt8 val = 0;
             while (j--) {
                 val <<= 1;
-                val |= vPtr[(rnd *= 17) >> 28];
+                val |= vPtr[(vdp->vramDecayRnd *= 17) >> 28];
             }
             vdp->vramPtr[i] |= val & 0x55;
             vdp->vramPtr[i] &= ~(val & 0xaa);
@@ -776,7 +775,7 @@ static int updateScreenMode(VDP* vdp) {
 
 static void onScrModeChange(VDP* vdp, UInt32 time)
 {
-    int scanLine = (boardSystemTime() - vdp->frameStartTime) / HPERIOD;
+    int scanLine = (boardSystemTime(vdp->board) - vdp->frameStartTime) / HPERIOD;
     int screenMode = vdp->screenMode;
     sync(vdp, time);
     
@@ -797,7 +796,7 @@ static void onScrModeChange(VDP* vdp, UInt32 time)
             if ((~vdp->vdpRegs[1] & 0x80) && !vdp->screenOn) {
                simulateVramDecay(vdp);
             }
-            vdp->screenOffTime = boardSystemTime();
+            vdp->screenOffTime = boardSystemTime(vdp->board);
         }
     }
 #endif
@@ -831,7 +830,7 @@ static void vdpUpdateRegisters(VDP* vdp, UInt8 reg, UInt8 value)
 
     reg   &= vdp->registerMask;
     value &= vdp->registerValueMask[reg];
-    sync(vdp, boardSystemTime());
+    sync(vdp, boardSystemTime(vdp->board));
 
 //    if (reg == 0 || reg == 1 || reg == 5 || reg == 6 || reg == 8 || reg == 9 || reg == 11 || reg == 23)
 //        printf("W %.2x: 0x%.2x\t%d\n", reg, value, boardSystemTime());
@@ -851,14 +850,14 @@ static void vdpUpdateRegisters(VDP* vdp, UInt8 reg, UInt8 value)
             vdp->vramAccMask  = vdp->vramMasks[((vdp->vdpRegs[8] & 0x08) >> 2) | (((vdp->vdpRegs[0x2d] >> 6) & 1))];
             vdp->vramEnable   = vdp->vram192 || !((value >> 6) & 1);
         }
-        vdpCmdWrite(vdp->cmdEngine, reg - 0x20, value, boardSystemTime());
+        vdpCmdWrite(vdp->cmdEngine, reg - 0x20, value, boardSystemTime(vdp->board));
         return;
     }
 
     switch (reg) {
     case 0: 
         if (!(value & 0x10)) {
-            boardClearInt(INT_IE1);
+            boardClearInt(vdp->board, INT_IE1);
         }
 
         if (change & 0x0e) {
@@ -874,10 +873,10 @@ static void vdpUpdateRegisters(VDP* vdp, UInt8 reg, UInt8 value)
     case 1: 
         if (vdp->vdpStatus[0] & 0x80) {
 			if (value & 0x20) {
-				boardSetInt(INT_IE0);
+				boardSetInt(vdp->board, INT_IE0);
 			}
 			else {
-				boardClearInt(INT_IE0);
+				boardClearInt(vdp->board, INT_IE0);
 			}
         }
 
@@ -962,7 +961,7 @@ static void vdpUpdateRegisters(VDP* vdp, UInt8 reg, UInt8 value)
         break;
 
     case 19:
-        boardClearInt(INT_IE1);
+        boardClearInt(vdp->board, INT_IE1);
         if (change) {
             scheduleHint(vdp);
         }
@@ -971,10 +970,10 @@ static void vdpUpdateRegisters(VDP* vdp, UInt8 reg, UInt8 value)
     case 23:
         if (change) {
             scheduleHint(vdp);
-            spriteLineInvalidate(vdp, (boardSystemTime() - vdp->frameStartTime) / HPERIOD);
+            spriteLineInvalidate(vdp, (boardSystemTime(vdp->board) - vdp->frameStartTime) / HPERIOD);
         }
         if (!(vdp->vdpRegs[0] & 0x10)) {
-            boardClearInt(INT_IE1);
+            boardClearInt(vdp->board, INT_IE1);
         }
         break;
 
@@ -992,7 +991,7 @@ static void vdpUpdateRegisters(VDP* vdp, UInt8 reg, UInt8 value)
 static UInt8 peek(VDP* vdp, UInt16 ioPort) 
 {
     if (vdp->vdpVersion == VDP_V9938 || vdp->vdpVersion == VDP_V9958) {
-        vdpCmdExecute(vdp->cmdEngine, boardSystemTime());
+        vdpCmdExecute(vdp->cmdEngine, boardSystemTime(vdp->board));
     }
 
 	return vdp->vdpData;
@@ -1003,7 +1002,7 @@ static UInt8 readNoTimingCheck(VDP* vdp, UInt16 ioPort)
     UInt8 value;
 
     if (vdp->vdpVersion == VDP_V9938 || vdp->vdpVersion == VDP_V9958) {
-        vdpCmdExecute(vdp->cmdEngine, boardSystemTime());
+        vdpCmdExecute(vdp->cmdEngine, boardSystemTime(vdp->board));
     }
 
 	value = vdp->vdpData;
@@ -1020,7 +1019,7 @@ static UInt8 readNoTimingCheck(VDP* vdp, UInt16 ioPort)
 static UInt8 read(VDP* vdp, UInt16 ioPort) 
 {
     if (vdp->vdpVersion == VDP_TMS9929A || vdp->vdpVersion == VDP_TMS99x8A) {
-        checkVramAccessTimeTms(vdp);
+        checkVramAccessTimeTms(vdp, boardSystemTime(vdp->board));
     }
 
     return readNoTimingCheck(vdp, ioPort);
@@ -1030,7 +1029,7 @@ static UInt8 peekStatus(VDP* vdp, UInt16 ioPort)
 {
     UInt8 vdpStatus;
 
-    sync(vdp, boardSystemTime());
+    sync(vdp, boardSystemTime(vdp->board));
     if (vdp->vdpVersion == VDP_TMS9929A || vdp->vdpVersion == VDP_TMS99x8A) {
         return vdp->vdpStatus[0];
     }
@@ -1039,12 +1038,12 @@ static UInt8 peekStatus(VDP* vdp, UInt16 ioPort)
     switch(vdp->vdpRegs[15]) {
     case 1: 
         if (vdp->vdpRegs[0] & 0x10) {
-            if (boardGetInt(INT_IE1)) {
+            if (boardGetInt(vdp->board, INT_IE1)) {
                 vdpStatus |=  0x01;
             }
         }
         else {
-            if (boardSystemTime() - vdp->timeHint < HPERIOD - vdp->displayArea) {
+            if (boardSystemTime(vdp->board) - vdp->timeHint < HPERIOD - vdp->displayArea) {
                 vdpStatus |= 0x01;
             }
         }
@@ -1052,7 +1051,7 @@ static UInt8 peekStatus(VDP* vdp, UInt16 ioPort)
 
     case 2:
         {
-            UInt32 frameTime = boardSystemTime() - vdp->frameStartTime;
+            UInt32 frameTime = boardSystemTime(vdp->board) - vdp->frameStartTime;
             vdpStatus |= 0x40 | 0x20 | vdpGetStatus(vdp->cmdEngine);
             if (vdp->drawArea || (frameTime - ((vdp->firstLine - 1) * HPERIOD + vdp->leftBorder - 10) < 4 * HPERIOD)) {
                 vdpStatus &= ~0x40;
@@ -1083,14 +1082,14 @@ static UInt8 readStatus(VDP* vdp, UInt16 ioPort)
 {
     UInt8 vdpStatus;
 
-    sync(vdp, boardSystemTime());
+    sync(vdp, boardSystemTime(vdp->board));
 
     vdp->vdpKey = 0;
 
     if (vdp->vdpVersion == VDP_TMS9929A || vdp->vdpVersion == VDP_TMS99x8A) {
         vdpStatus = vdp->vdpStatus[0];
         vdp->vdpStatus[0] &= 0x1f;
-        boardClearInt(INT_IE0);
+        boardClearInt(vdp->board, INT_IE0);
         return vdpStatus;
     }
     
@@ -1100,18 +1099,18 @@ static UInt8 readStatus(VDP* vdp, UInt16 ioPort)
     case 0: 
 //        printf("I %.2x: 0x%.2x\t%d\n", vdp->vdpRegs[15], vdpStatus, boardSystemTime());
         vdp->vdpStatus[0] &= 0x1f;
-        boardClearInt(INT_IE0);
+        boardClearInt(vdp->board, INT_IE0);
         break;
 
     case 1: 
         if (vdp->vdpRegs[0] & 0x10) {
-            if (boardGetInt(INT_IE1)) {
-                boardClearInt(INT_IE1);
+            if (boardGetInt(vdp->board, INT_IE1)) {
+                boardClearInt(vdp->board, INT_IE1);
                 vdpStatus |=  0x01;
             }
         }
         else {
-            if (boardSystemTime() - vdp->timeHint < HPERIOD - vdp->displayArea) {
+            if (boardSystemTime(vdp->board) - vdp->timeHint < HPERIOD - vdp->displayArea) {
                 vdpStatus |= 0x01;
             }
         }
@@ -1119,7 +1118,7 @@ static UInt8 readStatus(VDP* vdp, UInt16 ioPort)
 
     case 2:
         {
-            UInt32 frameTime = boardSystemTime() - vdp->frameStartTime;
+            UInt32 frameTime = boardSystemTime(vdp->board) - vdp->frameStartTime;
             vdpStatus |= 0x40 | 0x20 | vdpGetStatus(vdp->cmdEngine);
             if (vdp->drawArea || (frameTime - ((vdp->firstLine - 1) * HPERIOD + vdp->leftBorder - 10) < 4 * HPERIOD)) {
                 vdpStatus &= ~0x40;
@@ -1150,12 +1149,10 @@ static UInt8 peekVram(VDP* vdp, int address) {
     return vdp->vram[address];
 }
                   
-static void write(VDP* vdp, UInt16 ioPort, UInt8 value)
+static void writeData(VDP* vdp, UInt8 value, UInt32 systemTime)
 {
-    sync(vdp, boardSystemTime());
-
     if (vdp->vdpVersion == VDP_TMS9929A || vdp->vdpVersion == VDP_TMS99x8A) {
-        checkVramAccessTimeTms(vdp);
+        checkVramAccessTimeTms(vdp, systemTime);
     }
 
     if (vdp->vramEnable) {
@@ -1163,7 +1160,7 @@ static void write(VDP* vdp, UInt16 ioPort, UInt8 value)
         if (!(index & ~vdp->vramAccMask)) {
             vdp->vram[index] = value;
 
-            tryWatchpoint(DBGTYPE_VIDEO, index, value, vdp, peekVram);
+            tryWatchpoint(vdp->board, DBGTYPE_VIDEO, index, value, vdp, peekVram);
 //        printf("W(0x%.4x): %.2x\n", (vdp->vdpRegs[14] << 14) | vdp->vramAddress, value);
 //            *MAP_VRAM(vdp, (vdp->vdpRegs[14] << 14) | vdp->vramAddress) = value;
         }
@@ -1174,8 +1171,28 @@ static void write(VDP* vdp, UInt16 ioPort, UInt8 value)
     if (vdp->vramAddress == 0 && vdp->screenMode > 3) {
         vdp->vdpRegs[14] = (vdp->vdpRegs[14] + 1 )& (vdp->vramPages - 1);
     }
-    if (!vdp->videoEnabled && boardGetVideoAutodetect() && videoManagerGetCount() > 1) {
-        videoManagerSetActive(vdp->videoHandle);
+    if (!vdp->videoEnabled && boardGetVideoAutodetect(vdp->board) && videoManagerGetCount(vdp->board) > 1) {
+        videoManagerSetActive(vdp->board, vdp->videoHandle);
+    }
+}
+
+static void write(VDP* vdp, UInt16 ioPort, UInt8 value)
+{
+    sync(vdp, boardSystemTime(vdp->board));
+    writeData(vdp, value, boardSystemTime(vdp->board));
+}
+
+// Data written by a block I/O instruction. Each value is written at the
+// time the CPU wrote it, with the VDP and the command engine synced to
+// that time first.
+static void writeBlock(VDP* vdp, UInt16 ioPort, const UInt8* values, 
+                       const UInt32* times, int count)
+{
+    int i;
+
+    for (i = 0; i < count; i++) {
+        syncAt(vdp, times[i], times[i]);
+        writeData(vdp, values[i], times[i]);
     }
 }
 
@@ -1275,9 +1292,9 @@ static void digitize(VDP* vdp)
     int yDelta = 14 + vdp->VAdjust;
     int x, y;
 
-    vdpDaDevice.callbacks.daStart(vdpDaDevice.ref, vdpIsOddPage(vdp));
+    vdp->daDevice.callbacks.daStart(vdp->daDevice.ref, vdpIsOddPage(vdp));
 
-#define videoDaGet(sm, x, y, pal, cnt) vdpDaDevice.callbacks.daRead(vdpDaDevice.ref, sm, x, y, pal, cnt)
+#define videoDaGet(sm, x, y, pal, cnt) vdp->daDevice.callbacks.daRead(vdp->daDevice.ref, sm, x, y, pal, cnt)
 
     for (y = 0; y < 212; y++) {
         UInt8* charTable = vdp->vram + (vdp->chrTabBase & (~vdpIsOddPage(vdp) << 7) & ((-1 << 15) | ((y + vdpVScroll(vdp)) << 7)));
@@ -1316,7 +1333,7 @@ static void digitize(VDP* vdp)
         }
     }
     
-    vdpDaDevice.callbacks.daEnd(vdpDaDevice.ref);
+    vdp->daDevice.callbacks.daEnd(vdp->daDevice.ref);
 }
 
 static void updateOutputMode(VDP* vdp)
@@ -1328,15 +1345,15 @@ static void updateOutputMode(VDP* vdp)
         (!(vdp->vdpRegs[8] & 0x80) && (vdp->vdpRegs[8] & 0x10)) || (vdp->vdpRegs[0] & 0x40)) 
     {
         if (vdp->screenMode >=5 && vdp->screenMode <= 12) {
-            videoManagerSetMode(vdp->videoHandle, VIDEO_EXTERNAL, vdpDaDevice.videoModeMask);
+            videoManagerSetMode(vdp->board, vdp->videoHandle, VIDEO_EXTERNAL, vdp->daDevice.videoModeMask);
         }
         else {
-            videoManagerSetMode(vdp->videoHandle, VIDEO_INTERNAL, vdpDaDevice.videoModeMask);
+            videoManagerSetMode(vdp->board, vdp->videoHandle, VIDEO_INTERNAL, vdp->daDevice.videoModeMask);
         }
     }
     else if (mode == 1 && transparency) {
         vdp->palette[0] = videoGetTransparentColor();
-        videoManagerSetMode(vdp->videoHandle, VIDEO_MIX, vdpDaDevice.videoModeMask);
+        videoManagerSetMode(vdp->board, vdp->videoHandle, VIDEO_MIX, vdp->daDevice.videoModeMask);
     }
     else {
         if (vdp->BGColor == 0 || !transparency) {
@@ -1345,7 +1362,7 @@ static void updateOutputMode(VDP* vdp)
         else {
             vdp->palette[0] = vdp->palette[vdp->BGColor];
         }
-        videoManagerSetMode(vdp->videoHandle, VIDEO_INTERNAL, vdpDaDevice.videoModeMask);
+        videoManagerSetMode(vdp->board, vdp->videoHandle, VIDEO_INTERNAL, vdp->daDevice.videoModeMask);
     }
 }
 
@@ -1368,7 +1385,7 @@ static void writePaletteLatch(VDP* vdp, UInt16 ioPort, UInt8 value)
 {
     if (vdp->palKey) {
 		int palEntry = vdp->vdpRegs[16];
-        sync(vdp, boardSystemTime());
+        sync(vdp, boardSystemTime(vdp->board));
         vdp->paletteReg[palEntry] = 256 * (value & 0x07) | (vdp->vdpDataLatch & 0x77);
         updatePalette(vdp, palEntry, (vdp->vdpDataLatch & 0x70) * 255 / 112, 
                                      (value & 0x07) * 255 / 7,
@@ -1397,14 +1414,55 @@ static void writeRegister(VDP* vdp, UInt16 ioPort, UInt8 value)
     }
 }
 
-void vdpForceSync()
+int vdpGetRefreshRate(BoardContext* board)
+{
+    VDP* vdp = boardGetVdp(board);
+
+    return vdp != NULL ? vdp->refreshRate : 0;
+}
+
+int vdpRegisterDaConverter(BoardContext* board, VdpDaCallbacks* callbacks, void* ref, VideoMode videoModeMask)
+{
+    VDP* vdp = boardGetVdp(board);
+
+    if (vdp == NULL) {
+        return 0;
+    }
+
+    vdp->daDevice.videoModeMask     = videoModeMask;
+    vdp->daDevice.callbacks.daStart = callbacks->daStart ? callbacks->daStart : daStart;
+    vdp->daDevice.callbacks.daEnd   = callbacks->daEnd   ? callbacks->daEnd   : daEnd;
+    vdp->daDevice.callbacks.daRead  = callbacks->daRead  ? callbacks->daRead  : daRead;
+    vdp->daDevice.ref               = ref;
+    vdp->daDevice.handle++;
+
+    return vdp->daDevice.handle;
+}
+
+void vdpUnregisterDaConverter(BoardContext* board, int vdpDaHandle)
 {
-    if (theVdp != NULL) {
-        sync(theVdp, boardSystemTime());
+    VDP* vdp = boardGetVdp(board);
+
+    if (vdp != NULL && vdpDaHandle == vdp->daDevice.handle) {
+        daDeviceReset(&vdp->daDevice);
+    }
+}
+
+void vdpForceSync(BoardContext* board)
+{
+    VDP* vdp = boardGetVdp(board);
+
+    if (vdp != NULL) {
+        sync(vdp, boardSystemTime(board));
     }
 }
 
 static void sync(VDP* vdp, UInt32 systemTime) 
+{
+    syncAt(vdp, systemTime, boardSystemTime(vdp->board));
+}
+
+static void syncAt(VDP* vdp, UInt32 systemTime, UInt32 cmdTime) 
 {
     int frameTime = systemTime - vdp->frameStartTime;
     int scanLine = frameTime / HPERIOD;
@@ -1412,10 +1470,10 @@ static void sync(VDP* vdp, UInt32 systemTime)
     int curLineOffset;
 
     if (vdp->vdpVersion == VDP_V9938 || vdp->vdpVersion == VDP_V9958) {
-        vdpCmdExecute(vdp->cmdEngine, boardSystemTime());
+        vdpCmdExecute(vdp->cmdEngine, cmdTime);
     }
 
-    if (!vdp->videoEnabled || !displayEnable || frameBufferGetDrawFrame() == NULL) {
+    if (!vdp->videoEnabled || !boardGetDisplayEnable(vdp->board) || frameBufferGetDrawFrame(vdp->board) == NULL) {
         return;
     }
 
@@ -1423,6 +1481,7 @@ static void sync(VDP* vdp, UInt32 systemTime)
         if (vdp->lineOffset <= 32) {
             if (vdp->curLine >= vdp->displayOffest && vdp->curLine < vdp->displayOffest + SCREEN_HEIGHT) {
                 vdp->RefreshLine(vdp, vdp->curLine, vdp->lineOffset, 33);
+                frameBufferHashLine(frameBufferGetDrawFrame(vdp->board), vdp->curLine - vdp->displayOffest);
             }
         }
         vdp->lineOffset = -1;
@@ -1430,6 +1489,7 @@ static void sync(VDP* vdp, UInt32 systemTime)
         while (vdp->curLine < scanLine) {
             if (vdp->curLine >= vdp->displayOffest && vdp->curLine < vdp->displayOffest + SCREEN_HEIGHT) {
                 vdp->RefreshLine(vdp, vdp->curLine, -1, 33);
+                frameBufferHashLine(frameBufferGetDrawFrame(vdp->board), vdp->curLine - vdp->displayOffest);
             }
             vdp->curLine++;
         }
@@ -1447,6 +1507,9 @@ static void sync(VDP* vdp, UInt32 systemTime)
     if (vdp->lineOffset < curLineOffset) {
         if (vdp->curLine >= vdp->displayOffest && vdp->curLine < vdp->displayOffest + SCREEN_HEIGHT) {
             vdp->RefreshLine(vdp, vdp->curLine, vdp->lineOffset, curLineOffset);
+            if (curLineOffset == 33) {
+                frameBufferHashLine(frameBufferGetDrawFrame(vdp->board), vdp->curLine - vdp->displayOffest);
+            }
         }
         vdp->lineOffset = curLineOffset;
     }
@@ -1454,7 +1517,7 @@ static void sync(VDP* vdp, UInt32 systemTime)
 #if 0
 static void saveState(VDP* vdp)
 {
-    SaveState* state = saveStateOpenForWrite("vdp");
+    SaveState* state = saveStateOpenForWrite(vdp->board, "vdp");
     char tag[32];
     int index;
 
@@ -1513,8 +1576,8 @@ static void saveState(VDP* vdp)
 
 static void loadState(VDP* vdp)
 {
-    SaveState* state = saveStateOpenForRead("vdp");
-    UInt32 systemTime = boardSystemTime() + 100;
+    SaveState* state = saveStateOpenForRead(vdp->board, "vdp");
+    UInt32 systemTime = boardSystemTime(vdp->board) + 100;
     char tag[32];
     int index;
 
@@ -1555,7 +1618,7 @@ static void loadState(VDP* vdp)
 
     vdp->palette0 = saveStateGet(state, "paletteTmp0",        0);
 
-    vdp->screenOffTime = boardSystemTime();
+    vdp->screenOffTime = boardSystemTime(vdp->board);
 
     saveStateGetBuffer(state, "regs", vdp->vdpRegs, sizeof(vdp->vdpRegs));
     saveStateGetBuffer(state, "status", vdp->vdpStatus, sizeof(vdp->vdpStatus));
@@ -1624,9 +1687,9 @@ static void loadState(VDP* vdp)
 //        boardTimerAdd(vdp->timerTmsVint, vdp->timeTmsVint);
 //    }
 
-    onScrModeChange(vdp, boardSystemTime());
+    onScrModeChange(vdp, boardSystemTime(vdp->board));
 
-    canFlipFrameBuffer = 0;
+    vdp->canFlipFrameBuffer = 0;
 }
 
 #else
@@ -1634,7 +1697,7 @@ static void loadState(VDP* vdp)
 
 static void saveState(VDP* vdp)
 {
-    SaveState* state = saveStateOpenForWrite("vdp");
+    SaveState* state = saveStateOpenForWrite(vdp->board, "vdp");
     char tag[32];
     int i;
 
@@ -1726,8 +1789,8 @@ static void saveState(VDP* vdp)
 
 static void loadState(VDP* vdp)
 {
-    SaveState* state = saveStateOpenForRead("vdp");
-    UInt32 systemTime = boardSystemTime() + 100;
+    SaveState* state = saveStateOpenForRead(vdp->board, "vdp");
+    UInt32 systemTime = boardSystemTime(vdp->board) + 100;
     char tag[32];
     int i;
 
@@ -1818,7 +1881,7 @@ static void loadState(VDP* vdp)
 
     vdp->vramPtr = vdp->vram + vdp->vramOffsets[(vdp->vdpRegs[0x2d] >> 6) & 1];
 
-    canFlipFrameBuffer = 0;
+    vdp->canFlipFrameBuffer = 0;
 
     updateScreenMode(vdp);
 
@@ -1882,7 +1945,7 @@ static void getDebugInfo(VDP* vdp, DbgDevice* dbgDevice)
         break;
     }
 
-    sync(vdp, boardSystemTime());
+    sync(vdp, boardSystemTime(vdp->board));
 
     dbgDeviceAddMemoryBlock(dbgDevice, langDbgMemVram(), 0, 0, vdp->vramSize, vdp->vram);
 
@@ -1921,7 +1984,7 @@ static void getDebugInfo(VDP* vdp, DbgDevice* dbgDevice)
     for (i = 0; i < cmdRegCount; i++) {
         char reg[4];
         sprintf(reg, "R%d", 32 + i);
-        dbgRegisterBankAddRegister(regBank, regOffset++, reg, 8, vdpCmdPeek(vdp->cmdEngine, i, boardSystemTime()));
+        dbgRegisterBankAddRegister(regBank, regOffset++, reg, 8, vdpCmdPeek(vdp->cmdEngine, i, boardSystemTime(vdp->board)));
     }
 
     for (i = 0; i < paletteCount; i++) {
@@ -1936,7 +1999,7 @@ static void getDebugInfo(VDP* vdp, DbgDevice* dbgDevice)
         dbgRegisterBankAddRegister(regBank, regOffset++, reg, 8, vdp->vdpStatus[i]);
     }
 
-    frameTime = boardSystemTime() - vdp->frameStartTime;
+    frameTime = boardSystemTime(vdp->board) - vdp->frameStartTime;
     scanLine = frameTime / HPERIOD;
     lineTime = frameTime % HPERIOD;
     if (scanLine < 0) scanLine += vdpIsVideoPal(vdp) ? 313 : 262;
@@ -2060,10 +2123,10 @@ static void reset(VDP* vdp)
 {
     int i;
 
-    RefreshLineReset();
+    RefreshLineReset(vdp);
 
-    vdp->frameStartTime  = boardSystemTime();
-    vdp->timeDisplay     = boardSystemTime();
+    vdp->frameStartTime  = boardSystemTime(vdp->board);
+    vdp->timeDisplay     = boardSystemTime(vdp->board);
     vdp->scr0splitLine   = 0;
     vdp->vramPage        = 0;
     vdp->sprGenBase      = 0;
@@ -2095,7 +2158,7 @@ static void reset(VDP* vdp)
     vdp->lineOffset      = 256;
     vdp->firstLine       = 1;
     vdp->lastLine        = -1;
-    vdp->screenOffTime = boardSystemTime();
+    vdp->screenOffTime = boardSystemTime(vdp->board);
     
     vdp->timeScrModeEn       = 0;
     vdp->timeHintEn          = 0;
@@ -2134,45 +2197,45 @@ static void reset(VDP* vdp)
 
     memcpy(vdp->paletteReg, defaultPaletteRegs, sizeof(vdp->paletteReg));
 
-    onScrModeChange(vdp, boardSystemTime());
+    onScrModeChange(vdp, boardSystemTime(vdp->board));
 
-    onDisplay(vdp, boardSystemTime());
+    onDisplay(vdp, boardSystemTime(vdp->board));
 }
 
 static void destroy(VDP* vdp) 
 {
     int i;
 
-    theVdp = NULL;
+    boardSetVdp(vdp->board, NULL);
 
-    debugDeviceUnregister(vdp->debugHandle);
-    deviceManagerUnregister(vdp->deviceHandle);
-    videoManagerUnregister(vdp->videoHandle);
+    debugDeviceUnregister(vdp->board, vdp->debugHandle);
+    deviceManagerUnregister(vdp->board, vdp->deviceHandle);
+    videoManagerUnregister(vdp->board, vdp->videoHandle);
 
     switch (vdp->vdpConnector) {
     case VDP_MSX:
-        ioPortUnregister(0x98);
-        ioPortUnregister(0x99);
-        ioPortUnregister(0x9a);
-        ioPortUnregister(0x9b);
+        ioPortUnregister(vdp->board, 0x98);
+        ioPortUnregister(vdp->board, 0x99);
+        ioPortUnregister(vdp->board, 0x9a);
+        ioPortUnregister(vdp->board, 0x9b);
         break;
 
     case VDP_SVI:
-        ioPortUnregister(0x80);
-        ioPortUnregister(0x81);
-        ioPortUnregister(0x84);
-        ioPortUnregister(0x85);
+        ioPortUnregister(vdp->board, 0x80);
+        ioPortUnregister(vdp->board, 0x81);
+        ioPortUnregister(vdp->board, 0x84);
+        ioPortUnregister(vdp->board, 0x85);
         break;
 
     case VDP_COLECO:
         for (i = 0xa0; i < 0xc0; i++) {
-            ioPortUnregister(i);
+            ioPortUnregister(vdp->board, i);
         }
         break;
 
     case VDP_SG1000:
         for (i = 0x80; i < 0xc0; i++) {
-            ioPortUnregister(i);
+            ioPortUnregister(vdp->board, i);
         }
         break;
     }
@@ -2188,7 +2251,7 @@ static void destroy(VDP* vdp)
 
     vdpCmdDestroy(vdp->cmdEngine);
 
-    frameBufferDataDestroy(vdp->frameBuffer);
+    frameBufferDataDestroy(vdp->board, vdp->frameBuffer);
 
     free(vdp);
 }
@@ -2203,7 +2266,7 @@ static void videoDisable(VDP* vdp)
     vdp->videoEnabled = 0;
 }
 
-void vdpCreate(VdpConnector connector, VdpVersion version, VdpSyncMode sync, int vramPages)
+void vdpCreate(BoardContext* board, VdpConnector connector, VdpVersion version, VdpSyncMode sync, int vramPages)
 {
     DeviceCallbacks callbacks = { destroy, reset, saveState, loadState };
     DebugCallbacks dbgCallbacks = { getDebugInfo, dbgWriteMemory, dbgWriteRegister, NULL };
@@ -2214,20 +2277,29 @@ void vdpCreate(VdpConnector connector, VdpVersion version, VdpSyncMode sync, int
 
     VDP* vdp = (VDP*)calloc(1, sizeof(VDP));
 
-    theVdp = vdp;
+    vdp->board = board;
+
+    boardSetVdp(board, vdp);
+
+    daDeviceReset(&vdp->daDevice);
+    vdp->vramAccessTime = 0xffff0000;
+    vdp->vramDecayRnd   = 0xfffffff3;
+    vdp->spriteLines[0] = nullSpritesLine();
+    vdp->spriteLines[1] = nullSpritesLine();
+    vdp->nonVisibleLine = -1;
 
     initPalette(vdp);
 
-    vdp->deviceHandle = deviceManagerRegister(ROM_V9958, &callbacks, vdp);
+    vdp->deviceHandle = deviceManagerRegister(board, ROM_V9958, &callbacks, vdp);
 
-    vdp->timerDisplay       = boardTimerCreate(onDisplay, vdp);
-    vdp->timerDrawAreaStart = boardTimerCreate(onDrawAreaStart, vdp);
-    vdp->timerVStart        = boardTimerCreate(onVStart, vdp);
-    vdp->timerScrModeChange = boardTimerCreate(onScrModeChange, vdp);
-    vdp->timerHint          = boardTimerCreate(onHint, vdp);
-    vdp->timerVint          = boardTimerCreate(onVint, vdp);
-    vdp->timerDrawAreaEnd   = boardTimerCreate(onDrawAreaEnd, vdp);
-    vdp->timerTmsVint       = boardTimerCreate(onTmsVint, vdp);
+    vdp->timerDisplay       = boardTimerCreate(board, onDisplay, vdp);
+    vdp->timerDrawAreaStart = boardTimerCreate(board, onDrawAreaStart, vdp);
+    vdp->timerVStart        = boardTimerCreate(board, onVStart, vdp);
+    vdp->timerScrModeChange = boardTimerCreate(board, onScrModeChange, vdp);
+    vdp->timerHint          = boardTimerCreate(board, onHint, vdp);
+    vdp->timerVint          = boardTimerCreate(board, onVint, vdp);
+    vdp->timerDrawAreaEnd   = boardTimerCreate(board, onDrawAreaEnd, vdp);
+    vdp->timerTmsVint       = boardTimerCreate(board, onTmsVint, vdp);
 
     vdp->RefreshLine = RefreshLine0; 
 
@@ -2261,8 +2333,8 @@ void vdpCreate(VdpConnector connector, VdpVersion version, VdpSyncMode sync, int
     vdp->vdpVersion    = version;
     vdp->vdpConnector  = connector;
 
-    vdp->frameBuffer   = frameBufferDataCreate(8 + 256 + 8, 240, 1);
-    vdp->videoHandle   = videoManagerRegister(VdpNames[version], vdp->frameBuffer, &videoCallbacks, vdp);
+    vdp->frameBuffer   = frameBufferDataCreate(board, 8 + 256 + 8, 240, 1);
+    vdp->videoHandle   = videoManagerRegister(board, VdpNames[version], vdp->frameBuffer, &videoCallbacks, vdp);
 
     if (sync == VDP_SYNC_AUTO) {
         vdp->palMask  = ~0;
@@ -2278,7 +2350,7 @@ void vdpCreate(VdpConnector connector, VdpVersion version, VdpSyncMode sync, int
     }
 
     memset(vdp->vram, 0, VRAM_SIZE);
-    vdp->cmdEngine = vdpCmdCreate(vramSize, vdp->vram, boardSystemTime());
+    vdp->cmdEngine = vdpCmdCreate(board, vramSize, vdp->vram, boardSystemTime(board));
 
     reset(vdp);
 
@@ -2310,35 +2382,39 @@ void vdpCreate(VdpConnector connector, VdpVersion version, VdpSyncMode sync, int
         break;
     }
     
-    vdp->debugHandle = debugDeviceRegister(DBGTYPE_VIDEO, vdpVersionString, &dbgCallbacks, vdp);
+    vdp->debugHandle = debugDeviceRegister(board, DBGTYPE_VIDEO, vdpVersionString, &dbgCallbacks, vdp);
 
     switch (vdp->vdpConnector) {
     case VDP_MSX:
-        ioPortRegister(0x98, read,       write,      vdp);
-        ioPortRegister(0x99, readStatus, writeLatch, vdp);
+        ioPortRegister(board, 0x98, read,       write,      vdp);
+        ioPortRegister(board, 0x99, readStatus, writeLatch, vdp);
+        ioPortRegisterWriteBlock(board, 0x98, writeBlock);
         if (vdp->vdpVersion == VDP_V9938 || vdp->vdpVersion == VDP_V9958) {
-            ioPortRegister(0x9a, NULL, writePaletteLatch, vdp);
-            ioPortRegister(0x9b, NULL, writeRegister,     vdp);
+            ioPortRegister(board, 0x9a, NULL, writePaletteLatch, vdp);
+            ioPortRegister(board, 0x9b, NULL, writeRegister,     vdp);
         }
         break;
 
     case VDP_SVI:
-        ioPortRegister(0x80, NULL,       write,      vdp); // vdp->vdpRegs vdp->vram Write
-        ioPortRegister(0x81, NULL,       writeLatch, vdp); // vdp->vdpRegs Address Latch
-        ioPortRegister(0x84, read,       NULL,       vdp); // vdp->vdpRegs vdp->vram Read
-        ioPortRegister(0x85, readStatus, NULL,       vdp); // vdp->vdpRegs Status Read
+        ioPortRegister(board, 0x80, NULL,       write,      vdp); // vdp->vdpRegs vdp->vram Write
+        ioPortRegister(board, 0x81, NULL,       writeLatch, vdp); // vdp->vdpRegs Address Latch
+        ioPortRegisterWriteBlock(board, 0x80, writeBlock);
+        ioPortRegister(board, 0x84, read,       NULL,       vdp); // vdp->vdpRegs vdp->vram Read
+        ioPortRegister(board, 0x85, readStatus, NULL,       vdp); // vdp->vdpRegs Status Read
         break;
 
     case VDP_COLECO:
         for (i = 0xa0; i < 0xc0; i += 2) {
-            ioPortRegister(i,     read,       write,      vdp);
-            ioPortRegister(i + 1, readStatus, writeLatch, vdp);
+            ioPortRegister(board, i,     read,       write,      vdp);
+            ioPortRegister(board, i + 1, readStatus, writeLatch, vdp);
+            ioPortRegisterWriteBlock(board, i, writeBlock);
         }
         break;
         
     case VDP_SG1000:
-        ioPortRegister(0xbe, read,       write,      vdp);
-        ioPortRegister(0xbf, readStatus, writeLatch, vdp);
+        ioPortRegister(board, 0xbe, read,       write,      vdp);
+        ioPortRegister(board, 0xbf, readStatus, writeLatch, vdp);
+        ioPortRegisterWriteBlock(board, 0xbe, writeBlock);
         break;
     }
 }
@@ -37,18 +37,16 @@ typedef enum { VDP_MSX, VDP_SVI, VDP_COLECO, VDP_SG1000 } VdpConnector;
 
 static const char* VdpNames[] = { "V9938", "V9958", "TMS9929A", "TMS99x8A" };
 
-void vdpCreate(VdpConnector connector, VdpVersion version, VdpSyncMode sync, int vramPages);
+typedef struct VDP VDP;
 
-int  vdpGetRefreshRate();
+void vdpCreate(BoardContext* board, VdpConnector connector, VdpVersion version, VdpSyncMode sync, int vramPages);
 
-void vdpSetSpritesEnable(int enable);
-int  vdpGetSpritesEnable();
-void vdpSetNoSpriteLimits(int enable);
-int  vdpGetNoSpritesLimit();
-void vdpSetDisplayEnable(int enable);
-int  vdpGetDisplayEnable();
+int  vdpGetRefreshRate(BoardContext* board);
 
-void vdpForceSync();
+// Percentage of the current frame that is drawn
+int  vdpGetScreenCompletePercent(BoardContext* board);
+
+void vdpForceSync(BoardContext* board);
 
 // Video DA Interface
 
@@ -61,8 +59,8 @@ typedef struct {
     UInt8 (*daRead)(void*, int, int, int, Pixel*, int);
 } VdpDaCallbacks;
 
-int vdpRegisterDaConverter(VdpDaCallbacks* callbacks, void* ref, VideoMode videoModeMask);
-void vdpUnregisterDaConverter(int vdpDaHandle);
+int vdpRegisterDaConverter(BoardContext* board, VdpDaCallbacks* callbacks, void* ref, VideoMode videoModeMask);
+void vdpUnregisterDaConverter(BoardContext* board, int vdpDaHandle);
 
 /* The following methods needs target dependent implementation */
 extern void RefreshScreen(int);
@@ -28,6 +28,7 @@
 #include "VideoManager.h"
 #include "ArchNotifications.h"
 #include "SaveState.h"
+#include "Board.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -44,154 +45,177 @@ typedef struct {
     char  name[32];
 } VideoInfo;
 
-typedef struct {
+struct VideoManagerContext {
     VideoInfo di[MAX_DEVICES];
     int count;
     int lastHandle;
-} VideoManager;
+};
+
+VideoManagerContext* videoManagerContextCreate()
+{
+    return calloc(1, sizeof(VideoManagerContext));
+}
 
-static VideoManager videoManager;
+void videoManagerContextDestroy(VideoManagerContext* context)
+{
+    free(context);
+}
 
-void videoManagerReset() 
+void videoManagerReset(BoardContext* board) 
 {
-    videoManager.count = 0;
-    videoManager.lastHandle = 0;
+    VideoManagerContext* ctx = boardGetVideoManager(board);
+
+    ctx->count = 0;
+    ctx->lastHandle = 0;
 }
 
-int videoManagerGetCount() 
+int videoManagerGetCount(BoardContext* board) 
 {
-    return videoManager.count;
+    VideoManagerContext* ctx = boardGetVideoManager(board);
+
+    return ctx->count;
 }
 
-int videoManagerIsActive(int index) 
+int videoManagerIsActive(BoardContext* board, int index) 
 {
-    if (index >= videoManager.count) {
+    VideoManagerContext* ctx = boardGetVideoManager(board);
+
+    if (index >= ctx->count) {
         return 0;
     }
 
-    return videoManager.di[index].frameBufer == frameBufferGetActive();
+    return ctx->di[index].frameBufer == frameBufferGetActive(board);
 }
 
-int videoManagerGetActive()
+int videoManagerGetActive(BoardContext* board)
 {
+    VideoManagerContext* ctx = boardGetVideoManager(board);
     int index;
-    for (index = 0; index < videoManager.count; index++) {
-        if (videoManagerIsActive(index)) {
+    for (index = 0; index < ctx->count; index++) {
+        if (videoManagerIsActive(board, index)) {
             return index;
         }
     }
     return -1;
 }
 
-void videoManagerSetMode(int index, VideoMode videoMode, VideoMode modeMask)
+void videoManagerSetMode(BoardContext* board, int index, VideoMode videoMode, VideoMode modeMask)
 {
-    videoManager.di[index].videoMode = videoMode;
-    videoManager.di[index].videoMask = modeMask;
-    if (videoManagerIsActive(index)) {
-        frameBufferSetMixMode(videoManager.di[index].videoMode, videoManager.di[index].videoMask);
+    VideoManagerContext* ctx = boardGetVideoManager(board);
+
+    ctx->di[index].videoMode = videoMode;
+    ctx->di[index].videoMask = modeMask;
+    if (videoManagerIsActive(board, index)) {
+        frameBufferSetMixMode(board, ctx->di[index].videoMode, ctx->di[index].videoMask);
     }
 }
 
-void videoManagerSetActive(int index)
+void videoManagerSetActive(BoardContext* board, int index)
 {
+    VideoManagerContext* ctx = boardGetVideoManager(board);
     int activeIndex;
 
-    if (videoManager.count <= 0) {
-        frameBufferSetActive(NULL);
+    if (ctx->count <= 0) {
+        frameBufferSetActive(board, NULL);
         return;
     }
 
-    if (index >= videoManager.count) {
+    if (index >= ctx->count) {
         return;
     }
 
-    for (activeIndex = 0; activeIndex < videoManager.count; activeIndex++) {
-        if (videoManagerIsActive(activeIndex)) {
-            if (activeIndex != index && videoManager.di[activeIndex].callbacks.disable != NULL) {
-                videoManager.di[activeIndex].callbacks.disable(videoManager.di[activeIndex].ref);
+    for (activeIndex = 0; activeIndex < ctx->count; activeIndex++) {
+        if (videoManagerIsActive(board, activeIndex)) {
+            if (activeIndex != index && ctx->di[activeIndex].callbacks.disable != NULL) {
+                ctx->di[activeIndex].callbacks.disable(ctx->di[activeIndex].ref);
             }
         }
     }
 
     if (index < 0) {
-        frameBufferSetActive(NULL);
+        frameBufferSetActive(board, NULL);
     }
     else {
-        frameBufferSetActive(videoManager.di[index].frameBufer);
-        frameBufferSetMixMode(videoManager.di[index].videoMode, videoManager.di[index].videoMask);
-        if (activeIndex != index && videoManager.di[index].callbacks.enable != NULL) {
-            videoManager.di[index].callbacks.enable(videoManager.di[index].ref);
+        frameBufferSetActive(board, ctx->di[index].frameBufer);
+        frameBufferSetMixMode(board, ctx->di[index].videoMode, ctx->di[index].videoMask);
+        if (activeIndex != index && ctx->di[index].callbacks.enable != NULL) {
+            ctx->di[index].callbacks.enable(ctx->di[index].ref);
         }
     }
 }
 
-char* videoManagerGetName(int index)
+char* videoManagerGetName(BoardContext* board, int index)
 {
-    if (index >= videoManager.count) {
+    VideoManagerContext* ctx = boardGetVideoManager(board);
+
+    if (index >= ctx->count) {
         return index == 0 ? "Default" : NULL;
     }
-    return videoManager.di[index].name;
+    return ctx->di[index].name;
 }
 
-int videoManagerRegister(const char* name, FrameBufferData* frameBuffer, 
+int videoManagerRegister(BoardContext* board, const char* name, FrameBufferData* frameBuffer, 
                          VideoCallbacks* callbacks, void* ref)
 {
-    if (videoManager.count >= MAX_DEVICES) {
+    VideoManagerContext* ctx = boardGetVideoManager(board);
+
+    if (ctx->count >= MAX_DEVICES) {
         return 0;
     }
 
-    videoManager.di[videoManager.count].handle      = ++videoManager.lastHandle;
-    videoManager.di[videoManager.count].frameBufer  = frameBuffer;
-    videoManager.di[videoManager.count].callbacks   = *callbacks;
-    videoManager.di[videoManager.count].ref         = ref;
-    videoManager.di[videoManager.count].videoMode   = VIDEO_INTERNAL;
-    videoManager.di[videoManager.count].videoMask   = VIDEO_INTERNAL;
+    ctx->di[ctx->count].handle      = ++ctx->lastHandle;
+    ctx->di[ctx->count].frameBufer  = frameBuffer;
+    ctx->di[ctx->count].callbacks   = *callbacks;
+    ctx->di[ctx->count].ref         = ref;
+    ctx->di[ctx->count].videoMode   = VIDEO_INTERNAL;
+    ctx->di[ctx->count].videoMask   = VIDEO_INTERNAL;
 
-    strcpy(videoManager.di[videoManager.count].name, name);
+    strcpy(ctx->di[ctx->count].name, name);
 
-    videoManager.count++;
+    ctx->count++;
 
-    if (videoManager.count == 1) {
-        videoManagerSetActive(0);
+    if (ctx->count == 1) {
+        videoManagerSetActive(board, 0);
     }
     
     archVideoOutputChange();
 
-    return videoManager.lastHandle - 1;
+    return ctx->lastHandle - 1;
 }
 
-void videoManagerUnregister(int handle)
+void videoManagerUnregister(BoardContext* board, int handle)
 {
+    VideoManagerContext* ctx = boardGetVideoManager(board);
     int isActive;
     int i;
 
-    if (videoManager.count == 0) {
+    if (ctx->count == 0) {
         return;
     }
 
-    for (i = 0; i < videoManager.count; i++) {
-        if (videoManager.di[i].handle == handle + 1) {
+    for (i = 0; i < ctx->count; i++) {
+        if (ctx->di[i].handle == handle + 1) {
             break;
         }
     }
 
-    if (i == videoManager.count) {
+    if (i == ctx->count) {
         return;
     }
 
-    isActive = videoManagerIsActive(i);
+    isActive = videoManagerIsActive(board, i);
 
-    videoManager.count--;
-    while (i < videoManager.count) {
-        videoManager.di[i] = videoManager.di[i + 1];
+    ctx->count--;
+    while (i < ctx->count) {
+        ctx->di[i] = ctx->di[i + 1];
         i++;
     }
 
-    if (isActive || videoManager.count == 0) {
-        videoManagerSetActive(0);
+    if (isActive || ctx->count == 0) {
+        videoManagerSetActive(board, 0);
     }
 
-    if (videoManager.count == 0) {
+    if (ctx->count == 0) {
         frameBufferClearDeinterlace();
     }
 
@@ -199,18 +223,18 @@ void videoManagerUnregister(int handle)
 }
 
 
-void videoManagerLoadState()
+void videoManagerLoadState(BoardContext* board)
 {
-    SaveState* state = saveStateOpenForRead("VideoManager");
+    SaveState* state = saveStateOpenForRead(board, "VideoManager");
     int index = saveStateGet(state, "ActiveFrameBuffer",  0);
     saveStateClose(state);
-    videoManagerSetActive(index);
+    videoManagerSetActive(board, index);
 
 }
 
-void videoManagerSaveState()
+void videoManagerSaveState(BoardContext* board)
 {
-    SaveState* state = saveStateOpenForWrite("VideoManager");
-    saveStateSet(state, "ActiveFrameBuffer",  videoManagerGetActive());
+    SaveState* state = saveStateOpenForWrite(board, "VideoManager");
+    saveStateSet(state, "ActiveFrameBuffer",  videoManagerGetActive(board));
     saveStateClose(state);
 }
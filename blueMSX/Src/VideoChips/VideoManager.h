@@ -44,20 +44,26 @@ typedef enum {
     VIDEO_MASK_ALL = VIDEO_INTERNAL | VIDEO_MIX | VIDEO_EXTERNAL | VIDEO_NONE
 } VideoMode;
 
-int videoManagerGetCount();
-int videoManagerGetActive();
-void videoManagerSetActive(int index);
-void videoManagerSetMode(int index, VideoMode videoMode, VideoMode modeMask);
-int videoManagerIsActive(int index);
-char* videoManagerGetName(int index);
+// The video devices of a board, found with boardGetVideoManager()
+typedef struct VideoManagerContext VideoManagerContext;
 
-void videoManagerReset();
+VideoManagerContext* videoManagerContextCreate();
+void videoManagerContextDestroy(VideoManagerContext* context);
 
-void videoManagerLoadState();
-void videoManagerSaveState();
+int videoManagerGetCount(BoardContext* board);
+int videoManagerGetActive(BoardContext* board);
+void videoManagerSetActive(BoardContext* board, int index);
+void videoManagerSetMode(BoardContext* board, int index, VideoMode videoMode, VideoMode modeMask);
+int videoManagerIsActive(BoardContext* board, int index);
+char* videoManagerGetName(BoardContext* board, int index);
 
-int videoManagerRegister(const char* name, FrameBufferData* frameBuffer, 
+void videoManagerReset(BoardContext* board);
+
+void videoManagerLoadState(BoardContext* board);
+void videoManagerSaveState(BoardContext* board);
+
+int videoManagerRegister(BoardContext* board, const char* name, FrameBufferData* frameBuffer, 
                         VideoCallbacks* callbacks, void* ref);
-void videoManagerUnregister(int handle);
+void videoManagerUnregister(BoardContext* board, int handle);
 
 #endif
@@ -369,3 +369,42 @@ void scale(unsigned scale, void* void_dst, unsigned dst_slice, const void* void_
 	}
 }
 
+/**
+ * Apply the Scale effect on a band of rows of a bitmap.
+ * Only the destination rows of the source rows first to last - 1 are
+ * written, so bands of a bitmap can be scaled in parallel. The result
+ * is the same as the one of ::scale().
+ * \param scale Scale factor. 2 or 3.
+ * \param void_dst Pointer at the first pixel of the destination bitmap.
+ * \param dst_slice Size in bytes of a destination bitmap row.
+ * \param void_src Pointer at the first pixel of the source bitmap.
+ * \param src_slice Size in bytes of a source bitmap row.
+ * \param pixel Bytes per pixel of the source and destination bitmap.
+ * \param width Horizontal size in pixels of the source bitmap.
+ * \param height Vertical size in pixels of the source bitmap.
+ * \param first First source row of the band.
+ * \param last Source row after the band.
+ */
+void scale_rows(unsigned scale, void* void_dst, unsigned dst_slice, const void* void_src, unsigned src_slice, unsigned pixel, unsigned width, unsigned height, unsigned first, unsigned last)
+{
+	unsigned char* dst = (unsigned char*)void_dst + first * scale * dst_slice;
+	const unsigned char* src = (unsigned char*)void_src;
+	unsigned y;
+
+	for (y = first; y < last; y++) {
+		const unsigned char* src0 = src + (y > 0 ? y - 1 : 0) * src_slice;
+		const unsigned char* src1 = src + y * src_slice;
+		const unsigned char* src2 = src + (y + 1 < height ? y + 1 : y) * src_slice;
+
+		switch (scale) {
+		case 2 : stage_scale2x(SCDST(0), SCDST(1), src0, src1, src2, pixel, width); break;
+		case 3 : stage_scale3x(SCDST(0), SCDST(1), SCDST(2), src0, src1, src2, pixel, width); break;
+		}
+
+		dst = SCDST(scale);
+	}
+
+#if defined(__GNUC__) && defined(__i386__)
+	scale2x_mmx_emms();
+#endif
+}
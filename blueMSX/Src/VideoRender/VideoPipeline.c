@@ -0,0 +1,453 @@
+/*****************************************************************************
+** $Source: /cygdrive/d/Private/_SVNROOT/bluemsx/blueMSX/Src/VideoRender/VideoPipeline.c,v $
+**
+** $Revision: 1.1 $
+**
+** $Date: 2026-10-18 12:00:00 $
+**
+** More info: http://www.bluemsx.com
+**
+** Copyright (C) 2003-2006 Daniel Vik
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+******************************************************************************
+*/
+#include "VideoPipeline.h"
+#include "FrameBuffer.h"
+#include "ArchThread.h"
+#include "ArchEvent.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+// One image shown, one rendered and two waiting. Must be a power of two.
+#define PIPELINE_IMAGES 4
+
+// The pal filters keep a copy of the frame on the stack
+#define PIPELINE_STACK_SIZE (1024 * 1024)
+
+#define STALE_NONE 0x7fffffff
+
+// Ring of images. Only the producer writes head and only the consumer
+// writes tail, so no lock is needed. It never fills up since it holds
+// as many entries as there are images.
+typedef struct {
+    VideoImage* image[PIPELINE_IMAGES];
+    volatile int head;
+    volatile int tail;
+} ImageQueue;
+
+static struct {
+    BoardContext* board;
+    Video* video;
+    void*  thread;
+    int    dropFrames;
+    void   (*imageReady)();
+
+    void*  frameSem;
+    void*  progressSem;
+    void*  freeSem;
+
+    // Shared between the threads
+    volatile int quit;
+    volatile int pending;
+    volatile int format;
+    volatile int mix;
+    volatile int published;
+    volatile int taken;
+    volatile int rendered;
+    volatile int publisherWaiting;
+    volatile int renderWaiting;
+
+    ImageQueue readyQueue;
+    ImageQueue freeQueue;
+    VideoImage image[PIPELINE_IMAGES];
+
+    // Presentation
+    VideoImage* current;
+
+    // Render thread. The frame is rendered into the canvas, which holds
+    // the last frame so only the lines that changed are redrawn. The
+    // rows each image misses are copied from the canvas when it is used.
+    UInt8*    canvas;
+    int       canvasSize;
+    int       bitDepth;
+    int       zoom;
+    int       borderWidth;
+    int       staleTop[PIPELINE_IMAGES];
+    int       staleBottom[PIPELINE_IMAGES];
+    int       rectCount;
+    VideoRect rect[VIDEO_PIPELINE_MAX_RECTS];
+} pipeline;
+
+static void queuePush(ImageQueue* queue, VideoImage* image)
+{
+    int head = queue->head;
+
+    queue->image[head & (PIPELINE_IMAGES - 1)] = image;
+    archAtomicSet(&queue->head, head + 1);
+}
+
+static VideoImage* queuePop(ImageQueue* queue)
+{
+    int tail = queue->tail;
+    VideoImage* image;
+
+    if (archAtomicGet(&queue->head) == tail) {
+        return NULL;
+    }
+
+    image = queue->image[tail & (PIPELINE_IMAGES - 1)];
+    archAtomicSet(&queue->tail, tail + 1);
+
+    return image;
+}
+
+// Adds rectangles to a list. When the list is full the last rectangle
+// grows to cover the rest. All rectangles are full rows of the image.
+static void rectsAdd(VideoRect* rects, int* rectCount, VideoRect* add, int addCount)
+{
+    int i;
+
+    for (i = 0; i < addCount; i++) {
+        VideoRect* last;
+        int y0;
+        int y1;
+
+        if (*rectCount < VIDEO_PIPELINE_MAX_RECTS) {
+            rects[(*rectCount)++] = add[i];
+            continue;
+        }
+
+        last = rects + *rectCount - 1;
+        y0 = MIN(last->y, add[i].y);
+        y1 = MAX(last->y + last->height, add[i].y + add[i].height);
+        last->y      = y0;
+        last->height = y1 - y0;
+    }
+}
+
+// The waiter sets its flag before it checks the condition and the other
+// thread clears it after it changed the condition, so one of them sees
+// the other and no wakeup is lost.
+static void pipelineWait(volatile int* counter, int seq)
+{
+    archAtomicSet(&pipeline.publisherWaiting, 1);
+    while (archAtomicGet(counter) - seq < 0) {
+        archSemaphoreWait(pipeline.progressSem, -1);
+        archAtomicSet(&pipeline.publisherWaiting, 1);
+    }
+    archAtomicSet(&pipeline.publisherWaiting, 0);
+}
+
+static void pipelineSignal(volatile int* counter, int seq)
+{
+    archAtomicSet(counter, seq);
+    if (archAtomicExchange(&pipeline.publisherWaiting, 0)) {
+        archSemaphoreSignal(pipeline.progressSem);
+    }
+}
+
+static VideoImage* pipelineGetFreeImage()
+{
+    VideoImage* image = queuePop(&pipeline.freeQueue);
+
+    if (image != NULL || pipeline.dropFrames || pipeline.thread == NULL) {
+        return image;
+    }
+
+    archAtomicSet(&pipeline.renderWaiting, 1);
+    while ((image = queuePop(&pipeline.freeQueue)) == NULL && !archAtomicGet(&pipeline.quit)) {
+        archSemaphoreWait(pipeline.freeSem, -1);
+        archAtomicSet(&pipeline.renderWaiting, 1);
+    }
+    archAtomicSet(&pipeline.renderWaiting, 0);
+
+    return image;
+}
+
+static void pipelineReleaseImage(VideoImage* image)
+{
+    queuePush(&pipeline.freeQueue, image);
+    if (archAtomicExchange(&pipeline.renderWaiting, 0)) {
+        archSemaphoreSignal(pipeline.freeSem);
+    }
+}
+
+static void pipelineRender(FrameBuffer* frame)
+{
+    int format   = archAtomicGet(&pipeline.format);
+    int bitDepth = format >> 8;
+    int zoom     = format & 0xff;
+    int width    = 320 * zoom;
+    int height   = 240 * zoom;
+    int pitch    = width * bitDepth / 8;
+    int borderWidth;
+    VideoRect rect[VIDEO_PIPELINE_MAX_RECTS];
+    int rectCount;
+    VideoImage* image;
+    int i;
+
+    if (frame == NULL) {
+        frame = frameBufferGetWhiteNoiseFrame();
+    }
+
+    borderWidth = (320 - frame->maxWidth) * zoom / 2;
+
+    if (bitDepth != pipeline.bitDepth || zoom != pipeline.zoom || borderWidth != pipeline.borderWidth) {
+        if (pitch * height > pipeline.canvasSize) {
+            free(pipeline.canvas);
+            pipeline.canvasSize = pitch * height;
+            pipeline.canvas     = malloc(pipeline.canvasSize);
+        }
+        memset(pipeline.canvas, 0, pitch * height);
+
+        pipeline.bitDepth    = bitDepth;
+        pipeline.zoom        = zoom;
+        pipeline.borderWidth = borderWidth;
+
+        videoRender(pipeline.video, frame, bitDepth, zoom, pipeline.canvas + borderWidth * bitDepth / 8, 0, pitch, -1);
+        rect[0].y      = 0;
+        rect[0].height = height;
+        rectCount = 1;
+    }
+    else {
+        videoRenderDirty(pipeline.video, frame, bitDepth, zoom, pipeline.canvas + borderWidth * bitDepth / 8, 0, pitch, -1,
+                         rect, VIDEO_PIPELINE_MAX_RECTS, &rectCount);
+    }
+
+    for (i = 0; i < rectCount; i++) {
+        int j;
+
+        rect[i].x     = 0;
+        rect[i].width = width;
+
+        for (j = 0; j < PIPELINE_IMAGES; j++) {
+            pipeline.staleTop[j]    = MIN(pipeline.staleTop[j], rect[i].y);
+            pipeline.staleBottom[j] = MAX(pipeline.staleBottom[j], rect[i].y + rect[i].height);
+        }
+    }
+
+    // The changes of skipped frames are kept for the next image
+    rectsAdd(pipeline.rect, &pipeline.rectCount, rect, rectCount);
+
+    image = pipelineGetFreeImage();
+    if (image == NULL) {
+        return;
+    }
+
+    i = image->index;
+
+    if (image->bitDepth != bitDepth || image->zoom != zoom) {
+        free(image->pixels);
+        image->pixels   = malloc(pitch * height);
+        image->pitch    = pitch;
+        image->width    = width;
+        image->height   = height;
+        image->bitDepth = bitDepth;
+        image->zoom     = zoom;
+
+        pipeline.staleTop[i]    = 0;
+        pipeline.staleBottom[i] = height;
+    }
+
+    if (pipeline.staleTop[i] < pipeline.staleBottom[i]) {
+        int top    = MAX(0, pipeline.staleTop[i]);
+        int bottom = MIN(height, pipeline.staleBottom[i]);
+        memcpy((UInt8*)image->pixels + top * pitch, pipeline.canvas + top * pitch, (bottom - top) * pitch);
+    }
+    pipeline.staleTop[i]    = STALE_NONE;
+    pipeline.staleBottom[i] = 0;
+
+    image->borderWidth = borderWidth;
+    image->rectCount   = pipeline.rectCount;
+    memcpy(image->rect, pipeline.rect, pipeline.rectCount * sizeof(VideoRect));
+    pipeline.rectCount = 0;
+
+    queuePush(&pipeline.readyQueue, image);
+
+    if (pipeline.imageReady != NULL) {
+        pipeline.imageReady();
+    }
+}
+
+static void pipelineRenderFrame()
+{
+    int seq = archAtomicGet(&pipeline.published);
+    int mix = archAtomicGet(&pipeline.mix);
+    FrameBuffer* frame;
+
+    frame = frameBufferFlipViewFrameMix(pipeline.board, mix >> 8, mix & 0xff);
+
+    // The emulation never draws into the view frame, so it can go on
+    pipelineSignal(&pipeline.taken, seq);
+
+    pipelineRender(frame);
+
+    pipelineSignal(&pipeline.rendered, seq);
+}
+
+static void pipelineRenderThread()
+{
+    for (;;) {
+        archSemaphoreWait(pipeline.frameSem, -1);
+        if (archAtomicGet(&pipeline.quit)) {
+            break;
+        }
+
+        // Frames published from here on wake the thread again
+        archAtomicSet(&pipeline.pending, 0);
+
+        pipelineRenderFrame();
+    }
+}
+
+void videoPipelineStart(BoardContext* board, Video* video, int dropFrames, void (*imageReady)())
+{
+    int i;
+
+    if (pipeline.video != NULL) {
+        videoPipelineStop();
+    }
+
+    pipeline.board      = board;
+    pipeline.video      = video;
+    pipeline.dropFrames = dropFrames;
+    pipeline.imageReady = imageReady;
+    pipeline.format     = (32 << 8) | 1;
+
+    for (i = 0; i < PIPELINE_IMAGES; i++) {
+        pipeline.image[i].index = i;
+        pipeline.staleTop[i]    = STALE_NONE;
+        pipeline.staleBottom[i] = 0;
+        queuePush(&pipeline.freeQueue, pipeline.image + i);
+    }
+
+    pipeline.frameSem    = archSemaphoreCreate(0);
+    pipeline.progressSem = archSemaphoreCreate(0);
+    pipeline.freeSem     = archSemaphoreCreate(0);
+
+#ifndef SINGLE_THREADED
+    pipeline.thread = archThreadCreateEx(pipelineRenderThread, THREAD_PRIO_NORMAL, PIPELINE_STACK_SIZE);
+#endif
+}
+
+void videoPipelineStop()
+{
+    int i;
+
+    if (pipeline.video == NULL) {
+        return;
+    }
+
+    if (pipeline.thread != NULL) {
+        archAtomicSet(&pipeline.quit, 1);
+        archSemaphoreSignal(pipeline.frameSem);
+        archSemaphoreSignal(pipeline.freeSem);
+        archThreadJoin(pipeline.thread, -1);
+        archThreadDestroy(pipeline.thread);
+    }
+
+    archSemaphoreDestroy(pipeline.frameSem);
+    archSemaphoreDestroy(pipeline.progressSem);
+    archSemaphoreDestroy(pipeline.freeSem);
+
+    for (i = 0; i < PIPELINE_IMAGES; i++) {
+        free(pipeline.image[i].pixels);
+    }
+    free(pipeline.canvas);
+
+    memset(&pipeline, 0, sizeof(pipeline));
+}
+
+void videoPipelineSetFormat(int bitDepth, int zoom)
+{
+    archAtomicSet(&pipeline.format, (bitDepth << 8) | zoom);
+}
+
+void videoPipelinePublish(int mixFrames, int sync)
+{
+    int seq;
+
+    if (pipeline.video == NULL) {
+        return;
+    }
+
+    // The mix percent is taken from the emulation, so it is read here.
+    // Both go in one word so the render thread never sees half of it.
+    archAtomicSet(&pipeline.mix, (mixFrames << 8) | (mixFrames ? frameBufferGetMixPercent(pipeline.board) : 0));
+
+    seq = pipeline.published + 1;
+    archAtomicSet(&pipeline.published, seq);
+
+    if (pipeline.thread == NULL) {
+        pipelineRenderFrame();
+        return;
+    }
+
+    if (archAtomicExchange(&pipeline.pending, 1) == 0) {
+        archSemaphoreSignal(pipeline.frameSem);
+    }
+
+    if (sync) {
+        pipelineWait(&pipeline.taken, seq);
+    }
+}
+
+void videoPipelineFlush()
+{
+    if (pipeline.video != NULL) {
+        pipelineWait(&pipeline.rendered, archAtomicGet(&pipeline.published));
+    }
+}
+
+VideoImage* videoPipelineGetLatest()
+{
+    VideoImage* image;
+
+    if (pipeline.current != NULL) {
+        pipeline.current->rectCount = 0;
+    }
+
+    while ((image = queuePop(&pipeline.readyQueue)) != NULL) {
+        if (pipeline.current != NULL) {
+            // Rows changed in images that were never shown
+            if (pipeline.current->zoom == image->zoom) {
+                rectsAdd(image->rect, &image->rectCount, pipeline.current->rect, pipeline.current->rectCount);
+            }
+            pipelineReleaseImage(pipeline.current);
+        }
+        pipeline.current = image;
+    }
+
+    return pipeline.current;
+}
+
+VideoImage* videoPipelineGetNext()
+{
+    VideoImage* image = queuePop(&pipeline.readyQueue);
+
+    if (image != NULL) {
+        if (pipeline.current != NULL) {
+            pipelineReleaseImage(pipeline.current);
+        }
+        pipeline.current = image;
+    }
+
+    return image;
+}
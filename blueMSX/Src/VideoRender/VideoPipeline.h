@@ -0,0 +1,87 @@
+/*****************************************************************************
+** $Source: /cygdrive/d/Private/_SVNROOT/bluemsx/blueMSX/Src/VideoRender/VideoPipeline.h,v $
+**
+** $Revision: 1.1 $
+**
+** $Date: 2026-10-18 12:00:00 $
+**
+** More info: http://www.bluemsx.com
+**
+** Copyright (C) 2003-2006 Daniel Vik
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+******************************************************************************
+*/
+#ifndef VIDEO_PIPELINE_H
+#define VIDEO_PIPELINE_H
+
+#include "VideoRender.h"
+
+//
+// Render pipeline. The emulation thread publishes each completed frame
+// and goes on with the next one. A render thread flips the view frame,
+// renders it with the video settings (deinterlace, frame mixing, pal
+// filters, scanlines and color saturation) into an image and hands the
+// image to the presentation thread through a lock-free single producer
+// single consumer queue. Images go back to the render thread through
+// a second queue when the presentation is done with them.
+//
+
+#define VIDEO_PIPELINE_MAX_RECTS 16
+
+typedef struct {
+    void* pixels;
+    int   pitch;
+    int   width;       // 320 * zoom
+    int   height;      // 240 * zoom
+    int   bitDepth;
+    int   zoom;
+    int   borderWidth; // Black columns on each side of the frame
+    int   rectCount;   // Rows that changed since the last image shown
+    VideoRect rect[VIDEO_PIPELINE_MAX_RECTS];
+    int   index;       // Internal use
+} VideoImage;
+
+// Starts the render thread for the frames of the board. When dropFrames
+// is set the render thread skips frames while the presentation holds on
+// to all images, otherwise it waits for an image and every published
+// frame is rendered. The imageReady callback is called on the render
+// thread when an image is queued for the presentation. Without threads
+// the frames are rendered by videoPipelinePublish().
+void videoPipelineStart(BoardContext* board, Video* video, int dropFrames, void (*imageReady)());
+void videoPipelineStop();
+
+// Sets the format of the images rendered from the next frame on
+void videoPipelineSetFormat(int bitDepth, int zoom);
+
+// Called by the emulation thread when a frame is complete. With sync
+// set it returns when the render thread has taken the frame, otherwise
+// at once, and frames published before the render thread got to them
+// are skipped.
+void videoPipelinePublish(int mixFrames, int sync);
+
+// Waits until all published frames are rendered
+void videoPipelineFlush();
+
+// Presentation. videoPipelineGetLatest() returns the newest image with
+// the rows that changed since the last image shown, or the last image
+// again with no changed rows. videoPipelineGetNext() returns the images
+// in the order they were rendered, or NULL if there is no new image.
+// Both give the previous image back to the render thread.
+VideoImage* videoPipelineGetLatest();
+VideoImage* videoPipelineGetNext();
+
+#endif /* VIDEO_PIPELINE_H */
@@ -33,9 +33,24 @@
 #include "Scalebit.h"
 #include "hq2x.h"
 #include "hq3x.h"
+#include "ArchThread.h"
+#include "ArchEvent.h"
 #include <stdlib.h>
+#include <stddef.h>
 #include <math.h>
 #include <string.h>
+
+#if !defined(WII) && !defined(NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VIDEO_SSE2
+#define VIDEO_SIMD_KERNELS
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define VIDEO_NEON
+#define VIDEO_SIMD_KERNELS
+#include <arm_neon.h>
+#endif
+#endif
  
 #ifdef WII
 static UInt16 empty_line_buffer[FB_MAX_LINE_WIDTH];
@@ -250,6 +265,28 @@ int videoRender(Video* pVideo, FrameBuffer* frame, int bitDepth, int zoom,
     return zoom;
 }
 
+int videoRenderDirty(Video* pVideo, FrameBuffer* frame, int bitDepth, int zoom,
+                     void* pDst, int dstOffset, int dstPitch, int canChangeZoom,
+                     VideoRect* rects, int maxRects, int* rectCount)
+{
+    *rectCount = 0;
+
+    if (frame == NULL) {
+        return zoom;
+    }
+
+    zoom = videoRender(pVideo, frame, bitDepth, zoom, pDst, dstOffset, dstPitch, canChangeZoom);
+
+    if (maxRects > 0) {
+        rects[0].x      = 0;
+        rects[0].y      = 0;
+        rects[0].width  = 320 * zoom;
+        rects[0].height = 240 * zoom;
+        *rectCount = 1;
+    }
+    return zoom;
+}
+
 Video* videoCreate()
 {
     Video* pVideo = (Video*)calloc(1, sizeof(Video));
@@ -269,6 +306,45 @@ void videoUpdateAll(Video* video, Properties* properties)
     video->deInterlace = properties->video.deInterlace;
 }
 
+int videoIsSimdSupported(VideoSimd simd)
+{
+    return simd == VIDEO_SIMD_NONE;
+}
+
+int videoSetSimd(VideoSimd simd)
+{
+    return simd == VIDEO_SIMD_NONE;
+}
+
+VideoSimd videoGetSimd()
+{
+    return VIDEO_SIMD_NONE;
+}
+
+int videoGetKernelCount()
+{
+    return 0;
+}
+
+const char* videoGetKernelName(int index)
+{
+    return NULL;
+}
+
+VideoSimd videoGetKernelSimd(int index)
+{
+    return VIDEO_SIMD_NONE;
+}
+
+DoubleT videoGetKernelRate(int index, VideoSimd simd)
+{
+    return 0;
+}
+
+void videoSetFilterThreads(Video* video, int threads)
+{
+}
+
 #else
 
 #define RGB_MASK 0x7fff
@@ -284,6 +360,73 @@ static UInt16 pRgbTableGreen16[MAX_RGB_COLORS];
 static UInt16 pRgbTableWhite16[MAX_RGB_COLORS];
 static UInt16 pRgbTableAmber16[MAX_RGB_COLORS];
 
+// State of the last videoRenderDirty() call. The line hashes are
+// compared with the next frame to find the lines that changed.
+struct VideoRenderState {
+    int    valid;
+    void*  pDst;
+    int    dstOffset;
+    int    dstPitch;
+    int    bitDepth;
+    int    zoom;
+    int    canChangeZoom;
+    int    resultZoom;
+    int    rgbTableVersion;
+    int    lines;
+    int    maxWidth;
+    int    interlace;
+    int    doubleWidth;
+    UInt32 palNoise;
+    UInt32 hash[FB_MAX_LINES];
+};
+
+// Lines the copy methods leave untouched, NULL when all lines are drawn
+static const UInt8* cleanLines = NULL;
+
+// Noise seed of the frame being drawn. Each video steps its own seed so
+// the noise of a frame does not depend on other videos drawing.
+static UInt32 palNoise = 51;
+
+#define isLineClean(h) (cleanLines != NULL && cleanLines[h])
+
+static int rgbTableVersion = 0;
+
+// Inner loops of the copy and filter methods. Each instruction set has
+// its own set of kernels, and VIDEO_SIMD_AUTO picks the fastest kernel
+// of each. The PAL kernels draw one line and return the next noise seed.
+typedef struct {
+    void (*copy_2x2_32_core1)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, UInt32* pDst2, int width, int hint);
+    void (*copy_2x2_32_core2)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, UInt32* pDst2, int width, int hint);
+    void (*copy_1x_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst, int width);
+    void (*copy_2x_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst, int width);
+    void (*copy_05x_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst, int width);
+    void (*copy_1x05_32_core)(UInt32* rgbTable, UInt16* pSrc1, UInt16* pSrc2, UInt32* pDst, int srcWidth, int doubleWidth);
+    void (*copy_1x_16_core)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst, int width);
+    void (*copy_2x_16_core)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst, int width);
+    void (*copy_05x_16_core)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst, int width);
+    void (*copy_2x2_16_core1)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst1, UInt16* pDst2, int width);
+    void (*copy_2x2_16_core2)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst1, UInt16* pDst2, int width);
+    void (*copy_1x05_16_core)(UInt16* rgbTable, UInt16* pSrc1, UInt16* pSrc2, UInt16* pDst, int srcWidth, int doubleWidth);
+    void (*scanLines_16_core)(UInt32* pBuf, int width, int scanLinesPct);
+    void (*scanLines_32_core)(UInt32* pBuf, int width, int scanLinesPct, int hint);
+    void (*colorSaturation_32_core)(UInt32* pBuf, int width, int blur);
+    UInt32 (*copySharpPAL_2x2_16_core)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst1, UInt16* pDst2, UInt16* pDst3, int srcWidth, int doubleWidth, UInt32 rnd);
+    UInt32 (*copySharpPAL_2x2_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, UInt32* pDst2, UInt32* pDst3, int srcWidth, int doubleWidth, UInt32 rnd);
+    UInt32 (*copySharpPAL_2x1_16_core)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst1, int srcWidth, int doubleWidth, UInt32 rnd);
+    UInt32 (*copySharpPAL_2x1_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, int srcWidth, int doubleWidth, UInt32 rnd);
+    UInt32 (*copyMonitorPAL_2x2_16_core)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst1, UInt16* pDst2, UInt16* pDst3, int srcWidth, int doubleWidth, UInt32 rnd);
+    UInt32 (*copyMonitorPAL_2x2_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, UInt32* pDst2, UInt32* pDst3, int srcWidth, int doubleWidth, UInt32 rnd);
+    UInt32 (*copyMonitorPAL_2x1_16_core)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst1, int srcWidth, int doubleWidth, UInt32 rnd);
+    UInt32 (*copyMonitorPAL_2x1_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, int srcWidth, int doubleWidth, UInt32 rnd);
+    UInt32 (*copyPAL_2x2_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, UInt32* pDst2, UInt32* pDst3, int srcWidth, int doubleWidth, UInt32 rnd);
+    UInt32 (*copyPAL_2x1_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, int srcWidth, int doubleWidth, UInt32 rnd);
+    UInt32 (*copyPAL_1x1_16_core)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst, int srcWidth, int doubleWidth, UInt32 rnd);
+    UInt32 (*copyPAL_1x1_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst, int srcWidth, int doubleWidth, UInt32 rnd);
+    UInt32 (*copyPAL_1x05_32_core)(UInt32* rgbTable, UInt16* pSrcA, UInt16* pSrcB, UInt32* pDst, int srcWidth, int doubleWidth, UInt32 rnd);
+} VideoKernels;
+
+static const VideoKernels* kernels;
+
 #define ABS(a) ((a) < 0 ? -1 * (a) : (a))
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
@@ -314,6 +457,8 @@ static void initRGBTable(Video* pVideo)
 {
     int rgb;
 
+    rgbTableVersion++;
+
     generateGammaTable(pVideo);
 
     for (rgb = 0; rgb < MAX_RGB_COLORS; rgb++) {
@@ -376,9 +521,76 @@ static void initRGBTable(Video* pVideo)
 **
 ******************************************************************************
 */
+static UInt32 copySharpPAL_2x2_16_core(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst1, UInt16* pDst2, UInt16* pDst3, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt16 colCur = (rgbTable[pSrc[0]] & 0xe79c) >> 2;
+    UInt16 colPrev = colCur;
+    int dstIndex = 0;
+
+    if (doubleWidth) {
+        int width = srcWidth * 2;
+        int w;
+        for (w = 0; w < width;) {
+            UInt16 colNext;
+            UInt16 colRgb1;
+            UInt16 colRgb2;
+            UInt16 noise;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
+            colRgb1 = (colPrev + colNext + 2 * colCur) & 0xe79c;
+
+            colPrev = colCur;
+            colCur  = colNext;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
+            colRgb2  = (colPrev + colNext + 2 * colCur) & 0xe79c;
+
+            colPrev = colCur;
+            colCur  = colNext;
+
+            noise = (UInt16)(rnd >> 31) * 0x0821;
+            pDst2[dstIndex] = colRgb1 + noise;
+            pDst1[dstIndex] = (((pDst3[dstIndex] >> 1) & 0x7bef) + ((colRgb1 >> 1) & 0x7bef));
+            dstIndex++;
+            pDst2[dstIndex] = colRgb2 + noise;
+            pDst1[dstIndex] = (((pDst3[dstIndex] >> 3) & 0x7bef) + ((colRgb2 >> 1) & 0x7bef));
+            dstIndex++;
+
+            rnd *= 23;
+        }
+    }
+    else {
+        int width = srcWidth;
+        int w;
+        for (w = 0; w < width;) {
+            UInt16 colNext;
+            UInt16 colRgb1;
+            UInt16 colRgb2;
+            UInt16 noise;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
+            colRgb1  = (colNext + 3 * colCur) & 0xe79c;
+            colRgb2  = (colCur + 3 * colNext) & 0xe79c;
+            
+            colCur = colNext;
+
+            noise = (UInt16)(rnd >> 31) * 0x0821;
+            pDst2[dstIndex] = colRgb1 + noise;
+            pDst1[dstIndex] = (((pDst3[dstIndex] >> 1) & 0x7bef) + ((colRgb1 >> 1) & 0x7bef));
+            dstIndex++;
+            pDst2[dstIndex] = colRgb2 + noise;
+            pDst1[dstIndex] = (((pDst3[dstIndex] >> 1) & 0x7bef) + ((colRgb2 >> 1) & 0x7bef));
+            dstIndex++;
+
+            rnd *= 23;
+        }
+    }
+
+    return rnd;
+}
+
 static void copySharpPAL_2x2_16(FrameBuffer* frame, void* pDestination, int dstPitch, UInt16* rgbTable, UInt32 rnd)
 {
-    static UInt32 rndVal = 51;
     UInt16* pDst1       = (UInt16*)pDestination;
     UInt16* pDst2       = pDst1 + dstPitch / (int)sizeof(UInt16);
     UInt16* pDst3       = pDst2;
@@ -386,8 +598,7 @@ static void copySharpPAL_2x2_16(FrameBuffer* frame, void* pDestination, int dstP
     int srcWidth        = frame->maxWidth;
     int h;
 
-    rndVal *= 13;
-    rnd    *= rndVal;
+    rnd *= palNoise;
 
     dstPitch /= (int)sizeof(UInt16);
 
@@ -398,69 +609,8 @@ static void copySharpPAL_2x2_16(FrameBuffer* frame, void* pDestination, int dstP
     }
 
     for (h = 0; h < height; h++) {
-        UInt16* pSrc = frame->line[h].buffer;
-        UInt16 colCur = (rgbTable[pSrc[0]] & 0xe79c) >> 2;
-        UInt16 colPrev = colCur;
-        int dstIndex = 0;
-
-        if (frame->line[h].doubleWidth) {
-            int width = srcWidth * 2;
-            int w;
-            for (w = 0; w < width;) {
-                UInt16 colNext;
-                UInt16 colRgb1;
-                UInt16 colRgb2;
-                UInt16 noise;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
-                colRgb1 = (colPrev + colNext + 2 * colCur) & 0xe79c;
-
-                colPrev = colCur;
-                colCur  = colNext;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
-                colRgb2  = (colPrev + colNext + 2 * colCur) & 0xe79c;
-
-                colPrev = colCur;
-                colCur  = colNext;
-
-                noise = (UInt16)(rnd >> 31) * 0x0821;
-                pDst2[dstIndex] = colRgb1 + noise;
-                pDst1[dstIndex] = (((pDst3[dstIndex] >> 1) & 0x7bef) + ((colRgb1 >> 1) & 0x7bef));
-                dstIndex++;
-                pDst2[dstIndex] = colRgb2 + noise;
-                pDst1[dstIndex] = (((pDst3[dstIndex] >> 3) & 0x7bef) + ((colRgb2 >> 1) & 0x7bef));
-                dstIndex++;
-
-                rnd *= 23;
-            }
-        }
-        else {
-            int width = srcWidth;
-            int w;
-            for (w = 0; w < width;) {
-                UInt16 colNext;
-                UInt16 colRgb1;
-                UInt16 colRgb2;
-                UInt16 noise;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
-                colRgb1  = (colNext + 3 * colCur) & 0xe79c;
-                colRgb2  = (colCur + 3 * colNext) & 0xe79c;
-                
-                colCur = colNext;
-
-                noise = (UInt16)(rnd >> 31) * 0x0821;
-                pDst2[dstIndex] = colRgb1 + noise;
-                pDst1[dstIndex] = (((pDst3[dstIndex] >> 1) & 0x7bef) + ((colRgb1 >> 1) & 0x7bef));
-                dstIndex++;
-                pDst2[dstIndex] = colRgb2 + noise;
-                pDst1[dstIndex] = (((pDst3[dstIndex] >> 1) & 0x7bef) + ((colRgb2 >> 1) & 0x7bef));
-                dstIndex++;
-
-                rnd *= 23;
-            }
-        }
+        rnd = kernels->copySharpPAL_2x2_16_core(rgbTable, frame->line[h].buffer, pDst1, pDst2, pDst3,
+                                                srcWidth, frame->line[h].doubleWidth, rnd);
 
         pDst3 = pDst2;
         pDst1 += dstPitch * 2;
@@ -468,9 +618,76 @@ static void copySharpPAL_2x2_16(FrameBuffer* frame, void* pDestination, int dstP
     }
 }
 
+static UInt32 copySharpPAL_2x2_32_core(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, UInt32* pDst2, UInt32* pDst3, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt32 colCur = (rgbTable[pSrc[0]] & 0xfcfcfc) >> 2;
+    UInt32 colPrev = colCur;
+    int dstIndex = 0;
+
+    if (doubleWidth) {
+        int width = srcWidth * 2;
+        int w;
+        for (w = 0; w < width;) {
+            UInt32 colNext;
+            UInt32 colRgb1;
+            UInt32 colRgb2;
+            UInt32 noise;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
+            colRgb1 = (colPrev + colNext + 2 * colCur) & 0xfcfcfc;
+
+            colPrev = colCur;
+            colCur  = colNext;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
+            colRgb2  = (colPrev + colNext + 2 * colCur) & 0xfcfcfc;
+
+            colPrev = colCur;
+            colCur  = colNext;
+
+            noise = (rnd >> 29) * 0x10101;
+            pDst2[dstIndex] = colRgb1 + noise;
+            pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb1 >> 1) & 0x7f7f7f);
+            dstIndex++;
+            pDst2[dstIndex] = colRgb2 + noise;
+            pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f);
+            dstIndex++;
+
+            rnd *= 23;
+        }
+    }
+    else {
+        int width = srcWidth;
+        int w;
+        for (w = 0; w < width;) {
+            UInt32 colNext;
+            UInt32 colRgb1;
+            UInt32 colRgb2;
+            UInt32 noise;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
+            colRgb1  = (colNext + 3 * colCur) & 0xfcfcfc;
+            colRgb2  = (colCur + 3 * colNext) & 0xfcfcfc;
+            
+            colCur = colNext;
+
+            noise = (rnd >> 29) * 0x10101;
+            pDst2[dstIndex] = colRgb1 + noise;
+            pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb1 >> 1) & 0x7f7f7f);
+            dstIndex++;
+            pDst2[dstIndex] = colRgb2 + noise;
+            pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f);
+            dstIndex++;
+
+            rnd *= 23;
+        }
+    }
+
+    return rnd;
+}
+
 static void copySharpPAL_2x2_32(FrameBuffer* frame, void* pDestination, int dstPitch, UInt32* rgbTable, UInt32 rnd)
 {
-    static UInt32 rndVal = 51;
     UInt32* pDst1       = (UInt32*)pDestination;
     UInt32* pDst2       = pDst1 + dstPitch / (int)sizeof(UInt32);
     UInt32* pDst3       = pDst2;
@@ -478,8 +695,7 @@ static void copySharpPAL_2x2_32(FrameBuffer* frame, void* pDestination, int dstP
     int srcWidth        = frame->maxWidth;
     int h;
 
-    rndVal *= 13;
-    rnd    *= rndVal;
+    rnd *= palNoise;
 
     dstPitch /= (int)sizeof(UInt32);
 
@@ -490,69 +706,8 @@ static void copySharpPAL_2x2_32(FrameBuffer* frame, void* pDestination, int dstP
     }
 
     for (h = 0; h < height; h++) {
-        UInt16* pSrc = frame->line[h].buffer;
-        UInt32 colCur = (rgbTable[pSrc[0]] & 0xfcfcfc) >> 2;
-        UInt32 colPrev = colCur;
-        int dstIndex = 0;
-
-        if (frame->line[h].doubleWidth) {
-            int width = srcWidth * 2;
-            int w;
-            for (w = 0; w < width;) {
-                UInt32 colNext;
-                UInt32 colRgb1;
-                UInt32 colRgb2;
-                UInt32 noise;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
-                colRgb1 = (colPrev + colNext + 2 * colCur) & 0xfcfcfc;
-
-                colPrev = colCur;
-                colCur  = colNext;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
-                colRgb2  = (colPrev + colNext + 2 * colCur) & 0xfcfcfc;
-
-                colPrev = colCur;
-                colCur  = colNext;
-
-                noise = (rnd >> 29) * 0x10101;
-                pDst2[dstIndex] = colRgb1 + noise;
-                pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb1 >> 1) & 0x7f7f7f);
-                dstIndex++;
-                pDst2[dstIndex] = colRgb2 + noise;
-                pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f);
-                dstIndex++;
-
-                rnd *= 23;
-            }
-        }
-        else {
-            int width = srcWidth;
-            int w;
-            for (w = 0; w < width;) {
-                UInt32 colNext;
-                UInt32 colRgb1;
-                UInt32 colRgb2;
-                UInt32 noise;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
-                colRgb1  = (colNext + 3 * colCur) & 0xfcfcfc;
-                colRgb2  = (colCur + 3 * colNext) & 0xfcfcfc;
-                
-                colCur = colNext;
-
-                noise = (rnd >> 29) * 0x10101;
-                pDst2[dstIndex] = colRgb1 + noise;
-                pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb1 >> 1) & 0x7f7f7f);
-                dstIndex++;
-                pDst2[dstIndex] = colRgb2 + noise;
-                pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f);
-                dstIndex++;
-
-                rnd *= 23;
-            }
-        }
+        rnd = kernels->copySharpPAL_2x2_32_core(rgbTable, frame->line[h].buffer, pDst1, pDst2, pDst3,
+                                                srcWidth, frame->line[h].doubleWidth, rnd);
 
         pDst3 = pDst2;
         pDst1 += dstPitch * 2;
@@ -560,16 +715,80 @@ static void copySharpPAL_2x2_32(FrameBuffer* frame, void* pDestination, int dstP
     }
 }
 
+static UInt32 copySharpPAL_2x1_16_core(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst1, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt16 colCur = (rgbTable[pSrc[0]] & 0xe79c) >> 2;
+    UInt16 colPrev = colCur;
+    int dstIndex = 0;
+
+    if (doubleWidth) {
+        int width = srcWidth * 2;
+        int w;
+        for (w = 0; w < width;) {
+            UInt16 colNext;
+            UInt16 colRgb1;
+            UInt16 colRgb2;
+            UInt16 noise;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
+            colRgb1 = (colPrev + colNext + 2 * colCur) & 0xe79c;
+
+            colPrev = colCur;
+            colCur  = colNext;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
+            colRgb2 = (colPrev + colNext + 2 * colCur) & 0xe79c;
+
+            colPrev = colCur;
+            colCur  = colNext;
+
+            noise = (UInt16)((rnd >> 31) * 0x821);
+            pDst1[dstIndex++] = colRgb1 + noise;
+            pDst1[dstIndex++] = colRgb2 + noise;
+
+            rnd *= 23;
+        }
+    }
+    else {
+        int width = srcWidth;
+        int w;
+        for (w = 0; w < width;) {
+            UInt16 colNext;
+            UInt16 colRgb1;
+            UInt16 colRgb2;
+            UInt16 noise;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
+            colRgb1 = (colPrev + colNext + 2 * colCur) & 0xe79c;
+
+            colPrev = colCur;
+            colCur  = colNext;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
+            colRgb2 = (colPrev + colNext + 2 * colCur) & 0xe79c;
+
+            colPrev = colCur;
+            colCur  = colNext;
+
+            noise = (UInt16)((rnd >> 31) * 0x821);
+            pDst1[dstIndex++] = colRgb1 + noise;
+            pDst1[dstIndex++] = colRgb2 + noise;
+
+            rnd *= 23;
+        }
+    }
+
+    return rnd;
+}
+
 static void copySharpPAL_2x1_16(FrameBuffer* frame, void* pDestination, int dstPitch, UInt16* rgbTable, UInt32 rnd)
 {
-    static UInt32 rndVal = 51;
     UInt16* pDst1       = (UInt16*)pDestination;
     int height          = frame->lines;
     int srcWidth        = frame->maxWidth;
     int h;
 
-    rndVal *= 13;
-    rnd    *= rndVal;
+    rnd *= palNoise;
 
     dstPitch /= (int)sizeof(UInt16);
 
@@ -579,83 +798,84 @@ static void copySharpPAL_2x1_16(FrameBuffer* frame, void* pDestination, int dstP
     }
 
     for (h = 0; h < height; h++) {
-        UInt16* pSrc = frame->line[h].buffer;
-        UInt16 colCur = (rgbTable[pSrc[0]] & 0xe79c) >> 2;
-        UInt16 colPrev = colCur;
-        int dstIndex = 0;
+        rnd = kernels->copySharpPAL_2x1_16_core(rgbTable, frame->line[h].buffer, pDst1,
+                                                srcWidth, frame->line[h].doubleWidth, rnd);
 
-        if (frame->line[h].doubleWidth) {
-            int width = srcWidth * 2;
-            int w;
-            for (w = 0; w < width;) {
-                UInt16 colNext;
-                UInt16 colRgb1;
-                UInt16 colRgb2;
-                UInt16 noise;
+        pDst1 += dstPitch;
+    }
+}
 
-                colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
-                colRgb1 = (colPrev + colNext + 2 * colCur) & 0xe79c;
 
-                colPrev = colCur;
-                colCur  = colNext;
+static UInt32 copySharpPAL_2x1_32_core(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt32 colCur = (rgbTable[pSrc[0]] & 0xfcfcfc) >> 2;
+    UInt32 colPrev = colCur;
+    int dstIndex = 0;
 
-                colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
-                colRgb2 = (colPrev + colNext + 2 * colCur) & 0xe79c;
+    if (doubleWidth) {
+        int width = srcWidth * 2;
+        int w;
+        for (w = 0; w < width;) {
+            UInt32 colNext;
+            UInt32 colRgb1;
+            UInt32 colRgb2;
+            UInt32 noise;
 
-                colPrev = colCur;
-                colCur  = colNext;
+            colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
+            colRgb1 = (colPrev + colNext + 2 * colCur) & 0xfcfcfc;
 
-                noise = (UInt16)((rnd >> 31) * 0x821);
-                pDst1[dstIndex++] = colRgb1 + noise;
-                pDst1[dstIndex++] = colRgb2 + noise;
+            colPrev = colCur;
+            colCur  = colNext;
 
-                rnd *= 23;
-            }
-        }
-        else {
-            int width = srcWidth;
-            int w;
-            for (w = 0; w < width;) {
-                UInt16 colNext;
-                UInt16 colRgb1;
-                UInt16 colRgb2;
-                UInt16 noise;
+            colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
+            colRgb2 = (colPrev + colNext + 2 * colCur) & 0xfcfcfc;
 
-                colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
-                colRgb1 = (colPrev + colNext + 2 * colCur) & 0xe79c;
+            colPrev = colCur;
+            colCur  = colNext;
 
-                colPrev = colCur;
-                colCur  = colNext;
+            noise = (rnd >> 29) * 0x10101;
+            pDst1[dstIndex++] = colRgb1 + noise;
+            pDst1[dstIndex++] = colRgb2 + noise;
+
+            rnd *= 23;
+        }
+    }
+    else {
+        int width = srcWidth;
+        int w;
+        for (w = 0; w < width;) {
+            UInt32 colNext;
+            UInt32 colRgb1;
+            UInt32 colRgb2;
+            UInt32 noise;
 
-                colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
-                colRgb2 = (colPrev + colNext + 2 * colCur) & 0xe79c;
+            colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
+            colRgb1 = (colPrev + 3 * colCur) & 0xfcfcfc;
+            colRgb2 = (colNext + 3 * colCur) & 0xfcfcfc;
 
-                colPrev = colCur;
-                colCur  = colNext;
+            colPrev = colCur;
+            colCur  = colNext;
 
-                noise = (UInt16)((rnd >> 31) * 0x821);
-                pDst1[dstIndex++] = colRgb1 + noise;
-                pDst1[dstIndex++] = colRgb2 + noise;
+            noise = (rnd >> 29) * 0x10101;
+            pDst1[dstIndex++] = colRgb1 + noise;
+            pDst1[dstIndex++] = colRgb2 + noise;
 
-                rnd *= 23;
-            }
+            rnd *= 23;
+            colCur = colNext;
         }
-
-        pDst1 += dstPitch;
     }
-}
 
+    return rnd;
+}
 
 static void copySharpPAL_2x1_32(FrameBuffer* frame, void* pDestination, int dstPitch, UInt32* rgbTable, UInt32 rnd)
 {
-    static UInt32 rndVal = 51;
     UInt32* pDst1       = (UInt32*)pDestination;
     int height          = frame->lines;
     int srcWidth        = frame->maxWidth;
     int h;
 
-    rndVal *= 13;
-    rnd    *= rndVal;
+    rnd *= palNoise;
 
     dstPitch /= (int)sizeof(UInt32);
 
@@ -665,71 +885,87 @@ static void copySharpPAL_2x1_32(FrameBuffer* frame, void* pDestination, int dstP
     }
 
     for (h = 0; h < height; h++) {
-        UInt16* pSrc = frame->line[h].buffer;
-        UInt32 colCur = (rgbTable[pSrc[0]] & 0xfcfcfc) >> 2;
-        UInt32 colPrev = colCur;
-        int dstIndex = 0;
-
-        if (frame->line[h].doubleWidth) {
-            int width = srcWidth * 2;
-            int w;
-            for (w = 0; w < width;) {
-                UInt32 colNext;
-                UInt32 colRgb1;
-                UInt32 colRgb2;
-                UInt32 noise;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
-                colRgb1 = (colPrev + colNext + 2 * colCur) & 0xfcfcfc;
+        rnd = kernels->copySharpPAL_2x1_32_core(rgbTable, frame->line[h].buffer, pDst1,
+                                                srcWidth, frame->line[h].doubleWidth, rnd);
 
-                colPrev = colCur;
-                colCur  = colNext;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
-                colRgb2 = (colPrev + colNext + 2 * colCur) & 0xfcfcfc;
-
-                colPrev = colCur;
-                colCur  = colNext;
+        pDst1 += dstPitch;
+    }
+}
 
-                noise = (rnd >> 29) * 0x10101;
-                pDst1[dstIndex++] = colRgb1 + noise;
-                pDst1[dstIndex++] = colRgb2 + noise;
+static UInt32 copyMonitorPAL_2x2_16_core(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst1, UInt16* pDst2, UInt16* pDst3, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt16 colCur = (rgbTable[pSrc[0]] & 0xe79c) >> 2;
+    UInt16 colPrev = colCur;
+    int dstIndex = 0;
 
-                rnd *= 23;
-            }
+    if (doubleWidth) {
+        int width = srcWidth * 2;
+        int w;
+        for (w = 0; w < width;) {
+            UInt16 colNext;
+            UInt16 colRgb1;
+            UInt16 colRgb2;
+            UInt16 noise;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
+            colRgb1 = (colPrev + 3 * colCur) & 0xe79c;
+
+            colPrev = colCur;
+            colCur  = colNext;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
+            colRgb2 = (colNext + 3 * colCur) & 0xe79c;
+
+            colPrev = colCur;
+            colCur  = colNext;
+
+            noise = (UInt16)(rnd >> 31) * 0x0821;
+            pDst2[dstIndex] = colRgb1 + noise;
+            pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7bef) + ((colRgb1 >> 1) & 0x7bef);
+            pDst1[dstIndex] = ((pDst1[dstIndex] >> 1) & 0x7bef) + ((colRgb1 >> 1) & 0x7bef);
+            dstIndex++;
+            pDst2[dstIndex] = colRgb2 + noise;
+            pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f);
+            pDst1[dstIndex] = ((pDst1[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f);
+            dstIndex++;
+
+            rnd *= 23;
         }
-        else {
-            int width = srcWidth;
-            int w;
-            for (w = 0; w < width;) {
-                UInt32 colNext;
-                UInt32 colRgb1;
-                UInt32 colRgb2;
-                UInt32 noise;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
-                colRgb1 = (colPrev + 3 * colCur) & 0xfcfcfc;
-                colRgb2 = (colNext + 3 * colCur) & 0xfcfcfc;
-
-                colPrev = colCur;
-                colCur  = colNext;
-
-                noise = (rnd >> 29) * 0x10101;
-                pDst1[dstIndex++] = colRgb1 + noise;
-                pDst1[dstIndex++] = colRgb2 + noise;
-
-                rnd *= 23;
-                colCur = colNext;
-            }
+    }
+    else {
+        int width = srcWidth;
+        int w;
+        for (w = 0; w < width;) {
+            UInt16 colRgb1;
+            UInt16 colRgb2;
+            UInt16 colNext;
+            UInt16 noise;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
+            colRgb1 = (3 * colCur + colNext) & 0xfcfcfc;
+            colRgb2 = (4 * colNext) & 0xfcfcfc;
+            
+            colCur = colNext;
+
+            noise = (UInt16)(rnd >> 31) * 0x0821;
+            pDst2[dstIndex] = colRgb1 + noise;
+            pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7bef) + ((colRgb1 >> 1) & 0x7bef);
+            pDst1[dstIndex] = ((pDst1[dstIndex] >> 1) & 0x7bef) + ((colRgb1 >> 1) & 0x7bef);
+            dstIndex++;
+            pDst2[dstIndex] = colRgb2 + noise;
+            pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7bef) + ((colRgb2 >> 1) & 0x7bef);
+            pDst1[dstIndex] = ((pDst1[dstIndex] >> 1) & 0x7bef) + ((colRgb2 >> 1) & 0x7bef);
+            dstIndex++;
+
+            rnd *= 23;
         }
-
-        pDst1 += dstPitch;
     }
+
+    return rnd;
 }
 
 static void copyMonitorPAL_2x2_16(FrameBuffer* frame, void* pDestination, int dstPitch, UInt16* rgbTable, UInt32 rnd)
 {
-    static UInt32 rndVal = 51;
     UInt16* pDst1       = (UInt16*)pDestination;
     UInt16* pDst2       = pDst1 + dstPitch / (int)sizeof(UInt16);
     UInt16* pDst3       = pDst2;
@@ -737,8 +973,7 @@ static void copyMonitorPAL_2x2_16(FrameBuffer* frame, void* pDestination, int ds
     int srcWidth        = frame->maxWidth;
     int h;
 
-    rndVal *= 13;
-    rnd    *= rndVal;
+    rnd *= palNoise;
 
     dstPitch /= (int)sizeof(UInt16);
 
@@ -749,73 +984,8 @@ static void copyMonitorPAL_2x2_16(FrameBuffer* frame, void* pDestination, int ds
     }
 
     for (h = 0; h < height; h++) {
-        UInt16* pSrc = frame->line[h].buffer;
-        UInt16 colCur = (rgbTable[pSrc[0]] & 0xe79c) >> 2;
-        UInt16 colPrev = colCur;
-        int dstIndex = 0;
-
-        if (frame->line[h].doubleWidth) {
-            int width = srcWidth * 2;
-            int w;
-            for (w = 0; w < width;) {
-                UInt16 colNext;
-                UInt16 colRgb1;
-                UInt16 colRgb2;
-                UInt16 noise;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
-                colRgb1 = (colPrev + 3 * colCur) & 0xe79c;
-
-                colPrev = colCur;
-                colCur  = colNext;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
-                colRgb2 = (colNext + 3 * colCur) & 0xe79c;
-
-                colPrev = colCur;
-                colCur  = colNext;
-
-                noise = (UInt16)(rnd >> 31) * 0x0821;
-                pDst2[dstIndex] = colRgb1 + noise;
-                pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7bef) + ((colRgb1 >> 1) & 0x7bef);
-                pDst1[dstIndex] = ((pDst1[dstIndex] >> 1) & 0x7bef) + ((colRgb1 >> 1) & 0x7bef);
-                dstIndex++;
-                pDst2[dstIndex] = colRgb2 + noise;
-                pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f);
-                pDst1[dstIndex] = ((pDst1[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f);
-                dstIndex++;
-
-                rnd *= 23;
-            }
-        }
-        else {
-            int width = srcWidth;
-            int w;
-            for (w = 0; w < width;) {
-                UInt16 colRgb1;
-                UInt16 colRgb2;
-                UInt16 colNext;
-                UInt16 noise;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
-                colRgb1 = (3 * colCur + colNext) & 0xfcfcfc;
-                colRgb2 = (4 * colNext) & 0xfcfcfc;
-                
-                colCur = colNext;
-
-                noise = (UInt16)(rnd >> 31) * 0x0821;
-                pDst2[dstIndex] = colRgb1 + noise;
-                pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7bef) + ((colRgb1 >> 1) & 0x7bef);
-                pDst1[dstIndex] = ((pDst1[dstIndex] >> 1) & 0x7bef) + ((colRgb1 >> 1) & 0x7bef);
-                dstIndex++;
-                pDst2[dstIndex] = colRgb2 + noise;
-                pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7bef) + ((colRgb2 >> 1) & 0x7bef);
-                pDst1[dstIndex] = ((pDst1[dstIndex] >> 1) & 0x7bef) + ((colRgb2 >> 1) & 0x7bef);
-                dstIndex++;
-
-                rnd *= 23;
-            }
-        }
+        rnd = kernels->copyMonitorPAL_2x2_16_core(rgbTable, frame->line[h].buffer, pDst1, pDst2, pDst3,
+                                                  srcWidth, frame->line[h].doubleWidth, rnd);
 
         pDst3  = pDst2;
         pDst1 += dstPitch * 2;
@@ -823,9 +993,80 @@ static void copyMonitorPAL_2x2_16(FrameBuffer* frame, void* pDestination, int ds
     }
 }
 
+static UInt32 copyMonitorPAL_2x2_32_core(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, UInt32* pDst2, UInt32* pDst3, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt32 colCur = (rgbTable[pSrc[0]] & 0xfcfcfc) >> 2;
+    UInt32 colPrev = colCur;
+    int dstIndex = 0;
+
+    if (doubleWidth) {
+        int width = srcWidth * 2;
+        int w;
+        for (w = 0; w < width;) {
+            UInt32 colNext;
+            UInt32 colRgb1;
+            UInt32 colRgb2;
+            UInt32 noise;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
+            colRgb1 = (colPrev + 3 * colCur) & 0xfcfcfc;
+
+            colPrev = colCur;
+            colCur  = colNext;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
+            colRgb2 = (colNext + 3 * colCur) & 0xfcfcfc;
+
+            colPrev = colCur;
+            colCur  = colNext;
+
+            noise = (rnd >> 30) * 0x10101;
+            pDst2[dstIndex] = colRgb1 + noise;
+            pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb1 >> 1) & 0x7f7f7f);
+            pDst1[dstIndex] = ((pDst1[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb1 >> 1) & 0x7f7f7f);
+            dstIndex++;
+            pDst2[dstIndex] = colRgb2 + noise;
+            pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f);
+            pDst1[dstIndex] = ((pDst1[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f);
+            dstIndex++;
+
+            rnd *= 23;
+        }
+    }
+    else {
+        int width = srcWidth;
+        int w;
+        for (w = 0; w < width;) {
+            UInt32 colRgb1;
+            UInt32 colRgb2;
+            UInt32 colNext;
+            UInt32 noise;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
+            colRgb1 = (3 * colCur + colNext) & 0xfcfcfc;
+            colRgb2 = (4 * colNext) & 0xfcfcfc;
+            
+            colCur = colNext;
+
+            noise = (rnd >> 30) * 0x10101;
+            pDst2[dstIndex] = colRgb1 + noise;
+            pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb1 >> 1) & 0x7f7f7f);
+            pDst1[dstIndex] = ((pDst1[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb1 >> 1) & 0x7f7f7f);
+            dstIndex++;
+            pDst2[dstIndex] = colRgb2 + noise;
+            pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f);
+            pDst1[dstIndex] = ((pDst1[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f);
+            dstIndex++;
+
+            rnd *= 23;
+        }
+    }
+
+    return rnd;
+}
+
 static void copyMonitorPAL_2x2_32(FrameBuffer* frame, void* pDestination, int dstPitch, UInt32* rgbTable, UInt32 rnd)
 {
-    static UInt32 rndVal = 51;
     UInt32* pDst1       = (UInt32*)pDestination;
     UInt32* pDst2       = pDst1 + dstPitch / (int)sizeof(UInt32);
     UInt32* pDst3       = pDst2;
@@ -833,8 +1074,7 @@ static void copyMonitorPAL_2x2_32(FrameBuffer* frame, void* pDestination, int ds
     int srcWidth        = frame->maxWidth;
     int h;
 
-    rndVal *= 13;
-    rnd    *= rndVal;
+    rnd *= palNoise;
 
     dstPitch /= (int)sizeof(UInt32);
 
@@ -845,73 +1085,8 @@ static void copyMonitorPAL_2x2_32(FrameBuffer* frame, void* pDestination, int ds
     }
 
     for (h = 0; h < height; h++) {
-        UInt16* pSrc = frame->line[h].buffer;
-        UInt32 colCur = (rgbTable[pSrc[0]] & 0xfcfcfc) >> 2;
-        UInt32 colPrev = colCur;
-        int dstIndex = 0;
-
-        if (frame->line[h].doubleWidth) {
-            int width = srcWidth * 2;
-            int w;
-            for (w = 0; w < width;) {
-                UInt32 colNext;
-                UInt32 colRgb1;
-                UInt32 colRgb2;
-                UInt32 noise;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
-                colRgb1 = (colPrev + 3 * colCur) & 0xfcfcfc;
-
-                colPrev = colCur;
-                colCur  = colNext;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
-                colRgb2 = (colNext + 3 * colCur) & 0xfcfcfc;
-
-                colPrev = colCur;
-                colCur  = colNext;
-
-                noise = (rnd >> 30) * 0x10101;
-                pDst2[dstIndex] = colRgb1 + noise;
-                pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb1 >> 1) & 0x7f7f7f);
-                pDst1[dstIndex] = ((pDst1[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb1 >> 1) & 0x7f7f7f);
-                dstIndex++;
-                pDst2[dstIndex] = colRgb2 + noise;
-                pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f);
-                pDst1[dstIndex] = ((pDst1[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f);
-                dstIndex++;
-
-                rnd *= 23;
-            }
-        }
-        else {
-            int width = srcWidth;
-            int w;
-            for (w = 0; w < width;) {
-                UInt32 colRgb1;
-                UInt32 colRgb2;
-                UInt32 colNext;
-                UInt32 noise;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
-                colRgb1 = (3 * colCur + colNext) & 0xfcfcfc;
-                colRgb2 = (4 * colNext) & 0xfcfcfc;
-                
-                colCur = colNext;
-
-                noise = (rnd >> 30) * 0x10101;
-                pDst2[dstIndex] = colRgb1 + noise;
-                pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb1 >> 1) & 0x7f7f7f);
-                pDst1[dstIndex] = ((pDst1[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb1 >> 1) & 0x7f7f7f);
-                dstIndex++;
-                pDst2[dstIndex] = colRgb2 + noise;
-                pDst1[dstIndex] = ((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f);
-                pDst1[dstIndex] = ((pDst1[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f);
-                dstIndex++;
-
-                rnd *= 23;
-            }
-        }
+        rnd = kernels->copyMonitorPAL_2x2_32_core(rgbTable, frame->line[h].buffer, pDst1, pDst2, pDst3,
+                                                  srcWidth, frame->line[h].doubleWidth, rnd);
 
         pDst3  = pDst2;
         pDst1 += dstPitch * 2;
@@ -919,16 +1094,71 @@ static void copyMonitorPAL_2x2_32(FrameBuffer* frame, void* pDestination, int ds
     }
 }
 
+static UInt32 copyMonitorPAL_2x1_16_core(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst1, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt16 colCur = (rgbTable[pSrc[0]] & 0xe79c) >> 2;
+    int dstIndex = 0;
+
+    if (doubleWidth) {
+        int width = srcWidth * 2;
+        int w;
+        for (w = 0; w < width;) {
+            UInt16 colNext;
+            UInt16 colRgb1;
+            UInt16 colRgb2;
+            UInt16 noise;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
+            colRgb1 = (colNext + 3 * colCur) & 0xe79c;
+
+            colCur = colNext;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
+            colRgb2 = (colNext + 3 * colCur) & 0xe79c;
+
+            colCur = colNext;
+
+            noise = (UInt16)(rnd >> 31) * 0x0821;
+            pDst1[dstIndex++] = colRgb1 + noise;
+            pDst1[dstIndex++] = colRgb2 + noise;
+
+            rnd *= 23;
+        }
+    }
+    else {
+        int width = srcWidth;
+        int w;
+        for (w = 0; w < width;) {
+            UInt16 colNext;
+            UInt16 colRgb1;
+            UInt16 colRgb2;
+            UInt16 noise;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
+            colRgb1 = (colNext + 3 * colCur) & 0xe79c;
+            colRgb2 = (colNext * 4) & 0xe79c;
+            
+            colCur = colNext;
+
+
+            noise = (UInt16)(rnd >> 31) * 0x0821;
+            pDst1[dstIndex++] = colRgb1 + noise;
+            pDst1[dstIndex++] = colRgb2 + noise;
+            rnd *= 23;
+        }
+    }
+
+    return rnd;
+}
+
 static void copyMonitorPAL_2x1_16(FrameBuffer* frame, void* pDestination, int dstPitch, UInt16* rgbTable, UInt32 rnd)
 {
-    static UInt32 rndVal = 51;
     UInt16* pDst1       = (UInt16*)pDestination;
     int height          = frame->lines;
     int srcWidth        = frame->maxWidth;
     int h;
 
-    rndVal *= 13;
-    rnd    *= rndVal;
+    rnd *= palNoise;
 
     dstPitch /= (int)sizeof(UInt16);
 
@@ -938,73 +1168,78 @@ static void copyMonitorPAL_2x1_16(FrameBuffer* frame, void* pDestination, int ds
     }
 
     for (h = 0; h < height; h++) {
-        UInt16* pSrc = frame->line[h].buffer;
-        UInt16 colCur = (rgbTable[pSrc[0]] & 0xe79c) >> 2;
-        int dstIndex = 0;
+        rnd = kernels->copyMonitorPAL_2x1_16_core(rgbTable, frame->line[h].buffer, pDst1,
+                                                  srcWidth, frame->line[h].doubleWidth, rnd);
 
-        if (frame->line[h].doubleWidth) {
-            int width = srcWidth * 2;
-            int w;
-            for (w = 0; w < width;) {
-                UInt16 colNext;
-                UInt16 colRgb1;
-                UInt16 colRgb2;
-                UInt16 noise;
+        pDst1 += dstPitch;
+    }
+}
+
+static UInt32 copyMonitorPAL_2x1_32_core(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt32 colCur = (rgbTable[pSrc[0]] & 0xfcfcfc) >> 2;
+    int dstIndex = 0;
+
+    if (doubleWidth) {
+        int width = srcWidth * 2;
+        int w;
+        for (w = 0; w < width;) {
+            UInt32 colNext;
+            UInt32 colRgb1;
+            UInt32 colRgb2;
+            UInt32 noise;
 
-                colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
-                colRgb1 = (colNext + 3 * colCur) & 0xe79c;
+            colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
+            colRgb1 = (colNext + 3 * colCur) & 0xfcfcfc;
 
-                colCur = colNext;
+            colCur = colNext;
 
-                colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
-                colRgb2 = (colNext + 3 * colCur) & 0xe79c;
+            colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
+            colRgb2 = (colNext + 3 * colCur) & 0xfcfcfc;
 
-                colCur = colNext;
+            colCur = colNext;
 
-                noise = (UInt16)(rnd >> 31) * 0x0821;
-                pDst1[dstIndex++] = colRgb1 + noise;
-                pDst1[dstIndex++] = colRgb2 + noise;
+            noise = (rnd >> 30) * 0x10101;
 
-                rnd *= 23;
-            }
+            pDst1[dstIndex++] = colRgb1 + noise;
+            pDst1[dstIndex++] = colRgb2 + noise;
+
+            rnd *= 23;
         }
-        else {
-            int width = srcWidth;
-            int w;
-            for (w = 0; w < width;) {
-                UInt16 colNext;
-                UInt16 colRgb1;
-                UInt16 colRgb2;
-                UInt16 noise;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
-                colRgb1 = (colNext + 3 * colCur) & 0xe79c;
-                colRgb2 = (colNext * 4) & 0xe79c;
-                
-                colCur = colNext;
-
-
-                noise = (UInt16)(rnd >> 31) * 0x0821;
-                pDst1[dstIndex++] = colRgb1 + noise;
-                pDst1[dstIndex++] = colRgb2 + noise;
-                rnd *= 23;
-            }
+    }
+    else {
+        int width = srcWidth;
+        int w;
+        for (w = 0; w < width;) {
+            UInt32 colNext;
+            UInt32 colRgb1;
+            UInt32 colRgb2;
+            UInt32 noise;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
+            colRgb1 = (colNext + 3 * colCur) & 0xfcfcfc;
+            colRgb2 = (colNext * 4) & 0xfcfcfc;
+            
+            colCur = colNext;
+
+            noise = (rnd >> 30) * 0x10101;
+            pDst1[dstIndex++] = colRgb1 + noise;
+            pDst1[dstIndex++] = colRgb2 + noise;
+            rnd *= 23;
         }
-
-        pDst1 += dstPitch;
     }
+
+    return rnd;
 }
 
 static void copyMonitorPAL_2x1_32(FrameBuffer* frame, void* pDestination, int dstPitch, UInt32* rgbTable, UInt32 rnd)
 {
-    static UInt32 rndVal = 51;
     UInt32* pDst1       = (UInt32*)pDestination;
     int height          = frame->lines;
     int srcWidth        = frame->maxWidth;
     int h;
 
-    rndVal *= 13;
-    rnd    *= rndVal;
+    rnd *= palNoise;
 
     dstPitch /= (int)sizeof(UInt32);
 
@@ -1014,67 +1249,99 @@ static void copyMonitorPAL_2x1_32(FrameBuffer* frame, void* pDestination, int ds
     }
 
     for (h = 0; h < height; h++) {
-        UInt16* pSrc = frame->line[h].buffer;
-        UInt32 colCur = (rgbTable[pSrc[0]] & 0xfcfcfc) >> 2;
-        int dstIndex = 0;
-
-        if (frame->line[h].doubleWidth) {
-            int width = srcWidth * 2;
-            int w;
-            for (w = 0; w < width;) {
-                UInt32 colNext;
-                UInt32 colRgb1;
-                UInt32 colRgb2;
-                UInt32 noise;
+        rnd = kernels->copyMonitorPAL_2x1_32_core(rgbTable, frame->line[h].buffer, pDst1,
+                                                  srcWidth, frame->line[h].doubleWidth, rnd);
 
-                colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
-                colRgb1 = (colNext + 3 * colCur) & 0xfcfcfc;
-
-                colCur = colNext;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
-                colRgb2 = (colNext + 3 * colCur) & 0xfcfcfc;
-
-                colCur = colNext;
-
-                noise = (rnd >> 30) * 0x10101;
+        pDst1 += dstPitch;
+    }
+}
 
-                pDst1[dstIndex++] = colRgb1 + noise;
-                pDst1[dstIndex++] = colRgb2 + noise;
 
-                rnd *= 23;
-            }
+static UInt32 copyPAL_2x2_32_core(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, UInt32* pDst2, UInt32* pDst3, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt32 colCur = (rgbTable[pSrc[0]] & 0xf0f0f0) >> 4;
+    UInt32 colPrev2 = colCur;
+    UInt32 colPrev1 = colCur;
+    UInt32 colNext1 = colCur;
+    int dstIndex = 0;
+
+    if (doubleWidth) {
+        int width = srcWidth * 2;
+        int w;
+        for (w = 0; w < width;) {
+            UInt32 colNext2;
+            UInt32 colRgb1;
+            UInt32 colRgb2;
+            UInt32 colLgt;
+            UInt32 noise;
+
+            colNext2 = (rgbTable[pSrc[w++]] & 0xf0f0f0) >> 4;
+            colLgt   = colCur;
+
+            colRgb1 = (colPrev2 + colNext2 + 2 * colNext1 + 4 * colPrev1 + 8 * colLgt) & 0xf0f0f0;
+
+            colPrev2 = colPrev1;
+            colPrev1 = colCur;
+            colCur   = colNext1;
+            colNext1 = colNext2;
+            colNext2 = pSrc[w];
+
+            colNext2 = (rgbTable[pSrc[w++]] & 0xf0f0f0) >> 4;
+            colLgt   = colCur;
+
+            colRgb2 = (colPrev2 + colNext2 + 2 * colPrev1 + 4 * colNext1 + 8 * colLgt) & 0xf0f0f0;
+
+            colPrev2 = colPrev1;
+            colPrev1 = colCur;
+            colCur   = colNext1;
+            colNext1 = colNext2;
+
+            noise = (rnd >> 29) * 0x10101;
+            pDst2[dstIndex] = colRgb1 + noise;
+            pDst1[dstIndex] = (((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb1 >> 1) & 0x7f7f7f));
+            dstIndex++;
+            pDst2[dstIndex] = colRgb2 + noise;
+            pDst1[dstIndex] = (((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f));
+            dstIndex++;
+
+            rnd *= 23;
         }
-        else {
-            int width = srcWidth;
-            int w;
-            for (w = 0; w < width;) {
-                UInt32 colNext;
-                UInt32 colRgb1;
-                UInt32 colRgb2;
-                UInt32 noise;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
-                colRgb1 = (colNext + 3 * colCur) & 0xfcfcfc;
-                colRgb2 = (colNext * 4) & 0xfcfcfc;
-                
-                colCur = colNext;
-
-                noise = (rnd >> 30) * 0x10101;
-                pDst1[dstIndex++] = colRgb1 + noise;
-                pDst1[dstIndex++] = colRgb2 + noise;
-                rnd *= 23;
-            }
+    }
+    else {
+        int width = srcWidth;
+        int w;
+        for (w = 0; w < width;) {
+            UInt32 colNext;
+            UInt32 colRgb1;
+            UInt32 colRgb2;
+            UInt32 colLgt;
+            UInt32 noise;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xf0f0f0) >> 4;
+            colLgt   = colCur;
+
+            colRgb1 = (6 * colPrev1 + 2 * colNext + 8 * colLgt) & 0xf0f0f0;
+            colRgb2 = (2 * colPrev1 + 6 * colNext + 8 * colLgt) & 0xf0f0f0;
+
+            noise = (rnd >> 29) * 0x10101;
+            pDst2[dstIndex] = colRgb1 + noise;
+            pDst1[dstIndex] = (((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb1 >> 1) & 0x7f7f7f));
+            dstIndex++;
+            pDst2[dstIndex] = colRgb2 + noise;
+            pDst1[dstIndex] = (((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f));
+            dstIndex++;
+
+            rnd *= 23;
+            colPrev1 = colCur;
+            colCur = colNext;
         }
-
-        pDst1 += dstPitch;
     }
-}
 
+    return rnd;
+}
 
 static void copyPAL_2x2_32(FrameBuffer* frame, void* pDestination, int dstPitch, UInt32* rgbTable, UInt32 rnd)
 {
-    static UInt32 rndVal = 51;
     UInt32* pDst1       = (UInt32*)pDestination;
     UInt32* pDst2       = pDst1 + dstPitch / (int)sizeof(UInt32);
     UInt32* pDst3       = pDst2;
@@ -1082,8 +1349,7 @@ static void copyPAL_2x2_32(FrameBuffer* frame, void* pDestination, int dstPitch,
     int srcWidth        = frame->maxWidth;
     int h;
 
-    rndVal *= 13;
-    rnd    *= rndVal;
+    rnd *= palNoise;
 
     dstPitch /= (int)sizeof(UInt32);
 
@@ -1094,84 +1360,8 @@ static void copyPAL_2x2_32(FrameBuffer* frame, void* pDestination, int dstPitch,
     }
 
     for (h = 0; h < height; h++) {
-        UInt16* pSrc = frame->line[h].buffer;
-        UInt32 colCur = (rgbTable[pSrc[0]] & 0xf0f0f0) >> 4;
-        UInt32 colPrev2 = colCur;
-        UInt32 colPrev1 = colCur;
-        UInt32 colNext1 = colCur;
-        int dstIndex = 0;
-
-        if (frame->line[h].doubleWidth) {
-            int width = srcWidth * 2;
-            int w;
-            for (w = 0; w < width;) {
-                UInt32 colNext2;
-                UInt32 colRgb1;
-                UInt32 colRgb2;
-                UInt32 colLgt;
-                UInt32 noise;
-
-                colNext2 = (rgbTable[pSrc[w++]] & 0xf0f0f0) >> 4;
-                colLgt   = colCur;
-
-                colRgb1 = (colPrev2 + colNext2 + 2 * colNext1 + 4 * colPrev1 + 8 * colLgt) & 0xf0f0f0;
-
-                colPrev2 = colPrev1;
-                colPrev1 = colCur;
-                colCur   = colNext1;
-                colNext1 = colNext2;
-                colNext2 = pSrc[w];
-
-                colNext2 = (rgbTable[pSrc[w++]] & 0xf0f0f0) >> 4;
-                colLgt   = colCur;
-
-                colRgb2 = (colPrev2 + colNext2 + 2 * colPrev1 + 4 * colNext1 + 8 * colLgt) & 0xf0f0f0;
-
-                colPrev2 = colPrev1;
-                colPrev1 = colCur;
-                colCur   = colNext1;
-                colNext1 = colNext2;
-
-                noise = (rnd >> 29) * 0x10101;
-                pDst2[dstIndex] = colRgb1 + noise;
-                pDst1[dstIndex] = (((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb1 >> 1) & 0x7f7f7f));
-                dstIndex++;
-                pDst2[dstIndex] = colRgb2 + noise;
-                pDst1[dstIndex] = (((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f));
-                dstIndex++;
-
-                rnd *= 23;
-            }
-        }
-        else {
-            int width = srcWidth;
-            int w;
-            for (w = 0; w < width;) {
-                UInt32 colNext;
-                UInt32 colRgb1;
-                UInt32 colRgb2;
-                UInt32 colLgt;
-                UInt32 noise;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xf0f0f0) >> 4;
-                colLgt   = colCur;
-
-                colRgb1 = (6 * colPrev1 + 2 * colNext + 8 * colLgt) & 0xf0f0f0;
-                colRgb2 = (2 * colPrev1 + 6 * colNext + 8 * colLgt) & 0xf0f0f0;
-
-                noise = (rnd >> 29) * 0x10101;
-                pDst2[dstIndex] = colRgb1 + noise;
-                pDst1[dstIndex] = (((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb1 >> 1) & 0x7f7f7f));
-                dstIndex++;
-                pDst2[dstIndex] = colRgb2 + noise;
-                pDst1[dstIndex] = (((pDst3[dstIndex] >> 1) & 0x7f7f7f) + ((colRgb2 >> 1) & 0x7f7f7f));
-                dstIndex++;
-
-                rnd *= 23;
-                colPrev1 = colCur;
-                colCur = colNext;
-            }
-        }
+        rnd = kernels->copyPAL_2x2_32_core(rgbTable, frame->line[h].buffer, pDst1, pDst2, pDst3,
+                                           srcWidth, frame->line[h].doubleWidth, rnd);
         pDst3 = pDst2;
         pDst1 += dstPitch * 2;
         pDst2 += dstPitch * 2;
@@ -1179,16 +1369,87 @@ static void copyPAL_2x2_32(FrameBuffer* frame, void* pDestination, int dstPitch,
 }
 
 
-static void copyPAL_2x1_32(FrameBuffer* frame, void* pDestination, int dstPitch, UInt32* rgbTable, UInt32 rnd)
+static UInt32 copyPAL_2x1_32_core(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, int srcWidth, int doubleWidth, UInt32 rnd)
 {
-    static UInt32 rndVal = 51;
-    UInt32* pDst1       = (UInt32*)pDestination;
-    int height          = frame->lines;
-    int srcWidth        = frame->maxWidth;
-    int h;
+    UInt32 colCur = (rgbTable[pSrc[0]] & 0xf0f0f0) >> 4;
+    UInt32 colPrev2 = colCur;
+    UInt32 colPrev1 = colCur;
+    UInt32 colNext1 = colCur;
+    int dstIndex = 0;
+
+    if (doubleWidth) {
+        int width = srcWidth * 2;
+        int w;
+        for (w = 0; w < width;) {
+            UInt32 colNext2;
+            UInt32 colRgb1;
+            UInt32 colRgb2;
+            UInt32 colLgt;
+            UInt32 noise;
+
+            colNext2 = (rgbTable[pSrc[w++]] & 0xf0f0f0) >> 4;
+            colLgt = colCur;
+            colRgb1 = (colPrev2 + colNext2 + 2 * colNext1 + 4 * colPrev1 + 8 * colLgt) & 0xf0f0f0;
+
+            colPrev2 = colPrev1;
+            colPrev1 = colCur;
+            colCur   = colNext1;
+            colNext1 = colNext2;
+            colNext2 = pSrc[w];
+
+            colNext2 = (rgbTable[pSrc[w++]] & 0xf0f0f0) >> 4;
+            colLgt = colCur;
+            colRgb2 = (colPrev2 + colNext2 + 2 * colPrev1 + 4 * colNext1 + 8 * colLgt) & 0xf0f0f0;
+
+            colPrev2 = colPrev1;
+            colPrev1 = colCur;
+            colCur   = colNext1;
+            colNext1 = colNext2;
+
+            noise = (rnd >> 29) * 0x10101;
+            pDst1[dstIndex++] = colRgb1 + noise;
+            pDst1[dstIndex++] = colRgb2 + noise;
+
+            rnd *= 23;
+        }
+    }
+    else {
+        int width = srcWidth;
+        int w;
+        for (w = 0; w < width;) {
+            UInt32 colNext;
+            UInt32 colRgb1;
+            UInt32 colRgb2;
+            UInt32 colLgt;
+            UInt32 noise;
+
+            colNext = (rgbTable[pSrc[w++]] & 0xf0f0f0) >> 4;
+            colLgt = colCur;
+            colRgb1 = (2 * colNext  + 6 * colPrev1 + 8 * colLgt) & 0xf0f0f0;
+            colRgb2 = (2 * colPrev1 + 6 * colNext  + 8 * colLgt) & 0xf0f0f0;
+
+            noise = (rnd >> 29) * 0x10101;
+            pDst1[dstIndex++] = colRgb1 + noise;
+            pDst1[dstIndex++] = colRgb2 + noise;
+
+
+            rnd *= 23;
+            colPrev1 = colCur;
+            colCur = colNext;
+        }
+    }
+
+    return rnd;
+}
+
+static void copyPAL_2x1_32(FrameBuffer* frame, void* pDestination, int dstPitch, UInt32* rgbTable, UInt32 rnd)
+{
+    UInt32* pDst1       = (UInt32*)pDestination;
+    int height          = frame->lines;
+    int srcWidth        = frame->maxWidth;
+    int h;
 
-    rndVal *= 13;
-    rnd    *= rndVal;
+    rnd *= palNoise;
 
     dstPitch /= (int)sizeof(UInt32);
 
@@ -1198,234 +1459,182 @@ static void copyPAL_2x1_32(FrameBuffer* frame, void* pDestination, int dstPitch,
     }
 
     for (h = 0; h < height; h++) {
-        UInt16* pSrc = frame->line[h].buffer;
-        UInt32 colCur = (rgbTable[pSrc[0]] & 0xf0f0f0) >> 4;
-        UInt32 colPrev2 = colCur;
-        UInt32 colPrev1 = colCur;
-        UInt32 colNext1 = colCur;
-        int dstIndex = 0;
+        rnd = kernels->copyPAL_2x1_32_core(rgbTable, frame->line[h].buffer, pDst1,
+                                           srcWidth, frame->line[h].doubleWidth, rnd);
+        pDst1 += dstPitch;
+    }
+}
 
-        if (frame->line[h].doubleWidth) {
-            int width = srcWidth * 2;
-            int w;
-            for (w = 0; w < width;) {
-                UInt32 colNext2;
-                UInt32 colRgb1;
-                UInt32 colRgb2;
-                UInt32 colLgt;
-                UInt32 noise;
-
-                colNext2 = (rgbTable[pSrc[w++]] & 0xf0f0f0) >> 4;
-                colLgt = colCur;
-                colRgb1 = (colPrev2 + colNext2 + 2 * colNext1 + 4 * colPrev1 + 8 * colLgt) & 0xf0f0f0;
-
-                colPrev2 = colPrev1;
-                colPrev1 = colCur;
-                colCur   = colNext1;
-                colNext1 = colNext2;
-                colNext2 = pSrc[w];
-
-                colNext2 = (rgbTable[pSrc[w++]] & 0xf0f0f0) >> 4;
-                colLgt = colCur;
-                colRgb2 = (colPrev2 + colNext2 + 2 * colPrev1 + 4 * colNext1 + 8 * colLgt) & 0xf0f0f0;
-
-                colPrev2 = colPrev1;
-                colPrev1 = colCur;
-                colCur   = colNext1;
-                colNext1 = colNext2;
-
-                noise = (rnd >> 29) * 0x10101;
-                pDst1[dstIndex++] = colRgb1 + noise;
-                pDst1[dstIndex++] = colRgb2 + noise;
-
-                rnd *= 23;
-            }
+static UInt32 copyPAL_1x1_16_core(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt16 colCur =  (rgbTable[pSrc[0]] & 0xe79c) >> 2;
+    UInt16 colPrev = colCur;
+    int dstIndex = 0;
+    int w;
+
+    if (doubleWidth) {
+        int width = srcWidth * 2;
+        for (w = 0; w < width;) {
+            UInt16 colTmp1 = (rgbTable[pSrc[w++]] & 0xc718) >> 3;
+            UInt16 colTmp2 = (rgbTable[pSrc[w++]] & 0xc718) >> 3;
+            UInt16 colNext = (colTmp1 + colTmp2) & 0xe79c;
+            UInt16 colRgb  = (colPrev + 2 * colCur + colNext) & 0xe79c;
+
+            colPrev = colCur;
+            colCur = colNext;
+
+            pDst[dstIndex++] = colRgb + (UInt16)(rnd >> 31)  * 0x0821;
+            rnd *= 23;
         }
-        else {
-            int width = srcWidth;
-            int w;
-            for (w = 0; w < width;) {
-                UInt32 colNext;
-                UInt32 colRgb1;
-                UInt32 colRgb2;
-                UInt32 colLgt;
-                UInt32 noise;
-
-                colNext = (rgbTable[pSrc[w++]] & 0xf0f0f0) >> 4;
-                colLgt = colCur;
-                colRgb1 = (2 * colNext  + 6 * colPrev1 + 8 * colLgt) & 0xf0f0f0;
-                colRgb2 = (2 * colPrev1 + 6 * colNext  + 8 * colLgt) & 0xf0f0f0;
-
-                noise = (rnd >> 29) * 0x10101;
-                pDst1[dstIndex++] = colRgb1 + noise;
-                pDst1[dstIndex++] = colRgb2 + noise;
-
-
-                rnd *= 23;
-                colPrev1 = colCur;
-                colCur = colNext;
-            }
+    }
+    else {
+        int width = srcWidth;
+        for (w = 0; w < width;) {
+            UInt16 colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
+            UInt16 colRgb  = (colPrev + 2 * colCur + colNext) & 0xe79c;
+            colPrev = colCur;
+            colCur = colNext;
+
+            pDst[dstIndex++] = colRgb + (UInt16)(rnd >> 31)  * 0x0821;
+            rnd *= 23;
         }
-        pDst1 += dstPitch;
     }
+
+    return rnd;
 }
 
 static void copyPAL_1x1_16(FrameBuffer* frame, void* pDestination, int dstPitch, UInt16* rgbTable, UInt32 rnd)
 {
-    static UInt32 rndVal = 51;
     UInt16* pDst        = (UInt16*)pDestination;
     int height          = frame->lines;
     int srcWidth        = frame->maxWidth;
     int h;
 
-    rndVal *= 13;
-    rnd    *= rndVal;
+    rnd *= palNoise;
     
     dstPitch /= (int)sizeof(UInt16);
 
     for (h = 0; h < height; h++) {
-        UInt16* pSrc = frame->line[h].buffer;
-        UInt16 colCur =  (rgbTable[pSrc[0]] & 0xe79c) >> 2;
-        UInt16 colPrev = colCur;
-        int dstIndex = 0;
-        int w;
+        rnd = kernels->copyPAL_1x1_16_core(rgbTable, frame->line[h].buffer, pDst,
+                                           srcWidth, frame->line[h].doubleWidth, rnd);
+        pDst += dstPitch;
+    }
+}
 
-        if (frame->line[h].doubleWidth) {
-            int width = srcWidth * 2;
-            for (w = 0; w < width;) {
-                UInt16 colTmp1 = (rgbTable[pSrc[w++]] & 0xc718) >> 3;
-                UInt16 colTmp2 = (rgbTable[pSrc[w++]] & 0xc718) >> 3;
-                UInt16 colNext = (colTmp1 + colTmp2) & 0xe79c;
-                UInt16 colRgb  = (colPrev + 2 * colCur + colNext) & 0xe79c;
-
-                colPrev = colCur;
-                colCur = colNext;
-
-                pDst[dstIndex++] = colRgb + (UInt16)(rnd >> 31)  * 0x0821;
-                rnd *= 23;
-            }
+
+static UInt32 copyPAL_1x1_32_core(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt32 colCur = (rgbTable[pSrc[0]] & 0xfcfcfc) >> 2;
+    UInt32 colPrev = colCur;
+    int dstIndex = 0;
+    int w;
+
+    if (doubleWidth) {
+        int width = srcWidth * 2;
+        for (w = 0; w < width; ) {
+            UInt32 colTmp1 = (rgbTable[pSrc[w++]] & 0xf8f8f8) >> 3;
+            UInt32 colTmp2 = (rgbTable[pSrc[w++]] & 0xf8f8f8) >> 3;
+            UInt32 colNext = (colTmp1 + colTmp2) & 0xfcfcfc;
+            UInt32 colRgb  = (colPrev + 2 * colCur + colNext) & 0xfcfcfc;
+
+            colPrev = colCur;
+            colCur = colNext;
+
+            pDst[dstIndex++] = colRgb + (rnd >> 31)  * 0x10101;
+            rnd *= 23;
         }
-        else {
-            int width = srcWidth;
-            for (w = 0; w < width;) {
-                UInt16 colNext = (rgbTable[pSrc[w++]] & 0xe79c) >> 2;
-                UInt16 colRgb  = (colPrev + 2 * colCur + colNext) & 0xe79c;
-                colPrev = colCur;
-                colCur = colNext;
-
-                pDst[dstIndex++] = colRgb + (UInt16)(rnd >> 31)  * 0x0821;
-                rnd *= 23;
-            }
+    }
+    else {
+        int width = srcWidth;
+        for (w = 0; w < width;) {
+            UInt32 colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
+            UInt32 colRgb  = (colPrev + 2 * colCur + colNext) & 0xfcfcfc;
+            colPrev = colCur;
+            colCur = colNext;
+
+            pDst[dstIndex++] = colRgb + (rnd >> 31)  * 0x10101;
+            rnd *= 23;
         }
-        pDst += dstPitch;
     }
-}
 
+    return rnd;
+}
 
 static void copyPAL_1x1_32(FrameBuffer* frame, void* pDestination, int dstPitch, UInt32* rgbTable, UInt32 rnd)
 {
-    static UInt32 rndVal = 51;
     UInt32* pDst        = (UInt32*)pDestination;
     int height          = frame->lines;
     int srcWidth        = frame->maxWidth;
     int h;
 
-    rndVal *= 13;
-    rnd    *= rndVal;
+    rnd *= palNoise;
 
     dstPitch /= (int)sizeof(UInt32);
 
     for (h = 0; h < height; h++) {
-        UInt16* pSrc = frame->line[h].buffer;
-        UInt32 colCur = (rgbTable[pSrc[0]] & 0xfcfcfc) >> 2;
-        UInt32 colPrev = colCur;
-        int dstIndex = 0;
-        int w;
+        rnd = kernels->copyPAL_1x1_32_core(rgbTable, frame->line[h].buffer, pDst,
+                                           srcWidth, frame->line[h].doubleWidth, rnd);
+        pDst += dstPitch;
+    }
+}
 
-        if (frame->line[h].doubleWidth) {
-            int width = srcWidth * 2;
-            for (w = 0; w < width; ) {
-                UInt32 colTmp1 = (rgbTable[pSrc[w++]] & 0xf8f8f8) >> 3;
-                UInt32 colTmp2 = (rgbTable[pSrc[w++]] & 0xf8f8f8) >> 3;
-                UInt32 colNext = (colTmp1 + colTmp2) & 0xfcfcfc;
-                UInt32 colRgb  = (colPrev + 2 * colCur + colNext) & 0xfcfcfc;
-
-                colPrev = colCur;
-                colCur = colNext;
-
-                pDst[dstIndex++] = colRgb + (rnd >> 31)  * 0x10101;
-                rnd *= 23;
-            }
+static UInt32 copyPAL_1x05_32_core(UInt32* rgbTable, UInt16* pSrcA, UInt16* pSrcB, UInt32* pDst, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt32 colCur = (rgbTable[pSrcA[0]] & 0xfcfcfc) >> 2;
+    UInt32 colPrev = colCur;
+    int dstIndex = 0;
+    int w;
+
+    if (doubleWidth) {
+        int width = srcWidth * 2;
+        for (w = 0; w < width;) {
+            UInt32 colTmp1A = (rgbTable[pSrcA[w  ]] & 0xf0f0f0) >> 4;
+            UInt32 colTmp1B = (rgbTable[pSrcB[w++]] & 0xf0f0f0) >> 4;
+            UInt32 colTmp2A = (rgbTable[pSrcA[w  ]] & 0xf0f0f0) >> 4;
+            UInt32 colTmp2B = (rgbTable[pSrcB[w++]] & 0xf0f0f0) >> 4;
+            UInt32 colNext = (colTmp1A + colTmp2A + colTmp1B + colTmp2B) & 0xf0f0f0;
+            UInt32 colRgb  = (colPrev + 2 * colCur + colNext) & 0xfcfcfc;
+            
+            colPrev = colCur;
+            colCur = colNext;
+
+            pDst[dstIndex++] = colRgb + (rnd >> 31)  * 0x10101;
+            rnd *= 23;
         }
-        else {
-            int width = srcWidth;
-            for (w = 0; w < width;) {
-                UInt32 colNext = (rgbTable[pSrc[w++]] & 0xfcfcfc) >> 2;
-                UInt32 colRgb  = (colPrev + 2 * colCur + colNext) & 0xfcfcfc;
-                colPrev = colCur;
-                colCur = colNext;
-
-                pDst[dstIndex++] = colRgb + (rnd >> 31)  * 0x10101;
-                rnd *= 23;
-            }
+    }
+    else {
+        int width = srcWidth;
+        for (w = 0; w < width;) {
+            UInt32 colTmpA = (rgbTable[pSrcA[w  ]] & 0xf8f8f8) >> 3;
+            UInt32 colTmpB = (rgbTable[pSrcB[w++]] & 0xf8f8f8) >> 3;
+            UInt32 colNext = (colTmpA + colTmpB) & 0xf8f8f8;
+            UInt32 colRgb  = (colPrev + 2 * colCur + colNext) & 0xfcfcfc;
+            
+            colPrev = colCur;
+            colCur = colNext;
+
+            pDst[dstIndex++] = colRgb + (rnd >> 31)  * 0x10101;
+            rnd *= 23;
         }
-        pDst += dstPitch;
     }
+
+    return rnd;
 }
 
 static void copyPAL_1x05_32(FrameBuffer* frame, void* pDestination, int dstPitch, UInt32* rgbTable, UInt32 rnd)
 {
-    static UInt32 rndVal = 51;
     UInt32* pDst        = (UInt32*)pDestination;
     int height          = frame->lines;
     int srcWidth        = frame->maxWidth;
     int h;
 
-    rndVal *= 13;
-    rnd    *= rndVal;
+    rnd *= palNoise;
 
     dstPitch /= (int)sizeof(UInt32);
 
     for (h = 0; h < height; h += 2) {
-        UInt16* pSrcA = frame->line[h + 0].buffer;
-        UInt16* pSrcB = frame->line[h + 1].buffer;
-        UInt32 colCur = (rgbTable[pSrcA[0]] & 0xfcfcfc) >> 2;
-        UInt32 colPrev = colCur;
-        int dstIndex = 0;
-        int w;
-
-        if (frame->line[h].doubleWidth) {
-            int width = srcWidth * 2;
-            for (w = 0; w < width;) {
-                UInt32 colTmp1A = (rgbTable[pSrcA[w  ]] & 0xf0f0f0) >> 4;
-                UInt32 colTmp1B = (rgbTable[pSrcB[w++]] & 0xf0f0f0) >> 4;
-                UInt32 colTmp2A = (rgbTable[pSrcA[w  ]] & 0xf0f0f0) >> 4;
-                UInt32 colTmp2B = (rgbTable[pSrcB[w++]] & 0xf0f0f0) >> 4;
-                UInt32 colNext = (colTmp1A + colTmp2A + colTmp1B + colTmp2B) & 0xf0f0f0;
-                UInt32 colRgb  = (colPrev + 2 * colCur + colNext) & 0xfcfcfc;
-                
-                colPrev = colCur;
-                colCur = colNext;
-
-                pDst[dstIndex++] = colRgb + (rnd >> 31)  * 0x10101;
-                rnd *= 23;
-            }
-        }
-        else {
-            int width = srcWidth;
-            for (w = 0; w < width;) {
-                UInt32 colTmpA = (rgbTable[pSrcA[w  ]] & 0xf8f8f8) >> 3;
-                UInt32 colTmpB = (rgbTable[pSrcB[w++]] & 0xf8f8f8) >> 3;
-                UInt32 colNext = (colTmpA + colTmpB) & 0xf8f8f8;
-                UInt32 colRgb  = (colPrev + 2 * colCur + colNext) & 0xfcfcfc;
-                
-                colPrev = colCur;
-                colCur = colNext;
-
-                pDst[dstIndex++] = colRgb + (rnd >> 31)  * 0x10101;
-                rnd *= 23;
-            }
-        }
+        rnd = kernels->copyPAL_1x05_32_core(rgbTable, frame->line[h + 0].buffer, frame->line[h + 1].buffer, pDst,
+                                            srcWidth, frame->line[h].doubleWidth, rnd);
         pDst += dstPitch;
     }
 }
@@ -1450,27 +1659,16 @@ static void copy_1x1_16(FrameBuffer* frame, void* pDestination, int dstPitch, UI
         UInt16* pOldDst = pDst;
         UInt16* pSrc = frame->line[h].buffer;
 
+        if (isLineClean(h)) {
+            pDst += dstPitch;
+            continue;
+        }
+
         if (frame->line[h].doubleWidth) {
-            int width = srcWidth / 4;
-            while (width--) {
-                pDst[0] = (((rgbTable[pSrc[0]] & 0xe79c) >> 1) + ((rgbTable[pSrc[1]] & 0xe79c) >> 1)) & 0xe79c;
-                pDst[1] = (((rgbTable[pSrc[2]] & 0xe79c) >> 1) + ((rgbTable[pSrc[3]] & 0xe79c) >> 1)) & 0xe79c;
-                pDst[2] = (((rgbTable[pSrc[4]] & 0xe79c) >> 1) + ((rgbTable[pSrc[5]] & 0xe79c) >> 1)) & 0xe79c;
-                pDst[3] = (((rgbTable[pSrc[6]] & 0xe79c) >> 1) + ((rgbTable[pSrc[7]] & 0xe79c) >> 1)) & 0xe79c;
-                pSrc += 8;
-                pDst += 4;
-            }
+            kernels->copy_05x_16_core(rgbTable, pSrc, pDst, srcWidth / 4);
         }
         else {
-            int width = srcWidth / 4;
-            while (width--) {
-                pDst[0] = rgbTable[pSrc[0]];
-                pDst[1] = rgbTable[pSrc[1]];
-                pDst[2] = rgbTable[pSrc[2]];
-                pDst[3] = rgbTable[pSrc[3]];
-                pSrc += 4;
-                pDst += 4;
-            }
+            kernels->copy_1x_16_core(rgbTable, pSrc, pDst, srcWidth / 4);
         }
         pDst = pOldDst + dstPitch; 
     }
@@ -1490,27 +1688,16 @@ static void copy_1x1_32(FrameBuffer* frame, void* pDestination, int dstPitch, UI
         UInt32* pOldDst = pDst;
         UInt16* pSrc = frame->line[h].buffer;
 
+        if (isLineClean(h)) {
+            pDst += dstPitch;
+            continue;
+        }
+
         if (frame->line[h].doubleWidth) {
-            int width = srcWidth / 4;
-            while (width--) {
-                pDst[0] = (((rgbTable[pSrc[0]] & 0xfefefe) >> 1) + ((rgbTable[pSrc[1]] & 0xfefefe) >> 1)) & 0xfefefe;
-                pDst[1] = (((rgbTable[pSrc[2]] & 0xfefefe) >> 1) + ((rgbTable[pSrc[3]] & 0xfefefe) >> 1)) & 0xfefefe;
-                pDst[2] = (((rgbTable[pSrc[4]] & 0xfefefe) >> 1) + ((rgbTable[pSrc[5]] & 0xfefefe) >> 1)) & 0xfefefe;
-                pDst[3] = (((rgbTable[pSrc[6]] & 0xfefefe) >> 1) + ((rgbTable[pSrc[7]] & 0xfefefe) >> 1)) & 0xfefefe;
-                pSrc += 8;
-                pDst += 4;
-            }
+            kernels->copy_05x_32_core(rgbTable, pSrc, pDst, srcWidth / 4);
         }
         else {
-            int width = srcWidth / 4;
-            while (width--) {
-                pDst[0] = rgbTable[pSrc[0]];
-                pDst[1] = rgbTable[pSrc[1]];
-                pDst[2] = rgbTable[pSrc[2]];
-                pDst[3] = rgbTable[pSrc[3]];
-                pSrc += 4;
-                pDst += 4;
-            }
+            kernels->copy_1x_32_core(rgbTable, pSrc, pDst, srcWidth / 4);
         }
         pDst = pOldDst + dstPitch; 
     }
@@ -1530,23 +1717,12 @@ static void copy_1x05_16(FrameBuffer* frame, void* pDestination, int dstPitch, U
         UInt16* pSrc1 = frame->line[h + 0].buffer;
         UInt16* pSrc2 = frame->line[h + 1].buffer;
 
-        if (frame->line[h].doubleWidth) {
-            int width = srcWidth;
-            while (width--) {
-                UInt16 col0 = (((rgbTable[pSrc1[0]] & 0xe79c) >> 2) + ((rgbTable[pSrc1[1]] & 0xe79c) >> 2));
-                UInt16 col1 = (((rgbTable[pSrc2[0]] & 0xe79c) >> 2) + ((rgbTable[pSrc2[1]] & 0xe79c) >> 2));
-                
-                *pDst++ = (col0 + col1) & 0xe79c;
-                pSrc1 += 2;
-                pSrc2 += 2;
-            }
-        }
-        else {
-            int width = srcWidth;
-            while (width--) {
-                *pDst++ = (((rgbTable[pSrc1[0]] & 0xe79c) >> 1) + ((rgbTable[pSrc2[0]] & 0xe79c) >> 1)) & 0xe79c;
-            }
+        if (isLineClean(h) && isLineClean(h + 1)) {
+            pDst += dstPitch;
+            continue;
         }
+
+        kernels->copy_1x05_16_core(rgbTable, pSrc1, pSrc2, pDst, srcWidth, frame->line[h].doubleWidth);
         pDst = pOldDst + dstPitch; 
     }
 }
@@ -1566,25 +1742,12 @@ static void copy_1x05_32(FrameBuffer* frame, void* pDestination, int dstPitch, U
         UInt16* pSrc1 = frame->line[h + 0].buffer;
         UInt16* pSrc2 = frame->line[h + 1].buffer;
 
-        if (frame->line[h].doubleWidth) {
-            int width = srcWidth;
-            while (width--) {
-                UInt32 col0 = (((rgbTable[pSrc1[0]] & 0xfcfcfc) >> 2) + ((rgbTable[pSrc1[1]] & 0xfcfcfc) >> 2));
-                UInt32 col1 = (((rgbTable[pSrc2[0]] & 0xfcfcfc) >> 2) + ((rgbTable[pSrc2[1]] & 0xfcfcfc) >> 2));
-                
-                *pDst++ = (col0 + col1) & 0xfcfcfc;
-                pSrc1 += 2;
-                pSrc2 += 2;
-            }
-        }
-        else {
-            int width = srcWidth;
-            while (width--) {
-                *pDst++ = (((rgbTable[pSrc1[0]] & 0xfefefe) >> 1) + ((rgbTable[pSrc2[0]] & 0xfefefe) >> 1)) & 0xfefefe;
-                pSrc1++;
-                pSrc2++;
-            }
+        if (isLineClean(h) && isLineClean(h + 1)) {
+            pDst += dstPitch;
+            continue;
         }
+
+        kernels->copy_1x05_32_core(rgbTable, pSrc1, pSrc2, pDst, srcWidth, frame->line[h].doubleWidth);
         pDst = pOldDst + dstPitch; 
     }
 }
@@ -1607,65 +1770,21 @@ static void copy_2x2_16(FrameBuffer* frame, void* pDestination, int dstPitch, UI
     }
 
     for (h = 0; h < height; h++) {
-        UInt16* pDst1old = pDst1;
-        UInt16* pDst2old = pDst2;
-        UInt16* pSrc = frame->line[h].buffer;
+        if (isLineClean(h)) {
+            pDst1 += dstPitch * 2;
+            pDst2 += dstPitch * 2;
+            continue;
+        }
 
         if (frame->line[h].doubleWidth) {
-            int width = srcWidth / 4 * 2;
-            while (width--) {
-                UInt16 col1 = rgbTable[pSrc[0]];
-                UInt16 col2 = rgbTable[pSrc[1]];
-                UInt16 col3 = rgbTable[pSrc[2]];
-                UInt16 col4 = rgbTable[pSrc[3]];
-                pSrc  += 4;
-
-                pDst1[0] = col1;
-                pDst1[1] = col2;
-                pDst1[2] = col3;
-                pDst1[3] = col4;
-                pDst1 += 4;
-
-                pDst2[0] = col1;
-                pDst2[1] = col2;
-                pDst2[2] = col3;
-                pDst2[3] = col4;
-                pDst2 += 4;
-            }
+            kernels->copy_2x2_16_core1(rgbTable, frame->line[h].buffer, pDst1, pDst2, srcWidth / 4 * 2);
         }
         else {
-            int width = srcWidth / 4;
-            while (width--) {
-                UInt16 col1 = rgbTable[pSrc[0]];
-                UInt16 col2 = rgbTable[pSrc[1]];
-                UInt16 col3 = rgbTable[pSrc[2]];
-                UInt16 col4 = rgbTable[pSrc[3]];
-                pSrc  += 4;
-
-                pDst1[0] = col1;
-                pDst1[1] = col1;
-                pDst1[2] = col2;
-                pDst1[3] = col2;
-                pDst1[4] = col3;
-                pDst1[5] = col3;
-                pDst1[6] = col4;
-                pDst1[7] = col4;
-                pDst1 += 8;
-
-                pDst2[0] = col1;
-                pDst2[1] = col1;
-                pDst2[2] = col2;
-                pDst2[3] = col2;
-                pDst2[4] = col3;
-                pDst2[5] = col3;
-                pDst2[6] = col4;
-                pDst2[7] = col4;
-                pDst2 += 8;
-            }  
-        }
-
-        pDst1 = pDst1old + dstPitch * 2;
-        pDst2 = pDst2old +  dstPitch * 2;
+            kernels->copy_2x2_16_core2(rgbTable, frame->line[h].buffer, pDst1, pDst2, srcWidth / 4);
+        }
+
+        pDst1 += dstPitch * 2;
+        pDst2 += dstPitch * 2;
     }
 }
 
@@ -1999,36 +2118,6 @@ static void copy_2x2_32(FrameBuffer* frame, void* pDestination, int dstPitch, UI
     int height          = frame->lines;
     int srcWidth        = frame->maxWidth;
     int h;
-    void (*core1) (UInt32*, UInt16*, UInt32*, UInt32* , int , int );
-    void (*core2) (UInt32*, UInt16*, UInt32*, UInt32* , int , int );
-#ifndef NO_ASM
-	int hasSSE=0;
-	const int SSEbit=1<<25;
-
-#ifdef __GNUC__
-    __asm__ (
-        "movl   $1,%%eax            \n\t"
-        "cpuid                      \n\t"
-        "andl   $0x2000000,%%edx    \n\t"
-        "movl   %%edx,%0            \n\t"
-        : "=r" (hasSSE) : : "%eax", "%ebx", "%ecx", "%edx"
-    );
-#else
-	__asm {
-		mov eax,1
-		cpuid
-		and edx,SSEbit
-		mov hasSSE,edx
-	}
-#endif
-    
-    hasSSE = 1;
-	core1=hasSSE? copy_2x2_32_core1_SSE: copy_2x2_32_core1;
-	core2=hasSSE? copy_2x2_32_core2_SSE: copy_2x2_32_core2;
-#else
-	core1=copy_2x2_32_core1;
-	core2=copy_2x2_32_core2;
-#endif
 
 	/*rdtsc_start_timer(0);*/
     dstPitch /= (int)sizeof(UInt32);
@@ -2041,10 +2130,16 @@ static void copy_2x2_32(FrameBuffer* frame, void* pDestination, int dstPitch, UI
 
     for (h = 0; h < height; h++) {
 
+        if (isLineClean(h)) {
+            pDst1 += dstPitch * 2;
+            pDst2 += dstPitch * 2;
+            continue;
+        }
+
         if (frame->line[h].doubleWidth) 
-			core1(rgbTable,frame->line[h].buffer,pDst1,pDst2,srcWidth / 4 * 2,dstPitch * 2*4);
+			kernels->copy_2x2_32_core1(rgbTable,frame->line[h].buffer,pDst1,pDst2,srcWidth / 4 * 2,dstPitch * 2*4);
         else 
-			core2(rgbTable,frame->line[h].buffer,pDst1,pDst2,srcWidth / 4,dstPitch * 2*4);
+			kernels->copy_2x2_32_core2(rgbTable,frame->line[h].buffer,pDst1,pDst2,srcWidth / 4,dstPitch * 2*4);
 
         pDst1 += dstPitch * 2;
         pDst2 += dstPitch * 2;
@@ -2070,36 +2165,16 @@ static void copy_2x1_16(FrameBuffer* frame, void* pDestination, int dstPitch, UI
         UInt16* pDst1old = pDst1;
         UInt16* pSrc = frame->line[h].buffer;
 
+        if (isLineClean(h)) {
+            pDst1 += dstPitch;
+            continue;
+        }
+
         if (frame->line[h].doubleWidth) {
-            int width = srcWidth / 4 * 2;
-            while (width--) {
-                pDst1[0] = rgbTable[pSrc[0]];
-                pDst1[1] = rgbTable[pSrc[1]];
-                pDst1[2] = rgbTable[pSrc[2]];
-                pDst1[3] = rgbTable[pSrc[3]];
-                pDst1 += 4;
-                pSrc  += 4;
-            }
+            kernels->copy_1x_16_core(rgbTable, pSrc, pDst1, srcWidth / 4 * 2);
         }
         else {
-            int width = srcWidth / 4;
-            while (width--) {
-                UInt16 col1 = rgbTable[pSrc[0]];
-                UInt16 col2 = rgbTable[pSrc[1]];
-                UInt16 col3 = rgbTable[pSrc[2]];
-                UInt16 col4 = rgbTable[pSrc[3]];
-                pSrc  += 4;
-
-                pDst1[0] = col1;
-                pDst1[1] = col1;
-                pDst1[2] = col2;
-                pDst1[3] = col2;
-                pDst1[4] = col3;
-                pDst1[5] = col3;
-                pDst1[6] = col4;
-                pDst1[7] = col4;
-                pDst1 += 8;
-            }
+            kernels->copy_2x_16_core(rgbTable, pSrc, pDst1, srcWidth / 4);
         }
 
         pDst1 = pDst1old + dstPitch;
@@ -2124,36 +2199,16 @@ static void copy_2x1_32(FrameBuffer* frame, void* pDestination, int dstPitch, UI
         UInt32* pDst1old = pDst1;
         UInt16* pSrc = frame->line[h].buffer;
 
+        if (isLineClean(h)) {
+            pDst1 += dstPitch;
+            continue;
+        }
+
         if (frame->line[h].doubleWidth) {
-            int width = srcWidth / 4 * 2;
-            while (width--) {
-                pDst1[0] = rgbTable[pSrc[0]];
-                pDst1[1] = rgbTable[pSrc[1]];
-                pDst1[2] = rgbTable[pSrc[2]];
-                pDst1[3] = rgbTable[pSrc[3]];
-                pDst1 += 4;
-                pSrc  += 4;
-            }
+            kernels->copy_1x_32_core(rgbTable, pSrc, pDst1, srcWidth / 4 * 2);
         }
         else {
-            int width = srcWidth / 4;
-            while (width--) {
-                UInt32 col1 = rgbTable[pSrc[0]];
-                UInt32 col2 = rgbTable[pSrc[1]];
-                UInt32 col3 = rgbTable[pSrc[2]];
-                UInt32 col4 = rgbTable[pSrc[3]];
-                pSrc  += 4;
-
-                pDst1[0] = col1;
-                pDst1[1] = col1;
-                pDst1[2] = col2;
-                pDst1[3] = col2;
-                pDst1[4] = col3;
-                pDst1[5] = col3;
-                pDst1[6] = col4;
-                pDst1[7] = col4;
-                pDst1 += 8;
-            }
+            kernels->copy_2x_32_core(rgbTable, pSrc, pDst1, srcWidth / 4);
         }
 
         pDst1 = pDst1old + dstPitch;
@@ -2161,8 +2216,194 @@ static void copy_2x1_32(FrameBuffer* frame, void* pDestination, int dstPitch, UI
 }
 
 
+/*****************************************************************************
+**
+** Filter worker pool
+**
+******************************************************************************
+*/
+#define FILTER_MAX_THREADS 8
+
+// Source image and destination of a scaling filter
+typedef struct {
+    void* pSrc;
+    void* pDst;
+    int   width;
+    int   height;
+    int   pixel;
+    int   dstPitch;
+} FilterJob;
+
+typedef void (*FilterBandCb)(FilterJob* job, int first, int last);
+
+// The workers are created with the first video and wait for the next
+// frame until the last video is destroyed. Each thread takes bands of
+// rows until all are done.
+static struct {
+    int          users;
+    void*        lock;
+    void*        runLock;
+    void*        startSem;
+    void*        doneSem;
+    void*        workers[FILTER_MAX_THREADS - 1];
+    int          workerCount;
+    int          quit;
+    FilterBandCb bandCb;
+    FilterJob*   job;
+    int          bandCount;
+    int          nextBand;
+} filterPool;
+
+static void filterRunBands()
+{
+    for (;;) {
+        int band;
+
+        archSemaphoreWait(filterPool.lock, -1);
+        band = filterPool.nextBand++;
+        archSemaphoreSignal(filterPool.lock);
+
+        if (band >= filterPool.bandCount) {
+            return;
+        }
+
+        filterPool.bandCb(filterPool.job, 
+                          filterPool.job->height * band / filterPool.bandCount,
+                          filterPool.job->height * (band + 1) / filterPool.bandCount);
+    }
+}
+
+static void filterWorker()
+{
+    for (;;) {
+        archSemaphoreWait(filterPool.startSem, -1);
+        if (filterPool.quit) {
+            return;
+        }
+        filterRunBands();
+        archSemaphoreSignal(filterPool.doneSem);
+    }
+}
+
+// All workers are created up front, so any thread count set with
+// videoSetFilterThreads() can be served. Idle workers only block.
+static void filterPoolCreate()
+{
+    if (filterPool.users++ > 0) {
+        return;
+    }
+
+    filterPool.lock     = archSemaphoreCreate(1);
+    filterPool.runLock  = archSemaphoreCreate(1);
+    filterPool.startSem = archSemaphoreCreate(0);
+    filterPool.doneSem  = archSemaphoreCreate(0);
+    filterPool.quit     = 0;
+
+    while (filterPool.workerCount < FILTER_MAX_THREADS - 1) {
+        void* thread = archThreadCreate(filterWorker, THREAD_PRIO_NORMAL);
+        if (thread == NULL) {
+            break;
+        }
+        filterPool.workers[filterPool.workerCount++] = thread;
+    }
+}
+
+static void filterPoolDestroy()
+{
+    int i;
+
+    if (--filterPool.users > 0) {
+        return;
+    }
+
+    filterPool.quit = 1;
+    for (i = 0; i < filterPool.workerCount; i++) {
+        archSemaphoreSignal(filterPool.startSem);
+    }
+    for (i = 0; i < filterPool.workerCount; i++) {
+        archThreadJoin(filterPool.workers[i], -1);
+        archThreadDestroy(filterPool.workers[i]);
+    }
+    filterPool.workerCount = 0;
+
+    archSemaphoreDestroy(filterPool.lock);
+    archSemaphoreDestroy(filterPool.runLock);
+    archSemaphoreDestroy(filterPool.startSem);
+    archSemaphoreDestroy(filterPool.doneSem);
+}
+
+// Runs the filter over all rows of the job on the given number of
+// threads, the calling thread included. The filters only read the
+// rows next to a band, so the bands give the same image as one pass.
+static void filterRows(FilterBandCb bandCb, FilterJob* job, int threads)
+{
+    int workers;
+    int i;
+
+    if (threads > FILTER_MAX_THREADS) {
+        threads = FILTER_MAX_THREADS;
+    }
+
+    if (threads <= 1 || job->height < 2 * threads) {
+        bandCb(job, 0, job->height);
+        return;
+    }
+
+    archSemaphoreWait(filterPool.runLock, -1);
+
+    workers = MIN(threads - 1, filterPool.workerCount);
+
+    // Two bands per thread evens out bands that take longer
+    filterPool.bandCb    = bandCb;
+    filterPool.job       = job;
+    filterPool.bandCount = 2 * (workers + 1);
+    filterPool.nextBand  = 0;
+
+    for (i = 0; i < workers; i++) {
+        archSemaphoreSignal(filterPool.startSem);
+    }
+
+    filterRunBands();
+
+    for (i = 0; i < workers; i++) {
+        archSemaphoreWait(filterPool.doneSem, -1);
+    }
+
+    archSemaphoreSignal(filterPool.runLock);
+}
+
+static void hq2xBand(FilterJob* job, int first, int last)
+{
+    hq2x_32_rows(job->pSrc, job->pDst, job->width, job->height, job->dstPitch, first, last);
+}
+
+static void hq3xBand(FilterJob* job, int first, int last)
+{
+    hq3x_32_rows(job->pSrc, job->pDst, job->width, job->height, job->dstPitch, first, last);
+}
+
+static void scale2xBand(FilterJob* job, int first, int last)
+{
+    scale_rows(2, job->pDst, job->dstPitch, job->pSrc, job->width * job->pixel, 
+               job->pixel, job->width, job->height, first, last);
+}
+
+static void filterRun(FilterBandCb bandCb, void* pSrc, void* pDst, int width, int height, 
+                      int pixel, int dstPitch, int threads)
+{
+    FilterJob job;
+
+    job.pSrc     = pSrc;
+    job.pDst     = pDst;
+    job.width    = width;
+    job.height   = height;
+    job.pixel    = pixel;
+    job.dstPitch = dstPitch;
+
+    filterRows(bandCb, &job, threads);
+}
 
-static void hq2x_2x2_32(FrameBuffer* frame, void* pDestination, int dstPitch, UInt16* rgbTable)
+static void hq2x_2x2_32(FrameBuffer* frame, void* pDestination, int dstPitch, UInt16* rgbTable, int threads)
 {
 	UInt16  ImgSrc[320 * 240];
     UInt16* pDst        = (UInt16*)ImgSrc;
@@ -2191,10 +2432,10 @@ static void hq2x_2x2_32(FrameBuffer* frame, void* pDestination, int dstPitch, UI
         }
     }
 
-    hq2x_32(ImgSrc, pDestination, srcWidth, srcHeight, dstPitch);
+    filterRun(hq2xBand, ImgSrc, pDestination, srcWidth, srcHeight, sizeof(UInt16), dstPitch, threads);
 }
 
-static void hq3x_2x2_32(FrameBuffer* frame, void* pDestination, int dstPitch, UInt16* rgbTable)
+static void hq3x_2x2_32(FrameBuffer* frame, void* pDestination, int dstPitch, UInt16* rgbTable, int threads)
 {
 	UInt16  ImgSrc[320 * 240];
     UInt16* pDst        = (UInt16*)ImgSrc;
@@ -2223,10 +2464,10 @@ static void hq3x_2x2_32(FrameBuffer* frame, void* pDestination, int dstPitch, UI
         }
     }
 
-    hq3x_32(ImgSrc, pDestination, srcWidth, srcHeight, dstPitch);
+    filterRun(hq3xBand, ImgSrc, pDestination, srcWidth, srcHeight, sizeof(UInt16), dstPitch, threads);
 }
 
-static void scale2x_2x2_32(FrameBuffer* frame, void* pDestination, int dstPitch, UInt32* rgbTable)
+static void scale2x_2x2_32(FrameBuffer* frame, void* pDestination, int dstPitch, UInt32* rgbTable, int threads)
 {
 	UInt32  ImgSrc[320 * 240];
     UInt32* pDst        = (UInt32*)ImgSrc;
@@ -2255,10 +2496,10 @@ static void scale2x_2x2_32(FrameBuffer* frame, void* pDestination, int dstPitch,
         }
     }
 
-    scale(2, pDestination, dstPitch, ImgSrc, srcWidth * sizeof(UInt32), sizeof(UInt32), srcWidth, srcHeight);
+    filterRun(scale2xBand, ImgSrc, pDestination, srcWidth, srcHeight, sizeof(UInt32), dstPitch, threads);
 }
 
-static void scale2x_2x2_16(FrameBuffer* frame, void* pDestination, int dstPitch, UInt16* rgbTable)
+static void scale2x_2x2_16(FrameBuffer* frame, void* pDestination, int dstPitch, UInt16* rgbTable, int threads)
 {
 	UInt16  ImgSrc[320 * 240];
     UInt16* pDst        = (UInt16*)ImgSrc;
@@ -2287,7 +2528,7 @@ static void scale2x_2x2_16(FrameBuffer* frame, void* pDestination, int dstPitch,
         }
     }
 
-    scale(2, pDestination, dstPitch, ImgSrc, srcWidth * sizeof(UInt16), sizeof(UInt16), srcWidth, srcHeight);
+    filterRun(scale2xBand, ImgSrc, pDestination, srcWidth, srcHeight, sizeof(UInt16), dstPitch, threads);
 }
 
 /*****************************************************************************
@@ -2307,6 +2548,8 @@ Video* videoCreate()
     pVideo->deInterlace = 0;
     pVideo->invertRGB   = 0;
 
+    videoSetFilterThreads(pVideo, 0);
+
     initRGBTable(pVideo);
 
     hq2x_init();
@@ -2316,17 +2559,34 @@ Video* videoCreate()
     pVideo->pRgbTable16 = pRgbTableColor16;
     pVideo->pRgbTable32 = pRgbTableColor32;
 
+    pVideo->renderState = (struct VideoRenderState*)calloc(1, sizeof(struct VideoRenderState));
+    pVideo->renderState->palNoise = 51;
+
+    filterPoolCreate();
+
+    if (kernels == NULL) {
+        videoSetSimd(VIDEO_SIMD_AUTO);
+    }
+
     return pVideo;
 }
 
 void videoDestroy(Video* pVideo) 
 {
+    filterPoolDestroy();
+    free(pVideo->renderState);
     free(pVideo);
 }
 
+static void videoInvalidate(Video* pVideo)
+{
+    pVideo->renderState->valid = 0;
+}
+
 void videoSetDeInterlace(Video* pVideo, int deInterlace)
 {
     pVideo->deInterlace = deInterlace;
+    videoInvalidate(pVideo);
 }
 
 void videoSetBlendFrames(Video* pVideo, int blendFrames)
@@ -2365,11 +2625,13 @@ void videoSetColorMode(Video* pVideo, VideoColorMode colorMode)
         pVideo->pRgbTable32 = pRgbTableColor32;
         break;
     }
+    videoInvalidate(pVideo);
 }
 
 void videoSetPalMode(Video* pVideo, VideoPalMode palMode)
 {
     pVideo->palMode = palMode;
+    videoInvalidate(pVideo);
 }
 
 void videoSetRgbMode(Video* pVideo, int inverted)
@@ -2388,12 +2650,19 @@ void videoSetScanLines(Video* pVideo, int enable, int scanLinesPct)
 {
     pVideo->scanLinesEnable = enable;
     pVideo->scanLinesPct    = scanLinesPct;
+    videoInvalidate(pVideo);
 }
 
 void videoSetColorSaturation(Video* pVideo, int enable, int width)
 {
     pVideo->colorSaturationEnable = enable;
     pVideo->colorSaturationWidth  = width;
+    videoInvalidate(pVideo);
+}
+
+void videoSetFilterThreads(Video* pVideo, int threads)
+{
+    pVideo->filterThreads = threads > 0 ? threads : archThreadGetCpuCount();
 }
 
 void videoUpdateAll(Video* video, Properties* properties) 
@@ -2402,6 +2671,7 @@ void videoUpdateAll(Video* video, Properties* properties)
     videoSetScanLines(video, properties->video.scanlinesEnable, properties->video.scanlinesPct);
     videoSetColorSaturation(video, properties->video.colorSaturationEnable, properties->video.colorSaturationWidth);
     videoSetDeInterlace(video, properties->video.deInterlace);
+    videoSetFilterThreads(video, properties->video.filterThreads);
 
     switch (properties->video.monitorColor) {
     case P_VIDEO_COLOR:
@@ -2518,79 +2788,91 @@ void colorSaturation_16(void* pBuffer, int width, int height, int pitch, int blu
     }
 }
 
-void colorSaturation_32(void* pBuffer, int width, int height, int pitch, int blur)
+void colorSaturation_32_core(UInt32* pBuf, int width, int blur)
 {
-    UInt32* pBuf = (UInt32*)pBuffer;
-    int w, h;
-
-    pitch  /= (int)sizeof(UInt32);
+    UInt32 p0, p1, p2, p3;
+    int w;
 
     switch (blur) {
-    case 0:
-        break;
-
     case 1:
-        for (h = 0; h < height; h++) {
-            UInt32 p0 = pBuf[0] & 0xfefefe;
-            for (w = 1; w < width; w++) {
-                UInt32 p1 = pBuf[w] & 0xfefefe;
-                pBuf[w] = (p0 & 0x00ff00) | (((p0 + p1) / 2) & 0x0000ff) | (p1 & 0xff0000);
-                p0 = p1;
-            }
-            pBuf += pitch;
+        p0 = pBuf[0] & 0xfefefe;
+        for (w = 1; w < width; w++) {
+            p1 = pBuf[w] & 0xfefefe;
+            pBuf[w] = (p0 & 0x00ff00) | (((p0 + p1) / 2) & 0x0000ff) | (p1 & 0xff0000);
+            p0 = p1;
         }
         break;
 
     case 2:
-        for (h = 0; h < height; h++) {
-            UInt32 p0 = pBuf[0];
-            UInt32 p1 = pBuf[1];
-            for (w = 2; w < width; w++) {
-                UInt32 p2 = pBuf[w];
-                pBuf[w] = (p0 & 0x00ff00) | (p1 & 0x0000ff) | (((p1 + p2) / 2) & 0xff0000);
-                p0 = p1;
-                p1 = p2;
-            }
-            pBuf += pitch;
+        p0 = pBuf[0];
+        p1 = pBuf[1];
+        for (w = 2; w < width; w++) {
+            p2 = pBuf[w];
+            pBuf[w] = (p0 & 0x00ff00) | (p1 & 0x0000ff) | (((p1 + p2) / 2) & 0xff0000);
+            p0 = p1;
+            p1 = p2;
         }
         break;
 
     case 3:
-        for (h = 0; h < height; h++) {
-            UInt32 p0 = pBuf[0];
-            UInt32 p1 = pBuf[1];
-            for (w = 2; w < width; w++) {
-                UInt32 p2 = pBuf[w];
-                pBuf[w] = (p0 & 0x00ff00) | (p1 & 0x0000ff) | (p2 & 0xff0000);
-                p0 = p1;
-                p1 = p2;
-            }
-            pBuf += pitch;
+        p0 = pBuf[0];
+        p1 = pBuf[1];
+        for (w = 2; w < width; w++) {
+            p2 = pBuf[w];
+            pBuf[w] = (p0 & 0x00ff00) | (p1 & 0x0000ff) | (p2 & 0xff0000);
+            p0 = p1;
+            p1 = p2;
         }
         break;
 
     case 4:
-        for (h = 0; h < height; h++) {
-            UInt32 p0 = pBuf[0] & 0xfefefe;
-            UInt32 p1 = pBuf[1] & 0xfefefe;
-            UInt32 p2 = pBuf[2] & 0xfefefe;
-            for (w = 3; w < width; w++) {
-                UInt32 p3 = pBuf[w] & 0xfefefe;;
-                pBuf[w] = (((p0 + p1) / 2) & 0x00ff00) | (p2 & 0x0000ff) | (p3 & 0xff0000);
-                p0 = p1;
-                p1 = p2;
-                p2 = p3;
-            }
-            pBuf += pitch;
+        p0 = pBuf[0] & 0xfefefe;
+        p1 = pBuf[1] & 0xfefefe;
+        p2 = pBuf[2] & 0xfefefe;
+        for (w = 3; w < width; w++) {
+            p3 = pBuf[w] & 0xfefefe;
+            pBuf[w] = (((p0 + p1) / 2) & 0x00ff00) | (p2 & 0x0000ff) | (p3 & 0xff0000);
+            p0 = p1;
+            p1 = p2;
+            p2 = p3;
         }
         break;
     }
 }
 
-void scanLines_16(void* pBuffer, int width, int height, int pitch, int scanLinesPct)
+void colorSaturation_32(void* pBuffer, int width, int height, int pitch, int blur)
 {
     UInt32* pBuf = (UInt32*)pBuffer;
-    int w, h;
+    int h;
+
+    pitch  /= (int)sizeof(UInt32);
+
+    if (blur == 0) {
+        return;
+    }
+
+    for (h = 0; h < height; h++) {
+        kernels->colorSaturation_32_core(pBuf, width, blur);
+        pBuf += pitch;
+    }
+}
+
+void scanLines_16_core(UInt32* pBuf, int width, int scanLinesPct)
+{
+    int w;
+
+    for (w = 0; w < width; w++) {
+        UInt32 pixel = pBuf[w];
+        UInt32 a = (((pixel & 0x07e0f81f) * scanLinesPct) & 0xfc1f03e0) >> 5;
+        UInt32 b = (((pixel >> 5) & 0x07c0f83f) * scanLinesPct) & 0xf81f07e0;
+        pBuf[w] = a | b;
+    }
+}
+
+void scanLines_16(void* pBuffer, int width, int height, int pitch, int scanLinesPct)
+{
+    UInt32* pBuf = (UInt32*)pBuffer;
+    int h;
 
     if (scanLinesPct == 100) {
         return;
@@ -2610,12 +2892,7 @@ void scanLines_16(void* pBuffer, int width, int height, int pitch, int scanLines
     }
 
     for (h = 0; h < height; h++) {
-        for (w = 0; w < width; w++) {
-            UInt32 pixel = pBuf[w];
-            UInt32 a = (((pixel & 0x07e0f81f) * scanLinesPct) & 0xfc1f03e0) >> 5;
-            UInt32 b = (((pixel >> 5) & 0x07c0f83f) * scanLinesPct) & 0xf81f07e0;
-            pBuf[w] = a | b;
-        }
+        kernels->scanLines_16_core(pBuf, width, scanLinesPct);
         pBuf += pitch;
     }
 }
@@ -2716,35 +2993,6 @@ void scanLines_32(void* pBuffer, int width, int height, int pitch, int scanLines
 {
     UInt32* pBuf = (UInt32*)pBuffer;
     int h;
-    void (*core) (UInt32* , int , int , int ) ;
-
-#ifndef NO_ASM
-	int hasSSE=0;
-	const int SSEbit=1<<25;
-
-#ifdef __GNUC__
-    __asm__ (
-        "movl   $1,%%eax            \n\t"
-        "cpuid                      \n\t"
-        "andl   $0x2000000,%%edx    \n\t"
-        "movl   %%edx,%0            \n\t"
-        : "=r" (hasSSE) : : "%eax", "%ebx", "%ecx", "%edx"
-    );
-#else
-	__asm {
-		mov eax,1
-		cpuid
-		and edx,SSEbit
-		mov hasSSE,edx
-	}
-#endif
-
-    hasSSE = 1;
-	core=hasSSE? scanLines_32_core_SSE: scanLines_32_core;
-	/*rdtsc_start_timer(0);*/
-#else
-	core=scanLines_32_core;
-#endif
 
     if (scanLinesPct == 100) {
   	    /*rdtsc_end_timer(0);*/
@@ -2765,12 +3013,818 @@ void scanLines_32(void* pBuffer, int width, int height, int pitch, int scanLines
     }
 
     for (h = 0; h < height; h++) {
-		core (pBuf,width,scanLinesPct,pitch*4);
+		kernels->scanLines_32_core(pBuf,width,scanLinesPct,pitch*4);
         pBuf += pitch;
     }
 	/*rdtsc_end_timer(0);*/
 }
 
+/*****************************************************************************
+**
+** Copy and filter kernels
+**
+******************************************************************************
+*/
+void copy_1x_32_core(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst, int width)
+{
+    while (width--) {
+        pDst[0] = rgbTable[pSrc[0]];
+        pDst[1] = rgbTable[pSrc[1]];
+        pDst[2] = rgbTable[pSrc[2]];
+        pDst[3] = rgbTable[pSrc[3]];
+        pSrc += 4;
+        pDst += 4;
+    }
+}
+
+void copy_2x_32_core(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst, int width)
+{
+    while (width--) {
+        UInt32 col1 = rgbTable[pSrc[0]];
+        UInt32 col2 = rgbTable[pSrc[1]];
+        UInt32 col3 = rgbTable[pSrc[2]];
+        UInt32 col4 = rgbTable[pSrc[3]];
+        pSrc  += 4;
+
+        pDst[0] = col1;
+        pDst[1] = col1;
+        pDst[2] = col2;
+        pDst[3] = col2;
+        pDst[4] = col3;
+        pDst[5] = col3;
+        pDst[6] = col4;
+        pDst[7] = col4;
+        pDst += 8;
+    }
+}
+
+void copy_05x_32_core(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst, int width)
+{
+    while (width--) {
+        pDst[0] = (((rgbTable[pSrc[0]] & 0xfefefe) >> 1) + ((rgbTable[pSrc[1]] & 0xfefefe) >> 1)) & 0xfefefe;
+        pDst[1] = (((rgbTable[pSrc[2]] & 0xfefefe) >> 1) + ((rgbTable[pSrc[3]] & 0xfefefe) >> 1)) & 0xfefefe;
+        pDst[2] = (((rgbTable[pSrc[4]] & 0xfefefe) >> 1) + ((rgbTable[pSrc[5]] & 0xfefefe) >> 1)) & 0xfefefe;
+        pDst[3] = (((rgbTable[pSrc[6]] & 0xfefefe) >> 1) + ((rgbTable[pSrc[7]] & 0xfefefe) >> 1)) & 0xfefefe;
+        pSrc += 8;
+        pDst += 4;
+    }
+}
+
+static void copy_1x05_32_core(UInt32* rgbTable, UInt16* pSrc1, UInt16* pSrc2, UInt32* pDst, int srcWidth, int doubleWidth)
+{
+    int width = srcWidth;
+
+    if (doubleWidth) {
+        while (width--) {
+            UInt32 col0 = (((rgbTable[pSrc1[0]] & 0xfcfcfc) >> 2) + ((rgbTable[pSrc1[1]] & 0xfcfcfc) >> 2));
+            UInt32 col1 = (((rgbTable[pSrc2[0]] & 0xfcfcfc) >> 2) + ((rgbTable[pSrc2[1]] & 0xfcfcfc) >> 2));
+            
+            *pDst++ = (col0 + col1) & 0xfcfcfc;
+            pSrc1 += 2;
+            pSrc2 += 2;
+        }
+    }
+    else {
+        while (width--) {
+            *pDst++ = (((rgbTable[pSrc1[0]] & 0xfefefe) >> 1) + ((rgbTable[pSrc2[0]] & 0xfefefe) >> 1)) & 0xfefefe;
+            pSrc1++;
+            pSrc2++;
+        }
+    }
+}
+
+static void copy_1x_16_core(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst, int width)
+{
+    while (width--) {
+        pDst[0] = rgbTable[pSrc[0]];
+        pDst[1] = rgbTable[pSrc[1]];
+        pDst[2] = rgbTable[pSrc[2]];
+        pDst[3] = rgbTable[pSrc[3]];
+        pSrc += 4;
+        pDst += 4;
+    }
+}
+
+static void copy_2x_16_core(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst, int width)
+{
+    while (width--) {
+        UInt16 col1 = rgbTable[pSrc[0]];
+        UInt16 col2 = rgbTable[pSrc[1]];
+        UInt16 col3 = rgbTable[pSrc[2]];
+        UInt16 col4 = rgbTable[pSrc[3]];
+        pSrc  += 4;
+
+        pDst[0] = col1;
+        pDst[1] = col1;
+        pDst[2] = col2;
+        pDst[3] = col2;
+        pDst[4] = col3;
+        pDst[5] = col3;
+        pDst[6] = col4;
+        pDst[7] = col4;
+        pDst += 8;
+    }
+}
+
+static void copy_05x_16_core(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst, int width)
+{
+    while (width--) {
+        pDst[0] = (((rgbTable[pSrc[0]] & 0xe79c) >> 1) + ((rgbTable[pSrc[1]] & 0xe79c) >> 1)) & 0xe79c;
+        pDst[1] = (((rgbTable[pSrc[2]] & 0xe79c) >> 1) + ((rgbTable[pSrc[3]] & 0xe79c) >> 1)) & 0xe79c;
+        pDst[2] = (((rgbTable[pSrc[4]] & 0xe79c) >> 1) + ((rgbTable[pSrc[5]] & 0xe79c) >> 1)) & 0xe79c;
+        pDst[3] = (((rgbTable[pSrc[6]] & 0xe79c) >> 1) + ((rgbTable[pSrc[7]] & 0xe79c) >> 1)) & 0xe79c;
+        pSrc += 8;
+        pDst += 4;
+    }
+}
+
+static void copy_2x2_16_core1(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst1, UInt16* pDst2, int width)
+{
+    while (width--) {
+        UInt16 col1 = rgbTable[pSrc[0]];
+        UInt16 col2 = rgbTable[pSrc[1]];
+        UInt16 col3 = rgbTable[pSrc[2]];
+        UInt16 col4 = rgbTable[pSrc[3]];
+        pSrc  += 4;
+
+        pDst1[0] = col1;
+        pDst1[1] = col2;
+        pDst1[2] = col3;
+        pDst1[3] = col4;
+        pDst1 += 4;
+
+        pDst2[0] = col1;
+        pDst2[1] = col2;
+        pDst2[2] = col3;
+        pDst2[3] = col4;
+        pDst2 += 4;
+    }
+}
+
+static void copy_2x2_16_core2(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst1, UInt16* pDst2, int width)
+{
+    while (width--) {
+        UInt16 col1 = rgbTable[pSrc[0]];
+        UInt16 col2 = rgbTable[pSrc[1]];
+        UInt16 col3 = rgbTable[pSrc[2]];
+        UInt16 col4 = rgbTable[pSrc[3]];
+        pSrc  += 4;
+
+        pDst1[0] = col1;
+        pDst1[1] = col1;
+        pDst1[2] = col2;
+        pDst1[3] = col2;
+        pDst1[4] = col3;
+        pDst1[5] = col3;
+        pDst1[6] = col4;
+        pDst1[7] = col4;
+        pDst1 += 8;
+
+        pDst2[0] = col1;
+        pDst2[1] = col1;
+        pDst2[2] = col2;
+        pDst2[3] = col2;
+        pDst2[4] = col3;
+        pDst2[5] = col3;
+        pDst2[6] = col4;
+        pDst2[7] = col4;
+        pDst2 += 8;
+    }
+}
+
+static void copy_1x05_16_core(UInt16* rgbTable, UInt16* pSrc1, UInt16* pSrc2, UInt16* pDst, int srcWidth, int doubleWidth)
+{
+    int width = srcWidth;
+
+    if (doubleWidth) {
+        while (width--) {
+            UInt16 col0 = (((rgbTable[pSrc1[0]] & 0xe79c) >> 2) + ((rgbTable[pSrc1[1]] & 0xe79c) >> 2));
+            UInt16 col1 = (((rgbTable[pSrc2[0]] & 0xe79c) >> 2) + ((rgbTable[pSrc2[1]] & 0xe79c) >> 2));
+            
+            *pDst++ = (col0 + col1) & 0xe79c;
+            pSrc1 += 2;
+            pSrc2 += 2;
+        }
+    }
+    else {
+        while (width--) {
+            *pDst++ = (((rgbTable[pSrc1[0]] & 0xe79c) >> 1) + ((rgbTable[pSrc2[0]] & 0xe79c) >> 1)) & 0xe79c;
+        }
+    }
+}
+
+// Blurred pixel p[0] of colorSaturation_32_core() from the unfiltered
+// pixels left of it. The vector kernels filter right to left and use
+// it for the pixels left over.
+static UInt32 colorSaturationPixel_32(UInt32* p, int blur)
+{
+    UInt32 p0, p1, p2, p3;
+
+    switch (blur) {
+    case 1:
+        p0 = p[-1] & 0xfefefe;
+        p1 = p[0]  & 0xfefefe;
+        return (p0 & 0x00ff00) | (((p0 + p1) / 2) & 0x0000ff) | (p1 & 0xff0000);
+    case 2:
+        return (p[-2] & 0x00ff00) | (p[-1] & 0x0000ff) | (((p[-1] + p[0]) / 2) & 0xff0000);
+    case 3:
+        return (p[-2] & 0x00ff00) | (p[-1] & 0x0000ff) | (p[0] & 0xff0000);
+    case 4:
+        p0 = p[-3] & 0xfefefe;
+        p1 = p[-2] & 0xfefefe;
+        p2 = p[-1] & 0xfefefe;
+        p3 = p[0]  & 0xfefefe;
+        return (((p0 + p1) / 2) & 0x00ff00) | (p2 & 0x0000ff) | (p3 & 0xff0000);
+    }
+    return p[0];
+}
+
+// First pixel colorSaturation_32_core() changes for a blur width
+static int colorSaturationStart(int blur)
+{
+    return blur == 1 ? 1 : blur == 4 ? 3 : 2;
+}
+
+#ifdef VIDEO_SIMD_KERNELS
+// Colors kept left of the line by the vector PAL kernels for the taps
+#define PAL_LINE_PAD 4
+
+// Filters of the vector PAL kernels, from the colors c[]. The single
+// width (2X) filters make output pixels 2k and 2k + 1 from color k.
+typedef enum {
+    PAL_SHARP,              // c[i-2] + 2 c[i-1] + c[i]
+    PAL_MONITOR,            // 3 c[i-1] + c[i-2] on even and c[i] on odd pixels
+    PAL_MONITOR_RIGHT,      // 3 c[i-1] + c[i]
+    PAL_BLUR,               // five taps from c[i-4] to c[i]
+    PAL_SHARP_2X,           // c[k] + 3 c[k-1], c[k-1] + 3 c[k]
+    PAL_SHARP_2X_CENTER,    // c[k-2] + 3 c[k-1], c[k] + 3 c[k-1]
+    PAL_MONITOR_2X,         // 3 c[k-1] + c[k], 4 c[k]
+    PAL_BLUR_2X             // three taps from c[k-2] to c[k]
+} PalFilter;
+
+#define PAL_FILTER_IS_2X(filter) ((filter) >= PAL_SHARP_2X)
+
+// rnd stepped count times the way the C loops step the noise
+static UInt32 palNoiseStep(UInt32 rnd, int count)
+{
+    UInt32 factor = 23;
+
+    while (count > 0) {
+        if (count & 1) {
+            rnd *= factor;
+        }
+        factor *= factor;
+        count >>= 1;
+    }
+    return rnd;
+}
+
+// The vector PAL kernels take lines of a multiple of eight pixels that
+// fit the color buffer and leave other lines to the C loops
+static int palLineFits(int srcWidth, int doubleWidth)
+{
+    int count = doubleWidth ? 2 * srcWidth : srcWidth;
+    return srcWidth > 0 && (srcWidth & 7) == 0 && count <= FB_MAX_LINE_WIDTH;
+}
+#endif
+
+#ifdef VIDEO_SSE2
+// SSE2 has no 32-bit multiply, so the even and odd lanes are
+// multiplied as 64-bit lanes and put together again
+static __m128i vecMul32_SSE2(__m128i a, __m128i b)
+{
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd  = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, 0x08), _mm_shuffle_epi32(odd, 0x08));
+}
+
+#define SIMD(name)              name##_SSE2
+#define VideoVec                __m128i
+#define vecLoad(p)              _mm_loadu_si128((const __m128i*)(p))
+#define vecStore(p, v)          _mm_storeu_si128((__m128i*)(p), v)
+#define vecSet1_32(x)           _mm_set1_epi32((int)(x))
+#define vecSet1_16(x)           _mm_set1_epi16((short)(x))
+#define vecSet32(a, b, c, d)    _mm_setr_epi32((int)(a), (int)(b), (int)(c), (int)(d))
+#define vecSet16(a, b, c, d, e, f, g, h) \
+    _mm_setr_epi16((short)(a), (short)(b), (short)(c), (short)(d), \
+                   (short)(e), (short)(f), (short)(g), (short)(h))
+#define vecZero()               _mm_setzero_si128()
+#define vecAnd(a, b)            _mm_and_si128(a, b)
+#define vecOr(a, b)             _mm_or_si128(a, b)
+#define vecAdd32(a, b)          _mm_add_epi32(a, b)
+#define vecAdd16(a, b)          _mm_add_epi16(a, b)
+#define vecSrl32(v, n)          _mm_srli_epi32(v, n)
+#define vecSll32(v, n)          _mm_slli_epi32(v, n)
+#define vecSrl16(v, n)          _mm_srli_epi16(v, n)
+#define vecSll16(v, n)          _mm_slli_epi16(v, n)
+#define vecMul32(a, b)          vecMul32_SSE2(a, b)
+#define vecMul16(a, b)          _mm_mullo_epi16(a, b)
+#define vecSelect(m, a, b)      _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b))
+#define vecZipLo32(a, b)        _mm_unpacklo_epi32(a, b)
+#define vecZipHi32(a, b)        _mm_unpackhi_epi32(a, b)
+#define vecZipLo16(a, b)        _mm_unpacklo_epi16(a, b)
+#define vecZipHi16(a, b)        _mm_unpackhi_epi16(a, b)
+#define vecWidenLo8(v)          _mm_unpacklo_epi8(v, _mm_setzero_si128())
+#define vecWidenHi8(v)          _mm_unpackhi_epi8(v, _mm_setzero_si128())
+#define vecNarrow16(lo, hi)     _mm_packus_epi16(lo, hi)
+#define vecPack32(a, b)         _mm_packs_epi32(a, b)
+
+#include "VideoRenderSimd.h"
+#endif
+
+#ifdef VIDEO_NEON
+static uint32x4_t vecSet32_NEON(UInt32 a, UInt32 b, UInt32 c, UInt32 d)
+{
+    UInt32 v[4];
+    v[0] = a; v[1] = b; v[2] = c; v[3] = d;
+    return vld1q_u32(v);
+}
+
+static uint32x4_t vecSet16_NEON(UInt16 a, UInt16 b, UInt16 c, UInt16 d, UInt16 e, UInt16 f, UInt16 g, UInt16 h)
+{
+    UInt16 v[8];
+    v[0] = a; v[1] = b; v[2] = c; v[3] = d;
+    v[4] = e; v[5] = f; v[6] = g; v[7] = h;
+    return vreinterpretq_u32_u16(vld1q_u16(v));
+}
+
+#define NEON_U16(v)             vreinterpretq_u16_u32(v)
+#define NEON_U32(v)             vreinterpretq_u32_u16(v)
+
+#define SIMD(name)              name##_NEON
+#define VideoVec                uint32x4_t
+#define vecLoad(p)              vreinterpretq_u32_u8(vld1q_u8((const UInt8*)(p)))
+#define vecStore(p, v)          vst1q_u8((UInt8*)(p), vreinterpretq_u8_u32(v))
+#define vecSet1_32(x)           vdupq_n_u32((UInt32)(x))
+#define vecSet1_16(x)           NEON_U32(vdupq_n_u16((UInt16)(x)))
+#define vecSet32                vecSet32_NEON
+#define vecSet16                vecSet16_NEON
+#define vecZero()               vdupq_n_u32(0)
+#define vecAnd(a, b)            vandq_u32(a, b)
+#define vecOr(a, b)             vorrq_u32(a, b)
+#define vecAdd32(a, b)          vaddq_u32(a, b)
+#define vecAdd16(a, b)          NEON_U32(vaddq_u16(NEON_U16(a), NEON_U16(b)))
+#define vecSrl32(v, n)          vshlq_u32(v, vdupq_n_s32(-(n)))
+#define vecSll32(v, n)          vshlq_u32(v, vdupq_n_s32(n))
+#define vecSrl16(v, n)          NEON_U32(vshlq_u16(NEON_U16(v), vdupq_n_s16((Int16)-(n))))
+#define vecSll16(v, n)          NEON_U32(vshlq_u16(NEON_U16(v), vdupq_n_s16((Int16)(n))))
+#define vecMul32(a, b)          vmulq_u32(a, b)
+#define vecMul16(a, b)          NEON_U32(vmulq_u16(NEON_U16(a), NEON_U16(b)))
+#define vecSelect(m, a, b)      vbslq_u32(m, a, b)
+#define vecZipLo32(a, b)        vzipq_u32(a, b).val[0]
+#define vecZipHi32(a, b)        vzipq_u32(a, b).val[1]
+#define vecZipLo16(a, b)        NEON_U32(vzipq_u16(NEON_U16(a), NEON_U16(b)).val[0])
+#define vecZipHi16(a, b)        NEON_U32(vzipq_u16(NEON_U16(a), NEON_U16(b)).val[1])
+#define vecWidenLo8(v)          NEON_U32(vmovl_u8(vget_low_u8(vreinterpretq_u8_u32(v))))
+#define vecWidenHi8(v)          NEON_U32(vmovl_u8(vget_high_u8(vreinterpretq_u8_u32(v))))
+#define vecNarrow16(lo, hi)     vreinterpretq_u32_u8(vcombine_u8(vqmovn_u16(NEON_U16(lo)), vqmovn_u16(NEON_U16(hi))))
+#define vecPack32(a, b)         NEON_U32(vcombine_u16(vmovn_u32(a), vmovn_u32(b)))
+
+#include "VideoRenderSimd.h"
+
+#undef NEON_U16
+#undef NEON_U32
+#endif
+
+static const VideoKernels kernelsGeneric = {
+#ifndef NO_ASM
+    copy_2x2_32_core1_SSE,
+    copy_2x2_32_core2_SSE,
+#else
+    copy_2x2_32_core1,
+    copy_2x2_32_core2,
+#endif
+    copy_1x_32_core,
+    copy_2x_32_core,
+    copy_05x_32_core,
+    copy_1x05_32_core,
+    copy_1x_16_core,
+    copy_2x_16_core,
+    copy_05x_16_core,
+    copy_2x2_16_core1,
+    copy_2x2_16_core2,
+    copy_1x05_16_core,
+    scanLines_16_core,
+#ifndef NO_ASM
+    scanLines_32_core_SSE,
+#else
+    scanLines_32_core,
+#endif
+    colorSaturation_32_core,
+    copySharpPAL_2x2_16_core,
+    copySharpPAL_2x2_32_core,
+    copySharpPAL_2x1_16_core,
+    copySharpPAL_2x1_32_core,
+    copyMonitorPAL_2x2_16_core,
+    copyMonitorPAL_2x2_32_core,
+    copyMonitorPAL_2x1_16_core,
+    copyMonitorPAL_2x1_32_core,
+    copyPAL_2x2_32_core,
+    copyPAL_2x1_32_core,
+    copyPAL_1x1_16_core,
+    copyPAL_1x1_32_core,
+    copyPAL_1x05_32_core
+};
+
+#ifdef VIDEO_SSE2
+static const VideoKernels kernelsSSE2 = {
+    copy_2x2_32_core1_SSE2,
+    copy_2x2_32_core2_SSE2,
+    copy_1x_32_core_SSE2,
+    copy_2x_32_core_SSE2,
+    copy_05x_32_core_SSE2,
+    copy_1x05_32_core_SSE2,
+    copy_1x_16_core_SSE2,
+    copy_2x_16_core_SSE2,
+    copy_05x_16_core_SSE2,
+    copy_2x2_16_core1_SSE2,
+    copy_2x2_16_core2_SSE2,
+    copy_1x05_16_core_SSE2,
+    scanLines_16_core_SSE2,
+    scanLines_32_core_SSE2,
+    colorSaturation_32_core_SSE2,
+    copySharpPAL_2x2_16_core_SSE2,
+    copySharpPAL_2x2_32_core_SSE2,
+    copySharpPAL_2x1_16_core_SSE2,
+    copySharpPAL_2x1_32_core_SSE2,
+    copyMonitorPAL_2x2_16_core_SSE2,
+    copyMonitorPAL_2x2_32_core_SSE2,
+    copyMonitorPAL_2x1_16_core_SSE2,
+    copyMonitorPAL_2x1_32_core_SSE2,
+    copyPAL_2x2_32_core_SSE2,
+    copyPAL_2x1_32_core_SSE2,
+    copyPAL_1x1_16_core_SSE2,
+    copyPAL_1x1_32_core_SSE2,
+    copyPAL_1x05_32_core_SSE2
+};
+#endif
+
+#ifdef VIDEO_NEON
+static const VideoKernels kernelsNEON = {
+    copy_2x2_32_core1_NEON,
+    copy_2x2_32_core2_NEON,
+    copy_1x_32_core_NEON,
+    copy_2x_32_core_NEON,
+    copy_05x_32_core_NEON,
+    copy_1x05_32_core_NEON,
+    copy_1x_16_core_NEON,
+    copy_2x_16_core_NEON,
+    copy_05x_16_core_NEON,
+    copy_2x2_16_core1_NEON,
+    copy_2x2_16_core2_NEON,
+    copy_1x05_16_core_NEON,
+    scanLines_16_core_NEON,
+    scanLines_32_core_NEON,
+    colorSaturation_32_core_NEON,
+    copySharpPAL_2x2_16_core_NEON,
+    copySharpPAL_2x2_32_core_NEON,
+    copySharpPAL_2x1_16_core_NEON,
+    copySharpPAL_2x1_32_core_NEON,
+    copyMonitorPAL_2x2_16_core_NEON,
+    copyMonitorPAL_2x2_32_core_NEON,
+    copyMonitorPAL_2x1_16_core_NEON,
+    copyMonitorPAL_2x1_32_core_NEON,
+    copyPAL_2x2_32_core_NEON,
+    copyPAL_2x1_32_core_NEON,
+    copyPAL_1x1_16_core_NEON,
+    copyPAL_1x1_32_core_NEON,
+    copyPAL_1x05_32_core_NEON
+};
+#endif
+
+// Signatures of the kernels, for running them on the test lines
+typedef enum {
+    KERNEL_COPY_2X2_32,
+    KERNEL_COPY_32,
+    KERNEL_COPY_1X05_32,
+    KERNEL_COPY_16,
+    KERNEL_COPY_2X2_16,
+    KERNEL_COPY_1X05_16,
+    KERNEL_SCANLINES_16,
+    KERNEL_SCANLINES_32,
+    KERNEL_SATURATION_32,
+    KERNEL_PAL_2X2_16,
+    KERNEL_PAL_2X2_32,
+    KERNEL_PAL_16,
+    KERNEL_PAL_32,
+    KERNEL_PAL_1X05_32
+} VideoKernelType;
+
+#define KERNEL(name, type) { #name, offsetof(VideoKernels, name), type }
+
+static const struct {
+    const char*     name;
+    size_t          offset;
+    VideoKernelType type;
+} kernelInfo[] = {
+    KERNEL(copy_2x2_32_core1,          KERNEL_COPY_2X2_32),
+    KERNEL(copy_2x2_32_core2,          KERNEL_COPY_2X2_32),
+    KERNEL(copy_1x_32_core,            KERNEL_COPY_32),
+    KERNEL(copy_2x_32_core,            KERNEL_COPY_32),
+    KERNEL(copy_05x_32_core,           KERNEL_COPY_32),
+    KERNEL(copy_1x05_32_core,          KERNEL_COPY_1X05_32),
+    KERNEL(copy_1x_16_core,            KERNEL_COPY_16),
+    KERNEL(copy_2x_16_core,            KERNEL_COPY_16),
+    KERNEL(copy_05x_16_core,           KERNEL_COPY_16),
+    KERNEL(copy_2x2_16_core1,          KERNEL_COPY_2X2_16),
+    KERNEL(copy_2x2_16_core2,          KERNEL_COPY_2X2_16),
+    KERNEL(copy_1x05_16_core,          KERNEL_COPY_1X05_16),
+    KERNEL(scanLines_16_core,          KERNEL_SCANLINES_16),
+    KERNEL(scanLines_32_core,          KERNEL_SCANLINES_32),
+    KERNEL(colorSaturation_32_core,    KERNEL_SATURATION_32),
+    KERNEL(copySharpPAL_2x2_16_core,   KERNEL_PAL_2X2_16),
+    KERNEL(copySharpPAL_2x2_32_core,   KERNEL_PAL_2X2_32),
+    KERNEL(copySharpPAL_2x1_16_core,   KERNEL_PAL_16),
+    KERNEL(copySharpPAL_2x1_32_core,   KERNEL_PAL_32),
+    KERNEL(copyMonitorPAL_2x2_16_core, KERNEL_PAL_2X2_16),
+    KERNEL(copyMonitorPAL_2x2_32_core, KERNEL_PAL_2X2_32),
+    KERNEL(copyMonitorPAL_2x1_16_core, KERNEL_PAL_16),
+    KERNEL(copyMonitorPAL_2x1_32_core, KERNEL_PAL_32),
+    KERNEL(copyPAL_2x2_32_core,        KERNEL_PAL_2X2_32),
+    KERNEL(copyPAL_2x1_32_core,        KERNEL_PAL_32),
+    KERNEL(copyPAL_1x1_16_core,        KERNEL_PAL_16),
+    KERNEL(copyPAL_1x1_32_core,        KERNEL_PAL_32),
+    KERNEL(copyPAL_1x05_32_core,       KERNEL_PAL_1X05_32)
+};
+
+#define KERNEL_COUNT ((int)(sizeof(kernelInfo) / sizeof(kernelInfo[0])))
+
+// Each kernel is timed on a line of KERNEL_TEST_WIDTH pixels at single
+// and double width, with and without noise
+#define KERNEL_TEST_WIDTH  256
+#define KERNEL_TEST_PASSES 4
+#define KERNEL_TEST_REPS   64
+#define KERNEL_TEST_RUNS   3
+
+typedef void (*VideoKernelFn)();
+
+static UInt16 kernelTestSrc[2][2 * KERNEL_TEST_WIDTH];
+static UInt32 kernelTestDst[3][4 * KERNEL_TEST_WIDTH];
+
+static VideoSimd    videoSimd = VIDEO_SIMD_NONE;
+static VideoKernels kernelsAuto;
+static VideoSimd    kernelSimd[KERNEL_COUNT];
+static UInt32       kernelTime[VIDEO_SIMD_AUTO][KERNEL_COUNT];
+static int          kernelsMeasured = 0;
+
+static const VideoKernels* videoGetKernels(VideoSimd simd)
+{
+    switch (simd) {
+    case VIDEO_SIMD_NONE:
+        return &kernelsGeneric;
+#ifdef VIDEO_SSE2
+    case VIDEO_SIMD_SSE2:
+        return &kernelsSSE2;
+#endif
+#ifdef VIDEO_NEON
+    case VIDEO_SIMD_NEON:
+        return &kernelsNEON;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+static void videoRunKernel(const VideoKernels* set, int index, int pass)
+{
+    const char* field = (const char*)set + kernelInfo[index].offset;
+    UInt32* rgb32 = pRgbTableColor32;
+    UInt16* rgb16 = pRgbTableColor16;
+    UInt16* pSrc1 = kernelTestSrc[0];
+    UInt16* pSrc2 = kernelTestSrc[1];
+    UInt32* pDst1 = kernelTestDst[0];
+    UInt32* pDst2 = kernelTestDst[1];
+    UInt32* pDst3 = kernelTestDst[2];
+    int width = KERNEL_TEST_WIDTH;
+    int doubleWidth = pass & 1;
+    UInt32 rnd = (pass & 2) ? 0x2545f491 : 0;
+
+    switch (kernelInfo[index].type) {
+    case KERNEL_COPY_2X2_32:
+        {
+            void (*fn)(UInt32*, UInt16*, UInt32*, UInt32*, int, int);
+            memcpy(&fn, field, sizeof(fn));
+            fn(rgb32, pSrc1, pDst1, pDst2, width / 4, 0);
+        }
+        break;
+    case KERNEL_COPY_32:
+        {
+            void (*fn)(UInt32*, UInt16*, UInt32*, int);
+            memcpy(&fn, field, sizeof(fn));
+            fn(rgb32, pSrc1, pDst1, width / 4);
+        }
+        break;
+    case KERNEL_COPY_1X05_32:
+        {
+            void (*fn)(UInt32*, UInt16*, UInt16*, UInt32*, int, int);
+            memcpy(&fn, field, sizeof(fn));
+            fn(rgb32, pSrc1, pSrc2, pDst1, width, doubleWidth);
+        }
+        break;
+    case KERNEL_COPY_16:
+        {
+            void (*fn)(UInt16*, UInt16*, UInt16*, int);
+            memcpy(&fn, field, sizeof(fn));
+            fn(rgb16, pSrc1, (UInt16*)pDst1, width / 4);
+        }
+        break;
+    case KERNEL_COPY_2X2_16:
+        {
+            void (*fn)(UInt16*, UInt16*, UInt16*, UInt16*, int);
+            memcpy(&fn, field, sizeof(fn));
+            fn(rgb16, pSrc1, (UInt16*)pDst1, (UInt16*)pDst2, width / 4);
+        }
+        break;
+    case KERNEL_COPY_1X05_16:
+        {
+            void (*fn)(UInt16*, UInt16*, UInt16*, UInt16*, int, int);
+            memcpy(&fn, field, sizeof(fn));
+            fn(rgb16, pSrc1, pSrc2, (UInt16*)pDst1, width, doubleWidth);
+        }
+        break;
+    case KERNEL_SCANLINES_16:
+        {
+            void (*fn)(UInt32*, int, int);
+            memcpy(&fn, field, sizeof(fn));
+            fn(pDst1, width, 24);
+        }
+        break;
+    case KERNEL_SCANLINES_32:
+        {
+            void (*fn)(UInt32*, int, int, int);
+            memcpy(&fn, field, sizeof(fn));
+            fn(pDst1, width, 192, 0);
+        }
+        break;
+    case KERNEL_SATURATION_32:
+        {
+            void (*fn)(UInt32*, int, int);
+            memcpy(&fn, field, sizeof(fn));
+            fn(pDst1, width, 1 + pass);
+        }
+        break;
+    case KERNEL_PAL_2X2_16:
+        {
+            UInt32 (*fn)(UInt16*, UInt16*, UInt16*, UInt16*, UInt16*, int, int, UInt32);
+            memcpy(&fn, field, sizeof(fn));
+            fn(rgb16, pSrc1, (UInt16*)pDst1, (UInt16*)pDst2, (UInt16*)pDst3, width, doubleWidth, rnd);
+        }
+        break;
+    case KERNEL_PAL_2X2_32:
+        {
+            UInt32 (*fn)(UInt32*, UInt16*, UInt32*, UInt32*, UInt32*, int, int, UInt32);
+            memcpy(&fn, field, sizeof(fn));
+            fn(rgb32, pSrc1, pDst1, pDst2, pDst3, width, doubleWidth, rnd);
+        }
+        break;
+    case KERNEL_PAL_16:
+        {
+            UInt32 (*fn)(UInt16*, UInt16*, UInt16*, int, int, UInt32);
+            memcpy(&fn, field, sizeof(fn));
+            fn(rgb16, pSrc1, (UInt16*)pDst1, width, doubleWidth, rnd);
+        }
+        break;
+    case KERNEL_PAL_32:
+        {
+            UInt32 (*fn)(UInt32*, UInt16*, UInt32*, int, int, UInt32);
+            memcpy(&fn, field, sizeof(fn));
+            fn(rgb32, pSrc1, pDst1, width, doubleWidth, rnd);
+        }
+        break;
+    case KERNEL_PAL_1X05_32:
+        {
+            UInt32 (*fn)(UInt32*, UInt16*, UInt16*, UInt32*, int, int, UInt32);
+            memcpy(&fn, field, sizeof(fn));
+            fn(rgb32, pSrc1, pSrc2, pDst1, width, doubleWidth, rnd);
+        }
+        break;
+    }
+}
+
+// Microseconds the kernel takes for KERNEL_TEST_REPS runs of each pass
+static UInt32 videoTimeKernel(const VideoKernels* set, int index)
+{
+    UInt32 start = archGetHiresTimer();
+    int i;
+
+    for (i = 0; i < KERNEL_TEST_REPS * KERNEL_TEST_PASSES; i++) {
+        videoRunKernel(set, index, i % KERNEL_TEST_PASSES);
+    }
+    return archGetHiresTimer() - start;
+}
+
+// Times every kernel of every set on the test lines and builds the
+// automatic set from the fastest of each. A vector kernel replaces the
+// C loop only when it measured faster. The runs of the sets alternate
+// so a slow period of the host hits all of them.
+static void videoMeasureKernels()
+{
+    UInt32 seed = 1;
+    int run;
+    int simd;
+    int i;
+
+    if (kernelsMeasured) {
+        return;
+    }
+    kernelsMeasured = 1;
+
+    for (i = 0; i < 2 * KERNEL_TEST_WIDTH; i++) {
+        seed = seed * 1103515245 + 12345;
+        kernelTestSrc[0][i] = (UInt16)((seed >> 16) & RGB_MASK);
+        seed = seed * 1103515245 + 12345;
+        kernelTestSrc[1][i] = (UInt16)((seed >> 16) & RGB_MASK);
+    }
+
+    kernelsAuto = kernelsGeneric;
+
+    for (i = 0; i < KERNEL_COUNT; i++) {
+        VideoSimd best = VIDEO_SIMD_NONE;
+
+        for (run = 0; run < KERNEL_TEST_RUNS; run++) {
+            for (simd = VIDEO_SIMD_NONE; simd < VIDEO_SIMD_AUTO; simd++) {
+                const VideoKernels* set = videoGetKernels((VideoSimd)simd);
+                if (set != NULL) {
+                    UInt32 time = videoTimeKernel(set, i);
+                    if (run == 0 || time < kernelTime[simd][i]) {
+                        kernelTime[simd][i] = time;
+                    }
+                }
+            }
+        }
+
+        for (simd = VIDEO_SIMD_NONE + 1; simd < VIDEO_SIMD_AUTO; simd++) {
+            if (videoGetKernels((VideoSimd)simd) != NULL && kernelTime[simd][i] < kernelTime[best][i]) {
+                best = (VideoSimd)simd;
+            }
+        }
+
+        kernelSimd[i] = best;
+        memcpy((char*)&kernelsAuto + kernelInfo[i].offset,
+               (const char*)videoGetKernels(best) + kernelInfo[i].offset, sizeof(VideoKernelFn));
+    }
+}
+
+int videoIsSimdSupported(VideoSimd simd)
+{
+    return simd == VIDEO_SIMD_AUTO || videoGetKernels(simd) != NULL;
+}
+
+int videoSetSimd(VideoSimd simd)
+{
+    if (!videoIsSimdSupported(simd)) {
+        return 0;
+    }
+
+    if (simd == VIDEO_SIMD_AUTO) {
+        videoMeasureKernels();
+        kernels = &kernelsAuto;
+    }
+    else {
+        kernels = videoGetKernels(simd);
+    }
+    videoSimd = simd;
+
+    return 1;
+}
+
+VideoSimd videoGetSimd()
+{
+    return videoSimd;
+}
+
+int videoGetKernelCount()
+{
+    return KERNEL_COUNT;
+}
+
+const char* videoGetKernelName(int index)
+{
+    return index >= 0 && index < KERNEL_COUNT ? kernelInfo[index].name : NULL;
+}
+
+VideoSimd videoGetKernelSimd(int index)
+{
+    videoMeasureKernels();
+    return index >= 0 && index < KERNEL_COUNT ? kernelSimd[index] : VIDEO_SIMD_NONE;
+}
+
+DoubleT videoGetKernelRate(int index, VideoSimd simd)
+{
+    UInt32 time;
+
+    videoMeasureKernels();
+
+    if (index < 0 || index >= KERNEL_COUNT || !videoIsSimdSupported(simd)) {
+        return 0;
+    }
+    if (simd == VIDEO_SIMD_AUTO) {
+        simd = kernelSimd[index];
+    }
+    time = kernelTime[simd][index];
+    return time > 0 ? (DoubleT)KERNEL_TEST_REPS * KERNEL_TEST_PASSES * KERNEL_TEST_WIDTH / time : 0;
+}
+
 static int videoRender240(Video* pVideo, FrameBuffer* frame, int bitDepth, int zoom, 
                           void* pDst, int dstOffset, int dstPitch, int canChangeZoom)
 {
@@ -2820,7 +3874,7 @@ static int videoRender240(Video* pVideo, FrameBuffer* frame, int bitDepth, int z
 		case VIDEO_PAL_SCALE2X:
             if (zoom==2) {
                 if (frame->line[0].doubleWidth == 0 && frame->interlace == INTERLACE_NONE) {
-                    scale2x_2x2_16(frame, pDst, dstPitch, pVideo->pRgbTable16);
+                    scale2x_2x2_16(frame, pDst, dstPitch, pVideo->pRgbTable16, pVideo->filterThreads);
                 }
                 else {
                     copy_2x2_16(frame, pDst, dstPitch, pVideo->pRgbTable16);
@@ -2874,7 +3928,7 @@ static int videoRender240(Video* pVideo, FrameBuffer* frame, int bitDepth, int z
 		case VIDEO_PAL_SCALE2X:
             if (zoom==2) {
                 if (frame->line[0].doubleWidth == 0 && frame->interlace == INTERLACE_NONE) {
-                    scale2x_2x2_32(frame, pDst, dstPitch, pVideo->pRgbTable32);
+                    scale2x_2x2_32(frame, pDst, dstPitch, pVideo->pRgbTable32, pVideo->filterThreads);
                 }
                 else {
                     copy_2x2_32(frame, pDst, dstPitch, pVideo->pRgbTable32);
@@ -2889,11 +3943,11 @@ static int videoRender240(Video* pVideo, FrameBuffer* frame, int bitDepth, int z
                 if (frame->line[0].doubleWidth == 0 && frame->interlace == INTERLACE_NONE) {
                     if (canChangeZoom > 0) {
                         pDst = (char*)pDst + dstOffset;
-                        hq3x_2x2_32(frame, pDst, dstPitch, pVideo->pRgbTable16);
+                        hq3x_2x2_32(frame, pDst, dstPitch, pVideo->pRgbTable16, pVideo->filterThreads);
                         zoom =3;
                     }
                     else {
-                        hq2x_2x2_32(frame, pDst, dstPitch, pVideo->pRgbTable16);
+                        hq2x_2x2_32(frame, pDst, dstPitch, pVideo->pRgbTable16, pVideo->filterThreads);
                     }
                 }
                 else {
@@ -2982,16 +4036,11 @@ static int videoRender480(Video* pVideo, FrameBuffer* frame, int bitDepth, int z
     return zoom;
 }
 
-int videoRender(Video* pVideo, FrameBuffer* frame, int bitDepth, int zoom, 
-                void* pDst, int dstOffset, int dstPitch, int canChangeZoom)
+static int videoRenderFrame(Video* pVideo, FrameBuffer* frame, int bitDepth, int zoom, 
+                            void* pDst, int dstOffset, int dstPitch, int canChangeZoom)
 {
-    if (frame == NULL) {
-        return zoom;
-    }
-
-    if (frame->interlace != INTERLACE_NONE && pVideo->deInterlace) {
-        frame = frameBufferDeinterlace(frame);
-    }
+    pVideo->renderState->palNoise *= 13;
+    palNoise = pVideo->renderState->palNoise;
 
     if (frame->lines <= 240) {
         zoom = videoRender240(pVideo, frame, bitDepth, zoom, pDst, dstOffset, dstPitch, canChangeZoom);
@@ -3024,4 +4073,183 @@ int videoRender(Video* pVideo, FrameBuffer* frame, int bitDepth, int zoom,
 
     return zoom;
 }
+
+int videoRender(Video* pVideo, FrameBuffer* frame, int bitDepth, int zoom, 
+                void* pDst, int dstOffset, int dstPitch, int canChangeZoom)
+{
+    if (frame == NULL) {
+        return zoom;
+    }
+
+    if (frame->interlace != INTERLACE_NONE && pVideo->deInterlace) {
+        frame = frameBufferDeinterlace(frame);
+    }
+
+    videoInvalidate(pVideo);
+
+    return videoRenderFrame(pVideo, frame, bitDepth, zoom, pDst, dstOffset, dstPitch, canChangeZoom);
+}
+
+// Returns how many source lines around a changed line that are affected
+// by the pal mode, or -1 if the frame changes every time it is drawn.
+static int videoDirtyRadius(Video* pVideo, FrameBuffer* frame)
+{
+    switch (pVideo->palMode) {
+    case VIDEO_PAL_FAST:
+        return 0;
+    case VIDEO_PAL_SCALE2X:
+    case VIDEO_PAL_HQ2X:
+        return 1;
+    case VIDEO_PAL_MONITOR:
+    case VIDEO_PAL_SHARP:
+    case VIDEO_PAL_BLUR:
+        return frame->lines <= 240 ? 1 : -1;
+    default:
+        return -1;
+    }
+}
+
+int videoRenderDirty(Video* pVideo, FrameBuffer* frame, int bitDepth, int zoom,
+                     void* pDst, int dstOffset, int dstPitch, int canChangeZoom,
+                     VideoRect* rects, int maxRects, int* rectCount)
+{
+    struct VideoRenderState* state = pVideo->renderState;
+    UInt8 dirty[FB_MAX_LINES];
+    UInt8 clean[FB_MAX_LINES];
+    int radius;
+    int full;
+    int skip;
+    int resultZoom;
+    int rowsNum;
+    int rowsDen;
+    int height;
+    int y;
+
+    *rectCount = 0;
+
+    if (frame == NULL) {
+        return zoom;
+    }
+
+    if (frame->interlace != INTERLACE_NONE && pVideo->deInterlace) {
+        frame = frameBufferDeinterlace(frame);
+    }
+
+    radius = videoDirtyRadius(pVideo, frame);
+
+    full = radius < 0                                 ||
+           !state->valid                              ||
+           state->pDst            != pDst             ||
+           state->dstOffset       != dstOffset        ||
+           state->dstPitch        != dstPitch         ||
+           state->bitDepth        != bitDepth         ||
+           state->zoom            != zoom             ||
+           state->canChangeZoom   != canChangeZoom    ||
+           state->rgbTableVersion != rgbTableVersion  ||
+           state->lines           != frame->lines     ||
+           state->maxWidth        != frame->maxWidth  ||
+           state->interlace       != frame->interlace ||
+           state->doubleWidth     != frame->line[0].doubleWidth;
+
+    for (y = 0; y < frame->lines; y++) {
+        UInt32 hash = frame->line[y].hash;
+        dirty[y] = full || hash == 0 || hash != state->hash[y];
+        state->hash[y] = hash;
+    }
+
+    if (radius > 0 && !full) {
+        int last = -2 * radius;
+        for (y = 0; y < frame->lines; y++) {
+            if (dirty[y]) {
+                last = y;
+            }
+            clean[y] = y - last > radius;
+        }
+        last = frame->lines + 2 * radius;
+        for (y = frame->lines - 1; y >= 0; y--) {
+            if (dirty[y]) {
+                last = y;
+            }
+            dirty[y] = !clean[y] || last - y <= radius;
+        }
+    }
+
+    // The fast copy methods draw each line on its own, so the lines that
+    // did not change are left as they are. Post filters work in place
+    // and need the whole image redrawn.
+    skip = !full && pVideo->palMode == VIDEO_PAL_FAST && 
+           !pVideo->scanLinesEnable && !pVideo->colorSaturationEnable;
+
+    if (skip) {
+        for (y = 0; y < frame->lines; y++) {
+            clean[y] = !dirty[y];
+        }
+        cleanLines = clean;
+    }
+
+    resultZoom = videoRenderFrame(pVideo, frame, bitDepth, zoom, pDst, dstOffset, dstPitch, canChangeZoom);
+
+    cleanLines = NULL;
+
+    if (!full && resultZoom != state->resultZoom) {
+        if (skip) {
+            resultZoom = videoRenderFrame(pVideo, frame, bitDepth, zoom, pDst, dstOffset, dstPitch, canChangeZoom);
+        }
+        full = 1;
+    }
+
+    state->valid           = 1;
+    state->pDst            = pDst;
+    state->dstOffset       = dstOffset;
+    state->dstPitch        = dstPitch;
+    state->bitDepth        = bitDepth;
+    state->zoom            = zoom;
+    state->canChangeZoom   = canChangeZoom;
+    state->resultZoom      = resultZoom;
+    state->rgbTableVersion = rgbTableVersion;
+    state->lines           = frame->lines;
+    state->maxWidth        = frame->maxWidth;
+    state->interlace       = frame->interlace;
+    state->doubleWidth     = frame->line[0].doubleWidth;
+
+    // Map the changed lines to destination rows. One extra row on each
+    // side covers the offset of odd interlaced frames.
+    height  = 240 * resultZoom;
+    rowsNum = resultZoom;
+    rowsDen = frame->lines <= 240 ? 1 : 2;
+
+    for (y = 0; y < frame->lines && maxRects > 0; y++) {
+        VideoRect* rect;
+        int y0;
+        int y1;
+
+        if (!full && !dirty[y]) {
+            continue;
+        }
+
+        y0 = MAX(0, y * rowsNum / rowsDen - 1);
+        y1 = MIN(height, ((y + 1) * rowsNum + rowsDen - 1) / rowsDen + 1);
+        if (y0 >= y1) {
+            continue;
+        }
+
+        // Extend the last rectangle when it is adjacent or when there
+        // is no room for more
+        if (*rectCount > 0) {
+            rect = rects + *rectCount - 1;
+            if (y0 <= rect->y + rect->height || *rectCount == maxRects) {
+                rect->height = y1 - rect->y;
+                continue;
+            }
+        }
+
+        rect = rects + (*rectCount)++;
+        rect->x      = 0;
+        rect->y      = y0;
+        rect->width  = 320 * resultZoom;
+        rect->height = y1 - y0;
+    }
+
+    return resultZoom;
+}
 #endif
@@ -51,8 +51,27 @@ typedef enum {
     VIDEO_PAL_HQ2X,
 } VideoPalMode;
 
+// Instruction sets the copy and filter kernels can use. The vector sets
+// cover the FAST copies, the PAL, sharp PAL and monitor PAL methods and
+// the scanline and color saturation filters. Scale2x and hq2x are always
+// scalar. VIDEO_SIMD_AUTO times the kernels of each set on the host and
+// uses a vector kernel only where it is faster than the C loop.
+typedef enum {
+    VIDEO_SIMD_NONE,
+    VIDEO_SIMD_SSE2,
+    VIDEO_SIMD_NEON,
+    VIDEO_SIMD_AUTO
+} VideoSimd;
+
 typedef struct Video Video;
 
+typedef struct {
+    int x;
+    int y;
+    int width;
+    int height;
+} VideoRect;
+
 struct Video {
     UInt16* pRgbTable16;
     UInt32* pRgbTable32;
@@ -67,6 +86,8 @@ struct Video {
     DoubleT contrast;
     int deInterlace;
     int invertRGB;
+    int filterThreads;
+    struct VideoRenderState* renderState; // Internal use
 };
 
 Video* videoCreate();
@@ -83,11 +104,38 @@ void videoSetPalMode(Video* video, VideoPalMode palMode);
 
 int videoRender(Video* video, FrameBuffer* frameBuffer, int bitDepth, int zoom, void* pDst, int dstOffset, int dstPitch, int canChangeZoom);
 
+// Renders the frame like videoRender() but only redraws the lines that
+// changed since the last call, and returns the changed area of pDst as
+// up to maxRects rectangles. pDst must hold the image from the last call;
+// everything is redrawn when the destination or the video settings
+// changed in between.
+int videoRenderDirty(Video* video, FrameBuffer* frameBuffer, int bitDepth, int zoom, void* pDst, int dstOffset, int dstPitch, int canChangeZoom,
+                     VideoRect* rects, int maxRects, int* rectCount);
+
 void videoSetColors(Video* video, int saturation, int brightness, int contrast, int gamma);
 
 void videoSetScanLines(Video* video, int enable, int scanLinesPct);
 void videoSetColorSaturation(Video* video, int enable, int width);
 
+// Number of threads the scale2x, hq2x and hq3x filters run on, or 0
+// for one per CPU
+void videoSetFilterThreads(Video* video, int threads);
+
 void videoUpdateAll(Video* video, struct Properties* properties); 
 
+// The kernels are shared by all Video objects. The first videoCreate()
+// selects VIDEO_SIMD_AUTO, videoSetSimd() returns 0 and keeps the
+// current set if the host does not support the one given. All sets
+// render the same image.
+int       videoIsSimdSupported(VideoSimd simd);
+int       videoSetSimd(VideoSimd simd);
+VideoSimd videoGetSimd();
+
+// The kernels VIDEO_SIMD_AUTO chooses from, the set it took for each and
+// the measured throughput in megapixels per second, 0 if not measured
+int         videoGetKernelCount();
+const char* videoGetKernelName(int index);
+VideoSimd   videoGetKernelSimd(int index);
+DoubleT     videoGetKernelRate(int index, VideoSimd simd);
+
 #endif
@@ -0,0 +1,921 @@
+/*****************************************************************************
+** $Source: /cygdrive/d/Private/_SVNROOT/bluemsx/blueMSX/Src/VideoRender/VideoRenderSimd.h,v $
+**
+** $Revision: 1.1 $
+**
+** $Date: 2026-10-18 12:00:00 $
+**
+** More info: http://www.bluemsx.com
+**
+** Copyright (C) 2003-2006 Daniel Vik
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+******************************************************************************
+*/
+
+//
+// Vector copy and filter kernels. VideoRender.c includes this file once
+// for each instruction set, with SIMD() adding the set to the function
+// names and the vec macros mapped to its intrinsics. The macros are
+// undefined at the end of the file. A VideoVec holds four 32-bit or
+// eight 16-bit pixels.
+//
+// The color lookups are scalar. The kernels do the same integer
+// operations as the C loops on whole pixels, so the carries between the
+// color channels and the 16-bit truncations come out the same. Lines
+// that are not a multiple of eight pixels are left to the C loops.
+//
+
+#define vecTimes3_32(v) vecAdd32(v, vecSll32(v, 1))
+#define vecTimes3_16(v) vecAdd16(v, vecSll16(v, 1))
+#define vecTimes6_32(v) vecAdd32(vecSll32(v, 2), vecSll32(v, 1))
+
+/*****************************************************************************
+**
+** Fast copies and filters
+**
+******************************************************************************
+*/
+static void SIMD(copy_2x2_32_core1)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, UInt32* pDst2, int width, int hint)
+{
+    while (width--) {
+        VideoVec col = vecSet32(rgbTable[pSrc[0]], rgbTable[pSrc[1]],
+                                rgbTable[pSrc[2]], rgbTable[pSrc[3]]);
+        vecStore(pDst1, col);
+        vecStore(pDst2, col);
+        pSrc  += 4;
+        pDst1 += 4;
+        pDst2 += 4;
+    }
+}
+
+static void SIMD(copy_2x2_32_core2)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, UInt32* pDst2, int width, int hint)
+{
+    while (width--) {
+        VideoVec col = vecSet32(rgbTable[pSrc[0]], rgbTable[pSrc[1]],
+                                rgbTable[pSrc[2]], rgbTable[pSrc[3]]);
+        VideoVec lo  = vecZipLo32(col, col);
+        VideoVec hi  = vecZipHi32(col, col);
+        vecStore(pDst1, lo);
+        vecStore(pDst1 + 4, hi);
+        vecStore(pDst2, lo);
+        vecStore(pDst2 + 4, hi);
+        pSrc  += 4;
+        pDst1 += 8;
+        pDst2 += 8;
+    }
+}
+
+static void SIMD(copy_1x_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst, int width)
+{
+    while (width--) {
+        VideoVec col = vecSet32(rgbTable[pSrc[0]], rgbTable[pSrc[1]],
+                                rgbTable[pSrc[2]], rgbTable[pSrc[3]]);
+        vecStore(pDst, col);
+        pSrc += 4;
+        pDst += 4;
+    }
+}
+
+static void SIMD(copy_2x_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst, int width)
+{
+    while (width--) {
+        VideoVec col = vecSet32(rgbTable[pSrc[0]], rgbTable[pSrc[1]],
+                                rgbTable[pSrc[2]], rgbTable[pSrc[3]]);
+        vecStore(pDst, vecZipLo32(col, col));
+        vecStore(pDst + 4, vecZipHi32(col, col));
+        pSrc += 4;
+        pDst += 8;
+    }
+}
+
+static void SIMD(copy_05x_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst, int width)
+{
+    VideoVec mask = vecSet1_32(0xfefefe);
+
+    while (width--) {
+        VideoVec even = vecSet32(rgbTable[pSrc[0]], rgbTable[pSrc[2]],
+                                 rgbTable[pSrc[4]], rgbTable[pSrc[6]]);
+        VideoVec odd  = vecSet32(rgbTable[pSrc[1]], rgbTable[pSrc[3]],
+                                 rgbTable[pSrc[5]], rgbTable[pSrc[7]]);
+        even = vecSrl32(vecAnd(even, mask), 1);
+        odd  = vecSrl32(vecAnd(odd,  mask), 1);
+        vecStore(pDst, vecAnd(vecAdd32(even, odd), mask));
+        pSrc += 8;
+        pDst += 4;
+    }
+}
+
+static void SIMD(copy_1x05_32_core)(UInt32* rgbTable, UInt16* pSrc1, UInt16* pSrc2, UInt32* pDst, int srcWidth, int doubleWidth)
+{
+    VideoVec mask4 = vecSet1_32(0xfcfcfc);
+    VideoVec mask2 = vecSet1_32(0xfefefe);
+    int w;
+
+    if (srcWidth & 7) {
+        copy_1x05_32_core(rgbTable, pSrc1, pSrc2, pDst, srcWidth, doubleWidth);
+        return;
+    }
+
+    for (w = 0; w < srcWidth; w += 4) {
+        VideoVec col;
+        if (doubleWidth) {
+            UInt16* p1 = pSrc1 + 2 * w;
+            UInt16* p2 = pSrc2 + 2 * w;
+            VideoVec a0 = vecSet32(rgbTable[p1[0]], rgbTable[p1[2]], rgbTable[p1[4]], rgbTable[p1[6]]);
+            VideoVec a1 = vecSet32(rgbTable[p1[1]], rgbTable[p1[3]], rgbTable[p1[5]], rgbTable[p1[7]]);
+            VideoVec b0 = vecSet32(rgbTable[p2[0]], rgbTable[p2[2]], rgbTable[p2[4]], rgbTable[p2[6]]);
+            VideoVec b1 = vecSet32(rgbTable[p2[1]], rgbTable[p2[3]], rgbTable[p2[5]], rgbTable[p2[7]]);
+            VideoVec col0 = vecAdd32(vecSrl32(vecAnd(a0, mask4), 2), vecSrl32(vecAnd(a1, mask4), 2));
+            VideoVec col1 = vecAdd32(vecSrl32(vecAnd(b0, mask4), 2), vecSrl32(vecAnd(b1, mask4), 2));
+            col = vecAnd(vecAdd32(col0, col1), mask4);
+        }
+        else {
+            UInt16* p1 = pSrc1 + w;
+            UInt16* p2 = pSrc2 + w;
+            VideoVec a = vecSet32(rgbTable[p1[0]], rgbTable[p1[1]], rgbTable[p1[2]], rgbTable[p1[3]]);
+            VideoVec b = vecSet32(rgbTable[p2[0]], rgbTable[p2[1]], rgbTable[p2[2]], rgbTable[p2[3]]);
+            col = vecAnd(vecAdd32(vecSrl32(vecAnd(a, mask2), 1), vecSrl32(vecAnd(b, mask2), 1)), mask2);
+        }
+        vecStore(pDst + w, col);
+    }
+}
+
+static VideoVec SIMD(load_16)(UInt16* rgbTable, UInt16* pSrc)
+{
+    return vecSet16(rgbTable[pSrc[0]], rgbTable[pSrc[1]], rgbTable[pSrc[2]], rgbTable[pSrc[3]],
+                    rgbTable[pSrc[4]], rgbTable[pSrc[5]], rgbTable[pSrc[6]], rgbTable[pSrc[7]]);
+}
+
+// Eight lookups of every other source pixel
+static VideoVec SIMD(loadEven_16)(UInt16* rgbTable, UInt16* pSrc)
+{
+    return vecSet16(rgbTable[pSrc[0]], rgbTable[pSrc[2]], rgbTable[pSrc[4]],  rgbTable[pSrc[6]],
+                    rgbTable[pSrc[8]], rgbTable[pSrc[10]], rgbTable[pSrc[12]], rgbTable[pSrc[14]]);
+}
+
+// The 16-bit copies take the width in groups of four pixels like the
+// 32-bit ones and do two groups at a time
+static void SIMD(copy_1x_16_core)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst, int width)
+{
+    for (; width >= 2; width -= 2) {
+        vecStore(pDst, SIMD(load_16)(rgbTable, pSrc));
+        pSrc += 8;
+        pDst += 8;
+    }
+    copy_1x_16_core(rgbTable, pSrc, pDst, width);
+}
+
+static void SIMD(copy_2x_16_core)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst, int width)
+{
+    for (; width >= 2; width -= 2) {
+        VideoVec col = SIMD(load_16)(rgbTable, pSrc);
+        vecStore(pDst, vecZipLo16(col, col));
+        vecStore(pDst + 8, vecZipHi16(col, col));
+        pSrc += 8;
+        pDst += 16;
+    }
+    copy_2x_16_core(rgbTable, pSrc, pDst, width);
+}
+
+static void SIMD(copy_05x_16_core)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst, int width)
+{
+    VideoVec mask = vecSet1_16(0xe79c);
+
+    for (; width >= 2; width -= 2) {
+        VideoVec even = vecSrl16(vecAnd(SIMD(loadEven_16)(rgbTable, pSrc), mask), 1);
+        VideoVec odd  = vecSrl16(vecAnd(SIMD(loadEven_16)(rgbTable, pSrc + 1), mask), 1);
+        vecStore(pDst, vecAnd(vecAdd16(even, odd), mask));
+        pSrc += 16;
+        pDst += 8;
+    }
+    copy_05x_16_core(rgbTable, pSrc, pDst, width);
+}
+
+static void SIMD(copy_2x2_16_core1)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst1, UInt16* pDst2, int width)
+{
+    for (; width >= 2; width -= 2) {
+        VideoVec col = SIMD(load_16)(rgbTable, pSrc);
+        vecStore(pDst1, col);
+        vecStore(pDst2, col);
+        pSrc  += 8;
+        pDst1 += 8;
+        pDst2 += 8;
+    }
+    copy_2x2_16_core1(rgbTable, pSrc, pDst1, pDst2, width);
+}
+
+static void SIMD(copy_2x2_16_core2)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst1, UInt16* pDst2, int width)
+{
+    for (; width >= 2; width -= 2) {
+        VideoVec col = SIMD(load_16)(rgbTable, pSrc);
+        VideoVec lo  = vecZipLo16(col, col);
+        VideoVec hi  = vecZipHi16(col, col);
+        vecStore(pDst1, lo);
+        vecStore(pDst1 + 8, hi);
+        vecStore(pDst2, lo);
+        vecStore(pDst2 + 8, hi);
+        pSrc  += 8;
+        pDst1 += 16;
+        pDst2 += 16;
+    }
+    copy_2x2_16_core2(rgbTable, pSrc, pDst1, pDst2, width);
+}
+
+static void SIMD(copy_1x05_16_core)(UInt16* rgbTable, UInt16* pSrc1, UInt16* pSrc2, UInt16* pDst, int srcWidth, int doubleWidth)
+{
+    VideoVec mask = vecSet1_16(0xe79c);
+    VideoVec col;
+    int w;
+
+    if (srcWidth & 7) {
+        copy_1x05_16_core(rgbTable, pSrc1, pSrc2, pDst, srcWidth, doubleWidth);
+        return;
+    }
+
+    if (!doubleWidth) {
+        // The C loop repeats the first pixel over the whole line
+        col = vecSet1_16((UInt16)((((rgbTable[pSrc1[0]] & 0xe79c) >> 1) + ((rgbTable[pSrc2[0]] & 0xe79c) >> 1)) & 0xe79c));
+        for (w = 0; w < srcWidth; w += 8) {
+            vecStore(pDst + w, col);
+        }
+        return;
+    }
+
+    for (w = 0; w < srcWidth; w += 8) {
+        VideoVec a0 = vecSrl16(vecAnd(SIMD(loadEven_16)(rgbTable, pSrc1 + 2 * w), mask), 2);
+        VideoVec a1 = vecSrl16(vecAnd(SIMD(loadEven_16)(rgbTable, pSrc1 + 2 * w + 1), mask), 2);
+        VideoVec b0 = vecSrl16(vecAnd(SIMD(loadEven_16)(rgbTable, pSrc2 + 2 * w), mask), 2);
+        VideoVec b1 = vecSrl16(vecAnd(SIMD(loadEven_16)(rgbTable, pSrc2 + 2 * w + 1), mask), 2);
+        col = vecAdd16(vecAdd16(a0, a1), vecAdd16(b0, b1));
+        vecStore(pDst + w, vecAnd(col, mask));
+    }
+}
+
+static void SIMD(scanLines_16_core)(UInt32* pBuf, int width, int scanLinesPct)
+{
+    VideoVec pct   = vecSet1_16(scanLinesPct);
+    VideoVec maskR = vecSet1_16(0xf800);
+    VideoVec maskG = vecSet1_16(0x07e0);
+    VideoVec mask5 = vecSet1_16(0x001f);
+    VideoVec mask6 = vecSet1_16(0x003f);
+    int w;
+
+    // Each channel c becomes c * scanLinesPct / 32, eight pixels at a time
+    for (w = 0; w + 4 <= width; w += 4) {
+        VideoVec p = vecLoad(pBuf + w);
+        VideoVec r = vecMul16(vecSrl16(p, 11), pct);
+        VideoVec g = vecMul16(vecAnd(vecSrl16(p, 5), mask6), pct);
+        VideoVec b = vecMul16(vecAnd(p, mask5), pct);
+        r = vecAnd(vecSll16(r, 6), maskR);
+        g = vecAnd(g, maskG);
+        b = vecSrl16(b, 5);
+        vecStore(pBuf + w, vecOr(vecOr(r, g), b));
+    }
+    scanLines_16_core(pBuf + w, width - w, scanLinesPct);
+}
+
+static void SIMD(scanLines_32_core)(UInt32* pBuf, int width, int scanLinesPct, int hint)
+{
+    VideoVec pct = vecSet1_16(scanLinesPct);
+    int w;
+
+    // Each byte c becomes c * scanLinesPct / 256, four pixels at a time
+    for (w = 0; w + 4 <= width; w += 4) {
+        VideoVec p  = vecLoad(pBuf + w);
+        VideoVec lo = vecSrl16(vecMul16(vecWidenLo8(p), pct), 8);
+        VideoVec hi = vecSrl16(vecMul16(vecWidenHi8(p), pct), 8);
+        vecStore(pBuf + w, vecNarrow16(lo, hi));
+    }
+    scanLines_32_core(pBuf + w, width - w, scanLinesPct, hint);
+}
+
+static void SIMD(colorSaturation_32_core)(UInt32* pBuf, int width, int blur)
+{
+    VideoVec mask  = vecSet1_32(0xfefefe);
+    VideoVec maskR = vecSet1_32(0xff0000);
+    VideoVec maskG = vecSet1_32(0x00ff00);
+    VideoVec maskB = vecSet1_32(0x0000ff);
+    int start = colorSaturationStart(blur);
+    int w = width;
+
+    if (blur < 1 || blur > 4) {
+        return;
+    }
+
+    // Filter right to left so the pixels loaded are not yet changed
+    while (w - 4 >= start) {
+        VideoVec p0, p1, p2, p3, r, g, b;
+        w -= 4;
+        switch (blur) {
+        case 1:
+            p0 = vecAnd(vecLoad(pBuf + w - 1), mask);
+            p1 = vecAnd(vecLoad(pBuf + w), mask);
+            g  = vecAnd(p0, maskG);
+            b  = vecAnd(vecSrl32(vecAdd32(p0, p1), 1), maskB);
+            r  = vecAnd(p1, maskR);
+            break;
+        case 2:
+        case 3:
+            p0 = vecLoad(pBuf + w - 2);
+            p1 = vecLoad(pBuf + w - 1);
+            p2 = vecLoad(pBuf + w);
+            g  = vecAnd(p0, maskG);
+            b  = vecAnd(p1, maskB);
+            r  = blur == 2 ? vecSrl32(vecAdd32(p1, p2), 1) : p2;
+            r  = vecAnd(r, maskR);
+            break;
+        default:
+            p0 = vecAnd(vecLoad(pBuf + w - 3), mask);
+            p1 = vecAnd(vecLoad(pBuf + w - 2), mask);
+            p2 = vecAnd(vecLoad(pBuf + w - 1), mask);
+            p3 = vecAnd(vecLoad(pBuf + w), mask);
+            g  = vecAnd(vecSrl32(vecAdd32(p0, p1), 1), maskG);
+            b  = vecAnd(p2, maskB);
+            r  = vecAnd(p3, maskR);
+            break;
+        }
+        vecStore(pBuf + w, vecOr(vecOr(r, g), b));
+    }
+    while (--w >= start) {
+        pBuf[w] = colorSaturationPixel_32(pBuf + w, blur);
+    }
+}
+
+
+/*****************************************************************************
+**
+** PAL lines
+**
+******************************************************************************
+*/
+// The PAL kernels look up the colors of the line into a buffer first and
+// then filter vectors loaded at the offsets of the taps. The colors left
+// of the line hold the value the C loops start with.
+
+// (rgbTable[pSrc[i]] & mask) >> shift for count pixels
+static void SIMD(palLoad_32)(UInt32* rgbTable, UInt16* pSrc, UInt32* col, int count,
+                             UInt32 mask, int shift, UInt32 first)
+{
+    VideoVec m = vecSet1_32(mask);
+    int i;
+
+    for (i = 1; i <= PAL_LINE_PAD; i++) {
+        col[-i] = first;
+    }
+    for (i = 0; i < count; i += 4) {
+        VideoVec c = vecSet32(rgbTable[pSrc[i]],     rgbTable[pSrc[i + 1]],
+                              rgbTable[pSrc[i + 2]], rgbTable[pSrc[i + 3]]);
+        vecStore(col + i, vecSrl32(vecAnd(c, m), shift));
+    }
+}
+
+// Sums of step neighbouring pixels of one or two lines, each masked and
+// shifted, for the methods that shrink the line
+static void SIMD(palLoadSum_32)(UInt32* rgbTable, UInt16* pSrcA, UInt16* pSrcB, int step, UInt32* col, int count,
+                                UInt32 mask, int shift, UInt32 sumMask, UInt32 first)
+{
+    VideoVec m = vecSet1_32(mask);
+    VideoVec s = vecSet1_32(sumMask);
+    int i;
+    int j;
+
+    for (i = 1; i <= PAL_LINE_PAD; i++) {
+        col[-i] = first;
+    }
+    for (i = 0; i < count; i += 4) {
+        VideoVec sum = vecZero();
+        for (j = 0; j < step; j++) {
+            UInt16* p = pSrcA + step * i + j;
+            VideoVec c = vecSet32(rgbTable[p[0]],        rgbTable[p[step]],
+                                  rgbTable[p[2 * step]], rgbTable[p[3 * step]]);
+            sum = vecAdd32(sum, vecSrl32(vecAnd(c, m), shift));
+            if (pSrcB != NULL) {
+                p = pSrcB + step * i + j;
+                c = vecSet32(rgbTable[p[0]],        rgbTable[p[step]],
+                             rgbTable[p[2 * step]], rgbTable[p[3 * step]]);
+                sum = vecAdd32(sum, vecSrl32(vecAnd(c, m), shift));
+            }
+        }
+        vecStore(col + i, vecAnd(sum, s));
+    }
+}
+
+static void SIMD(palLoad_16)(UInt16* rgbTable, UInt16* pSrc, UInt16* col, int count,
+                             UInt16 mask, int shift, UInt16 first)
+{
+    VideoVec m = vecSet1_16(mask);
+    int i;
+
+    for (i = 1; i <= PAL_LINE_PAD; i++) {
+        col[-i] = first;
+    }
+    for (i = 0; i < count; i += 8) {
+        vecStore(col + i, vecSrl16(vecAnd(SIMD(load_16)(rgbTable, pSrc + i), m), shift));
+    }
+}
+
+// Sums of two neighbouring pixels, each masked and shifted
+static void SIMD(palLoadPairs_16)(UInt16* rgbTable, UInt16* pSrc, UInt16* col, int count,
+                                  UInt16 mask, int shift, UInt16 sumMask, UInt16 first)
+{
+    VideoVec m = vecSet1_16(mask);
+    VideoVec s = vecSet1_16(sumMask);
+    int i;
+
+    for (i = 1; i <= PAL_LINE_PAD; i++) {
+        col[-i] = first;
+    }
+    for (i = 0; i < count; i += 8) {
+        VideoVec even = vecSrl16(vecAnd(SIMD(loadEven_16)(rgbTable, pSrc + 2 * i), m), shift);
+        VideoVec odd  = vecSrl16(vecAnd(SIMD(loadEven_16)(rgbTable, pSrc + 2 * i + 1), m), shift);
+        vecStore(col + i, vecAnd(vecAdd16(even, odd), s));
+    }
+}
+
+// Noise seeds of four pixels, rnd advanced by 0, 0, 1 and 1 steps when
+// two pixels share the noise and by 0 to 3 steps otherwise
+static VideoVec SIMD(palSeeds)(UInt32 rnd, int pairs)
+{
+    if (pairs) {
+        return vecSet32(rnd, rnd, rnd * 23, rnd * 23);
+    }
+    return vecSet32(rnd, rnd * 23, rnd * 23 * 23, rnd * 23 * 23 * 23);
+}
+
+// (rnd >> shift) * 0x10101 of four pixels. The seeds advance by step.
+static VideoVec SIMD(palNoise_32)(VideoVec* rnd, VideoVec step, int shift)
+{
+    VideoVec v = vecSrl32(*rnd, shift);
+    *rnd = vecMul32(*rnd, step);
+    return vecOr(v, vecOr(vecSll32(v, 8), vecSll32(v, 16)));
+}
+
+// (rnd >> 31) * 0x0821 of eight pixels. With a single seed vector each
+// seed is used for two pixels.
+static VideoVec SIMD(palNoise_16)(VideoVec* rnd0, VideoVec* rnd1, VideoVec step)
+{
+    VideoVec v;
+
+    if (rnd1 == NULL) {
+        v = vecPack32(vecSrl32(*rnd0, 31), vecZero());
+        v = vecZipLo16(v, v);
+    }
+    else {
+        v = vecPack32(vecSrl32(*rnd0, 31), vecSrl32(*rnd1, 31));
+        *rnd1 = vecMul32(*rnd1, step);
+    }
+    *rnd0 = vecMul32(*rnd0, step);
+    return vecOr(v, vecOr(vecSll16(v, 5), vecSll16(v, 11)));
+}
+
+// The lower line of a 2x2 pixel gets the color and the noise, the upper
+// line the color blended once or twice with the lower line above it.
+// pDst3 may be pDst1 or pDst2, so pDst2 is stored before pDst3 is read.
+static void SIMD(palStore_2x2_32)(UInt32* pDst1, UInt32* pDst2, UInt32* pDst3,
+                                  VideoVec col, VideoVec noise, int blends)
+{
+    VideoVec mask = vecSet1_32(0x7f7f7f);
+    VideoVec half = vecAnd(vecSrl32(col, 1), mask);
+    VideoVec pix;
+
+    vecStore(pDst2, vecAdd32(col, noise));
+    pix = vecAdd32(vecAnd(vecSrl32(vecLoad(pDst3), 1), mask), half);
+    if (blends == 2) {
+        pix = vecAdd32(vecAnd(vecSrl32(pix, 1), mask), half);
+    }
+    vecStore(pDst1, pix);
+}
+
+// The 16-bit blend masks of some methods differ between even and odd
+// pixels, and the sharp method shifts the odd pixels above by 3
+static void SIMD(palStore_2x2_16)(UInt16* pDst1, UInt16* pDst2, UInt16* pDst3, VideoVec col, VideoVec noise,
+                                  VideoVec mask, int oddShift3, int blends)
+{
+    VideoVec half = vecAnd(vecSrl16(col, 1), mask);
+    VideoVec above;
+    VideoVec pix;
+
+    vecStore(pDst2, vecAdd16(col, noise));
+    above = vecLoad(pDst3);
+    if (oddShift3) {
+        above = vecSelect(vecSet1_32(0xffff), vecSrl16(above, 1), vecSrl16(above, 3));
+    }
+    else {
+        above = vecSrl16(above, 1);
+    }
+    pix = vecAdd16(vecAnd(above, mask), half);
+    if (blends == 2) {
+        pix = vecAdd16(vecAnd(vecSrl16(pix, 1), mask), half);
+    }
+    vecStore(pDst1, pix);
+}
+
+// Filters count output pixels from the colors in col and stores them
+// into pDst1, or into the 2x2 pixels of pDst1 and pDst2 when pDst2 is
+// not NULL. The single width filters make two pixels of each color.
+// Returns rnd advanced once per pixel or per pair of pixels.
+static UInt32 SIMD(palLine_32)(UInt32* col, int count, PalFilter filter, UInt32 outMask,
+                               UInt32* pDst1, UInt32* pDst2, UInt32* pDst3, int blends,
+                               UInt32 rnd, int noiseShift, int pairs)
+{
+    VideoVec mask  = vecSet1_32(outMask);
+    VideoVec even  = vecSet32(0xffffffff, 0, 0xffffffff, 0);
+    VideoVec seeds = SIMD(palSeeds)(rnd, pairs);
+    VideoVec step  = vecSet1_32(palNoiseStep(1, pairs ? 2 : 4));
+    int n = PAL_FILTER_IS_2X(filter) ? 2 : 1;
+    int i;
+    int j;
+
+    for (i = 0; i < count; i += 4 * n) {
+        VideoVec out[2];
+        VideoVec c0, c1, c2, c3, c4;
+
+        if (n == 1) {
+            c0 = vecLoad(col + i - 2);
+            c1 = vecLoad(col + i - 1);
+            c2 = vecLoad(col + i);
+            switch (filter) {
+            case PAL_SHARP:
+                out[0] = vecAdd32(vecAdd32(c0, c2), vecSll32(c1, 1));
+                break;
+            case PAL_MONITOR:
+                out[0] = vecAdd32(vecTimes3_32(c1), vecSelect(even, c0, c2));
+                break;
+            case PAL_MONITOR_RIGHT:
+                out[0] = vecAdd32(c2, vecTimes3_32(c1));
+                break;
+            default:
+                c3 = vecLoad(col + i - 3);
+                c4 = vecLoad(col + i - 4);
+                out[0] = vecAdd32(vecAdd32(c4, c2), vecSll32(c0, 3));
+                out[0] = vecAdd32(out[0], vecSelect(even, vecAdd32(vecSll32(c1, 1), vecSll32(c3, 2)),
+                                                          vecAdd32(vecSll32(c1, 2), vecSll32(c3, 1))));
+                break;
+            }
+        }
+        else {
+            VideoVec p0, p1;
+
+            c0 = vecLoad(col + i / 2 - 2);
+            c1 = vecLoad(col + i / 2 - 1);
+            c2 = vecLoad(col + i / 2);
+            switch (filter) {
+            case PAL_SHARP_2X:
+                p0 = vecAdd32(c2, vecTimes3_32(c1));
+                p1 = vecAdd32(c1, vecTimes3_32(c2));
+                break;
+            case PAL_SHARP_2X_CENTER:
+                p0 = vecAdd32(c0, vecTimes3_32(c1));
+                p1 = vecAdd32(c2, vecTimes3_32(c1));
+                break;
+            case PAL_MONITOR_2X:
+                p0 = vecAdd32(vecTimes3_32(c1), c2);
+                p1 = vecSll32(c2, 2);
+                break;
+            default:
+                c3 = vecSll32(c1, 3);
+                p0 = vecAdd32(vecAdd32(vecTimes6_32(c0), vecSll32(c2, 1)), c3);
+                p1 = vecAdd32(vecAdd32(vecSll32(c0, 1), vecTimes6_32(c2)), c3);
+                break;
+            }
+            out[0] = vecZipLo32(p0, p1);
+            out[1] = vecZipHi32(p0, p1);
+        }
+
+        for (j = 0; j < n; j++) {
+            VideoVec pix   = vecAnd(out[j], mask);
+            VideoVec noise = rnd != 0 ? SIMD(palNoise_32)(&seeds, step, noiseShift) : vecZero();
+            int k = i + 4 * j;
+
+            if (pDst2 != NULL) {
+                SIMD(palStore_2x2_32)(pDst1 + k, pDst2 + k, pDst3 + k, pix, noise, blends);
+            }
+            else {
+                vecStore(pDst1 + k, vecAdd32(pix, noise));
+            }
+        }
+    }
+
+    return palNoiseStep(rnd, pairs ? count / 2 : count);
+}
+
+// 16-bit version of palLine_32(). The noise is always (rnd >> 31) and
+// the 2x2 blends use maskEven and maskOdd on the even and odd pixels.
+static UInt32 SIMD(palLine_16)(UInt16* col, int count, PalFilter filter, UInt16 outMask,
+                               UInt16* pDst1, UInt16* pDst2, UInt16* pDst3, int blends,
+                               UInt16 maskEven, UInt16 maskOdd, int oddShift3,
+                               UInt32 rnd, int pairs)
+{
+    VideoVec mask  = vecSet1_16(outMask);
+    VideoVec even  = vecSet1_32(0xffff);
+    VideoVec blend = vecSelect(even, vecSet1_16(maskEven), vecSet1_16(maskOdd));
+    VideoVec seeds0 = SIMD(palSeeds)(rnd, 0);
+    VideoVec seeds1 = vecMul32(seeds0, vecSet1_32(palNoiseStep(1, 4)));
+    VideoVec step   = vecSet1_32(palNoiseStep(1, pairs ? 4 : 8));
+    int n = PAL_FILTER_IS_2X(filter) ? 2 : 1;
+    int i;
+    int j;
+
+    for (i = 0; i < count; i += 8 * n) {
+        VideoVec out[2];
+        VideoVec c0, c1, c2;
+
+        if (n == 1) {
+            c0 = vecLoad(col + i - 2);
+            c1 = vecLoad(col + i - 1);
+            c2 = vecLoad(col + i);
+            switch (filter) {
+            case PAL_SHARP:
+                out[0] = vecAdd16(vecAdd16(c0, c2), vecSll16(c1, 1));
+                break;
+            case PAL_MONITOR:
+                out[0] = vecAdd16(vecTimes3_16(c1), vecSelect(even, c0, c2));
+                break;
+            default:
+                out[0] = vecAdd16(c2, vecTimes3_16(c1));
+                break;
+            }
+        }
+        else {
+            VideoVec p0, p1;
+
+            c1 = vecLoad(col + i / 2 - 1);
+            c2 = vecLoad(col + i / 2);
+            switch (filter) {
+            case PAL_SHARP_2X:
+                p0 = vecAdd16(c2, vecTimes3_16(c1));
+                p1 = vecAdd16(c1, vecTimes3_16(c2));
+                break;
+            default:
+                p0 = vecAdd16(vecTimes3_16(c1), c2);
+                p1 = vecSll16(c2, 2);
+                break;
+            }
+            out[0] = vecZipLo16(p0, p1);
+            out[1] = vecZipHi16(p0, p1);
+        }
+
+        for (j = 0; j < n; j++) {
+            VideoVec pix   = vecAnd(out[j], mask);
+            VideoVec noise = rnd != 0 ? SIMD(palNoise_16)(&seeds0, pairs ? NULL : &seeds1, step) : vecZero();
+            int k = i + 8 * j;
+
+            if (pDst2 != NULL) {
+                SIMD(palStore_2x2_16)(pDst1 + k, pDst2 + k, pDst3 + k, pix, noise, blend, oddShift3, blends);
+            }
+            else {
+                vecStore(pDst1 + k, vecAdd16(pix, noise));
+            }
+        }
+    }
+
+    return palNoiseStep(rnd, pairs ? count / 2 : count);
+}
+
+static UInt32 SIMD(copySharpPAL_2x2_16_core)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst1, UInt16* pDst2, UInt16* pDst3, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt16 buf[PAL_LINE_PAD + FB_MAX_LINE_WIDTH];
+    UInt16 first = (rgbTable[pSrc[0]] & 0xe79c) >> 2;
+    int count = doubleWidth ? 2 * srcWidth : srcWidth;
+
+    if (!palLineFits(srcWidth, doubleWidth)) {
+        return copySharpPAL_2x2_16_core(rgbTable, pSrc, pDst1, pDst2, pDst3, srcWidth, doubleWidth, rnd);
+    }
+    SIMD(palLoad_16)(rgbTable, pSrc, buf + PAL_LINE_PAD, count, 0xe79c, 2, first);
+    return SIMD(palLine_16)(buf + PAL_LINE_PAD, 2 * srcWidth, doubleWidth ? PAL_SHARP : PAL_SHARP_2X, 0xe79c,
+                            pDst1, pDst2, pDst3, 1, 0x7bef, 0x7bef, doubleWidth, rnd, 1);
+}
+
+static UInt32 SIMD(copySharpPAL_2x2_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, UInt32* pDst2, UInt32* pDst3, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt32 buf[PAL_LINE_PAD + FB_MAX_LINE_WIDTH];
+    UInt32 first = (rgbTable[pSrc[0]] & 0xfcfcfc) >> 2;
+    int count = doubleWidth ? 2 * srcWidth : srcWidth;
+
+    if (!palLineFits(srcWidth, doubleWidth)) {
+        return copySharpPAL_2x2_32_core(rgbTable, pSrc, pDst1, pDst2, pDst3, srcWidth, doubleWidth, rnd);
+    }
+    SIMD(palLoad_32)(rgbTable, pSrc, buf + PAL_LINE_PAD, count, 0xfcfcfc, 2, first);
+    return SIMD(palLine_32)(buf + PAL_LINE_PAD, 2 * srcWidth, doubleWidth ? PAL_SHARP : PAL_SHARP_2X, 0xfcfcfc,
+                            pDst1, pDst2, pDst3, 1, rnd, 29, 1);
+}
+
+static UInt32 SIMD(copySharpPAL_2x1_16_core)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst1, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt16 buf[PAL_LINE_PAD + FB_MAX_LINE_WIDTH];
+    UInt16 first = (rgbTable[pSrc[0]] & 0xe79c) >> 2;
+    int count = doubleWidth ? 2 * srcWidth : srcWidth;
+
+    if (!palLineFits(srcWidth, doubleWidth)) {
+        return copySharpPAL_2x1_16_core(rgbTable, pSrc, pDst1, srcWidth, doubleWidth, rnd);
+    }
+    // The single width line is filtered like a double width one of half
+    // the width
+    SIMD(palLoad_16)(rgbTable, pSrc, buf + PAL_LINE_PAD, count, 0xe79c, 2, first);
+    return SIMD(palLine_16)(buf + PAL_LINE_PAD, count, PAL_SHARP, 0xe79c,
+                            pDst1, NULL, NULL, 0, 0, 0, 0, rnd, 1);
+}
+
+static UInt32 SIMD(copySharpPAL_2x1_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt32 buf[PAL_LINE_PAD + FB_MAX_LINE_WIDTH];
+    UInt32 first = (rgbTable[pSrc[0]] & 0xfcfcfc) >> 2;
+    int count = doubleWidth ? 2 * srcWidth : srcWidth;
+
+    if (!palLineFits(srcWidth, doubleWidth)) {
+        return copySharpPAL_2x1_32_core(rgbTable, pSrc, pDst1, srcWidth, doubleWidth, rnd);
+    }
+    SIMD(palLoad_32)(rgbTable, pSrc, buf + PAL_LINE_PAD, count, 0xfcfcfc, 2, first);
+    return SIMD(palLine_32)(buf + PAL_LINE_PAD, 2 * srcWidth, doubleWidth ? PAL_SHARP : PAL_SHARP_2X_CENTER, 0xfcfcfc,
+                            pDst1, NULL, NULL, 0, rnd, 29, 1);
+}
+
+static UInt32 SIMD(copyMonitorPAL_2x2_16_core)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst1, UInt16* pDst2, UInt16* pDst3, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt16 buf[PAL_LINE_PAD + FB_MAX_LINE_WIDTH];
+    UInt16 first = (rgbTable[pSrc[0]] & 0xe79c) >> 2;
+
+    if (!palLineFits(srcWidth, doubleWidth)) {
+        return copyMonitorPAL_2x2_16_core(rgbTable, pSrc, pDst1, pDst2, pDst3, srcWidth, doubleWidth, rnd);
+    }
+    if (doubleWidth) {
+        SIMD(palLoad_16)(rgbTable, pSrc, buf + PAL_LINE_PAD, 2 * srcWidth, 0xe79c, 2, first);
+        return SIMD(palLine_16)(buf + PAL_LINE_PAD, 2 * srcWidth, PAL_MONITOR, 0xe79c,
+                                pDst1, pDst2, pDst3, 2, 0x7bef, 0x7f7f, 0, rnd, 1);
+    }
+    // The C loop masks the single width colors with the 32-bit mask
+    SIMD(palLoad_16)(rgbTable, pSrc, buf + PAL_LINE_PAD, srcWidth, 0xfcfc, 2, first);
+    return SIMD(palLine_16)(buf + PAL_LINE_PAD, 2 * srcWidth, PAL_MONITOR_2X, 0xfcfc,
+                            pDst1, pDst2, pDst3, 2, 0x7bef, 0x7bef, 0, rnd, 1);
+}
+
+static UInt32 SIMD(copyMonitorPAL_2x2_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, UInt32* pDst2, UInt32* pDst3, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt32 buf[PAL_LINE_PAD + FB_MAX_LINE_WIDTH];
+    UInt32 first = (rgbTable[pSrc[0]] & 0xfcfcfc) >> 2;
+    int count = doubleWidth ? 2 * srcWidth : srcWidth;
+
+    if (!palLineFits(srcWidth, doubleWidth)) {
+        return copyMonitorPAL_2x2_32_core(rgbTable, pSrc, pDst1, pDst2, pDst3, srcWidth, doubleWidth, rnd);
+    }
+    SIMD(palLoad_32)(rgbTable, pSrc, buf + PAL_LINE_PAD, count, 0xfcfcfc, 2, first);
+    return SIMD(palLine_32)(buf + PAL_LINE_PAD, 2 * srcWidth, doubleWidth ? PAL_MONITOR : PAL_MONITOR_2X, 0xfcfcfc,
+                            pDst1, pDst2, pDst3, 2, rnd, 30, 1);
+}
+
+static UInt32 SIMD(copyMonitorPAL_2x1_16_core)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst1, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt16 buf[PAL_LINE_PAD + FB_MAX_LINE_WIDTH];
+    UInt16 first = (rgbTable[pSrc[0]] & 0xe79c) >> 2;
+    int count = doubleWidth ? 2 * srcWidth : srcWidth;
+
+    if (!palLineFits(srcWidth, doubleWidth)) {
+        return copyMonitorPAL_2x1_16_core(rgbTable, pSrc, pDst1, srcWidth, doubleWidth, rnd);
+    }
+    SIMD(palLoad_16)(rgbTable, pSrc, buf + PAL_LINE_PAD, count, 0xe79c, 2, first);
+    return SIMD(palLine_16)(buf + PAL_LINE_PAD, 2 * srcWidth, doubleWidth ? PAL_MONITOR_RIGHT : PAL_MONITOR_2X, 0xe79c,
+                            pDst1, NULL, NULL, 0, 0, 0, 0, rnd, 1);
+}
+
+static UInt32 SIMD(copyMonitorPAL_2x1_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt32 buf[PAL_LINE_PAD + FB_MAX_LINE_WIDTH];
+    UInt32 first = (rgbTable[pSrc[0]] & 0xfcfcfc) >> 2;
+    int count = doubleWidth ? 2 * srcWidth : srcWidth;
+
+    if (!palLineFits(srcWidth, doubleWidth)) {
+        return copyMonitorPAL_2x1_32_core(rgbTable, pSrc, pDst1, srcWidth, doubleWidth, rnd);
+    }
+    SIMD(palLoad_32)(rgbTable, pSrc, buf + PAL_LINE_PAD, count, 0xfcfcfc, 2, first);
+    return SIMD(palLine_32)(buf + PAL_LINE_PAD, 2 * srcWidth, doubleWidth ? PAL_MONITOR_RIGHT : PAL_MONITOR_2X, 0xfcfcfc,
+                            pDst1, NULL, NULL, 0, rnd, 30, 1);
+}
+
+static UInt32 SIMD(copyPAL_2x2_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, UInt32* pDst2, UInt32* pDst3, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt32 buf[PAL_LINE_PAD + FB_MAX_LINE_WIDTH];
+    UInt32 first = (rgbTable[pSrc[0]] & 0xf0f0f0) >> 4;
+    int count = doubleWidth ? 2 * srcWidth : srcWidth;
+
+    if (!palLineFits(srcWidth, doubleWidth)) {
+        return copyPAL_2x2_32_core(rgbTable, pSrc, pDst1, pDst2, pDst3, srcWidth, doubleWidth, rnd);
+    }
+    SIMD(palLoad_32)(rgbTable, pSrc, buf + PAL_LINE_PAD, count, 0xf0f0f0, 4, first);
+    return SIMD(palLine_32)(buf + PAL_LINE_PAD, 2 * srcWidth, doubleWidth ? PAL_BLUR : PAL_BLUR_2X, 0xf0f0f0,
+                            pDst1, pDst2, pDst3, 1, rnd, 29, 1);
+}
+
+static UInt32 SIMD(copyPAL_2x1_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst1, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt32 buf[PAL_LINE_PAD + FB_MAX_LINE_WIDTH];
+    UInt32 first = (rgbTable[pSrc[0]] & 0xf0f0f0) >> 4;
+    int count = doubleWidth ? 2 * srcWidth : srcWidth;
+
+    if (!palLineFits(srcWidth, doubleWidth)) {
+        return copyPAL_2x1_32_core(rgbTable, pSrc, pDst1, srcWidth, doubleWidth, rnd);
+    }
+    SIMD(palLoad_32)(rgbTable, pSrc, buf + PAL_LINE_PAD, count, 0xf0f0f0, 4, first);
+    return SIMD(palLine_32)(buf + PAL_LINE_PAD, 2 * srcWidth, doubleWidth ? PAL_BLUR : PAL_BLUR_2X, 0xf0f0f0,
+                            pDst1, NULL, NULL, 0, rnd, 29, 1);
+}
+
+static UInt32 SIMD(copyPAL_1x1_16_core)(UInt16* rgbTable, UInt16* pSrc, UInt16* pDst, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt16 buf[PAL_LINE_PAD + FB_MAX_LINE_WIDTH];
+    UInt16 first = (rgbTable[pSrc[0]] & 0xe79c) >> 2;
+
+    if (!palLineFits(srcWidth, doubleWidth)) {
+        return copyPAL_1x1_16_core(rgbTable, pSrc, pDst, srcWidth, doubleWidth, rnd);
+    }
+    if (doubleWidth) {
+        SIMD(palLoadPairs_16)(rgbTable, pSrc, buf + PAL_LINE_PAD, srcWidth, 0xc718, 3, 0xe79c, first);
+    }
+    else {
+        SIMD(palLoad_16)(rgbTable, pSrc, buf + PAL_LINE_PAD, srcWidth, 0xe79c, 2, first);
+    }
+    return SIMD(palLine_16)(buf + PAL_LINE_PAD, srcWidth, PAL_SHARP, 0xe79c,
+                            pDst, NULL, NULL, 0, 0, 0, 0, rnd, 0);
+}
+
+static UInt32 SIMD(copyPAL_1x1_32_core)(UInt32* rgbTable, UInt16* pSrc, UInt32* pDst, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt32 buf[PAL_LINE_PAD + FB_MAX_LINE_WIDTH];
+    UInt32 first = (rgbTable[pSrc[0]] & 0xfcfcfc) >> 2;
+
+    if (!palLineFits(srcWidth, doubleWidth)) {
+        return copyPAL_1x1_32_core(rgbTable, pSrc, pDst, srcWidth, doubleWidth, rnd);
+    }
+    if (doubleWidth) {
+        SIMD(palLoadSum_32)(rgbTable, pSrc, NULL, 2, buf + PAL_LINE_PAD, srcWidth, 0xf8f8f8, 3, 0xfcfcfc, first);
+    }
+    else {
+        SIMD(palLoad_32)(rgbTable, pSrc, buf + PAL_LINE_PAD, srcWidth, 0xfcfcfc, 2, first);
+    }
+    return SIMD(palLine_32)(buf + PAL_LINE_PAD, srcWidth, PAL_SHARP, 0xfcfcfc,
+                            pDst, NULL, NULL, 0, rnd, 31, 0);
+}
+
+static UInt32 SIMD(copyPAL_1x05_32_core)(UInt32* rgbTable, UInt16* pSrcA, UInt16* pSrcB, UInt32* pDst, int srcWidth, int doubleWidth, UInt32 rnd)
+{
+    UInt32 buf[PAL_LINE_PAD + FB_MAX_LINE_WIDTH];
+    UInt32 first = (rgbTable[pSrcA[0]] & 0xfcfcfc) >> 2;
+
+    if (!palLineFits(srcWidth, doubleWidth)) {
+        return copyPAL_1x05_32_core(rgbTable, pSrcA, pSrcB, pDst, srcWidth, doubleWidth, rnd);
+    }
+    if (doubleWidth) {
+        SIMD(palLoadSum_32)(rgbTable, pSrcA, pSrcB, 2, buf + PAL_LINE_PAD, srcWidth, 0xf0f0f0, 4, 0xf0f0f0, first);
+    }
+    else {
+        SIMD(palLoadSum_32)(rgbTable, pSrcA, pSrcB, 1, buf + PAL_LINE_PAD, srcWidth, 0xf8f8f8, 3, 0xf8f8f8, first);
+    }
+    return SIMD(palLine_32)(buf + PAL_LINE_PAD, srcWidth, PAL_SHARP, 0xfcfcfc,
+                            pDst, NULL, NULL, 0, rnd, 31, 0);
+}
+
+#undef vecTimes3_32
+#undef vecTimes3_16
+#undef vecTimes6_32
+
+#undef SIMD
+#undef VideoVec
+#undef vecLoad
+#undef vecStore
+#undef vecSet1_32
+#undef vecSet1_16
+#undef vecSet32
+#undef vecSet16
+#undef vecZero
+#undef vecAnd
+#undef vecOr
+#undef vecAdd32
+#undef vecAdd16
+#undef vecSrl32
+#undef vecSll32
+#undef vecSrl16
+#undef vecSll16
+#undef vecMul32
+#undef vecMul16
+#undef vecSelect
+#undef vecZipLo32
+#undef vecZipHi32
+#undef vecZipLo16
+#undef vecZipHi16
+#undef vecWidenLo8
+#undef vecWidenHi8
+#undef vecNarrow16
+#undef vecPack32
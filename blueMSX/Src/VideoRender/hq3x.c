@@ -231,10 +231,10 @@ FIN:
 #pragma warning(disable: 4035)
 #pragma warning(default: 4035)
 
-void hq3x_32(void* pSrc, void* pDest, int Xres, int Yres, int BpL)
+void hq3x_32_rows(void* pSrc, void* pDest, int Xres, int Yres, int BpL, int first, int last)
 {
-    unsigned char* pIn  = (unsigned char*)pSrc;
-    unsigned char* pOut = (unsigned char*)pDest;
+    unsigned char* pIn  = (unsigned char*)pSrc + first * Xres * 2;
+    unsigned char* pOut = (unsigned char*)pDest + first * 3 * BpL;
     int  i, j, k;
     int  prevline, nextline;
     int  w[10];
@@ -251,7 +251,7 @@ void hq3x_32(void* pSrc, void* pDest, int Xres, int Yres, int BpL)
     //   | w7 | w8 | w9 |
     //   +----+----+----+
 
-    for (j=0; j<Yres; j++)
+    for (j=first; j<last; j++)
     {
         char* pOutOrig = pOut;
 
@@ -3952,3 +3952,8 @@ void hq3x_init(void)
 #endif
             }
 }
+
+void hq3x_32(void* pSrc, void* pDest, int Xres, int Yres, int BpL)
+{
+    hq3x_32_rows(pSrc, pDest, Xres, Yres, BpL, 0, Yres);
+}
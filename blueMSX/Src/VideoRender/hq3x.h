@@ -5,5 +5,9 @@ void hq3x_init(void);
 
 void hq3x_32(void* pSrc, void* pDest, int Xres, int Yres, int BpL);
 
+// Scales the source rows first to last - 1 of the image. The other rows
+// are only read, so bands of rows can be scaled in parallel.
+void hq3x_32_rows(void* pSrc, void* pDest, int Xres, int Yres, int BpL, int first, int last);
+
 #endif
 
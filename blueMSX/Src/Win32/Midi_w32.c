@@ -35,6 +35,7 @@
 #include <stdio.h>
 
 #include "SaveState.h"
+#include "Emulator.h"
 
 #define MAXPATHLEN MAX_PATH
 
@@ -391,7 +392,7 @@ static void w32_setHistory(unsigned idx)
 
 void w32_midiOutLoadState(unsigned idx)
 {
-    SaveState* state = saveStateOpenForRead("MidiOut");
+    SaveState* state = saveStateOpenForRead(emulatorGetBoard(), "MidiOut");
     int i;
 
     for (i = 0; i < 256; i++) {
@@ -418,7 +419,7 @@ void w32_midiOutLoadState(unsigned idx)
 
 void w32_midiOutSaveState(unsigned idx)
 {
-    SaveState* state = saveStateOpenForWrite("MidiOut");
+    SaveState* state = saveStateOpenForWrite(emulatorGetBoard(), "MidiOut");
     int i;
 
     for (i = 0; i < 256; i++) {
@@ -43,6 +43,7 @@
 #include "Switches.h"
 #include "AudioMixer.h"
 #include "VideoRender.h"
+#include "VideoPipeline.h"
 #include "CommandLine.h"
 #include "Language.h"   
 #include "resource.h"
@@ -98,8 +99,6 @@
 // PacketFileSystem.h Need to be included after all other includes
 #include "PacketFileSystem.h"
 
-void vdpSetDisplayEnable(int enable);
-
 
 static EmuLanguageType getLangType()
 {
@@ -629,7 +628,7 @@ static void tapeDlgUpdate(HWND hwnd, TapeContent* tc, int tcCount, int showCusto
 
     ListView_DeleteAllItems(hwnd);
 
-    curPos = tapeGetCurrentPos();
+    curPos = tapeGetCurrentPos(emulatorGetBoard());
 
     for (i = 0; i < tcCount; i++) {
         char buffer[64] = {0};
@@ -695,7 +694,7 @@ static BOOL CALLBACK tapePosDlg(HWND hDlg, UINT iMsg, WPARAM wParam, LPARAM lPar
 
             SendMessage(GetDlgItem(hDlg, IDC_SETTAPECUSTOM), BM_SETCHECK, *showCustomFiles ? BST_CHECKED : BST_UNCHECKED, 0);
 
-            tc = tapeGetContent(&tcCount);
+            tc = tapeGetContent(emulatorGetBoard(), &tcCount);
     
             hwnd = GetDlgItem(hDlg, IDC_SETTAPELIST);
 
@@ -777,7 +776,7 @@ static BOOL CALLBACK tapePosDlg(HWND hDlg, UINT iMsg, WPARAM wParam, LPARAM lPar
                 for (i = 0; i < tcCount; i++) {
                     if (*showCustomFiles || tc[i].type != TAPE_CUSTOM) {
                         if (currIndex == index) {
-                            tapeSetCurrentPos(tc[i].pos);
+                            tapeSetCurrentPos(emulatorGetBoard(), tc[i].pos);
                         }
                         index++;
                     }
@@ -802,8 +801,8 @@ void setTapePosition(HWND parent, Properties* pProperties) {
         emulatorSuspend();
     }
     else {
-        tapeSetReadOnly(1);
-        boardChangeCassette(0, strlen(pProperties->media.tapes[0].fileName) ? pProperties->media.tapes[0].fileName : NULL, 
+        tapeSetReadOnly(emulatorGetBoard(), 1);
+        boardChangeCassette(emulatorGetBoard(), 0, strlen(pProperties->media.tapes[0].fileName) ? pProperties->media.tapes[0].fileName : NULL, 
                             strlen(pProperties->media.tapes[0].fileNameInZip) ? pProperties->media.tapes[0].fileNameInZip : NULL);
     }
 
@@ -813,8 +812,8 @@ void setTapePosition(HWND parent, Properties* pProperties) {
         emulatorResume();
     }
     else {
-        boardChangeCassette(0, NULL, NULL);
-        tapeSetReadOnly(pProperties->cassette.readOnly);
+        boardChangeCassette(emulatorGetBoard(), 0, NULL, NULL);
+        tapeSetReadOnly(emulatorGetBoard(), pProperties->cassette.readOnly);
     }
 }
 
@@ -954,7 +953,7 @@ static void checkKeyUp(Shortcuts* s, ShotcutHotkey key)
 #define TIMER_MENUUPDATE                    18
 #define TIMER_CLIP_REGION                   19
 
-void  PatchDiskSetBusy(int driveId, int busy);
+void  PatchDiskSetBusy(BoardContext* board, int driveId, int busy);
 
 void updateMenu(int show);
 
@@ -1132,8 +1131,9 @@ void archShowPropertiesDialog(PropPage  startPane) {
         restart = 1;
     }
 
-    boardSetFdcTimingEnable(pProperties->emulation.enableFdcTiming);
-    boardSetNoSpriteLimits(pProperties->emulation.noSpriteLimits);
+    boardSetFdcTimingEnable(emulatorGetBoard(), pProperties->emulation.enableFdcTiming);
+    boardSetNoSpriteLimits(emulatorGetBoard(), pProperties->emulation.noSpriteLimits);
+    boardSetRunAhead(emulatorGetBoard(), pProperties->emulation.runAhead);
 
     /* Update switches */
     switchSetAudio(pProperties->emulation.audioSwitch);
@@ -1157,23 +1157,23 @@ void archShowPropertiesDialog(PropPage  startPane) {
         oldProp.sound.chip.enableYM2413    != pProperties->sound.chip.enableYM2413 ||
         oldProp.sound.chip.enableMoonsound != pProperties->sound.chip.enableMoonsound)
     {
-        boardSetY8950Enable(pProperties->sound.chip.enableY8950);
-        boardSetYm2413Enable(pProperties->sound.chip.enableYM2413);
-        boardSetMoonsoundEnable(pProperties->sound.chip.enableMoonsound);
+        boardSetY8950Enable(emulatorGetBoard(), pProperties->sound.chip.enableY8950);
+        boardSetYm2413Enable(emulatorGetBoard(), pProperties->sound.chip.enableYM2413);
+        boardSetMoonsoundEnable(emulatorGetBoard(), pProperties->sound.chip.enableMoonsound);
         restart = 1;
     }
 
     if (oldProp.emulation.syncMethod != pProperties->emulation.syncMethod) {
         switch(pProperties->emulation.syncMethod) {
         case P_EMU_SYNCNONE:
-            frameBufferSetFrameCount(1);
+            frameBufferSetFrameCount(emulatorGetBoard(), 1);
             break;
         case P_EMU_SYNCTOVBLANK:
         case P_EMU_SYNCTOVBLANKASYNC:
-            frameBufferSetFrameCount(4);
+            frameBufferSetFrameCount(emulatorGetBoard(), 4);
             break;
         default:
-            frameBufferSetFrameCount(3);
+            frameBufferSetFrameCount(emulatorGetBoard(), 3);
         }
     }
 
@@ -1274,7 +1274,7 @@ void updateMenu(int show) {
          }
     }
 
-    if (boardGetType() != BOARD_MSX) {
+    if (boardGetType(emulatorGetBoard()) != BOARD_MSX) {
         enableSpecial = 0;
     }
 
@@ -1283,7 +1283,7 @@ void updateMenu(int show) {
                emuState == EMU_RUNNING, 
                emuState == EMU_STOPPED, 
                mixerIsLogging(st.mixer),
-               boardCaptureIsRecording() ? 1 : boardCaptureIsPlaying() ? 2 : 0,
+               boardCaptureIsRecording(emulatorGetBoard()) ? 1 : boardCaptureIsPlaying(emulatorGetBoard()) ? 2 : 0,
                fileExist(pProperties->filehistory.quicksave, NULL),
                enableSpecial);
 
@@ -1636,6 +1636,17 @@ void archUpdateWindow() {
 
 
 
+// Called on the render thread when an image is ready
+static void onImageReady()
+{
+    if (pProperties->video.driver == P_VIDEO_DRVGDI) {
+        PostMessage(getMainHwnd(), WM_UPDATE, 0, 0);
+    }
+    else {
+        SetEvent(st.ddrawEvent);
+    }
+}
+
 static void emuWindowDraw(int onlyOnVblank)
 {      
     static void* lock = NULL;
@@ -1703,33 +1714,31 @@ void* createScreenShot(int large, int* bitmapSize, int png)
     int zoom = large ? 2 : 1;
 
     DWORD* bmBitsDst = malloc(zoom * zoom * WIDTH * HEIGHT * sizeof(UInt32));
-    VideoPalMode palMode      = st.pVideo->palMode;
-    int scanLinesEnable       = st.pVideo->scanLinesEnable;
-    int colorSaturationEnable = st.pVideo->colorSaturationEnable;
+    Video* video;
     
-    FrameBuffer* frameBuffer = frameBufferGetViewFrame();
+    FrameBuffer* frameBuffer = frameBufferGetViewFrame(emulatorGetBoard());
 
     if (frameBuffer == NULL || frameBuffer->maxWidth <= 0 || frameBuffer->lines <= 0) {
         return NULL;
     }
 
-    st.pVideo->palMode = VIDEO_PAL_FAST;
-    st.pVideo->scanLinesEnable = 0;
-    st.pVideo->colorSaturationEnable = 0;
+    // The render thread uses st.pVideo, so the screenshot is rendered
+    // with its own video without pal filter, scanlines or saturation
+    video = videoCreate();
+    videoSetColors(video, pProperties->video.saturation, pProperties->video.brightness, 
+                   pProperties->video.contrast, pProperties->video.gamma);
 
     if (png) {
-        videoRender(st.pVideo, frameBufferGetViewFrame(), 32, zoom, 
+        videoRender(video, frameBuffer, 32, zoom, 
                     bmBitsDst, 0, zoom * WIDTH * sizeof(DWORD), 0);
     }
     else {
-        videoRender(st.pVideo, frameBufferGetViewFrame(), 32, zoom, 
+        videoRender(video, frameBuffer, 32, zoom, 
                     bmBitsDst + (zoom * HEIGHT - 1) * zoom * WIDTH, 
                     0, -1 * zoom * WIDTH * sizeof(DWORD), 0);
     }
 
-    st.pVideo->palMode               = palMode;
-    st.pVideo->scanLinesEnable       = scanLinesEnable;
-    st.pVideo->colorSaturationEnable = colorSaturationEnable;
+    videoDestroy(video);
 
     if (bitmapSize != NULL) {
         bitmap = ScreenShot2(bmBitsDst, 320 * zoom, frameBuffer->maxWidth * zoom, 240 * zoom, bitmapSize, png);
@@ -1780,8 +1789,7 @@ static LRESULT CALLBACK emuWndProc(HWND hwnd, UINT iMsg, WPARAM wParam, LPARAM l
         if (pProperties->video.driver == P_VIDEO_DRVGDI && emulatorGetState() != EMU_STOPPED) 
 		{
             PAINTSTRUCT ps;
-            FrameBuffer* frameBuffer;
-            int borderWidth;
+            VideoImage* image;
             HDC hdc;   
             int zoom = getZoom();
 
@@ -1789,32 +1797,22 @@ static LRESULT CALLBACK emuWndProc(HWND hwnd, UINT iMsg, WPARAM wParam, LPARAM l
                 st.bmBitsGDI = malloc(4096 * 4096 * sizeof(UInt32));
             }
 
-            frameBuffer = frameBufferGetViewFrame();
-            if (frameBuffer == NULL) {
-                frameBuffer = frameBufferGetWhiteNoiseFrame();
-            }
-        
-			// clear borders
-            borderWidth = (320 - frameBuffer->maxWidth) * zoom / 2;
+            // The frame is flipped and rendered by the render pipeline.
+            // The bitmap keeps the last image until an image in the new
+            // format is rendered.
+            videoPipelineSetFormat(32, zoom);
 
-            if (borderWidth > 0) {
-                DWORD* ptr  = st.bmBitsGDI;
+            image = videoPipelineGetLatest();
+            if (image != NULL && image->bitDepth == 32 && image->zoom == zoom) {
                 int y;
-                for (y = 0; y < zoom * HEIGHT; y++) {
-                    memset(ptr, 0, borderWidth * sizeof(DWORD));
-                    ptr += zoom * WIDTH;
-                    memset(ptr - borderWidth, 0, borderWidth * sizeof(DWORD));
+
+                // The bitmap is bottom up
+                for (y = 0; y < image->height; y++) {
+                    memcpy((char*)st.bmBitsGDI + (image->height - 1 - y) * image->pitch, 
+                           (char*)image->pixels + y * image->pitch, image->pitch);
                 }
             }
 
-			// render image
-            videoRender(st.pVideo, 
-						frameBuffer, 
-						32, 
-						zoom, 
-                        (char*)st.bmBitsGDI + borderWidth * sizeof(DWORD) + (zoom * HEIGHT - 1) * zoom * WIDTH * sizeof(DWORD), 
-                        0, -1 * zoom * WIDTH * sizeof(DWORD), 0);
-
 			// Beginpaint moved because it's only needed to output the framebuffer
 			hdc = BeginPaint ( hwnd, &ps );
 
@@ -1961,7 +1959,7 @@ static LRESULT CALLBACK wndProc(HWND hwnd, UINT iMsg, WPARAM wParam, LPARAM lPar
     case WM_SYSCOMMAND:
         switch(wParam) {
         case SC_MAXIMIZE:
-            vdpSetDisplayEnable(1);
+            boardSetDisplayEnable(emulatorGetBoard(), 1);
             st.minimized = 0;
             if (pProperties->video.windowSize != P_VIDEO_SIZEFULLSCREEN) {
                 pProperties->video.windowSize = P_VIDEO_SIZEFULLSCREEN;
@@ -1969,12 +1967,12 @@ static LRESULT CALLBACK wndProc(HWND hwnd, UINT iMsg, WPARAM wParam, LPARAM lPar
             }
             return 0;
         case SC_MINIMIZE:
-            vdpSetDisplayEnable(0);
+            boardSetDisplayEnable(emulatorGetBoard(), 0);
             st.minimized = 1;
 //            emulatorSuspend();
             break;
         case SC_RESTORE:
-            vdpSetDisplayEnable(1);
+            boardSetDisplayEnable(emulatorGetBoard(), 1);
             st.minimized = 0;
 //            emulatorResume();
             break;
@@ -2190,8 +2188,8 @@ static LRESULT CALLBACK wndProc(HWND hwnd, UINT iMsg, WPARAM wParam, LPARAM lPar
                 themePageUpdate(st.themePageActive, hdc);
                 ReleaseDC(hwnd, hdc);
 
-                PatchDiskSetBusy(0, 0);
-                PatchDiskSetBusy(1, 0);
+                PatchDiskSetBusy(emulatorGetBoard(), 0, 0);
+                PatchDiskSetBusy(emulatorGetBoard(), 1, 0);
                 ledSetCas(0);
 
             }
@@ -2299,7 +2297,6 @@ static LRESULT CALLBACK wndProc(HWND hwnd, UINT iMsg, WPARAM wParam, LPARAM lPar
         return 0;
 
     case WM_UPDATE:
-        frameBufferFlipViewFrame(0);
         InvalidateRect(st.emuHwnd, NULL, TRUE);
         return 0;
 
@@ -2723,14 +2720,14 @@ WINAPI WinMain(HINSTANCE hInst, HINSTANCE hPrevInst, PSTR szLine, int iShow)
 
     switch(pProperties->emulation.syncMethod) {
     case P_EMU_SYNCNONE:
-        frameBufferSetFrameCount(1);
+        frameBufferSetFrameCount(emulatorGetBoard(), 1);
         break;
     case P_EMU_SYNCTOVBLANK:
     case P_EMU_SYNCTOVBLANKASYNC:
-        frameBufferSetFrameCount(4);
+        frameBufferSetFrameCount(emulatorGetBoard(), 4);
         break;
     default:
-        frameBufferSetFrameCount(3);
+        frameBufferSetFrameCount(emulatorGetBoard(), 3);
     }
 
     midiInitialize();
@@ -2764,6 +2761,9 @@ WINAPI WinMain(HINSTANCE hInst, HINSTANCE hPrevInst, PSTR szLine, int iShow)
     videoSetColorSaturation(st.pVideo, pProperties->video.colorSaturationEnable, pProperties->video.colorSaturationWidth);
     videoSetBlendFrames(st.pVideo, pProperties->video.blendFrames);
 
+    // Frames are rendered on their own thread and drawn by this one
+    videoPipelineStart(emulatorGetBoard(), st.pVideo, 1, onImageReady);
+
     DirectDrawSetDisplayMode(pProperties->video.fullscreen.width,
                              pProperties->video.fullscreen.height,
                              pProperties->video.fullscreen.bitDepth);
@@ -2773,7 +2773,7 @@ WINAPI WinMain(HINSTANCE hInst, HINSTANCE hPrevInst, PSTR szLine, int iShow)
     emulatorInit(pProperties, st.mixer);
     actionInit(st.pVideo, pProperties, st.mixer);
     langInit();
-    tapeSetReadOnly(pProperties->cassette.readOnly);
+    tapeSetReadOnly(emulatorGetBoard(), pProperties->cassette.readOnly);
     
     ethIfInitialize(pProperties);
     cdromInitialize();
@@ -2901,16 +2901,17 @@ WINAPI WinMain(HINSTANCE hInst, HINSTANCE hPrevInst, PSTR szLine, int iShow)
     {
         Machine* machine = machineCreate(pProperties->emulation.machineName);
         if (machine != NULL) {
-            boardSetMachine(machine);
+            boardSetMachine(emulatorGetBoard(), machine);
             machineDestroy(machine);
         }
     }
-    boardSetFdcTimingEnable(pProperties->emulation.enableFdcTiming);
-    boardSetNoSpriteLimits(pProperties->emulation.noSpriteLimits);
-    boardSetY8950Enable(pProperties->sound.chip.enableY8950);
-    boardSetYm2413Enable(pProperties->sound.chip.enableYM2413);
-    boardSetMoonsoundEnable(pProperties->sound.chip.enableMoonsound);
-    boardSetVideoAutodetect(pProperties->video.detectActiveMonitor);
+    boardSetFdcTimingEnable(emulatorGetBoard(), pProperties->emulation.enableFdcTiming);
+    boardSetNoSpriteLimits(emulatorGetBoard(), pProperties->emulation.noSpriteLimits);
+    boardSetRunAhead(emulatorGetBoard(), pProperties->emulation.runAhead);
+    boardSetY8950Enable(emulatorGetBoard(), pProperties->sound.chip.enableY8950);
+    boardSetYm2413Enable(emulatorGetBoard(), pProperties->sound.chip.enableYM2413);
+    boardSetMoonsoundEnable(emulatorGetBoard(), pProperties->sound.chip.enableMoonsound);
+    boardSetVideoAutodetect(emulatorGetBoard(), pProperties->video.detectActiveMonitor);
 
     updateMenu(0);
 
@@ -2950,6 +2951,7 @@ WINAPI WinMain(HINSTANCE hInst, HINSTANCE hPrevInst, PSTR szLine, int iShow)
     }
 
     emulatorExit();
+    videoPipelineStop();
     sprintf(pProperties->keyboard.configFile, keyboardGetCurrentConfig());
     shortcutsDestroyProfile(st.shortcuts);
     videoDestroy(st.pVideo);
@@ -3594,14 +3596,28 @@ void archEmulationStopNotification()
 }
 
 int archUpdateEmuDisplay(int syncMode) {
+    int useD3D = pProperties->video.driver == P_VIDEO_DRVDIRECTX_D3D;
+    int waitDisplay = syncMode > 1 && syncMode != 4;
+
     st.diplayUpdateOnVblank = syncMode == 4;
-    if (pProperties->video.driver == P_VIDEO_DRVGDI) {
-        if (syncMode == 0) {
-            PostMessage(getMainHwnd(), WM_UPDATE, 0, 0);
+
+    // Direct3D scales the frame itself and flips it when it draws. The
+    // other drivers show the images of the render pipeline, which calls
+    // onImageReady() when the frame is rendered.
+    if (!useD3D) {
+        videoPipelinePublish(syncMode >= 3, waitDisplay);
+        if (waitDisplay) {
+            videoPipelineFlush();
         }
     }
+
+    if (pProperties->video.driver == P_VIDEO_DRVGDI) {
+        return 0;
+    }
     else if (syncMode == 4) { // VBlank async
-        SetEvent(st.ddrawEvent);
+        if (useD3D) {
+            SetEvent(st.ddrawEvent);
+        }
     }
     else if (syncMode == 3) { // VBlank sync
         st.diplaySync = 1;
@@ -3609,7 +3625,9 @@ int archUpdateEmuDisplay(int syncMode) {
         return st.diplayUpdated;
     }
     else {
-        SetEvent(st.ddrawEvent);
+        if (useD3D) {
+            SetEvent(st.ddrawEvent);
+        }
         if (syncMode > 1) {
             WaitForSingleObject(st.ddrawAckEvent, 500);
             return st.diplayUpdated;
@@ -3738,7 +3756,7 @@ static int LoadMemory(const char* fileName, UInt16 address)
     if (file != NULL) {
         UInt8 data;
         while (address <= 0xffff && (fread(&data, 1, 1, file) == 1)) {
-            slotWrite(NULL, address, data);
+            slotWrite(emulatorGetBoard(), address, data);
             address++;
         }
         fclose(file);
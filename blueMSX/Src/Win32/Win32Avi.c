@@ -271,7 +271,7 @@ void aviVideoCallback(void* dummy, UInt32 time)
     int borderWidth;
     int displayPitch = width * bitDepth / 8;
 
-    frameBuffer = frameBufferFlipViewFrame(1);
+    frameBuffer = frameBufferFlipViewFrame(emulatorGetBoard(), 1);
     if (frameBuffer == NULL) {
         frameBuffer = frameBufferGetWhiteNoiseFrame();
     }
@@ -353,7 +353,7 @@ char* aviGetFilename(Properties* properties)
 static char* progressText()
 {
     static char text[128];
-    int amount = boardCaptureCompleteAmount();
+    int amount = boardCaptureCompleteAmount(emulatorGetBoard());
 
     sprintf(text, "%s %d.%d%%", langDlgAmountCompleted(), amount / 10, amount % 10);
 
@@ -375,7 +375,7 @@ static BOOL CALLBACK statusDlgProc(HWND hDlg, UINT iMsg, WPARAM wParam, LPARAM l
 
     case WM_TIMER:
         SendDlgItemMessage(hDlg, IDC_VIDEOPROGRESSTEXT, WM_SETTEXT, 0, (LPARAM)progressText());
-        if (!boardCaptureIsPlaying()) {
+        if (!boardCaptureIsPlaying(emulatorGetBoard())) {
             EndDialog(hDlg, TRUE);
         }
         return FALSE;
@@ -415,11 +415,11 @@ void aviStartRender(HWND hwndOwner, Properties* prop, Video* vid)
         return;
     }
 
-    boardSetPeriodicCallback(aviVideoCallback, NULL, properties->video.captureFps);
+    boardSetPeriodicCallback(emulatorGetBoard(), aviVideoCallback, NULL, properties->video.captureFps);
     properties->emulation.syncMethod = P_EMU_SYNCIGNORE;
-    mixerSetBoardFrequencyFixed(3579545);
+    mixerSetBoardFrequencyFixed(mixerGetGlobalMixer(), 3579545);
     actionEmuSpeedSet(100);
-    frameBufferSetFrameCount(4);
+    frameBufferSetFrameCount(emulatorGetBoard(), 4);
 
     soundDriverConfig(hwnd, SOUND_DRV_AVI);
     emulatorRestartSound();
@@ -453,20 +453,20 @@ void aviStopRender()
     properties->emulation.syncMethod = syncMethod;
     switch(properties->emulation.syncMethod) {
     case P_EMU_SYNCNONE:
-        frameBufferSetFrameCount(1);
+        frameBufferSetFrameCount(emulatorGetBoard(), 1);
         break;
     case P_EMU_SYNCTOVBLANK:
     case P_EMU_SYNCTOVBLANKASYNC:
-        frameBufferSetFrameCount(4);
+        frameBufferSetFrameCount(emulatorGetBoard(), 4);
         break;
     default:
-        frameBufferSetFrameCount(3);
+        frameBufferSetFrameCount(emulatorGetBoard(), 3);
     }
 
     // Restore emu speed
-    mixerSetBoardFrequencyFixed(0);
+    mixerSetBoardFrequencyFixed(mixerGetGlobalMixer(), 0);
     actionEmuSpeedSet(emuSpeed);
 
     // Remove board timer
-    boardSetPeriodicCallback(NULL, NULL, 0);
+    boardSetPeriodicCallback(emulatorGetBoard(), NULL, NULL, 0);
 }
@@ -11,6 +11,8 @@
 
 #include "Win32D3D.h"
 #include "FrameBuffer.h"
+#include "Emulator.h"
+#include "VDP.h"
 #include "AppConfig.h"
 
 const float C_fNTSCAspectRatio = 1.151f;	
@@ -394,7 +396,7 @@ int D3DUpdateSurface(HWND hWnd, Video* pVideo, int syncVblank, D3DProperties * d
 			/***********************************/
 			FrameBuffer* frameBuffer;
 
-			frameBuffer = frameBufferFlipViewFrame(syncVblank);
+			frameBuffer = frameBufferFlipViewFrame(emulatorGetBoard(), syncVblank);
 
 			if (frameBuffer == NULL)
 				frameBuffer = frameBufferGetWhiteNoiseFrame();
@@ -497,7 +499,7 @@ int D3DUpdateSurface(HWND hWnd, Video* pVideo, int syncVblank, D3DProperties * d
 				break;
 
 			case P_D3D_AR_AUTO:
-				fAR = (vdpGetRefreshRate() == 60) ?  C_fNTSCAspectRatio : C_fPALAspectRatio;
+				fAR = (vdpGetRefreshRate(emulatorGetBoard()) == 60) ?  C_fNTSCAspectRatio : C_fPALAspectRatio;
 				break;
 
 			case P_D3D_AR_STRETCH:
@@ -33,6 +33,7 @@
 #include "Resource.h"
 #include "Language.h"
 #include "Board.h"
+#include "Emulator.h"
 #include "ArchMenu.h"
 #include "Actions.h"
 #include "Casette.h"
@@ -404,7 +405,7 @@ static HMENU menuCreateVideoConnect(Properties* pProperties, Shortcuts* shortcut
     char langBuffer[560];
     HMENU hMenu = CreatePopupMenu();
 
-    int count = videoManagerGetCount();
+    int count = videoManagerGetCount(emulatorGetBoard());
     int i;
 
     setMenuColor(hMenu);
@@ -415,8 +416,8 @@ static HMENU menuCreateVideoConnect(Properties* pProperties, Shortcuts* shortcut
     }
 
     for (i = 0; i < count; i++) {
-        sprintf(langBuffer, "%s        ", videoManagerGetName(i));
-        AppendMenu(hMenu, MF_STRING | (videoManagerIsActive(i) ? MFS_CHECKED : 0), ID_VIDEO_CONNECTORS + i, langBuffer);
+        sprintf(langBuffer, "%s        ", videoManagerGetName(emulatorGetBoard(), i));
+        AppendMenu(hMenu, MF_STRING | (videoManagerIsActive(emulatorGetBoard(), i) ? MFS_CHECKED : 0), ID_VIDEO_CONNECTORS + i, langBuffer);
     }
     
     AppendMenu(hMenu, MF_SEPARATOR, 0, NULL);
@@ -710,7 +711,7 @@ static HMENU menuCreateVideoCapture(Properties* pProperties, Shortcuts* shortcut
     AppendMenu(hMenu, MF_SEPARATOR, 0, NULL);
 
     sprintf(langBuffer, "%s      \t%hs", langMenuVideoRender(), shortcutsToString(shortcuts->videoCapSave));
-    AppendMenu(hMenu, MF_STRING | (boardCaptureHasData() ? 0 : MF_GRAYED), ID_FILE_VIDEOCAPSAVE, langBuffer);
+    AppendMenu(hMenu, MF_STRING | (boardCaptureHasData(emulatorGetBoard()) ? 0 : MF_GRAYED), ID_FILE_VIDEOCAPSAVE, langBuffer);
     
     return hMenu;
 }
@@ -815,7 +816,7 @@ static HMENU menuCreateHarddisk(Properties* pProperties, Shortcuts* shortcuts)
     setMenuColor(hMenu);
 
     for (i = 0; i < MAX_HD_COUNT; i++) {
-        switch (boardGetHdType(i)) {
+        switch (boardGetHdType(emulatorGetBoard(), i)) {
         case HD_SUNRISEIDE:
             hasHd = 1;
             sprintf(langBuffer, "IDE%d  - Sunrise Primary", i);
@@ -855,7 +856,7 @@ static HMENU menuCreateHarddisk(Properties* pProperties, Shortcuts* shortcuts)
         case HD_WAVESCSI:
             hasHd = 1;
             for (j = 0; j < 8; j++) {
-                sprintf(langBuffer, "SCSI%d %s-SCSI #%d", i, (boardGetHdType(i) == HD_MEGASCSI) ? "MEGA" : "WAVE", j);
+                sprintf(langBuffer, "SCSI%d %s-SCSI #%d", i, (boardGetHdType(emulatorGetBoard(), i) == HD_MEGASCSI) ? "MEGA" : "WAVE", j);
 #if 1  // CD_UPDATE: Don't grey out id #6
                 AppendMenu(hMenu, MF_POPUP, (UINT)menuCreateIdeHd(diskGetHdDriveId(i, j), pProperties, shortcuts, 1), langBuffer);
 #else
@@ -1812,7 +1813,7 @@ int menuCommand(Properties* pProperties, int command)
         // Parse Tape Menu Items
         h = command - ID_FILE_TAPE_HISTORY;
         if (h >= 0 && h < MAX_HISTORY) {
-            if (pProperties->cassette.rewindAfterInsert) tapeRewindNextInsert();
+            if (pProperties->cassette.rewindAfterInsert) tapeRewindNextInsert(emulatorGetBoard());
             insertCassette(pProperties, 0, pProperties->filehistory.cassette[0][h], NULL, 0);
             return 1;
         }
@@ -1882,11 +1883,11 @@ int menuCommand(Properties* pProperties, int command)
     
     i = command - ID_VIDEO_CONNECTORS;
     if (i >= 0 && i < 16) {
-        if (videoManagerGetActive() == i) {
-            videoManagerSetActive(-1);
+        if (videoManagerGetActive(emulatorGetBoard()) == i) {
+            videoManagerSetActive(emulatorGetBoard(), -1);
         }
         else {
-            videoManagerSetActive(i);
+            videoManagerSetActive(emulatorGetBoard(), i);
         }
         return 1;
     }
@@ -1928,7 +1929,7 @@ int menuCommand(Properties* pProperties, int command)
         return 1;
     case ID_VIDEO_AUTODETECT:
         pProperties->video.detectActiveMonitor = !pProperties->video.detectActiveMonitor;
-        boardSetVideoAutodetect(pProperties->video.detectActiveMonitor);
+        boardSetVideoAutodetect(emulatorGetBoard(), pProperties->video.detectActiveMonitor);
         return 1;
     case ID_FILE_PTRSCR:                    actionScreenCapture();          return 0;
     case ID_FILE_SAVE:                      actionSaveState();              return 0;
@@ -30,6 +30,7 @@
 #include "MsxTypes.h"
 #include "ArchMidi.h"
 #include "SaveState.h"
+#include "Emulator.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -272,7 +273,7 @@ void archMidiUpdateVolume(int left, int right)
 
 void archMidiLoadState(void)
 {
-    SaveState* state = saveStateOpenForRead("ArchMidi");
+    SaveState* state = saveStateOpenForRead(emulatorGetBoard(), "ArchMidi");
     char buf[64];
     int i;
 
@@ -312,7 +313,7 @@ void archMidiLoadState(void)
 
 void archMidiSaveState(void)
 {
-    SaveState* state = saveStateOpenForWrite("ArchMidi");
+    SaveState* state = saveStateOpenForWrite(emulatorGetBoard(), "ArchMidi");
     char buf[64];
     int i;
 
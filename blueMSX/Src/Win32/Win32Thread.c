@@ -29,9 +29,14 @@
 #include <windows.h>
 
 void* archThreadCreate(void (*entryPoint)(), int priority)
+{
+    return archThreadCreateEx(entryPoint, priority, 0);
+}
+
+void* archThreadCreateEx(void (*entryPoint)(), int priority, int stacksize)
 {
     DWORD id;
-    HANDLE h = CreateThread(NULL, 0, (LPTHREAD_START_ROUTINE)entryPoint, NULL, 0, &id);
+    HANDLE h = CreateThread(NULL, stacksize, (LPTHREAD_START_ROUTINE)entryPoint, NULL, 0, &id);
     if (priority == THREAD_PRIO_HIGH) {
         SetThreadPriority(h, THREAD_PRIORITY_ABOVE_NORMAL);
     }
@@ -56,4 +61,48 @@ void archThreadJoin(void* thread, int timeout)
 void archThreadSleep(int milliseconds) 
 {
     Sleep(milliseconds);
+}
+
+int archThreadGetCpuCount()
+{
+    SYSTEM_INFO info;
+
+    GetSystemInfo(&info);
+
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+}
+
+int archAtomicGet(volatile int* value)
+{
+    return InterlockedExchangeAdd((LONG*)value, 0);
+}
+
+void archAtomicSet(volatile int* value, int newValue)
+{
+    InterlockedExchange((LONG*)value, newValue);
+}
+
+int archAtomicExchange(volatile int* value, int newValue)
+{
+    return InterlockedExchange((LONG*)value, newValue);
+}
+
+int archAtomicCompareExchange(volatile int* value, int oldValue, int newValue)
+{
+    return InterlockedCompareExchange((LONG*)value, newValue, oldValue);
+}
+
+void archThreadOnce(volatile int* once, void (*init)())
+{
+    if (archAtomicGet(once) == 2) {
+        return;
+    }
+    if (archAtomicCompareExchange(once, 0, 1) == 0) {
+        init();
+        archAtomicSet(once, 2);
+        return;
+    }
+    while (archAtomicGet(once) != 2) {
+        archThreadSleep(1);
+    }
 }
\ No newline at end of file
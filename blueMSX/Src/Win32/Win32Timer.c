@@ -48,10 +48,24 @@ static void syncCallback() {
     }
 }
 
+// Counts microseconds and wraps around, only the difference between
+// two values is meaningful.
 UInt32 archGetHiresTimer() {
     LARGE_INTEGER li;
+
+    if (!uptime_hfFrequency) {
+        if (QueryPerformanceFrequency(&li)) {
+            uptime_hfFrequency = li.QuadPart;
+        }
+        else {
+            return 0;
+        }
+    }
+
     QueryPerformanceCounter(&li);
-    return li.LowPart;
+
+    return (UInt32)(li.QuadPart / uptime_hfFrequency * 1000000 + 
+                    li.QuadPart % uptime_hfFrequency * 1000000 / uptime_hfFrequency);
 }
 
 UInt32 archGetSystemUpTime(UInt32 frequency)
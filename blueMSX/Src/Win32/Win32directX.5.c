@@ -37,6 +37,7 @@
 #include "Win32directx.h"
 #include "VideoRender.h"
 #include "FrameBuffer.h"
+#include "Emulator.h"
 #include "AppConfig.h"
 
 
@@ -681,7 +682,7 @@ int DirectXUpdateSurface(Video* pVideo,
 
     surfaceBuffer = ddsd.lpSurface;
 
-    frameBuffer = frameBufferFlipViewFrame(syncVblank);
+    frameBuffer = frameBufferFlipViewFrame(emulatorGetBoard(), syncVblank);
     if (frameBuffer == NULL) {
         frameBuffer = frameBufferGetWhiteNoiseFrame();
     }
@@ -36,6 +36,7 @@
  
 #include "Win32directx.h"
 #include "VideoRender.h"
+#include "VideoPipeline.h"
 #include "FrameBuffer.h"
 #include "AppConfig.h"
 
@@ -597,38 +598,19 @@ static int DirectXCheckVBlank()
     return FALSE;
 }
 
-static int renderNoStretch(Video* pVideo, FrameBuffer* frameBuffer, int bitCount, 
-                            int zoom, void* dstBuffer, int dstPitch, int canChangeZoom)
+// Copies an image from the render pipeline. The image has the black
+// border columns of the frame, so nothing else is drawn.
+static void copyImage(VideoImage* image, void* dstBuffer, int dstPitch)
 {
-    int borderWidth = (320 - frameBuffer->maxWidth) / 2;
-    int dstOffset = borderWidth > 0 ? borderWidth * bitCount / 8 : 0;
-
-    zoom = videoRender(pVideo, frameBuffer, bitCount, zoom, 
-                       dstBuffer, dstOffset, dstPitch, canChangeZoom);
-
-    if (borderWidth > 0) {
-        borderWidth *= zoom;
-        if (bitCount == 16) {
-            UInt16* ptr  = dstBuffer;                    
-            int h = zoom * 240;
-            while (h--) {
-                memset(ptr, 0, borderWidth * sizeof(UInt16));
-                memset(ptr + zoom * 320 - borderWidth, 0, borderWidth * sizeof(UInt16));
-                ptr += dstPitch / sizeof(UInt16);
-            }
-        }
-        else if (bitCount == 32) {
-            UInt32* ptr  = dstBuffer;                 
-            int h = zoom * 240;
-            while (h--) {
-                memset(ptr, 0, borderWidth * sizeof(UInt32));
-                memset(ptr + zoom * 320 - borderWidth, 0, borderWidth * sizeof(UInt32));
-                ptr += dstPitch / sizeof(UInt32);
-            }
-        }
-    }
+    UInt8* src = image->pixels;
+    UInt8* dst = dstBuffer;
+    int y;
 
-    return zoom;
+    for (y = 0; y < image->height; y++) {
+        memcpy(dst, src, image->pitch);
+        src += image->pitch;
+        dst += dstPitch;
+    }
 }
 
 int DirectXUpdateSurface(Video* pVideo, 
@@ -640,9 +622,8 @@ int DirectXUpdateSurface(Video* pVideo,
     LPDIRECTDRAWSURFACE7 surface = NULL;
     LPDIRECTDRAWSURFACE7  lpDDSTemp;
     HRESULT     ddrval;
-    FrameBuffer* frameBuffer;
+    VideoImage* image;
     POINT pt = {0, 0};
-    int canChangeZoom;
     RECT destRect = { 0, 0, screenWidth, screenHeight };
     RECT rcRect = { 0, 0, screenWidth, screenHeight };
     void* surfaceBuffer;
@@ -706,14 +687,14 @@ int DirectXUpdateSurface(Video* pVideo,
 
     surfaceBuffer = ddsd.lpSurface;
 
-    frameBuffer = frameBufferFlipViewFrame(syncVblank);
-    if (frameBuffer == NULL) {
-        frameBuffer = frameBufferGetWhiteNoiseFrame();
-    }
+    // The frame is flipped and rendered by the render pipeline. Images
+    // in another format are skipped until the new format is rendered.
+    videoPipelineSetFormat(ddsd.ddpfPixelFormat.dwRGBBitCount, zoom);
 
-    canChangeZoom = -1; // Allow scale down when possible
-    if (isFullscreen && currentFullscreenMode->width >= 3 * 320) {
-        canChangeZoom = 1; // Allow scale up in fullscreen
+    image = videoPipelineGetLatest();
+    if (image == NULL || image->bitDepth != (int)ddsd.ddpfPixelFormat.dwRGBBitCount || image->zoom != zoom) {
+        IDirectDrawSurface7_Unlock(surface, NULL);
+        return 0;
     }
 
     if (lowresMode) {
@@ -723,8 +704,7 @@ int DirectXUpdateSurface(Video* pVideo,
         UInt8* srcPtr = lowresOffscreen + (((480 - screenHeight) / 2) * 640 + ((640 - screenWidth) / 2)) * bytesPerPixel;
         int y;
 
-        renderNoStretch(pVideo, frameBuffer, ddsd.ddpfPixelFormat.dwRGBBitCount, zoom, 
-                        rdrPtr, 640 * bytesPerPixel, -1);
+        copyImage(image, rdrPtr, 640 * bytesPerPixel);
 
         for (y = 0; y < screenHeight; y++) {
             memcpy(dstPtr, srcPtr, screenWidth * bytesPerPixel);
@@ -733,14 +713,7 @@ int DirectXUpdateSurface(Video* pVideo,
         }
     }
     else {
-        if (horizontalStretch) {
-            zoom = videoRender(pVideo, frameBuffer, ddsd.ddpfPixelFormat.dwRGBBitCount, zoom, 
-                                surfaceBuffer, 0, ddsd.lPitch, canChangeZoom);
-        }
-        else {
-            zoom = renderNoStretch(pVideo, frameBuffer, ddsd.ddpfPixelFormat.dwRGBBitCount, zoom, 
-                                   surfaceBuffer, ddsd.lPitch, canChangeZoom);
-        }
+        copyImage(image, surfaceBuffer, ddsd.lPitch);
     }
 
     if (IDirectDrawSurface7_Unlock(surface, NULL) == DDERR_SURFACELOST) {
@@ -774,8 +747,10 @@ int DirectXUpdateSurface(Video* pVideo,
         rcRect.bottom = 240 * zoom;
         rcRect.right  = 320 * zoom;
 
+        // The border columns are left out when stretched
         if (horizontalStretch) {
-            rcRect.right -= (320 - frameBuffer->maxWidth) * zoom;
+            rcRect.left  += image->borderWidth;
+            rcRect.right -= image->borderWidth;
         }
         rcRect.top -= dstPitchY;
 
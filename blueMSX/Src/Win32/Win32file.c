@@ -32,6 +32,7 @@
 #include <stdio.h>
 #include "Resource.h"
 #include "MediaDb.h"
+#include "Emulator.h"
 #include "RomLoader.h"
 #include "ziphelper.h"
 #include "Win32Common.h"
@@ -310,7 +311,7 @@ UINT_PTR CALLBACK hookRomProc(HWND hDlg, UINT iMsg, WPARAM wParam, LPARAM lParam
                         RomType romType;
                         int idx = 0;
                         
-                        if (!mediaType) mediaType=mediaDbGuessRom(buf, size);
+                        if (!mediaType) mediaType=mediaDbGuessRom(emulatorGetBoard(), buf, size);
                         romType = mediaType != NULL ? mediaDbGetRomType(mediaType) : ROM_UNKNOWN;
 			
                         while (romTypeList[idx] != romType) {
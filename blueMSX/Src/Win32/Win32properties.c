@@ -55,6 +55,7 @@ static HRESULT StringCchLength(LPCTSTR s, size_t m, size_t *l) { *l = strlen(s);
 #include "Language.h"
 #include "Machine.h"
 #include "Board.h"
+#include "Emulator.h"
 #include "Win32Midi.h"
 #include "Win32Cdrom.h"
 #include "Win32File.h"
@@ -1711,15 +1712,15 @@ static BOOL CALLBACK soundDlgProc(HWND hDlg, UINT iMsg, WPARAM wParam, LPARAM lP
 #endif
         case IDC_OVERSAMPLEMSXMUSIC:
             index = SendDlgItemMessage(hDlg, IDC_OVERSAMPLEMSXMUSIC, CB_GETCURSEL, 0, 0);
-            boardSetYm2413Oversampling(1 << index);
+            boardSetYm2413Oversampling(emulatorGetBoard(), 1 << index);
             break;
         case IDC_OVERSAMPLEMSXAUDIO:
             index = SendDlgItemMessage(hDlg, IDC_OVERSAMPLEMSXAUDIO, CB_GETCURSEL, 0, 0);
-            boardSetY8950Oversampling(1 << index);
+            boardSetY8950Oversampling(emulatorGetBoard(), 1 << index);
             break;
         case IDC_OVERSAMPLEMOONSOUND:
             index = SendDlgItemMessage(hDlg, IDC_OVERSAMPLEMOONSOUND, CB_GETCURSEL, 0, 0);
-            boardSetMoonsoundOversampling(1 << index);
+            boardSetMoonsoundOversampling(emulatorGetBoard(), 1 << index);
             break;
         }
         break;
@@ -1753,9 +1754,9 @@ static BOOL CALLBACK soundDlgProc(HWND hDlg, UINT iMsg, WPARAM wParam, LPARAM lP
         case PSN_QUERYCANCEL:
             emulatorRestartSound();
 
-            boardSetYm2413Oversampling(pProperties->sound.chip.ym2413Oversampling);
-            boardSetY8950Oversampling(pProperties->sound.chip.y8950Oversampling);
-            boardSetMoonsoundOversampling(pProperties->sound.chip.moonsoundOversampling);
+            boardSetYm2413Oversampling(emulatorGetBoard(), pProperties->sound.chip.ym2413Oversampling);
+            boardSetY8950Oversampling(emulatorGetBoard(), pProperties->sound.chip.y8950Oversampling);
+            boardSetMoonsoundOversampling(emulatorGetBoard(), pProperties->sound.chip.moonsoundOversampling);
 
             return FALSE;
         }
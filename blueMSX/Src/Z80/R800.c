@@ -33,14 +33,62 @@
 #include "R800.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+
+/* This file is compiled once as the generic core, which reads the
+** instruction timing from the delay table of the R800 object and has
+** the debugger support (time trace, call stack, breakpoints and
+** watchpoints). It is also included by R800CoreLean.c, R800CoreZ80.c
+** and R800CoreR800.c with R800_CORE_LEAN, R800_CORE_Z80 or R800_CORE_R800
+** defined. Those builds leave out the debugger support, the Z80 and R800
+** ones also have the timing and the CPU mode as compile time constants.
+** They only contain the instruction set and the execute loop.
+** r800SwitchCpu() selects the core to run.
+*/
+#if defined(R800_CORE_LEAN) || defined(R800_CORE_Z80) || defined(R800_CORE_R800)
+#define R800_CORE_SPECIALISED
+#define R800_TABLE extern
+#undef  ENABLE_BREAKPOINTS
+#undef  ENABLE_CALLSTACK
+#undef  ENABLE_WATCHPOINTS
+#undef  ENABLE_PROFILER
+#undef  ENABLE_TRACE_RING
+#undef  TIME_TRACE_SIZE
+#define TIME_TRACE_SIZE 0
+#else
+#define R800_TABLE
+#endif
+
+#define CORE_GENERIC  0
+#define CORE_LEAN     1
+#define CORE_Z80      2
+#define CORE_R800     3
+
+void r800SwitchCpu(R800* r800);
+void r800ExecuteGeneric(R800* r800);
+void r800ExecuteLean(R800* r800);
+void r800ExecuteZ80(R800* r800);
+void r800ExecuteR800(R800* r800);
 
 typedef void (*Opcode)(R800*);
 typedef void (*OpcodeNn)(R800*, UInt16);
 
-static UInt8  ZSXYTable[256];
-static UInt8  ZSPXYTable[256];
-static UInt8  ZSPHTable[256];
-static UInt16 DAATable[0x800];
+/* Each address an instruction was fetched from has the handler of the
+** instruction after its prefix and its first opcode in the high byte
+** of the code, with the number of opcode bytes in the low byte. A code
+** of 0 means that the address isn't decoded. The instructions of a
+** block are decoded at the block version in versions.
+*/
+struct R800CodeCache {
+    UInt32 versions[256];
+    UInt16 codes[0x10000];
+    Opcode handlers[0x10000];
+};
+
+R800_TABLE UInt8  ZSXYTable[256];
+R800_TABLE UInt8  ZSPXYTable[256];
+R800_TABLE UInt8  ZSPHTable[256];
+R800_TABLE UInt16 DAATable[0x800];
 
 
 static void cb(R800* r800);
@@ -87,37 +135,140 @@ static void fd_cb(R800* r800);
 #define DLY_LDSPHL    30
 #define DLY_BITIX     31
 
-#define delayMem(r800)      { r800->systemTime += r800->delay[DLY_MEM];      }
-#define delayMemOp(r800)    { r800->systemTime += r800->delay[DLY_MEMOP];    }
-#define delayMemPage(r800)  { r800->systemTime += r800->delay[DLY_MEMPAGE];  }
-#define delayPreIo(r800)    { r800->systemTime += r800->delay[DLY_PREIO];    }
-#define delayPostIo(r800)   { r800->systemTime += r800->delay[DLY_POSTIO];   }
-#define delayM1(r800)       { r800->systemTime += r800->delay[DLY_M1];       }
-#define delayXD(r800)       { r800->systemTime += r800->delay[DLY_XD];       }
-#define delayIm(r800)       { r800->systemTime += r800->delay[DLY_IM];       }
-#define delayIm2(r800)      { r800->systemTime += r800->delay[DLY_IM2];      }
-#define delayNmi(r800)      { r800->systemTime += r800->delay[DLY_NMI];      }
-#define delayParallel(r800) { r800->systemTime += r800->delay[DLY_PARALLEL]; }
-#define delayBlock(r800)    { r800->systemTime += r800->delay[DLY_BLOCK];    }
-#define delayAdd8(r800)     { r800->systemTime += r800->delay[DLY_ADD8];     }
-#define delayAdd16(r800)    { r800->systemTime += r800->delay[DLY_ADD16];    }
-#define delayBit(r800)      { r800->systemTime += r800->delay[DLY_BIT];      }
-#define delayCall(r800)     { r800->systemTime += r800->delay[DLY_CALL];     }
-#define delayDjnz(r800)     { r800->systemTime += r800->delay[DLY_DJNZ];     }
-#define delayExSpHl(r800)   { r800->systemTime += r800->delay[DLY_EXSPHL];   }
-#define delayInc(r800)      { r800->systemTime += r800->delay[DLY_INC];      }
-#define delayInc16(r800)    { r800->systemTime += r800->delay[DLY_INC16];    }
-#define delayInOut(r800)    { r800->systemTime += r800->delay[DLY_INOUT];    }
-#define delayLd(r800)       { r800->systemTime += r800->delay[DLY_LD];       }
-#define delayLdi(r800)      { r800->systemTime += r800->delay[DLY_LDI];      }
-#define delayMul8(r800)     { r800->systemTime += r800->delay[DLY_MUL8];     }
-#define delayMul16(r800)    { r800->systemTime += r800->delay[DLY_MUL16];    }
-#define delayPush(r800)     { r800->systemTime += r800->delay[DLY_PUSH];     }
-#define delayRet(r800)      { r800->systemTime += r800->delay[DLY_RET];      }
-#define delayRld(r800)      { r800->systemTime += r800->delay[DLY_RLD];      }
+/* Instruction timing of the Z80 and the R800 in CPU clock cycles. The M1
+** delay only applies with CPU_ENABLE_M1 and the T9769 delay only with
+** CPU_VDP_IO_DELAY.
+*/
+static const UInt8 z80Timing[32] = {
+     3, /* DLY_MEM      */
+     3, /* DLY_MEMOP    */
+     0, /* DLY_MEMPAGE  */
+     1, /* DLY_PREIO    */
+     3, /* DLY_POSTIO   */
+     2, /* DLY_M1       */
+     1, /* DLY_XD       */
+     2, /* DLY_IM       */ /* should be 4, but currently will break vdp timing */
+    19, /* DLY_IM2      */
+    11, /* DLY_NMI      */
+     2, /* DLY_PARALLEL */
+     5, /* DLY_BLOCK    */
+     5, /* DLY_ADD8     */
+     7, /* DLY_ADD16    */
+     1, /* DLY_BIT      */
+     1, /* DLY_CALL     */
+     1, /* DLY_DJNZ     */
+     3, /* DLY_EXSPHL   */
+     1, /* DLY_INC      */
+     2, /* DLY_INC16    */
+     1, /* DLY_INOUT    */
+     1, /* DLY_LD       */
+     2, /* DLY_LDI      */
+     0, /* DLY_MUL8     */
+     0, /* DLY_MUL16    */
+     1, /* DLY_PUSH     */
+     4, /* DLY_RLD      */
+     1, /* DLY_RET      */
+     0, /* DLY_S1990VDP */
+     1, /* DLY_T9769VDP */
+     2, /* DLY_LDSPHL   */
+     2  /* DLY_BITIX    */
+};
+
+static const UInt8 r800Timing[32] = {
+     2, /* DLY_MEM      */
+     1, /* DLY_MEMOP    */
+     1, /* DLY_MEMPAGE  */
+     0, /* DLY_PREIO    */
+     3, /* DLY_POSTIO   */
+     0, /* DLY_M1       */
+     0, /* DLY_XD       */
+     0, /* DLY_IM       */
+     3, /* DLY_IM2      */
+     0, /* DLY_NMI      */
+     0, /* DLY_PARALLEL */
+     1, /* DLY_BLOCK    */
+     1, /* DLY_ADD8     */
+     0, /* DLY_ADD16    */
+     0, /* DLY_BIT      */
+     0, /* DLY_CALL     */
+     0, /* DLY_DJNZ     */
+     0, /* DLY_EXSPHL   */
+     1, /* DLY_INC      */
+     0, /* DLY_INC16    */
+     0, /* DLY_INOUT    */
+     0, /* DLY_LD       */
+     0, /* DLY_LDI      */
+    12, /* DLY_MUL8     */
+    34, /* DLY_MUL16    */
+     1, /* DLY_PUSH     */
+     1, /* DLY_RLD      */
+     0, /* DLY_RET      */
+    57, /* DLY_S1990VDP */
+     1, /* DLY_T9769VDP */
+     0, /* DLY_LDSPHL   */
+     0  /* DLY_BITIX    */
+};
+
+/* Master clock cycles per CPU clock cycle at the standard frequencies */
+#define Z80_FREQ_ADJUST   (R800_MASTER_FREQUENCY / (3579545 - 1))
+#define R800_FREQ_ADJUST  (R800_MASTER_FREQUENCY / (7159090 - 1))
+
+#if defined(R800_CORE_Z80)
+#define R800_CORE_ID      CORE_Z80
+#define R800_EXECUTE      r800ExecuteZ80
+#define CPU_MODE(r800)    CPU_Z80
+#define DELAY(r800, dly)  (Z80_FREQ_ADJUST * z80Timing[dly])
+#elif defined(R800_CORE_R800)
+#define R800_CORE_ID      CORE_R800
+#define R800_EXECUTE      r800ExecuteR800
+#define CPU_MODE(r800)    CPU_R800
+#define DELAY(r800, dly)  (R800_FREQ_ADJUST * r800Timing[dly])
+#elif defined(R800_CORE_LEAN)
+#define R800_CORE_ID      CORE_LEAN
+#define R800_EXECUTE      r800ExecuteLean
+#define CPU_MODE(r800)    ((r800)->cpuMode)
+#define DELAY(r800, dly)  ((r800)->delay[dly])
+#else
+#define R800_CORE_ID      CORE_GENERIC
+#define R800_EXECUTE      r800ExecuteGeneric
+#define CPU_MODE(r800)    ((r800)->cpuMode)
+#define DELAY(r800, dly)  ((r800)->delay[dly])
+#endif
+
+#define delayMem(r800)      { r800->systemTime += DELAY(r800, DLY_MEM);      }
+#define delayMemOp(r800)    { r800->systemTime += DELAY(r800, DLY_MEMOP);    }
+#define delayMemPage(r800)  { r800->systemTime += DELAY(r800, DLY_MEMPAGE);  }
+#define delayPreIo(r800)    { r800->systemTime += DELAY(r800, DLY_PREIO);    }
+#define delayPostIo(r800)   { r800->systemTime += DELAY(r800, DLY_POSTIO);   }
+#define delayM1(r800)       { r800->systemTime += DELAY(r800, DLY_M1);       }
+#define delayXD(r800)       { r800->systemTime += DELAY(r800, DLY_XD);       }
+#define delayIm(r800)       { r800->systemTime += DELAY(r800, DLY_IM);       }
+#define delayIm2(r800)      { r800->systemTime += DELAY(r800, DLY_IM2);      }
+#define delayNmi(r800)      { r800->systemTime += DELAY(r800, DLY_NMI);      }
+#define delayParallel(r800) { r800->systemTime += DELAY(r800, DLY_PARALLEL); }
+#define delayBlock(r800)    { r800->systemTime += DELAY(r800, DLY_BLOCK);    }
+#define delayAdd8(r800)     { r800->systemTime += DELAY(r800, DLY_ADD8);     }
+#define delayAdd16(r800)    { r800->systemTime += DELAY(r800, DLY_ADD16);    }
+#define delayBit(r800)      { r800->systemTime += DELAY(r800, DLY_BIT);      }
+#define delayCall(r800)     { r800->systemTime += DELAY(r800, DLY_CALL);     }
+#define delayDjnz(r800)     { r800->systemTime += DELAY(r800, DLY_DJNZ);     }
+#define delayExSpHl(r800)   { r800->systemTime += DELAY(r800, DLY_EXSPHL);   }
+#define delayInc(r800)      { r800->systemTime += DELAY(r800, DLY_INC);      }
+#define delayInc16(r800)    { r800->systemTime += DELAY(r800, DLY_INC16);    }
+#define delayInOut(r800)    { r800->systemTime += DELAY(r800, DLY_INOUT);    }
+#define delayLd(r800)       { r800->systemTime += DELAY(r800, DLY_LD);       }
+#define delayLdi(r800)      { r800->systemTime += DELAY(r800, DLY_LDI);      }
+#define delayMul8(r800)     { r800->systemTime += DELAY(r800, DLY_MUL8);     }
+#define delayMul16(r800)    { r800->systemTime += DELAY(r800, DLY_MUL16);    }
+#define delayPush(r800)     { r800->systemTime += DELAY(r800, DLY_PUSH);     }
+#define delayRet(r800)      { r800->systemTime += DELAY(r800, DLY_RET);      }
+#define delayRld(r800)      { r800->systemTime += DELAY(r800, DLY_RLD);      }
 #define delayT9769(r800)    { r800->systemTime += r800->delay[DLY_T9769VDP]; }
-#define delayLdSpHl(r800)   { r800->systemTime += r800->delay[DLY_LDSPHL];   }
-#define delayBitIx(r800)    { r800->systemTime += r800->delay[DLY_BITIX];    }
+#define delayLdSpHl(r800)   { r800->systemTime += DELAY(r800, DLY_LDSPHL);   }
+#define delayBitIx(r800)    { r800->systemTime += DELAY(r800, DLY_BITIX);    }
+
+/* Makes the execute loop handle events after the current instruction */
+#define signalEvent(r800)   { r800->eventTime = r800->systemTime;            }
 
 /*
 #define delayVdpIO(r800, port) do {                                          \
@@ -138,11 +289,11 @@ static void fd_cb(R800* r800);
     if ((port & 0xfc) == 0x98) {                                             \
         delayT9769(r800);                                                    \
     }                                                                        \
-    if (r800->cpuMode == CPU_R800) {                                         \
+    if (CPU_MODE(r800) == CPU_R800) {                                        \
         r800->systemTime = 6 * ((r800->systemTime + 5) / 6);                 \
         if ((port & 0xf8) == 0x98) {                                         \
-            if (r800->systemTime - r800->vdpTime < r800->delay[DLY_S1990VDP])\
-                r800->systemTime = r800->vdpTime + r800->delay[DLY_S1990VDP];\
+            if (r800->systemTime - r800->vdpTime < DELAY(r800, DLY_S1990VDP))\
+                r800->systemTime = r800->vdpTime + DELAY(r800, DLY_S1990VDP);\
             r800->vdpTime = r800->systemTime;                                \
         }                                                                    \
     }                                                                        \
@@ -179,24 +330,63 @@ static void writePort(R800* r800, UInt16 port, UInt8 value) {
 }
 
 static UInt8 readMem(R800* r800, UInt16 address) {
+    UInt8* block;
+
     delayMem(r800);
     r800->cachePage = 0xffff;
+
+    block = r800->readBlocks[address >> 8];
+    if (block != NULL) {
+        return block[address & 0xff];
+    }
     return r800->readMemory(r800->ref, address);
 }
 
 static UInt8 readOpcode(R800* r800, UInt16 address) {
+    UInt8* block;
+
     delayMemOp(r800);
     if ((address >> 8) ^ r800->cachePage) {
         r800->cachePage = address >> 8;
         delayMemPage(r800);
     }
+
+    // Code in plain memory is fetched without the memory callback
+    block = r800->readBlocks[address >> 8];
+    if (block != NULL) {
+        return block[address & 0xff];
+    }
     return r800->readMemory(r800->ref, address);
 }
 
+/* Drops the instructions decoded from the bytes in the range. The
+** instruction before the range may have its second opcode in it.
+*/
+static void codeWritten(R800* r800, UInt16 address, UInt32 count) {
+    R800CodeCache* cache = r800->codeCache;
+
+    if (cache != NULL) {
+        cache->codes[(UInt16)(address - 1)] = 0;
+        while (count--) {
+            cache->codes[address++] = 0;
+        }
+    }
+}
+
 static void writeMem(R800* r800, UInt16 address, UInt8 value) {
+    UInt8* block;
+
     delayMem(r800);
     r800->cachePage = 0xffff;
-    r800->writeMemory(r800->ref, address, value);
+    codeWritten(r800, address, 1);
+
+    block = r800->writeBlocks[address >> 8];
+    if (block != NULL) {
+        block[address & 0xff] = value;
+    }
+    else {
+        r800->writeMemory(r800->ref, address, value);
+    }
 
 #ifdef ENABLE_WATCHPOINTS
     if (r800->watchpointMemCb != NULL) {
@@ -404,6 +594,9 @@ static void JR(R800* r800) {
     RegisterPair addr;
 
     addr.W = r800->regs.PC.W + 1 + (Int8)readOpcode(r800, r800->regs.PC.W);
+    if (addr.W == (UInt16)(r800->regs.PC.W - 1)) {
+        signalEvent(r800);
+    }
     r800->regs.PC.W = addr.W;
     r800->regs.SH.W = addr.W;
     delayAdd8(r800);
@@ -418,6 +611,9 @@ static void JP(R800* r800) {
 
     addr.B.l = readOpcode(r800, r800->regs.PC.W++);
     addr.B.h = readOpcode(r800, r800->regs.PC.W++);
+    if (addr.W == (UInt16)(r800->regs.PC.W - 3)) {
+        signalEvent(r800);
+    }
     r800->regs.PC.W = addr.W;
     r800->regs.SH.W = addr.W;
 }
@@ -601,7 +797,7 @@ static void ld_a_i(R800* r800) {
     r800->regs.AF.B.l = (r800->regs.AF.B.l & C_FLAG) | 
         ZSXYTable[r800->regs.AF.B.h] | (r800->regs.iff2 << 2);
     
-    if (r800->cpuMode == CPU_Z80 && ((r800->intState == INT_LOW && r800->regs.iff1) || r800->nmiEdge)) r800->regs.AF.B.l &= 0xfb;
+    if (CPU_MODE(r800) == CPU_Z80 && ((r800->intState == INT_LOW && r800->regs.iff1) || r800->nmiEdge)) r800->regs.AF.B.l &= 0xfb;
 }
 
 static void ld_a_r(R800* r800) {
@@ -610,7 +806,7 @@ static void ld_a_r(R800* r800) {
     r800->regs.AF.B.l = (r800->regs.AF.B.l & C_FLAG) | 
         ZSXYTable[r800->regs.AF.B.h] | (r800->regs.iff2 << 2);
     
-    if (r800->cpuMode == CPU_Z80 && ((r800->intState == INT_LOW && r800->regs.iff1) || r800->nmiEdge)) r800->regs.AF.B.l &= 0xfb;
+    if (CPU_MODE(r800) == CPU_Z80 && ((r800->intState == INT_LOW && r800->regs.iff1) || r800->nmiEdge)) r800->regs.AF.B.l &= 0xfb;
 }
 
 static void inc_bc(R800* r800) {
@@ -2361,19 +2557,19 @@ static void mulu_a(R800* r800) {
 }
 
 static void mulu_b(R800* r800) { 
-    if (r800->cpuMode == CPU_R800) MULU(r800, r800->regs.BC.B.h);
+    if (CPU_MODE(r800) == CPU_R800) MULU(r800, r800->regs.BC.B.h);
 }
 
 static void mulu_c(R800* r800) {
-    if (r800->cpuMode == CPU_R800) MULU(r800, r800->regs.BC.B.l); 
+    if (CPU_MODE(r800) == CPU_R800) MULU(r800, r800->regs.BC.B.l); 
 }
 
 static void mulu_d(R800* r800) {
-    if (r800->cpuMode == CPU_R800) MULU(r800, r800->regs.DE.B.h); 
+    if (CPU_MODE(r800) == CPU_R800) MULU(r800, r800->regs.DE.B.h); 
 }
 
 static void mulu_e(R800* r800) {
-    if (r800->cpuMode == CPU_R800) MULU(r800, r800->regs.DE.B.l);
+    if (CPU_MODE(r800) == CPU_R800) MULU(r800, r800->regs.DE.B.l);
 }
 
 static void mulu_h(R800* r800) { 
@@ -2383,7 +2579,7 @@ static void mulu_l(R800* r800) {
 }
 
 static void muluw_bc(R800* r800) { 
-    if (r800->cpuMode == CPU_R800) MULUW(r800, r800->regs.BC.W);
+    if (CPU_MODE(r800) == CPU_R800) MULUW(r800, r800->regs.BC.W);
 }
 
 static void muluw_de(R800* r800) {
@@ -2393,7 +2589,7 @@ static void muluw_hl(R800* r800) {
 }
 
 static void muluw_sp(R800* r800) {
-    if (r800->cpuMode == CPU_R800) MULUW(r800, r800->regs.SP.W); 
+    if (CPU_MODE(r800) == CPU_R800) MULUW(r800, r800->regs.SP.W); 
 }
 
 static void sla_a(R800* r800) { 
@@ -4874,11 +5070,13 @@ static void ret_po(R800* r800) {
 
 static void reti(R800* r800) {
     r800->regs.iff1 = r800->regs.iff2;
+    signalEvent(r800);
     RET(r800);
 }
 
 static void retn(R800* r800) {
     r800->regs.iff1 = r800->regs.iff2;
+    signalEvent(r800);
     RET(r800); 
 }
 
@@ -4964,6 +5162,7 @@ static void halt(R800* r800) {
 	else {
 		r800->regs.PC.W--;
 		r800->regs.halt=1;
+        signalEvent(r800);
 	}
 }
 
@@ -5100,6 +5299,7 @@ static void ei(R800* r800) {
         r800->regs.iff2 = 1;
         r800->regs.iff1 = 1;
 		r800->regs.ei_mode=1;
+        signalEvent(r800);
 }
 
 static void im_0(R800* r800)  {
@@ -5193,6 +5393,223 @@ static void in_0_c(R800* r800) {
         ZSPXYTable[readPort(r800, r800->regs.BC.W)]; 
 }
 
+/* Repeating block instructions run their following iterations at once
+** while the instruction and its data are in memory blocks with direct
+** access and no event is due. The iterations take the same time and
+** have the same effect as refetching and executing the instruction,
+** and the last iteration is always left to the instruction itself.
+** The generic core executes them one at a time for the debugger.
+*/
+#ifdef R800_CORE_SPECIALISED
+
+static UInt8* directRead(R800* r800, UInt16 address) {
+    UInt8* block = r800->readBlocks[address >> 8];
+    return block != NULL ? block + (address & 0xff) : NULL;
+}
+
+static UInt8* directWrite(R800* r800, UInt16 address) {
+    UInt8* block = r800->writeBlocks[address >> 8];
+    return block != NULL ? block + (address & 0xff) : NULL;
+}
+
+/* Returns 1 if the instruction at pc is the given ED prefixed block
+** instruction and can be fetched from memory with direct access.
+*/
+static int isBlockInstruction(R800* r800, UInt16 pc, UInt8 opcode) {
+    UInt8* prefix = directRead(r800, pc);
+    UInt8* code   = directRead(r800, (UInt16)(pc + 1));
+
+    return prefix != NULL && code != NULL && *prefix == 0xed && *code == opcode;
+}
+
+/* Time to fetch a block instruction after an iteration that ended with
+** a memory access.
+*/
+static UInt32 blockFetchTime(R800* r800, UInt16 pc) {
+    UInt32 time = 2 * (DELAY(r800, DLY_MEMOP) + DELAY(r800, DLY_M1)) + 
+                  DELAY(r800, DLY_MEMPAGE);
+
+    if ((UInt16)(pc + 1) >> 8 != pc >> 8) {
+        time += DELAY(r800, DLY_MEMPAGE);
+    }
+    return time;
+}
+
+/* Fetches a block instruction the way readOpcode() and ed() do */
+static void blockFetch(R800* r800, UInt16 pc) {
+    int i;
+
+    for (i = 0; i < 2; i++, pc++) {
+        delayMemOp(r800);
+        if ((pc >> 8) ^ r800->cachePage) {
+            r800->cachePage = pc >> 8;
+            delayMemPage(r800);
+        }
+        M1(r800);
+    }
+}
+
+static UInt32 iterationsBeforeEvent(R800* r800, UInt32 time) {
+    Int32 left = (Int32)(r800->eventTime - r800->systemTime);
+    return left > 0 ? (left + time - 1) / time : 0;
+}
+
+/* Number of bytes from address to the end of its block in the
+** direction of step.
+*/
+static UInt32 blockRoom(UInt16 address, int step) {
+    return step > 0 ? 0x100 - (address & 0xff) : (address & 0xff) + 1;
+}
+
+/* Limits count so that as many writes from dst in the direction of
+** step leave the byte at ptr alone.
+*/
+static UInt32 clampWrites(UInt8* dst, int step, UInt32 count, UInt8* ptr) {
+    if (ptr != NULL) {
+        if (step > 0 && ptr >= dst && ptr < dst + count) {
+            return ptr - dst;
+        }
+        if (step < 0 && ptr <= dst && ptr > dst - count) {
+            return dst - ptr;
+        }
+    }
+    return count;
+}
+
+/* Continues LDIR (step 1) or LDDR (step -1) */
+static void repeatLdBlock(R800* r800, int step) {
+    UInt16 pc   = r800->regs.PC.W;
+    UInt8  code = step > 0 ? 0xb0 : 0xb8;
+    UInt32 time = blockFetchTime(r800, pc) + 2 * DELAY(r800, DLY_MEM) + 
+                  DELAY(r800, DLY_LDI) + DELAY(r800, DLY_BLOCK);
+
+    while (isBlockInstruction(r800, pc, code)) {
+        UInt8* src = directRead(r800, r800->regs.HL.W);
+        UInt8* dst = directWrite(r800, r800->regs.DE.W);
+        UInt32 count = r800->regs.BC.W - 1;
+        UInt32 i;
+        UInt8  val;
+
+        if (src == NULL || dst == NULL) {
+            break;
+        }
+
+        if (count > iterationsBeforeEvent(r800, time)) {
+            count = iterationsBeforeEvent(r800, time);
+        }
+        if (count > blockRoom(r800->regs.HL.W, step)) {
+            count = blockRoom(r800->regs.HL.W, step);
+        }
+        if (count > blockRoom(r800->regs.DE.W, step)) {
+            count = blockRoom(r800->regs.DE.W, step);
+        }
+
+        // The instruction must not overwrite itself
+        count = clampWrites(dst, step, count, directRead(r800, pc));
+        count = clampWrites(dst, step, count, directRead(r800, (UInt16)(pc + 1)));
+
+        if (count == 0) {
+            break;
+        }
+
+        // Overlapping copies repeat the source like the iterations do
+        if (step > 0 && (dst + count <= src || src + count <= dst)) {
+            memcpy(dst, src, count);
+        }
+        else {
+            for (i = 0; i < count; i++) {
+                dst[(Int32)i * step] = src[(Int32)i * step];
+            }
+        }
+        val = dst[(Int32)(count - 1) * step];
+        codeWritten(r800, step > 0 ? r800->regs.DE.W : (UInt16)(r800->regs.DE.W - count + 1), count);
+
+        r800->regs.HL.W += (UInt16)((Int32)count * step);
+        r800->regs.DE.W += (UInt16)((Int32)count * step);
+        r800->regs.BC.W -= (UInt16)count;
+        r800->regs.R = (r800->regs.R & 0x80) | ((r800->regs.R + 2 * count) & 0x7f);
+        r800->systemTime += count * time;
+        r800->regs.AF.B.l = (r800->regs.AF.B.l & (S_FLAG | Z_FLAG | C_FLAG)) |
+            (((r800->regs.AF.B.h + val) << 4) & Y_FLAG) | 
+            ((r800->regs.AF.B.h + val) & X_FLAG) | P_FLAG;
+    }
+}
+
+/* Continues CPIR (step 1) or CPDR (step -1) */
+static void repeatCpBlock(R800* r800, int step) {
+    UInt16 pc   = r800->regs.PC.W;
+    UInt8  code = step > 0 ? 0xb1 : 0xb9;
+    UInt32 time = blockFetchTime(r800, pc) + DELAY(r800, DLY_MEM) + 
+                  2 * DELAY(r800, DLY_BLOCK);
+
+    while (isBlockInstruction(r800, pc, code)) {
+        UInt8* src = directRead(r800, r800->regs.HL.W);
+        UInt32 count = r800->regs.BC.W - 1;
+        UInt32 i;
+        UInt8  val;
+        UInt8  rv;
+
+        if (src == NULL) {
+            break;
+        }
+
+        if (count > iterationsBeforeEvent(r800, time)) {
+            count = iterationsBeforeEvent(r800, time);
+        }
+        if (count > blockRoom(r800->regs.HL.W, step)) {
+            count = blockRoom(r800->regs.HL.W, step);
+        }
+
+        // The iteration that finds A ends the instruction
+        if (step > 0) {
+            UInt8* match = memchr(src, r800->regs.AF.B.h, count);
+            if (match != NULL) {
+                count = match - src;
+            }
+        }
+        else {
+            for (i = 0; i < count && src[-(Int32)i] != r800->regs.AF.B.h; i++);
+            count = i;
+        }
+
+        if (count == 0) {
+            break;
+        }
+
+        val = src[(Int32)(count - 1) * step];
+        rv  = r800->regs.AF.B.h - val;
+
+        r800->regs.HL.W += (UInt16)((Int32)count * step);
+        r800->regs.BC.W -= (UInt16)count;
+        r800->regs.R = (r800->regs.R & 0x80) | ((r800->regs.R + 2 * count) & 0x7f);
+        r800->systemTime += count * time;
+        r800->regs.AF.B.l = (r800->regs.AF.B.l & C_FLAG) | 
+            ((r800->regs.AF.B.h ^ val ^ rv) & H_FLAG) | 
+            (ZSPXYTable[rv & 0xff] & (Z_FLAG | S_FLAG)) | N_FLAG;
+        rv -= (r800->regs.AF.B.l & H_FLAG) >> 4;
+        r800->regs.AF.B.l |= ((rv << 4) & Y_FLAG) | (rv & X_FLAG) | P_FLAG;
+    }
+}
+
+/* Continues INIR or OTIR. Every iteration accesses the I/O port at its
+** own time, so the iterations are run one by one without the fetch,
+** decode and event checks in between.
+*/
+static void repeatIoBlock(R800* r800, UInt8 code, void (*iteration)(R800*)) {
+    UInt16 pc = r800->regs.PC.W;
+
+    while (r800->regs.BC.B.h > 1 && 
+           (Int32)(r800->eventTime - r800->systemTime) > 0 &&
+           isBlockInstruction(r800, pc, code))
+    {
+        blockFetch(r800, pc);
+        iteration(r800);
+        delayBlock(r800);
+    }
+}
+
+#endif
+
 static void cpi(R800* r800) { 
     UInt8 val = readMem(r800, r800->regs.HL.W++);
     UInt8 rv = r800->regs.AF.B.h - val;
@@ -5213,6 +5630,9 @@ static void cpir(R800* r800) {
         delayBlock(r800); 
         r800->regs.PC.W -= 2;
         r800->instCnt--;
+#ifdef R800_CORE_SPECIALISED
+        repeatCpBlock(r800, 1);
+#endif
     }
 }
 
@@ -5236,6 +5656,9 @@ static void cpdr(R800* r800) {
         delayBlock(r800); 
         r800->regs.PC.W -= 2;
         r800->instCnt--;
+#ifdef R800_CORE_SPECIALISED
+        repeatCpBlock(r800, -1);
+#endif
     }
 }
 
@@ -5256,6 +5679,9 @@ static void ldir(R800* r800) {
         delayBlock(r800); 
         r800->regs.PC.W -= 2; 
         r800->instCnt--;
+#ifdef R800_CORE_SPECIALISED
+        repeatLdBlock(r800, 1);
+#endif
     }
 }
 
@@ -5276,6 +5702,9 @@ static void lddr(R800* r800) {
         delayBlock(r800); 
         r800->regs.PC.W -= 2; 
         r800->instCnt--;
+#ifdef R800_CORE_SPECIALISED
+        repeatLdBlock(r800, -1);
+#endif
     }
 }
 
@@ -5299,6 +5728,9 @@ static void inir(R800* r800) {
         delayBlock(r800); 
         r800->regs.PC.W -= 2; 
         r800->instCnt--;
+#ifdef R800_CORE_SPECIALISED
+        repeatIoBlock(r800, 0xb2, ini);
+#endif
     }
 }
 
@@ -5326,12 +5758,9 @@ static void indr(R800* r800) {
     }
 }
 
-static void outi(R800* r800) {
-    UInt8  val;
+/* Decrements B and sets the flags after OUTI or OUTD wrote val */
+static void outFlags(R800* r800, UInt8 val) {
     UInt16 tmp;
-    delayInOut(r800);
-    val = readMem(r800, r800->regs.HL.W++);
-    writePort(r800, r800->regs.BC.W, val);
     r800->regs.BC.B.h--;
     r800->regs.AF.B.l = (ZSXYTable[r800->regs.BC.B.h]) |
         ((val >> 6) & N_FLAG);
@@ -5340,27 +5769,128 @@ static void outi(R800* r800) {
         (ZSPXYTable[(tmp & 0x07) ^ r800->regs.BC.B.h] & P_FLAG);
 }
 
+static void OUTI(R800* r800) {
+    UInt8  val;
+    delayInOut(r800);
+    val = readMem(r800, r800->regs.HL.W++);
+    writePort(r800, r800->regs.BC.W, val);
+    outFlags(r800, val);
+}
+
+#ifdef R800_CORE_SPECIALISED
+
+/* Values written to a port that takes block writes, with the time of
+** each write. A block holds at most one OTIR.
+*/
+typedef struct {
+    int        count;
+    UInt8      values[256];
+    SystemTime times[256];
+} OutBlock;
+
+/* OUTI that queues the value in the block instead of writing the port.
+** The timing is the same as in OUTI and writePort().
+*/
+static void outiQueued(R800* r800, OutBlock* block) {
+    UInt16 port = r800->regs.BC.W;
+    UInt8  val;
+    delayInOut(r800);
+    val = readMem(r800, r800->regs.HL.W++);
+    r800->regs.SH.W = port + 1;
+    delayPreIo(r800);
+    delayVdpIO(r800, port);
+    block->values[block->count] = val;
+    block->times[block->count++] = r800->systemTime;
+    delayPostIo(r800);
+    outFlags(r800, val);
+}
+
+static void outBlockFlush(R800* r800, OutBlock* block) {
+    if (block->count > 0) {
+        r800->writeIoPortBlock(r800->ref, r800->regs.BC.W, 
+                               block->values, block->times, block->count);
+        block->count = 0;
+    }
+}
+
+/* Continues OTIR to a port that takes block writes. The iterations are
+** run as in repeatIoBlock() while the data is in plain memory, and the
+** port gets all values in one call afterwards.
+*/
+static void repeatOutBlock(R800* r800) {
+    UInt16 pc = r800->regs.PC.W;
+    OutBlock block;
+
+    block.count = 0;
+    while (r800->regs.BC.B.h > 1 && 
+           (Int32)(r800->eventTime - r800->systemTime) > 0 &&
+           isBlockInstruction(r800, pc, 0xb3) &&
+           directRead(r800, r800->regs.HL.W) != NULL)
+    {
+        blockFetch(r800, pc);
+        outiQueued(r800, &block);
+        delayBlock(r800);
+    }
+    outBlockFlush(r800, &block);
+}
+
+#endif
+
+static void outi(R800* r800) {
+    OUTI(r800);
+#ifdef R800_CORE_SPECIALISED
+    // Unrolled OUTI sequences are run without the event checks in between
+    if (r800->checkIoPortBlock(r800->ref, r800->regs.BC.W)) {
+        OutBlock block;
+
+        block.count = 0;
+        while (block.count < 256 &&
+               (Int32)(r800->eventTime - r800->systemTime) > 0 &&
+               isBlockInstruction(r800, r800->regs.PC.W, 0xa3) &&
+               directRead(r800, r800->regs.HL.W) != NULL)
+        {
+            blockFetch(r800, r800->regs.PC.W);
+            r800->regs.PC.W += 2;
+            r800->instCnt++;
+            outiQueued(r800, &block);
+        }
+        outBlockFlush(r800, &block);
+        return;
+    }
+    while ((Int32)(r800->eventTime - r800->systemTime) > 0 &&
+           isBlockInstruction(r800, r800->regs.PC.W, 0xa3))
+    {
+        blockFetch(r800, r800->regs.PC.W);
+        r800->regs.PC.W += 2;
+        r800->instCnt++;
+        OUTI(r800);
+    }
+#endif
+}
+
 static void otir(R800* r800) { 
-    outi(r800);
+    OUTI(r800);
     if (r800->regs.BC.B.h != 0) {
         delayBlock(r800); 
         r800->regs.PC.W -= 2; 
         r800->instCnt--;
+#ifdef R800_CORE_SPECIALISED
+        if (r800->checkIoPortBlock(r800->ref, r800->regs.BC.W)) {
+            repeatOutBlock(r800);
+        }
+        else {
+            repeatIoBlock(r800, 0xb3, OUTI);
+        }
+#endif
     }
 }
 
 static void outd(R800* r800) {
     UInt8 val;
-    UInt16 tmp;
     delayInOut(r800);
     val = readMem(r800, r800->regs.HL.W--);
     writePort(r800, r800->regs.BC.W, val);
-    r800->regs.BC.B.h--;
-    r800->regs.AF.B.l = (ZSXYTable[r800->regs.BC.B.h]) |
-        ((val >> 6) & N_FLAG);
-    tmp = val + r800->regs.HL.B.l;
-    r800->regs.AF.B.l |= (tmp >> 8) * (H_FLAG | C_FLAG) |
-        (ZSPXYTable[(tmp & 0x07) ^ r800->regs.BC.B.h] & P_FLAG);
+    outFlags(r800, val);
 }
 
 static void otdr(R800* r800) { 
@@ -5630,6 +6160,91 @@ static void executeInstruction(R800* r800, UInt8 opcode) {
     opcodeMain[opcode](r800);
 }
 
+#ifdef R800_CORE_SPECIALISED
+
+/* Executes the instruction at pc the way executeCode() does when it is
+** not decoded, and keeps it in the code cache if its opcodes are in
+** plain memory in the same block.
+*/
+static UInt8 decodeInstruction(R800* r800, UInt16 pc) {
+    R800CodeCache* cache = r800->codeCache;
+    UInt8* block  = r800->readBlocks[pc >> 8];
+    UInt8  opcode = readOpcode(r800, r800->regs.PC.W++);
+
+    if (block != NULL && cache->versions[pc >> 8] != 0) {
+        UInt8 next = block[(pc + 1) & 0xff];
+
+        switch (opcode) {
+        case 0xcb:
+        case 0xdd:
+        case 0xed:
+        case 0xfd:
+            if ((pc & 0xff) != 0xff) {
+                cache->handlers[pc] = opcode == 0xcb ? opcodeCb[next] :
+                                      opcode == 0xdd ? opcodeDd[next] :
+                                      opcode == 0xed ? opcodeEd[next] : opcodeFd[next];
+                cache->codes[pc] = opcode << 8 | 2;
+            }
+            break;
+        default:
+            cache->handlers[pc] = opcodeMain[opcode];
+            cache->codes[pc] = opcode << 8 | 1;
+            break;
+        }
+    }
+
+    executeInstruction(r800, opcode);
+
+    return opcode;
+}
+
+/* Fetches and executes the instruction at pc and returns its first
+** opcode. A decoded instruction gets the delays and the refresh counter
+** updates of its opcode fetches and is called without reading them.
+*/
+static UInt8 executeCode(R800* r800, UInt16 pc) {
+    R800CodeCache* cache = r800->codeCache;
+    UInt32 version;
+    UInt16 code;
+
+    if (cache == NULL) {
+        UInt8 opcode = readOpcode(r800, r800->regs.PC.W++);
+        executeInstruction(r800, opcode);
+        return opcode;
+    }
+
+    version = r800->blockVersions[pc >> 8];
+    if (cache->versions[pc >> 8] != version) {
+        cache->versions[pc >> 8] = version;
+        memset(cache->codes + (pc & 0xff00), 0, 0x100 * sizeof(UInt16));
+    }
+
+    code = cache->codes[pc];
+    if (code == 0) {
+        return decodeInstruction(r800, pc);
+    }
+
+    delayMemOp(r800);
+    if ((pc >> 8) ^ r800->cachePage) {
+        r800->cachePage = pc >> 8;
+        delayMemPage(r800);
+    }
+    M1(r800);
+    r800->instCnt++;
+    if ((code & 0xff) == 2) {
+        delayMemOp(r800);
+        M1(r800);
+    }
+    r800->regs.PC.W = pc + (code & 0xff);
+    cache->handlers[pc](r800);
+
+    return (UInt8)(code >> 8);
+}
+
+#endif
+
+#ifndef R800_CORE_SPECIALISED
+
 static UInt8 readMemoryDummy(void* ref, UInt16 address) {
     return 0xff;
 }
@@ -5644,6 +6259,10 @@ static UInt8 readIoPortDummy(void* ref, UInt16 address) {
 static void writeIoPortDummy(void* ref, UInt16 address, UInt8 value) {
 }
 
+static int checkIoPortBlockDummy(void* ref, UInt16 address) {
+    return 0;
+}
+
 static void  patchDummy(void* ref, CpuRegs* regs) {
 }
 
@@ -5710,8 +6329,11 @@ static void r800InitTables() {
 	}
 }
 
-static void r800SwitchCpu(R800* r800) {
+void r800SwitchCpu(R800* r800) {
+    const UInt8* timing;
+    int oldCore = r800->core;
     int freqAdjust;
+    int i;
 
     switch (r800->oldCpuMode) {
     case CPU_Z80:
@@ -5746,75 +6368,54 @@ static void r800SwitchCpu(R800* r800) {
     switch (r800->cpuMode) {
     default:
     case CPU_Z80:
-        r800->delay[DLY_MEM]       = freqAdjust * 3;
-        r800->delay[DLY_MEMOP]     = freqAdjust * 3;
-        r800->delay[DLY_MEMPAGE]   = freqAdjust * 0;
-        r800->delay[DLY_PREIO]     = freqAdjust * 1;
-        r800->delay[DLY_POSTIO]    = freqAdjust * 3;
-        r800->delay[DLY_M1]        = freqAdjust * ((r800->cpuFlags & CPU_ENABLE_M1) ? 2 : 0);
-        r800->delay[DLY_XD]        = freqAdjust * 1;
-        r800->delay[DLY_IM]        = freqAdjust * 2; // should be 4, but currently will break vdp timing
-        r800->delay[DLY_IM2]       = freqAdjust * 19;
-        r800->delay[DLY_NMI]       = freqAdjust * 11;
-        r800->delay[DLY_PARALLEL]  = freqAdjust * 2;
-        r800->delay[DLY_BLOCK]     = freqAdjust * 5;
-        r800->delay[DLY_ADD8]      = freqAdjust * 5;
-        r800->delay[DLY_ADD16]     = freqAdjust * 7;
-        r800->delay[DLY_BIT]       = freqAdjust * 1;
-        r800->delay[DLY_CALL]      = freqAdjust * 1;
-        r800->delay[DLY_DJNZ]      = freqAdjust * 1;
-        r800->delay[DLY_EXSPHL]    = freqAdjust * 3;
-        r800->delay[DLY_LD]        = freqAdjust * 1;
-        r800->delay[DLY_LDI]       = freqAdjust * 2;
-        r800->delay[DLY_INC]       = freqAdjust * 1;
-        r800->delay[DLY_INC16]     = freqAdjust * 2;
-        r800->delay[DLY_INOUT]     = freqAdjust * 1;
-        r800->delay[DLY_MUL8]      = freqAdjust * 0;
-        r800->delay[DLY_MUL16]     = freqAdjust * 0;
-        r800->delay[DLY_PUSH]      = freqAdjust * 1;
-        r800->delay[DLY_RET]       = freqAdjust * 1;
-        r800->delay[DLY_RLD]       = freqAdjust * 4;
-        r800->delay[DLY_S1990VDP]  = freqAdjust * 0;
-        r800->delay[DLY_T9769VDP]  = freqAdjust * ((r800->cpuFlags & CPU_VDP_IO_DELAY) ? 1 : 0);
-        r800->delay[DLY_LDSPHL]    = freqAdjust * 2;
-        r800->delay[DLY_BITIX]     = freqAdjust * 2;
+        timing = z80Timing;
         break;
-
     case CPU_R800:
-        r800->delay[DLY_MEM]       = freqAdjust * 2;
-        r800->delay[DLY_MEMOP]     = freqAdjust * 1;
-        r800->delay[DLY_MEMPAGE]   = freqAdjust * 1;
-        r800->delay[DLY_PREIO]     = freqAdjust * 0;
-        r800->delay[DLY_POSTIO]    = freqAdjust * 3;
-        r800->delay[DLY_M1]        = freqAdjust * 0;
-        r800->delay[DLY_XD]        = freqAdjust * 0;
-        r800->delay[DLY_IM]        = freqAdjust * 0;
-        r800->delay[DLY_IM2]       = freqAdjust * 3;
-        r800->delay[DLY_NMI]       = freqAdjust * 0;
-        r800->delay[DLY_PARALLEL]  = freqAdjust * 0;
-        r800->delay[DLY_BLOCK]     = freqAdjust * 1;
-        r800->delay[DLY_ADD8]      = freqAdjust * 1;
-        r800->delay[DLY_ADD16]     = freqAdjust * 0;
-        r800->delay[DLY_BIT]       = freqAdjust * 0;
-        r800->delay[DLY_CALL]      = freqAdjust * 0;
-        r800->delay[DLY_DJNZ]      = freqAdjust * 0;
-        r800->delay[DLY_EXSPHL]    = freqAdjust * 0;
-        r800->delay[DLY_LD]        = freqAdjust * 0;
-        r800->delay[DLY_LDI]       = freqAdjust * 0;
-        r800->delay[DLY_INC]       = freqAdjust * 1;
-        r800->delay[DLY_INC16]     = freqAdjust * 0;
-        r800->delay[DLY_INOUT]     = freqAdjust * 0;
-        r800->delay[DLY_MUL8]      = freqAdjust * 12;
-        r800->delay[DLY_MUL16]     = freqAdjust * 34;
-        r800->delay[DLY_PUSH]      = freqAdjust * 1;
-        r800->delay[DLY_RET]       = freqAdjust * 0;
-        r800->delay[DLY_RLD]       = freqAdjust * 1;
-        r800->delay[DLY_S1990VDP]  = freqAdjust * 57;
-        r800->delay[DLY_T9769VDP]  = freqAdjust * ((r800->cpuFlags & CPU_VDP_IO_DELAY) ? 1 : 0);
-        r800->delay[DLY_LDSPHL]    = freqAdjust * 0;
-        r800->delay[DLY_BITIX]     = freqAdjust * 0;
+        timing = r800Timing;
         break;
     }
+
+    for (i = 0; i < 32; i++) {
+        r800->delay[i] = freqAdjust * timing[i];
+    }
+
+    if (!(r800->cpuFlags & CPU_ENABLE_M1)) {
+        r800->delay[DLY_M1] = 0;
+    }
+
+    if (!(r800->cpuFlags & CPU_VDP_IO_DELAY)) {
+        r800->delay[DLY_T9769VDP] = 0;
+    }
+
+    r800->core = CORE_GENERIC;
+
+    if (!(r800->cpuFlags & CPU_GENERIC_CORE) && !r800->instrumented
+#ifdef ENABLE_BREAKPOINTS
+        && r800->breakpointCount == 0
+#endif
+#ifdef ENABLE_PROFILER
+        && r800->profileCb == NULL
+#endif
+#ifdef ENABLE_TRACE_RING
+        && r800->traceHeader == NULL
+#endif
+        )
+    {
+        r800->core = CORE_LEAN;
+        if (r800->cpuMode == CPU_Z80 && freqAdjust == Z80_FREQ_ADJUST && 
+            (r800->cpuFlags & CPU_ENABLE_M1)) 
+        {
+            r800->core = CORE_Z80;
+        }
+        if (r800->cpuMode == CPU_R800 && freqAdjust == R800_FREQ_ADJUST) {
+            r800->core = CORE_R800;
+        }
+    }
+
+    // The decoded handlers belong to the core that decoded them
+    if (r800->core != oldCore && r800->codeCache != NULL) {
+        memset(r800->codeCache->codes, 0, sizeof(r800->codeCache->codes));
+    }
 }
 
 R800* r800Create(UInt32 cpuFlags, 
@@ -5843,6 +6444,9 @@ R800* r800Create(UInt32 cpuFlags,
     r800->watchpointIoCb   = watchpointIoCb   ? watchpointIoCb   : writeIoPortDummy;
     r800->ref         = ref;
 
+    r800SetMemoryBlocks(r800, NULL, NULL);
+    r800SetIoPortBlockWrite(r800, NULL, NULL);
+
     r800->frequencyZ80  = 3579545;
     r800->frequencyR800 = 7159090;
 
@@ -5862,6 +6466,7 @@ R800* r800Create(UInt32 cpuFlags,
 }
 
 void r800Destroy(R800* r800) {
+    free(r800->codeCache);
     free(r800);
 }
 
@@ -5934,6 +6539,8 @@ void r800Reset(R800 *r800, UInt32 cpuTime) {
 #ifdef ENABLE_CALLSTACK
     r800->callstackSize = 0;
 #endif
+
+    signalEvent(r800);
 }
 
 void r800SetDataBus(R800* r800, UInt8 value, UInt8 defaultValue, int setDefault) {
@@ -5945,6 +6552,7 @@ void r800SetDataBus(R800* r800, UInt8 value, UInt8 defaultValue, int setDefault)
 
 void r800SetInt(R800* r800) {
     r800->intState = INT_LOW;
+    signalEvent(r800);
 }
 
 void r800ClearInt(R800* r800) {
@@ -5956,6 +6564,7 @@ void r800SetNmi(R800* r800) {
         r800->nmiEdge = 1;
     }
     r800->nmiState = INT_LOW;
+    signalEvent(r800);
 }
 
 void r800ClearNmi(R800* r800) {
@@ -5978,6 +6587,7 @@ void r800SetFrequency(R800* r800, CpuMode cpuMode, UInt32 frequency) {
 
     r800->oldCpuMode = r800->cpuMode;
     r800SwitchCpu(r800);
+    signalEvent(r800);
 }
 
 void r800SetMode(R800* r800, CpuMode mode) {
@@ -5987,15 +6597,92 @@ void r800SetMode(R800* r800, CpuMode mode) {
 
     r800->oldCpuMode = r800->cpuMode;
     r800->cpuMode    = mode;
+    signalEvent(r800);
 }
 
 void r800StopExecution(R800* r800) {
     r800->terminate = 1;
+    signalEvent(r800);
 }
 
 void r800SetTimeoutAt(R800* r800, SystemTime time)
 {
     r800->timeout = time;
+    if ((Int32)(time - r800->eventTime) < 0) {
+        r800->eventTime = time;
+    }
+}
+
+/* Makes the execute loop select its core again before the next
+** instruction. The CPU mode is switched to itself unless a switch to
+** the other mode is already pending.
+*/
+static void r800UpdateCore(R800* r800)
+{
+    if (r800->oldCpuMode == CPU_UNKNOWN) {
+        r800->oldCpuMode = r800->cpuMode;
+    }
+    signalEvent(r800);
+}
+
+void r800SetInstrumentation(R800* r800, int enable)
+{
+    if (r800->instrumented == enable) {
+        return;
+    }
+
+    r800->instrumented = enable;
+
+#if TIME_TRACE_SIZE > 0
+    memset(r800->timeTraceBuffer, 0, sizeof(r800->timeTraceBuffer));
+#endif
+
+    r800UpdateCore(r800);
+}
+
+void r800SetProfiler(R800* r800, R800ProfileCb profileCb, void* ref)
+{
+#ifdef ENABLE_PROFILER
+    r800->profileCb  = profileCb;
+    r800->profileRef = ref;
+
+    r800UpdateCore(r800);
+#endif
+}
+
+void r800SetTraceRing(R800* r800, R800TraceHeader* header)
+{
+#ifdef ENABLE_TRACE_RING
+    r800->traceHeader = header;
+
+    r800UpdateCore(r800);
+#endif
+}
+
+void r800SetMemoryBlocks(R800* r800, UInt8** readBlocks, UInt8** writeBlocks)
+{
+    static UInt8* noBlocks[0x100];
+
+    r800->readBlocks  = readBlocks  != NULL ? readBlocks  : noBlocks;
+    r800->writeBlocks = writeBlocks != NULL ? writeBlocks : noBlocks;
+}
+
+void r800SetCodeCache(R800* r800, const UInt32* blockVersions)
+{
+    free(r800->codeCache);
+
+    r800->blockVersions = blockVersions;
+    r800->codeCache     = NULL;
+    if (blockVersions != NULL) {
+        r800->codeCache = calloc(1, sizeof(R800CodeCache));
+    }
+}
+
+void r800SetIoPortBlockWrite(R800* r800, R800CheckBlockCb checkIoPortBlock, 
+                             R800WriteBlockCb writeIoPortBlock)
+{
+    r800->checkIoPortBlock = checkIoPortBlock ? checkIoPortBlock : checkIoPortBlockDummy;
+    r800->writeIoPortBlock = writeIoPortBlock;
 }
 
 void r800SetBreakpoint(R800* r800, UInt16 address)
@@ -6003,7 +6690,9 @@ void r800SetBreakpoint(R800* r800, UInt16 address)
 #ifdef ENABLE_BREAKPOINTS
     if (r800->breakpoints[address] == 0) {
         r800->breakpoints[address] = 1;
-        r800->breakpointCount++;
+        if (r800->breakpointCount++ == 0) {
+            r800UpdateCore(r800);
+        }
     }
 #endif
 }
@@ -6012,130 +6701,385 @@ void r800ClearBreakpoint(R800* r800, UInt16 address)
 {
 #ifdef ENABLE_BREAKPOINTS
     if (r800->breakpoints[address] != 0) {
-        r800->breakpointCount--;
         r800->breakpoints[address] = 0;
+        if (--r800->breakpointCount == 0) {
+            r800UpdateCore(r800);
+        }
     }
 #endif
 }
 
 SystemTime r800GetTimeTrace(R800* r800, int offset) {
 #if TIME_TRACE_SIZE > 0
+    // The time trace is only kept by the generic core
+    if (r800->core != CORE_GENERIC) {
+        return 0;
+    }
     return r800->timeTraceBuffer[(TIME_TRACE_SIZE + r800->timeTraceIndex - offset) % TIME_TRACE_SIZE];
 #else
     return r800->systemTime;
 #endif
 }
 
-void r800Execute(R800* r800) {
-    static SystemTime lastRefreshTime = 0;
-    while (!r800->terminate) {
-        UInt16 address;
-        int iff1 = 0;
+#endif
 
-#if TIME_TRACE_SIZE > 0
-        if (r800->regs.PC.W != r800->lastPC) {
-            r800->lastPC = r800->regs.PC.W;
-            r800->timeTraceBuffer[++r800->timeTraceIndex % TIME_TRACE_SIZE] = r800->systemTime;
-        }
+/* Skips the iterations of an instruction that loops on itself (HALT,
+** JR $ or JP $, conditional or not) that would run before the next
+** timeout. Such an iteration only fetches its own opcode bytes, so the
+** system time, the R register and the instruction counter are advanced
+** exactly as if the iterations were executed one by one.
+*/
+static void skipIdleLoop(R800* r800, UInt8 opcode) {
+    UInt16 pc = r800->regs.PC.W;
+    UInt32 time;
+    int length;
+    int i;
+
+    switch (opcode) {
+    case 0x76:
+        length = 1;
+        time   = 0;
+        break;
+    case 0x18: case 0x20: case 0x28: case 0x30: case 0x38:
+        length = 2;
+        time   = DELAY(r800, DLY_ADD8);
+        break;
+    case 0xc2: case 0xc3: case 0xca: case 0xd2: case 0xda: 
+    case 0xe2: case 0xea: case 0xf2: case 0xfa:
+        length = 3;
+        time   = 0;
+        break;
+    default:
+        return;
+    }
+
+    if (r800->oldCpuMode != CPU_UNKNOWN) {
+        return;
+    }
+
+    if (r800->cachePage != (UInt16)(pc + length - 1) >> 8) {
+        return;
+    }
+
+#ifdef ENABLE_BREAKPOINTS
+    if (r800->breakpointCount > 0 && r800->breakpoints[pc]) {
+        return;
+    }
 #endif
-        if ((Int32)(r800->timeout - r800->systemTime) <= 0) {
-            if (r800->timerCb != NULL) {
-                r800->timerCb(r800->ref);
-            }
+
+    time += DELAY(r800, DLY_M1);
+    for (i = 0; i < length; i++) {
+        time += DELAY(r800, DLY_MEMOP);
+        if ((UInt16)(pc + i) >> 8 != (UInt16)(pc + (i + length - 1) % length) >> 8) {
+            time += DELAY(r800, DLY_MEMPAGE);
         }
+    }
 
-        if (r800->oldCpuMode != CPU_UNKNOWN) {
-            r800SwitchCpu(r800);
+    while (!r800->terminate) {
+        Int32  left = (Int32)(r800->timeout - r800->systemTime);
+        UInt32 count;
+
+        if (left <= 0) {
+            break;
         }
 
-        if (r800->cpuMode == CPU_R800) {
-            if (r800->systemTime - lastRefreshTime > 222 * 3) {
-                lastRefreshTime = r800->systemTime;
+        count = (left + time - 1) / time;
+
+        if (CPU_MODE(r800) == CPU_R800) {
+            UInt32 elapsed = r800->systemTime - r800->lastRefreshTime;
+            if (elapsed > 222 * 3) {
+                r800->lastRefreshTime = r800->systemTime;
                 r800->systemTime += 20 * 3;
+                count = 1;
+            }
+            else if (count > (222 * 3 - elapsed) / time + 1) {
+                count = (222 * 3 - elapsed) / time + 1;
             }
         }
 
+        r800->systemTime += count * time;
+        r800->regs.R = (r800->regs.R & 0x80) | ((r800->regs.R + count) & 0x7f);
+        r800->instCnt += count;
+    }
+}
+
+/* Sets the time at which the execute loop next has to leave its fast
+** path. Anything that needs attention between two instructions and
+** isn't a timeout or an R800 refresh makes that the current time.
+** State changes from instructions and callbacks use signalEvent().
+*/
+static void updateEventTime(R800* r800) {
+    if (r800->terminate || r800->oldCpuMode != CPU_UNKNOWN ||
+        r800->regs.halt || r800->regs.ei_mode || r800->nmiEdge ||
+        (r800->intState == INT_LOW && r800->regs.iff1))
+    {
+        r800->eventTime = r800->systemTime;
+        return;
+    }
+
 #ifdef ENABLE_BREAKPOINTS
-        if (r800->breakpointCount > 0) {
-            if (r800->breakpoints[r800->regs.PC.W]) {
-                if (r800->breakpointCb != NULL) {
-                    r800->breakpointCb(r800->ref, r800->regs.PC.W);
-                    if (r800->terminate) {
-                        break;
-                    }
-                }
-            }
-        }
+    if (r800->breakpointCount > 0) {
+        r800->eventTime = r800->systemTime;
+        return;
+    }
 #endif
 
-        executeInstruction(r800, readOpcode(r800, r800->regs.PC.W++));
+    r800->eventTime = r800->timeout;
 
-        if (r800->regs.halt) {
-			continue;
+    if (CPU_MODE(r800) == CPU_R800) {
+        SystemTime refreshTime = r800->lastRefreshTime + 222 * 3 + 1;
+        if ((Int32)(refreshTime - r800->eventTime) < 0) {
+            r800->eventTime = refreshTime;
         }
+    }
+}
 
-		if (r800->regs.ei_mode) {
-			r800->regs.ei_mode=0;
-			continue;
-		}
+/* Handles the end of an instruction: halt, EI delay, idle loops and
+** interrupts.
+*/
+static void afterInstruction(R800* r800, UInt16 pc, UInt8 opcode) {
+    UInt16 address;
 
-        if (! ((r800->intState==INT_LOW && r800->regs.iff1)||r800->nmiEdge) ) {
-			continue;
+    if (r800->regs.halt) {
+        skipIdleLoop(r800, 0x76);
+        return;
+    }
+
+	if (r800->regs.ei_mode) {
+		r800->regs.ei_mode=0;
+		return;
+	}
+
+    if (! ((r800->intState==INT_LOW && r800->regs.iff1)||r800->nmiEdge) ) {
+        if (r800->regs.PC.W == pc) {
+            skipIdleLoop(r800, opcode);
         }
+		return;
+    }
 
-        /* If it is NMI... */
+    /* If it is NMI... */
 
-        if (r800->nmiEdge) {
-            r800->nmiEdge = 0;
+    if (r800->nmiEdge) {
+        r800->nmiEdge = 0;
 #ifdef ENABLE_CALLSTACK
-            r800->callstack[r800->callstackSize++ & 0xff] = r800->regs.PC.W;
+        r800->callstack[r800->callstackSize++ & 0xff] = r800->regs.PC.W;
 #endif
-	        r800->writeMemory(r800->ref, --r800->regs.SP.W, r800->regs.PC.B.h);
-	        r800->writeMemory(r800->ref, --r800->regs.SP.W, r800->regs.PC.B.l);
-//            r800->regs.iff2 = r800->regs.iff1;
-            r800->regs.iff1 = 0;
-            r800->regs.PC.W = 0x0066;
-            M1(r800);
-            delayNmi(r800);
-            continue;
-        }
-
+	    r800->writeMemory(r800->ref, --r800->regs.SP.W, r800->regs.PC.B.h);
+	    r800->writeMemory(r800->ref, --r800->regs.SP.W, r800->regs.PC.B.l);
+//        r800->regs.iff2 = r800->regs.iff1;
         r800->regs.iff1 = 0;
-        r800->regs.iff2 = 0;
+        r800->regs.PC.W = 0x0066;
+        M1(r800);
+        delayNmi(r800);
+        return;
+    }
 
-        switch (r800->regs.im) {
+    r800->regs.iff1 = 0;
+    r800->regs.iff2 = 0;
 
-        case 0:
-            delayIm(r800);
-            address = r800->dataBus;
-            r800->dataBus = r800->defaultDatabus;
-            executeInstruction(r800, (UInt8)(address & 0xff));
-            break;
+    switch (r800->regs.im) {
 
-        case 1:
-            delayIm(r800);
-            executeInstruction(r800, 0xff);
-            break;
+    case 0:
+        delayIm(r800);
+        address = r800->dataBus;
+        r800->dataBus = r800->defaultDatabus;
+        executeInstruction(r800, (UInt8)(address & 0xff));
+        break;
 
-        case 2:
-            address = r800->dataBus | ((Int16)r800->regs.I << 8);
-            r800->dataBus = r800->defaultDatabus;
+    case 1:
+        delayIm(r800);
+        executeInstruction(r800, 0xff);
+        break;
+
+    case 2:
+        address = r800->dataBus | ((Int16)r800->regs.I << 8);
+        r800->dataBus = r800->defaultDatabus;
 #ifdef ENABLE_CALLSTACK
-            r800->callstack[r800->callstackSize++ & 0xff] = r800->regs.PC.W;
+        r800->callstack[r800->callstackSize++ & 0xff] = r800->regs.PC.W;
 #endif
-	        r800->writeMemory(r800->ref, --r800->regs.SP.W, r800->regs.PC.B.h);
-	        r800->writeMemory(r800->ref, --r800->regs.SP.W, r800->regs.PC.B.l);
-            r800->regs.PC.B.l = r800->readMemory(r800->ref, address++);
-            r800->regs.PC.B.h = r800->readMemory(r800->ref, address);
-            M1_nodelay(r800);
-            delayIm2(r800);
+	    r800->writeMemory(r800->ref, --r800->regs.SP.W, r800->regs.PC.B.h);
+	    r800->writeMemory(r800->ref, --r800->regs.SP.W, r800->regs.PC.B.l);
+        r800->regs.PC.B.l = r800->readMemory(r800->ref, address++);
+        r800->regs.PC.B.h = r800->readMemory(r800->ref, address);
+        M1_nodelay(r800);
+        delayIm2(r800);
+        break;
+    }
+}
+
+/* Handles the start of an instruction: termination, the CPU timeout,
+** CPU switches, the R800 refresh and breakpoints. Returns 0 if the
+** execute loop is to return.
+*/
+static int beforeInstruction(R800* r800) {
+    if (r800->terminate) {
+        return 0;
+    }
+
+    if ((Int32)(r800->timeout - r800->systemTime) <= 0) {
+        if (r800->timerCb != NULL) {
+            r800->timerCb(r800->ref);
+        }
+    }
+
+    if (r800->oldCpuMode != CPU_UNKNOWN) {
+        r800SwitchCpu(r800);
+        if (r800->core != R800_CORE_ID) {
+            return 0;
+        }
+    }
+
+    if (CPU_MODE(r800) == CPU_R800) {
+        if (r800->systemTime - r800->lastRefreshTime > 222 * 3) {
+            r800->lastRefreshTime = r800->systemTime;
+            r800->systemTime += 20 * 3;
+        }
+    }
+
+#ifdef ENABLE_BREAKPOINTS
+    if (r800->breakpointCount > 0) {
+        if (r800->breakpoints[r800->regs.PC.W]) {
+            if (r800->breakpointCb != NULL) {
+                r800->breakpointCb(r800->ref, r800->regs.PC.W);
+                if (r800->terminate) {
+                    return 0;
+                }
+            }
+        }
+    }
+#endif
+
+    updateEventTime(r800);
+
+    return 1;
+}
+
+#ifdef ENABLE_TRACE_RING
+static void traceInstruction(R800* r800) {
+    R800TraceHeader* header = r800->traceHeader;
+    R800TraceEntry* entries = (R800TraceEntry*)(header + 1);
+    R800TraceEntry* entry;
+    UInt32 delta = r800->systemTime - header->time;
+    UInt16 pc = r800->regs.PC.W;
+    int i;
+
+    if (delta >= R800_TRACE_TIME) {
+        entry = entries + (header->count++ & (header->size - 1));
+        entry->pc        = 0;
+        entry->timeDelta = R800_TRACE_TIME;
+        entry->AF        = (UInt16)delta;
+        entry->BC        = (UInt16)(delta >> 16);
+        entry->DE        = 0;
+        entry->HL        = 0;
+        delta = 0;
+    }
+
+    entry = entries + (header->count++ & (header->size - 1));
+    entry->pc        = pc;
+    entry->timeDelta = (UInt16)delta;
+    entry->AF        = r800->regs.AF.W;
+    entry->BC        = r800->regs.BC.W;
+    entry->DE        = r800->regs.DE.W;
+    entry->HL        = r800->regs.HL.W;
+
+    // Only plain memory is read, reading I/O mapped memory has side effects
+    for (i = 0; i < 4; i++) {
+        UInt16 address = pc + i;
+        UInt8* block = r800->readBlocks[address >> 8];
+        entry->opcode[i] = block != NULL ? block[address & 0xff] : 0xff;
+    }
+
+    header->time = r800->systemTime;
+}
+#endif
+
+/* The common path only fetches and executes an instruction and compares
+** the system time with the event time. Everything else is done by
+** afterInstruction() and beforeInstruction() when an event is due.
+*/
+void R800_EXECUTE(R800* r800) {
+    UInt16 pc;
+    UInt8  opcode;
+#ifdef ENABLE_PROFILER
+    SystemTime startTime;
+    UInt32     startCount;
+#endif
+
+    if (!beforeInstruction(r800)) {
+        return;
+    }
+
+    for (;;) {
+#if TIME_TRACE_SIZE > 0
+        if (r800->regs.PC.W != r800->lastPC) {
+            r800->lastPC = r800->regs.PC.W;
+            r800->timeTraceBuffer[++r800->timeTraceIndex % TIME_TRACE_SIZE] = r800->systemTime;
+        }
+#endif
+        pc     = r800->regs.PC.W;
+#ifdef ENABLE_PROFILER
+        startTime  = r800->systemTime;
+        startCount = r800->instCnt;
+#endif
+#ifdef ENABLE_TRACE_RING
+        if (r800->traceHeader != NULL) {
+            traceInstruction(r800);
+        }
+#endif
+#ifdef R800_CORE_SPECIALISED
+        opcode = executeCode(r800, pc);
+#else
+        opcode = readOpcode(r800, r800->regs.PC.W++);
+        executeInstruction(r800, opcode);
+#endif
+
+        if ((Int32)(r800->eventTime - r800->systemTime) > 0) {
+#ifdef ENABLE_PROFILER
+            if (r800->profileCb != NULL) {
+                r800->profileCb(r800->profileRef, pc, r800->instCnt - startCount, 
+                                r800->systemTime - startTime);
+            }
+#endif
+            continue;
+        }
+
+        afterInstruction(r800, pc, opcode);
+
+#ifdef ENABLE_PROFILER
+        if (r800->profileCb != NULL) {
+            r800->profileCb(r800->profileRef, pc, r800->instCnt - startCount, 
+                            r800->systemTime - startTime);
+        }
+#endif
+
+        if (!beforeInstruction(r800)) {
+            return;
+        }
+    }
+}
+
+#ifndef R800_CORE_SPECIALISED
+
+void r800Execute(R800* r800) {
+    while (!r800->terminate) {
+        switch (r800->core) {
+        case CORE_LEAN:
+            r800ExecuteLean(r800);
+            break;
+        case CORE_Z80:
+            r800ExecuteZ80(r800);
+            break;
+        case CORE_R800:
+            r800ExecuteR800(r800);
+            break;
+        default:
+            r800ExecuteGeneric(r800);
             break;
         }
     }
 }
 
 void r800ExecuteUntil(R800* r800, UInt32 endTime) {
-    static SystemTime lastRefreshTime = 0;
 
     while ((Int32)(endTime - r800->systemTime) > 0) {
         UInt16 address;
@@ -6146,8 +7090,8 @@ void r800ExecuteUntil(R800* r800, UInt32 endTime) {
         }
 
         if (r800->cpuMode == CPU_R800) {
-            if (r800->systemTime - lastRefreshTime > 222 * 3) {
-                lastRefreshTime = r800->systemTime;
+            if (r800->systemTime - r800->lastRefreshTime > 222 * 3) {
+                r800->lastRefreshTime = r800->systemTime;
                 r800->systemTime += 12 * 3;
             }
         }
@@ -6229,13 +7173,12 @@ void r800ExecuteUntil(R800* r800, UInt32 endTime) {
 }
 
 void r800ExecuteInstruction(R800* r800) {
-    static SystemTime lastRefreshTime = 0;
     UInt16 address;
     int iff1 = 0;
 
     if (r800->cpuMode == CPU_R800) {
-        if (r800->systemTime - lastRefreshTime > 222 * 3) {
-            lastRefreshTime = r800->systemTime;
+        if (r800->systemTime - r800->lastRefreshTime > 222 * 3) {
+            r800->lastRefreshTime = r800->systemTime;
             r800->systemTime += 12 * 3;
         }
     }
@@ -6315,3 +7258,4 @@ void r800ExecuteInstruction(R800* r800) {
     }
 }
 
+#endif
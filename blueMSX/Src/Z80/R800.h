@@ -91,6 +91,8 @@
 #define ENABLE_WATCHPOINTS
 #define ENABLE_ASMSX_DEBUG_COMMANDS
 #define ENABLE_TRAP_CALLBACK
+#define ENABLE_PROFILER
+#define ENABLE_TRACE_RING
 #define TIME_TRACE_SIZE 1024
 #endif
 
@@ -116,6 +118,7 @@ typedef enum {
 typedef enum { 
     CPU_VDP_IO_DELAY = 0x0001,
     CPU_ENABLE_M1    = 0x0002,
+    CPU_GENERIC_CORE = 0x0004,  /* Don't use the constant timing cores */
 } CpuFlags;
 
 
@@ -212,6 +215,57 @@ typedef void  (*R800BreakptCb)(void*, UInt16);
 typedef void  (*R800DebugCb)(void*, int, const char*);
 typedef void  (*R800TrapCb)(void*, UInt8);
 typedef void  (*R800TimerCb)(void*);
+typedef void  (*R800ProfileCb)(void*, UInt16, UInt32, UInt32);
+typedef int   (*R800CheckBlockCb)(void*, UInt16);
+typedef void  (*R800WriteBlockCb)(void*, UInt16, const UInt8*, const SystemTime*, int);
+
+
+/*****************************************************
+** R800TraceEntry
+**
+** One 16 byte entry in a binary instruction trace. It holds the
+** address, the first four bytes and the main registers before the
+** instruction is executed and the number of master clock cycles
+** since the previous entry. Bytes outside plain memory read as 0xff.
+**
+** A delta that doesn't fit in 16 bits is stored in a time entry
+** before the instruction, with timeDelta set to R800_TRACE_TIME and
+** the low and high words of the delta in AF and BC.
+******************************************************
+*/
+#define R800_TRACE_TIME     0xffff
+
+typedef struct {
+    UInt16 pc;
+    UInt16 timeDelta;
+    UInt8  opcode[4];
+    UInt16 AF;
+    UInt16 BC;
+    UInt16 DE;
+    UInt16 HL;
+} R800TraceEntry;
+
+
+/*****************************************************
+** R800TraceHeader
+**
+** Header of a trace ring, followed by the entries. The entry count
+** is a power of two and the newest entry is at (count - 1) modulo
+** the size. time is the system time of the newest entry.
+******************************************************
+*/
+#define R800_TRACE_MAGIC    "BMXTRACE"
+#define R800_TRACE_VERSION  1
+
+typedef struct {
+    char       magic[8];
+    UInt32     version;
+    UInt32     entrySize;
+    UInt64     size;
+    UInt64     count;
+    SystemTime time;
+    UInt32     reserved[7];
+} R800TraceHeader;
 
 
 /*****************************************************
@@ -230,6 +284,15 @@ typedef void  (*R800TimerCb)(void*);
 #define Z_FLAG      0x40
 #define S_FLAG      0x80
 
+/*****************************************************
+** R800CodeCache
+**
+** Instructions decoded from plain memory, see
+** r800SetCodeCache(). The layout is private to R800.c.
+******************************************************
+*/
+typedef struct R800CodeCache R800CodeCache;
+
 /*****************************************************
 ** R800
 **
@@ -253,6 +316,8 @@ typedef struct
     CpuMode       oldCpuMode;       /* CPU mode before CPU switch      */
     CpuRegs       regBanks[2];      /* Z80 and R800 register banks     */
     UInt32        cpuFlags;         /* Current CPU flags               */
+    int           core;             /* Execution core in use           */
+    int           instrumented;     /* Debugger support is enabled     */
 
     UInt32        instCnt;          /* Instruction counter             */
 
@@ -261,6 +326,8 @@ typedef struct
 
     int           terminate;        /* Termination flag                */
     SystemTime    timeout;          /* User scheduled timeout          */
+    SystemTime    eventTime;        /* Time of next execute loop event */
+    SystemTime    lastRefreshTime;  /* Time of last R800 DRAM refresh  */
 
     R800ReadCb    readMemory;       /* Callback functions for reading  */
     R800WriteCb   writeMemory;      /* and writing memory and IO ports */
@@ -273,9 +340,16 @@ typedef struct
     R800WriteCb   watchpointMemCb;
     R800WriteCb   watchpointIoCb;
     R800TrapCb    trapCb;
+    R800CheckBlockCb checkIoPortBlock;
+    R800WriteBlockCb writeIoPortBlock;
     void*         ref;              /* User defined pointer which is   */
                                     /* passed to the callbacks         */
 
+    UInt8**       readBlocks;       /* Direct pointers to the memory   */
+    UInt8**       writeBlocks;      /* in each 256 byte block, or NULL */
+    const UInt32* blockVersions;    /* Version of each block and the   */
+    R800CodeCache* codeCache;       /* code decoded from them, or NULL */
+
 #ifdef ENABLE_CALLSTACK
     UInt32        callstackSize;    /* Nr of entries in the callstack  */
                                     /* only last 256 entries are stored*/
@@ -292,6 +366,16 @@ typedef struct
     UInt32        timeTraceIndex;
     UInt16        lastPC;
 #endif
+
+#ifdef ENABLE_PROFILER
+    R800ProfileCb profileCb;        /* Called after each instruction   */
+                                    /* while profiling, or NULL        */
+    void*         profileRef;       /* Reference passed to profileCb   */
+#endif
+
+#ifdef ENABLE_TRACE_RING
+    R800TraceHeader* traceHeader;   /* Trace ring or NULL              */
+#endif
 } R800;
 
 
@@ -453,7 +537,9 @@ void r800SetDataBus(R800* r800, UInt8 value, UInt8 defValue, int useDef);
 ** r800Execute
 **
 ** Executes CPU instructions until the r800StopExecution function is
-** called.
+** called. A Z80 at 3.58 MHz with M1 wait states and an R800 at 7.16 MHz
+** run on cores with constant timing unless CPU_GENERIC_CORE is set or
+** the debugger support is needed (see r800SetInstrumentation).
 **
 ** Arguments:
 **      r800        - Pointer to an R800 object
@@ -488,6 +574,117 @@ void r800ExecuteInstruction(R800* r800);
 void r800StopExecution(R800* r800);
 void r800SetTimeoutAt(R800* r800, SystemTime time);
 
+/************************************************************************
+** r800SetInstrumentation
+**
+** Enables the time trace, the call stack and the watchpoint callbacks
+** that a debugger needs. Without them, and without breakpoints, the
+** instructions are executed by cores that leave the debugger support
+** out.
+**
+** Arguments:
+**      r800        - Pointer to an R800 object
+**      enable      - 1 to enable the debugger support, 0 to disable it
+*************************************************************************
+*/
+void r800SetInstrumentation(R800* r800, int enable);
+
+/************************************************************************
+** r800SetMemoryBlocks
+**
+** Gives the CPU direct access to plain memory. Each table has one
+** entry per 256 byte block of the address space that points to the
+** memory mapped in the block, or is NULL if the block is accessed
+** through the memory callbacks. The tables are owned by the caller and
+** must be kept up to date, NULL leaves all blocks to the callbacks.
+** Instructions in blocks with direct access are fetched without the
+** read callback, and block instructions run many iterations at once
+** when their data is in such blocks.
+**
+** Arguments:
+**      r800        - Pointer to an R800 object
+**      readBlocks  - Table of blocks that can be read directly
+**      writeBlocks - Table of blocks that can be written directly
+*************************************************************************
+*/
+void r800SetMemoryBlocks(R800* r800, UInt8** readBlocks, UInt8** writeBlocks);
+
+/************************************************************************
+** r800SetIoPortBlockWrite
+**
+** Lets OTIR and unrolled OUTI sequences hand the values they write to
+** a port in one call. checkIoPortBlock returns non zero if the port
+** takes block writes. writeIoPortBlock then gets the values together
+** with the system time each iteration wrote the port, after the
+** iterations have run. Other ports are written one value at a time.
+**
+** Arguments:
+**      r800             - Pointer to an R800 object
+**      checkIoPortBlock - Function that checks if a port takes block
+**                         writes, or NULL
+**      writeIoPortBlock - Function that writes a block to a port
+*************************************************************************
+*/
+void r800SetIoPortBlockWrite(R800* r800, R800CheckBlockCb checkIoPortBlock, 
+                             R800WriteBlockCb writeIoPortBlock);
+
+/************************************************************************
+** r800SetCodeCache
+**
+** Keeps the instructions the CPU fetches from plain memory decoded, so
+** that the next time they are dispatched to the handler after their
+** prefix without fetching and decoding the opcodes again. The timing is
+** the same as when the opcodes are fetched. The operands are fetched
+** by the handlers as before.
+**
+** The cache is dropped for a 256 byte block when its version changes,
+** and for an address when the CPU writes to it. Other writes to memory
+** mapped in a block must give the block a new version. Blocks with
+** version 0 are not cached. The cache is only used by the constant and
+** lean cores, see r800SetMemoryBlocks().
+**
+** Arguments:
+**      r800          - Pointer to an R800 object
+**      blockVersions - Table with the version of each 256 byte block,
+**                      or NULL to remove the cache
+*************************************************************************
+*/
+void r800SetCodeCache(R800* r800, const UInt32* blockVersions);
+
+/************************************************************************
+** r800SetProfiler
+**
+** Starts or stops profiling. While a profile callback is set, the
+** instructions are executed by the generic core, which calls it after
+** each instruction with its address, the number of instructions it
+** counts for and the system time it took. The count includes the
+** iterations of an idle loop skipped after the instruction and is zero
+** for a repeated iteration of a block instruction, as in instCnt. The
+** time includes an interrupt accepted or idle time skipped after it.
+**
+** Arguments:
+**      r800        - Pointer to an R800 object
+**      profileCb   - Function called for each instruction, or NULL to
+**                    stop profiling
+**      ref         - Reference passed to profileCb
+*************************************************************************
+*/
+void r800SetProfiler(R800* r800, R800ProfileCb profileCb, void* ref);
+
+/************************************************************************
+** r800SetTraceRing
+**
+** Starts or stops the binary instruction trace. While a trace ring is
+** set, the instructions are executed by the generic core, which adds
+** an entry to the ring before each instruction.
+**
+** Arguments:
+**      r800        - Pointer to an R800 object
+**      header      - Header of the trace ring, or NULL to stop tracing
+*************************************************************************
+*/
+void r800SetTraceRing(R800* r800, R800TraceHeader* header);
+
 void r800SetBreakpoint(R800* r800, UInt16 address);
 void r800ClearBreakpoint(R800* r800, UInt16 address);
 
@@ -30,6 +30,7 @@
 ******************************************************************************
 */
 #include "R800Debug.h"
+#include "R800Trace.h"
 #include "SlotManager.h"
 #include "DebugDeviceManager.h"
 #include "Language.h"
@@ -37,35 +38,198 @@
 #include <stdio.h>
 #include <string.h>
 #include "Board.h"
+#include "Debugger.h"
 
 
 extern void debuggerTrace(const char* str);
 extern void archTrap(UInt8 value);
 
+typedef struct {
+    UInt32 key;
+    UInt32 count;
+    UInt64 time;
+} ProfileEntry;
+
 struct R800Debug {
+    BoardContext* board;
     int debugHandle;
     R800* r800;
+    ProfileEntry* profile;
+    int profileSize;
+    int profileCount;
+    R800TraceRing* trace;
+    UInt8 mappedRAM[0x10000];
+    UInt16 callstack[0x100];
 };
 
-static R800Debug* dbg;
+
+// The profile is an open addressed hash table of instructions keyed by
+// the address and the slot, subslot and bank it was executed from.
+#define PROFILE_KEY(pc, slot, sslot, bank) \
+    ((pc) | ((slot) << 16) | ((sslot) << 18) | ((UInt32)(bank) << 20) | 0x80000000)
+
+#define PROFILE_HASH(key, size) \
+    ((((key) ^ ((key) >> 16)) * 2654435761U) & ((size) - 1))
+
+static int profileResize(R800Debug* dbg, int size)
+{
+    ProfileEntry* profile = calloc(size, sizeof(ProfileEntry));
+    int i;
+
+    if (profile == NULL) {
+        return 0;
+    }
+
+    for (i = 0; i < dbg->profileSize; i++) {
+        if (dbg->profile[i].key != 0) {
+            int j = PROFILE_HASH(dbg->profile[i].key, size);
+            while (profile[j].key != 0) {
+                j = (j + 1) & (size - 1);
+            }
+            profile[j] = dbg->profile[i];
+        }
+    }
+
+    free(dbg->profile);
+    dbg->profile     = profile;
+    dbg->profileSize = size;
+
+    return 1;
+}
+
+static void profileCb(R800Debug* dbg, UInt16 pc, UInt32 count, UInt32 time)
+{
+    ProfileEntry* entry;
+    UInt32 key;
+    int slot;
+    int sslot;
+    int bank;
+    int i;
+
+    slotGetMapping(dbg->board, pc, &slot, &sslot, &bank);
+    key = PROFILE_KEY(pc, slot, sslot, bank & 0x7ff);
+
+    i = PROFILE_HASH(key, dbg->profileSize);
+    while (dbg->profile[i].key != key) {
+        if (dbg->profile[i].key == 0) {
+            if (2 * (dbg->profileCount + 1) > dbg->profileSize) {
+                if (!profileResize(dbg, 2 * dbg->profileSize)) {
+                    return;
+                }
+                profileCb(dbg, pc, count, time);
+                return;
+            }
+            dbg->profile[i].key = key;
+            dbg->profileCount++;
+            break;
+        }
+        i = (i + 1) & (dbg->profileSize - 1);
+    }
+
+    entry = dbg->profile + i;
+    entry->count += count;
+    entry->time  += time;
+}
+
+static int setProfiling(R800Debug* dbg, int enable)
+{
+    free(dbg->profile);
+    dbg->profile      = NULL;
+    dbg->profileSize  = 0;
+    dbg->profileCount = 0;
+
+    if (enable && !profileResize(dbg, 0x1000)) {
+        enable = 0;
+    }
+
+    r800SetProfiler(dbg->r800, enable ? profileCb : NULL, dbg);
+
+    return enable;
+}
+
+static int profileCompare(const void* a, const void* b)
+{
+    UInt32 keyA = ((const ProfileEntry*)a)->key;
+    UInt32 keyB = ((const ProfileEntry*)b)->key;
+
+    return keyA < keyB ? -1 : keyA > keyB ? 1 : 0;
+}
+
+// Saves the profile in callgrind format. Each slot is an object and each
+// mapper bank a function, the costs are master clock cycles and executed
+// instructions.
+static int saveProfile(R800Debug* dbg, const char* fileName)
+{
+    ProfileEntry* entries;
+    UInt32 lastGroup = 0;
+    FILE* file;
+    int count = 0;
+    int i;
+
+    if (dbg->profile == NULL) {
+        return 0;
+    }
+
+    entries = malloc((dbg->profileCount + 1) * sizeof(ProfileEntry));
+    if (entries == NULL) {
+        return 0;
+    }
+
+    for (i = 0; i < dbg->profileSize; i++) {
+        if (dbg->profile[i].key != 0) {
+            entries[count++] = dbg->profile[i];
+        }
+    }
+    qsort(entries, count, sizeof(ProfileEntry), profileCompare);
+
+    file = fopen(fileName, "w");
+    if (file == NULL) {
+        free(entries);
+        return 0;
+    }
+
+    fprintf(file, "# callgrind format\n");
+    fprintf(file, "version: 1\n");
+    fprintf(file, "creator: blueMSX\n");
+    fprintf(file, "positions: instr\n");
+    fprintf(file, "event: Ticks : Master clock cycles (%d Hz)\n", R800_MASTER_FREQUENCY);
+    fprintf(file, "event: Ir : Instructions\n");
+    fprintf(file, "events: Ticks Ir\n");
+
+    for (i = 0; i < count; i++) {
+        UInt32 key = entries[i].key;
+        if (i == 0 || (key >> 16) != lastGroup) {
+            lastGroup = key >> 16;
+            fprintf(file, "\nob=slot %d-%d\n", (key >> 16) & 3, (key >> 18) & 3);
+            fprintf(file, "fn=bank %d\n", (key >> 20) & 0x7ff);
+        }
+        fprintf(file, "0x%04x %llu %u\n", key & 0xffff, 
+                (unsigned long long)entries[i].time, entries[i].count);
+    }
+
+    fclose(file);
+    free(entries);
+
+    return 1;
+}
 
 
 static void getDebugInfo(R800Debug* dbg, DbgDevice* dbgDevice)
 {
-    static UInt8 mappedRAM[0x10000];
+    UInt8* mappedRAM = dbg->mappedRAM;
     DbgRegisterBank* regBank;
     int freqAdjust;
     int i;
 
     for (i = 0; i < 0x10000; i++) {
-        mappedRAM[i] = slotPeek(NULL, i);
+        mappedRAM[i] = slotPeek(dbg->board, i);
     }
 
     dbgDeviceAddMemoryBlock(dbgDevice, langDbgMemVisible(), 0, 0, 0x10000, mappedRAM);
 
 #ifdef ENABLE_CALLSTACK
     if (dbg->r800->callstackSize > 255) {
-        static UInt16 callstack[0x100];
+        UInt16* callstack = dbg->callstack;
         int beginning = dbg->r800->callstackSize & 0xff;
         int reminder = 256 - beginning;
         memcpy(callstack, dbg->r800->callstack + beginning, reminder * sizeof(UInt16));
@@ -124,8 +288,8 @@ static int dbgWriteMemory(R800Debug* dbg, char* name, void* data, int start, int
     }
 
     for (i = 0; i < size; i++) {
-        slotWrite(NULL, start + i, dataBuffer[i]);
-        rv &= dataBuffer[i] == slotPeek(NULL, start + i);
+        slotWrite(dbg->board, start + i, dataBuffer[i]);
+        rv &= dataBuffer[i] == slotPeek(dbg->board, start + i);
     }
 
     return rv;
@@ -157,29 +321,63 @@ static int dbgWriteRegister(R800Debug* dbg, char* name, int regIndex, UInt32 val
 }
 
 
-static void breakpointCb(R800Debug* dbg, UInt16 pc)
+static int setTrace(R800Debug* dbg, const char* fileName, UInt64 size)
+{
+    r800SetTraceRing(dbg->r800, NULL);
+
+    if (dbg->trace != NULL) {
+        r800TraceDestroy(dbg->trace);
+        dbg->trace = NULL;
+    }
+
+    if (size == 0) {
+        return 1;
+    }
+
+    dbg->trace = r800TraceCreate(fileName, size);
+    if (dbg->trace == NULL) {
+        return 0;
+    }
+
+    r800SetTraceRing(dbg->r800, r800TraceGetHeader(dbg->trace));
+
+    return 1;
+}
+
+static int saveTrace(R800Debug* dbg, const char* fileName)
+{
+    if (dbg->trace == NULL) {
+        return 0;
+    }
+    return r800TraceSave(dbg->trace, fileName);
+}
+
+
+// The CPU callbacks below get the CPU reference, which is the board
+
+static void breakpointCb(BoardContext* board, UInt16 pc)
 {
-    boardOnBreakpoint(pc);
+    boardOnBreakpoint(board, pc);
 }
   
 UInt8 readMem(void* ref, int address) {
     if (address < 0x10000) {
-        return slotPeek(NULL, (UInt16)address);
+        return slotPeek(ref, (UInt16)address);
     }
     return 0xff;
 }
 
-static void watchpointMemCb(R800Debug* dbg, UInt16 address, UInt8 value) 
+static void watchpointMemCb(BoardContext* board, UInt16 address, UInt8 value) 
 {
-    tryWatchpoint(DBGTYPE_CPU, address, value, dbg, readMem); 
+    tryWatchpoint(board, DBGTYPE_CPU, address, value, board, readMem); 
 }
 
-static void watchpointIoCb(R800Debug* dbg, UInt16 port, UInt8 value) 
+static void watchpointIoCb(BoardContext* board, UInt16 port, UInt8 value) 
 {
-    tryWatchpoint(DBGTYPE_PORT, port, value, dbg, NULL); 
+    tryWatchpoint(board, DBGTYPE_PORT, port, value, board, NULL); 
 }
 
-static void debugCb(R800Debug* dbg, int command, const char* data) 
+static void debugCb(BoardContext* board, int command, const char* data) 
 {
     int slot, page, addr, rv;
     switch (command) {
@@ -200,24 +398,41 @@ void trapCb(R800* r800, UInt8 value)
     archTrap(value);
 }
 
-void r800DebugCreate(R800* r800)
+static void debuggerChanged(R800Debug* dbg)
+{
+    r800SetInstrumentation(dbg->r800, debuggerIsPresent() || debugDeviceHasWatchpoints(dbg->board));
+}
+
+R800Debug* r800DebugCreate(BoardContext* board, R800* r800)
 {
     DebugCallbacks dbgCallbacks = { getDebugInfo, dbgWriteMemory, dbgWriteRegister, NULL };
+    DebugToolCallbacks toolCallbacks = { setProfiling, saveProfile, setTrace, saveTrace, debuggerChanged };
+    R800Debug* dbg;
     
-    dbg = (R800Debug*)malloc(sizeof(R800Debug));
+    dbg = (R800Debug*)calloc(1, sizeof(R800Debug));
+    dbg->board = board;
     dbg->r800 = r800;
-    dbg->debugHandle = debugDeviceRegister(DBGTYPE_CPU, langDbgDevZ80(), &dbgCallbacks, dbg);
+    dbg->debugHandle = debugDeviceRegister(board, DBGTYPE_CPU, langDbgDevZ80(), &dbgCallbacks, dbg);
+    debugDeviceSetToolCallbacks(board, dbg->debugHandle, &toolCallbacks);
 
     r800->debugCb           = debugCb;
     r800->breakpointCb      = breakpointCb;
     r800->trapCb            = trapCb;
     r800->watchpointMemCb   = watchpointMemCb;
     r800->watchpointIoCb    = watchpointIoCb;
+
+    debuggerChanged(dbg);
+
+    return dbg;
 }
 
-void r800DebugDestroy()
+void r800DebugDestroy(R800Debug* dbg)
 {   
-    debugDeviceUnregister(dbg->debugHandle);
+    debugDeviceUnregister(dbg->board, dbg->debugHandle);
+    free(dbg->profile);
+    if (dbg->trace != NULL) {
+        r800TraceDestroy(dbg->trace);
+    }
     free(dbg);
 }
 
@@ -37,7 +37,10 @@
 
 typedef struct R800Debug R800Debug;
 
-void r800DebugCreate(R800* r800);
-void r800DebugDestroy();
+// The CPU core with the debugger support is selected while a debugger
+// is attached or a watchpoint is set, see debugDeviceDebuggerChanged().
+// The breakpoints select it in the CPU itself.
+R800Debug* r800DebugCreate(BoardContext* board, R800* r800);
+void r800DebugDestroy(R800Debug* dbg);
 
 #endif
@@ -82,9 +82,9 @@
     saveStateSet(state, "ei_mode" #index, regs.ei_mode);        \
 }
 
-void r800LoadState(R800* r800)
+void r800LoadState(BoardContext* board, R800* r800)
 {
-    SaveState* state = saveStateOpenForRead("r800");
+    SaveState* state = saveStateOpenForRead(board, "r800");
     char tag[32];
     int i;
     
@@ -115,11 +115,14 @@ void r800LoadState(R800* r800)
 #endif
 
     saveStateClose(state);
+
+    // Makes the execute loop look at the loaded state
+    r800->eventTime = r800->systemTime;
 }
 
-void r800SaveState(R800* r800)
+void r800SaveState(BoardContext* board, R800* r800)
 {
-    SaveState* state = saveStateOpenForWrite("r800");
+    SaveState* state = saveStateOpenForWrite(board, "r800");
     char tag[32];
     int i;
     
@@ -35,7 +35,7 @@
 #include "MsxTypes.h"
 #include "R800.h"
 
-void r800LoadState(R800* r800);
-void r800SaveState(R800* r800);
+void r800LoadState(BoardContext* board, R800* r800);
+void r800SaveState(BoardContext* board, R800* r800);
 
 #endif
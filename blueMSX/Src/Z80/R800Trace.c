@@ -0,0 +1,319 @@
+/*****************************************************************************
+** $Source: /cygdrive/d/Private/_SVNROOT/bluemsx/blueMSX/Src/Z80/R800Trace.c,v $
+**
+** $Revision: 1.1 $
+**
+** $Date: 2026-10-18 12:00:00 $
+**
+** More info: http://www.bluemsx.com
+**
+** Copyright (C) 2003-2006 Daniel Vik
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+******************************************************************************
+*/
+#include "R800Trace.h"
+#include "R800Dasm.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//
+// File layout:
+//
+//   R800TraceHeader
+//   R800TraceEntry[header.size]
+//
+// The file is a copy of the ring, the oldest entry is at count modulo
+// size once the ring has wrapped.
+//
+
+#define MIN_ENTRIES 0x400
+
+struct R800TraceRing {
+    R800TraceHeader* header;
+    UInt64 bytes;
+    int    mapped;
+#ifdef WIN32
+    HANDLE file;
+    HANDLE mapping;
+#else
+    int    file;
+#endif
+};
+
+static int fileSeek(FILE* file, UInt64 offset)
+{
+#if defined(_MSC_VER) && _MSC_VER >= 1400
+    return _fseeki64(file, (__int64)offset, SEEK_SET);
+#elif defined(_WIN32)
+    return fseek(file, (long)offset, SEEK_SET);
+#else
+    return fseeko(file, (off_t)offset, SEEK_SET);
+#endif
+}
+
+static void* mapFile(R800TraceRing* ring, const char* fileName)
+{
+#ifdef WIN32
+    void* data;
+
+    ring->file = CreateFileA(fileName, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                             NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (ring->file == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+
+    ring->mapping = CreateFileMappingA(ring->file, NULL, PAGE_READWRITE, 
+                                       (DWORD)(ring->bytes >> 32), (DWORD)ring->bytes, NULL);
+    if (ring->mapping == NULL) {
+        CloseHandle(ring->file);
+        return NULL;
+    }
+
+    data = MapViewOfFile(ring->mapping, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)ring->bytes);
+    if (data == NULL) {
+        CloseHandle(ring->mapping);
+        CloseHandle(ring->file);
+    }
+    return data;
+#else
+    void* data;
+
+    ring->file = open(fileName, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (ring->file < 0) {
+        return NULL;
+    }
+
+    if (ftruncate(ring->file, (off_t)ring->bytes) != 0) {
+        close(ring->file);
+        return NULL;
+    }
+
+    data = mmap(NULL, (size_t)ring->bytes, PROT_READ | PROT_WRITE, MAP_SHARED, ring->file, 0);
+    if (data == MAP_FAILED) {
+        close(ring->file);
+        return NULL;
+    }
+    return data;
+#endif
+}
+
+static void unmapFile(R800TraceRing* ring)
+{
+#ifdef WIN32
+    UnmapViewOfFile(ring->header);
+    CloseHandle(ring->mapping);
+    CloseHandle(ring->file);
+#else
+    munmap(ring->header, (size_t)ring->bytes);
+    close(ring->file);
+#endif
+}
+
+R800TraceRing* r800TraceCreate(const char* fileName, UInt64 bytes)
+{
+    R800TraceRing* ring;
+    UInt64 size = MIN_ENTRIES;
+
+    while (sizeof(R800TraceHeader) + 2 * size * sizeof(R800TraceEntry) <= bytes) {
+        size *= 2;
+    }
+
+    // The ring can't be larger than the address space of the host
+    if ((size_t)(size * sizeof(R800TraceEntry)) / sizeof(R800TraceEntry) != size) {
+        return NULL;
+    }
+
+    ring = calloc(1, sizeof(R800TraceRing));
+    if (ring == NULL) {
+        return NULL;
+    }
+
+    ring->bytes = sizeof(R800TraceHeader) + size * sizeof(R800TraceEntry);
+
+    if (fileName != NULL) {
+        ring->header = mapFile(ring, fileName);
+        ring->mapped = 1;
+    }
+    else {
+        ring->header = calloc(1, (size_t)ring->bytes);
+    }
+
+    if (ring->header == NULL) {
+        free(ring);
+        return NULL;
+    }
+
+    memset(ring->header, 0, sizeof(R800TraceHeader));
+    memcpy(ring->header->magic, R800_TRACE_MAGIC, sizeof(ring->header->magic));
+    ring->header->version   = R800_TRACE_VERSION;
+    ring->header->entrySize = sizeof(R800TraceEntry);
+    ring->header->size      = size;
+
+    return ring;
+}
+
+void r800TraceDestroy(R800TraceRing* ring)
+{
+    if (ring->mapped) {
+        unmapFile(ring);
+    }
+    else {
+        free(ring->header);
+    }
+    free(ring);
+}
+
+R800TraceHeader* r800TraceGetHeader(R800TraceRing* ring)
+{
+    return ring->header;
+}
+
+int r800TraceSave(R800TraceRing* ring, const char* fileName)
+{
+    FILE* file = fopen(fileName, "wb");
+    int rv;
+
+    if (file == NULL) {
+        return 0;
+    }
+
+    rv = fwrite(ring->header, 1, (size_t)ring->bytes, file) == (size_t)ring->bytes;
+    fclose(file);
+
+    return rv;
+}
+
+static UInt32 entryDelta(R800TraceEntry* entry)
+{
+    if (entry->timeDelta == R800_TRACE_TIME) {
+        return entry->AF | ((UInt32)entry->BC << 16);
+    }
+    return entry->timeDelta;
+}
+
+// Reads entries in ring order and only seeks when the ring wraps
+static int readEntry(FILE* file, R800TraceHeader* header, UInt64 index, int seek, R800TraceEntry* entry)
+{
+    UInt64 position = index & (header->size - 1);
+
+    if (seek || position == 0) {
+        if (fileSeek(file, sizeof(R800TraceHeader) + position * sizeof(R800TraceEntry))) {
+            return 0;
+        }
+    }
+    return fread(entry, sizeof(R800TraceEntry), 1, file) == 1;
+}
+
+static UInt8 dasmRead(void* ref, UInt16 address)
+{
+    R800TraceEntry* entry = (R800TraceEntry*)ref;
+    UInt16 offset = address - entry->pc;
+
+    return offset < 4 ? entry->opcode[offset] : 0xff;
+}
+
+int r800TraceDecode(const char* fileName, FILE* output, UInt64 count)
+{
+    static R800 dasmCpu;
+    R800TraceHeader header;
+    R800TraceEntry entry;
+    SystemTime time;
+    UInt64 first;
+    UInt64 i;
+    FILE* file;
+
+    file = fopen(fileName, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, R800_TRACE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != R800_TRACE_VERSION || 
+        header.entrySize != sizeof(R800TraceEntry) ||
+        header.size == 0 || (header.size & (header.size - 1)) != 0)
+    {
+        fclose(file);
+        return 0;
+    }
+
+    first = header.count > header.size ? header.count - header.size : 0;
+    if (count > 0 && header.count - first > count) {
+        first = header.count - count;
+    }
+
+    // The header holds the time of the newest entry, so the time of the
+    // first one is found by subtracting the deltas of the ones after it
+    time = header.time;
+    for (i = first + 1; i < header.count; i++) {
+        if (!readEntry(file, &header, i, i == first + 1, &entry)) {
+            fclose(file);
+            return 0;
+        }
+        time -= entryDelta(&entry);
+    }
+
+    dasmCpu.readMemory = dasmRead;
+    dasmCpu.ref        = &entry;
+
+    for (i = first; i < header.count; i++) {
+        char mnemonic[64];
+        char bytes[16];
+        int length;
+        int j;
+
+        if (!readEntry(file, &header, i, i == first, &entry)) {
+            fclose(file);
+            return 0;
+        }
+
+        if (i > first) {
+            time += entryDelta(&entry);
+        }
+
+        if (entry.timeDelta == R800_TRACE_TIME) {
+            continue;
+        }
+
+        length = r800Dasm(&dasmCpu, entry.pc, mnemonic);
+        for (j = 0; j < 4; j++) {
+            if (j < length) {
+                sprintf(bytes + 3 * j, "%02x ", entry.opcode[j]);
+            }
+            else {
+                strcpy(bytes + 3 * j, "   ");
+            }
+        }
+
+        fprintf(output, "%10u  %04x  %s %s AF=%04x BC=%04x DE=%04x HL=%04x\n",
+                time, entry.pc, bytes, mnemonic, 
+                entry.AF, entry.BC, entry.DE, entry.HL);
+    }
+
+    fclose(file);
+
+    return 1;
+}
@@ -0,0 +1,61 @@
+/*****************************************************************************
+** $Source: /cygdrive/d/Private/_SVNROOT/bluemsx/blueMSX/Src/Z80/R800Trace.h,v $
+**
+** $Revision: 1.1 $
+**
+** $Date: 2026-10-18 12:00:00 $
+**
+** More info: http://www.bluemsx.com
+**
+** Copyright (C) 2003-2006 Daniel Vik
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+******************************************************************************
+*/
+#ifndef R800_TRACE_H
+#define R800_TRACE_H
+
+#include "MsxTypes.h"
+#include "R800.h"
+#include <stdio.h>
+
+//
+// Binary instruction trace. The CPU writes a 16 byte R800TraceEntry
+// per instruction into a ring, which is kept in memory or mapped to
+// a file. A file mapped ring is written to disk by the host as it
+// fills and holds the trace also if the emulator is stopped or
+// crashes. Trace files are in host byte order.
+//
+
+typedef struct R800TraceRing R800TraceRing;
+
+// Creates a trace ring that is at most the given number of bytes. With
+// a file name the ring is mapped to that file, otherwise it is kept in
+// memory. Returns NULL if the ring can't be created.
+R800TraceRing* r800TraceCreate(const char* fileName, UInt64 bytes);
+void r800TraceDestroy(R800TraceRing* ring);
+
+R800TraceHeader* r800TraceGetHeader(R800TraceRing* ring);
+
+// Writes the ring to a trace file
+int r800TraceSave(R800TraceRing* ring, const char* fileName);
+
+// Disassembles the last count instructions in a trace file, or all of
+// them if count is 0, and prints them with their system time and the
+// registers before the instruction.
+int r800TraceDecode(const char* fileName, FILE* output, UInt64 count);
+
+#endif /* R800_TRACE_H */